@@ -252,6 +252,25 @@ if (HIP_PLATFORM STREQUAL "hip-clang" OR HIP_PLATFORM STREQUAL "hcc")
         INTERFACE_INCLUDE_DIRECTORIES "${HIP_roctracer_INCLUDE_DIR};${HIP_roctracer_INCLUDE_DIR}"
         )
     endif()
+
+    find_library(HIP_roctx_LIBRARY roctx64
+        PATHS
+        "${HIP_ROOT_DIR}"
+        ENV ROCM_PATH
+        ENV HIP_PATH
+        /opt/rocm
+        /opt/rocm/roctracer
+        PATH_SUFFIXES lib
+        NO_DEFAULT_PATH)
+
+    mark_as_advanced(HIP_roctx_LIBRARY)
+    if(HIP_roctx_LIBRARY AND NOT TARGET HIP::roctx)
+      add_library(HIP::roctx UNKNOWN IMPORTED)
+      set_target_properties(HIP::roctx PROPERTIES
+        IMPORTED_LOCATION "${HIP_roctx_LIBRARY}"
+        INTERFACE_INCLUDE_DIRECTORIES "${HIP_roctracer_INCLUDE_DIR}"
+        )
+    endif()
 endif()
 
 
@@ -0,0 +1,26 @@
+# Find the single precision FFTW3 library and its thread support
+#
+# MKL provides the same interface, point FFTW_INCLUDE_DIR, FFTW_LIBRARY, and FFTW_THREADS_LIBRARY
+# to the MKL FFTW3 wrappers to use it.
+
+find_path(FFTW_INCLUDE_DIR fftw3.h)
+
+find_library(FFTW_LIBRARY fftw3f
+             HINTS ${FFTW_INCLUDE_DIR}/../lib )
+
+find_library(FFTW_THREADS_LIBRARY fftw3f_threads
+             HINTS ${FFTW_INCLUDE_DIR}/../lib )
+
+# handle the QUIETLY and REQUIRED arguments and set FFTW_FOUND to TRUE if
+# all listed variables are TRUE
+include(FindPackageHandleStandardArgs)
+find_package_handle_standard_args(FFTW
+                                  REQUIRED_VARS FFTW_LIBRARY FFTW_THREADS_LIBRARY FFTW_INCLUDE_DIR)
+
+if(FFTW_LIBRARY AND FFTW_THREADS_LIBRARY AND NOT TARGET FFTW::fftw3f)
+    add_library(FFTW::fftw3f UNKNOWN IMPORTED)
+    set_target_properties(FFTW::fftw3f PROPERTIES
+        IMPORTED_LOCATION "${FFTW_LIBRARY}"
+        INTERFACE_INCLUDE_DIRECTORIES "${FFTW_INCLUDE_DIR}"
+        INTERFACE_LINK_LIBRARIES "${FFTW_THREADS_LIBRARY}")
+endif()
@@ -5,6 +5,7 @@
 
 #include "HOOMDMath.h"
 #include "VectorMath.h"
+#include <algorithm>
 #include <stack>
 #include <vector>
 
@@ -39,6 +40,18 @@ const unsigned int INVALID_NODE = 0xffffffff; //!< Invalid node index sentinel
 
 #ifndef __HIPCC__
 
+//! Bit of a particle type in the node type masks
+/*! \param type Particle type
+    \returns The bit of the type in an AABBNode type mask
+
+    Types 31 and above share the highest bit, so the masks remain conservative for any number of
+    types.
+*/
+inline unsigned int type_mask_bit(unsigned int type)
+    {
+    return 1u << std::min(type, 31u);
+    }
+
 //! Node in an AABBTree
 /*! Stores data for a node in the AABB tree
  */
@@ -50,6 +63,7 @@ struct PYBIND11_EXPORT AABBNode
         left = right = parent = INVALID_NODE;
         num_particles = 0;
         skip = 0;
+        type_mask = 0xffffffff;
         }
 
     AABB aabb;           //!< The box bounding this node's volume
@@ -63,6 +77,7 @@ struct PYBIND11_EXPORT AABBNode
     unsigned int
         particle_tags[NODE_CAPACITY]; //!< Corresponding particle tags for particles in node
     unsigned int num_particles;       //!< Number of particles contained in the node
+    unsigned int type_mask; //!< Bits (type_mask_bit) of the particle types in the node's subtree
     } __attribute__((aligned(32)));
 
 //! AABB Tree
@@ -164,9 +179,18 @@ class PYBIND11_EXPORT AABBTree
     //! Find all particles that overlap with the query AABB
     inline unsigned int query(std::vector<unsigned int>& hits, const AABB& aabb) const;
 
+    //! Recompute the node AABBs from a new list of AABBs without changing the topology
+    inline void refit(const AABB* aabbs, unsigned int N);
+
+    //! Get the sum of the surface areas of all nodes
+    inline Scalar getCost() const;
+
     //! Update the AABB of a particle
     inline void update(unsigned int idx, const AABB& aabb);
 
+    //! Set the type masks of the nodes
+    inline void setTypeMasks(const unsigned int* masks, unsigned int N);
+
     //! Get the height of a given particle's leaf node
     inline unsigned int height(unsigned int idx);
 
@@ -208,6 +232,14 @@ class PYBIND11_EXPORT AABBTree
         return (m_nodes[node].skip);
         }
 
+    //! Get the type mask of a given node
+    /*! \param node Index of the node (not the particle) to query
+     */
+    inline unsigned int getNodeTypeMask(unsigned int node) const
+        {
+        return (m_nodes[node].type_mask);
+        }
+
     //! Get the left child of a given node
     /*! \param node Index of the node (not the particle) to query
      */
@@ -354,6 +386,86 @@ inline void AABBTree::update(unsigned int idx, const AABB& aabb)
         }
     }
 
+/*! \param aabbs List of AABBs for each particle
+    \param N Number of AABBs in the list
+
+    Recompute the AABB of every leaf node from the AABBs of the particles it holds and the AABB of
+    every internal node from its children. refit() keeps the tree topology, so the caller must
+    ensure that \a aabbs lists the same particles, in the same order, as the last call to
+    buildTree(). The quality of the tree degrades as particles move away from their neighbors in
+    the leaf, which getCost() measures.
+*/
+inline void AABBTree::refit(const AABB* aabbs, unsigned int N)
+    {
+    assert(N == m_mapping.size());
+
+    // children are always allocated after their parents, walk the nodes from the leaves up
+    for (unsigned int node_idx = m_num_nodes; node_idx-- > 0;)
+        {
+        AABBNode& node = m_nodes[node_idx];
+        if (isNodeLeaf(node_idx))
+            {
+            AABB aabb = aabbs[node.particles[0]];
+            for (unsigned int i = 1; i < node.num_particles; i++)
+                {
+                aabb = merge(aabb, aabbs[node.particles[i]]);
+                }
+            node.aabb = aabb;
+            }
+        else
+            {
+            node.aabb = merge(m_nodes[node.left].aabb, m_nodes[node.right].aabb);
+            }
+        }
+    }
+
+/*! \param masks Type mask bit (type_mask_bit) of each particle, in the order of the AABBs
+    \param N Number of particles
+
+    Sets the type mask of every node to the union of the types in its subtree. Traversals skip the
+   subtrees without types of interest, e.g. those that do not overlap with the query particle. Nodes
+   of a tree without type masks include all types. The masks are kept by refit() and must be set
+   again after buildTree().
+*/
+inline void AABBTree::setTypeMasks(const unsigned int* masks, unsigned int N)
+    {
+    assert(N == m_mapping.size());
+
+    // children are always allocated after their parents, walk the nodes from the leaves up
+    for (unsigned int node_idx = m_num_nodes; node_idx-- > 0;)
+        {
+        AABBNode& node = m_nodes[node_idx];
+        if (isNodeLeaf(node_idx))
+            {
+            unsigned int mask = 0;
+            for (unsigned int i = 0; i < node.num_particles; i++)
+                {
+                mask |= masks[node.particles[i]];
+                }
+            node.type_mask = mask;
+            }
+        else
+            {
+            node.type_mask = m_nodes[node.left].type_mask | m_nodes[node.right].type_mask;
+            }
+        }
+    }
+
+/*! \returns The sum of the surface areas of the node AABBs
+
+    The cost is proportional to the expected number of nodes a random query visits.
+*/
+inline Scalar AABBTree::getCost() const
+    {
+    Scalar cost = 0;
+    for (unsigned int node_idx = 0; node_idx < m_num_nodes; node_idx++)
+        {
+        vec3<Scalar> length = m_nodes[node_idx].aabb.getUpper() - m_nodes[node_idx].aabb.getLower();
+        cost += Scalar(2.0) * (length.x * length.y + length.y * length.z + length.z * length.x);
+        }
+    return cost;
+    }
+
 /*! \param idx Particle to get height for
     \returns Height of the node
 */
@@ -15,7 +15,8 @@ namespace py = pybind11;
     \post The Analyzer is constructed with the given particle data and a NULL profiler.
 */
 Analyzer::Analyzer(std::shared_ptr<SystemDefinition> sysdef)
-    : m_sysdef(sysdef), m_pdata(m_sysdef->getParticleData()), m_exec_conf(m_pdata->getExecConf())
+    : m_sysdef(sysdef), m_pdata(m_sysdef->getParticleData()), m_profile_name("Analyzer"),
+      m_exec_conf(m_pdata->getExecConf()), m_timer(m_exec_conf)
     {
     // sanity check
     assert(m_sysdef);
@@ -42,6 +43,9 @@ void export_Analyzer(py::module& m)
         .def(py::init<std::shared_ptr<SystemDefinition>>())
         .def("analyze", &Analyzer::analyze)
         .def("setProfiler", &Analyzer::setProfiler)
+        .def("setProfileName", &Analyzer::setProfileName)
+        .def("getProfileName", &Analyzer::getProfileName)
+        .def("getRunTime", &Analyzer::getRunTime)
         .def("notifyDetach", &Analyzer::notifyDetach)
 #ifdef ENABLE_MPI
         .def("setCommunicator", &Analyzer::setCommunicator)
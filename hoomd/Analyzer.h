@@ -17,11 +17,13 @@
 #define __ANALYZER_H__
 
 #include "Communicator.h"
+#include "OperationTimer.h"
 #include "Profiler.h"
 #include "SharedSignal.h"
 #include "SystemDefinition.h"
 
 #include <memory>
+#include <string>
 #include <typeinfo>
 
 /*! \ingroup hoomd_lib
@@ -81,6 +83,41 @@ class PYBIND11_EXPORT Analyzer
     //! Sets the profiler for the analyzer to use
     void setProfiler(std::shared_ptr<Profiler> prof);
 
+    //! Set the name of this analyzer in profiles
+    /*! \param name Name to use, Python passes the class name of the operation
+     */
+    void setProfileName(const std::string& name)
+        {
+        m_profile_name = name;
+        }
+
+    //! Get the name of this analyzer in profiles
+    const std::string& getProfileName() const
+        {
+        return m_profile_name;
+        }
+
+    //! Get the timer of this analyzer
+    OperationTimer& getTimer()
+        {
+        return m_timer;
+        }
+
+    //! Get the time in seconds this analyzer has spent executing during the current run
+    double getRunTime()
+        {
+        return m_timer.getTime();
+        }
+
+    //! Discard the times measured by this analyzer
+    /*! System calls resetTimers() at the start of each run. Derived classes that time other
+        operations on their behalf should reset those as well.
+    */
+    virtual void resetTimers()
+        {
+        m_timer.reset();
+        }
+
     //! Set autotuner parameters
     /*! \param enable Enable/disable autotuning
         \param period period (approximate) in time steps when returning occurs
@@ -96,6 +133,12 @@ class PYBIND11_EXPORT Analyzer
     */
     virtual void resetStats() { }
 
+    //! Complete any buffered output
+    /*! System calls flush() at the end of every run(). Derived classes that defer output should
+        override this method and return only after the output is complete.
+    */
+    virtual void flush() { }
+
     //! Get needed pdata flags
     /*! Not all fields in ParticleData are computed by default. When derived classes need one of
        these optional fields, they must return the requested fields in getRequestedPDataFlags().
@@ -150,6 +193,7 @@ class PYBIND11_EXPORT Analyzer
     const std::shared_ptr<ParticleData>
         m_pdata;                      //!< The particle data this analyzer is associated with
     std::shared_ptr<Profiler> m_prof; //!< The profiler this analyzer is to use
+    std::string m_profile_name;       //!< Name of this analyzer in profiles
 
 #ifdef ENABLE_MPI
     std::shared_ptr<Communicator> m_comm; //!< The communicator to use
@@ -158,7 +202,8 @@ class PYBIND11_EXPORT Analyzer
     std::shared_ptr<const ExecutionConfiguration>
         m_exec_conf; //!< Stored shared ptr to the execution configuration
     std::vector<std::shared_ptr<hoomd::detail::SignalSlot>>
-        m_slots; //!< Stored shared ptr to the system signals
+        m_slots;            //!< Stored shared ptr to the system signals
+    OperationTimer m_timer; //!< Time spent executing during the current run
     };
 
 //! Export the Analyzer class to python
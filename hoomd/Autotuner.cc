@@ -56,7 +56,13 @@ Autotuner::Autotuner(const std::vector<unsigned int>& parameters,
         m_samples[i].resize(m_nsamples);
         }
 
-    m_current_param = m_parameters[m_current_element];
+    // sample all parameters in the initial scan
+    m_measured.resize(m_parameters.size(), false);
+    m_active.resize(m_parameters.size());
+    for (unsigned int i = 0; i < m_parameters.size(); i++)
+        m_active[i] = i;
+
+    m_current_param = m_parameters[m_active[m_current_element]];
 
 // create CUDA events
 #ifdef ENABLE_HIP
@@ -122,7 +128,13 @@ Autotuner::Autotuner(unsigned int start,
         m_samples[i].resize(m_nsamples);
         }
 
-    m_current_param = m_parameters[m_current_element];
+    // sample all parameters in the initial scan
+    m_measured.resize(m_parameters.size(), false);
+    m_active.resize(m_parameters.size());
+    for (unsigned int i = 0; i < m_parameters.size(); i++)
+        m_active[i] = i;
+
+    m_current_param = m_parameters[m_active[m_current_element]];
 
 // create CUDA events
 #ifdef ENABLE_HIP
@@ -137,6 +149,7 @@ Autotuner::Autotuner(unsigned int start,
 Autotuner::~Autotuner()
     {
     m_exec_conf->msg->notice(5) << "Destroying Autotuner " << m_name << endl;
+    finishScan();
 #ifdef ENABLE_HIP
     hipEventDestroy(m_start);
     hipEventDestroy(m_stop);
@@ -150,11 +163,25 @@ void Autotuner::begin()
     if (!m_enabled)
         return;
 
+    // use a cached result in place of the initial scan
+    if (!m_cache_checked)
+        {
+        m_cache_checked = true;
+        if (m_state == STARTUP && m_current_element == 0 && m_current_sample == 0)
+            loadFromCache();
+
+        if (m_state == STARTUP)
+            {
+            m_exec_conf->getTuningCache().beginScan(m_name);
+            m_scan_counted = true;
+            }
+        }
+
 #ifdef ENABLE_HIP
     // if we are scanning, record a cuda event - otherwise do nothing
     if (m_state == STARTUP || m_state == SCANNING)
         {
-        hipEventRecord(m_start, 0);
+        hipEventRecord(m_start, m_stream);
         if (this->m_exec_conf->isCUDAErrorCheckingEnabled())
             CHECK_CUDA_ERROR();
         }
@@ -171,12 +198,12 @@ void Autotuner::end()
     // handle timing updates if scanning
     if (m_state == STARTUP || m_state == SCANNING)
         {
-        hipEventRecord(m_stop, 0);
+        hipEventRecord(m_stop, m_stream);
         hipEventSynchronize(m_stop);
-        hipEventElapsedTime(&m_samples[m_current_element][m_current_sample], m_start, m_stop);
-        m_exec_conf->msg->notice(9)
-            << "Autotuner " << m_name << ": t(" << m_current_param << "," << m_current_sample
-            << ") = " << m_samples[m_current_element][m_current_sample] << endl;
+        float& sample = m_samples[m_active[m_current_element]][m_current_sample];
+        hipEventElapsedTime(&sample, m_start, m_stop);
+        m_exec_conf->msg->notice(9) << "Autotuner " << m_name << ": t(" << m_current_param << ","
+                                    << m_current_sample << ") = " << sample << endl;
 
         if (this->m_exec_conf->isCUDAErrorCheckingEnabled())
             CHECK_CUDA_ERROR();
@@ -193,20 +220,35 @@ void Autotuner::end()
         if (m_current_sample >= m_nsamples)
             {
             m_current_sample = 0;
+            m_measured[m_active[m_current_element]] = true;
             m_current_element++;
 
-            // if we hit the end of the elements, transition to the IDLE state and compute the
-            // optimal parameter
-            if (m_current_element >= m_parameters.size())
+            // if we hit the end of the elements, choose the next elements to sample. When the
+            // search is complete, transition to the IDLE state and compute the optimal parameter
+            if (m_current_element >= m_active.size())
                 {
                 m_current_element = 0;
-                m_state = IDLE;
-                m_current_param = computeOptimalParameter();
+                if (!advanceSearch())
+                    {
+                    m_state = IDLE;
+                    m_current_param = computeOptimalParameter();
+                    finishScan();
+
+                    // later scans sample all measured elements
+                    m_active.clear();
+                    for (unsigned int i = 0; i < m_parameters.size(); i++)
+                        if (m_measured[i])
+                            m_active.push_back(i);
+                    }
+                else
+                    {
+                    m_current_param = m_parameters[m_active[m_current_element]];
+                    }
                 }
             else
                 {
                 // if moving on to the next element, update the cached parameter to set
-                m_current_param = m_parameters[m_current_element];
+                m_current_param = m_parameters[m_active[m_current_element]];
                 }
             }
         }
@@ -217,7 +259,7 @@ void Autotuner::end()
 
         // if we hit the end of the elements, transition to the IDLE state and compute the optimal
         // parameter, and move on to the next sample for next time
-        if (m_current_element >= m_parameters.size())
+        if (m_current_element >= m_active.size())
             {
             m_current_element = 0;
             m_state = IDLE;
@@ -227,7 +269,7 @@ void Autotuner::end()
         else
             {
             // if moving on to the next element, update the cached parameter to set
-            m_current_param = m_parameters[m_current_element];
+            m_current_param = m_parameters[m_active[m_current_element]];
             }
         }
     else if (m_state == IDLE)
@@ -241,7 +283,7 @@ void Autotuner::end()
             m_calls = 0;
 
             // initialize a scan
-            m_current_param = m_parameters[m_current_element];
+            m_current_param = m_parameters[m_active[m_current_element]];
             m_state = SCANNING;
             m_exec_conf->msg->notice(4)
                 << "Autotuner " << m_name << " - beginning scan" << std::endl;
@@ -249,6 +291,194 @@ void Autotuner::end()
         }
     }
 
+/*! \param multipliers Place value of each packed sub-parameter, from the most to the least
+    significant. The last multiplier must be 1.
+
+    For example, a kernel that packs its parameters as block_size*10000 + threads_per_particle
+    calls setDimensions({10000, 1}).
+
+    Must be called before the first call to begin().
+*/
+void Autotuner::setDimensions(const std::vector<unsigned int>& multipliers)
+    {
+    if (multipliers.size() == 0 || multipliers.back() != 1)
+        {
+        m_exec_conf->msg->error() << "Autotuner " << m_name
+                                  << ": the last dimension multiplier must be 1" << endl;
+        throw std::runtime_error("Error initializing autotuner");
+        }
+    for (unsigned int d = 1; d < multipliers.size(); d++)
+        {
+        if (multipliers[d - 1] % multipliers[d] != 0)
+            {
+            m_exec_conf->msg->error() << "Autotuner " << m_name
+                                      << ": each dimension multiplier must divide the previous"
+                                      << endl;
+            throw std::runtime_error("Error initializing autotuner");
+            }
+        }
+
+    m_multipliers = multipliers;
+    m_current_element = 0;
+    m_current_sample = 0;
+    m_search_dim = 0;
+
+    // start the search with a line through the first parameter
+    m_active = getLine(0, 0);
+    m_current_param = m_parameters[m_active[m_current_element]];
+    }
+
+/*! \param p Packed parameter
+    \param d Dimension
+    \returns The value of sub-parameter \a d of \a p
+*/
+unsigned int Autotuner::getCoordinate(unsigned int p, unsigned int d) const
+    {
+    unsigned int value = p / m_multipliers[d];
+    if (d > 0)
+        value %= m_multipliers[d - 1] / m_multipliers[d];
+    return value;
+    }
+
+/*! \param idx Index of a parameter
+    \param d Dimension
+    \returns The indices of all parameters that differ from parameter \a idx only in dimension \a d
+*/
+std::vector<unsigned int> Autotuner::getLine(unsigned int idx, unsigned int d) const
+    {
+    std::vector<unsigned int> line;
+    for (unsigned int i = 0; i < m_parameters.size(); i++)
+        {
+        bool on_line = true;
+        for (unsigned int k = 0; k < m_multipliers.size(); k++)
+            {
+            if (k != d
+                && getCoordinate(m_parameters[i], k) != getCoordinate(m_parameters[idx], k))
+                {
+                on_line = false;
+                break;
+                }
+            }
+        if (on_line)
+            line.push_back(i);
+        }
+    return line;
+    }
+
+/*! \returns true when there are more elements to sample during the initial scan
+
+    Exhaustive searches sample all elements in a single pass. The coordinate descent search
+    samples the parameters along one dimension at a time, through the fastest parameter found so
+    far. It completes when every line through the fastest parameter has been sampled, so the
+    result is optimal along each dimension.
+*/
+bool Autotuner::advanceSearch()
+    {
+    if (m_multipliers.size() == 0)
+        return false;
+
+    // computeOptimalParameter synchronizes the result across ranks, so all ranks walk the same path
+    unsigned int opt = computeOptimalParameter();
+    unsigned int best = (unsigned int)(std::find(m_parameters.begin(), m_parameters.end(), opt)
+                                       - m_parameters.begin());
+
+    for (unsigned int i = 0; i < m_multipliers.size(); i++)
+        {
+        m_search_dim = (m_search_dim + 1) % (unsigned int)m_multipliers.size();
+
+        m_active.clear();
+        for (unsigned int idx : getLine(best, m_search_dim))
+            if (!m_measured[idx])
+                m_active.push_back(idx);
+
+        if (m_active.size() > 0)
+            {
+            m_exec_conf->msg->notice(6) << "Autotuner " << m_name << " searching dimension "
+                                        << m_search_dim << " through " << opt << endl;
+            return true;
+            }
+        }
+
+    return false;
+    }
+
+void Autotuner::finishScan()
+    {
+    if (m_scan_counted)
+        {
+        m_exec_conf->getTuningCache().endScan(m_name);
+        m_scan_counted = false;
+        }
+    }
+
+std::string Autotuner::getCacheKey() const
+    {
+#ifdef ENABLE_HIP
+    std::string device = m_exec_conf->isCUDAEnabled() ? m_exec_conf->dev_prop.name : "cpu";
+#else
+    std::string device = "cpu";
+#endif
+    return hoomd::detail::AutotunerCache::makeKey(m_name, device, m_size_bucket, m_parameters);
+    }
+
+/*! When the tuning cache has an entry for this autotuner, seed the samples of the cached parameter
+    with the cached time and the samples of all other parameters with FLT_MAX, then transition to
+    the IDLE state. Later periodic scans replace the seeded samples with measured ones.
+
+    With MPI synchronization enabled, the root rank decides whether to use the cache so that all
+    ranks stay in the same state.
+*/
+void Autotuner::loadFromCache()
+    {
+    hoomd::detail::AutotunerCache::Entry entry;
+    bool found = m_exec_conf->getTuningCache().find(getCacheKey(), entry);
+
+#ifdef ENABLE_MPI
+    if (m_sync && m_exec_conf->getNRanks() > 1)
+        {
+        bcast(found, 0, m_exec_conf->getMPICommunicator());
+        bcast(entry.param, 0, m_exec_conf->getMPICommunicator());
+        bcast(entry.time, 0, m_exec_conf->getMPICommunicator());
+        }
+#endif
+
+    if (!found)
+        return;
+
+    auto it = std::find(m_parameters.begin(), m_parameters.end(), entry.param);
+    if (it == m_parameters.end())
+        return;
+
+    unsigned int idx = (unsigned int)(it - m_parameters.begin());
+    for (unsigned int i = 0; i < m_parameters.size(); i++)
+        {
+        float t = (i == idx) ? entry.time : FLT_MAX;
+        std::fill(m_samples[i].begin(), m_samples[i].end(), t);
+        m_sample_median[i] = t;
+        }
+
+    // rescan all parameters, or only the lines through the cached parameter in a multi-dimensional
+    // search
+    std::fill(m_measured.begin(), m_measured.end(), m_multipliers.size() == 0);
+    for (unsigned int d = 0; d < m_multipliers.size(); d++)
+        for (unsigned int i : getLine(idx, d))
+            m_measured[i] = true;
+
+    m_active.clear();
+    for (unsigned int i = 0; i < m_parameters.size(); i++)
+        if (m_measured[i])
+            m_active.push_back(i);
+
+    m_current_element = 0;
+    m_current_sample = 0;
+    m_calls = 0;
+    m_state = IDLE;
+    m_current_param = entry.param;
+
+    m_exec_conf->msg->notice(4) << "Autotuner " << m_name << " using cached parameter "
+                                << m_current_param << endl;
+    }
+
 /*! \returns The optimal parameter given the current data in m_samples
 
     computeOptimalParameter computes the median time among all samples for a given element. It then
@@ -272,6 +502,13 @@ unsigned int Autotuner::computeOptimalParameter()
     std::vector<float> v;
     for (unsigned int i = 0; i < m_parameters.size(); i++)
         {
+        // skip parameters that the search has not sampled
+        if (!m_measured[i])
+            {
+            m_sample_median[i] = FLT_MAX;
+            continue;
+            }
+
         v = m_samples[i];
 #ifdef ENABLE_MPI
         if (m_sync && nranks)
@@ -326,12 +563,12 @@ unsigned int Autotuner::computeOptimalParameter()
     if (is_root)
         {
         // now find the minimum and maximum times in the medians
-        float min = m_sample_median[0];
+        float min = FLT_MAX;
         unsigned int min_idx = 0;
         // float max = m_sample_median[0];
         // unsigned int max_idx = 0;
 
-        for (unsigned int i = 1; i < m_parameters.size(); i++)
+        for (unsigned int i = 0; i < m_parameters.size(); i++)
             {
             if (m_sample_median[i] < min)
                 {
@@ -352,6 +589,8 @@ unsigned int Autotuner::computeOptimalParameter()
         // print stats
         m_exec_conf->msg->notice(4)
             << "Autotuner " << m_name << " found optimal parameter " << opt << endl;
+
+        m_exec_conf->getTuningCache().store(getCacheKey(), {opt, min});
         }
 
 #ifdef ENABLE_MPI
@@ -44,6 +44,19 @@
 
     Each Autotuner instance has a string name to help identify it's output on the notice stream.
 
+    Autotuners store the result of each scan in the tuning cache of the ExecutionConfiguration. The
+   first call to begin() looks up the cache and, when it finds a match, uses the cached parameter
+   and skips the initial scan. Entries are keyed by the name, the GPU model, the valid parameters,
+   and the problem size bucket set by setProblemSize() (floor(log2(N))), so callers whose optimal
+   parameters depend on the system size should call setProblemSize() before begin().
+
+    By default, the initial scan samples every valid parameter. Kernels that pack several
+   sub-parameters into one value (such as block_size*10000 + threads_per_particle) can call
+   setDimensions() to search with coordinate descent instead: the scan samples the parameters along
+   one dimension at a time, through the fastest parameter found so far, until the result is
+   optimal along every dimension. Periodic scans then sample only the parameters visited by the
+   search.
+
     Autotuner is not useful in non-GPU builds. Timing is performed with CUDA events and requires
    ENABLE_HIP=on. Behavior of Autotuner is undefined when ENABLE_HIP=off.
 
@@ -118,6 +131,7 @@ class PYBIND11_EXPORT Autotuner
                 {
                 m_exec_conf->msg->notice(2) << "Disabling Autotuner " << m_name
                                             << " before initial scan completed!" << std::endl;
+                finishScan();
                 }
             else
                 {
@@ -176,6 +190,33 @@ class PYBIND11_EXPORT Autotuner
         mode_max         //!< Maximum
         };
 
+    //! Set the problem size used to key cached results
+    /*! \param N Number of elements processed by the kernel (typically the number of particles)
+     */
+    void setProblemSize(unsigned int N)
+        {
+        int bucket = 0;
+        while (N >>= 1)
+            bucket++;
+        m_size_bucket = bucket;
+        }
+
+    //! Search the parameters with coordinate descent
+    void setDimensions(const std::vector<unsigned int>& multipliers);
+
+    //! Get the key of this autotuner in the tuning cache
+    std::string getCacheKey() const;
+
+#ifdef ENABLE_HIP
+    //! Set the stream that the tuned kernels execute on
+    /*! \param stream Stream to record the timing events on
+     */
+    void setStream(hipStream_t stream)
+        {
+        m_stream = stream;
+        }
+#endif
+
     //! Set sampling mode
     /*! \param avg If true, use average maximum instead of median of samples to compute kernel time
      */
@@ -201,6 +242,21 @@ class PYBIND11_EXPORT Autotuner
     protected:
     unsigned int computeOptimalParameter();
 
+    //! Initialize the state from the tuning cache
+    void loadFromCache();
+
+    //! Remove this autotuner from the count of initial scans in the tuning cache
+    void finishScan();
+
+    //! Choose the next elements to sample in the initial scan
+    bool advanceSearch();
+
+    //! Get the value of one sub-parameter of a packed parameter
+    unsigned int getCoordinate(unsigned int p, unsigned int d) const;
+
+    //! Get the parameters on a line through a parameter
+    std::vector<unsigned int> getLine(unsigned int idx, unsigned int d) const;
+
     //! State names
     enum State
         {
@@ -219,22 +275,32 @@ class PYBIND11_EXPORT Autotuner
     // state info
     State m_state;                  //!< Current state
     unsigned int m_current_sample;  //!< Current sample taken
-    unsigned int m_current_element; //!< Index of current parameter sampled
+    unsigned int m_current_element; //!< Index of current parameter sampled in m_active
     unsigned int m_calls;           //!< Count of the number of calls since the last sample
     unsigned int m_current_param;   //!< Value of the current parameter
 
     std::vector<std::vector<float>> m_samples; //!< Raw sample data for each element
     std::vector<float> m_sample_median;        //!< Current sample median for each element
+    std::vector<unsigned int> m_active;        //!< Indices of the elements to sample in a scan
+    std::vector<bool> m_measured;              //!< True for elements with a complete set of samples
+
+    std::vector<unsigned int> m_multipliers; //!< Place value of each dimension, empty when flat
+    unsigned int m_search_dim = 0;           //!< Dimension searched by the coordinate descent
 
     std::shared_ptr<const ExecutionConfiguration> m_exec_conf; //!< Execution configuration
 
 #ifdef ENABLE_HIP
-    hipEvent_t m_start; //!< CUDA event for recording start times
-    hipEvent_t m_stop;  //!< CUDA event for recording end times
+    hipEvent_t m_start;       //!< CUDA event for recording start times
+    hipEvent_t m_stop;        //!< CUDA event for recording end times
+    hipStream_t m_stream = 0; //!< Stream the timing events are recorded on
 #endif
 
     bool m_sync;      //!< If true, synchronize results via MPI
     mode_Enum m_mode; //!< The sampling mode
+
+    int m_size_bucket = -1;      //!< Problem size bucket, -1 when not set
+    bool m_cache_checked = false; //!< True after the tuning cache has been searched
+    bool m_scan_counted = false;  //!< True while the tuning cache counts this initial scan
     };
 
 //! Export the Autotuner class to python
@@ -0,0 +1,119 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "AutotunerCache.h"
+
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+
+namespace hoomd
+    {
+namespace detail
+    {
+static const char cache_header[] = "# HOOMD-blue autotuner cache 1";
+
+bool AutotunerCache::find(const std::string& key, Entry& entry) const
+    {
+    if (!m_read_enabled)
+        return false;
+
+    return get(key, entry);
+    }
+
+bool AutotunerCache::get(const std::string& key, Entry& entry) const
+    {
+    auto it = m_entries.find(key);
+    if (it == m_entries.end())
+        return false;
+
+    entry = it->second;
+    return true;
+    }
+
+/*! \param filename File to read
+
+    Entries in the file replace existing entries with the same key.
+*/
+void AutotunerCache::load(const std::string& filename)
+    {
+    std::ifstream f(filename.c_str());
+    if (!f.good())
+        throw std::runtime_error("Error opening autotuner cache " + filename);
+
+    std::string line;
+    std::getline(f, line);
+    if (line != cache_header)
+        throw std::runtime_error("Invalid autotuner cache " + filename);
+
+    while (std::getline(f, line))
+        {
+        if (line.empty() || line[0] == '#')
+            continue;
+
+        size_t tab_time = line.rfind('\t');
+        size_t tab_param = tab_time == std::string::npos ? std::string::npos
+                                                         : line.rfind('\t', tab_time - 1);
+        if (tab_param == std::string::npos || tab_param == 0)
+            throw std::runtime_error("Invalid entry in autotuner cache " + filename);
+
+        Entry entry;
+        std::istringstream values(line.substr(tab_param + 1));
+        if (!(values >> entry.param >> entry.time))
+            throw std::runtime_error("Invalid entry in autotuner cache " + filename);
+
+        m_entries[line.substr(0, tab_param)] = entry;
+        }
+    }
+
+void AutotunerCache::save(const std::string& filename) const
+    {
+    std::ofstream f(filename.c_str());
+    if (!f.good())
+        throw std::runtime_error("Error opening autotuner cache " + filename);
+
+    f << cache_header << std::endl;
+    f << std::setprecision(9);
+    for (const auto& key_entry : m_entries)
+        {
+        f << key_entry.first << '\t' << key_entry.second.param << '\t' << key_entry.second.time
+          << '\n';
+        }
+
+    if (!f.good())
+        throw std::runtime_error("Error writing autotuner cache " + filename);
+    }
+
+/*! The key combines the autotuner name, the GPU model, the problem size bucket, and a hash of the
+    valid parameters so that a change to the parameter space invalidates old entries.
+*/
+std::string AutotunerCache::makeKey(const std::string& name,
+                                    const std::string& device,
+                                    int size_bucket,
+                                    const std::vector<unsigned int>& parameters)
+    {
+    // FNV-1a hash of the parameter list
+    uint64_t hash = 14695981039346656037ull;
+    for (unsigned int p : parameters)
+        {
+        for (unsigned int b = 0; b < sizeof(unsigned int); b++)
+            {
+            hash ^= (p >> (8 * b)) & 0xff;
+            hash *= 1099511628211ull;
+            }
+        }
+
+    std::ostringstream s;
+    s << name << '|' << device << '|';
+    if (size_bucket >= 0)
+        s << "N" << size_bucket;
+    else
+        s << "any";
+    s << '|' << parameters.size() << ':' << std::hex << std::setw(16) << std::setfill('0')
+      << hash;
+    return s.str();
+    }
+
+    } // namespace detail
+    } // namespace hoomd
@@ -0,0 +1,143 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#pragma once
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include <cstdint>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <pybind11/pybind11.h>
+
+namespace hoomd
+    {
+namespace detail
+    {
+/// Store the results of Autotuner scans for reuse in later simulations
+/*! Each entry maps a key that identifies the tuned kernel (see makeKey()) to the optimal parameter
+    and the time it took. ExecutionConfiguration owns one cache that all Autotuner instances share.
+    Autotuners look up their key before the initial scan and skip the scan when there is a match.
+
+    The cache is stored on disk as a text file with one tab separated entry per line.
+
+    The cache also counts the autotuners that are in their initial scan, so that callers can run a
+    simulation until every kernel it launches is tuned (see hoomd.tune.benchmark).
+*/
+class PYBIND11_EXPORT AutotunerCache
+    {
+    public:
+    /// A cached tuning result
+    struct Entry
+        {
+        unsigned int param; //!< Optimal parameter
+        float time;         //!< Kernel time with the optimal parameter (ms)
+        };
+
+    /// Find an entry
+    /*! \param key Key to search for
+        \param entry Set to the entry when found
+
+        \returns true when there is an entry for \a key
+    */
+    bool find(const std::string& key, Entry& entry) const;
+
+    /// Get an entry even when reading is disabled
+    /*! \param key Key to search for
+        \param entry Set to the entry when found
+
+        \returns true when there is an entry for \a key
+    */
+    bool get(const std::string& key, Entry& entry) const;
+
+    /// Add or replace an entry
+    void store(const std::string& key, const Entry& entry)
+        {
+        m_entries[key] = entry;
+        m_updated.insert(key);
+        }
+
+    /// Get the keys stored since the last call to clearUpdated()
+    const std::set<std::string>& getUpdated() const
+        {
+        return m_updated;
+        }
+
+    /// Forget which keys have been stored
+    void clearUpdated()
+        {
+        m_updated.clear();
+        }
+
+    /// Set whether find() returns cached entries
+    /*! \param enable When false, find() reports no entries so that autotuners always scan. Scans
+                      still store their results.
+    */
+    void setReadEnabled(bool enable)
+        {
+        m_read_enabled = enable;
+        }
+
+    /// Record that an autotuner started its initial scan
+    void beginScan(const std::string& name)
+        {
+        m_scanning.insert(name);
+        }
+
+    /// Record that an autotuner finished or abandoned its initial scan
+    void endScan(const std::string& name)
+        {
+        auto it = m_scanning.find(name);
+        if (it != m_scanning.end())
+            m_scanning.erase(it);
+        }
+
+    /// Get the names of the autotuners in their initial scan
+    const std::multiset<std::string>& getScanning() const
+        {
+        return m_scanning;
+        }
+
+    /// Add the entries in a file to the cache
+    void load(const std::string& filename);
+
+    /// Write all entries to a file
+    void save(const std::string& filename) const;
+
+    /// Remove all entries
+    void clear()
+        {
+        m_entries.clear();
+        }
+
+    /// Get the number of entries
+    size_t size() const
+        {
+        return m_entries.size();
+        }
+
+    /// Build a cache key
+    /*! \param name Name of the autotuner
+        \param device Name of the GPU model
+        \param size_bucket Problem size bucket, or -1 when the autotuner does not set one
+        \param parameters Valid parameters of the autotuner
+    */
+    static std::string makeKey(const std::string& name,
+                               const std::string& device,
+                               int size_bucket,
+                               const std::vector<unsigned int>& parameters);
+
+    private:
+    std::map<std::string, Entry> m_entries; //!< Cached entries
+    std::set<std::string> m_updated;        //!< Keys stored since the last clearUpdated()
+    std::multiset<std::string> m_scanning;  //!< Names of the autotuners in their initial scan
+    bool m_read_enabled = true;             //!< When false, find() reports no entries
+    };
+
+    } // namespace detail
+    } // namespace hoomd
@@ -0,0 +1,103 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "BackgroundWriter.h"
+
+namespace hoomd
+    {
+namespace detail
+    {
+void BackgroundWriter::enqueue(std::function<void()> job)
+    {
+    if (!m_thread.joinable())
+        {
+        m_stop = false;
+        m_thread = std::thread(&BackgroundWriter::run, this);
+        }
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_cv.wait(lock, [this] { return m_queue.size() < m_max_queued; });
+    m_queue.push_back(std::move(job));
+    lock.unlock();
+
+    m_cv.notify_all();
+    }
+
+void BackgroundWriter::flush()
+    {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_cv.wait(lock, [this] { return m_queue.empty(); });
+    lock.unlock();
+
+    checkError();
+    }
+
+void BackgroundWriter::stop()
+    {
+    if (!m_thread.joinable())
+        return;
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_stop = true;
+    lock.unlock();
+
+    m_cv.notify_all();
+    m_thread.join();
+    m_stop = false;
+    }
+
+void BackgroundWriter::checkError()
+    {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    std::exception_ptr exception = m_exception;
+    m_exception = nullptr;
+    lock.unlock();
+
+    if (exception)
+        std::rethrow_exception(exception);
+    }
+
+bool BackgroundWriter::hasError()
+    {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    return bool(m_exception);
+    }
+
+bool BackgroundWriter::full()
+    {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    return m_queue.size() >= m_max_queued;
+    }
+
+void BackgroundWriter::run()
+    {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true)
+        {
+        m_cv.wait(lock, [this] { return m_stop || !m_queue.empty(); });
+        if (m_queue.empty())
+            break;
+
+        // references to deque elements remain valid while the main thread pushes new jobs
+        std::function<void()>& job = m_queue.front();
+        lock.unlock();
+        std::exception_ptr exception;
+        try
+            {
+            job();
+            }
+        catch (...)
+            {
+            exception = std::current_exception();
+            }
+        lock.lock();
+
+        m_queue.pop_front();
+        if (exception && !m_exception)
+            m_exception = exception;
+        m_cv.notify_all();
+        }
+    }
+
+    } // namespace detail
+    } // namespace hoomd
@@ -0,0 +1,90 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#pragma once
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#include <pybind11/pybind11.h>
+
+namespace hoomd
+    {
+namespace detail
+    {
+/// Perform file writes on a background thread
+/*! Writers stage a frame in memory and enqueue a job that writes it. The jobs run in order on a
+    single background thread, which is started by the first call to enqueue(). At most
+    max_queued jobs are buffered; enqueue() blocks when the queue is full.
+
+    Exceptions thrown by a job are stored, and rethrown on the calling thread by the next call to
+    checkError() or flush(). The jobs queued after a failed job still run.
+*/
+class PYBIND11_EXPORT BackgroundWriter
+    {
+    public:
+    /// Construct the writer
+    /*! \param max_queued Maximum number of buffered jobs
+     */
+    BackgroundWriter(unsigned int max_queued = 2) : m_max_queued(max_queued) { }
+
+    /// Destructor, runs all queued jobs
+    ~BackgroundWriter()
+        {
+        stop();
+        }
+
+    /// Queue a job, blocking while the queue is full
+    void enqueue(std::function<void()> job);
+
+    /// Wait for all queued jobs to complete and rethrow any error
+    void flush();
+
+    /// Wait for all queued jobs to complete and join the background thread
+    void stop();
+
+    /// Rethrow the first exception thrown by a job
+    void checkError();
+
+    /// Test if a job threw an exception that has not been rethrown
+    bool hasError();
+
+    /// Test if the queue is full, so that enqueue() would block
+    bool full();
+
+    private:
+    /// Jobs waiting to run, the front job is running
+    std::deque<std::function<void()>> m_queue;
+
+    /// Maximum number of buffered jobs
+    unsigned int m_max_queued;
+
+    /// Background thread that runs the jobs in m_queue
+    std::thread m_thread;
+
+    /// Protects m_queue, m_stop, and m_exception
+    std::mutex m_mutex;
+
+    /// Signals changes to m_queue
+    std::condition_variable m_cv;
+
+    /// Set to true to stop the background thread
+    bool m_stop = false;
+
+    /// First exception thrown by a job
+    std::exception_ptr m_exception;
+
+    /// Background thread loop
+    void run();
+    };
+
+    } // namespace detail
+    } // namespace hoomd
@@ -13,6 +13,8 @@
 
 #include <pybind11/numpy.h>
 
+#include <algorithm>
+
 #ifdef ENABLE_HIP
 #include "BondedGroupData.cuh"
 #include "CachedAllocator.h"
@@ -50,8 +52,8 @@ BondedGroupData<group_size, Group, name, has_type_mapping>::BondedGroupData(
     // connect to particle sort signal
     m_pdata->getParticleSortSignal()
         .template connect<BondedGroupData<group_size, Group, name, has_type_mapping>,
-                          &BondedGroupData<group_size, Group, name, has_type_mapping>::setDirty>(
-            this);
+                          &BondedGroupData<group_size, Group, name, has_type_mapping>::
+                              slotParticleSort>(this);
 #ifdef ENABLE_MPI
     if (m_pdata->getDomainDecomposition())
         {
@@ -92,8 +94,8 @@ BondedGroupData<group_size, Group, name, has_type_mapping>::BondedGroupData(
     // connect to particle sort signal
     m_pdata->getParticleSortSignal()
         .template connect<BondedGroupData<group_size, Group, name, has_type_mapping>,
-                          &BondedGroupData<group_size, Group, name, has_type_mapping>::setDirty>(
-            this);
+                          &BondedGroupData<group_size, Group, name, has_type_mapping>::
+                              slotParticleSort>(this);
 
     // initialize from snapshot
     initializeFromSnapshot(snapshot);
@@ -116,8 +118,8 @@ BondedGroupData<group_size, Group, name, has_type_mapping>::~BondedGroupData()
     {
     m_pdata->getParticleSortSignal()
         .template disconnect<BondedGroupData<group_size, Group, name, has_type_mapping>,
-                             &BondedGroupData<group_size, Group, name, has_type_mapping>::setDirty>(
-            this);
+                             &BondedGroupData<group_size, Group, name, has_type_mapping>::
+                                 slotParticleSort>(this);
 #ifdef ENABLE_MPI
     m_pdata->getSingleParticleMoveSignal()
         .template disconnect<
@@ -215,6 +217,23 @@ template<unsigned int group_size, typename Group, const char* name, bool has_typ
 void BondedGroupData<group_size, Group, name, has_type_mapping>::initializeFromSnapshot(
     const Snapshot& snapshot)
     {
+    initializeFromReplicatedSnapshot(snapshot, 1, 0);
+    }
+
+/*! \param snapshot Snapshot of the groups in the unit cell
+    \param n Number of periodic images of the unit cell
+    \param n_particles Number of particles in the unit cell
+
+    Add the groups of \a snapshot once for every image, offsetting the member tags by \a n_particles
+   per image. The groups are in the same order as in Snapshot::replicate(). In MPI simulations, only
+   the unit cell is broadcast and every rank keeps the groups with local members.
+*/
+template<unsigned int group_size, typename Group, const char* name, bool has_type_mapping>
+void BondedGroupData<group_size, Group, name, has_type_mapping>::initializeFromReplicatedSnapshot(
+    const Snapshot& snapshot,
+    unsigned int n,
+    unsigned int n_particles)
+    {
     // check that all fields in the snapshot have correct length
     if (m_exec_conf->getRank() == 0 && !snapshot.validate())
         {
@@ -267,32 +286,42 @@ void BondedGroupData<group_size, Group, name, has_type_mapping>::initializeFromS
         bcast(m_type_mapping, 0, m_exec_conf->getMPICommunicator());
 
         // iterate over groups and add those that have local particles
-        for (unsigned int group_tag = 0; group_tag < all_groups.size(); ++group_tag)
-            addBondedGroup(Group(all_typeval[group_tag], all_groups[group_tag]));
+        for (unsigned int image = 0; image < n; ++image)
+            {
+            for (unsigned int group_idx = 0; group_idx < all_groups.size(); ++group_idx)
+                {
+                members_t members = all_groups[group_idx];
+                for (unsigned int k = 0; k < group_size; ++k)
+                    members.tag[k] += image * n_particles;
+                addBondedGroup(Group(all_typeval[group_idx], members));
+                }
+            }
         }
     else
 #endif
         {
         m_type_mapping = snapshot.type_mapping;
 
-        if (has_type_mapping)
-            {
-            // create bonded groups with types
-            for (unsigned group_idx = 0; group_idx < snapshot.groups.size(); group_idx++)
-                {
-                typeval_t t;
-                t.type = snapshot.type_id[group_idx];
-                addBondedGroup(Group(t, snapshot.groups[group_idx]));
-                }
-            }
-        else
+        for (unsigned int image = 0; image < n; ++image)
             {
-            // create constraints
             for (unsigned group_idx = 0; group_idx < snapshot.groups.size(); group_idx++)
                 {
                 typeval_t t;
-                t.val = snapshot.val[group_idx];
-                addBondedGroup(Group(t, snapshot.groups[group_idx]));
+                if (has_type_mapping)
+                    {
+                    // create bonded groups with types
+                    t.type = snapshot.type_id[group_idx];
+                    }
+                else
+                    {
+                    // create constraints
+                    t.val = snapshot.val[group_idx];
+                    }
+
+                members_t members = snapshot.groups[group_idx];
+                for (unsigned int k = 0; k < group_size; ++k)
+                    members.tag[k] += image * n_particles;
+                addBondedGroup(Group(t, members));
                 }
             }
         }
@@ -716,6 +745,110 @@ void BondedGroupData<group_size, Group, name, has_type_mapping>::maybe_rebuild_t
     m_invalid_cached_tags = false;
     }
 
+template<unsigned int group_size, typename Group, const char* name, bool has_type_mapping>
+void BondedGroupData<group_size, Group, name, has_type_mapping>::slotParticleSort()
+    {
+    // the GPU table is stored by particle index and needs no further sorting
+    if (m_exec_conf->isCUDAEnabled())
+        {
+        setDirty();
+        return;
+        }
+
+    sortGroups();
+    }
+
+/*! Sorts the local groups, and separately the ghost groups, by the lowest particle index among
+    their members. Loops over the groups then access the particle data in nearly sequential order.
+ */
+template<unsigned int group_size, typename Group, const char* name, bool has_type_mapping>
+void BondedGroupData<group_size, Group, name, has_type_mapping>::sortGroups()
+    {
+    const unsigned int n_groups = getN() + getNGhosts();
+    if (n_groups == 0)
+        {
+        setDirty();
+        return;
+        }
+
+    if (m_prof)
+        m_prof->push("sort " + std::string(name) + "s");
+
+    std::vector<std::pair<unsigned int, unsigned int>> order(n_groups);
+    std::vector<members_t> groups(n_groups);
+    std::vector<typeval_t> group_typeval(n_groups);
+    std::vector<unsigned int> group_tag(n_groups);
+
+        {
+        ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(),
+                                         access_location::host,
+                                         access_mode::read);
+        ArrayHandle<members_t> h_groups(m_groups, access_location::host, access_mode::read);
+        ArrayHandle<typeval_t> h_group_typeval(m_group_typeval,
+                                               access_location::host,
+                                               access_mode::read);
+        ArrayHandle<unsigned int> h_group_tag(m_group_tag,
+                                              access_location::host,
+                                              access_mode::read);
+
+        for (unsigned int i = 0; i < n_groups; i++)
+            {
+            unsigned int min_idx = NOT_LOCAL;
+            for (unsigned int j = 0; j < group_size; j++)
+                min_idx = std::min(min_idx, h_rtag.data[h_groups.data[i].tag[j]]);
+            order[i] = std::make_pair(min_idx, i);
+
+            groups[i] = h_groups.data[i];
+            group_typeval[i] = h_group_typeval.data[i];
+            group_tag[i] = h_group_tag.data[i];
+            }
+        }
+
+    // ghost groups must stay behind the local ones
+    std::sort(order.begin(), order.begin() + getN());
+    std::sort(order.begin() + getN(), order.end());
+
+        {
+        ArrayHandle<members_t> h_groups(m_groups, access_location::host, access_mode::overwrite);
+        ArrayHandle<typeval_t> h_group_typeval(m_group_typeval,
+                                               access_location::host,
+                                               access_mode::overwrite);
+        ArrayHandle<unsigned int> h_group_tag(m_group_tag,
+                                              access_location::host,
+                                              access_mode::overwrite);
+        ArrayHandle<unsigned int> h_group_rtag(m_group_rtag,
+                                               access_location::host,
+                                               access_mode::readwrite);
+
+        for (unsigned int i = 0; i < n_groups; i++)
+            {
+            unsigned int old_idx = order[i].second;
+            h_groups.data[i] = groups[old_idx];
+            h_group_typeval.data[i] = group_typeval[old_idx];
+            h_group_tag.data[i] = group_tag[old_idx];
+            h_group_rtag.data[group_tag[old_idx]] = i;
+            }
+        }
+
+#ifdef ENABLE_MPI
+    if (m_pdata->getDomainDecomposition())
+        {
+        ArrayHandle<ranks_t> h_group_ranks(m_group_ranks,
+                                           access_location::host,
+                                           access_mode::readwrite);
+        std::vector<ranks_t> group_ranks(h_group_ranks.data, h_group_ranks.data + n_groups);
+        for (unsigned int i = 0; i < n_groups; i++)
+            h_group_ranks.data[i] = group_ranks[order[i].second];
+        }
+#endif
+
+    // rebuild the GPU table and notify subscribers that the group indices have changed
+    notifyGroupReorder();
+
+    if (m_prof)
+        m_prof->pop();
+    }
+
 template<unsigned int group_size, typename Group, const char* name, bool has_type_mapping>
 void BondedGroupData<group_size, Group, name, has_type_mapping>::rebuildGPUTable()
     {
@@ -1114,6 +1247,9 @@ BondedGroupData<group_size, Group, name, has_type_mapping>::takeSnapshot(Snapsho
 
     snapshot.type_mapping = m_type_mapping;
 
+    // the snapshot matches the group data
+    snapshot.modified = false;
+
     return index;
     }
 
@@ -1384,6 +1520,7 @@ void BondedGroupData<group_size, Group, name, has_type_mapping>::Snapshot::repli
         }
 
     size = n * old_size;
+    modified = true;
     }
 
 /*! \returns a numpy array that wraps the type_id data element.
@@ -1397,6 +1534,7 @@ py::object BondedGroupData<group_size, Group, name, has_type_mapping>::Snapshot:
     assert(has_type_mapping);
     auto self_cpp
         = self.cast<BondedGroupData<group_size, Group, name, has_type_mapping>::Snapshot*>();
+    self_cpp->modified = true;
     return pybind11::array(self_cpp->type_id.size(), &self_cpp->type_id[0], self);
     }
 
@@ -1411,6 +1549,7 @@ py::object BondedGroupData<group_size, Group, name, has_type_mapping>::Snapshot:
     assert(!has_type_mapping);
     auto self_cpp
         = self.cast<BondedGroupData<group_size, Group, name, has_type_mapping>::Snapshot*>();
+    self_cpp->modified = true;
     return pybind11::array(self_cpp->val.size(), &self_cpp->val[0], self);
     }
 
@@ -1424,6 +1563,7 @@ py::object BondedGroupData<group_size, Group, name, has_type_mapping>::Snapshot:
     {
     auto self_cpp
         = self.cast<BondedGroupData<group_size, Group, name, has_type_mapping>::Snapshot*>();
+    self_cpp->modified = true;
     std::vector<size_t> dims(2);
     dims[0] = self_cpp->groups.size();
     dims[1] = group_size;
@@ -1448,6 +1588,7 @@ py::list BondedGroupData<group_size, Group, name, has_type_mapping>::Snapshot::g
 template<unsigned int group_size, typename Group, const char* name, bool has_type_mapping>
 void BondedGroupData<group_size, Group, name, has_type_mapping>::Snapshot::setTypes(py::list types)
     {
+    modified = true;
     type_mapping.resize(len(types));
 
     for (unsigned int i = 0; i < len(types); i++)
@@ -147,6 +147,7 @@ class BondedGroupData
         Snapshot()
             {
             size = 0;
+            modified = true;
             }
 
         //! Constructor
@@ -181,6 +182,7 @@ class BondedGroupData
                 }
             groups.resize(n_groups, def);
             size = n_groups;
+            modified = true;
             }
 
         //! Validate the snapshot
@@ -233,6 +235,11 @@ class BondedGroupData
         std::vector<members_t> groups;         //!< Stores the data for each group
         std::vector<std::string> type_mapping; //!< Names of group types
         unsigned int size;                     //!< Number of bonds in the snapshot
+
+        /// True when the groups may have been modified since takeSnapshot()
+        /** Accessing an array from Python sets it, since the numpy array is a writable view.
+         */
+        bool modified;
         };
 
     //! Constructor for empty BondedGroupData
@@ -246,6 +253,11 @@ class BondedGroupData
     //! Initialize from a snapshot
     virtual void initializeFromSnapshot(const Snapshot& snapshot);
 
+    //! Initialize from a snapshot of a unit cell that is replicated n times
+    void initializeFromReplicatedSnapshot(const Snapshot& snapshot,
+                                          unsigned int n,
+                                          unsigned int n_particles);
+
     //! Take a snapshot
     virtual std::map<unsigned int, unsigned int> takeSnapshot(Snapshot& snapshot) const;
 
@@ -672,6 +684,12 @@ class BondedGroupData
     //! Helper function to rebuild lookup by index table
     void rebuildGPUTable();
 
+    //! Called when the particles are sorted
+    void slotParticleSort();
+
+    //! Sort the group tables by the particle indices of their members
+    void sortGroups();
+
     //! Resize internal tables
     /*! \param new_size New size of local group tables, new_size = n_local + n_ghost
      */
@@ -86,7 +86,7 @@ class PYBIND11_EXPORT BoxResizeUpdater : public Updater
     /// Update box interpolation based on provided timestep
     virtual void update(uint64_t timestep);
 
-    private:
+    protected:
     pybind11::object m_py_box1;             ///< The python box assoc with min
     pybind11::object m_py_box2;             ///< The python box assoc with max
     BoxDim& m_box1;                         ///< C++ box assoc with min
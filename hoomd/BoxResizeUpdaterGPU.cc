@@ -0,0 +1,120 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file BoxResizeUpdaterGPU.cc
+    \brief Defines the BoxResizeUpdaterGPU class
+*/
+
+#ifdef ENABLE_HIP
+
+#include "BoxResizeUpdaterGPU.h"
+#include "BoxResizeUpdaterGPU.cuh"
+
+using namespace std;
+namespace py = pybind11;
+
+BoxResizeUpdaterGPU::BoxResizeUpdaterGPU(std::shared_ptr<SystemDefinition> sysdef,
+                                         pybind11::object box1,
+                                         pybind11::object box2,
+                                         std::shared_ptr<Variant> variant,
+                                         std::shared_ptr<ParticleGroup> group)
+    : BoxResizeUpdater(sysdef, box1, box2, variant, group)
+    {
+    m_exec_conf->msg->notice(5) << "Constructing BoxResizeUpdaterGPU" << endl;
+
+    if (!m_exec_conf->isCUDAEnabled())
+        {
+        throw std::runtime_error(
+            "Creating a BoxResizeUpdaterGPU with no GPU in the execution configuration");
+        }
+
+    unsigned int warp_size = m_exec_conf->dev_prop.warpSize;
+    m_tuner_scale.reset(
+        new Autotuner(warp_size, 1024, warp_size, 5, 100000, "box_resize_scale", m_exec_conf));
+    m_tuner_wrap.reset(
+        new Autotuner(warp_size, 1024, warp_size, 5, 100000, "box_resize_wrap", m_exec_conf));
+    }
+
+BoxResizeUpdaterGPU::~BoxResizeUpdaterGPU()
+    {
+    m_exec_conf->msg->notice(5) << "Destroying BoxResizeUpdaterGPU" << endl;
+    }
+
+/** Perform the needed calculations to scale the box size
+    \param timestep Current time step of the simulation
+*/
+void BoxResizeUpdaterGPU::update(uint64_t timestep)
+    {
+    Updater::update(timestep);
+    m_exec_conf->msg->notice(10) << "Box resize update" << endl;
+    if (m_prof)
+        m_prof->push(m_exec_conf, "BoxResize");
+
+    // first, compute the new box
+    BoxDim new_box = getCurrentBox(timestep);
+
+    // check if the current box size is the same
+    BoxDim cur_box = m_pdata->getGlobalBox();
+
+    // only change the box if there is a change in the box dimensions
+    if (new_box != cur_box)
+        {
+        // set the new box
+        m_pdata->setGlobalBox(new_box);
+
+        ArrayHandle<Scalar4> d_pos(m_pdata->getPositions(),
+                                   access_location::device,
+                                   access_mode::readwrite);
+
+            {
+            // scale the group members with the box
+            ArrayHandle<unsigned int> d_group_members(m_group->getIndexArray(),
+                                                      access_location::device,
+                                                      access_mode::read);
+
+            m_tuner_scale->begin();
+            gpu_box_resize_scale(d_pos.data,
+                                 d_group_members.data,
+                                 m_group->getNumMembers(),
+                                 cur_box,
+                                 new_box,
+                                 m_tuner_scale->getParam());
+            if (m_exec_conf->isCUDAErrorCheckingEnabled())
+                CHECK_CUDA_ERROR();
+            m_tuner_scale->end();
+            }
+
+        // ensure that the particles are still in their local boxes by wrapping them if they are
+        // not
+        ArrayHandle<int3> d_image(m_pdata->getImages(),
+                                  access_location::device,
+                                  access_mode::readwrite);
+
+        m_tuner_wrap->begin();
+        gpu_box_resize_wrap(d_pos.data,
+                            d_image.data,
+                            m_pdata->getN(),
+                            m_pdata->getBox(),
+                            m_tuner_wrap->getParam());
+        if (m_exec_conf->isCUDAErrorCheckingEnabled())
+            CHECK_CUDA_ERROR();
+        m_tuner_wrap->end();
+        }
+
+    if (m_prof)
+        m_prof->pop(m_exec_conf);
+    }
+
+void export_BoxResizeUpdaterGPU(py::module& m)
+    {
+    py::class_<BoxResizeUpdaterGPU, BoxResizeUpdater, std::shared_ptr<BoxResizeUpdaterGPU>>(
+        m,
+        "BoxResizeUpdaterGPU")
+        .def(pybind11::init<std::shared_ptr<SystemDefinition>,
+                            pybind11::object,
+                            pybind11::object,
+                            std::shared_ptr<Variant>,
+                            std::shared_ptr<ParticleGroup>>());
+    }
+
+#endif // ENABLE_HIP
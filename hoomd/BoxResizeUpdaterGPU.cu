@@ -0,0 +1,137 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file BoxResizeUpdaterGPU.cu
+    \brief Defines GPU kernel code for scaling particle positions with the box. Used by
+   BoxResizeUpdaterGPU.
+*/
+
+#include "BoxResizeUpdaterGPU.cuh"
+
+//! Scale the positions of the group members from the old to the new box
+/*! \param d_pos Particle positions
+    \param d_group_members Indices of the particles to scale
+    \param group_size Number of particles to scale
+    \param cur_box Global box the positions are currently in
+    \param new_box Global box to scale the positions into
+
+    One thread per group member maps the position to fractional coordinates in \a cur_box and
+    back to coordinates in \a new_box.
+*/
+__global__ void gpu_box_resize_scale_kernel(Scalar4* d_pos,
+                                            const unsigned int* d_group_members,
+                                            const unsigned int group_size,
+                                            const BoxDim cur_box,
+                                            const BoxDim new_box)
+    {
+    unsigned int group_idx = blockIdx.x * blockDim.x + threadIdx.x;
+
+    if (group_idx >= group_size)
+        return;
+
+    unsigned int idx = d_group_members[group_idx];
+    Scalar4 postype = d_pos[idx];
+
+    Scalar3 fractional_pos = cur_box.makeFraction(make_scalar3(postype.x, postype.y, postype.z));
+    Scalar3 scaled_pos = new_box.makeCoordinates(fractional_pos);
+
+    d_pos[idx] = make_scalar4(scaled_pos.x, scaled_pos.y, scaled_pos.z, postype.w);
+    }
+
+/*! \param d_pos Particle positions
+    \param d_group_members Indices of the particles to scale
+    \param group_size Number of particles to scale
+    \param cur_box Global box the positions are currently in
+    \param new_box Global box to scale the positions into
+    \param block_size Block size to execute on the GPU
+*/
+hipError_t gpu_box_resize_scale(Scalar4* d_pos,
+                                const unsigned int* d_group_members,
+                                const unsigned int group_size,
+                                const BoxDim& cur_box,
+                                const BoxDim& new_box,
+                                const unsigned int block_size)
+    {
+    static unsigned int max_block_size = UINT_MAX;
+    if (max_block_size == UINT_MAX)
+        {
+        hipFuncAttributes attr;
+        hipFuncGetAttributes(&attr, (const void*)gpu_box_resize_scale_kernel);
+        max_block_size = attr.maxThreadsPerBlock;
+        }
+
+    unsigned int run_block_size = min(block_size, max_block_size);
+
+    hipLaunchKernelGGL((gpu_box_resize_scale_kernel),
+                       dim3(group_size / run_block_size + 1),
+                       dim3(run_block_size),
+                       0,
+                       0,
+                       d_pos,
+                       d_group_members,
+                       group_size,
+                       cur_box,
+                       new_box);
+
+    return hipSuccess;
+    }
+
+//! Wrap the local particles back into the local box
+/*! \param d_pos Particle positions
+    \param d_image Particle images
+    \param N Number of local particles
+    \param local_box Local box
+*/
+__global__ void gpu_box_resize_wrap_kernel(Scalar4* d_pos,
+                                           int3* d_image,
+                                           const unsigned int N,
+                                           const BoxDim local_box)
+    {
+    unsigned int idx = blockIdx.x * blockDim.x + threadIdx.x;
+
+    if (idx >= N)
+        return;
+
+    Scalar4 postype = d_pos[idx];
+    int3 image = d_image[idx];
+
+    local_box.wrap(postype, image);
+
+    d_pos[idx] = postype;
+    d_image[idx] = image;
+    }
+
+/*! \param d_pos Particle positions
+    \param d_image Particle images
+    \param N Number of local particles
+    \param local_box Local box
+    \param block_size Block size to execute on the GPU
+*/
+hipError_t gpu_box_resize_wrap(Scalar4* d_pos,
+                               int3* d_image,
+                               const unsigned int N,
+                               const BoxDim& local_box,
+                               const unsigned int block_size)
+    {
+    static unsigned int max_block_size = UINT_MAX;
+    if (max_block_size == UINT_MAX)
+        {
+        hipFuncAttributes attr;
+        hipFuncGetAttributes(&attr, (const void*)gpu_box_resize_wrap_kernel);
+        max_block_size = attr.maxThreadsPerBlock;
+        }
+
+    unsigned int run_block_size = min(block_size, max_block_size);
+
+    hipLaunchKernelGGL((gpu_box_resize_wrap_kernel),
+                       dim3(N / run_block_size + 1),
+                       dim3(run_block_size),
+                       0,
+                       0,
+                       d_pos,
+                       d_image,
+                       N,
+                       local_box);
+
+    return hipSuccess;
+    }
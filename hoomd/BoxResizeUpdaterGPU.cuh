@@ -0,0 +1,31 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file BoxResizeUpdaterGPU.cuh
+    \brief Declares GPU kernel code for scaling particle positions with the box. Used by
+   BoxResizeUpdaterGPU.
+*/
+
+#ifndef __BOXRESIZEUPDATER_GPU_CUH__
+#define __BOXRESIZEUPDATER_GPU_CUH__
+
+#include "BoxDim.h"
+#include "HOOMDMath.h"
+#include <hip/hip_runtime.h>
+
+//! Kernel driver to scale the positions of the group members from the old to the new box
+hipError_t gpu_box_resize_scale(Scalar4* d_pos,
+                                const unsigned int* d_group_members,
+                                const unsigned int group_size,
+                                const BoxDim& cur_box,
+                                const BoxDim& new_box,
+                                const unsigned int block_size);
+
+//! Kernel driver to wrap the local particles back into the local box
+hipError_t gpu_box_resize_wrap(Scalar4* d_pos,
+                               int3* d_image,
+                               const unsigned int N,
+                               const BoxDim& local_box,
+                               const unsigned int block_size);
+
+#endif // __BOXRESIZEUPDATER_GPU_CUH__
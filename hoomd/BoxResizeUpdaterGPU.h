@@ -0,0 +1,65 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file BoxResizeUpdaterGPU.h
+    \brief Declares an updater that resizes the simulation box of the system on the GPU
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#ifdef ENABLE_HIP
+
+#include "Autotuner.h"
+#include "BoxResizeUpdater.h"
+
+#include <memory>
+#include <pybind11/pybind11.h>
+
+#ifndef __BOXRESIZEUPDATER_GPU_H__
+#define __BOXRESIZEUPDATER_GPU_H__
+
+/// Updates the simulation box over time on the GPU
+/** The positions are scaled with the box and wrapped back into the local box in place on the
+ * device. The neighbor list distance check subtracts the homogeneous dilation of the box from the
+ * particle displacements, so a slow compression only triggers a rebuild when the particles have
+ * moved further than the buffer allows.
+ * \ingroup updaters
+ */
+class PYBIND11_EXPORT BoxResizeUpdaterGPU : public BoxResizeUpdater
+    {
+    public:
+    /// Constructor
+    BoxResizeUpdaterGPU(std::shared_ptr<SystemDefinition> sysdef,
+                        pybind11::object box1,
+                        pybind11::object box2,
+                        std::shared_ptr<Variant> variant,
+                        std::shared_ptr<ParticleGroup> m_group);
+
+    /// Destructor
+    virtual ~BoxResizeUpdaterGPU();
+
+    /// Set autotuner parameters
+    virtual void setAutotunerParams(bool enable, unsigned int period)
+        {
+        BoxResizeUpdater::setAutotunerParams(enable, period);
+        m_tuner_scale->setPeriod(period);
+        m_tuner_scale->setEnabled(enable);
+        m_tuner_wrap->setPeriod(period);
+        m_tuner_wrap->setEnabled(enable);
+        }
+
+    /// Update box interpolation based on provided timestep
+    virtual void update(uint64_t timestep);
+
+    protected:
+    std::unique_ptr<Autotuner> m_tuner_scale; //!< Autotuner for the block size of the scaling
+    std::unique_ptr<Autotuner> m_tuner_wrap;  //!< Autotuner for the block size of the wrapping
+    };
+
+/// Export the BoxResizeUpdaterGPU to python
+void export_BoxResizeUpdaterGPU(pybind11::module& m);
+
+#endif // __BOXRESIZEUPDATER_GPU_H__
+#endif // ENABLE_HIP
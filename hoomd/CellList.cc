@@ -12,6 +12,11 @@
 
 #include <algorithm>
 
+#ifdef ENABLE_TBB
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#endif
+
 using namespace std;
 namespace py = pybind11;
 
@@ -47,6 +52,7 @@ CellList::CellList(std::shared_ptr<SystemDefinition> sysdef)
     m_ghost_width = make_scalar3(0.0, 0.0, 0.0);
 
     m_pdata->getParticleSortSignal().connect<CellList, &CellList::slotParticlesSorted>(this);
+    m_pdata->getParticlesMovedSignal().connect<CellList, &CellList::slotParticlesSorted>(this);
     m_pdata->getBoxChangeSignal().connect<CellList, &CellList::slotBoxChanged>(this);
     }
 
@@ -54,6 +60,7 @@ CellList::~CellList()
     {
     m_exec_conf->msg->notice(5) << "Destroying CellList" << endl;
     m_pdata->getParticleSortSignal().disconnect<CellList, &CellList::slotParticlesSorted>(this);
+    m_pdata->getParticlesMovedSignal().disconnect<CellList, &CellList::slotParticlesSorted>(this);
     m_pdata->getBoxChangeSignal().disconnect<CellList, &CellList::slotBoxChanged>(this);
     }
 
@@ -192,6 +199,71 @@ void CellList::compute(uint64_t timestep)
         m_prof->pop();
     }
 
+/*! \param request Configuration to set
+
+    Sets the width, radius, flag, per device mode, and the optional data to exactly those of \a
+    request.
+*/
+void CellList::setRequest(const CellListRequest& request)
+    {
+    setNominalWidth(request.nominal_width);
+    setRadius(request.radius);
+    if (request.flag == CellListRequest::flag_type)
+        setFlagType();
+    else if (request.flag == CellListRequest::flag_charge)
+        setFlagCharge();
+    else
+        setFlagIndex();
+    setPerDevice(request.per_device);
+    setComputeXYZF(request.compute_xyzf);
+    setComputeTDB(request.compute_tdb);
+    setComputeOrientation(request.compute_orientation);
+    setComputeIdx(request.compute_idx);
+    setComputeAdjList(request.compute_adj_list);
+    setSortCellList(request.sort);
+    }
+
+/*! \param request Configuration to test
+    \returns true when the consumer that makes \a request can use this cell list
+
+    Cells wider than requested are correct for any consumer, \a request.max_width limits how much
+    wider they may be. The optional data is not tested, addRequest() adds it.
+*/
+bool CellList::isCompatible(const CellListRequest& request) const
+    {
+    Scalar max_width = std::max(request.nominal_width, request.max_width);
+    CellListRequest::flagMode flag = CellListRequest::flag_index;
+    if (m_flag_type)
+        flag = CellListRequest::flag_type;
+    else if (m_flag_charge)
+        flag = CellListRequest::flag_charge;
+
+    return m_nominal_width >= request.nominal_width && m_nominal_width <= max_width
+           && m_radius == request.radius && flag == request.flag
+           && getPerDevice() == request.per_device && m_multiple == 1;
+    }
+
+/*! \param request Configuration of a new consumer
+
+    Only turns optional data on, the other consumers may still need the data that \a request does
+    not ask for. Each change reinitializes the cell list on the next compute().
+*/
+void CellList::addRequest(const CellListRequest& request)
+    {
+    if (request.compute_xyzf && !m_compute_xyzf)
+        setComputeXYZF(true);
+    if (request.compute_tdb && !m_compute_tdb)
+        setComputeTDB(true);
+    if (request.compute_orientation && !m_compute_orientation)
+        setComputeOrientation(true);
+    if (request.compute_idx && !m_compute_idx)
+        setComputeIdx(true);
+    if (request.compute_adj_list && !m_compute_adj_list)
+        setComputeAdjList(true);
+    if (request.sort && !m_sort_cell_list)
+        setSortCellList(true);
+    }
+
 /*! \param num_iters Number of iterations to average for the benchmark
     \returns Milliseconds of execution time per calculation
 
@@ -376,6 +448,22 @@ void CellList::initializeMemory()
         m_idx.swap(idx);
         }
 
+    if (m_sort_cell_list)
+        {
+        m_type_head_indexer = Index2D(m_pdata->getNTypes() + 1, m_cell_indexer.getNumElements());
+        GlobalArray<unsigned int> type_head(m_type_head_indexer.getNumElements(), m_exec_conf);
+        m_type_head.swap(type_head);
+        TAG_ALLOCATION(m_type_head);
+        }
+    else
+        {
+        m_type_head_indexer = Index2D();
+
+        // array is no longer needed, discard it
+        GlobalArray<unsigned int> type_head;
+        m_type_head.swap(type_head);
+        }
+
     if (m_prof)
         m_prof->pop();
 
@@ -494,52 +582,110 @@ void CellList::computeCellList()
     // for each particle
     unsigned n_tot_particles = m_pdata->getN() + m_pdata->getNGhosts();
 
-    for (unsigned int n = 0; n < n_tot_particles; n++)
-        {
-        Scalar3 p = make_scalar3(h_pos.data[n].x, h_pos.data[n].y, h_pos.data[n].z);
-        if (std::isnan(p.x) || std::isnan(p.y) || std::isnan(p.z))
+    // bin values that flag particles with invalid positions
+    const unsigned int nan_bin = 0xffffffff;
+    const unsigned int out_of_bounds_bin = 0xfffffffe;
+
+    // find the bin each particle belongs in
+    auto find_bins = [&](unsigned int begin, unsigned int end)
+    {
+        for (unsigned int n = begin; n < end; n++)
             {
-            conditions.y = n + 1;
-            continue;
+            Scalar3 p = make_scalar3(h_pos.data[n].x, h_pos.data[n].y, h_pos.data[n].z);
+            if (std::isnan(p.x) || std::isnan(p.y) || std::isnan(p.z))
+                {
+                m_bin[n] = nan_bin;
+                continue;
+                }
+
+            Scalar3 f = box.makeFraction(p, ghost_width);
+            int ib = (int)(f.x * m_dim.x);
+            int jb = (int)(f.y * m_dim.y);
+            int kb = (int)(f.z * m_dim.z);
+
+            // check if the particle is inside the unit cell + ghost layer in all dimensions
+            if ((f.x < Scalar(-0.00001) || f.x >= Scalar(1.00001))
+                || (f.y < Scalar(-0.00001) || f.y >= Scalar(1.00001))
+                || (f.z < Scalar(-0.00001) || f.z >= Scalar(1.00001)))
+                {
+                m_bin[n] = out_of_bounds_bin;
+                continue;
+                }
+
+            // need to handle the case where the particle is exactly at the box hi
+            if (ib == (int)m_dim.x && periodic.x)
+                ib = 0;
+            if (jb == (int)m_dim.y && periodic.y)
+                jb = 0;
+            if (kb == (int)m_dim.z && periodic.z)
+                kb = 0;
+
+            // sanity check
+            assert((ib < (int)(m_dim.x) && jb < (int)(m_dim.y) && kb < (int)(m_dim.z))
+                   || n >= m_pdata->getN());
+
+            // all particles should be in a valid cell
+            if (ib < 0 || ib >= (int)m_dim.x || jb < 0 || jb >= (int)m_dim.y || kb < 0
+                || kb >= (int)m_dim.z)
+                {
+                m_bin[n] = out_of_bounds_bin;
+                continue;
+                }
+
+            m_bin[n] = ci(ib, jb, kb);
             }
+    };
 
-        // find the bin each particle belongs in
-        Scalar3 f = box.makeFraction(p, ghost_width);
-        int ib = (int)(f.x * m_dim.x);
-        int jb = (int)(f.y * m_dim.y);
-        int kb = (int)(f.z * m_dim.z);
+    m_bin.resize(n_tot_particles);
 
-        // check if the particle is inside the unit cell + ghost layer in all dimensions
-        if ((f.x < Scalar(-0.00001) || f.x >= Scalar(1.00001))
-            || (f.y < Scalar(-0.00001) || f.y >= Scalar(1.00001))
-            || (f.z < Scalar(-0.00001) || f.z >= Scalar(1.00001)))
+#ifdef ENABLE_TBB
+    m_exec_conf->getTaskArena()->execute(
+        [&]
+        {
+            tbb::parallel_for(tbb::blocked_range<unsigned int>(0, n_tot_particles),
+                              [&](const tbb::blocked_range<unsigned int>& r)
+                              { find_bins(r.begin(), r.end()); });
+        });
+#else
+    find_bins(0, n_tot_particles);
+#endif
+
+    // when sorting, place the members of each cell in blocks by type, starting at the offsets
+    // given by an exclusive prefix sum over the number of members of each type
+    ArrayHandle<unsigned int> h_type_head(m_type_head,
+                                          access_location::host,
+                                          access_mode::overwrite);
+    const Index2D& thi = m_type_head_indexer;
+    if (m_sort_cell_list)
+        {
+        memset(h_type_head.data, 0, sizeof(unsigned int) * m_type_head.getNumElements());
+
+        for (unsigned int n = 0; n < n_tot_particles; n++)
             {
-            // if a ghost particle is out of bounds, silently ignore it
-            if (n < m_pdata->getN())
-                conditions.z = n + 1;
-            continue;
+            unsigned int bin = m_bin[n];
+            if (bin < ci.getNumElements())
+                h_type_head.data[thi(__scalar_as_int(h_pos.data[n].w) + 1, bin)]++;
             }
 
-        // need to handle the case where the particle is exactly at the box hi
-        if (ib == (int)m_dim.x && periodic.x)
-            ib = 0;
-        if (jb == (int)m_dim.y && periodic.y)
-            jb = 0;
-        if (kb == (int)m_dim.z && periodic.z)
-            kb = 0;
-
-        // sanity check
-        assert((ib < (int)(m_dim.x) && jb < (int)(m_dim.y) && kb < (int)(m_dim.z))
-               || n >= m_pdata->getN());
+        for (unsigned int bin = 0; bin < ci.getNumElements(); bin++)
+            for (unsigned int t = 1; t < thi.getW(); t++)
+                h_type_head.data[thi(t, bin)] += h_type_head.data[thi(t - 1, bin)];
+        }
 
-        // record its bin
-        unsigned int bin = ci(ib, jb, kb);
+    // fill the cells in particle order so that the cell list does not depend on the number of
+    // threads
+    for (unsigned int n = 0; n < n_tot_particles; n++)
+        {
+        unsigned int bin = m_bin[n];
+        if (bin == nan_bin)
+            {
+            conditions.y = n + 1;
+            continue;
+            }
 
-        // all particles should be in a valid cell
-        if (ib < 0 || ib >= (int)m_dim.x || jb < 0 || jb >= (int)m_dim.y || kb < 0
-            || kb >= (int)m_dim.z)
+        if (bin == out_of_bounds_bin)
             {
-            // but ghost particles that are out of range should not produce an error
+            // if a ghost particle is out of bounds, silently ignore it
             if (n < m_pdata->getN())
                 conditions.z = n + 1;
             continue;
@@ -556,6 +702,8 @@ void CellList::computeCellList()
 
         // store the bin entries
         unsigned int offset = h_cell_size.data[bin];
+        if (m_sort_cell_list)
+            offset = h_type_head.data[thi(__scalar_as_int(h_pos.data[n].w), bin)]++;
 
         if (offset < m_Nmax)
             {
@@ -592,6 +740,17 @@ void CellList::computeCellList()
         h_cell_size.data[bin]++;
         }
 
+    if (m_sort_cell_list)
+        {
+        // every type offset has advanced to the end of its block, shift them back to the start
+        for (unsigned int bin = 0; bin < ci.getNumElements(); bin++)
+            {
+            for (unsigned int t = thi.getW() - 1; t > 0; t--)
+                h_type_head.data[thi(t, bin)] = h_type_head.data[thi(t - 1, bin)];
+            h_type_head.data[thi(0, bin)] = 0;
+            }
+        }
+
         {
         // write out conditions
         ArrayHandle<uint3> h_conditions(m_conditions,
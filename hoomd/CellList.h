@@ -11,6 +11,7 @@
 
 #include <hoomd/extern/nano-signal-slot/nano_signal_slot.hpp>
 #include <memory>
+#include <vector>
 
 /*! \file CellList.h
     \brief Declares the CellList class
@@ -25,6 +26,36 @@
 #ifndef __CELLLIST_H__
 #define __CELLLIST_H__
 
+//! Cell list configuration requested by a consumer
+/*! Consumers that request compatible configurations share one CellList through
+    SystemDefinition::getCellList(). A cell list is compatible with a request when its nominal width
+    is in the range [nominal_width, max_width] and its radius, flag, and per device mode are the
+    same. The other fields select optional data, a shared cell list computes the optional data of
+    all its consumers.
+*/
+struct PYBIND11_EXPORT CellListRequest
+    {
+    //! Content of the flag in the xyzf list
+    enum flagMode
+        {
+        flag_index,
+        flag_type,
+        flag_charge
+        };
+
+    Scalar nominal_width = Scalar(1.0); //!< Minimum width of a cell
+    Scalar max_width = Scalar(0.0);     //!< Largest acceptable width (nominal_width when smaller)
+    unsigned int radius = 1;            //!< Radius of cells in the adjacency list
+    flagMode flag = flag_index;         //!< Content of the flag in the xyzf list
+    bool per_device = false;            //!< Keep a cell list per GPU
+    bool compute_xyzf = true;           //!< Compute the xyzf list
+    bool compute_tdb = false;           //!< Compute the tdb list
+    bool compute_orientation = false;   //!< Compute the orientation list
+    bool compute_idx = false;           //!< Compute the index list
+    bool compute_adj_list = true;       //!< Compute the cell adjacency list
+    bool sort = false;                  //!< Sort the members of each cell
+    };
+
 //! Computes a cell list from the particles in the system
 /*! \b Overview:
     Cell lists are useful data structures when working with locality queries on particles. The most
@@ -57,6 +88,10 @@
    time when it is not needed.
      - The cell_adj array lists indices of adjacent cells. A specified radius (3,5,7,...) of cells
    is included in the list.
+     - The \c type_head array lists, for every cell, the offset of the first member of each type.
+   It is only computed on the CPU when the cell list is sorted. Sorted cells list their members
+   grouped by type, in particle order within each type, so that the members of type t in a cell
+   occupy offsets type_head(t, cell) to type_head(t+1, cell)-1.
 
     A given cell cuboid with x,y,z indices of i,j,k has a unique cell index. This index can be
    obtained from the Index3D object returned by getCellIndexer() \code Index3D cell_indexer =
@@ -221,6 +256,24 @@ class PYBIND11_EXPORT CellList : public Compute
         // base class does nothing
         }
 
+    //! Set all parameters from a request
+    void setRequest(const CellListRequest& request);
+
+    //! Test if a consumer that makes a request can share this cell list
+    bool isCompatible(const CellListRequest& request) const;
+
+    //! Also compute the optional data of a request
+    void addRequest(const CellListRequest& request);
+
+    //! Rebuild on the next call to compute()
+    /*! Consumers that share a cell list call this after moving particles in place, so that the
+        other consumers do not use the cell list computed before the move at the same time step.
+    */
+    void notifyParticlesMoved()
+        {
+        m_particles_sorted = true;
+        }
+
     //! Return true if we maintain a cell list per device
     virtual bool getPerDevice() const
         {
@@ -333,6 +386,18 @@ class PYBIND11_EXPORT CellList : public Compute
         return m_idx;
         }
 
+    //! Get the offsets of the type blocks in each (sorted) cell
+    const GlobalArray<unsigned int>& getTypeHeadArray() const
+        {
+        return m_type_head;
+        }
+
+    //! Get an indexer to index into the type head array
+    const Index2D& getTypeHeadIndexer() const
+        {
+        return m_type_head_indexer;
+        }
+
     //! Get the cell list containing index (per device)
     virtual const GlobalArray<unsigned int>& getIndexArrayPerDevice() const
         {
@@ -381,6 +446,7 @@ class PYBIND11_EXPORT CellList : public Compute
     Index3D m_cell_indexer;      //!< Indexes cells from i,j,k
     Index2D m_cell_list_indexer; //!< Indexes elements in the cell list
     Index2D m_cell_adj_indexer;  //!< Indexes elements in the cell adjacency list
+    Index2D m_type_head_indexer; //!< Indexes elements in the type head array
     unsigned int m_Nmax;         //!< Numer of spaces reserved for particles in each cell
     Scalar3 m_actual_width;      //!< Actual width of a cell in each direction
     Scalar3 m_ghost_width;       //!< Width of ghost layer sized for (on one side only)
@@ -392,7 +458,9 @@ class PYBIND11_EXPORT CellList : public Compute
     GlobalArray<Scalar4> m_tdb;            //!< Cell list with type,diameter,body
     GlobalArray<Scalar4> m_orientation;    //!< Cell list with orientation
     GlobalArray<unsigned int> m_idx;       //!< Cell list with index
+    GlobalArray<unsigned int> m_type_head; //!< Offset of the first member of each type per cell
     GlobalArray<uint3> m_conditions; //!< Condition flags set during the computeCellList() call
+    std::vector<unsigned int> m_bin; //!< Bin of each particle, computed by computeCellList()
 
     bool m_sort_cell_list;   //!< If true, sort cell list
     bool m_compute_adj_list; //!< If true, compute the cell adjacency lists
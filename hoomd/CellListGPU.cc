@@ -9,6 +9,7 @@
 
 #include "CellListGPU.h"
 #include "CellListGPU.cuh"
+#include "StepArena.h"
 
 namespace py = pybind11;
 
@@ -101,13 +102,16 @@ void CellListGPU::computeCellList()
                                         access_location::device,
                                         access_mode::overwrite);
 
-        // reset cell list contents
-        hipMemsetAsync(d_cell_size.data,
-                       0,
-                       sizeof(unsigned int) * m_cell_indexer.getNumElements(),
-                       0);
-        if (m_exec_conf->isCUDAErrorCheckingEnabled())
-            CHECK_CUDA_ERROR();
+        // reset cell list contents, combineCellLists() overwrites all cell sizes when combining
+        if (ngpu == 1 || m_per_device)
+            {
+            hipMemsetAsync(d_cell_size.data,
+                           0,
+                           sizeof(unsigned int) * m_cell_indexer.getNumElements(),
+                           0);
+            if (m_exec_conf->isCUDAErrorCheckingEnabled())
+                CHECK_CUDA_ERROR();
+            }
 
         if (ngpu > 1 || m_per_device)
             {
@@ -191,18 +195,14 @@ void CellListGPU::computeCellList()
         // sort partial cell lists
         for (unsigned int i = 0; i < m_exec_conf->getNumActiveGPUs(); ++i)
             {
-            ScopedAllocation<uint2> d_sort_idx(m_exec_conf->getCachedAllocator(),
-                                               m_cell_list_indexer.getNumElements());
-            ScopedAllocation<unsigned int> d_sort_permutation(m_exec_conf->getCachedAllocator(),
-                                                              m_cell_list_indexer.getNumElements());
-            ScopedAllocation<unsigned int> d_cell_idx_new(m_exec_conf->getCachedAllocator(),
-                                                          m_idx.getNumElements());
-            ScopedAllocation<Scalar4> d_xyzf_new(m_exec_conf->getCachedAllocator(),
-                                                 m_xyzf.getNumElements());
-            ScopedAllocation<Scalar4> d_cell_orientation_new(m_exec_conf->getCachedAllocator(),
-                                                             m_orientation.getNumElements());
-            ScopedAllocation<Scalar4> d_tdb_new(m_exec_conf->getCachedAllocator(),
-                                                m_tdb.getNumElements());
+            StepArena& arena = m_exec_conf->getDeviceArena();
+            ArenaAllocation<uint2> d_sort_idx(arena, m_cell_list_indexer.getNumElements());
+            ArenaAllocation<unsigned int> d_sort_permutation(arena,
+                                                             m_cell_list_indexer.getNumElements());
+            ArenaAllocation<unsigned int> d_cell_idx_new(arena, m_idx.getNumElements());
+            ArenaAllocation<Scalar4> d_xyzf_new(arena, m_xyzf.getNumElements());
+            ArenaAllocation<Scalar4> d_cell_orientation_new(arena, m_orientation.getNumElements());
+            ArenaAllocation<Scalar4> d_tdb_new(arena, m_tdb.getNumElements());
 
             gpu_sort_cell_list(
                 (ngpu == 1 && !m_per_device)
@@ -321,32 +321,26 @@ __global__ void gpu_combine_cell_lists_kernel(const unsigned int* d_cell_size_sc
     unsigned int local_idx = p.x;
     unsigned int bin = p.y;
 
-    // reduce cell sizes for 0..igpu
-    unsigned int local_size;
-    unsigned int offset = 0;
-    unsigned int total_size = 0;
-
-    for (unsigned int i = 0; i < ngpu; ++i)
-        {
-        unsigned int sz = d_cell_size_scratch[bin + i * cli.getH()];
-
-        if (i == igpu)
-            local_size = sz;
-
-        if (i < igpu)
-            offset += sz;
-
-        total_size += sz;
-        }
-
     // write out cell size total on GPU 0
     if (igpu == 0 && local_idx == 0)
+        {
+        unsigned int total_size = 0;
+        for (unsigned int i = 0; i < ngpu; ++i)
+            total_size += d_cell_size_scratch[bin + i * cli.getH()];
         d_cell_size[bin] = total_size;
+        }
 
-    // is local_idx within bounds?
+    // is local_idx within bounds? Each GPU only binned its own partition, so most slots of its
+    // partial cell list are empty and can be skipped before reducing over the other GPUs
+    unsigned int local_size = d_cell_size_scratch[bin + igpu * cli.getH()];
     if (local_idx >= local_size)
         return;
 
+    // reduce cell sizes for 0..igpu-1 to find the write offset
+    unsigned int offset = 0;
+    for (unsigned int i = 0; i < igpu; ++i)
+        offset += d_cell_size_scratch[bin + i * cli.getH()];
+
     unsigned int out_idx = offset + local_idx;
 
     if (out_idx >= Nmax)
@@ -93,6 +93,10 @@ void Communicator::GroupCommunicator<group_data>::migrateGroups(bool incomplete,
             uint3 my_pos = m_comm.m_pdata->getDomainDecomposition()->getGridPos();
             unsigned int my_rank = m_exec_conf->getRank();
 
+            // groups with migrating members are the only ones that are sent in phase 2, remember
+            // them so that the remaining groups are not scanned again
+            m_migrating_groups.clear();
+
             // mark groups whose member ranks need to be updated
             unsigned int n_groups = m_gdata->getN();
             for (unsigned int group_idx = 0; group_idx < n_groups; group_idx++)
@@ -104,6 +108,7 @@ void Communicator::GroupCommunicator<group_data>::migrateGroups(bool incomplete,
                 unsigned int mask = 0;
 
                 bool update = false;
+                bool migrating = false;
 
                 // iterate over group members
                 for (unsigned int i = 0; i < group_data::size; i++)
@@ -176,12 +181,16 @@ void Communicator::GroupCommunicator<group_data>::migrateGroups(bool incomplete,
                             r.idx[i] = h_cart_ranks.data[di(ni, nj, nk)];
 
                             update = true;
+                            migrating = true;
                             }
                         }
                     } // end loop over group members
 
                 h_group_ranks.data[group_idx] = r;
 
+                if (migrating)
+                    m_migrating_groups.push_back(group_idx);
+
                 // a group that is purely local is not sent
                 if (!update)
                     mask = 0;
@@ -409,6 +418,7 @@ void Communicator::GroupCommunicator<group_data>::migrateGroups(bool incomplete,
         // send map for groups
         typedef std::multimap<unsigned int, group_element_t> group_map_t;
         group_map_t group_send_map;
+        unsigned int n_remove_groups = 0;
 
             {
             ArrayHandle<typename group_data::members_t> h_groups(m_gdata->getMembersArray(),
@@ -433,9 +443,7 @@ void Communicator::GroupCommunicator<group_data>::migrateGroups(bool incomplete,
                                                    access_location::host,
                                                    access_mode::read);
 
-            unsigned int ngroups = m_gdata->getN();
-
-            for (unsigned int group_idx = 0; group_idx < ngroups; group_idx++)
+            for (unsigned int group_idx : m_migrating_groups)
                 {
                 unsigned int mask = 0;
 
@@ -487,79 +495,83 @@ void Communicator::GroupCommunicator<group_data>::migrateGroups(bool incomplete,
 
                     // if group is no longer local, flag for removal
                     if (!is_local)
+                        {
                         h_group_rtag.data[el.group_tag] = GROUP_NOT_LOCAL;
+                        n_remove_groups++;
+                        }
                     }
                 } // end loop over groups
             }
 
-        unsigned int new_ngroups;
+        // compact the group arrays only if groups have left this domain
+        if (n_remove_groups)
             {
-            ArrayHandle<typename group_data::members_t> h_groups(m_gdata->getMembersArray(),
-                                                                 access_location::host,
-                                                                 access_mode::read);
-            ArrayHandle<typeval_t> h_group_typeval(m_gdata->getTypeValArray(),
-                                                   access_location::host,
-                                                   access_mode::read);
-            ArrayHandle<unsigned int> h_group_tag(m_gdata->getTags(),
-                                                  access_location::host,
-                                                  access_mode::read);
-            ArrayHandle<typename group_data::ranks_t> h_group_ranks(m_gdata->getRanksArray(),
-                                                                    access_location::host,
-                                                                    access_mode::read);
-
-            // access alternate arrays to write to
-            ArrayHandle<typename group_data::members_t> h_groups_alt(m_gdata->getAltMembersArray(),
+                {
+                ArrayHandle<typename group_data::members_t> h_groups(m_gdata->getMembersArray(),
                                                                      access_location::host,
-                                                                     access_mode::overwrite);
-            ArrayHandle<typeval_t> h_group_typeval_alt(m_gdata->getAltTypeValArray(),
+                                                                     access_mode::read);
+                ArrayHandle<typeval_t> h_group_typeval(m_gdata->getTypeValArray(),
                                                        access_location::host,
-                                                       access_mode::overwrite);
-            ArrayHandle<unsigned int> h_group_tag_alt(m_gdata->getAltTags(),
+                                                       access_mode::read);
+                ArrayHandle<unsigned int> h_group_tag(m_gdata->getTags(),
                                                       access_location::host,
-                                                      access_mode::overwrite);
-            ArrayHandle<typename group_data::ranks_t> h_group_ranks_alt(m_gdata->getAltRanksArray(),
+                                                      access_mode::read);
+                ArrayHandle<typename group_data::ranks_t> h_group_ranks(m_gdata->getRanksArray(),
                                                                         access_location::host,
-                                                                        access_mode::overwrite);
-
-            // access rtags
-            ArrayHandle<unsigned int> h_group_rtag(m_gdata->getRTags(),
-                                                   access_location::host,
-                                                   access_mode::readwrite);
+                                                                        access_mode::read);
 
-            unsigned int ngroups = m_gdata->getN();
-            unsigned int n = 0;
-            for (unsigned int group_idx = 0; group_idx < ngroups; group_idx++)
-                {
-                unsigned int group_tag = h_group_tag.data[group_idx];
-                bool keep = h_group_rtag.data[group_tag] != GROUP_NOT_LOCAL;
+                // access alternate arrays to write to
+                ArrayHandle<typename group_data::members_t> h_groups_alt(
+                    m_gdata->getAltMembersArray(),
+                    access_location::host,
+                    access_mode::overwrite);
+                ArrayHandle<typeval_t> h_group_typeval_alt(m_gdata->getAltTypeValArray(),
+                                                           access_location::host,
+                                                           access_mode::overwrite);
+                ArrayHandle<unsigned int> h_group_tag_alt(m_gdata->getAltTags(),
+                                                          access_location::host,
+                                                          access_mode::overwrite);
+                ArrayHandle<typename group_data::ranks_t> h_group_ranks_alt(
+                    m_gdata->getAltRanksArray(),
+                    access_location::host,
+                    access_mode::overwrite);
+
+                // access rtags
+                ArrayHandle<unsigned int> h_group_rtag(m_gdata->getRTags(),
+                                                       access_location::host,
+                                                       access_mode::readwrite);
 
-                if (keep)
+                unsigned int ngroups = m_gdata->getN();
+                unsigned int n = 0;
+                for (unsigned int group_idx = 0; group_idx < ngroups; group_idx++)
                     {
-                    h_groups_alt.data[n] = h_groups.data[group_idx];
-                    h_group_typeval_alt.data[n] = h_group_typeval.data[group_idx];
-                    h_group_tag_alt.data[n] = group_tag;
-                    h_group_ranks_alt.data[n] = h_group_ranks.data[group_idx];
+                    unsigned int group_tag = h_group_tag.data[group_idx];
+                    bool keep = h_group_rtag.data[group_tag] != GROUP_NOT_LOCAL;
 
-                    // rebuild rtags
-                    h_group_rtag.data[group_tag] = n++;
-                    }
-                }
-
-            new_ngroups = n;
-            }
+                    if (keep)
+                        {
+                        h_groups_alt.data[n] = h_groups.data[group_idx];
+                        h_group_typeval_alt.data[n] = h_group_typeval.data[group_idx];
+                        h_group_tag_alt.data[n] = group_tag;
+                        h_group_ranks_alt.data[n] = h_group_ranks.data[group_idx];
 
-        // make alternate arrays current
-        m_gdata->swapMemberArrays();
-        m_gdata->swapTypeArrays();
-        m_gdata->swapTagArrays();
-        m_gdata->swapRankArrays();
+                        // rebuild rtags
+                        h_group_rtag.data[group_tag] = n++;
+                        }
+                    }
 
-        assert(new_ngroups <= m_gdata->getN());
+                assert(n == m_gdata->getN() - n_remove_groups);
+                }
 
-        // resize group arrays
-        m_gdata->removeGroups(m_gdata->getN() - new_ngroups);
+            // make alternate arrays current
+            m_gdata->swapMemberArrays();
+            m_gdata->swapTypeArrays();
+            m_gdata->swapTagArrays();
+            m_gdata->swapRankArrays();
 
-        assert(m_gdata->getN() == new_ngroups);
+            // resize group arrays
+            m_gdata->removeGroups(n_remove_groups);
+            }
 
         // reset send buf
         m_groups_sendbuf.clear();
@@ -1230,17 +1242,21 @@ Communicator::Communicator(std::shared_ptr<SystemDefinition> sysdef,
                            std::shared_ptr<DomainDecomposition> decomposition)
     : m_sysdef(sysdef), m_pdata(sysdef->getParticleData()), m_exec_conf(m_pdata->getExecConf()),
       m_mpi_comm(m_exec_conf->getMPICommunicator()), m_decomposition(decomposition),
-      m_is_communicating(false), m_force_migrate(false), m_nneigh(0), m_n_unique_neigh(0),
+      m_is_communicating(false), m_force_migrate(false), m_comm_time(0), m_comm_timer_start(0),
+      m_sync_timing(false), m_nneigh(0), m_n_unique_neigh(0),
       m_pos_copybuf(m_exec_conf), m_charge_copybuf(m_exec_conf), m_diameter_copybuf(m_exec_conf),
       m_body_copybuf(m_exec_conf), m_image_copybuf(m_exec_conf), m_velocity_copybuf(m_exec_conf),
       m_orientation_copybuf(m_exec_conf), m_plan_copybuf(m_exec_conf), m_tag_copybuf(m_exec_conf),
       m_netforce_copybuf(m_exec_conf), m_nettorque_copybuf(m_exec_conf),
-      m_netvirial_copybuf(m_exec_conf), m_netvirial_recvbuf(m_exec_conf), m_plan(m_exec_conf),
+      m_netvirial_copybuf(m_exec_conf), m_netvirial_recvbuf(m_exec_conf),
+      m_compress_ghost_positions(false), m_ghost_pos_ref_valid(false),
+      m_ghost_pos_compressed(false), m_plan(m_exec_conf),
       m_plan_reverse(m_exec_conf), m_tag_reverse(m_exec_conf),
       m_netforce_reverse_copybuf(m_exec_conf), m_netforce_reverse_recvbuf(m_exec_conf),
       m_r_ghost_max(Scalar(0.0)), m_r_extra_ghost_max(Scalar(0.0)), m_ghosts_added(0),
-      m_has_ghost_particles(false), m_last_flags(0), m_comm_pending(false),
-      m_bond_comm(*this, m_sysdef->getBondData()), m_angle_comm(*this, m_sysdef->getAngleData()),
+      m_has_ghost_particles(false), m_last_flags(0), m_comm_pending(false), m_pending_dir(0),
+      m_pending_start_idx(0), m_bond_comm(*this, m_sysdef->getBondData()),
+      m_angle_comm(*this, m_sysdef->getAngleData()),
       m_dihedral_comm(*this, m_sysdef->getDihedralData()),
       m_improper_comm(*this, m_sysdef->getImproperData()),
       m_constraint_comm(*this, m_sysdef->getConstraintData()),
@@ -1537,8 +1553,10 @@ void Communicator::communicate(uint64_t timestep)
     if (!m_force_migrate && !m_compute_callbacks.empty() && m_has_ghost_particles)
         {
         // do an obligatory update before determining whether to migrate
+        startCommTimer();
         beginUpdateGhosts(timestep);
         finishUpdateGhosts(timestep);
+        stopCommTimer();
 
         // call subscribers after ghost update, but before distance check
         m_compute_callbacks.emit(timestep);
@@ -1552,8 +1570,10 @@ void Communicator::communicate(uint64_t timestep)
         {
         // distance check, may not be called directly after particle reorder (such as
         // due to SFCPackUpdater running before)
+        startCommTimer();
         m_migrate_requests.emit_accumulate([&](bool r) { migrate_request = migrate_request || r; },
                                            timestep);
+        stopCommTimer();
         }
 
     bool migrate = migrate_request || m_force_migrate || !m_has_ghost_particles;
@@ -1561,9 +1581,16 @@ void Communicator::communicate(uint64_t timestep)
     // Update ghosts if we are not migrating
     if (!migrate && m_compute_callbacks.empty())
         {
+        startCommTimer();
         beginUpdateGhosts(timestep);
+        stopCommTimer();
+
+        // compute what we can from the local particles while the ghost update is in flight
+        m_interior_compute_callbacks.emit(timestep);
 
+        startCommTimer();
         finishUpdateGhosts(timestep);
+        stopCommTimer();
         }
 
     // Check if migration of particles is requested
@@ -1571,12 +1598,16 @@ void Communicator::communicate(uint64_t timestep)
         {
         m_force_migrate = false;
 
+        startCommTimer();
+
         // If so, migrate atoms
         migrateParticles();
 
         // Construct ghost send lists, exchange ghost atom data
         exchangeGhosts();
 
+        stopCommTimer();
+
         // update particle data now that ghosts are available
         m_compute_callbacks.emit(timestep);
 
@@ -1586,6 +1617,18 @@ void Communicator::communicate(uint64_t timestep)
     m_is_communicating = false;
     }
 
+void Communicator::startCommTimer()
+    {
+#ifdef ENABLE_HIP
+    // wait for queued kernels so that their run time is not attributed to communication
+    if (m_sync_timing && m_exec_conf->isCUDAEnabled())
+        {
+        hipDeviceSynchronize();
+        }
+#endif
+    m_comm_timer_start = m_comm_clock.getTime();
+    }
+
 //! Transfer particles between neighboring domains
 void Communicator::migrateParticles()
     {
@@ -2058,6 +2101,11 @@ void Communicator::exchangeGhosts()
                     m_num_copy_ghosts[dir]++;
                     }
                 }
+
+            // remember the sent positions as the reference for compressed ghost updates
+            if (flags[comm_flag::position] && m_compress_ghost_positions)
+                m_ghost_pos_ref_send[dir].assign(h_pos_copybuf.data,
+                                                 h_pos_copybuf.data + m_num_copy_ghosts[dir]);
             }
         unsigned int send_neighbor = m_decomposition->getNeighborRank(dir);
 
@@ -2363,6 +2411,16 @@ void Communicator::exchangeGhosts()
                                       access_location::host,
                                       access_mode::readwrite);
 
+            // remember the unwrapped positions as the reference for compressed ghost updates
+            if (m_compress_ghost_positions)
+                {
+                const unsigned int ref_idx = start_idx - m_pdata->getN();
+                m_ghost_pos_ref_recv.resize(ref_idx + m_num_recv_ghosts[dir]);
+                std::copy(h_pos.data + start_idx,
+                          h_pos.data + start_idx + m_num_recv_ghosts[dir],
+                          m_ghost_pos_ref_recv.begin() + ref_idx);
+                }
+
             const BoxDim shifted_box = getShiftedBox();
 
             for (unsigned int idx = start_idx; idx < start_idx + m_num_recv_ghosts[dir]; idx++)
@@ -2399,6 +2457,7 @@ void Communicator::exchangeGhosts()
     m_constraint_comm.exchangeGhostGroups(m_plan, mask);
 
     m_last_flags = flags;
+    m_ghost_pos_ref_valid = m_compress_ghost_positions && flags[comm_flag::position];
 
     /***********************************************************************************************************************************************************
      * For multi-body force fields we must allow particles to send information back through their
@@ -2694,6 +2753,15 @@ void Communicator::beginUpdateGhosts(uint64_t timestep)
 
     unsigned int num_tot_recv_ghosts = 0; // total number of ghosts received
 
+    // send displacements only if the reference positions are current
+    m_ghost_pos_compressed = m_compress_ghost_positions && m_ghost_pos_ref_valid;
+
+    // the exchange in the last direction completes in finishUpdateGhosts()
+    unsigned int last_dir = 6;
+    for (unsigned int dir = 0; dir < 6; dir++)
+        if (isCommunicating(dir))
+            last_dir = dir;
+
     for (unsigned int dir = 0; dir < 6; dir++)
         {
         if (!isCommunicating(dir))
@@ -2716,15 +2784,46 @@ void Communicator::beginUpdateGhosts(uint64_t timestep)
                                              access_location::host,
                                              access_mode::read);
 
-            // copy positions of ghost particles
-            for (unsigned int ghost_idx = 0; ghost_idx < m_num_copy_ghosts[dir]; ghost_idx++)
+            if (m_ghost_pos_compressed)
                 {
-                unsigned int idx = h_rtag.data[h_copy_ghosts.data[ghost_idx]];
+                const BoxDim& global_box = m_pdata->getGlobalBox();
+                const std::vector<Scalar4>& ref = m_ghost_pos_ref_send[dir];
+                m_pos_delta_sendbuf.resize(m_num_copy_ghosts[dir]);
 
-                assert(idx < m_pdata->getN() + m_pdata->getNGhosts());
+                // pack displacements of ghost particles since the last ghost exchange
+                for (unsigned int ghost_idx = 0; ghost_idx < m_num_copy_ghosts[dir]; ghost_idx++)
+                    {
+                    unsigned int idx = h_rtag.data[h_copy_ghosts.data[ghost_idx]];
+
+                    assert(idx < m_pdata->getN() + m_pdata->getNGhosts());
+
+                    Scalar4 postype = h_pos.data[idx];
 
-                // copy position into send buffer
-                h_pos_copybuf.data[ghost_idx] = h_pos.data[idx];
+                    // local particles may have been wrapped since the reference was taken
+                    Scalar3 delta = global_box.minImage(
+                        make_scalar3(postype.x - ref[ghost_idx].x,
+                                     postype.y - ref[ghost_idx].y,
+                                     postype.z - ref[ghost_idx].z));
+
+                    ghost_pos_delta& d = m_pos_delta_sendbuf[ghost_idx];
+                    d.x = float(delta.x);
+                    d.y = float(delta.y);
+                    d.z = float(delta.z);
+                    d.type = __scalar_as_int(postype.w);
+                    }
+                }
+            else
+                {
+                // copy positions of ghost particles
+                for (unsigned int ghost_idx = 0; ghost_idx < m_num_copy_ghosts[dir]; ghost_idx++)
+                    {
+                    unsigned int idx = h_rtag.data[h_copy_ghosts.data[ghost_idx]];
+
+                    assert(idx < m_pdata->getN() + m_pdata->getNGhosts());
+
+                    // copy position into send buffer
+                    h_pos_copybuf.data[ghost_idx] = h_pos.data[idx];
+                    }
                 }
             }
 
@@ -2801,12 +2900,39 @@ void Communicator::beginUpdateGhosts(uint64_t timestep)
         num_tot_recv_ghosts += m_num_recv_ghosts[dir];
 
         size_t sz = 0;
+        m_reqs.clear();
+
         // only non-permanent fields (position, velocity, orientation) need to be considered here
         // charge, body, image and diameter are not updated between neighbor list builds
-        if (flags[comm_flag::position])
+        if (flags[comm_flag::position] && m_ghost_pos_compressed)
             {
-            m_reqs.resize(2);
-            m_stats.resize(2);
+            size_t n_req = m_reqs.size();
+            m_reqs.resize(n_req + 2);
+
+            m_pos_delta_recvbuf.resize(m_num_recv_ghosts[dir]);
+
+            // exchange displacements, positions are reconstructed after the receive completes
+            MPI_Isend(m_pos_delta_sendbuf.data(),
+                      (unsigned int)(m_num_copy_ghosts[dir] * sizeof(ghost_pos_delta)),
+                      MPI_BYTE,
+                      send_neighbor,
+                      1,
+                      m_mpi_comm,
+                      &m_reqs[n_req]);
+            MPI_Irecv(m_pos_delta_recvbuf.data(),
+                      (unsigned int)(m_num_recv_ghosts[dir] * sizeof(ghost_pos_delta)),
+                      MPI_BYTE,
+                      recv_neighbor,
+                      1,
+                      m_mpi_comm,
+                      &m_reqs[n_req + 1]);
+
+            sz += sizeof(ghost_pos_delta);
+            }
+        else if (flags[comm_flag::position])
+            {
+            size_t n_req = m_reqs.size();
+            m_reqs.resize(n_req + 2);
 
             ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(),
                                        access_location::host,
@@ -2822,23 +2948,22 @@ void Communicator::beginUpdateGhosts(uint64_t timestep)
                       send_neighbor,
                       1,
                       m_mpi_comm,
-                      &m_reqs[0]);
+                      &m_reqs[n_req]);
             MPI_Irecv(h_pos.data + start_idx,
                       (unsigned int)(m_num_recv_ghosts[dir] * sizeof(Scalar4)),
                       MPI_BYTE,
                       recv_neighbor,
                       1,
                       m_mpi_comm,
-                      &m_reqs[1]);
-            MPI_Waitall(2, &m_reqs.front(), &m_stats.front());
+                      &m_reqs[n_req + 1]);
 
             sz += sizeof(Scalar4);
             }
 
         if (flags[comm_flag::velocity])
             {
-            m_reqs.resize(2);
-            m_stats.resize(2);
+            size_t n_req = m_reqs.size();
+            m_reqs.resize(n_req + 2);
 
             ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(),
                                        access_location::host,
@@ -2854,23 +2979,22 @@ void Communicator::beginUpdateGhosts(uint64_t timestep)
                       send_neighbor,
                       2,
                       m_mpi_comm,
-                      &m_reqs[0]);
+                      &m_reqs[n_req]);
             MPI_Irecv(h_vel.data + start_idx,
                       (unsigned int)(m_num_recv_ghosts[dir] * sizeof(Scalar4)),
                       MPI_BYTE,
                       recv_neighbor,
                       2,
                       m_mpi_comm,
-                      &m_reqs[1]);
-            MPI_Waitall(2, &m_reqs.front(), &m_stats.front());
+                      &m_reqs[n_req + 1]);
 
             sz += sizeof(Scalar4);
             }
 
         if (flags[comm_flag::orientation])
             {
-            m_reqs.resize(2);
-            m_stats.resize(2);
+            size_t n_req = m_reqs.size();
+            m_reqs.resize(n_req + 2);
 
             ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(),
                                                access_location::host,
@@ -2886,15 +3010,14 @@ void Communicator::beginUpdateGhosts(uint64_t timestep)
                       send_neighbor,
                       3,
                       m_mpi_comm,
-                      &m_reqs[0]);
+                      &m_reqs[n_req]);
             MPI_Irecv(h_orientation.data + start_idx,
                       (unsigned int)(m_num_recv_ghosts[dir] * sizeof(Scalar4)),
                       MPI_BYTE,
                       recv_neighbor,
                       3,
                       m_mpi_comm,
-                      &m_reqs[1]);
-            MPI_Waitall(2, &m_reqs.front(), &m_stats.front());
+                      &m_reqs[n_req + 1]);
 
             sz += sizeof(Scalar4);
             }
@@ -2902,30 +3025,93 @@ void Communicator::beginUpdateGhosts(uint64_t timestep)
         if (m_prof)
             m_prof->pop(0, (m_num_recv_ghosts[dir] + m_num_copy_ghosts[dir]) * sz);
 
-        // wrap particle positions (only if copying positions)
-        if (flags[comm_flag::position])
+        if (dir == last_dir)
             {
-            ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(),
-                                       access_location::host,
-                                       access_mode::readwrite);
-
-            const BoxDim shifted_box = getShiftedBox();
-            for (unsigned int idx = start_idx; idx < start_idx + m_num_recv_ghosts[dir]; idx++)
-                {
-                Scalar4& pos = h_pos.data[idx];
-
-                // wrap particles received across a global boundary
-                int3 img = make_int3(0, 0, 0);
-                shifted_box.wrap(pos, img);
-                }
+            // let the caller overlap computation on the local particles with the last exchange
+            m_pending_dir = dir;
+            m_pending_start_idx = start_idx;
+            m_comm_pending = true;
+            break;
             }
 
+        m_stats.resize(m_reqs.size());
+        MPI_Waitall((unsigned int)m_reqs.size(), m_reqs.data(), m_stats.data());
+        decompressGhostPositions(start_idx, m_num_recv_ghosts[dir]);
+        wrapGhostPositions(start_idx, m_num_recv_ghosts[dir]);
         } // end dir loop
 
     if (m_prof)
         m_prof->pop();
     }
 
+void Communicator::finishUpdateGhosts(uint64_t timestep)
+    {
+    if (!m_comm_pending)
+        return;
+
+    if (m_prof)
+        m_prof->push("comm_ghost_update");
+
+    m_stats.resize(m_reqs.size());
+    MPI_Waitall((unsigned int)m_reqs.size(), m_reqs.data(), m_stats.data());
+    m_reqs.clear();
+    m_comm_pending = false;
+
+    decompressGhostPositions(m_pending_start_idx, m_num_recv_ghosts[m_pending_dir]);
+    wrapGhostPositions(m_pending_start_idx, m_num_recv_ghosts[m_pending_dir]);
+
+    if (m_prof)
+        m_prof->pop();
+    }
+
+//! Wrap the positions of received ghost particles across the global boundary
+void Communicator::wrapGhostPositions(unsigned int start_idx, unsigned int n)
+    {
+    if (!getFlags()[comm_flag::position])
+        return;
+
+    ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(),
+                               access_location::host,
+                               access_mode::readwrite);
+
+    const BoxDim shifted_box = getShiftedBox();
+    for (unsigned int idx = start_idx; idx < start_idx + n; idx++)
+        {
+        Scalar4& pos = h_pos.data[idx];
+
+        // wrap particles received across a global boundary
+        int3 img = make_int3(0, 0, 0);
+        shifted_box.wrap(pos, img);
+        }
+    }
+
+//! Add the received displacements to the reference positions of the ghost particles
+void Communicator::decompressGhostPositions(unsigned int start_idx, unsigned int n)
+    {
+    if (!getFlags()[comm_flag::position] || !m_ghost_pos_compressed)
+        return;
+
+    ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(),
+                               access_location::host,
+                               access_mode::readwrite);
+
+    const unsigned int ref_idx = start_idx - m_pdata->getN();
+    assert(ref_idx + n <= m_ghost_pos_ref_recv.size());
+    assert(n <= m_pos_delta_recvbuf.size());
+
+    for (unsigned int i = 0; i < n; i++)
+        {
+        const Scalar4& ref = m_ghost_pos_ref_recv[ref_idx + i];
+        const ghost_pos_delta& d = m_pos_delta_recvbuf[i];
+
+        // the result is unwrapped like the reference, wrapGhostPositions() follows
+        h_pos.data[start_idx + i] = make_scalar4(ref.x + Scalar(d.x),
+                                                 ref.y + Scalar(d.y),
+                                                 ref.z + Scalar(d.z),
+                                                 __int_as_scalar(d.type));
+        }
+    }
+
 void Communicator::updateNetForce(uint64_t timestep)
     {
     CommFlags flags = getFlags();
@@ -3499,6 +3685,9 @@ void export_Communicator(py::module& m)
     {
     py::class_<Communicator, std::shared_ptr<Communicator>>(m, "Communicator")
         .def(py::init<std::shared_ptr<SystemDefinition>, std::shared_ptr<DomainDecomposition>>())
-        .def_property_readonly("domain_decomposition", &Communicator::getDomainDecomposition);
+        .def_property_readonly("domain_decomposition", &Communicator::getDomainDecomposition)
+        .def_property("compress_ghost_positions",
+                      &Communicator::getCompressGhostPositions,
+                      &Communicator::setCompressGhostPositions);
     }
 #endif // ENABLE_MPI
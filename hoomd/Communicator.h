@@ -13,6 +13,7 @@
 #define __COMMUNICATOR_H__
 
 #include "BondedGroupData.h"
+#include "ClockSource.h"
 #include "DomainDecomposition.h"
 #include "GPUVector.h"
 #include "GlobalArray.h"
@@ -21,6 +22,7 @@
 
 #include <hoomd/extern/nano-signal-slot/nano_signal_slot.hpp>
 #include <memory>
+#include <vector>
 
 #ifndef __HIPCC__
 #include <pybind11/pybind11.h>
@@ -53,6 +55,17 @@ class ParticleData;
 // in 3d, there are 27 neighbors max.
 #define NEIGH_MAX 27
 
+//! Compressed ghost position sent in a ghost update
+/*! The displacement is taken relative to the position sent in the last ghost exchange.
+ */
+struct ghost_pos_delta
+    {
+    float x;           //!< x component of the displacement
+    float y;           //!< y component of the displacement
+    float z;           //!< z component of the displacement
+    unsigned int type; //!< Particle type
+    };
+
 //! Optional flags to enable communication of certain ParticleData fields for ghost particles
 struct comm_flag
     {
@@ -177,7 +190,10 @@ class PYBIND11_EXPORT Communicator
 
     //! Subscribe to list of functions that request a minimum ghost layer width
     /*! This method keeps track of all functions that request a minimum ghost layer width
-     * The actual ghost layer width is chosen from the max over the inputs
+     * The actual ghost layer width is chosen from the max over the inputs, separately for each
+     * particle type. A local particle is only sent as a ghost when it lies within the width
+     * requested for its own type, so a few large particles do not widen the ghost layer of the
+     * remaining types. The overall maximum is only used to validate the domain size.
      * \return A connection to the present class
      */
     Nano::Signal<Scalar(unsigned int type)>& getGhostLayerWidthRequestSignal()
@@ -188,7 +204,8 @@ class PYBIND11_EXPORT Communicator
     //! Subscribe to list of functions that request a minimum extra ghost layer width (added to the
     //! maximum ghost layer)
     /*! This method keeps track of all functions that request a minimum ghost layer width
-     * The actual ghost layer width is chosen from the max over the inputs
+     * The actual ghost layer width is chosen from the max over the inputs, separately for each
+     * particle type. The extra width is only applied to particles that belong to a rigid body.
      * \return A connection to the present class
      */
     Nano::Signal<Scalar(unsigned int type)>& getExtraGhostLayerWidthRequestSignal()
@@ -237,6 +254,19 @@ class PYBIND11_EXPORT Communicator
         return m_compute_callbacks;
         }
 
+    //! Subscribe to list of call-backs that overlap with the ghost update
+    /*!
+     * On steps that update the ghost positions without migrating particles, the subscribers are
+     * called after beginUpdateGhosts() and before finishUpdateGhosts(). They may only access local
+     * particles, as the ghost particle data is not current until finishUpdateGhosts() returns.
+     *
+     * \return A Nano::Signal object reference to be used for connect and disconnect calls.
+     */
+    Nano::Signal<void(uint64_t timestep)>& getInteriorComputeCallbackSignal()
+        {
+        return m_interior_compute_callbacks;
+        }
+
     //! Get the ghost communication flags
     CommFlags getFlags()
         {
@@ -296,6 +326,43 @@ class PYBIND11_EXPORT Communicator
             m_force_migrate = true;
         }
 
+    //! Get the total time spent exchanging particle data in communicate()
+    /*! \returns Wall clock time in nanoseconds. Time spent in the compute callbacks is not
+     * included.
+     */
+    int64_t getCommunicationTime() const
+        {
+        return m_comm_time;
+        }
+
+    //! Synchronize the GPU before timing communication
+    /*! \param sync When true, queued GPU work completes before the communication timer starts so
+     * that it is not counted as communication time
+     */
+    void setSynchronizeTiming(bool sync)
+        {
+        m_sync_timing = sync;
+        }
+
+    //! Set whether ghost position updates are compressed
+    /*! \param compress When true, beginUpdateGhosts() sends every ghost position as a single
+     * precision displacement from the position sent in the last ghost exchange. Positions are
+     * reconstructed relative to that reference, so rounding errors do not accumulate between
+     * exchanges. The setting takes effect at the next ghost exchange.
+     *
+     * \note Only the CPU code path compresses ghost positions.
+     */
+    void setCompressGhostPositions(bool compress)
+        {
+        m_compress_ghost_positions = compress;
+        }
+
+    //! Get whether ghost position updates are compressed
+    bool getCompressGhostPositions() const
+        {
+        return m_compress_ghost_positions;
+        }
+
     /*! Exchange positions of ghost particles
      * Using the previously constructed ghost exchange lists, ghost positions are updated on the
      * neighboring processors.
@@ -315,11 +382,7 @@ class PYBIND11_EXPORT Communicator
      *
      * \param timestep The time step
      */
-    virtual void finishUpdateGhosts(uint64_t timestep)
-        {
-        // the base class implementation is currently empty
-        m_comm_pending = false;
-        }
+    virtual void finishUpdateGhosts(uint64_t timestep);
 
     /*! Communicate the net particle force
      * \parm timestep The time step
@@ -436,6 +499,9 @@ class PYBIND11_EXPORT Communicator
             m_groups_sendbuf; //!< Send buffer for group elements
         std::vector<typename group_data::packed_t>
             m_groups_recvbuf; //!< Receive buffer for group elements
+
+        std::vector<unsigned int>
+            m_migrating_groups; //!< Indices of local groups with at least one migrating member
         };
 
     //! Returns true if we are communicating particles along a given direction
@@ -461,6 +527,15 @@ class PYBIND11_EXPORT Communicator
     //! Helper function to update the shifted box for ghost particle PBC
     const BoxDim getShiftedBox() const;
 
+    //! Start timing a communication phase
+    void startCommTimer();
+
+    //! Stop timing a communication phase
+    void stopCommTimer()
+        {
+        m_comm_time += m_comm_clock.getTime() - m_comm_timer_start;
+        }
+
     std::shared_ptr<SystemDefinition> m_sysdef;                //!< System definition
     std::shared_ptr<ParticleData> m_pdata;                     //!< Particle data
     std::shared_ptr<const ExecutionConfiguration> m_exec_conf; //!< Execution configuration
@@ -471,6 +546,11 @@ class PYBIND11_EXPORT Communicator
     bool m_is_communicating; //!< Whether we are currently communicating
     bool m_force_migrate;    //!< True if particle migration is forced
 
+    ClockSource m_comm_clock;   //!< Clock to time communication
+    int64_t m_comm_time;        //!< Total time spent communicating (ns)
+    int64_t m_comm_timer_start; //!< Start time of the current communication phase
+    bool m_sync_timing;         //!< True if the GPU is synchronized before timing
+
     unsigned int m_is_at_boundary[6]; //!< Array of flags indicating whether this box lies at a
                                       //!< global boundary
 
@@ -502,6 +582,16 @@ class PYBIND11_EXPORT Communicator
         m_num_copy_ghosts[6]; //!< Number of local particles that are sent to neighboring processors
     unsigned int m_num_recv_ghosts[6]; //!< Number of ghosts received per direction
 
+    bool m_compress_ghost_positions; //!< True if ghost position updates are compressed
+    bool m_ghost_pos_ref_valid;      //!< True if the reference positions match the ghost lists
+    bool m_ghost_pos_compressed;     //!< True if the current ghost update is compressed
+    std::vector<Scalar4>
+        m_ghost_pos_ref_send[6]; //!< Per-direction positions sent in the last ghost exchange
+    std::vector<Scalar4>
+        m_ghost_pos_ref_recv; //!< Unwrapped ghost positions received in the last ghost exchange
+    std::vector<ghost_pos_delta> m_pos_delta_sendbuf; //!< Send buffer for compressed positions
+    std::vector<ghost_pos_delta> m_pos_delta_recvbuf; //!< Receive buffer for compressed positions
+
     GlobalVector<unsigned int>
         m_plan; //!< Array of per-direction flags that determine the sending route
 
@@ -581,12 +671,17 @@ class PYBIND11_EXPORT Communicator
     Nano::Signal<void(const GlobalArray<unsigned int>&)>
         m_comm_callbacks; //!< List of functions that are called after the compute callbacks
 
+    /// List of functions that are called while the ghost update is in progress
+    Nano::Signal<void(uint64_t timestep)> m_interior_compute_callbacks;
+
     CommFlags m_flags;      //!< The ghost communication flags
     CommFlags m_last_flags; //!< Flags of last ghost exchange
 
     bool m_comm_pending;             //!< If true, a communication is in process
     std::vector<MPI_Request> m_reqs; //!< Container for all MPI communication requests
     std::vector<MPI_Status> m_stats; //!< Container for all MPI communication statuses
+    unsigned int m_pending_dir;       //!< Direction of the pending ghost update
+    unsigned int m_pending_start_idx; //!< Index of the first ghost received in m_pending_dir
 
     /* Bonds communication */
     bool m_bonds_changed; //!< True if bond information needs to be refreshed
@@ -689,6 +784,12 @@ class PYBIND11_EXPORT Communicator
     GroupCommunicator<PairData> m_pair_comm; //!< Communication helper for special pairs
     friend class GroupCommunicator<PairData>;
 
+    /// Wrap the positions of \a n received ghost particles starting at \a start_idx
+    void wrapGhostPositions(unsigned int start_idx, unsigned int n);
+
+    /// Reconstruct the positions of \a n received ghost particles from compressed displacements
+    void decompressGhostPositions(unsigned int start_idx, unsigned int n);
+
     //! Helper function to initialize adjacency arrays
     void initializeNeighborArrays();
 
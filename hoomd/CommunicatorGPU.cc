@@ -12,6 +12,7 @@
 
 #include "CommunicatorGPU.h"
 #include "Profiler.h"
+#include "StepArena.h"
 #include "System.h"
 
 namespace py = pybind11;
@@ -50,6 +51,22 @@ CommunicatorGPU::~CommunicatorGPU()
     {
     m_exec_conf->msg->notice(5) << "Destroying CommunicatorGPU";
     hipEventDestroy(m_event);
+
+    // the requests are released by MPI_Finalize when the execution configuration goes first
+    int finalized = 0;
+    MPI_Finalized(&finalized);
+    if (!finalized)
+        freeGhostUpdateRequests();
+    }
+
+void CommunicatorGPU::freeGhostUpdateRequests()
+    {
+    for (auto& stage_reqs : m_ghost_update_reqs)
+        {
+        for (auto& req : stage_reqs.reqs)
+            MPI_Request_free(&req);
+        }
+    m_ghost_update_reqs.clear();
     }
 
 void CommunicatorGPU::allocateBuffers()
@@ -1217,9 +1234,9 @@ void CommunicatorGPU::GroupCommunicatorGPU<group_data>::migrateGroups(bool incom
                                                    access_mode::readwrite);
 
             // get temp buffer
-            ScopedAllocation<unsigned int> d_marked_groups(m_exec_conf->getCachedAllocator(),
-                                                           n_recv_unique);
-            ScopedAllocation<unsigned int> d_tmp(m_exec_conf->getCachedAllocator(), n_recv_unique);
+            ArenaAllocation<unsigned int> d_marked_groups(m_exec_conf->getDeviceArena(),
+                                                          n_recv_unique);
+            ArenaAllocation<unsigned int> d_tmp(m_exec_conf->getDeviceArena(), n_recv_unique);
 
             // add new groups, updating groups that are already present locally
             gpu_add_groups(old_ngroups,
@@ -1659,9 +1676,9 @@ void CommunicatorGPU::GroupCommunicatorGPU<group_data>::exchangeGhostGroups(
                                                  access_location::device,
                                                  access_mode::read);
 
-                CachedAllocator& alloc = m_exec_conf->getCachedAllocator();
-                ScopedAllocation<unsigned int> d_keep(alloc, n_recv_ghost_groups_tot[stage]);
-                ScopedAllocation<unsigned int> d_scan(alloc, n_recv_ghost_groups_tot[stage]);
+                StepArena& arena = m_exec_conf->getDeviceArena();
+                ArenaAllocation<unsigned int> d_keep(arena, n_recv_ghost_groups_tot[stage]);
+                ArenaAllocation<unsigned int> d_scan(arena, n_recv_ghost_groups_tot[stage]);
 
                 // copy recv buf into group data, omitting duplicates and groups with nonlocal ptls
                 gpu_exchange_ghost_groups_copy_buf<group_data::size>(
@@ -1862,9 +1879,9 @@ void CommunicatorGPU::migrateParticles()
 
             // get temporary buffers
             size_t nsend = m_gpu_sendbuf.size();
-            CachedAllocator& alloc = m_exec_conf->getCachedAllocator();
-            ScopedAllocation<pdata_element> d_in_copy(alloc, nsend);
-            ScopedAllocation<unsigned int> d_tmp(alloc, nsend);
+            StepArena& arena = m_exec_conf->getDeviceArena();
+            ArenaAllocation<pdata_element> d_in_copy(arena, nsend);
+            ArenaAllocation<unsigned int> d_tmp(arena, nsend);
 
             gpu_sort_migrating_particles(m_gpu_sendbuf.size(),
                                          d_gpu_sendbuf.data,
@@ -2105,6 +2122,9 @@ void CommunicatorGPU::exchangeGhosts()
     // check if simulation box is sufficiently large for domain decomposition
     checkBoxSize();
 
+    // the ghost counts and buffers change, recreate the ghost update requests on the next update
+    freeGhostUpdateRequests();
+
     if (m_prof)
         m_prof->push(m_exec_conf, "comm_ghost_exch");
 
@@ -3047,6 +3067,12 @@ void CommunicatorGPU::beginUpdateGhosts(uint64_t timestep)
 
     CommFlags flags = getFlags();
 
+    if (m_ghost_update_reqs.size() != m_num_stages)
+        {
+        freeGhostUpdateRequests();
+        m_ghost_update_reqs.resize(m_num_stages);
+        }
+
     // main communication loop
     for (unsigned int stage = 0; stage < m_num_stages; ++stage)
         {
@@ -3215,111 +3241,137 @@ void CommunicatorGPU::beginUpdateGhosts(uint64_t timestep)
             if (m_prof)
                 m_prof->push(m_exec_conf, "MPI send/recv");
 
-            m_reqs.clear();
-            MPI_Request req;
+            // the ghost lists only change in exchangeGhosts(), reuse the requests until then
+            GhostUpdateRequests& stage_reqs = m_ghost_update_reqs[stage];
+            std::vector<const void*> buffers
+                = {pos_ghost_sendbuf_handle.data,
+                   vel_ghost_sendbuf_handle.data,
+                   orientation_ghost_sendbuf_handle.data,
+                   pos_ghost_recvbuf_handle.data + offs,
+                   vel_ghost_recvbuf_handle.data + offs,
+                   orientation_ghost_recvbuf_handle.data + offs};
+
+            if (stage_reqs.buffers != buffers || stage_reqs.flags != flags.to_ulong())
+                {
+                for (auto& req : stage_reqs.reqs)
+                    MPI_Request_free(&req);
+                stage_reqs.reqs.clear();
+                stage_reqs.buffers = buffers;
+                stage_reqs.flags = flags.to_ulong();
 
-            unsigned int send_bytes = 0;
-            unsigned int recv_bytes = 0;
+                MPI_Request req;
 
-            // loop over neighbors
-            for (unsigned int ineigh = 0; ineigh < m_n_unique_neigh; ineigh++)
-                {
-                // rank of neighbor processor
-                unsigned int neighbor = h_unique_neighbors.data[ineigh];
+                unsigned int send_bytes = 0;
+                unsigned int recv_bytes = 0;
 
-                if (flags[comm_flag::position])
+                // loop over neighbors
+                for (unsigned int ineigh = 0; ineigh < m_n_unique_neigh; ineigh++)
                     {
-                    if (m_n_send_ghosts[stage][ineigh])
-                        {
-                        MPI_Isend(pos_ghost_sendbuf_handle.data
-                                      + h_ghost_begin.data[ineigh + stage * m_n_unique_neigh],
-                                  int(m_n_send_ghosts[stage][ineigh] * sizeof(Scalar4)),
-                                  MPI_BYTE,
-                                  neighbor,
-                                  2,
-                                  m_mpi_comm,
-                                  &req);
-                        m_reqs.push_back(req);
-                        }
-                    send_bytes += (unsigned int)(m_n_send_ghosts[stage][ineigh] * sizeof(Scalar4));
+                    // rank of neighbor processor
+                    unsigned int neighbor = h_unique_neighbors.data[ineigh];
+                    unsigned int send_begin = h_ghost_begin.data[ineigh + stage * m_n_unique_neigh];
+                    unsigned int recv_begin = m_ghost_offs[stage][ineigh] + offs;
 
-                    if (m_n_recv_ghosts[stage][ineigh])
+                    if (flags[comm_flag::position])
                         {
-                        MPI_Irecv(pos_ghost_recvbuf_handle.data + m_ghost_offs[stage][ineigh]
-                                      + offs,
-                                  int(m_n_recv_ghosts[stage][ineigh] * sizeof(Scalar4)),
-                                  MPI_BYTE,
-                                  neighbor,
-                                  2,
-                                  m_mpi_comm,
-                                  &req);
-                        m_reqs.push_back(req);
+                        if (m_n_send_ghosts[stage][ineigh])
+                            {
+                            MPI_Send_init(pos_ghost_sendbuf_handle.data + send_begin,
+                                          int(m_n_send_ghosts[stage][ineigh] * sizeof(Scalar4)),
+                                          MPI_BYTE,
+                                          neighbor,
+                                          2,
+                                          m_mpi_comm,
+                                          &req);
+                            stage_reqs.reqs.push_back(req);
+                            }
+                        send_bytes
+                            += (unsigned int)(m_n_send_ghosts[stage][ineigh] * sizeof(Scalar4));
+
+                        if (m_n_recv_ghosts[stage][ineigh])
+                            {
+                            MPI_Recv_init(pos_ghost_recvbuf_handle.data + recv_begin,
+                                          int(m_n_recv_ghosts[stage][ineigh] * sizeof(Scalar4)),
+                                          MPI_BYTE,
+                                          neighbor,
+                                          2,
+                                          m_mpi_comm,
+                                          &req);
+                            stage_reqs.reqs.push_back(req);
+                            }
+                        recv_bytes
+                            += (unsigned int)(m_n_recv_ghosts[stage][ineigh] * sizeof(Scalar4));
                         }
-                    recv_bytes += (unsigned int)(m_n_recv_ghosts[stage][ineigh] * sizeof(Scalar4));
-                    }
 
-                if (flags[comm_flag::velocity])
-                    {
-                    if (m_n_send_ghosts[stage][ineigh])
+                    if (flags[comm_flag::velocity])
                         {
-                        MPI_Isend(vel_ghost_sendbuf_handle.data
-                                      + h_ghost_begin.data[ineigh + stage * m_n_unique_neigh],
-                                  int(m_n_send_ghosts[stage][ineigh] * sizeof(Scalar4)),
-                                  MPI_BYTE,
-                                  neighbor,
-                                  3,
-                                  m_mpi_comm,
-                                  &req);
-                        m_reqs.push_back(req);
+                        if (m_n_send_ghosts[stage][ineigh])
+                            {
+                            MPI_Send_init(vel_ghost_sendbuf_handle.data + send_begin,
+                                          int(m_n_send_ghosts[stage][ineigh] * sizeof(Scalar4)),
+                                          MPI_BYTE,
+                                          neighbor,
+                                          3,
+                                          m_mpi_comm,
+                                          &req);
+                            stage_reqs.reqs.push_back(req);
+                            }
+                        send_bytes
+                            += (unsigned int)(m_n_send_ghosts[stage][ineigh] * sizeof(Scalar4));
+
+                        if (m_n_recv_ghosts[stage][ineigh])
+                            {
+                            MPI_Recv_init(vel_ghost_recvbuf_handle.data + recv_begin,
+                                          int(m_n_recv_ghosts[stage][ineigh] * sizeof(Scalar4)),
+                                          MPI_BYTE,
+                                          neighbor,
+                                          3,
+                                          m_mpi_comm,
+                                          &req);
+                            stage_reqs.reqs.push_back(req);
+                            }
+                        recv_bytes
+                            += (unsigned int)(m_n_recv_ghosts[stage][ineigh] * sizeof(Scalar4));
                         }
-                    send_bytes += (unsigned int)(m_n_send_ghosts[stage][ineigh] * sizeof(Scalar4));
 
-                    if (m_n_recv_ghosts[stage][ineigh])
+                    if (flags[comm_flag::orientation])
                         {
-                        MPI_Irecv(vel_ghost_recvbuf_handle.data + m_ghost_offs[stage][ineigh]
-                                      + offs,
-                                  int(m_n_recv_ghosts[stage][ineigh] * sizeof(Scalar4)),
-                                  MPI_BYTE,
-                                  neighbor,
-                                  3,
-                                  m_mpi_comm,
-                                  &req);
-                        m_reqs.push_back(req);
+                        if (m_n_send_ghosts[stage][ineigh])
+                            {
+                            MPI_Send_init(orientation_ghost_sendbuf_handle.data + send_begin,
+                                          int(m_n_send_ghosts[stage][ineigh] * sizeof(Scalar4)),
+                                          MPI_BYTE,
+                                          neighbor,
+                                          6,
+                                          m_mpi_comm,
+                                          &req);
+                            stage_reqs.reqs.push_back(req);
+                            }
+                        send_bytes
+                            += (unsigned int)(m_n_send_ghosts[stage][ineigh] * sizeof(Scalar4));
+
+                        if (m_n_recv_ghosts[stage][ineigh])
+                            {
+                            MPI_Recv_init(orientation_ghost_recvbuf_handle.data + recv_begin,
+                                          int(m_n_recv_ghosts[stage][ineigh] * sizeof(Scalar4)),
+                                          MPI_BYTE,
+                                          neighbor,
+                                          6,
+                                          m_mpi_comm,
+                                          &req);
+                            stage_reqs.reqs.push_back(req);
+                            }
+                        recv_bytes
+                            += (unsigned int)(m_n_recv_ghosts[stage][ineigh] * sizeof(Scalar4));
                         }
-                    recv_bytes += (unsigned int)(m_n_recv_ghosts[stage][ineigh] * sizeof(Scalar4));
-                    }
+                    } // end neighbor loop
 
-                if (flags[comm_flag::orientation])
-                    {
-                    if (m_n_send_ghosts[stage][ineigh])
-                        {
-                        MPI_Isend(orientation_ghost_sendbuf_handle.data
-                                      + h_ghost_begin.data[ineigh + stage * m_n_unique_neigh],
-                                  int(m_n_send_ghosts[stage][ineigh] * sizeof(Scalar4)),
-                                  MPI_BYTE,
-                                  neighbor,
-                                  6,
-                                  m_mpi_comm,
-                                  &req);
-                        m_reqs.push_back(req);
-                        }
-                    send_bytes += (unsigned int)(m_n_send_ghosts[stage][ineigh] * sizeof(Scalar4));
+                stage_reqs.send_bytes = send_bytes;
+                stage_reqs.recv_bytes = recv_bytes;
+                }
 
-                    if (m_n_recv_ghosts[stage][ineigh])
-                        {
-                        MPI_Irecv(orientation_ghost_recvbuf_handle.data
-                                      + m_ghost_offs[stage][ineigh] + offs,
-                                  int(m_n_recv_ghosts[stage][ineigh] * sizeof(Scalar4)),
-                                  MPI_BYTE,
-                                  neighbor,
-                                  6,
-                                  m_mpi_comm,
-                                  &req);
-                        m_reqs.push_back(req);
-                        }
-                    recv_bytes += (unsigned int)(m_n_recv_ghosts[stage][ineigh] * sizeof(Scalar4));
-                    }
-                } // end neighbor loop
+            if (!stage_reqs.reqs.empty())
+                MPI_Startall((int)stage_reqs.reqs.size(), stage_reqs.reqs.data());
 
             if (m_num_stages == 1)
                 {
@@ -3329,13 +3381,15 @@ void CommunicatorGPU::beginUpdateGhosts(uint64_t timestep)
             else
                 {
                 // complete communication
-                std::vector<MPI_Status> stats(m_reqs.size());
-                MPI_Waitall((unsigned int)m_reqs.size(), &m_reqs.front(), &stats.front());
+                std::vector<MPI_Status> stats(stage_reqs.reqs.size());
+                MPI_Waitall((unsigned int)stage_reqs.reqs.size(),
+                            stage_reqs.reqs.data(),
+                            stats.data());
                 }
 
             if (m_prof)
                 {
-                m_prof->pop(m_exec_conf, 0, send_bytes + recv_bytes);
+                m_prof->pop(m_exec_conf, 0, stage_reqs.send_bytes + stage_reqs.recv_bytes);
                 }
             } // end ArrayHandle scope
 
@@ -3426,8 +3480,9 @@ void CommunicatorGPU::finishUpdateGhosts(uint64_t timestep)
         // complete communication
         if (m_prof)
             m_prof->push(m_exec_conf, "MPI send/recv");
-        std::vector<MPI_Status> stats(m_reqs.size());
-        MPI_Waitall((unsigned int)m_reqs.size(), &m_reqs.front(), &stats.front());
+        std::vector<MPI_Request>& reqs = m_ghost_update_reqs[0].reqs;
+        std::vector<MPI_Status> stats(reqs.size());
+        MPI_Waitall((unsigned int)reqs.size(), reqs.data(), stats.data());
         if (m_prof)
             {
             m_prof->pop(m_exec_conf);
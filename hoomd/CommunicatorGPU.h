@@ -250,6 +250,22 @@ class PYBIND11_EXPORT CommunicatorGPU : public Communicator
 
     hipEvent_t m_event; //!< CUDA event for synchronization
 
+    /// Persistent MPI requests for the ghost update of one communication stage
+    struct GhostUpdateRequests
+        {
+        std::vector<MPI_Request> reqs;    //!< Requests created by MPI_Send_init and MPI_Recv_init
+        std::vector<const void*> buffers; //!< Buffer addresses the requests were created for
+        unsigned long flags = 0;          //!< Communication flags the requests were created for
+        unsigned int send_bytes = 0;      //!< Number of bytes sent by the requests
+        unsigned int recv_bytes = 0;      //!< Number of bytes received by the requests
+        };
+
+    /// Ghost update requests per stage, reused until the ghosts are exchanged again
+    std::vector<GhostUpdateRequests> m_ghost_update_reqs;
+
+    //! Free the persistent ghost update requests
+    void freeGhostUpdateRequests();
+
     //! Helper function to allocate various buffers
     void allocateBuffers();
 
@@ -20,8 +20,9 @@ using namespace std;
     \post The Compute is constructed with the given particle data and a NULL profiler.
 */
 Compute::Compute(std::shared_ptr<SystemDefinition> sysdef)
-    : m_sysdef(sysdef), m_pdata(m_sysdef->getParticleData()), m_exec_conf(m_pdata->getExecConf()),
-      m_force_compute(false), m_last_computed(0), m_first_compute(true)
+    : m_sysdef(sysdef), m_pdata(m_sysdef->getParticleData()), m_profile_name("Compute"),
+      m_exec_conf(m_pdata->getExecConf()), m_timer(m_exec_conf), m_force_compute(false),
+      m_last_computed(0), m_first_compute(true)
     {
     // sanity check
     assert(m_sysdef);
@@ -122,6 +123,9 @@ void export_Compute(py::module& m)
         .def("compute", &Compute::compute)
         .def("benchmark", &Compute::benchmark)
         .def("setProfiler", &Compute::setProfiler)
+        .def("setProfileName", &Compute::setProfileName)
+        .def("getProfileName", &Compute::getProfileName)
+        .def("getRunTime", &Compute::getRunTime)
         .def("notifyDetach", &Compute::notifyDetach)
 #ifdef ENABLE_MPI
         .def("setCommunicator", &Compute::setCommunicator)
@@ -3,10 +3,12 @@
 
 // Maintainer: joaander
 
+#include "OperationTimer.h"
 #include "Profiler.h"
 #include "SharedSignal.h"
 #include "SystemDefinition.h"
 
+#include <functional>
 #include <memory>
 #include <string>
 #include <vector>
@@ -93,6 +95,41 @@ class PYBIND11_EXPORT Compute
     //! Sets the profiler for the compute to use
     virtual void setProfiler(std::shared_ptr<Profiler> prof);
 
+    //! Set the name of this compute in profiles
+    /*! \param name Name to use, Python passes the class name of the operation
+     */
+    void setProfileName(const std::string& name)
+        {
+        m_profile_name = name;
+        }
+
+    //! Get the name of this compute in profiles
+    const std::string& getProfileName() const
+        {
+        return m_profile_name;
+        }
+
+    //! Get the timer of this compute
+    OperationTimer& getTimer()
+        {
+        return m_timer;
+        }
+
+    //! Get the time in seconds this compute has spent executing during the current run
+    double getRunTime()
+        {
+        return m_timer.getTime();
+        }
+
+    //! Discard the times measured by this compute
+    /*! System calls resetTimers() at the start of each run. Derived classes that time other
+        operations on their behalf should reset those as well.
+    */
+    virtual void resetTimers()
+        {
+        m_timer.reset();
+        }
+
     //! Set autotuner parameters
     /*! \param enable Enable/disable autotuning
         \param period period (approximate) in time steps when returning occurs
@@ -111,6 +148,20 @@ class PYBIND11_EXPORT Compute
     /// Python will notify C++ objects when they are detached from Simulation
     virtual void notifyDetach() {};
 
+    /// Get a function that evaluates a scalar loggable quantity
+    /** Native loggers (LogBufferWriter) sample quantities through these functions without calling
+        into Python. Callers must call compute() with the current timestep before evaluating the
+        function.
+
+        @param quantity Name of the quantity, the same as the name of the Python property
+        @returns A function returning the value, or an empty function when the compute does not
+                 provide @a quantity
+    */
+    virtual std::function<Scalar()> getLogScalar(const std::string& quantity)
+        {
+        return std::function<Scalar()>();
+        }
+
 #ifdef ENABLE_MPI
     //! Set communicator this Compute is to use
     /*! \param comm The communicator
@@ -148,6 +199,7 @@ class PYBIND11_EXPORT Compute
     const std::shared_ptr<ParticleData>
         m_pdata;                      //!< The particle data this compute is associated with
     std::shared_ptr<Profiler> m_prof; //!< The profiler this compute is to use
+    std::string m_profile_name;       //!< Name of this compute in profiles
 #ifdef ENABLE_MPI
     std::shared_ptr<Communicator> m_comm; //!< The communicator this compute is to use
 #endif
@@ -155,6 +207,7 @@ class PYBIND11_EXPORT Compute
         m_exec_conf; //!< Stored shared ptr to the execution configuration
     std::vector<std::shared_ptr<hoomd::detail::SignalSlot>>
         m_slots;              //!< Stored shared ptr to the system signals
+    OperationTimer m_timer;   //!< Time spent computing during the current run
     bool m_force_compute;     //!< true if calculation is enforced
     uint64_t m_last_computed; //!< Stores the last timestep compute was called
     bool m_first_compute;     //!< true if compute has not yet been called
@@ -77,7 +77,6 @@ DCDDumpWriter::DCDDumpWriter(std::shared_ptr<SystemDefinition> sysdef,
 //! Initializes the output file for writing
 void DCDDumpWriter::initFileIO(uint64_t timestep)
     {
-    m_staging_buffer = new float[m_pdata->getNGlobal()];
     m_is_initialized = true;
 
     m_nglobal = m_pdata->getNGlobal();
@@ -134,8 +133,11 @@ DCDDumpWriter::~DCDDumpWriter()
 
     if (m_is_initialized)
         {
+        m_writer.stop();
+        if (m_writer.hasError())
+            m_exec_conf->msg->error() << "DCD: error writing buffered frames to " << m_fname
+                                      << endl;
         m_file.close();
-        delete[] m_staging_buffer;
         }
     }
 
@@ -150,10 +152,10 @@ void DCDDumpWriter::analyze(uint64_t timestep)
     if (m_prof)
         m_prof->push("Dump DCD");
 
-    // take particle data snapshot
-    SnapshotParticleData<Scalar> snapshot;
-
-    m_pdata->takeSnapshot(snapshot);
+    // pack the coordinates (this gathers the particle data on the root rank)
+    Frame frame;
+    frame.timestep = timestep;
+    packFrame(frame);
 
 #ifdef ENABLE_MPI
     // if we are not the root processor, do not perform file I/O
@@ -165,6 +167,9 @@ void DCDDumpWriter::analyze(uint64_t timestep)
         }
 #endif
 
+    // raise errors from frames written in the background
+    m_writer.checkError();
+
     if (!m_is_initialized)
         initFileIO(timestep);
 
@@ -195,19 +200,188 @@ void DCDDumpWriter::analyze(uint64_t timestep)
             << " which is not specified in the period of the DCD file: " << m_start_timestep
             << " + i * " << m_period << endl;
 
-    // write the data for the current time step
-    m_file.seekp(0, std::ios_base::end);
-    write_frame_header(m_file);
-    write_frame_data(m_file, snapshot);
+    if (timestep > std::numeric_limits<uint32_t>::max())
+        m_exec_conf->msg->warning() << "DCD: Truncating timestep to lower 32 bits" << endl;
 
-    // update the header with the number of frames written
+    // the header records the number of frames written
     m_num_frames_written++;
-    write_updated_header(m_file, timestep);
+    frame.n_frames = m_num_frames_written;
+
+    if (m_asynchronous)
+        {
+        auto staged = std::make_shared<Frame>(std::move(frame));
+        m_writer.enqueue([this, staged]() { writeFrame(*staged); });
+        }
+    else
+        {
+        writeFrame(frame);
+        }
 
     if (m_prof)
         m_prof->pop();
     }
 
+/*! Disabling asynchronous mode writes all buffered frames and stops the background thread.
+ */
+void DCDDumpWriter::setAsynchronous(bool asynchronous)
+    {
+    if (!asynchronous)
+        {
+        m_writer.stop();
+        m_writer.checkError();
+        }
+    m_asynchronous = asynchronous;
+    }
+
+void DCDDumpWriter::flush()
+    {
+    m_writer.flush();
+    }
+
+/*! \param frame Frame to pack
+
+    Without a domain decomposition, the coordinates of the group members are read directly from the
+    particle data arrays. Otherwise, a particle data snapshot is gathered on the root rank and the
+    coordinates are packed on the root rank only.
+*/
+void DCDDumpWriter::packFrame(Frame& frame)
+    {
+    BoxDim box = m_pdata->getGlobalBox();
+    unsigned int nparticles = m_group->getNumMembersGlobal();
+
+    // set box dimensions
+    Scalar a, b, c, alpha, beta, gamma;
+    Scalar3 va = box.getLatticeVector(0);
+    Scalar3 vb = box.getLatticeVector(1);
+    Scalar3 vc = box.getLatticeVector(2);
+    a = sqrt(dot(va, va));
+    b = sqrt(dot(vb, vb));
+    c = sqrt(dot(vc, vc));
+    alpha = dot(vb, vc) / (b * c);
+    beta = dot(va, vc) / (a * c);
+    gamma = dot(va, vb) / (a * b);
+
+    frame.unitcell[0] = a;
+    frame.unitcell[2] = b;
+    frame.unitcell[5] = c;
+    // box angles are 90 degrees
+    frame.unitcell[1] = gamma;
+    frame.unitcell[3] = beta;
+    frame.unitcell[4] = alpha;
+
+    frame.xyz.resize(3 * size_t(nparticles));
+    float* x = frame.xyz.data();
+    float* y = x + nparticles;
+    float* z = y + nparticles;
+
+    // store the coordinates of one group member, unwrapping them as requested
+    auto store = [&](unsigned int group_idx,
+                     Scalar3 pos,
+                     const int3& img,
+                     const int3* body_img,
+                     const Scalar4& orientation)
+    {
+        if (m_unwrap_full)
+            {
+            pos = box.shift(pos, img);
+            }
+        else if (m_unwrap_rigid && body_img)
+            {
+            int3 img_diff
+                = make_int3(img.x - body_img->x, img.y - body_img->y, img.z - body_img->z);
+            pos = box.shift(pos, img_diff);
+            }
+
+        x[group_idx] = float(pos.x);
+        y[group_idx] = float(pos.y);
+        z[group_idx] = float(pos.z);
+
+        // m_angle set to True turns on a hack where the particle orientation angle is written out
+        // to the z component this only works in 2D simulations, obviously
+        if (m_angle)
+            z[group_idx] = float(atan2(orientation.w, orientation.x) * 2);
+    };
+
+#ifdef ENABLE_MPI
+    if (m_comm)
+        {
+        // take particle data snapshot
+        SnapshotParticleData<Scalar> snapshot;
+        m_pdata->takeSnapshot(snapshot);
+
+        if (!m_exec_conf->isRoot())
+            return;
+
+        for (unsigned int group_idx = 0; group_idx < nparticles; group_idx++)
+            {
+            unsigned int i = m_group->getMemberTag(group_idx);
+            unsigned int body = snapshot.body[i];
+            store(group_idx,
+                  vec_to_scalar3(snapshot.pos[i]),
+                  snapshot.image[i],
+                  body < MIN_FLOPPY ? &snapshot.image[body] : NULL,
+                  quat_to_scalar4(snapshot.orientation[i]));
+            }
+        return;
+        }
+#endif
+
+    ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
+    ArrayHandle<int3> h_image(m_pdata->getImages(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_body(m_pdata->getBodies(),
+                                     access_location::host,
+                                     access_mode::read);
+    ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(),
+                                       access_location::host,
+                                       access_mode::read);
+    ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::read);
+
+    Scalar3 origin = m_pdata->getOrigin();
+    int3 o_image = m_pdata->getOriginImage();
+
+    // compute the position and image of a particle relative to the origin, as in a snapshot
+    auto get_position = [&](unsigned int idx, Scalar3& pos, int3& img)
+    {
+        pos = make_scalar3(h_pos.data[idx].x, h_pos.data[idx].y, h_pos.data[idx].z) - origin;
+        img = make_int3(h_image.data[idx].x - o_image.x,
+                        h_image.data[idx].y - o_image.y,
+                        h_image.data[idx].z - o_image.z);
+        box.wrap(pos, img);
+    };
+
+    for (unsigned int group_idx = 0; group_idx < nparticles; group_idx++)
+        {
+        unsigned int idx = h_rtag.data[m_group->getMemberTag(group_idx)];
+        Scalar3 pos;
+        int3 img;
+        get_position(idx, pos, img);
+
+        unsigned int body = h_body.data[idx];
+        Scalar3 body_pos;
+        int3 body_img;
+        if (m_unwrap_rigid && body < MIN_FLOPPY)
+            get_position(h_rtag.data[body], body_pos, body_img);
+
+        store(group_idx, pos, img, body < MIN_FLOPPY ? &body_img : NULL, h_orientation.data[idx]);
+        }
+    }
+
+/*! \param frame Frame to write
+
+    Called on the background thread in asynchronous mode. The main thread does not access m_file
+    while frames are queued.
+*/
+void DCDDumpWriter::writeFrame(const Frame& frame)
+    {
+    // write the data for the current time step
+    m_file.seekp(0, std::ios_base::end);
+    write_frame_header(m_file, frame);
+    write_frame_data(m_file, frame);
+
+    // update the header with the number of frames written
+    write_updated_header(m_file, frame);
+    }
+
 /*! \param file File to write to
     Writes the initial DCD header to the beginning of the file. This must be
     called on a newly created (or truncated file).
@@ -280,35 +454,14 @@ void DCDDumpWriter::write_file_header(std::fstream& file)
     }
 
 /*! \param file File to write to
+    \param frame Frame to write
     Writes the header that precedes each snapshot in the file. This header
     includes information on the box size of the simulation.
 */
-void DCDDumpWriter::write_frame_header(std::fstream& file)
+void DCDDumpWriter::write_frame_header(std::fstream& file, const Frame& frame)
     {
-    double unitcell[6];
-    BoxDim box = m_pdata->getGlobalBox();
-    // set box dimensions
-    Scalar a, b, c, alpha, beta, gamma;
-    Scalar3 va = box.getLatticeVector(0);
-    Scalar3 vb = box.getLatticeVector(1);
-    Scalar3 vc = box.getLatticeVector(2);
-    a = sqrt(dot(va, va));
-    b = sqrt(dot(vb, vb));
-    c = sqrt(dot(vc, vc));
-    alpha = dot(vb, vc) / (b * c);
-    beta = dot(va, vc) / (a * c);
-    gamma = dot(va, vb) / (a * b);
-
-    unitcell[0] = a;
-    unitcell[2] = b;
-    unitcell[5] = c;
-    // box angles are 90 degrees
-    unitcell[1] = gamma;
-    unitcell[3] = beta;
-    unitcell[4] = alpha;
-
     write_int(file, 48);
-    file.write((char*)unitcell, 48);
+    file.write((char*)frame.unitcell, 48);
     write_int(file, 48);
 
     // check for errors
@@ -320,88 +473,21 @@ void DCDDumpWriter::write_frame_header(std::fstream& file)
     }
 
 /*! \param file File to write to
-    \param snapshot Snapshot to write
+    \param frame Frame to write
     Writes the actual particle positions for all particles at the current time step
 */
-void DCDDumpWriter::write_frame_data(std::fstream& file,
-                                     const SnapshotParticleData<Scalar>& snapshot)
+void DCDDumpWriter::write_frame_data(std::fstream& file, const Frame& frame)
     {
-    // we need to unsort the positions and write in tag order
-    assert(m_staging_buffer);
-
-    BoxDim box = m_pdata->getGlobalBox();
-
-    unsigned int nparticles = m_group->getNumMembersGlobal();
-
-    // Create a tmp copy of the particle data and unwrap particles
-    std::vector<vec3<Scalar>> tmp_pos(snapshot.pos);
-    for (unsigned int group_idx = 0; group_idx < nparticles; group_idx++)
-        {
-        unsigned int i = m_group->getMemberTag(group_idx);
-
-        if (m_unwrap_full)
-            {
-            tmp_pos[i] = box.shift(tmp_pos[i], snapshot.image[i]);
-            }
-        else if (m_unwrap_rigid && snapshot.body[i] < MIN_FLOPPY)
-            {
-            unsigned int central_ptl_tag = snapshot.body[i];
-            int body_ix = snapshot.image[central_ptl_tag].x;
-            int body_iy = snapshot.image[central_ptl_tag].y;
-            int body_iz = snapshot.image[central_ptl_tag].z;
-            int3 particle_img = snapshot.image[i];
-            int3 img_diff = make_int3(particle_img.x - body_ix,
-                                      particle_img.y - body_iy,
-                                      particle_img.z - body_iz);
-
-            tmp_pos[i] = box.shift(tmp_pos[i], img_diff);
-            }
-        }
-
-    // prepare x coords for writing, looping in tag order
-    for (unsigned int group_idx = 0; group_idx < nparticles; group_idx++)
-        {
-        unsigned int i = m_group->getMemberTag(group_idx);
-        m_staging_buffer[group_idx] = float(tmp_pos[i].x);
-        }
-
-    // write x coords
-    write_int(file, (unsigned int)(nparticles * sizeof(float)));
-    file.write((char*)m_staging_buffer, nparticles * sizeof(float));
-    write_int(file, (unsigned int)(nparticles * sizeof(float)));
+    unsigned int nparticles = (unsigned int)(frame.xyz.size() / 3);
 
-    // prepare y coords for writing
-    for (unsigned int group_idx = 0; group_idx < nparticles; group_idx++)
-        {
-        unsigned int i = m_group->getMemberTag(group_idx);
-        m_staging_buffer[group_idx] = float(tmp_pos[i].y);
-        }
-
-    // write y coords
-    write_int(file, (unsigned int)(nparticles * sizeof(float)));
-    file.write((char*)m_staging_buffer, nparticles * sizeof(float));
-    write_int(file, (unsigned int)(nparticles * sizeof(float)));
-
-    // prepare z coords for writing
-    for (unsigned int group_idx = 0; group_idx < nparticles; group_idx++)
+    // write x, y, and z coords
+    for (unsigned int d = 0; d < 3; d++)
         {
-        unsigned int i = m_group->getMemberTag(group_idx);
-        m_staging_buffer[group_idx] = float(tmp_pos[i].z);
-
-        // m_angle set to True turns on a hack where the particle orientation angle is written out
-        // to the z component this only works in 2D simulations, obviously
-        if (m_angle)
-            {
-            m_staging_buffer[group_idx]
-                = float(atan2(snapshot.orientation[i].v.z, snapshot.orientation[i].s) * 2);
-            }
+        write_int(file, (unsigned int)(nparticles * sizeof(float)));
+        file.write((char*)(frame.xyz.data() + size_t(d) * nparticles), nparticles * sizeof(float));
+        write_int(file, (unsigned int)(nparticles * sizeof(float)));
         }
 
-    // write z coords
-    write_int(file, (unsigned int)(nparticles * sizeof(float)));
-    file.write((char*)m_staging_buffer, nparticles * sizeof(float));
-    write_int(file, (unsigned int)(nparticles * sizeof(float)));
-
     // check for errors
     if (!file.good())
         {
@@ -411,21 +497,18 @@ void DCDDumpWriter::write_frame_data(std::fstream& file,
     }
 
 /*! \param file File to write to
-    \param timestep Current time step of the simulation
+    \param frame Frame that was written
 
     Updates the pointers in the main file header to reflect the current number of frames
     written and the last time step written.
 */
-void DCDDumpWriter::write_updated_header(std::fstream& file, uint64_t timestep)
+void DCDDumpWriter::write_updated_header(std::fstream& file, const Frame& frame)
     {
     file.seekp(NFILE_POS);
-    write_int(file, m_num_frames_written);
+    write_int(file, frame.n_frames);
 
     file.seekp(NSTEP_POS);
-    write_int(file, static_cast<uint32_t>(timestep));
-
-    if (timestep > std::numeric_limits<uint32_t>::max())
-        m_exec_conf->msg->warning() << "DCD: Truncating timestep to lower 32 bits" << endl;
+    write_int(file, static_cast<uint32_t>(frame.timestep));
     }
 
 void export_DCDDumpWriter(py::module& m)
@@ -441,5 +524,9 @@ void export_DCDDumpWriter(py::module& m)
                       &DCDDumpWriter::getUnwrapRigid,
                       &DCDDumpWriter::setUnwrapRigid)
         .def_property("angle_z", &DCDDumpWriter::getAngleZ, &DCDDumpWriter::setAngleZ)
-        .def_property_readonly("overwrite", &DCDDumpWriter::getOverwrite);
+        .def_property_readonly("overwrite", &DCDDumpWriter::getOverwrite)
+        .def_property("asynchronous",
+                      &DCDDumpWriter::getAsynchronous,
+                      &DCDDumpWriter::setAsynchronous)
+        .def("flush", &DCDDumpWriter::flush);
     }
@@ -7,11 +7,13 @@
 #define __DCDDUMPWRITER_H__
 
 #include "Analyzer.h"
+#include "BackgroundWriter.h"
 #include "ParticleGroup.h"
 
 #include <fstream>
 #include <memory>
 #include <string>
+#include <vector>
 
 /*! \file DCDDumpWriter.h
     \brief Declares the DCDDumpWriter class
@@ -45,6 +47,10 @@
     Due to a limitation in the DCD format, the time step period between calls to
     analyze() \b must be specified up front. If analyze() detects that this period is
     not being maintained, it will print a warning but continue.
+
+    analyze() packs the coordinates of the group members into a Frame in tag order. Without a
+    domain decomposition, the coordinates are read directly from the particle data arrays. In
+    asynchronous mode, a background thread writes the frames to the file.
     \ingroup analyzers
 */
 class PYBIND11_EXPORT DCDDumpWriter : public Analyzer
@@ -101,7 +107,33 @@ class PYBIND11_EXPORT DCDDumpWriter : public Analyzer
         return m_overwrite;
         }
 
+    //! Enable or disable writing frames on a background thread
+    void setAsynchronous(bool asynchronous);
+
+    bool getAsynchronous()
+        {
+        return m_asynchronous;
+        }
+
+    //! Wait until all buffered frames are written to the file
+    virtual void flush();
+
+    /// Stop the background writer when removed from the Simulation
+    virtual void notifyDetach()
+        {
+        m_writer.stop();
+        }
+
     private:
+    /// Coordinates and box of one frame
+    struct Frame
+        {
+        uint64_t timestep;      //!< Time step of the frame
+        unsigned int n_frames;  //!< Number of frames in the file after this frame is written
+        double unitcell[6];     //!< Box in the DCD unit cell format
+        std::vector<float> xyz; //!< x, y, and z coordinates of all group members, in that order
+        };
+
     std::string m_fname;                    //!< The file name we are writing to
     uint64_t m_start_timestep;              //!< First time step written to the file
     unsigned int m_period;                  //!< Time step period between writes
@@ -117,21 +149,27 @@ class PYBIND11_EXPORT DCDDumpWriter : public Analyzer
     bool m_is_initialized;  //!< True if file IO has been initialized
     unsigned int m_nglobal; //!< Initial number of particles
 
-    float* m_staging_buffer; //!< Buffer for staging particle positions in tag order
-    std::fstream m_file;     //!< The file object
+    std::fstream m_file; //!< The file object
+
+    bool m_asynchronous = false;             //!< True if frames are written on a background thread
+    hoomd::detail::BackgroundWriter m_writer; //!< Writes frames on a background thread
 
     // helper functions
 
     //! Initializes the file header
     void write_file_header(std::fstream& file);
     //! Writes the frame header
-    void write_frame_header(std::fstream& file);
+    void write_frame_header(std::fstream& file, const Frame& frame);
     //! Writes the particle positions for a frame
-    void write_frame_data(std::fstream& file, const SnapshotParticleData<Scalar>& snapshot);
+    void write_frame_data(std::fstream& file, const Frame& frame);
     //! Updates the file header
-    void write_updated_header(std::fstream& file, uint64_t timestep);
+    void write_updated_header(std::fstream& file, const Frame& frame);
     //! Initializes the output file for writing
     void initFileIO(uint64_t timestep);
+    //! Pack the box and coordinates of the current time step
+    void packFrame(Frame& frame);
+    //! Write a frame to the end of the file and update the header
+    void writeFrame(const Frame& frame);
     };
 
 //! Exports the DCDDumpWriter class to python
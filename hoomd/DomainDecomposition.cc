@@ -11,6 +11,7 @@
 #include "DomainDecomposition.h"
 
 #include "ParticleData.h"
+#include "SnapshotSystemData.h"
 #include "SystemDefinition.h"
 
 #include "HOOMDMPI.h"
@@ -567,6 +568,134 @@ void DomainDecomposition::setCumulativeFractions(unsigned int dir,
         }
     }
 
+/*!
+ * \param snapshot Snapshot holding the initial configuration
+ *
+ * The particle positions are histogrammed along each direction with more than one domain, and the
+ * cut planes are placed at the quantiles of the histogram. Only the marginal distributions matter
+ * because the cut planes along a direction are shared by all domains. No domain is made narrower
+ * than a quarter of the uniform width, which keeps the domains wider than the ghost layer in all
+ * but very small boxes.
+ *
+ * The snapshot is read on the root rank, or on every rank when it is distributed.
+ */
+template<class Real>
+void DomainDecomposition::balanceFractions(const SnapshotSystemData<Real>& snapshot)
+    {
+    const unsigned int bins_per_domain = 32;
+    const Scalar min_width = Scalar(0.25);
+
+    const BoxDim& box = snapshot.global_box;
+    const SnapshotParticleData<Real>& particles = snapshot.particle_data;
+    const unsigned int n_domains[3] = {m_nx, m_ny, m_nz};
+
+    std::vector<unsigned int> hist[3];
+    for (unsigned int dir = 0; dir < 3; ++dir)
+        {
+        if (n_domains[dir] > 1)
+            hist[dir].resize(bins_per_domain * n_domains[dir], 0);
+        }
+
+    if (particles.is_distributed || m_exec_conf->getRank() == 0)
+        {
+        for (unsigned int i = 0; i < particles.size; ++i)
+            {
+            const vec3<Real>& pos = particles.pos[i];
+            const Scalar3 f = box.makeFraction(make_scalar3(pos.x, pos.y, pos.z));
+            const Scalar fs[3] = {f.x, f.y, f.z};
+            for (unsigned int dir = 0; dir < 3; ++dir)
+                {
+                if (hist[dir].empty())
+                    continue;
+
+                const unsigned int n_bins = (unsigned int)hist[dir].size();
+                int bin = int(fs[dir] * Scalar(n_bins));
+                bin = std::max(0, std::min(bin, int(n_bins) - 1));
+                ++hist[dir][bin];
+                }
+            }
+        }
+
+    for (unsigned int dir = 0; dir < 3; ++dir)
+        {
+        if (hist[dir].empty())
+            continue;
+
+        const unsigned int n_bins = (unsigned int)hist[dir].size();
+        MPI_Allreduce(MPI_IN_PLACE, &hist[dir][0], n_bins, MPI_UNSIGNED, MPI_SUM, m_mpi_comm);
+
+        const unsigned int n = n_domains[dir];
+        const double total = std::accumulate(hist[dir].begin(), hist[dir].end(), 0.0);
+        if (total == 0.0)
+            continue;
+
+        // place a cut plane at every quantile, interpolating linearly within the bins
+        std::vector<Scalar> widths(n);
+        double cum_count = 0.0;
+        double last_cut = 0.0;
+        unsigned int bin = 0;
+        for (unsigned int k = 1; k < n; ++k)
+            {
+            const double target = total * double(k) / double(n);
+            while (bin < n_bins - 1 && cum_count + hist[dir][bin] < target)
+                {
+                cum_count += hist[dir][bin];
+                ++bin;
+                }
+            const double in_bin
+                = (hist[dir][bin] > 0) ? (target - cum_count) / double(hist[dir][bin]) : 0.0;
+            const double cut = (double(bin) + std::min(in_bin, 1.0)) / double(n_bins);
+            widths[k - 1] = Scalar(cut - last_cut);
+            last_cut = cut;
+            }
+        widths[n - 1] = Scalar(1.0 - last_cut);
+
+        // widen the narrow domains to the minimum and shrink the others proportionally
+        const Scalar min_frac = min_width / Scalar(n);
+        std::vector<bool> clamped(n, false);
+        bool changed = true;
+        while (changed)
+            {
+            changed = false;
+            Scalar free_width(0.0);
+            unsigned int n_clamped = 0;
+            for (unsigned int i = 0; i < n; ++i)
+                {
+                if (clamped[i])
+                    ++n_clamped;
+                else
+                    free_width += widths[i];
+                }
+
+            const Scalar scale = (Scalar(1.0) - Scalar(n_clamped) * min_frac) / free_width;
+            for (unsigned int i = 0; i < n; ++i)
+                {
+                if (clamped[i])
+                    continue;
+
+                widths[i] *= scale;
+                if (widths[i] < min_frac)
+                    {
+                    widths[i] = min_frac;
+                    clamped[i] = true;
+                    changed = true;
+                    }
+                }
+            }
+
+        std::vector<Scalar> cum_frac(n + 1);
+        cum_frac[0] = Scalar(0.0);
+        for (unsigned int i = 0; i < n - 1; ++i)
+            cum_frac[i + 1] = cum_frac[i] + widths[i];
+        cum_frac[n] = Scalar(1.0);
+
+        setCumulativeFractions(dir, cum_frac, 0);
+        }
+    }
+
+template void DomainDecomposition::balanceFractions(const SnapshotSystemData<float>& snapshot);
+template void DomainDecomposition::balanceFractions(const SnapshotSystemData<double>& snapshot);
+
 /*!
  * \param global_box The global simulation box
  * \returns The local simulation box for the current rank
@@ -671,6 +800,20 @@ void DomainDecomposition::findCommonNodes()
     MPI_Get_processor_name(procname, &len);
     std::string s(procname, len);
 
+    // ranks that can share memory run on the same node, identify every node by the processor
+    // name and rank of its first rank because processor names need not be unique
+    MPI_Comm node_comm;
+    MPI_Comm_split_type(m_exec_conf->getMPICommunicator(),
+                        MPI_COMM_TYPE_SHARED,
+                        m_exec_conf->getRank(),
+                        MPI_INFO_NULL,
+                        &node_comm);
+    std::ostringstream oss;
+    oss << s << " (rank " << m_exec_conf->getRank() << ")";
+    s = oss.str();
+    bcast(s, 0, node_comm);
+    MPI_Comm_free(&node_comm);
+
     // collect node names from all ranks on rank zero
     std::vector<std::string> nodes;
     gather_v(s, nodes, 0, m_exec_conf->getMPICommunicator());
@@ -728,6 +871,8 @@ void export_DomainDecomposition(py::module& m)
                       const std::vector<Scalar>&,
                       const std::vector<Scalar>&,
                       const std::vector<Scalar>&>())
-        .def("getCumulativeFractions", &DomainDecomposition::getCumulativeFractions);
+        .def("getCumulativeFractions", &DomainDecomposition::getCumulativeFractions)
+        .def("balanceFractions", &DomainDecomposition::balanceFractions<float>)
+        .def("balanceFractions", &DomainDecomposition::balanceFractions<double>);
     }
 #endif // ENABLE_MPI
@@ -23,6 +23,8 @@
 #include <pybind11/pybind11.h>
 #endif
 
+template<class Real> struct SnapshotSystemData;
+
 /*! \ingroup communication
  */
 
@@ -44,6 +46,9 @@
  * box is covered. If the specified number of ranks does not match the number that is available,
  * behavior is reverted to the normal default with uniform cuts along each dimension.
  *
+ *  The cuts can also be placed from the particle density of the initial configuration with
+ * balanceFractions(), so that every domain starts with approximately the same number of particles.
+ *
  *  The initialization of the domain decomposition scheme is performed in the constructor.
  */
 class PYBIND11_EXPORT DomainDecomposition
@@ -157,6 +162,9 @@ class PYBIND11_EXPORT DomainDecomposition
                                 const std::vector<Scalar>& cum_frac,
                                 unsigned int root);
 
+    //! Collectively place the cut planes so that the domains hold equal numbers of particles
+    template<class Real> void balanceFractions(const SnapshotSystemData<Real>& snapshot);
+
     //! Get the dimensions of the local simulation box
     const BoxDim calculateLocalBox(const BoxDim& global_box);
 
@@ -32,6 +32,8 @@ using namespace std;
 #include "CachedAllocator.h"
 #endif
 
+#include "StepArena.h"
+
 /*! \file ExecutionConfiguration.cc
     \brief Defines ExecutionConfiguration and related classes
 */
@@ -54,7 +56,9 @@ ExecutionConfiguration::ExecutionConfiguration(executionMode mode,
                                                std::vector<int> gpu_id,
                                                std::shared_ptr<MPIConfiguration> mpi_config,
                                                std::shared_ptr<Messenger> _msg)
-    : msg(_msg), m_hip_error_checking(false), m_mpi_config(mpi_config)
+    : msg(_msg), m_hip_error_checking(false), m_mpi_config(mpi_config),
+      m_memory_traceback(new MemoryTraceback(false)),
+      m_tuning_cache(new hoomd::detail::AutotunerCache())
     {
     if (!m_mpi_config)
         {
@@ -77,6 +81,8 @@ ExecutionConfiguration::ExecutionConfiguration(executionMode mode,
     msg->notice(5) << "Constructing ExecutionConfiguration: ( " << s.str() << ") " << endl;
     exec_mode = mode;
 
+    m_host_arena.reset(new StepArena(false));
+
 #if defined(ENABLE_HIP)
     // scan the available GPUs
     scanGPUs();
@@ -186,6 +192,7 @@ ExecutionConfiguration::ExecutionConfiguration(executionMode mode,
             new CachedAllocator(false, (unsigned int)(0.5f * (float)dev_prop.totalGlobalMem)));
         m_cached_alloc_managed.reset(
             new CachedAllocator(true, (unsigned int)(0.5f * (float)dev_prop.totalGlobalMem)));
+        m_device_arena.reset(new StepArena(true));
         }
 #endif
 
@@ -250,7 +257,34 @@ ExecutionConfiguration::~ExecutionConfiguration()
     // the destructors of these objects can issue hip calls, so free them before the device reset
     m_cached_alloc.reset();
     m_cached_alloc_managed.reset();
+    m_device_arena.reset();
+#endif
+    }
+
+/*! System::run() calls resetArenas() at the start of every time step. Temporaries from the arenas
+    must not outlive the step in which they were allocated.
+*/
+void ExecutionConfiguration::resetArenas()
+    {
+    m_host_arena->reset();
+#if defined(ENABLE_HIP)
+    if (m_device_arena)
+        m_device_arena->reset();
+#endif
+    }
+
+/*! The arenas are reported under StepArena::host and StepArena::device, including the overflow
+    blocks of allocations that are still alive.
+*/
+std::map<std::string, size_t> ExecutionConfiguration::getMemoryReport() const
+    {
+    std::map<std::string, size_t> report = m_memory_traceback->getReport();
+    report["StepArena::host"] = m_host_arena->getAllocatedBytes();
+#if defined(ENABLE_HIP)
+    if (m_device_arena)
+        report["StepArena::device"] = m_device_arena->getAllocatedBytes();
 #endif
+    return report;
     }
 
 #if defined(ENABLE_HIP)
@@ -685,6 +719,23 @@ void export_ExecutionConfiguration(py::module& m)
         .def("setMemoryTracing", &ExecutionConfiguration::setMemoryTracing)
         .def("getMemoryTracer", &ExecutionConfiguration::getMemoryTracer)
         .def("memoryTracingEnabled", &ExecutionConfiguration::memoryTracingEnabled)
+        .def("getMemoryReport", &ExecutionConfiguration::getMemoryReport)
+        .def("setTransferTracing", &ExecutionConfiguration::setTransferTracing)
+        .def("getTransferTracing", &ExecutionConfiguration::getTransferTracing)
+        .def("getTransferReport", &ExecutionConfiguration::getTransferReport)
+        .def("resetTransferReport", &ExecutionConfiguration::resetTransferReport)
+        .def("setDeterministic", &ExecutionConfiguration::setDeterministic)
+        .def("getDeterministic", &ExecutionConfiguration::getDeterministic)
+        .def("setShrinkFraction", &ExecutionConfiguration::setShrinkFraction)
+        .def("getShrinkFraction", &ExecutionConfiguration::getShrinkFraction)
+        .def("setShrinkDelay", &ExecutionConfiguration::setShrinkDelay)
+        .def("getShrinkDelay", &ExecutionConfiguration::getShrinkDelay)
+        .def("loadTuningCache", &ExecutionConfiguration::loadTuningCache)
+        .def("saveTuningCache", &ExecutionConfiguration::saveTuningCache)
+        .def("setTuningCacheRead", &ExecutionConfiguration::setTuningCacheRead)
+        .def("getScanningAutotuners", &ExecutionConfiguration::getScanningAutotuners)
+        .def("getTuningReport", &ExecutionConfiguration::getTuningReport)
+        .def("resetTuningReport", &ExecutionConfiguration::resetTuningReport)
         .def_static("getCapableDevices", &ExecutionConfiguration::getCapableDevices)
         .def_static("getScanMessages", &ExecutionConfiguration::getScanMessages)
         .def("getActiveDevices", &ExecutionConfiguration::getActiveDevices);
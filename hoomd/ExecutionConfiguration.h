@@ -16,6 +16,7 @@
 #include "MPIConfiguration.h"
 
 #include <memory>
+#include <stdexcept>
 #include <string>
 #include <vector>
 
@@ -32,6 +33,7 @@
 #include <tbb/task_arena.h>
 #endif
 
+#include "AutotunerCache.h"
 #include "MemoryTraceback.h"
 #include "Messenger.h"
 
@@ -51,6 +53,9 @@
 class CachedAllocator;
 #endif
 
+//! Forward declaration
+class StepArena;
+
 //! Defines the execution configuration for the simulation
 /*! \ingroup data_structs
     ExecutionConfiguration is a data structure needed to support the hybrid CPU/GPU code. It
@@ -295,15 +300,29 @@ class PYBIND11_EXPORT ExecutionConfiguration
         {
         return *m_cached_alloc_managed;
         }
+
+    //! Returns the arena for device temporaries that live no longer than one time step
+    StepArena& getDeviceArena() const
+        {
+        return *m_device_arena;
+        }
 #endif
 
+    //! Returns the arena for host temporaries that live no longer than one time step
+    StepArena& getHostArena() const
+        {
+        return *m_host_arena;
+        }
+
+    //! Invalidate all arena allocations at the start of a time step
+    void resetArenas();
+
     //! Set up memory tracing
+    /*! Allocations are always accounted for, \a enable controls whether stack traces are recorded.
+     */
     void setMemoryTracing(bool enable)
         {
-        if (enable)
-            m_memory_traceback = std::unique_ptr<MemoryTraceback>(new MemoryTraceback);
-        else
-            m_memory_traceback = std::unique_ptr<MemoryTraceback>();
+        m_memory_traceback->setBacktrace(enable);
         }
 
     //! Returns the memory tracer
@@ -312,9 +331,133 @@ class PYBIND11_EXPORT ExecutionConfiguration
         return m_memory_traceback.get();
         }
 
+    /// Get the cache of autotuner results
+    hoomd::detail::AutotunerCache& getTuningCache() const
+        {
+        return *m_tuning_cache;
+        }
+
+    /// Add the autotuner results in a file to the cache
+    void loadTuningCache(const std::string& filename)
+        {
+        m_tuning_cache->load(filename);
+        }
+
+    /// Write the cached autotuner results to a file
+    void saveTuningCache(const std::string& filename) const
+        {
+        m_tuning_cache->save(filename);
+        }
+
+    /// Set whether autotuners use cached results in place of their initial scans
+    void setTuningCacheRead(bool enable)
+        {
+        m_tuning_cache->setReadEnabled(enable);
+        }
+
+    /// Get the names of the autotuners in their initial scan
+    std::vector<std::string> getScanningAutotuners() const
+        {
+        const auto& scanning = m_tuning_cache->getScanning();
+        return std::vector<std::string>(scanning.begin(), scanning.end());
+        }
+
+    /// Get the results stored in the cache since the last call to resetTuningReport()
+    /*! \returns A map from each cache key to the optimal parameter and its kernel time (ms)
+     */
+    std::map<std::string, std::pair<unsigned int, float>> getTuningReport() const
+        {
+        std::map<std::string, std::pair<unsigned int, float>> report;
+        for (const auto& key : m_tuning_cache->getUpdated())
+            {
+            hoomd::detail::AutotunerCache::Entry entry;
+            // read the entry directly, find() may be disabled
+            if (m_tuning_cache->get(key, entry))
+                report[key] = std::make_pair(entry.param, entry.time);
+            }
+        return report;
+        }
+
+    /// Start a new tuning report
+    void resetTuningReport()
+        {
+        m_tuning_cache->clearUpdated();
+        }
+
     bool memoryTracingEnabled() const
         {
-        return m_memory_traceback.get() != nullptr;
+        return m_memory_traceback->getBacktrace();
+        }
+
+    //! Get the number of bytes held by each tagged allocation and the arenas on this rank
+    std::map<std::string, size_t> getMemoryReport() const;
+
+    //! Set whether to record the implicit copies of arrays between the host and the device
+    void setTransferTracing(bool enable)
+        {
+        m_memory_traceback->setTransferTracing(enable);
+        }
+
+    //! Get whether the implicit copies of arrays between the host and the device are recorded
+    bool getTransferTracing() const
+        {
+        return m_memory_traceback->getTransferTracing();
+        }
+
+    //! Get the number of copies and the bytes copied for each array and direction on this rank
+    std::map<std::string, std::pair<size_t, size_t>> getTransferReport() const
+        {
+        return m_memory_traceback->getTransferReport();
+        }
+
+    //! Clear the recorded copies
+    void resetTransferReport()
+        {
+        m_memory_traceback->resetTransferReport();
+        }
+
+    /// Set the reproducible summation mode
+    /*! When enabled, GPU kernels sum forces in 64-bit fixed point or in a fixed order, so that
+        repeated runs give bitwise identical results at some cost in performance.
+    */
+    void setDeterministic(bool deterministic)
+        {
+        m_deterministic = deterministic;
+        }
+
+    /// Get the reproducible summation mode
+    bool getDeterministic() const
+        {
+        return m_deterministic;
+        }
+
+    /// Set the fraction of capacity below which GPUVector and GlobalVector shrink
+    /*! A vector shrinks to fit its size after it stays below \a fraction of its capacity for
+        getShrinkDelay() consecutive resizes. Set \a fraction to 0 to never shrink.
+    */
+    void setShrinkFraction(double fraction)
+        {
+        if (fraction < 0.0 || fraction >= 1.0)
+            throw std::domain_error("The shrink fraction must be in the range [0, 1).");
+        m_shrink_fraction = fraction;
+        }
+
+    /// Get the fraction of capacity below which vectors shrink
+    double getShrinkFraction() const
+        {
+        return m_shrink_fraction;
+        }
+
+    /// Set the number of consecutive resizes below the shrink fraction before a vector shrinks
+    void setShrinkDelay(unsigned int delay)
+        {
+        m_shrink_delay = delay;
+        }
+
+    /// Get the number of consecutive resizes below the shrink fraction before a vector shrinks
+    unsigned int getShrinkDelay() const
+        {
+        return m_shrink_delay;
         }
 
     //! Returns true if we are in a multi-GPU block
@@ -412,8 +555,11 @@ class PYBIND11_EXPORT ExecutionConfiguration
     std::unique_ptr<CachedAllocator> m_cached_alloc; //!< Cached allocator for temporary allocations
     std::unique_ptr<CachedAllocator>
         m_cached_alloc_managed; //!< Cached allocator for temporary allocations in managed memory
+    std::unique_ptr<StepArena> m_device_arena; //!< Arena for per-step device temporaries
 #endif
 
+    std::unique_ptr<StepArena> m_host_arena; //!< Arena for per-step host temporaries
+
 #ifdef ENABLE_TBB
     std::shared_ptr<tbb::task_arena> m_task_arena; //!< The TBB task arena
     unsigned int m_num_threads;                    //!<  The number of TBB threads used
@@ -423,6 +569,14 @@ class PYBIND11_EXPORT ExecutionConfiguration
     void setupStats();
 
     std::unique_ptr<MemoryTraceback> m_memory_traceback; //!< Keeps track of allocations
+
+    bool m_deterministic = false; //!< True when GPU kernels sum forces reproducibly
+
+    double m_shrink_fraction = 0.0;    //!< Vectors below this fraction of capacity shrink
+    unsigned int m_shrink_delay = 100; //!< Number of resizes below the fraction before shrinking
+
+    /// Autotuner results shared by all autotuners
+    std::unique_ptr<hoomd::detail::AutotunerCache> m_tuning_cache;
     };
 
 #if defined(ENABLE_HIP)
@@ -0,0 +1,57 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#ifndef __HOOMD_FIXED_POINT_H__
+#define __HOOMD_FIXED_POINT_H__
+
+#include "hoomd/HOOMDMath.h"
+
+/*! \file FixedPoint.h
+    \brief Conversions between Scalar and the 64-bit fixed point format used for reproducible sums
+
+    Floating point addition is not associative, so sums accumulated with atomic operations depend
+    on the order in which the threads execute. Integer addition is associative: values converted to
+    fixed point and summed with 64-bit integer atomics give bitwise identical results regardless of
+    the order. The conversion back to Scalar happens once, after the sum is complete.
+
+    The fixed point format has 32 fractional bits. It represents values of magnitude less than 2^31
+    with an absolute resolution of 2^-32. Larger values overflow silently.
+*/
+
+// need to declare these class methods with __device__ qualifiers when building in nvcc
+// HOSTDEVICE is __host__ __device__ when included in nvcc and blank when included into the host
+// compiler
+#ifdef __HIPCC__
+#define HOSTDEVICE __host__ __device__
+#else
+#define HOSTDEVICE
+#endif
+
+namespace hoomd
+    {
+//! Scale factor between a Scalar and its fixed point representation
+constexpr double fixed_point_scale = 4294967296.0;
+
+//! Convert a Scalar to fixed point
+/*! \param x Value to convert
+    \returns The two's complement fixed point representation of \a x, rounded to nearest
+*/
+HOSTDEVICE inline unsigned long long scalar_to_fixed(Scalar x)
+    {
+    return (unsigned long long)(::llrint(double(x) * fixed_point_scale));
+    }
+
+//! Convert a fixed point value to Scalar
+/*! \param x Two's complement fixed point value
+    \returns The value of \a x
+*/
+HOSTDEVICE inline Scalar fixed_to_scalar(unsigned long long x)
+    {
+    return Scalar(double((long long)x) / fixed_point_scale);
+    }
+
+    } // end namespace hoomd
+
+#undef HOSTDEVICE
+
+#endif // __HOOMD_FIXED_POINT_H__
@@ -28,7 +28,7 @@ namespace py = pybind11;
     \post All forces are initialized to 0
 */
 ForceCompute::ForceCompute(std::shared_ptr<SystemDefinition> sysdef)
-    : Compute(sysdef), m_particles_sorted(false)
+    : Compute(sysdef), m_particles_sorted(false), m_keep_force_arrays(false)
     {
     assert(m_pdata);
     assert(m_pdata->getMaxN() > 0);
@@ -79,11 +79,22 @@ ForceCompute::ForceCompute(std::shared_ptr<SystemDefinition> sysdef)
         }
 #endif
 
+#ifdef ENABLE_HIP
+    // execute on the default stream unless the integrator assigns a stream
+    m_stream = 0;
+    if (m_exec_conf->isCUDAEnabled())
+        hipEventCreateWithFlags(&m_stream_event, hipEventDisableTiming);
+#endif
+
     m_virial_pitch = m_virial.getPitch();
 
     // connect to the ParticleData to receive notifications when particles change order in memory
     m_pdata->getParticleSortSignal().connect<ForceCompute, &ForceCompute::setParticlesSorted>(this);
 
+    // forces also need to be recomputed when particle properties are modified in place
+    m_pdata->getParticlesModifiedSignal()
+        .connect<ForceCompute, &ForceCompute::setParticlesSorted>(this);
+
     // connect to the ParticleData to receive notifications when the maximum number of particles
     // changes
     m_pdata->getMaxParticleNumberChangeSignal().connect<ForceCompute, &ForceCompute::reallocate>(
@@ -106,19 +117,25 @@ ForceCompute::ForceCompute(std::shared_ptr<SystemDefinition> sysdef)
  */
 void ForceCompute::reallocate()
     {
-    m_force.resize(m_pdata->getMaxN());
-    m_virial.resize(m_pdata->getMaxN(), 6);
-    m_torque.resize(m_pdata->getMaxN());
-
+    // released arrays are allocated at the new size when they are restored
+    if (!m_force.isNull())
         {
+        m_force.resize(m_pdata->getMaxN());
+        m_virial.resize(m_pdata->getMaxN(), 6);
+
         ArrayHandle<Scalar4> h_force(m_force, access_location::host, access_mode::overwrite);
-        ArrayHandle<Scalar4> h_torque(m_torque, access_location::host, access_mode::overwrite);
         ArrayHandle<Scalar> h_virial(m_virial, access_location::host, access_mode::overwrite);
         memset(h_force.data, 0, sizeof(Scalar4) * m_force.getNumElements());
-        memset(h_torque.data, 0, sizeof(Scalar4) * m_torque.getNumElements());
         memset(h_virial.data, 0, sizeof(Scalar) * m_virial.getNumElements());
         }
 
+    m_torque.resize(m_pdata->getMaxN());
+
+        {
+        ArrayHandle<Scalar4> h_torque(m_torque, access_location::host, access_mode::overwrite);
+        memset(h_torque.data, 0, sizeof(Scalar4) * m_torque.getNumElements());
+        }
+
     // the pitch of the virial array may have changed
     m_virial_pitch = m_virial.getPitch();
 
@@ -126,10 +143,59 @@ void ForceCompute::reallocate()
     updateGPUAdvice();
     }
 
+/*! The integrator releases the arrays of forces that support it when it elides the per-compute
+    arrays. compute() restores them when called with the arrays released.
+*/
+void ForceCompute::releaseForceArrays()
+    {
+    GlobalArray<Scalar4> force;
+    GlobalArray<Scalar> virial;
+    m_force.swap(force);
+    m_virial.swap(virial);
+    m_virial_pitch = 0;
+    }
+
+/*! \param force Force array to exchange with m_force
+    \param virial Virial array to exchange with m_virial
+
+    The integrator swaps its shared arrays in before computing a force with released arrays, and
+    swaps them out again after adding the result to the net force.
+*/
+void ForceCompute::swapForceArrays(GlobalArray<Scalar4>& force, GlobalArray<Scalar>& virial)
+    {
+    m_force.swap(force);
+    m_virial.swap(virial);
+    m_virial_pitch = m_virial.getPitch();
+    }
+
+/*! \post m_force and m_virial are allocated, zeroed, and kept from now on
+ */
+void ForceCompute::restoreForceArrays()
+    {
+    GlobalArray<Scalar4> force(m_pdata->getMaxN(), m_exec_conf);
+    GlobalArray<Scalar> virial(m_pdata->getMaxN(), 6, m_exec_conf);
+    m_force.swap(force);
+    TAG_ALLOCATION(m_force);
+    m_virial.swap(virial);
+    TAG_ALLOCATION(m_virial);
+
+        {
+        ArrayHandle<Scalar4> h_force(m_force, access_location::host, access_mode::overwrite);
+        ArrayHandle<Scalar> h_virial(m_virial, access_location::host, access_mode::overwrite);
+        memset(h_force.data, 0, sizeof(Scalar4) * m_force.getNumElements());
+        memset(h_virial.data, 0, sizeof(Scalar) * m_virial.getNumElements());
+        }
+
+    m_virial_pitch = m_virial.getPitch();
+    m_keep_force_arrays = true;
+    updateGPUAdvice();
+    }
+
 void ForceCompute::updateGPUAdvice()
     {
 #if defined(ENABLE_HIP) && defined(__HIP_PLATFORM_NVCC__)
-    if (m_exec_conf->isCUDAEnabled() && m_exec_conf->allConcurrentManagedAccess())
+    if (m_exec_conf->isCUDAEnabled() && m_exec_conf->allConcurrentManagedAccess()
+        && !m_force.isNull())
         {
         auto gpu_map = m_exec_conf->getGPUIds();
 
@@ -199,10 +265,36 @@ ForceCompute::~ForceCompute()
     {
     m_pdata->getParticleSortSignal().disconnect<ForceCompute, &ForceCompute::setParticlesSorted>(
         this);
+    m_pdata->getParticlesModifiedSignal()
+        .disconnect<ForceCompute, &ForceCompute::setParticlesSorted>(this);
     m_pdata->getMaxParticleNumberChangeSignal().disconnect<ForceCompute, &ForceCompute::reallocate>(
         this);
+#ifdef ENABLE_HIP
+    if (m_exec_conf->isCUDAEnabled())
+        hipEventDestroy(m_stream_event);
+#endif
     }
 
+#ifdef ENABLE_HIP
+void ForceCompute::waitForDefaultStream()
+    {
+    if (!m_stream)
+        return;
+
+    hipEventRecord(m_stream_event, 0);
+    hipStreamWaitEvent(m_stream, m_stream_event, 0);
+    }
+
+void ForceCompute::joinStream()
+    {
+    if (!m_stream)
+        return;
+
+    hipEventRecord(m_stream_event, m_stream);
+    hipStreamWaitEvent(0, m_stream_event, 0);
+    }
+#endif
+
 /*! Sums the total potential energy calculated by the last call to compute() and returns it.
  */
 Scalar ForceCompute::calcEnergySum()
@@ -228,6 +320,16 @@ Scalar ForceCompute::calcEnergySum()
     return Scalar(pe_total);
     }
 
+/*! \param quantity Name of the quantity
+    \returns A function returning the value, or an empty function for unknown quantities
+*/
+std::function<Scalar()> ForceCompute::getLogScalar(const std::string& quantity)
+    {
+    if (quantity == "energy")
+        return [this]() { return calcEnergySum(); };
+    return Compute::getLogScalar(quantity);
+    }
+
 /*! Sums the potential energy of a particle group calculated by the last call to compute() and
  * returns it.
  */
@@ -513,10 +615,21 @@ pybind11::object ForceCompute::getVirialsPython()
 void ForceCompute::compute(uint64_t timestep)
     {
     Compute::compute(timestep);
+
+    // the integrator released the arrays of this force and now its forces are requested directly,
+    // keep arrays of its own from now on and compute into them
+    if (m_force.isNull())
+        {
+        restoreForceArrays();
+        m_force_compute = true;
+        }
+
     // recompute forces if the particles were sorted, this is a new timestep, or the particle data
     // flags do not match
     if (m_particles_sorted || shouldCompute(timestep) || m_pdata->getFlags() != m_computed_flags)
         {
+        ScopedToolRange range(m_profile_name);
+        ScopedOperationTimer timer(m_timer);
         computeForces(timestep);
         }
 
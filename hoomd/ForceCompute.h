@@ -19,6 +19,13 @@
 
 #include <hoomd/extern/nano-signal-slot/nano_signal_slot.hpp>
 #include <memory>
+#include <vector>
+
+#ifdef ENABLE_TBB
+#include <tbb/blocked_range.h>
+#include <tbb/enumerable_thread_specific.h>
+#include <tbb/parallel_for.h>
+#endif
 
 /*! \file ForceCompute.h
     \brief Declares the ForceCompute class
@@ -75,6 +82,9 @@ class PYBIND11_EXPORT ForceCompute : public Compute
     //! Computes the forces
     virtual void compute(uint64_t timestep);
 
+    //! Get a function that evaluates a scalar loggable quantity
+    virtual std::function<Scalar()> getLogScalar(const std::string& quantity);
+
     //! Benchmark the force compute
     virtual double benchmark(unsigned int num_iters);
 
@@ -176,9 +186,84 @@ class PYBIND11_EXPORT ForceCompute : public Compute
         return false;
         }
 
+    //! Returns true if compute() may execute concurrently with the compute() of other forces
+    /*! Integrator::computeNetForce() computes such forces on separate threads. Their
+        computeForces() must access the particle data on the host read only, write only to the
+        arrays of this force, and not communicate with other ranks.
+    */
+    virtual bool supportsConcurrentCompute()
+        {
+        return false;
+        }
+
+    //! Returns true if computeForces() overwrites the forces of all local particles
+    /*! The integrator may release the force and virial arrays of such forces and have them compute
+        into arrays that it shares among them (see Integrator::setElideForceArrays()).
+        computeForces() must overwrite the force and energy of every local particle, and the virial
+        when the pressure tensor flag is set, and must not read back results of earlier calls.
+    */
+    virtual bool supportsElidedForceArrays()
+        {
+        return false;
+        }
+
+    //! Returns true once the forces of this compute have been requested outside of the integrator
+    bool getKeepForceArrays()
+        {
+        return m_keep_force_arrays;
+        }
+
+    //! Release the force and virial arrays
+    void releaseForceArrays();
+
+    //! Exchange the force and virial arrays with the given ones
+    void swapForceArrays(GlobalArray<Scalar4>& force, GlobalArray<Scalar>& virial);
+
+    //! Returns the compute that compute() updates before computing the forces, if any
+    /*! Concurrent forces that depend on the same compute (such as a neighbor list) are computed one
+        after the other on the same thread.
+    */
+    virtual std::shared_ptr<Compute> getComputeDependency()
+        {
+        return std::shared_ptr<Compute>();
+        }
+
+#ifdef ENABLE_HIP
+    //! Returns true if computeForces() enqueues all of its GPU work on the stream from setStream()
+    virtual bool supportsStreams()
+        {
+        return false;
+        }
+
+    //! Set the stream that computeForces() executes on
+    /*! \param stream A stream created with hipStreamNonBlocking, or 0 for the default stream
+
+        Integrator::computeNetForceGPU() assigns streams to the forces that support them, so that
+        their kernels execute concurrently with those of the other forces.
+    */
+    void setStream(hipStream_t stream)
+        {
+        m_stream = stream;
+        }
+
+    //! Make the default stream wait for the work enqueued on the stream of this force
+    void joinStream();
+#endif
+
     protected:
     bool m_particles_sorted; //!< Flag set to true when particles are resorted in memory
 
+#ifdef ENABLE_HIP
+    hipStream_t m_stream;      //!< Stream that computeForces() executes on
+    hipEvent_t m_stream_event; //!< Orders the work on m_stream with the default stream
+
+    //! Make the stream of this force wait for the work enqueued on the default stream
+    /*! Call after acquiring the inputs on the device, which may launch kernels on the default
+        stream, and before launching the first kernel on m_stream.
+    */
+    void waitForDefaultStream();
+#endif
+
     //! Helper function called when particles are sorted
     /*! setParticlesSorted() is passed as a slot to the particle sort signal.
         It is used to flag \c m_particles_sorted so that a second call to compute
@@ -193,6 +278,9 @@ class PYBIND11_EXPORT ForceCompute : public Compute
     //! Reallocate internal arrays
     void reallocate();
 
+    //! Allocate the released force and virial arrays again
+    void restoreForceArrays();
+
     //! Update GPU memory hints
     void updateGPUAdvice();
 
@@ -217,6 +305,185 @@ class PYBIND11_EXPORT ForceCompute : public Compute
     /// Store the particle data flags used during the last computation
     PDataFlags m_computed_flags;
 
+    /// True when the integrator may no longer release the force and virial arrays
+    bool m_keep_force_arrays;
+
+#ifdef ENABLE_TBB
+    /// Per-thread force accumulators used by scatterForces()
+    tbb::enumerable_thread_specific<std::vector<Scalar4>> m_thread_force;
+
+    /// Per-thread torque accumulators used by scatterForcesAndTorques()
+    tbb::enumerable_thread_specific<std::vector<Scalar4>> m_thread_torque;
+
+    /// Per-thread virial accumulators used by scatterForces() when the virial is requested
+    tbb::enumerable_thread_specific<std::vector<Scalar>> m_thread_virial;
+#endif
+
+    //! Evaluate a loop that adds forces to more than one particle per iteration
+    /*! \param begin First loop index
+        \param end Last loop index (exclusive)
+        \param compute_virial Set to true to accumulate the virial
+        \param force Force array of the local particles
+        \param virial Virial array of the local particles with a pitch of m_virial_pitch
+        \param body Loop body, called as body(begin, end, force, virial, virial_pitch)
+
+        When HOOMD is built with TBB and runs more than one thread, the loop is split among the
+        threads of the task arena. Each thread adds its forces to private arrays that are summed
+        into \a force and \a virial after the loop. Otherwise, \a body is called once on the output
+        arrays. \a body may write to the entries of both local and ghost particles.
+    */
+    template<class Body>
+    void scatterForces(unsigned int begin,
+                       unsigned int end,
+                       bool compute_virial,
+                       Scalar4* force,
+                       Scalar* virial,
+                       const Body& body)
+        {
+        scatterForcesAndTorques(begin,
+                                end,
+                                compute_virial,
+                                force,
+                                nullptr,
+                                virial,
+                                [&](unsigned int r_begin,
+                                    unsigned int r_end,
+                                    Scalar4* r_force,
+                                    Scalar4* r_torque,
+                                    Scalar* r_virial,
+                                    size_t virial_pitch)
+                                { body(r_begin, r_end, r_force, r_virial, virial_pitch); });
+        }
+
+    //! Evaluate a loop that adds forces and torques to more than one particle per iteration
+    /*! \param begin First loop index
+        \param end Last loop index (exclusive)
+        \param compute_virial Set to true to accumulate the virial
+        \param force Force array of the local particles
+        \param torque Torque array of the local particles, or nullptr when there are no torques
+        \param virial Virial array of the local particles with a pitch of m_virial_pitch
+        \param body Loop body, called as body(begin, end, force, torque, virial, virial_pitch)
+
+        Like scatterForces(), with an additional per-thread accumulator for the torques.
+    */
+    template<class Body>
+    void scatterForcesAndTorques(unsigned int begin,
+                                 unsigned int end,
+                                 bool compute_virial,
+                                 Scalar4* force,
+                                 Scalar4* torque,
+                                 Scalar* virial,
+                                 const Body& body)
+        {
+#ifdef ENABLE_TBB
+        if (m_exec_conf->getNumThreads() > 1)
+            {
+            const unsigned int N = m_pdata->getN() + m_pdata->getNGhosts();
+            const bool compute_torque = torque != nullptr;
+
+            // reset the per-thread accumulators that survive from the previous call
+            for (auto& thread_force : m_thread_force)
+                thread_force.assign(N, make_scalar4(0, 0, 0, 0));
+            if (compute_torque)
+                {
+                for (auto& thread_torque : m_thread_torque)
+                    thread_torque.assign(N, make_scalar4(0, 0, 0, 0));
+                }
+            if (compute_virial)
+                {
+                for (auto& thread_virial : m_thread_virial)
+                    thread_virial.assign(6 * size_t(N), Scalar(0.0));
+                }
+
+            m_exec_conf->getTaskArena()->execute(
+                [&]
+                {
+                    tbb::parallel_for(tbb::blocked_range<unsigned int>(begin, end),
+                                      [&](const tbb::blocked_range<unsigned int>& r)
+                                      {
+                                          // threads that join after the reset start empty
+                                          std::vector<Scalar4>& thread_force
+                                              = m_thread_force.local();
+                                          if (thread_force.size() != N)
+                                              thread_force.assign(N, make_scalar4(0, 0, 0, 0));
+
+                                          Scalar* thread_virial_data = nullptr;
+                                          if (compute_virial)
+                                              {
+                                              std::vector<Scalar>& thread_virial
+                                                  = m_thread_virial.local();
+                                              if (thread_virial.size() != 6 * size_t(N))
+                                                  thread_virial.assign(6 * size_t(N),
+                                                                       Scalar(0.0));
+                                              thread_virial_data = thread_virial.data();
+                                              }
+
+                                          Scalar4* thread_torque_data = nullptr;
+                                          if (compute_torque)
+                                              {
+                                              std::vector<Scalar4>& thread_torque
+                                                  = m_thread_torque.local();
+                                              if (thread_torque.size() != N)
+                                                  thread_torque.assign(N,
+                                                                       make_scalar4(0, 0, 0, 0));
+                                              thread_torque_data = thread_torque.data();
+                                              }
+
+                                          body(r.begin(),
+                                               r.end(),
+                                               thread_force.data(),
+                                               thread_torque_data,
+                                               thread_virial_data,
+                                               size_t(N));
+                                      });
+
+                    // sum the per-thread contributions
+                    tbb::parallel_for(
+                        tbb::blocked_range<unsigned int>(0, N),
+                        [&](const tbb::blocked_range<unsigned int>& r)
+                        {
+                            for (auto& thread_force : m_thread_force)
+                                {
+                                for (unsigned int i = r.begin(); i != r.end(); ++i)
+                                    {
+                                    force[i].x += thread_force[i].x;
+                                    force[i].y += thread_force[i].y;
+                                    force[i].z += thread_force[i].z;
+                                    force[i].w += thread_force[i].w;
+                                    }
+                                }
+
+                            if (compute_torque)
+                                {
+                                for (auto& thread_torque : m_thread_torque)
+                                    {
+                                    for (unsigned int i = r.begin(); i != r.end(); ++i)
+                                        {
+                                        torque[i].x += thread_torque[i].x;
+                                        torque[i].y += thread_torque[i].y;
+                                        torque[i].z += thread_torque[i].z;
+                                        }
+                                    }
+                                }
+
+                            if (compute_virial)
+                                {
+                                for (auto& thread_virial : m_thread_virial)
+                                    {
+                                    for (unsigned int k = 0; k < 6; ++k)
+                                        for (unsigned int i = r.begin(); i != r.end(); ++i)
+                                            virial[k * m_virial_pitch + i]
+                                                += thread_virial[k * size_t(N) + i];
+                                    }
+                                }
+                        });
+                });
+            return;
+            }
+#endif
+        body(begin, end, force, torque, virial, m_virial_pitch);
+        }
+
     //! Actually perform the computation of the forces
     /*! This is pure virtual here. Sub-classes must implement this function. It will be called by
         the base class compute() when the forces need to be computed.
@@ -26,9 +26,11 @@
 #include <algorithm>
 #include <iostream>
 #include <memory>
+#include <mutex>
 #include <stdexcept>
 #include <stdlib.h>
 #include <string.h>
+#include <typeinfo>
 
 #include <cxxabi.h>
 #include <sstream>
@@ -74,6 +76,19 @@ struct access_mode
 
 template<class T> class GPUArray;
 
+namespace hoomd
+    {
+namespace detail
+    {
+//! Mutex that serializes the acquire and release bookkeeping of all GPUArrays
+inline std::mutex& gpu_array_acquire_mutex()
+    {
+    static std::mutex mutex;
+    return mutex;
+    }
+    } // end namespace detail
+    } // end namespace hoomd
+
 namespace hoomd
     {
 namespace detail
@@ -164,6 +179,11 @@ template<class T> class host_deleter
             CHECK_CUDA_ERROR();
             }
 
+        // update memory allocation table
+        if (m_exec_conf && m_exec_conf->getMemoryTracer())
+            m_exec_conf->getMemoryTracer()->unregisterAllocation(reinterpret_cast<const void*>(ptr),
+                                                                 sizeof(T) * m_N);
+
         // free the allocation
         free(ptr);
         }
@@ -532,6 +552,18 @@ template<class T> class GPUArray : public GPUArrayBase<T, GPUArray<T>>
     //! Resize a 2D GPUArray
     void resize(size_t width, size_t height);
 
+    //! Set an optional tag for memory profiling
+    /*! \param tag The name of this allocation
+     */
+    void setTag(const std::string& tag)
+        {
+        m_tag = tag;
+        if (m_exec_conf && m_exec_conf->getMemoryTracer() && h_data)
+            m_exec_conf->getMemoryTracer()->updateTag(reinterpret_cast<const void*>(h_data.get()),
+                                                      sizeof(T) * m_num_elements,
+                                                      m_tag);
+        }
+
     //! Return a string representation of this array
     std::string getRepresentation() const
         {
@@ -579,13 +611,17 @@ template<class T> class GPUArray : public GPUArrayBase<T, GPUArray<T>>
     //! Release the data pointer
     inline void release() const
         {
-        m_acquired = false;
+        std::lock_guard<std::mutex> lock(hoomd::detail::gpu_array_acquire_mutex());
+        if (m_num_readers > 0)
+            m_num_readers--;
+        else
+            m_acquired = false;
         }
 
     //! Returns the acquire state
     inline bool isAcquired() const
         {
-        return m_acquired;
+        return m_acquired || m_num_readers > 0;
         }
 
     //! Need to be friend with dispatch
@@ -603,7 +639,9 @@ template<class T> class GPUArray : public GPUArrayBase<T, GPUArray<T>>
     size_t m_height;       //!< Number of allocated rows
 
     mutable bool m_acquired;                     //!< Tracks whether the data has been acquired
+    mutable unsigned int m_num_readers = 0;      //!< Number of shared read only host acquisitions
     mutable data_location::Enum m_data_location; //!< Tracks the current location of the data
+    std::string m_tag;                           //!< Name of the allocation for memory profiling
 #ifdef ENABLE_HIP
     bool m_mapped; //!< True if we are using mapped memory
 #endif
@@ -625,6 +663,9 @@ template<class T> class GPUArray : public GPUArrayBase<T, GPUArray<T>>
     //! Helper function to allocate memory
     inline void allocate();
 
+    //! Helper function to register the host allocation with the memory tracer
+    inline void registerHostAllocation(size_t num_elements) const;
+
 #ifdef ENABLE_HIP
     //! Helper function to copy memory from the device to host
     inline void memcpyDeviceToHost(bool async) const;
@@ -810,7 +851,7 @@ GPUArray<T>::GPUArray(size_t width,
 template<class T>
 GPUArray<T>::GPUArray(const GPUArray& from) noexcept
     : m_num_elements(from.m_num_elements), m_pitch(from.m_pitch), m_height(from.m_height),
-      m_acquired(false), m_data_location(data_location::host),
+      m_acquired(false), m_data_location(data_location::host), m_tag(from.m_tag),
 #ifdef ENABLE_HIP
       m_mapped(from.m_mapped),
 #endif
@@ -833,13 +874,14 @@ template<class T> GPUArray<T>& GPUArray<T>::operator=(const GPUArray& rhs) noexc
     if (this != &rhs) // protect against invalid self-assignment
         {
         // sanity check
-        assert(!m_acquired && !rhs.m_acquired);
+        assert(!isAcquired() && !rhs.isAcquired());
 
         // copy over basic elements
         m_num_elements = rhs.m_num_elements;
         m_pitch = rhs.m_pitch;
         m_height = rhs.m_height;
         m_exec_conf = rhs.m_exec_conf;
+        m_tag = rhs.m_tag;
 #ifdef ENABLE_HIP
         m_mapped = rhs.m_mapped;
 #endif
@@ -874,7 +916,7 @@ template<class T>
 GPUArray<T>::GPUArray(GPUArray&& from) noexcept
     : m_num_elements(std::move(from.m_num_elements)), m_pitch(std::move(from.m_pitch)),
       m_height(std::move(from.m_height)), m_acquired(std::move(from.m_acquired)),
-      m_data_location(std::move(from.m_data_location)),
+      m_data_location(std::move(from.m_data_location)), m_tag(std::move(from.m_tag)),
 #ifdef ENABLE_HIP
       m_mapped(std::move(from.m_mapped)), d_data(std::move(from.d_data)),
 #endif
@@ -891,6 +933,7 @@ template<class T> GPUArray<T>& GPUArray<T>::operator=(GPUArray&& rhs) noexcept
         m_pitch = std::move(rhs.m_pitch);
         m_height = std::move(rhs.m_height);
         m_exec_conf = std::move(rhs.m_exec_conf);
+        m_tag = std::move(rhs.m_tag);
 #ifdef ENABLE_HIP
         m_mapped = std::move(rhs.m_mapped);
         d_data = std::move(rhs.d_data);
@@ -919,7 +962,7 @@ and assignment operator.
 template<class T> void GPUArray<T>::swap(GPUArray& from)
     {
     // this may work, but really shouldn't be done when acquired
-    assert(!m_acquired && !from.m_acquired);
+    assert(!isAcquired() && !from.isAcquired());
     assert(&from != this);
 
     std::swap(m_num_elements, from.m_num_elements);
@@ -928,6 +971,7 @@ template<class T> void GPUArray<T>::swap(GPUArray& from)
     std::swap(m_acquired, from.m_acquired);
     std::swap(m_data_location, from.m_data_location);
     std::swap(m_exec_conf, from.m_exec_conf);
+    std::swap(m_tag, from.m_tag);
 #ifdef ENABLE_HIP
     std::swap(d_data, from.d_data);
     std::swap(m_mapped, from.m_mapped);
@@ -1001,6 +1045,7 @@ template<class T> void GPUArray<T>::allocate()
     hoomd::detail::host_deleter<T> host_deleter(m_exec_conf, use_device, m_num_elements);
     h_data = std::unique_ptr<T, hoomd::detail::host_deleter<T>>(reinterpret_cast<T*>(host_ptr),
                                                                 host_deleter);
+    registerHostAllocation(m_num_elements);
 
 #if defined(ENABLE_HIP)
     if (m_exec_conf && m_exec_conf->isCUDAEnabled())
@@ -1033,6 +1078,20 @@ template<class T> void GPUArray<T>::allocate()
 #endif
     }
 
+/*! \param num_elements Number of elements in the host allocation
+
+    The device mirror of the array has the same size and is not registered separately.
+*/
+template<class T> void GPUArray<T>::registerHostAllocation(size_t num_elements) const
+    {
+    if (m_exec_conf && m_exec_conf->getMemoryTracer())
+        m_exec_conf->getMemoryTracer()->registerAllocation(
+            reinterpret_cast<const void*>(h_data.get()),
+            sizeof(T) * num_elements,
+            typeid(T).name(),
+            m_tag);
+    }
+
 /*! \pre allocate() has been called
     \post All allocated memory is set to 0
 */
@@ -1083,6 +1142,8 @@ template<class T> void GPUArray<T>::memcpyDeviceToHost(bool async) const
         m_exec_conf->msg->notice(10)
             << "GPUArray: Copying " << float(m_num_elements * sizeof(T)) / 1024.0f / 1024.0f
             << " MB device->host " << (async ? std::string("async") : std::string()) << std::endl;
+    if (m_exec_conf && m_exec_conf->getMemoryTracer())
+        m_exec_conf->getMemoryTracer()->recordTransfer(m_tag, sizeof(T) * m_num_elements, true);
 #ifdef ENABLE_HIP
     if (async)
         {
@@ -1119,6 +1180,8 @@ template<class T> void GPUArray<T>::memcpyHostToDevice(bool async) const
         m_exec_conf->msg->notice(10)
             << "GPUArray: Copying " << float(m_num_elements * sizeof(T)) / 1024.0f / 1024.0f
             << " MB host->device " << (async ? std::string("async") : std::string()) << std::endl;
+    if (m_exec_conf && m_exec_conf->getMemoryTracer())
+        m_exec_conf->getMemoryTracer()->recordTransfer(m_tag, sizeof(T) * m_num_elements, false);
     if (async)
 #ifdef ENABLE_HIP
         hipMemcpyAsync(d_data.get(),
@@ -1155,11 +1218,23 @@ ArrayHandleDispatch<T> GPUArray<T>::acquire(const access_location::Enum location
 #endif
 ) const
     {
-    if (m_acquired)
         {
-        throw std::runtime_error("Cannot acquire access to array in use.");
+        // Any number of threads may read the data on the host at the same time, as long as it is
+        // current there. All other acquisitions are exclusive.
+        std::lock_guard<std::mutex> lock(hoomd::detail::gpu_array_acquire_mutex());
+        bool shared_read = location == access_location::host && mode == access_mode::read;
+#ifdef ENABLE_HIP
+        shared_read = shared_read && m_data_location != data_location::device;
+#endif
+        if (m_acquired || (!shared_read && m_num_readers > 0))
+            {
+            throw std::runtime_error("Cannot acquire access to array in use.");
+            }
+        if (shared_read)
+            m_num_readers++;
+        else
+            m_acquired = true;
         }
-    m_acquired = true;
 
     // base case - handle acquiring a NULL GPUArray by simply returning NULL to prevent any memcpys
     // from being attempted
@@ -1367,6 +1442,7 @@ template<class T> T* GPUArray<T>::resizeHostArray(size_t num_elements)
     bool use_device = m_exec_conf && m_exec_conf->isCUDAEnabled();
     hoomd::detail::host_deleter<T> host_deleter(m_exec_conf, use_device, num_elements);
     h_data = std::unique_ptr<T, hoomd::detail::host_deleter<T>>(h_tmp, host_deleter);
+    registerHostAllocation(num_elements);
 
 #ifdef ENABLE_HIP
     // update device pointer
@@ -1437,6 +1513,7 @@ T* GPUArray<T>::resize2DHostArray(size_t pitch, size_t new_pitch, size_t height,
     bool use_device = m_exec_conf && m_exec_conf->isCUDAEnabled();
     hoomd::detail::host_deleter<T> host_deleter(m_exec_conf, use_device, new_pitch * new_height);
     h_data = std::unique_ptr<T, hoomd::detail::host_deleter<T>>(h_tmp, host_deleter);
+    registerHostAllocation(new_pitch * new_height);
 
 #ifdef ENABLE_HIP
     // update device pointer
@@ -1572,7 +1649,7 @@ T* GPUArray<T>::resize2DDeviceArray(size_t pitch,
  */
 template<class T> void GPUArray<T>::resize(size_t num_elements)
     {
-    assert(!m_acquired);
+    assert(!isAcquired());
     assert(num_elements > 0);
 
     // if not allocated, simply allocate
@@ -1613,7 +1690,7 @@ template<class T> void GPUArray<T>::resize(size_t num_elements)
  */
 template<class T> void GPUArray<T>::resize(size_t width, size_t height)
     {
-    assert(!m_acquired);
+    assert(!isAcquired());
 
     // make m_pitch the next multiple of 16 larger or equal to the given width
     size_t new_pitch = (width + (16 - (width & 15)));
@@ -111,6 +111,22 @@ class __attribute__((visibility("default"))) GPUPartition
         m_gpu_range[m_n_gpu - 1].second = ini_offset + N;
         }
 
+    //! Distribute contiguous blocks of elements equally between GPUs
+    /*! \param n_blocks Number of blocks
+        \param block_size Number of elements in each block
+
+        The range of every GPU starts and ends at a block boundary.
+     */
+    void setBlocks(unsigned int n_blocks, unsigned int block_size)
+        {
+        setN(n_blocks);
+        for (unsigned int i = 0; i < m_n_gpu; ++i)
+            {
+            m_gpu_range[i].first *= block_size;
+            m_gpu_range[i].second *= block_size;
+            }
+        }
+
     //! Get the number of active GPUs
     inline unsigned int getNumActiveGPUs() const
         {
@@ -31,8 +31,11 @@ template<class T> class GlobalVector;
     It uses a GPUArray as the underlying storage class, thus the data in a GPUVectorBase can also be
    accessed directly using ArrayHandles.
 
-    In the current implementation, a GPUVectorBase can only grow (but not shrink) in size until it
-   is destroyed.
+    The allocated memory grows geometrically as elements are added. It shrinks only when the
+   execution configuration sets a shrink fraction: after resize() has left the vector below that
+   fraction of its capacity for a number of consecutive calls (the shrink delay), the allocation is
+   reduced to fit the current size. The delay avoids reallocating a buffer whose size fluctuates.
+   shrink_to_fit() reduces the allocation unconditionally.
 
     \ingroup data_structs
 */
@@ -83,6 +86,9 @@ template<class T, class Array> class GPUVectorBase : public Array
     //! Clear the list
     virtual void clear();
 
+    //! Reduce the allocated memory to fit the current size
+    void shrink_to_fit();
+
     //! Proxy class to provide access to the data elements of the vector
     class data_proxy
         {
@@ -153,11 +159,15 @@ template<class T, class Array> class GPUVectorBase : public Array
 #endif
 
     private:
-    size_t m_size; //!< Number of elements
+    size_t m_size;            //!< Number of elements
+    unsigned int m_num_below; //!< Number of consecutive resizes below the shrink fraction
 
     //! Helper function to reallocate the GPUArray (using amortized array resizing)
     void reallocate(size_t new_size);
 
+    //! Helper function to shrink the GPUArray after it has been underused for long enough
+    void checkShrink();
+
     //! Acquire the underlying GPU array on the host
     ArrayHandleDispatch<T> acquireHost(const access_mode::Enum mode) const;
 
@@ -172,13 +182,16 @@ template<class T, class Array> class GPUVectorBase : public Array
 /*! \warning When using this constructor, a properly initialized GPUVectorBase with an exec_conf
    needs to be swapped in later, after construction of the GPUVectorBase.
  */
-template<class T, class Array> GPUVectorBase<T, Array>::GPUVectorBase() : Array(), m_size(0) { }
+template<class T, class Array>
+GPUVectorBase<T, Array>::GPUVectorBase() : Array(), m_size(0), m_num_below(0)
+    {
+    }
 
 /*! \param exec_conf Shared pointer to the execution configuration
  */
 template<class T, class Array>
 GPUVectorBase<T, Array>::GPUVectorBase(std::shared_ptr<const ExecutionConfiguration> exec_conf)
-    : Array(0, exec_conf), m_size(0)
+    : Array(0, exec_conf), m_size(0), m_num_below(0)
     {
     }
 
@@ -188,7 +201,7 @@ GPUVectorBase<T, Array>::GPUVectorBase(std::shared_ptr<const ExecutionConfigurat
 template<class T, class Array>
 GPUVectorBase<T, Array>::GPUVectorBase(size_t size,
                                        std::shared_ptr<const ExecutionConfiguration> exec_conf)
-    : Array(size, exec_conf), m_size(size)
+    : Array(size, exec_conf), m_size(size), m_num_below(0)
     {
     }
 
@@ -200,7 +213,7 @@ template<class T, class Array>
 GPUVectorBase<T, Array>::GPUVectorBase(unsigned int size,
                                        const T& value,
                                        std::shared_ptr<const ExecutionConfiguration> exec_conf)
-    : Array(size, exec_conf), m_size(size)
+    : Array(size, exec_conf), m_size(size), m_num_below(0)
     {
     auto dispatch = acquireHost(access_mode::readwrite);
     T* data = dispatch.get();
@@ -209,7 +222,8 @@ GPUVectorBase<T, Array>::GPUVectorBase(unsigned int size,
     }
 
 template<class T, class Array>
-GPUVectorBase<T, Array>::GPUVectorBase(const GPUVectorBase& from) : Array(from), m_size(from.m_size)
+GPUVectorBase<T, Array>::GPUVectorBase(const GPUVectorBase& from)
+    : Array(from), m_size(from.m_size), m_num_below(0)
     {
     }
 
@@ -231,6 +245,7 @@ GPUVectorBase<T, Array>& GPUVectorBase<T, Array>::operator=(const GPUVectorBase&
 template<class T, class Array> void GPUVectorBase<T, Array>::swap(GPUVectorBase<T, Array>& from)
     {
     std::swap(m_size, from.m_size);
+    std::swap(m_num_below, from.m_num_below);
     Array::swap(from);
     }
 
@@ -272,6 +287,39 @@ template<class T, class Array> void GPUVectorBase<T, Array>::resize(size_t new_s
 
     // set new size
     m_size = new_size;
+
+    checkShrink();
+    }
+
+/*! The shrink fraction and delay are read from the execution configuration. A shrink fraction of
+    zero disables shrinking.
+*/
+template<class T, class Array> void GPUVectorBase<T, Array>::checkShrink()
+    {
+    if (!this->m_exec_conf)
+        return;
+
+    double fraction = this->m_exec_conf->getShrinkFraction();
+    if (fraction <= 0.0 || (double)m_size >= fraction * (double)Array::getNumElements())
+        {
+        m_num_below = 0;
+        return;
+        }
+
+    if (++m_num_below >= this->m_exec_conf->getShrinkDelay())
+        shrink_to_fit();
+    }
+
+/*! The new allocation leaves the same head room above the current size that reallocate() adds when
+    the vector grows, so that a vector does not need to grow again right after it shrinks.
+*/
+template<class T, class Array> void GPUVectorBase<T, Array>::shrink_to_fit()
+    {
+    m_num_below = 0;
+
+    size_t new_allocated_size = ((size_t)(((double)m_size) * RESIZE_FACTOR)) + 1;
+    if (new_allocated_size < Array::getNumElements())
+        Array::resize(new_allocated_size);
     }
 
 /*!
@@ -0,0 +1,99 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "GSDCheckpointWriter.h"
+
+#include <pybind11/stl.h>
+
+#include <stdexcept>
+
+using namespace std;
+namespace py = pybind11;
+
+/*! \param sysdef SystemDefinition containing the ParticleData to dump
+    \param writers One truncating writer per checkpoint file
+*/
+GSDCheckpointWriter::GSDCheckpointWriter(std::shared_ptr<SystemDefinition> sysdef,
+                                         const std::vector<std::shared_ptr<GSDDumpWriter>>& writers)
+    : Analyzer(sysdef), m_writers(writers), m_next(0)
+    {
+    m_exec_conf->msg->notice(5) << "Constructing GSDCheckpointWriter: " << m_writers.size()
+                                << " files" << endl;
+
+    if (m_writers.empty())
+        {
+        throw std::invalid_argument("GSDCheckpointWriter needs at least one file");
+        }
+    for (auto& writer : m_writers)
+        {
+        if (!writer->getTruncate())
+            {
+            throw std::invalid_argument("GSDCheckpointWriter: " + writer->getFilename()
+                                        + " is not written with truncate=True");
+            }
+        }
+    }
+
+GSDCheckpointWriter::~GSDCheckpointWriter()
+    {
+    m_exec_conf->msg->notice(5) << "Destroying GSDCheckpointWriter" << endl;
+    }
+
+/*! \param timestep Current time step of the simulation
+ */
+void GSDCheckpointWriter::analyze(uint64_t timestep)
+    {
+    Analyzer::analyze(timestep);
+
+    m_writers[m_next]->analyze(timestep);
+    m_next = (m_next + 1) % (unsigned int)m_writers.size();
+    }
+
+void GSDCheckpointWriter::flush()
+    {
+    for (auto& writer : m_writers)
+        writer->flush();
+    }
+
+void GSDCheckpointWriter::notifyDetach()
+    {
+    for (auto& writer : m_writers)
+        writer->notifyDetach();
+    }
+
+#ifdef ENABLE_MPI
+void GSDCheckpointWriter::setCommunicator(std::shared_ptr<Communicator> comm)
+    {
+    Analyzer::setCommunicator(comm);
+    for (auto& writer : m_writers)
+        writer->setCommunicator(comm);
+    }
+#endif
+
+/*! \param index Index of the file that the next checkpoint writes
+
+    Set by Python when a simulation continues from existing checkpoint files, so that the next
+    checkpoint does not overwrite the most recent one.
+*/
+void GSDCheckpointWriter::setNextIndex(unsigned int index)
+    {
+    if (index >= m_writers.size())
+        {
+        throw std::domain_error("GSDCheckpointWriter: file index out of range");
+        }
+    m_next = index;
+    }
+
+void export_GSDCheckpointWriter(py::module& m)
+    {
+    py::class_<GSDCheckpointWriter, Analyzer, std::shared_ptr<GSDCheckpointWriter>>(
+        m,
+        "GSDCheckpointWriter")
+        .def(py::init<std::shared_ptr<SystemDefinition>,
+                      const std::vector<std::shared_ptr<GSDDumpWriter>>&>())
+        .def("flush", &GSDCheckpointWriter::flush)
+        .def_property("next_index",
+                      &GSDCheckpointWriter::getNextIndex,
+                      &GSDCheckpointWriter::setNextIndex)
+        .def_property_readonly("num_files", &GSDCheckpointWriter::getNumFiles);
+    }
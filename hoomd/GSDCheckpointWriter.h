@@ -0,0 +1,84 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#pragma once
+
+#include "Analyzer.h"
+#include "GSDDumpWriter.h"
+
+#include <memory>
+#include <vector>
+
+/*! \file GSDCheckpointWriter.h
+    \brief Declares the GSDCheckpointWriter class
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include <pybind11/pybind11.h>
+
+//! Write checkpoints to a rotating set of GSD files
+/*! GSDCheckpointWriter owns one truncating GSDDumpWriter per checkpoint file. Each call to
+    analyze() passes the time step to the next writer in turn, so a checkpoint never overwrites the
+    most recent complete checkpoint. With asynchronous writers, each file is written by its own
+    background thread and writes to different files proceed concurrently.
+
+    The writers are configured in Python (dynamic categories, parallel and asynchronous writes, and
+    the log writer that stores the operation state).
+
+    \ingroup analyzers
+*/
+class PYBIND11_EXPORT GSDCheckpointWriter : public Analyzer
+    {
+    public:
+    //! Construct the writer
+    GSDCheckpointWriter(std::shared_ptr<SystemDefinition> sysdef,
+                        const std::vector<std::shared_ptr<GSDDumpWriter>>& writers);
+
+    //! Destructor
+    ~GSDCheckpointWriter();
+
+    //! Write a checkpoint to the next file
+    void analyze(uint64_t timestep);
+
+    //! Wait until all checkpoints are written
+    virtual void flush();
+
+    /// Stop the background writers when removed from the Simulation
+    virtual void notifyDetach();
+
+    /// The state log writer does not log computed quantities
+    virtual PDataFlags getRequestedPDataFlags()
+        {
+        return PDataFlags(0);
+        }
+
+#ifdef ENABLE_MPI
+    //! Set the communicator of all writers
+    virtual void setCommunicator(std::shared_ptr<Communicator> comm);
+#endif
+
+    //! Get the index of the file that the next checkpoint writes
+    unsigned int getNextIndex() const
+        {
+        return m_next;
+        }
+
+    //! Set the index of the file that the next checkpoint writes
+    void setNextIndex(unsigned int index);
+
+    //! Get the number of checkpoint files
+    unsigned int getNumFiles() const
+        {
+        return (unsigned int)m_writers.size();
+        }
+
+    private:
+    std::vector<std::shared_ptr<GSDDumpWriter>> m_writers; //!< One writer per checkpoint file
+    unsigned int m_next;                                   //!< Index of the next writer
+    };
+
+//! Exports the GSDCheckpointWriter class to python
+void export_GSDCheckpointWriter(pybind11::module& m);
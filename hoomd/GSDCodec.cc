@@ -0,0 +1,174 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "GSDCodec.h"
+
+#ifdef ENABLE_ZLIB
+#include <zlib.h>
+#endif
+
+#include <cmath>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <string.h>
+
+namespace hoomd
+    {
+namespace detail
+    {
+static const char codec_magic[4] = {'H', 'G', 'C', '1'};
+
+#ifdef ENABLE_ZLIB
+//! Transpose the bytes of \a n values of \a value_size bytes each
+static void shuffleBytes(const char* in, char* out, size_t n, size_t value_size)
+    {
+    for (size_t i = 0; i < n; i++)
+        for (size_t b = 0; b < value_size; b++)
+            out[b * n + i] = in[i * value_size + b];
+    }
+
+//! Reverse shuffleBytes()
+static void unshuffleBytes(const char* in, char* out, size_t n, size_t value_size)
+    {
+    for (size_t i = 0; i < n; i++)
+        for (size_t b = 0; b < value_size; b++)
+            out[i * value_size + b] = in[b * n + i];
+    }
+#endif
+
+bool GSDCodec::available()
+    {
+#ifdef ENABLE_ZLIB
+    return true;
+#else
+    return false;
+#endif
+    }
+
+std::vector<char>
+GSDCodec::encode(const void* data, gsd_type type, uint64_t N, uint32_t M, float precision)
+    {
+#ifdef ENABLE_ZLIB
+    size_t n_values = N * M;
+    size_t value_size = gsd_sizeof_type(type);
+    if (value_size == 0)
+        throw std::invalid_argument("GSD: Invalid chunk type to compress");
+
+    Header header;
+    memset(&header, 0, sizeof(Header));
+    memcpy(header.magic, codec_magic, sizeof(codec_magic));
+    header.codec = shuffle_zlib;
+    header.type = (uint8_t)type;
+    header.M = M;
+    header.N = N;
+
+    // quantize floating point values to integer multiples of the precision
+    std::vector<int32_t> quantized;
+    const char* values = (const char*)data;
+    if (precision > 0)
+        {
+        if (type != GSD_TYPE_FLOAT)
+            throw std::invalid_argument("GSD: Only float chunks can be quantized");
+
+        header.codec = quantize_shuffle_zlib;
+        header.precision = precision;
+        quantized.resize(n_values);
+        const float* f = (const float*)data;
+        for (size_t i = 0; i < n_values; i++)
+            {
+            double q = std::round(double(f[i]) / double(precision));
+            if (std::abs(q) > double(std::numeric_limits<int32_t>::max()))
+                throw std::runtime_error("GSD: Value out of range for the quantization precision");
+            quantized[i] = int32_t(q);
+            }
+        values = (const char*)quantized.data();
+        value_size = sizeof(int32_t);
+        }
+
+    size_t size = n_values * value_size;
+    std::vector<char> shuffled(size);
+    shuffleBytes(values, shuffled.data(), n_values, value_size);
+
+    uLongf compressed_size = compressBound(uLong(size));
+    std::vector<char> encoded(sizeof(Header) + compressed_size);
+    int retval = compress2((Bytef*)(encoded.data() + sizeof(Header)),
+                           &compressed_size,
+                           (const Bytef*)shuffled.data(),
+                           uLong(size),
+                           Z_BEST_SPEED);
+    if (retval != Z_OK)
+        throw std::runtime_error("GSD: Error compressing chunk");
+
+    memcpy(encoded.data(), &header, sizeof(Header));
+    encoded.resize(sizeof(Header) + compressed_size);
+    return encoded;
+#else
+    throw std::runtime_error("GSD: HOOMD-blue was built without zlib, cannot compress chunks");
+#endif
+    }
+
+bool GSDCodec::readHeader(const std::vector<char>& encoded, Header& header)
+    {
+    if (encoded.size() < sizeof(Header))
+        return false;
+
+    memcpy(&header, encoded.data(), sizeof(Header));
+    if (memcmp(header.magic, codec_magic, sizeof(codec_magic)) != 0)
+        return false;
+
+    return header.codec == shuffle_zlib || header.codec == quantize_shuffle_zlib;
+    }
+
+void GSDCodec::decode(const std::vector<char>& encoded, void* data, size_t size)
+    {
+    Header header;
+    if (!readHeader(encoded, header))
+        throw std::runtime_error("GSD: Invalid compressed chunk");
+
+#ifdef ENABLE_ZLIB
+    size_t n_values = header.N * header.M;
+    size_t value_size = gsd_sizeof_type((gsd_type)header.type);
+    if (n_values * value_size != size)
+        {
+        std::ostringstream s;
+        s << "GSD: Expecting " << size << " bytes in compressed chunk but found "
+          << n_values * value_size;
+        throw std::runtime_error(s.str());
+        }
+
+    if (n_values == 0)
+        return;
+
+    if (header.codec == quantize_shuffle_zlib)
+        value_size = sizeof(int32_t);
+
+    uLongf shuffled_size = uLongf(n_values * value_size);
+    std::vector<char> shuffled(shuffled_size);
+    int retval = uncompress((Bytef*)shuffled.data(),
+                            &shuffled_size,
+                            (const Bytef*)(encoded.data() + sizeof(Header)),
+                            uLong(encoded.size() - sizeof(Header)));
+    if (retval != Z_OK || shuffled_size != n_values * value_size)
+        throw std::runtime_error("GSD: Error decompressing chunk");
+
+    if (header.codec == quantize_shuffle_zlib)
+        {
+        std::vector<int32_t> quantized(n_values);
+        unshuffleBytes(shuffled.data(), (char*)quantized.data(), n_values, value_size);
+        float* f = (float*)data;
+        for (size_t i = 0; i < n_values; i++)
+            f[i] = float(double(quantized[i]) * double(header.precision));
+        }
+    else
+        {
+        unshuffleBytes(shuffled.data(), (char*)data, n_values, value_size);
+        }
+#else
+    throw std::runtime_error("GSD: HOOMD-blue was built without zlib, cannot read compressed "
+                             "chunks");
+#endif
+    }
+
+    } // namespace detail
+    } // namespace hoomd
@@ -0,0 +1,78 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#pragma once
+
+#include "hoomd/extern/gsd.h"
+#include <cstdint>
+#include <vector>
+
+#include <pybind11/pybind11.h>
+
+namespace hoomd
+    {
+namespace detail
+    {
+/// Encode and decode compressed GSD data chunks.
+/*! A compressed chunk is stored as a GSD_TYPE_UINT8 chunk with M == 1 under the original chunk
+    name. The chunk data starts with a Header that records the codec and the type and shape of the
+    original data, followed by the compressed bytes.
+
+    The lossless codec shuffles the bytes of the values so that the n-th byte of every value is
+    stored contiguously, then compresses the result with zlib. The quantized codec first rounds
+    floating point values to the nearest multiple of the precision and stores the integer
+    multiples with the lossless codec.
+*/
+class PYBIND11_EXPORT GSDCodec
+    {
+    public:
+    /// Codec identifiers
+    enum Codec : uint8_t
+        {
+        shuffle_zlib = 1,
+        quantize_shuffle_zlib = 2
+        };
+
+    /// Header at the start of every compressed chunk
+    struct Header
+        {
+        char magic[4];
+        uint8_t codec;
+        uint8_t type;
+        uint16_t reserved0;
+        uint32_t M;
+        float precision;
+        uint64_t N;
+        uint64_t reserved1;
+        };
+
+    /// Test if HOOMD was built with compression support
+    static bool available();
+
+    /// Encode a chunk
+    /*! \param data Data to encode
+        \param type Type of the data
+        \param N Number of rows
+        \param M Number of columns
+        \param precision Quantize values to this precision when > 0, otherwise compress losslessly
+
+        \returns The encoded chunk, starting with a Header
+    */
+    static std::vector<char>
+    encode(const void* data, gsd_type type, uint64_t N, uint32_t M, float precision);
+
+    /// Read the header of an encoded chunk
+    /*! \returns true when \a encoded starts with a valid header
+     */
+    static bool readHeader(const std::vector<char>& encoded, Header& header);
+
+    /// Decode a chunk
+    /*! \param encoded Encoded chunk, starting with a Header
+        \param data Output buffer
+        \param size Size of the output buffer in bytes, must match the decoded size
+    */
+    static void decode(const std::vector<char>& encoded, void* data, size_t size);
+    };
+
+    } // namespace detail
+    } // namespace hoomd
@@ -4,15 +4,23 @@
 #include "GSDDumpWriter.h"
 #include "Filesystem.h"
 #include "GSD.h"
+#include "GSDCodec.h"
 #include "HOOMDVersion.h"
 
 #ifdef ENABLE_MPI
 #include "Communicator.h"
 #endif
 
+#ifdef ENABLE_HIP
+#include "ParticleGroup.cuh"
+#endif
+
+#include "StepArena.h"
+
 #include <pybind11/numpy.h>
 #include <pybind11/stl_bind.h>
 
+#include <algorithm>
 #include <limits>
 #include <list>
 #include <sstream>
@@ -133,6 +141,13 @@ GSDDumpWriter::~GSDDumpWriter()
 
     if (root && m_is_initialized)
         {
+        m_writer.stop();
+        if (m_writer.hasError())
+            {
+            m_exec_conf->msg->error()
+                << "GSD: error writing buffered frames to " << m_fname << endl;
+            }
+
         m_exec_conf->msg->notice(5) << "GSD: close gsd file " << m_fname << endl;
         gsd_close(&m_handle);
         }
@@ -153,32 +168,64 @@ void GSDDumpWriter::analyze(uint64_t timestep)
     if (m_prof)
         m_prof->push("Dump GSD");
 
-    // take particle data snapshot
-    m_exec_conf->msg->notice(10) << "GSD: taking particle data snapshot" << endl;
-    SnapshotParticleData<float> snapshot;
-    const std::map<unsigned int, unsigned int>& map = m_pdata->takeSnapshot<float>(snapshot);
-
+    bool distributed = false;
 #ifdef ENABLE_MPI
     // if we are not the root processor, do not perform file I/O
     root = m_exec_conf->isRoot();
+
+    // write per-particle chunks from all ranks instead of gathering them on the root
+    distributed = m_parallel && m_pdata->getDomainDecomposition();
+    if (distributed && !m_compression.empty())
+        {
+        throw runtime_error("GSD: Compression is not supported with parallel writes");
+        }
 #endif
 
+    // gather the group members on the root rank
+    SnapshotParticleData<float> snapshot;
+    if (!distributed)
+        {
+        m_exec_conf->msg->notice(10) << "GSD: gathering group members" << endl;
+        takeGroupSnapshot(snapshot);
+        }
+
     // open the file if it is not yet opened
     if (!m_is_initialized && root)
+        {
         initFileIO();
+        m_nframes = gsd_get_nframes(&m_handle);
+        }
+
+    // stage the frame for the background thread unless signal slots need direct file access
+    if (root)
+        {
+        m_writer.checkError();
+        m_staging = m_asynchronous && !m_write_signal_requested && !distributed;
+        m_frame = StagedFrame();
+        if (!m_staging)
+            flush();
+        }
 
     // truncate the file if requested
     if (m_truncate && root)
         {
         m_exec_conf->msg->notice(10) << "GSD: truncating file" << endl;
-        retval = gsd_truncate(&m_handle);
-        GSDUtils::checkError(retval, m_fname);
+        if (m_staging)
+            {
+            m_frame.truncate = true;
+            }
+        else
+            {
+            retval = gsd_truncate(&m_handle);
+            GSDUtils::checkError(retval, m_fname);
+            }
+        m_nframes = 0;
         }
 
     uint64_t nframes = 0;
     if (root)
         {
-        nframes = gsd_get_nframes(&m_handle);
+        nframes = m_nframes;
         m_exec_conf->msg->notice(10)
             << "GSD: " << m_fname << " has " << nframes << " frames" << endl;
         }
@@ -193,13 +240,26 @@ void GSDDumpWriter::analyze(uint64_t timestep)
         writeFrameHeader(timestep);
 
         // only write out data chunk categories if requested, or if on frame 0
-        if (m_write_attribute || nframes == 0)
-            writeAttributes(snapshot, map);
-        if (m_write_property || nframes == 0)
-            writeProperties(snapshot, map);
-        if (m_write_momentum || nframes == 0)
-            writeMomenta(snapshot, map);
+        if (!distributed)
+            {
+            if (m_write_attribute || nframes == 0)
+                writeAttributes(snapshot);
+            if (m_write_property || nframes == 0)
+                writeProperties(snapshot);
+            if (m_write_momentum || nframes == 0)
+                writeMomenta(snapshot);
+            }
+        }
+
+#ifdef ENABLE_MPI
+    if (distributed)
+        {
+        writeParticlesDistributed(m_write_attribute || nframes == 0,
+                                  m_write_property || nframes == 0,
+                                  m_write_momentum || nframes == 0,
+                                  nframes);
         }
+#endif
 
     // topology is only meaningful if this is the all group
     if (m_group->getNumMembersGlobal() == m_pdata->getNGlobal()
@@ -242,15 +302,152 @@ void GSDDumpWriter::analyze(uint64_t timestep)
 
     if (root)
         {
-        m_exec_conf->msg->notice(10) << "GSD: ending frame" << endl;
-        retval = gsd_end_frame(&m_handle);
-        GSDUtils::checkError(retval, m_fname);
+        if (m_staging)
+            {
+            m_exec_conf->msg->notice(10) << "GSD: queueing frame" << endl;
+            m_staging = false;
+            enqueueFrame();
+            }
+        else
+            {
+            m_exec_conf->msg->notice(10) << "GSD: ending frame" << endl;
+            retval = gsd_end_frame(&m_handle);
+            GSDUtils::checkError(retval, m_fname);
+            }
+        m_nframes++;
         }
 
     if (m_prof)
         m_prof->pop();
     }
 
+/*! \param asynchronous Set to true to write frames on a background thread
+
+    Disabling asynchronous mode writes all buffered frames and stops the background thread.
+*/
+void GSDDumpWriter::setAsynchronous(bool asynchronous)
+    {
+    if (!asynchronous)
+        {
+        m_writer.stop();
+        m_writer.checkError();
+        }
+    m_asynchronous = asynchronous;
+    }
+
+void GSDDumpWriter::flush()
+    {
+    m_writer.flush();
+    }
+
+/*! Write the chunk to the file or, when staging a frame for the background thread, copy the data
+    into m_frame.
+*/
+int GSDDumpWriter::writeChunk(const char* name,
+                              gsd_type type,
+                              uint64_t N,
+                              uint32_t M,
+                              const void* data)
+    {
+    if (!m_staging)
+        return writeChunkToFile(name, type, N, M, data);
+
+    size_t size = gsd_sizeof_type(type) * N * M;
+    StagedChunk chunk;
+    chunk.name = name;
+    chunk.type = type;
+    chunk.N = N;
+    chunk.M = M;
+    chunk.data.resize(size);
+    if (size > 0)
+        memcpy(chunk.data.data(), data, size);
+    m_frame.chunks.push_back(std::move(chunk));
+    return GSD_SUCCESS;
+    }
+
+/*! Called on the background thread. The main thread does not access m_handle while frames are
+    queued.
+*/
+int GSDDumpWriter::writeStagedFrame(const StagedFrame& frame)
+    {
+    int retval;
+    if (frame.truncate)
+        {
+        retval = gsd_truncate(&m_handle);
+        if (retval != GSD_SUCCESS)
+            return retval;
+        }
+
+    for (auto const& chunk : frame.chunks)
+        {
+        retval = writeChunkToFile(chunk.name.c_str(),
+                                  chunk.type,
+                                  chunk.N,
+                                  chunk.M,
+                                  chunk.data.data());
+        if (retval != GSD_SUCCESS)
+            return retval;
+        }
+
+    return gsd_end_frame(&m_handle);
+    }
+
+void GSDDumpWriter::enqueueFrame()
+    {
+    auto frame = std::make_shared<StagedFrame>(std::move(m_frame));
+    m_frame = StagedFrame();
+    m_writer.enqueue(
+        [this, frame]()
+        {
+            int retval = writeStagedFrame(*frame);
+            GSDUtils::checkError(retval, m_fname);
+        });
+    }
+
+/*! \param name Name of a per-particle chunk
+    \param precision Quantize the values to this precision, or 0 to compress losslessly
+
+    Compressed chunks can only be read by GSDReader.
+*/
+void GSDDumpWriter::setCompression(const std::string& name, float precision)
+    {
+    if (!GSDCodec::available())
+        {
+        throw runtime_error("GSD: HOOMD-blue was built without zlib, cannot compress " + name);
+        }
+
+    if (name != "particles/position"
+        && std::find(particle_chunks.begin(), particle_chunks.end(), name)
+               == particle_chunks.end())
+        {
+        throw invalid_argument("GSD: Cannot compress chunk " + name);
+        }
+
+    if (precision < 0
+        || (precision > 0
+            && (name == "particles/typeid" || name == "particles/body"
+                || name == "particles/image")))
+        {
+        throw invalid_argument("GSD: Invalid compression precision for " + name);
+        }
+
+    m_compression[name] = precision;
+    }
+
+int GSDDumpWriter::writeChunkToFile(const char* name,
+                                    gsd_type type,
+                                    uint64_t N,
+                                    uint32_t M,
+                                    const void* data)
+    {
+    auto it = m_compression.find(name);
+    if (it == m_compression.end())
+        return gsd_write_chunk(&m_handle, name, type, N, M, 0, data);
+
+    std::vector<char> encoded = GSDCodec::encode(data, type, N, M, group_idx);
+    return gsd_write_chunk(&m_handle, name, GSD_TYPE_UINT8, encoded.size(), 1, 0, encoded.data());
+    }
+
 void GSDDumpWriter::writeTypeMapping(std::string chunk, std::vector<std::string> type_mapping)
     {
     int max_len = 0;
@@ -265,13 +462,11 @@ void GSDDumpWriter::writeTypeMapping(std::string chunk, std::vector<std::string>
         std::vector<char> types(max_len * type_mapping.size());
         for (unsigned int i = 0; i < type_mapping.size(); i++)
             strncpy(&types[max_len * i], type_mapping[i].c_str(), max_len);
-        int retval = gsd_write_chunk(&m_handle,
-                                     chunk.c_str(),
-                                     GSD_TYPE_UINT8,
-                                     type_mapping.size(),
-                                     max_len,
-                                     0,
-                                     (void*)&types[0]);
+        int retval = writeChunk(chunk.c_str(),
+                                GSD_TYPE_UINT8,
+                                type_mapping.size(),
+                                max_len,
+                                (void*)&types[0]);
         GSDUtils::checkError(retval, m_fname);
         }
     }
@@ -289,21 +484,14 @@ void GSDDumpWriter::writeFrameHeader(uint64_t timestep)
     int retval;
     m_exec_conf->msg->notice(10) << "GSD: writing configuration/step" << endl;
     uint64_t step = timestep;
-    retval
-        = gsd_write_chunk(&m_handle, "configuration/step", GSD_TYPE_UINT64, 1, 1, 0, (void*)&step);
+    retval = writeChunk("configuration/step", GSD_TYPE_UINT64, 1, 1, (void*)&step);
     GSDUtils::checkError(retval, m_fname);
 
-    if (gsd_get_nframes(&m_handle) == 0)
+    if (m_nframes == 0)
         {
         m_exec_conf->msg->notice(10) << "GSD: writing configuration/dimensions" << endl;
         uint8_t dimensions = (uint8_t)m_sysdef->getNDimensions();
-        retval = gsd_write_chunk(&m_handle,
-                                 "configuration/dimensions",
-                                 GSD_TYPE_UINT8,
-                                 1,
-                                 1,
-                                 0,
-                                 (void*)&dimensions);
+        retval = writeChunk("configuration/dimensions", GSD_TYPE_UINT8, 1, 1, (void*)&dimensions);
         GSDUtils::checkError(retval, m_fname);
         }
 
@@ -316,26 +504,25 @@ void GSDDumpWriter::writeFrameHeader(uint64_t timestep)
     box_a[3] = (float)box.getTiltFactorXY();
     box_a[4] = (float)box.getTiltFactorXZ();
     box_a[5] = (float)box.getTiltFactorYZ();
-    retval = gsd_write_chunk(&m_handle, "configuration/box", GSD_TYPE_FLOAT, 6, 1, 0, (void*)box_a);
+    retval = writeChunk("configuration/box", GSD_TYPE_FLOAT, 6, 1, (void*)box_a);
     GSDUtils::checkError(retval, m_fname);
 
     m_exec_conf->msg->notice(10) << "GSD: writing particles/N" << endl;
     uint32_t N = m_group->getNumMembersGlobal();
-    retval = gsd_write_chunk(&m_handle, "particles/N", GSD_TYPE_UINT32, 1, 1, 0, (void*)&N);
+    retval = writeChunk("particles/N", GSD_TYPE_UINT32, 1, 1, (void*)&N);
     GSDUtils::checkError(retval, m_fname);
     }
 
-/*! \param snapshot particle data snapshot to write out to the file
+/*! \param snapshot Snapshot of the group members, in file order
 
     Writes the data chunks types, typeid, mass, charge, diameter, body, moment_inertia in
    particles/.
 */
-void GSDDumpWriter::writeAttributes(const SnapshotParticleData<float>& snapshot,
-                                    const std::map<unsigned int, unsigned int>& map)
+void GSDDumpWriter::writeAttributes(const SnapshotParticleData<float>& snapshot)
     {
     uint32_t N = m_group->getNumMembersGlobal();
     int retval;
-    uint64_t nframes = gsd_get_nframes(&m_handle);
+    uint64_t nframes = m_nframes;
 
     writeTypeMapping("particles/types", snapshot.type_mapping);
 
@@ -346,28 +533,16 @@ void GSDDumpWriter::writeAttributes(const SnapshotParticleData<float>& snapshot,
 
         for (unsigned int group_idx = 0; group_idx < N; group_idx++)
             {
-            unsigned int t = m_group->getMemberTag(group_idx);
-
-            // look up tag in snapshot
-            auto it = map.find(t);
-            assert(it != map.end());
-
-            if (snapshot.type[it->second] != 0)
+            if (snapshot.type[group_idx] != 0)
                 all_default = false;
 
-            type[group_idx] = uint32_t(snapshot.type[it->second]);
+            type[group_idx] = uint32_t(snapshot.type[group_idx]);
             }
 
         if (!all_default || (nframes > 0 && m_nondefault["particles/typeid"]))
             {
             m_exec_conf->msg->notice(10) << "GSD: writing particles/typeid" << endl;
-            retval = gsd_write_chunk(&m_handle,
-                                     "particles/typeid",
-                                     GSD_TYPE_UINT32,
-                                     N,
-                                     1,
-                                     0,
-                                     (void*)&type[0]);
+            retval = writeChunk("particles/typeid", GSD_TYPE_UINT32, N, 1, (void*)&type[0]);
             GSDUtils::checkError(retval, m_fname);
             if (nframes == 0)
                 m_nondefault["particles/typeid"] = true;
@@ -381,28 +556,16 @@ void GSDDumpWriter::writeAttributes(const SnapshotParticleData<float>& snapshot,
 
         for (unsigned int group_idx = 0; group_idx < N; group_idx++)
             {
-            unsigned int t = m_group->getMemberTag(group_idx);
-
-            // look up tag in snapshot
-            auto it = map.find(t);
-            assert(it != map.end());
-
-            if (snapshot.mass[it->second] != float(1.0))
+            if (snapshot.mass[group_idx] != float(1.0))
                 all_default = false;
 
-            data[group_idx] = float(snapshot.mass[it->second]);
+            data[group_idx] = float(snapshot.mass[group_idx]);
             }
 
         if (!all_default || (nframes > 0 && m_nondefault["particles/mass"]))
             {
             m_exec_conf->msg->notice(10) << "GSD: writing particles/mass" << endl;
-            retval = gsd_write_chunk(&m_handle,
-                                     "particles/mass",
-                                     GSD_TYPE_FLOAT,
-                                     N,
-                                     1,
-                                     0,
-                                     (void*)&data[0]);
+            retval = writeChunk("particles/mass", GSD_TYPE_FLOAT, N, 1, (void*)&data[0]);
             GSDUtils::checkError(retval, m_fname);
             if (nframes == 0)
                 m_nondefault["particles/mass"] = true;
@@ -412,27 +575,15 @@ void GSDDumpWriter::writeAttributes(const SnapshotParticleData<float>& snapshot,
 
         for (unsigned int group_idx = 0; group_idx < N; group_idx++)
             {
-            unsigned int t = m_group->getMemberTag(group_idx);
-
-            // look up tag in snapshot
-            auto it = map.find(t);
-            assert(it != map.end());
-
-            if (snapshot.charge[it->second] != float(0.0))
+            if (snapshot.charge[group_idx] != float(0.0))
                 all_default = false;
-            data[group_idx] = float(snapshot.charge[it->second]);
+            data[group_idx] = float(snapshot.charge[group_idx]);
             }
 
         if (!all_default || (nframes > 0 && m_nondefault["particles/charge"]))
             {
             m_exec_conf->msg->notice(10) << "GSD: writing particles/charge" << endl;
-            retval = gsd_write_chunk(&m_handle,
-                                     "particles/charge",
-                                     GSD_TYPE_FLOAT,
-                                     N,
-                                     1,
-                                     0,
-                                     (void*)&data[0]);
+            retval = writeChunk("particles/charge", GSD_TYPE_FLOAT, N, 1, (void*)&data[0]);
             GSDUtils::checkError(retval, m_fname);
             if (nframes == 0)
                 m_nondefault["particles/charge"] = true;
@@ -442,28 +593,16 @@ void GSDDumpWriter::writeAttributes(const SnapshotParticleData<float>& snapshot,
 
         for (unsigned int group_idx = 0; group_idx < N; group_idx++)
             {
-            unsigned int t = m_group->getMemberTag(group_idx);
-
-            // look up tag in snapshot
-            auto it = map.find(t);
-            assert(it != map.end());
-
-            if (snapshot.diameter[it->second] != float(1.0))
+            if (snapshot.diameter[group_idx] != float(1.0))
                 all_default = false;
 
-            data[group_idx] = float(snapshot.diameter[it->second]);
+            data[group_idx] = float(snapshot.diameter[group_idx]);
             }
 
         if (!all_default || (nframes > 0 && m_nondefault["particles/diameter"]))
             {
             m_exec_conf->msg->notice(10) << "GSD: writing particles/diameter" << endl;
-            retval = gsd_write_chunk(&m_handle,
-                                     "particles/diameter",
-                                     GSD_TYPE_FLOAT,
-                                     N,
-                                     1,
-                                     0,
-                                     (void*)&data[0]);
+            retval = writeChunk("particles/diameter", GSD_TYPE_FLOAT, N, 1, (void*)&data[0]);
             GSDUtils::checkError(retval, m_fname);
             if (nframes == 0)
                 m_nondefault["particles/diameter"] = true;
@@ -477,28 +616,16 @@ void GSDDumpWriter::writeAttributes(const SnapshotParticleData<float>& snapshot,
 
         for (unsigned int group_idx = 0; group_idx < N; group_idx++)
             {
-            unsigned int t = m_group->getMemberTag(group_idx);
-
-            // look up tag in snapshot
-            auto it = map.find(t);
-            assert(it != map.end());
-
-            if (snapshot.body[it->second] != NO_BODY)
+            if (snapshot.body[group_idx] != NO_BODY)
                 all_default = false;
 
-            body[group_idx] = int32_t(snapshot.body[it->second]);
+            body[group_idx] = int32_t(snapshot.body[group_idx]);
             }
 
         if (!all_default || (nframes > 0 && m_nondefault["particles/body"]))
             {
             m_exec_conf->msg->notice(10) << "GSD: writing particles/body" << endl;
-            retval = gsd_write_chunk(&m_handle,
-                                     "particles/body",
-                                     GSD_TYPE_INT32,
-                                     N,
-                                     1,
-                                     0,
-                                     (void*)&body[0]);
+            retval = writeChunk("particles/body", GSD_TYPE_INT32, N, 1, (void*)&body[0]);
             GSDUtils::checkError(retval, m_fname);
             if (nframes == 0)
                 m_nondefault["particles/body"] = true;
@@ -512,34 +639,22 @@ void GSDDumpWriter::writeAttributes(const SnapshotParticleData<float>& snapshot,
 
         for (unsigned int group_idx = 0; group_idx < N; group_idx++)
             {
-            unsigned int t = m_group->getMemberTag(group_idx);
-
-            // look up tag in snapshot
-            auto it = map.find(t);
-            assert(it != map.end());
-
-            if (snapshot.inertia[it->second].x != float(0.0)
-                || snapshot.inertia[it->second].y != float(0.0)
-                || snapshot.inertia[it->second].z != float(0.0))
+            if (snapshot.inertia[group_idx].x != float(0.0)
+                || snapshot.inertia[group_idx].y != float(0.0)
+                || snapshot.inertia[group_idx].z != float(0.0))
                 {
                 all_default = false;
                 }
 
-            data[group_idx * 3 + 0] = float(snapshot.inertia[it->second].x);
-            data[group_idx * 3 + 1] = float(snapshot.inertia[it->second].y);
-            data[group_idx * 3 + 2] = float(snapshot.inertia[it->second].z);
+            data[group_idx * 3 + 0] = float(snapshot.inertia[group_idx].x);
+            data[group_idx * 3 + 1] = float(snapshot.inertia[group_idx].y);
+            data[group_idx * 3 + 2] = float(snapshot.inertia[group_idx].z);
             }
 
         if (!all_default || (nframes > 0 && m_nondefault["particles/moment_inertia"]))
             {
             m_exec_conf->msg->notice(10) << "GSD: writing particles/moment_inertia" << endl;
-            retval = gsd_write_chunk(&m_handle,
-                                     "particles/moment_inertia",
-                                     GSD_TYPE_FLOAT,
-                                     N,
-                                     3,
-                                     0,
-                                     (void*)&data[0]);
+            retval = writeChunk("particles/moment_inertia", GSD_TYPE_FLOAT, N, 3, (void*)&data[0]);
             GSDUtils::checkError(retval, m_fname);
             if (nframes == 0)
                 m_nondefault["particles/moment_inertia"] = true;
@@ -547,16 +662,15 @@ void GSDDumpWriter::writeAttributes(const SnapshotParticleData<float>& snapshot,
         }
     }
 
-/*! \param snapshot particle data snapshot to write out to the file
+/*! \param snapshot Snapshot of the group members, in file order
 
     Writes the data chunks position and orientation in particles/.
 */
-void GSDDumpWriter::writeProperties(const SnapshotParticleData<float>& snapshot,
-                                    const std::map<unsigned int, unsigned int>& map)
+void GSDDumpWriter::writeProperties(const SnapshotParticleData<float>& snapshot)
     {
     uint32_t N = m_group->getNumMembersGlobal();
     int retval;
-    uint64_t nframes = gsd_get_nframes(&m_handle);
+    uint64_t nframes = m_nframes;
 
         {
         std::vector<float> data(uint64_t(N) * 3);
@@ -564,25 +678,13 @@ void GSDDumpWriter::writeProperties(const SnapshotParticleData<float>& snapshot,
 
         for (unsigned int group_idx = 0; group_idx < N; group_idx++)
             {
-            unsigned int t = m_group->getMemberTag(group_idx);
-
-            // look up tag in snapshot
-            auto it = map.find(t);
-            assert(it != map.end());
-
-            data[group_idx * 3 + 0] = float(snapshot.pos[it->second].x);
-            data[group_idx * 3 + 1] = float(snapshot.pos[it->second].y);
-            data[group_idx * 3 + 2] = float(snapshot.pos[it->second].z);
+            data[group_idx * 3 + 0] = float(snapshot.pos[group_idx].x);
+            data[group_idx * 3 + 1] = float(snapshot.pos[group_idx].y);
+            data[group_idx * 3 + 2] = float(snapshot.pos[group_idx].z);
             }
 
         m_exec_conf->msg->notice(10) << "GSD: writing particles/position" << endl;
-        retval = gsd_write_chunk(&m_handle,
-                                 "particles/position",
-                                 GSD_TYPE_FLOAT,
-                                 N,
-                                 3,
-                                 0,
-                                 (void*)&data[0]);
+        retval = writeChunk("particles/position", GSD_TYPE_FLOAT, N, 3, (void*)&data[0]);
         GSDUtils::checkError(retval, m_fname);
         }
 
@@ -593,36 +695,24 @@ void GSDDumpWriter::writeProperties(const SnapshotParticleData<float>& snapshot,
 
         for (unsigned int group_idx = 0; group_idx < N; group_idx++)
             {
-            unsigned int t = m_group->getMemberTag(group_idx);
-
-            // look up tag in snapshot
-            auto it = map.find(t);
-            assert(it != map.end());
-
-            if (snapshot.orientation[it->second].s != float(1.0)
-                || snapshot.orientation[it->second].v.x != float(0.0)
-                || snapshot.orientation[it->second].v.y != float(0.0)
-                || snapshot.orientation[it->second].v.z != float(0.0))
+            if (snapshot.orientation[group_idx].s != float(1.0)
+                || snapshot.orientation[group_idx].v.x != float(0.0)
+                || snapshot.orientation[group_idx].v.y != float(0.0)
+                || snapshot.orientation[group_idx].v.z != float(0.0))
                 {
                 all_default = false;
                 }
 
-            data[group_idx * 4 + 0] = float(snapshot.orientation[it->second].s);
-            data[group_idx * 4 + 1] = float(snapshot.orientation[it->second].v.x);
-            data[group_idx * 4 + 2] = float(snapshot.orientation[it->second].v.y);
-            data[group_idx * 4 + 3] = float(snapshot.orientation[it->second].v.z);
+            data[group_idx * 4 + 0] = float(snapshot.orientation[group_idx].s);
+            data[group_idx * 4 + 1] = float(snapshot.orientation[group_idx].v.x);
+            data[group_idx * 4 + 2] = float(snapshot.orientation[group_idx].v.y);
+            data[group_idx * 4 + 3] = float(snapshot.orientation[group_idx].v.z);
             }
 
         if (!all_default || (nframes > 0 && m_nondefault["particles/orientation"]))
             {
             m_exec_conf->msg->notice(10) << "GSD: writing particles/orientation" << endl;
-            retval = gsd_write_chunk(&m_handle,
-                                     "particles/orientation",
-                                     GSD_TYPE_FLOAT,
-                                     N,
-                                     4,
-                                     0,
-                                     (void*)&data[0]);
+            retval = writeChunk("particles/orientation", GSD_TYPE_FLOAT, N, 4, (void*)&data[0]);
             GSDUtils::checkError(retval, m_fname);
             if (nframes == 0)
                 m_nondefault["particles/orientation"] = true;
@@ -630,16 +720,15 @@ void GSDDumpWriter::writeProperties(const SnapshotParticleData<float>& snapshot,
         }
     }
 
-/*! \param snapshot particle data snapshot to write out to the file
+/*! \param snapshot Snapshot of the group members, in file order
 
     Writes the data chunks velocity, angmom, and image in particles/.
 */
-void GSDDumpWriter::writeMomenta(const SnapshotParticleData<float>& snapshot,
-                                 const std::map<unsigned int, unsigned int>& map)
+void GSDDumpWriter::writeMomenta(const SnapshotParticleData<float>& snapshot)
     {
     uint32_t N = m_group->getNumMembersGlobal();
     int retval;
-    uint64_t nframes = gsd_get_nframes(&m_handle);
+    uint64_t nframes = m_nframes;
 
         {
         std::vector<float> data(uint64_t(N) * 3);
@@ -648,33 +737,21 @@ void GSDDumpWriter::writeMomenta(const SnapshotParticleData<float>& snapshot,
 
         for (unsigned int group_idx = 0; group_idx < N; group_idx++)
             {
-            unsigned int t = m_group->getMemberTag(group_idx);
-
-            // look up tag in snapshot
-            auto it = map.find(t);
-            assert(it != map.end());
-
-            if (snapshot.vel[it->second].x != float(0.0) || snapshot.vel[it->second].y != float(0.0)
-                || snapshot.vel[it->second].z != float(0.0))
+            if (snapshot.vel[group_idx].x != float(0.0) || snapshot.vel[group_idx].y != float(0.0)
+                || snapshot.vel[group_idx].z != float(0.0))
                 {
                 all_default = false;
                 }
 
-            data[group_idx * 3 + 0] = float(snapshot.vel[it->second].x);
-            data[group_idx * 3 + 1] = float(snapshot.vel[it->second].y);
-            data[group_idx * 3 + 2] = float(snapshot.vel[it->second].z);
+            data[group_idx * 3 + 0] = float(snapshot.vel[group_idx].x);
+            data[group_idx * 3 + 1] = float(snapshot.vel[group_idx].y);
+            data[group_idx * 3 + 2] = float(snapshot.vel[group_idx].z);
             }
 
         if (!all_default || (nframes > 0 && m_nondefault["particles/velocity"]))
             {
             m_exec_conf->msg->notice(10) << "GSD: writing particles/velocity" << endl;
-            retval = gsd_write_chunk(&m_handle,
-                                     "particles/velocity",
-                                     GSD_TYPE_FLOAT,
-                                     N,
-                                     3,
-                                     0,
-                                     (void*)&data[0]);
+            retval = writeChunk("particles/velocity", GSD_TYPE_FLOAT, N, 3, (void*)&data[0]);
             GSDUtils::checkError(retval, m_fname);
             if (nframes == 0)
                 m_nondefault["particles/velocity"] = true;
@@ -688,36 +765,24 @@ void GSDDumpWriter::writeMomenta(const SnapshotParticleData<float>& snapshot,
 
         for (unsigned int group_idx = 0; group_idx < N; group_idx++)
             {
-            unsigned int t = m_group->getMemberTag(group_idx);
-
-            // look up tag in snapshot
-            auto it = map.find(t);
-            assert(it != map.end());
-
-            if (snapshot.angmom[it->second].s != float(0.0)
-                || snapshot.angmom[it->second].v.x != float(0.0)
-                || snapshot.angmom[it->second].v.y != float(0.0)
-                || snapshot.angmom[it->second].v.z != float(0.0))
+            if (snapshot.angmom[group_idx].s != float(0.0)
+                || snapshot.angmom[group_idx].v.x != float(0.0)
+                || snapshot.angmom[group_idx].v.y != float(0.0)
+                || snapshot.angmom[group_idx].v.z != float(0.0))
                 {
                 all_default = false;
                 }
 
-            data[group_idx * 4 + 0] = float(snapshot.angmom[it->second].s);
-            data[group_idx * 4 + 1] = float(snapshot.angmom[it->second].v.x);
-            data[group_idx * 4 + 2] = float(snapshot.angmom[it->second].v.y);
-            data[group_idx * 4 + 3] = float(snapshot.angmom[it->second].v.z);
+            data[group_idx * 4 + 0] = float(snapshot.angmom[group_idx].s);
+            data[group_idx * 4 + 1] = float(snapshot.angmom[group_idx].v.x);
+            data[group_idx * 4 + 2] = float(snapshot.angmom[group_idx].v.y);
+            data[group_idx * 4 + 3] = float(snapshot.angmom[group_idx].v.z);
             }
 
         if (!all_default || (nframes > 0 && m_nondefault["particles/angmom"]))
             {
             m_exec_conf->msg->notice(10) << "GSD: writing particles/angmom" << endl;
-            retval = gsd_write_chunk(&m_handle,
-                                     "particles/angmom",
-                                     GSD_TYPE_FLOAT,
-                                     N,
-                                     4,
-                                     0,
-                                     (void*)&data[0]);
+            retval = writeChunk("particles/angmom", GSD_TYPE_FLOAT, N, 4, (void*)&data[0]);
             GSDUtils::checkError(retval, m_fname);
             if (nframes == 0)
                 m_nondefault["particles/angmom"] = true;
@@ -731,33 +796,21 @@ void GSDDumpWriter::writeMomenta(const SnapshotParticleData<float>& snapshot,
 
         for (unsigned int group_idx = 0; group_idx < N; group_idx++)
             {
-            unsigned int t = m_group->getMemberTag(group_idx);
-
-            // look up tag in snapshot
-            auto it = map.find(t);
-            assert(it != map.end());
-
-            if (snapshot.image[it->second].x != 0 || snapshot.image[it->second].y != 0
-                || snapshot.image[it->second].z != 0)
+            if (snapshot.image[group_idx].x != 0 || snapshot.image[group_idx].y != 0
+                || snapshot.image[group_idx].z != 0)
                 {
                 all_default = false;
                 }
 
-            data[group_idx * 3 + 0] = snapshot.image[it->second].x;
-            data[group_idx * 3 + 1] = snapshot.image[it->second].y;
-            data[group_idx * 3 + 2] = snapshot.image[it->second].z;
+            data[group_idx * 3 + 0] = snapshot.image[group_idx].x;
+            data[group_idx * 3 + 1] = snapshot.image[group_idx].y;
+            data[group_idx * 3 + 2] = snapshot.image[group_idx].z;
             }
 
         if (!all_default || (nframes > 0 && m_nondefault["particles/image"]))
             {
             m_exec_conf->msg->notice(10) << "GSD: writing particles/image" << endl;
-            retval = gsd_write_chunk(&m_handle,
-                                     "particles/image",
-                                     GSD_TYPE_INT32,
-                                     N,
-                                     3,
-                                     0,
-                                     (void*)&data[0]);
+            retval = writeChunk("particles/image", GSD_TYPE_INT32, N, 3, (void*)&data[0]);
             GSDUtils::checkError(retval, m_fname);
             if (nframes == 0)
                 m_nondefault["particles/image"] = true;
@@ -765,6 +818,641 @@ void GSDDumpWriter::writeMomenta(const SnapshotParticleData<float>& snapshot,
         }
     }
 
+/*! \param array Per-particle array of the local particles
+    \param values Values of the local group members, in group index order (output)
+
+    On the GPU, the members are gathered on the device so that only they are copied to the host.
+*/
+template<class T> void GSDDumpWriter::gatherMembers(const GlobalArray<T>& array, T* values)
+    {
+    unsigned int n_members = m_group->getNumMembers();
+    if (n_members == 0)
+        return;
+
+#ifdef ENABLE_HIP
+    if (m_exec_conf->isCUDAEnabled())
+        {
+        ArrayHandle<unsigned int> d_member_idx(m_group->getIndexArray(),
+                                               access_location::device,
+                                               access_mode::read);
+        ArrayHandle<T> d_array(array, access_location::device, access_mode::read);
+
+        ArenaAllocation<T> d_values(m_exec_conf->getDeviceArena(), n_members);
+        gpu_gather_members(n_members, d_member_idx.data, d_array.data, d_values.data);
+        if (m_exec_conf->isCUDAErrorCheckingEnabled())
+            CHECK_CUDA_ERROR();
+
+        hipMemcpy(values, d_values.data, sizeof(T) * n_members, hipMemcpyDeviceToHost);
+        return;
+        }
+#endif
+
+    ArrayHandle<unsigned int> h_member_idx(m_group->getIndexArray(),
+                                           access_location::host,
+                                           access_mode::read);
+    ArrayHandle<T> h_array(array, access_location::host, access_mode::read);
+    for (unsigned int group_idx = 0; group_idx < n_members; group_idx++)
+        values[group_idx] = h_array.data[h_member_idx.data[group_idx]];
+    }
+
+/*! \param particles Local group members (output)
+
+    Converts the local group members to the file precision and sets PackedParticle::index to their
+    index in the file, where the members of the group are ordered by tag. Only the group members
+    are read from the particle data.
+*/
+void GSDDumpWriter::packMembers(std::vector<PackedParticle>& particles)
+    {
+    unsigned int n_members = m_group->getNumMembers();
+    uint64_t N = m_group->getNumMembersGlobal();
+
+    // host temporaries for the member values
+    StepArena& arena = m_exec_conf->getHostArena();
+    ArenaAllocation<Scalar4> pos(arena, n_members), vel(arena, n_members);
+    ArenaAllocation<Scalar4> orientation(arena, n_members), angmom(arena, n_members);
+    ArenaAllocation<Scalar3> inertia(arena, n_members);
+    ArenaAllocation<Scalar> charge(arena, n_members), diameter(arena, n_members);
+    ArenaAllocation<int3> images(arena, n_members);
+    ArenaAllocation<unsigned int> body(arena, n_members), tag(arena, n_members);
+    gatherMembers(m_pdata->getPositions(), pos.data);
+    gatherMembers(m_pdata->getVelocities(), vel.data);
+    gatherMembers(m_pdata->getOrientationArray(), orientation.data);
+    gatherMembers(m_pdata->getAngularMomentumArray(), angmom.data);
+    gatherMembers(m_pdata->getMomentsOfInertiaArray(), inertia.data);
+    gatherMembers(m_pdata->getCharges(), charge.data);
+    gatherMembers(m_pdata->getDiameters(), diameter.data);
+    gatherMembers(m_pdata->getImages(), images.data);
+    gatherMembers(m_pdata->getBodies(), body.data);
+    gatherMembers(m_pdata->getTags(), tag.data);
+
+    ArrayHandle<unsigned int> h_member_tags(m_group->getMemberTagArray(),
+                                            access_location::host,
+                                            access_mode::read);
+
+    const BoxDim& global_box = m_pdata->getGlobalBox();
+    Scalar3 origin = m_pdata->getOrigin();
+    int3 origin_image = m_pdata->getOriginImage();
+
+    particles.resize(n_members);
+    for (unsigned int i = 0; i < n_members; i++)
+        {
+        PackedParticle& p = particles[i];
+        p.index = std::lower_bound(h_member_tags.data, h_member_tags.data + N, tag.data[i])
+                  - h_member_tags.data;
+
+        // match the conversions made by ParticleData::takeSnapshot
+        vec3<float> r(make_scalar3(pos.data[i].x, pos.data[i].y, pos.data[i].z) - origin);
+        int3 image = images.data[i];
+        image.x -= origin_image.x;
+        image.y -= origin_image.y;
+        image.z -= origin_image.z;
+        Scalar3 tmp = vec_to_scalar3(r);
+        global_box.wrap(tmp, image);
+
+        p.type = __scalar_as_int(pos.data[i].w);
+        p.body = int32_t(body.data[i]);
+        p.mass = float(vel.data[i].w);
+        p.charge = float(charge.data[i]);
+        p.diameter = float(diameter.data[i]);
+        p.inertia[0] = float(inertia.data[i].x);
+        p.inertia[1] = float(inertia.data[i].y);
+        p.inertia[2] = float(inertia.data[i].z);
+        p.position[0] = float(tmp.x);
+        p.position[1] = float(tmp.y);
+        p.position[2] = float(tmp.z);
+        p.orientation[0] = float(orientation.data[i].x);
+        p.orientation[1] = float(orientation.data[i].y);
+        p.orientation[2] = float(orientation.data[i].z);
+        p.orientation[3] = float(orientation.data[i].w);
+        p.velocity[0] = float(vel.data[i].x);
+        p.velocity[1] = float(vel.data[i].y);
+        p.velocity[2] = float(vel.data[i].z);
+        p.angmom[0] = float(angmom.data[i].x);
+        p.angmom[1] = float(angmom.data[i].y);
+        p.angmom[2] = float(angmom.data[i].z);
+        p.angmom[3] = float(angmom.data[i].w);
+        p.image[0] = image.x;
+        p.image[1] = image.y;
+        p.image[2] = image.z;
+        }
+    }
+
+/*! \param snapshot Snapshot of the group members, in file order (output, only on the root rank)
+
+    Unlike ParticleData::takeSnapshot, this gathers only the members of the group. With a domain
+    decomposition, each rank sends its local members to the root rank.
+*/
+void GSDDumpWriter::takeGroupSnapshot(SnapshotParticleData<float>& snapshot)
+    {
+    std::vector<PackedParticle> particles;
+    packMembers(particles);
+
+#ifdef ENABLE_MPI
+    if (m_pdata->getDomainDecomposition())
+        {
+        MPI_Comm mpi_comm = m_exec_conf->getMPICommunicator();
+        unsigned int n_ranks = m_exec_conf->getNRanks();
+
+        // count particles instead of bytes so that large groups do not overflow the counts
+        MPI_Datatype mpi_particle;
+        MPI_Type_contiguous(int(sizeof(PackedParticle)), MPI_BYTE, &mpi_particle);
+        MPI_Type_commit(&mpi_particle);
+
+        int n_send = int(particles.size());
+        std::vector<int> n_recv(n_ranks), recv_offset(n_ranks);
+        MPI_Gather(&n_send, 1, MPI_INT, n_recv.data(), 1, MPI_INT, 0, mpi_comm);
+
+        std::vector<PackedParticle> recv_buf;
+        if (m_exec_conf->isRoot())
+            {
+            int total = 0;
+            for (unsigned int r = 0; r < n_ranks; r++)
+                {
+                recv_offset[r] = total;
+                total += n_recv[r];
+                }
+            recv_buf.resize(total);
+            }
+
+        MPI_Gatherv(particles.data(),
+                    n_send,
+                    mpi_particle,
+                    recv_buf.data(),
+                    n_recv.data(),
+                    recv_offset.data(),
+                    mpi_particle,
+                    0,
+                    mpi_comm);
+        MPI_Type_free(&mpi_particle);
+        particles.swap(recv_buf);
+        }
+#endif
+
+    if (!m_exec_conf->isRoot())
+        return;
+
+    uint64_t N = m_group->getNumMembersGlobal();
+    assert(particles.size() == N);
+    snapshot.resize((unsigned int)N);
+    snapshot.type_mapping.clear();
+    for (unsigned int i = 0; i < m_pdata->getNTypes(); i++)
+        snapshot.type_mapping.push_back(m_pdata->getNameByType(i));
+
+    for (auto const& p : particles)
+        {
+        uint64_t i = p.index;
+        snapshot.type[i] = p.type;
+        snapshot.body[i] = (unsigned int)p.body;
+        snapshot.mass[i] = p.mass;
+        snapshot.charge[i] = p.charge;
+        snapshot.diameter[i] = p.diameter;
+        snapshot.inertia[i] = vec3<float>(p.inertia[0], p.inertia[1], p.inertia[2]);
+        snapshot.pos[i] = vec3<float>(p.position[0], p.position[1], p.position[2]);
+        snapshot.orientation[i]
+            = quat<float>(p.orientation[0],
+                          vec3<float>(p.orientation[1], p.orientation[2], p.orientation[3]));
+        snapshot.vel[i] = vec3<float>(p.velocity[0], p.velocity[1], p.velocity[2]);
+        snapshot.angmom[i]
+            = quat<float>(p.angmom[0], vec3<float>(p.angmom[1], p.angmom[2], p.angmom[3]));
+        snapshot.image[i] = make_int3(p.image[0], p.image[1], p.image[2]);
+        }
+    }
+
+#ifdef ENABLE_MPI
+/*! \param write_attributes Write the chunks that writeAttributes() writes
+    \param write_properties Write the chunks that writeProperties() writes
+    \param write_momenta Write the chunks that writeMomenta() writes
+    \param nframes Number of frames in the file
+
+    Members of the group are ordered by tag in the file. Rank r writes the members with file
+    indices in [N*r/P, N*(r+1)/P). Each rank sends its local members to the rank that writes them,
+    then every rank writes its slice of each chunk with MPI-IO. No rank holds more than its slice of
+    the data.
+*/
+void GSDDumpWriter::writeParticlesDistributed(bool write_attributes,
+                                              bool write_properties,
+                                              bool write_momenta,
+                                              uint64_t nframes)
+    {
+    MPI_Comm mpi_comm = m_exec_conf->getMPICommunicator();
+    unsigned int n_ranks = m_exec_conf->getNRanks();
+    unsigned int rank = m_exec_conf->getRank();
+    uint64_t N = m_group->getNumMembersGlobal();
+
+    // first file index written by each rank
+    std::vector<uint64_t> first(n_ranks + 1);
+    for (unsigned int r = 0; r <= n_ranks; r++)
+        first[r] = N * r / n_ranks;
+
+    m_exec_conf->msg->notice(10) << "GSD: distributing particle data" << endl;
+    std::vector<PackedParticle> local;
+    packMembers(local);
+
+    std::vector<std::vector<PackedParticle>> send(n_ranks);
+    for (auto const& p : local)
+        {
+        unsigned int dest
+            = (unsigned int)(std::upper_bound(first.begin(), first.end(), p.index) - first.begin())
+              - 1;
+        send[dest].push_back(p);
+        }
+
+    // exchange the particles
+    std::vector<int> send_bytes(n_ranks), send_offset(n_ranks);
+    std::vector<int> recv_bytes(n_ranks), recv_offset(n_ranks);
+    std::vector<PackedParticle> send_buf;
+    for (unsigned int r = 0; r < n_ranks; r++)
+        {
+        send_bytes[r] = int(send[r].size() * sizeof(PackedParticle));
+        send_offset[r] = int(send_buf.size() * sizeof(PackedParticle));
+        send_buf.insert(send_buf.end(), send[r].begin(), send[r].end());
+        }
+
+    MPI_Alltoall(send_bytes.data(), 1, MPI_INT, recv_bytes.data(), 1, MPI_INT, mpi_comm);
+
+    uint64_t n_local = first[rank + 1] - first[rank];
+    int total_recv = 0;
+    for (unsigned int r = 0; r < n_ranks; r++)
+        {
+        recv_offset[r] = total_recv;
+        total_recv += recv_bytes[r];
+        }
+    assert(uint64_t(total_recv) == n_local * sizeof(PackedParticle));
+
+    std::vector<PackedParticle> recv_buf(n_local);
+    MPI_Alltoallv(send_buf.data(),
+                  send_bytes.data(),
+                  send_offset.data(),
+                  MPI_BYTE,
+                  recv_buf.data(),
+                  recv_bytes.data(),
+                  recv_offset.data(),
+                  MPI_BYTE,
+                  mpi_comm);
+
+    // order the local slice by file index
+    std::vector<PackedParticle> particles(n_local);
+    for (auto const& p : recv_buf)
+        particles[p.index - first[rank]] = p;
+
+    // open the file on all ranks after the root has created or truncated it
+    MPI_Barrier(mpi_comm);
+    MPI_File file;
+    int retval = MPI_File_open(mpi_comm,
+                               (char*)m_fname.c_str(),
+                               MPI_MODE_WRONLY,
+                               MPI_INFO_NULL,
+                               &file);
+    if (retval != MPI_SUCCESS)
+        {
+        throw runtime_error("Error opening GSD file for parallel writes: " + m_fname);
+        }
+
+    if (write_attributes)
+        {
+        if (m_exec_conf->isRoot())
+            {
+            std::vector<std::string> type_mapping;
+            for (unsigned int i = 0; i < m_pdata->getNTypes(); i++)
+                type_mapping.push_back(m_pdata->getNameByType(i));
+            writeTypeMapping("particles/types", type_mapping);
+            }
+
+            {
+            std::vector<uint32_t> type(n_local);
+            bool all_default = true;
+            for (uint64_t i = 0; i < n_local; i++)
+                {
+                type[i] = particles[i].type;
+                if (type[i] != 0)
+                    all_default = false;
+                }
+            if (checkDistributedChunk("particles/typeid", all_default, nframes))
+                {
+                writeDistributedChunk(file,
+                                      "particles/typeid",
+                                      GSD_TYPE_UINT32,
+                                      1,
+                                      first[rank],
+                                      n_local,
+                                      type.data());
+                }
+            }
+
+            {
+            std::vector<float> data(n_local);
+            bool all_default = true;
+            for (uint64_t i = 0; i < n_local; i++)
+                {
+                data[i] = particles[i].mass;
+                if (data[i] != float(1.0))
+                    all_default = false;
+                }
+            if (checkDistributedChunk("particles/mass", all_default, nframes))
+                {
+                writeDistributedChunk(file,
+                                      "particles/mass",
+                                      GSD_TYPE_FLOAT,
+                                      1,
+                                      first[rank],
+                                      n_local,
+                                      data.data());
+                }
+
+            all_default = true;
+            for (uint64_t i = 0; i < n_local; i++)
+                {
+                data[i] = particles[i].charge;
+                if (data[i] != float(0.0))
+                    all_default = false;
+                }
+            if (checkDistributedChunk("particles/charge", all_default, nframes))
+                {
+                writeDistributedChunk(file,
+                                      "particles/charge",
+                                      GSD_TYPE_FLOAT,
+                                      1,
+                                      first[rank],
+                                      n_local,
+                                      data.data());
+                }
+
+            all_default = true;
+            for (uint64_t i = 0; i < n_local; i++)
+                {
+                data[i] = particles[i].diameter;
+                if (data[i] != float(1.0))
+                    all_default = false;
+                }
+            if (checkDistributedChunk("particles/diameter", all_default, nframes))
+                {
+                writeDistributedChunk(file,
+                                      "particles/diameter",
+                                      GSD_TYPE_FLOAT,
+                                      1,
+                                      first[rank],
+                                      n_local,
+                                      data.data());
+                }
+            }
+
+            {
+            std::vector<int32_t> body(n_local);
+            bool all_default = true;
+            for (uint64_t i = 0; i < n_local; i++)
+                {
+                body[i] = particles[i].body;
+                if (particles[i].body != int32_t(NO_BODY))
+                    all_default = false;
+                }
+            if (checkDistributedChunk("particles/body", all_default, nframes))
+                {
+                writeDistributedChunk(file,
+                                      "particles/body",
+                                      GSD_TYPE_INT32,
+                                      1,
+                                      first[rank],
+                                      n_local,
+                                      body.data());
+                }
+            }
+
+            {
+            std::vector<float> data(n_local * 3);
+            bool all_default = true;
+            for (uint64_t i = 0; i < n_local; i++)
+                {
+                for (unsigned int j = 0; j < 3; j++)
+                    {
+                    data[i * 3 + j] = particles[i].inertia[j];
+                    if (data[i * 3 + j] != float(0.0))
+                        all_default = false;
+                    }
+                }
+            if (checkDistributedChunk("particles/moment_inertia", all_default, nframes))
+                {
+                writeDistributedChunk(file,
+                                      "particles/moment_inertia",
+                                      GSD_TYPE_FLOAT,
+                                      3,
+                                      first[rank],
+                                      n_local,
+                                      data.data());
+                }
+            }
+        }
+
+    if (write_properties)
+        {
+            {
+            std::vector<float> data(n_local * 3);
+            for (uint64_t i = 0; i < n_local; i++)
+                {
+                for (unsigned int j = 0; j < 3; j++)
+                    data[i * 3 + j] = particles[i].position[j];
+                }
+            m_exec_conf->msg->notice(10) << "GSD: writing particles/position" << endl;
+            writeDistributedChunk(file,
+                                  "particles/position",
+                                  GSD_TYPE_FLOAT,
+                                  3,
+                                  first[rank],
+                                  n_local,
+                                  data.data());
+            }
+
+            {
+            std::vector<float> data(n_local * 4);
+            bool all_default = true;
+            for (uint64_t i = 0; i < n_local; i++)
+                {
+                for (unsigned int j = 0; j < 4; j++)
+                    data[i * 4 + j] = particles[i].orientation[j];
+                if (data[i * 4 + 0] != float(1.0) || data[i * 4 + 1] != float(0.0)
+                    || data[i * 4 + 2] != float(0.0) || data[i * 4 + 3] != float(0.0))
+                    {
+                    all_default = false;
+                    }
+                }
+            if (checkDistributedChunk("particles/orientation", all_default, nframes))
+                {
+                writeDistributedChunk(file,
+                                      "particles/orientation",
+                                      GSD_TYPE_FLOAT,
+                                      4,
+                                      first[rank],
+                                      n_local,
+                                      data.data());
+                }
+            }
+        }
+
+    if (write_momenta)
+        {
+            {
+            std::vector<float> data(n_local * 3);
+            bool all_default = true;
+            for (uint64_t i = 0; i < n_local; i++)
+                {
+                for (unsigned int j = 0; j < 3; j++)
+                    {
+                    data[i * 3 + j] = particles[i].velocity[j];
+                    if (data[i * 3 + j] != float(0.0))
+                        all_default = false;
+                    }
+                }
+            if (checkDistributedChunk("particles/velocity", all_default, nframes))
+                {
+                writeDistributedChunk(file,
+                                      "particles/velocity",
+                                      GSD_TYPE_FLOAT,
+                                      3,
+                                      first[rank],
+                                      n_local,
+                                      data.data());
+                }
+            }
+
+            {
+            std::vector<float> data(n_local * 4);
+            bool all_default = true;
+            for (uint64_t i = 0; i < n_local; i++)
+                {
+                for (unsigned int j = 0; j < 4; j++)
+                    {
+                    data[i * 4 + j] = particles[i].angmom[j];
+                    if (data[i * 4 + j] != float(0.0))
+                        all_default = false;
+                    }
+                }
+            if (checkDistributedChunk("particles/angmom", all_default, nframes))
+                {
+                writeDistributedChunk(file,
+                                      "particles/angmom",
+                                      GSD_TYPE_FLOAT,
+                                      4,
+                                      first[rank],
+                                      n_local,
+                                      data.data());
+                }
+            }
+
+            {
+            std::vector<int32_t> data(n_local * 3);
+            bool all_default = true;
+            for (uint64_t i = 0; i < n_local; i++)
+                {
+                for (unsigned int j = 0; j < 3; j++)
+                    {
+                    data[i * 3 + j] = particles[i].image[j];
+                    if (data[i * 3 + j] != 0)
+                        all_default = false;
+                    }
+                }
+            if (checkDistributedChunk("particles/image", all_default, nframes))
+                {
+                writeDistributedChunk(file,
+                                      "particles/image",
+                                      GSD_TYPE_INT32,
+                                      3,
+                                      first[rank],
+                                      n_local,
+                                      data.data());
+                }
+            }
+        }
+
+    // close the file on all ranks so that the data is on disk when the root ends the frame
+    MPI_File_close(&file);
+    }
+
+/*! \param name Name of the chunk
+    \param all_default True when all local values are the default
+    \param nframes Number of frames in the file
+
+    \returns true on all ranks when the chunk is written, following the same rules as the serial
+    writers.
+*/
+bool GSDDumpWriter::checkDistributedChunk(const std::string& name,
+                                          bool all_default,
+                                          uint64_t nframes)
+    {
+    MPI_Comm mpi_comm = m_exec_conf->getMPICommunicator();
+    int local_default = all_default;
+    int global_default = 0;
+    MPI_Allreduce(&local_default, &global_default, 1, MPI_INT, MPI_LAND, mpi_comm);
+
+    // m_nondefault is only populated on the root rank
+    bool write = false;
+    if (m_exec_conf->isRoot())
+        {
+        write = !global_default || (nframes > 0 && m_nondefault[name]);
+        if (write && nframes == 0)
+            m_nondefault[name] = true;
+        }
+    bcast(write, 0, mpi_comm);
+
+    if (write)
+        m_exec_conf->msg->notice(10) << "GSD: writing " << name << endl;
+    return write;
+    }
+
+/*! \param file MPI file handle open on all ranks
+    \param name Name of the chunk
+    \param type Type of the chunk data
+    \param M Number of columns in the chunk
+    \param first Index of the first row written by this rank
+    \param n_local Number of rows written by this rank
+    \param data Rows to write
+
+    The root rank reserves the chunk in the GSD index, then all ranks write their rows collectively.
+*/
+void GSDDumpWriter::writeDistributedChunk(MPI_File file,
+                                          const char* name,
+                                          gsd_type type,
+                                          uint32_t M,
+                                          uint64_t first,
+                                          uint64_t n_local,
+                                          const void* data)
+    {
+    MPI_Comm mpi_comm = m_exec_conf->getMPICommunicator();
+    uint64_t location = 0;
+    int retval = GSD_SUCCESS;
+    if (m_exec_conf->isRoot())
+        {
+        retval = gsd_reserve_chunk(&m_handle,
+                                   name,
+                                   type,
+                                   m_group->getNumMembersGlobal(),
+                                   M,
+                                   0,
+                                   &location);
+        }
+    bcast(retval, 0, mpi_comm);
+    bcast(location, 0, mpi_comm);
+    GSDUtils::checkError(retval, m_fname);
+
+    size_t row_size = gsd_sizeof_type(type) * M;
+    uint64_t bytes = n_local * row_size;
+    if (bytes > uint64_t(std::numeric_limits<int>::max()))
+        {
+        throw runtime_error("GSD: too many particles per rank to write " + string(name));
+        }
+
+    MPI_Offset offset = MPI_Offset(location + first * row_size);
+    retval = MPI_File_write_at_all(file,
+                                   offset,
+                                   const_cast<void*>(data),
+                                   int(bytes),
+                                   MPI_BYTE,
+                                   MPI_STATUS_IGNORE);
+    if (retval != MPI_SUCCESS)
+        {
+        throw runtime_error("Error writing " + string(name) + " to GSD file: " + m_fname);
+        }
+    }
+#endif
+
 /*! \param bond Bond data snapshot
     \param angle Angle data snapshot
     \param dihedral Dihedral data snapshot
@@ -785,116 +1473,68 @@ void GSDDumpWriter::writeTopology(BondData::Snapshot& bond,
         {
         m_exec_conf->msg->notice(10) << "GSD: writing bonds/N" << endl;
         uint32_t N = bond.size;
-        int retval = gsd_write_chunk(&m_handle, "bonds/N", GSD_TYPE_UINT32, 1, 1, 0, (void*)&N);
+        int retval = writeChunk("bonds/N", GSD_TYPE_UINT32, 1, 1, (void*)&N);
         GSDUtils::checkError(retval, m_fname);
 
         writeTypeMapping("bonds/types", bond.type_mapping);
 
         m_exec_conf->msg->notice(10) << "GSD: writing bonds/typeid" << endl;
-        retval = gsd_write_chunk(&m_handle,
-                                 "bonds/typeid",
-                                 GSD_TYPE_UINT32,
-                                 N,
-                                 1,
-                                 0,
-                                 (void*)&bond.type_id[0]);
+        retval = writeChunk("bonds/typeid", GSD_TYPE_UINT32, N, 1, (void*)&bond.type_id[0]);
         GSDUtils::checkError(retval, m_fname);
 
         m_exec_conf->msg->notice(10) << "GSD: writing bonds/group" << endl;
-        retval = gsd_write_chunk(&m_handle,
-                                 "bonds/group",
-                                 GSD_TYPE_UINT32,
-                                 N,
-                                 2,
-                                 0,
-                                 (void*)&bond.groups[0]);
+        retval = writeChunk("bonds/group", GSD_TYPE_UINT32, N, 2, (void*)&bond.groups[0]);
         GSDUtils::checkError(retval, m_fname);
         }
     if (angle.size > 0)
         {
         m_exec_conf->msg->notice(10) << "GSD: writing angles/N" << endl;
         uint32_t N = angle.size;
-        int retval = gsd_write_chunk(&m_handle, "angles/N", GSD_TYPE_UINT32, 1, 1, 0, (void*)&N);
+        int retval = writeChunk("angles/N", GSD_TYPE_UINT32, 1, 1, (void*)&N);
         GSDUtils::checkError(retval, m_fname);
 
         writeTypeMapping("angles/types", angle.type_mapping);
 
         m_exec_conf->msg->notice(10) << "GSD: writing angles/typeid" << endl;
-        retval = gsd_write_chunk(&m_handle,
-                                 "angles/typeid",
-                                 GSD_TYPE_UINT32,
-                                 N,
-                                 1,
-                                 0,
-                                 (void*)&angle.type_id[0]);
+        retval = writeChunk("angles/typeid", GSD_TYPE_UINT32, N, 1, (void*)&angle.type_id[0]);
         GSDUtils::checkError(retval, m_fname);
 
         m_exec_conf->msg->notice(10) << "GSD: writing angles/group" << endl;
-        retval = gsd_write_chunk(&m_handle,
-                                 "angles/group",
-                                 GSD_TYPE_UINT32,
-                                 N,
-                                 3,
-                                 0,
-                                 (void*)&angle.groups[0]);
+        retval = writeChunk("angles/group", GSD_TYPE_UINT32, N, 3, (void*)&angle.groups[0]);
         GSDUtils::checkError(retval, m_fname);
         }
     if (dihedral.size > 0)
         {
         m_exec_conf->msg->notice(10) << "GSD: writing dihedrals/N" << endl;
         uint32_t N = dihedral.size;
-        int retval = gsd_write_chunk(&m_handle, "dihedrals/N", GSD_TYPE_UINT32, 1, 1, 0, (void*)&N);
+        int retval = writeChunk("dihedrals/N", GSD_TYPE_UINT32, 1, 1, (void*)&N);
         GSDUtils::checkError(retval, m_fname);
 
         writeTypeMapping("dihedrals/types", dihedral.type_mapping);
 
         m_exec_conf->msg->notice(10) << "GSD: writing dihedrals/typeid" << endl;
-        retval = gsd_write_chunk(&m_handle,
-                                 "dihedrals/typeid",
-                                 GSD_TYPE_UINT32,
-                                 N,
-                                 1,
-                                 0,
-                                 (void*)&dihedral.type_id[0]);
+        retval = writeChunk("dihedrals/typeid", GSD_TYPE_UINT32, N, 1, (void*)&dihedral.type_id[0]);
         GSDUtils::checkError(retval, m_fname);
 
         m_exec_conf->msg->notice(10) << "GSD: writing dihedrals/group" << endl;
-        retval = gsd_write_chunk(&m_handle,
-                                 "dihedrals/group",
-                                 GSD_TYPE_UINT32,
-                                 N,
-                                 4,
-                                 0,
-                                 (void*)&dihedral.groups[0]);
+        retval = writeChunk("dihedrals/group", GSD_TYPE_UINT32, N, 4, (void*)&dihedral.groups[0]);
         GSDUtils::checkError(retval, m_fname);
         }
     if (improper.size > 0)
         {
         m_exec_conf->msg->notice(10) << "GSD: writing impropers/N" << endl;
         uint32_t N = improper.size;
-        int retval = gsd_write_chunk(&m_handle, "impropers/N", GSD_TYPE_UINT32, 1, 1, 0, (void*)&N);
+        int retval = writeChunk("impropers/N", GSD_TYPE_UINT32, 1, 1, (void*)&N);
         GSDUtils::checkError(retval, m_fname);
 
         writeTypeMapping("impropers/types", improper.type_mapping);
 
         m_exec_conf->msg->notice(10) << "GSD: writing impropers/typeid" << endl;
-        retval = gsd_write_chunk(&m_handle,
-                                 "impropers/typeid",
-                                 GSD_TYPE_UINT32,
-                                 N,
-                                 1,
-                                 0,
-                                 (void*)&improper.type_id[0]);
+        retval = writeChunk("impropers/typeid", GSD_TYPE_UINT32, N, 1, (void*)&improper.type_id[0]);
         GSDUtils::checkError(retval, m_fname);
 
         m_exec_conf->msg->notice(10) << "GSD: writing impropers/group" << endl;
-        retval = gsd_write_chunk(&m_handle,
-                                 "impropers/group",
-                                 GSD_TYPE_UINT32,
-                                 N,
-                                 4,
-                                 0,
-                                 (void*)&improper.groups[0]);
+        retval = writeChunk("impropers/group", GSD_TYPE_UINT32, N, 4, (void*)&improper.groups[0]);
         GSDUtils::checkError(retval, m_fname);
         }
 
@@ -902,8 +1542,7 @@ void GSDDumpWriter::writeTopology(BondData::Snapshot& bond,
         {
         m_exec_conf->msg->notice(10) << "GSD: writing constraints/N" << endl;
         uint32_t N = constraint.size;
-        int retval
-            = gsd_write_chunk(&m_handle, "constraints/N", GSD_TYPE_UINT32, 1, 1, 0, (void*)&N);
+        int retval = writeChunk("constraints/N", GSD_TYPE_UINT32, 1, 1, (void*)&N);
         GSDUtils::checkError(retval, m_fname);
 
         m_exec_conf->msg->notice(10) << "GSD: writing constraints/value" << endl;
@@ -913,24 +1552,16 @@ void GSDDumpWriter::writeTopology(BondData::Snapshot& bond,
             for (unsigned int i = 0; i < N; i++)
                 data[i] = float(constraint.val[i]);
 
-            retval = gsd_write_chunk(&m_handle,
-                                     "constraints/value",
-                                     GSD_TYPE_FLOAT,
-                                     N,
-                                     1,
-                                     0,
-                                     (void*)&data[0]);
+            retval = writeChunk("constraints/value", GSD_TYPE_FLOAT, N, 1, (void*)&data[0]);
             GSDUtils::checkError(retval, m_fname);
             }
 
         m_exec_conf->msg->notice(10) << "GSD: writing constraints/group" << endl;
-        retval = gsd_write_chunk(&m_handle,
-                                 "constraints/group",
-                                 GSD_TYPE_UINT32,
-                                 N,
-                                 2,
-                                 0,
-                                 (void*)&constraint.groups[0]);
+        retval = writeChunk("constraints/group",
+                            GSD_TYPE_UINT32,
+                            N,
+                            2,
+                            (void*)&constraint.groups[0]);
         GSDUtils::checkError(retval, m_fname);
         }
 
@@ -938,29 +1569,17 @@ void GSDDumpWriter::writeTopology(BondData::Snapshot& bond,
         {
         m_exec_conf->msg->notice(10) << "GSD: writing pairs/N" << endl;
         uint32_t N = pair.size;
-        int retval = gsd_write_chunk(&m_handle, "pairs/N", GSD_TYPE_UINT32, 1, 1, 0, (void*)&N);
+        int retval = writeChunk("pairs/N", GSD_TYPE_UINT32, 1, 1, (void*)&N);
         GSDUtils::checkError(retval, m_fname);
 
         writeTypeMapping("pairs/types", pair.type_mapping);
 
         m_exec_conf->msg->notice(10) << "GSD: writing pairs/typeid" << endl;
-        retval = gsd_write_chunk(&m_handle,
-                                 "pairs/typeid",
-                                 GSD_TYPE_UINT32,
-                                 N,
-                                 1,
-                                 0,
-                                 (void*)&pair.type_id[0]);
+        retval = writeChunk("pairs/typeid", GSD_TYPE_UINT32, N, 1, (void*)&pair.type_id[0]);
         GSDUtils::checkError(retval, m_fname);
 
         m_exec_conf->msg->notice(10) << "GSD: writing pairs/group" << endl;
-        retval = gsd_write_chunk(&m_handle,
-                                 "pairs/group",
-                                 GSD_TYPE_UINT32,
-                                 N,
-                                 2,
-                                 0,
-                                 (void*)&pair.groups[0]);
+        retval = writeChunk("pairs/group", GSD_TYPE_UINT32, N, 2, (void*)&pair.groups[0]);
         GSDUtils::checkError(retval, m_fname);
         }
     }
@@ -1061,13 +1680,7 @@ void GSDDumpWriter::writeLogQuantities(pybind11::dict dict)
                 throw invalid_argument("Invalid numpy dimension in gsd log data [" + name + "]");
                 }
 
-            int retval = gsd_write_chunk(&m_handle,
-                                         name.c_str(),
-                                         type,
-                                         N,
-                                         (uint32_t)M,
-                                         0,
-                                         (void*)arr.data());
+            int retval = writeChunk(name.c_str(), type, N, (uint32_t)M, (void*)arr.data());
             GSDUtils::checkError(retval, m_fname);
             }
         }
@@ -1131,6 +1744,12 @@ void export_GSDDumpWriter(py::module& m)
         .def_property_readonly("mode", &GSDDumpWriter::getMode)
         .def_property_readonly("dynamic", &GSDDumpWriter::getDynamic)
         .def_property_readonly("truncate", &GSDDumpWriter::getTruncate)
+        .def_property("asynchronous",
+                      &GSDDumpWriter::getAsynchronous,
+                      &GSDDumpWriter::setAsynchronous)
+        .def("flush", &GSDDumpWriter::flush)
+        .def_property("parallel", &GSDDumpWriter::getParallel, &GSDDumpWriter::setParallel)
+        .def("setCompression", &GSDDumpWriter::setCompression)
         .def_property_readonly("filter",
                                [](const std::shared_ptr<GSDDumpWriter> gsd)
                                { return gsd->getGroup()->getFilter(); });
@@ -4,12 +4,15 @@
 #pragma once
 
 #include "Analyzer.h"
+#include "BackgroundWriter.h"
 #include "ParticleGroup.h"
 #include "SharedSignal.h"
 
 #include "hoomd/extern/gsd.h"
+#include <map>
 #include <memory>
 #include <string>
+#include <vector>
 
 /*! \file GSDDumpWriter.h
     \brief Declares the GSDDumpWriter class
@@ -28,6 +31,22 @@
 
     The file is not opened until the first call to analyze().
 
+    analyze() gathers only the members of the group on the root rank, it does not take a snapshot
+    of all particles. On the GPU, the members are gathered on the device before they are copied to
+    the host.
+
+    In asynchronous mode, analyze() copies the frame into a staging buffer and a background thread
+    performs the file writes on the root rank. At most two frames are buffered;
+    analyze() blocks when the queue is full. flush() waits for all buffered frames to be written.
+
+    setCompression() selects per-particle chunks to compress with GSDCodec. Compressed chunks are
+    stored as uint8 chunks that GSDReader decodes.
+
+    In parallel mode with a domain decomposition, the particle data is not gathered on the root
+    rank. Each rank sends its local group members to the rank that writes the corresponding slice of
+    the per-particle chunks, and all ranks write their slices with MPI-IO at offsets the root rank
+    reserves in the file. The root rank still writes the frame header and topology.
+
     \ingroup analyzers
 */
 class PYBIND11_EXPORT GSDDumpWriter : public Analyzer
@@ -79,6 +98,28 @@ class PYBIND11_EXPORT GSDDumpWriter : public Analyzer
         return m_truncate;
         }
 
+    //! Enable or disable writing frames on a background thread
+    void setAsynchronous(bool asynchronous);
+
+    bool getAsynchronous()
+        {
+        return m_asynchronous;
+        }
+
+    //! Enable or disable writing per-particle chunks from all ranks
+    void setParallel(bool parallel)
+        {
+        m_parallel = parallel;
+        }
+
+    bool getParallel()
+        {
+        return m_parallel;
+        }
+
+    //! Compress a per-particle chunk
+    void setCompression(const std::string& name, float precision);
+
     std::shared_ptr<ParticleGroup> getGroup()
         {
         return m_group;
@@ -105,8 +146,19 @@ class PYBIND11_EXPORT GSDDumpWriter : public Analyzer
     //! Write out the data for the current timestep
     void analyze(uint64_t timestep);
 
+    //! Wait until all buffered frames are written to the file
+    virtual void flush();
+
+    /// Stop the background writer when removed from the Simulation
+    virtual void notifyDetach()
+        {
+        m_writer.stop();
+        }
+
     hoomd::detail::SharedSignal<int(gsd_handle&)>& getWriteSignal()
         {
+        // slots write to m_handle directly, so frames must be written synchronously
+        m_write_signal_requested = true;
         return m_write_signal;
         }
 
@@ -160,6 +212,105 @@ class PYBIND11_EXPORT GSDDumpWriter : public Analyzer
 
     hoomd::detail::SharedSignal<int(gsd_handle&)> m_write_signal;
 
+    /// True when slots may be connected to m_write_signal
+    bool m_write_signal_requested = false;
+
+    /// Number of frames in the file, including frames buffered for writing
+    uint64_t m_nframes = 0;
+
+    /// A data chunk staged for writing
+    struct StagedChunk
+        {
+        std::string name;
+        gsd_type type;
+        uint64_t N;
+        uint32_t M;
+        std::vector<char> data;
+        };
+
+    /// A frame staged for writing by the background thread
+    struct StagedFrame
+        {
+        bool truncate = false;
+        std::vector<StagedChunk> chunks;
+        };
+
+    /// True if frames are written on a background thread
+    bool m_asynchronous = false;
+
+    /// True while analyze() stages chunks into m_frame
+    bool m_staging = false;
+
+    /// Frame being staged by analyze()
+    StagedFrame m_frame;
+
+    /// Writes staged frames on a background thread
+    hoomd::detail::BackgroundWriter m_writer;
+
+    /// Chunks to compress and their quantization precision (0 for lossless compression)
+    std::map<std::string, float> m_compression;
+
+    //! Write a chunk to the file, or stage it when writing in the background
+    int writeChunk(const char* name, gsd_type type, uint64_t N, uint32_t M, const void* data);
+
+    //! Write a chunk to the file, compressing it when requested
+    int writeChunkToFile(const char* name, gsd_type type, uint64_t N, uint32_t M, const void* data);
+
+    //! Write the staged frame and end it
+    int writeStagedFrame(const StagedFrame& frame);
+
+    //! Queue m_frame for the background thread, blocking while the queue is full
+    void enqueueFrame();
+
+    /// True if all ranks write the per-particle chunks in a domain decomposition
+    bool m_parallel = false;
+
+    /// Per-particle data of a group member, converted to the file precision
+    struct PackedParticle
+        {
+        uint64_t index;
+        uint32_t type;
+        int32_t body;
+        float mass;
+        float charge;
+        float diameter;
+        float inertia[3];
+        float position[3];
+        float orientation[4];
+        float velocity[3];
+        float angmom[4];
+        int32_t image[3];
+        };
+
+    //! Gather the values of the local group members from a per-particle array
+    template<class T> void gatherMembers(const GlobalArray<T>& array, T* values);
+
+    //! Convert the local group members to the file precision
+    void packMembers(std::vector<PackedParticle>& particles);
+
+    //! Gather the group members on the root rank, in file order
+    void takeGroupSnapshot(SnapshotParticleData<float>& snapshot);
+
+#ifdef ENABLE_MPI
+    //! Write the per-particle chunks from all ranks
+    void writeParticlesDistributed(bool write_attributes,
+                                   bool write_properties,
+                                   bool write_momenta,
+                                   uint64_t nframes);
+
+    //! Determine whether a chunk must be written, given the local default state
+    bool checkDistributedChunk(const std::string& name, bool all_default, uint64_t nframes);
+
+    //! Write a slice of a per-particle chunk from every rank
+    void writeDistributedChunk(MPI_File file,
+                               const char* name,
+                               gsd_type type,
+                               uint32_t M,
+                               uint64_t first,
+                               uint64_t n_local,
+                               const void* data);
+#endif
+
     //! Write a type mapping out to the file
     void writeTypeMapping(std::string chunk, std::vector<std::string> type_mapping);
 
@@ -170,16 +321,13 @@ class PYBIND11_EXPORT GSDDumpWriter : public Analyzer
     void writeFrameHeader(uint64_t timestep);
 
     //! Write particle attributes
-    void writeAttributes(const SnapshotParticleData<float>& snapshot,
-                         const std::map<unsigned int, unsigned int>& map);
+    void writeAttributes(const SnapshotParticleData<float>& snapshot);
 
     //! Write particle properties
-    void writeProperties(const SnapshotParticleData<float>& snapshot,
-                         const std::map<unsigned int, unsigned int>& map);
+    void writeProperties(const SnapshotParticleData<float>& snapshot);
 
     //! Write particle momenta
-    void writeMomenta(const SnapshotParticleData<float>& snapshot,
-                      const std::map<unsigned int, unsigned int>& map);
+    void writeMomenta(const SnapshotParticleData<float>& snapshot);
 
     //! Write bond topology
     void writeTopology(BondData::Snapshot& bond,
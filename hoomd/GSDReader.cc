@@ -4,6 +4,7 @@
 #include "GSDReader.h"
 #include "ExecutionConfiguration.h"
 #include "GSD.h"
+#include "GSDCodec.h"
 #include "SnapshotSystemData.h"
 #include "hoomd/extern/gsd.h"
 #include <sstream>
@@ -19,21 +20,30 @@ namespace py = pybind11;
     \param name File name to read
     \param frame Frame index to read from the file
     \param from_end Count frames back from the end of the file
+    \param distributed Read a slice of the particles on every rank
 
     The GSDReader constructor opens the GSD file, initializes an empty snapshot, and reads the file
    into memory (on the root rank).
+
+    When \a distributed is set in an MPI simulation, every rank opens the file and reads a
+   contiguous slice of the particles into SnapshotParticleData, which is marked with
+   SnapshotParticleData::is_distributed. The topology is still read on the root rank.
 */
 GSDReader::GSDReader(std::shared_ptr<const ExecutionConfiguration> exec_conf,
                      const std::string& name,
                      const uint64_t frame,
-                     bool from_end)
-    : m_exec_conf(exec_conf), m_timestep(0), m_name(name), m_frame(frame)
+                     bool from_end,
+                     bool distributed)
+    : m_exec_conf(exec_conf), m_timestep(0), m_name(name), m_frame(frame), m_distributed(false),
+      m_n_global(0), m_first(0)
     {
     m_snapshot = std::shared_ptr<SnapshotSystemData<float>>(new SnapshotSystemData<float>);
 
 #ifdef ENABLE_MPI
+    m_distributed = distributed && m_exec_conf->getNRanks() > 1;
+
     // if we are not the root processor, do not perform file I/O
-    if (!m_exec_conf->isRoot())
+    if (!m_exec_conf->isRoot() && !m_distributed)
         {
         return;
         }
@@ -74,14 +84,15 @@ GSDReader::GSDReader(std::shared_ptr<const ExecutionConfiguration> exec_conf,
 
     readHeader();
     readParticles();
-    readTopology();
+    if (m_exec_conf->isRoot())
+        readTopology();
     }
 
 GSDReader::~GSDReader()
     {
 #ifdef ENABLE_MPI
     // if we are not the root processor, do not perform file I/O
-    if (!m_exec_conf->isRoot())
+    if (!m_exec_conf->isRoot() && !m_distributed)
         {
         return;
         }
@@ -102,6 +113,8 @@ GSDReader::~GSDReader()
 
     Per the GSD spec, keep the default when the frame 0 N does not match the current N.
 
+    Chunks compressed by GSDDumpWriter are decoded with GSDCodec.
+
     Return true if data is actually read from the file.
 */
 bool GSDReader::readChunk(void* data,
@@ -114,11 +127,36 @@ bool GSDReader::readChunk(void* data,
     if (entry == NULL && frame != 0)
         entry = gsd_find_chunk(&m_handle, 0, name);
 
-    if (entry == NULL || (cur_n != 0 && entry->N != cur_n))
+    // compressed chunks record the type and shape of the data in a header
+    std::vector<char> encoded;
+    GSDCodec::Header header;
+    bool compressed = false;
+    if (entry != NULL && entry->type == GSD_TYPE_UINT8 && entry->M == 1
+        && entry->N >= sizeof(GSDCodec::Header) && entry->N * entry->M != expected_size)
+        {
+        encoded.resize(entry->N);
+        int retval = gsd_read_chunk(&m_handle, &encoded[0], entry);
+        GSDUtils::checkError(retval, m_name);
+        compressed = GSDCodec::readHeader(encoded, header);
+        }
+
+    uint64_t entry_n = 0;
+    if (entry != NULL)
+        entry_n = compressed ? header.N : entry->N;
+
+    if (entry == NULL || (cur_n != 0 && entry_n != cur_n))
         {
         m_exec_conf->msg->notice(10) << "data.gsd_snapshot: chunk not found " << name << endl;
         return false;
         }
+    else if (compressed)
+        {
+        m_exec_conf->msg->notice(7) << "data.gsd_snapshot: reading compressed chunk " << name
+                                    << endl;
+        GSDCodec::decode(encoded, data, expected_size);
+
+        return true;
+        }
     else
         {
         m_exec_conf->msg->notice(7) << "data.gsd_snapshot: reading chunk " << name << endl;
@@ -203,37 +241,78 @@ void GSDReader::readHeader()
                                   << "cannot read a file with 0 particles" << endl;
         throw runtime_error("Error reading GSD file");
         }
-    m_snapshot->particle_data.resize(N);
+    m_n_global = N;
+
+    unsigned int n_local = N;
+#ifdef ENABLE_MPI
+    if (m_distributed)
+        {
+        uint64_t rank = m_exec_conf->getRank();
+        uint64_t n_ranks = m_exec_conf->getNRanks();
+        m_first = (unsigned int)(N * rank / n_ranks);
+        n_local = (unsigned int)(N * (rank + 1) / n_ranks) - m_first;
+        }
+#endif
+
+    m_snapshot->particle_data.resize(n_local);
+    m_snapshot->particle_data.is_distributed = m_distributed;
+    }
+
+/*! \param data Pointer to data to read into
+    \param name Name of the data chunk
+    \param row_size Size of one row of the chunk in bytes
+
+    Read the rows of the chunk for the particles in the local snapshot. Compressed chunks cannot be
+   read in slices, they are decoded in full and then copied.
+
+    Return true if data is actually read from the file.
+*/
+bool GSDReader::readParticleChunk(void* data, const char* name, size_t row_size)
+    {
+    if (!m_distributed)
+        return readChunk(data, m_frame, name, m_n_global * row_size, m_n_global);
+
+    size_t n_local = m_snapshot->particle_data.size;
+    const struct gsd_index_entry* entry = gsd_find_chunk(&m_handle, m_frame, name);
+    if (entry == NULL && m_frame != 0)
+        entry = gsd_find_chunk(&m_handle, 0, name);
+
+    if (entry != NULL && entry->N == m_n_global
+        && entry->M * gsd_sizeof_type((enum gsd_type)entry->type) == row_size)
+        {
+        m_exec_conf->msg->notice(7) << "data.gsd_snapshot: reading rows of chunk " << name << endl;
+        int retval = gsd_read_chunk_rows(&m_handle, data, entry, m_first, n_local);
+        GSDUtils::checkError(retval, m_name);
+        return true;
+        }
+
+    std::vector<char> all_rows(m_n_global * row_size);
+    if (!readChunk(all_rows.data(), m_frame, name, all_rows.size(), m_n_global))
+        return false;
+
+    memcpy(data, all_rows.data() + m_first * row_size, n_local * row_size);
+    return true;
     }
 
 /*! Read the same data chunks for particles
  */
 void GSDReader::readParticles()
     {
-    unsigned int N = m_snapshot->particle_data.size;
     m_snapshot->particle_data.type_mapping = readTypes(m_frame, "particles/types");
 
     // the snapshot already has default values, if a chunk is not found, the value
     // is already at the default, and the failed read is not a problem
-    readChunk(&m_snapshot->particle_data.type[0], m_frame, "particles/typeid", N * 4, N);
-    readChunk(&m_snapshot->particle_data.mass[0], m_frame, "particles/mass", N * 4, N);
-    readChunk(&m_snapshot->particle_data.charge[0], m_frame, "particles/charge", N * 4, N);
-    readChunk(&m_snapshot->particle_data.diameter[0], m_frame, "particles/diameter", N * 4, N);
-    readChunk(&m_snapshot->particle_data.body[0], m_frame, "particles/body", N * 4, N);
-    readChunk(&m_snapshot->particle_data.inertia[0],
-              m_frame,
-              "particles/moment_inertia",
-              N * 12,
-              N);
-    readChunk(&m_snapshot->particle_data.pos[0], m_frame, "particles/position", N * 12, N);
-    readChunk(&m_snapshot->particle_data.orientation[0],
-              m_frame,
-              "particles/orientation",
-              N * 16,
-              N);
-    readChunk(&m_snapshot->particle_data.vel[0], m_frame, "particles/velocity", N * 12, N);
-    readChunk(&m_snapshot->particle_data.angmom[0], m_frame, "particles/angmom", N * 16, N);
-    readChunk(&m_snapshot->particle_data.image[0], m_frame, "particles/image", N * 12, N);
+    readParticleChunk(m_snapshot->particle_data.type.data(), "particles/typeid", 4);
+    readParticleChunk(m_snapshot->particle_data.mass.data(), "particles/mass", 4);
+    readParticleChunk(m_snapshot->particle_data.charge.data(), "particles/charge", 4);
+    readParticleChunk(m_snapshot->particle_data.diameter.data(), "particles/diameter", 4);
+    readParticleChunk(m_snapshot->particle_data.body.data(), "particles/body", 4);
+    readParticleChunk(m_snapshot->particle_data.inertia.data(), "particles/moment_inertia", 12);
+    readParticleChunk(m_snapshot->particle_data.pos.data(), "particles/position", 12);
+    readParticleChunk(m_snapshot->particle_data.orientation.data(), "particles/orientation", 16);
+    readParticleChunk(m_snapshot->particle_data.vel.data(), "particles/velocity", 12);
+    readParticleChunk(m_snapshot->particle_data.angmom.data(), "particles/angmom", 16);
+    readParticleChunk(m_snapshot->particle_data.image.data(), "particles/image", 12);
     }
 
 /*! Read the same data chunks for topology
@@ -465,6 +544,7 @@ void export_GSDReader(py::module& m)
         .def(py::init<std::shared_ptr<const ExecutionConfiguration>,
                       const string&,
                       const uint64_t,
+                      bool,
                       bool>())
         .def("getTimeStep", &GSDReader::getTimeStep)
         .def("getSnapshot", &GSDReader::getSnapshot)
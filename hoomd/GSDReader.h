@@ -31,7 +31,8 @@ class PYBIND11_EXPORT GSDReader
     GSDReader(std::shared_ptr<const ExecutionConfiguration> exec_conf,
               const std::string& name,
               const uint64_t frame,
-              bool from_end);
+              bool from_end,
+              bool distributed = false);
 
     //! Destructor
     ~GSDReader();
@@ -91,9 +92,21 @@ class PYBIND11_EXPORT GSDReader
     std::shared_ptr<SnapshotSystemData<float>> m_snapshot;     //!< The snapshot to read
     gsd_handle m_handle;                                       //!< Handle to the file
 
+    /// True when every rank reads a slice of the particles
+    bool m_distributed;
+
+    /// Number of particles in the frame
+    unsigned int m_n_global;
+
+    /// Index of the first particle read by this rank
+    unsigned int m_first;
+
     //! Helper function to read a type list from the file
     std::vector<std::string> readTypes(uint64_t frame, const char* name);
 
+    /// Read the rows of a per-particle chunk that belong to this rank
+    bool readParticleChunk(void* data, const char* name, size_t row_size);
+
     // helper functions to read sections of the file
     void readHeader();
     void readParticles();
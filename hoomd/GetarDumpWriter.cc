@@ -6,6 +6,7 @@
 #include "ParticleData.h"
 
 #include <cstdio>
+#include <cstring>
 #include <iostream>
 
 namespace py = pybind11;
@@ -324,20 +325,58 @@ GetarDumpWriter::GetarDumpWriter(std::shared_ptr<SystemDefinition> sysdef,
     m_systemSnap = takeSystemSnapshot(m_sysdef);
     }
 
-GetarDumpWriter::~GetarDumpWriter() { }
+GetarDumpWriter::~GetarDumpWriter()
+    {
+    try
+        {
+        flush();
+        }
+    catch (const std::exception& e)
+        {
+        m_exec_conf->msg->error() << "getar: " << e.what() << endl;
+        }
+    m_writer.stop();
+    }
 
 void GetarDumpWriter::close()
     {
+    flush();
     if (m_archive)
         m_archive->close();
     }
 
+/*! \param asynchronous Set to true to write frames on a background thread
+
+    Disabling asynchronous mode writes all buffered frames and stops the background thread.
+*/
+void GetarDumpWriter::setAsynchronous(bool asynchronous)
+    {
+    if (!asynchronous)
+        {
+        flush();
+        m_writer.stop();
+        }
+    m_asynchronous = asynchronous;
+    }
+
+void GetarDumpWriter::setBatchFrames(unsigned int batchFrames)
+    {
+    if (batchFrames == 0)
+        throw std::domain_error("batch_frames must be greater than 0");
+    m_batchFrames = batchFrames;
+    }
+
+void GetarDumpWriter::flush()
+    {
+    submitFrames();
+    m_writer.flush();
+    }
+
 void GetarDumpWriter::analyze(uint64_t timestep)
     {
     Analyzer::analyze(timestep);
     const uint64_t shiftedTimestep(timestep - m_offset);
     bool neededSnapshots[9] = {false, false, false, false, false, false, false, false, false};
-    bool ranThisStep(false);
 
     for (NeedSnapshotMap::iterator pIter(m_neededSnapshots.begin());
          pIter != m_neededSnapshots.end();
@@ -359,80 +398,151 @@ void GetarDumpWriter::analyze(uint64_t timestep)
         return;
 #endif
 
+    m_writer.checkError();
+
+    vector<GetarDumpDescription> records;
+    for (PeriodMap::iterator pIter(m_periods.begin()); pIter != m_periods.end(); ++pIter)
+        {
+        if (!(shiftedTimestep % pIter->first))
+            records.insert(records.end(), pIter->second.begin(), pIter->second.end());
+        }
+
+    if (records.empty() || (m_operationMode != OneShot && !m_archive))
+        return;
+
+    m_pendingFrames.push_back(stageFrame(timestep, records));
+    if (m_pendingFrames.size() >= m_batchFrames)
+        submitFrames();
+    }
+
+/*! Copies everything the records need from the particle data, so that the frame can be written
+    while the simulation continues.
+*/
+shared_ptr<GetarFrame> GetarDumpWriter::stageFrame(uint64_t timestep,
+                                                   const vector<GetarDumpDescription>& records)
+    {
+    shared_ptr<GetarFrame> frame(new GetarFrame());
+    frame->timestep = timestep;
+    frame->records = records;
     if (m_operationMode == OneShot)
+        frame->staticRecords = m_staticRecords;
+    // snapshots are never modified after they are taken, so frames may share them
+    frame->snapshot = m_systemSnap;
+    frame->box = m_pdata->getGlobalBox();
+
+    bool needForce(false), needVirial(false);
+    for (const vector<GetarDumpDescription>* list : {&frame->records, &frame->staticRecords})
+        for (vector<GetarDumpDescription>::const_iterator iter(list->begin());
+             iter != list->end();
+             ++iter)
+            {
+            needForce |= iter->m_prop == PotentialEnergy;
+            needVirial |= iter->m_prop == Virial;
+            }
+
+    if (needForce)
         {
-        for (PeriodMap::iterator pIter(m_periods.begin()); pIter != m_periods.end(); ++pIter)
-            if (!(shiftedTimestep % pIter->first))
-                ranThisStep = true;
+        ArrayHandle<unsigned int> tags(m_pdata->getTags(),
+                                       access_location::host,
+                                       access_mode::read);
+        ArrayHandle<Scalar4> handle(m_pdata->getNetForce(),
+                                    access_location::host,
+                                    access_mode::read);
+        const unsigned int N(m_pdata->getN());
 
-        if (ranThisStep)
+        for (unsigned int i(0); i < N; ++i)
+            frame->netForce[tags.data[i]] = handle.data[i];
+        }
+
+    if (needVirial)
+        {
+        ArrayHandle<unsigned int> tags(m_pdata->getTags(),
+                                       access_location::host,
+                                       access_mode::read);
+        ArrayHandle<Scalar> handle(m_pdata->getNetVirial(),
+                                   access_location::host,
+                                   access_mode::read);
+
+        const unsigned int N(m_pdata->getN());
+        size_t virialPitch(m_pdata->getNetVirial().getPitch());
+
+        for (unsigned int i(0); i < N; ++i)
+            for (unsigned int j(0); j < 6; ++j)
+                frame->netVirial[j][tags.data[i]] = handle.data[j * virialPitch + i];
+        }
+
+    return frame;
+    }
+
+void GetarDumpWriter::submitFrames()
+    {
+    if (m_pendingFrames.empty())
+        return;
+
+    shared_ptr<vector<shared_ptr<GetarFrame>>> frames(new vector<shared_ptr<GetarFrame>>());
+    frames->swap(m_pendingFrames);
+
+    if (m_asynchronous)
+        m_writer.enqueue([this, frames]() { writeFrames(*frames); });
+    else
+        writeFrames(*frames);
+    }
+
+/*! Records are compressed as they are written, so this runs on the background thread in
+    asynchronous mode.
+*/
+void GetarDumpWriter::writeFrames(const vector<shared_ptr<GetarFrame>>& frames)
+    {
+    if (m_operationMode == OneShot)
+        {
+        // every frame replaces the file, so only the last one needs to be written
+        const GetarFrame& frame(*frames.back());
+
+        m_archive.reset(new GTAR(m_tempName, gtar::Write));
             {
-            m_archive.reset(new GTAR(m_tempName, gtar::Write));
-                {
-                GTAR::BulkWriter writer(*m_archive);
-
-                for (PeriodMap::iterator pIter(m_periods.begin()); pIter != m_periods.end();
-                     ++pIter)
-                    {
-                    if (!(shiftedTimestep % pIter->first))
-                        {
-                        for (vector<GetarDumpDescription>::iterator dIter(pIter->second.begin());
-                             dIter != pIter->second.end();
-                             ++dIter)
-                            {
-                            write(writer, *dIter, timestep);
-                            // const Property prop(dIter->m_prop);
-                            // const Resolution res(dIter->m_res);
-
-                            // string path(dIter->getFormattedPath(timestep));
-                            }
-                        }
-                    }
-
-                for (vector<GetarDumpDescription>::const_iterator iter(m_staticRecords.begin());
-                     iter != m_staticRecords.end();
-                     ++iter)
-                    write(writer, *iter, 0);
-                }
+            GTAR::BulkWriter writer(*m_archive);
 
-            m_archive.reset();
-            int result(rename(m_tempName.c_str(), m_filename.c_str()));
+            for (vector<GetarDumpDescription>::const_iterator iter(frame.records.begin());
+                 iter != frame.records.end();
+                 ++iter)
+                write(writer, frame, *iter, frame.timestep);
 
-            if (result)
-                {
-                stringstream msg;
-                msg << "Error " << result << " in one-shot file: " << strerror(result);
-                m_exec_conf->msg->error() << msg.str() << endl;
-                throw runtime_error(msg.str());
-                }
+            for (vector<GetarDumpDescription>::const_iterator iter(frame.staticRecords.begin());
+                 iter != frame.staticRecords.end();
+                 ++iter)
+                write(writer, frame, *iter, 0);
+            }
+
+        m_archive.reset();
+        int result(rename(m_tempName.c_str(), m_filename.c_str()));
+
+        if (result)
+            {
+            stringstream msg;
+            msg << "Error " << result << " in one-shot file: " << strerror(result);
+            throw runtime_error(msg.str());
             }
         }
-    else if (m_archive)
+    else
         {
+        // write the whole batch through one bulk writer
         GTAR::BulkWriter writer(*m_archive);
 
-        for (PeriodMap::iterator pIter(m_periods.begin()); pIter != m_periods.end(); ++pIter)
+        for (vector<shared_ptr<GetarFrame>>::const_iterator fIter(frames.begin());
+             fIter != frames.end();
+             ++fIter)
             {
-            if (!(shiftedTimestep % pIter->first))
-                {
-                ranThisStep = true;
-
-                for (vector<GetarDumpDescription>::iterator dIter(pIter->second.begin());
-                     dIter != pIter->second.end();
-                     ++dIter)
-                    {
-                    write(writer, *dIter, timestep);
-                    // const Property prop(dIter->m_prop);
-                    // const Resolution res(dIter->m_res);
-
-                    // string path(dIter->getFormattedPath(timestep));
-                    }
-                }
+            const GetarFrame& frame(**fIter);
+            for (vector<GetarDumpDescription>::const_iterator iter(frame.records.begin());
+                 iter != frame.records.end();
+                 ++iter)
+                write(writer, frame, *iter, frame.timestep);
             }
         }
     }
 
 void GetarDumpWriter::write(GTAR::BulkWriter& writer,
+                            const GetarFrame& frame,
                             const GetarDumpDescription& desc,
                             uint64_t timestep)
     {
@@ -440,22 +550,23 @@ void GetarDumpWriter::write(GTAR::BulkWriter& writer,
         return;
 
     if (desc.m_res == Individual)
-        writeIndividual(writer, desc, timestep);
+        writeIndividual(writer, frame, desc, timestep);
     else if (desc.m_res == Text)
-        writeText(writer, desc, timestep);
+        writeText(writer, frame, desc, timestep);
     else if (desc.m_res == Uniform)
-        writeUniform(writer, desc, timestep);
+        writeUniform(writer, frame, desc, timestep);
     }
 
 void GetarDumpWriter::writeIndividual(GTAR::BulkWriter& writer,
+                                      const GetarFrame& frame,
                                       const GetarDumpDescription& desc,
                                       uint64_t timestep)
     {
     if (desc.m_prop == AngularMomentum)
         {
         typedef QuatsxyzIterator<float, vector<quat<Scalar>>::iterator> iter_t;
-        iter_t begin(m_systemSnap->particle_data.angmom.begin());
-        iter_t end(m_systemSnap->particle_data.angmom.end());
+        iter_t begin(frame.snapshot->particle_data.angmom.begin());
+        iter_t end(frame.snapshot->particle_data.angmom.end());
         writer.writeIndividual<iter_t, float>(desc.getFormattedPath(timestep),
                                               begin,
                                               end,
@@ -463,13 +574,13 @@ void GetarDumpWriter::writeIndividual(GTAR::BulkWriter& writer,
         }
     else if (desc.m_prop == AngleNames)
         {
-        string json(makeTypeList(m_systemSnap->angle_data.type_mapping));
+        string json(makeTypeList(frame.snapshot->angle_data.type_mapping));
         writer.writeString(desc.getFormattedPath(timestep), json, desc.m_compression);
         }
     else if (desc.m_prop == AngleTags)
         {
-        GroupTagIterator<3> begin(m_systemSnap->angle_data.groups.begin());
-        GroupTagIterator<3> end(m_systemSnap->angle_data.groups.end());
+        GroupTagIterator<3> begin(frame.snapshot->angle_data.groups.begin());
+        GroupTagIterator<3> end(frame.snapshot->angle_data.groups.end());
         writer.writeIndividual<GroupTagIterator<3>, uint32_t>(desc.getFormattedPath(timestep),
                                                               begin,
                                                               end,
@@ -477,8 +588,8 @@ void GetarDumpWriter::writeIndividual(GTAR::BulkWriter& writer,
         }
     else if (desc.m_prop == AngleTypes)
         {
-        vector<unsigned int>::iterator begin(m_systemSnap->angle_data.type_id.begin());
-        vector<unsigned int>::iterator end(m_systemSnap->angle_data.type_id.end());
+        vector<unsigned int>::iterator begin(frame.snapshot->angle_data.type_id.begin());
+        vector<unsigned int>::iterator end(frame.snapshot->angle_data.type_id.end());
         writer.writeIndividual<vector<unsigned int>::iterator, uint32_t>(
             desc.getFormattedPath(timestep),
             begin,
@@ -487,8 +598,8 @@ void GetarDumpWriter::writeIndividual(GTAR::BulkWriter& writer,
         }
     else if (desc.m_prop == Body)
         {
-        vector<unsigned int>::iterator begin(m_systemSnap->particle_data.body.begin());
-        vector<unsigned int>::iterator end(m_systemSnap->particle_data.body.end());
+        vector<unsigned int>::iterator begin(frame.snapshot->particle_data.body.begin());
+        vector<unsigned int>::iterator end(frame.snapshot->particle_data.body.end());
         writer.writeIndividual<vector<unsigned int>::iterator, int32_t>(
             desc.getFormattedPath(timestep),
             begin,
@@ -497,13 +608,13 @@ void GetarDumpWriter::writeIndividual(GTAR::BulkWriter& writer,
         }
     else if (desc.m_prop == BondNames)
         {
-        string json(makeTypeList(m_systemSnap->bond_data.type_mapping));
+        string json(makeTypeList(frame.snapshot->bond_data.type_mapping));
         writer.writeString(desc.getFormattedPath(timestep), json, desc.m_compression);
         }
     else if (desc.m_prop == BondTags)
         {
-        GroupTagIterator<2> begin(m_systemSnap->bond_data.groups.begin());
-        GroupTagIterator<2> end(m_systemSnap->bond_data.groups.end());
+        GroupTagIterator<2> begin(frame.snapshot->bond_data.groups.begin());
+        GroupTagIterator<2> end(frame.snapshot->bond_data.groups.end());
         writer.writeIndividual<GroupTagIterator<2>, uint32_t>(desc.getFormattedPath(timestep),
                                                               begin,
                                                               end,
@@ -511,8 +622,8 @@ void GetarDumpWriter::writeIndividual(GTAR::BulkWriter& writer,
         }
     else if (desc.m_prop == BondTypes)
         {
-        vector<unsigned int>::iterator begin(m_systemSnap->bond_data.type_id.begin());
-        vector<unsigned int>::iterator end(m_systemSnap->bond_data.type_id.end());
+        vector<unsigned int>::iterator begin(frame.snapshot->bond_data.type_id.begin());
+        vector<unsigned int>::iterator end(frame.snapshot->bond_data.type_id.end());
         writer.writeIndividual<vector<unsigned int>::iterator, uint32_t>(
             desc.getFormattedPath(timestep),
             begin,
@@ -521,8 +632,8 @@ void GetarDumpWriter::writeIndividual(GTAR::BulkWriter& writer,
         }
     else if (desc.m_prop == Charge)
         {
-        vector<Scalar>::iterator begin(m_systemSnap->particle_data.charge.begin());
-        vector<Scalar>::iterator end(m_systemSnap->particle_data.charge.end());
+        vector<Scalar>::iterator begin(frame.snapshot->particle_data.charge.begin());
+        vector<Scalar>::iterator end(frame.snapshot->particle_data.charge.end());
         writer.writeIndividual<vector<Scalar>::iterator, float>(desc.getFormattedPath(timestep),
                                                                 begin,
                                                                 end,
@@ -530,8 +641,8 @@ void GetarDumpWriter::writeIndividual(GTAR::BulkWriter& writer,
         }
     else if (desc.m_prop == Diameter)
         {
-        vector<Scalar>::iterator begin(m_systemSnap->particle_data.diameter.begin());
-        vector<Scalar>::iterator end(m_systemSnap->particle_data.diameter.end());
+        vector<Scalar>::iterator begin(frame.snapshot->particle_data.diameter.begin());
+        vector<Scalar>::iterator end(frame.snapshot->particle_data.diameter.end());
         writer.writeIndividual<vector<Scalar>::iterator, float>(desc.getFormattedPath(timestep),
                                                                 begin,
                                                                 end,
@@ -539,13 +650,13 @@ void GetarDumpWriter::writeIndividual(GTAR::BulkWriter& writer,
         }
     else if (desc.m_prop == DihedralNames)
         {
-        string json(makeTypeList(m_systemSnap->dihedral_data.type_mapping));
+        string json(makeTypeList(frame.snapshot->dihedral_data.type_mapping));
         writer.writeString(desc.getFormattedPath(timestep), json, desc.m_compression);
         }
     else if (desc.m_prop == DihedralTags)
         {
-        GroupTagIterator<4> begin(m_systemSnap->dihedral_data.groups.begin());
-        GroupTagIterator<4> end(m_systemSnap->dihedral_data.groups.end());
+        GroupTagIterator<4> begin(frame.snapshot->dihedral_data.groups.begin());
+        GroupTagIterator<4> end(frame.snapshot->dihedral_data.groups.end());
         writer.writeIndividual<GroupTagIterator<4>, uint32_t>(desc.getFormattedPath(timestep),
                                                               begin,
                                                               end,
@@ -553,8 +664,8 @@ void GetarDumpWriter::writeIndividual(GTAR::BulkWriter& writer,
         }
     else if (desc.m_prop == DihedralTypes)
         {
-        vector<unsigned int>::iterator begin(m_systemSnap->dihedral_data.type_id.begin());
-        vector<unsigned int>::iterator end(m_systemSnap->dihedral_data.type_id.end());
+        vector<unsigned int>::iterator begin(frame.snapshot->dihedral_data.type_id.begin());
+        vector<unsigned int>::iterator end(frame.snapshot->dihedral_data.type_id.end());
         writer.writeIndividual<vector<unsigned int>::iterator, uint32_t>(
             desc.getFormattedPath(timestep),
             begin,
@@ -564,8 +675,8 @@ void GetarDumpWriter::writeIndividual(GTAR::BulkWriter& writer,
     else if (desc.m_prop == Image)
         {
         typedef Int3xyzIterator<vector<int3>::iterator> iter_t;
-        iter_t begin(m_systemSnap->particle_data.image.begin());
-        iter_t end(m_systemSnap->particle_data.image.end());
+        iter_t begin(frame.snapshot->particle_data.image.begin());
+        iter_t end(frame.snapshot->particle_data.image.end());
         writer.writeIndividual<iter_t, int32_t>(desc.getFormattedPath(timestep),
                                                 begin,
                                                 end,
@@ -573,13 +684,13 @@ void GetarDumpWriter::writeIndividual(GTAR::BulkWriter& writer,
         }
     else if (desc.m_prop == ImproperNames)
         {
-        string json(makeTypeList(m_systemSnap->improper_data.type_mapping));
+        string json(makeTypeList(frame.snapshot->improper_data.type_mapping));
         writer.writeString(desc.getFormattedPath(timestep), json, desc.m_compression);
         }
     else if (desc.m_prop == ImproperTags)
         {
-        GroupTagIterator<4> begin(m_systemSnap->improper_data.groups.begin());
-        GroupTagIterator<4> end(m_systemSnap->improper_data.groups.end());
+        GroupTagIterator<4> begin(frame.snapshot->improper_data.groups.begin());
+        GroupTagIterator<4> end(frame.snapshot->improper_data.groups.end());
         writer.writeIndividual<GroupTagIterator<4>, uint32_t>(desc.getFormattedPath(timestep),
                                                               begin,
                                                               end,
@@ -587,8 +698,8 @@ void GetarDumpWriter::writeIndividual(GTAR::BulkWriter& writer,
         }
     else if (desc.m_prop == ImproperTypes)
         {
-        vector<unsigned int>::iterator begin(m_systemSnap->improper_data.type_id.begin());
-        vector<unsigned int>::iterator end(m_systemSnap->improper_data.type_id.end());
+        vector<unsigned int>::iterator begin(frame.snapshot->improper_data.type_id.begin());
+        vector<unsigned int>::iterator end(frame.snapshot->improper_data.type_id.end());
         writer.writeIndividual<vector<unsigned int>::iterator, uint32_t>(
             desc.getFormattedPath(timestep),
             begin,
@@ -597,13 +708,13 @@ void GetarDumpWriter::writeIndividual(GTAR::BulkWriter& writer,
         }
     else if (desc.m_prop == PairNames)
         {
-        string json(makeTypeList(m_systemSnap->pair_data.type_mapping));
+        string json(makeTypeList(frame.snapshot->pair_data.type_mapping));
         writer.writeString(desc.getFormattedPath(timestep), json, desc.m_compression);
         }
     else if (desc.m_prop == PairTags)
         {
-        GroupTagIterator<2> begin(m_systemSnap->pair_data.groups.begin());
-        GroupTagIterator<2> end(m_systemSnap->pair_data.groups.end());
+        GroupTagIterator<2> begin(frame.snapshot->pair_data.groups.begin());
+        GroupTagIterator<2> end(frame.snapshot->pair_data.groups.end());
         writer.writeIndividual<GroupTagIterator<2>, uint32_t>(desc.getFormattedPath(timestep),
                                                               begin,
                                                               end,
@@ -611,8 +722,8 @@ void GetarDumpWriter::writeIndividual(GTAR::BulkWriter& writer,
         }
     else if (desc.m_prop == PairTypes)
         {
-        vector<unsigned int>::iterator begin(m_systemSnap->pair_data.type_id.begin());
-        vector<unsigned int>::iterator end(m_systemSnap->pair_data.type_id.end());
+        vector<unsigned int>::iterator begin(frame.snapshot->pair_data.type_id.begin());
+        vector<unsigned int>::iterator end(frame.snapshot->pair_data.type_id.end());
         writer.writeIndividual<vector<unsigned int>::iterator, uint32_t>(
             desc.getFormattedPath(timestep),
             begin,
@@ -621,8 +732,8 @@ void GetarDumpWriter::writeIndividual(GTAR::BulkWriter& writer,
         }
     else if (desc.m_prop == Mass)
         {
-        vector<Scalar>::iterator begin(m_systemSnap->particle_data.mass.begin());
-        vector<Scalar>::iterator end(m_systemSnap->particle_data.mass.end());
+        vector<Scalar>::iterator begin(frame.snapshot->particle_data.mass.begin());
+        vector<Scalar>::iterator end(frame.snapshot->particle_data.mass.end());
         writer.writeIndividual<vector<Scalar>::iterator, float>(desc.getFormattedPath(timestep),
                                                                 begin,
                                                                 end,
@@ -631,8 +742,8 @@ void GetarDumpWriter::writeIndividual(GTAR::BulkWriter& writer,
     else if (desc.m_prop == MomentInertia)
         {
         typedef Scalar3xyzIterator<float, vector<vec3<Scalar>>::iterator> iter_t;
-        iter_t begin(m_systemSnap->particle_data.inertia.begin());
-        iter_t end(m_systemSnap->particle_data.inertia.end());
+        iter_t begin(frame.snapshot->particle_data.inertia.begin());
+        iter_t end(frame.snapshot->particle_data.inertia.end());
         writer.writeIndividual<iter_t, float>(desc.getFormattedPath(timestep),
                                               begin,
                                               end,
@@ -643,8 +754,8 @@ void GetarDumpWriter::writeIndividual(GTAR::BulkWriter& writer,
         if (desc.m_highPrecision == false)
             {
             typedef QuatsxyzIterator<float, vector<quat<Scalar>>::iterator> iter_t;
-            iter_t begin(m_systemSnap->particle_data.orientation.begin());
-            iter_t end(m_systemSnap->particle_data.orientation.end());
+            iter_t begin(frame.snapshot->particle_data.orientation.begin());
+            iter_t end(frame.snapshot->particle_data.orientation.end());
             writer.writeIndividual<iter_t, float>(desc.getFormattedPath(timestep),
                                                   begin,
                                                   end,
@@ -653,8 +764,8 @@ void GetarDumpWriter::writeIndividual(GTAR::BulkWriter& writer,
         else
             {
             typedef QuatsxyzIterator<double, vector<quat<Scalar>>::iterator> iter_t;
-            iter_t begin(m_systemSnap->particle_data.orientation.begin());
-            iter_t end(m_systemSnap->particle_data.orientation.end());
+            iter_t begin(frame.snapshot->particle_data.orientation.begin());
+            iter_t end(frame.snapshot->particle_data.orientation.end());
             writer.writeIndividual<iter_t, double>(desc.getFormattedPath(timestep),
                                                    begin,
                                                    end,
@@ -666,8 +777,8 @@ void GetarDumpWriter::writeIndividual(GTAR::BulkWriter& writer,
         if (desc.m_highPrecision == false)
             {
             typedef Scalar3xyzIterator<float, vector<vec3<Scalar>>::iterator> iter_t;
-            iter_t begin(m_systemSnap->particle_data.pos.begin());
-            iter_t end(m_systemSnap->particle_data.pos.end());
+            iter_t begin(frame.snapshot->particle_data.pos.begin());
+            iter_t end(frame.snapshot->particle_data.pos.end());
             writer.writeIndividual<iter_t, float>(desc.getFormattedPath(timestep),
                                                   begin,
                                                   end,
@@ -676,8 +787,8 @@ void GetarDumpWriter::writeIndividual(GTAR::BulkWriter& writer,
         else
             {
             typedef Scalar3xyzIterator<double, vector<vec3<Scalar>>::iterator> iter_t;
-            iter_t begin(m_systemSnap->particle_data.pos.begin());
-            iter_t end(m_systemSnap->particle_data.pos.end());
+            iter_t begin(frame.snapshot->particle_data.pos.begin());
+            iter_t end(frame.snapshot->particle_data.pos.end());
             writer.writeIndividual<iter_t, double>(desc.getFormattedPath(timestep),
                                                    begin,
                                                    end,
@@ -686,21 +797,9 @@ void GetarDumpWriter::writeIndividual(GTAR::BulkWriter& writer,
         }
     else if (desc.m_prop == PotentialEnergy)
         {
-        ArrayHandle<unsigned int> tags(m_pdata->getTags(),
-                                       access_location::host,
-                                       access_mode::read);
-        ArrayHandle<Scalar4> handle(m_pdata->getNetForce(),
-                                    access_location::host,
-                                    access_mode::read);
-        const unsigned int N(m_pdata->getN());
-
-        map<unsigned int, Scalar4> sorted;
-        for (unsigned int i(0); i < N; ++i)
-            sorted[tags.data[i]] = handle.data[i];
-
         typedef Scalar4wIterator<MapValueIterator<unsigned int, Scalar4>> iter_t;
-        iter_t begin(sorted.begin());
-        iter_t end(sorted.end());
+        iter_t begin(frame.netForce.begin());
+        iter_t end(frame.netForce.end());
         writer.writeIndividual<iter_t, float>(desc.getFormattedPath(timestep),
                                               begin,
                                               end,
@@ -708,8 +807,8 @@ void GetarDumpWriter::writeIndividual(GTAR::BulkWriter& writer,
         }
     else if (desc.m_prop == Type)
         {
-        vector<unsigned int>::iterator begin(m_systemSnap->particle_data.type.begin());
-        vector<unsigned int>::iterator end(m_systemSnap->particle_data.type.end());
+        vector<unsigned int>::iterator begin(frame.snapshot->particle_data.type.begin());
+        vector<unsigned int>::iterator end(frame.snapshot->particle_data.type.end());
         writer.writeIndividual<vector<unsigned int>::iterator, uint32_t>(
             desc.getFormattedPath(timestep),
             begin,
@@ -721,8 +820,8 @@ void GetarDumpWriter::writeIndividual(GTAR::BulkWriter& writer,
         if (desc.m_highPrecision == false)
             {
             typedef Scalar3xyzIterator<float, vector<vec3<Scalar>>::iterator> iter_t;
-            iter_t begin(m_systemSnap->particle_data.vel.begin());
-            iter_t end(m_systemSnap->particle_data.vel.end());
+            iter_t begin(frame.snapshot->particle_data.vel.begin());
+            iter_t end(frame.snapshot->particle_data.vel.end());
             writer.writeIndividual<iter_t, float>(desc.getFormattedPath(timestep),
                                                   begin,
                                                   end,
@@ -731,8 +830,8 @@ void GetarDumpWriter::writeIndividual(GTAR::BulkWriter& writer,
         else
             {
             typedef Scalar3xyzIterator<double, vector<vec3<Scalar>>::iterator> iter_t;
-            iter_t begin(m_systemSnap->particle_data.vel.begin());
-            iter_t end(m_systemSnap->particle_data.vel.end());
+            iter_t begin(frame.snapshot->particle_data.vel.begin());
+            iter_t end(frame.snapshot->particle_data.vel.end());
             writer.writeIndividual<iter_t, double>(desc.getFormattedPath(timestep),
                                                    begin,
                                                    end,
@@ -741,21 +840,6 @@ void GetarDumpWriter::writeIndividual(GTAR::BulkWriter& writer,
         }
     else if (desc.m_prop == Virial)
         {
-        ArrayHandle<unsigned int> tags(m_pdata->getTags(),
-                                       access_location::host,
-                                       access_mode::read);
-        ArrayHandle<Scalar> handle(m_pdata->getNetVirial(),
-                                   access_location::host,
-                                   access_mode::read);
-
-        const unsigned int N(m_pdata->getN());
-        size_t virialPitch(m_pdata->getNetVirial().getPitch());
-
-        map<unsigned int, Scalar> sorted[6];
-        for (unsigned int i(0); i < N; ++i)
-            for (unsigned int j(0); j < 6; ++j)
-                sorted[j][tags.data[i]] = handle.data[j * virialPitch + i];
-
         typedef VirialIterator<float, MapValueIterator<unsigned int, Scalar>> iter_t;
         typedef MapValueIterator<unsigned int, Scalar> map_iter_t;
 
@@ -764,8 +848,8 @@ void GetarDumpWriter::writeIndividual(GTAR::BulkWriter& writer,
         map_iter_t ends[6];
         for (unsigned int i(0); i < 6; ++i)
             {
-            begins[i] = map_iter_t(sorted[i].begin());
-            ends[i] = map_iter_t(sorted[i].end());
+            begins[i] = map_iter_t(frame.netVirial[i].begin());
+            ends[i] = map_iter_t(frame.netVirial[i].end());
             }
         iter_t begin(begins);
         iter_t end(ends);
@@ -784,21 +868,22 @@ void GetarDumpWriter::writeIndividual(GTAR::BulkWriter& writer,
     }
 
 void GetarDumpWriter::writeUniform(GTAR::BulkWriter& writer,
+                                   const GetarFrame& frame,
                                    const GetarDumpDescription& desc,
                                    uint64_t timestep)
     {
     if (desc.m_prop == Box)
         {
-        Scalar3 box(m_pdata->getGlobalBox().getL());
+        Scalar3 box(frame.box.getL());
 
         if (desc.m_highPrecision == false)
             {
             float arr[] = {float(box.x),
                            float(box.y),
                            float(box.z),
-                           float(m_pdata->getGlobalBox().getTiltFactorXY()),
-                           float(m_pdata->getGlobalBox().getTiltFactorXZ()),
-                           float(m_pdata->getGlobalBox().getTiltFactorYZ())};
+                           float(frame.box.getTiltFactorXY()),
+                           float(frame.box.getTiltFactorXZ()),
+                           float(frame.box.getTiltFactorYZ())};
             writer.writeIndividual<float*, float>(desc.getFormattedPath(timestep),
                                                   arr,
                                                   &arr[6],
@@ -809,9 +894,9 @@ void GetarDumpWriter::writeUniform(GTAR::BulkWriter& writer,
             double arr[] = {box.x,
                             box.y,
                             box.z,
-                            m_pdata->getGlobalBox().getTiltFactorXY(),
-                            m_pdata->getGlobalBox().getTiltFactorXZ(),
-                            m_pdata->getGlobalBox().getTiltFactorYZ()};
+                            frame.box.getTiltFactorXY(),
+                            frame.box.getTiltFactorXZ(),
+                            frame.box.getTiltFactorYZ()};
             writer.writeIndividual<double*, double>(desc.getFormattedPath(timestep),
                                                     arr,
                                                     &arr[6],
@@ -821,7 +906,7 @@ void GetarDumpWriter::writeUniform(GTAR::BulkWriter& writer,
     else if (desc.m_prop == Dimensions)
         {
         writer.writeUniform<unsigned int>(desc.getFormattedPath(timestep),
-                                          m_systemSnap->dimensions);
+                                          frame.snapshot->dimensions);
         }
     else
         {
@@ -832,37 +917,38 @@ void GetarDumpWriter::writeUniform(GTAR::BulkWriter& writer,
     }
 
 void GetarDumpWriter::writeText(GTAR::BulkWriter& writer,
+                                const GetarFrame& frame,
                                 const GetarDumpDescription& desc,
                                 uint64_t timestep)
     {
     if (desc.m_prop == TypeNames)
         {
-        string json(makeTypeList(m_systemSnap->particle_data.type_mapping));
+        string json(makeTypeList(frame.snapshot->particle_data.type_mapping));
         writer.writeString(desc.getFormattedPath(timestep), json, desc.m_compression);
         }
     else if (desc.m_prop == AngleNames)
         {
-        string json(makeTypeList(m_systemSnap->angle_data.type_mapping));
+        string json(makeTypeList(frame.snapshot->angle_data.type_mapping));
         writer.writeString(desc.getFormattedPath(timestep), json, desc.m_compression);
         }
     else if (desc.m_prop == BondNames)
         {
-        string json(makeTypeList(m_systemSnap->bond_data.type_mapping));
+        string json(makeTypeList(frame.snapshot->bond_data.type_mapping));
         writer.writeString(desc.getFormattedPath(timestep), json, desc.m_compression);
         }
     else if (desc.m_prop == DihedralNames)
         {
-        string json(makeTypeList(m_systemSnap->dihedral_data.type_mapping));
+        string json(makeTypeList(frame.snapshot->dihedral_data.type_mapping));
         writer.writeString(desc.getFormattedPath(timestep), json, desc.m_compression);
         }
     else if (desc.m_prop == ImproperNames)
         {
-        string json(makeTypeList(m_systemSnap->improper_data.type_mapping));
+        string json(makeTypeList(frame.snapshot->improper_data.type_mapping));
         writer.writeString(desc.getFormattedPath(timestep), json, desc.m_compression);
         }
     else if (desc.m_prop == PairNames)
         {
-        string json(makeTypeList(m_systemSnap->pair_data.type_mapping));
+        string json(makeTypeList(frame.snapshot->pair_data.type_mapping));
         writer.writeString(desc.getFormattedPath(timestep), json, desc.m_compression);
         }
     else
@@ -975,7 +1061,11 @@ void GetarDumpWriter::writeStr(const std::string& name,
     // only write on root rank
     if (m_exec_conf->isRoot())
 #endif
+        {
+        // keep the order of the records and do not write while the background thread does
+        flush();
         m_archive->writeString(rec.getPath(), contents, gtar::FastCompress);
+        }
     }
 
 void export_GetarDumpWriter(py::module& m)
@@ -989,7 +1079,14 @@ void export_GetarDumpWriter(py::module& m)
         .def("getPeriod", &GetarDumpWriter::getPeriod)
         .def("setPeriod", &GetarDumpWriter::setPeriod)
         .def("removeDump", &GetarDumpWriter::removeDump)
-        .def("writeStr", &GetarDumpWriter::writeStr);
+        .def("writeStr", &GetarDumpWriter::writeStr)
+        .def("flush", &GetarDumpWriter::flush)
+        .def_property("asynchronous",
+                      &GetarDumpWriter::getAsynchronous,
+                      &GetarDumpWriter::setAsynchronous)
+        .def_property("batch_frames",
+                      &GetarDumpWriter::getBatchFrames,
+                      &GetarDumpWriter::setBatchFrames);
 
     py::enum_<getardump::GetarDumpMode>(m, "GetarDumpMode")
         .value("Overwrite", getardump::Overwrite)
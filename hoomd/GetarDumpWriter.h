@@ -5,6 +5,7 @@
 #define __GETAR_DUMPER_H_
 
 #include "hoomd/Analyzer.h"
+#include "hoomd/BackgroundWriter.h"
 #include "hoomd/GetarDumpIterators.h"
 #include "hoomd/SnapshotSystemData.h"
 #include "hoomd/extern/libgetar/src/GTAR.hpp"
@@ -218,6 +219,26 @@ class GetarDumpDescription
     std::string m_suffix;
     };
 
+/// Everything needed to write the records of one frame, copied from the system when the frame
+/// is staged so that it can be written while the simulation continues
+struct GetarFrame
+    {
+    /// Timestep of the frame
+    uint64_t timestep;
+    /// Records to write at this timestep
+    std::vector<GetarDumpDescription> records;
+    /// Static records to write (one-shot mode only)
+    std::vector<GetarDumpDescription> staticRecords;
+    /// System snapshot taken at this timestep
+    std::shared_ptr<SystemSnapshot> snapshot;
+    /// Net force of each particle, sorted by tag (mutable for MapValueIterator)
+    mutable std::map<unsigned int, Scalar4> netForce;
+    /// Components of the net virial of each particle, sorted by tag
+    mutable std::map<unsigned int, Scalar> netVirial[6];
+    /// Global box
+    BoxDim box;
+    };
+
 /// HOOMD analyzer which periodically dumps a set of properties
 class PYBIND11_EXPORT GetarDumpWriter : public Analyzer
     {
@@ -242,6 +263,27 @@ class PYBIND11_EXPORT GetarDumpWriter : public Analyzer
     /// Close the getar file manually after finalizing any IO
     void close();
 
+    /// Set whether frames are written on a background thread
+    void setAsynchronous(bool asynchronous);
+
+    /// Get whether frames are written on a background thread
+    bool getAsynchronous() const
+        {
+        return m_asynchronous;
+        }
+
+    /// Set the number of frames to buffer before writing them together
+    void setBatchFrames(unsigned int batchFrames);
+
+    /// Get the number of frames to buffer before writing them together
+    unsigned int getBatchFrames() const
+        {
+        return m_batchFrames;
+        }
+
+    /// Write all buffered frames and wait for the background thread to finish
+    virtual void flush();
+
     /// Get needed pdata flags
     virtual PDataFlags getRequestedPDataFlags()
         {
@@ -284,19 +326,34 @@ class PYBIND11_EXPORT GetarDumpWriter : public Analyzer
     void writeStr(const std::string& name, const std::string& contents, uint64_t timestep);
 
     private:
-    /// Write any GetarDumpDescription for the given timestep
-    void write(gtar::GTAR::BulkWriter& writer, const GetarDumpDescription& desc, uint64_t timestep);
-    /// Write an individual GetarDumpDescription for the given timestep
+    /// Copy the data needed by the given records at this timestep into a frame
+    std::shared_ptr<GetarFrame> stageFrame(uint64_t timestep,
+                                           const std::vector<GetarDumpDescription>& records);
+    /// Write the buffered frames, on the background thread in asynchronous mode
+    void submitFrames();
+    /// Write a batch of frames
+    void writeFrames(const std::vector<std::shared_ptr<GetarFrame>>& frames);
+
+    /// Write any GetarDumpDescription of a frame for the given timestep
+    void write(gtar::GTAR::BulkWriter& writer,
+               const GetarFrame& frame,
+               const GetarDumpDescription& desc,
+               uint64_t timestep);
+    /// Write an individual GetarDumpDescription of a frame for the given timestep
     void writeIndividual(gtar::GTAR::BulkWriter& writer,
+                         const GetarFrame& frame,
                          const GetarDumpDescription& desc,
                          uint64_t timestep);
-    /// Write a uniform GetarDumpDescription for the given timestep
+    /// Write a uniform GetarDumpDescription of a frame for the given timestep
     void writeUniform(gtar::GTAR::BulkWriter& writer,
+                      const GetarFrame& frame,
                       const GetarDumpDescription& desc,
                       uint64_t timestep);
-    /// Write a text GetarDumpDescription for the given timestep
-    void
-    writeText(gtar::GTAR::BulkWriter& writer, const GetarDumpDescription& desc, uint64_t timestep);
+    /// Write a text GetarDumpDescription of a frame for the given timestep
+    void writeText(gtar::GTAR::BulkWriter& writer,
+                   const GetarFrame& frame,
+                   const GetarDumpDescription& desc,
+                   uint64_t timestep);
 
     /// File archive interface
     std::shared_ptr<gtar::GTAR> m_archive;
@@ -317,6 +374,15 @@ class PYBIND11_EXPORT GetarDumpWriter : public Analyzer
     std::shared_ptr<SystemSnapshot> m_systemSnap;
     /// Map detailing when we need which snapshots
     NeedSnapshotMap m_neededSnapshots;
+
+    /// True when frames are written on the background thread
+    bool m_asynchronous = false;
+    /// Number of frames to buffer before writing them
+    unsigned int m_batchFrames = 1;
+    /// Frames staged but not yet submitted for writing
+    std::vector<std::shared_ptr<GetarFrame>> m_pendingFrames;
+    /// Background thread that compresses and writes the frames
+    hoomd::detail::BackgroundWriter m_writer;
     };
 
 void export_GetarDumpWriter(pybind11::module& m);
@@ -35,6 +35,9 @@
 #include <memory>
 
 #include "GPUArray.h"
+#ifdef ENABLE_HIP
+#include "GPUPartition.cuh"
+#endif
 #include "MemoryTraceback.h"
 
 #include <cxxabi.h>
@@ -43,18 +46,32 @@
 #include <sstream>
 #include <string>
 #include <type_traits>
+#include <typeinfo>
 #include <unistd.h>
 #include <vector>
 
-#define TAG_ALLOCATION(array)              \
-        {                                  \
-        array.setTag(std::string(#array)); \
+//! Tag an allocation with the name of the owning class and the member
+/*! Must be used inside a member function of the class that owns \a array.
+ */
+#define TAG_ALLOCATION(array)                                                            \
+        {                                                                                \
+        array.setTag(hoomd::detail::demangled_type_name(typeid(*this)) + "::" + #array); \
         }
 
 namespace hoomd
     {
 namespace detail
     {
+//! Get the human readable name of a type
+inline std::string demangled_type_name(const std::type_info& info)
+    {
+    int status;
+    char* realname = abi::__cxa_demangle(info.name(), 0, 0, &status);
+    std::string name = (status == 0) ? std::string(realname) : std::string(info.name());
+    free(realname);
+    return name;
+    }
+
 #ifdef __GNUC__
 #define GCC_VERSION (__GNUC__ * 10000 + __GNUC_MINOR__ * 100 + __GNUC_PATCHLEVEL__)
 /* Test for GCC < 5.0 */
@@ -249,7 +266,10 @@ template<class T> class GlobalArray : public GPUArrayBase<T, GlobalArray<T>>
         {
 #ifndef ALWAYS_USE_MANAGED_MEMORY
         if (!(m_is_managed))
+            {
+            m_fallback.setTag(tag);
             return;
+            }
 #endif
 
         assert(this->m_exec_conf);
@@ -528,6 +548,47 @@ template<class T> class GlobalArray : public GPUArrayBase<T, GlobalArray<T>>
         return m_height;
         }
 
+#ifdef ENABLE_HIP
+    //! Set the preferred location of each GPU's range of elements to that GPU
+    /*! \param gpu_partition Partition of the element indices across the GPUs
+
+        For 2D arrays, the partition applies to every row. Does nothing unless the array is in
+        managed memory and all GPUs support concurrent managed access.
+    */
+    void setPartitionAdvice(const GPUPartition& gpu_partition) const
+        {
+#ifdef __HIP_PLATFORM_NVCC__
+        forEachPartitionRange(gpu_partition,
+                              [](const T* ptr, size_t nbytes, int device)
+                              {
+                                  cudaMemAdvise(ptr,
+                                                nbytes,
+                                                cudaMemAdviseSetPreferredLocation,
+                                                device);
+                              });
+#endif
+        }
+
+    //! Migrate each GPU's range of elements to that GPU
+    /*! \param gpu_partition Partition of the element indices across the GPUs
+
+        The prefetches are queued on the default stream of the destination GPU, so that the data is
+        resident before the next kernel launched on that GPU reads it. Call after the elements have
+        been written on the host or rearranged, to avoid page faults on first touch.
+    */
+    void prefetchPartition(const GPUPartition& gpu_partition) const
+        {
+#ifdef __HIP_PLATFORM_NVCC__
+        forEachPartitionRange(gpu_partition,
+                              [](const T* ptr, size_t nbytes, int device)
+                              {
+                                  hipSetDevice(device);
+                                  cudaMemPrefetchAsync(ptr, nbytes, device);
+                              });
+#endif
+        }
+#endif
+
     //! Resize the GlobalArray
     /*! This method resizes the array by allocating a new array and copying over the elements
         from the old array. Resizing is a slow operation.
@@ -656,6 +717,11 @@ template<class T> class GlobalArray : public GPUArrayBase<T, GlobalArray<T>>
         if (!isNull() && m_data)
             m_data.get_deleter().setTag(tag);
 
+#ifndef ALWAYS_USE_MANAGED_MEMORY
+        // arrays that fall back onto GPUArray are accounted for there
+        m_fallback.setTag(tag);
+#endif
+
         // for debugging
         this->outputRepresentation();
         }
@@ -766,6 +832,36 @@ template<class T> class GlobalArray : public GPUArrayBase<T, GlobalArray<T>>
         m_event; //! CUDA event for synchronization
 #endif
 
+#ifdef ENABLE_HIP
+    //! Call \a f(ptr, nbytes, device) on the elements assigned to each GPU
+    template<class Func>
+    void forEachPartitionRange(const GPUPartition& gpu_partition, Func f) const
+        {
+        if (!this->m_exec_conf || !m_is_managed || isNull()
+            || !this->m_exec_conf->allConcurrentManagedAccess())
+            return;
+
+        auto gpu_map = this->m_exec_conf->getGPUIds();
+
+        int current_device;
+        hipGetDevice(&current_device);
+
+        for (unsigned int idev = 0; idev < gpu_partition.getNumActiveGPUs(); ++idev)
+            {
+            auto range = gpu_partition.getRange(idev);
+            size_t nelem = range.second - range.first;
+
+            if (!nelem)
+                continue;
+
+            for (size_t row = 0; row < m_height; ++row)
+                f(m_data.get() + row * m_pitch + range.first, sizeof(T) * nelem, gpu_map[idev]);
+            }
+
+        hipSetDevice(current_device);
+        }
+#endif
+
     //! Allocate the managed array and construct the items
     void allocate()
         {
@@ -36,6 +36,16 @@ std::string BuildInfo::getCompileFlags()
 #ifdef ENABLE_HPMC_MIXED_PRECISION
     o << "HPMC_MIXED ";
 #endif
+#ifdef ENABLE_MD_MIXED_PRECISION
+    o << "MD_MIXED ";
+#endif
+#ifdef ENABLE_MPCD_MIXED_PRECISION
+    o << "MPCD_MIXED ";
+#endif
+#endif
+
+#ifdef ENABLE_MD_FAST_MATH
+    o << "MD_FAST_MATH ";
 #endif
 
 #ifdef ENABLE_MPI
@@ -50,6 +60,10 @@ std::string BuildInfo::getCompileFlags()
     o << "TBB ";
 #endif
 
+#ifdef ENABLE_ZLIB
+    o << "ZLIB ";
+#endif
+
 #ifdef __SSE__
     o << "SSE ";
 #endif
@@ -163,6 +177,15 @@ bool BuildInfo::getEnableMPI()
 #endif
     }
 
+bool BuildInfo::getEnableZLIB()
+    {
+#ifdef ENABLE_ZLIB
+    return true;
+#else
+    return false;
+#endif
+    }
+
 std::string BuildInfo::getSourceDir()
     {
     return std::string(HOOMD_SOURCE_DIR);
@@ -0,0 +1,299 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file IMDWriter.cc
+    \brief Defines the IMDWriter class
+*/
+
+#include "IMDWriter.h"
+#include "extern/imd.h"
+#include "extern/vmdsock.h"
+
+#ifdef ENABLE_MPI
+#include "HOOMDMPI.h"
+#endif
+
+#include <signal.h>
+#include <stdexcept>
+
+namespace py = pybind11;
+
+using namespace std;
+
+/*! \param sysdef System definition containing particle data to send
+    \param port TCP port to listen on
+    \param group Group of particles to send
+*/
+IMDWriter::IMDWriter(std::shared_ptr<SystemDefinition> sysdef,
+                     int port,
+                     std::shared_ptr<ParticleGroup> group)
+    : Analyzer(sysdef), m_port(port), m_group(group), m_listen_sock(nullptr),
+      m_client_sock(nullptr), m_trate(1), m_count(0), m_send_failed(false), m_frames_sent(0),
+      m_frames_dropped(0), m_sender(1)
+    {
+    m_exec_conf->msg->notice(5) << "Constructing IMDWriter: " << port << endl;
+
+    if (port <= 0 || port > 65535)
+        {
+        throw runtime_error("IMD: port must be in the range 1 to 65535");
+        }
+
+    // only the root rank listens for clients
+    if (!m_exec_conf->isRoot())
+        return;
+
+    vmdsock_init();
+    m_listen_sock = vmdsock_create();
+    if (!m_listen_sock || vmdsock_bind(m_listen_sock, m_port) != 0
+        || vmdsock_listen(m_listen_sock) != 0)
+        {
+        if (m_listen_sock)
+            vmdsock_destroy(m_listen_sock);
+        m_listen_sock = nullptr;
+        throw runtime_error("IMD: unable to listen on port " + to_string(port));
+        }
+
+    m_exec_conf->msg->notice(2) << "IMD: listening on port " << m_port << endl;
+    }
+
+IMDWriter::~IMDWriter()
+    {
+    m_exec_conf->msg->notice(5) << "Destroying IMDWriter" << endl;
+
+    m_sender.stop();
+    if (m_client_sock)
+        vmdsock_destroy(m_client_sock);
+    if (m_listen_sock)
+        vmdsock_destroy(m_listen_sock);
+    }
+
+/*! \param timestep Current time step of the simulation
+ */
+void IMDWriter::analyze(uint64_t timestep)
+    {
+    Analyzer::analyze(timestep);
+    if (m_prof)
+        m_prof->push("IMD");
+
+    // decide on the root rank whether to send a frame
+    bool send = false;
+    if (m_exec_conf->isRoot())
+        {
+        if (m_send_failed)
+            {
+            m_exec_conf->msg->notice(2) << "IMD: lost the connection to the client" << endl;
+            closeClient();
+            }
+
+        if (!m_client_sock)
+            acceptClient();
+
+        if (m_client_sock)
+            processMessages();
+
+        if (m_client_sock && m_count++ % m_trate == 0)
+            {
+            // drop the frame while the previous one is still being sent
+            if (m_sender.full())
+                m_frames_dropped++;
+            else
+                send = true;
+            }
+        }
+
+#ifdef ENABLE_MPI
+    if (m_comm)
+        bcast(send, 0, m_exec_conf->getMPICommunicator());
+#endif
+
+    if (send)
+        {
+        auto coords = std::make_shared<std::vector<float>>();
+        packFrame(*coords);
+
+        if (m_exec_conf->isRoot())
+            {
+            void* sock = m_client_sock;
+            const int32 n = int32(m_group->getNumMembersGlobal());
+            m_sender.enqueue(
+                [this, sock, n, coords]()
+                {
+                    // report a closed connection as an error instead of raising SIGPIPE
+                    sigset_t set;
+                    sigemptyset(&set);
+                    sigaddset(&set, SIGPIPE);
+                    pthread_sigmask(SIG_BLOCK, &set, nullptr);
+
+                    if (imd_send_fcoords(sock, n, coords->data()) != 0)
+                        m_send_failed = true;
+                    else
+                        m_frames_sent++;
+                });
+            }
+        }
+
+    if (m_prof)
+        m_prof->pop();
+    }
+
+/*! Accept a waiting client and perform the IMD handshake. The client must send IMD_GO to start.
+ */
+void IMDWriter::acceptClient()
+    {
+    if (vmdsock_selread(m_listen_sock, 0) <= 0)
+        return;
+
+    void* sock = vmdsock_accept(m_listen_sock);
+    if (!sock)
+        return;
+
+    int32 length;
+    if (imd_handshake(sock) != 0 || vmdsock_selread(sock, 1) != 1
+        || imd_recv_header(sock, &length) != IMD_GO)
+        {
+        m_exec_conf->msg->notice(2) << "IMD: client failed the handshake" << endl;
+        vmdsock_destroy(sock);
+        return;
+        }
+
+    m_exec_conf->msg->notice(2) << "IMD: client connected on port " << m_port << endl;
+    m_client_sock = sock;
+    m_trate = 1;
+    m_count = 0;
+    }
+
+/*! Handle all messages waiting on the client socket. While the client has paused the simulation,
+    block until it resumes or disconnects.
+*/
+void IMDWriter::processMessages()
+    {
+    bool paused = false;
+    while (m_client_sock)
+        {
+        const int ready = vmdsock_selread(m_client_sock, paused ? 1 : 0);
+        if (ready < 0)
+            {
+            m_exec_conf->msg->notice(2) << "IMD: lost the connection to the client" << endl;
+            closeClient();
+            break;
+            }
+        if (ready == 0)
+            {
+            if (paused)
+                continue;
+            break;
+            }
+
+        int32 length;
+        switch (imd_recv_header(m_client_sock, &length))
+            {
+        case IMD_DISCONNECT:
+            m_exec_conf->msg->notice(2) << "IMD: client disconnected" << endl;
+            closeClient();
+            break;
+        case IMD_KILL:
+            m_exec_conf->msg->notice(2) << "IMD: ignoring kill request, disconnecting" << endl;
+            closeClient();
+            break;
+        case IMD_PAUSE:
+            paused = !paused;
+            break;
+        case IMD_TRATE:
+            m_trate = length > 0 ? (unsigned int)length : 1;
+            m_count = 0;
+            break;
+        case IMD_MDCOMM:
+            {
+            // forces are not applied, read and discard them
+            std::vector<int32> indices(length);
+            std::vector<float> forces(3 * size_t(length));
+            if (imd_recv_mdcomm(m_client_sock, length, indices.data(), forces.data()) != 0)
+                closeClient();
+            break;
+            }
+        case IMD_IOERROR:
+            m_exec_conf->msg->notice(2) << "IMD: lost the connection to the client" << endl;
+            closeClient();
+            break;
+        default:
+            break;
+            }
+        }
+    }
+
+/*! Wait for the frame in flight, then close the socket.
+ */
+void IMDWriter::closeClient()
+    {
+    m_sender.flush();
+    vmdsock_destroy(m_client_sock);
+    m_client_sock = nullptr;
+    m_send_failed = false;
+    }
+
+/*! \param coords Coordinates x0 y0 z0 x1 ... of the group members in tag order
+
+    Without a domain decomposition, the coordinates are read directly from the particle data arrays.
+    Otherwise, a particle data snapshot is gathered and the coordinates are packed on the root rank
+    only.
+*/
+void IMDWriter::packFrame(std::vector<float>& coords)
+    {
+    const BoxDim box = m_pdata->getGlobalBox();
+    const unsigned int nparticles = m_group->getNumMembersGlobal();
+
+#ifdef ENABLE_MPI
+    if (m_comm)
+        {
+        SnapshotParticleData<Scalar> snapshot;
+        m_pdata->takeSnapshot(snapshot);
+
+        if (!m_exec_conf->isRoot())
+            return;
+
+        coords.resize(3 * size_t(nparticles));
+        for (unsigned int group_idx = 0; group_idx < nparticles; group_idx++)
+            {
+            const vec3<Scalar> pos = snapshot.pos[m_group->getMemberTag(group_idx)];
+            coords[3 * group_idx] = float(pos.x);
+            coords[3 * group_idx + 1] = float(pos.y);
+            coords[3 * group_idx + 2] = float(pos.z);
+            }
+        return;
+        }
+#endif
+
+    ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
+    ArrayHandle<int3> h_image(m_pdata->getImages(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::read);
+
+    // positions relative to the origin, as in a snapshot
+    const Scalar3 origin = m_pdata->getOrigin();
+    const int3 o_image = m_pdata->getOriginImage();
+
+    coords.resize(3 * size_t(nparticles));
+    for (unsigned int group_idx = 0; group_idx < nparticles; group_idx++)
+        {
+        const unsigned int idx = h_rtag.data[m_group->getMemberTag(group_idx)];
+        Scalar3 pos
+            = make_scalar3(h_pos.data[idx].x, h_pos.data[idx].y, h_pos.data[idx].z) - origin;
+        int3 img = make_int3(h_image.data[idx].x - o_image.x,
+                             h_image.data[idx].y - o_image.y,
+                             h_image.data[idx].z - o_image.z);
+        box.wrap(pos, img);
+
+        coords[3 * group_idx] = float(pos.x);
+        coords[3 * group_idx + 1] = float(pos.y);
+        coords[3 * group_idx + 2] = float(pos.z);
+        }
+    }
+
+void export_IMDWriter(py::module& m)
+    {
+    py::class_<IMDWriter, Analyzer, std::shared_ptr<IMDWriter>>(m, "IMDWriter")
+        .def(py::init<std::shared_ptr<SystemDefinition>, int, std::shared_ptr<ParticleGroup>>())
+        .def_property_readonly("port", &IMDWriter::getPort)
+        .def_property_readonly("frames_sent", &IMDWriter::getFramesSent)
+        .def_property_readonly("frames_dropped", &IMDWriter::getFramesDropped)
+        .def_property_readonly("connected", &IMDWriter::isConnected);
+    }
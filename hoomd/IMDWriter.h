@@ -0,0 +1,108 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#ifndef __IMDWRITER_H__
+#define __IMDWRITER_H__
+
+#include "Analyzer.h"
+#include "BackgroundWriter.h"
+#include "ParticleGroup.h"
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+/*! \file IMDWriter.h
+    \brief Declares the IMDWriter class
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include <pybind11/pybind11.h>
+
+//! Analyzer that streams coordinates to a client over the IMD protocol
+/*! IMDWriter listens on a TCP port for a client that speaks the interactive molecular dynamics
+    (IMD) protocol, such as VMD. Only one client is connected at a time. Each call to analyze()
+    accepts a waiting client, processes the messages sent by the client, and sends the coordinates
+    of the group members in tag order when a client is connected. Nothing is gathered or packed
+    while no client is connected.
+
+    Frames are sent on a background thread so that a slow client does not stall the simulation. At
+    most one frame is in flight: when the previous frame has not been sent yet, the current frame
+    is dropped. The client can request a transmission rate (IMD_TRATE), in which case only every
+    rate-th call to analyze() sends a frame. IMD_PAUSE blocks analyze() until the client resumes or
+    disconnects. IMD_KILL is treated as a disconnect, and forces sent by the client are ignored.
+
+    The socket lives on the root rank. With a domain decomposition, the root rank broadcasts the
+    decision to send a frame and the coordinates are gathered on the root rank.
+    \ingroup analyzers
+*/
+class PYBIND11_EXPORT IMDWriter : public Analyzer
+    {
+    public:
+    //! Construct the writer and listen on the port
+    IMDWriter(std::shared_ptr<SystemDefinition> sysdef,
+              int port,
+              std::shared_ptr<ParticleGroup> group);
+
+    //! Destructor
+    ~IMDWriter();
+
+    //! Serve the client and send the current coordinates
+    void analyze(uint64_t timestep);
+
+    //! Get the port to listen on
+    int getPort() const
+        {
+        return m_port;
+        }
+
+    //! Get the number of frames sent to clients
+    uint64_t getFramesSent() const
+        {
+        return m_frames_sent;
+        }
+
+    //! Get the number of frames dropped because the previous frame was still being sent
+    uint64_t getFramesDropped() const
+        {
+        return m_frames_dropped;
+        }
+
+    //! Test if a client is connected
+    bool isConnected() const
+        {
+        return m_client_sock != nullptr;
+        }
+
+    private:
+    int m_port;                               //!< Port to listen on
+    std::shared_ptr<ParticleGroup> m_group;   //!< Particles to send
+    void* m_listen_sock;                      //!< Socket listening for clients
+    void* m_client_sock;                      //!< Socket connected to the client
+    unsigned int m_trate;                     //!< Send every m_trate calls to analyze()
+    uint64_t m_count;                         //!< Calls to analyze() since the client connected
+    std::atomic<bool> m_send_failed;          //!< Set when a send on the background thread fails
+    std::atomic<uint64_t> m_frames_sent;      //!< Number of frames sent
+    uint64_t m_frames_dropped;                //!< Number of frames dropped
+    hoomd::detail::BackgroundWriter m_sender; //!< Sends frames on a background thread
+
+    //! Accept a waiting client
+    void acceptClient();
+
+    //! Process the messages sent by the client
+    void processMessages();
+
+    //! Close the connection to the client
+    void closeClient();
+
+    //! Pack the coordinates of the group members
+    void packFrame(std::vector<float>& coords);
+    };
+
+//! Exports the IMDWriter class to python
+void export_IMDWriter(pybind11::module& m);
+
+#endif
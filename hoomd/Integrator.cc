@@ -13,6 +13,12 @@ namespace py = pybind11;
 #include "Communicator.h"
 #endif
 
+#ifdef ENABLE_TBB
+#include <tbb/task_group.h>
+#endif
+
+#include <algorithm>
+#include <map>
 #include <pybind11/stl_bind.h>
 PYBIND11_MAKE_OPAQUE(std::vector<std::shared_ptr<ForceConstraint>>);
 PYBIND11_MAKE_OPAQUE(std::vector<std::shared_ptr<ForceCompute>>);
@@ -40,6 +46,10 @@ Integrator::~Integrator()
     if (m_signals_connected && m_comm)
         m_comm->getComputeCallbackSignal().disconnect<Integrator, &Integrator::computeCallback>(
             this);
+#endif
+#ifdef ENABLE_HIP
+    for (auto stream : m_force_streams)
+        hipStreamDestroy(stream);
 #endif
     }
 
@@ -75,9 +85,41 @@ void Integrator::setDeltaT(Scalar deltaT)
         constraint_force->setDeltaT(deltaT);
         }
 
+    for (auto& force : m_outer_forces)
+        {
+        force->setDeltaT(deltaT);
+        }
+
     m_deltaT = deltaT;
     }
 
+/** @param outer_period Number of time steps between evaluations of the outer forces
+ */
+void Integrator::setOuterPeriod(unsigned int outer_period)
+    {
+    if (outer_period == 0)
+        throw std::domain_error("outer_period must be positive");
+
+    m_outer_period = outer_period;
+    }
+
+/** @param elide_force_arrays Set to true to compute supporting forces into shared arrays
+
+    Disabling the mode frees the shared arrays. Forces that have released their arrays allocate
+    them again the next time they are computed.
+*/
+void Integrator::setElideForceArrays(bool elide_force_arrays)
+    {
+    m_elide_force_arrays = elide_force_arrays;
+    if (!m_elide_force_arrays)
+        {
+        GlobalArray<Scalar4> shared_force;
+        GlobalArray<Scalar> shared_virial;
+        m_shared_force.swap(shared_force);
+        m_shared_virial.swap(shared_virial);
+        }
+    }
+
 /** \return the timestep deltaT
  */
 Scalar Integrator::getDeltaT()
@@ -197,12 +239,217 @@ Scalar Integrator::computeTotalMomentum(uint64_t timestep)
    of data traffic back and forth if the forces and/or integrator are on the GPU. Call
    computeNetForcesGPU() to sum the forces on the GPU
 */
+/*! \param forces Forces to compute
+    \param timestep Current time step
+
+    Forces that do not support concurrent computation are computed first, in order. The remaining
+    forces are then grouped by the compute they depend on (forces that share a neighbor list form
+    one group) and the groups execute as concurrent tasks. Each force writes to its own arrays,
+    which computeNetForce() sums afterwards. Forces are computed in order when running on a single
+    thread, when profiling, and with a domain decomposition, where neighbor lists communicate.
+*/
+void Integrator::computeForcesCPU(const std::vector<std::shared_ptr<ForceCompute>>& forces,
+                                  uint64_t timestep)
+    {
+#ifdef ENABLE_TBB
+    bool concurrent = m_exec_conf->getNumThreads() > 1 && !m_prof && forces.size() > 1;
+#ifdef ENABLE_MPI
+    concurrent = concurrent && !m_pdata->getDomainDecomposition();
+#endif
+
+    if (concurrent)
+        {
+        std::vector<std::vector<std::shared_ptr<ForceCompute>>> groups;
+        std::map<std::shared_ptr<Compute>, size_t> group_index;
+        for (auto& force : forces)
+            {
+            if (!force->supportsConcurrentCompute())
+                {
+                force->compute(timestep);
+                continue;
+                }
+
+            std::shared_ptr<Compute> dependency = force->getComputeDependency();
+            if (dependency && group_index.count(dependency))
+                {
+                groups[group_index[dependency]].push_back(force);
+                continue;
+                }
+
+            if (dependency)
+                group_index[dependency] = groups.size();
+            groups.push_back(std::vector<std::shared_ptr<ForceCompute>>(1, force));
+            }
+
+        m_exec_conf->getTaskArena()->execute(
+            [&]
+            {
+                tbb::task_group tasks;
+                for (auto& group : groups)
+                    {
+                    tasks.run(
+                        [&group, timestep]
+                        {
+                            for (auto& force : group)
+                                force->compute(timestep);
+                        });
+                    }
+                tasks.wait();
+            });
+        return;
+        }
+#endif
+
+    for (auto& force : forces)
+        {
+        force->compute(timestep);
+        }
+    }
+
+/*! \param force Force to check
+    \returns true when \a force computes into the shared arrays at this step
+
+    Forces keep arrays of their own once their forces are requested outside of the integrator.
+    All forces keep their arrays with a domain decomposition, where pair forces may start computing
+    while the ghost particles are communicated, and on multiple GPUs, where the arrays carry memory
+    hints for each GPU.
+*/
+bool Integrator::elideForceArrays(const std::shared_ptr<ForceCompute>& force)
+    {
+    if (!m_elide_force_arrays || !force->supportsElidedForceArrays()
+        || force->getKeepForceArrays())
+        return false;
+
+#ifdef ENABLE_MPI
+    if (m_pdata->getDomainDecomposition())
+        return false;
+#endif
+
+    return m_exec_conf->getNumActiveGPUs() <= 1;
+    }
+
+/*! \param force Force with elided arrays
+    \param timestep Current time step
+
+    \post \a force holds the shared arrays and its result, the caller swaps them back after adding
+    the result to the net force.
+*/
+void Integrator::computeElidedForce(const std::shared_ptr<ForceCompute>& force, uint64_t timestep)
+    {
+    unsigned int max_n = m_pdata->getMaxN();
+    if (m_shared_force.getNumElements() < max_n)
+        {
+        GlobalArray<Scalar4> shared_force(max_n, m_exec_conf);
+        GlobalArray<Scalar> shared_virial(max_n, 6, m_exec_conf);
+        m_shared_force.swap(shared_force);
+        TAG_ALLOCATION(m_shared_force);
+        m_shared_virial.swap(shared_virial);
+        TAG_ALLOCATION(m_shared_virial);
+
+        // entries that a force does not write (ghosts) must not add to the net force
+        ArrayHandle<Scalar4> h_force(m_shared_force, access_location::host, access_mode::overwrite);
+        ArrayHandle<Scalar> h_virial(m_shared_virial,
+                                     access_location::host,
+                                     access_mode::overwrite);
+        memset(h_force.data, 0, sizeof(Scalar4) * m_shared_force.getNumElements());
+        memset(h_virial.data, 0, sizeof(Scalar) * m_shared_virial.getNumElements());
+        }
+
+    if (!force->getForceArray().isNull())
+        force->releaseForceArrays();
+
+    // the shared arrays hold the result of another force, compute even when this force has
+    // already been computed at this time step
+    force->swapForceArrays(m_shared_force, m_shared_virial);
+    force->forceCompute(timestep);
+    }
+
+/*! \param force Force with elided arrays
+    \param scale Factor applied to the force and torque
+    \param timestep Current time step
+    \param external_virial External virial to add to
+    \param external_energy External energy to add to
+
+    Computes \a force into the shared arrays and adds the result to the net force, torque, and
+    virial, which already hold the sum of the other forces. Energies and virials are not scaled.
+*/
+void Integrator::addElidedForceCPU(const std::shared_ptr<ForceCompute>& force,
+                                   Scalar scale,
+                                   uint64_t timestep,
+                                   Scalar* external_virial,
+                                   Scalar& external_energy)
+    {
+    computeElidedForce(force, timestep);
+
+        {
+        const GlobalArray<Scalar>& net_virial = m_pdata->getNetVirial();
+        ArrayHandle<Scalar4> h_net_force(m_pdata->getNetForce(),
+                                         access_location::host,
+                                         access_mode::readwrite);
+        ArrayHandle<Scalar> h_net_virial(net_virial, access_location::host, access_mode::readwrite);
+        ArrayHandle<Scalar4> h_net_torque(m_pdata->getNetTorqueArray(),
+                                          access_location::host,
+                                          access_mode::readwrite);
+
+        GlobalArray<Scalar>& h_virial_array = force->getVirialArray();
+        ArrayHandle<Scalar4> h_force(force->getForceArray(),
+                                     access_location::host,
+                                     access_mode::read);
+        ArrayHandle<Scalar> h_virial(h_virial_array, access_location::host, access_mode::read);
+        ArrayHandle<Scalar4> h_torque(force->getTorqueArray(),
+                                      access_location::host,
+                                      access_mode::read);
+
+        // the virial is only written when the pressure tensor is requested
+        bool compute_virial = m_pdata->getFlags()[pdata_flag::pressure_tensor];
+        unsigned int nparticles = m_pdata->getN() + m_pdata->getNGhosts();
+        size_t net_virial_pitch = net_virial.getPitch();
+        size_t virial_pitch = h_virial_array.getPitch();
+        for (unsigned int j = 0; j < nparticles; j++)
+            {
+            h_net_force.data[j].x += scale * h_force.data[j].x;
+            h_net_force.data[j].y += scale * h_force.data[j].y;
+            h_net_force.data[j].z += scale * h_force.data[j].z;
+            h_net_force.data[j].w += h_force.data[j].w;
+
+            h_net_torque.data[j].x += scale * h_torque.data[j].x;
+            h_net_torque.data[j].y += scale * h_torque.data[j].y;
+            h_net_torque.data[j].z += scale * h_torque.data[j].z;
+            h_net_torque.data[j].w += h_torque.data[j].w;
+
+            for (unsigned int k = 0; compute_virial && k < 6; k++)
+                {
+                h_net_virial.data[k * net_virial_pitch + j] += h_virial.data[k * virial_pitch + j];
+                }
+            }
+        }
+
+    force->swapForceArrays(m_shared_force, m_shared_virial);
+
+    for (unsigned int k = 0; k < 6; k++)
+        {
+        external_virial[k] += force->getExternalVirial(k);
+        }
+
+    external_energy += force->getExternalEnergy();
+    }
+
 void Integrator::computeNetForce(uint64_t timestep)
     {
+    // forces with elided arrays are computed and summed one at a time after the others
+    bool outer_step = isOuterStep(timestep);
+    std::vector<std::shared_ptr<ForceCompute>> forces;
     for (auto& force : m_forces)
         {
-        force->compute(timestep);
+        if (!elideForceArrays(force))
+            forces.push_back(force);
+        }
+    for (auto& force : m_outer_forces)
+        {
+        if (outer_step && !elideForceArrays(force))
+            forces.push_back(force);
         }
+    computeForcesCPU(forces, timestep);
 
     if (m_prof)
         {
@@ -244,6 +491,9 @@ void Integrator::computeNetForce(uint64_t timestep)
 
         for (const auto& force : m_forces)
             {
+            if (elideForceArrays(force))
+                continue;
+
             GlobalArray<Scalar4>& h_force_array = force->getForceArray();
             GlobalArray<Scalar>& h_virial_array = force->getVirialArray();
             GlobalArray<Scalar4>& h_torque_array = force->getTorqueArray();
@@ -283,6 +533,71 @@ void Integrator::computeNetForce(uint64_t timestep)
 
             external_energy += force->getExternalEnergy();
             }
+
+        // apply the outer forces as an impulse, their energies and virials are not scaled
+        for (const auto& force : m_outer_forces)
+            {
+            if (!outer_step)
+                break;
+            if (elideForceArrays(force))
+                continue;
+
+            GlobalArray<Scalar4>& h_force_array = force->getForceArray();
+            GlobalArray<Scalar>& h_virial_array = force->getVirialArray();
+            GlobalArray<Scalar4>& h_torque_array = force->getTorqueArray();
+
+            assert(nparticles <= h_force_array.getNumElements());
+            assert(6 * nparticles <= h_virial_array.getNumElements());
+            assert(nparticles <= h_torque_array.getNumElements());
+
+            ArrayHandle<Scalar4> h_force(h_force_array, access_location::host, access_mode::read);
+            ArrayHandle<Scalar> h_virial(h_virial_array, access_location::host, access_mode::read);
+            ArrayHandle<Scalar4> h_torque(h_torque_array, access_location::host, access_mode::read);
+
+            Scalar scale = Scalar(m_outer_period);
+            size_t virial_pitch = h_virial_array.getPitch();
+            for (unsigned int j = 0; j < nparticles; j++)
+                {
+                h_net_force.data[j].x += scale * h_force.data[j].x;
+                h_net_force.data[j].y += scale * h_force.data[j].y;
+                h_net_force.data[j].z += scale * h_force.data[j].z;
+                h_net_force.data[j].w += h_force.data[j].w;
+
+                h_net_torque.data[j].x += scale * h_torque.data[j].x;
+                h_net_torque.data[j].y += scale * h_torque.data[j].y;
+                h_net_torque.data[j].z += scale * h_torque.data[j].z;
+                h_net_torque.data[j].w += h_torque.data[j].w;
+
+                for (unsigned int k = 0; k < 6; k++)
+                    {
+                    h_net_virial.data[k * net_virial_pitch + j]
+                        += h_virial.data[k * virial_pitch + j];
+                    }
+                }
+
+            for (unsigned int k = 0; k < 6; k++)
+                {
+                external_virial[k] += force->getExternalVirial(k);
+                }
+
+            external_energy += force->getExternalEnergy();
+            }
+        }
+
+    for (const auto& force : m_forces)
+        {
+        if (elideForceArrays(force))
+            addElidedForceCPU(force, Scalar(1.0), timestep, external_virial, external_energy);
+        }
+
+    for (const auto& force : m_outer_forces)
+        {
+        if (outer_step && elideForceArrays(force))
+            addElidedForceCPU(force,
+                              Scalar(m_outer_period),
+                              timestep,
+                              external_virial,
+                              external_energy);
         }
 
     for (unsigned int k = 0; k < 6; k++)
@@ -399,6 +714,120 @@ void Integrator::computeNetForce(uint64_t timestep)
     \post All added force computes in \a m_forces are computed and totaled up in \a m_net_force and
    \a m_net_virial \note The summation step is performed <b>on the GPU</b>.
 */
+/*! \param forces Forces to compute
+    \param timestep Current time step
+
+    Forces that support streams are computed first, each on its own non-blocking stream, so that
+    their kernels execute concurrently with the kernels of the remaining forces on the default
+    stream. The default stream waits for all streams before returning, so later work (the net force
+    sum in particular) sees the complete results. Streams are only used on a single GPU.
+*/
+void Integrator::computeForcesGPU(const std::vector<std::shared_ptr<ForceCompute>>& forces,
+                                  uint64_t timestep)
+    {
+    std::vector<std::shared_ptr<ForceCompute>> stream_forces;
+    if (m_exec_conf->getNumActiveGPUs() == 1 && forces.size() > 1)
+        {
+        for (auto& force : forces)
+            {
+            if (force->supportsStreams())
+                stream_forces.push_back(force);
+            }
+        }
+
+    while (m_force_streams.size() < stream_forces.size())
+        {
+        hipStream_t stream;
+        hipStreamCreateWithFlags(&stream, hipStreamNonBlocking);
+        m_force_streams.push_back(stream);
+        }
+
+    for (size_t i = 0; i < stream_forces.size(); ++i)
+        {
+        stream_forces[i]->setStream(m_force_streams[i]);
+        stream_forces[i]->compute(timestep);
+        }
+
+    for (auto& force : forces)
+        {
+        if (std::find(stream_forces.begin(), stream_forces.end(), force) == stream_forces.end())
+            force->compute(timestep);
+        }
+
+    for (auto& force : stream_forces)
+        {
+        force->joinStream();
+        force->setStream(0);
+        }
+
+    if (m_exec_conf->isCUDAErrorCheckingEnabled())
+        CHECK_CUDA_ERROR();
+    }
+
+/*! \param force Force with elided arrays
+    \param scale Factor applied to the force and torque
+    \param timestep Current time step
+
+    Computes \a force into the shared arrays and adds the result to the net force, torque, and
+    virial on the GPU, which already hold the sum of the other forces.
+*/
+void Integrator::addElidedForceGPU(const std::shared_ptr<ForceCompute>& force,
+                                   Scalar scale,
+                                   uint64_t timestep)
+    {
+    computeElidedForce(force, timestep);
+
+        {
+        const GlobalArray<Scalar>& net_virial = m_pdata->getNetVirial();
+        ArrayHandle<Scalar4> d_net_force(m_pdata->getNetForce(),
+                                         access_location::device,
+                                         access_mode::readwrite);
+        ArrayHandle<Scalar> d_net_virial(net_virial,
+                                         access_location::device,
+                                         access_mode::readwrite);
+        ArrayHandle<Scalar4> d_net_torque(m_pdata->getNetTorqueArray(),
+                                          access_location::device,
+                                          access_mode::readwrite);
+
+        const GlobalArray<Scalar>& d_virial_array = force->getVirialArray();
+        ArrayHandle<Scalar4> d_force(force->getForceArray(),
+                                     access_location::device,
+                                     access_mode::read);
+        ArrayHandle<Scalar> d_virial(d_virial_array, access_location::device, access_mode::read);
+        ArrayHandle<Scalar4> d_torque(force->getTorqueArray(),
+                                      access_location::device,
+                                      access_mode::read);
+
+        gpu_force_list force_list;
+        force_list.f0 = d_force.data;
+        force_list.v0 = d_virial.data;
+        force_list.vpitch0 = d_virial_array.getPitch();
+        force_list.t0 = d_torque.data;
+
+        PDataFlags flags = this->m_pdata->getFlags();
+
+        m_exec_conf->beginMultiGPU();
+
+        gpu_integrator_sum_net_force(d_net_force.data,
+                                     d_net_virial.data,
+                                     net_virial.getPitch(),
+                                     d_net_torque.data,
+                                     force_list,
+                                     m_pdata->getN() + m_pdata->getNGhosts(),
+                                     false,
+                                     flags[pdata_flag::pressure_tensor],
+                                     m_pdata->getGPUPartition(),
+                                     scale);
+
+        if (m_exec_conf->isCUDAErrorCheckingEnabled())
+            CHECK_CUDA_ERROR();
+
+        m_exec_conf->endMultiGPU();
+        }
+
+    force->swapForceArrays(m_shared_force, m_shared_virial);
+    }
+
 void Integrator::computeNetForceGPU(uint64_t timestep)
     {
     if (!m_exec_conf->isCUDAEnabled())
@@ -408,12 +837,22 @@ void Integrator::computeNetForceGPU(uint64_t timestep)
         throw runtime_error("Error computing accelerations");
         }
 
-    // compute all the normal forces first
-
+    // compute all the normal forces first, forces with elided arrays are computed and summed one
+    // at a time after the others
+    bool outer_step = isOuterStep(timestep);
+    std::vector<std::shared_ptr<ForceCompute>> forces;
     for (auto& force : m_forces)
         {
-        force->compute(timestep);
+        if (!elideForceArrays(force))
+            forces.push_back(force);
+        }
+    std::vector<std::shared_ptr<ForceCompute>> compute_forces(forces);
+    for (auto& force : m_outer_forces)
+        {
+        if (outer_step && !elideForceArrays(force))
+            compute_forces.push_back(force);
         }
+    computeForcesGPU(compute_forces, timestep);
 
     if (m_prof)
         {
@@ -456,7 +895,7 @@ void Integrator::computeNetForceGPU(uint64_t timestep)
         // there is no need to zero out the initial net force and virial here, the first call to the
         // addition kernel will do that ahh!, but we do need to zer out the net force and virial if
         // there are 0 forces!
-        if (m_forces.size() == 0)
+        if (forces.size() == 0)
             {
             // start by zeroing the net force and virial arrays
             hipMemset(d_net_force.data, 0, sizeof(Scalar4) * net_force.getNumElements());
@@ -469,20 +908,20 @@ void Integrator::computeNetForceGPU(uint64_t timestep)
         // now, add up the accelerations
         // sum all the forces into the net force
         // perform the sum in groups of 6 to avoid kernel launch and memory access overheads
-        for (unsigned int cur_force = 0; cur_force < m_forces.size(); cur_force += 6)
+        for (unsigned int cur_force = 0; cur_force < forces.size(); cur_force += 6)
             {
             // grab the device pointers for the current set
             gpu_force_list force_list;
 
-            const GlobalArray<Scalar4>& d_force_array0 = m_forces[cur_force]->getForceArray();
+            const GlobalArray<Scalar4>& d_force_array0 = forces[cur_force]->getForceArray();
             ArrayHandle<Scalar4> d_force0(d_force_array0,
                                           access_location::device,
                                           access_mode::read);
-            const GlobalArray<Scalar>& d_virial_array0 = m_forces[cur_force]->getVirialArray();
+            const GlobalArray<Scalar>& d_virial_array0 = forces[cur_force]->getVirialArray();
             ArrayHandle<Scalar> d_virial0(d_virial_array0,
                                           access_location::device,
                                           access_mode::read);
-            const GlobalArray<Scalar4>& d_torque_array0 = m_forces[cur_force]->getTorqueArray();
+            const GlobalArray<Scalar4>& d_torque_array0 = forces[cur_force]->getTorqueArray();
             ArrayHandle<Scalar4> d_torque0(d_torque_array0,
                                            access_location::device,
                                            access_mode::read);
@@ -491,20 +930,20 @@ void Integrator::computeNetForceGPU(uint64_t timestep)
             force_list.vpitch0 = d_virial_array0.getPitch();
             force_list.t0 = d_torque0.data;
 
-            if (cur_force + 1 < m_forces.size())
+            if (cur_force + 1 < forces.size())
                 {
                 const GlobalArray<Scalar4>& d_force_array1
-                    = m_forces[cur_force + 1]->getForceArray();
+                    = forces[cur_force + 1]->getForceArray();
                 ArrayHandle<Scalar4> d_force1(d_force_array1,
                                               access_location::device,
                                               access_mode::read);
                 const GlobalArray<Scalar>& d_virial_array1
-                    = m_forces[cur_force + 1]->getVirialArray();
+                    = forces[cur_force + 1]->getVirialArray();
                 ArrayHandle<Scalar> d_virial1(d_virial_array1,
                                               access_location::device,
                                               access_mode::read);
                 const GlobalArray<Scalar4>& d_torque_array1
-                    = m_forces[cur_force + 1]->getTorqueArray();
+                    = forces[cur_force + 1]->getTorqueArray();
                 ArrayHandle<Scalar4> d_torque1(d_torque_array1,
                                                access_location::device,
                                                access_mode::read);
@@ -513,20 +952,20 @@ void Integrator::computeNetForceGPU(uint64_t timestep)
                 force_list.vpitch1 = d_virial_array1.getPitch();
                 force_list.t1 = d_torque1.data;
                 }
-            if (cur_force + 2 < m_forces.size())
+            if (cur_force + 2 < forces.size())
                 {
                 const GlobalArray<Scalar4>& d_force_array2
-                    = m_forces[cur_force + 2]->getForceArray();
+                    = forces[cur_force + 2]->getForceArray();
                 ArrayHandle<Scalar4> d_force2(d_force_array2,
                                               access_location::device,
                                               access_mode::read);
                 const GlobalArray<Scalar>& d_virial_array2
-                    = m_forces[cur_force + 2]->getVirialArray();
+                    = forces[cur_force + 2]->getVirialArray();
                 ArrayHandle<Scalar> d_virial2(d_virial_array2,
                                               access_location::device,
                                               access_mode::read);
                 const GlobalArray<Scalar4>& d_torque_array2
-                    = m_forces[cur_force + 2]->getTorqueArray();
+                    = forces[cur_force + 2]->getTorqueArray();
                 ArrayHandle<Scalar4> d_torque2(d_torque_array2,
                                                access_location::device,
                                                access_mode::read);
@@ -535,20 +974,20 @@ void Integrator::computeNetForceGPU(uint64_t timestep)
                 force_list.vpitch2 = d_virial_array2.getPitch();
                 force_list.t2 = d_torque2.data;
                 }
-            if (cur_force + 3 < m_forces.size())
+            if (cur_force + 3 < forces.size())
                 {
                 const GlobalArray<Scalar4>& d_force_array3
-                    = m_forces[cur_force + 3]->getForceArray();
+                    = forces[cur_force + 3]->getForceArray();
                 ArrayHandle<Scalar4> d_force3(d_force_array3,
                                               access_location::device,
                                               access_mode::read);
                 const GlobalArray<Scalar>& d_virial_array3
-                    = m_forces[cur_force + 3]->getVirialArray();
+                    = forces[cur_force + 3]->getVirialArray();
                 ArrayHandle<Scalar> d_virial3(d_virial_array3,
                                               access_location::device,
                                               access_mode::read);
                 const GlobalArray<Scalar4>& d_torque_array3
-                    = m_forces[cur_force + 3]->getTorqueArray();
+                    = forces[cur_force + 3]->getTorqueArray();
                 ArrayHandle<Scalar4> d_torque3(d_torque_array3,
                                                access_location::device,
                                                access_mode::read);
@@ -557,20 +996,20 @@ void Integrator::computeNetForceGPU(uint64_t timestep)
                 force_list.vpitch3 = d_virial_array3.getPitch();
                 force_list.t3 = d_torque3.data;
                 }
-            if (cur_force + 4 < m_forces.size())
+            if (cur_force + 4 < forces.size())
                 {
                 const GlobalArray<Scalar4>& d_force_array4
-                    = m_forces[cur_force + 4]->getForceArray();
+                    = forces[cur_force + 4]->getForceArray();
                 ArrayHandle<Scalar4> d_force4(d_force_array4,
                                               access_location::device,
                                               access_mode::read);
                 const GlobalArray<Scalar>& d_virial_array4
-                    = m_forces[cur_force + 4]->getVirialArray();
+                    = forces[cur_force + 4]->getVirialArray();
                 ArrayHandle<Scalar> d_virial4(d_virial_array4,
                                               access_location::device,
                                               access_mode::read);
                 const GlobalArray<Scalar4>& d_torque_array4
-                    = m_forces[cur_force + 4]->getTorqueArray();
+                    = forces[cur_force + 4]->getTorqueArray();
                 ArrayHandle<Scalar4> d_torque4(d_torque_array4,
                                                access_location::device,
                                                access_mode::read);
@@ -579,20 +1018,20 @@ void Integrator::computeNetForceGPU(uint64_t timestep)
                 force_list.vpitch4 = d_virial_array4.getPitch();
                 force_list.t4 = d_torque4.data;
                 }
-            if (cur_force + 5 < m_forces.size())
+            if (cur_force + 5 < forces.size())
                 {
                 const GlobalArray<Scalar4>& d_force_array5
-                    = m_forces[cur_force + 5]->getForceArray();
+                    = forces[cur_force + 5]->getForceArray();
                 ArrayHandle<Scalar4> d_force5(d_force_array5,
                                               access_location::device,
                                               access_mode::read);
                 const GlobalArray<Scalar>& d_virial_array5
-                    = m_forces[cur_force + 5]->getVirialArray();
+                    = forces[cur_force + 5]->getVirialArray();
                 ArrayHandle<Scalar> d_virial5(d_virial_array5,
                                               access_location::device,
                                               access_mode::read);
                 const GlobalArray<Scalar4>& d_torque_array5
-                    = m_forces[cur_force + 5]->getTorqueArray();
+                    = forces[cur_force + 5]->getTorqueArray();
                 ArrayHandle<Scalar4> d_torque5(d_torque_array5,
                                                access_location::device,
                                                access_mode::read);
@@ -625,6 +1064,64 @@ void Integrator::computeNetForceGPU(uint64_t timestep)
 
             m_exec_conf->endMultiGPU();
             }
+
+        // apply the outer forces as an impulse, their energies and virials are not scaled
+        for (unsigned int cur_force = 0; outer_step && cur_force < m_outer_forces.size();
+             cur_force++)
+            {
+            if (elideForceArrays(m_outer_forces[cur_force]))
+                continue;
+
+            gpu_force_list force_list;
+            const GlobalArray<Scalar4>& d_force_array = m_outer_forces[cur_force]->getForceArray();
+            ArrayHandle<Scalar4> d_force(d_force_array, access_location::device, access_mode::read);
+            const GlobalArray<Scalar>& d_virial_array
+                = m_outer_forces[cur_force]->getVirialArray();
+            ArrayHandle<Scalar> d_virial(d_virial_array,
+                                         access_location::device,
+                                         access_mode::read);
+            const GlobalArray<Scalar4>& d_torque_array
+                = m_outer_forces[cur_force]->getTorqueArray();
+            ArrayHandle<Scalar4> d_torque(d_torque_array,
+                                          access_location::device,
+                                          access_mode::read);
+            force_list.f0 = d_force.data;
+            force_list.v0 = d_virial.data;
+            force_list.vpitch0 = d_virial_array.getPitch();
+            force_list.t0 = d_torque.data;
+
+            PDataFlags flags = this->m_pdata->getFlags();
+
+            m_exec_conf->beginMultiGPU();
+
+            gpu_integrator_sum_net_force(d_net_force.data,
+                                         d_net_virial.data,
+                                         net_virial_pitch,
+                                         d_net_torque.data,
+                                         force_list,
+                                         nparticles,
+                                         false,
+                                         flags[pdata_flag::pressure_tensor],
+                                         m_pdata->getGPUPartition(),
+                                         Scalar(m_outer_period));
+
+            if (m_exec_conf->isCUDAErrorCheckingEnabled())
+                CHECK_CUDA_ERROR();
+
+            m_exec_conf->endMultiGPU();
+            }
+        }
+
+    for (const auto& force : m_forces)
+        {
+        if (elideForceArrays(force))
+            addElidedForceGPU(force, Scalar(1.0), timestep);
+        }
+
+    for (const auto& force : m_outer_forces)
+        {
+        if (outer_step && elideForceArrays(force))
+            addElidedForceGPU(force, Scalar(m_outer_period), timestep);
         }
 
     // add up external virials and energies
@@ -635,6 +1132,16 @@ void Integrator::computeNetForceGPU(uint64_t timestep)
         external_energy += force->getExternalEnergy();
         }
 
+    for (const auto& force : m_outer_forces)
+        {
+        if (!outer_step)
+            break;
+
+        for (unsigned int k = 0; k < 6; k++)
+            external_virial[k] += force->getExternalVirial(k);
+        external_energy += force->getExternalEnergy();
+        }
+
     for (unsigned int k = 0; k < 6; k++)
         m_pdata->setExternalVirial(k, external_virial[k]);
 
@@ -829,7 +1336,7 @@ void Integrator::computeNetForceGPU(uint64_t timestep)
                 }
 
             // clear only on the first iteration AND if there are zero forces
-            bool clear = (cur_force == 0) && (m_forces.size() == 0);
+            bool clear = (cur_force == 0) && (m_forces.size() == 0) && !outer_step;
 
             // access flags
             PDataFlags flags = this->m_pdata->getFlags();
@@ -893,6 +1400,11 @@ void Integrator::update(uint64_t timestep)
         {
         constraint_force->setDeltaT(m_deltaT);
         }
+
+    for (auto& force : m_outer_forces)
+        {
+        force->setDeltaT(m_deltaT);
+        }
     }
 
 /** prepRun() is to be called at the very beginning of each run, before any analyzers are called,
@@ -906,6 +1418,57 @@ void Integrator::update(uint64_t timestep)
 */
 void Integrator::prepRun(uint64_t timestep) { }
 
+/** The forces and the computes they depend on, such as neighbor lists, are timed when they compute
+    and are reset along with the integrator.
+*/
+void Integrator::resetTimers()
+    {
+    Updater::resetTimers();
+
+    for (auto& compute : getForceComputes())
+        compute->resetTimers();
+    }
+
+/** System does not hold the forces or the neighbor lists they depend on, so the integrator resets
+    them at the start of each run.
+*/
+void Integrator::resetStats()
+    {
+    Updater::resetStats();
+
+    for (auto& compute : getForceComputes())
+        compute->resetStats();
+    }
+
+/** A compute that several forces depend on appears once.
+ */
+std::vector<std::shared_ptr<Compute>> Integrator::getForceComputes()
+    {
+    std::vector<std::shared_ptr<Compute>> computes;
+    auto add_compute = [&computes](const std::shared_ptr<Compute>& compute)
+    {
+        if (compute && std::find(computes.begin(), computes.end(), compute) == computes.end())
+            computes.push_back(compute);
+    };
+
+    for (auto& force : m_forces)
+        {
+        add_compute(force);
+        add_compute(force->getComputeDependency());
+        }
+    for (auto& force : m_outer_forces)
+        {
+        add_compute(force);
+        add_compute(force->getComputeDependency());
+        }
+    for (auto& constraint_force : m_constraint_forces)
+        {
+        add_compute(constraint_force);
+        add_compute(constraint_force->getComputeDependency());
+        }
+    return computes;
+    }
+
 #ifdef ENABLE_MPI
 /** @param tstep Time step for which to determine the flags
 
@@ -928,6 +1491,15 @@ CommFlags Integrator::determineFlags(uint64_t timestep)
         flags |= constraint_force->getRequestedCommFlags(timestep);
         }
 
+    // query the outer forces on the steps they are evaluated
+    if (isOuterStep(timestep))
+        {
+        for (const auto& force : m_outer_forces)
+            {
+            flags |= force->getRequestedCommFlags(timestep);
+            }
+        }
+
     return flags;
     }
 
@@ -955,6 +1527,14 @@ void Integrator::computeCallback(uint64_t timestep)
         {
         force->preCompute(timestep);
         }
+
+    if (isOuterStep(timestep))
+        {
+        for (auto& force : m_outer_forces)
+            {
+            force->preCompute(timestep);
+            }
+        }
     }
 #endif
 
@@ -972,6 +1552,11 @@ bool Integrator::getAnisotropic()
         aniso |= constraint_force->isAnisotropic();
         }
 
+    for (auto& force : m_outer_forces)
+        {
+        aniso |= force->isAnisotropic();
+        }
+
     return aniso;
     }
 
@@ -985,5 +1570,10 @@ void export_Integrator(py::module& m)
         .def("updateGroupDOF", &Integrator::updateGroupDOF)
         .def_property("dt", &Integrator::getDeltaT, &Integrator::setDeltaT)
         .def_property_readonly("forces", &Integrator::getForces)
-        .def_property_readonly("constraints", &Integrator::getConstraintForces);
+        .def_property_readonly("constraints", &Integrator::getConstraintForces)
+        .def_property_readonly("outer_forces", &Integrator::getOuterForces)
+        .def_property("outer_period", &Integrator::getOuterPeriod, &Integrator::setOuterPeriod)
+        .def_property("elide_force_arrays",
+                      &Integrator::getElideForceArrays,
+                      &Integrator::setElideForceArrays);
     }
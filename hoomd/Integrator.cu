@@ -21,16 +21,17 @@ __device__ void add_force_total(Scalar4& net_force,
                                 Scalar* d_v,
                                 const size_t virial_pitch,
                                 Scalar4* d_t,
-                                int idx)
+                                int idx,
+                                Scalar force_scale)
     {
     if (d_f != NULL && d_v != NULL && d_t != NULL)
         {
         Scalar4 f = d_f[idx];
         Scalar4 t = d_t[idx];
 
-        net_force.x += f.x;
-        net_force.y += f.y;
-        net_force.z += f.z;
+        net_force.x += force_scale * f.x;
+        net_force.y += force_scale * f.y;
+        net_force.z += force_scale * f.z;
         net_force.w += f.w;
 
         if (compute_virial)
@@ -39,9 +40,9 @@ __device__ void add_force_total(Scalar4& net_force,
                 net_virial[i] += d_v[i * virial_pitch + idx];
             }
 
-        net_torque.x += t.x;
-        net_torque.y += t.y;
-        net_torque.z += t.z;
+        net_torque.x += force_scale * t.x;
+        net_torque.y += force_scale * t.y;
+        net_torque.z += force_scale * t.z;
         net_torque.w += t.w;
         }
     }
@@ -59,6 +60,7 @@ __device__ void add_force_total(Scalar4& net_force,
     \param clear When true, initializes the sums to 0 before adding. When false, reads in the
    current \a d_net_force and \a d_net_virial and adds to that \param offset of this GPU in ptls
    array
+    \param force_scale Factor applied to the forces and torques (not the energies and virials)
 
     \tparam compute_virial When set to 0, the virial sum is not computed
 */
@@ -70,7 +72,8 @@ __global__ void gpu_integrator_sum_net_force_kernel(Scalar4* d_net_force,
                                                     const gpu_force_list force_list,
                                                     unsigned int nwork,
                                                     bool clear,
-                                                    unsigned int offset)
+                                                    unsigned int offset,
+                                                    Scalar force_scale)
     {
     // calculate the index we will be handling
     int idx = blockDim.x * blockIdx.x + threadIdx.x;
@@ -113,7 +116,8 @@ __global__ void gpu_integrator_sum_net_force_kernel(Scalar4* d_net_force,
                                         force_list.v0,
                                         force_list.vpitch0,
                                         force_list.t0,
-                                        idx);
+                                        idx,
+                                        force_scale);
         add_force_total<compute_virial>(net_force,
                                         net_virial,
                                         net_torque,
@@ -121,7 +125,8 @@ __global__ void gpu_integrator_sum_net_force_kernel(Scalar4* d_net_force,
                                         force_list.v1,
                                         force_list.vpitch1,
                                         force_list.t1,
-                                        idx);
+                                        idx,
+                                        force_scale);
         add_force_total<compute_virial>(net_force,
                                         net_virial,
                                         net_torque,
@@ -129,7 +134,8 @@ __global__ void gpu_integrator_sum_net_force_kernel(Scalar4* d_net_force,
                                         force_list.v2,
                                         force_list.vpitch2,
                                         force_list.t2,
-                                        idx);
+                                        idx,
+                                        force_scale);
         add_force_total<compute_virial>(net_force,
                                         net_virial,
                                         net_torque,
@@ -137,7 +143,8 @@ __global__ void gpu_integrator_sum_net_force_kernel(Scalar4* d_net_force,
                                         force_list.v3,
                                         force_list.vpitch3,
                                         force_list.t3,
-                                        idx);
+                                        idx,
+                                        force_scale);
         add_force_total<compute_virial>(net_force,
                                         net_virial,
                                         net_torque,
@@ -145,7 +152,8 @@ __global__ void gpu_integrator_sum_net_force_kernel(Scalar4* d_net_force,
                                         force_list.v4,
                                         force_list.vpitch4,
                                         force_list.t4,
-                                        idx);
+                                        idx,
+                                        force_scale);
         add_force_total<compute_virial>(net_force,
                                         net_virial,
                                         net_torque,
@@ -153,7 +161,8 @@ __global__ void gpu_integrator_sum_net_force_kernel(Scalar4* d_net_force,
                                         force_list.v5,
                                         force_list.vpitch5,
                                         force_list.t5,
-                                        idx);
+                                        idx,
+                                        force_scale);
 
         // write out the final result
         d_net_force[idx] = net_force;
@@ -174,7 +183,8 @@ hipError_t gpu_integrator_sum_net_force(Scalar4* d_net_force,
                                         unsigned int nparticles,
                                         bool clear,
                                         bool compute_virial,
-                                        const GPUPartition& gpu_partition)
+                                        const GPUPartition& gpu_partition,
+                                        Scalar force_scale)
     {
     // sanity check
     assert(d_net_force);
@@ -204,7 +214,8 @@ hipError_t gpu_integrator_sum_net_force(Scalar4* d_net_force,
                                force_list,
                                nwork,
                                clear,
-                               range.first);
+                               range.first,
+                               force_scale);
             }
         else
             {
@@ -220,7 +231,8 @@ hipError_t gpu_integrator_sum_net_force(Scalar4* d_net_force,
                                force_list,
                                nwork,
                                clear,
-                               range.first);
+                               range.first,
+                               force_scale);
             }
         }
 
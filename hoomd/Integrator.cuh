@@ -68,6 +68,7 @@ hipError_t gpu_integrator_sum_net_force(Scalar4* d_net_force,
                                         unsigned int nparticles,
                                         bool clear,
                                         bool compute_virial,
-                                        const GPUPartition& gpu_partition);
+                                        const GPUPartition& gpu_partition,
+                                        Scalar force_scale = Scalar(1.0));
 
 #endif
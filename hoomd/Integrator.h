@@ -44,6 +44,20 @@
     convenience in derived classes implementing correct counting in getTranslationalDOF() and
     getRotationalDOF().
 
+    Forces in m_outer_forces (accessed via getOuterForces) are evaluated only on time steps that
+    are multiples of the outer period, and their forces and torques enter the net force multiplied
+    by the outer period on those steps. With velocity Verlet style integration methods, this
+    applies the slowly varying outer forces as an impulse every outer period, following the
+    r-RESPA multiple time step scheme. Their energies and virials are included unscaled on the
+    outer steps and are absent from the net force on the steps in between.
+
+    With setElideForceArrays(), forces that support it (ForceCompute::supportsElidedForceArrays())
+    release their force and virial arrays. The integrator computes them one at a time into a pair of
+    shared arrays and adds each result to the net force before computing the next, so that the
+    memory for the per-force arrays is needed once instead of once per force. A force allocates its
+    arrays again, and keeps them, when it is computed outside of the integrator to access its
+    forces or energies.
+
     Integrators take "ownership" of the particle's accelerations. Any other updater that modifies
     the particles accelerations will produce undefined results. If accelerations are to be modified,
     they must be done through forces, and added to an Integrator via the m_forces std::vector.
@@ -80,6 +94,30 @@ class PYBIND11_EXPORT Integrator : public Updater
         return m_constraint_forces;
         }
 
+    /// Get the list of force computes evaluated every outer period
+    std::vector<std::shared_ptr<ForceCompute>>& getOuterForces()
+        {
+        return m_outer_forces;
+        }
+
+    /// Get the number of time steps between evaluations of the outer forces
+    unsigned int getOuterPeriod()
+        {
+        return m_outer_period;
+        }
+
+    /// Set the number of time steps between evaluations of the outer forces
+    void setOuterPeriod(unsigned int outer_period);
+
+    /// Get whether supporting forces compute into arrays shared among them
+    bool getElideForceArrays()
+        {
+        return m_elide_force_arrays;
+        }
+
+    /// Set whether supporting forces compute into arrays shared among them
+    void setElideForceArrays(bool elide_force_arrays);
+
     /// Set HalfStepHook
     virtual void setHalfStepHook(std::shared_ptr<HalfStepHook> hook);
 
@@ -129,6 +167,12 @@ class PYBIND11_EXPORT Integrator : public Updater
     /// Prepare for the run
     virtual void prepRun(uint64_t timestep);
 
+    /// Discard the times measured by the integrator and its forces
+    virtual void resetTimers();
+
+    /// Reset the statistics of the integrator and its forces
+    virtual void resetStats();
+
 #ifdef ENABLE_MPI
     /// Set the communicator to use
     /** @param comm The Communicator
@@ -149,6 +193,12 @@ class PYBIND11_EXPORT Integrator : public Updater
     /// List of all the constraints
     std::vector<std::shared_ptr<ForceConstraint>> m_constraint_forces;
 
+    /// List of the force computes evaluated every outer period
+    std::vector<std::shared_ptr<ForceCompute>> m_outer_forces;
+
+    /// Number of time steps between evaluations of the outer forces
+    unsigned int m_outer_period = 1;
+
     /// The HalfStepHook, if active
     std::shared_ptr<HalfStepHook> m_half_step_hook;
 
@@ -158,9 +208,35 @@ class PYBIND11_EXPORT Integrator : public Updater
     /// helper function to compute net force/virial
     virtual void computeNetForce(uint64_t timestep);
 
+    /// Compute the given forces on the CPU, independent forces on separate threads
+    void computeForcesCPU(const std::vector<std::shared_ptr<ForceCompute>>& forces,
+                          uint64_t timestep);
+
+    /// Check whether a force computes into the shared arrays
+    bool elideForceArrays(const std::shared_ptr<ForceCompute>& force);
+
+    /// Compute a force with elided arrays into the shared arrays
+    void computeElidedForce(const std::shared_ptr<ForceCompute>& force, uint64_t timestep);
+
+    /// Compute a force with elided arrays and add it to the net force on the CPU
+    void addElidedForceCPU(const std::shared_ptr<ForceCompute>& force,
+                           Scalar scale,
+                           uint64_t timestep,
+                           Scalar* external_virial,
+                           Scalar& external_energy);
+
 #ifdef ENABLE_HIP
     /// helper function to compute net force/virial on the GPU
     virtual void computeNetForceGPU(uint64_t timestep);
+
+    /// Compute the given forces on the GPU, each force that supports streams on its own stream
+    void computeForcesGPU(const std::vector<std::shared_ptr<ForceCompute>>& forces,
+                          uint64_t timestep);
+
+    /// Compute a force with elided arrays and add it to the net force on the GPU
+    void addElidedForceGPU(const std::shared_ptr<ForceCompute>& force,
+                           Scalar scale,
+                           uint64_t timestep);
 #endif
 
 #ifdef ENABLE_MPI
@@ -171,7 +247,25 @@ class PYBIND11_EXPORT Integrator : public Updater
     /// Check if any forces introduce anisotropic degrees of freedom
     virtual bool getAnisotropic();
 
+    /// Check whether the outer forces are applied at the given time step
+    bool isOuterStep(uint64_t timestep)
+        {
+        return m_outer_forces.size() > 0 && timestep % m_outer_period == 0;
+        }
+
     private:
+    /// Get the forces and the computes they depend on, such as neighbor lists
+    std::vector<std::shared_ptr<Compute>> getForceComputes();
+
+    /// True when supporting forces compute into the shared arrays
+    bool m_elide_force_arrays = false;
+
+    /// Force array shared by the forces with elided arrays
+    GlobalArray<Scalar4> m_shared_force;
+
+    /// Virial array shared by the forces with elided arrays
+    GlobalArray<Scalar> m_shared_virial;
+
 #ifdef ENABLE_MPI
     /// Connection to Communicator to request communication flags
     bool m_request_flags_connected = false;
@@ -179,6 +273,11 @@ class PYBIND11_EXPORT Integrator : public Updater
     /// Track if we have already connected signals
     bool m_signals_connected = false;
 #endif
+
+#ifdef ENABLE_HIP
+    /// Non-blocking streams assigned to the forces that support them
+    std::vector<hipStream_t> m_force_streams;
+#endif
     };
 
 /// Exports the NVEUpdater class to python
@@ -13,6 +13,7 @@
 #include "hoomd/extern/BVLSSolver.h"
 #include <Eigen/Dense>
 
+#include <algorithm>
 #include <cmath>
 #include <iostream>
 #include <limits>
@@ -35,7 +36,9 @@ LoadBalancer::LoadBalancer(std::shared_ptr<SystemDefinition> sysdef,
 #endif
       m_max_imbalance(Scalar(1.0)), m_recompute_max_imbalance(true), m_needs_migrate(false),
       m_needs_recount(false), m_tolerance(Scalar(1.05)), m_maxiter(1), m_max_scale(Scalar(0.05)),
-      m_N_own(m_pdata->getN()), m_max_max_imbalance(1.0), m_total_max_imbalance(0.0), m_n_calls(0),
+      m_time_weight(false), m_load_own(Scalar(m_pdata->getN())), m_particle_weight(Scalar(1.0)),
+      m_total_load(Scalar(m_pdata->getNGlobal())), m_last_time(0), m_last_comm_time(0),
+      m_has_time(false), m_max_max_imbalance(1.0), m_total_max_imbalance(0.0), m_n_calls(0),
       m_n_iterations(0), m_n_rebalances(0)
     {
     m_exec_conf->msg->notice(5) << "Constructing LoadBalancer" << endl;
@@ -61,6 +64,30 @@ LoadBalancer::LoadBalancer(std::shared_ptr<SystemDefinition> sysdef,
 LoadBalancer::~LoadBalancer()
     {
     m_exec_conf->msg->notice(5) << "Destroying LoadBalancer" << endl;
+#ifdef ENABLE_MPI
+    if (m_comm && m_time_weight)
+        m_comm->setSynchronizeTiming(false);
+#endif
+    }
+
+/*!
+ * \param weight Name of the load metric
+ */
+void LoadBalancer::setWeight(const std::string& weight)
+    {
+    if (weight == "particles")
+        m_time_weight = false;
+    else if (weight == "time")
+        m_time_weight = true;
+    else
+        throw std::invalid_argument("Unknown load balancing weight: " + weight);
+
+    // restart the time measurement with the next update
+    m_has_time = false;
+#ifdef ENABLE_MPI
+    if (m_comm)
+        m_comm->setSynchronizeTiming(m_time_weight);
+#endif
     }
 
 /*!
@@ -81,9 +108,15 @@ void LoadBalancer::update(uint64_t timestep)
     if (m_prof)
         m_prof->push(m_exec_conf, "balance");
 
-    // no adjustment has been made yet, so set m_N_own to the number of particles on the rank
+    // measure the cost of the particles on this rank since the last update
+    measureParticleWeight();
+
+    // no adjustment has been made yet, so set the load from the particles on the rank
     resetNOwn(m_pdata->getN());
 
+    // moving the domain boundaries moves particles along with their load, so the total is conserved
+    MPI_Allreduce(&m_load_own, &m_total_load, 1, MPI_HOOMD_SCALAR, MPI_SUM, m_mpi_comm);
+
     // figure out which rank is the reduction root for broadcasting
     const Index3D& di = m_decomposition->getDomainIndexer();
     unsigned int reduce_root(0);
@@ -139,17 +172,17 @@ void LoadBalancer::update(uint64_t timestep)
                 min_frac_i = min_domain_frac.z;
                 }
 
-            vector<unsigned int> N_i;
+            vector<Scalar> load_i;
             bool adjusted = false;
 
-            // reduce the number of particles in the slice along dim
-            bool active = reduce(N_i, dim, reduce_root);
+            // reduce the load in the slice along dim
+            bool active = reduce(load_i, dim, reduce_root);
 
             // attempt an adjustment
             vector<Scalar> cum_frac = m_decomposition->getCumulativeFractions(dim);
             if (active)
                 {
-                adjusted = adjust(cum_frac, N_i, L_i, min_frac_i);
+                adjusted = adjust(cum_frac, load_i, L_i, min_frac_i);
                 }
 
             // broadcast if an adjustment has been made on the root
@@ -167,8 +200,19 @@ void LoadBalancer::update(uint64_t timestep)
         // force a particle migration if one is needed
         if (m_needs_migrate)
             {
+            // the migrated particles carry the load predicted for the new domains
+            Scalar load(0.0);
+            if (m_time_weight)
+                load = getLoadOwn();
+
             m_comm->forceMigrate();
             m_comm->communicate(timestep);
+
+            if (m_time_weight)
+                {
+                const unsigned int N = m_pdata->getN();
+                m_particle_weight = (N > 0) ? load / Scalar(N) : Scalar(0.0);
+                }
             resetNOwn(m_pdata->getN());
             m_needs_migrate = false;
 
@@ -177,6 +221,14 @@ void LoadBalancer::update(uint64_t timestep)
             }
         }
 
+    // start the next measurement interval after the balancing work
+    if (m_time_weight)
+        {
+        m_last_time = m_clock.getTime();
+        m_last_comm_time = m_comm->getCommunicationTime();
+        m_has_time = true;
+        }
+
     if (m_prof)
         m_prof->pop(m_exec_conf);
 #endif // ENABLE_MPI
@@ -185,15 +237,14 @@ void LoadBalancer::update(uint64_t timestep)
 #ifdef ENABLE_MPI
 
 /*!
- * Computes the imbalance factor I = N / <N> for each rank, and computes the maximum among all
- * ranks.
+ * Computes the imbalance factor I = W / <W> of the load W for each rank, and computes the maximum
+ * among all ranks.
  */
 Scalar LoadBalancer::getMaxImbalance()
     {
     if (m_recompute_max_imbalance)
         {
-        Scalar cur_imb = Scalar(getNOwn())
-                         / (Scalar(m_pdata->getNGlobal()) / Scalar(m_exec_conf->getNRanks()));
+        Scalar cur_imb = getLoadOwn() / (m_total_load / Scalar(m_exec_conf->getNRanks()));
         Scalar max_imb(0.0);
         MPI_Allreduce(&cur_imb, &max_imb, 1, MPI_HOOMD_SCALAR, MPI_MAX, m_mpi_comm);
 
@@ -208,37 +259,42 @@ Scalar LoadBalancer::getMaxImbalance()
     }
 
 /*!
- * \param N_i Vector holding the total number of particles in each slice (will be allocated on call)
+ * \param load_i Vector holding the total load in each slice (will be allocated on call)
  * \param dim The dimension of the slices (x=0, y=1, z=2)
  * \param reduce_root The rank to perform the reduction on
- * \returns true if the current rank holds the active \a N_i
+ * \returns true if the current rank holds the active \a load_i
  *
- * \post \a N_i holds the number of particles in each slice along \a dim
+ * \post \a load_i holds the load in each slice along \a dim
  *
  * \note reduce() relies on collective MPI calls, and so all ranks must call it. However, for
  * efficiency the data will be active only on Cartesian rank \a reduce_root, as indicated by the
- * return value. As a result, only \a reduce_root actually needs to allocate memory for \a N_i.
+ * return value. As a result, only \a reduce_root actually needs to allocate memory for \a load_i.
  *
  * The reduction is performed by performing an all-to-one gather, followed by summation on \a
  * reduce_root. This operation may be suboptimal for very large numbers of processors, and could be
  * replaced by cascading send operations down dimensions. Generally, load balancing should not be
  * performed too frequently, and so we do not pursue this optimization right now.
  */
-bool LoadBalancer::reduce(std::vector<unsigned int>& N_i,
-                          unsigned int dim,
-                          unsigned int reduce_root)
+bool LoadBalancer::reduce(std::vector<Scalar>& load_i, unsigned int dim, unsigned int reduce_root)
     {
     // do nothing if there is only one rank
-    if (N_i.size() == 1)
+    if (load_i.size() == 1)
         return false;
 
     const Index3D& di = m_decomposition->getDomainIndexer();
-    std::vector<unsigned int> N_per_rank(di.getNumElements());
+    std::vector<Scalar> load_per_rank(di.getNumElements());
 
-    // get the number of particles the current rank owns (the quantity to be reduced)
-    unsigned int N_own = getNOwn();
+    // get the load of the particles the current rank owns (the quantity to be reduced)
+    Scalar load_own = getLoadOwn();
 
-    MPI_Gather(&N_own, 1, MPI_UNSIGNED, &N_per_rank[0], 1, MPI_UNSIGNED, reduce_root, m_mpi_comm);
+    MPI_Gather(&load_own,
+               1,
+               MPI_HOOMD_SCALAR,
+               &load_per_rank[0],
+               1,
+               MPI_HOOMD_SCALAR,
+               reduce_root,
+               m_mpi_comm);
 
     // only the root rank performs the reduction
     if (m_exec_conf->getRank() != reduce_root)
@@ -248,57 +304,57 @@ bool LoadBalancer::reduce(std::vector<unsigned int>& N_i,
     ArrayHandle<unsigned int> h_cart_ranks_inv(m_decomposition->getInverseCartRanks(),
                                                access_location::host,
                                                access_mode::read);
-    std::vector<unsigned int> N_per_cart_rank(di.getNumElements());
+    std::vector<Scalar> load_per_cart_rank(di.getNumElements());
     for (unsigned int cur_rank = 0; cur_rank < di.getNumElements(); ++cur_rank)
         {
-        N_per_cart_rank[h_cart_ranks_inv.data[cur_rank]] = N_per_rank[cur_rank];
+        load_per_cart_rank[h_cart_ranks_inv.data[cur_rank]] = load_per_rank[cur_rank];
         }
 
     // perform the summation along dim in as cache friendly of a way as we can manage
     if (dim == 0) // to x
         {
-        N_i.clear();
-        N_i.resize(di.getW());
+        load_i.clear();
+        load_i.resize(di.getW());
         for (unsigned int i = 0; i < di.getW(); ++i)
             {
-            N_i[i] = 0;
+            load_i[i] = Scalar(0.0);
             for (unsigned int k = 0; k < di.getD(); ++k)
                 {
                 for (unsigned int j = 0; j < di.getH(); ++j)
                     {
-                    N_i[i] += N_per_cart_rank[di(i, j, k)];
+                    load_i[i] += load_per_cart_rank[di(i, j, k)];
                     }
                 }
             }
         }
     else if (dim == 1) // to y
         {
-        N_i.clear();
-        N_i.resize(di.getH());
+        load_i.clear();
+        load_i.resize(di.getH());
         for (unsigned int j = 0; j < di.getH(); ++j)
             {
-            N_i[j] = 0;
+            load_i[j] = Scalar(0.0);
             for (unsigned int k = 0; k < di.getD(); ++k)
                 {
                 for (unsigned int i = 0; i < di.getW(); ++i)
                     {
-                    N_i[j] += N_per_cart_rank[di(i, j, k)];
+                    load_i[j] += load_per_cart_rank[di(i, j, k)];
                     }
                 }
             }
         }
     else if (dim == 2) // to z
         {
-        N_i.clear();
-        N_i.resize(di.getD());
+        load_i.clear();
+        load_i.resize(di.getD());
         for (unsigned int k = 0; k < di.getD(); ++k)
             {
-            N_i[k] = 0;
+            load_i[k] = Scalar(0.0);
             for (unsigned int j = 0; j < di.getH(); ++j)
                 {
                 for (unsigned int i = 0; i < di.getW(); ++i)
                     {
-                    N_i[k] += N_per_cart_rank[di(i, j, k)];
+                    load_i[k] += load_per_cart_rank[di(i, j, k)];
                     }
                 }
             }
@@ -315,7 +371,7 @@ bool LoadBalancer::reduce(std::vector<unsigned int>& N_i,
 
 /*!
  * \param cum_frac_i The cumulative fraction array to write output into
- * \param N_i The reduced number of particles along the dimension
+ * \param load_i The reduced load along the dimension
  * \param L_i The global box length along the dimension
  * \param min_frac_i The minimum fractional width of a domain
  *
@@ -334,31 +390,31 @@ bool LoadBalancer::reduce(std::vector<unsigned int>& N_i,
  * minimization was successful, apply the adjustment to \a cum_frac_i.
  */
 bool LoadBalancer::adjust(vector<Scalar>& cum_frac_i,
-                          const vector<unsigned int>& N_i,
+                          const vector<Scalar>& load_i,
                           Scalar L_i,
                           Scalar min_frac_i)
     {
-    if (N_i.size() == 1)
+    if (load_i.size() == 1)
         return false;
 
-    // target particles per rank is uniform distribution
-    const Scalar target = Scalar(m_pdata->getNGlobal()) / Scalar(N_i.size());
+    // target load per slice is the uniform distribution
+    const Scalar target = m_total_load / Scalar(load_i.size());
 
     // make the minimum domain slightly bigger so that the optimization won't fail at equality
     const Scalar min_domain_size = Scalar(1.00001) * min_frac_i * L_i;
     // if system is overconstrained (exactly decomposed) don't do any adjusting
-    if (min_domain_size * Scalar(N_i.size()) >= L_i)
+    if (min_domain_size * Scalar(load_i.size()) >= L_i)
         {
         return false;
         }
 
     // imbalance factors for each rank
-    vector<Scalar> new_widths(N_i.size());
-    for (unsigned int i = 0; i < N_i.size(); ++i)
+    vector<Scalar> new_widths(load_i.size());
+    for (unsigned int i = 0; i < load_i.size(); ++i)
         {
-        const Scalar imb_factor = Scalar(N_i[i]) / target;
+        const Scalar imb_factor = load_i[i] / target;
         Scalar scale_factor
-            = (N_i[i] > 0)
+            = (load_i[i] > Scalar(0.0))
                   ? Scalar(1.0) / imb_factor
                   : (Scalar(1.0)
                      + m_max_scale); // as in gromacs, use half the imbalance factor to scale
@@ -383,7 +439,7 @@ bool LoadBalancer::adjust(vector<Scalar>& cum_frac_i,
     // setup the augmented A matrix, with scale factor eps for the actual least squares part (to
     // enforce the inequality constraints correctly)
     const Scalar eps(0.001);
-    unsigned int m = (unsigned int)N_i.size();
+    unsigned int m = (unsigned int)load_i.size();
     unsigned int n = m - 1;
     Eigen::MatrixXd A = Eigen::MatrixXd::Zero(2 * m, n + m);
     A(0, 0) = 1.0;
@@ -553,8 +609,8 @@ void LoadBalancer::countParticlesOffRank(std::map<unsigned int, unsigned int>& c
 
 /*!
  * Each rank calls countParticlesOffRank() to count the number of particles to send to other ranks.
- * Neighboring ranks then perform send/receive calls, and count the new number of particles they own
- * as the number they owned locally plus the number received minus the number sent.
+ * Neighboring ranks then exchange the load carried by these particles, and compute the new load
+ * they own as the load they owned locally plus the load received minus the load sent.
  *
  * \note All ranks must participate in this call since it involves send/receive operations between
  * neighboring domains.
@@ -583,23 +639,23 @@ void LoadBalancer::computeOwnedParticles()
     MPI_Status stat[2 * m_comm->getNUniqueNeighbors()];
     unsigned int nreq = 0;
 
-    unsigned int n_send_ptls[m_comm->getNUniqueNeighbors()];
-    unsigned int n_recv_ptls[m_comm->getNUniqueNeighbors()];
+    Scalar send_load[m_comm->getNUniqueNeighbors()];
+    Scalar recv_load[m_comm->getNUniqueNeighbors()];
     for (unsigned int cur_neigh = 0; cur_neigh < m_comm->getNUniqueNeighbors(); ++cur_neigh)
         {
         unsigned int neigh_rank = h_unique_neigh.data[cur_neigh];
-        n_send_ptls[cur_neigh] = cnts[neigh_rank];
+        send_load[cur_neigh] = m_particle_weight * Scalar(cnts[neigh_rank]);
 
-        MPI_Isend(&n_send_ptls[cur_neigh],
+        MPI_Isend(&send_load[cur_neigh],
                   1,
-                  MPI_UNSIGNED,
+                  MPI_HOOMD_SCALAR,
                   neigh_rank,
                   0,
                   m_mpi_comm,
                   &req[nreq++]);
-        MPI_Irecv(&n_recv_ptls[cur_neigh],
+        MPI_Irecv(&recv_load[cur_neigh],
                   1,
-                  MPI_UNSIGNED,
+                  MPI_HOOMD_SCALAR,
                   neigh_rank,
                   0,
                   m_mpi_comm,
@@ -607,16 +663,18 @@ void LoadBalancer::computeOwnedParticles()
         }
     MPI_Waitall(nreq, req, stat);
 
-    // reduce the particles sent to me
-    int N_own = m_pdata->getN();
+    // reduce the load sent to me
+    Scalar load_own = m_particle_weight * Scalar(m_pdata->getN());
     for (unsigned int cur_neigh = 0; cur_neigh < m_comm->getNUniqueNeighbors(); ++cur_neigh)
         {
-        N_own += n_recv_ptls[cur_neigh];
-        N_own -= n_send_ptls[cur_neigh];
+        load_own += recv_load[cur_neigh];
+        load_own -= send_load[cur_neigh];
         }
 
-    // set the count
-    resetNOwn(N_own);
+    // set the load
+    m_load_own = load_own;
+    m_recompute_max_imbalance = true;
+    m_needs_recount = false;
     }
 
 #endif // ENABLE_MPI
@@ -629,7 +687,36 @@ void LoadBalancer::resetStats()
     m_n_calls = m_n_iterations = m_n_rebalances = 0;
     m_total_max_imbalance = 0.0;
     m_max_max_imbalance = Scalar(1.0);
+    m_has_time = false;
+    }
+
+#ifdef ENABLE_MPI
+/*!
+ * With the "time" weight, the load of a rank is the wall clock time it spent since the end of the
+ * previous update, excluding the time spent in communication where it may have waited on other
+ * ranks. Each owned particle carries an equal share of this load. The first update of a run has no
+ * measurement and falls back to the particle count.
+ */
+void LoadBalancer::measureParticleWeight()
+    {
+    m_particle_weight = Scalar(1.0);
+    if (!m_time_weight)
+        return;
+
+    // keep queued GPU work out of the communication time
+    m_comm->setSynchronizeTiming(true);
+
+    if (!m_has_time)
+        return;
+
+    const int64_t elapsed = m_clock.getTime() - m_last_time;
+    const int64_t comm_time = m_comm->getCommunicationTime() - m_last_comm_time;
+    const Scalar busy = Scalar(std::max(elapsed - comm_time, int64_t(1))) * Scalar(1e-9);
+
+    const unsigned int N = m_pdata->getN();
+    m_particle_weight = (N > 0) ? busy / Scalar(N) : Scalar(0.0);
     }
+#endif // ENABLE_MPI
 
 void export_LoadBalancer(py::module& m)
     {
@@ -641,5 +728,6 @@ void export_LoadBalancer(py::module& m)
                       &LoadBalancer::setMaxIterations)
         .def_property("x", &LoadBalancer::getEnableX, &LoadBalancer::setEnableX)
         .def_property("y", &LoadBalancer::getEnableY, &LoadBalancer::setEnableY)
-        .def_property("z", &LoadBalancer::getEnableZ, &LoadBalancer::setEnableZ);
+        .def_property("z", &LoadBalancer::getEnableZ, &LoadBalancer::setEnableZ)
+        .def_property("weight", &LoadBalancer::getWeight, &LoadBalancer::setWeight);
     }
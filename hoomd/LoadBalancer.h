@@ -12,6 +12,7 @@
 #endif
 
 #pragma once
+#include "ClockSource.h"
 #include "Trigger.h"
 #include "Tuner.h"
 
@@ -24,8 +25,10 @@
 //! Updates domain decompositions to balance the load
 /*!
  * Adjusts the boundaries of the processor domains to distribute the load close to evenly between
- * them. The load imbalance is defined as the number of particles owned by a rank divided by the
- * average number of particles per rank if the particles had a uniform distribution.
+ * them. The load imbalance is defined as the load of a rank divided by the average load per rank.
+ * By default, the load is the number of particles owned by the rank. When the weight is "time",
+ * the load is the wall clock time the rank spent outside of communication since the last update,
+ * and each particle carries an equal share of the load of the rank that owns it.
  *
  * At each load balancing step, we attempt to rescale the domain size by the inverse of the load
  * balance, subject to the following constraints that are imposed to both maintain a stable
@@ -101,6 +104,19 @@ class PYBIND11_EXPORT LoadBalancer : public Tuner
             }
         }
 
+    /// Set the load metric
+    /*!
+     * \param weight "particles" to balance the number of particles, or "time" to balance the
+     * measured computation time of each rank
+     */
+    void setWeight(const std::string& weight);
+
+    /// Get the load metric
+    std::string getWeight()
+        {
+        return m_time_weight ? "time" : "particles";
+        }
+
     /// Set m_enable_x
     void setEnableX(bool enable)
         {
@@ -153,8 +169,8 @@ class PYBIND11_EXPORT LoadBalancer : public Tuner
     //! Computes the maximum imbalance factor
     Scalar getMaxImbalance();
 
-    //! Reduce the particle numbers per rank down to one dimension
-    bool reduce(std::vector<unsigned int>& N_i, unsigned int dim, unsigned int reduce_root);
+    //! Reduce the loads per rank down to one dimension
+    bool reduce(std::vector<Scalar>& load_i, unsigned int dim, unsigned int reduce_root);
 
     //! Set flags within the class that a resize has been performed
     void signalResize()
@@ -166,30 +182,33 @@ class PYBIND11_EXPORT LoadBalancer : public Tuner
 
     //! Adjust the partitioning along a single dimension
     bool adjust(std::vector<Scalar>& cum_frac_i,
-                const std::vector<unsigned int>& N_i,
+                const std::vector<Scalar>& load_i,
                 Scalar L_i,
                 Scalar min_domain_frac);
 
-    //! Compute the number of particles on each rank after an adjustment
+    //! Compute the load on each rank after an adjustment
     void computeOwnedParticles();
 
+    //! Measure the cost per particle on this rank since the last update
+    void measureParticleWeight();
+
     //! Count the number of particles that have gone off the rank
     virtual void countParticlesOffRank(std::map<unsigned int, unsigned int>& cnts);
 
-    //! Gets the number of owned particles, updating if necessary
-    unsigned int getNOwn()
+    //! Gets the load of the owned particles, updating if necessary
+    Scalar getLoadOwn()
         {
         computeOwnedParticles();
-        return m_N_own;
+        return m_load_own;
         }
 
-    //! Force a reset of the number of owned particles without counting
+    //! Force a reset of the load of the owned particles without counting
     /*!
      * \param N number of particles owned by the rank
      */
     void resetNOwn(unsigned int N)
         {
-        m_N_own = N;
+        m_load_own = m_particle_weight * Scalar(N);
         m_recompute_max_imbalance = true;
         m_needs_recount = false;
         }
@@ -209,8 +228,17 @@ class PYBIND11_EXPORT LoadBalancer : public Tuner
 
     const Scalar m_max_scale; //!< Maximum fraction to rescale either direction (5%)
 
+    bool m_time_weight; //!< Flag to balance the measured time instead of the particle count
+
     private:
-    unsigned int m_N_own; //!< Number of particles owned by this rank
+    Scalar m_load_own;        //!< Load of the particles owned by this rank
+    Scalar m_particle_weight; //!< Load per particle owned by this rank
+    Scalar m_total_load;      //!< Load summed over all ranks
+
+    ClockSource m_clock;      //!< Clock to measure the time between updates
+    int64_t m_last_time;      //!< Time at the end of the previous update
+    int64_t m_last_comm_time; //!< Communication time at the end of the previous update
+    bool m_has_time;          //!< Flag if m_last_time was set during this run
 
     Scalar m_max_max_imbalance;   //!< The maximum imbalance of any check
     double m_total_max_imbalance; //!< The average imbalance over checks
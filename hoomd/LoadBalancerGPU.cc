@@ -12,7 +12,7 @@
 #include "LoadBalancerGPU.cuh"
 #include <hip/hip_runtime.h>
 
-#include "CachedAllocator.h"
+#include "Communicator.h"
 
 using namespace std;
 
@@ -26,22 +26,14 @@ LoadBalancerGPU::LoadBalancerGPU(std::shared_ptr<SystemDefinition> sysdef,
                                  std::shared_ptr<Trigger> trigger)
     : LoadBalancer(sysdef, trigger)
     {
-    // allocate data connected to the maximum number of particles
-    m_pdata->getMaxParticleNumberChangeSignal()
-        .connect<LoadBalancerGPU, &LoadBalancerGPU::slotMaxNumChanged>(this);
-
-    GPUArray<unsigned int> off_ranks(m_pdata->getMaxN(), m_exec_conf);
-    m_off_ranks.swap(off_ranks);
+    // at most 26 unique neighbors, grown on demand
+    GPUArray<unsigned int> off_rank_counts(26, m_exec_conf);
+    m_off_rank_counts.swap(off_rank_counts);
 
     m_tuner.reset(new Autotuner(32, 1024, 32, 5, 100000, "load_balance", this->m_exec_conf));
     }
 
-LoadBalancerGPU::~LoadBalancerGPU()
-    {
-    // disconnect from the signal
-    m_pdata->getMaxParticleNumberChangeSignal()
-        .disconnect<LoadBalancerGPU, &LoadBalancerGPU::slotMaxNumChanged>(this);
-    }
+LoadBalancerGPU::~LoadBalancerGPU() { }
 
 #ifdef ENABLE_MPI
 void LoadBalancerGPU::countParticlesOffRank(std::map<unsigned int, unsigned int>& cnts)
@@ -50,61 +42,51 @@ void LoadBalancerGPU::countParticlesOffRank(std::map<unsigned int, unsigned int>
     if (m_pdata->getN() == 0)
         return;
 
-    // mark the current ranks of each particle (hijack the comm flags array)
+    const unsigned int n_unique_neigh = m_comm->getNUniqueNeighbors();
+    if (m_off_rank_counts.getNumElements() < n_unique_neigh)
+        m_off_rank_counts.resize(n_unique_neigh);
+
+    // histogram the particles that left the rank over the unique neighbors on the device
         {
-        ArrayHandle<unsigned int> d_comm_flag(m_pdata->getCommFlags(),
-                                              access_location::device,
-                                              access_mode::overwrite);
+        ArrayHandle<unsigned int> d_off_rank_counts(m_off_rank_counts,
+                                                    access_location::device,
+                                                    access_mode::overwrite);
         ArrayHandle<Scalar4> d_pos(m_pdata->getPositions(),
                                    access_location::device,
                                    access_mode::read);
         ArrayHandle<unsigned int> d_cart_ranks(m_decomposition->getCartRanks(),
                                                access_location::device,
                                                access_mode::read);
+        ArrayHandle<unsigned int> d_unique_neigh(m_comm->getUniqueNeighbors(),
+                                                 access_location::device,
+                                                 access_mode::read);
 
         m_tuner->begin();
-        gpu_load_balance_mark_rank(d_comm_flag.data,
-                                   d_pos.data,
-                                   d_cart_ranks.data,
-                                   m_decomposition->getGridPos(),
-                                   m_pdata->getBox(),
-                                   m_decomposition->getDomainIndexer(),
-                                   m_pdata->getN(),
-                                   m_tuner->getParam());
+        gpu_load_balance_count_off_rank(d_off_rank_counts.data,
+                                        d_pos.data,
+                                        d_cart_ranks.data,
+                                        d_unique_neigh.data,
+                                        m_decomposition->getGridPos(),
+                                        m_pdata->getBox(),
+                                        m_decomposition->getDomainIndexer(),
+                                        m_pdata->getN(),
+                                        n_unique_neigh,
+                                        m_tuner->getParam());
         if (m_exec_conf->isCUDAErrorCheckingEnabled())
             CHECK_CUDA_ERROR();
         m_tuner->end();
         }
 
-    // select the particles that should be sent to other ranks
-    vector<unsigned int> off_rank;
-        {
-        ArrayHandle<unsigned int> d_comm_flag(m_pdata->getCommFlags(),
-                                              access_location::device,
-                                              access_mode::read);
-        ArrayHandle<unsigned int> d_off_ranks(m_off_ranks,
-                                              access_location::device,
-                                              access_mode::overwrite);
-
-        // size the temporary storage
-        const unsigned int n_off_rank = gpu_load_balance_select_off_rank(d_off_ranks.data,
-                                                                         d_comm_flag.data,
-                                                                         m_pdata->getN(),
-                                                                         m_exec_conf->getRank());
-
-        // copy just the subset of particles that are off rank on the device into host memory
-        // this can save substantially on the memcpy if there are many particles on a rank
-        off_rank.resize(n_off_rank);
-        hipMemcpy(&off_rank[0],
-                  d_off_ranks.data,
-                  sizeof(unsigned int) * n_off_rank,
-                  hipMemcpyDeviceToHost);
-        }
-
-    // perform the counting on the host
-    for (unsigned int cur_p = 0; cur_p < off_rank.size(); ++cur_p)
+    // only the histogram is copied back to the host
+    ArrayHandle<unsigned int> h_off_rank_counts(m_off_rank_counts,
+                                                access_location::host,
+                                                access_mode::read);
+    ArrayHandle<unsigned int> h_unique_neigh(m_comm->getUniqueNeighbors(),
+                                             access_location::host,
+                                             access_mode::read);
+    for (unsigned int cur_neigh = 0; cur_neigh < n_unique_neigh; ++cur_neigh)
         {
-        cnts[off_rank[cur_p]]++;
+        cnts[h_unique_neigh.data[cur_neigh]] += h_off_rank_counts.data[cur_neigh];
         }
     }
 #endif // ENABLE_MPI
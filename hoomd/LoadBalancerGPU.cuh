@@ -12,19 +12,15 @@
 #include "Index1D.h"
 #include "ParticleData.cuh"
 
-//! Kernel drive to mark the current rank of each particle
-void gpu_load_balance_mark_rank(unsigned int* d_ranks,
-                                const Scalar4* d_pos,
-                                const unsigned int* d_cart_ranks,
-                                const uint3 rank_pos,
-                                const BoxDim& box,
-                                const Index3D& di,
-                                const unsigned int N,
-                                const unsigned int block_size);
-
-//! thrust driver to select the particles that are off rank
-unsigned int gpu_load_balance_select_off_rank(unsigned int* d_off_rank,
-                                              unsigned int* d_ranks,
-                                              const unsigned int N,
-                                              const unsigned int cur_rank);
+//! Kernel driver to count the particles that are off rank per neighboring rank
+void gpu_load_balance_count_off_rank(unsigned int* d_off_rank_counts,
+                                     const Scalar4* d_pos,
+                                     const unsigned int* d_cart_ranks,
+                                     const unsigned int* d_unique_neigh,
+                                     const uint3 rank_pos,
+                                     const BoxDim& box,
+                                     const Index3D& di,
+                                     const unsigned int N,
+                                     const unsigned int n_unique_neigh,
+                                     const unsigned int block_size);
 #endif // ENABLE_MPI
@@ -45,13 +45,6 @@ class PYBIND11_EXPORT LoadBalancerGPU : public LoadBalancer
         m_tuner->setEnabled(enable);
         }
 
-    //! Resize the per particle data when there is a max number of particle change
-    void slotMaxNumChanged()
-        {
-        GPUArray<unsigned int> off_ranks(m_pdata->getMaxN(), m_exec_conf);
-        m_off_ranks.swap(off_ranks);
-        }
-
     protected:
 #ifdef ENABLE_MPI
     //! Count the number of particles that have gone off either edge of the rank along a dimension
@@ -60,8 +53,8 @@ class PYBIND11_EXPORT LoadBalancerGPU : public LoadBalancer
 #endif
 
     private:
-    std::unique_ptr<Autotuner> m_tuner; //!< Autotuner for block size counting particles
-    GPUArray<unsigned int> m_off_ranks; //!< Array to hold the ranks of particles that have moved
+    std::unique_ptr<Autotuner> m_tuner;      //!< Autotuner for block size counting particles
+    GPUArray<unsigned int> m_off_rank_counts; //!< Number of particles moved to each neighbor
     };
 
 //! Export the LoadBalancerGPU to python
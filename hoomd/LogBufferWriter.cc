@@ -0,0 +1,346 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file LogBufferWriter.cc
+    \brief Defines the LogBufferWriter class
+*/
+
+#include "LogBufferWriter.h"
+#include "GSD.h"
+#include "HOOMDVersion.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+
+#include <pybind11/stl.h>
+
+namespace py = pybind11;
+
+using namespace std;
+
+/*! \param sysdef System definition
+    \param capacity Maximum number of rows to buffer
+    \param filename File to write, empty to buffer the rows for Python
+    \param format File format, "text" or "gsd"
+    \param delimiter Column delimiter in the file
+    \param precision Number of significant digits in the file
+*/
+LogBufferWriter::LogBufferWriter(std::shared_ptr<SystemDefinition> sysdef,
+                                 unsigned int capacity,
+                                 const std::string& filename,
+                                 const std::string& format,
+                                 const std::string& delimiter,
+                                 unsigned int precision)
+    : Analyzer(sysdef), m_capacity(capacity), m_filename(filename), m_gsd(format == "gsd"),
+      m_delimiter(delimiter), m_precision(precision), m_bound(false), m_first_row(0),
+      m_num_rows(0), m_num_dropped(0), m_header_written(false), m_gsd_open(false)
+    {
+    m_exec_conf->msg->notice(5) << "Constructing LogBufferWriter" << endl;
+
+    if (m_capacity == 0)
+        {
+        throw runtime_error("capacity must be greater than 0");
+        }
+    if (format != "text" && format != "gsd")
+        {
+        throw invalid_argument("Invalid log file format: " + format);
+        }
+
+    if (!m_filename.empty() && m_exec_conf->isRoot())
+        {
+        if (m_gsd)
+            {
+            ostringstream o;
+            o << "HOOMD-blue " << HOOMD_VERSION;
+            int retval = gsd_create_and_open(&m_handle,
+                                             m_filename.c_str(),
+                                             o.str().c_str(),
+                                             "hoomd",
+                                             gsd_make_version(1, 4),
+                                             GSD_OPEN_APPEND,
+                                             0);
+            hoomd::detail::GSDUtils::checkError(retval, m_filename);
+            m_gsd_open = true;
+            }
+        else
+            {
+            m_file.open(m_filename.c_str(), ios::out | ios::trunc);
+            if (!m_file.good())
+                {
+                throw runtime_error("Error opening log file " + m_filename);
+                }
+            }
+        }
+    }
+
+LogBufferWriter::~LogBufferWriter()
+    {
+    m_exec_conf->msg->notice(5) << "Destroying LogBufferWriter" << endl;
+
+    if (!m_filename.empty())
+        {
+        try
+            {
+            flush();
+            }
+        catch (const std::exception& e)
+            {
+            m_exec_conf->msg->error() << e.what() << endl;
+            }
+        }
+    m_writer.stop();
+
+    if (m_gsd_open)
+        gsd_close(&m_handle);
+    }
+
+/*! \param label Column label
+    \param operation Python operation that provides the quantity
+    \param name Name of the loggable property of \a operation
+*/
+void LogBufferWriter::addQuantity(const std::string& label,
+                                  pybind11::object operation,
+                                  const std::string& name)
+    {
+    if (m_num_rows > 0)
+        {
+        throw runtime_error("Cannot add quantities to a buffer that holds rows");
+        }
+
+    m_labels.push_back(label);
+    m_operations.push_back(operation);
+    m_names.push_back(name);
+    m_bound = false;
+    m_buffer.clear();
+    }
+
+/*! Operations attach their C++ objects in the order of the operation lists, so the quantities are
+    resolved on the first call to analyze() rather than when the writer attaches.
+*/
+void LogBufferWriter::bindQuantities()
+    {
+    m_computes.clear();
+    m_getters.clear();
+
+    for (size_t i = 0; i < m_operations.size(); i++)
+        {
+        py::object cpp_obj = m_operations[i].attr("_cpp_obj");
+        std::shared_ptr<Compute> compute = cpp_obj.cast<std::shared_ptr<Compute>>();
+        std::function<Scalar()> getter = compute->getLogScalar(m_names[i]);
+        if (!getter)
+            {
+            throw runtime_error("Quantity " + m_labels[i] + " cannot be sampled natively");
+            }
+
+        if (std::find(m_computes.begin(), m_computes.end(), compute) == m_computes.end())
+            m_computes.push_back(compute);
+        m_getters.push_back(getter);
+        }
+
+    m_buffer.resize(size_t(m_capacity) * getNumColumns());
+    m_bound = true;
+    }
+
+/*! \param timestep Current time step of the simulation
+ */
+void LogBufferWriter::analyze(uint64_t timestep)
+    {
+    Analyzer::analyze(timestep);
+
+    if (!m_bound)
+        bindQuantities();
+
+    if (m_prof)
+        m_prof->push("Log buffer");
+
+    // computes skip the work when they have already computed this step
+    for (auto& compute : m_computes)
+        compute->compute(timestep);
+
+    if (m_num_rows == m_capacity)
+        {
+        if (!m_filename.empty())
+            {
+            writeBatch();
+            }
+        else
+            {
+            // overwrite the oldest row
+            m_first_row = (m_first_row + 1) % m_capacity;
+            m_num_rows--;
+            m_num_dropped++;
+            }
+        }
+
+    const unsigned int num_columns = getNumColumns();
+    double* row = &m_buffer[size_t((m_first_row + m_num_rows) % m_capacity) * num_columns];
+    row[0] = double(timestep);
+    for (unsigned int i = 0; i < m_getters.size(); i++)
+        row[i + 1] = double(m_getters[i]());
+    m_num_rows++;
+
+    if (m_prof)
+        m_prof->pop();
+    }
+
+std::vector<double> LogBufferWriter::takeRows()
+    {
+    const unsigned int num_columns = getNumColumns();
+    std::vector<double> rows(size_t(m_num_rows) * num_columns);
+    for (unsigned int i = 0; i < m_num_rows; i++)
+        {
+        const double* row = &m_buffer[size_t((m_first_row + i) % m_capacity) * num_columns];
+        std::copy(row, row + num_columns, rows.begin() + size_t(i) * num_columns);
+        }
+
+    m_first_row = 0;
+    m_num_rows = 0;
+    return rows;
+    }
+
+void LogBufferWriter::writeBatch()
+    {
+    auto rows = std::make_shared<std::vector<double>>(takeRows());
+    if (!m_exec_conf->isRoot() || rows->empty())
+        return;
+
+    if (m_gsd)
+        {
+        m_writer.enqueue([this, rows]() { writeGSD(*rows); });
+        return;
+        }
+
+    std::vector<std::string> header;
+    if (!m_header_written)
+        {
+        header = getLabels();
+        m_header_written = true;
+        }
+    m_writer.enqueue([this, rows, header]() { writeText(*rows, header); });
+    }
+
+/*! \param rows Rows to write
+    \param header Column labels, empty when the header has already been written
+*/
+void LogBufferWriter::writeText(const std::vector<double>& rows,
+                                const std::vector<std::string>& header)
+    {
+    const unsigned int num_columns = getNumColumns();
+
+    // format the whole batch and write it at once
+    std::ostringstream out;
+    out << std::setprecision(m_precision);
+    for (size_t i = 0; i < header.size(); i++)
+        out << (i > 0 ? m_delimiter : "") << header[i];
+    if (!header.empty())
+        out << '\n';
+
+    for (size_t i = 0; i < rows.size(); i += num_columns)
+        {
+        out << uint64_t(rows[i]);
+        for (unsigned int j = 1; j < num_columns; j++)
+            out << m_delimiter << rows[i + j];
+        out << '\n';
+        }
+
+    const std::string text = out.str();
+    m_file.write(text.data(), text.size());
+    m_file.flush();
+    if (!m_file.good())
+        throw runtime_error("Error writing log file " + m_filename);
+    }
+
+/*! \param rows Rows to write
+
+    The frame holds the batch column by column, so readers can concatenate the chunks of all frames
+    to obtain the time series. configuration/step is the last time step in the batch.
+*/
+void LogBufferWriter::writeGSD(const std::vector<double>& rows)
+    {
+    const unsigned int num_columns = getNumColumns();
+    const uint64_t num_rows = rows.size() / num_columns;
+
+    std::vector<uint64_t> timesteps(num_rows);
+    for (uint64_t i = 0; i < num_rows; i++)
+        timesteps[i] = uint64_t(rows[i * num_columns]);
+
+    int retval = gsd_write_chunk(&m_handle,
+                                 "configuration/step",
+                                 GSD_TYPE_UINT64,
+                                 1,
+                                 1,
+                                 0,
+                                 &timesteps.back());
+    hoomd::detail::GSDUtils::checkError(retval, m_filename);
+    retval = gsd_write_chunk(&m_handle,
+                             "log/timestep",
+                             GSD_TYPE_UINT64,
+                             num_rows,
+                             1,
+                             0,
+                             timesteps.data());
+    hoomd::detail::GSDUtils::checkError(retval, m_filename);
+
+    std::vector<double> column(num_rows);
+    for (unsigned int j = 1; j < num_columns; j++)
+        {
+        for (uint64_t i = 0; i < num_rows; i++)
+            column[i] = rows[i * num_columns + j];
+
+        std::string name = "log/" + m_labels[j - 1];
+        std::replace(name.begin(), name.end(), '.', '/');
+        retval = gsd_write_chunk(&m_handle,
+                                 name.c_str(),
+                                 GSD_TYPE_DOUBLE,
+                                 num_rows,
+                                 1,
+                                 0,
+                                 column.data());
+        hoomd::detail::GSDUtils::checkError(retval, m_filename);
+        }
+
+    retval = gsd_end_frame(&m_handle);
+    hoomd::detail::GSDUtils::checkError(retval, m_filename);
+    }
+
+/*! Writes the buffered rows and waits for the background thread. Rows are buffered for Python when
+    there is no file.
+*/
+void LogBufferWriter::flush()
+    {
+    if (m_filename.empty())
+        return;
+
+    writeBatch();
+    m_writer.flush();
+    }
+
+/*! \returns Array with one row per sample, the time step followed by the quantities
+ */
+pybind11::array_t<double> LogBufferWriter::fetch()
+    {
+    const size_t num_columns = getNumColumns();
+    std::vector<double> rows = takeRows();
+    pybind11::array_t<double> result({rows.size() / num_columns, num_columns});
+    std::copy(rows.begin(), rows.end(), result.mutable_data());
+    return result;
+    }
+
+void export_LogBufferWriter(py::module& m)
+    {
+    py::class_<LogBufferWriter, Analyzer, std::shared_ptr<LogBufferWriter>>(m, "LogBufferWriter")
+        .def(py::init<std::shared_ptr<SystemDefinition>,
+                      unsigned int,
+                      const std::string&,
+                      const std::string&,
+                      const std::string&,
+                      unsigned int>())
+        .def("addQuantity", &LogBufferWriter::addQuantity)
+        .def("flush", &LogBufferWriter::flush)
+        .def("fetch", &LogBufferWriter::fetch)
+        .def_property_readonly("labels", &LogBufferWriter::getLabels)
+        .def_property_readonly("capacity", &LogBufferWriter::getCapacity)
+        .def_property_readonly("num_dropped", &LogBufferWriter::getNumDropped);
+    }
@@ -0,0 +1,145 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#ifndef __LOG_BUFFER_WRITER_H__
+#define __LOG_BUFFER_WRITER_H__
+
+#include "Analyzer.h"
+#include "BackgroundWriter.h"
+#include "Compute.h"
+#include "hoomd/extern/gsd.h"
+
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+/*! \file LogBufferWriter.h
+    \brief Declares the LogBufferWriter class
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include <pybind11/numpy.h>
+#include <pybind11/pybind11.h>
+
+//! Sample scalar loggable quantities into a buffer without calling into Python
+/*! Each quantity is identified by a Python operation and the name of one of its loggable
+    properties. The first call to analyze() resolves the quantities to functions provided by
+    Compute::getLogScalar() of the operations' C++ objects. After that, analyze() calls compute()
+    on each distinct Compute and appends one row (the time step followed by the values) to the
+    buffer, without acquiring Python objects or formatting values.
+
+    Without a file name, the buffer is a ring of \a capacity rows: the oldest rows are overwritten
+    until Python calls fetch(), which returns and clears the buffered rows. With a file name, full
+    buffers are written to the file as one batch on a background thread, and flush() writes the
+    remaining rows at the end of every run. Only the root rank writes the file.
+
+    The "text" format writes one delimited line per row after a header line of labels. The "gsd"
+    format writes one GSD frame per batch with columnar chunks: log/timestep and one
+    log/<label> chunk per quantity (with '.' in the label replaced by '/'), each holding one value
+    per row of the batch.
+
+    \ingroup analyzers
+*/
+class PYBIND11_EXPORT LogBufferWriter : public Analyzer
+    {
+    public:
+    //! Construct the writer
+    LogBufferWriter(std::shared_ptr<SystemDefinition> sysdef,
+                    unsigned int capacity,
+                    const std::string& filename,
+                    const std::string& format,
+                    const std::string& delimiter,
+                    unsigned int precision);
+
+    //! Destructor
+    ~LogBufferWriter();
+
+    //! Add a quantity to sample
+    void addQuantity(const std::string& label, pybind11::object operation, const std::string& name);
+
+    //! Sample the quantities at the current timestep
+    void analyze(uint64_t timestep);
+
+    //! Write the buffered rows to the file
+    void flush();
+
+    //! Get the buffered rows and clear the buffer
+    pybind11::array_t<double> fetch();
+
+    //! Get the column labels, starting with the timestep
+    std::vector<std::string> getLabels() const
+        {
+        std::vector<std::string> labels = {"timestep"};
+        labels.insert(labels.end(), m_labels.begin(), m_labels.end());
+        return labels;
+        }
+
+    //! Get the maximum number of buffered rows
+    unsigned int getCapacity() const
+        {
+        return m_capacity;
+        }
+
+    //! Get the number of rows overwritten before they were fetched
+    uint64_t getNumDropped() const
+        {
+        return m_num_dropped;
+        }
+
+    private:
+    unsigned int m_capacity;  //!< Maximum number of rows in the buffer
+    std::string m_filename;   //!< File to write, empty to buffer rows for Python
+    bool m_gsd;               //!< True when writing the GSD format
+    std::string m_delimiter;  //!< Column delimiter in the file
+    unsigned int m_precision; //!< Number of significant digits in the file
+
+    std::vector<std::string> m_labels;          //!< Label of each quantity
+    std::vector<pybind11::object> m_operations; //!< Python operation providing each quantity
+    std::vector<std::string> m_names;           //!< Name of each quantity in its operation
+
+    bool m_bound;                                     //!< True when the quantities are resolved
+    std::vector<std::shared_ptr<Compute>> m_computes; //!< Distinct computes to update
+    std::vector<std::function<Scalar()>> m_getters;   //!< Function evaluating each quantity
+
+    std::vector<double> m_buffer; //!< Ring buffer of rows
+    unsigned int m_first_row;     //!< Index of the oldest row in the ring
+    unsigned int m_num_rows;      //!< Number of rows in the ring
+    uint64_t m_num_dropped;       //!< Number of rows overwritten before they were fetched
+
+    std::ofstream m_file;                     //!< Output text file
+    bool m_header_written;                    //!< True when the text file has a header
+    gsd_handle m_handle;                      //!< Output GSD file
+    bool m_gsd_open;                          //!< True when m_handle is open
+    hoomd::detail::BackgroundWriter m_writer; //!< Writes batches to the file
+
+    //! Resolve the quantities to functions of the C++ computes
+    void bindQuantities();
+
+    //! Number of values in a row
+    unsigned int getNumColumns() const
+        {
+        return (unsigned int)m_labels.size() + 1;
+        }
+
+    //! Copy the buffered rows in order and clear the buffer
+    std::vector<double> takeRows();
+
+    //! Write the buffered rows to the file on the background thread
+    void writeBatch();
+
+    //! Write rows to the text file
+    void writeText(const std::vector<double>& rows, const std::vector<std::string>& header);
+
+    //! Write rows to the GSD file as one frame
+    void writeGSD(const std::vector<double>& rows);
+    };
+
+//! Exports the LogBufferWriter class to python
+void export_LogBufferWriter(pybind11::module& m);
+
+#endif
@@ -94,6 +94,7 @@ void export_MPIConfiguration(pybind11::module& m)
         .def("getNRanks", &MPIConfiguration::getNRanks)
         .def("getRank", &MPIConfiguration::getRank)
         .def("barrier", &MPIConfiguration::barrier)
+        .def("allReduceMax", &MPIConfiguration::allReduceMax)
         .def("getNRanksGlobal", &MPIConfiguration::getNRanksGlobal)
         .def("getRankGlobal", &MPIConfiguration::getRankGlobal)
 #ifdef ENABLE_MPI
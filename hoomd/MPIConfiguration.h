@@ -128,6 +128,19 @@ class PYBIND11_EXPORT MPIConfiguration
 #endif
         }
 
+    //! Get the largest value over the ranks in this partition
+    /*! \param value Value on this rank
+
+        Tuners that act on timings call this so that every rank makes the same choice.
+    */
+    double allReduceMax(double value) const
+        {
+#ifdef ENABLE_MPI
+        MPI_Allreduce(MPI_IN_PLACE, &value, 1, MPI_DOUBLE, MPI_MAX, m_mpi_comm);
+#endif
+        return value;
+        }
+
     protected:
 #ifdef ENABLE_MPI
     MPI_Comm m_mpi_comm;    //!< The MPI communicator
@@ -24,13 +24,22 @@ void MemoryTraceback::registerAllocation(const void* ptr,
                                          const std::string& type_hint,
                                          const std::string& tag) const
     {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
     // insert element into list of allocations
     std::pair<const void*, size_t> idx = std::make_pair(ptr, nbytes);
 
-    m_traces[idx] = std::vector<void*>(MAX_TRACEBACK, nullptr);
     m_type_hints[idx] = type_hint;
     m_tags[idx] = tag;
 
+    if (!m_backtrace)
+        {
+        m_traces[idx] = std::vector<void*>();
+        return;
+        }
+
+    m_traces[idx] = std::vector<void*>(MAX_TRACEBACK, nullptr);
+
     // obtain a traceback
     int num_symbols = backtrace(&m_traces[idx].front(), MAX_TRACEBACK);
 
@@ -39,6 +48,8 @@ void MemoryTraceback::registerAllocation(const void* ptr,
 
 void MemoryTraceback::unregisterAllocation(const void* ptr, size_t nbytes) const
     {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
     // remove element from list of allocations
     std::pair<const void*, size_t> idx = std::make_pair(ptr, nbytes);
 
@@ -49,12 +60,95 @@ void MemoryTraceback::unregisterAllocation(const void* ptr, size_t nbytes) const
 
 void MemoryTraceback::updateTag(const void* ptr, size_t nbytes, const std::string& tag) const
     {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
     std::pair<const void*, size_t> idx = std::make_pair(ptr, nbytes);
 
     if (m_tags.find(idx) != m_tags.end())
         m_tags[idx] = tag;
     }
 
+std::map<std::string, size_t> MemoryTraceback::getReport() const
+    {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    std::map<std::string, size_t> report;
+    for (auto it_tag = m_tags.begin(); it_tag != m_tags.end(); ++it_tag)
+        {
+        const std::string& tag = it_tag->second.empty() ? std::string("untagged") : it_tag->second;
+        report[tag] += it_tag->first.second;
+        }
+    return report;
+    }
+
+size_t MemoryTraceback::getTotalBytes() const
+    {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    size_t nbytes_tot = 0;
+    for (auto it_tag = m_tags.begin(); it_tag != m_tags.end(); ++it_tag)
+        nbytes_tot += it_tag->first.second;
+    return nbytes_tot;
+    }
+
+//! Maximum number of stack frames searched for the function that acquired an array
+#define MAX_TRANSFER_TRACEBACK 16
+
+//! Find the first function on the stack outside of the array classes
+static std::string find_array_caller()
+    {
+    void* trace[MAX_TRANSFER_TRACEBACK];
+    int num_symbols = backtrace(trace, MAX_TRANSFER_TRACEBACK);
+
+    for (int i = 1; i < num_symbols; ++i)
+        {
+        Dl_info info;
+        if (!dladdr(trace[i], &info) || !info.dli_sname)
+            continue;
+
+        int status = -1;
+        char* demangled = abi::__cxa_demangle(info.dli_sname, NULL, 0, &status);
+        std::string name = (status == 0) ? std::string(demangled) : std::string(info.dli_sname);
+        if (status == 0)
+            free(demangled);
+
+        if (name.find("MemoryTraceback") == std::string::npos
+            && name.find("GPUArray") == std::string::npos
+            && name.find("GlobalArray") == std::string::npos
+            && name.find("ArrayHandle") == std::string::npos)
+            return name;
+        }
+    return std::string("unknown");
+    }
+
+void MemoryTraceback::recordTransfer(const std::string& tag, size_t nbytes, bool to_host) const
+    {
+    if (!m_transfer_tracing)
+        return;
+
+    std::string key = tag.empty() ? std::string("untagged") : tag;
+    key += to_host ? " device->host" : " host->device";
+    if (m_backtrace)
+        key += " in " + find_array_caller();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::pair<size_t, size_t>& transfer = m_transfers[key];
+    transfer.first++;
+    transfer.second += nbytes;
+    }
+
+std::map<std::string, std::pair<size_t, size_t>> MemoryTraceback::getTransferReport() const
+    {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_transfers;
+    }
+
+void MemoryTraceback::resetTransferReport() const
+    {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_transfers.clear();
+    }
+
 //! Pretty print number of bytes
 inline std::string pretty_bytes(size_t bytes)
     {
@@ -82,6 +176,8 @@ inline std::string pretty_bytes(size_t bytes)
 
 void MemoryTraceback::outputTraces(std::shared_ptr<Messenger> msg) const
     {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
     // reduce total memory
     unsigned long int nbytes_tot = 0;
 
@@ -90,7 +186,7 @@ void MemoryTraceback::outputTraces(std::shared_ptr<Messenger> msg) const
         nbytes_tot += it_trace->first.second;
         }
 
-    msg->notice(2) << "Total amount of managed memory allocated through Global[Array,Vector]: "
+    msg->notice(2) << "Total amount of memory allocated through GlobalArray and GPUArray: "
                    << pretty_bytes(nbytes_tot) << std::endl;
     msg->notice(2)
         << "Actual allocation sizes may be larger by up to the OS page size due to alignment."
@@ -119,8 +215,12 @@ void MemoryTraceback::outputTraces(std::shared_ptr<Messenger> msg) const
             oss << " [" << m_tags[it_trace->first] << "]";
         msg->notice(2) << oss.str() << std::endl;
 
-        // translate symbol addresses into array of strings
+        // allocations made while stack traces were disabled have no trace
         size_t size = it_trace->second.size();
+        if (size == 0)
+            continue;
+
+        // translate symbol addresses into array of strings
         char** symbols = backtrace_symbols(&it_trace->second.front(), (unsigned int)size);
 
         if (!symbols)
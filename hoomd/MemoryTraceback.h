@@ -10,14 +10,24 @@
 */
 
 #include <map>
+#include <mutex>
 
 #include "Messenger.h"
 
 #include <pybind11/pybind11.h>
 
+/*! MemoryTraceback keeps a table of all allocations made through GlobalArray and GPUArray. The
+    table is cheap to maintain and always available, so getReport() can account for the memory held
+    by each tagged array. Stack traces are only recorded when requested with setBacktrace().
+*/
 class PYBIND11_EXPORT MemoryTraceback
     {
     public:
+    //! Constructor
+    /*! \param backtrace Set to true to record a stack trace with every allocation
+     */
+    MemoryTraceback(bool backtrace = true) : m_backtrace(backtrace), m_transfer_tracing(false) { }
+
     //! Register a memory allocation along with a stacktrace
     /*! \param ptr The pointer to the memory address being allocated
         \param nbytes The size of the allocation in bytes
@@ -42,11 +52,66 @@ class PYBIND11_EXPORT MemoryTraceback
      */
     void updateTag(const void* ptr, size_t nbytes, const std::string& tag) const;
 
+    //! Set whether to record stack traces for new allocations
+    void setBacktrace(bool backtrace)
+        {
+        m_backtrace = backtrace;
+        }
+
+    //! Get whether stack traces are recorded for new allocations
+    bool getBacktrace() const
+        {
+        return m_backtrace;
+        }
+
+    //! Get the number of bytes held by each tag
+    /*! Allocations without a tag are summed under "untagged".
+     */
+    std::map<std::string, size_t> getReport() const;
+
+    //! Get the total number of bytes in all registered allocations
+    size_t getTotalBytes() const;
+
+    //! Record a copy of an array between the host and the device
+    /*! \param tag Name of the array
+        \param nbytes Number of bytes copied
+        \param to_host True for a device to host copy
+
+        Does nothing unless transfer tracing is enabled. When stack traces are also enabled, the
+        function that acquired the array is recorded with the copy.
+     */
+    void recordTransfer(const std::string& tag, size_t nbytes, bool to_host) const;
+
+    //! Set whether to record the copies between the host and the device
+    void setTransferTracing(bool enable)
+        {
+        m_transfer_tracing = enable;
+        }
+
+    //! Get whether the copies between the host and the device are recorded
+    bool getTransferTracing() const
+        {
+        return m_transfer_tracing;
+        }
+
+    //! Get the number of copies and the number of bytes copied for each array and direction
+    /*! The counts accumulate from the time transfer tracing is enabled.
+     */
+    std::map<std::string, std::pair<size_t, size_t>> getTransferReport() const;
+
+    //! Clear the recorded copies
+    void resetTransferReport() const;
+
     private:
+    bool m_backtrace;           //!< True when stack traces are recorded
+    bool m_transfer_tracing;    //!< True when copies between host and device are recorded
+    mutable std::mutex m_mutex; //!< Protects the tables from concurrent access
     mutable std::map<std::pair<const void*, size_t>, std::vector<void*>>
         m_traces; //!< A stacktrace per memory allocation
     mutable std::map<std::pair<const void*, size_t>, std::string>
         m_type_hints; //!< Types of memory allocations
     mutable std::map<std::pair<const void*, size_t>, std::string>
         m_tags; //!< Tags of memory allocations
+    mutable std::map<std::string, std::pair<size_t, size_t>>
+        m_transfers; //!< Number of copies and bytes copied per array and direction
     };
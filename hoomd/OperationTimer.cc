@@ -0,0 +1,92 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file OperationTimer.cc
+    \brief Defines the OperationTimer class
+*/
+
+#include "OperationTimer.h"
+
+#include <algorithm>
+
+OperationTimer::OperationTimer(std::shared_ptr<const ExecutionConfiguration> exec_conf)
+    : m_exec_conf(exec_conf)
+    {
+    }
+
+OperationTimer::~OperationTimer()
+    {
+#ifdef ENABLE_HIP
+    if (m_use_events)
+        {
+        hipEventDestroy(m_start_event);
+        hipEventDestroy(m_stop_event);
+        }
+#endif
+    }
+
+void OperationTimer::start()
+    {
+    collect();
+
+#ifdef ENABLE_HIP
+    if (m_exec_conf->isCUDAEnabled())
+        {
+        // most operations are never timed on the device, create the events on first use
+        if (!m_use_events)
+            {
+            hipEventCreate(&m_start_event);
+            hipEventCreate(&m_stop_event);
+            m_use_events = true;
+            }
+        hipEventRecord(m_start_event, 0);
+        }
+#endif
+
+    m_host_start = m_clk.getTime();
+    }
+
+void OperationTimer::stop()
+    {
+    m_host_elapsed = m_clk.getTime() - m_host_start;
+
+#ifdef ENABLE_HIP
+    if (m_use_events)
+        hipEventRecord(m_stop_event, 0);
+#endif
+
+    m_pending = true;
+    }
+
+void OperationTimer::reset()
+    {
+    m_pending = false;
+    m_total = 0.0;
+    }
+
+double OperationTimer::getTime()
+    {
+    collect();
+    return m_total;
+    }
+
+void OperationTimer::collect()
+    {
+    if (!m_pending)
+        return;
+
+    double elapsed = double(m_host_elapsed) * 1e-9;
+
+#ifdef ENABLE_HIP
+    if (m_use_events)
+        {
+        float device_ms = 0;
+        hipEventSynchronize(m_stop_event);
+        hipEventElapsedTime(&device_ms, m_start_event, m_stop_event);
+        elapsed = std::max(elapsed, double(device_ms) * 1e-3);
+        }
+#endif
+
+    m_total += elapsed;
+    m_pending = false;
+    }
@@ -0,0 +1,103 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file OperationTimer.h
+    \brief Declares the OperationTimer class
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#pragma once
+
+#include "ClockSource.h"
+#include "ExecutionConfiguration.h"
+
+#ifdef ENABLE_HIP
+#include <hip/hip_runtime.h>
+#endif
+
+#include <memory>
+
+//! Measures the time an operation spends executing during a run
+/*! System, ForceCompute, and NeighborList call start() and stop() around every execution of an
+    operation and System calls reset() at the start of each run. getTime() returns the total time
+    since the last reset.
+
+    On the GPU, most of the work of an operation runs after the host returns from it, so each
+    execution is also bracketed by a pair of events in the default stream. The elapsed time between
+    the events is read when the operation starts again (by which time they have almost always
+    completed) or when getTime() is called, so the timer does not synchronize the GPU every step.
+    Each execution counts as the longer of its host and device time. This covers operations limited
+    by host work as well as those limited by kernels.
+*/
+class PYBIND11_EXPORT OperationTimer
+    {
+    public:
+    //! Construct the timer
+    /*! \param exec_conf Execution configuration
+     */
+    OperationTimer(std::shared_ptr<const ExecutionConfiguration> exec_conf);
+
+    //! Destroy the timer
+    ~OperationTimer();
+
+    OperationTimer(const OperationTimer&) = delete;
+    OperationTimer& operator=(const OperationTimer&) = delete;
+
+    //! Mark the start of an execution
+    void start();
+
+    //! Mark the end of an execution
+    void stop();
+
+    //! Discard the accumulated time
+    void reset();
+
+    //! Get the total time in seconds since the last reset
+    double getTime();
+
+    private:
+    std::shared_ptr<const ExecutionConfiguration> m_exec_conf; //!< Execution configuration
+    ClockSource m_clk;                                         //!< Host clock
+
+    int64_t m_host_start = 0;   //!< Host time at the start of the current execution
+    int64_t m_host_elapsed = 0; //!< Host time of the pending execution
+    bool m_pending = false;     //!< True when an execution has not been added to m_total
+    double m_total = 0.0;       //!< Total time since the last reset
+
+#ifdef ENABLE_HIP
+    hipEvent_t m_start_event;  //!< Event recorded at the start of an execution
+    hipEvent_t m_stop_event;   //!< Event recorded at the end of an execution
+    bool m_use_events = false; //!< True when the events have been created
+#endif
+
+    //! Add the pending execution to the total
+    void collect();
+    };
+
+//! Times the enclosing scope with an OperationTimer
+class ScopedOperationTimer
+    {
+    public:
+    //! Start the timer
+    /*! \param timer Timer to start
+     */
+    explicit ScopedOperationTimer(OperationTimer& timer) : m_timer(timer)
+        {
+        m_timer.start();
+        }
+
+    //! Stop the timer
+    ~ScopedOperationTimer()
+        {
+        m_timer.stop();
+        }
+
+    ScopedOperationTimer(const ScopedOperationTimer&) = delete;
+    ScopedOperationTimer& operator=(const ScopedOperationTimer&) = delete;
+
+    private:
+    OperationTimer& m_timer; //!< The timer
+    };
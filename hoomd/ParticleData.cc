@@ -21,10 +21,13 @@
 
 #include <pybind11/numpy.h>
 #include <pybind11/operators.h>
+#include <pybind11/stl.h>
 
+#include <algorithm>
 #include <cassert>
 #include <iomanip>
 #include <iostream>
+#include <limits>
 #include <sstream>
 #include <stdexcept>
 #include <stdlib.h>
@@ -105,12 +108,17 @@ ParticleData::ParticleData(unsigned int N,
         {
         m_gpu_partition = GPUPartition(m_exec_conf->getGPUIds());
         m_memory_advice_last_Nmax = UINT_MAX;
+        m_memory_advice_last_N = UINT_MAX;
         }
 #endif
 
     // initialize rtag array
     GlobalVector<unsigned int>(exec_conf).swap(m_rtag);
     TAG_ALLOCATION(m_rtag);
+    GlobalVector<unsigned int>(exec_conf).swap(m_batch_tags);
+    TAG_ALLOCATION(m_batch_tags);
+    GlobalVector<unsigned int>(exec_conf).swap(m_batch_types);
+    TAG_ALLOCATION(m_batch_types);
 
     // initialize all processors
     initializeFromSnapshot(snap);
@@ -166,12 +174,17 @@ ParticleData::ParticleData(const SnapshotParticleData<Real>& snapshot,
         {
         m_gpu_partition = GPUPartition(m_exec_conf->getGPUIds());
         m_memory_advice_last_Nmax = UINT_MAX;
+        m_memory_advice_last_N = UINT_MAX;
         }
 #endif
 
     // initialize rtag array
     GlobalVector<unsigned int>(exec_conf).swap(m_rtag);
     TAG_ALLOCATION(m_rtag);
+    GlobalVector<unsigned int>(exec_conf).swap(m_batch_tags);
+    TAG_ALLOCATION(m_batch_tags);
+    GlobalVector<unsigned int>(exec_conf).swap(m_batch_types);
+    TAG_ALLOCATION(m_batch_types);
 
     // initialize particle data with snapshot contents
     initializeFromSnapshot(snapshot);
@@ -256,6 +269,30 @@ void ParticleData::notifyParticleSort()
     m_sort_signal.emit();
     }
 
+/*! \param moved True when positions or orientations have changed
+
+    Call this function after modifying the properties of local particles in place, without changing
+    their order or number. Unlike notifyParticleSort(), this does not invalidate data structures
+    that only depend on the particle order (such as group index lists or bond tables).
+
+    The notification is not free: every ForceCompute recomputes its forces at the current step.
+    When \a moved is set, the cell lists are also rebuilt and the neighbor list checks the distances
+    again. Only call it when properties have actually changed. Local snapshots do not call it, as
+    their arrays are always writable and a read-only access cannot be told apart from an edit.
+
+    No migration is forced. In MPI simulations, positions are never modified in place (see
+    updateFromSnapshot()), and velocities and orientations reach the ghosts with the next ghost
+    update.
+    \note The call must be made after releasing the modified arrays
+*/
+void ParticleData::notifyParticlesModified(bool moved)
+    {
+    if (moved)
+        m_particles_moved_signal.emit();
+
+    m_particles_modified_signal.emit();
+    }
+
 /*! This function is called any time the ghost particles are removed
  *
  * The rationale is that a subscriber (i.e. the Communicator) can perform clean-up for ghost
@@ -461,8 +498,10 @@ void ParticleData::allocate(unsigned int N)
         }
 #endif
 
-    // allocate alternate particle data arrays (for swapping in-out)
-    allocateAlternateArrays(N);
+    // the alternate particle data arrays (for swapping in-out) are allocated on first use,
+    // resize them if they already exist
+    if (!m_pos_alt.isNull())
+        allocateAlternateArrays(N);
 
     // notify observers
     m_max_particle_num_signal.emit();
@@ -898,7 +937,7 @@ void ParticleData::maybe_rebuild_tag_cache()
 template<class Real> bool ParticleData::inBox(const SnapshotParticleData<Real>& snap)
     {
     bool in_box = true;
-    if (m_exec_conf->getRank() == 0)
+    if (m_exec_conf->getRank() == 0 || snap.is_distributed)
         {
         Scalar3 lo = m_global_box.getLo();
         Scalar3 hi = m_global_box.getHi();
@@ -924,7 +963,20 @@ template<class Real> bool ParticleData::inBox(const SnapshotParticleData<Real>&
             }
         }
 #ifdef ENABLE_MPI
-    if (m_decomposition)
+    if (m_decomposition && snap.is_distributed)
+        {
+        // every rank checks its own slice of the snapshot
+        int local_in_box = in_box;
+        int global_in_box = 0;
+        MPI_Allreduce(&local_in_box,
+                      &global_in_box,
+                      1,
+                      MPI_INT,
+                      MPI_LAND,
+                      m_exec_conf->getMPICommunicator());
+        in_box = global_in_box != 0;
+        }
+    else if (m_decomposition)
         {
         bcast(in_box, 0, m_exec_conf->getMPICommunicator());
         }
@@ -932,6 +984,78 @@ template<class Real> bool ParticleData::inBox(const SnapshotParticleData<Real>&
     return in_box;
     }
 
+#ifdef ENABLE_MPI
+/*! The particle is wrapped into the global box when it is exactly on a boundary, and placed using
+    the actual domain fractions.
+*/
+unsigned int ParticleData::placeSnapshotParticle(Scalar3& pos,
+                                                 int3& img,
+                                                 unsigned int snap_idx,
+                                                 const unsigned int* cart_ranks)
+    {
+    const Index3D& di = m_decomposition->getDomainIndexer();
+    BoxDim global_box = m_global_box;
+
+    // determine domain the particle is placed into
+    Scalar3 f = m_global_box.makeFraction(pos);
+    int i = int(f.x * ((Scalar)di.getW()));
+    int j = int(f.y * ((Scalar)di.getH()));
+    int k = int(f.z * ((Scalar)di.getD()));
+
+    // wrap particles that are exactly on a boundary
+    // we only need to wrap in the negative direction, since
+    // processor ids are rounded toward zero
+    char3 flags = make_char3(0, 0, 0);
+    if (i == (int)di.getW())
+        {
+        i = 0;
+        flags.x = 1;
+        }
+
+    if (j == (int)di.getH())
+        {
+        j = 0;
+        flags.y = 1;
+        }
+
+    if (k == (int)di.getD())
+        {
+        k = 0;
+        flags.z = 1;
+        }
+
+    // only wrap if the particles is on one of the boundaries
+    uchar3 periodic = make_uchar3(flags.x, flags.y, flags.z);
+    global_box.setPeriodic(periodic);
+    global_box.wrap(pos, img, flags);
+
+    // place particle using actual domain fractions, not global box fraction
+    unsigned int rank = m_decomposition->placeParticle(m_global_box, pos, cart_ranks);
+
+    if (rank >= m_exec_conf->getNRanks())
+        {
+        m_exec_conf->msg->error() << "init.*: Particle " << snap_idx << " out of bounds."
+                                  << std::endl;
+        m_exec_conf->msg->error() << "Cartesian coordinates: " << std::endl;
+        m_exec_conf->msg->error() << "x: " << pos.x << " y: " << pos.y << " z: " << pos.z
+                                  << std::endl;
+        m_exec_conf->msg->error() << "Fractional coordinates: " << std::endl;
+        m_exec_conf->msg->error() << "f.x: " << f.x << " f.y: " << f.y << " f.z: " << f.z
+                                  << std::endl;
+        Scalar3 lo = m_global_box.getLo();
+        Scalar3 hi = m_global_box.getHi();
+        m_exec_conf->msg->error() << "Global box lo: (" << lo.x << ", " << lo.y << ", " << lo.z
+                                  << ")" << std::endl;
+        m_exec_conf->msg->error() << "           hi: (" << hi.x << ", " << hi.y << ", " << hi.z
+                                  << ")" << std::endl;
+
+        throw std::runtime_error("Error initializing from snapshot.");
+        }
+
+    return rank;
+    }
+#endif
+
 //! Initialize from a snapshot
 /*! \param snapshot the initial particle data
     \param ignore_bodies If True, ignore particles that have a body flag set
@@ -940,6 +1064,10 @@ template<class Real> bool ParticleData::inBox(const SnapshotParticleData<Real>&
 
     \pre In parallel simulations, the local box size must be set before a call to
    initializeFromSnapshot().
+
+    In parallel simulations, the snapshot is read on the root rank unless
+   SnapshotParticleData::is_distributed is set. In that case, every rank places the particles in its
+   slice of the snapshot and sends them directly to their domains.
  */
 template<class Real>
 void ParticleData::initializeFromSnapshot(const SnapshotParticleData<Real>& snapshot,
@@ -951,7 +1079,7 @@ void ParticleData::initializeFromSnapshot(const SnapshotParticleData<Real>& snap
     removeAllGhostParticles();
 
     // check that all fields in the snapshot have correct length
-    if (m_exec_conf->getRank() == 0 && !snapshot.validate())
+    if ((m_exec_conf->getRank() == 0 || snapshot.is_distributed) && !snapshot.validate())
         {
         throw std::runtime_error("Invalid particle data in snapshot.");
         }
@@ -973,198 +1101,285 @@ void ParticleData::initializeFromSnapshot(const SnapshotParticleData<Real>& snap
         // gather box information from all processors
         unsigned int root = 0;
 
-        // Define per-processor particle data
-        std::vector<std::vector<Scalar3>> pos_proc;       // Position array of every processor
-        std::vector<std::vector<Scalar3>> vel_proc;       // Velocities array of every processor
-        std::vector<std::vector<Scalar3>> accel_proc;     // Accelerations array of every processor
-        std::vector<std::vector<unsigned int>> type_proc; // Particle types array of every processor
-        std::vector<std::vector<Scalar>> mass_proc;   // Particle masses array of every processor
-        std::vector<std::vector<Scalar>> charge_proc; // Particle charges array of every processor
-        std::vector<std::vector<Scalar>>
-            diameter_proc;                         // Particle diameters array of every processor
-        std::vector<std::vector<int3>> image_proc; // Particle images array of every processor
-        std::vector<std::vector<unsigned int>> body_proc;   // Body ids of every processor
-        std::vector<std::vector<Scalar4>> orientation_proc; // Orientations of every processor
-        std::vector<std::vector<Scalar4>> angmom_proc;      // Angular momenta of every processor
-        std::vector<std::vector<Scalar3>> inertia_proc;     // Angular momenta of every processor
-        std::vector<std::vector<unsigned int>> tag_proc;    // Global tags of every processor
-        std::vector<unsigned int> N_proc; // Number of particles on every processor
-
-        // resize to number of ranks in communicator
         const MPI_Comm mpi_comm = m_exec_conf->getMPICommunicator();
         unsigned int size = m_exec_conf->getNRanks();
         unsigned int my_rank = m_exec_conf->getRank();
 
-        pos_proc.resize(size);
-        vel_proc.resize(size);
-        accel_proc.resize(size);
-        type_proc.resize(size);
-        mass_proc.resize(size);
-        charge_proc.resize(size);
-        diameter_proc.resize(size);
-        image_proc.resize(size);
-        body_proc.resize(size);
-        orientation_proc.resize(size);
-        angmom_proc.resize(size);
-        inertia_proc.resize(size);
-        tag_proc.resize(size);
-        N_proc.resize(size, 0);
-
-        if (my_rank == 0)
-            {
-            ArrayHandle<unsigned int> h_cart_ranks(m_decomposition->getCartRanks(),
-                                                   access_location::host,
-                                                   access_mode::read);
-
-            const Index3D& di = m_decomposition->getDomainIndexer();
-            unsigned int n_ranks = m_exec_conf->getNRanks();
+        // Particles placed on this rank
+        std::vector<pdata_element> local_particles;
 
-            BoxDim global_box = m_global_box;
+        ArrayHandle<unsigned int> h_cart_ranks(m_decomposition->getCartRanks(),
+                                               access_location::host,
+                                               access_mode::read);
 
-            // loop over particles in snapshot, place them into domains
-            for (typename std::vector<vec3<Real>>::const_iterator it = snapshot.pos.begin();
-                 it != snapshot.pos.end();
-                 it++)
+        // pack a snapshot particle for its destination rank
+        auto pack_particle = [&](unsigned int snap_idx, unsigned int tag, pdata_element& p)
+        {
+            Scalar3 pos = vec_to_scalar3(snapshot.pos[snap_idx]);
+            int3 img = snapshot.image[snap_idx];
+            placeSnapshotParticle(pos, img, snap_idx, h_cart_ranks.data);
+
+            p.pos = make_scalar4(pos.x, pos.y, pos.z, __int_as_scalar(snapshot.type[snap_idx]));
+            p.vel = make_scalar4(snapshot.vel[snap_idx].x,
+                                 snapshot.vel[snap_idx].y,
+                                 snapshot.vel[snap_idx].z,
+                                 snapshot.mass[snap_idx]);
+            p.accel = vec_to_scalar3(snapshot.accel[snap_idx]);
+            p.charge = snapshot.charge[snap_idx];
+            p.diameter = snapshot.diameter[snap_idx];
+            p.image = img;
+            p.body = snapshot.body[snap_idx];
+            p.orientation = quat_to_scalar4(snapshot.orientation[snap_idx]);
+            p.angmom = quat_to_scalar4(snapshot.angmom[snap_idx]);
+            p.inertia = vec_to_scalar3(snapshot.inertia[snap_idx]);
+            p.tag = tag;
+        };
+
+        // Destination rank of every snapshot particle, later reused for the global tags
+        std::vector<unsigned int> snap_rank;
+
+        // Number of particles on every processor
+        std::vector<unsigned int> N_proc(size, 0);
+
+        // Snapshot particle indices sorted by destination rank
+        std::vector<unsigned int> snap_order;
+        std::vector<unsigned int> rank_offset(size + 1, 0);
+
+        if (snapshot.is_distributed)
+            {
+            // every rank holds a contiguous slice of the particles, in rank order
+            unsigned int snap_offset = 0;
+            MPI_Exscan(&snapshot.size, &snap_offset, 1, MPI_UNSIGNED, MPI_SUM, mpi_comm);
+            if (my_rank == 0)
+                snap_offset = 0;
+
+            snap_rank.resize(snapshot.size, NOT_LOCAL);
+            unsigned int n_kept = 0;
+            for (unsigned int snap_idx = 0; snap_idx < snapshot.size; snap_idx++)
                 {
-                unsigned int snap_idx = (unsigned int)(it - snapshot.pos.begin());
-
                 // if requested, do not initialize constituent particles of bodies
                 if (ignore_bodies && snapshot.body[snap_idx] < MIN_FLOPPY
-                    && snapshot.body[snap_idx] != snap_idx)
+                    && snapshot.body[snap_idx] != snap_offset + snap_idx)
                     {
                     continue;
                     }
 
-                // determine domain the particle is placed into
-                Scalar3 pos = vec_to_scalar3(*it);
-                Scalar3 f = m_global_box.makeFraction(pos);
-                int i = int(f.x * ((Scalar)di.getW()));
-                int j = int(f.y * ((Scalar)di.getH()));
-                int k = int(f.z * ((Scalar)di.getD()));
-
-                // wrap particles that are exactly on a boundary
-                // we only need to wrap in the negative direction, since
-                // processor ids are rounded toward zero
-                char3 flags = make_char3(0, 0, 0);
-                if (i == (int)di.getW())
-                    {
-                    i = 0;
-                    flags.x = 1;
-                    }
+                Scalar3 pos = vec_to_scalar3(snapshot.pos[snap_idx]);
+                int3 img = snapshot.image[snap_idx];
+                unsigned int rank
+                    = placeSnapshotParticle(pos, img, snap_offset + snap_idx, h_cart_ranks.data);
+                snap_rank[snap_idx] = rank;
+                N_proc[rank]++;
+                n_kept++;
 
-                if (j == (int)di.getH())
-                    {
-                    j = 0;
-                    flags.y = 1;
-                    }
+                max_typeid = std::max(max_typeid, snapshot.type[snap_idx]);
+                }
+
+            // tags are assigned in snapshot order across all ranks
+            unsigned int tag_offset = 0;
+            MPI_Exscan(&n_kept, &tag_offset, 1, MPI_UNSIGNED, MPI_SUM, mpi_comm);
+            if (my_rank == 0)
+                tag_offset = 0;
+            MPI_Allreduce(&n_kept, &nglobal, 1, MPI_UNSIGNED, MPI_SUM, mpi_comm);
+            MPI_Allreduce(MPI_IN_PLACE, &max_typeid, 1, MPI_UNSIGNED, MPI_MAX, mpi_comm);
+
+            // sort the local particles by destination rank, preserving the order in the snapshot
+            for (unsigned int rank = 0; rank < size; rank++)
+                rank_offset[rank + 1] = rank_offset[rank] + N_proc[rank];
+
+            std::vector<pdata_element> send_buf(n_kept);
+            std::vector<unsigned int> rank_fill(rank_offset.begin(), rank_offset.end() - 1);
+            unsigned int tag = tag_offset;
+            for (unsigned int snap_idx = 0; snap_idx < snapshot.size; snap_idx++)
+                {
+                if (snap_rank[snap_idx] != NOT_LOCAL)
+                    pack_particle(snap_idx, tag++, send_buf[rank_fill[snap_rank[snap_idx]]++]);
+                }
+
+            // exchange the particles with all other ranks
+            std::vector<unsigned int> n_recv(size);
+            MPI_Alltoall(N_proc.data(), 1, MPI_UNSIGNED, n_recv.data(), 1, MPI_UNSIGNED, mpi_comm);
+
+            std::vector<int> send_counts(size), send_displs(size);
+            std::vector<int> recv_counts(size), recv_displs(size);
+            m_nparticles = 0;
+            for (unsigned int rank = 0; rank < size; rank++)
+                {
+                send_counts[rank] = int(N_proc[rank]);
+                send_displs[rank] = int(rank_offset[rank]);
+                recv_counts[rank] = int(n_recv[rank]);
+                recv_displs[rank] = int(m_nparticles);
+                m_nparticles += n_recv[rank];
+                }
+
+            local_particles.resize(m_nparticles);
+
+            MPI_Datatype mpi_pdata_element;
+            MPI_Type_contiguous(int(sizeof(pdata_element)), MPI_BYTE, &mpi_pdata_element);
+            MPI_Type_commit(&mpi_pdata_element);
+            MPI_Alltoallv(send_buf.data(),
+                          send_counts.data(),
+                          send_displs.data(),
+                          mpi_pdata_element,
+                          local_particles.data(),
+                          recv_counts.data(),
+                          recv_displs.data(),
+                          mpi_pdata_element,
+                          mpi_comm);
+            MPI_Type_free(&mpi_pdata_element);
+
+            // get type mapping
+            m_type_mapping = snapshot.type_mapping;
+
+            if (my_rank != root)
+                {
+                m_type_mapping.clear();
+                }
+
+            // broadcast type mapping
+            bcast(m_type_mapping, root, mpi_comm);
+
+            // resize array for reverse-lookup tags
+            m_rtag.resize(nglobal);
+            }
+        else
+            {
+            // Particles are sent to the other ranks in batches to bound the size of the send
+            // buffer
+            const unsigned int max_batch = 65536;
+
+            if (my_rank == root)
+                {
+                snap_rank.resize(snapshot.size, NOT_LOCAL);
 
-                if (k == (int)di.getD())
+                // loop over particles in snapshot, place them into domains
+                for (unsigned int snap_idx = 0; snap_idx < snapshot.size; snap_idx++)
                     {
-                    k = 0;
-                    flags.z = 1;
+                    // if requested, do not initialize constituent particles of bodies
+                    if (ignore_bodies && snapshot.body[snap_idx] < MIN_FLOPPY
+                        && snapshot.body[snap_idx] != snap_idx)
+                        {
+                        continue;
+                        }
+
+                    Scalar3 pos = vec_to_scalar3(snapshot.pos[snap_idx]);
+                    int3 img = snapshot.image[snap_idx];
+                    unsigned int rank
+                        = placeSnapshotParticle(pos, img, snap_idx, h_cart_ranks.data);
+                    snap_rank[snap_idx] = rank;
+                    N_proc[rank]++;
+                    nglobal++;
+
+                    // determine max typeid on root rank
+                    max_typeid = std::max(max_typeid, snapshot.type[snap_idx]);
                     }
 
-                int3 img = snapshot.image[snap_idx];
-
-                // only wrap if the particles is on one of the boundaries
-                uchar3 periodic = make_uchar3(flags.x, flags.y, flags.z);
-                global_box.setPeriodic(periodic);
-                global_box.wrap(pos, img, flags);
+                // sort the particles by destination rank, preserving the order in the snapshot
+                for (unsigned int rank = 0; rank < size; rank++)
+                    rank_offset[rank + 1] = rank_offset[rank] + N_proc[rank];
 
-                // place particle using actual domain fractions, not global box fraction
-                unsigned int rank
-                    = m_decomposition->placeParticle(m_global_box, pos, h_cart_ranks.data);
+                snap_order.resize(nglobal);
+                std::vector<unsigned int> rank_fill(rank_offset.begin(), rank_offset.end() - 1);
+                for (unsigned int snap_idx = 0; snap_idx < snapshot.size; snap_idx++)
+                    {
+                    if (snap_rank[snap_idx] != NOT_LOCAL)
+                        snap_order[rank_fill[snap_rank[snap_idx]]++] = snap_idx;
+                    }
 
-                if (rank >= n_ranks)
+                // tags are assigned in snapshot order
+                unsigned int tag = 0;
+                for (unsigned int snap_idx = 0; snap_idx < snapshot.size; snap_idx++)
                     {
-                    m_exec_conf->msg->error()
-                        << "init.*: Particle " << snap_idx << " out of bounds." << std::endl;
-                    m_exec_conf->msg->error() << "Cartesian coordinates: " << std::endl;
-                    m_exec_conf->msg->error()
-                        << "x: " << pos.x << " y: " << pos.y << " z: " << pos.z << std::endl;
-                    m_exec_conf->msg->error() << "Fractional coordinates: " << std::endl;
-                    m_exec_conf->msg->error()
-                        << "f.x: " << f.x << " f.y: " << f.y << " f.z: " << f.z << std::endl;
-                    Scalar3 lo = m_global_box.getLo();
-                    Scalar3 hi = m_global_box.getHi();
-                    m_exec_conf->msg->error() << "Global box lo: (" << lo.x << ", " << lo.y << ", "
-                                              << lo.z << ")" << std::endl;
-                    m_exec_conf->msg->error() << "           hi: (" << hi.x << ", " << hi.y << ", "
-                                              << hi.z << ")" << std::endl;
-
-                    throw std::runtime_error("Error initializing from snapshot.");
+                    if (snap_rank[snap_idx] != NOT_LOCAL)
+                        snap_rank[snap_idx] = tag++;
                     }
+                }
 
-                // fill up per-processor data structures
-                pos_proc[rank].push_back(pos);
-                image_proc[rank].push_back(img);
-                vel_proc[rank].push_back(vec_to_scalar3(snapshot.vel[snap_idx]));
-                accel_proc[rank].push_back(vec_to_scalar3(snapshot.accel[snap_idx]));
-                type_proc[rank].push_back(snapshot.type[snap_idx]);
-                mass_proc[rank].push_back(snapshot.mass[snap_idx]);
-                charge_proc[rank].push_back(snapshot.charge[snap_idx]);
-                diameter_proc[rank].push_back(snapshot.diameter[snap_idx]);
-                body_proc[rank].push_back(snapshot.body[snap_idx]);
-                orientation_proc[rank].push_back(quat_to_scalar4(snapshot.orientation[snap_idx]));
-                angmom_proc[rank].push_back(quat_to_scalar4(snapshot.angmom[snap_idx]));
-                inertia_proc[rank].push_back(vec_to_scalar3(snapshot.inertia[snap_idx]));
-                tag_proc[rank].push_back(nglobal++);
-                N_proc[rank]++;
+            // get type mapping
+            m_type_mapping = snapshot.type_mapping;
 
-                // determine max typeid on root rank
-                max_typeid = std::max(max_typeid, snapshot.type[snap_idx]);
+            if (my_rank != root)
+                {
+                m_type_mapping.clear();
                 }
-            }
 
-        // get type mapping
-        m_type_mapping = snapshot.type_mapping;
+            // broadcast type mapping
+            bcast(m_type_mapping, root, mpi_comm);
 
-        if (my_rank != root)
-            {
-            m_type_mapping.clear();
-            }
+            // broadcast global number of particles
+            bcast(nglobal, root, mpi_comm);
 
-        // broadcast type mapping
-        bcast(m_type_mapping, root, mpi_comm);
+            // resize array for reverse-lookup tags
+            m_rtag.resize(nglobal);
 
-        // broadcast global number of particles
-        bcast(nglobal, root, mpi_comm);
+            // distribute number of particles
+            MPI_Scatter(N_proc.data(),
+                        1,
+                        MPI_UNSIGNED,
+                        &m_nparticles,
+                        1,
+                        MPI_UNSIGNED,
+                        root,
+                        mpi_comm);
 
-        // resize array for reverse-lookup tags
-        m_rtag.resize(nglobal);
+            local_particles.resize(m_nparticles);
 
-        // Local particle data
-        std::vector<Scalar3> pos;
-        std::vector<Scalar3> vel;
-        std::vector<Scalar3> accel;
-        std::vector<unsigned int> type;
-        std::vector<Scalar> mass;
-        std::vector<Scalar> charge;
-        std::vector<Scalar> diameter;
-        std::vector<int3> image;
-        std::vector<unsigned int> body;
-        std::vector<Scalar4> orientation;
-        std::vector<Scalar4> angmom;
-        std::vector<Scalar3> inertia;
-        std::vector<unsigned int> tag;
-
-        // distribute particle data
-        scatter_v(pos_proc, pos, root, mpi_comm);
-        scatter_v(vel_proc, vel, root, mpi_comm);
-        scatter_v(accel_proc, accel, root, mpi_comm);
-        scatter_v(type_proc, type, root, mpi_comm);
-        scatter_v(mass_proc, mass, root, mpi_comm);
-        scatter_v(charge_proc, charge, root, mpi_comm);
-        scatter_v(diameter_proc, diameter, root, mpi_comm);
-        scatter_v(image_proc, image, root, mpi_comm);
-        scatter_v(body_proc, body, root, mpi_comm);
-        scatter_v(orientation_proc, orientation, root, mpi_comm);
-        scatter_v(angmom_proc, angmom, root, mpi_comm);
-        scatter_v(inertia_proc, inertia, root, mpi_comm);
-        scatter_v(tag_proc, tag, root, mpi_comm);
-
-        // distribute number of particles
-        scatter_v(N_proc, m_nparticles, root, mpi_comm);
+            // distribute particle data
+            if (my_rank == root)
+                {
+                std::vector<pdata_element> send_buf;
+                for (unsigned int rank = 0; rank < size; rank++)
+                    {
+                    for (unsigned int begin = rank_offset[rank]; begin < rank_offset[rank + 1];
+                         begin += max_batch)
+                        {
+                        unsigned int end = std::min(begin + max_batch, rank_offset[rank + 1]);
+
+                        // the particles of the root rank are placed directly in the local buffer
+                        pdata_element* buf;
+                        if (rank == root)
+                            {
+                            buf = local_particles.data() + (begin - rank_offset[rank]);
+                            }
+                        else
+                            {
+                            send_buf.resize(end - begin);
+                            buf = send_buf.data();
+                            }
+
+                        for (unsigned int order_idx = begin; order_idx < end; order_idx++)
+                            {
+                            unsigned int snap_idx = snap_order[order_idx];
+                            pack_particle(snap_idx, snap_rank[snap_idx], buf[order_idx - begin]);
+                            }
+
+                        if (rank != root)
+                            {
+                            MPI_Send(send_buf.data(),
+                                     int((end - begin) * sizeof(pdata_element)),
+                                     MPI_BYTE,
+                                     rank,
+                                     0,
+                                     mpi_comm);
+                            }
+                        }
+                    }
+                }
+            else
+                {
+                for (unsigned int begin = 0; begin < m_nparticles; begin += max_batch)
+                    {
+                    unsigned int end = std::min(begin + max_batch, m_nparticles);
+                    MPI_Recv(local_particles.data() + begin,
+                             int((end - begin) * sizeof(pdata_element)),
+                             MPI_BYTE,
+                             root,
+                             0,
+                             mpi_comm,
+                             MPI_STATUS_IGNORE);
+                    }
+                }
+            }
 
             {
             // reset all reverse lookup tags to NOT_LOCAL flag
@@ -1211,19 +1426,19 @@ void ParticleData::initializeFromSnapshot(const SnapshotParticleData<Real>& snap
 
         for (unsigned int idx = 0; idx < m_nparticles; idx++)
             {
-            h_pos.data[idx]
-                = make_scalar4(pos[idx].x, pos[idx].y, pos[idx].z, __int_as_scalar(type[idx]));
-            h_vel.data[idx] = make_scalar4(vel[idx].x, vel[idx].y, vel[idx].z, mass[idx]);
-            h_accel.data[idx] = accel[idx];
-            h_charge.data[idx] = charge[idx];
-            h_diameter.data[idx] = diameter[idx];
-            h_image.data[idx] = image[idx];
-            h_tag.data[idx] = tag[idx];
-            h_rtag.data[tag[idx]] = idx;
-            h_body.data[idx] = body[idx];
-            h_orientation.data[idx] = orientation[idx];
-            h_angmom.data[idx] = angmom[idx];
-            h_inertia.data[idx] = inertia[idx];
+            const pdata_element& p = local_particles[idx];
+            h_pos.data[idx] = p.pos;
+            h_vel.data[idx] = p.vel;
+            h_accel.data[idx] = p.accel;
+            h_charge.data[idx] = p.charge;
+            h_diameter.data[idx] = p.diameter;
+            h_image.data[idx] = p.image;
+            h_tag.data[idx] = p.tag;
+            h_rtag.data[p.tag] = idx;
+            h_body.data[idx] = p.body;
+            h_orientation.data[idx] = p.orientation;
+            h_angmom.data[idx] = p.angmom;
+            h_inertia.data[idx] = p.inertia;
 
             h_comm_flag.data[idx] = 0; // initialize with zero
             }
@@ -1314,7 +1529,7 @@ void ParticleData::initializeFromSnapshot(const SnapshotParticleData<Real>& snap
     m_origin = make_scalar3(0, 0, 0);
     m_o_image = make_int3(0, 0, 0);
 
-    unsigned int snapshot_size = snapshot.size;
+    unsigned int snapshot_size = snapshot.is_distributed ? nglobal : snapshot.size;
 
 // Raise an exception if there are any invalid type ids. This is done here (instead of in the
 // loops above) to avoid MPI communication deadlocks when only some ranks have invalid types.
@@ -1582,9 +1797,247 @@ ParticleData::takeSnapshot(SnapshotParticleData<Real>& snapshot)
     // copy over acceleration set flag (this is a copy in case users take a snapshot before running)
     snapshot.is_accel_set = m_accel_set;
 
+    // the snapshot matches the particle data
+    snapshot.modified = 0;
+
     return index;
     }
 
+/*! \param snapshot Snapshot taken with takeSnapshot()
+    \returns false when the particles cannot be updated in place
+
+    Copy the arrays flagged in SnapshotParticleData::modified to the particles with the same tags
+   and keep all other particle properties. This avoids redistributing all particles when only some
+   properties change. It requires a snapshot with every particle in tag order, that is with as many
+   particles as the system, contiguous tags, and the same types. In MPI simulations, new positions,
+   images, or bodies may move particles to other ranks, so those require initializeFromSnapshot().
+   Particles are sent to the other ranks in batches, as in initializeFromSnapshot().
+
+   Listeners are notified as narrowly as possible: new types, diameters, or bodies (and charges in
+   MPI simulations, since ghost charges are only sent with a full ghost exchange) are handled like
+   a particle sort, while other properties only trigger notifyParticlesModified(), so that a new set
+   of velocities does not invalidate the groups, neighbor list, or cell list.
+*/
+template<class Real>
+bool ParticleData::updateFromSnapshot(const SnapshotParticleData<Real>& snapshot)
+    {
+    unsigned int modified = snapshot.modified;
+    bool in_place = false;
+    if (m_exec_conf->getRank() == 0)
+        {
+        in_place = !snapshot.is_distributed && snapshot.validate()
+                   && snapshot.size == getNGlobal() && getMaximumTag() + 1 == getNGlobal()
+                   && snapshot.type_mapping == m_type_mapping;
+        }
+
+#ifdef ENABLE_MPI
+    if (m_decomposition)
+        {
+        bcast(in_place, 0, m_exec_conf->getMPICommunicator());
+        bcast(modified, 0, m_exec_conf->getMPICommunicator());
+        const unsigned int migrating_fields = SnapshotParticleData<Real>::field_pos
+                                              | SnapshotParticleData<Real>::field_image
+                                              | SnapshotParticleData<Real>::field_body;
+        in_place = in_place && !(modified & migrating_fields);
+        }
+#endif
+
+    if (!in_place)
+        return false;
+
+    m_exec_conf->msg->notice(4) << "ParticleData: updating from snapshot" << std::endl;
+
+    // remove all ghost particles, they are exchanged again before the next step
+    removeAllGhostParticles();
+
+    // pack a snapshot particle
+    auto pack_particle = [&](unsigned int tag, pdata_element& p)
+    {
+        p.pos = make_scalar4(snapshot.pos[tag].x,
+                             snapshot.pos[tag].y,
+                             snapshot.pos[tag].z,
+                             __int_as_scalar(snapshot.type[tag]));
+        p.vel = make_scalar4(snapshot.vel[tag].x,
+                             snapshot.vel[tag].y,
+                             snapshot.vel[tag].z,
+                             snapshot.mass[tag]);
+        p.accel = vec_to_scalar3(snapshot.accel[tag]);
+        p.charge = snapshot.charge[tag];
+        p.diameter = snapshot.diameter[tag];
+        p.image = snapshot.image[tag];
+        p.body = snapshot.body[tag];
+        p.orientation = quat_to_scalar4(snapshot.orientation[tag]);
+        p.angmom = quat_to_scalar4(snapshot.angmom[tag]);
+        p.inertia = vec_to_scalar3(snapshot.inertia[tag]);
+        p.tag = tag;
+    };
+
+        {
+        ArrayHandle<Scalar4> h_pos(m_pos, access_location::host, access_mode::readwrite);
+        ArrayHandle<Scalar4> h_vel(m_vel, access_location::host, access_mode::readwrite);
+        ArrayHandle<Scalar3> h_accel(m_accel, access_location::host, access_mode::readwrite);
+        ArrayHandle<int3> h_image(m_image, access_location::host, access_mode::readwrite);
+        ArrayHandle<Scalar> h_charge(m_charge, access_location::host, access_mode::readwrite);
+        ArrayHandle<Scalar> h_diameter(m_diameter, access_location::host, access_mode::readwrite);
+        ArrayHandle<unsigned int> h_body(m_body, access_location::host, access_mode::readwrite);
+        ArrayHandle<Scalar4> h_orientation(m_orientation,
+                                           access_location::host,
+                                           access_mode::readwrite);
+        ArrayHandle<Scalar4> h_angmom(m_angmom, access_location::host, access_mode::readwrite);
+        ArrayHandle<Scalar3> h_inertia(m_inertia, access_location::host, access_mode::readwrite);
+        ArrayHandle<unsigned int> h_tag(m_tag, access_location::host, access_mode::read);
+
+        // copy the modified properties of a packed particle to local index idx
+        auto apply_particle = [&](unsigned int idx, const pdata_element& p)
+        {
+            typedef SnapshotParticleData<Real> Snapshot;
+            if (modified & Snapshot::field_pos)
+                {
+                h_pos.data[idx].x = p.pos.x;
+                h_pos.data[idx].y = p.pos.y;
+                h_pos.data[idx].z = p.pos.z;
+                }
+            if (modified & Snapshot::field_type)
+                h_pos.data[idx].w = p.pos.w;
+            if (modified & Snapshot::field_vel)
+                {
+                h_vel.data[idx].x = p.vel.x;
+                h_vel.data[idx].y = p.vel.y;
+                h_vel.data[idx].z = p.vel.z;
+                }
+            if (modified & Snapshot::field_mass)
+                h_vel.data[idx].w = p.vel.w;
+            if (modified & Snapshot::field_accel)
+                h_accel.data[idx] = p.accel;
+            if (modified & Snapshot::field_charge)
+                h_charge.data[idx] = p.charge;
+            if (modified & Snapshot::field_diameter)
+                h_diameter.data[idx] = p.diameter;
+            if (modified & Snapshot::field_image)
+                h_image.data[idx] = p.image;
+            if (modified & Snapshot::field_body)
+                h_body.data[idx] = p.body;
+            if (modified & Snapshot::field_orientation)
+                h_orientation.data[idx] = p.orientation;
+            if (modified & Snapshot::field_angmom)
+                h_angmom.data[idx] = p.angmom;
+            if (modified & Snapshot::field_inertia)
+                h_inertia.data[idx] = p.inertia;
+        };
+
+#ifdef ENABLE_MPI
+        if (m_decomposition)
+            {
+            const MPI_Comm mpi_comm = m_exec_conf->getMPICommunicator();
+            const unsigned int root = 0;
+            const unsigned int max_batch = 65536;
+
+            if (m_exec_conf->getRank() == root)
+                {
+                pdata_element p;
+                for (unsigned int idx = 0; idx < m_nparticles; idx++)
+                    {
+                    pack_particle(h_tag.data[idx], p);
+                    apply_particle(idx, p);
+                    }
+
+                // send the particles requested by every other rank
+                std::vector<unsigned int> tags;
+                std::vector<pdata_element> send_buf;
+                for (unsigned int rank = 0; rank < m_exec_conf->getNRanks(); rank++)
+                    {
+                    if (rank == root)
+                        continue;
+
+                    unsigned int n;
+                    MPI_Recv(&n, 1, MPI_UNSIGNED, rank, 0, mpi_comm, MPI_STATUS_IGNORE);
+                    tags.resize(n);
+                    MPI_Recv(tags.data(), n, MPI_UNSIGNED, rank, 0, mpi_comm, MPI_STATUS_IGNORE);
+
+                    for (unsigned int begin = 0; begin < n; begin += max_batch)
+                        {
+                        unsigned int end = std::min(begin + max_batch, n);
+                        send_buf.resize(end - begin);
+                        for (unsigned int i = begin; i < end; i++)
+                            pack_particle(tags[i], send_buf[i - begin]);
+
+                        MPI_Send(send_buf.data(),
+                                 int((end - begin) * sizeof(pdata_element)),
+                                 MPI_BYTE,
+                                 rank,
+                                 0,
+                                 mpi_comm);
+                        }
+                    }
+                }
+            else
+                {
+                // request the local particles from the root rank
+                MPI_Send(&m_nparticles, 1, MPI_UNSIGNED, root, 0, mpi_comm);
+                MPI_Send(h_tag.data, m_nparticles, MPI_UNSIGNED, root, 0, mpi_comm);
+
+                std::vector<pdata_element> recv_buf;
+                for (unsigned int begin = 0; begin < m_nparticles; begin += max_batch)
+                    {
+                    unsigned int end = std::min(begin + max_batch, m_nparticles);
+                    recv_buf.resize(end - begin);
+                    MPI_Recv(recv_buf.data(),
+                             int((end - begin) * sizeof(pdata_element)),
+                             MPI_BYTE,
+                             root,
+                             0,
+                             mpi_comm,
+                             MPI_STATUS_IGNORE);
+
+                    for (unsigned int idx = begin; idx < end; idx++)
+                        apply_particle(idx, recv_buf[idx - begin]);
+                    }
+                }
+            }
+        else
+#endif
+            {
+            pdata_element p;
+            for (unsigned int idx = 0; idx < m_nparticles; idx++)
+                {
+                pack_particle(h_tag.data[idx], p);
+                apply_particle(idx, p);
+                }
+            }
+        }
+
+    m_accel_set = snapshot.is_accel_set;
+#ifdef ENABLE_MPI
+    if (m_decomposition)
+        bcast(m_accel_set, 0, m_exec_conf->getMPICommunicator());
+#endif
+
+    // types, diameters, and bodies change neighbor cutoffs and exclusions, handle them like a sort
+    typedef SnapshotParticleData<Real> Snapshot;
+    unsigned int sort_fields
+        = Snapshot::field_type | Snapshot::field_diameter | Snapshot::field_body;
+#ifdef ENABLE_MPI
+    // ghost charges are only sent with a full ghost exchange
+    if (m_decomposition)
+        sort_fields |= Snapshot::field_charge;
+#endif
+
+    if (modified & sort_fields)
+        {
+        notifyParticleSort();
+
+        // group membership and rigid bodies depend on types and bodies
+        if (modified & (Snapshot::field_type | Snapshot::field_body))
+            m_global_particle_num_signal.emit();
+        }
+    else
+        {
+        notifyParticlesModified(modified & (Snapshot::field_pos | Snapshot::field_orientation));
+        }
+
+    return true;
+    }
+
 //! Add ghost particles at the end of the local particle data
 /*! Ghost ptls are appended at the end of the particle data.
   Ghost particles have only incomplete particle information (position, charge, diameter) and
@@ -2401,238 +2854,421 @@ void ParticleData::setMomentsOfInertia(unsigned int tag, const Scalar3& inertia)
  */
 unsigned int ParticleData::addParticle(unsigned int type)
     {
-    // we are changing the local number of particles, so remove ghosts
-    removeAllGhostParticles();
+    return addParticleBatch(std::vector<unsigned int>(1, type))[0];
+    }
+
+/*! \param types Types of the particles to add
+    \returns the unique tags of the newly added particles, in the order of \a types
 
-    // the global tag of the newly created particle
-    unsigned int tag;
+    Adds all particles in one pass: tags are allocated at once, the arrays are resized once, and
+    the particle sort and particle number signals are emitted once for the whole batch. The new
+    particles take the same default values as in addParticle(). On the GPU, the arrays are
+    initialized on the device.
+*/
+std::vector<unsigned int> ParticleData::addParticleBatch(const std::vector<unsigned int>& types)
+    {
+    unsigned int n_add = (unsigned int)types.size();
+    std::vector<unsigned int> tags(n_add);
+    if (n_add == 0)
+        return tags;
 
-    // first check if we can recycle a deleted tag
-    if (m_recycled_tags.size())
+    for (auto type : types)
         {
-        tag = m_recycled_tags.top();
-        m_recycled_tags.pop();
+        if (type >= getNTypes())
+            {
+            m_exec_conf->msg->error() << "Trying to add a particle of type " << type
+                                      << " which does not exist!" << endl;
+            throw runtime_error("Error adding particle");
+            }
         }
-    else
+
+    // we are changing the local number of particles, so remove ghosts
+    removeAllGhostParticles();
+
+    // recycle deleted tags first. When none are left, the active tags are exactly
+    // 0 ... NGlobal + i - 1, so the next new tag is NGlobal + i.
+    for (unsigned int i = 0; i < n_add; ++i)
         {
-        // Otherwise, generate a new tag
-        tag = getNGlobal();
+        if (m_recycled_tags.size())
+            {
+            tags[i] = m_recycled_tags.top();
+            m_recycled_tags.pop();
+            }
+        else
+            {
+            tags[i] = getNGlobal() + i;
+            }
 
-        assert(m_rtag.size() == getNGlobal());
+        // add to set of active tags
+        m_tag_set.insert(tags[i]);
         }
 
-    // add to set of active tags
-    m_tag_set.insert(tag);
-
     // invalidate the active tag cache
     m_invalid_cached_tags = true;
 
     // resize array of global reverse lookup tags
     m_rtag.resize(getMaximumTag() + 1);
 
-        {
-        // update reverse-lookup table
-        ArrayHandle<unsigned int> h_rtag(m_rtag, access_location::host, access_mode::readwrite);
-        assert((h_rtag.data[tag] = NOT_LOCAL));
-        if (m_exec_conf->getRank() == 0)
-            {
-            // we add the particle at the end
-            h_rtag.data[tag] = getN();
-            }
-        else
-            {
-            // not on this processor
-            h_rtag.data[tag] = NOT_LOCAL;
-            }
-        }
+    // we add the particles at the end of the local arrays on rank 0
+    bool is_local = m_exec_conf->getRank() == 0;
+    unsigned int old_nparticles = getN();
 
-    assert(tag <= m_recycled_tags.size() + getNGlobal());
+    // resize particle data using amortized O(1) array resizing
+    // and update particle number
+    if (is_local)
+        resize(old_nparticles + n_add);
 
-    if (m_exec_conf->getRank() == 0)
+#ifdef ENABLE_HIP
+    if (m_exec_conf->isCUDAEnabled())
         {
-        // resize particle data using amortized O(1) array resizing
-        // and update particle number
-        unsigned int old_nparticles = getN();
-        resize(old_nparticles + 1);
+        m_batch_tags.resize(n_add);
+        m_batch_types.resize(n_add);
 
-        // access particle data arrays
-        ArrayHandle<Scalar4> h_pos(getPositions(), access_location::host, access_mode::readwrite);
-        ArrayHandle<Scalar4> h_vel(getVelocities(), access_location::host, access_mode::readwrite);
-        ArrayHandle<Scalar3> h_accel(getAccelerations(),
-                                     access_location::host,
+            {
+            ArrayHandle<unsigned int> h_batch_tags(m_batch_tags,
+                                                   access_location::host,
+                                                   access_mode::overwrite);
+            ArrayHandle<unsigned int> h_batch_types(m_batch_types,
+                                                    access_location::host,
+                                                    access_mode::overwrite);
+            std::copy(tags.begin(), tags.end(), h_batch_tags.data);
+            std::copy(types.begin(), types.end(), h_batch_types.data);
+            }
+
+        // initialize the new particles on the device, so the arrays stay resident there
+        ArrayHandle<unsigned int> d_batch_tags(m_batch_tags,
+                                               access_location::device,
+                                               access_mode::read);
+        ArrayHandle<unsigned int> d_batch_types(m_batch_types,
+                                                access_location::device,
+                                                access_mode::read);
+        ArrayHandle<Scalar4> d_pos(getPositions(), access_location::device, access_mode::readwrite);
+        ArrayHandle<Scalar4> d_vel(getVelocities(),
+                                   access_location::device,
+                                   access_mode::readwrite);
+        ArrayHandle<Scalar3> d_accel(getAccelerations(),
+                                     access_location::device,
                                      access_mode::readwrite);
-        ArrayHandle<Scalar> h_charge(getCharges(), access_location::host, access_mode::readwrite);
-        ArrayHandle<Scalar> h_diameter(getDiameters(),
-                                       access_location::host,
+        ArrayHandle<Scalar> d_charge(getCharges(), access_location::device, access_mode::readwrite);
+        ArrayHandle<Scalar> d_diameter(getDiameters(),
+                                       access_location::device,
                                        access_mode::readwrite);
-        ArrayHandle<int3> h_image(getImages(), access_location::host, access_mode::readwrite);
-        ArrayHandle<Scalar4> h_angmom(getAngularMomentumArray(),
-                                      access_location::host,
+        ArrayHandle<int3> d_image(getImages(), access_location::device, access_mode::readwrite);
+        ArrayHandle<unsigned int> d_body(getBodies(),
+                                         access_location::device,
+                                         access_mode::readwrite);
+        ArrayHandle<Scalar4> d_orientation(getOrientationArray(),
+                                           access_location::device,
+                                           access_mode::readwrite);
+        ArrayHandle<Scalar4> d_angmom(getAngularMomentumArray(),
+                                      access_location::device,
                                       access_mode::readwrite);
-        ArrayHandle<Scalar3> h_inertia(getMomentsOfInertiaArray(),
+        ArrayHandle<Scalar3> d_inertia(getMomentsOfInertiaArray(),
+                                       access_location::device,
+                                       access_mode::readwrite);
+        ArrayHandle<unsigned int> d_tag(getTags(), access_location::device, access_mode::readwrite);
+        ArrayHandle<unsigned int> d_rtag(m_rtag, access_location::device, access_mode::readwrite);
+        ArrayHandle<unsigned int> d_comm_flag(m_comm_flags,
+                                              access_location::device,
+                                              access_mode::readwrite);
+
+        gpu_pdata_add_particle_batch(old_nparticles,
+                                     n_add,
+                                     is_local,
+                                     d_batch_tags.data,
+                                     d_batch_types.data,
+                                     d_pos.data,
+                                     d_vel.data,
+                                     d_accel.data,
+                                     d_charge.data,
+                                     d_diameter.data,
+                                     d_image.data,
+                                     d_body.data,
+                                     d_orientation.data,
+                                     d_angmom.data,
+                                     d_inertia.data,
+                                     d_tag.data,
+                                     d_rtag.data,
+                                     d_comm_flag.data);
+
+        if (m_exec_conf->isCUDAErrorCheckingEnabled())
+            CHECK_CUDA_ERROR();
+        }
+    else
+#endif
+        {
+        // update reverse-lookup table
+        ArrayHandle<unsigned int> h_rtag(m_rtag, access_location::host, access_mode::readwrite);
+        for (unsigned int i = 0; i < n_add; ++i)
+            h_rtag.data[tags[i]] = is_local ? old_nparticles + i : NOT_LOCAL;
+
+        if (is_local)
+            {
+            // access particle data arrays
+            ArrayHandle<Scalar4> h_pos(getPositions(),
                                        access_location::host,
                                        access_mode::readwrite);
-        ArrayHandle<unsigned int> h_body(getBodies(),
+            ArrayHandle<Scalar4> h_vel(getVelocities(),
+                                       access_location::host,
+                                       access_mode::readwrite);
+            ArrayHandle<Scalar3> h_accel(getAccelerations(),
                                          access_location::host,
                                          access_mode::readwrite);
-        ArrayHandle<Scalar4> h_orientation(getOrientationArray(),
+            ArrayHandle<Scalar> h_charge(getCharges(),
+                                         access_location::host,
+                                         access_mode::readwrite);
+            ArrayHandle<Scalar> h_diameter(getDiameters(),
                                            access_location::host,
                                            access_mode::readwrite);
-        ArrayHandle<unsigned int> h_tag(getTags(), access_location::host, access_mode::readwrite);
-        ArrayHandle<unsigned int> h_comm_flag(m_comm_flags,
-                                              access_location::host,
-                                              access_mode::readwrite);
-
-        unsigned int idx = old_nparticles;
+            ArrayHandle<int3> h_image(getImages(), access_location::host, access_mode::readwrite);
+            ArrayHandle<Scalar4> h_angmom(getAngularMomentumArray(),
+                                          access_location::host,
+                                          access_mode::readwrite);
+            ArrayHandle<Scalar3> h_inertia(getMomentsOfInertiaArray(),
+                                           access_location::host,
+                                           access_mode::readwrite);
+            ArrayHandle<unsigned int> h_body(getBodies(),
+                                             access_location::host,
+                                             access_mode::readwrite);
+            ArrayHandle<Scalar4> h_orientation(getOrientationArray(),
+                                               access_location::host,
+                                               access_mode::readwrite);
+            ArrayHandle<unsigned int> h_tag(getTags(),
+                                            access_location::host,
+                                            access_mode::readwrite);
+            ArrayHandle<unsigned int> h_comm_flag(m_comm_flags,
+                                                  access_location::host,
+                                                  access_mode::readwrite);
 
-        // initialize to some sensible default values
-        h_pos.data[idx] = make_scalar4(0, 0, 0, __int_as_scalar(type));
-        h_vel.data[idx] = make_scalar4(0, 0, 0, 1.0);
-        h_accel.data[idx] = make_scalar3(0, 0, 0);
-        h_charge.data[idx] = 0.0;
-        h_diameter.data[idx] = 1.0;
-        h_image.data[idx] = make_int3(0, 0, 0);
-        h_angmom.data[idx] = make_scalar4(0, 0, 0, 0);
-        h_inertia.data[idx] = make_scalar3(0, 0, 0);
-        h_body.data[idx] = NO_BODY;
-        h_orientation.data[idx] = make_scalar4(1.0, 0.0, 0.0, 0.0);
-        h_tag.data[idx] = tag;
-        h_comm_flag.data[idx] = 0;
+            for (unsigned int i = 0; i < n_add; ++i)
+                {
+                unsigned int idx = old_nparticles + i;
+
+                // initialize to some sensible default values
+                h_pos.data[idx] = make_scalar4(0, 0, 0, __int_as_scalar(types[i]));
+                h_vel.data[idx] = make_scalar4(0, 0, 0, 1.0);
+                h_accel.data[idx] = make_scalar3(0, 0, 0);
+                h_charge.data[idx] = 0.0;
+                h_diameter.data[idx] = 1.0;
+                h_image.data[idx] = make_int3(0, 0, 0);
+                h_angmom.data[idx] = make_scalar4(0, 0, 0, 0);
+                h_inertia.data[idx] = make_scalar3(0, 0, 0);
+                h_body.data[idx] = NO_BODY;
+                h_orientation.data[idx] = make_scalar4(1.0, 0.0, 0.0, 0.0);
+                h_tag.data[idx] = tags[i];
+                h_comm_flag.data[idx] = 0;
+                }
+            }
         }
 
     // update global number of particles
-    setNGlobal(getNGlobal() + 1);
+    setNGlobal(getNGlobal() + n_add);
 
-    // we have added a particle, notify listeners
+    // we have added particles, notify listeners
     notifyParticleSort();
 
-    return tag;
+    return tags;
     }
 
 /*! \param tag Tag of particle to remove
  */
 void ParticleData::removeParticle(unsigned int tag)
     {
-    if (getNGlobal() == 0)
-        {
-        m_exec_conf->msg->error() << "Trying to remove particle when there are zero particles!"
-                                  << endl;
-        throw runtime_error("Error removing particle");
-        }
+    removeParticleBatch(std::vector<unsigned int>(1, tag));
+    }
 
-    // we are changing the local number of particles, so remove ghosts
-    removeAllGhostParticles();
+/*! \param tags Tags of the particles to remove
 
-    // sanity check
-    if (tag >= m_rtag.size())
+    Removes all particles in one pass and emits the particle sort and particle number signals once
+    for the whole batch. Every tag must belong to an existing particle and appear only once.
+    Particles from the end of the local arrays move into the slots of the removed ones. On the GPU,
+    the arrays are compacted on the device.
+*/
+void ParticleData::removeParticleBatch(const std::vector<unsigned int>& tags)
+    {
+    unsigned int n_remove = (unsigned int)tags.size();
+    if (n_remove == 0)
+        return;
+
+    if (getNGlobal() < n_remove)
         {
-        m_exec_conf->msg->error() << "Trying to remove particle " << tag << " which does not exist!"
-                                  << endl;
+        m_exec_conf->msg->error() << "Trying to remove " << n_remove << " particles when there are "
+                                  << getNGlobal() << " particles!" << endl;
         throw runtime_error("Error removing particle");
         }
 
-    // Local particle index
-    unsigned int idx = m_rtag[tag];
-
-    bool is_local = idx < getN();
-    assert(is_local || idx == NOT_LOCAL);
-
-    bool is_available = is_local;
-
-#ifdef ENABLE_MPI
-    if (getDomainDecomposition())
+    // the set of active tags is the same on all ranks, check the batch before changing anything
+    std::set<unsigned int> batch;
+    for (auto tag : tags)
         {
-        int res = is_local ? 1 : 0;
-
-        // check that particle is local on some processor
-        MPI_Allreduce(MPI_IN_PLACE, &res, 1, MPI_INT, MPI_SUM, m_exec_conf->getMPICommunicator());
-
-        assert((unsigned int)res <= 1);
-        is_available = res;
+        if (tag >= m_rtag.size())
+            {
+            m_exec_conf->msg->error()
+                << "Trying to remove particle " << tag << " which does not exist!" << endl;
+            throw runtime_error("Error removing particle");
+            }
+        if (!isTagActive(tag) || !batch.insert(tag).second)
+            {
+            m_exec_conf->msg->error() << "Trying to remove particle " << tag
+                                      << " which has been previously removed!" << endl;
+            throw runtime_error("Error removing particle");
+            }
         }
-#endif
 
-    if (!is_available)
-        {
-        m_exec_conf->msg->error() << "Trying to remove particle " << tag
-                                  << " which has been previously removed!" << endl;
-        throw runtime_error("Error removing particle");
-        }
+    // we are changing the local number of particles, so remove ghosts
+    removeAllGhostParticles();
 
-    // delete from map
-    m_rtag[tag] = NOT_LOCAL;
+    unsigned int new_nparticles = getN();
 
-    if (is_local)
+#ifdef ENABLE_HIP
+    if (m_exec_conf->isCUDAEnabled())
         {
-        unsigned int size = getN();
+        m_batch_tags.resize(n_remove);
 
-        // If the particle is not the last element of the particle data, move the last element to
-        // to the position of the removed element
-        if (idx < (size - 1))
             {
-            // access particle data arrays
-            ArrayHandle<Scalar4> h_pos(getPositions(),
-                                       access_location::host,
+            ArrayHandle<unsigned int> h_batch_tags(m_batch_tags,
+                                                   access_location::host,
+                                                   access_mode::overwrite);
+            std::copy(tags.begin(), tags.end(), h_batch_tags.data);
+            }
+
+        // compact the arrays on the device
+        ArrayHandle<unsigned int> d_batch_tags(m_batch_tags,
+                                               access_location::device,
+                                               access_mode::read);
+        ArrayHandle<Scalar4> d_pos(getPositions(), access_location::device, access_mode::readwrite);
+        ArrayHandle<Scalar4> d_vel(getVelocities(),
+                                   access_location::device,
+                                   access_mode::readwrite);
+        ArrayHandle<Scalar3> d_accel(getAccelerations(),
+                                     access_location::device,
+                                     access_mode::readwrite);
+        ArrayHandle<Scalar> d_charge(getCharges(), access_location::device, access_mode::readwrite);
+        ArrayHandle<Scalar> d_diameter(getDiameters(),
+                                       access_location::device,
                                        access_mode::readwrite);
-            ArrayHandle<Scalar4> h_vel(getVelocities(),
+        ArrayHandle<int3> d_image(getImages(), access_location::device, access_mode::readwrite);
+        ArrayHandle<unsigned int> d_body(getBodies(),
+                                         access_location::device,
+                                         access_mode::readwrite);
+        ArrayHandle<Scalar4> d_orientation(getOrientationArray(),
+                                           access_location::device,
+                                           access_mode::readwrite);
+        ArrayHandle<Scalar4> d_angmom(getAngularMomentumArray(),
+                                      access_location::device,
+                                      access_mode::readwrite);
+        ArrayHandle<Scalar3> d_inertia(getMomentsOfInertiaArray(),
+                                       access_location::device,
+                                       access_mode::readwrite);
+        ArrayHandle<unsigned int> d_tag(getTags(), access_location::device, access_mode::readwrite);
+        ArrayHandle<unsigned int> d_rtag(m_rtag, access_location::device, access_mode::readwrite);
+        ArrayHandle<unsigned int> d_comm_flag(m_comm_flags,
+                                              access_location::device,
+                                              access_mode::readwrite);
+
+        new_nparticles = gpu_pdata_remove_particle_batch(getN(),
+                                                         n_remove,
+                                                         d_batch_tags.data,
+                                                         d_pos.data,
+                                                         d_vel.data,
+                                                         d_accel.data,
+                                                         d_charge.data,
+                                                         d_diameter.data,
+                                                         d_image.data,
+                                                         d_body.data,
+                                                         d_orientation.data,
+                                                         d_angmom.data,
+                                                         d_inertia.data,
+                                                         d_tag.data,
+                                                         d_rtag.data,
+                                                         d_comm_flag.data,
+                                                         m_exec_conf->getCachedAllocator());
+
+        if (m_exec_conf->isCUDAErrorCheckingEnabled())
+            CHECK_CUDA_ERROR();
+        }
+    else
+#endif
+        {
+        // access particle data arrays
+        ArrayHandle<Scalar4> h_pos(getPositions(), access_location::host, access_mode::readwrite);
+        ArrayHandle<Scalar4> h_vel(getVelocities(), access_location::host, access_mode::readwrite);
+        ArrayHandle<Scalar3> h_accel(getAccelerations(),
+                                     access_location::host,
+                                     access_mode::readwrite);
+        ArrayHandle<Scalar> h_charge(getCharges(), access_location::host, access_mode::readwrite);
+        ArrayHandle<Scalar> h_diameter(getDiameters(),
                                        access_location::host,
                                        access_mode::readwrite);
-            ArrayHandle<Scalar3> h_accel(getAccelerations(),
-                                         access_location::host,
-                                         access_mode::readwrite);
-            ArrayHandle<Scalar> h_charge(getCharges(),
+        ArrayHandle<int3> h_image(getImages(), access_location::host, access_mode::readwrite);
+        ArrayHandle<unsigned int> h_body(getBodies(),
                                          access_location::host,
                                          access_mode::readwrite);
-            ArrayHandle<Scalar> h_diameter(getDiameters(),
+        ArrayHandle<Scalar4> h_orientation(getOrientationArray(),
                                            access_location::host,
                                            access_mode::readwrite);
-            ArrayHandle<int3> h_image(getImages(), access_location::host, access_mode::readwrite);
-            ArrayHandle<unsigned int> h_body(getBodies(),
-                                             access_location::host,
-                                             access_mode::readwrite);
-            ArrayHandle<Scalar4> h_orientation(getOrientationArray(),
-                                               access_location::host,
-                                               access_mode::readwrite);
-            ArrayHandle<unsigned int> h_tag(getTags(),
-                                            access_location::host,
-                                            access_mode::readwrite);
-            ArrayHandle<unsigned int> h_rtag(getRTags(),
-                                             access_location::host,
-                                             access_mode::readwrite);
-            ArrayHandle<unsigned int> h_comm_flag(m_comm_flags,
-                                                  access_location::host,
-                                                  access_mode::readwrite);
+        ArrayHandle<Scalar4> h_angmom(getAngularMomentumArray(),
+                                      access_location::host,
+                                      access_mode::readwrite);
+        ArrayHandle<Scalar3> h_inertia(getMomentsOfInertiaArray(),
+                                       access_location::host,
+                                       access_mode::readwrite);
+        ArrayHandle<unsigned int> h_tag(getTags(), access_location::host, access_mode::readwrite);
+        ArrayHandle<unsigned int> h_rtag(m_rtag, access_location::host, access_mode::readwrite);
+        ArrayHandle<unsigned int> h_comm_flag(m_comm_flags,
+                                              access_location::host,
+                                              access_mode::readwrite);
 
-            h_pos.data[idx] = h_pos.data[size - 1];
-            h_vel.data[idx] = h_vel.data[size - 1];
-            h_accel.data[idx] = h_accel.data[size - 1];
-            h_charge.data[idx] = h_charge.data[size - 1];
-            h_diameter.data[idx] = h_diameter.data[size - 1];
-            h_image.data[idx] = h_image.data[size - 1];
-            h_body.data[idx] = h_body.data[size - 1];
-            h_orientation.data[idx] = h_orientation.data[size - 1];
-            h_tag.data[idx] = h_tag.data[size - 1];
-            h_comm_flag.data[idx] = h_comm_flag.data[size - 1];
-
-            unsigned int last_tag = h_tag.data[size - 1];
-            h_rtag.data[last_tag] = idx;
-            }
+        for (auto tag : tags)
+            {
+            unsigned int idx = h_rtag.data[tag];
+            h_rtag.data[tag] = NOT_LOCAL;
+
+            if (idx >= new_nparticles)
+                continue;
+
+            // If the particle is not the last element of the particle data, move the last
+            // element to the position of the removed element
+            unsigned int last = new_nparticles - 1;
+            if (idx < last)
+                {
+                h_pos.data[idx] = h_pos.data[last];
+                h_vel.data[idx] = h_vel.data[last];
+                h_accel.data[idx] = h_accel.data[last];
+                h_charge.data[idx] = h_charge.data[last];
+                h_diameter.data[idx] = h_diameter.data[last];
+                h_image.data[idx] = h_image.data[last];
+                h_body.data[idx] = h_body.data[last];
+                h_orientation.data[idx] = h_orientation.data[last];
+                h_angmom.data[idx] = h_angmom.data[last];
+                h_inertia.data[idx] = h_inertia.data[last];
+                h_tag.data[idx] = h_tag.data[last];
+                h_comm_flag.data[idx] = h_comm_flag.data[last];
+
+                h_rtag.data[h_tag.data[idx]] = idx;
+                }
 
-        // update particle number
-        resize(getN() - 1);
+            new_nparticles--;
+            }
         }
 
-    // remove from set of active tags
-    m_tag_set.erase(tag);
+    // update particle number
+    resize(new_nparticles);
 
-    // maintain a stack of deleted group tags for future recycling
-    m_recycled_tags.push(tag);
+    for (auto tag : tags)
+        {
+        // remove from set of active tags
+        m_tag_set.erase(tag);
+
+        // maintain a stack of deleted group tags for future recycling
+        m_recycled_tags.push(tag);
+        }
 
     // invalidate active tag cache
     m_invalid_cached_tags = true;
 
     // update global particle number
-    setNGlobal(getNGlobal() - 1);
+    setNGlobal(getNGlobal() - n_remove);
 
     // local particle number may have changed
     notifyParticleSort();
@@ -2715,6 +3351,8 @@ ParticleData::initializeFromSnapshot<double>(const SnapshotParticleData<double>&
                                              bool ignore_bodies);
 template std::map<unsigned int, unsigned int>
 ParticleData::takeSnapshot<double>(SnapshotParticleData<double>& snapshot);
+template bool
+ParticleData::updateFromSnapshot<double>(const SnapshotParticleData<double>& snapshot);
 
 template ParticleData::ParticleData(const SnapshotParticleData<float>& snapshot,
                                     const BoxDim& global_box,
@@ -2725,6 +3363,8 @@ ParticleData::initializeFromSnapshot<float>(const SnapshotParticleData<float>& s
                                             bool ignore_bodies);
 template std::map<unsigned int, unsigned int>
 ParticleData::takeSnapshot<float>(SnapshotParticleData<float>& snapshot);
+template bool
+ParticleData::updateFromSnapshot<float>(const SnapshotParticleData<float>& snapshot);
 
 void export_ParticleData(py::module& m)
     {
@@ -2780,6 +3420,8 @@ void export_ParticleData(py::module& m)
         .def("getMaximumTag", &ParticleData::getMaximumTag)
         .def("addParticle", &ParticleData::addParticle)
         .def("removeParticle", &ParticleData::removeParticle)
+        .def("addParticleBatch", &ParticleData::addParticleBatch)
+        .def("removeParticleBatch", &ParticleData::removeParticleBatch)
         .def("getNthTag", &ParticleData::getNthTag)
 #ifdef ENABLE_MPI
         .def("setDomainDecomposition", &ParticleData::setDomainDecomposition)
@@ -2790,7 +3432,8 @@ void export_ParticleData(py::module& m)
 
 //! Constructor for SnapshotParticleData
 template<class Real>
-SnapshotParticleData<Real>::SnapshotParticleData(unsigned int N) : size(N), is_accel_set(false)
+SnapshotParticleData<Real>::SnapshotParticleData(unsigned int N)
+    : size(N), is_accel_set(false), is_distributed(false), modified(field_all)
     {
     resize(N);
     }
@@ -2811,6 +3454,7 @@ template<class Real> void SnapshotParticleData<Real>::resize(unsigned int N)
     inertia.resize(N, vec3<Real>(0.0, 0.0, 0.0));
     size = N;
     is_accel_set = false;
+    modified = field_all;
     }
 
 template<class Real> void SnapshotParticleData<Real>::insert(unsigned int i, unsigned int n)
@@ -2830,6 +3474,7 @@ template<class Real> void SnapshotParticleData<Real>::insert(unsigned int i, uns
     inertia.insert(inertia.begin() + i, n, vec3<Real>(0.0, 0.0, 0.0));
     size += n;
     is_accel_set = false;
+    modified = field_all;
     }
 
 template<class Real> bool SnapshotParticleData<Real>::validate() const
@@ -2864,6 +3509,8 @@ void ParticleData::removeParticles(std::vector<pdata_element>& out,
     if (m_prof)
         m_prof->push("pack");
 
+    maybeAllocateAlternateArrays();
+
     unsigned int num_remove_ptls = 0;
 
         {
@@ -3181,6 +3828,8 @@ void ParticleData::removeParticlesGPU(GlobalVector<pdata_element>& out,
     if (m_prof)
         m_prof->push(m_exec_conf, "pack");
 
+    maybeAllocateAlternateArrays();
+
     // this is the maximum number of elements we can possibly write to out
     unsigned int max_n_out = (unsigned int)out.getNumElements();
     if (comm_flags.getNumElements() < max_n_out)
@@ -3473,245 +4122,54 @@ void ParticleData::addParticlesGPU(const GlobalVector<pdata_element>& in)
 void ParticleData::setGPUAdvice()
     {
 #if defined(ENABLE_HIP) && defined(__HIP_PLATFORM_NVCC__)
-    if (m_exec_conf->isCUDAEnabled())
-        {
-        // only call CUDA API when necessary
-        if (m_memory_advice_last_Nmax == m_max_nparticles)
-            return;
-
-        m_memory_advice_last_Nmax = m_max_nparticles;
+    if (!m_exec_conf->isCUDAEnabled() || !m_exec_conf->allConcurrentManagedAccess())
+        return;
 
-        auto gpu_map = m_exec_conf->getGPUIds();
+    auto for_each_array = [this](bool alternate, auto f)
+    {
+        f(alternate ? m_pos_alt : m_pos);
+        f(alternate ? m_vel_alt : m_vel);
+        f(alternate ? m_accel_alt : m_accel);
+        f(alternate ? m_charge_alt : m_charge);
+        f(alternate ? m_diameter_alt : m_diameter);
+        f(alternate ? m_image_alt : m_image);
+        f(alternate ? m_tag_alt : m_tag);
+        f(alternate ? m_body_alt : m_body);
+        f(alternate ? m_orientation_alt : m_orientation);
+        f(alternate ? m_angmom_alt : m_angmom);
+        f(alternate ? m_inertia_alt : m_inertia);
+        f(alternate ? m_net_force_alt : m_net_force);
+        f(alternate ? m_net_virial_alt : m_net_virial);
+        f(alternate ? m_net_torque_alt : m_net_torque);
+    };
 
-        if (!m_exec_conf->allConcurrentManagedAccess())
-            return;
+    // the preferred locations only change with the partition, so only call the CUDA API then
+    if (m_memory_advice_last_Nmax != m_max_nparticles || m_memory_advice_last_N != getN())
+        {
+        m_memory_advice_last_Nmax = m_max_nparticles;
+        m_memory_advice_last_N = getN();
 
         // split preferred location of particle data across GPUs
-        for (unsigned int idev = 0; idev < m_exec_conf->getNumActiveGPUs(); ++idev)
-            {
-            auto range = m_gpu_partition.getRange(idev);
-            unsigned int nelem = range.second - range.first;
-
-            if (!nelem)
-                continue;
-
-            cudaMemAdvise(m_pos.get() + range.first,
-                          sizeof(Scalar4) * nelem,
-                          cudaMemAdviseSetPreferredLocation,
-                          gpu_map[idev]);
-            cudaMemAdvise(m_vel.get() + range.first,
-                          sizeof(Scalar4) * nelem,
-                          cudaMemAdviseSetPreferredLocation,
-                          gpu_map[idev]);
-            cudaMemAdvise(m_accel.get() + range.first,
-                          sizeof(Scalar3) * nelem,
-                          cudaMemAdviseSetPreferredLocation,
-                          gpu_map[idev]);
-            cudaMemAdvise(m_charge.get() + range.first,
-                          sizeof(Scalar) * nelem,
-                          cudaMemAdviseSetPreferredLocation,
-                          gpu_map[idev]);
-            cudaMemAdvise(m_diameter.get() + range.first,
-                          sizeof(Scalar) * nelem,
-                          cudaMemAdviseSetPreferredLocation,
-                          gpu_map[idev]);
-            cudaMemAdvise(m_image.get() + range.first,
-                          sizeof(int3) * nelem,
-                          cudaMemAdviseSetPreferredLocation,
-                          gpu_map[idev]);
-            cudaMemAdvise(m_tag.get() + range.first,
-                          sizeof(unsigned int) * nelem,
-                          cudaMemAdviseSetPreferredLocation,
-                          gpu_map[idev]);
-            cudaMemAdvise(m_body.get() + range.first,
-                          sizeof(unsigned int) * nelem,
-                          cudaMemAdviseSetPreferredLocation,
-                          gpu_map[idev]);
-            cudaMemAdvise(m_orientation.get() + range.first,
-                          sizeof(Scalar4) * nelem,
-                          cudaMemAdviseSetPreferredLocation,
-                          gpu_map[idev]);
-            cudaMemAdvise(m_angmom.get() + range.first,
-                          sizeof(Scalar4) * nelem,
-                          cudaMemAdviseSetPreferredLocation,
-                          gpu_map[idev]);
-            cudaMemAdvise(m_inertia.get() + range.first,
-                          sizeof(Scalar3) * nelem,
-                          cudaMemAdviseSetPreferredLocation,
-                          gpu_map[idev]);
-            cudaMemAdvise(m_net_force.get() + range.first,
-                          sizeof(Scalar4) * nelem,
-                          cudaMemAdviseSetPreferredLocation,
-                          gpu_map[idev]);
-            for (unsigned int i = 0; i < 6; ++i)
-                cudaMemAdvise(m_net_virial.get() + i * m_net_virial.getPitch() + range.first,
-                              sizeof(Scalar) * nelem,
-                              cudaMemAdviseSetPreferredLocation,
-                              gpu_map[idev]);
-            cudaMemAdvise(m_net_torque.get() + range.first,
-                          sizeof(Scalar4) * nelem,
-                          cudaMemAdviseSetPreferredLocation,
-                          gpu_map[idev]);
-
-            // migrate data to preferred location
-            cudaMemPrefetchAsync(m_pos.get() + range.first, sizeof(Scalar4) * nelem, gpu_map[idev]);
-            cudaMemPrefetchAsync(m_vel.get() + range.first, sizeof(Scalar4) * nelem, gpu_map[idev]);
-            cudaMemPrefetchAsync(m_accel.get() + range.first,
-                                 sizeof(Scalar3) * nelem,
-                                 gpu_map[idev]);
-            cudaMemPrefetchAsync(m_charge.get() + range.first,
-                                 sizeof(Scalar) * nelem,
-                                 gpu_map[idev]);
-            cudaMemPrefetchAsync(m_diameter.get() + range.first,
-                                 sizeof(Scalar) * nelem,
-                                 gpu_map[idev]);
-            cudaMemPrefetchAsync(m_image.get() + range.first, sizeof(int3) * nelem, gpu_map[idev]);
-            cudaMemPrefetchAsync(m_tag.get() + range.first,
-                                 sizeof(unsigned int) * nelem,
-                                 gpu_map[idev]);
-            cudaMemPrefetchAsync(m_body.get() + range.first,
-                                 sizeof(unsigned int) * nelem,
-                                 gpu_map[idev]);
-            cudaMemPrefetchAsync(m_orientation.get() + range.first,
-                                 sizeof(Scalar4) * nelem,
-                                 gpu_map[idev]);
-            cudaMemPrefetchAsync(m_angmom.get() + range.first,
-                                 sizeof(Scalar4) * nelem,
-                                 gpu_map[idev]);
-            cudaMemPrefetchAsync(m_inertia.get() + range.first,
-                                 sizeof(Scalar3) * nelem,
-                                 gpu_map[idev]);
-            cudaMemPrefetchAsync(m_net_force.get() + range.first,
-                                 sizeof(Scalar4) * nelem,
-                                 gpu_map[idev]);
-            for (unsigned int i = 0; i < 6; ++i)
-                cudaMemPrefetchAsync(m_net_virial.get() + i * m_net_virial.getPitch() + range.first,
-                                     sizeof(Scalar) * nelem,
-                                     gpu_map[idev]);
-            cudaMemPrefetchAsync(m_net_torque.get() + range.first,
-                                 sizeof(Scalar4) * nelem,
-                                 gpu_map[idev]);
-            }
-        CHECK_CUDA_ERROR();
+        for_each_array(false,
+                       [this](const auto& array) { array.setPartitionAdvice(m_gpu_partition); });
 
         if (!m_pos_alt.isNull())
             {
-            for (unsigned int idev = 0; idev < m_exec_conf->getNumActiveGPUs(); ++idev)
-                {
-                auto range = m_gpu_partition.getRange(idev);
-                unsigned int nelem = range.second - range.first;
-
-                if (!nelem)
-                    continue;
-
-                cudaMemAdvise(m_pos_alt.get() + range.first,
-                              sizeof(Scalar4) * nelem,
-                              cudaMemAdviseSetPreferredLocation,
-                              gpu_map[idev]);
-                cudaMemAdvise(m_vel_alt.get() + range.first,
-                              sizeof(Scalar4) * nelem,
-                              cudaMemAdviseSetPreferredLocation,
-                              gpu_map[idev]);
-                cudaMemAdvise(m_accel_alt.get() + range.first,
-                              sizeof(Scalar3) * nelem,
-                              cudaMemAdviseSetPreferredLocation,
-                              gpu_map[idev]);
-                cudaMemAdvise(m_charge_alt.get() + range.first,
-                              sizeof(Scalar) * nelem,
-                              cudaMemAdviseSetPreferredLocation,
-                              gpu_map[idev]);
-                cudaMemAdvise(m_diameter_alt.get() + range.first,
-                              sizeof(Scalar) * nelem,
-                              cudaMemAdviseSetPreferredLocation,
-                              gpu_map[idev]);
-                cudaMemAdvise(m_image_alt.get() + range.first,
-                              sizeof(int3) * nelem,
-                              cudaMemAdviseSetPreferredLocation,
-                              gpu_map[idev]);
-                cudaMemAdvise(m_tag_alt.get() + range.first,
-                              sizeof(unsigned int) * nelem,
-                              cudaMemAdviseSetPreferredLocation,
-                              gpu_map[idev]);
-                cudaMemAdvise(m_body_alt.get() + range.first,
-                              sizeof(unsigned int) * nelem,
-                              cudaMemAdviseSetPreferredLocation,
-                              gpu_map[idev]);
-                cudaMemAdvise(m_orientation_alt.get() + range.first,
-                              sizeof(Scalar4) * nelem,
-                              cudaMemAdviseSetPreferredLocation,
-                              gpu_map[idev]);
-                cudaMemAdvise(m_angmom_alt.get() + range.first,
-                              sizeof(Scalar4) * nelem,
-                              cudaMemAdviseSetPreferredLocation,
-                              gpu_map[idev]);
-                cudaMemAdvise(m_inertia_alt.get() + range.first,
-                              sizeof(Scalar3) * nelem,
-                              cudaMemAdviseSetPreferredLocation,
-                              gpu_map[idev]);
-                cudaMemAdvise(m_net_force_alt.get() + range.first,
-                              sizeof(Scalar4) * nelem,
-                              cudaMemAdviseSetPreferredLocation,
-                              gpu_map[idev]);
-                for (unsigned int i = 0; i < 6; ++i)
-                    cudaMemAdvise(m_net_virial_alt.get() + i * m_net_virial_alt.getPitch()
-                                      + range.first,
-                                  sizeof(Scalar) * nelem,
-                                  cudaMemAdviseSetPreferredLocation,
-                                  gpu_map[idev]);
-                cudaMemAdvise(m_net_torque_alt.get() + range.first,
-                              sizeof(Scalar4) * nelem,
-                              cudaMemAdviseSetPreferredLocation,
-                              gpu_map[idev]);
-
-                cudaMemPrefetchAsync(m_pos_alt.get() + range.first,
-                                     sizeof(Scalar4) * nelem,
-                                     gpu_map[idev]);
-                cudaMemPrefetchAsync(m_vel_alt.get() + range.first,
-                                     sizeof(Scalar4) * nelem,
-                                     gpu_map[idev]);
-                cudaMemPrefetchAsync(m_accel_alt.get() + range.first,
-                                     sizeof(Scalar3) * nelem,
-                                     gpu_map[idev]);
-                cudaMemPrefetchAsync(m_charge_alt.get() + range.first,
-                                     sizeof(Scalar) * nelem,
-                                     gpu_map[idev]);
-                cudaMemPrefetchAsync(m_diameter_alt.get() + range.first,
-                                     sizeof(Scalar) * nelem,
-                                     gpu_map[idev]);
-                cudaMemPrefetchAsync(m_image_alt.get() + range.first,
-                                     sizeof(int3) * nelem,
-                                     gpu_map[idev]);
-                cudaMemPrefetchAsync(m_tag_alt.get() + range.first,
-                                     sizeof(unsigned int) * nelem,
-                                     gpu_map[idev]);
-                cudaMemPrefetchAsync(m_body_alt.get() + range.first,
-                                     sizeof(unsigned int) * nelem,
-                                     gpu_map[idev]);
-                cudaMemPrefetchAsync(m_orientation_alt.get() + range.first,
-                                     sizeof(Scalar4) * nelem,
-                                     gpu_map[idev]);
-                cudaMemPrefetchAsync(m_angmom_alt.get() + range.first,
-                                     sizeof(Scalar4) * nelem,
-                                     gpu_map[idev]);
-                cudaMemPrefetchAsync(m_inertia_alt.get() + range.first,
-                                     sizeof(Scalar3) * nelem,
-                                     gpu_map[idev]);
-                cudaMemPrefetchAsync(m_net_force_alt.get() + range.first,
-                                     sizeof(Scalar4) * nelem,
-                                     gpu_map[idev]);
-                for (unsigned int i = 0; i < 6; ++i)
-                    cudaMemPrefetchAsync(m_net_virial_alt.get() + i * m_net_virial_alt.getPitch()
-                                             + range.first,
-                                         sizeof(Scalar) * nelem,
-                                         gpu_map[idev]);
-                cudaMemPrefetchAsync(m_net_torque_alt.get() + range.first,
-                                     sizeof(Scalar4) * nelem,
-                                     gpu_map[idev]);
-                }
-
-            CHECK_CUDA_ERROR();
+            for_each_array(true,
+                           [this](const auto& array)
+                           {
+                               array.setPartitionAdvice(m_gpu_partition);
+                               array.prefetchPartition(m_gpu_partition);
+                           });
             }
         }
+
+    // sorts and migrations rewrite the particle data on the host or on a single GPU, migrate
+    // every GPU's range back before the next kernel launch touches it
+    for_each_array(false, [this](const auto& array) { array.prefetchPartition(m_gpu_partition); });
+
+    if (m_exec_conf->isCUDAErrorCheckingEnabled())
+        CHECK_CUDA_ERROR();
 #endif
     }
 
@@ -3722,67 +4180,90 @@ void SnapshotParticleData<Real>::replicate(unsigned int nx,
                                            const BoxDim& old_box,
                                            const BoxDim& new_box)
     {
-    unsigned int old_size = size;
+    SnapshotParticleData<Real> unit_cell(*this);
+    replicateImages(unit_cell, nx, ny, nz, old_box, new_box, 0, nx * ny * nz);
+    }
+
+/*! The images are numbered with z running fastest, then y, then x. The copy of particle i in image
+   j is placed at index (j - first_image) * unit_cell.size + i, so a range of images holds a
+   contiguous range of the tags of the fully replicated system.
+*/
+template<class Real>
+void SnapshotParticleData<Real>::replicateImages(const SnapshotParticleData<Real>& unit_cell,
+                                                 unsigned int nx,
+                                                 unsigned int ny,
+                                                 unsigned int nz,
+                                                 const BoxDim& old_box,
+                                                 const BoxDim& new_box,
+                                                 unsigned int first_image,
+                                                 unsigned int n_images)
+    {
+    unsigned int old_size = unit_cell.size;
+
+    if (uint64_t(old_size) * nx * ny * nz > std::numeric_limits<unsigned int>::max())
+        throw std::runtime_error("Replication would create more particles than HOOMD supports!");
 
     // resize snapshot
-    resize(old_size * nx * ny * nz);
+    resize(old_size * n_images);
+    type_mapping = unit_cell.type_mapping;
+    is_accel_set = unit_cell.is_accel_set;
 
     for (unsigned int i = 0; i < old_size; ++i)
         {
         // unwrap position of particle i in old box using image flags
-        vec3<Real> p = pos[i];
-        int3 img = image[i];
+        vec3<Real> p = unit_cell.pos[i];
+        int3 img = unit_cell.image[i];
 
         // need to cast to a scalar and back because the Box is in Scalars, but we might be in a
         // different type
         p = vec3<Real>(old_box.shift(vec3<Scalar>(p), img));
         vec3<Real> f = old_box.makeFraction(p);
 
-        unsigned int j = 0;
-        for (unsigned int l = 0; l < nx; l++)
-            for (unsigned int m = 0; m < ny; m++)
-                for (unsigned int n = 0; n < nz; n++)
-                    {
-                    Scalar3 f_new;
-                    // replicate particle
-                    f_new.x = f.x / (Real)nx + (Real)l / (Real)nx;
-                    f_new.y = f.y / (Real)ny + (Real)m / (Real)ny;
-                    f_new.z = f.z / (Real)nz + (Real)n / (Real)nz;
-
-                    unsigned int k = j * old_size + i;
-
-                    // coordinates in new box
-                    Scalar3 q = new_box.makeCoordinates(f_new);
-
-                    // wrap by multiple box vectors if necessary
-                    image[k] = new_box.getImage(q);
-                    int3 negimg = make_int3(-image[k].x, -image[k].y, -image[k].z);
-                    q = new_box.shift(q, negimg);
-
-                    // rewrap using wrap so that rounding is consistent
-                    new_box.wrap(q, image[k]);
-
-                    pos[k] = vec3<Real>(q);
-                    vel[k] = vel[i];
-                    accel[k] = accel[i];
-                    type[k] = type[i];
-                    mass[k] = mass[i];
-                    charge[k] = charge[i];
-                    diameter[k] = diameter[i];
-                    // This math also accounts for floppy bodies since body[i]
-                    // is already greater than MIN_FLOPPY, so the new body id
-                    // body[k] is guaranteed to be so as well. However, we
-                    // check to ensure that something that wasn't originally a
-                    // floppy body doesn't overflow into the floppy body tags.
-                    body[k] = (body[i] != NO_BODY ? j * old_size + body[i] : NO_BODY);
-                    if (body[i] < MIN_FLOPPY && body[k] >= MIN_FLOPPY)
-                        throw std::runtime_error("Replication would create more distinct rigid "
-                                                 "bodies than HOOMD supports!");
-                    orientation[k] = orientation[i];
-                    angmom[k] = angmom[i];
-                    inertia[k] = inertia[i];
-                    j++;
-                    }
+        for (unsigned int j = first_image; j < first_image + n_images; j++)
+            {
+            unsigned int l = j / (ny * nz);
+            unsigned int m = (j / nz) % ny;
+            unsigned int n = j % nz;
+
+            Scalar3 f_new;
+            // replicate particle
+            f_new.x = f.x / (Real)nx + (Real)l / (Real)nx;
+            f_new.y = f.y / (Real)ny + (Real)m / (Real)ny;
+            f_new.z = f.z / (Real)nz + (Real)n / (Real)nz;
+
+            unsigned int k = (j - first_image) * old_size + i;
+
+            // coordinates in new box
+            Scalar3 q = new_box.makeCoordinates(f_new);
+
+            // wrap by multiple box vectors if necessary
+            image[k] = new_box.getImage(q);
+            int3 negimg = make_int3(-image[k].x, -image[k].y, -image[k].z);
+            q = new_box.shift(q, negimg);
+
+            // rewrap using wrap so that rounding is consistent
+            new_box.wrap(q, image[k]);
+
+            pos[k] = vec3<Real>(q);
+            vel[k] = unit_cell.vel[i];
+            accel[k] = unit_cell.accel[i];
+            type[k] = unit_cell.type[i];
+            mass[k] = unit_cell.mass[i];
+            charge[k] = unit_cell.charge[i];
+            diameter[k] = unit_cell.diameter[i];
+            // This math also accounts for floppy bodies since body[i]
+            // is already greater than MIN_FLOPPY, so the new body id
+            // body[k] is guaranteed to be so as well. However, we
+            // check to ensure that something that wasn't originally a
+            // floppy body doesn't overflow into the floppy body tags.
+            body[k] = (unit_cell.body[i] != NO_BODY ? j * old_size + unit_cell.body[i] : NO_BODY);
+            if (unit_cell.body[i] < MIN_FLOPPY && body[k] >= MIN_FLOPPY)
+                throw std::runtime_error("Replication would create more distinct rigid "
+                                         "bodies than HOOMD supports!");
+            orientation[k] = unit_cell.orientation[i];
+            angmom[k] = unit_cell.angmom[i];
+            inertia[k] = unit_cell.inertia[i];
+            }
         }
     }
 
@@ -3795,6 +4276,7 @@ template<class Real> py::object SnapshotParticleData<Real>::getPosNP(pybind11::o
     auto self_cpp = self.cast<SnapshotParticleData<Real>*>();
     // mark as dirty when accessing internal data
     self_cpp->is_accel_set = false;
+    self_cpp->modified |= field_pos;
 
     std::vector<size_t> dims(2);
     dims[0] = self_cpp->pos.size();
@@ -3811,6 +4293,7 @@ template<class Real> py::object SnapshotParticleData<Real>::getVelNP(pybind11::o
     auto self_cpp = self.cast<SnapshotParticleData<Real>*>();
     // mark as dirty when accessing internal data
     self_cpp->is_accel_set = false;
+    self_cpp->modified |= field_vel;
 
     std::vector<size_t> dims(2);
     dims[0] = self_cpp->pos.size();
@@ -3827,6 +4310,7 @@ template<class Real> py::object SnapshotParticleData<Real>::getAccelNP(pybind11:
     auto self_cpp = self.cast<SnapshotParticleData<Real>*>();
     // mark as dirty when accessing internal data
     self_cpp->is_accel_set = false;
+    self_cpp->modified |= field_accel;
 
     std::vector<size_t> dims(2);
     dims[0] = self_cpp->pos.size();
@@ -3843,6 +4327,7 @@ template<class Real> py::object SnapshotParticleData<Real>::getTypeNP(pybind11::
     auto self_cpp = self.cast<SnapshotParticleData<Real>*>();
     // mark as dirty when accessing internal data
     self_cpp->is_accel_set = false;
+    self_cpp->modified |= field_type;
 
     return pybind11::array(self_cpp->type.size(), &self_cpp->type[0], self);
     }
@@ -3856,6 +4341,7 @@ template<class Real> py::object SnapshotParticleData<Real>::getMassNP(pybind11::
     auto self_cpp = self.cast<SnapshotParticleData<Real>*>();
     // mark as dirty when accessing internal data
     self_cpp->is_accel_set = false;
+    self_cpp->modified |= field_mass;
 
     return pybind11::array(self_cpp->mass.size(), &self_cpp->mass[0], self);
     }
@@ -3869,6 +4355,7 @@ template<class Real> py::object SnapshotParticleData<Real>::getChargeNP(pybind11
     auto self_cpp = self.cast<SnapshotParticleData<Real>*>();
     // mark as dirty when accessing internal data
     self_cpp->is_accel_set = false;
+    self_cpp->modified |= field_charge;
 
     return pybind11::array(self_cpp->charge.size(), &self_cpp->charge[0], self);
     }
@@ -3882,6 +4369,7 @@ template<class Real> py::object SnapshotParticleData<Real>::getDiameterNP(pybind
     auto self_cpp = self.cast<SnapshotParticleData<Real>*>();
     // mark as dirty when accessing internal data
     self_cpp->is_accel_set = false;
+    self_cpp->modified |= field_diameter;
 
     return pybind11::array(self_cpp->diameter.size(), &self_cpp->diameter[0], self);
     }
@@ -3895,6 +4383,7 @@ template<class Real> py::object SnapshotParticleData<Real>::getImageNP(pybind11:
     auto self_cpp = self.cast<SnapshotParticleData<Real>*>();
     // mark as dirty when accessing internal data
     self_cpp->is_accel_set = false;
+    self_cpp->modified |= field_image;
 
     std::vector<size_t> dims(2);
     dims[0] = self_cpp->pos.size();
@@ -3911,6 +4400,7 @@ template<class Real> py::object SnapshotParticleData<Real>::getBodyNP(pybind11::
     auto self_cpp = self.cast<SnapshotParticleData<Real>*>();
     // mark as dirty when accessing internal data
     self_cpp->is_accel_set = false;
+    self_cpp->modified |= field_body;
 
     return pybind11::array(self_cpp->body.size(), (int*)&self_cpp->body[0], self);
     }
@@ -3924,6 +4414,7 @@ template<class Real> py::object SnapshotParticleData<Real>::getOrientationNP(pyb
     auto self_cpp = self.cast<SnapshotParticleData<Real>*>();
     // mark as dirty when accessing internal data
     self_cpp->is_accel_set = false;
+    self_cpp->modified |= field_orientation;
 
     std::vector<size_t> dims(2);
     dims[0] = self_cpp->pos.size();
@@ -3941,6 +4432,7 @@ py::object SnapshotParticleData<Real>::getMomentInertiaNP(pybind11::object self)
     auto self_cpp = self.cast<SnapshotParticleData<Real>*>();
     // mark as dirty when accessing internal data
     self_cpp->is_accel_set = false;
+    self_cpp->modified |= field_inertia;
 
     std::vector<size_t> dims(2);
     dims[0] = self_cpp->inertia.size();
@@ -3957,6 +4449,7 @@ template<class Real> py::object SnapshotParticleData<Real>::getAngmomNP(pybind11
     auto self_cpp = self.cast<SnapshotParticleData<Real>*>();
     // mark as dirty when accessing internal data
     self_cpp->is_accel_set = false;
+    self_cpp->modified |= field_angmom;
 
     std::vector<size_t> dims(2);
     dims[0] = self_cpp->angmom.size();
@@ -3982,6 +4475,7 @@ template<class Real> void SnapshotParticleData<Real>::setTypes(py::list types)
     {
     // set dirty
     is_accel_set = false;
+    modified = field_all;
 
     type_mapping.resize(len(types));
 
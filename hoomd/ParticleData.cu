@@ -486,3 +486,339 @@ void gpu_pdata_add_particles(const unsigned int old_nparticles,
     }
 
 #endif // ENABLE_MPI
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wconversion"
+#include <thrust/copy.h>
+#include <thrust/count.h>
+#include <thrust/device_ptr.h>
+#include <thrust/execution_policy.h>
+#include <thrust/functional.h>
+#include <thrust/iterator/counting_iterator.h>
+#pragma GCC diagnostic pop
+
+//! Kernel to initialize a batch of new particles
+__global__ void gpu_pdata_add_particle_batch_kernel(const unsigned int old_nparticles,
+                                                    const unsigned int n_add,
+                                                    const bool is_local,
+                                                    const unsigned int* d_new_tags,
+                                                    const unsigned int* d_new_types,
+                                                    Scalar4* d_pos,
+                                                    Scalar4* d_vel,
+                                                    Scalar3* d_accel,
+                                                    Scalar* d_charge,
+                                                    Scalar* d_diameter,
+                                                    int3* d_image,
+                                                    unsigned int* d_body,
+                                                    Scalar4* d_orientation,
+                                                    Scalar4* d_angmom,
+                                                    Scalar3* d_inertia,
+                                                    unsigned int* d_tag,
+                                                    unsigned int* d_rtag,
+                                                    unsigned int* d_comm_flags)
+    {
+    unsigned int i = blockIdx.x * blockDim.x + threadIdx.x;
+
+    if (i >= n_add)
+        return;
+
+    unsigned int tag = d_new_tags[i];
+
+    // the particles are not on this rank
+    if (!is_local)
+        {
+        d_rtag[tag] = NOT_LOCAL;
+        return;
+        }
+
+    unsigned int idx = old_nparticles + i;
+    d_rtag[tag] = idx;
+
+    d_pos[idx] = make_scalar4(0, 0, 0, __int_as_scalar(d_new_types[i]));
+    d_vel[idx] = make_scalar4(0, 0, 0, 1.0);
+    d_accel[idx] = make_scalar3(0, 0, 0);
+    d_charge[idx] = 0.0;
+    d_diameter[idx] = 1.0;
+    d_image[idx] = make_int3(0, 0, 0);
+    d_body[idx] = NO_BODY;
+    d_orientation[idx] = make_scalar4(1.0, 0.0, 0.0, 0.0);
+    d_angmom[idx] = make_scalar4(0, 0, 0, 0);
+    d_inertia[idx] = make_scalar3(0, 0, 0);
+    d_tag[idx] = tag;
+    d_comm_flags[idx] = 0;
+    }
+
+/*! \param old_nparticles Number of local particles before the insertion
+    \param n_add Number of particles to add
+    \param is_local True when the new particles are added on this rank
+    \param d_new_tags Tags of the new particles
+    \param d_new_types Types of the new particles
+    \param d_pos Device array of particle positions
+    \param d_vel Device array of particle velocities
+    \param d_accel Device array of particle accelerations
+    \param d_charge Device array of particle charges
+    \param d_diameter Device array of particle diameters
+    \param d_image Device array of particle images
+    \param d_body Device array of particle body tags
+    \param d_orientation Device array of particle orientations
+    \param d_angmom Device array of particle angular momenta
+    \param d_inertia Device array of particle moments of inertia
+    \param d_tag Device array of particle tags
+    \param d_rtag Device array for reverse-lookup table
+    \param d_comm_flags Device array of communication flags
+
+    The new particles take default values and are appended after the existing ones.
+*/
+void gpu_pdata_add_particle_batch(const unsigned int old_nparticles,
+                                  const unsigned int n_add,
+                                  const bool is_local,
+                                  const unsigned int* d_new_tags,
+                                  const unsigned int* d_new_types,
+                                  Scalar4* d_pos,
+                                  Scalar4* d_vel,
+                                  Scalar3* d_accel,
+                                  Scalar* d_charge,
+                                  Scalar* d_diameter,
+                                  int3* d_image,
+                                  unsigned int* d_body,
+                                  Scalar4* d_orientation,
+                                  Scalar4* d_angmom,
+                                  Scalar3* d_inertia,
+                                  unsigned int* d_tag,
+                                  unsigned int* d_rtag,
+                                  unsigned int* d_comm_flags)
+    {
+    assert(d_new_tags);
+    assert(d_new_types);
+    assert(d_rtag);
+
+    if (n_add == 0)
+        return;
+
+    unsigned int block_size = 256;
+    unsigned int n_blocks = n_add / block_size + 1;
+
+    hipLaunchKernelGGL(gpu_pdata_add_particle_batch_kernel,
+                       dim3(n_blocks),
+                       dim3(block_size),
+                       0,
+                       0,
+                       old_nparticles,
+                       n_add,
+                       is_local,
+                       d_new_tags,
+                       d_new_types,
+                       d_pos,
+                       d_vel,
+                       d_accel,
+                       d_charge,
+                       d_diameter,
+                       d_image,
+                       d_body,
+                       d_orientation,
+                       d_angmom,
+                       d_inertia,
+                       d_tag,
+                       d_rtag,
+                       d_comm_flags);
+    }
+
+//! Kernel to flag the local particles of a removal batch and clear their reverse-lookup entries
+__global__ void gpu_pdata_flag_removed_kernel(const unsigned int N,
+                                              const unsigned int n_remove,
+                                              const unsigned int* d_remove_tags,
+                                              unsigned int* d_rtag,
+                                              unsigned int* d_flags)
+    {
+    unsigned int i = blockIdx.x * blockDim.x + threadIdx.x;
+
+    if (i >= n_remove)
+        return;
+
+    unsigned int tag = d_remove_tags[i];
+    unsigned int idx = d_rtag[tag];
+    d_rtag[tag] = NOT_LOCAL;
+
+    if (idx < N)
+        d_flags[idx] = 1;
+    }
+
+//! Kernel to move the surviving particles from the end of the arrays into the holes
+__global__ void gpu_pdata_fill_holes_kernel(const unsigned int n_holes,
+                                            const unsigned int* d_holes,
+                                            const unsigned int* d_movers,
+                                            Scalar4* d_pos,
+                                            Scalar4* d_vel,
+                                            Scalar3* d_accel,
+                                            Scalar* d_charge,
+                                            Scalar* d_diameter,
+                                            int3* d_image,
+                                            unsigned int* d_body,
+                                            Scalar4* d_orientation,
+                                            Scalar4* d_angmom,
+                                            Scalar3* d_inertia,
+                                            unsigned int* d_tag,
+                                            unsigned int* d_rtag,
+                                            unsigned int* d_comm_flags)
+    {
+    unsigned int i = blockIdx.x * blockDim.x + threadIdx.x;
+
+    if (i >= n_holes)
+        return;
+
+    unsigned int dst = d_holes[i];
+    unsigned int src = d_movers[i];
+
+    d_pos[dst] = d_pos[src];
+    d_vel[dst] = d_vel[src];
+    d_accel[dst] = d_accel[src];
+    d_charge[dst] = d_charge[src];
+    d_diameter[dst] = d_diameter[src];
+    d_image[dst] = d_image[src];
+    d_body[dst] = d_body[src];
+    d_orientation[dst] = d_orientation[src];
+    d_angmom[dst] = d_angmom[src];
+    d_inertia[dst] = d_inertia[src];
+    d_comm_flags[dst] = d_comm_flags[src];
+
+    unsigned int tag = d_tag[src];
+    d_tag[dst] = tag;
+    d_rtag[tag] = dst;
+    }
+
+/*! \param N Number of local particles before the removal
+    \param n_remove Number of tags to remove
+    \param d_remove_tags Tags of the particles to remove (local or not)
+    \param d_pos Device array of particle positions
+    \param d_vel Device array of particle velocities
+    \param d_accel Device array of particle accelerations
+    \param d_charge Device array of particle charges
+    \param d_diameter Device array of particle diameters
+    \param d_image Device array of particle images
+    \param d_body Device array of particle body tags
+    \param d_orientation Device array of particle orientations
+    \param d_angmom Device array of particle angular momenta
+    \param d_inertia Device array of particle moments of inertia
+    \param d_tag Device array of particle tags
+    \param d_rtag Device array for reverse-lookup table
+    \param d_comm_flags Device array of communication flags
+    \param alloc Caching allocator for temporary storage
+
+    \returns The number of local particles after the removal
+
+    Removed particles leave holes in the first N_new = N - n_removed slots. The surviving particles
+    in the slots past N_new fill these holes in order, so only the tail of the arrays moves.
+*/
+unsigned int gpu_pdata_remove_particle_batch(const unsigned int N,
+                                             const unsigned int n_remove,
+                                             const unsigned int* d_remove_tags,
+                                             Scalar4* d_pos,
+                                             Scalar4* d_vel,
+                                             Scalar3* d_accel,
+                                             Scalar* d_charge,
+                                             Scalar* d_diameter,
+                                             int3* d_image,
+                                             unsigned int* d_body,
+                                             Scalar4* d_orientation,
+                                             Scalar4* d_angmom,
+                                             Scalar3* d_inertia,
+                                             unsigned int* d_tag,
+                                             unsigned int* d_rtag,
+                                             unsigned int* d_comm_flags,
+                                             CachedAllocator& alloc)
+    {
+    assert(d_remove_tags);
+    assert(d_rtag);
+
+    if (n_remove == 0)
+        return N;
+
+    unsigned int* d_flags = alloc.getTemporaryBuffer<unsigned int>(N + 1);
+    hipMemsetAsync(d_flags, 0, sizeof(unsigned int) * (N + 1));
+
+    unsigned int block_size = 256;
+    hipLaunchKernelGGL(gpu_pdata_flag_removed_kernel,
+                       dim3(n_remove / block_size + 1),
+                       dim3(block_size),
+                       0,
+                       0,
+                       N,
+                       n_remove,
+                       d_remove_tags,
+                       d_rtag,
+                       d_flags);
+
+    thrust::device_ptr<unsigned int> flags(d_flags);
+#ifdef __HIP_PLATFORM_HCC__
+    unsigned int n_removed = (unsigned int)thrust::count(thrust::hip::par(alloc),
+#else
+    unsigned int n_removed = (unsigned int)thrust::count(thrust::cuda::par(alloc),
+#endif
+                                                         flags,
+                                                         flags + N,
+                                                         1u);
+    unsigned int N_new = N - n_removed;
+
+    if (n_removed > 0)
+        {
+        unsigned int* d_holes = alloc.getTemporaryBuffer<unsigned int>(n_removed);
+        unsigned int* d_movers = alloc.getTemporaryBuffer<unsigned int>(n_removed);
+        thrust::device_ptr<unsigned int> holes(d_holes);
+        thrust::device_ptr<unsigned int> movers(d_movers);
+
+        // flagged slots below N_new are holes, unflagged slots past N_new hold their fillers
+#ifdef __HIP_PLATFORM_HCC__
+        auto holes_end = thrust::copy_if(thrust::hip::par(alloc),
+#else
+        auto holes_end = thrust::copy_if(thrust::cuda::par(alloc),
+#endif
+                                         thrust::counting_iterator<unsigned int>(0),
+                                         thrust::counting_iterator<unsigned int>(N_new),
+                                         flags,
+                                         holes,
+                                         thrust::identity<unsigned int>());
+#ifdef __HIP_PLATFORM_HCC__
+        thrust::copy_if(thrust::hip::par(alloc),
+#else
+        thrust::copy_if(thrust::cuda::par(alloc),
+#endif
+                        thrust::counting_iterator<unsigned int>(N_new),
+                        thrust::counting_iterator<unsigned int>(N),
+                        flags + N_new,
+                        movers,
+                        thrust::logical_not<unsigned int>());
+
+        unsigned int n_holes = (unsigned int)(holes_end - holes);
+        if (n_holes > 0)
+            {
+            hipLaunchKernelGGL(gpu_pdata_fill_holes_kernel,
+                               dim3(n_holes / block_size + 1),
+                               dim3(block_size),
+                               0,
+                               0,
+                               n_holes,
+                               d_holes,
+                               d_movers,
+                               d_pos,
+                               d_vel,
+                               d_accel,
+                               d_charge,
+                               d_diameter,
+                               d_image,
+                               d_body,
+                               d_orientation,
+                               d_angmom,
+                               d_inertia,
+                               d_tag,
+                               d_rtag,
+                               d_comm_flags);
+            }
+
+        alloc.deallocate((char*)d_movers);
+        alloc.deallocate((char*)d_holes);
+        }
+
+    alloc.deallocate((char*)d_flags);
+
+    return N_new;
+    }
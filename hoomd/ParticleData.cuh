@@ -113,4 +113,43 @@ void gpu_pdata_add_particles(const unsigned int old_nparticles,
                              unsigned int* d_rtag,
                              const pdata_element* d_in,
                              unsigned int* d_comm_flags);
+
+//! Initialize a batch of new particles at the end of the arrays and their reverse-lookup entries
+void gpu_pdata_add_particle_batch(const unsigned int old_nparticles,
+                                  const unsigned int n_add,
+                                  const bool is_local,
+                                  const unsigned int* d_new_tags,
+                                  const unsigned int* d_new_types,
+                                  Scalar4* d_pos,
+                                  Scalar4* d_vel,
+                                  Scalar3* d_accel,
+                                  Scalar* d_charge,
+                                  Scalar* d_diameter,
+                                  int3* d_image,
+                                  unsigned int* d_body,
+                                  Scalar4* d_orientation,
+                                  Scalar4* d_angmom,
+                                  Scalar3* d_inertia,
+                                  unsigned int* d_tag,
+                                  unsigned int* d_rtag,
+                                  unsigned int* d_comm_flags);
+
+//! Remove a batch of particles and compact the arrays
+unsigned int gpu_pdata_remove_particle_batch(const unsigned int N,
+                                             const unsigned int n_remove,
+                                             const unsigned int* d_remove_tags,
+                                             Scalar4* d_pos,
+                                             Scalar4* d_vel,
+                                             Scalar3* d_accel,
+                                             Scalar* d_charge,
+                                             Scalar* d_diameter,
+                                             int3* d_image,
+                                             unsigned int* d_body,
+                                             Scalar4* d_orientation,
+                                             Scalar4* d_angmom,
+                                             Scalar3* d_inertia,
+                                             unsigned int* d_tag,
+                                             unsigned int* d_rtag,
+                                             unsigned int* d_comm_flags,
+                                             CachedAllocator& alloc);
 #endif
@@ -154,8 +154,29 @@ std::string getDefaultTypeName(unsigned int id);
  */
 template<class Real> struct PYBIND11_EXPORT SnapshotParticleData
     {
+    //! Flags of the per-particle arrays, to mark them as modified
+    enum Field : unsigned int
+        {
+        field_pos = 1 << 0,
+        field_vel = 1 << 1,
+        field_accel = 1 << 2,
+        field_type = 1 << 3,
+        field_mass = 1 << 4,
+        field_charge = 1 << 5,
+        field_diameter = 1 << 6,
+        field_image = 1 << 7,
+        field_body = 1 << 8,
+        field_orientation = 1 << 9,
+        field_angmom = 1 << 10,
+        field_inertia = 1 << 11,
+        field_all = (1 << 12) - 1
+        };
+
     //! Empty snapshot
-    SnapshotParticleData() : size(0), is_accel_set(false) { }
+    SnapshotParticleData()
+        : size(0), is_accel_set(false), is_distributed(false), modified(field_all)
+        {
+        }
 
     //! constructor
     /*! \param N number of particles to allocate memory for
@@ -201,6 +222,25 @@ template<class Real> struct PYBIND11_EXPORT SnapshotParticleData
                    const BoxDim& old_box,
                    const BoxDim& new_box);
 
+    //! Fill this snapshot with a range of the periodic images of a unit cell
+    /*! \param unit_cell Snapshot to replicate
+     *  \param nx Number of times to replicate the unit cell along the x direction
+     *  \param ny Number of times to replicate the unit cell along the y direction
+     *  \param nz Number of times to replicate the unit cell along the z direction
+     *  \param old_box Box of the unit cell
+     *  \param new_box Dimensions of replicated box
+     *  \param first_image Index of the first image to place in this snapshot
+     *  \param n_images Number of images to place in this snapshot
+     */
+    void replicateImages(const SnapshotParticleData<Real>& unit_cell,
+                         unsigned int nx,
+                         unsigned int ny,
+                         unsigned int nz,
+                         const BoxDim& old_box,
+                         const BoxDim& new_box,
+                         unsigned int first_image,
+                         unsigned int n_images);
+
     //! Get pos as a Python object
     static pybind11::object getPosNP(pybind11::object self);
     //! Get vel as a Python object
@@ -248,6 +288,14 @@ template<class Real> struct PYBIND11_EXPORT SnapshotParticleData
     std::vector<std::string> type_mapping; //!< Mapping between particle type ids and names
 
     bool is_accel_set; //!< Flag indicating if accel is set
+
+    /// Flag indicating that every rank holds a contiguous slice of the particles, in rank order
+    bool is_distributed;
+
+    /// Arrays that may have been modified since ParticleData::takeSnapshot() (a Field bitmask)
+    /** Accessing an array from Python marks it, since the numpy array is a writable view of it.
+     */
+    unsigned int modified;
     };
 
 //! Structure to store packed particle data
@@ -668,6 +716,9 @@ class PYBIND11_EXPORT ParticleData
      *          In parallel simulations, the ghost data needs to be initialized as well,
      *          or all ghosts need to be removed and re-initialized before and after reordering.
      *
+     * The stand-by arrays are allocated on the first access, so that simulations that never
+     * use them do not hold twice the per-particle memory.
+     *
      * USAGE EXAMPLE:
      * \code
      * m_comm->migrateParticles(); // migrate particles and remove all ghosts
@@ -683,8 +734,9 @@ class PYBIND11_EXPORT ParticleData
      */
 
     //! Return positions and types (alternate array)
-    const GlobalArray<Scalar4>& getAltPositions() const
+    const GlobalArray<Scalar4>& getAltPositions()
         {
+        maybeAllocateAlternateArrays();
         return m_pos_alt;
         }
 
@@ -695,8 +747,9 @@ class PYBIND11_EXPORT ParticleData
         }
 
     //! Return velocities and masses (alternate array)
-    const GlobalArray<Scalar4>& getAltVelocities() const
+    const GlobalArray<Scalar4>& getAltVelocities()
         {
+        maybeAllocateAlternateArrays();
         return m_vel_alt;
         }
 
@@ -707,8 +760,9 @@ class PYBIND11_EXPORT ParticleData
         }
 
     //! Return accelerations (alternate array)
-    const GlobalArray<Scalar3>& getAltAccelerations() const
+    const GlobalArray<Scalar3>& getAltAccelerations()
         {
+        maybeAllocateAlternateArrays();
         return m_accel_alt;
         }
 
@@ -719,8 +773,9 @@ class PYBIND11_EXPORT ParticleData
         }
 
     //! Return charges (alternate array)
-    const GlobalArray<Scalar>& getAltCharges() const
+    const GlobalArray<Scalar>& getAltCharges()
         {
+        maybeAllocateAlternateArrays();
         return m_charge_alt;
         }
 
@@ -731,8 +786,9 @@ class PYBIND11_EXPORT ParticleData
         }
 
     //! Return diameters (alternate array)
-    const GlobalArray<Scalar>& getAltDiameters() const
+    const GlobalArray<Scalar>& getAltDiameters()
         {
+        maybeAllocateAlternateArrays();
         return m_diameter_alt;
         }
 
@@ -743,8 +799,9 @@ class PYBIND11_EXPORT ParticleData
         }
 
     //! Return images (alternate array)
-    const GlobalArray<int3>& getAltImages() const
+    const GlobalArray<int3>& getAltImages()
         {
+        maybeAllocateAlternateArrays();
         return m_image_alt;
         }
 
@@ -755,8 +812,9 @@ class PYBIND11_EXPORT ParticleData
         }
 
     //! Return tags (alternate array)
-    const GlobalArray<unsigned int>& getAltTags() const
+    const GlobalArray<unsigned int>& getAltTags()
         {
+        maybeAllocateAlternateArrays();
         return m_tag_alt;
         }
 
@@ -767,8 +825,9 @@ class PYBIND11_EXPORT ParticleData
         }
 
     //! Return body ids (alternate array)
-    const GlobalArray<unsigned int>& getAltBodies() const
+    const GlobalArray<unsigned int>& getAltBodies()
         {
+        maybeAllocateAlternateArrays();
         return m_body_alt;
         }
 
@@ -779,8 +838,9 @@ class PYBIND11_EXPORT ParticleData
         }
 
     //! Get the net force array (alternate array)
-    const GlobalArray<Scalar4>& getAltNetForce() const
+    const GlobalArray<Scalar4>& getAltNetForce()
         {
+        maybeAllocateAlternateArrays();
         return m_net_force_alt;
         }
 
@@ -791,8 +851,9 @@ class PYBIND11_EXPORT ParticleData
         }
 
     //! Get the net virial array (alternate array)
-    const GlobalArray<Scalar>& getAltNetVirial() const
+    const GlobalArray<Scalar>& getAltNetVirial()
         {
+        maybeAllocateAlternateArrays();
         return m_net_virial_alt;
         }
 
@@ -803,8 +864,9 @@ class PYBIND11_EXPORT ParticleData
         }
 
     //! Get the net torque array (alternate array)
-    const GlobalArray<Scalar4>& getAltNetTorqueArray() const
+    const GlobalArray<Scalar4>& getAltNetTorqueArray()
         {
+        maybeAllocateAlternateArrays();
         return m_net_torque_alt;
         }
 
@@ -815,8 +877,9 @@ class PYBIND11_EXPORT ParticleData
         }
 
     //! Get the orientations (alternate array)
-    const GlobalArray<Scalar4>& getAltOrientationArray() const
+    const GlobalArray<Scalar4>& getAltOrientationArray()
         {
+        maybeAllocateAlternateArrays();
         return m_orientation_alt;
         }
 
@@ -827,14 +890,16 @@ class PYBIND11_EXPORT ParticleData
         }
 
     //! Get the angular momenta (alternate array)
-    const GlobalArray<Scalar4>& getAltAngularMomentumArray() const
+    const GlobalArray<Scalar4>& getAltAngularMomentumArray()
         {
+        maybeAllocateAlternateArrays();
         return m_angmom_alt;
         }
 
     //! Get the moments of inertia array (alternate array)
-    const GlobalArray<Scalar3>& getAltMomentsOfInertiaArray() const
+    const GlobalArray<Scalar3>& getAltMomentsOfInertiaArray()
         {
+        maybeAllocateAlternateArrays();
         return m_inertia_alt;
         }
 
@@ -867,6 +932,21 @@ class PYBIND11_EXPORT ParticleData
     //! Notify listeners that the particles have been rearranged in memory
     void notifyParticleSort();
 
+    //! Connects a function to be called every time particle properties are modified in place
+    Nano::Signal<void()>& getParticlesModifiedSignal()
+        {
+        return m_particles_modified_signal;
+        }
+
+    //! Connects a function to be called every time particles are moved or rotated in place
+    Nano::Signal<void()>& getParticlesMovedSignal()
+        {
+        return m_particles_moved_signal;
+        }
+
+    //! Notify listeners that particle properties have been modified in place
+    void notifyParticlesModified(bool moved);
+
     //! Connects a function to be called every time the box size is changed
     Nano::Signal<void()>& getBoxChangeSignal()
         {
@@ -1157,6 +1237,9 @@ class PYBIND11_EXPORT ParticleData
     void initializeFromSnapshot(const SnapshotParticleData<Real>& snapshot,
                                 bool ignore_bodies = false);
 
+    //! Update the particles in place from the modified arrays of a snapshot
+    template<class Real> bool updateFromSnapshot(const SnapshotParticleData<Real>& snapshot);
+
     //! Take a snapshot
     template<class Real>
     std::map<unsigned int, unsigned int> takeSnapshot(SnapshotParticleData<Real>& snapshot);
@@ -1237,9 +1320,15 @@ class PYBIND11_EXPORT ParticleData
     //! Add a single particle to the simulation
     unsigned int addParticle(unsigned int type);
 
+    //! Add a batch of particles to the simulation
+    std::vector<unsigned int> addParticleBatch(const std::vector<unsigned int>& types);
+
     //! Remove a particle from the simulation
     void removeParticle(unsigned int tag);
 
+    //! Remove a batch of particles from the simulation
+    void removeParticleBatch(const std::vector<unsigned int>& tags);
+
     //! Return the nth active global tag
     unsigned int getNthTag(unsigned int n);
 
@@ -1290,6 +1379,10 @@ class PYBIND11_EXPORT ParticleData
     Nano::Signal<void()>
         m_sort_signal; //!< Signal that is triggered when particles are sorted in memory
     Nano::Signal<void()> m_boxchange_signal; //!< Signal that is triggered when the box size changes
+    Nano::Signal<void()> m_particles_modified_signal; //!< Signal that is triggered when particle
+                                                      //!< properties are modified in place
+    Nano::Signal<void()> m_particles_moved_signal; //!< Signal that is triggered when particles are
+                                                   //!< moved or rotated in place
     Nano::Signal<void()> m_max_particle_num_signal; //!< Signal that is triggered when the maximum
                                                     //!< particle number changes
     Nano::Signal<void()> m_ghost_particles_removed_signal; //!< Signal that is triggered when ghost
@@ -1327,6 +1420,9 @@ class PYBIND11_EXPORT ParticleData
     GlobalArray<Scalar3> m_inertia;         //!< Principal moments of inertia for each particle
     GlobalArray<unsigned int> m_comm_flags; //!< Array of communication flags
 
+    GlobalVector<unsigned int> m_batch_tags;  //!< Staged tags of a particle batch
+    GlobalVector<unsigned int> m_batch_types; //!< Staged types of a particle batch
+
     std::stack<unsigned int> m_recycled_tags; //!< Global tags of removed particles
     std::set<unsigned int> m_tag_set;         //!< Lookup table for tags by active index
     std::vector<unsigned int>
@@ -1379,6 +1475,7 @@ class PYBIND11_EXPORT ParticleData
 #ifdef ENABLE_HIP
     GPUPartition m_gpu_partition; //!< The partition of the local number of particles across GPUs
     unsigned int m_memory_advice_last_Nmax; //!< Nmax at which memory hints were last set
+    unsigned int m_memory_advice_last_N;    //!< N at which memory hints were last set
 #endif
 
     //! Helper function to allocate particle data
@@ -1387,6 +1484,13 @@ class PYBIND11_EXPORT ParticleData
     //! Helper function to allocate alternate particle data
     void allocateAlternateArrays(unsigned int N);
 
+    //! Allocate the alternate particle data on first use
+    void maybeAllocateAlternateArrays()
+        {
+        if (m_pos_alt.isNull())
+            allocateAlternateArrays(m_max_nparticles);
+        }
+
     //! Helper function for amortized array resizing
     void resize(unsigned int new_nparticles);
 
@@ -1402,6 +1506,20 @@ class PYBIND11_EXPORT ParticleData
      */
     template<class Real> bool inBox(const SnapshotParticleData<Real>& snap);
 
+#ifdef ENABLE_MPI
+    //! Helper function to find the domain a snapshot particle is placed into
+    /*! \param pos Position of the particle, wrapped when it is exactly on a boundary
+        \param img Image of the particle, updated when the position is wrapped
+        \param snap_idx Index of the particle in the snapshot (for error messages)
+        \param cart_ranks Ranks of the domains, indexed by domain
+        \returns The rank the particle is placed on
+    */
+    unsigned int placeSnapshotParticle(Scalar3& pos,
+                                       int3& img,
+                                       unsigned int snap_idx,
+                                       const unsigned int* cart_ranks);
+#endif
+
     //! Update the CUDA memory hints
     void setGPUAdvice();
     };
@@ -17,6 +17,9 @@
 #include <algorithm>
 #include <iostream>
 using namespace std;
+
+//! Last value assigned to a ParticleGroup member tags revision, shared by all groups
+static unsigned int s_member_tags_revision = 0;
 namespace py = pybind11;
 
 /*! \param sysdef System the particles are to be selected from
@@ -248,6 +251,7 @@ ParticleGroup::ParticleGroup(std::shared_ptr<SystemDefinition> sysdef,
     GlobalArray<unsigned int> member_tags_array(member_tags.size(), m_exec_conf);
     m_member_tags.swap(member_tags_array);
     TAG_ALLOCATION(m_member_tags);
+    m_member_tags_revision = ++s_member_tags_revision;
 
         {
         ArrayHandle<unsigned int> h_member_tags(m_member_tags,
@@ -326,6 +330,23 @@ void ParticleGroup::updateMemberTags(bool force_update) const
         m_warning_printed = true;
         }
 
+#ifdef ENABLE_HIP
+    if (m_selector && (m_update_tags || force_update) && m_exec_conf->isCUDAEnabled()
+        && m_selector->hasGPUFlags())
+        {
+        bool domain_decomposition = false;
+#ifdef ENABLE_MPI
+        domain_decomposition = bool(m_pdata->getDomainDecomposition());
+#endif
+        // the member tags of a domain decomposed system are gathered on the host below
+        if (!domain_decomposition)
+            {
+            updateMemberTagsGPU();
+            return;
+            }
+        }
+#endif
+
     if (m_selector && (m_update_tags || force_update))
         {
         // notice message
@@ -362,6 +383,7 @@ void ParticleGroup::updateMemberTags(bool force_update) const
         GlobalArray<unsigned int> member_tags_array(member_tags.size(), m_pdata->getExecConf());
         m_member_tags.swap(member_tags_array);
         TAG_ALLOCATION(m_member_tags);
+        m_member_tags_revision = ++s_member_tags_revision;
 
         // sort member tags
         std::sort(member_tags.begin(), member_tags.end());
@@ -376,6 +398,14 @@ void ParticleGroup::updateMemberTags(bool force_update) const
         GlobalArray<unsigned int> member_idx(member_tags.size(), m_pdata->getExecConf());
         m_member_idx.swap(member_idx);
         TAG_ALLOCATION(m_member_idx);
+
+        // member tags are unique, so the group contains all particles when the counts agree
+        m_all_members = (member_tags.size() == m_pdata->getNGlobal());
+        }
+    else
+        {
+        // the tags of a static group no longer match the particles in the system
+        m_all_members = false;
         }
 
     // one byte per particle to indicate membership in the group, initialize with current number of
@@ -387,6 +417,7 @@ void ParticleGroup::updateMemberTags(bool force_update) const
     GlobalArray<unsigned int> is_member_tag(m_pdata->getRTags().size(), m_pdata->getExecConf());
     m_is_member_tag.swap(is_member_tag);
     TAG_ALLOCATION(m_is_member_tag);
+    m_num_identity = 0;
 
     // build the reverse lookup table for tags
     buildTagHash();
@@ -396,9 +427,104 @@ void ParticleGroup::updateMemberTags(bool force_update) const
     rebuildIndexList();
     }
 
+#ifdef ENABLE_HIP
+/*! Evaluates the filter on the GPU and builds the member tags, the tag lookup table, and the index
+    list on the device. Only the number of members is copied to the host.
+*/
+void ParticleGroup::updateMemberTagsGPU() const
+    {
+    m_pdata->getExecConf()->msg->notice(7)
+        << "ParticleGroup: rebuilding tags on the GPU" << std::endl;
+
+    const unsigned int nparticles = m_pdata->getN();
+    CachedAllocator& alloc = m_exec_conf->getCachedAllocator();
+
+    GlobalArray<unsigned int> is_member(m_pdata->getMaxN(), m_exec_conf);
+    m_is_member.swap(is_member);
+    TAG_ALLOCATION(m_is_member);
+
+    GlobalArray<unsigned int> is_member_tag(m_pdata->getRTags().size(), m_exec_conf);
+    m_is_member_tag.swap(is_member_tag);
+    TAG_ALLOCATION(m_is_member_tag);
+    m_num_identity = 0;
+
+    ScopedAllocation<unsigned int> d_scan(alloc, nparticles);
+    ScopedAllocation<unsigned int> d_idx(alloc, nparticles);
+    unsigned int num_members = 0;
+
+        {
+        ArrayHandle<unsigned int> d_is_member(m_is_member,
+                                              access_location::device,
+                                              access_mode::overwrite);
+        m_selector->computeGPUFlags(m_sysdef, d_is_member.data);
+        if (m_exec_conf->isCUDAErrorCheckingEnabled())
+            CHECK_CUDA_ERROR();
+
+        gpu_compact_index_list(nparticles,
+                               d_is_member.data,
+                               d_idx.data,
+                               num_members,
+                               d_scan.data,
+                               alloc);
+        if (m_exec_conf->isCUDAErrorCheckingEnabled())
+            CHECK_CUDA_ERROR();
+        }
+
+    GlobalArray<unsigned int> member_tags(num_members, m_exec_conf);
+    m_member_tags.swap(member_tags);
+    TAG_ALLOCATION(m_member_tags);
+    m_member_tags_revision = ++s_member_tags_revision;
+
+    GlobalArray<unsigned int> member_idx(num_members, m_exec_conf);
+    m_member_idx.swap(member_idx);
+    TAG_ALLOCATION(m_member_idx);
+
+    if (num_members > 0)
+        {
+        ArrayHandle<unsigned int> d_member_idx(m_member_idx,
+                                               access_location::device,
+                                               access_mode::overwrite);
+        hipMemcpy(d_member_idx.data,
+                  d_idx.data,
+                  sizeof(unsigned int) * num_members,
+                  hipMemcpyDeviceToDevice);
+        }
+
+        {
+        ArrayHandle<unsigned int> d_member_tags(m_member_tags,
+                                                access_location::device,
+                                                access_mode::overwrite);
+        ArrayHandle<unsigned int> d_is_member_tag(m_is_member_tag,
+                                                  access_location::device,
+                                                  access_mode::overwrite);
+        ArrayHandle<unsigned int> d_tag(m_pdata->getTags(),
+                                        access_location::device,
+                                        access_mode::read);
+
+        // d_scan is no longer needed and holds the unsorted tags
+        gpu_build_member_tags(num_members,
+                              d_idx.data,
+                              d_tag.data,
+                              d_member_tags.data,
+                              d_is_member_tag.data,
+                              (unsigned int)m_pdata->getRTags().size(),
+                              d_scan.data,
+                              alloc);
+        if (m_exec_conf->isCUDAErrorCheckingEnabled())
+            CHECK_CUDA_ERROR();
+        }
+
+    m_num_local_members = num_members;
+    m_all_members = (num_members == m_pdata->getNGlobal());
+    m_particles_sorted = false;
+    m_gpu_partition.setN(m_num_local_members);
+    }
+#endif
+
 void ParticleGroup::reallocate() const
     {
     m_is_member.resize(m_pdata->getMaxN());
+    m_num_identity = 0;
 
     if (m_is_member_tag.getNumElements() != m_pdata->getRTags().size())
         {
@@ -644,13 +770,17 @@ void ParticleGroup::rebuildIndexList() const
     // notice message
     m_pdata->getExecConf()->msg->notice(10) << "ParticleGroup: rebuilding index" << std::endl;
 
+    if (m_all_members)
+        {
+        fillIdentityIndexList();
+        }
 #ifdef ENABLE_HIP
-    if (m_pdata->getExecConf()->isCUDAEnabled())
+    else if (m_pdata->getExecConf()->isCUDAEnabled())
         {
         rebuildIndexListGPU();
         }
-    else
 #endif
+    else
         {
         // rebuild the membership flags for the  indices in the group and construct member list
         ArrayHandle<unsigned int> h_is_member(m_is_member,
@@ -695,6 +825,54 @@ void ParticleGroup::rebuildIndexList() const
 #endif
     }
 
+/*! Every local particle is a member of the group, so entry i of the index list is i regardless of
+    the particle order. Entries filled by an earlier call remain valid, only those past them are
+    written.
+*/
+void ParticleGroup::fillIdentityIndexList() const
+    {
+    const unsigned int nparticles = m_pdata->getN();
+    assert(nparticles <= m_member_idx.getNumElements());
+
+    if (m_num_identity < nparticles)
+        {
+#ifdef ENABLE_HIP
+        if (m_pdata->getExecConf()->isCUDAEnabled())
+            {
+            ArrayHandle<unsigned int> d_is_member(m_is_member,
+                                                  access_location::device,
+                                                  access_mode::readwrite);
+            ArrayHandle<unsigned int> d_member_idx(m_member_idx,
+                                                   access_location::device,
+                                                   access_mode::readwrite);
+            gpu_fill_identity_index_list(m_num_identity,
+                                         nparticles,
+                                         d_is_member.data,
+                                         d_member_idx.data);
+            if (m_exec_conf->isCUDAErrorCheckingEnabled())
+                CHECK_CUDA_ERROR();
+            }
+        else
+#endif
+            {
+            ArrayHandle<unsigned int> h_is_member(m_is_member,
+                                                  access_location::host,
+                                                  access_mode::readwrite);
+            ArrayHandle<unsigned int> h_member_idx(m_member_idx,
+                                                   access_location::host,
+                                                   access_mode::readwrite);
+            for (unsigned int idx = m_num_identity; idx < nparticles; idx++)
+                {
+                h_is_member.data[idx] = 1;
+                h_member_idx.data[idx] = idx;
+                }
+            }
+        m_num_identity = nparticles;
+        }
+
+    m_num_local_members = nparticles;
+    }
+
 void ParticleGroup::updateGPUAdvice() const
     {
 #if defined(ENABLE_HIP) && defined(__HIP_PLATFORM_NVCC__)
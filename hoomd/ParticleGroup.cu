@@ -9,9 +9,6 @@
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wconversion"
 #include <hipcub/hipcub.hpp>
-#include <thrust/device_ptr.h>
-#include <thrust/execution_policy.h>
-#include <thrust/reduce.h>
 #pragma GCC diagnostic pop
 
 /*! \file ParticleGroup.cu
@@ -48,6 +45,53 @@ __global__ void gpu_scatter_member_indices(unsigned int N,
         d_member_idx[d_scan[idx]] = idx;
     }
 
+//! GPU kernel to gather the tags of the members and flag them in the tag lookup table
+__global__ void gpu_gather_member_tags(unsigned int num_members,
+                                       const unsigned int* d_member_idx,
+                                       const unsigned int* d_tag,
+                                       unsigned int* d_member_tags,
+                                       unsigned int* d_is_member_tag)
+    {
+    unsigned int member = blockIdx.x * blockDim.x + threadIdx.x;
+
+    if (member >= num_members)
+        return;
+
+    unsigned int tag = d_tag[d_member_idx[member]];
+    d_member_tags[member] = tag;
+    d_is_member_tag[tag] = 1;
+    }
+
+//! GPU kernel to mark particles first to N-1 as members at their own index
+__global__ void gpu_fill_identity_index_list_kernel(unsigned int first,
+                                                    unsigned int N,
+                                                    unsigned int* d_is_member,
+                                                    unsigned int* d_member_idx)
+    {
+    unsigned int idx = first + blockIdx.x * blockDim.x + threadIdx.x;
+
+    if (idx >= N)
+        return;
+
+    d_is_member[idx] = 1;
+    d_member_idx[idx] = idx;
+    }
+
+//! GPU kernel to gather the values of the group members from a per-particle array
+template<class T>
+__global__ void gpu_gather_members_kernel(unsigned int num_members,
+                                          const unsigned int* d_member_idx,
+                                          const T* d_in,
+                                          T* d_out)
+    {
+    unsigned int member = blockIdx.x * blockDim.x + threadIdx.x;
+
+    if (member >= num_members)
+        return;
+
+    d_out[member] = d_in[d_member_idx[member]];
+    }
+
 //! GPU method for rebuilding the index list of a ParticleGroup
 /*! \param N number of local particles
     \param d_is_member_tag Global lookup table for tag -> group membership
@@ -109,14 +153,19 @@ hipError_t gpu_compact_index_list(unsigned int N,
     hipcub::DeviceScan::ExclusiveSum(d_temp_storage, temp_storage_bytes, d_is_member, d_tmp, N);
     alloc.deallocate((char*)d_temp_storage);
 
-    thrust::device_ptr<unsigned int> is_member(d_is_member);
-#ifdef __HIP_PLATFORM_HCC__
-    num_local_members = thrust::reduce(thrust::hip::par(alloc),
-#else
-    num_local_members = thrust::reduce(thrust::cuda::par(alloc),
-#endif
-                                       is_member,
-                                       is_member + N);
+    // the number of members is the exclusive sum at the last particle plus its own flag, which
+    // saves a separate reduction over all particles
+    num_local_members = 0;
+    if (N > 0)
+        {
+        unsigned int last_scan, last_is_member;
+        hipMemcpy(&last_scan, d_tmp + N - 1, sizeof(unsigned int), hipMemcpyDeviceToHost);
+        hipMemcpy(&last_is_member,
+                  d_is_member + N - 1,
+                  sizeof(unsigned int),
+                  hipMemcpyDeviceToHost);
+        num_local_members = last_scan + last_is_member;
+        }
 
     // fill member_idx array
     unsigned int block_size = 256;
@@ -134,3 +183,139 @@ hipError_t gpu_compact_index_list(unsigned int N,
 
     return hipSuccess;
     }
+
+/*! \param first First particle index that is not yet filled
+    \param N number of local particles
+    \param d_is_member Array of membership flags
+    \param d_member_idx Array of member indices
+*/
+hipError_t gpu_fill_identity_index_list(unsigned int first,
+                                        unsigned int N,
+                                        unsigned int* d_is_member,
+                                        unsigned int* d_member_idx)
+    {
+    assert(d_is_member);
+    assert(d_member_idx);
+
+    if (N <= first)
+        return hipSuccess;
+
+    unsigned int block_size = 256;
+    unsigned int n_blocks = (N - first) / block_size + 1;
+
+    hipLaunchKernelGGL(gpu_fill_identity_index_list_kernel,
+                       dim3(n_blocks),
+                       dim3(block_size),
+                       0,
+                       0,
+                       first,
+                       N,
+                       d_is_member,
+                       d_member_idx);
+    return hipSuccess;
+    }
+
+/*! \param num_members Number of members
+    \param d_member_idx Indices of the members
+    \param d_tag Particle tags
+    \param d_member_tags Member tags in ascending order (output)
+    \param d_is_member_tag Tag lookup table for group membership (output)
+    \param num_tags Number of elements in the tag lookup table
+    \param d_tmp Temporary array with num_members elements
+    \param alloc Allocator for temporary storage
+*/
+hipError_t gpu_build_member_tags(unsigned int num_members,
+                                 const unsigned int* d_member_idx,
+                                 const unsigned int* d_tag,
+                                 unsigned int* d_member_tags,
+                                 unsigned int* d_is_member_tag,
+                                 unsigned int num_tags,
+                                 unsigned int* d_tmp,
+                                 CachedAllocator& alloc)
+    {
+    hipMemset(d_is_member_tag, 0, sizeof(unsigned int) * num_tags);
+    if (num_members == 0)
+        return hipSuccess;
+
+    unsigned int block_size = 256;
+    unsigned int n_blocks = num_members / block_size + 1;
+
+    hipLaunchKernelGGL(gpu_gather_member_tags,
+                       dim3(n_blocks),
+                       dim3(block_size),
+                       0,
+                       0,
+                       num_members,
+                       d_member_idx,
+                       d_tag,
+                       d_tmp,
+                       d_is_member_tag);
+
+    // sort the tags
+    void* d_temp_storage = NULL;
+    size_t temp_storage_bytes = 0;
+    hipcub::DeviceRadixSort::SortKeys(d_temp_storage,
+                                      temp_storage_bytes,
+                                      d_tmp,
+                                      d_member_tags,
+                                      num_members);
+    d_temp_storage = alloc.getTemporaryBuffer<char>(temp_storage_bytes);
+    hipcub::DeviceRadixSort::SortKeys(d_temp_storage,
+                                      temp_storage_bytes,
+                                      d_tmp,
+                                      d_member_tags,
+                                      num_members);
+    alloc.deallocate((char*)d_temp_storage);
+
+    return hipSuccess;
+    }
+
+/*! \param num_members Number of members
+    \param d_member_idx Indices of the members
+    \param d_in Per-particle array
+    \param d_out Values of the members, in member order (output)
+*/
+template<class T>
+hipError_t gpu_gather_members(unsigned int num_members,
+                              const unsigned int* d_member_idx,
+                              const T* d_in,
+                              T* d_out)
+    {
+    if (num_members == 0)
+        return hipSuccess;
+
+    unsigned int block_size = 256;
+    unsigned int n_blocks = num_members / block_size + 1;
+
+    hipLaunchKernelGGL(HIP_KERNEL_NAME(gpu_gather_members_kernel<T>),
+                       dim3(n_blocks),
+                       dim3(block_size),
+                       0,
+                       0,
+                       num_members,
+                       d_member_idx,
+                       d_in,
+                       d_out);
+    return hipSuccess;
+    }
+
+template hipError_t gpu_gather_members<Scalar4>(unsigned int num_members,
+                                                const unsigned int* d_member_idx,
+                                                const Scalar4* d_in,
+                                                Scalar4* d_out);
+template hipError_t gpu_gather_members<Scalar3>(unsigned int num_members,
+                                                const unsigned int* d_member_idx,
+                                                const Scalar3* d_in,
+                                                Scalar3* d_out);
+template hipError_t gpu_gather_members<Scalar>(unsigned int num_members,
+                                               const unsigned int* d_member_idx,
+                                               const Scalar* d_in,
+                                               Scalar* d_out);
+template hipError_t gpu_gather_members<int3>(unsigned int num_members,
+                                             const unsigned int* d_member_idx,
+                                             const int3* d_in,
+                                             int3* d_out);
+template hipError_t gpu_gather_members<unsigned int>(unsigned int num_members,
+                                                     const unsigned int* d_member_idx,
+                                                     const unsigned int* d_in,
+                                                     unsigned int* d_out);
@@ -30,4 +30,27 @@ hipError_t gpu_compact_index_list(unsigned int N,
                                   unsigned int& num_local_members,
                                   unsigned int* d_tmp,
                                   CachedAllocator& alloc);
+
+//! GPU method for building the sorted member tags and tag lookup table from member indices
+hipError_t gpu_build_member_tags(unsigned int num_members,
+                                 const unsigned int* d_member_idx,
+                                 const unsigned int* d_tag,
+                                 unsigned int* d_member_tags,
+                                 unsigned int* d_is_member_tag,
+                                 unsigned int num_tags,
+                                 unsigned int* d_tmp,
+                                 CachedAllocator& alloc);
+
+//! GPU method for extending the identity index list of a group that contains all particles
+hipError_t gpu_fill_identity_index_list(unsigned int first,
+                                        unsigned int N,
+                                        unsigned int* d_is_member,
+                                        unsigned int* d_member_idx);
+
+//! GPU method for gathering the values of the group members from a per-particle array
+template<class T>
+hipError_t gpu_gather_members(unsigned int num_members,
+                              const unsigned int* d_member_idx,
+                              const T* d_in,
+                              T* d_out);
 #endif
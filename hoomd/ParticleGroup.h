@@ -132,6 +132,10 @@ class PYBIND11_EXPORT ParticleFilterRigidCenter : public ParticleFilter
    is used to store one bit per particle for efficient O(1) tests if a given particle is in the
    group.
 
+    Groups that contain every particle in the system (e.g. ParticleFilterAll) are common. Their
+   index list is the identity, independent of the particle order, so sorts leave it unchanged and a
+   change in the local particle number (e.g. after a migration) only fills in the new entries.
+
     Finally, the common use case on the GPU using groups will include running one thread per
    particle in the group. For that it needs a list of indices of all the particles in the group. To
    facilitates this, the list of indices in the group will be stored in a GPUArray.
@@ -255,6 +259,28 @@ class PYBIND11_EXPORT ParticleGroup
         return m_member_idx;
         }
 
+    //! Get a counter that changes whenever the member tags change
+    /*! Revisions are unique among all groups. Callers that cache data derived from the member tags
+        compare the revision to the value at the time they built the cache.
+    */
+    unsigned int getMemberTagsRevision() const
+        {
+        checkRebuild();
+
+        return m_member_tags_revision;
+        }
+
+    //! Direct access to the sorted list of member tags
+    /*! \returns The tags of all members of the group, in ascending order. The caller \b must \b not
+       write to or change the array.
+    */
+    const GlobalArray<unsigned int>& getMemberTagArray() const
+        {
+        checkRebuild();
+
+        return m_member_tags;
+        }
+
 #ifdef ENABLE_HIP
     //! Return the load balancing GPU partition
     const GPUPartition& getGPUPartition() const
@@ -355,6 +381,7 @@ class PYBIND11_EXPORT ParticleGroup
     mutable GlobalArray<unsigned int> m_member_idx;  //!< List of all particle indices in the group
     mutable GlobalArray<unsigned int> m_member_tags; //!< Lists the tags of the particle members
     mutable unsigned int m_num_local_members;        //!< Number of members on the local processor
+    mutable unsigned int m_member_tags_revision = 0; //!< Incremented when m_member_tags changes
     mutable bool m_particles_sorted;      //!< True if particle have been sorted since last rebuild
     mutable bool m_reallocated;           //!< True if particle data arrays have been reallocated
     mutable bool m_global_ptl_num_change; //!< True if the global particle number changed
@@ -377,12 +404,21 @@ class PYBIND11_EXPORT ParticleGroup
     /// Number of rotational degrees of freedom in the group
     Scalar m_rotational_dof = 0;
 
+    /// True when the selected member tags include every particle in the system
+    mutable bool m_all_members = false;
+
+    /// Number of leading entries in m_member_idx and m_is_member that hold the identity map
+    mutable unsigned int m_num_identity = 0;
+
     //! Helper function to resize array of member tags
     void reallocate() const;
 
     //! Helper function to rebuild the index lists after the particles have been sorted
     void rebuildIndexList() const;
 
+    //! Helper function to extend the identity index list of a group containing all particles
+    void fillIdentityIndexList() const;
+
     //! Helper function to rebuild internal arrays
     void checkRebuild() const
         {
@@ -437,6 +473,9 @@ class PYBIND11_EXPORT ParticleGroup
 #ifdef ENABLE_HIP
     //! Helper function to rebuild the index lists after the particles have been sorted
     void rebuildIndexListGPU() const;
+
+    //! Helper function to select the member tags with a filter evaluated on the GPU
+    void updateMemberTagsGPU() const;
 #endif
     };
 
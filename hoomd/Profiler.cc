@@ -9,8 +9,10 @@
 
 #include "Profiler.h"
 
+#include <fstream>
 #include <iomanip>
 #include <sstream>
+#include <stdexcept>
 
 using namespace std;
 namespace py = pybind11;
@@ -66,6 +68,26 @@ int64_t ProfileDataElem::getTotalMemByteCount() const
     return total;
     }
 
+/*! \param stats Dictionary to add the statistics to
+    \param path Path of this node in the tree
+
+    Adds one entry per descendant of this node, keyed by the '/' separated path from the root.
+*/
+void ProfileDataElem::collectStats(py::dict& stats, const std::string& path) const
+    {
+    for (auto i = m_children.begin(); i != m_children.end(); ++i)
+        {
+        std::string child_path = path.empty() ? i->first : path + "/" + i->first;
+        py::dict entry;
+        entry["time"] = double(i->second.m_elapsed_time) / 1e9;
+        entry["self_time"]
+            = double(i->second.m_elapsed_time - i->second.getChildElapsedTime()) / 1e9;
+        entry["calls"] = i->second.m_call_count;
+        stats[child_path.c_str()] = entry;
+        i->second.collectStats(stats, child_path);
+        }
+    }
+
 /*! Recursive output routine to write results from this profile node and all sub nodes printed in
     a tree.
     \param o stream to write output to
@@ -214,15 +236,89 @@ void Profiler::output(std::ostream& o)
         o << "***Warning! Outputting a profile with incomplete samples" << endl;
         }
 
+    // outputting a profile implicitly calls for a time sample
+    stop();
+
+    // startup the recursive output process
+    m_root.output(o, m_name, 0, m_root.m_elapsed_time, (int)m_name.size());
+    }
+
+/*! Sample the elapsed time of the root profile. Later calls update the elapsed time.
+ */
+void Profiler::stop()
+    {
 #ifdef SCOREP_USER_ENABLE
-    SCOREP_USER_REGION_END(m_root.m_scorep_region)
+    if (!m_stopped)
+        {
+        SCOREP_USER_REGION_END(m_root.m_scorep_region)
+        }
 #endif
 
-    // outputting a profile implicitly calls for a time sample
+    m_stopped = true;
     m_root.m_elapsed_time = m_clk.getTime() - m_root.m_start_time;
+    }
 
-    // startup the recursive output process
-    m_root.output(o, m_name, 0, m_root.m_elapsed_time, (int)m_name.size());
+/*! \returns A dictionary that maps the '/' separated path of each category to a dictionary with
+    the total time in seconds (``time``), the time not spent in sub-categories (``self_time``), and
+    the number of calls (``calls``). The key ``total`` holds the elapsed time of the whole profile.
+*/
+py::dict Profiler::getStatsPy()
+    {
+    py::dict stats;
+    m_root.collectStats(stats, "");
+    stats["total"] = double(m_root.m_elapsed_time) / 1e9;
+    return stats;
+    }
+
+//! Write a string to a JSON document with the necessary escape sequences
+static void writeJSONString(std::ostream& o, const std::string& str)
+    {
+    o << '"';
+    for (char c : str)
+        {
+        if (c == '"' || c == '\\')
+            {
+            o << '\\' << c;
+            }
+        else if ((unsigned char)c < 0x20)
+            {
+            o << "\\u" << std::hex << std::setw(4) << std::setfill('0') << int(c) << std::dec
+              << std::setfill(' ');
+            }
+        else
+            {
+            o << c;
+            }
+        }
+    o << '"';
+    }
+
+/*! \param o Stream to write to
+    \param pid Process id to record in the events (the MPI rank)
+
+    Writes a JSON document with one complete ("X") event per recorded push/pop pair. Times are in
+    microseconds relative to the start of the profile.
+*/
+void Profiler::writeChromeTrace(std::ostream& o, unsigned int pid)
+    {
+    o << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    o << setiosflags(ios::fixed) << setprecision(3);
+    bool first = true;
+    for (const auto& event : m_trace)
+        {
+        if (!first)
+            o << ",";
+        first = false;
+
+        o << "\n{\"name\":";
+        writeJSONString(o, *event.name);
+        o << ",\"ph\":\"X\",\"ts\":" << double(event.start - m_root.m_start_time) / 1e3
+          << ",\"dur\":" << double(event.duration) / 1e3 << ",\"pid\":" << pid
+          << ",\"tid\":0,\"args\":{\"depth\":" << event.depth << "}}";
+        }
+    o << "\n],\"otherData\":{\"name\":";
+    writeJSONString(o, m_name);
+    o << ",\"dropped_events\":" << m_dropped_trace_events << "}}\n";
     }
 
 /*! \param o Stream to output to
@@ -247,9 +343,24 @@ string print_profiler(Profiler* prof)
     return s.str();
     }
 
+//! Helper function to write the Chrome trace of a Profiler to a file
+void write_profiler_trace(Profiler* prof, const std::string& filename, unsigned int pid)
+    {
+    assert(prof);
+    ofstream f(filename.c_str());
+    if (!f.good())
+        throw runtime_error("Error opening profile trace file " + filename);
+    prof->writeChromeTrace(f, pid);
+    if (!f.good())
+        throw runtime_error("Error writing profile trace file " + filename);
+    }
+
 void export_Profiler(py::module& m)
     {
-    py::class_<Profiler>(m, "Profiler")
+    py::class_<Profiler, std::shared_ptr<Profiler>>(m, "Profiler")
         .def(py::init<const std::string&>())
-        .def("__str__", &print_profiler);
+        .def("__str__", &print_profiler)
+        .def("getStats", &Profiler::getStatsPy)
+        .def("setMaxTraceEvents", &Profiler::setMaxTraceEvents)
+        .def("writeChromeTrace", &write_profiler_trace);
     }
@@ -22,11 +22,17 @@
 #include <nvToolsExt.h>
 #endif
 
+#if defined(ENABLE_ROCTRACER) && defined(__HIP_PLATFORM_HCC__)
+#define HOOMD_ROCTX
+#include <roctracer/roctx.h>
+#endif
+
 #include <cassert>
 #include <iostream>
 #include <map>
 #include <stack>
 #include <string>
+#include <vector>
 
 #include <pybind11/pybind11.h>
 
@@ -63,7 +69,7 @@ class PYBIND11_EXPORT ProfileDataElem
     public:
     //! Constructs an element with zeroed counters
     ProfileDataElem()
-        : m_start_time(0), m_elapsed_time(0), m_flop_count(0), m_mem_byte_count(0)
+        : m_start_time(0), m_elapsed_time(0), m_flop_count(0), m_mem_byte_count(0), m_call_count(0)
 #ifdef SCOREP_USER_ENABLE
           ,
           m_scorep_region(SCOREP_USER_INVALID_REGION)
@@ -84,6 +90,8 @@ class PYBIND11_EXPORT ProfileDataElem
                 int tab_level,
                 int64_t total_time,
                 int name_width) const;
+    //! Collect the statistics of the children of this node
+    void collectStats(pybind11::dict& stats, const std::string& path) const;
     //! Another output helper function
     void output_line(std::ostream& o,
                      const std::string& name,
@@ -99,6 +107,7 @@ class PYBIND11_EXPORT ProfileDataElem
     int64_t m_elapsed_time;   //!< A running total of elapsed running time
     int64_t m_flop_count;     //!< A running total of floating point operations
     int64_t m_mem_byte_count; //!< A running total of memory bytes transferred
+    int64_t m_call_count;     //!< Number of completed timed events
 
 #ifdef SCOREP_USER_ENABLE
     SCOREP_User_RegionHandle m_scorep_region; //!< ScoreP region identifier
@@ -121,7 +130,10 @@ class PYBIND11_EXPORT ProfileDataElem
     These methods automatically synchronize with the asynchronous GPU execution stream in order
     to provide accurate timing information.
 
-    These profiles can of course be output via normal ostream operators.
+    These profiles can of course be output via normal ostream operators. getStatsPy() returns the
+    accumulated times as a Python dictionary, and writeChromeTrace() writes the recorded events in
+    the Chrome trace event format, which chrome://tracing and Perfetto load. At most
+    setMaxTraceEvents() events are recorded, later events are only accumulated in the tree.
     \ingroup utils
     */
 class PYBIND11_EXPORT Profiler
@@ -141,11 +153,40 @@ class PYBIND11_EXPORT Profiler
              uint64_t flop_count = 0,
              uint64_t byte_count = 0);
 
+    //! Stop the timer of the root profile
+    void stop();
+
+    //! Set the maximum number of recorded trace events
+    void setMaxTraceEvents(size_t max_trace_events)
+        {
+        m_max_trace_events = max_trace_events;
+        }
+
+    //! Get the accumulated statistics of all sub-categories
+    pybind11::dict getStatsPy();
+
+    //! Write the recorded events in the Chrome trace event format
+    void writeChromeTrace(std::ostream& o, unsigned int pid);
+
     private:
+    /// A completed timed event
+    struct TraceEvent
+        {
+        const std::string* name; //!< Name of the category (points to a key in the tree)
+        int64_t start;           //!< Start time
+        int64_t duration;        //!< Elapsed time
+        unsigned int depth;      //!< Depth in the tree
+        };
+
     ClockSource m_clk;                    //!< Clock to provide timing information
     std::string m_name;                   //!< The name of this profile
     ProfileDataElem m_root;               //!< The root profile element
     std::stack<ProfileDataElem*> m_stack; //!< A stack of data elements for the push/pop structure
+    std::stack<const std::string*> m_name_stack; //!< Names of the elements in m_stack
+    std::vector<TraceEvent> m_trace;             //!< Recorded events
+    size_t m_max_trace_events = 0;               //!< Maximum number of events to record
+    size_t m_dropped_trace_events = 0;           //!< Number of events not recorded
+    bool m_stopped = false;                      //!< True when the root timer is stopped
 
     //! Output helper function
     void output(std::ostream& o);
@@ -154,6 +195,45 @@ class PYBIND11_EXPORT Profiler
     friend std::ostream& operator<<(std::ostream& o, Profiler& prof);
     };
 
+//! Annotates a region of code for external profiling tools
+/*! ScopedToolRange opens a range named \a name in NVTX (ENABLE_NVTOOLS) or roctx
+    (ENABLE_ROCTRACER) on construction and closes it on destruction. Unlike Profiler::push(), it
+    neither times the region nor synchronizes the GPU, and it compiles to nothing when neither
+    option is enabled. System and ForceCompute wrap every operation they dispatch in one, named
+    after the Python class of the operation, so that Nsight Systems and rocprof timelines cover
+    all operations whether or not the profiler is enabled.
+*/
+class ScopedToolRange
+    {
+    public:
+    //! Open the range
+    /*! \param name Name of the range
+     */
+    explicit ScopedToolRange(const std::string& name)
+        {
+#ifdef ENABLE_NVTOOLS
+        nvtxRangePush(name.c_str());
+#endif
+#ifdef HOOMD_ROCTX
+        roctxRangePush(name.c_str());
+#endif
+        }
+
+    //! Close the range
+    ~ScopedToolRange()
+        {
+#ifdef ENABLE_NVTOOLS
+        nvtxRangePop();
+#endif
+#ifdef HOOMD_ROCTX
+        roctxRangePop();
+#endif
+        }
+
+    ScopedToolRange(const ScopedToolRange&) = delete;
+    ScopedToolRange& operator=(const ScopedToolRange&) = delete;
+    };
+
 //! Exports the Profiler class to python
 #ifndef __HIPCC__
 void export_Profiler(pybind11::module& m);
@@ -202,6 +282,9 @@ inline void Profiler::push(const std::string& name)
 #ifdef ENABLE_NVTOOLS
     nvtxRangePush(name.c_str());
 #endif
+#ifdef HOOMD_ROCTX
+    roctxRangePush(name.c_str());
+#endif
 
     // pushing a new record on to the stack involves taking a time sample
     int64_t t = m_clk.getTime();
@@ -209,14 +292,16 @@ inline void Profiler::push(const std::string& name)
     ProfileDataElem* cur = m_stack.top();
 
     // then creating (or accessing) the named sample and setting the start time
-    cur->m_children[name].m_start_time = t;
+    auto child = cur->m_children.emplace(name, ProfileDataElem()).first;
+    child->second.m_start_time = t;
 
     // and updating the stack
-    m_stack.push(&cur->m_children[name]);
+    m_stack.push(&child->second);
+    m_name_stack.push(&child->first);
 
 #ifdef SCOREP_USER_ENABLE
     // log Score-P region
-    SCOREP_USER_REGION_BEGIN(cur->m_children[name].m_scorep_region,
+    SCOREP_USER_REGION_BEGIN(child->second.m_scorep_region,
                              name.c_str(),
                              SCOREP_USER_REGION_TYPE_COMMON)
 #endif
@@ -231,6 +316,9 @@ inline void Profiler::pop(uint64_t flop_count, uint64_t byte_count)
 #ifdef ENABLE_NVTOOLS
     nvtxRangePop();
 #endif
+#ifdef HOOMD_ROCTX
+    roctxRangePop();
+#endif
 
     // popping up a level in the profile stack involves taking a time sample
     int64_t t = m_clk.getTime();
@@ -241,13 +329,28 @@ inline void Profiler::pop(uint64_t flop_count, uint64_t byte_count)
     SCOREP_USER_REGION_END(cur->m_scorep_region)
 #endif
     cur->m_elapsed_time += t - cur->m_start_time;
+    cur->m_call_count++;
 
     // and increasing the flop and mem counters
     cur->m_flop_count += flop_count;
     cur->m_mem_byte_count += byte_count;
 
+    // record the event
+    if (m_trace.size() < m_max_trace_events)
+        {
+        m_trace.push_back(TraceEvent {m_name_stack.top(),
+                                      cur->m_start_time,
+                                      t - cur->m_start_time,
+                                      (unsigned int)(m_stack.size() - 1)});
+        }
+    else if (m_max_trace_events > 0)
+        {
+        m_dropped_trace_events++;
+        }
+
     // and finally popping the stack so that the next pop will access the correct element
     m_stack.pop();
+    m_name_stack.pop();
     }
 
 #endif
@@ -1,5 +1,83 @@
 #include "PythonLocalDataAccess.h"
 
+namespace
+    {
+/// Owns the shape and strides that a DLManagedTensor points to
+struct DLPackContext
+    {
+    hoomd::detail::DLManagedTensor tensor;
+    std::vector<int64_t> shape;
+    std::vector<int64_t> strides;
+    };
+
+void dlpack_deleter(hoomd::detail::DLManagedTensor* self)
+    {
+    delete static_cast<DLPackContext*>(self->manager_ctx);
+    }
+
+/// Free the tensor when the capsule is destroyed before a consumer took ownership of it
+void dlpack_capsule_destructor(PyObject* capsule)
+    {
+    // consumers rename the capsule to "used_dltensor" and call the deleter themselves
+    if (PyCapsule_IsValid(capsule, "used_dltensor"))
+        return;
+
+    // preserve any exception that is being raised while the capsule is collected
+    PyObject *type, *value, *traceback;
+    PyErr_Fetch(&type, &value, &traceback);
+
+    auto* tensor = static_cast<hoomd::detail::DLManagedTensor*>(
+        PyCapsule_GetPointer(capsule, "dltensor"));
+    if (tensor)
+        tensor->deleter(tensor);
+    else
+        PyErr_WriteUnraisable(capsule);
+
+    PyErr_Restore(type, value, traceback);
+    }
+    } // end anonymous namespace
+
+pybind11::capsule HOOMDBuffer::getDLPack(pybind11::object)
+    {
+    if (m_read_only)
+        throw pybind11::buffer_error("Cannot export a read only buffer through DLPack.");
+
+    // DLPack strides count elements, HOOMD buffers count bytes
+    ssize_t itemsize = m_dtype.bits / 8;
+    auto context = std::unique_ptr<DLPackContext>(new DLPackContext);
+    for (size_t i = 0; i < m_shape.size(); ++i)
+        {
+        if (m_strides[i] % itemsize != 0)
+            throw pybind11::buffer_error("Buffer strides are not a multiple of the item size.");
+        context->shape.push_back(m_shape[i]);
+        context->strides.push_back(m_strides[i] / itemsize);
+        }
+
+    hoomd::detail::DLTensor& dl_tensor = context->tensor.dl_tensor;
+    dl_tensor.data = m_data;
+    dl_tensor.device = m_device;
+    dl_tensor.ndim = (int32_t)m_shape.size();
+    dl_tensor.dtype = m_dtype;
+    dl_tensor.shape = context->shape.data();
+    dl_tensor.strides = context->strides.data();
+    dl_tensor.byte_offset = 0;
+    context->tensor.manager_ctx = context.get();
+    context->tensor.deleter = dlpack_deleter;
+
+    PyObject* capsule = PyCapsule_New(&context->tensor, "dltensor", dlpack_capsule_destructor);
+    if (!capsule)
+        throw pybind11::error_already_set();
+
+    // the capsule now owns the context
+    context.release();
+    return pybind11::reinterpret_steal<pybind11::capsule>(capsule);
+    }
+
+pybind11::tuple HOOMDBuffer::getDLPackDevice() const
+    {
+    return pybind11::make_tuple(m_device.device_type, m_device.device_id);
+    }
+
 void export_GhostDataFlag(pybind11::module& m)
     {
     pybind11::enum_<GhostDataFlag>(m, "GhostDataFlag")
@@ -12,6 +90,10 @@ void export_HOOMDHostBuffer(pybind11::module& m)
     {
     pybind11::class_<HOOMDHostBuffer>(m, "HOOMDHostBuffer", pybind11::buffer_protocol())
         .def_buffer([](HOOMDHostBuffer& b) -> pybind11::buffer_info { return b.new_buffer(); })
+        .def("__dlpack__",
+             &HOOMDHostBuffer::getDLPack,
+             pybind11::arg("stream") = pybind11::none())
+        .def("__dlpack_device__", &HOOMDHostBuffer::getDLPackDevice)
         .def_property_readonly("read_only", &HOOMDHostBuffer::getReadOnly);
     ;
     }
@@ -22,6 +104,10 @@ void export_HOOMDDeviceBuffer(pybind11::module& m)
     pybind11::class_<HOOMDDeviceBuffer>(m, "HOOMDDeviceBuffer")
         .def_property_readonly("__cuda_array_interface__",
                                &HOOMDDeviceBuffer::getCudaArrayInterface)
+        .def("__dlpack__",
+             &HOOMDDeviceBuffer::getDLPack,
+             pybind11::arg("stream") = pybind11::none())
+        .def("__dlpack_device__", &HOOMDDeviceBuffer::getDLPackDevice)
         .def_property_readonly("read_only", &HOOMDDeviceBuffer::getReadOnly);
     ;
     }
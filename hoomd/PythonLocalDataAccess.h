@@ -2,12 +2,77 @@
 #define __PYTHON_LOCAL_DATA_ACCESS_H__
 
 #include "GlobalArray.h"
+#include <cstdint>
 #include <pybind11/numpy.h>
 #include <pybind11/pybind11.h>
 #include <string>
 #include <type_traits>
 #include <utility>
 
+namespace hoomd
+    {
+namespace detail
+    {
+/// Data structures of the DLPack ABI (https://github.com/dmlc/dlpack, version 0.6).
+/** Only the device types and type codes that HOOMD buffers use are listed.
+ */
+enum DLDeviceType : int32_t
+    {
+    kDLCPU = 1,
+    kDLCUDA = 2,
+    kDLROCM = 10
+    };
+
+enum DLDataTypeCode : uint8_t
+    {
+    kDLInt = 0,
+    kDLUInt = 1,
+    kDLFloat = 2
+    };
+
+struct DLDevice
+    {
+    int32_t device_type;
+    int32_t device_id;
+    };
+
+struct DLDataType
+    {
+    uint8_t code;
+    uint8_t bits;
+    uint16_t lanes;
+    };
+
+struct DLTensor
+    {
+    void* data;
+    DLDevice device;
+    int32_t ndim;
+    DLDataType dtype;
+    int64_t* shape;
+    int64_t* strides;
+    uint64_t byte_offset;
+    };
+
+struct DLManagedTensor
+    {
+    DLTensor dl_tensor;
+    void* manager_ctx;
+    void (*deleter)(DLManagedTensor* self);
+    };
+
+/// DLPack description of the scalar type T
+template<class T> DLDataType dlpackDataType()
+    {
+    static_assert(std::is_arithmetic<T>::value, "DLPack buffers must hold arithmetic types.");
+    uint8_t code = std::is_floating_point<T>::value ? kDLFloat
+                   : std::is_signed<T>::value       ? kDLInt
+                                                    : kDLUInt;
+    return DLDataType {code, uint8_t(8 * sizeof(T)), 1};
+    }
+    } // end namespace detail
+    } // end namespace hoomd
+
 /// Base class for buffers for LocalDataAccess template class type checking.
 /** In addition, this class allows for a uniform way of specifying a CPU(Host)
  *  or GPU(Device) buffer.  HOOMDBuffer classes need to implement a templated
@@ -25,14 +90,18 @@ struct HOOMDBuffer
     std::vector<ssize_t> m_shape;
     std::vector<ssize_t> m_strides;
     bool m_read_only;
+    hoomd::detail::DLDataType m_dtype;
+    hoomd::detail::DLDevice m_device;
 
     HOOMDBuffer(void* data,
                 std::string typestr,
                 std::vector<ssize_t> shape,
                 std::vector<ssize_t> strides,
-                bool read_only)
+                bool read_only,
+                hoomd::detail::DLDataType dtype,
+                hoomd::detail::DLDevice device)
         : m_data(data), m_typestr(typestr), m_shape(shape), m_strides(strides),
-          m_read_only(read_only)
+          m_read_only(read_only), m_dtype(dtype), m_device(device)
         {
         if (m_shape.size() != m_strides.size())
             {
@@ -44,6 +113,17 @@ struct HOOMDBuffer
         {
         return m_read_only;
         }
+
+    /// Export the buffer as a DLPack capsule without copying the data.
+    /** The consumer shares the memory, which is only valid while the context manager that
+     *  created the buffer is open. Data is ready on the default stream, so \a stream is
+     *  accepted for compatibility with the protocol and otherwise ignored. Read only buffers
+     *  cannot be exported, as DLPack has no way to mark the memory read only.
+     */
+    pybind11::capsule getDLPack(pybind11::object stream);
+
+    /// Return the (device type, device id) tuple of the DLPack protocol.
+    pybind11::tuple getDLPackDevice() const;
     };
 
 /// Represents the data required to specify a CPU buffer object in Python.
@@ -62,9 +142,16 @@ struct HOOMDHostBuffer : public HOOMDBuffer
                     std::vector<ssize_t> strides,
                     bool read_only,
                     ssize_t itemsize,
-                    ssize_t dimensions)
-        : HOOMDBuffer(data, typestr, shape, strides, read_only), m_itemsize(itemsize),
-          m_dimensions(dimensions)
+                    ssize_t dimensions,
+                    hoomd::detail::DLDataType dtype)
+        : HOOMDBuffer(data,
+                      typestr,
+                      shape,
+                      strides,
+                      read_only,
+                      dtype,
+                      hoomd::detail::DLDevice {hoomd::detail::kDLCPU, 0}),
+          m_itemsize(itemsize), m_dimensions(dimensions)
         {
         }
 
@@ -78,7 +165,8 @@ struct HOOMDHostBuffer : public HOOMDBuffer
                                strides,
                                read_only,
                                sizeof(T),
-                               shape.size());
+                               shape.size(),
+                               hoomd::detail::dlpackDataType<T>());
         }
 
     pybind11::buffer_info new_buffer()
@@ -105,8 +193,10 @@ struct HOOMDDeviceBuffer : public HOOMDBuffer
                       std::string typestr,
                       std::vector<ssize_t> shape,
                       std::vector<ssize_t> strides,
-                      bool read_only)
-        : HOOMDBuffer(data, typestr, shape, strides, read_only)
+                      bool read_only,
+                      hoomd::detail::DLDataType dtype,
+                      hoomd::detail::DLDevice device)
+        : HOOMDBuffer(data, typestr, shape, strides, read_only, dtype, device)
         {
         }
 
@@ -114,11 +204,20 @@ struct HOOMDDeviceBuffer : public HOOMDBuffer
     static HOOMDDeviceBuffer
     make(T* data, std::vector<ssize_t> shape, std::vector<ssize_t> strides, bool read_only)
         {
+        int device_id = 0;
+        hipGetDevice(&device_id);
+#ifdef __HIP_PLATFORM_NVCC__
+        auto device_type = hoomd::detail::kDLCUDA;
+#else
+        auto device_type = hoomd::detail::kDLROCM;
+#endif
         return HOOMDDeviceBuffer(data,
                                  pybind11::format_descriptor<T>::format(),
                                  shape,
                                  strides,
-                                 read_only);
+                                 read_only,
+                                 hoomd::detail::dlpackDataType<T>(),
+                                 hoomd::detail::DLDevice {device_type, device_id});
         }
 
     /// Convert object to a __cuda_array_interface__ v2 compliant Python dict.
@@ -321,6 +420,38 @@ template<class Output, class Data> class LocalDataAccess
                             true);
         }
 
+    /// Convert Global/GPUArray or vector into an Ouput object with a given size
+    /** This function is for arrays that are not indexed by particle, such as
+     *  the flat neighbor list. The exposed array holds the first \a size
+     *  elements of the internal array.
+     *
+     *  Template parameters:
+     *  T: the value stored in the by the internal array (i.e. the template
+     *  parameter of the ArrayHandle)
+     *  U: the templated array class returned by the parameter
+     *  get_array_func.
+     *
+     *  Arguments:
+     *  handle: a reference to the unique_ptr that holds the ArrayHandle.
+     *  get_array_func: the method of m_data to use to access the array.
+     *  size: the number of elements exposed in Python.
+     *  read_only: whether the array should be read only (defaults to True).
+     */
+    template<class T, template<class> class U = GlobalArray>
+    Output getBufferOfSize(std::unique_ptr<ArrayHandle<T>>& handle,
+                           const U<T>& (Data::*get_array_func)() const,
+                           size_t size,
+                           bool read_only = true)
+        {
+        checkManager();
+        updateHandle(handle, get_array_func, read_only);
+
+        return Output::make(handle.get()->data,
+                            std::vector<ssize_t>({(ssize_t)size}),
+                            std::vector<ssize_t>({sizeof(T)}),
+                            read_only);
+        }
+
     // clear should remove any references to ArrayHandle objects so the
     // handle can be released for other objects.
     virtual void clear() = 0;
@@ -63,6 +63,12 @@ struct RNGIdentifier
     static const uint8_t HPMCDepletantNumClusters = 38;
     static const uint8_t HPMCMonoPatch = 39;
     static const uint8_t UpdaterClusters2 = 40;
+    static const uint8_t HPMCMonoCheckerboard = 41;
+    static const uint8_t RandomBatchEwald = 42;
+    static const uint8_t HPMCMonoExternalField = 43;
+    static const uint8_t SDFGeometryFiller = 44;
+    static const uint8_t HPMCDepletantCache = 45;
+    static const uint8_t ReplicaExchangeUpdater = 46;
     };
 
     } // namespace hoomd
@@ -229,6 +229,14 @@ class RandomGenerator
     /// Generate uniformly distributed 128-bit values
     DEVICE inline r123::Philox4x32::ctr_type operator()();
 
+    /// Advance the generator without computing the skipped values
+    /** @param n Number of steps to skip.
+     */
+    DEVICE inline void discard(uint32_t n)
+        {
+        m_ctr.v[0] += n;
+        }
+
     /// Get the key
     DEVICE inline r123::Philox4x32::key_type getKey()
         {
@@ -264,6 +272,89 @@ DEVICE inline r123::Philox4x32::ctr_type RandomGenerator::operator()()
     return u;
     }
 
+#ifndef __HIPCC__
+//! Philox random number generator for N independent streams at once
+/*! RandomGeneratorBatch evaluates the streams of N RandomGenerator instances that share a Seed
+    and differ in their Counter, one lane per stream. Lane i of each step produces the same value
+    as the matching step of RandomGenerator(seed, counter_i), so CPU code can draw the random
+    numbers of N particles at a time and still reproduce the per particle streams exactly.
+
+    The Philox4x32-10 rounds are written as loops over the lanes with no dependencies between
+    them, which the compiler turns into SIMD instructions. Choose N as a multiple of the SIMD width
+    (8 for 32-bit lanes with AVX2, 16 with AVX-512).
+*/
+template<unsigned int N> class RandomGeneratorBatch
+    {
+    public:
+    /** Construct a batch generator with all lanes at a zero counter
+
+        @param seed RNG seed shared by all lanes.
+    */
+    inline explicit RandomGeneratorBatch(const Seed& seed)
+        {
+        m_key[0] = seed.getKey().v[0];
+        m_key[1] = seed.getKey().v[1];
+        for (unsigned int k = 0; k < 4; k++)
+            for (unsigned int i = 0; i < N; i++)
+                m_ctr[k][i] = 0;
+        }
+
+    /** Set the counter of one lane
+
+        @param i Lane index.
+        @param counter Initial value of the RNG counter of lane \a i.
+    */
+    inline void setCounter(unsigned int i, const Counter& counter)
+        {
+        for (unsigned int k = 0; k < 4; k++)
+            m_ctr[k][i] = counter.getCounter().v[k];
+        }
+
+    /** Generate uniformly distributed 128-bit values in every lane
+
+        @param u [out] Word k of the value of lane i is placed in u[k][i].
+
+        @post The state of every lane is advanced one step.
+    */
+    inline void operator()(uint32_t (&u)[4][N])
+        {
+        for (unsigned int k = 0; k < 4; k++)
+            for (unsigned int i = 0; i < N; i++)
+                u[k][i] = m_ctr[k][i];
+
+        uint32_t key0 = m_key[0];
+        uint32_t key1 = m_key[1];
+        for (unsigned int round = 0; round < 10; round++)
+            {
+            if (round > 0)
+                {
+                key0 += 0x9E3779B9;
+                key1 += 0xBB67AE85;
+                }
+
+            for (unsigned int i = 0; i < N; i++)
+                {
+                const uint64_t p0 = uint64_t(0xD2511F53) * u[0][i];
+                const uint64_t p1 = uint64_t(0xCD9E8D57) * u[2][i];
+                const uint32_t x1 = u[1][i];
+                const uint32_t x3 = u[3][i];
+                u[0][i] = uint32_t(p1 >> 32) ^ x1 ^ key0;
+                u[1][i] = uint32_t(p1);
+                u[2][i] = uint32_t(p0 >> 32) ^ x3 ^ key1;
+                u[3][i] = uint32_t(p0);
+                }
+            }
+
+        for (unsigned int i = 0; i < N; i++)
+            m_ctr[0][i] += 1;
+        }
+
+    private:
+    uint32_t m_key[2];    //!< RNG key shared by all lanes
+    uint32_t m_ctr[4][N]; //!< RNG counter of each lane
+    };
+#endif
+
 namespace detail
     {
 //! Generate a uniform random uint32_t
@@ -330,6 +421,71 @@ template<typename Real> class UniformDistribution
         return a + width * detail::generate_canonical<Real>(rng);
         }
 
+    //! Draw two values from the distribution
+    /*! \param out1 [out] First output
+        \param out2 [out] Second output
+        \param rng Random number generator
+
+        Both values are taken from one step of the generator.
+    */
+    template<typename RNG> DEVICE inline void operator()(Real& out1, Real& out2, RNG& rng)
+        {
+        uint64_t u0, u1;
+        detail::generate_2u64(u0, u1, rng);
+        out1 = a + width * r123::u01<Real>(u0);
+        out2 = a + width * r123::u01<Real>(u1);
+        }
+
+    //! Draw N values from the distribution
+    /*! \param out [out] Array of outputs
+        \param rng Random number generator
+
+        The values are drawn in pairs, so the generator is advanced (N+1)/2 steps instead of N.
+    */
+    template<unsigned int N, typename RNG> DEVICE inline void operator()(Real (&out)[N], RNG& rng)
+        {
+        for (unsigned int i = 0; i + 1 < N; i += 2)
+            (*this)(out[i], out[i + 1], rng);
+        if (N % 2)
+            out[N - 1] = (*this)(rng);
+        }
+
+#ifndef __HIPCC__
+    //! Draw two values in every lane of a batch generator
+    /*! \param out1 [out] First output of each lane
+        \param out2 [out] Second output of each lane
+        \param rng Batch random number generator
+
+        Lane i receives the values that operator()(out1, out2, rng_i) draws from the matching
+        RandomGenerator.
+    */
+    template<unsigned int N>
+    inline void operator()(Real (&out1)[N], Real (&out2)[N], RandomGeneratorBatch<N>& rng)
+        {
+        uint32_t u[4][N];
+        rng(u);
+        for (unsigned int i = 0; i < N; i++)
+            {
+            out1[i] = a + width * r123::u01<Real>(uint64_t(u[0][i]) << 32 | u[1][i]);
+            out2[i] = a + width * r123::u01<Real>(uint64_t(u[2][i]) << 32 | u[3][i]);
+            }
+        }
+
+    //! Draw one value in every lane of a batch generator
+    /*! \param out [out] Output of each lane
+        \param rng Batch random number generator
+
+        Lane i receives the value that operator()(rng_i) draws from the matching RandomGenerator.
+    */
+    template<unsigned int N> inline void operator()(Real (&out)[N], RandomGeneratorBatch<N>& rng)
+        {
+        uint32_t u[4][N];
+        rng(u);
+        for (unsigned int i = 0; i < N; i++)
+            out[i] = a + width * r123::u01<Real>(uint64_t(u[0][i]) << 32 | u[1][i]);
+        }
+#endif
+
     private:
     const Real a;     //!< Left end point of the interval
     const Real width; //!< Width of the interval
@@ -391,6 +547,20 @@ template<typename Real> class NormalDistribution
         out2 = y + mu;
         }
 
+    //! Draw N values from the distribution
+    /*! \param out [out] Array of outputs
+        \param rng Random number generator
+
+        The values are drawn in pairs, so the generator is advanced (N+1)/2 steps instead of N.
+    */
+    template<unsigned int N, typename RNG> DEVICE inline void operator()(Real (&out)[N], RNG& rng)
+        {
+        for (unsigned int i = 0; i + 1 < N; i += 2)
+            (*this)(out[i], out[i + 1], rng);
+        if (N % 2)
+            out[N - 1] = (*this)(rng);
+        }
+
     private:
     const Real sigma; //!< Standard deviation
     const Real mu;    //!< Mean
@@ -404,15 +574,15 @@ template<typename Real> class SpherePointGenerator
 
     template<typename RNG, typename Real3> DEVICE inline void operator()(RNG& rng, Real3& point)
         {
-        // draw a random angle
-        const Real theta = UniformDistribution<Real>(Real(0), Real(2.0 * M_PI))(rng);
-
-        // draw u (should typically only happen once) ensuring that
-        // 1-u^2 > 0 so that the square-root is defined
-        Real u, one_minus_u2;
+        // draw a random angle and u from one step of the generator (should typically only happen
+        // once) ensuring that 1-u^2 > 0 so that the square-root is defined
+        Real theta, u, one_minus_u2;
         do
             {
-            u = UniformDistribution<Real>(Real(-1.0), Real(1.0))(rng);
+            uint64_t u0, u1;
+            detail::generate_2u64(u0, u1, rng);
+            theta = Real(2.0 * M_PI) * r123::u01<Real>(u0);
+            u = r123::uneg11<Real>(u1);
             one_minus_u2 = 1.0f - u * u;
             } while (one_minus_u2 < Real(0.0));
 
@@ -16,14 +16,63 @@
 #include <math.h>
 #include <stdexcept>
 
+#ifdef ENABLE_TBB
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/parallel_sort.h>
+#endif
+
 using namespace std;
 namespace py = pybind11;
 
+//! Call body(begin, end) on subranges of [0, N), split among the TBB threads when available
+template<class Body>
+static void forEachRange(std::shared_ptr<const ExecutionConfiguration> exec_conf,
+                         unsigned int N,
+                         const Body& body)
+    {
+#ifdef ENABLE_TBB
+    exec_conf->getTaskArena()->execute(
+        [&]
+        {
+            tbb::parallel_for(tbb::blocked_range<unsigned int>(0, N),
+                              [&](const tbb::blocked_range<unsigned int>& r)
+                              { body(r.begin(), r.end()); });
+        });
+#else
+    body(0, N);
+#endif
+    }
+
+//! Reorder the N entries of \a data so that entry i is the old entry \a order[i]
+/*! \a tmp must hold at least N entries.
+ */
+template<class T>
+static void reorder(std::shared_ptr<const ExecutionConfiguration> exec_conf,
+                    T* data,
+                    T* tmp,
+                    const std::vector<unsigned int>& order,
+                    unsigned int N)
+    {
+    forEachRange(exec_conf,
+                 N,
+                 [&](unsigned int begin, unsigned int end)
+                 {
+                     for (unsigned int i = begin; i < end; i++)
+                         tmp[i] = data[order[i]];
+                 });
+    forEachRange(exec_conf,
+                 N,
+                 [&](unsigned int begin, unsigned int end)
+                 { std::copy(tmp + begin, tmp + end, data + begin); });
+    }
+
 /*! \param sysdef System to perform sorts on
  */
 SFCPackTuner::SFCPackTuner(std::shared_ptr<SystemDefinition> sysdef,
                            std::shared_ptr<Trigger> trigger)
-    : Tuner(sysdef, trigger), m_last_grid(0), m_last_dim(0)
+    : Tuner(sysdef, trigger), m_last_grid(0), m_last_dim(0), m_curve(hoomd::sfc_curve::hilbert),
+      m_last_curve(hoomd::sfc_curve::hilbert), m_threshold(0), m_low_memory(false)
     {
     m_exec_conf->msg->notice(5) << "Constructing SFCPackTuner" << endl;
 
@@ -73,6 +122,45 @@ SFCPackTuner::~SFCPackTuner()
 void SFCPackTuner::update(uint64_t timestep)
     {
     Updater::update(timestep);
+
+    // skip the sort while the particles remain mostly in order
+    if (m_threshold > Scalar(0.0))
+        {
+        if (m_prof)
+            m_prof->push(m_exec_conf, "SFCPack check");
+
+        unsigned long long n_unsorted = countUnsorted();
+        unsigned long long N = m_pdata->getN();
+#ifdef ENABLE_MPI
+        if (m_comm)
+            {
+            MPI_Allreduce(MPI_IN_PLACE,
+                          &n_unsorted,
+                          1,
+                          MPI_UNSIGNED_LONG_LONG,
+                          MPI_SUM,
+                          m_exec_conf->getMPICommunicator());
+            MPI_Allreduce(MPI_IN_PLACE,
+                          &N,
+                          1,
+                          MPI_UNSIGNED_LONG_LONG,
+                          MPI_SUM,
+                          m_exec_conf->getMPICommunicator());
+            }
+#endif
+
+        if (m_prof)
+            m_prof->pop(m_exec_conf);
+
+        Scalar unsorted_fraction = N > 0 ? Scalar(n_unsorted) / Scalar(N) : Scalar(0.0);
+        if (unsorted_fraction < m_threshold)
+            {
+            m_exec_conf->msg->notice(6) << "SFCPackTuner: skipping sort, " << unsorted_fraction
+                                        << " of the particles are out of order" << std::endl;
+            return;
+            }
+        }
+
     m_exec_conf->msg->notice(6) << "SFCPackTuner: particle sort" << std::endl;
 
 #ifdef ENABLE_MPI
@@ -150,54 +238,36 @@ void SFCPackTuner::applySortOrder()
                                      access_location::host,
                                      access_mode::readwrite);
 
-    // construct a temporary holding array for the sorted data
-    Scalar4* scal4_tmp = new Scalar4[m_pdata->getN()];
+    // a single holding array for the sorted data, large enough for the widest per-particle type,
+    // is reused for all arrays
+    const unsigned int N = m_pdata->getN();
+    std::vector<Scalar4> tmp(N);
+    Scalar4* scal4_tmp = tmp.data();
+    Scalar3* scal3_tmp = reinterpret_cast<Scalar3*>(scal4_tmp);
+    Scalar* scal_tmp = reinterpret_cast<Scalar*>(scal4_tmp);
+    int3* int3_tmp = reinterpret_cast<int3*>(scal4_tmp);
+    unsigned int* uint_tmp = reinterpret_cast<unsigned int*>(scal4_tmp);
 
     // sort positions and types
-    for (unsigned int i = 0; i < m_pdata->getN(); i++)
-        scal4_tmp[i] = h_pos.data[m_sort_order[i]];
-    for (unsigned int i = 0; i < m_pdata->getN(); i++)
-        h_pos.data[i] = scal4_tmp[i];
+    reorder(m_exec_conf, h_pos.data, scal4_tmp, m_sort_order, N);
 
     // sort velocities and mass
-    for (unsigned int i = 0; i < m_pdata->getN(); i++)
-        scal4_tmp[i] = h_vel.data[m_sort_order[i]];
-    for (unsigned int i = 0; i < m_pdata->getN(); i++)
-        h_vel.data[i] = scal4_tmp[i];
+    reorder(m_exec_conf, h_vel.data, scal4_tmp, m_sort_order, N);
 
-    Scalar3* scal3_tmp = new Scalar3[m_pdata->getN()];
     // sort accelerations
-    for (unsigned int i = 0; i < m_pdata->getN(); i++)
-        scal3_tmp[i] = h_accel.data[m_sort_order[i]];
-    for (unsigned int i = 0; i < m_pdata->getN(); i++)
-        h_accel.data[i] = scal3_tmp[i];
+    reorder(m_exec_conf, h_accel.data, scal3_tmp, m_sort_order, N);
 
-    Scalar* scal_tmp = new Scalar[m_pdata->getN()];
     // sort charge
-    for (unsigned int i = 0; i < m_pdata->getN(); i++)
-        scal_tmp[i] = h_charge.data[m_sort_order[i]];
-    for (unsigned int i = 0; i < m_pdata->getN(); i++)
-        h_charge.data[i] = scal_tmp[i];
+    reorder(m_exec_conf, h_charge.data, scal_tmp, m_sort_order, N);
 
     // sort diameter
-    for (unsigned int i = 0; i < m_pdata->getN(); i++)
-        scal_tmp[i] = h_diameter.data[m_sort_order[i]];
-    for (unsigned int i = 0; i < m_pdata->getN(); i++)
-        h_diameter.data[i] = scal_tmp[i];
+    reorder(m_exec_conf, h_diameter.data, scal_tmp, m_sort_order, N);
 
     // sort angular momentum
-    for (unsigned int i = 0; i < m_pdata->getN(); i++)
-        scal4_tmp[i] = h_angmom.data[m_sort_order[i]];
-    for (unsigned int i = 0; i < m_pdata->getN(); i++)
-        h_angmom.data[i] = scal4_tmp[i];
+    reorder(m_exec_conf, h_angmom.data, scal4_tmp, m_sort_order, N);
 
     // sort moment of inertia
-    for (unsigned int i = 0; i < m_pdata->getN(); i++)
-        scal3_tmp[i] = h_inertia.data[m_sort_order[i]];
-    for (unsigned int i = 0; i < m_pdata->getN(); i++)
-        {
-        h_inertia.data[i] = scal3_tmp[i];
-        }
+    reorder(m_exec_conf, h_inertia.data, scal3_tmp, m_sort_order, N);
 
     // in case anyone access it from frame to frame, sort the net virial
         {
@@ -208,10 +278,7 @@ void SFCPackTuner::applySortOrder()
 
         for (unsigned int j = 0; j < 6; j++)
             {
-            for (unsigned int i = 0; i < m_pdata->getN(); i++)
-                scal_tmp[i] = h_net_virial.data[j * virial_pitch + m_sort_order[i]];
-            for (unsigned int i = 0; i < m_pdata->getN(); i++)
-                h_net_virial.data[j * virial_pitch + i] = scal_tmp[i];
+            reorder(m_exec_conf, h_net_virial.data + j * virial_pitch, scal_tmp, m_sort_order, N);
             }
         }
 
@@ -221,10 +288,7 @@ void SFCPackTuner::applySortOrder()
                                          access_location::host,
                                          access_mode::readwrite);
 
-        for (unsigned int i = 0; i < m_pdata->getN(); i++)
-            scal4_tmp[i] = h_net_force.data[m_sort_order[i]];
-        for (unsigned int i = 0; i < m_pdata->getN(); i++)
-            h_net_force.data[i] = scal4_tmp[i];
+        reorder(m_exec_conf, h_net_force.data, scal4_tmp, m_sort_order, N);
         }
 
         {
@@ -232,10 +296,7 @@ void SFCPackTuner::applySortOrder()
                                           access_location::host,
                                           access_mode::readwrite);
 
-        for (unsigned int i = 0; i < m_pdata->getN(); i++)
-            scal4_tmp[i] = h_net_torque.data[m_sort_order[i]];
-        for (unsigned int i = 0; i < m_pdata->getN(); i++)
-            h_net_torque.data[i] = scal4_tmp[i];
+        reorder(m_exec_conf, h_net_torque.data, scal4_tmp, m_sort_order, N);
         }
 
         {
@@ -243,43 +304,26 @@ void SFCPackTuner::applySortOrder()
                                            access_location::host,
                                            access_mode::readwrite);
 
-        for (unsigned int i = 0; i < m_pdata->getN(); i++)
-            scal4_tmp[i] = h_orientation.data[m_sort_order[i]];
-        for (unsigned int i = 0; i < m_pdata->getN(); i++)
-            h_orientation.data[i] = scal4_tmp[i];
+        reorder(m_exec_conf, h_orientation.data, scal4_tmp, m_sort_order, N);
         }
 
     // sort image
-    int3* int3_tmp = new int3[m_pdata->getN()];
-    for (unsigned int i = 0; i < m_pdata->getN(); i++)
-        int3_tmp[i] = h_image.data[m_sort_order[i]];
-    for (unsigned int i = 0; i < m_pdata->getN(); i++)
-        h_image.data[i] = int3_tmp[i];
+    reorder(m_exec_conf, h_image.data, int3_tmp, m_sort_order, N);
 
     // sort body
-    unsigned int* uint_tmp = new unsigned int[m_pdata->getN()];
-    for (unsigned int i = 0; i < m_pdata->getN(); i++)
-        uint_tmp[i] = h_body.data[m_sort_order[i]];
-    for (unsigned int i = 0; i < m_pdata->getN(); i++)
-        h_body.data[i] = uint_tmp[i];
+    reorder(m_exec_conf, h_body.data, uint_tmp, m_sort_order, N);
 
     // sort global tag
-    for (unsigned int i = 0; i < m_pdata->getN(); i++)
-        uint_tmp[i] = h_tag.data[m_sort_order[i]];
-    for (unsigned int i = 0; i < m_pdata->getN(); i++)
-        h_tag.data[i] = uint_tmp[i];
+    reorder(m_exec_conf, h_tag.data, uint_tmp, m_sort_order, N);
 
     // rebuild global rtag
-    for (unsigned int i = 0; i < m_pdata->getN(); i++)
-        {
-        h_rtag.data[h_tag.data[i]] = i;
-        }
-
-    delete[] scal_tmp;
-    delete[] scal4_tmp;
-    delete[] scal3_tmp;
-    delete[] uint_tmp;
-    delete[] int3_tmp;
+    forEachRange(m_exec_conf,
+                 N,
+                 [&](unsigned int begin, unsigned int end)
+                 {
+                     for (unsigned int i = begin; i < end; i++)
+                         h_rtag.data[h_tag.data[i]] = i;
+                 });
     }
 
 //! x walking table for the hilbert curve
@@ -480,29 +524,109 @@ void SFCPackTuner::generateTraversalOrder(int i,
         }
     }
 
-void SFCPackTuner::getSortedOrder2D()
+/*! Generates the traversal order of the 3D grid along the chosen curve. The Hilbert curve is
+    generated recursively, the other curves directly from the grid indices.
+*/
+void SFCPackTuner::updateTraversalOrder()
+    {
+    if (m_last_grid == m_grid && m_last_dim == 3 && m_last_curve == m_curve)
+        return;
+
+    if (m_grid > 256)
+        {
+        unsigned int mb = m_grid * m_grid * m_grid * 4 / 1024 / 1024;
+        m_exec_conf->msg->warning()
+            << "sorter is about to allocate a very large amount of memory (" << mb << "MB)"
+            << " and may crash." << endl;
+        m_exec_conf->msg->warning() << "            Reduce the amount of memory allocated to "
+                                       "prevent this by decreasing the "
+                                    << endl;
+        m_exec_conf->msg->warning() << "            grid dimension (i.e. "
+                                       "sorter.set_params(grid=128) ) or by disabling it "
+                                    << endl;
+        m_exec_conf->msg->warning()
+            << "            ( sorter.disable() ) before beginning the run()." << endl;
+        }
+
+    // generate the traversal order
+    GPUArray<unsigned int> traversal_order(m_grid * m_grid * m_grid, m_exec_conf);
+    m_traversal_order.swap(traversal_order);
+
+    // access traversal order
+    ArrayHandle<unsigned int> h_traversal_order(m_traversal_order,
+                                                access_location::host,
+                                                access_mode::overwrite);
+
+    if (m_curve == hoomd::sfc_curve::hilbert)
+        {
+        vector<unsigned int> reverse_order(m_grid * m_grid * m_grid);
+        reverse_order.clear();
+
+        // we need to start the hilbert curve with a seed order 0,1,2,3,4,5,6,7
+        unsigned int cell_order[8];
+        for (unsigned int i = 0; i < 8; i++)
+            cell_order[i] = i;
+        generateTraversalOrder(0, 0, 0, m_grid, m_grid, cell_order, reverse_order);
+
+        for (unsigned int i = 0; i < m_grid * m_grid * m_grid; i++)
+            h_traversal_order.data[reverse_order[i]] = i;
+
+        // write the traversal order out to a file for testing/presentations
+        // writeTraversalOrder("hilbert.mol2", reverse_order);
+        }
+    else
+        {
+        for (unsigned int ib = 0; ib < m_grid; ib++)
+            for (unsigned int jb = 0; jb < m_grid; jb++)
+                for (unsigned int kb = 0; kb < m_grid; kb++)
+                    {
+                    unsigned int bin = ib * (m_grid * m_grid) + jb * m_grid + kb;
+                    if (m_curve == hoomd::sfc_curve::morton)
+                        h_traversal_order.data[bin] = hoomd::morton_index(ib, jb, kb, m_grid);
+                    else
+                        h_traversal_order.data[bin] = (kb * m_grid + jb) * m_grid + ib;
+                    }
+        }
+
+    m_last_grid = m_grid;
+    m_last_curve = m_curve;
+    // store the last system dimension computed so we can be mindful if that ever changes
+    m_last_dim = 3;
+    }
+
+void SFCPackTuner::binParticles()
     {
     // start by checking the saneness of some member variables
     assert(m_pdata);
-    assert(m_sort_order.size() >= m_pdata->getN());
+    assert(m_particle_bins.size() >= m_pdata->getN());
 
     // make even bin dimensions
     const BoxDim& box = m_pdata->getBox();
+    const bool twod = m_sysdef->getNDimensions() == 2;
+
+    // reallocate memory arrays if m_grid changed
+    // also regenerate the traversal order
+    if (!twod)
+        updateTraversalOrder();
 
     // put the particles in the bins
-        {
-        ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(),
-                                   access_location::host,
-                                   access_mode::read);
+    ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
+
+    // access traversal order
+    ArrayHandle<unsigned int> h_traversal_order(m_traversal_order,
+                                                access_location::host,
+                                                access_mode::read);
 
-        // for each particle
-        for (unsigned int n = 0; n < m_pdata->getN(); n++)
+    // for each particle
+    auto bin_particles = [&](unsigned int begin, unsigned int end)
+    {
+        for (unsigned int n = begin; n < end; n++)
             {
-            // find the bin each particle belongs in
             Scalar3 p = make_scalar3(h_pos.data[n].x, h_pos.data[n].y, h_pos.data[n].z);
             Scalar3 f = box.makeFraction(p, make_scalar3(0.0, 0.0, 0.0));
             int ib = (unsigned int)(f.x * m_grid) % m_grid;
             int jb = (unsigned int)(f.y * m_grid) % m_grid;
+            int kb = twod ? 0 : (unsigned int)(f.z * m_grid) % m_grid;
 
             // if the particle is slightly outside, move back into grid
             if (ib < 0)
@@ -515,126 +639,63 @@ void SFCPackTuner::getSortedOrder2D()
             if (jb >= (int)m_grid)
                 jb = m_grid - 1;
 
-            // record its bin
-            unsigned int bin = ib * m_grid + jb;
+            if (kb < 0)
+                kb = 0;
+            if (kb >= (int)m_grid)
+                kb = m_grid - 1;
+
+            // record the position of its bin along the curve
+            unsigned int bin;
+            if (twod)
+                bin = hoomd::sfc_index_2d(ib, jb, m_grid, m_curve);
+            else
+                bin = h_traversal_order.data[ib * (m_grid * m_grid) + jb * m_grid + kb];
 
             m_particle_bins[n] = std::pair<unsigned int, unsigned int>(bin, n);
             }
-        }
+    };
+    forEachRange(m_exec_conf, m_pdata->getN(), bin_particles);
+    }
 
-    // sort the tuples
-    sort(m_particle_bins.begin(), m_particle_bins.begin() + m_pdata->getN());
+/*! \returns The number of local particles whose bin comes before that of the previous particle in
+    memory. The count is 0 right after a sort and grows as the particles diffuse.
+*/
+unsigned int SFCPackTuner::countUnsorted()
+    {
+    binParticles();
 
-    // translate the sorted order
-    for (unsigned int j = 0; j < m_pdata->getN(); j++)
+    unsigned int n_unsorted = 0;
+    for (unsigned int n = 1; n < m_pdata->getN(); n++)
         {
-        m_sort_order[j] = m_particle_bins[j].second;
+        if (m_particle_bins[n].first < m_particle_bins[n - 1].first)
+            n_unsorted++;
         }
+    return n_unsorted;
+    }
+
+void SFCPackTuner::getSortedOrder2D()
+    {
+    // binParticles handles both cases
+    getSortedOrder3D();
     }
 
 void SFCPackTuner::getSortedOrder3D()
     {
-    // start by checking the saneness of some member variables
-    assert(m_pdata);
     assert(m_sort_order.size() >= m_pdata->getN());
 
-    // make even bin dimensions
-    const BoxDim& box = m_pdata->getBox();
-
-    // reallocate memory arrays if m_grid changed
-    // also regenerate the traversal order
-    if (m_last_grid != m_grid || m_last_dim != 3)
-        {
-        if (m_grid > 256)
-            {
-            unsigned int mb = m_grid * m_grid * m_grid * 4 / 1024 / 1024;
-            m_exec_conf->msg->warning()
-                << "sorter is about to allocate a very large amount of memory (" << mb << "MB)"
-                << " and may crash." << endl;
-            m_exec_conf->msg->warning() << "            Reduce the amount of memory allocated to "
-                                           "prevent this by decreasing the "
-                                        << endl;
-            m_exec_conf->msg->warning() << "            grid dimension (i.e. "
-                                           "sorter.set_params(grid=128) ) or by disabling it "
-                                        << endl;
-            m_exec_conf->msg->warning()
-                << "            ( sorter.disable() ) before beginning the run()." << endl;
-            }
-
-        // generate the traversal order
-        GPUArray<unsigned int> traversal_order(m_grid * m_grid * m_grid, m_exec_conf);
-        m_traversal_order.swap(traversal_order);
-
-        vector<unsigned int> reverse_order(m_grid * m_grid * m_grid);
-        reverse_order.clear();
-
-        // we need to start the hilbert curve with a seed order 0,1,2,3,4,5,6,7
-        unsigned int cell_order[8];
-        for (unsigned int i = 0; i < 8; i++)
-            cell_order[i] = i;
-        generateTraversalOrder(0, 0, 0, m_grid, m_grid, cell_order, reverse_order);
-
-        // access traversal order
-        ArrayHandle<unsigned int> h_traversal_order(m_traversal_order,
-                                                    access_location::host,
-                                                    access_mode::overwrite);
-
-        for (unsigned int i = 0; i < m_grid * m_grid * m_grid; i++)
-            h_traversal_order.data[reverse_order[i]] = i;
-
-        // write the traversal order out to a file for testing/presentations
-        // writeTraversalOrder("hilbert.mol2", reverse_order);
-
-        m_last_grid = m_grid;
-        // store the last system dimension computed so we can be mindful if that ever changes
-        m_last_dim = m_sysdef->getNDimensions();
-        }
-
-    // sanity checks
-    assert(m_particle_bins.size() >= m_pdata->getN());
-    assert(m_traversal_order.getNumElements() == m_grid * m_grid * m_grid);
-
-    // put the particles in the bins
-    ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
-
-    // access traversal order
-    ArrayHandle<unsigned int> h_traversal_order(m_traversal_order,
-                                                access_location::host,
-                                                access_mode::read);
-
-    // for each particle
-    for (unsigned int n = 0; n < m_pdata->getN(); n++)
-        {
-        Scalar3 p = make_scalar3(h_pos.data[n].x, h_pos.data[n].y, h_pos.data[n].z);
-        Scalar3 f = box.makeFraction(p, make_scalar3(0.0, 0.0, 0.0));
-        int ib = (unsigned int)(f.x * m_grid) % m_grid;
-        int jb = (unsigned int)(f.y * m_grid) % m_grid;
-        int kb = (unsigned int)(f.z * m_grid) % m_grid;
-
-        // if the particle is slightly outside, move back into grid
-        if (ib < 0)
-            ib = 0;
-        if (ib >= (int)m_grid)
-            ib = m_grid - 1;
-
-        if (jb < 0)
-            jb = 0;
-        if (jb >= (int)m_grid)
-            jb = m_grid - 1;
-
-        if (kb < 0)
-            kb = 0;
-        if (kb >= (int)m_grid)
-            kb = m_grid - 1;
-
-        // record its bin
-        unsigned int bin = ib * (m_grid * m_grid) + jb * m_grid + kb;
-
-        m_particle_bins[n] = std::pair<unsigned int, unsigned int>(h_traversal_order.data[bin], n);
-        }
+    binParticles();
 
     // sort the tuples
+#ifdef ENABLE_TBB
+    m_exec_conf->getTaskArena()->execute(
+        [&]
+        {
+            tbb::parallel_sort(m_particle_bins.begin(),
+                               m_particle_bins.begin() + m_pdata->getN());
+        });
+#else
     sort(m_particle_bins.begin(), m_particle_bins.begin() + m_pdata->getN());
+#endif
 
     // translate the sorted order
     for (unsigned int j = 0; j < m_pdata->getN(); j++)
@@ -677,9 +738,36 @@ void SFCPackTuner::writeTraversalOrder(const std::string& fname,
         }
     }
 
+/*! \param curve Name of the curve: "hilbert", "morton", or "cell"
+ */
+void SFCPackTuner::setCurvePython(const std::string& curve)
+    {
+    if (curve == "hilbert")
+        m_curve = hoomd::sfc_curve::hilbert;
+    else if (curve == "morton")
+        m_curve = hoomd::sfc_curve::morton;
+    else if (curve == "cell")
+        m_curve = hoomd::sfc_curve::cell;
+    else
+        throw std::domain_error("Invalid curve: " + curve);
+    }
+
+std::string SFCPackTuner::getCurvePython()
+    {
+    if (m_curve == hoomd::sfc_curve::morton)
+        return "morton";
+    else if (m_curve == hoomd::sfc_curve::cell)
+        return "cell";
+    else
+        return "hilbert";
+    }
+
 void export_SFCPackTuner(py::module& m)
     {
     py::class_<SFCPackTuner, Tuner, std::shared_ptr<SFCPackTuner>>(m, "SFCPackTuner")
         .def(py::init<std::shared_ptr<SystemDefinition>, std::shared_ptr<Trigger>>())
-        .def_property("grid", &SFCPackTuner::getGrid, &SFCPackTuner::setGridPython);
+        .def_property("grid", &SFCPackTuner::getGrid, &SFCPackTuner::setGridPython)
+        .def_property("curve", &SFCPackTuner::getCurvePython, &SFCPackTuner::setCurvePython)
+        .def_property("threshold", &SFCPackTuner::getThreshold, &SFCPackTuner::setThreshold)
+        .def_property("low_memory", &SFCPackTuner::getLowMemory, &SFCPackTuner::setLowMemory);
     }
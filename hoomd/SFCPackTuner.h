@@ -12,10 +12,12 @@
 #endif
 
 #include "GPUVector.h"
+#include "SpaceFillingCurve.h"
 #include "Tuner.h"
 
 #include <memory>
 #include <pybind11/pybind11.h>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -41,7 +43,18 @@
     Implementation details:<br>
     The rearranging is done by computing bins for the particles, and then ordering the particles
    based on the order in which those bins appear along a hilbert curve. It is very efficient, even
-   when the box size changes often as the grid dimension is kept constant.
+   when the box size changes often as the grid dimension is kept constant. setCurve() selects a
+   Morton curve or the cell list order instead.
+
+    When the threshold is set to a positive value, update() first measures the fraction of
+   particles that are out of order along the curve and skips the sort while that fraction is below
+   the threshold.
+
+    The CPU implementation reorders each array through a single temporary buffer. The GPU
+   implementation writes into the alternate particle data arrays and swaps them in, unless low
+   memory mode is enabled with setLowMemory(). Then it reorders each array in place through a
+   scratch buffer of one array's size, so that single GPU simulations need not allocate the
+   alternate arrays at all.
 
     \ingroup updaters
 */
@@ -80,12 +93,52 @@ class PYBIND11_EXPORT SFCPackTuner : public Tuner
         return m_grid;
         }
 
+    //! Set the curve to sort along
+    void setCurvePython(const std::string& curve);
+
+    //! Get the curve to sort along
+    std::string getCurvePython();
+
+    //! Set the fraction of unsorted particles below which sorts are skipped
+    void setThreshold(Scalar threshold)
+        {
+        m_threshold = threshold;
+        }
+
+    //! Get the fraction of unsorted particles below which sorts are skipped
+    Scalar getThreshold()
+        {
+        return m_threshold;
+        }
+
+    //! Set whether to reorder the particle data in place through one scratch buffer
+    void setLowMemory(bool low_memory)
+        {
+        m_low_memory = low_memory;
+        }
+
+    //! Get whether to reorder the particle data in place through one scratch buffer
+    bool getLowMemory()
+        {
+        return m_low_memory;
+        }
+
     protected:
     unsigned int m_grid;                      //!< Grid dimension to use
     unsigned int m_last_grid;                 //!< The last value of MMax
     unsigned int m_last_dim;                  //!< Check the last dimension we ran at
+    unsigned int m_curve;                     //!< Curve to sort along (a sfc_curve::Enum)
+    unsigned int m_last_curve;                //!< Curve of the current traversal order
+    Scalar m_threshold;                       //!< Skip sorts below this fraction of unsorted ptls
+    bool m_low_memory;                        //!< Reorder in place instead of via alternate arrays
     GPUArray<unsigned int> m_traversal_order; //!< Generated traversal order of bins
 
+    //! Regenerate the 3D traversal order when the grid or curve has changed
+    void updateTraversalOrder();
+
+    //! Count the local particles that are out of order along the curve
+    virtual unsigned int countUnsorted();
+
     //! Helper function that actually performs the sort
     virtual void getSortedOrder2D();
     //! Helper function that actually performs the sort
@@ -111,6 +164,9 @@ class PYBIND11_EXPORT SFCPackTuner : public Tuner
     virtual void reallocate();
 
     private:
+    //! Compute the position of each particle's bin along the curve
+    void binParticles();
+
     std::vector<unsigned int> m_sort_order; //!< Generated sort order of the particles
     std::vector<std::pair<unsigned int, unsigned int>> m_particle_bins; //!< Binned particles
     std::shared_ptr<Trigger> m_trigger;
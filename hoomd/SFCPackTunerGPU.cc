@@ -11,6 +11,7 @@
 
 #include "SFCPackTunerGPU.h"
 #include "SFCPackTunerGPU.cuh"
+#include "StepArena.h"
 
 #include <algorithm>
 #include <fstream>
@@ -74,49 +75,8 @@ void SFCPackTunerGPU::getSortedOrder3D()
 
     // reallocate memory arrays if m_grid changed
     // also regenerate the traversal order
-    if ((m_last_grid != m_grid || m_last_dim != 3) && m_sysdef->getNDimensions() == 3)
-        {
-        if (m_grid > 256)
-            {
-            unsigned int mb = m_grid * m_grid * m_grid * 4 / 1024 / 1024;
-            m_exec_conf->msg->warning()
-                << "sorter is about to allocate a very large amount of memory (" << mb << "MB)"
-                << " and may crash." << endl;
-            m_exec_conf->msg->warning() << "            Reduce the amount of memory allocated to "
-                                           "prevent this by decreasing the "
-                                        << endl;
-            m_exec_conf->msg->warning() << "            grid dimension (i.e. "
-                                           "sorter.set_params(grid=128) ) or by disabling it "
-                                        << endl;
-            m_exec_conf->msg->warning()
-                << "            ( sorter.disable() ) before beginning the run()." << endl;
-            }
-
-        // generate the traversal order
-        GPUArray<unsigned int> traversal_order(m_grid * m_grid * m_grid, m_exec_conf);
-        m_traversal_order.swap(traversal_order);
-
-        vector<unsigned int> reverse_order(m_grid * m_grid * m_grid);
-        reverse_order.clear();
-
-        // we need to start the hilbert curve with a seed order 0,1,2,3,4,5,6,7
-        unsigned int cell_order[8];
-        for (unsigned int i = 0; i < 8; i++)
-            cell_order[i] = i;
-        generateTraversalOrder(0, 0, 0, m_grid, m_grid, cell_order, reverse_order);
-
-        // access traversal order
-        ArrayHandle<unsigned int> h_traversal_order(m_traversal_order,
-                                                    access_location::host,
-                                                    access_mode::overwrite);
-
-        for (unsigned int i = 0; i < m_grid * m_grid * m_grid; i++)
-            h_traversal_order.data[reverse_order[i]] = i;
-
-        m_last_grid = m_grid;
-        // store the last system dimension computed so we can be mindful if that ever changes
-        m_last_dim = m_sysdef->getNDimensions();
-        }
+    if (m_sysdef->getNDimensions() == 3)
+        updateTraversalOrder();
 
     // sanity checks
     assert(m_gpu_particle_bins.getNumElements() >= m_pdata->getN());
@@ -142,17 +102,122 @@ void SFCPackTunerGPU::getSortedOrder3D()
                               d_gpu_sort_order.data,
                               box,
                               m_sysdef->getNDimensions() == 2,
+                              m_curve,
                               m_exec_conf->getCachedAllocator());
 
     if (m_exec_conf->isCUDAErrorCheckingEnabled())
         CHECK_CUDA_ERROR();
     }
 
+unsigned int SFCPackTunerGPU::countUnsorted()
+    {
+    if (m_sysdef->getNDimensions() == 3)
+        updateTraversalOrder();
+
+    const BoxDim& box = m_pdata->getBox();
+
+    ArrayHandle<Scalar4> d_pos(m_pdata->getPositions(), access_location::device, access_mode::read);
+    ArrayHandle<unsigned int> d_gpu_particle_bins(m_gpu_particle_bins,
+                                                  access_location::device,
+                                                  access_mode::overwrite);
+    ArrayHandle<unsigned int> d_gpu_sort_order(m_gpu_sort_order,
+                                               access_location::device,
+                                               access_mode::overwrite);
+    ArrayHandle<unsigned int> d_traversal_order(m_traversal_order,
+                                                access_location::device,
+                                                access_mode::read);
+
+    unsigned int n_unsorted = gpu_sfc_count_unsorted(m_pdata->getN(),
+                                                     d_pos.data,
+                                                     d_gpu_particle_bins.data,
+                                                     d_traversal_order.data,
+                                                     m_grid,
+                                                     d_gpu_sort_order.data,
+                                                     box,
+                                                     m_sysdef->getNDimensions() == 2,
+                                                     m_curve,
+                                                     m_exec_conf->getCachedAllocator());
+
+    if (m_exec_conf->isCUDAErrorCheckingEnabled())
+        CHECK_CUDA_ERROR();
+
+    return n_unsorted;
+    }
+
+//! Reorder the first N entries of one per-particle array in place
+/*! \param array Array to reorder
+    \param N Number of local particles
+    \param d_sorted_order Sorted order of the particles
+    \param d_scratch Scratch buffer of at least N Scalar4 elements
+    \param offset Offset of the first entry (to reorder the rows of 2D arrays)
+*/
+template<class T>
+static void reorderInPlace(const GlobalArray<T>& array,
+                           unsigned int N,
+                           const unsigned int* d_sorted_order,
+                           Scalar4* d_scratch,
+                           size_t offset = 0)
+    {
+    ArrayHandle<T> d_data(array, access_location::device, access_mode::readwrite);
+    gpu_sfc_reorder(N, d_sorted_order, d_data.data + offset, reinterpret_cast<T*>(d_scratch));
+    }
+
+void SFCPackTunerGPU::applySortOrderInPlace()
+    {
+    const unsigned int N = m_pdata->getN();
+
+    ArrayHandle<unsigned int> d_gpu_sort_order(m_gpu_sort_order,
+                                               access_location::device,
+                                               access_mode::read);
+    const unsigned int* d_order = d_gpu_sort_order.data;
+
+    // a single scratch buffer, large enough for the widest per-particle type, serves all arrays
+    ArenaAllocation<Scalar4> d_scratch(m_exec_conf->getDeviceArena(), N);
+
+    reorderInPlace(m_pdata->getPositions(), N, d_order, d_scratch.data);
+    reorderInPlace(m_pdata->getVelocities(), N, d_order, d_scratch.data);
+    reorderInPlace(m_pdata->getAccelerations(), N, d_order, d_scratch.data);
+    reorderInPlace(m_pdata->getCharges(), N, d_order, d_scratch.data);
+    reorderInPlace(m_pdata->getDiameters(), N, d_order, d_scratch.data);
+    reorderInPlace(m_pdata->getImages(), N, d_order, d_scratch.data);
+    reorderInPlace(m_pdata->getBodies(), N, d_order, d_scratch.data);
+    reorderInPlace(m_pdata->getTags(), N, d_order, d_scratch.data);
+    reorderInPlace(m_pdata->getOrientationArray(), N, d_order, d_scratch.data);
+    reorderInPlace(m_pdata->getAngularMomentumArray(), N, d_order, d_scratch.data);
+    reorderInPlace(m_pdata->getMomentsOfInertiaArray(), N, d_order, d_scratch.data);
+    reorderInPlace(m_pdata->getNetForce(), N, d_order, d_scratch.data);
+    reorderInPlace(m_pdata->getNetTorqueArray(), N, d_order, d_scratch.data);
+
+    const size_t virial_pitch = m_pdata->getNetVirial().getPitch();
+    for (unsigned int j = 0; j < 6; j++)
+        reorderInPlace(m_pdata->getNetVirial(), N, d_order, d_scratch.data, j * virial_pitch);
+
+        {
+        // rebuild the reverse tag lookup
+        ArrayHandle<unsigned int> d_tag(m_pdata->getTags(),
+                                        access_location::device,
+                                        access_mode::read);
+        ArrayHandle<unsigned int> d_rtag(m_pdata->getRTags(),
+                                         access_location::device,
+                                         access_mode::readwrite);
+        gpu_sfc_update_rtag(N, d_tag.data, d_rtag.data);
+        }
+
+    if (m_exec_conf->isCUDAErrorCheckingEnabled())
+        CHECK_CUDA_ERROR();
+    }
+
 void SFCPackTunerGPU::applySortOrder()
     {
     assert(m_pdata);
     assert(m_gpu_sort_order.getNumElements() >= m_pdata->getN());
 
+    if (m_low_memory)
+        {
+        applySortOrderInPlace();
+        return;
+        }
+
         {
         // access alternate arrays to write to
         ArrayHandle<Scalar4> d_pos_alt(m_pdata->getAltPositions(),
@@ -14,6 +14,8 @@
 #pragma GCC diagnostic ignored "-Wconversion"
 #include <thrust/device_ptr.h>
 #include <thrust/execution_policy.h>
+#include <thrust/functional.h>
+#include <thrust/inner_product.h>
 #include <thrust/sort.h>
 #pragma GCC diagnostic pop
 
@@ -27,7 +29,8 @@ __global__ void gpu_sfc_bin_particles_kernel(unsigned int N,
                                              const unsigned int* d_traversal_order,
                                              unsigned int n_grid,
                                              unsigned int* d_sorted_order,
-                                             const BoxDim box)
+                                             const BoxDim box,
+                                             const unsigned int curve)
     {
     unsigned int idx = blockDim.x * blockIdx.x + threadIdx.x;
 
@@ -60,16 +63,14 @@ __global__ void gpu_sfc_bin_particles_kernel(unsigned int N,
         kb = n_grid - 1;
 
     // record its bin
-    unsigned int bin;
     if (twod)
         {
-        // do not use Hilbert curve in 2D
-        bin = ib * n_grid + jb;
-        d_particle_bins[idx] = bin;
+        // the 2D grid can be too large for a lookup table, compute the curve position directly
+        d_particle_bins[idx] = hoomd::sfc_index_2d(ib, jb, n_grid, curve);
         }
     else
         {
-        bin = ib * (n_grid * n_grid) + jb * n_grid + kb;
+        unsigned int bin = ib * (n_grid * n_grid) + jb * n_grid + kb;
         d_particle_bins[idx] = d_traversal_order[bin];
         }
 
@@ -77,24 +78,26 @@ __global__ void gpu_sfc_bin_particles_kernel(unsigned int N,
     d_sorted_order[idx] = idx;
     }
 
+//! Bin the particles along the curve
 /*! \param N number of local particles
     \param d_pos Device array of positions
     \param d_particle_bins Device array of particle bins
-    \param d_traversal_order Device array of Hilbert-curve bins
+    \param d_traversal_order Device array of 3D curve positions of the bins
     \param n_grid Number of grid elements along one edge
     \param d_sorted_order Sorted order of particles
     \param box Box dimensions
     \param twod If true, bin particles in two dimensions
+    \param curve Curve to sort along (a hoomd::sfc_curve::Enum)
     */
-void gpu_generate_sorted_order(unsigned int N,
-                               const Scalar4* d_pos,
-                               unsigned int* d_particle_bins,
-                               unsigned int* d_traversal_order,
-                               unsigned int n_grid,
-                               unsigned int* d_sorted_order,
-                               const BoxDim& box,
-                               bool twod,
-                               CachedAllocator& alloc)
+static void gpu_sfc_bin_particles(unsigned int N,
+                                  const Scalar4* d_pos,
+                                  unsigned int* d_particle_bins,
+                                  unsigned int* d_traversal_order,
+                                  unsigned int n_grid,
+                                  unsigned int* d_sorted_order,
+                                  const BoxDim& box,
+                                  bool twod,
+                                  unsigned int curve)
     {
     // maybe need to autotune, but SFCPackTuner is called infrequently
     unsigned int block_size = 256;
@@ -112,7 +115,8 @@ void gpu_generate_sorted_order(unsigned int N,
                            d_traversal_order,
                            n_grid,
                            d_sorted_order,
-                           box);
+                           box,
+                           curve);
     else
         hipLaunchKernelGGL(HIP_KERNEL_NAME(gpu_sfc_bin_particles_kernel<false>),
                            dim3(n_blocks),
@@ -125,7 +129,40 @@ void gpu_generate_sorted_order(unsigned int N,
                            d_traversal_order,
                            n_grid,
                            d_sorted_order,
-                           box);
+                           box,
+                           curve);
+    }
+
+/*! \param N number of local particles
+    \param d_pos Device array of positions
+    \param d_particle_bins Device array of particle bins
+    \param d_traversal_order Device array of 3D curve positions of the bins
+    \param n_grid Number of grid elements along one edge
+    \param d_sorted_order Sorted order of particles
+    \param box Box dimensions
+    \param twod If true, bin particles in two dimensions
+    \param curve Curve to sort along (a hoomd::sfc_curve::Enum)
+    */
+void gpu_generate_sorted_order(unsigned int N,
+                               const Scalar4* d_pos,
+                               unsigned int* d_particle_bins,
+                               unsigned int* d_traversal_order,
+                               unsigned int n_grid,
+                               unsigned int* d_sorted_order,
+                               const BoxDim& box,
+                               bool twod,
+                               unsigned int curve,
+                               CachedAllocator& alloc)
+    {
+    gpu_sfc_bin_particles(N,
+                          d_pos,
+                          d_particle_bins,
+                          d_traversal_order,
+                          n_grid,
+                          d_sorted_order,
+                          box,
+                          twod,
+                          curve);
 
     // Sort particles
     if (N)
@@ -143,6 +180,55 @@ void gpu_generate_sorted_order(unsigned int N,
         }
     }
 
+/*! \param N number of local particles
+    \param d_pos Device array of positions
+    \param d_particle_bins Device array of particle bins
+    \param d_traversal_order Device array of 3D curve positions of the bins
+    \param n_grid Number of grid elements along one edge
+    \param d_sorted_order Scratch array of N elements
+    \param box Box dimensions
+    \param twod If true, bin particles in two dimensions
+    \param curve Curve to sort along (a hoomd::sfc_curve::Enum)
+    \returns The number of particles whose bin comes before that of the previous particle
+    */
+unsigned int gpu_sfc_count_unsorted(unsigned int N,
+                                    const Scalar4* d_pos,
+                                    unsigned int* d_particle_bins,
+                                    unsigned int* d_traversal_order,
+                                    unsigned int n_grid,
+                                    unsigned int* d_sorted_order,
+                                    const BoxDim& box,
+                                    bool twod,
+                                    unsigned int curve,
+                                    CachedAllocator& alloc)
+    {
+    if (N < 2)
+        return 0;
+
+    gpu_sfc_bin_particles(N,
+                          d_pos,
+                          d_particle_bins,
+                          d_traversal_order,
+                          n_grid,
+                          d_sorted_order,
+                          box,
+                          twod,
+                          curve);
+
+    thrust::device_ptr<unsigned int> particle_bins(d_particle_bins);
+#ifdef __HIP_PLATFORM_HCC__
+    return thrust::inner_product(thrust::hip::par(alloc),
+#else
+    return thrust::inner_product(thrust::cuda::par(alloc),
+#endif
+                                 particle_bins,
+                                 particle_bins + N - 1,
+                                 particle_bins + 1,
+                                 0u,
+                                 thrust::plus<unsigned int>(),
+                                 thrust::greater<unsigned int>());
+    }
+
 //! Kernel to apply sorted order
 __global__ void gpu_apply_sorted_order_kernel(unsigned int N,
                                               unsigned int n_ghost,
@@ -291,3 +377,103 @@ void gpu_apply_sorted_order(unsigned int N,
                        d_net_torque_alt,
                        d_rtag);
     }
+
+//! Kernel to gather one per-particle array in the sorted order
+template<class T>
+__global__ void gpu_sfc_gather_kernel(unsigned int N,
+                                      const unsigned int* d_sorted_order,
+                                      const T* d_in,
+                                      T* d_out)
+    {
+    unsigned int idx = blockIdx.x * blockDim.x + threadIdx.x;
+
+    if (idx >= N)
+        return;
+
+    d_out[idx] = d_in[d_sorted_order[idx]];
+    }
+
+/*! \param N Number of local particles
+    \param d_sorted_order Sorted order of the particles
+    \param d_data Array to reorder
+    \param d_scratch Scratch buffer of at least N elements
+
+    The entries are gathered into the scratch buffer and copied back, so the scratch memory is
+    bounded by the size of a single array.
+*/
+template<class T>
+void gpu_sfc_reorder(unsigned int N, const unsigned int* d_sorted_order, T* d_data, T* d_scratch)
+    {
+    if (N == 0)
+        return;
+
+    unsigned int block_size = 256;
+    unsigned int n_blocks = N / block_size + 1;
+
+    hipLaunchKernelGGL(HIP_KERNEL_NAME(gpu_sfc_gather_kernel<T>),
+                       dim3(n_blocks),
+                       dim3(block_size),
+                       0,
+                       0,
+                       N,
+                       d_sorted_order,
+                       d_data,
+                       d_scratch);
+
+    hipMemcpy(d_data, d_scratch, sizeof(T) * N, hipMemcpyDeviceToDevice);
+    }
+
+//! Kernel to rebuild the reverse tag lookup
+__global__ void
+gpu_sfc_update_rtag_kernel(unsigned int N, const unsigned int* d_tag, unsigned int* d_rtag)
+    {
+    unsigned int idx = blockIdx.x * blockDim.x + threadIdx.x;
+
+    if (idx >= N)
+        return;
+
+    d_rtag[d_tag[idx]] = idx;
+    }
+
+/*! \param N Number of local particles
+    \param d_tag Particle tags in the new order
+    \param d_rtag Reverse tag lookup to update
+*/
+void gpu_sfc_update_rtag(unsigned int N, const unsigned int* d_tag, unsigned int* d_rtag)
+    {
+    if (N == 0)
+        return;
+
+    unsigned int block_size = 256;
+    unsigned int n_blocks = N / block_size + 1;
+
+    hipLaunchKernelGGL(gpu_sfc_update_rtag_kernel,
+                       dim3(n_blocks),
+                       dim3(block_size),
+                       0,
+                       0,
+                       N,
+                       d_tag,
+                       d_rtag);
+    }
+
+template void gpu_sfc_reorder<Scalar4>(unsigned int N,
+                                       const unsigned int* d_sorted_order,
+                                       Scalar4* d_data,
+                                       Scalar4* d_scratch);
+template void gpu_sfc_reorder<Scalar3>(unsigned int N,
+                                       const unsigned int* d_sorted_order,
+                                       Scalar3* d_data,
+                                       Scalar3* d_scratch);
+template void gpu_sfc_reorder<Scalar>(unsigned int N,
+                                      const unsigned int* d_sorted_order,
+                                      Scalar* d_data,
+                                      Scalar* d_scratch);
+template void gpu_sfc_reorder<int3>(unsigned int N,
+                                    const unsigned int* d_sorted_order,
+                                    int3* d_data,
+                                    int3* d_scratch);
+template void gpu_sfc_reorder<unsigned int>(unsigned int N,
+                                            const unsigned int* d_sorted_order,
+                                            unsigned int* d_data,
+                                            unsigned int* d_scratch);
@@ -9,6 +9,7 @@
 #include "BoxDim.h"
 #include "CachedAllocator.h"
 #include "HOOMDMath.h"
+#include "SpaceFillingCurve.h"
 
 /*! \file SFCPackTunerGPU.cuh
     \brief Defines GPU functions for generating the space-filling curve sorted order on the GPU.
@@ -24,8 +25,21 @@ void gpu_generate_sorted_order(unsigned int N,
                                unsigned int* d_sorted_order,
                                const BoxDim& box,
                                bool twod,
+                               unsigned int curve,
                                CachedAllocator& alloc);
 
+//! Count the particles that are out of order along the curve on the GPU
+unsigned int gpu_sfc_count_unsorted(unsigned int N,
+                                    const Scalar4* d_pos,
+                                    unsigned int* d_particle_bins,
+                                    unsigned int* d_traversal_order,
+                                    unsigned int n_grid,
+                                    unsigned int* d_sorted_order,
+                                    const BoxDim& box,
+                                    bool twod,
+                                    unsigned int curve,
+                                    CachedAllocator& alloc);
+
 //! Reorder particle data (GPU driver function)
 void gpu_apply_sorted_order(unsigned int N,
                             unsigned int n_ghost,
@@ -61,4 +75,11 @@ void gpu_apply_sorted_order(unsigned int N,
                             Scalar4* d_net_torque_alt,
                             unsigned int* d_rtag);
 
+//! Reorder one array in place through a scratch buffer (GPU driver function)
+template<class T>
+void gpu_sfc_reorder(unsigned int N, const unsigned int* d_sorted_order, T* d_data, T* d_scratch);
+
+//! Rebuild the reverse tag lookup after a reorder (GPU driver function)
+void gpu_sfc_update_rtag(unsigned int N, const unsigned int* d_tag, unsigned int* d_rtag);
+
 #endif // __SFC_PACK_UPDATER_GPU_CUH__
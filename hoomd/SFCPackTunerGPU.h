@@ -57,6 +57,12 @@ class PYBIND11_EXPORT SFCPackTunerGPU : public SFCPackTuner
 
     //! Apply the sorted order to the particle data
     virtual void applySortOrder();
+
+    //! Apply the sorted order to the particle data without the alternate arrays
+    void applySortOrderInPlace();
+
+    //! Count the local particles that are out of order along the curve
+    virtual unsigned int countUnsorted();
     };
 
 //! Export the SFCPackTunerGPU class to python
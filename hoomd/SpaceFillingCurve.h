@@ -0,0 +1,121 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#ifndef __SPACE_FILLING_CURVE_H__
+#define __SPACE_FILLING_CURVE_H__
+
+#include "hoomd/HOOMDMath.h"
+
+/*! \file SpaceFillingCurve.h
+    \brief Positions of grid points along the curves that SFCPackTuner sorts particles on
+*/
+
+// need to declare these class methods with __device__ qualifiers when building in nvcc
+// HOSTDEVICE is __host__ __device__ when included in nvcc and blank when included into the host
+// compiler
+#ifdef __HIPCC__
+#define HOSTDEVICE __host__ __device__
+#else
+#define HOSTDEVICE
+#endif
+
+namespace hoomd
+    {
+//! Curves that the particles can be sorted along
+struct sfc_curve
+    {
+    enum Enum
+        {
+        hilbert = 0, //!< Hilbert curve
+        morton,      //!< Morton (Z order) curve
+        cell         //!< Cells in the order of the CellList index, x fastest
+        };
+    };
+
+//! Position of a 2D grid point along the Hilbert curve
+/*! \param i x index of the grid point
+    \param j y index of the grid point
+    \param n Width of the grid, a power of 2
+*/
+HOSTDEVICE inline unsigned int hilbert_index(unsigned int i, unsigned int j, unsigned int n)
+    {
+    unsigned int d = 0;
+    for (unsigned int s = n / 2; s > 0; s /= 2)
+        {
+        unsigned int ri = (i & s) > 0;
+        unsigned int rj = (j & s) > 0;
+        d += s * s * ((3 * ri) ^ rj);
+
+        // rotate the quadrant so that the curve continues in the sub grid
+        if (rj == 0)
+            {
+            if (ri == 1)
+                {
+                i = n - 1 - i;
+                j = n - 1 - j;
+                }
+            unsigned int t = i;
+            i = j;
+            j = t;
+            }
+        }
+    return d;
+    }
+
+//! Position of a 2D grid point along the Morton curve
+/*! \param i x index of the grid point
+    \param j y index of the grid point
+    \param n Width of the grid, a power of 2
+*/
+HOSTDEVICE inline unsigned int morton_index(unsigned int i, unsigned int j, unsigned int n)
+    {
+    unsigned int d = 0;
+    for (unsigned int b = 0; (1u << b) < n; b++)
+        {
+        d |= ((i >> b) & 1) << (2 * b + 1);
+        d |= ((j >> b) & 1) << (2 * b);
+        }
+    return d;
+    }
+
+//! Position of a 3D grid point along the Morton curve
+/*! \param i x index of the grid point
+    \param j y index of the grid point
+    \param k z index of the grid point
+    \param n Width of the grid, a power of 2
+*/
+HOSTDEVICE inline unsigned int
+morton_index(unsigned int i, unsigned int j, unsigned int k, unsigned int n)
+    {
+    unsigned int d = 0;
+    for (unsigned int b = 0; (1u << b) < n; b++)
+        {
+        d |= ((i >> b) & 1) << (3 * b + 2);
+        d |= ((j >> b) & 1) << (3 * b + 1);
+        d |= ((k >> b) & 1) << (3 * b);
+        }
+    return d;
+    }
+
+//! Position of a 2D grid point along a curve
+/*! \param i x index of the grid point
+    \param j y index of the grid point
+    \param n Width of the grid, a power of 2
+    \param curve Curve to follow (one of sfc_curve::Enum)
+*/
+HOSTDEVICE inline unsigned int
+sfc_index_2d(unsigned int i, unsigned int j, unsigned int n, unsigned int curve)
+    {
+    if (curve == sfc_curve::hilbert)
+        return hilbert_index(i, j, n);
+    else if (curve == sfc_curve::morton)
+        return morton_index(i, j, n);
+    else
+        return j * n + i;
+    }
+
+    } // end namespace hoomd
+
+#undef HOSTDEVICE
+
+#endif // __SPACE_FILLING_CURVE_H__
@@ -0,0 +1,157 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "StepArena.h"
+
+#ifdef ENABLE_HIP
+#include <hip/hip_runtime.h>
+#endif
+
+#include <algorithm>
+#include <cassert>
+#include <new>
+#include <stdexcept>
+#include <stdlib.h>
+#include <string>
+
+/*! \file StepArena.cc
+    \brief Defines StepArena
+*/
+
+//! Alignment of every allocation in bytes
+static const size_t arena_alignment = 256;
+
+//! Round up to a multiple of arena_alignment
+static size_t alignArena(size_t num_bytes)
+    {
+    return (num_bytes + arena_alignment - 1) / arena_alignment * arena_alignment;
+    }
+
+StepArena::StepArena(bool device)
+    : m_device(device), m_data(nullptr), m_capacity(0), m_offset(0), m_peak(0),
+      m_overflow_size(0), m_depth(0)
+    {
+#ifndef ENABLE_HIP
+    if (m_device)
+        throw std::runtime_error("StepArena: device memory requires a GPU build");
+#endif
+    }
+
+StepArena::~StepArena()
+    {
+    for (char* data : m_overflow)
+        freeBlock(data);
+    freeBlock(m_data);
+    }
+
+/*! \param num_bytes Number of bytes to allocate
+    \returns A pointer to the buffer, aligned to 256 bytes
+*/
+char* StepArena::acquire(size_t num_bytes)
+    {
+    m_depth++;
+    if (num_bytes == 0)
+        return nullptr;
+
+    size_t begin = alignArena(m_offset);
+    size_t end = begin + num_bytes;
+    if (end <= m_capacity)
+        {
+        m_offset = end;
+        m_peak = std::max(m_peak, m_offset + m_overflow_size);
+        return m_data + begin;
+        }
+
+    // the block is full, use a separate block until the next reset
+    char* data = allocateBlock(num_bytes);
+    m_overflow.push_back(data);
+    m_overflow_size += alignArena(num_bytes);
+    m_peak = std::max(m_peak, alignArena(m_offset) + m_overflow_size);
+    return data;
+    }
+
+/*! \param begin Offset of the arena before the allocation
+    \param end Offset of the arena after the allocation
+
+    Returns the memory when it is the last allocation in the block. Releasing the outermost
+    allocation resets the arena, which frees the overflow blocks.
+*/
+void StepArena::release(size_t begin, size_t end)
+    {
+    if (m_offset == end)
+        m_offset = begin;
+
+    assert(m_depth > 0);
+    m_depth--;
+    if (m_depth == 0)
+        reset();
+    }
+
+/*! Frees the overflow blocks and replaces the block with one that holds the peak usage since the
+    last reset, with some headroom. The block never shrinks. Does nothing while allocations are
+    outstanding.
+*/
+void StepArena::reset()
+    {
+    if (m_depth > 0)
+        return;
+
+    if (!m_overflow.empty())
+        {
+        for (char* data : m_overflow)
+            freeBlock(data);
+        m_overflow.clear();
+        m_overflow_size = 0;
+
+        size_t capacity = alignArena(m_peak + m_peak / 4);
+        freeBlock(m_data);
+        m_data = nullptr;
+        m_capacity = 0;
+        m_data = allocateBlock(capacity);
+        m_capacity = capacity;
+        }
+
+    m_offset = 0;
+    m_peak = 0;
+    }
+
+/*! \param num_bytes Number of bytes to allocate
+    \returns The block
+*/
+char* StepArena::allocateBlock(size_t num_bytes)
+    {
+    char* data = nullptr;
+#ifdef ENABLE_HIP
+    if (m_device)
+        {
+        hipError_t error = hipMalloc((void**)&data, num_bytes);
+        if (error != hipSuccess)
+            {
+            throw std::runtime_error("StepArena: " + std::string(hipGetErrorString(error)));
+            }
+        return data;
+        }
+#endif
+
+    if (posix_memalign((void**)&data, arena_alignment, num_bytes) != 0)
+        throw std::bad_alloc();
+    return data;
+    }
+
+/*! \param data Block to free
+ */
+void StepArena::freeBlock(char* data)
+    {
+    if (!data)
+        return;
+
+#ifdef ENABLE_HIP
+    if (m_device)
+        {
+        hipFree(data);
+        return;
+        }
+#endif
+
+    free(data);
+    }
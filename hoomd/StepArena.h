@@ -0,0 +1,135 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+/*! \file StepArena.h
+    \brief Declares StepArena and ArenaAllocation
+*/
+
+template<typename T> class ArenaAllocation;
+
+//! Bump allocator for temporaries that live no longer than one time step
+/*! StepArena hands out memory through ArenaAllocation by advancing an offset into a single block.
+    ArenaAllocation returns its memory when it goes out of scope, so temporaries of consecutive
+    computes reuse the same memory.
+
+    When the block is full, an allocation falls back on a separate block for the request. When the
+    outermost ArenaAllocation is released, the arena frees these overflow blocks and grows the main
+    block to the peak usage since the last reset. After the first steps of a run, every allocation
+    is a pointer bump in one block and temporaries no longer fragment the device memory. Overflow
+    blocks never outlive the outermost allocation, also when the arena is used outside of a run.
+    System::run() additionally calls reset() at the start of every time step.
+
+    A device arena allocates device memory on the current device. Kernels that use arena memory
+    must be launched on the default stream, which orders them before the kernels of later
+    allocations that reuse the memory.
+
+    StepArena is not thread safe.
+*/
+class __attribute__((visibility("default"))) StepArena
+    {
+    public:
+    //! Constructor
+    /*! \param device True to allocate device memory, false to allocate host memory
+     */
+    StepArena(bool device);
+
+    StepArena(const StepArena&) = delete;
+    StepArena& operator=(const StepArena&) = delete;
+
+    //! Destructor
+    ~StepArena();
+
+    //! Get the current offset into the block
+    size_t getOffset() const
+        {
+        return m_offset;
+        }
+
+    //! Make the whole arena available
+    void reset();
+
+    //! Get the number of bytes in the block
+    size_t getCapacity() const
+        {
+        return m_capacity;
+        }
+
+    //! Get the number of bytes held by the arena, including overflow blocks
+    size_t getAllocatedBytes() const
+        {
+        return m_capacity + m_overflow_size;
+        }
+
+    //! Get the number of allocations that have not been released
+    unsigned int getNumAllocations() const
+        {
+        return m_depth;
+        }
+
+    private:
+    bool m_device;          //!< True if the arena holds device memory
+    char* m_data;           //!< The block
+    size_t m_capacity;      //!< Number of bytes in the block
+    size_t m_offset;        //!< First unused byte in the block
+    size_t m_peak;          //!< Largest number of bytes in use since the last reset()
+    size_t m_overflow_size; //!< Number of bytes in overflow blocks
+    unsigned int m_depth;   //!< Number of allocations that have not been released
+
+    std::vector<char*> m_overflow; //!< Blocks allocated when the block was full
+
+    //! Allocate a temporary buffer of bytes
+    char* acquire(size_t num_bytes);
+
+    //! Release an allocation, resetting the arena when it is the outermost one
+    void release(size_t begin, size_t end);
+
+    //! Allocate a block of memory
+    char* allocateBlock(size_t num_bytes);
+
+    //! Free a block of memory
+    void freeBlock(char* data);
+
+    template<typename T> friend class ArenaAllocation;
+    };
+
+//! A temporary allocation from a StepArena
+/*! When it goes out of scope, the memory is returned to the arena. Allocations must be released in
+    the reverse order of their construction, as automatic variables are.
+ */
+template<typename T> class ArenaAllocation
+    {
+    public:
+    //! Constructor
+    ArenaAllocation(StepArena& arena, size_t num_elements)
+        : m_arena(arena), m_begin(arena.getOffset())
+        {
+        data = (T*)m_arena.acquire(sizeof(T) * num_elements);
+        m_end = m_arena.getOffset();
+        }
+
+    ArenaAllocation(const ArenaAllocation&) = delete;
+    ArenaAllocation& operator=(const ArenaAllocation&) = delete;
+
+    //! Destructor
+    ~ArenaAllocation()
+        {
+        m_arena.release(m_begin, m_end);
+        }
+
+    T* operator()()
+        {
+        return data;
+        }
+
+    T* data;
+
+    private:
+    StepArena& m_arena; //!< The arena that holds the memory
+    size_t m_begin;     //!< Offset of the arena before the allocation
+    size_t m_end;       //!< Offset of the arena after the allocation
+    };
@@ -88,6 +88,11 @@ void System::run(uint64_t nsteps, bool write_at_start)
     m_start_tstep = m_cur_tstep;
     m_end_tstep = m_cur_tstep + nsteps;
 
+    // operations and triggers may have changed since the last run
+    m_analyzer_schedule.clear();
+    m_updater_schedule.clear();
+    m_tuner_schedule.clear();
+
     // initialize the last status time
     m_initial_time = m_clk.getTime();
     setupProfiling();
@@ -119,27 +124,42 @@ void System::run(uint64_t nsteps, bool write_at_start)
     // execute analyzers on initial step if requested
     if (write_at_start)
         {
-        for (auto& analyzer_trigger_pair : m_analyzers)
+        for (size_t i = 0; i < m_analyzers.size(); i++)
             {
-            if ((*analyzer_trigger_pair.second)(m_cur_tstep))
-                analyzer_trigger_pair.first->analyze(m_cur_tstep);
+            if (isTriggered(m_analyzer_schedule, i, m_analyzers[i].second, m_cur_tstep))
+                {
+                ScopedToolRange range(m_analyzers[i].first->getProfileName());
+                ScopedOperationTimer timer(m_analyzers[i].first->getTimer());
+                m_analyzers[i].first->analyze(m_cur_tstep);
+                }
             }
         }
 
     // run the steps
     for (uint64_t count = 0; count < nsteps; count++)
         {
-        for (auto& tuner : m_tuners)
+        // temporaries from the previous step are no longer in use
+        m_exec_conf->resetArenas();
+
+        for (size_t i = 0; i < m_tuners.size(); i++)
             {
-            if ((*tuner->getTrigger())(m_cur_tstep))
-                tuner->update(m_cur_tstep);
+            if (isTriggered(m_tuner_schedule, i, m_tuners[i]->getTrigger(), m_cur_tstep))
+                {
+                ScopedToolRange range(m_tuners[i]->getProfileName());
+                ScopedOperationTimer timer(m_tuners[i]->getTimer());
+                m_tuners[i]->update(m_cur_tstep);
+                }
             }
 
         // execute updaters
-        for (auto& updater_trigger_pair : m_updaters)
+        for (size_t i = 0; i < m_updaters.size(); i++)
             {
-            if ((*updater_trigger_pair.second)(m_cur_tstep))
-                updater_trigger_pair.first->update(m_cur_tstep);
+            if (isTriggered(m_updater_schedule, i, m_updaters[i].second, m_cur_tstep))
+                {
+                ScopedToolRange range(m_updaters[i].first->getProfileName());
+                ScopedOperationTimer timer(m_updaters[i].first->getTimer());
+                m_updaters[i].first->update(m_cur_tstep);
+                }
             }
 
         // look ahead to the next time step and see which analyzers and updaters will be executed
@@ -149,15 +169,23 @@ void System::run(uint64_t nsteps, bool write_at_start)
 
         // execute the integrator
         if (m_integrator)
+            {
+            ScopedToolRange range(m_integrator->getProfileName());
+            ScopedOperationTimer timer(m_integrator->getTimer());
             m_integrator->update(m_cur_tstep);
+            }
 
         m_cur_tstep++;
 
         // execute analyzers after incrementing the step counter
-        for (auto& analyzer_trigger_pair : m_analyzers)
+        for (size_t i = 0; i < m_analyzers.size(); i++)
             {
-            if ((*analyzer_trigger_pair.second)(m_cur_tstep))
-                analyzer_trigger_pair.first->analyze(m_cur_tstep);
+            if (isTriggered(m_analyzer_schedule, i, m_analyzers[i].second, m_cur_tstep))
+                {
+                ScopedToolRange range(m_analyzers[i].first->getProfileName());
+                ScopedOperationTimer timer(m_analyzers[i].first->getTimer());
+                m_analyzers[i].first->analyze(m_cur_tstep);
+                }
             }
 
         updateTPS();
@@ -169,6 +197,13 @@ void System::run(uint64_t nsteps, bool write_at_start)
             }
         }
 
+    // complete buffered output before returning control to the caller
+    for (auto& analyzer_trigger_pair : m_analyzers)
+        analyzer_trigger_pair.first->flush();
+
+    if (m_profiler)
+        m_profiler->stop();
+
 #ifdef ENABLE_MPI
     // make sure all ranks return the same TPS after the run completes
     if (m_comm)
@@ -226,7 +261,10 @@ void System::setAutotunerParams(bool enabled, unsigned int period)
 void System::setupProfiling()
     {
     if (m_profile)
+        {
         m_profiler = std::shared_ptr<Profiler>(new Profiler("Simulation"));
+        m_profiler->setMaxTraceEvents(1 << 20);
+        }
     else
         m_profiler = std::shared_ptr<Profiler>();
 
@@ -280,6 +318,18 @@ void System::resetStats()
     // computes
     for (auto compute : m_computes)
         compute->resetStats();
+
+    // operation timers measure one run at a time
+    if (m_integrator)
+        m_integrator->resetTimers();
+    for (auto& analyzer_trigger_pair : m_analyzers)
+        analyzer_trigger_pair.first->resetTimers();
+    for (auto& updater_trigger_pair : m_updaters)
+        updater_trigger_pair.first->resetTimers();
+    for (auto& tuner : m_tuners)
+        tuner->resetTimers();
+    for (auto compute : m_computes)
+        compute->resetTimers();
     }
 
 /*! \param tstep Time step for which to determine the flags
@@ -293,27 +343,48 @@ PDataFlags System::determineFlags(uint64_t tstep)
     if (m_integrator)
         flags |= m_integrator->getRequestedPDataFlags();
 
-    for (auto& analyzer_trigger_pair : m_analyzers)
+    for (size_t i = 0; i < m_analyzers.size(); i++)
         {
-        if ((*analyzer_trigger_pair.second)(tstep))
-            flags |= analyzer_trigger_pair.first->getRequestedPDataFlags();
+        if (isTriggered(m_analyzer_schedule, i, m_analyzers[i].second, tstep))
+            flags |= m_analyzers[i].first->getRequestedPDataFlags();
         }
 
-    for (auto& updater_trigger_pair : m_updaters)
+    for (size_t i = 0; i < m_updaters.size(); i++)
         {
-        if ((*updater_trigger_pair.second)(tstep))
-            flags |= updater_trigger_pair.first->getRequestedPDataFlags();
+        if (isTriggered(m_updater_schedule, i, m_updaters[i].second, tstep))
+            flags |= m_updaters[i].first->getRequestedPDataFlags();
         }
 
-    for (auto& tuner : m_tuners)
+    for (size_t i = 0; i < m_tuners.size(); i++)
         {
-        if ((*tuner->getTrigger())(tstep))
-            flags |= tuner->getRequestedPDataFlags();
+        if (isTriggered(m_tuner_schedule, i, m_tuners[i]->getTrigger(), tstep))
+            flags |= m_tuners[i]->getRequestedPDataFlags();
         }
 
     return flags;
     }
 
+/*! \param schedule Cached schedules of the triggers in the list
+    \param i Index of the operation in the list
+    \param trigger Trigger of the operation
+    \param tstep Time step to query
+
+    Periodic and other predictable triggers are only evaluated once they are due to activate.
+*/
+bool System::isTriggered(std::vector<ScheduledTrigger>& schedule,
+                         size_t i,
+                         const std::shared_ptr<Trigger>& trigger,
+                         uint64_t tstep)
+    {
+    // Python code may add, remove, or replace operations during a run
+    if (i >= schedule.size())
+        schedule.resize(i + 1);
+    if (schedule[i].getTrigger() != trigger)
+        schedule[i] = ScheduledTrigger(trigger);
+
+    return schedule[i](tstep);
+    }
+
 void export_System(py::module& m)
     {
     py::bind_vector<std::vector<std::pair<std::shared_ptr<Analyzer>, std::shared_ptr<Trigger>>>>(
@@ -333,6 +404,7 @@ void export_System(py::module& m)
 
         .def("setAutotunerParams", &System::setAutotunerParams)
         .def("enableProfiler", &System::enableProfiler)
+        .def("getProfiler", &System::getProfiler)
         .def("run", &System::run)
 
         .def("getLastTPS", &System::getLastTPS)
@@ -341,6 +413,7 @@ void export_System(py::module& m)
         .def("getPressureFlag", &System::getPressureFlag)
         .def_property_readonly("walltime", &System::getCurrentWalltime)
         .def_property_readonly("final_timestep", &System::getEndStep)
+        .def_property_readonly("start_timestep", &System::getStartStep)
         .def_property_readonly("analyzers", &System::getAnalyzers)
         .def_property_readonly("updaters", &System::getUpdaters)
         .def_property_readonly("tuners", &System::getTuners)
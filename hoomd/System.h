@@ -102,6 +102,12 @@ class PYBIND11_EXPORT System
     //! Configures profiling of runs
     void enableProfiler(bool enable);
 
+    /// Get the profile of the last run (null when profiling is disabled)
+    std::shared_ptr<Profiler> getProfiler()
+        {
+        return m_profiler;
+        }
+
     //! Get the average TPS from the last run
     Scalar getLastTPS() const
         {
@@ -126,6 +132,12 @@ class PYBIND11_EXPORT System
         return m_end_tstep;
         }
 
+    /// Get the first time step of the current run
+    uint64_t getStartStep()
+        {
+        return m_start_tstep;
+        }
+
     // -------------- Misc methods
 
     //! Get the system definition
@@ -210,6 +222,17 @@ class PYBIND11_EXPORT System
     //! Get the flags needed for a particular step
     PDataFlags determineFlags(uint64_t tstep);
 
+    /// Cached schedules of the analyzer, updater, and tuner triggers in the current run
+    std::vector<ScheduledTrigger> m_analyzer_schedule;
+    std::vector<ScheduledTrigger> m_updater_schedule;
+    std::vector<ScheduledTrigger> m_tuner_schedule;
+
+    /// Evaluate the trigger of the i'th operation in a list through its cached schedule
+    bool isTriggered(std::vector<ScheduledTrigger>& schedule,
+                     size_t i,
+                     const std::shared_ptr<Trigger>& trigger,
+                     uint64_t tstep);
+
     /// Record the initial time of the last run
     int64_t m_initial_time = 0;
 
@@ -9,8 +9,15 @@
 
 #include "SystemDefinition.h"
 
+#include "CellList.h"
 #include "SnapshotSystemData.h"
 
+#ifdef ENABLE_HIP
+#include "CellListGPU.h"
+#endif
+
+#include <algorithm>
+
 #ifdef ENABLE_MPI
 #include "Communicator.h"
 #endif
@@ -168,6 +175,178 @@ void SystemDefinition::initializeFromSnapshot(std::shared_ptr<SnapshotSystemData
     m_pair_data->initializeFromSnapshot(snapshot->pair_data);
     }
 
+/*! \param snapshot Snapshot taken with takeSnapshot() from this system, with no changes to the
+    system since
+
+    Apply only the particle arrays and bonded groups that were modified in the snapshot, see
+    ParticleData::updateFromSnapshot(). Fall back to initializeFromSnapshot() when the box or the
+    dimensionality change or the particles cannot be updated in place.
+*/
+template<class Real>
+void SystemDefinition::updateFromSnapshot(std::shared_ptr<SnapshotSystemData<Real>> snapshot)
+    {
+    std::shared_ptr<const ExecutionConfiguration> exec_conf = m_particle_data->getExecConf();
+
+    bool same_box = snapshot->dimensions == m_n_dimensions
+                    && snapshot->global_box == m_particle_data->getGlobalBox();
+    bool groups_modified[6] = {snapshot->bond_data.modified,
+                               snapshot->angle_data.modified,
+                               snapshot->dihedral_data.modified,
+                               snapshot->improper_data.modified,
+                               snapshot->constraint_data.modified,
+                               snapshot->pair_data.modified};
+#ifdef ENABLE_MPI
+    if (m_particle_data->getDomainDecomposition())
+        {
+        bcast(same_box, 0, exec_conf->getMPICommunicator());
+        for (unsigned int i = 0; i < 6; i++)
+            bcast(groups_modified[i], 0, exec_conf->getMPICommunicator());
+        }
+#endif
+
+    if (!same_box || !m_particle_data->updateFromSnapshot(snapshot->particle_data))
+        {
+        initializeFromSnapshot(snapshot);
+        return;
+        }
+
+    if (groups_modified[0])
+        m_bond_data->initializeFromSnapshot(snapshot->bond_data);
+    if (groups_modified[1])
+        m_angle_data->initializeFromSnapshot(snapshot->angle_data);
+    if (groups_modified[2])
+        m_dihedral_data->initializeFromSnapshot(snapshot->dihedral_data);
+    if (groups_modified[3])
+        m_improper_data->initializeFromSnapshot(snapshot->improper_data);
+    if (groups_modified[4])
+        m_constraint_data->initializeFromSnapshot(snapshot->constraint_data);
+    if (groups_modified[5])
+        m_pair_data->initializeFromSnapshot(snapshot->pair_data);
+    }
+
+/*! \param request Configuration that the consumer needs
+    \returns A cell list that satisfies \a request
+
+    Returns a cell list that another consumer holds when one is compatible with \a request (see
+    CellList::isCompatible()), and adds the optional data of \a request to it. Otherwise, creates a
+    new cell list. Consumers call compute() on the shared cell list as usual, it is built at most
+    once per time step. A consumer whose requirements change (for example, the cell width) requests
+    a new cell list instead of modifying the shared one.
+
+    SystemDefinition keeps weak references, a cell list is destroyed with its last consumer.
+*/
+std::shared_ptr<CellList> SystemDefinition::getCellList(const CellListRequest& request)
+    {
+    m_cell_lists.erase(std::remove_if(m_cell_lists.begin(),
+                                      m_cell_lists.end(),
+                                      [](const std::weak_ptr<CellList>& cl)
+                                      { return cl.expired(); }),
+                       m_cell_lists.end());
+
+    // prefer the cell list with the most consumers, then the one with the narrowest cells
+    std::shared_ptr<CellList> cl;
+    for (const auto& weak_cl : m_cell_lists)
+        {
+        std::shared_ptr<CellList> candidate = weak_cl.lock();
+        if (!candidate->isCompatible(request))
+            continue;
+
+        if (!cl || candidate.use_count() > cl.use_count()
+            || (candidate.use_count() == cl.use_count()
+                && candidate->getNominalWidth() < cl->getNominalWidth()))
+            {
+            cl = candidate;
+            }
+        }
+
+    if (cl)
+        {
+        cl->addRequest(request);
+        return cl;
+        }
+
+#ifdef ENABLE_HIP
+    if (m_particle_data->getExecConf()->isCUDAEnabled())
+        cl = std::make_shared<CellListGPU>(shared_from_this());
+    else
+#endif
+        cl = std::make_shared<CellList>(shared_from_this());
+
+    cl->setRequest(request);
+    m_cell_lists.push_back(cl);
+    return cl;
+    }
+
+/*! \param nx Number of times to replicate the system along the x direction
+    \param ny Number of times to replicate the system along the y direction
+    \param nz Number of times to replicate the system along the z direction
+
+    Equivalent to replicating a snapshot of the system with SnapshotSystemData::replicate() and
+    initializing from it. In MPI simulations, only the unit cell is gathered on the root rank and
+    broadcast. Every rank creates a contiguous range of the periodic images, which
+    ParticleData::initializeFromSnapshot() sends to the ranks that own the particles, and every rank
+    creates only the bonded groups with local members. No rank holds the whole replicated system.
+*/
+void SystemDefinition::replicate(unsigned int nx, unsigned int ny, unsigned int nz)
+    {
+    if (nx == 0 || ny == 0 || nz == 0)
+        {
+        throw std::runtime_error("Cannot replicate the system zero times.");
+        }
+
+    std::shared_ptr<SnapshotSystemData<double>> snap = takeSnapshot<double>();
+
+#ifdef ENABLE_MPI
+    if (m_particle_data->getDomainDecomposition())
+        {
+        std::shared_ptr<const ExecutionConfiguration> exec_conf = m_particle_data->getExecConf();
+
+        // every rank creates its images from the unit cell
+        snap->particle_data.bcast(0, exec_conf->getMPICommunicator());
+
+        BoxDim old_box = snap->global_box;
+        BoxDim new_box = old_box;
+        Scalar3 L = old_box.getL();
+        L.x *= (Scalar)nx;
+        L.y *= (Scalar)ny;
+        L.z *= (Scalar)nz;
+        new_box.setL(L);
+
+        unsigned int old_n = snap->particle_data.size;
+        unsigned int n = nx * ny * nz;
+        uint64_t rank = exec_conf->getRank();
+        uint64_t n_ranks = exec_conf->getNRanks();
+        unsigned int first_image = (unsigned int)(n * rank / n_ranks);
+        unsigned int last_image = (unsigned int)(n * (rank + 1) / n_ranks);
+
+        SnapshotParticleData<double> particles;
+        particles.replicateImages(snap->particle_data,
+                                  nx,
+                                  ny,
+                                  nz,
+                                  old_box,
+                                  new_box,
+                                  first_image,
+                                  last_image - first_image);
+        particles.is_distributed = true;
+        snap->particle_data = SnapshotParticleData<double>();
+
+        m_particle_data->setGlobalBox(new_box);
+        m_particle_data->initializeFromSnapshot(particles);
+        m_bond_data->initializeFromReplicatedSnapshot(snap->bond_data, n, old_n);
+        m_angle_data->initializeFromReplicatedSnapshot(snap->angle_data, n, old_n);
+        m_dihedral_data->initializeFromReplicatedSnapshot(snap->dihedral_data, n, old_n);
+        m_improper_data->initializeFromReplicatedSnapshot(snap->improper_data, n, old_n);
+        m_constraint_data->initializeFromReplicatedSnapshot(snap->constraint_data, n, old_n);
+        m_pair_data->initializeFromReplicatedSnapshot(snap->pair_data, n, old_n);
+        return;
+        }
+#endif
+
+    snap->replicate(nx, ny, nz);
+    initializeFromSnapshot(snap);
+    }
+
 // instantiate both float and double methods
 template SystemDefinition::SystemDefinition(std::shared_ptr<SnapshotSystemData<float>> snapshot,
                                             std::shared_ptr<ExecutionConfiguration> exec_conf,
@@ -175,6 +354,8 @@ template SystemDefinition::SystemDefinition(std::shared_ptr<SnapshotSystemData<f
 template std::shared_ptr<SnapshotSystemData<float>> SystemDefinition::takeSnapshot<float>();
 template void SystemDefinition::initializeFromSnapshot<float>(
     std::shared_ptr<SnapshotSystemData<float>> snapshot);
+template void
+SystemDefinition::updateFromSnapshot<float>(std::shared_ptr<SnapshotSystemData<float>> snapshot);
 
 template SystemDefinition::SystemDefinition(std::shared_ptr<SnapshotSystemData<double>> snapshot,
                                             std::shared_ptr<ExecutionConfiguration> exec_conf,
@@ -182,6 +363,8 @@ template SystemDefinition::SystemDefinition(std::shared_ptr<SnapshotSystemData<d
 template std::shared_ptr<SnapshotSystemData<double>> SystemDefinition::takeSnapshot<double>();
 template void SystemDefinition::initializeFromSnapshot<double>(
     std::shared_ptr<SnapshotSystemData<double>> snapshot);
+template void
+SystemDefinition::updateFromSnapshot<double>(std::shared_ptr<SnapshotSystemData<double>> snapshot);
 
 void export_SystemDefinition(py::module& m)
     {
@@ -228,6 +411,9 @@ void export_SystemDefinition(py::module& m)
         .def("takeSnapshot_double", &SystemDefinition::takeSnapshot<double>)
         .def("initializeFromSnapshot", &SystemDefinition::initializeFromSnapshot<float>)
         .def("initializeFromSnapshot", &SystemDefinition::initializeFromSnapshot<double>)
+        .def("updateFromSnapshot", &SystemDefinition::updateFromSnapshot<float>)
+        .def("updateFromSnapshot", &SystemDefinition::updateFromSnapshot<double>)
+        .def("replicate", &SystemDefinition::replicate)
         .def("getSeed", &SystemDefinition::getSeed)
         .def("setSeed", &SystemDefinition::setSeed);
     }
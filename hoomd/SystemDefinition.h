@@ -17,6 +17,7 @@
 
 #include <memory>
 #include <pybind11/pybind11.h>
+#include <vector>
 
 #ifndef __SYSTEM_DEFINITION_H__
 #define __SYSTEM_DEFINITION_H__
@@ -29,6 +30,10 @@ class Communicator;
 //! Forward declaration of SnapshotSystemData
 template<class Real> struct SnapshotSystemData;
 
+//! Forward declarations of the cell list
+class CellList;
+struct CellListRequest;
+
 //! Container class for all data needed to define the MD system
 /*! SystemDefinition is a big bucket where all of the data defining the MD system goes.
     Everything is stored as a shared pointer for quick and easy access from within C++
@@ -66,9 +71,15 @@ template<class Real> struct SnapshotSystemData;
     Several other default constructors are provided, mainly to provide backward compatibility to
    unit tests that relied on the simple initialization constructors provided by ParticleData.
 
+    <b>Shared cell lists</b>
+
+    Computes that need a cell list get one from getCellList(). Computes that request compatible
+   configurations share one cell list, so that the particles are binned once per time step no matter
+   how many computes use them.
+
     \ingroup data_structs
 */
-class PYBIND11_EXPORT SystemDefinition
+class PYBIND11_EXPORT SystemDefinition : public std::enable_shared_from_this<SystemDefinition>
     {
     public:
     //! Constructs a NULL SystemDefinition
@@ -175,6 +186,16 @@ class PYBIND11_EXPORT SystemDefinition
     template<class Real>
     void initializeFromSnapshot(std::shared_ptr<SnapshotSystemData<Real>> snapshot);
 
+    //! Update the system from the modified parts of a snapshot
+    template<class Real>
+    void updateFromSnapshot(std::shared_ptr<SnapshotSystemData<Real>> snapshot);
+
+    //! Replicate the system along the periodic box directions
+    void replicate(unsigned int nx, unsigned int ny, unsigned int nz);
+
+    //! Get a cell list shared with the other consumers of compatible cell lists
+    std::shared_ptr<CellList> getCellList(const CellListRequest& request);
+
     private:
     unsigned int m_n_dimensions;                       //!< Dimensionality of the system
     uint16_t m_seed = 0;                               //!< Random number seed
@@ -186,6 +207,7 @@ class PYBIND11_EXPORT SystemDefinition
     std::shared_ptr<ConstraintData> m_constraint_data; //!< Improper data for the system
     std::shared_ptr<IntegratorData> m_integrator_data; //!< Integrator data for the system
     std::shared_ptr<PairData> m_pair_data;             //!< Special pairs data for the system
+    std::vector<std::weak_ptr<CellList>> m_cell_lists; //!< Cell lists shared between consumers
     };
 
 //! Exports SystemDefinition to python
@@ -11,6 +11,15 @@ bool testTriggerCall(std::shared_ptr<Trigger> t, uint64_t step)
     return (*t)(step);
     }
 
+//* Method to enable unit testing of Trigger::nextTrigger from pytest
+pybind11::object testNextTrigger(std::shared_ptr<Trigger> t, uint64_t step)
+    {
+    uint64_t next;
+    if (!t->nextTrigger(step, next))
+        return pybind11::none();
+    return pybind11::int_(next);
+    }
+
 //* Trampoline for classes inherited in python
 class TriggerPy : public Trigger
     {
@@ -81,4 +90,5 @@ void export_Trigger(pybind11::module& m)
         .def(pybind11::init<pybind11::object>(), pybind11::arg("triggers"));
 
     m.def("_test_trigger_call", &testTriggerCall);
+    m.def("_test_next_trigger", &testNextTrigger);
     }
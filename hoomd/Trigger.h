@@ -5,6 +5,7 @@
 
 #include <algorithm>
 #include <cstdint>
+#include <limits>
 #include <memory>
 #include <pybind11/iostream.h>
 #include <pybind11/pybind11.h>
@@ -48,6 +49,21 @@ class PYBIND11_EXPORT Trigger
 
     virtual bool compute(uint64_t timestep) = 0;
 
+    /** Find the first time step on or after the given one on which the trigger activates
+     *
+     *  Triggers that activate on a predictable schedule override nextTrigger() so that System can
+     *  skip evaluating them until that step. Set @a next to the maximum uint64_t value when the
+     *  trigger never activates again.
+     *
+     *  @param timestep First time step to consider
+     *  @param next Set to the next time step on which the trigger activates
+     *  @returns `true` when @a next is set, `false` when the trigger must be evaluated every step
+     */
+    virtual bool nextTrigger(uint64_t timestep, uint64_t& next)
+        {
+        return false;
+        }
+
     private:
     /// Caches the last time step at which the trigger was computed
     uint64_t m_last_timestep;
@@ -81,6 +97,15 @@ class PYBIND11_EXPORT PeriodicTrigger : public Trigger
         return (timestep - m_phase) % m_period == 0;
         }
 
+    bool nextTrigger(uint64_t timestep, uint64_t& next)
+        {
+        // compute() wraps around below m_phase, continue that sequence until m_phase
+        next = timestep + (m_period - (timestep - m_phase) % m_period) % m_period;
+        if (timestep < m_phase && next > m_phase)
+            next = m_phase;
+        return true;
+        }
+
     /// Set the period
     void setPeriod(uint64_t period)
         {
@@ -126,6 +151,12 @@ class PYBIND11_EXPORT BeforeTrigger : public Trigger
         return timestep < m_timestep;
         }
 
+    bool nextTrigger(uint64_t timestep, uint64_t& next)
+        {
+        next = timestep < m_timestep ? timestep : std::numeric_limits<uint64_t>::max();
+        return true;
+        }
+
     /// Get the timestep before which the trigger is active.
     uint64_t getTimestep() const
         {
@@ -158,6 +189,12 @@ class PYBIND11_EXPORT OnTrigger : public Trigger
         return timestep == m_timestep;
         }
 
+    bool nextTrigger(uint64_t timestep, uint64_t& next)
+        {
+        next = timestep <= m_timestep ? m_timestep : std::numeric_limits<uint64_t>::max();
+        return true;
+        }
+
     /// Get the timestep when the trigger is active.
     uint64_t getTimestep() const
         {
@@ -190,6 +227,17 @@ class PYBIND11_EXPORT AfterTrigger : public Trigger
         return timestep > m_timestep;
         }
 
+    bool nextTrigger(uint64_t timestep, uint64_t& next)
+        {
+        if (timestep > m_timestep)
+            next = timestep;
+        else if (m_timestep == std::numeric_limits<uint64_t>::max())
+            next = m_timestep;
+        else
+            next = m_timestep + 1;
+        return true;
+        }
+
     /// Get the timestep after which the trigger is active.
     uint64_t getTimestep() const
         {
@@ -300,6 +348,20 @@ class PYBIND11_EXPORT OrTrigger : public Trigger
                            { return t->operator()(timestep); });
         }
 
+    /// The next activation is the earliest one of the triggers, when all of them are predictable
+    bool nextTrigger(uint64_t timestep, uint64_t& next)
+        {
+        next = std::numeric_limits<uint64_t>::max();
+        for (auto& trigger : m_triggers)
+            {
+            uint64_t trigger_next;
+            if (!trigger->nextTrigger(timestep, trigger_next))
+                return false;
+            next = std::min(next, trigger_next);
+            }
+        return true;
+        }
+
     const std::vector<std::shared_ptr<Trigger>>& getTriggers() const
         {
         return m_triggers;
@@ -310,5 +372,61 @@ class PYBIND11_EXPORT OrTrigger : public Trigger
     std::vector<std::shared_ptr<Trigger>> m_triggers;
     };
 
+/** Skip evaluating a trigger before the next time step on which it activates
+ *
+ *  System evaluates the trigger of every operation through a ScheduledTrigger. When the trigger
+ *  implements nextTrigger(), operator() compares the time step to the cached next activation and
+ *  calls nextTrigger() again only after that step has passed. Other triggers, including those
+ *  implemented in Python, are evaluated on every call. The time step must not decrease between
+ *  calls.
+ */
+class PYBIND11_EXPORT ScheduledTrigger
+    {
+    public:
+    /// Construct an empty ScheduledTrigger
+    ScheduledTrigger() : m_scheduled(false), m_known(false), m_next(0) { }
+
+    /// Construct a ScheduledTrigger for the given trigger
+    explicit ScheduledTrigger(std::shared_ptr<Trigger> trigger)
+        : m_trigger(trigger), m_scheduled(true), m_known(false), m_next(0)
+        {
+        }
+
+    /** Determine if an operation should be performed on the given timestep
+     *
+     *  @param timestep Time step to query
+     *  @returns `true` if the operation should occur, `false` if not
+     */
+    bool operator()(uint64_t timestep)
+        {
+        if (m_scheduled && (!m_known || timestep > m_next))
+            {
+            m_scheduled = m_trigger->nextTrigger(timestep, m_next);
+            m_known = true;
+            }
+
+        if (!m_scheduled)
+            return (*m_trigger)(timestep);
+
+        return timestep == m_next;
+        }
+
+    /// Get the trigger
+    const std::shared_ptr<Trigger>& getTrigger() const
+        {
+        return m_trigger;
+        }
+
+    private:
+    /// The trigger
+    std::shared_ptr<Trigger> m_trigger;
+    /// False when the trigger must be evaluated every step
+    bool m_scheduled;
+    /// True when m_next is set
+    bool m_known;
+    /// Next time step on which the trigger activates
+    uint64_t m_next;
+    };
+
 /// Export Trigger classes to Python
 void export_Trigger(pybind11::module& m);
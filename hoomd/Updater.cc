@@ -14,7 +14,8 @@ namespace py = pybind11;
     \post The Updater is constructed with the given particle data and a NULL profiler.
 */
 Updater::Updater(std::shared_ptr<SystemDefinition> sysdef)
-    : m_sysdef(sysdef), m_pdata(m_sysdef->getParticleData()), m_exec_conf(m_pdata->getExecConf())
+    : m_sysdef(sysdef), m_pdata(m_sysdef->getParticleData()), m_profile_name("Updater"),
+      m_exec_conf(m_pdata->getExecConf()), m_timer(m_exec_conf)
     {
     // sanity check
     assert(m_sysdef);
@@ -41,6 +42,9 @@ void export_Updater(py::module& m)
         .def(py::init<std::shared_ptr<SystemDefinition>>())
         .def("update", &Updater::update)
         .def("setProfiler", &Updater::setProfiler)
+        .def("setProfileName", &Updater::setProfileName)
+        .def("getProfileName", &Updater::getProfileName)
+        .def("getRunTime", &Updater::getRunTime)
         .def("notifyDetach", &Updater::notifyDetach)
 #ifdef ENABLE_MPI
         .def("setCommunicator", &Updater::setCommunicator)
@@ -5,11 +5,13 @@
 
 #include "Communicator.h"
 #include "HOOMDMath.h"
+#include "OperationTimer.h"
 #include "Profiler.h"
 #include "SharedSignal.h"
 #include "SystemDefinition.h"
 
 #include <memory>
+#include <string>
 
 #ifndef __UPDATER_H__
 #define __UPDATER_H__
@@ -80,6 +82,41 @@ class PYBIND11_EXPORT Updater
     //! Sets the profiler for the compute to use
     virtual void setProfiler(std::shared_ptr<Profiler> prof);
 
+    //! Set the name of this updater in profiles
+    /*! \param name Name to use, Python passes the class name of the operation
+     */
+    void setProfileName(const std::string& name)
+        {
+        m_profile_name = name;
+        }
+
+    //! Get the name of this updater in profiles
+    const std::string& getProfileName() const
+        {
+        return m_profile_name;
+        }
+
+    //! Get the timer of this updater
+    OperationTimer& getTimer()
+        {
+        return m_timer;
+        }
+
+    //! Get the time in seconds this updater has spent executing during the current run
+    double getRunTime()
+        {
+        return m_timer.getTime();
+        }
+
+    //! Discard the times measured by this updater
+    /*! System calls resetTimers() at the start of each run. Derived classes that time other
+        operations on their behalf should reset those as well.
+    */
+    virtual void resetTimers()
+        {
+        m_timer.reset();
+        }
+
     //! Set autotuner parameters
     /*! \param enable Enable/disable autotuning
         \param period period (approximate) in time steps when returning occurs
@@ -150,13 +187,15 @@ class PYBIND11_EXPORT Updater
     const std::shared_ptr<ParticleData>
         m_pdata;                      //!< The particle data this compute is associated with
     std::shared_ptr<Profiler> m_prof; //!< The profiler this compute is to use
+    std::string m_profile_name;       //!< Name of this updater in profiles
 #ifdef ENABLE_MPI
     std::shared_ptr<Communicator> m_comm; //!< The communicator this updater is to use
 #endif
     std::shared_ptr<const ExecutionConfiguration>
         m_exec_conf; //!< Stored shared ptr to the execution configuration
     std::vector<std::shared_ptr<hoomd::detail::SignalSlot>>
-        m_slots; //!< Stored shared ptr to the system signals
+        m_slots;            //!< Stored shared ptr to the system signals
+    OperationTimer m_timer; //!< Time spent executing during the current run
     };
 
 //! Export the Updater class to python
@@ -17,6 +17,12 @@
 #include <pybind11/pybind11.h>
 #endif
 
+#ifdef ENABLE_TBB
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/parallel_reduce.h>
+#endif
+
 /** This updater removes the average particle drift from the reference positions.
  * The minimum image convention is applied to each particle displacement from the
  * reference configuration before averaging over N_particles. The particles are
@@ -34,7 +40,7 @@ class UpdaterRemoveDrift : public Updater
         }
 
     //! Set reference positions from a (N_particles, 3) numpy array
-    void setReferencePositions(const pybind11::array_t<double> ref_pos)
+    virtual void setReferencePositions(const pybind11::array_t<double> ref_pos)
         {
         if (ref_pos.ndim() != 2)
             {
@@ -97,19 +103,43 @@ class UpdaterRemoveDrift : public Updater
                                   access_mode::readwrite);
         const BoxDim& box = this->m_pdata->getGlobalBox();
         const vec3<Scalar> origin(this->m_pdata->getOrigin());
-        vec3<Scalar> rshift;
-        rshift.x = rshift.y = rshift.z = 0.0f;
+        const unsigned int N = this->m_pdata->getN();
+        const vec3<Scalar>* ref_positions = m_ref_positions.data();
 
-        for (unsigned int i = 0; i < this->m_pdata->getN(); i++)
-            {
+        // minimum image displacement of particle i from its reference position
+        auto displacement = [&](unsigned int i)
+        {
             unsigned int tag_i = h_tag.data[i];
             // read in the current position and orientation
             vec3<Scalar> postype_i = vec3<Scalar>(h_postype.data[i]) - origin;
             int3 tmp_image = make_int3(0, 0, 0);
             box.wrap(postype_i, tmp_image);
-            const vec3<Scalar> dr = postype_i - m_ref_positions[tag_i];
-            rshift += vec3<Scalar>(box.minImage(vec_to_scalar3(dr)));
-            }
+            const vec3<Scalar> dr = postype_i - ref_positions[tag_i];
+            return vec3<Scalar>(box.minImage(vec_to_scalar3(dr)));
+        };
+
+        // the partition is independent of the thread count, so the sum is reproducible
+#ifdef ENABLE_TBB
+        vec3<Scalar> rshift = m_exec_conf->getTaskArena()->execute(
+            [&]
+            {
+                return tbb::parallel_deterministic_reduce(
+                    tbb::blocked_range<unsigned int>(0, N, 1024),
+                    vec3<Scalar>(0, 0, 0),
+                    [&](const tbb::blocked_range<unsigned int>& r, vec3<Scalar> sum)
+                    {
+                        for (unsigned int i = r.begin(); i != r.end(); ++i)
+                            sum += displacement(i);
+                        return sum;
+                    },
+                    [](const vec3<Scalar>& a, const vec3<Scalar>& b) { return a + b; });
+            });
+#else
+        vec3<Scalar> rshift;
+        rshift.x = rshift.y = rshift.z = 0.0f;
+        for (unsigned int i = 0; i < N; i++)
+            rshift += displacement(i);
+#endif
 
 #ifdef ENABLE_MPI
         if (this->m_pdata->getDomainDecomposition())
@@ -129,14 +159,30 @@ class UpdaterRemoveDrift : public Updater
 
         rshift /= Scalar(this->m_pdata->getNGlobal());
 
-        for (unsigned int i = 0; i < this->m_pdata->getN(); i++)
-            {
+        auto subtract = [&](unsigned int i)
+        {
             // read in the current position and orientation
             Scalar4 postype_i = h_postype.data[i];
             const vec3<Scalar> r_i = vec3<Scalar>(postype_i);
             h_postype.data[i] = vec_to_scalar4(r_i - rshift, postype_i.w);
             box.wrap(h_postype.data[i], h_image.data[i]);
-            }
+        };
+
+#ifdef ENABLE_TBB
+        m_exec_conf->getTaskArena()->execute(
+            [&]
+            {
+                tbb::parallel_for(tbb::blocked_range<unsigned int>(0, N),
+                                  [&](const tbb::blocked_range<unsigned int>& r)
+                                  {
+                                      for (unsigned int i = r.begin(); i != r.end(); ++i)
+                                          subtract(i);
+                                  });
+            });
+#else
+        for (unsigned int i = 0; i < N; i++)
+            subtract(i);
+#endif
         }
 
     protected:
@@ -144,7 +190,7 @@ class UpdaterRemoveDrift : public Updater
     };
 
 /// Export the UpdaterRemoveDrift to python
-void export_UpdaterRemoveDrift(pybind11::module& m)
+inline void export_UpdaterRemoveDrift(pybind11::module& m)
     {
     pybind11::class_<UpdaterRemoveDrift, Updater, std::shared_ptr<UpdaterRemoveDrift>>(
         m,
@@ -0,0 +1,149 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file UpdaterRemoveDriftGPU.cc
+    \brief Defines the UpdaterRemoveDriftGPU class
+*/
+
+#ifdef ENABLE_HIP
+
+#include "UpdaterRemoveDriftGPU.h"
+#include "UpdaterRemoveDriftGPU.cuh"
+
+using namespace std;
+namespace py = pybind11;
+
+/*! \param sysdef System definition
+    \param ref_positions (N_particles, 3) array of reference positions
+ */
+UpdaterRemoveDriftGPU::UpdaterRemoveDriftGPU(std::shared_ptr<SystemDefinition> sysdef,
+                                             pybind11::array_t<double> ref_positions)
+    : UpdaterRemoveDrift(sysdef, ref_positions), m_block_size(256)
+    {
+    if (!m_exec_conf->isCUDAEnabled())
+        {
+        throw std::runtime_error(
+            "Creating a UpdaterRemoveDriftGPU with no GPU in the execution configuration");
+        }
+
+    // the base class constructor does not dispatch to the override
+    copyReferencePositions();
+
+    GPUArray<Scalar3> scratch(m_pdata->getN() / m_block_size + 1, m_exec_conf);
+    m_scratch.swap(scratch);
+    GPUArray<Scalar3> sum(1, m_exec_conf);
+    m_sum.swap(sum);
+
+    unsigned int warp_size = m_exec_conf->dev_prop.warpSize;
+    m_tuner.reset(
+        new Autotuner(warp_size, 1024, warp_size, 5, 100000, "remove_drift", m_exec_conf));
+    }
+
+/*! \param ref_pos (N_particles, 3) array of reference positions
+ */
+void UpdaterRemoveDriftGPU::setReferencePositions(const pybind11::array_t<double> ref_pos)
+    {
+    UpdaterRemoveDrift::setReferencePositions(ref_pos);
+    copyReferencePositions();
+    }
+
+void UpdaterRemoveDriftGPU::copyReferencePositions()
+    {
+    if (m_ref_positions_gpu.getNumElements() != m_ref_positions.size())
+        {
+        GPUArray<Scalar3> ref_positions_gpu(m_ref_positions.size(), m_exec_conf);
+        m_ref_positions_gpu.swap(ref_positions_gpu);
+        }
+
+    ArrayHandle<Scalar3> h_ref_positions(m_ref_positions_gpu,
+                                         access_location::host,
+                                         access_mode::overwrite);
+    for (size_t i = 0; i < m_ref_positions.size(); i++)
+        h_ref_positions.data[i] = vec_to_scalar3(m_ref_positions[i]);
+    }
+
+/*! \param timestep Current time step of the simulation
+ */
+void UpdaterRemoveDriftGPU::update(uint64_t timestep)
+    {
+    if (m_prof)
+        m_prof->push(m_exec_conf, "RemoveDrift");
+
+    const unsigned int N = m_pdata->getN();
+    const unsigned int num_blocks = N / m_block_size + 1;
+    if (m_scratch.getNumElements() < num_blocks)
+        m_scratch.resize(num_blocks);
+
+    const BoxDim& box = m_pdata->getGlobalBox();
+
+    ArrayHandle<Scalar4> d_postype(m_pdata->getPositions(),
+                                   access_location::device,
+                                   access_mode::readwrite);
+    ArrayHandle<int3> d_image(m_pdata->getImages(),
+                              access_location::device,
+                              access_mode::readwrite);
+
+        {
+        ArrayHandle<unsigned int> d_tag(m_pdata->getTags(),
+                                        access_location::device,
+                                        access_mode::read);
+        ArrayHandle<Scalar3> d_ref_positions(m_ref_positions_gpu,
+                                             access_location::device,
+                                             access_mode::read);
+        ArrayHandle<Scalar3> d_scratch(m_scratch, access_location::device, access_mode::overwrite);
+        ArrayHandle<Scalar3> d_sum(m_sum, access_location::device, access_mode::overwrite);
+
+        gpu_remove_drift_sum(d_sum.data,
+                             d_scratch.data,
+                             d_postype.data,
+                             d_tag.data,
+                             d_ref_positions.data,
+                             box,
+                             m_pdata->getOrigin(),
+                             N,
+                             m_block_size,
+                             num_blocks);
+        if (m_exec_conf->isCUDAErrorCheckingEnabled())
+            CHECK_CUDA_ERROR();
+        }
+
+#ifdef ENABLE_MPI
+    if (m_pdata->getDomainDecomposition())
+        {
+        ArrayHandle<Scalar3> h_sum(m_sum, access_location::host, access_mode::readwrite);
+        MPI_Allreduce(MPI_IN_PLACE,
+                      &h_sum.data[0],
+                      3,
+                      MPI_HOOMD_SCALAR,
+                      MPI_SUM,
+                      m_exec_conf->getMPICommunicator());
+        }
+#endif
+
+    ArrayHandle<Scalar3> d_sum(m_sum, access_location::device, access_mode::read);
+
+    m_tuner->begin();
+    gpu_remove_drift_apply(d_postype.data,
+                           d_image.data,
+                           d_sum.data,
+                           box,
+                           N,
+                           m_pdata->getNGlobal(),
+                           m_tuner->getParam());
+    if (m_exec_conf->isCUDAErrorCheckingEnabled())
+        CHECK_CUDA_ERROR();
+    m_tuner->end();
+
+    if (m_prof)
+        m_prof->pop(m_exec_conf);
+    }
+
+void export_UpdaterRemoveDriftGPU(pybind11::module& m)
+    {
+    pybind11::class_<UpdaterRemoveDriftGPU,
+                     UpdaterRemoveDrift,
+                     std::shared_ptr<UpdaterRemoveDriftGPU>>(m, "UpdaterRemoveDriftGPU")
+        .def(pybind11::init<std::shared_ptr<SystemDefinition>, pybind11::array_t<double>>());
+    }
+
+#endif // ENABLE_HIP
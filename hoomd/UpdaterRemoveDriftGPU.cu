@@ -0,0 +1,243 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "UpdaterRemoveDriftGPU.cuh"
+
+#include <assert.h>
+
+/*! \file UpdaterRemoveDriftGPU.cu
+    \brief Defines GPU kernel code for removing the average drift from the particles on the GPU.
+   Used by UpdaterRemoveDriftGPU.
+*/
+
+//! Reduce the Scalar3 values in shared memory to element 0
+/*! \param sdata Shared memory array with one element per thread, blockDim.x must be a power of two
+ */
+__device__ inline void remove_drift_block_reduce(Scalar3* sdata)
+    {
+    int offs = blockDim.x >> 1;
+    while (offs > 0)
+        {
+        if (threadIdx.x < offs)
+            {
+            sdata[threadIdx.x].x += sdata[threadIdx.x + offs].x;
+            sdata[threadIdx.x].y += sdata[threadIdx.x + offs].y;
+            sdata[threadIdx.x].z += sdata[threadIdx.x + offs].z;
+            }
+        offs >>= 1;
+        __syncthreads();
+        }
+    }
+
+//! Perform partial sums of the displacements on the GPU
+/*! \param d_scratch Scratch space to hold partial sums. One element is written per block
+    \param d_postype Particle positions
+    \param d_tag Particle tags
+    \param d_ref_positions Reference positions indexed by tag
+    \param box Global simulation box
+    \param origin Origin of the global box
+    \param N Number of local particles
+
+    One thread is executed per particle. Each thread wraps its particle back into the box relative
+    to the origin and takes the minimum image of its displacement from the reference position. The
+    block performs a reduction in shared memory and writes its partial sum to
+    d_scratch[blockIdx.x]. sizeof(Scalar3)*block_size of dynamic shared memory are needed for this
+    kernel to run.
+*/
+__global__ void gpu_remove_drift_partial_sums(Scalar3* d_scratch,
+                                              const Scalar4* d_postype,
+                                              const unsigned int* d_tag,
+                                              const Scalar3* d_ref_positions,
+                                              const BoxDim box,
+                                              const Scalar3 origin,
+                                              const unsigned int N)
+    {
+    HIP_DYNAMIC_SHARED(Scalar3, remove_drift_sdata)
+
+    unsigned int idx = blockIdx.x * blockDim.x + threadIdx.x;
+
+    // non-participating thread: contribute 0 to the sum
+    Scalar3 my_element = make_scalar3(0, 0, 0);
+
+    if (idx < N)
+        {
+        Scalar4 postype = d_postype[idx];
+        Scalar3 pos = make_scalar3(postype.x, postype.y, postype.z) - origin;
+        int3 tmp_image = make_int3(0, 0, 0);
+        box.wrap(pos, tmp_image);
+        my_element = box.minImage(pos - d_ref_positions[d_tag[idx]]);
+        }
+
+    remove_drift_sdata[threadIdx.x] = my_element;
+    __syncthreads();
+
+    remove_drift_block_reduce(remove_drift_sdata);
+
+    // write out our partial sum
+    if (threadIdx.x == 0)
+        d_scratch[blockIdx.x] = remove_drift_sdata[0];
+    }
+
+//! Complete the partial sums of the displacements on the GPU
+/*! \param d_sum Total displacement (one element)
+    \param d_scratch Partial sums from gpu_remove_drift_partial_sums
+    \param num_partial_sums Number of partial sums in \a d_scratch
+
+    Executed with a single block. sizeof(Scalar3)*block_size of dynamic shared memory are needed
+    for this kernel to run.
+*/
+__global__ void gpu_remove_drift_final_sum(Scalar3* d_sum,
+                                           const Scalar3* d_scratch,
+                                           const unsigned int num_partial_sums)
+    {
+    HIP_DYNAMIC_SHARED(Scalar3, remove_drift_sdata)
+
+    Scalar3 final_sum = make_scalar3(0, 0, 0);
+
+    // sum up the values in the partial sum via a sliding window
+    for (unsigned int start = 0; start < num_partial_sums; start += blockDim.x)
+        {
+        if (start + threadIdx.x < num_partial_sums)
+            remove_drift_sdata[threadIdx.x] = d_scratch[start + threadIdx.x];
+        else
+            remove_drift_sdata[threadIdx.x] = make_scalar3(0, 0, 0);
+        __syncthreads();
+
+        remove_drift_block_reduce(remove_drift_sdata);
+
+        // everybody sums up the total
+        final_sum += remove_drift_sdata[0];
+        __syncthreads();
+        }
+
+    if (threadIdx.x == 0)
+        *d_sum = final_sum;
+    }
+
+/*! \param d_sum Total displacement (one element)
+    \param d_scratch Scratch space for \a num_blocks partial sums
+    \param d_postype Particle positions
+    \param d_tag Particle tags
+    \param d_ref_positions Reference positions indexed by tag
+    \param box Global simulation box
+    \param origin Origin of the global box
+    \param N Number of local particles
+    \param block_size Block size to execute on the GPU (power of two)
+    \param num_blocks Number of blocks, must be at least N / block_size + 1
+
+    The result stays on the device.
+*/
+hipError_t gpu_remove_drift_sum(Scalar3* d_sum,
+                                Scalar3* d_scratch,
+                                const Scalar4* d_postype,
+                                const unsigned int* d_tag,
+                                const Scalar3* d_ref_positions,
+                                const BoxDim& box,
+                                const Scalar3 origin,
+                                const unsigned int N,
+                                const unsigned int block_size,
+                                const unsigned int num_blocks)
+    {
+    assert(d_sum);
+    assert(d_scratch);
+    assert(num_blocks >= N / block_size + 1);
+
+    hipLaunchKernelGGL((gpu_remove_drift_partial_sums),
+                       dim3(num_blocks),
+                       dim3(block_size),
+                       block_size * sizeof(Scalar3),
+                       0,
+                       d_scratch,
+                       d_postype,
+                       d_tag,
+                       d_ref_positions,
+                       box,
+                       origin,
+                       N);
+
+    hipLaunchKernelGGL((gpu_remove_drift_final_sum),
+                       dim3(1),
+                       dim3(block_size),
+                       block_size * sizeof(Scalar3),
+                       0,
+                       d_sum,
+                       d_scratch,
+                       num_blocks);
+
+    return hipSuccess;
+    }
+
+//! Subtract the average drift on the GPU
+/*! \param d_postype Particle positions
+    \param d_image Particle images
+    \param d_sum Total displacement summed over all particles
+    \param box Global simulation box
+    \param N Number of local particles
+    \param N_global Number of particles in the system
+*/
+__global__ void gpu_remove_drift_apply_kernel(Scalar4* d_postype,
+                                              int3* d_image,
+                                              const Scalar3* d_sum,
+                                              const BoxDim box,
+                                              const unsigned int N,
+                                              const unsigned int N_global)
+    {
+    unsigned int idx = blockIdx.x * blockDim.x + threadIdx.x;
+
+    if (idx >= N)
+        return;
+
+    Scalar3 rshift = *d_sum / Scalar(N_global);
+
+    Scalar4 postype = d_postype[idx];
+    postype.x -= rshift.x;
+    postype.y -= rshift.y;
+    postype.z -= rshift.z;
+
+    int3 image = d_image[idx];
+    box.wrap(postype, image);
+
+    d_postype[idx] = postype;
+    d_image[idx] = image;
+    }
+
+/*! \param d_postype Particle positions
+    \param d_image Particle images
+    \param d_sum Total displacement summed over all particles
+    \param box Global simulation box
+    \param N Number of local particles
+    \param N_global Number of particles in the system
+    \param block_size Block size to execute on the GPU
+*/
+hipError_t gpu_remove_drift_apply(Scalar4* d_postype,
+                                  int3* d_image,
+                                  const Scalar3* d_sum,
+                                  const BoxDim& box,
+                                  const unsigned int N,
+                                  const unsigned int N_global,
+                                  const unsigned int block_size)
+    {
+    static unsigned int max_block_size = UINT_MAX;
+    if (max_block_size == UINT_MAX)
+        {
+        hipFuncAttributes attr;
+        hipFuncGetAttributes(&attr, (const void*)gpu_remove_drift_apply_kernel);
+        max_block_size = attr.maxThreadsPerBlock;
+        }
+
+    unsigned int run_block_size = min(block_size, max_block_size);
+
+    hipLaunchKernelGGL((gpu_remove_drift_apply_kernel),
+                       dim3(N / run_block_size + 1),
+                       dim3(run_block_size),
+                       0,
+                       0,
+                       d_postype,
+                       d_image,
+                       d_sum,
+                       box,
+                       N,
+                       N_global);
+
+    return hipSuccess;
+    }
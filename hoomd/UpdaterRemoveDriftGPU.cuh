@@ -0,0 +1,37 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file UpdaterRemoveDriftGPU.cuh
+    \brief Declares GPU kernel code for removing the average drift from the particles on the GPU.
+   Used by UpdaterRemoveDriftGPU.
+*/
+
+#ifndef _REMOVE_DRIFT_UPDATER_GPU_CUH_
+#define _REMOVE_DRIFT_UPDATER_GPU_CUH_
+
+#include "BoxDim.h"
+#include "HOOMDMath.h"
+#include <hip/hip_runtime.h>
+
+//! Kernel driver to sum the minimum image displacements from the reference positions
+hipError_t gpu_remove_drift_sum(Scalar3* d_sum,
+                                Scalar3* d_scratch,
+                                const Scalar4* d_postype,
+                                const unsigned int* d_tag,
+                                const Scalar3* d_ref_positions,
+                                const BoxDim& box,
+                                const Scalar3 origin,
+                                const unsigned int N,
+                                const unsigned int block_size,
+                                const unsigned int num_blocks);
+
+//! Kernel driver to subtract the average drift and wrap the particles back into the box
+hipError_t gpu_remove_drift_apply(Scalar4* d_postype,
+                                  int3* d_image,
+                                  const Scalar3* d_sum,
+                                  const BoxDim& box,
+                                  const unsigned int N,
+                                  const unsigned int N_global,
+                                  const unsigned int block_size);
+
+#endif // _REMOVE_DRIFT_UPDATER_GPU_CUH_
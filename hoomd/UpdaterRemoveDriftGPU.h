@@ -0,0 +1,65 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file UpdaterRemoveDriftGPU.h
+    \brief Declares an updater that removes the average drift from the particles on the GPU
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#ifdef ENABLE_HIP
+
+#ifndef _REMOVE_DRIFT_UPDATER_GPU_H_
+#define _REMOVE_DRIFT_UPDATER_GPU_H_
+
+#include "Autotuner.h"
+#include "GPUArray.h"
+#include "UpdaterRemoveDrift.h"
+
+#include <memory>
+#include <pybind11/pybind11.h>
+
+/** Removes the average particle drift from the reference positions on the GPU.
+ *
+ * The displacements are reduced on the device and the shift is applied in place, so the positions
+ * never leave the device. The reference positions are kept on the device, indexed by tag.
+ */
+class PYBIND11_EXPORT UpdaterRemoveDriftGPU : public UpdaterRemoveDrift
+    {
+    public:
+    /// Constructor
+    UpdaterRemoveDriftGPU(std::shared_ptr<SystemDefinition> sysdef,
+                          pybind11::array_t<double> ref_positions);
+
+    /// Set reference positions from a (N_particles, 3) numpy array
+    virtual void setReferencePositions(const pybind11::array_t<double> ref_pos);
+
+    /// Set autotuner parameters
+    virtual void setAutotunerParams(bool enable, unsigned int period)
+        {
+        UpdaterRemoveDrift::setAutotunerParams(enable, period);
+        m_tuner->setPeriod(period);
+        m_tuner->setEnabled(enable);
+        }
+
+    /// Take one timestep forward
+    virtual void update(uint64_t timestep);
+
+    protected:
+    /// Copy the reference positions to the device
+    void copyReferencePositions();
+
+    unsigned int m_block_size;             //!< Block size (power of two) of the drift reduction
+    GPUArray<Scalar3> m_ref_positions_gpu; //!< Reference positions by tag
+    GPUArray<Scalar3> m_scratch;           //!< Partial sums of the displacement, one per block
+    GPUArray<Scalar3> m_sum;               //!< Total displacement
+    std::unique_ptr<Autotuner> m_tuner;    //!< Autotuner for the block size of the shift
+    };
+
+/// Export the UpdaterRemoveDriftGPU to python
+void export_UpdaterRemoveDriftGPU(pybind11::module& m);
+
+#endif // _REMOVE_DRIFT_UPDATER_GPU_H_
+#endif // ENABLE_HIP
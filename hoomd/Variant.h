@@ -8,6 +8,7 @@
 #include <utility>
 
 #include "HOOMDMath.h"
+#include "VariantDevice.h"
 
 /** Defines quantities that vary with time steps.
 
@@ -44,6 +45,33 @@ class PYBIND11_EXPORT Variant
         {
         return std::pair<Scalar, Scalar>(min(), max());
         }
+
+    /** Fill the parameters that evaluate_variant() needs to evaluate the variant.
+
+        @param params Parameters to fill.
+        @returns false when the variant cannot be evaluated by evaluate_variant().
+    */
+    virtual bool getParams(variant_params& params)
+        {
+        return false;
+        }
+
+    /** Get parameters that evaluate the variant on the device.
+
+        @param timestep Current time step.
+        @returns The parameters of built-in variants. Other variants, such as those implemented in
+        Python, are evaluated on the host and given as a constant.
+    */
+    variant_params getDeviceParams(uint64_t timestep)
+        {
+        variant_params params = variant_params();
+        if (!getParams(params))
+            {
+            params.kind = variant_constant;
+            params.A = (*this)(timestep);
+            }
+        return params;
+        }
     };
 
 /** Constant value
@@ -89,6 +117,15 @@ class PYBIND11_EXPORT VariantConstant : public Variant
         return m_value;
         }
 
+    /// Fill the parameters for evaluate_variant().
+    virtual bool getParams(variant_params& params)
+        {
+        params = variant_params();
+        params.kind = variant_constant;
+        params.A = m_value;
+        return true;
+        }
+
     protected:
     /// The value.
     Scalar m_value;
@@ -200,6 +237,18 @@ class PYBIND11_EXPORT VariantRamp : public Variant
         return m_A > m_B ? m_A : m_B;
         }
 
+    /// Fill the parameters for evaluate_variant().
+    virtual bool getParams(variant_params& params)
+        {
+        params = variant_params();
+        params.kind = variant_ramp;
+        params.A = m_A;
+        params.B = m_B;
+        params.t_start = m_t_start;
+        params.t_AB = m_t_ramp;
+        return true;
+        }
+
     protected:
     /// The starting value.
     Scalar m_A;
@@ -392,6 +441,21 @@ class PYBIND11_EXPORT VariantCycle : public Variant
         return m_A > m_B ? m_A : m_B;
         }
 
+    /// Fill the parameters for evaluate_variant().
+    virtual bool getParams(variant_params& params)
+        {
+        params = variant_params();
+        params.kind = variant_cycle;
+        params.A = m_A;
+        params.B = m_B;
+        params.t_start = m_t_start;
+        params.t_A = m_t_A;
+        params.t_AB = m_t_AB;
+        params.t_B = m_t_B;
+        params.t_BA = m_t_BA;
+        return true;
+        }
+
     protected:
     /// The starting value.
     Scalar m_A;
@@ -536,6 +600,22 @@ class PYBIND11_EXPORT VariantPower : public Variant
         return m_A > m_B ? m_A : m_B;
         }
 
+    /// Fill the parameters for evaluate_variant().
+    virtual bool getParams(variant_params& params)
+        {
+        params = variant_params();
+        params.kind = variant_power;
+        params.A = m_A;
+        params.B = m_B;
+        params.t_start = m_t_start;
+        params.t_AB = m_t_ramp;
+        params.power = m_power;
+        params.offset = m_offset;
+        params.inv_start = m_inv_start;
+        params.inv_end = m_inv_end;
+        return true;
+        }
+
     protected:
     /// Get the new offset
     double computeOffset(Scalar a, Scalar b)
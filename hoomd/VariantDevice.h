@@ -0,0 +1,117 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#pragma once
+
+/*! \file VariantDevice.h
+    \brief Defines the plain parameters of the built-in variants and their evaluation on the host
+    and the device
+*/
+
+#include "HOOMDMath.h"
+
+#include <cstdint>
+
+// need to declare these functions with __host__ __device__ qualifiers when building in nvcc
+// HOSTDEVICE is __host__ __device__ when included in nvcc and blank when included into the host
+// compiler
+#ifdef __HIPCC__
+#define HOSTDEVICE __host__ __device__
+#else
+#define HOSTDEVICE
+#endif
+
+//! Kinds of variants that evaluate_variant() implements
+enum variant_kind
+    {
+    variant_constant = 0, //!< VariantConstant
+    variant_ramp,         //!< VariantRamp
+    variant_cycle,        //!< VariantCycle
+    variant_power         //!< VariantPower
+    };
+
+//! Parameters of a built-in variant
+/*! Kernels take these parameters in place of a value evaluated on the host, so that the launch
+    arguments do not change from one step to the next while a variant ramps. A value-initialized
+    variant_params is the constant 0.
+*/
+struct variant_params
+    {
+    unsigned int kind; //!< One of variant_kind
+    Scalar A;          //!< Value (constant), starting value (ramp, power) or first value (cycle)
+    Scalar B;          //!< Ending value (ramp, power) or second value (cycle)
+    uint64_t t_start;  //!< First time step of the ramp or cycle
+    uint64_t t_A;      //!< Holding time at A (cycle)
+    uint64_t t_AB;     //!< Length of the ramp (ramp, power) or of the ramp from A to B (cycle)
+    uint64_t t_B;      //!< Holding time at B (cycle)
+    uint64_t t_BA;     //!< Length of the ramp from B to A (cycle)
+    double power;      //!< Power of the approach (power)
+    double offset;     //!< Offset that allows negative values (power)
+    double inv_start;  //!< Starting value of the interpolation (power)
+    double inv_end;    //!< Ending value of the interpolation (power)
+    };
+
+//! Test if two sets of variant parameters are the same
+inline bool operator==(const variant_params& a, const variant_params& b)
+    {
+    return a.kind == b.kind && a.A == b.A && a.B == b.B && a.t_start == b.t_start
+           && a.t_A == b.t_A && a.t_AB == b.t_AB && a.t_B == b.t_B && a.t_BA == b.t_BA
+           && a.power == b.power && a.offset == b.offset && a.inv_start == b.inv_start
+           && a.inv_end == b.inv_end;
+    }
+
+//! Evaluate a built-in variant
+/*! \param params Parameters of the variant
+    \param timestep Time step to query
+    \returns The value of the variant, the same as the host Variant classes compute
+*/
+HOSTDEVICE inline Scalar evaluate_variant(const variant_params& params, uint64_t timestep)
+    {
+    if (params.kind == variant_ramp)
+        {
+        if (timestep < params.t_start)
+            return params.A;
+        if (timestep < params.t_start + params.t_AB)
+            {
+            double s = double(timestep - params.t_start) / double(params.t_AB);
+            return params.B * s + params.A * (1.0 - s);
+            }
+        return params.B;
+        }
+    else if (params.kind == variant_cycle)
+        {
+        if (timestep < params.t_start)
+            return params.A;
+
+        uint64_t delta = timestep - params.t_start;
+        uint64_t period = params.t_A + params.t_AB + params.t_B + params.t_BA;
+        delta -= (delta / period) * period;
+
+        if (delta < params.t_A)
+            return params.A;
+        if (delta < params.t_A + params.t_AB)
+            {
+            double s = double(delta - params.t_A) / double(params.t_AB);
+            return params.B * s + params.A * (1.0 - s);
+            }
+        if (delta < params.t_A + params.t_AB + params.t_B)
+            return params.B;
+
+        double s = double(delta - (params.t_A + params.t_AB + params.t_B)) / double(params.t_BA);
+        return params.A * s + params.B * (1.0 - s);
+        }
+    else if (params.kind == variant_power)
+        {
+        if (timestep <= params.t_start)
+            return params.A;
+        if (timestep < params.t_start + params.t_AB)
+            {
+            double s = double(timestep - params.t_start) / double(params.t_AB);
+            double inv_result = params.inv_end * s + params.inv_start * (1.0 - s);
+            return pow(inv_result, params.power) - params.offset;
+            }
+        return params.B;
+        }
+
+    return params.A;
+    }
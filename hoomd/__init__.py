@@ -10,6 +10,7 @@ simulations using HOOMD.
 import sys
 import pathlib
 import os
+import importlib
 
 if ((pathlib.Path(__file__).parent / 'CMakeLists.txt').exists()
         and 'SPHINX' not in os.environ):
@@ -40,16 +41,38 @@ from hoomd import communicator
 from hoomd import util
 from hoomd import write
 from hoomd import _hoomd
+
+# The component packages load large extension modules. Import them when a
+# script first accesses them (e.g. ``hoomd.md``) so that scripts only pay for
+# the components they use.
+_components = []
 if version.md_built:
-    from hoomd import md
+    _components.append('md')
 if version.hpmc_built:
-    from hoomd import hpmc
+    _components.append('hpmc')
 if version.dem_built and version.md_built:
-    from hoomd import dem
+    _components.append('dem')
 # if version.metal_built:
-#     from hoomd import metal
+#     _components.append('metal')
 # if version.mpcd_built:
-#     from hoomd import mpcd
+#     _components.append('mpcd')
+
+
+def __getattr__(name):
+    """Import component packages on first access."""
+    if name in _components:
+        return importlib.import_module('hoomd.' + name)
+    raise AttributeError(f"module 'hoomd' has no attribute '{name}'")
+
+
+def __dir__():
+    return sorted(set(globals()) | set(_components))
+
+
+# module level __getattr__ requires Python 3.7
+if sys.version_info < (3, 7):
+    for _component in _components:
+        importlib.import_module('hoomd.' + _component)
 
 from hoomd.simulation import Simulation
 from hoomd.state import State
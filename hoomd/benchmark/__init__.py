@@ -0,0 +1,41 @@
+# Copyright (c) 2009-2021 The Regents of the University of Michigan
+# This file is part of the HOOMD-blue project, released under the BSD 3-Clause
+# License.
+
+"""Benchmarks.
+
+`hoomd.benchmark` provides reproducible workloads that exercise the hot paths
+of HOOMD-blue: MD pair, bond, long range, and rigid body forces, and HPMC
+overlap checks. Each `Benchmark` builds its system from a fixed lattice and
+seed so that results are comparable between builds and releases.
+
+Run all benchmarks and write the results to a JSON file with::
+
+    python3 -m hoomd.benchmark --device GPU --N 4096 32768 \\
+        --output benchmarks.json
+
+or build the ``hoomd-benchmarks`` target, which runs the benchmarks on the
+CPU with the default options and writes ``benchmarks.json`` in the build
+directory. Run ``python3 -m hoomd.benchmark --help`` for all options.
+
+Each result records the benchmark name and parameters, the number of
+particles, the device, the time steps per second (TPS) of each repeat and
+their median, the time spent in each profiled region of
+`hoomd.Simulation.profile`, and the memory in use.
+"""
+
+from hoomd import version
+from hoomd.benchmark.common import Benchmark, run_benchmarks
+
+benchmarks = dict()
+"""dict[str, type]: Benchmarks available in this build, keyed by name."""
+
+if version.md_built:
+    from hoomd.benchmark.md import LJLiquid, PolymerMelt, RigidBodies
+    benchmarks.update(lj_liquid=LJLiquid,
+                      polymer_melt=PolymerMelt,
+                      rigid_bodies=RigidBodies)
+
+if version.hpmc_built:
+    from hoomd.benchmark.hpmc import HardSphere, HardPolyhedron
+    benchmarks.update(hard_sphere=HardSphere, hard_polyhedron=HardPolyhedron)
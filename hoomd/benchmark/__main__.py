@@ -0,0 +1,77 @@
+# Copyright (c) 2009-2021 The Regents of the University of Michigan
+# This file is part of the HOOMD-blue project, released under the BSD 3-Clause
+# License.
+
+"""Run the benchmarks from the command line."""
+
+import argparse
+import json
+
+import hoomd
+from hoomd.benchmark import benchmarks, run_benchmarks
+
+
+def main():
+    """Parse the command line and run the selected benchmarks."""
+    parser = argparse.ArgumentParser(
+        prog='python3 -m hoomd.benchmark',
+        description='Run HOOMD-blue benchmarks and report the results as '
+        'JSON.')
+    parser.add_argument('--benchmarks',
+                        nargs='+',
+                        choices=sorted(benchmarks),
+                        default=sorted(benchmarks),
+                        help='Benchmarks to run (default: all).')
+    parser.add_argument('--device',
+                        choices=['CPU', 'GPU'],
+                        default='CPU',
+                        help='Device to run on (default: CPU).')
+    parser.add_argument('--N',
+                        nargs='+',
+                        type=int,
+                        default=[4096, 32768],
+                        help='Target numbers of particles (default: 4096 '
+                        '32768).')
+    parser.add_argument('--warmup-steps',
+                        type=int,
+                        default=1000,
+                        help='Steps to run before measuring (default: 1000).')
+    parser.add_argument('--benchmark-steps',
+                        type=int,
+                        default=1000,
+                        help='Steps in each measurement (default: 1000).')
+    parser.add_argument('--repeat',
+                        type=int,
+                        default=3,
+                        help='Number of measurements (default: 3).')
+    parser.add_argument('--no-profile',
+                        action='store_true',
+                        help='Do not report the time spent in each profiled '
+                        'region.')
+    parser.add_argument('--output',
+                        help='JSON file to write the results to (default: '
+                        'print to stdout).')
+    args = parser.parse_args()
+
+    device = getattr(hoomd.device, args.device)(notice_level=1)
+    results = run_benchmarks(device, [benchmarks[b] for b in args.benchmarks],
+                             args.N,
+                             warmup_steps=args.warmup_steps,
+                             benchmark_steps=args.benchmark_steps,
+                             repeat=args.repeat,
+                             profile=not args.no_profile)
+
+    if device.communicator.rank == 0:
+        for result in results:
+            print(f"{result['name']:>16} N={result['N']:<9} "
+                  f"{result['tps']:.4g} TPS")
+
+        if args.output is None:
+            print(json.dumps(results, indent=2))
+        else:
+            with open(args.output, 'w') as f:
+                json.dump(results, f, indent=2)
+
+
+if __name__ == '__main__':
+    main()
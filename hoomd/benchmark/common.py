@@ -0,0 +1,140 @@
+# Copyright (c) 2009-2021 The Regents of the University of Michigan
+# This file is part of the HOOMD-blue project, released under the BSD 3-Clause
+# License.
+
+"""Implement Benchmark."""
+
+import statistics
+
+import numpy as np
+
+import hoomd
+
+try:
+    import resource
+except ImportError:
+    resource = None
+
+
+def lattice_snapshot(device, N, spacing, particle_types=('A',)):
+    """Place about *N* particles on a simple cubic lattice.
+
+    Args:
+        device (hoomd.device.Device): Device of the simulation.
+        N (int): Target number of particles.
+        spacing (float): Lattice spacing :math:`[\\mathrm{length}]`.
+        particle_types (tuple[str]): Particle types in the snapshot.
+
+    Returns:
+        hoomd.Snapshot: The snapshot with ``round(N**(1/3))**3`` particles of
+        the first type.
+    """
+    n = max(int(round(N**(1 / 3))), 1)
+    snapshot = hoomd.Snapshot(device.communicator)
+    if snapshot.communicator.rank == 0:
+        L = n * spacing
+        snapshot.configuration.box = [L, L, L, 0, 0, 0]
+        snapshot.particles.types = list(particle_types)
+        snapshot.particles.N = n**3
+        x = (np.arange(n) + 0.5) * spacing - L / 2
+        position = np.array(np.meshgrid(x, x, x, indexing='ij'))
+        snapshot.particles.position[:] = position.reshape(3, -1).T
+    return snapshot
+
+
+class Benchmark:
+    """Base class of the benchmark workloads.
+
+    Args:
+        device (hoomd.device.Device): Device to run the benchmark on.
+        N (int): Target number of particles.
+        warmup_steps (int): Number of steps to run before measuring.
+        benchmark_steps (int): Number of steps in each measurement.
+        repeat (int): Number of measurements.
+        profile (bool): When `True`, run one more profiled measurement and
+            report the time spent in each region.
+
+    Derived classes set `name` and implement `make_simulation`, which returns
+    a `hoomd.Simulation` ready to run. Systems are built deterministically
+    with `seed` so that every run of a benchmark simulates the same
+    trajectory.
+    """
+
+    name = None
+    seed = 1
+
+    def __init__(self,
+                 device,
+                 N,
+                 warmup_steps=1000,
+                 benchmark_steps=1000,
+                 repeat=3,
+                 profile=True):
+        self.device = device
+        self.N = N
+        self.warmup_steps = warmup_steps
+        self.benchmark_steps = benchmark_steps
+        self.repeat = repeat
+        self.profile = profile
+
+    def make_simulation(self):
+        """Build the simulation to benchmark."""
+        raise NotImplementedError
+
+    def run(self):
+        """Run the benchmark.
+
+        Returns:
+            dict: The benchmark results.
+        """
+        sim = self.make_simulation()
+        sim.run(self.warmup_steps)
+
+        tps = []
+        for _ in range(self.repeat):
+            sim.run(self.benchmark_steps)
+            tps.append(sim.tps)
+
+        # profiling synchronizes the GPU, so it is measured separately
+        profile = None
+        if self.profile:
+            sim.profiling = True
+            sim.run(self.benchmark_steps)
+            profile = sim.profile
+            sim.profiling = False
+
+        memory = dict(arrays=sum(self.device.memory_report().values()))
+        if resource is not None:
+            # ru_maxrss is in kilobytes on Linux
+            memory['peak_rss'] = resource.getrusage(
+                resource.RUSAGE_SELF).ru_maxrss * 1024
+
+        return dict(name=self.name,
+                    N=sim.state.N_particles,
+                    device=type(self.device).__name__,
+                    num_ranks=self.device.communicator.num_ranks,
+                    steps=self.benchmark_steps,
+                    tps=statistics.median(tps),
+                    tps_samples=tps,
+                    profile=profile,
+                    memory=memory,
+                    hoomd_version=hoomd.version.version)
+
+
+def run_benchmarks(device, benchmarks, N, **kwargs):
+    """Run several benchmarks at several system sizes.
+
+    Args:
+        device (hoomd.device.Device): Device to run the benchmarks on.
+        benchmarks (list[type]): `Benchmark` subclasses to run.
+        N (list[int]): Target numbers of particles.
+        kwargs: Passed to the `Benchmark` constructors.
+
+    Returns:
+        list[dict]: The results of each benchmark at each size.
+    """
+    results = []
+    for cls in benchmarks:
+        for n in N:
+            results.append(cls(device, n, **kwargs).run())
+    return results
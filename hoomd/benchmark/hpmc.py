@@ -0,0 +1,56 @@
+# Copyright (c) 2009-2021 The Regents of the University of Michigan
+# This file is part of the HOOMD-blue project, released under the BSD 3-Clause
+# License.
+
+"""HPMC benchmarks."""
+
+import hoomd
+from hoomd import hpmc
+from hoomd.benchmark.common import Benchmark, lattice_snapshot
+
+
+class HardSphere(Benchmark):
+    """Hard spheres.
+
+    Spheres of diameter 1 start on a simple cubic lattice with spacing 1.1
+    (volume fraction 0.39) and move with `hoomd.hpmc.integrate.Sphere` with a
+    fixed move size of 0.1.
+    """
+
+    name = 'hard_sphere'
+
+    def make_simulation(self):
+        """Build the simulation to benchmark."""
+        sim = hoomd.Simulation(device=self.device, seed=self.seed)
+        sim.create_state_from_snapshot(
+            lattice_snapshot(self.device, self.N, spacing=1.1))
+
+        mc = hpmc.integrate.Sphere(default_d=0.1)
+        mc.shape['A'] = dict(diameter=1.0)
+        sim.operations.integrator = mc
+        return sim
+
+
+class HardPolyhedron(Benchmark):
+    """Hard cubes.
+
+    Unit cubes start on a simple cubic lattice with spacing 1.3 (volume
+    fraction 0.46) and move with `hoomd.hpmc.integrate.ConvexPolyhedron` with
+    fixed move sizes of 0.1.
+    """
+
+    name = 'hard_polyhedron'
+
+    def make_simulation(self):
+        """Build the simulation to benchmark."""
+        sim = hoomd.Simulation(device=self.device, seed=self.seed)
+        sim.create_state_from_snapshot(
+            lattice_snapshot(self.device, self.N, spacing=1.3))
+
+        mc = hpmc.integrate.ConvexPolyhedron(default_d=0.1, default_a=0.1)
+        mc.shape['A'] = dict(vertices=[(x, y, z)
+                                       for x in (-0.5, 0.5)
+                                       for y in (-0.5, 0.5)
+                                       for z in (-0.5, 0.5)])
+        sim.operations.integrator = mc
+        return sim
@@ -0,0 +1,143 @@
+# Copyright (c) 2009-2021 The Regents of the University of Michigan
+# This file is part of the HOOMD-blue project, released under the BSD 3-Clause
+# License.
+
+"""MD benchmarks."""
+
+import math
+
+import numpy as np
+
+import hoomd
+from hoomd import md
+from hoomd.benchmark.common import Benchmark, lattice_snapshot
+
+
+class LJLiquid(Benchmark):
+    """Lennard-Jones liquid.
+
+    Particles interact with the `hoomd.md.pair.LJ` potential
+    (:math:`r_\\mathrm{cut} = 2.5`) at number density 0.84 and are integrated
+    with `hoomd.md.methods.NVT` at :math:`kT = 1.2`.
+    """
+
+    name = 'lj_liquid'
+
+    def make_simulation(self):
+        """Build the simulation to benchmark."""
+        sim = hoomd.Simulation(device=self.device, seed=self.seed)
+        sim.create_state_from_snapshot(
+            lattice_snapshot(self.device, self.N, spacing=0.84**(-1 / 3)))
+        sim.state.thermalize_particle_momenta(hoomd.filter.All(), kT=1.2)
+
+        lj = md.pair.LJ(nlist=md.nlist.Cell(), default_r_cut=2.5)
+        lj.params[('A', 'A')] = dict(epsilon=1, sigma=1)
+        nvt = md.methods.NVT(filter=hoomd.filter.All(), kT=1.2, tau=0.5)
+        sim.operations.integrator = md.Integrator(dt=0.005,
+                                                  methods=[nvt],
+                                                  forces=[lj])
+        return sim
+
+
+class PolymerMelt(Benchmark):
+    """Charged bead-spring polymer melt.
+
+    Linear chains of `chain_length` beads at number density 1 are connected
+    by `hoomd.md.bond.Harmonic` bonds and interact with the
+    `hoomd.md.pair.LJ` potential and PPPM electrostatics
+    (`hoomd.md.long_range.pppm.make_pppm_coulomb_forces`). The bead charges
+    alternate between +0.5 and -0.5 along each chain.
+    `hoomd.md.methods.Langevin` integrates the melt at :math:`kT = 1`.
+    """
+
+    name = 'polymer_melt'
+    chain_length = 10
+
+    def make_simulation(self):
+        """Build the simulation to benchmark."""
+        snapshot = lattice_snapshot(self.device, self.N, spacing=1.0)
+        if snapshot.communicator.rank == 0:
+            # chains run along x through consecutive lattice sites
+            n = int(round(snapshot.particles.N**(1 / 3)))
+            index = np.arange(snapshot.particles.N)
+            x = index // (n * n)
+            in_chain = (x + 1 < n) & ((x + 1) % self.chain_length != 0)
+            first = index[in_chain]
+            snapshot.bonds.types = ['backbone']
+            snapshot.bonds.N = len(first)
+            snapshot.bonds.group[:] = np.stack([first, first + n * n], axis=1)
+            snapshot.particles.charge[:] = np.where(x % 2 == 0, 0.5, -0.5)
+
+        sim = hoomd.Simulation(device=self.device, seed=self.seed)
+        sim.create_state_from_snapshot(snapshot)
+        sim.state.thermalize_particle_momenta(hoomd.filter.All(), kT=1.0)
+
+        nlist = md.nlist.Cell(exclusions=('bond',))
+        lj = md.pair.LJ(nlist=nlist, default_r_cut=2.5)
+        lj.params[('A', 'A')] = dict(epsilon=1, sigma=1)
+        harmonic = md.bond.Harmonic()
+        harmonic.params['backbone'] = dict(k=400, r0=1.0)
+
+        L = sim.state.box.Lx
+        grid = 2**int(math.ceil(math.log2(L)))
+        real_space, reciprocal_space = \
+            md.long_range.pppm.make_pppm_coulomb_forces(
+                nlist=nlist, resolution=(grid, grid, grid), order=5, r_cut=2.5)
+
+        langevin = md.methods.Langevin(filter=hoomd.filter.All(), kT=1.0)
+        sim.operations.integrator = md.Integrator(
+            dt=0.005,
+            methods=[langevin],
+            forces=[lj, harmonic, real_space, reciprocal_space])
+        return sim
+
+
+class RigidBodies(Benchmark):
+    """Rigid dimers.
+
+    Each `hoomd.md.constrain.Rigid` body has two constituent particles 1
+    apart that interact with the constituents of other bodies through the
+    `hoomd.md.pair.LJ` potential. `hoomd.md.methods.Langevin` integrates the
+    translational and rotational degrees of freedom of the bodies at
+    :math:`kT = 1`. *N* counts the central and constituent particles.
+    """
+
+    name = 'rigid_bodies'
+
+    def make_simulation(self):
+        """Build the simulation to benchmark."""
+        snapshot = lattice_snapshot(self.device,
+                                    self.N / 3,
+                                    spacing=2.0,
+                                    particle_types=('R', 'A'))
+        if snapshot.communicator.rank == 0:
+            snapshot.particles.mass[:] = 2
+            snapshot.particles.moment_inertia[:] = [0.5, 0.5, 0]
+
+        sim = hoomd.Simulation(device=self.device, seed=self.seed)
+        sim.create_state_from_snapshot(snapshot)
+
+        rigid = md.constrain.Rigid()
+        rigid.body['R'] = {
+            "constituent_types": ['A', 'A'],
+            "positions": [(0, 0, 0.5), (0, 0, -0.5)],
+            "orientations": [(1.0, 0.0, 0.0, 0.0), (1.0, 0.0, 0.0, 0.0)],
+            "charges": [0.0, 0.0],
+            "diameters": [1.0, 1.0]
+        }
+        rigid.create_bodies(sim.state)
+        centers = hoomd.filter.Rigid(("center", "free"))
+        sim.state.thermalize_particle_momenta(centers, kT=1.0)
+
+        lj = md.pair.LJ(nlist=md.nlist.Cell(exclusions=('body',)),
+                        default_r_cut=2.5)
+        lj.params[('A', 'A')] = dict(epsilon=1, sigma=1)
+        lj.params[('R', ['R', 'A'])] = dict(epsilon=0, sigma=1)
+        lj.r_cut[('R', ['R', 'A'])] = 0
+
+        langevin = md.methods.Langevin(filter=centers, kT=1.0)
+        sim.operations.integrator = md.Integrator(dt=0.005,
+                                                  methods=[langevin],
+                                                  forces=[lj],
+                                                  rigid=rigid)
+        return sim
@@ -31,6 +31,26 @@ class Communicator(object):
     own `partition` index. Use this to perform many simulations in parallel, for
     example by using `partition` as an index into an array of state points to
     execute.
+
+    Tip:
+        A single small system (a few thousand particles) cannot saturate a
+        modern GPU. To run an ensemble of small systems efficiently, launch
+        more ranks than there are GPUs and set ``ranks_per_partition=1``. When
+        you do not give `hoomd.device.GPU` a ``gpu_ids`` argument, each rank
+        selects a GPU by its node local rank modulo the number of GPUs, so
+        several partitions share each GPU. Enable the CUDA Multi-Process
+        Service (MPS) so that kernels from these processes execute concurrently
+        instead of time slicing::
+
+            nvidia-cuda-mps-control -d
+            mpirun -n 32 python3 script.py
+
+        In ``script.py``, select the state point with the partition index::
+
+            communicator = hoomd.communicator.Communicator(
+                ranks_per_partition=1)
+            device = hoomd.device.GPU(communicator=communicator)
+            kT = kT_values[communicator.partition]
     """
 
     def __init__(self, mpi_comm=None, ranks_per_partition=None):
@@ -112,6 +112,10 @@ class CustomOperation(_TriggeredOperation, metaclass=_AbstractLoggable):
         """`hoomd.custom.Action` The action the operation wraps."""
         return self._action
 
+    @property
+    def _profile_name(self):
+        return type(self._action).__name__
+
 
 class _AbstractLoggableWithPassthrough(_AbstractLoggable):
 
@@ -172,6 +176,10 @@ class _InternalCustomOperation(CustomOperation,
     def action(self):
         raise AttributeError(f"Object {self} has no attribute 'action'.")
 
+    @property
+    def _profile_name(self):
+        return type(self).__name__
+
     def __dir__(self):
         """Expose all attributes for dynamic querying in notebooks and IDEs."""
         list_ = super().__dir__()
@@ -323,6 +323,26 @@ _wrap_list = [
 ]
 
 
+def _dlpack(self, stream=None):
+    """Export the array through the DLPack protocol without a copy.
+
+    The consumer shares the memory of the internal buffer, which is only valid
+    inside the context manager. Read only arrays cannot be exported.
+    """
+    if not self._callback():
+        raise HOOMDArrayError(
+            "Cannot access {} outside context manager.".format(
+                self.__class__.__name__))
+    if self.read_only:
+        raise BufferError("Cannot export a read only array through DLPack.")
+    return self._buffer.__dlpack__(stream=stream)
+
+
+def _dlpack_device(self):
+    """tuple[int, int]: The DLPack device type and device id of the array."""
+    return self._buffer.__dlpack_device__()
+
+
 def coerce_mock_to_array(val):
     """Helper function for ``__array_{ufunc,function}__``.
 
@@ -352,6 +372,10 @@ class HOOMDArray(metaclass=_wrap_class_factory(_wrap_list)):
     which it was created.  To have access outside the manager an explicit copy
     must be made (e.g.  ``numpy.array(obj, copy=True)``).
 
+    `HOOMDArray` objects implement the DLPack protocol, so libraries such as
+    PyTorch and JAX can access the data in place inside the context manager
+    (e.g. ``torch.from_dlpack(a)``).
+
     In general this class should be nearly as fast as a standard NumPy array,
     but there is some overhead. This is mitigated by returning a
     ``numpy.ndarray`` whenever possible. If every ounce of performance is
@@ -459,6 +483,9 @@ class HOOMDArray(metaclass=_wrap_class_factory(_wrap_list)):
         return np.array(self._coerce_to_ndarray(),
                         copy=True).__array_interface__
 
+    __dlpack__ = _dlpack
+    __dlpack_device__ = _dlpack_device
+
     def _coerce_to_ndarray(self):
         """Provide a `numpy.ndarray` interface to the underlying buffer.
 
@@ -549,6 +576,9 @@ if hoomd.version.gpu_enabled:
         def __cuda_array_interface__(self):
             return deepcopy(self._buffer.__cuda_array_interface__)
 
+        __dlpack__ = _dlpack
+        __dlpack_device__ = _dlpack_device
+
         @property
         def read_only(self):
             return self._buffer.read_only
@@ -766,6 +796,12 @@ multiplication cannot be performed between `HOOMDGPUArray` and ``cupy.ndarray``
 objects.  However, ``cupy.add`` can be directly used and is recommended for
 memory safety.
 
+`HOOMDGPUArray` also implements the DLPack protocol (``__dlpack__`` and
+``__dlpack_device__``), which PyTorch, JAX, and CuPy consume without a copy
+(e.g. ``torch.from_dlpack(data.particles.position)``). As with the
+``__cuda_array_interface__``, the resulting tensor is only valid inside the
+context manager. Read only arrays cannot be exported through DLPack.
+
 Note:
     Packages like Numba and PyTorch can use `HOOMDGPUArray` without CuPy
     installed. Any package that supports version 2 of the
@@ -157,6 +157,7 @@ void DEM2DForceComputeGPU<Real, Real2, Real4, Potential>::computeForces(uint64_t
         return;
 
     // run the kernel on all GPUs in parallel
+    this->m_exec_conf->beginMultiGPU();
     m_tuner->begin();
     gpu_compute_dem2d_forces<Real, Real2, Real4, Evaluator>(d_force.data,
                                                             d_torque.data,
@@ -179,10 +180,12 @@ void DEM2DForceComputeGPU<Real, Real2, Real4, Potential>::computeForces(uint64_t
                                                             this->m_r_cut * this->m_r_cut,
                                                             (unsigned int)this->m_shapes.size(),
                                                             (unsigned int)particlesPerBlock,
-                                                            (unsigned int)this->maxVertices());
+                                                            (unsigned int)this->maxVertices(),
+                                                            this->m_pdata->getGPUPartition());
     if (this->m_exec_conf->isCUDAErrorCheckingEnabled())
         CHECK_CUDA_ERROR();
     m_tuner->end();
+    this->m_exec_conf->endMultiGPU();
 
     Scalar avg_neigh = this->m_nlist->estimateNNeigh();
     int64_t n_calc = int64_t(avg_neigh * this->m_pdata->getN());
@@ -4,7 +4,7 @@
 // Maintainer: mspells
 
 #include "hoomd/Autotuner.h"
-#include "hoomd/GPUArray.h"
+#include "hoomd/GlobalArray.h"
 #include "hoomd/md/NeighborList.h"
 
 #include <memory>
@@ -56,9 +56,9 @@ class DEM2DForceComputeGPU : public DEM2DForceCompute<Real, Real4, Potential>
         }
 
     protected:
-    GPUArray<Real2> m_vertices;                  //!< Vertices for all shapes
-    GPUArray<unsigned int> m_num_shape_vertices; //!< Number of vertices for each shape
-    std::unique_ptr<Autotuner> m_tuner;          //!< Autotuner for block size
+    GlobalArray<Real2> m_vertices;                  //!< Vertices for all shapes
+    GlobalArray<unsigned int> m_num_shape_vertices; //!< Number of vertices for each shape
+    std::unique_ptr<Autotuner> m_tuner;             //!< Autotuner for block size
 
     //! Actually compute the forces
     virtual void computeForces(uint64_t timestep);
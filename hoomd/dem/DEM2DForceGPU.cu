@@ -35,7 +35,8 @@
   \param d_virial Device memory to write computed virials
   \param virial_pitch pitch of 2D virial array
   \param d_diameter Device memory to read particle diameters
-  \param N number of particles
+  \param N number of particles to compute forces for on this GPU
+  \param partOffset Index of the first particle handled by this GPU
   \param d_vertices Vertex indices on the GPU
   \param d_vertex_indices Vertex linkage indices on the GPU
   \param vertexCount Total number of vertices in all shapes
@@ -65,6 +66,7 @@ __global__ void gpu_compute_dem2d_forces_kernel(const Scalar4* d_pos,
                                                 Scalar* d_virial,
                                                 const size_t virial_pitch,
                                                 const unsigned int N,
+                                                const unsigned int partOffset,
                                                 const Real2* d_vertices,
                                                 const unsigned int* d_num_shape_verts,
                                                 const Scalar* d_diam,
@@ -107,8 +109,10 @@ __global__ void gpu_compute_dem2d_forces_kernel(const Scalar4* d_pos,
     shOffset += n_shapes;
 
     // partIdx is the absolute index of the particle this thread is
-    // calculating for
-    size_t partIdx(blockIdx.x * blockDim.y + threadIdx.y);
+    // calculating for; only the first N particles after partOffset
+    // are handled by this launch
+    const bool activePart(blockIdx.x * blockDim.y + threadIdx.y < N);
+    const size_t partIdx(blockIdx.x * blockDim.y + threadIdx.y + partOffset);
 
     // localThreadIdx is just this thread's index in the block; use it
     // to load vertices
@@ -158,7 +162,7 @@ __global__ void gpu_compute_dem2d_forces_kernel(const Scalar4* d_pos,
     // for the whole block
     __syncthreads();
 
-    if (partIdx < N)
+    if (activePart)
         {
         const size_t n_neigh(d_n_neigh[partIdx]);
         const unsigned int myHead(d_head_list[partIdx]);
@@ -347,7 +351,7 @@ __global__ void gpu_compute_dem2d_forces_kernel(const Scalar4* d_pos,
 
     // sum all the intermediate force and torque values for each
     // particle we calculate for in the block
-    if (partIdx < N)
+    if (activePart)
         {
         genAtomicAdd((Real*)&partForceTorques[threadIdx.y].x, (Real)localForceTorque.x);
         genAtomicAdd((Real*)&partForceTorques[threadIdx.y].y, (Real)localForceTorque.y);
@@ -361,7 +365,7 @@ __global__ void gpu_compute_dem2d_forces_kernel(const Scalar4* d_pos,
     __syncthreads();
 
     // finally, write the result
-    if (partIdx < N && threadIdx.z == 0 && threadIdx.x == 0)
+    if (activePart && threadIdx.z == 0 && threadIdx.x == 0)
         {
         partForceTorques[threadIdx.y].w *= .5f;
         d_force[partIdx].x = partForceTorques[threadIdx.y].x;
@@ -394,11 +398,12 @@ __global__ void gpu_compute_dem2d_forces_kernel(const Scalar4* d_pos,
   force is set to 0
   \param particlesPerBlock Block size to execute
   \param maxVerts Maximum number of vertices in any shape
+  \param gpu_partition Range of particles handled by each GPU
 
   \returns Any error code resulting from the kernel launch
 
   This is just a driver for gpu_compute_dem2d_forces_kernel, see the documentation for it for more
-  information.
+  information. The kernel is launched once on every active GPU for its range of particles.
 */
 template<typename Real, typename Real2, typename Real4, typename Evaluator>
 hipError_t gpu_compute_dem2d_forces(Scalar4* d_force,
@@ -422,11 +427,9 @@ hipError_t gpu_compute_dem2d_forces(Scalar4* d_force,
                                     const Real r_cutsq,
                                     const unsigned int n_shapes,
                                     const unsigned int particlesPerBlock,
-                                    const unsigned int maxVerts)
+                                    const unsigned int maxVerts,
+                                    const GPUPartition& gpu_partition)
     {
-    // setup the grid to run the kernel
-    dim3 grid((int)ceil((double)N / (double)particlesPerBlock), 1, 1);
-
     hipFuncAttributes attr;
     hipFuncGetAttributes(&attr,
                          reinterpret_cast<const void*>(
@@ -440,32 +443,44 @@ hipError_t gpu_compute_dem2d_forces(Scalar4* d_force,
     size_t shmSize(vertexCount * sizeof(Real2) + n_shapes * 2 * sizeof(unsigned int)
                    + particlesPerBlock * (sizeof(Real4) + 6 * sizeof(Real)));
 
-    // run the kernel
-    hipLaunchKernelGGL((gpu_compute_dem2d_forces_kernel<Real, Real2, Real4, Evaluator>),
-                       grid,
-                       threads,
-                       shmSize,
-                       0,
-                       d_pos,
-                       d_quat,
-                       d_force,
-                       d_torque,
-                       d_virial,
-                       virial_pitch,
-                       N,
-                       d_vertices,
-                       d_num_shape_verts,
-                       d_diam,
-                       d_velocity,
-                       vertexCount,
-                       box,
-                       d_n_neigh,
-                       d_nlist,
-                       d_head_list,
-                       potential,
-                       r_cutsq,
-                       n_shapes,
-                       maxVerts);
+    // run the kernel on all GPUs in parallel
+    for (int idev = gpu_partition.getNumActiveGPUs() - 1; idev >= 0; --idev)
+        {
+        auto range = gpu_partition.getRangeAndSetGPU(idev);
+        unsigned int nwork = range.second - range.first;
+        if (nwork == 0)
+            continue;
+
+        // setup the grid to run the kernel
+        dim3 grid((int)ceil((double)nwork / (double)particlesPerBlock), 1, 1);
+
+        hipLaunchKernelGGL((gpu_compute_dem2d_forces_kernel<Real, Real2, Real4, Evaluator>),
+                           grid,
+                           threads,
+                           shmSize,
+                           0,
+                           d_pos,
+                           d_quat,
+                           d_force,
+                           d_torque,
+                           d_virial,
+                           virial_pitch,
+                           nwork,
+                           range.first,
+                           d_vertices,
+                           d_num_shape_verts,
+                           d_diam,
+                           d_velocity,
+                           vertexCount,
+                           box,
+                           d_n_neigh,
+                           d_nlist,
+                           d_head_list,
+                           potential,
+                           r_cutsq,
+                           n_shapes,
+                           maxVerts);
+        }
 
     return hipSuccess;
     }
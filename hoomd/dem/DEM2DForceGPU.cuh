@@ -5,6 +5,7 @@
 
 #include "DEMEvaluator.h"
 #include "hoomd/BoxDim.h"
+#include "hoomd/GPUPartition.cuh"
 #include "hoomd/HOOMDMath.h"
 
 /*! \file DEM2DForceGPU.cuh
@@ -41,7 +42,8 @@ hipError_t gpu_compute_dem2d_forces(Scalar4* d_force,
                                     const Real r_cutsq,
                                     const unsigned int n_shapes,
                                     const unsigned int particlesPerBlock,
-                                    const unsigned int maxVerts);
+                                    const unsigned int maxVerts,
+                                    const GPUPartition& gpu_partition);
 
 #endif
 
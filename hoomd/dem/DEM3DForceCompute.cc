@@ -26,6 +26,21 @@
 
 using namespace std;
 
+/*! segmentDistanceSq: squared distance between point and the segment
+  from p0 to p1.
+*/
+template<typename Real>
+inline Real segmentDistanceSq(const vec3<Real>& p0, const vec3<Real>& p1, const vec3<Real>& point)
+    {
+    const vec3<Real> edge(p1 - p0);
+    const vec3<Real> rel(point - p0);
+    const Real edgeSq(dot(edge, edge));
+    Real t(edgeSq > Real(0) ? dot(rel, edge) / edgeSq : Real(0));
+    t = min(max(t, Real(0)), Real(1));
+    const vec3<Real> delta(rel - t * edge);
+    return dot(delta, delta);
+    }
+
 /*! \param sysdef System to compute forces on
   \param nlist Neighborlist to use for computing the forces
   \param r_cut Cutoff radius beyond which the force is 0
@@ -237,6 +252,16 @@ void DEM3DForceCompute<Real, Real4, Potential>::createGeometry()
     if (m_facesVec.size() != nTypes || m_shapes.size() != nTypes)
         return;
 
+    // circumscribed radius of each shape, used to cull features far from a contact
+    m_typeRadius.assign(nTypes, Real(0));
+    for (size_t i(0); i < m_shapes.size(); ++i)
+        {
+        Real radiusSq(0);
+        for (size_t k(0); k < m_shapes[i].size(); ++k)
+            radiusSq = max(radiusSq, dot(m_shapes[i][k], m_shapes[i][k]));
+        m_typeRadius[i] = sqrt(radiusSq);
+        }
+
     // resize the geometry arrays if necessary
     if (m_verts.getNumElements() != nVerts)
         m_verts.resize(nVerts);
@@ -752,12 +777,25 @@ void DEM3DForceCompute<Real, Real4, Potential>::computeForces(uint64_t timestep)
                 vec3<Real> torqueij, torqueji;
                 Real potentialij(0);
 
+                // vertices and edges farther than these distances from the center of the
+                // other particle cannot reach any of its features
+                const Real contactCut(m_evaluator.getContactCutoff());
+                const Real reachi(m_typeRadius[typei] + contactCut);
+                const Real reachj(m_typeRadius[typej] + contactCut);
+                if (reachi < Real(0) || reachj < Real(0))
+                    continue;
+                const Real reachiSq(reachi * reachi);
+                const Real reachjSq(reachj * reachj);
+
                 // iterate over each vertex in particle i
                 for (size_t vertIndex(0); vertIndex < h_numTypeVerts.data[typei]; ++vertIndex)
                     {
                     const vec3<Real> vertex0(
                         rotate(quati,
                                vec3<Real>(h_verts.data[h_firstTypeVert.data[typei] + vertIndex])));
+                    const vec3<Real> vertexToj(dx - vertex0);
+                    if (dot(vertexToj, vertexToj) > reachjSq)
+                        continue;
 
                     // iterate over each face in particle j
                     size_t faceIndex(typej);
@@ -833,6 +871,9 @@ void DEM3DForceCompute<Real, Real4, Potential>::computeForces(uint64_t timestep)
                     const vec3<Real> vertex0(
                         rotate(quatj,
                                vec3<Real>(h_verts.data[h_firstTypeVert.data[typej] + vertIndex])));
+                    const vec3<Real> vertexToi(dx + vertex0);
+                    if (dot(vertexToi, vertexToi) > reachiSq)
+                        continue;
 
                     // iterate over each face in particle i
                     size_t faceIndex(typei);
@@ -895,6 +936,8 @@ void DEM3DForceCompute<Real, Real4, Potential>::computeForces(uint64_t timestep)
                         h_verts.data[h_edges.data[2 * (edgei + h_firstTypeEdge.data[typei]) + 1]]);
                     p00 = rotate(quati, p00);
                     p01 = rotate(quati, p01);
+                    if (segmentDistanceSq(p00, p01, dx) > reachjSq)
+                        continue;
 
                     // iterate over all edges of j
                     for (size_t edgej(0); edgej < h_numTypeEdges.data[typej]; ++edgej)
@@ -4,6 +4,7 @@
 // Maintainer: mspells
 
 #include "hoomd/ForceCompute.h"
+#include "hoomd/GlobalArray.h"
 #include "hoomd/md/NeighborList.h"
 
 #include <memory>
@@ -58,6 +59,15 @@
   - Vertices (3D points) are stored consecutively for a shape
   - Edges (pairs of vertex indices) are stored consecutively for a shape
 
+  Feature culling (CPU):
+  The potentials sum the interactions of every vertex-face, vertex-edge, and edge-edge pair within
+  the contact cutoff, so each neighbor pair normally scans all features of both shapes. Every
+  point of a shape lies within the circumscribed radius of its type (the largest vertex distance
+  from the center) of the particle center. A vertex or edge of particle i farther than that radius
+  plus the contact cutoff from the center of particle j cannot interact with any feature of j, and
+  the scan over the features of j is skipped for it. This gives the same forces while visiting
+  only the features near the contact.
+
   \ingroup computes
 */
 template<typename Real, typename Real4, typename Potential>
@@ -135,22 +145,24 @@ class DEM3DForceCompute : public ForceCompute
     Real m_r_cut;                          //!< Cutoff radius beyond which the force is set to 0
     DEMEvaluator<Real, Real4, Potential>
         m_evaluator; //!< Object holding parameters and computation method for the potential
-    GPUArray<unsigned int> m_nextFace;      //! face->next face
-    GPUArray<unsigned int> m_firstFaceVert; //!< face->first vertex
-    GPUArray<unsigned int> m_nextFaceVert;  //!< vertex->next vertex in the given face
-    GPUArray<unsigned int> m_realVertIndex; //!< vertex->real vertex
-    GPUArray<unsigned int> m_firstTypeVert; //!< type->first real vertex index
-    GPUArray<unsigned int> m_numTypeVerts;  //!< type->number of vertices
-    GPUArray<unsigned int> m_firstTypeEdge; //!< type->first edge in pair
-    GPUArray<unsigned int> m_numTypeEdges;  //!< type->number of edges
-    GPUArray<unsigned int> m_numTypeFaces;  //!< type->number of faces
-    GPUArray<unsigned int>
-        m_vertexConnectivity;       //!< real vertex index->number of times it appears in an edge
-    GPUArray<unsigned int> m_edges; //!< 2*edge->first real vert, 2*edge+1->second real vert in edge
-    GPUArray<Real> m_faceRcutSq;    //!< face index->rcut*rcut
-    GPUArray<Real> m_edgeRcutSq;    //!< edge index->rcut*rcut
-    GPUArray<Real4> m_verts;        //! Vertices for each real index
+    GlobalArray<unsigned int> m_nextFace;      //! face->next face
+    GlobalArray<unsigned int> m_firstFaceVert; //!< face->first vertex
+    GlobalArray<unsigned int> m_nextFaceVert;  //!< vertex->next vertex in the given face
+    GlobalArray<unsigned int> m_realVertIndex; //!< vertex->real vertex
+    GlobalArray<unsigned int> m_firstTypeVert; //!< type->first real vertex index
+    GlobalArray<unsigned int> m_numTypeVerts;  //!< type->number of vertices
+    GlobalArray<unsigned int> m_firstTypeEdge; //!< type->first edge in pair
+    GlobalArray<unsigned int> m_numTypeEdges;  //!< type->number of edges
+    GlobalArray<unsigned int> m_numTypeFaces;  //!< type->number of faces
+    GlobalArray<unsigned int>
+        m_vertexConnectivity; //!< real vertex index->number of times it appears in an edge
+    GlobalArray<unsigned int>
+        m_edges;                    //!< 2*edge->first real vert, 2*edge+1->second real vert in edge
+    GlobalArray<Real> m_faceRcutSq; //!< face index->rcut*rcut
+    GlobalArray<Real> m_edgeRcutSq; //!< edge index->rcut*rcut
+    GlobalArray<Real4> m_verts;     //! Vertices for each real index
     std::vector<std::vector<vec3<Real>>> m_shapes;                  //!< Vertices for each type
+    std::vector<Real> m_typeRadius; //!< type->largest distance of a vertex from the center
     std::vector<std::vector<std::vector<unsigned int>>> m_facesVec; //!< Faces for each type
 
     //! Re-send the list of vertices and links to the GPU
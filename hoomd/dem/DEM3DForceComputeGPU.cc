@@ -212,6 +212,8 @@ void DEM3DForceComputeGPU<Real, Real4, Potential>::computeForces(uint64_t timest
     if (this->m_pdata->getN() == 0)
         return;
 
+    // run the kernel on all GPUs in parallel
+    this->m_exec_conf->beginMultiGPU();
     m_tuner->begin();
     gpu_compute_dem3d_forces<Real, Real4, DEMEvaluator<Real, Real4, Potential>>(
         d_force.data,
@@ -249,11 +251,13 @@ void DEM3DForceComputeGPU<Real, Real4, Potential>::computeForces(uint64_t timest
         d_numTypeEdges.data,
         d_numTypeFaces.data,
         d_vertexConnectivity.data,
-        d_edges.data);
+        d_edges.data,
+        this->m_pdata->getGPUPartition());
 
     if (this->m_exec_conf->isCUDAErrorCheckingEnabled())
         CHECK_CUDA_ERROR();
     m_tuner->end();
+    this->m_exec_conf->endMultiGPU();
 
     Scalar avg_neigh = this->m_nlist->estimateNNeigh();
     int64_t n_calc = int64_t(avg_neigh * this->m_pdata->getN());
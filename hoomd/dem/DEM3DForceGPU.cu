@@ -35,7 +35,8 @@
   \param d_torque Device memory to write computed torques
   \param d_virial Device memory to write computed virials
   \param virial_pitch pitch of 3D virial array
-  \param N number of particles
+  \param N number of particles to compute forces for on this GPU
+  \param partOffset Index of the first particle handled by this GPU
   \param d_vertices Vertex indices on the GPU
   \param d_vertex_indices Vertex linkage indices on the GPU
   \param vertexCount Total number of vertices in all shapes
@@ -64,6 +65,7 @@ __global__ void gpu_compute_dem3d_forces_kernel(const Scalar4* d_pos,
                                                 Scalar* d_virial,
                                                 const size_t virial_pitch,
                                                 const unsigned int N,
+                                                const unsigned int partOffset,
                                                 const unsigned int* d_nextFaces,
                                                 const unsigned int* d_firstFaceVertices,
                                                 const unsigned int* d_nextVertices,
@@ -146,8 +148,10 @@ __global__ void gpu_compute_dem3d_forces_kernel(const Scalar4* d_pos,
     shOffset += numVerts;
 
     // partIdx is the absolute index of the particle this thread is
-    // calculating for
-    size_t partIdx(blockIdx.x * blockDim.x + threadIdx.x);
+    // calculating for; only the first N particles after partOffset
+    // are handled by this launch
+    bool activePart(blockIdx.x * blockDim.x + threadIdx.x < N);
+    const size_t partIdx(blockIdx.x * blockDim.x + threadIdx.x + partOffset);
 
     // localThreadIdx is just this thread's index in the block; use it
     // to load vertices
@@ -222,7 +226,7 @@ __global__ void gpu_compute_dem3d_forces_kernel(const Scalar4* d_pos,
 
     // Don't calculate results for nonsensical features
     if (threadIdx.y >= maxFeatures)
-        partIdx = N;
+        activePart = false;
 
     // zero the calculated force, torque, and virial for this particle
     // in this thread. Note that localForceTorque is (force.x,
@@ -237,7 +241,7 @@ __global__ void gpu_compute_dem3d_forces_kernel(const Scalar4* d_pos,
     // for the whole block
     __syncthreads();
 
-    if (partIdx < N)
+    if (activePart)
         {
         const unsigned int n_neigh(d_n_neigh[partIdx]);
         const unsigned int myHead(d_head_list[partIdx]);
@@ -490,7 +494,7 @@ __global__ void gpu_compute_dem3d_forces_kernel(const Scalar4* d_pos,
 
     // sum all the intermediate force and torque values for each
     // particle we calculate for in the block.
-    if (partIdx < N)
+    if (activePart)
         {
         genAtomicAdd((Real*)&partForces[threadIdx.x].x, (Real)localForce.x);
         genAtomicAdd((Real*)&partForces[threadIdx.x].y, (Real)localForce.y);
@@ -508,7 +512,7 @@ __global__ void gpu_compute_dem3d_forces_kernel(const Scalar4* d_pos,
     __syncthreads();
 
     // finally, write the result.
-    if (partIdx < N && threadIdx.y == 0)
+    if (activePart && threadIdx.y == 0)
         {
         partForces[threadIdx.x].w *= .5f;
         d_force[partIdx] = partForces[threadIdx.x];
@@ -538,11 +542,12 @@ __global__ void gpu_compute_dem3d_forces_kernel(const Scalar4* d_pos,
   force is set to 0
   \param particlesPerBlock Block size to execute
   \param maxVerts Maximum number of vertices in any shape
+  \param gpu_partition Range of particles handled by each GPU
 
   \returns Any error code resulting from the kernel launch
 
   This is just a driver for gpu_compute_dem3d_forces_kernel, see the documentation for it for more
-  information.
+  information. The kernel is launched once on every active GPU for its range of particles.
 */
 template<typename Real, typename Real4, typename Evaluator>
 hipError_t gpu_compute_dem3d_forces(Scalar4* d_force,
@@ -580,11 +585,9 @@ hipError_t gpu_compute_dem3d_forces(Scalar4* d_force,
                                     const unsigned int* d_numTypeEdges,
                                     const unsigned int* d_numTypeFaces,
                                     const unsigned int* d_vertexConnectivity,
-                                    const unsigned int* d_edges)
+                                    const unsigned int* d_edges,
+                                    const GPUPartition& gpu_partition)
     {
-    // setup the grid to run the kernel
-    dim3 grid((int)ceil((double)N / (double)particlesPerBlock), 1, 1);
-
     hipFuncAttributes attr;
     hipFuncGetAttributes(
         &attr,
@@ -605,46 +608,58 @@ hipError_t gpu_compute_dem3d_forces(Scalar4* d_force,
         5 * numTypes * sizeof(unsigned int)
         + numVerts * sizeof(unsigned int)); // per-type counts and per-vertex connectivity
 
-    // run the kernel
-    hipLaunchKernelGGL((gpu_compute_dem3d_forces_kernel<Real, Real4, Evaluator>),
-                       dim3(grid),
-                       dim3(threads),
-                       shmSize,
-                       0,
-                       d_pos,
-                       d_quat,
-                       d_force,
-                       d_torque,
-                       d_virial,
-                       virial_pitch,
-                       N,
-                       d_nextFaces,
-                       d_firstFaceVertices,
-                       d_nextVertices,
-                       d_realVertices,
-                       d_vertices,
-                       d_diam,
-                       d_velocity,
-                       maxFeatures,
-                       maxVertices,
-                       numFaces,
-                       numDegenerateVerts,
-                       numVerts,
-                       numEdges,
-                       numTypes,
-                       box,
-                       d_n_neigh,
-                       d_nlist,
-                       d_head_list,
-                       evaluator,
-                       r_cutsq,
-                       d_firstTypeVert,
-                       d_numTypeVerts,
-                       d_firstTypeEdge,
-                       d_numTypeEdges,
-                       d_numTypeFaces,
-                       d_vertexConnectivity,
-                       d_edges);
+    // run the kernel on all GPUs in parallel
+    for (int idev = gpu_partition.getNumActiveGPUs() - 1; idev >= 0; --idev)
+        {
+        auto range = gpu_partition.getRangeAndSetGPU(idev);
+        unsigned int nwork = range.second - range.first;
+        if (nwork == 0)
+            continue;
+
+        // setup the grid to run the kernel
+        dim3 grid((int)ceil((double)nwork / (double)particlesPerBlock), 1, 1);
+
+        hipLaunchKernelGGL((gpu_compute_dem3d_forces_kernel<Real, Real4, Evaluator>),
+                           dim3(grid),
+                           dim3(threads),
+                           shmSize,
+                           0,
+                           d_pos,
+                           d_quat,
+                           d_force,
+                           d_torque,
+                           d_virial,
+                           virial_pitch,
+                           nwork,
+                           range.first,
+                           d_nextFaces,
+                           d_firstFaceVertices,
+                           d_nextVertices,
+                           d_realVertices,
+                           d_vertices,
+                           d_diam,
+                           d_velocity,
+                           maxFeatures,
+                           maxVertices,
+                           numFaces,
+                           numDegenerateVerts,
+                           numVerts,
+                           numEdges,
+                           numTypes,
+                           box,
+                           d_n_neigh,
+                           d_nlist,
+                           d_head_list,
+                           evaluator,
+                           r_cutsq,
+                           d_firstTypeVert,
+                           d_numTypeVerts,
+                           d_firstTypeEdge,
+                           d_numTypeEdges,
+                           d_numTypeFaces,
+                           d_vertexConnectivity,
+                           d_edges);
+        }
 
     return hipSuccess;
     }
@@ -5,6 +5,7 @@
 
 #include "DEMEvaluator.h"
 #include "hoomd/BoxDim.h"
+#include "hoomd/GPUPartition.cuh"
 #include "hoomd/HOOMDMath.h"
 #include "hoomd/Index1D.h"
 
@@ -56,7 +57,8 @@ hipError_t gpu_compute_dem3d_forces(Scalar4* d_force,
                                     const unsigned int* d_numTypeEdges,
                                     const unsigned int* d_numTypeFaces,
                                     const unsigned int* d_vertexConnectivity,
-                                    const unsigned int* d_edges);
+                                    const unsigned int* d_edges,
+                                    const GPUPartition& gpu_partition);
 
 #endif
 
@@ -143,6 +143,14 @@ template<typename Real, typename Real4, typename Potential> class DEMEvaluator
         return m_potential.withinCutoff(rsq, r_cut_sq);
         }
 
+    /*! Largest distance between two contact points (vertices, or
+      points on edges and faces) that still interact
+     */
+    DEVICE inline Real getContactCutoff() const
+        {
+        return m_potential.getContactCutoff();
+        }
+
     DEVICE static bool needsDiameter()
         {
         return Potential::needsDiameter();
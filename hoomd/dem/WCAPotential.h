@@ -92,6 +92,12 @@ template<typename Real, typename Real4, typename FrictionModel> class WCAPotenti
         return rsq < r_cutsq;
         }
 
+    /*! Largest distance between two contact points that interact */
+    DEVICE inline Real getContactCutoff() const
+        {
+        return sqrt(m_rcutsq);
+        }
+
     /*! Test if potential needs the diameter (It doesn't) */
     DEVICE static bool needsDiameter()
         {
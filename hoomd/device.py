@@ -6,9 +6,10 @@
 import contextlib
 import hoomd
 from hoomd import _hoomd
+from hoomd.logging import log, Loggable
 
 
-class Device:
+class Device(metaclass=Loggable):
     """Base class device object.
 
     Provides methods and properties common to `CPU` and `GPU`.
@@ -122,6 +123,58 @@ class Device:
         else:
             self._cpp_exec_conf.setNumThreads(int(num_cpu_threads))
 
+    @property
+    def shrink_fraction(self):
+        """float: Fraction of capacity below which growable arrays shrink.
+
+        Growable arrays (such as the neighbor list, cell list, and ghost
+        particle buffers) allocate extra capacity as they grow. When an array
+        stays below `shrink_fraction` of its capacity for `shrink_delay`
+        consecutive resizes, HOOMD frees the unused memory. Set to 0 to keep
+        the peak allocation for the rest of the run. Must be in the range
+        [0, 1). Defaults to 0.
+        """
+        return self._cpp_exec_conf.getShrinkFraction()
+
+    @shrink_fraction.setter
+    def shrink_fraction(self, value):
+        self._cpp_exec_conf.setShrinkFraction(float(value))
+
+    @property
+    def shrink_delay(self):
+        """int: Number of consecutive resizes below `shrink_fraction` before \
+        an array shrinks.
+
+        Larger values avoid repeated reallocation of arrays whose size
+        fluctuates. Defaults to 100.
+        """
+        return self._cpp_exec_conf.getShrinkDelay()
+
+    @shrink_delay.setter
+    def shrink_delay(self, value):
+        self._cpp_exec_conf.setShrinkDelay(int(value))
+
+    @log(is_property=False, category='object', default=False)
+    def memory_report(self):
+        """Report the memory held by the arrays allocated on this rank.
+
+        Returns:
+            dict[str, int]: Number of bytes allocated, keyed by the owning class
+            and member name (for example ``hoomd::md::NeighborList::m_nlist``).
+            Arrays without an owner are summed under ``untagged``.
+
+        The report includes the arrays that HOOMD allocates to store the
+        particle data and the internal data of operations. Arrays on the GPU
+        have a host or managed memory copy of the same size. The per-step
+        arenas for temporary buffers are reported under ``StepArena::host``
+        and ``StepArena::device``.
+
+        Use the report to find the structures that take up the most memory
+        in large systems. To log it, add the device to a `hoomd.logging.Logger`
+        with ``logger.add(sim.device, quantities=['memory_report'])``.
+        """
+        return self._cpp_exec_conf.getMemoryReport()
+
 
 def _create_messenger(mpi_config, notice_level, msg_file):
     msg = _hoomd.Messenger(mpi_config)
@@ -223,6 +276,8 @@ class GPU(Device):
         """bool: Whether GPU memory tracebacks should be enabled.
 
         Memory tracebacks are useful for developers when debugging GPU code.
+        Memory is accounted for in `memory_report` regardless of this setting,
+        `memory_traceback` also records a stack trace with every allocation.
         """
         return self._cpp_exec_conf.memoryTracingEnabled()
 
@@ -231,6 +286,46 @@ class GPU(Device):
 
         self._cpp_exec_conf.setMemoryTracing(mem_traceback)
 
+    @property
+    def transfer_tracing(self):
+        """bool: Whether to record implicit host/device copies of arrays.
+
+        HOOMD copies an array between the host and the GPU when code accesses
+        it on one side after the other side has modified it. A single host
+        side access per step, for example in a CPU only analyzer or updater,
+        can significantly slow down a GPU simulation. When `transfer_tracing`
+        is `True`, HOOMD counts these copies per array and direction in
+        `transfer_report` and `Simulation.run` prints a summary of the copies
+        made during the run at the end. Set `memory_traceback` to `True` to
+        also record the function that accessed the array. Defaults to
+        `False`.
+
+        Setting `transfer_tracing` clears the recorded copies.
+        """
+        return self._cpp_exec_conf.getTransferTracing()
+
+    @transfer_tracing.setter
+    def transfer_tracing(self, value):
+        self._cpp_exec_conf.resetTransferReport()
+        self._cpp_exec_conf.setTransferTracing(bool(value))
+
+    @log(is_property=False, category='object', default=False)
+    def transfer_report(self):
+        """Report the implicit host/device copies recorded on this rank.
+
+        Returns:
+            dict[str, tuple[int, int]]: Number of copies and number of bytes
+            copied, keyed by the array name and direction (for example
+            ``hoomd::ParticleData::m_pos device->host``). When
+            `memory_traceback` is `True`, the key also names the function that
+            accessed the array.
+
+        The counts accumulate from the time `transfer_tracing` is enabled.
+        Log the report with a `hoomd.logging.Logger` and compare consecutive
+        entries to obtain the copies made between them.
+        """
+        return self._cpp_exec_conf.getTransferReport()
+
     @property
     def gpu_error_checking(self):
         """bool: Whether to check for GPU error conditions after every call.
@@ -245,6 +340,24 @@ class GPU(Device):
     def gpu_error_checking(self, new_bool):
         self._cpp_exec_conf.setCUDAErrorChecking(new_bool)
 
+    @property
+    def deterministic(self):
+        """bool: Whether to sum forces on the GPU in a reproducible order.
+
+        When `True`, pair and bond forces are summed in 64-bit fixed point
+        and rigid body forces in a fixed order, so that repeated runs on the
+        same GPU with the same inputs give bitwise identical trajectories.
+        This costs some performance. Defaults to `False`.
+
+        Note:
+            Pair forces are reproducible only on a single GPU per rank.
+        """
+        return self._cpp_exec_conf.getDeterministic()
+
+    @deterministic.setter
+    def deterministic(self, value):
+        self._cpp_exec_conf.setDeterministic(bool(value))
+
     @property
     def compute_capability(self):
         """tuple(int, int): Compute capability of the device.
@@ -292,6 +405,11 @@ class GPU(Device):
         context manager and continue the simulation for a time. Profiling stops
         when the context manager closes.
 
+        When HOOMD is built with ``ENABLE_NVTOOLS`` or ``ENABLE_ROCTRACER``, the
+        timeline shows a range for every operation that `Simulation.run`
+        executes, named after the class of the operation (for example,
+        ``LJ`` or ``GSD``).
+
         Example::
 
             with device.enable_profiling():
@@ -303,6 +421,40 @@ class GPU(Device):
         finally:
             self._cpp_exec_conf.hipProfileStop()
 
+    def load_tuning_cache(self, filename):
+        """Load autotuner results from a file.
+
+        Args:
+            filename (str): Name of a file written by `save_tuning_cache`.
+
+        Autotuners that find their kernel in the cache use the cached parameters
+        and skip the initial scan over all parameters. Entries match by kernel,
+        GPU model, valid parameters, and (for some kernels) the number of
+        particles rounded down to a power of 2. Call `load_tuning_cache` before
+        the first call to `Simulation.run`.
+
+        Every MPI rank reads the file.
+        """
+        self._cpp_exec_conf.loadTuningCache(filename)
+
+    def save_tuning_cache(self, filename):
+        """Save autotuner results to a file.
+
+        Args:
+            filename (str): Name of the file to write.
+
+        The file includes the results of every autotuner scan completed so far
+        with this device and any entries loaded with `load_tuning_cache`. Only
+        the root MPI rank writes the file.
+
+        Example::
+
+            sim.run(10000)
+            device.save_tuning_cache('tuning.txt')
+        """
+        if self.communicator.rank == 0:
+            self._cpp_exec_conf.saveTuningCache(filename)
+
 
 class CPU(Device):
     """Select the CPU to execute simulations.
@@ -2,7 +2,10 @@
 # find_package(ACML QUIET)
 
 option(ENABLE_HOST "CPU FFT support" ON)
-if (MKL_LIBRARIES AND MKL_INCLUDE_DIR)
+if (ENABLE_FFTW)
+    # FFTW is set up by hoomd
+    set(LOCAL_FFT_LIB LOCAL_LIB_FFTW)
+elseif (MKL_LIBRARIES AND MKL_INCLUDE_DIR)
     set(LOCAL_FFT_LIB LOCAL_LIB_MKL)
     set(LOCAL_FFT_LIBRARIES "${MKL_LIBRARIES}")
     include_directories(${MKL_INCLUDE_DIR})
@@ -7,7 +7,11 @@
 #ifdef ENABLE_HOST
 /* Local FFT library for host DFFT */
 
-#if (LOCAL_FFT_LIB == LOCAL_LIB_MKL)
+#if (LOCAL_FFT_LIB == LOCAL_LIB_FFTW)
+/* FFTW, single precision */
+#include "fftw_single_interface.h"
+
+#elif (LOCAL_FFT_LIB == LOCAL_LIB_MKL)
 /* MKL, single precision is the default library*/
 #include "mkl_single_interface.h"
 
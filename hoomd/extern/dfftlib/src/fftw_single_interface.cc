@@ -0,0 +1,74 @@
+/* FFTW3 (single precision) backend for distributed FFT, implementation
+ */
+
+#include "fftw_single_interface.h"
+
+/* Initialize the library
+ */
+int dfft_init_local_fft()
+    {
+    return 0;
+    }
+
+/* De-initialize the library
+ */
+void dfft_teardown_local_fft()
+    {
+    /* do not call fftwf_cleanup(), other plans may be in use in the same process */
+    }
+
+/* Create a FFTW plan
+ *
+ * sign = 0 (forward) or 1 (inverse)
+ */
+int dfft_create_1d_plan(
+    plan_t *plan,
+    int dim,
+    int howmany,
+    int istride,
+    int idist,
+    int ostride,
+    int odist,
+    int dir)
+    {
+    /* FFTW_ESTIMATE does not touch the arrays, and with FFTW_UNALIGNED the plan can be
+     * executed on any out-of-place pair of arrays */
+    fftwf_complex *in = fftwf_alloc_complex(1);
+    fftwf_complex *out = fftwf_alloc_complex(1);
+    *plan = fftwf_plan_many_dft(1, &dim, howmany,
+        in, NULL, istride, idist,
+        out, NULL, ostride, odist,
+        dir ? FFTW_BACKWARD : FFTW_FORWARD,
+        FFTW_ESTIMATE | FFTW_UNALIGNED);
+    fftwf_free(in);
+    fftwf_free(out);
+    return (*plan == NULL);
+    }
+
+int dfft_allocate_aligned_memory(cpx_t **ptr, size_t size)
+    {
+    *ptr = (cpx_t *) fftwf_malloc(size);
+    return (*ptr == NULL);
+    }
+
+void dfft_free_aligned_memory(cpx_t *ptr)
+    {
+    fftwf_free(ptr);
+    }
+
+/* Destroy a 1d plan */
+void dfft_destroy_1d_plan(plan_t *p)
+    {
+    fftwf_destroy_plan(*p);
+    }
+
+/* Excecute a local 1D FFT
+ */
+void dfft_local_1dfft(
+    cpx_t *in,
+    cpx_t *out,
+    plan_t p,
+    int dir)
+    {
+    fftwf_execute_dft(p, (fftwf_complex *) in, (fftwf_complex *) out);
+    }
@@ -4,8 +4,13 @@
 #include "../SystemDefinition.h"
 #include <memory>
 #include <pybind11/pybind11.h>
+#include <stdexcept>
 #include <vector>
 
+#ifdef ENABLE_HIP
+#include "ParticleFilterGPU.cuh"
+#endif
+
 /// Utility class to select particles based on given conditions
 /** \b Overview
 
@@ -27,6 +32,14 @@
     rank.
 
     The base class getSelectedTags() method returns an empty vector.
+
+    <b>GPU evaluation</b> Filters that test each particle independently of the
+    others (by type, tag, or position) can also evaluate the test on the GPU.
+    Such filters return true from hasGPUFlags() and implement
+    computeGPUFlags(), which sets one membership flag per local particle in
+    device memory. ParticleGroup uses the flags to build its member lists on the
+    device, without calling getSelectedTags(). Set operations support the GPU
+    path when both of their operands do.
 */
 class PYBIND11_EXPORT ParticleFilter
     {
@@ -43,5 +56,25 @@ class PYBIND11_EXPORT ParticleFilter
         {
         return std::vector<unsigned int>();
         }
+
+    /// Test if the filter can compute membership flags on the GPU
+    virtual bool hasGPUFlags() const
+        {
+        return false;
+        }
+
+#ifdef ENABLE_HIP
+    /** Compute membership flags on the GPU
+     *  Args:
+     *  sysdef: system definition to evaluate the filter on
+     *  d_flags: device array with one element per local particle, set to 1
+     *           for selected particles and 0 otherwise
+     */
+    virtual void computeGPUFlags(std::shared_ptr<SystemDefinition> sysdef,
+                                 unsigned int* d_flags) const
+        {
+        throw std::runtime_error("This particle filter cannot be evaluated on the GPU");
+        }
+#endif
     };
 #endif
@@ -33,5 +33,20 @@ class PYBIND11_EXPORT ParticleFilterAll : public ParticleFilter
         std::copy_n(h_tag.data, N, member_tags.begin());
         return member_tags;
         }
+
+    /// All is evaluated on the GPU
+    virtual bool hasGPUFlags() const
+        {
+        return true;
+        }
+
+#ifdef ENABLE_HIP
+    /// Select every local particle
+    virtual void computeGPUFlags(std::shared_ptr<SystemDefinition> sysdef,
+                                 unsigned int* d_flags) const
+        {
+        gpu_filter_fill(sysdef->getParticleData()->getN(), d_flags, 1);
+        }
+#endif
     };
 #endif
@@ -0,0 +1,256 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file ParticleFilterGPU.cu
+    \brief Defines GPU kernel drivers that evaluate particle filters
+*/
+
+#include "ParticleFilterGPU.cuh"
+
+//! Kernel to set the membership flags to a constant
+__global__ void gpu_filter_fill_kernel(unsigned int N, unsigned int* d_flags, unsigned int value)
+    {
+    unsigned int idx = blockIdx.x * blockDim.x + threadIdx.x;
+    if (idx >= N)
+        return;
+
+    d_flags[idx] = value;
+    }
+
+//! Kernel to select particles by type
+/*! \param N Number of local particles
+    \param d_postype Particle positions and types
+    \param d_type_selected Flag for each type, nonzero if the type is selected
+    \param n_types Number of types
+    \param d_flags Membership flags (output)
+
+    The per-type flags are staged in shared memory.
+*/
+__global__ void gpu_filter_type_kernel(unsigned int N,
+                                       const Scalar4* d_postype,
+                                       const unsigned int* d_type_selected,
+                                       unsigned int n_types,
+                                       unsigned int* d_flags)
+    {
+    HIP_DYNAMIC_SHARED(unsigned int, s_type_selected)
+    for (unsigned int cur = threadIdx.x; cur < n_types; cur += blockDim.x)
+        s_type_selected[cur] = d_type_selected[cur];
+    __syncthreads();
+
+    unsigned int idx = blockIdx.x * blockDim.x + threadIdx.x;
+    if (idx >= N)
+        return;
+
+    const unsigned int type = __scalar_as_int(d_postype[idx].w);
+    d_flags[idx] = (type < n_types && s_type_selected[type]) ? 1 : 0;
+    }
+
+//! Kernel to select particles with tags in a sorted list
+__global__ void gpu_filter_tags_kernel(unsigned int N,
+                                       const unsigned int* d_tag,
+                                       const unsigned int* d_sorted_tags,
+                                       unsigned int n_tags,
+                                       unsigned int* d_flags)
+    {
+    unsigned int idx = blockIdx.x * blockDim.x + threadIdx.x;
+    if (idx >= N)
+        return;
+
+    // binary search for the first selected tag that is not less than this tag
+    const unsigned int tag = d_tag[idx];
+    unsigned int first = 0;
+    unsigned int last = n_tags;
+    while (first < last)
+        {
+        const unsigned int mid = first + (last - first) / 2;
+        if (d_sorted_tags[mid] < tag)
+            first = mid + 1;
+        else
+            last = mid;
+        }
+
+    d_flags[idx] = (first < n_tags && d_sorted_tags[first] == tag) ? 1 : 0;
+    }
+
+//! Kernel to select particles inside an axis-aligned region
+__global__ void gpu_filter_region_kernel(unsigned int N,
+                                         const Scalar4* d_postype,
+                                         const Scalar3 lower,
+                                         const Scalar3 upper,
+                                         unsigned int* d_flags)
+    {
+    unsigned int idx = blockIdx.x * blockDim.x + threadIdx.x;
+    if (idx >= N)
+        return;
+
+    const Scalar4 postype = d_postype[idx];
+    const bool inside = postype.x >= lower.x && postype.x < upper.x && postype.y >= lower.y
+                        && postype.y < upper.y && postype.z >= lower.z && postype.z < upper.z;
+    d_flags[idx] = inside ? 1 : 0;
+    }
+
+//! Kernel to combine two arrays of membership flags
+__global__ void gpu_filter_combine_kernel(unsigned int N,
+                                          unsigned int* d_flags,
+                                          const unsigned int* d_other,
+                                          gpu_filter_op op)
+    {
+    unsigned int idx = blockIdx.x * blockDim.x + threadIdx.x;
+    if (idx >= N)
+        return;
+
+    const bool f = d_flags[idx];
+    const bool g = d_other[idx];
+    bool result;
+    if (op == gpu_filter_intersection)
+        result = f && g;
+    else if (op == gpu_filter_union)
+        result = f || g;
+    else
+        result = f && !g;
+    d_flags[idx] = result ? 1 : 0;
+    }
+
+/*! \param N Number of local particles
+    \param d_flags Membership flags (output)
+    \param value Value to set
+*/
+hipError_t gpu_filter_fill(unsigned int N, unsigned int* d_flags, unsigned int value)
+    {
+    if (N == 0)
+        return hipSuccess;
+
+    unsigned int block_size = 256;
+    unsigned int n_blocks = N / block_size + 1;
+
+    hipLaunchKernelGGL(gpu_filter_fill_kernel,
+                       dim3(n_blocks),
+                       dim3(block_size),
+                       0,
+                       0,
+                       N,
+                       d_flags,
+                       value);
+    return hipSuccess;
+    }
+
+/*! \param N Number of local particles
+    \param d_postype Particle positions and types
+    \param d_type_selected Flag for each type, nonzero if the type is selected
+    \param n_types Number of types
+    \param d_flags Membership flags (output)
+*/
+hipError_t gpu_filter_type(unsigned int N,
+                           const Scalar4* d_postype,
+                           const unsigned int* d_type_selected,
+                           unsigned int n_types,
+                           unsigned int* d_flags)
+    {
+    if (N == 0)
+        return hipSuccess;
+
+    unsigned int block_size = 256;
+    unsigned int n_blocks = N / block_size + 1;
+
+    hipLaunchKernelGGL(gpu_filter_type_kernel,
+                       dim3(n_blocks),
+                       dim3(block_size),
+                       n_types * sizeof(unsigned int),
+                       0,
+                       N,
+                       d_postype,
+                       d_type_selected,
+                       n_types,
+                       d_flags);
+    return hipSuccess;
+    }
+
+/*! \param N Number of local particles
+    \param d_tag Particle tags
+    \param d_sorted_tags Selected tags in ascending order
+    \param n_tags Number of selected tags
+    \param d_flags Membership flags (output)
+*/
+hipError_t gpu_filter_tags(unsigned int N,
+                           const unsigned int* d_tag,
+                           const unsigned int* d_sorted_tags,
+                           unsigned int n_tags,
+                           unsigned int* d_flags)
+    {
+    if (N == 0)
+        return hipSuccess;
+
+    unsigned int block_size = 256;
+    unsigned int n_blocks = N / block_size + 1;
+
+    hipLaunchKernelGGL(gpu_filter_tags_kernel,
+                       dim3(n_blocks),
+                       dim3(block_size),
+                       0,
+                       0,
+                       N,
+                       d_tag,
+                       d_sorted_tags,
+                       n_tags,
+                       d_flags);
+    return hipSuccess;
+    }
+
+/*! \param N Number of local particles
+    \param d_postype Particle positions and types
+    \param lower Lower corner of the region (inclusive)
+    \param upper Upper corner of the region (exclusive)
+    \param d_flags Membership flags (output)
+*/
+hipError_t gpu_filter_region(unsigned int N,
+                             const Scalar4* d_postype,
+                             const Scalar3 lower,
+                             const Scalar3 upper,
+                             unsigned int* d_flags)
+    {
+    if (N == 0)
+        return hipSuccess;
+
+    unsigned int block_size = 256;
+    unsigned int n_blocks = N / block_size + 1;
+
+    hipLaunchKernelGGL(gpu_filter_region_kernel,
+                       dim3(n_blocks),
+                       dim3(block_size),
+                       0,
+                       0,
+                       N,
+                       d_postype,
+                       lower,
+                       upper,
+                       d_flags);
+    return hipSuccess;
+    }
+
+/*! \param N Number of local particles
+    \param d_flags Membership flags of the first filter, replaced by the combination
+    \param d_other Membership flags of the second filter
+    \param op Set operation to apply
+*/
+hipError_t gpu_filter_combine(unsigned int N,
+                              unsigned int* d_flags,
+                              const unsigned int* d_other,
+                              gpu_filter_op op)
+    {
+    if (N == 0)
+        return hipSuccess;
+
+    unsigned int block_size = 256;
+    unsigned int n_blocks = N / block_size + 1;
+
+    hipLaunchKernelGGL(gpu_filter_combine_kernel,
+                       dim3(n_blocks),
+                       dim3(block_size),
+                       0,
+                       0,
+                       N,
+                       d_flags,
+                       d_other,
+                       op);
+    return hipSuccess;
+    }
@@ -0,0 +1,52 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file ParticleFilterGPU.cuh
+    \brief Declares GPU kernel drivers that evaluate particle filters
+*/
+
+#ifndef __PARTICLE_FILTER_GPU_CUH__
+#define __PARTICLE_FILTER_GPU_CUH__
+
+#include "hoomd/HOOMDMath.h"
+#include <hip/hip_runtime.h>
+
+//! Set operations that combine two arrays of membership flags
+enum gpu_filter_op
+    {
+    gpu_filter_intersection, //!< Selected by both filters
+    gpu_filter_union,        //!< Selected by either filter
+    gpu_filter_difference    //!< Selected by the first filter but not the second
+    };
+
+//! Set the membership flags of all particles to the same value
+hipError_t gpu_filter_fill(unsigned int N, unsigned int* d_flags, unsigned int value);
+
+//! Select particles by type
+hipError_t gpu_filter_type(unsigned int N,
+                           const Scalar4* d_postype,
+                           const unsigned int* d_type_selected,
+                           unsigned int n_types,
+                           unsigned int* d_flags);
+
+//! Select particles with tags in a sorted list
+hipError_t gpu_filter_tags(unsigned int N,
+                           const unsigned int* d_tag,
+                           const unsigned int* d_sorted_tags,
+                           unsigned int n_tags,
+                           unsigned int* d_flags);
+
+//! Select particles with positions inside an axis-aligned region
+hipError_t gpu_filter_region(unsigned int N,
+                             const Scalar4* d_postype,
+                             const Scalar3 lower,
+                             const Scalar3 upper,
+                             unsigned int* d_flags);
+
+//! Combine the membership flags of a second filter into the first
+hipError_t gpu_filter_combine(unsigned int N,
+                              unsigned int* d_flags,
+                              const unsigned int* d_other,
+                              gpu_filter_op op);
+
+#endif // __PARTICLE_FILTER_GPU_CUH__
@@ -22,4 +22,19 @@ class PYBIND11_EXPORT ParticleFilterNull : public ParticleFilter
         std::vector<unsigned int> member_tags;
         return member_tags;
         }
+
+    /// Null is evaluated on the GPU
+    virtual bool hasGPUFlags() const
+        {
+        return true;
+        }
+
+#ifdef ENABLE_HIP
+    /// Select no particles
+    virtual void computeGPUFlags(std::shared_ptr<SystemDefinition> sysdef,
+                                 unsigned int* d_flags) const
+        {
+        gpu_filter_fill(sysdef->getParticleData()->getN(), d_flags, 0);
+        }
+#endif
     };
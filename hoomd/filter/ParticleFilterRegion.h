@@ -0,0 +1,96 @@
+#ifndef __PARTICLE_FILTER_REGION_H__
+#define __PARTICLE_FILTER_REGION_H__
+
+#include "ParticleFilter.h"
+#include <pybind11/stl.h>
+
+/// Select particles inside an axis-aligned region
+/** The region includes its lower bounds and excludes its upper bounds. Bounds may be infinite,
+    which selects half spaces (e.g. z > 10) or slabs.
+*/
+class PYBIND11_EXPORT ParticleFilterRegion : public ParticleFilter
+    {
+    public:
+    /** Constructs the selector
+     *  Args:
+     *  lower: lower corner of the region
+     *  upper: upper corner of the region
+     */
+    ParticleFilterRegion(Scalar3 lower, Scalar3 upper)
+        : ParticleFilter(), m_lower(lower), m_upper(upper)
+        {
+        }
+
+    /** Constructs the selector
+     *  Args:
+     *  lower: tuple (x, y, z) of the lower corner of the region
+     *  upper: tuple (x, y, z) of the upper corner of the region
+     */
+    ParticleFilterRegion(pybind11::tuple lower, pybind11::tuple upper)
+        : ParticleFilter(),
+          m_lower(make_scalar3(lower[0].cast<Scalar>(),
+                               lower[1].cast<Scalar>(),
+                               lower[2].cast<Scalar>())),
+          m_upper(make_scalar3(upper[0].cast<Scalar>(),
+                               upper[1].cast<Scalar>(),
+                               upper[2].cast<Scalar>()))
+        {
+        }
+
+    virtual ~ParticleFilterRegion() { }
+
+    /** Test if a particle meets the selection criteria
+     *  sysdef: system definition to find tags for
+     *
+     *  Returns:
+     *  tags of all rank local particles inside the region
+     */
+    virtual std::vector<unsigned int>
+    getSelectedTags(std::shared_ptr<SystemDefinition> sysdef) const
+        {
+        const auto pdata = sysdef->getParticleData();
+        const ArrayHandle<unsigned int> h_tag(pdata->getTags(),
+                                              access_location::host,
+                                              access_mode::read);
+        const ArrayHandle<Scalar4> h_postype(pdata->getPositions(),
+                                             access_location::host,
+                                             access_mode::read);
+
+        std::vector<unsigned int> member_tags;
+        const auto N = pdata->getN();
+        for (unsigned int idx = 0; idx < N; ++idx)
+            {
+            const Scalar4 postype = h_postype.data[idx];
+            if (postype.x >= m_lower.x && postype.x < m_upper.x && postype.y >= m_lower.y
+                && postype.y < m_upper.y && postype.z >= m_lower.z && postype.z < m_upper.z)
+                {
+                member_tags.push_back(h_tag.data[idx]);
+                }
+            }
+        return member_tags;
+        }
+
+    /// Region is evaluated on the GPU
+    virtual bool hasGPUFlags() const
+        {
+        return true;
+        }
+
+#ifdef ENABLE_HIP
+    /// Select local particles inside the region
+    virtual void computeGPUFlags(std::shared_ptr<SystemDefinition> sysdef,
+                                 unsigned int* d_flags) const
+        {
+        const auto pdata = sysdef->getParticleData();
+        ArrayHandle<Scalar4> d_postype(pdata->getPositions(),
+                                       access_location::device,
+                                       access_mode::read);
+        gpu_filter_region(pdata->getN(), d_postype.data, m_lower, m_upper, d_flags);
+        }
+#endif
+
+    protected:
+    Scalar3 m_lower; ///< Lower corner of the region
+    Scalar3 m_upper; ///< Upper corner of the region
+    };
+#endif
@@ -2,8 +2,13 @@
 #define __PARTICLE_FILTER_TAGS_H__
 
 #include "ParticleFilter.h"
+#include <algorithm>
 #include <pybind11/numpy.h>
 
+#ifdef ENABLE_HIP
+#include "hoomd/CachedAllocator.h"
+#endif
+
 /// Select particles based on their tag
 class PYBIND11_EXPORT ParticleFilterTags : public ParticleFilter
     {
@@ -11,7 +16,10 @@ class PYBIND11_EXPORT ParticleFilterTags : public ParticleFilter
     /** Args:
      *  tags: std::vector of tags to select
      */
-    ParticleFilterTags(std::vector<unsigned int> tags) : ParticleFilter(), m_tags(tags) { }
+    ParticleFilterTags(std::vector<unsigned int> tags) : ParticleFilter(), m_tags(tags)
+        {
+        sortTags();
+        }
 
     /** Args:
      *  tags: pybind11::array of tags to select
@@ -22,6 +30,7 @@ class PYBIND11_EXPORT ParticleFilterTags : public ParticleFilter
         {
         unsigned int* tags_ptr = (unsigned int*)tags.data();
         m_tags.assign(tags_ptr, tags_ptr + tags.size());
+        sortTags();
         }
 
     virtual ~ParticleFilterTags() { }
@@ -38,7 +47,44 @@ class PYBIND11_EXPORT ParticleFilterTags : public ParticleFilter
         return m_tags;
         }
 
+    /// Tags is evaluated on the GPU
+    virtual bool hasGPUFlags() const
+        {
+        return true;
+        }
+
+#ifdef ENABLE_HIP
+    /// Select local particles with tags in m_tags
+    virtual void computeGPUFlags(std::shared_ptr<SystemDefinition> sysdef,
+                                 unsigned int* d_flags) const
+        {
+        const auto pdata = sysdef->getParticleData();
+        const unsigned int n_tags = (unsigned int)m_sorted_tags.size();
+        ScopedAllocation<unsigned int> d_sorted_tags(pdata->getExecConf()->getCachedAllocator(),
+                                                     n_tags);
+        hipMemcpy(d_sorted_tags.data,
+                  m_sorted_tags.data(),
+                  sizeof(unsigned int) * n_tags,
+                  hipMemcpyHostToDevice);
+
+        ArrayHandle<unsigned int> d_tag(pdata->getTags(),
+                                        access_location::device,
+                                        access_mode::read);
+        gpu_filter_tags(pdata->getN(), d_tag.data, d_sorted_tags.data, n_tags, d_flags);
+        }
+#endif
+
     protected:
-    std::vector<unsigned int> m_tags; //< Tags to use for filter
+    std::vector<unsigned int> m_tags;        //< Tags to use for filter
+    std::vector<unsigned int> m_sorted_tags; //< Unique tags in ascending order, for searching
+
+    /// Build the sorted list of unique tags
+    void sortTags()
+        {
+        m_sorted_tags = m_tags;
+        std::sort(m_sorted_tags.begin(), m_sorted_tags.end());
+        m_sorted_tags.erase(std::unique(m_sorted_tags.begin(), m_sorted_tags.end()),
+                            m_sorted_tags.end());
+        }
     };
 #endif
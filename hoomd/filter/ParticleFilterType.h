@@ -6,6 +6,10 @@
 #include <string>
 #include <unordered_set>
 
+#ifdef ENABLE_HIP
+#include "hoomd/CachedAllocator.h"
+#endif
+
 //! Select particles based on their type
 class PYBIND11_EXPORT ParticleFilterType : public ParticleFilter
     {
@@ -64,6 +68,39 @@ class PYBIND11_EXPORT ParticleFilterType : public ParticleFilter
         return member_tags;
         }
 
+    /// Type is evaluated on the GPU
+    virtual bool hasGPUFlags() const
+        {
+        return true;
+        }
+
+#ifdef ENABLE_HIP
+    /// Select local particles of types in m_types
+    virtual void computeGPUFlags(std::shared_ptr<SystemDefinition> sysdef,
+                                 unsigned int* d_flags) const
+        {
+        const auto pdata = sysdef->getParticleData();
+        const unsigned int n_types = pdata->getNTypes();
+        std::vector<unsigned int> type_selected(n_types, 0);
+        for (auto type_str : m_types)
+            {
+            type_selected[pdata->getTypeByName(type_str)] = 1;
+            }
+
+        ScopedAllocation<unsigned int> d_type_selected(pdata->getExecConf()->getCachedAllocator(),
+                                                       n_types);
+        hipMemcpy(d_type_selected.data,
+                  type_selected.data(),
+                  sizeof(unsigned int) * n_types,
+                  hipMemcpyHostToDevice);
+
+        ArrayHandle<Scalar4> d_postype(pdata->getPositions(),
+                                       access_location::device,
+                                       access_mode::read);
+        gpu_filter_type(pdata->getN(), d_postype.data, d_type_selected.data, n_types, d_flags);
+        }
+#endif
+
     protected:
     std::unordered_set<std::string> m_types; ///< Set of types to select
     };
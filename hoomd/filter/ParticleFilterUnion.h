@@ -4,6 +4,10 @@
 #include "ParticleFilter.h"
 #include <algorithm>
 
+#ifdef ENABLE_HIP
+#include "hoomd/CachedAllocator.h"
+#endif
+
 class PYBIND11_EXPORT ParticleFilterUnion : public ParticleFilter
     {
     public:
@@ -43,6 +47,26 @@ class PYBIND11_EXPORT ParticleFilterUnion : public ParticleFilter
         return tags;
         }
 
+    /// The union is evaluated on the GPU when both operands are
+    virtual bool hasGPUFlags() const
+        {
+        return m_f->hasGPUFlags() && m_g->hasGPUFlags();
+        }
+
+#ifdef ENABLE_HIP
+    /// Combine the flags of m_f and m_g
+    virtual void computeGPUFlags(std::shared_ptr<SystemDefinition> sysdef,
+                                 unsigned int* d_flags) const
+        {
+        const auto pdata = sysdef->getParticleData();
+        ScopedAllocation<unsigned int> d_other(pdata->getExecConf()->getCachedAllocator(),
+                                               pdata->getN());
+        m_f->computeGPUFlags(sysdef, d_flags);
+        m_g->computeGPUFlags(sysdef, d_other.data);
+        gpu_filter_combine(pdata->getN(), d_flags, d_other.data, gpu_filter_union);
+        }
+#endif
+
     protected:
     std::shared_ptr<ParticleFilter> m_f;
     std::shared_ptr<ParticleFilter> m_g;
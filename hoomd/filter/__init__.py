@@ -25,6 +25,7 @@ count.
 from hoomd.filter.filter_ import ParticleFilter
 from hoomd.filter.all_ import All
 from hoomd.filter.null import Null
+from hoomd.filter.region import Region
 from hoomd.filter.rigid import Rigid
 from hoomd.filter.set_ import Intersection, SetDifference, Union
 from hoomd.filter.tags import Tags
@@ -4,6 +4,7 @@
 #include "ParticleFilterCustom.h"
 #include "ParticleFilterIntersection.h"
 #include "ParticleFilterNull.h"
+#include "ParticleFilterRegion.h"
 #include "ParticleFilterRigid.h"
 #include "ParticleFilterSetDifference.h"
 #include "ParticleFilterTags.h"
@@ -60,4 +61,9 @@ void export_ParticleFilters(pybind11::module& m)
         m,
         "ParticleFilterRigid")
         .def(pybind11::init<pybind11::tuple>());
+
+    pybind11::class_<ParticleFilterRegion, ParticleFilter, std::shared_ptr<ParticleFilterRegion>>(
+        m,
+        "ParticleFilterRegion")
+        .def(pybind11::init<pybind11::tuple, pybind11::tuple>());
     };
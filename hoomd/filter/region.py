@@ -0,0 +1,70 @@
+"""Define the Region filter."""
+
+import math
+
+from hoomd.filter.filter_ import ParticleFilter
+from hoomd._hoomd import ParticleFilterRegion
+
+
+class Region(ParticleFilter, ParticleFilterRegion):
+    """Select particles inside an axis-aligned region.
+
+    Args:
+        lower (tuple[float, float, float]): Lower corner of the region
+            :math:`[\\mathrm{length}]`. Defaults to ``(-inf, -inf, -inf)``.
+        upper (tuple[float, float, float]): Upper corner of the region
+            :math:`[\\mathrm{length}]`. Defaults to ``(inf, inf, inf)``.
+
+    `Region` selects the particles with positions :math:`\\vec{r}` that
+    satisfy ``lower[i] <= r[i] < upper[i]`` along each axis. Positions are
+    evaluated inside the periodic box. Use infinite bounds to select slabs or
+    half spaces.
+
+    `Region` is evaluated on the GPU, as are `All`, `Null`, `Tags`, `Type`,
+    and set operations on them. When `hoomd.update.FilterUpdater` updates such
+    a group in a GPU simulation on a single rank, the group membership is
+    computed on the device without copying particle data to the host.
+
+    Example::
+
+        # particles above z = 10
+        above = hoomd.filter.Region(lower=(-math.inf, -math.inf, 10))
+
+        # particles of type A above z = 10
+        a_above = hoomd.filter.Intersection(hoomd.filter.Type(['A']), above)
+
+    Base: `ParticleFilter`
+    """
+
+    def __init__(self,
+                 lower=(-math.inf, -math.inf, -math.inf),
+                 upper=(math.inf, math.inf, math.inf)):
+        ParticleFilter.__init__(self)
+        self._lower = tuple(float(x) for x in lower)
+        self._upper = tuple(float(x) for x in upper)
+        if len(self._lower) != 3 or len(self._upper) != 3:
+            raise ValueError("lower and upper must have three elements.")
+        ParticleFilterRegion.__init__(self, self._lower, self._upper)
+
+    def __hash__(self):
+        """Return a hash of the filter parameters."""
+        return hash((self._lower, self._upper))
+
+    def __eq__(self, other):
+        """Test for equality between two particle filters."""
+        return (type(self) == type(other) and self._lower == other._lower
+                and self._upper == other._upper)
+
+    @property
+    def lower(self):
+        """tuple[float, float, float]: Lower corner of the region."""
+        return self._lower
+
+    @property
+    def upper(self):
+        """tuple[float, float, float]: Upper corner of the region."""
+        return self._upper
+
+    def __reduce__(self):
+        """Enable (deep)copying and pickling of `Region` particle filters."""
+        return (type(self), (self.lower, self.upper))
@@ -23,10 +23,24 @@
 
 #include <pybind11/pybind11.h>
 
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
 namespace hpmc
     {
 //! Template class for a free volume integration analyzer
-/*!
+/*! ComputeFreeVolume divides the local box into a regular grid of strata in fractional
+    coordinates and places the test particles of each compute in the strata in proportion to the
+    standard deviation of the overlap indicator estimated from the previous samples (Neyman
+    allocation). Strata that are found to be fully excluded or fully free receive fewer samples, and
+    the samples concentrate where the free volume has structure. Every stratum receives at least one
+    sample, so the stratified estimate is unbiased.
+
+    When accumulation is enabled, the per stratum counts sum over all computes until reset() is
+    called, and the estimate and its standard error converge over many steps.
+
     \ingroup hpmc_integrators
 */
 template<class Shape> class ComputeFreeVolume : public Compute
@@ -34,8 +48,7 @@ template<class Shape> class ComputeFreeVolume : public Compute
     public:
     //! Construct the integrator
     ComputeFreeVolume(std::shared_ptr<SystemDefinition> sysdef,
-                      std::shared_ptr<IntegratorHPMCMono<Shape>> mc,
-                      std::shared_ptr<CellList> cl);
+                      std::shared_ptr<IntegratorHPMCMono<Shape>> mc);
     //! Destructor
     virtual ~ComputeFreeVolume() {};
 
@@ -67,6 +80,39 @@ template<class Shape> class ComputeFreeVolume : public Compute
         m_type = type_int;
         }
 
+    //! Get the number of strata along each box dimension
+    unsigned int getNumStrata()
+        {
+        return m_n_strata;
+        }
+
+    //! Set the number of strata along each box dimension
+    void setNumStrata(unsigned int n_strata)
+        {
+        if (n_strata == 0)
+            throw std::invalid_argument("num_strata must be positive");
+        m_n_strata = n_strata;
+        }
+
+    //! Get whether the sample counts accumulate over computes
+    bool getAccumulate()
+        {
+        return m_accumulate;
+        }
+
+    //! Set whether the sample counts accumulate over computes
+    void setAccumulate(bool accumulate)
+        {
+        m_accumulate = accumulate;
+        }
+
+    //! Discard the accumulated sample counts
+    void reset()
+        {
+        std::fill(m_stratum_samples.begin(), m_stratum_samples.end(), 0.0);
+        std::fill(m_stratum_overlaps.begin(), m_stratum_overlaps.end(), 0.0);
+        }
+
 #ifdef ENABLE_MPI
     virtual void setCommunicator(std::shared_ptr<Communicator> comm)
         {
@@ -74,45 +120,81 @@ template<class Shape> class ComputeFreeVolume : public Compute
         Compute::setCommunicator(comm);
 
         // set the communicator on the internal cell list
-        m_cl->setCommunicator(comm);
+        if (m_cl)
+            m_cl->setCommunicator(comm);
         }
 #endif
 
     //! Analyze the current configuration
     virtual void compute(uint64_t timestep);
 
-    //! Return an estimate of the overlap volume
-    virtual Scalar getFreeVolume();
+    //! Return an estimate of the free volume
+    virtual Scalar getFreeVolume()
+        {
+        return m_free_volume;
+        }
+
+    //! Return the standard error of the free volume estimate
+    virtual Scalar getFreeVolumeError()
+        {
+        return m_free_volume_error;
+        }
 
     protected:
     std::shared_ptr<IntegratorHPMCMono<Shape>> m_mc; //!< The parent integrator
-    std::shared_ptr<CellList> m_cl;                  //!< The cell list
+    std::shared_ptr<CellList> m_cl;                  //!< The cell list, shared with other computes
+    CellListRequest m_cl_request;                    //!< Configuration of the cell list
 
     unsigned int m_type;     //!< Type of depletant particle to generate
     unsigned int m_n_sample; //!< Number of sampling depletants to generate
 
-    GPUArray<unsigned int> m_n_overlap_all; //!< Number of overlap volume particles in box
+    unsigned int m_n_strata; //!< Number of strata along each box dimension
+    bool m_accumulate;       //!< True when the sample counts accumulate over computes
+
+    GPUArray<unsigned int> m_n_overlap_all;  //!< Number of overlapping samples per stratum
+    GPUArray<unsigned int> m_stratum_offset; //!< First sample index of each stratum
+    std::vector<double> m_stratum_samples;   //!< Accumulated number of samples per stratum
+    std::vector<double> m_stratum_overlaps;  //!< Accumulated number of overlaps per stratum
+    Scalar m_free_volume;                    //!< Current free volume estimate
+    Scalar m_free_volume_error;              //!< Standard error of the estimate
+
+    //! Get the number of strata along each dimension of the local box
+    uint3 getStrataDim()
+        {
+        unsigned int n_z = this->m_sysdef->getNDimensions() == 3 ? m_n_strata : 1;
+        return make_uint3(m_n_strata, m_n_strata, n_z);
+        }
 
-    //! Return an estimate of the overlap volume
+    //! Distribute the samples of this compute over the strata
+    void allocateSamples();
+
+    //! Count the overlapping samples in each stratum
     virtual void computeFreeVolume(uint64_t timestep);
+
+    //! Add the counts of this compute to the totals and update the estimate
+    void accumulateSamples();
     };
 
 template<class Shape>
 ComputeFreeVolume<Shape>::ComputeFreeVolume(std::shared_ptr<SystemDefinition> sysdef,
-                                            std::shared_ptr<IntegratorHPMCMono<Shape>> mc,
-                                            std::shared_ptr<CellList> cl)
-    : Compute(sysdef), m_mc(mc), m_cl(cl), m_type(0), m_n_sample(0)
+                                            std::shared_ptr<IntegratorHPMCMono<Shape>> mc)
+    : Compute(sysdef), m_mc(mc), m_type(0), m_n_sample(0), m_n_strata(1), m_accumulate(false),
+      m_free_volume(0), m_free_volume_error(0)
     {
     this->m_exec_conf->msg->notice(5) << "Constructing ComputeFreeVolume" << std::endl;
 
-    this->m_cl->setRadius(1);
-    this->m_cl->setComputeTDB(false);
-    this->m_cl->setFlagType();
-    this->m_cl->setComputeIdx(true);
+    // the GPU implementation requests the cell list when it knows the width
+    m_cl_request.radius = 1;
+    m_cl_request.compute_tdb = false;
+    m_cl_request.flag = CellListRequest::flag_type;
+    m_cl_request.compute_idx = true;
 
     // allocate mem for overlap counts
     GPUArray<unsigned int> n_overlap_all(1, this->m_exec_conf);
     m_n_overlap_all.swap(n_overlap_all);
+
+    GPUArray<unsigned int> stratum_offset(2, this->m_exec_conf);
+    m_stratum_offset.swap(stratum_offset);
     }
 
 template<class Shape> void ComputeFreeVolume<Shape>::compute(uint64_t timestep)
@@ -124,14 +206,115 @@ template<class Shape> void ComputeFreeVolume<Shape>::compute(uint64_t timestep)
     // update ghost layers
     m_mc->communicate(false);
 
+    allocateSamples();
     this->computeFreeVolume(timestep);
+    accumulateSamples();
+    }
+
+/*! The number of samples in stratum s is one plus its share of the remaining samples, weighted by
+    sqrt(p_s (1 - p_s)). p_s is the free fraction of the stratum from the accumulated counts, or
+    from the counts of the previous compute when accumulation is off, with one free and one
+    overlapping pseudo sample added so that strata with few samples keep a nonzero weight.
+*/
+template<class Shape> void ComputeFreeVolume<Shape>::allocateSamples()
+    {
+    uint3 strata_dim = getStrataDim();
+    unsigned int n_strata = strata_dim.x * strata_dim.y * strata_dim.z;
+
+    if (m_stratum_samples.size() != n_strata)
+        {
+        m_stratum_samples.assign(n_strata, 0.0);
+        m_stratum_overlaps.assign(n_strata, 0.0);
+        m_n_overlap_all.resize(n_strata);
+        m_stratum_offset.resize(n_strata + 1);
+        }
+
+    unsigned int n_sample = m_n_sample;
+#ifdef ENABLE_MPI
+    n_sample /= this->m_exec_conf->getNRanks();
+#endif
+    n_sample = std::max(n_sample, n_strata);
+
+    std::vector<double> weight(n_strata);
+    double total_weight = 0.0;
+    for (unsigned int s = 0; s < n_strata; ++s)
+        {
+        double p = (m_stratum_samples[s] - m_stratum_overlaps[s] + 1.0)
+                   / (m_stratum_samples[s] + 2.0);
+        weight[s] = sqrt(p * (1.0 - p));
+        total_weight += weight[s];
+        }
+
+    if (!m_accumulate)
+        reset();
+
+    // round the cumulative weights so that the allocation sums to n_sample exactly
+    ArrayHandle<unsigned int> h_stratum_offset(m_stratum_offset,
+                                               access_location::host,
+                                               access_mode::overwrite);
+    unsigned int n_extra = n_sample - n_strata;
+    double cumulative_weight = 0.0;
+    h_stratum_offset.data[0] = 0;
+    for (unsigned int s = 0; s < n_strata; ++s)
+        {
+        cumulative_weight += weight[s];
+        unsigned int n_extra_before = static_cast<unsigned int>(
+            std::round(cumulative_weight / total_weight * n_extra));
+        h_stratum_offset.data[s + 1] = std::min(s + 1 + n_extra_before, n_sample);
+        }
+    h_stratum_offset.data[n_strata] = n_sample;
     }
 
-/*! \return the current free volume estimate by MC integration
+/*! Each stratum contributes its volume times its free fraction. The variance of the estimate sums
+    V_s^2 p_s (1 - p_s) / n_s over all strata.
+*/
+template<class Shape> void ComputeFreeVolume<Shape>::accumulateSamples()
+    {
+    unsigned int n_strata = static_cast<unsigned int>(m_stratum_samples.size());
+    unsigned int ndim = this->m_sysdef->getNDimensions();
+
+    ArrayHandle<unsigned int> h_n_overlap_all(m_n_overlap_all,
+                                              access_location::host,
+                                              access_mode::read);
+    ArrayHandle<unsigned int> h_stratum_offset(m_stratum_offset,
+                                               access_location::host,
+                                               access_mode::read);
+
+    double V_stratum = this->m_pdata->getBox().getVolume(ndim == 2) / double(n_strata);
+    double estimate[2] = {0.0, 0.0};
+    for (unsigned int s = 0; s < n_strata; ++s)
+        {
+        m_stratum_samples[s] += h_stratum_offset.data[s + 1] - h_stratum_offset.data[s];
+        m_stratum_overlaps[s] += h_n_overlap_all.data[s];
+
+        if (m_stratum_samples[s] > 0)
+            {
+            double p = 1.0 - m_stratum_overlaps[s] / m_stratum_samples[s];
+            estimate[0] += V_stratum * p;
+            estimate[1] += V_stratum * V_stratum * p * (1.0 - p) / m_stratum_samples[s];
+            }
+        }
+
+#ifdef ENABLE_MPI
+    if (m_comm)
+        {
+        MPI_Allreduce(MPI_IN_PLACE,
+                      estimate,
+                      2,
+                      MPI_DOUBLE,
+                      MPI_SUM,
+                      m_exec_conf->getMPICommunicator());
+        }
+#endif
+
+    m_free_volume = Scalar(estimate[0]);
+    m_free_volume_error = Scalar(sqrt(estimate[1]));
+    }
+
+/*! Places the samples of each stratum uniformly in the stratum and counts those that overlap
  */
 template<class Shape> void ComputeFreeVolume<Shape>::computeFreeVolume(uint64_t timestep)
     {
-    unsigned int overlap_count = 0;
     unsigned int err_count = 0;
     unsigned int ndim = this->m_sysdef->getNDimensions();
 
@@ -148,6 +331,15 @@ template<class Shape> void ComputeFreeVolume<Shape>::computeFreeVolume(uint64_t
     if (m_prof)
         m_prof->push("Free volume");
 
+    // access the sample allocation and the per stratum counters
+    ArrayHandle<unsigned int> h_stratum_offset(m_stratum_offset,
+                                               access_location::host,
+                                               access_mode::read);
+    ArrayHandle<unsigned int> h_n_overlap_all(m_n_overlap_all,
+                                              access_location::host,
+                                              access_mode::overwrite);
+    std::fill(h_n_overlap_all.data, h_n_overlap_all.data + m_n_overlap_all.getNumElements(), 0);
+
     // only check if AABB tree is populated
     if (m_pdata->getN() + m_pdata->getNGhosts())
         {
@@ -170,16 +362,19 @@ template<class Shape> void ComputeFreeVolume<Shape>::computeFreeVolume(uint64_t
                                              access_mode::read);
         const Index2D& overlap_idx = m_mc->getOverlapIndexer();
 
-        // generate n_sample random test depletants in the global box
-        unsigned int n_sample = m_n_sample;
-
-#ifdef ENABLE_MPI
-        n_sample /= this->m_exec_conf->getNRanks();
-#endif
+        uint3 strata_dim = getStrataDim();
+        Index3D strata_indexer(strata_dim.x, strata_dim.y, strata_dim.z);
+        unsigned int n_strata = strata_indexer.getNumElements();
 
-        for (unsigned int i = 0; i < n_sample; i++)
+        unsigned int stratum = 0;
+        for (unsigned int i = 0; i < h_stratum_offset.data[n_strata]; i++)
             {
-            // select a random particle coordinate in the box
+            // advance to the stratum of sample i
+            while (i >= h_stratum_offset.data[stratum + 1])
+                stratum++;
+            uint3 cell = strata_indexer.getTriple(stratum);
+
+            // select a random particle coordinate in the stratum
             hoomd::RandomGenerator rng_i(
                 hoomd::Seed(hoomd::RNGIdentifier::ComputeFreeVolume, timestep, seed),
                 hoomd::Counter(m_exec_conf->getRank(), i));
@@ -188,7 +383,9 @@ template<class Shape> void ComputeFreeVolume<Shape>::computeFreeVolume(uint64_t
             Scalar yrand = hoomd::detail::generate_canonical<Scalar>(rng_i);
             Scalar zrand = hoomd::detail::generate_canonical<Scalar>(rng_i);
 
-            Scalar3 f = make_scalar3(xrand, yrand, zrand);
+            Scalar3 f = make_scalar3((Scalar(cell.x) + xrand) / Scalar(strata_dim.x),
+                                     (Scalar(cell.y) + yrand) / Scalar(strata_dim.y),
+                                     (Scalar(cell.z) + zrand) / Scalar(strata_dim.z));
             vec3<Scalar> pos_i = vec3<Scalar>(box.makeCoordinates(f));
 
             Shape shape_i(quat<Scalar>(), params[m_type]);
@@ -263,56 +460,14 @@ template<class Shape> void ComputeFreeVolume<Shape>::computeFreeVolume(uint64_t
 
             if (overlap)
                 {
-                overlap_count++;
+                h_n_overlap_all.data[stratum]++;
                 }
             } // end loop through all particles
 
         } // end lexical scope
 
-#ifdef ENABLE_MPI
-    if (m_comm)
-        {
-        MPI_Allreduce(MPI_IN_PLACE,
-                      &overlap_count,
-                      1,
-                      MPI_UNSIGNED,
-                      MPI_SUM,
-                      m_exec_conf->getMPICommunicator());
-        }
-#endif
-
     if (m_prof)
         m_prof->pop();
-
-    ArrayHandle<unsigned int> h_n_overlap_all(m_n_overlap_all,
-                                              access_location::host,
-                                              access_mode::overwrite);
-    *h_n_overlap_all.data = overlap_count;
-    }
-
-// \return the free volume.
-template<class Shape> Scalar ComputeFreeVolume<Shape>::getFreeVolume()
-    {
-    // access counters
-    ArrayHandle<unsigned int> h_n_overlap_all(m_n_overlap_all,
-                                              access_location::host,
-                                              access_mode::read);
-
-    // generate n_sample random test depletants in the global box
-    unsigned int n_sample = m_n_sample;
-
-#ifdef ENABLE_MPI
-    // in MPI, for small n_sample we can encounter round-off issues
-    unsigned int n_ranks = this->m_exec_conf->getNRanks();
-    n_sample = (n_sample / n_ranks) * n_ranks;
-#endif
-
-    // total free volume
-    const BoxDim& global_box = this->m_pdata->getGlobalBox();
-    Scalar V_free
-        = (Scalar)(n_sample - *h_n_overlap_all.data) / (Scalar)n_sample * global_box.getVolume();
-
-    return V_free;
     }
 
 //! Export this hpmc analyzer to python
@@ -325,15 +480,23 @@ template<class Shape> void export_ComputeFreeVolume(pybind11::module& m, const s
         m,
         name.c_str())
         .def(pybind11::init<std::shared_ptr<SystemDefinition>,
-                            std::shared_ptr<IntegratorHPMCMono<Shape>>,
-                            std::shared_ptr<CellList>>())
+                            std::shared_ptr<IntegratorHPMCMono<Shape>>>())
         .def_property("num_samples",
                       &ComputeFreeVolume<Shape>::getNumSamples,
                       &ComputeFreeVolume<Shape>::setNumSamples)
         .def_property("test_particle_type",
                       &ComputeFreeVolume<Shape>::getTestParticleType,
                       &ComputeFreeVolume<Shape>::setTestParticleType)
-        .def_property_readonly("free_volume", &ComputeFreeVolume<Shape>::getFreeVolume);
+        .def_property("num_strata",
+                      &ComputeFreeVolume<Shape>::getNumStrata,
+                      &ComputeFreeVolume<Shape>::setNumStrata)
+        .def_property("accumulate",
+                      &ComputeFreeVolume<Shape>::getAccumulate,
+                      &ComputeFreeVolume<Shape>::setAccumulate)
+        .def("reset", &ComputeFreeVolume<Shape>::reset)
+        .def_property_readonly("free_volume", &ComputeFreeVolume<Shape>::getFreeVolume)
+        .def_property_readonly("free_volume_error",
+                               &ComputeFreeVolume<Shape>::getFreeVolumeError);
     }
 
     } // end namespace hpmc
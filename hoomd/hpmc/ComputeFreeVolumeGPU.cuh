@@ -57,6 +57,8 @@ struct hpmc_free_volume_args_t
                             const unsigned int _group_size,
                             const unsigned int _max_n,
                             unsigned int* _d_n_overlap_all,
+                            const unsigned int* _d_stratum_offset,
+                            const uint3& _strata_dim,
                             const Scalar3 _ghost_width,
                             const unsigned int* _d_check_overlaps,
                             Index2D _overlap_idx,
@@ -67,7 +69,8 @@ struct hpmc_free_volume_args_t
           cell_dim(_cell_dim), N(_N), num_types(_num_types), seed(_seed), rank(_rank),
           select(_select), timestep(_timestep), dim(_dim), box(_box), block_size(_block_size),
           stride(_stride), group_size(_group_size), max_n(_max_n),
-          d_n_overlap_all(_d_n_overlap_all), ghost_width(_ghost_width),
+          d_n_overlap_all(_d_n_overlap_all), d_stratum_offset(_d_stratum_offset),
+          strata_dim(_strata_dim), ghost_width(_ghost_width),
           d_check_overlaps(_d_check_overlaps), overlap_idx(_overlap_idx), devprop(_devprop) {};
 
     unsigned int n_sample;                //!< Number of depletants particles to generate
@@ -94,7 +97,9 @@ struct hpmc_free_volume_args_t
     unsigned int stride;                  //!< Number of threads per overlap check
     unsigned int group_size;              //!< Size of the group to execute
     const unsigned int max_n;             //!< Maximum size of pdata arrays
-    unsigned int* d_n_overlap_all;        //!< Total number of depletants in overlap volume
+    unsigned int* d_n_overlap_all;        //!< Number of overlapping depletants per stratum
+    const unsigned int* d_stratum_offset; //!< First sample index of each stratum
+    const uint3& strata_dim;              //!< Number of strata along each box dimension
     const Scalar3 ghost_width;            //!< Width of ghost layer
     const unsigned int* d_check_overlaps; //!< Interaction matrix
     Index2D overlap_idx;                  //!< Interaction matrix indexer
@@ -151,7 +156,9 @@ __device__ inline unsigned int compute_cell_idx(const Scalar3 p,
     \param timestep Current timestep of the simulation
     \param dim Dimension of the simulation box
     \param box Simulation box
-    \param d_n_overlap_all Total overlap counter (output value)
+    \param d_n_overlap_all Overlap counter per stratum (output value)
+    \param d_stratum_offset First sample index of each stratum
+    \param strata_dim Number of strata along each box dimension
     \param ghost_width Width of ghost layer
     \param d_params Per-type shape parameters
     \param d_overlaps Per-type pair interaction matrix
@@ -177,6 +184,8 @@ __global__ void gpu_hpmc_free_volume_kernel(unsigned int n_sample,
                                             const unsigned int dim,
                                             const BoxDim box,
                                             unsigned int* d_n_overlap_all,
+                                            const unsigned int* d_stratum_offset,
+                                            const uint3 strata_dim,
                                             Scalar3 ghost_width,
                                             const unsigned int* d_check_overlaps,
                                             Index2D overlap_idx,
@@ -189,8 +198,6 @@ __global__ void gpu_hpmc_free_volume_kernel(unsigned int n_sample,
     bool master = (offset == 0 && threadIdx.x == 0);
     unsigned int n_groups = blockDim.z;
 
-    __shared__ unsigned int s_n_overlap;
-
     // determine sample idx
     unsigned int i;
     i = blockIdx.x * n_groups + group;
@@ -240,11 +247,6 @@ __global__ void gpu_hpmc_free_volume_kernel(unsigned int n_sample,
         s_overlap[group] = 0;
         }
 
-    if (master && group == 0)
-        {
-        s_n_overlap = 0;
-        }
-
     __syncthreads();
 
     bool active = true;
@@ -259,6 +261,7 @@ __global__ void gpu_hpmc_free_volume_kernel(unsigned int n_sample,
                                hoomd::Counter(rank, i));
 
     unsigned int my_cell;
+    unsigned int stratum = 0;
 
     // test depletant position
     vec3<Scalar> pos_i;
@@ -267,12 +270,27 @@ __global__ void gpu_hpmc_free_volume_kernel(unsigned int n_sample,
 
     if (active)
         {
-        // select a random particle coordinate in the box
+        // find the stratum of the sample by bisection of the offsets
+        Index3D strata_indexer(strata_dim.x, strata_dim.y, strata_dim.z);
+        unsigned int upper = strata_indexer.getNumElements();
+        while (upper - stratum > 1)
+            {
+            unsigned int mid = (stratum + upper) / 2;
+            if (d_stratum_offset[mid] <= i)
+                stratum = mid;
+            else
+                upper = mid;
+            }
+        uint3 cell = strata_indexer.getTriple(stratum);
+
+        // select a random particle coordinate in the stratum
         Scalar xrand = hoomd::detail::generate_canonical<Scalar>(rng);
         Scalar yrand = hoomd::detail::generate_canonical<Scalar>(rng);
         Scalar zrand = hoomd::detail::generate_canonical<Scalar>(rng);
 
-        Scalar3 f = make_scalar3(xrand, yrand, zrand);
+        Scalar3 f = make_scalar3((Scalar(cell.x) + xrand) / Scalar(strata_dim.x),
+                                 (Scalar(cell.y) + yrand) / Scalar(strata_dim.y),
+                                 (Scalar(cell.z) + zrand) / Scalar(strata_dim.z));
         pos_i = vec3<Scalar>(box.makeCoordinates(f));
 
         if (shape_i.hasOrientation())
@@ -333,21 +351,10 @@ __global__ void gpu_hpmc_free_volume_kernel(unsigned int n_sample,
 
     unsigned int overlap = s_overlap[group];
 
-    if (master)
-        {
-        // this thread counts towards the total overlap volume
-        if (overlap)
-            {
-            atomicAdd(&s_n_overlap, 1);
-            }
-        }
-
-    __syncthreads();
-
-    if (master && group == 0 && s_n_overlap)
+    if (master && active && overlap)
         {
-        // final tally into global mem
-        atomicAdd(d_n_overlap_all, s_n_overlap);
+        // this sample counts towards the overlap volume of its stratum
+        atomicAdd(&d_n_overlap_all[stratum], 1);
         }
     }
 
@@ -373,7 +380,10 @@ hipError_t gpu_hpmc_free_volume(const hpmc_free_volume_args_t& args,
     assert(args.block_size % (args.stride * args.group_size) == 0);
 
     // reset counters
-    hipMemsetAsync(args.d_n_overlap_all, 0, sizeof(unsigned int));
+    hipMemsetAsync(args.d_n_overlap_all,
+                   0,
+                   sizeof(unsigned int) * args.strata_dim.x * args.strata_dim.y
+                       * args.strata_dim.z);
 
     // determine the maximum block size and clamp the input block size down
     static int max_block_size = -1;
@@ -435,6 +445,8 @@ hipError_t gpu_hpmc_free_volume(const hpmc_free_volume_args_t& args,
                        args.dim,
                        args.box,
                        args.d_n_overlap_all,
+                       args.d_stratum_offset,
+                       args.strata_dim,
                        args.ghost_width,
                        args.d_check_overlaps,
                        args.overlap_idx,
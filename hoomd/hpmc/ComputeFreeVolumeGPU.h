@@ -40,8 +40,7 @@ template<class Shape> class ComputeFreeVolumeGPU : public ComputeFreeVolume<Shap
     public:
     //! Construct the integrator
     ComputeFreeVolumeGPU(std::shared_ptr<SystemDefinition> sysdef,
-                         std::shared_ptr<IntegratorHPMCMono<Shape>> mc,
-                         std::shared_ptr<CellList> cl);
+                         std::shared_ptr<IntegratorHPMCMono<Shape>> mc);
     //! Destructor
     virtual ~ComputeFreeVolumeGPU();
 
@@ -79,9 +78,8 @@ template<class Shape> class ComputeFreeVolumeGPU : public ComputeFreeVolume<Shap
 
 template<class Shape>
 ComputeFreeVolumeGPU<Shape>::ComputeFreeVolumeGPU(std::shared_ptr<SystemDefinition> sysdef,
-                                                  std::shared_ptr<IntegratorHPMCMono<Shape>> mc,
-                                                  std::shared_ptr<CellList> cl)
-    : ComputeFreeVolume<Shape>(sysdef, mc, cl)
+                                                  std::shared_ptr<IntegratorHPMCMono<Shape>> mc)
+    : ComputeFreeVolume<Shape>(sysdef, mc)
     {
     // initialize the autotuners
     // the full block size, stride and group size matrix is searched,
@@ -141,8 +139,17 @@ template<class Shape> void ComputeFreeVolumeGPU<Shape>::computeFreeVolume(uint64
     // set nominal width
     Scalar nominal_width = this->m_mc->getMaxCoreDiameter();
 
-    if (this->m_cl->getNominalWidth() != nominal_width)
-        this->m_cl->setNominalWidth(nominal_width);
+    // the integrator and other computes with the same cell width share the cell list
+    if (!this->m_cl || this->m_cl_request.nominal_width != nominal_width)
+        {
+        this->m_cl_request.nominal_width = nominal_width;
+        this->m_cl_request.max_width = nominal_width;
+        this->m_cl = this->m_sysdef->getCellList(this->m_cl_request);
+#ifdef ENABLE_MPI
+        if (this->m_comm)
+            this->m_cl->setCommunicator(this->m_comm);
+#endif
+        }
 
     const BoxDim& box = this->m_pdata->getBox();
     Scalar3 npd = box.getNearestPlaneDistance();
@@ -252,10 +259,23 @@ template<class Shape> void ComputeFreeVolumeGPU<Shape>::computeFreeVolume(uint64
         = this->m_mc->getParams();
 
         {
-        // access counter
+        // the last stratum offset is the number of samples on this rank
+        unsigned int n_sample;
+            {
+            ArrayHandle<unsigned int> h_stratum_offset(this->m_stratum_offset,
+                                                       access_location::host,
+                                                       access_mode::read);
+            n_sample = h_stratum_offset.data[this->m_stratum_offset.getNumElements() - 1];
+            }
+
+        // access the per stratum counters and the sample allocation
         ArrayHandle<unsigned int> d_n_overlap_all(this->m_n_overlap_all,
                                                   access_location::device,
                                                   access_mode::overwrite);
+        ArrayHandle<unsigned int> d_stratum_offset(this->m_stratum_offset,
+                                                   access_location::device,
+                                                   access_mode::read);
+        uint3 strata_dim = this->getStrataDim();
 
         m_tuner_free_volume->begin();
         unsigned int param = m_tuner_free_volume->getParam();
@@ -263,12 +283,6 @@ template<class Shape> void ComputeFreeVolumeGPU<Shape>::computeFreeVolume(uint64
         unsigned int stride = (param % 1000000) / 100;
         unsigned int group_size = param % 100;
 
-        unsigned int n_sample = this->m_n_sample;
-
-#ifdef ENABLE_MPI
-        n_sample /= this->m_exec_conf->getNRanks();
-#endif
-
         detail::hpmc_free_volume_args_t free_volume_args(n_sample,
                                                          this->m_type,
                                                          d_postype.data,
@@ -294,6 +308,8 @@ template<class Shape> void ComputeFreeVolumeGPU<Shape>::computeFreeVolume(uint64
                                                          group_size,
                                                          this->m_pdata->getMaxN(),
                                                          d_n_overlap_all.data,
+                                                         d_stratum_offset.data,
+                                                         strata_dim,
                                                          this->m_cl->getGhostWidth(),
                                                          d_overlaps.data,
                                                          overlap_idx,
@@ -308,21 +324,6 @@ template<class Shape> void ComputeFreeVolumeGPU<Shape>::computeFreeVolume(uint64
         m_tuner_free_volume->end();
         }
 
-#ifdef ENABLE_MPI
-    if (this->m_comm)
-        {
-        ArrayHandle<unsigned int> h_n_overlap_all(this->m_n_overlap_all,
-                                                  access_location::host,
-                                                  access_mode::readwrite);
-        MPI_Allreduce(MPI_IN_PLACE,
-                      h_n_overlap_all.data,
-                      1,
-                      MPI_UNSIGNED,
-                      MPI_SUM,
-                      this->m_exec_conf->getMPICommunicator());
-        }
-#endif
-
     if (this->m_prof)
         this->m_prof->pop(this->m_exec_conf);
     }
@@ -354,8 +355,7 @@ template<class Shape> void export_ComputeFreeVolumeGPU(pybind11::module& m, cons
                      ComputeFreeVolume<Shape>,
                      std::shared_ptr<ComputeFreeVolumeGPU<Shape>>>(m, name.c_str())
         .def(pybind11::init<std::shared_ptr<SystemDefinition>,
-                            std::shared_ptr<IntegratorHPMCMono<Shape>>,
-                            std::shared_ptr<CellList>>());
+                            std::shared_ptr<IntegratorHPMCMono<Shape>>>());
     }
 
     } // end namespace hpmc
@@ -16,6 +16,12 @@
 #include "hoomd/HOOMDMPI.h"
 #endif
 
+#ifdef ENABLE_TBB
+#include <tbb/blocked_range.h>
+#include <tbb/enumerable_thread_specific.h>
+#include <tbb/parallel_for.h>
+#endif
+
 /*! \file ComputeSDF.h
     \brief Defines the template class for an sdf compute
     \note This header cannot be compiled by nvcc
@@ -81,7 +87,8 @@ bool test_scaled_overlap(const vec3<Scalar>& r_ij,
 
     Outside of that ComputeSDF is a pretty basic histogramming code. The only other notable feature
     in the design is the full use of the MPI domain decomposition to compute the SDF fast in large
-    jobs.
+    jobs. When HOOMD is built with TBB, the particles on each rank are split among the threads of
+    the task arena, each of which fills its own histogram.
 
     \b Storage <br>
 
@@ -169,7 +176,15 @@ template<class Shape> class ComputeSDF : public Compute
     void zeroHistogram();
 
     //! Add to histogram counts
-    void countHistogram(uint64_t timestep);
+    virtual void countHistogram(uint64_t timestep);
+
+    //! Find the smallest s bin of the pairs of a local particle
+    size_t computeMinBin(unsigned int i,
+                         const detail::AABBTree& aabb_tree,
+                         const std::vector<vec3<Scalar>>& image_list,
+                         const Scalar4* h_postype,
+                         const Scalar4* h_orientation,
+                         Scalar extra_width);
 
     //! Determine the s bin of a given particle pair
     size_t computeBin(const vec3<Scalar>& r_ij,
@@ -306,80 +321,140 @@ template<class Shape> void ComputeSDF<Shape>::countHistogram(uint64_t timestep)
                                        access_location::host,
                                        access_mode::read);
 
-    const std::vector<param_type, managed_allocator<param_type>>& params = m_mc->getParams();
-
+#ifdef ENABLE_TBB
+    tbb::enumerable_thread_specific<std::vector<unsigned int>> thread_hist(
+        std::vector<unsigned int>(m_hist.size(), 0));
+    m_exec_conf->getTaskArena()->execute(
+        [&]
+        {
+            tbb::parallel_for(tbb::blocked_range<unsigned int>(0, m_pdata->getN()),
+                              [&](const tbb::blocked_range<unsigned int>& r)
+                              {
+                                  std::vector<unsigned int>& hist = thread_hist.local();
+                                  for (unsigned int i = r.begin(); i != r.end(); ++i)
+                                      {
+                                      size_t min_bin = computeMinBin(i,
+                                                                     aabb_tree,
+                                                                     image_list,
+                                                                     h_postype.data,
+                                                                     h_orientation.data,
+                                                                     extra_width);
+                                      if (min_bin < hist.size())
+                                          hist[min_bin]++;
+                                      }
+                              });
+        });
+
+    for (const auto& hist : thread_hist)
+        {
+        for (size_t bin = 0; bin < m_hist.size(); bin++)
+            m_hist[bin] += hist[bin];
+        }
+#else
     // loop through N particles
     for (unsigned int i = 0; i < m_pdata->getN(); i++)
         {
-        size_t min_bin = m_hist.size();
+        size_t min_bin = computeMinBin(i,
+                                       aabb_tree,
+                                       image_list,
+                                       h_postype.data,
+                                       h_orientation.data,
+                                       extra_width);
+
+        // record the minimum bin
+        if (min_bin < m_hist.size())
+            m_hist[min_bin]++;
+        }
+#endif
+    }
 
-        // read in the current position and orientation
-        Scalar4 postype_i = h_postype.data[i];
-        Scalar4 orientation_i = h_orientation.data[i];
-        Shape shape_i(quat<Scalar>(orientation_i), params[__scalar_as_int(postype_i.w)]);
-        vec3<Scalar> pos_i = vec3<Scalar>(postype_i);
+/*! \param i Index of the local particle
+    \param aabb_tree AABB tree of the local and ghost particles
+    \param image_list Periodic images to search
+    \param h_postype Particle positions and types
+    \param h_orientation Particle orientations
+    \param extra_width Padding of the search radius for the largest scale factor
 
-        // construct the AABB around the particle's circumsphere
-        // pad with enough extra width so that when scaled by xmax, found particles might touch
-        detail::AABB aabb_i_local(vec3<Scalar>(0, 0, 0),
-                                  shape_i.getCircumsphereDiameter() / Scalar(2) + extra_width);
+    \returns The smallest s bin over all pairs *i,j*, or a value >= the number of bins when no pair
+    touches within *xmax*.
 
-        size_t n_images = image_list.size();
-        for (unsigned int cur_image = 0; cur_image < n_images; cur_image++)
-            {
-            vec3<Scalar> pos_i_image = pos_i + image_list[cur_image];
-            detail::AABB aabb = aabb_i_local;
-            aabb.translate(pos_i_image);
+    computeMinBin() only reads shared state, so it may be called concurrently for different
+    particles.
+*/
+template<class Shape>
+size_t ComputeSDF<Shape>::computeMinBin(unsigned int i,
+                                        const detail::AABBTree& aabb_tree,
+                                        const std::vector<vec3<Scalar>>& image_list,
+                                        const Scalar4* h_postype,
+                                        const Scalar4* h_orientation,
+                                        Scalar extra_width)
+    {
+    const std::vector<param_type, managed_allocator<param_type>>& params = m_mc->getParams();
+
+    size_t min_bin = m_hist.size();
+
+    // read in the current position and orientation
+    Scalar4 postype_i = h_postype[i];
+    Scalar4 orientation_i = h_orientation[i];
+    Shape shape_i(quat<Scalar>(orientation_i), params[__scalar_as_int(postype_i.w)]);
+    vec3<Scalar> pos_i = vec3<Scalar>(postype_i);
 
-            // stackless search
-            for (unsigned int cur_node_idx = 0; cur_node_idx < aabb_tree.getNumNodes();
-                 cur_node_idx++)
+    // construct the AABB around the particle's circumsphere
+    // pad with enough extra width so that when scaled by xmax, found particles might touch
+    detail::AABB aabb_i_local(vec3<Scalar>(0, 0, 0),
+                              shape_i.getCircumsphereDiameter() / Scalar(2) + extra_width);
+
+    size_t n_images = image_list.size();
+    for (unsigned int cur_image = 0; cur_image < n_images; cur_image++)
+        {
+        vec3<Scalar> pos_i_image = pos_i + image_list[cur_image];
+        detail::AABB aabb = aabb_i_local;
+        aabb.translate(pos_i_image);
+
+        // stackless search
+        for (unsigned int cur_node_idx = 0; cur_node_idx < aabb_tree.getNumNodes(); cur_node_idx++)
+            {
+            if (detail::overlap(aabb_tree.getNodeAABB(cur_node_idx), aabb))
                 {
-                if (detail::overlap(aabb_tree.getNodeAABB(cur_node_idx), aabb))
+                if (aabb_tree.isNodeLeaf(cur_node_idx))
                     {
-                    if (aabb_tree.isNodeLeaf(cur_node_idx))
+                    for (unsigned int cur_p = 0;
+                         cur_p < aabb_tree.getNodeNumParticles(cur_node_idx);
+                         cur_p++)
                         {
-                        for (unsigned int cur_p = 0;
-                             cur_p < aabb_tree.getNodeNumParticles(cur_node_idx);
-                             cur_p++)
-                            {
-                            // read in its position and orientation
-                            unsigned int j = aabb_tree.getNodeParticle(cur_node_idx, cur_p);
-
-                            // skip i==j in the 0 image
-                            if (cur_image == 0 && i == j)
-                                continue;
-
-                            Scalar4 postype_j = h_postype.data[j];
-                            Scalar4 orientation_j = h_orientation.data[j];
-
-                            // put particles in coordinate system of particle i
-                            vec3<Scalar> r_ij = vec3<Scalar>(postype_j) - pos_i_image;
-
-                            size_t bin = computeBin(r_ij,
-                                                    quat<Scalar>(orientation_i),
-                                                    quat<Scalar>(orientation_j),
-                                                    params[__scalar_as_int(postype_i.w)],
-                                                    params[__scalar_as_int(postype_j.w)]);
-
-                            if (bin >= 0)
-                                min_bin = std::min(min_bin, bin);
-                            }
+                        // read in its position and orientation
+                        unsigned int j = aabb_tree.getNodeParticle(cur_node_idx, cur_p);
+
+                        // skip i==j in the 0 image
+                        if (cur_image == 0 && i == j)
+                            continue;
+
+                        Scalar4 postype_j = h_postype[j];
+                        Scalar4 orientation_j = h_orientation[j];
+
+                        // put particles in coordinate system of particle i
+                        vec3<Scalar> r_ij = vec3<Scalar>(postype_j) - pos_i_image;
+
+                        size_t bin = computeBin(r_ij,
+                                                quat<Scalar>(orientation_i),
+                                                quat<Scalar>(orientation_j),
+                                                params[__scalar_as_int(postype_i.w)],
+                                                params[__scalar_as_int(postype_j.w)]);
+
+                        if (bin >= 0)
+                            min_bin = std::min(min_bin, bin);
                         }
                     }
-                else
-                    {
-                    // skip ahead
-                    cur_node_idx += aabb_tree.getNodeSkip(cur_node_idx);
-                    }
-                } // end loop over AABB nodes
-            }     // end loop over images
-
-        // record the minimum bin
-        if ((unsigned int)min_bin < m_hist.size())
-            m_hist[min_bin]++;
+                }
+            else
+                {
+                // skip ahead
+                cur_node_idx += aabb_tree.getNodeSkip(cur_node_idx);
+                }
+            } // end loop over AABB nodes
+        }     // end loop over images
 
-        } // end loop over all particles
+    return min_bin;
     }
 
 /*! \param r_ij Vector pointing from particle i to j (already wrapped into the box)
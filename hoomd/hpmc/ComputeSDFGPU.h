@@ -0,0 +1,325 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#pragma once
+
+#ifdef ENABLE_HIP
+
+#include "ComputeSDF.h"
+#include "ComputeSDFGPU.cuh"
+#include "IntegratorHPMCMonoGPUTypes.cuh"
+
+#include "hoomd/Autotuner.h"
+#include "hoomd/CellList.h"
+#include "hoomd/GlobalArray.h"
+
+#include <hip/hip_runtime.h>
+
+/*! \file ComputeSDFGPU.h
+    \brief Declaration of ComputeSDFGPU
+    \note This header cannot be compiled by nvcc
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include <pybind11/pybind11.h>
+
+namespace hpmc
+    {
+/*!
+   Implementation of ComputeSDF on the GPU
+
+   The histogram of the smallest scale factor per particle is computed on the GPU with the same
+   overlap tests as the narrow phase, searching the neighbors of each particle in the expanded
+   cells of its own cell list. Boxes too small for the minimum image convention fall back to the
+   CPU implementation.
+*/
+template<class Shape> class ComputeSDFGPU : public ComputeSDF<Shape>
+    {
+    public:
+    //! Constructor
+    ComputeSDFGPU(std::shared_ptr<SystemDefinition> sysdef,
+                  std::shared_ptr<IntegratorHPMCMono<Shape>> mc,
+                  double xmax,
+                  double dx);
+
+    //! Destructor
+    virtual ~ComputeSDFGPU();
+
+    //! Set autotuner parameters
+    /*! \param enable Enable/disable autotuning
+        \param period period (approximate) in time steps when returning occurs
+    */
+    virtual void setAutotunerParams(bool enable, unsigned int period)
+        {
+        m_tuner_sdf->setPeriod(period);
+        m_tuner_sdf->setEnabled(enable);
+
+        m_tuner_excell_block_size->setPeriod(period);
+        m_tuner_excell_block_size->setEnabled(enable);
+        }
+
+#ifdef ENABLE_MPI
+    virtual void setCommunicator(std::shared_ptr<Communicator> comm)
+        {
+        ComputeSDF<Shape>::setCommunicator(comm);
+
+        // set the communicator on the internal cell list
+        if (m_cl)
+            m_cl->setCommunicator(comm);
+        }
+#endif
+
+    protected:
+    std::shared_ptr<CellList> m_cl; //!< Cell list of the local and ghost particles
+    CellListRequest m_cl_request;   //!< Configuration of the cell list
+    uint3 m_last_dim;               //!< Dimensions of the cell list on the last call
+    unsigned int m_last_nmax;       //!< Last cell list NMax value allocated in excell
+
+    GlobalArray<unsigned int> m_excell_idx;  //!< Particle indices in expanded cells
+    GlobalArray<unsigned int> m_excell_size; //!< Number of particles in each expanded cell
+    Index2D m_excell_list_indexer;           //!< Indexer to access elements of the excell_idx list
+
+    GlobalArray<unsigned int> m_hist_gpu; //!< Histogram counts computed on the GPU
+
+    std::unique_ptr<Autotuner> m_tuner_sdf;               //!< Autotuner for the histogram kernel
+    std::unique_ptr<Autotuner> m_tuner_excell_block_size; //!< Autotuner for excell block_size
+
+    //! Add to histogram counts
+    virtual void countHistogram(uint64_t timestep);
+
+    //! Resize the expanded cell list
+    void initializeExcellMem();
+    };
+
+template<class Shape>
+ComputeSDFGPU<Shape>::ComputeSDFGPU(std::shared_ptr<SystemDefinition> sysdef,
+                                    std::shared_ptr<IntegratorHPMCMono<Shape>> mc,
+                                    double xmax,
+                                    double dx)
+    : ComputeSDF<Shape>(sysdef, mc, xmax, dx)
+    {
+    this->m_exec_conf->msg->notice(5) << "Constructing ComputeSDFGPU" << std::endl;
+
+    // the cell list is requested on the first call, when the width is known
+    m_cl_request.radius = 1;
+    m_cl_request.compute_tdb = false;
+    m_cl_request.flag = CellListRequest::flag_type;
+    m_cl_request.compute_idx = true;
+
+    // set last dim to a bogus value so that it will re-init on the first call
+    m_last_dim = make_uint3(0xffffffff, 0xffffffff, 0xffffffff);
+    m_last_nmax = 0xffffffff;
+
+    GlobalArray<unsigned int>(0, this->m_exec_conf).swap(m_excell_size);
+    GlobalArray<unsigned int>(0, this->m_exec_conf).swap(m_excell_idx);
+    GlobalArray<unsigned int>(0, this->m_exec_conf).swap(m_hist_gpu);
+
+    // the block size and threads per particle are searched,
+    // encoded as block_size*1000000 + group_size
+    std::vector<unsigned int> valid_params;
+    const hipDeviceProp_t& dev_prop = this->m_exec_conf->dev_prop;
+    unsigned int warp_size = dev_prop.warpSize;
+    unsigned int max_groups = dev_prop.maxThreadsDim[2];
+    for (unsigned int block_size = warp_size;
+         block_size <= (unsigned int)dev_prop.maxThreadsPerBlock;
+         block_size += warp_size)
+        {
+        for (auto t : Autotuner::getTppListPow2(warp_size))
+            {
+            if ((block_size % t) == 0 && block_size / t <= max_groups)
+                valid_params.push_back(block_size * 1000000 + t);
+            }
+        }
+
+    m_tuner_sdf.reset(new Autotuner(valid_params, 5, 100000, "hpmc_sdf", this->m_exec_conf));
+
+    m_tuner_excell_block_size.reset(new Autotuner(warp_size,
+                                                  dev_prop.maxThreadsPerBlock,
+                                                  warp_size,
+                                                  5,
+                                                  1000000,
+                                                  "hpmc_sdf_excell_block_size",
+                                                  this->m_exec_conf));
+    }
+
+template<class Shape> ComputeSDFGPU<Shape>::~ComputeSDFGPU()
+    {
+    this->m_exec_conf->msg->notice(5) << "Destroying ComputeSDFGPU" << std::endl;
+    }
+
+/*! \param timestep current timestep
+
+    Searches the particles within the circumsphere diameter padded by the largest scale factor in
+    the cell list, so only the particle data is accessed on the device and the histogram is the
+    only transfer to the host.
+*/
+template<class Shape> void ComputeSDFGPU<Shape>::countHistogram(uint64_t timestep)
+    {
+    Scalar max_diam = this->m_mc->getMaxCoreDiameter();
+    Scalar extra_width = this->m_xmax / (1 - this->m_xmax) * max_diam;
+    Scalar nominal_width = max_diam + extra_width;
+
+    // the kernel checks a single image of every particle, it is only valid if no pair can touch
+    // through more than one image
+    const BoxDim& box = this->m_pdata->getBox();
+    Scalar3 npd = box.getNearestPlaneDistance();
+    if ((box.getPeriodic().x && npd.x <= nominal_width * 2)
+        || (box.getPeriodic().y && npd.y <= nominal_width * 2)
+        || (this->m_sysdef->getNDimensions() == 3 && box.getPeriodic().z
+            && npd.z <= nominal_width * 2))
+        {
+        ComputeSDF<Shape>::countHistogram(timestep);
+        return;
+        }
+
+    // other computes with the same cell width share the cell list
+    if (!m_cl || m_cl_request.nominal_width != nominal_width)
+        {
+        m_cl_request.nominal_width = nominal_width;
+        m_cl_request.max_width = nominal_width;
+        m_cl = this->m_sysdef->getCellList(m_cl_request);
+#ifdef ENABLE_MPI
+        if (this->m_comm)
+            m_cl->setCommunicator(this->m_comm);
+#endif
+        }
+    m_cl->compute(timestep);
+
+    // if the cell list is a different size than last time, reinitialize expanded cell list
+    uint3 cur_dim = m_cl->getDim();
+    if (m_last_dim.x != cur_dim.x || m_last_dim.y != cur_dim.y || m_last_dim.z != cur_dim.z
+        || m_last_nmax != m_cl->getNmax())
+        {
+        initializeExcellMem();
+        m_last_dim = cur_dim;
+        m_last_nmax = m_cl->getNmax();
+        }
+
+    unsigned int n_bins = (unsigned int)this->m_hist.size();
+    if (m_hist_gpu.getNumElements() != n_bins)
+        GlobalArray<unsigned int>(n_bins, this->m_exec_conf).swap(m_hist_gpu);
+
+        {
+        ArrayHandle<unsigned int> d_cell_size(m_cl->getCellSizeArray(),
+                                              access_location::device,
+                                              access_mode::read);
+        ArrayHandle<unsigned int> d_cell_idx(m_cl->getIndexArray(),
+                                             access_location::device,
+                                             access_mode::read);
+        ArrayHandle<unsigned int> d_cell_adj(m_cl->getCellAdjArray(),
+                                             access_location::device,
+                                             access_mode::read);
+        ArrayHandle<unsigned int> d_excell_idx(m_excell_idx,
+                                               access_location::device,
+                                               access_mode::overwrite);
+        ArrayHandle<unsigned int> d_excell_size(m_excell_size,
+                                                access_location::device,
+                                                access_mode::overwrite);
+
+        // update the expanded cells
+        m_tuner_excell_block_size->begin();
+        gpu::hpmc_excell(d_excell_idx.data,
+                         d_excell_size.data,
+                         m_excell_list_indexer,
+                         d_cell_idx.data,
+                         d_cell_size.data,
+                         d_cell_adj.data,
+                         m_cl->getCellIndexer(),
+                         m_cl->getCellListIndexer(),
+                         m_cl->getCellAdjIndexer(),
+                         1,
+                         m_tuner_excell_block_size->getParam());
+        if (this->m_exec_conf->isCUDAErrorCheckingEnabled())
+            CHECK_CUDA_ERROR();
+        m_tuner_excell_block_size->end();
+        }
+
+        {
+        ArrayHandle<Scalar4> d_postype(this->m_pdata->getPositions(),
+                                       access_location::device,
+                                       access_mode::read);
+        ArrayHandle<Scalar4> d_orientation(this->m_pdata->getOrientationArray(),
+                                           access_location::device,
+                                           access_mode::read);
+        ArrayHandle<unsigned int> d_excell_idx(m_excell_idx,
+                                               access_location::device,
+                                               access_mode::read);
+        ArrayHandle<unsigned int> d_excell_size(m_excell_size,
+                                                access_location::device,
+                                                access_mode::read);
+        ArrayHandle<unsigned int> d_hist(m_hist_gpu,
+                                         access_location::device,
+                                         access_mode::overwrite);
+
+        hipMemsetAsync(d_hist.data, 0, sizeof(unsigned int) * n_bins);
+
+        auto& params = this->m_mc->getParams();
+
+        m_tuner_sdf->begin();
+        unsigned int param = m_tuner_sdf->getParam();
+        gpu::sdf_args_t args(d_postype.data,
+                             d_orientation.data,
+                             d_excell_idx.data,
+                             d_excell_size.data,
+                             m_excell_list_indexer,
+                             m_cl->getCellIndexer(),
+                             m_cl->getDim(),
+                             m_cl->getGhostWidth(),
+                             this->m_pdata->getN(),
+                             this->m_pdata->getNTypes(),
+                             box,
+                             Scalar(this->m_dx),
+                             n_bins,
+                             d_hist.data,
+                             param / 1000000,
+                             param % 1000000,
+                             this->m_exec_conf->dev_prop);
+        gpu::hpmc_sdf<Shape>(args, params.data());
+        if (this->m_exec_conf->isCUDAErrorCheckingEnabled())
+            CHECK_CUDA_ERROR();
+        m_tuner_sdf->end();
+        }
+
+    ArrayHandle<unsigned int> h_hist(m_hist_gpu, access_location::host, access_mode::read);
+    for (unsigned int bin = 0; bin < n_bins; bin++)
+        this->m_hist[bin] += h_hist.data[bin];
+    }
+
+template<class Shape> void ComputeSDFGPU<Shape>::initializeExcellMem()
+    {
+    this->m_exec_conf->msg->notice(4) << "hpmc resizing expanded cells" << std::endl;
+
+    // get the current cell dimensions
+    unsigned int num_cells = m_cl->getCellIndexer().getNumElements();
+    unsigned int num_adj = m_cl->getCellAdjIndexer().getW();
+    unsigned int num_max = m_cl->getNmax();
+
+    // make the excell dimensions the same, but with room for Nmax*Nadj in each cell
+    m_excell_list_indexer = Index2D(num_max * num_adj, num_cells);
+
+    // reallocate memory
+    m_excell_idx.resize(m_excell_list_indexer.getNumElements());
+    m_excell_size.resize(num_cells);
+    }
+
+//! Export the ComputeSDFGPU class to python
+/*! \param name Name of the class in the exported python module
+    \tparam Shape An instantiation of ComputeSDFGPU<Shape> will be exported
+*/
+template<class Shape> void export_ComputeSDFGPU(pybind11::module& m, const std::string& name)
+    {
+    pybind11::class_<ComputeSDFGPU<Shape>,
+                     ComputeSDF<Shape>,
+                     std::shared_ptr<ComputeSDFGPU<Shape>>>(m, name.c_str())
+        .def(pybind11::init<std::shared_ptr<SystemDefinition>,
+                            std::shared_ptr<IntegratorHPMCMono<Shape>>,
+                            double,
+                            double>());
+    }
+
+    } // end namespace hpmc
+
+#endif // ENABLE_HIP
@@ -0,0 +1,55 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#pragma once
+
+/*! \file ExcellIndexer.h
+    \brief Defines the indexer of the compacted expanded cell list
+*/
+
+// need to declare these classes with __host__ __device__ qualifiers when building in nvcc
+// HOSTDEVICE is __host__ __device__ when included in nvcc and blank when included into the host
+// compiler
+#ifdef __HIPCC__
+#define HOSTDEVICE __host__ __device__
+#else
+#define HOSTDEVICE
+#endif
+
+namespace hpmc
+    {
+namespace gpu
+    {
+//! Index the compacted expanded cell list
+/*! The expanded cells are stored back to back in cell order, like a CSR matrix. The first entry
+    of each cell is at the exclusive prefix sum of the sizes of the preceding expanded cells, so
+    the list holds exactly one entry per particle in each expanded cell, no matter how unevenly
+    the particles are distributed among the cells.
+
+    Replaces Index2D(Nmax * Nadj, Ncells) in the kernels, which are indexed the same way:
+    excli(k, cell) is the position of the k-th particle of the expanded cell in the list.
+*/
+struct ExcellIndexer
+    {
+    //! Constructor
+    /*! \param _d_offset Offset of the first entry of each expanded cell (device pointer)
+     */
+    HOSTDEVICE explicit ExcellIndexer(const unsigned int* _d_offset = nullptr) : d_offset(_d_offset)
+        {
+        }
+
+    //! Calculate the index of the k-th entry of an expanded cell
+    /*! \param k Entry in the expanded cell
+        \param cell Expanded cell
+        \returns 1D index into the expanded cell list
+    */
+    HOSTDEVICE inline unsigned int operator()(unsigned int k, unsigned int cell) const
+        {
+        return d_offset[cell] + k;
+        }
+
+    const unsigned int* d_offset; //!< Offset of the first entry of each expanded cell
+    };
+
+    } // end namespace gpu
+    } // end namespace hpmc
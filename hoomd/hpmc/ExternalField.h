@@ -12,6 +12,11 @@
 #include "hoomd/Compute.h"
 #include "hoomd/VectorMath.h"
 
+#ifdef ENABLE_HIP
+#include "hoomd/GPUPartition.cuh"
+#include <hip/hip_runtime.h>
+#endif
+
 #include "HPMCCounters.h" // do we need this to keep track of the statistics?
 
 #ifndef __HIPCC__
@@ -20,10 +25,81 @@
 
 namespace hpmc
     {
+namespace detail
+    {
+#ifdef ENABLE_HIP
+//! Wraps arguments to the GPU external field kernel
+struct hpmc_external_args_t
+    {
+    //! Construct an hpmc_external_args_t
+    hpmc_external_args_t(const Scalar4* _d_postype,
+                         const Scalar4* _d_orientation,
+                         const Scalar4* _d_trial_postype,
+                         const Scalar4* _d_trial_orientation,
+                         const unsigned int* _d_trial_move_type,
+                         const Scalar* _d_charge,
+                         const Scalar* _d_diameter,
+                         unsigned int* _d_reject_out_of_cell,
+                         const BoxDim& _box,
+                         const uint16_t _seed,
+                         const unsigned int _rank,
+                         const uint64_t _timestep,
+                         const unsigned int _select,
+                         const GPUPartition& _gpu_partition)
+        : d_postype(_d_postype), d_orientation(_d_orientation), d_trial_postype(_d_trial_postype),
+          d_trial_orientation(_d_trial_orientation), d_trial_move_type(_d_trial_move_type),
+          d_charge(_d_charge), d_diameter(_d_diameter), d_reject_out_of_cell(_d_reject_out_of_cell),
+          box(_box), seed(_seed), rank(_rank), timestep(_timestep), select(_select),
+          gpu_partition(_gpu_partition)
+        {
+        }
+
+    const Scalar4* d_postype;              //!< postype array
+    const Scalar4* d_orientation;          //!< orientation array
+    const Scalar4* d_trial_postype;        //!< New positions (and type) of particles
+    const Scalar4* d_trial_orientation;    //!< New orientations of particles
+    const unsigned int* d_trial_move_type; //!< 0=no move, 1/2 = translate/rotate
+    const Scalar* d_charge;                //!< Particle charges
+    const Scalar* d_diameter;              //!< Particle diameters
+    unsigned int* d_reject_out_of_cell;    //!< Flag if a particle move has been rejected a priori
+    const BoxDim& box;                     //!< Current simulation box
+    const uint16_t seed;                   //!< RNG seed
+    const unsigned int rank;               //!< MPI Rank
+    const uint64_t timestep;               //!< Current timestep
+    const unsigned int select;             //!< Current selection
+    const GPUPartition& gpu_partition;     //!< split particles among GPUs
+    };
+#endif
+    } // end namespace detail
+
 class ExternalField : public Compute
     {
     public:
     ExternalField(std::shared_ptr<SystemDefinition> sysdef) : Compute(sysdef) { }
+
+#ifdef ENABLE_HIP
+    //! A struct that contains the kernel arguments
+    typedef detail::hpmc_external_args_t gpu_args_t;
+
+    //! Apply the external field to the trial moves on the GPU
+    /*! \param args Kernel arguments
+        \param hStream stream to execute on
+
+        Called by the GPU integrators once per sweep, after the trial moves are generated. The
+        energy of the field depends only on the moved particle, so implementations accept or reject
+        each trial move with its own Metropolis criterion and set d_reject_out_of_cell on rejection.
+        The overlap and patch checks then skip these particles.
+
+        The default implementation leaves all moves untouched.
+    */
+    virtual void computeExternalFieldGPU(const gpu_args_t& args, hipStream_t hStream) { }
+
+    //! Set autotuner parameters
+    /*! \param enable Enable/disable autotuning
+        \param period period (approximate) in time steps when returning occurs
+    */
+    virtual void setAutotunerParams(bool enable, unsigned int period) { }
+#endif
     /*! calculateBoltzmannWeight(uint64_t timestep)
         method used to calculate the boltzmann weight contribution for the
         external field of the entire system. This is used to interface with
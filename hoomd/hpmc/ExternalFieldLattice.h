@@ -585,7 +585,7 @@ template<class Shape> class ExternalFieldLattice : public ExternalFieldMono<Shap
         return calcE(index, position, shape.orientation, scale);
         }
 
-    private:
+    protected:
     LatticeReferenceList<Scalar3> m_latticePositions; // positions of the lattice.
     Scalar m_k;                                       // spring constant
 
@@ -594,6 +594,7 @@ template<class Shape> class ExternalFieldLattice : public ExternalFieldMono<Shap
 
     std::vector<quat<Scalar>> m_symmetry; // quaternions in the symmetry group of the shape.
 
+    private:
     Scalar m_Energy; // Store the total energy of the last computed timestep
 
     // All of these are on a per particle basis
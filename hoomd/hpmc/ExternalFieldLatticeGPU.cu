@@ -0,0 +1,186 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "ExternalFieldLatticeGPU.cuh"
+#include "hoomd/RNGIdentifiers.h"
+#include "hoomd/RandomNumbers.h"
+#include "hoomd/VectorMath.h"
+
+#include <cassert>
+
+/*! \file ExternalFieldLatticeGPU.cu
+    \brief Implements the harmonic lattice field on the GPU
+*/
+
+namespace hpmc
+    {
+namespace gpu
+    {
+namespace kernel
+    {
+//! Energy of a particle in the lattice field, as ExternalFieldLattice::calcE() computes it
+__device__ inline Scalar lattice_energy(const vec3<Scalar>& position,
+                                        const quat<Scalar>& orientation,
+                                        const unsigned int tag,
+                                        const Scalar3* d_lattice_positions,
+                                        const Scalar4* d_lattice_orientations,
+                                        const Scalar4* d_symmetry,
+                                        const unsigned int n_symmetry,
+                                        const Scalar k,
+                                        const Scalar q,
+                                        const BoxDim& box,
+                                        const vec3<Scalar>& origin)
+    {
+    Scalar energy(0.0);
+    if (d_lattice_positions)
+        {
+        vec3<Scalar> r0(d_lattice_positions[tag]);
+        vec3<Scalar> dr = vec3<Scalar>(box.minImage(vec_to_scalar3(r0 - position + origin)));
+        energy += k * dot(dr, dr);
+        }
+    if (d_lattice_orientations)
+        {
+        quat<Scalar> q0(d_lattice_orientations[tag]);
+        Scalar dqmin(0.0);
+        for (unsigned int i = 0; i < n_symmetry; i++)
+            {
+            quat<Scalar> dq = q0 - orientation * quat<Scalar>(d_symmetry[i]);
+            dqmin = (i == 0) ? norm2(dq) : fmin(dqmin, norm2(dq));
+            }
+        energy += q * dqmin;
+        }
+    return energy;
+    }
+
+//! Accept or reject the trial moves of every particle in the lattice field
+/*! One thread processes one particle. Moves that the Metropolis criterion on the change in the
+    field energy rejects set the a priori rejection flag, so that the narrow phase and patch kernels
+    skip the particle.
+*/
+__global__ void hpmc_lattice_field(const Scalar4* d_postype,
+                                   const Scalar4* d_orientation,
+                                   const Scalar4* d_trial_postype,
+                                   const Scalar4* d_trial_orientation,
+                                   const unsigned int* d_trial_move_type,
+                                   const unsigned int* d_tag,
+                                   unsigned int* d_reject_out_of_cell,
+                                   const Scalar3* d_lattice_positions,
+                                   const Scalar4* d_lattice_orientations,
+                                   const Scalar4* d_symmetry,
+                                   const unsigned int n_symmetry,
+                                   const Scalar k,
+                                   const Scalar q,
+                                   const BoxDim box,
+                                   const Scalar3 origin,
+                                   const uint16_t seed,
+                                   const unsigned int rank,
+                                   const uint64_t timestep,
+                                   const unsigned int select,
+                                   const unsigned int work_offset,
+                                   const unsigned int nwork)
+    {
+    unsigned int work_idx = blockIdx.x * blockDim.x + threadIdx.x;
+    if (work_idx >= nwork)
+        return;
+    unsigned int idx = work_idx + work_offset;
+
+    if (!d_trial_move_type[idx] || d_reject_out_of_cell[idx])
+        return;
+
+    unsigned int tag = d_tag[idx];
+    Scalar delta_U = lattice_energy(vec3<Scalar>(d_trial_postype[idx]),
+                                    quat<Scalar>(d_trial_orientation[idx]),
+                                    tag,
+                                    d_lattice_positions,
+                                    d_lattice_orientations,
+                                    d_symmetry,
+                                    n_symmetry,
+                                    k,
+                                    q,
+                                    box,
+                                    vec3<Scalar>(origin))
+                     - lattice_energy(vec3<Scalar>(d_postype[idx]),
+                                      quat<Scalar>(d_orientation[idx]),
+                                      tag,
+                                      d_lattice_positions,
+                                      d_lattice_orientations,
+                                      d_symmetry,
+                                      n_symmetry,
+                                      k,
+                                      q,
+                                      box,
+                                      vec3<Scalar>(origin));
+
+    // Metropolis-Hastings
+    hoomd::RandomGenerator rng_i(
+        hoomd::Seed(hoomd::RNGIdentifier::HPMCMonoExternalField, timestep, seed),
+        hoomd::Counter(idx, select, rank));
+    bool accept = hoomd::detail::generate_canonical<double>(rng_i) < slow::exp(-delta_U);
+
+    if (!accept)
+        d_reject_out_of_cell[idx] = 1;
+    }
+    } // end namespace kernel
+
+/*! \param args Bundled arguments
+    \param hStream stream to execute on
+*/
+void hpmc_lattice_field(const lattice_field_args_t& args, hipStream_t hStream)
+    {
+    assert(args.d_postype);
+    assert(args.d_trial_postype);
+    assert(args.d_tag);
+
+    // determine the maximum block size and clamp the input block size down
+    static int max_block_size = -1;
+    if (max_block_size == -1)
+        {
+        hipFuncAttributes attr;
+        hipFuncGetAttributes(&attr, reinterpret_cast<const void*>(kernel::hpmc_lattice_field));
+        max_block_size = attr.maxThreadsPerBlock;
+        }
+
+    unsigned int run_block_size = min(args.block_size, (unsigned int)max_block_size);
+    dim3 threads(run_block_size, 1, 1);
+
+    for (int idev = args.gpu_partition.getNumActiveGPUs() - 1; idev >= 0; --idev)
+        {
+        auto range = args.gpu_partition.getRangeAndSetGPU(idev);
+
+        unsigned int nwork = range.second - range.first;
+        if (nwork == 0)
+            continue;
+
+        dim3 grid(nwork / run_block_size + 1, 1, 1);
+
+        hipLaunchKernelGGL(kernel::hpmc_lattice_field,
+                           grid,
+                           threads,
+                           0,
+                           hStream,
+                           args.d_postype,
+                           args.d_orientation,
+                           args.d_trial_postype,
+                           args.d_trial_orientation,
+                           args.d_trial_move_type,
+                           args.d_tag,
+                           args.d_reject_out_of_cell,
+                           args.d_lattice_positions,
+                           args.d_lattice_orientations,
+                           args.d_symmetry,
+                           args.n_symmetry,
+                           args.k,
+                           args.q,
+                           args.box,
+                           args.origin,
+                           args.seed,
+                           args.rank,
+                           args.timestep,
+                           args.select,
+                           range.first,
+                           nwork);
+        }
+    }
+
+    } // end namespace gpu
+    } // end namespace hpmc
@@ -0,0 +1,84 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file ExternalFieldLatticeGPU.cuh
+    \brief Declares the GPU kernel driver for the harmonic lattice field
+*/
+
+#pragma once
+
+#include <hip/hip_runtime.h>
+
+#include "hoomd/BoxDim.h"
+#include "hoomd/GPUPartition.cuh"
+#include "hoomd/HOOMDMath.h"
+
+namespace hpmc
+    {
+namespace gpu
+    {
+//! Wraps arguments to hpmc_lattice_field
+/*! \ingroup hpmc_data_structs */
+struct lattice_field_args_t
+    {
+    //! Construct a lattice_field_args_t
+    lattice_field_args_t(const Scalar4* _d_postype,
+                         const Scalar4* _d_orientation,
+                         const Scalar4* _d_trial_postype,
+                         const Scalar4* _d_trial_orientation,
+                         const unsigned int* _d_trial_move_type,
+                         const unsigned int* _d_tag,
+                         unsigned int* _d_reject_out_of_cell,
+                         const Scalar3* _d_lattice_positions,
+                         const Scalar4* _d_lattice_orientations,
+                         const Scalar4* _d_symmetry,
+                         const unsigned int _n_symmetry,
+                         const Scalar _k,
+                         const Scalar _q,
+                         const BoxDim& _box,
+                         const Scalar3& _origin,
+                         const uint16_t _seed,
+                         const unsigned int _rank,
+                         const uint64_t _timestep,
+                         const unsigned int _select,
+                         const unsigned int _block_size,
+                         const GPUPartition& _gpu_partition)
+        : d_postype(_d_postype), d_orientation(_d_orientation), d_trial_postype(_d_trial_postype),
+          d_trial_orientation(_d_trial_orientation), d_trial_move_type(_d_trial_move_type),
+          d_tag(_d_tag), d_reject_out_of_cell(_d_reject_out_of_cell),
+          d_lattice_positions(_d_lattice_positions),
+          d_lattice_orientations(_d_lattice_orientations), d_symmetry(_d_symmetry),
+          n_symmetry(_n_symmetry), k(_k), q(_q), box(_box), origin(_origin), seed(_seed),
+          rank(_rank), timestep(_timestep), select(_select), block_size(_block_size),
+          gpu_partition(_gpu_partition)
+        {
+        }
+
+    const Scalar4* d_postype;               //!< postype array
+    const Scalar4* d_orientation;           //!< orientation array
+    const Scalar4* d_trial_postype;         //!< New positions (and type) of particles
+    const Scalar4* d_trial_orientation;     //!< New orientations of particles
+    const unsigned int* d_trial_move_type;  //!< 0=no move, 1/2 = translate/rotate
+    const unsigned int* d_tag;              //!< Particle tags
+    unsigned int* d_reject_out_of_cell;     //!< Flag if a particle move has been rejected a priori
+    const Scalar3* d_lattice_positions;     //!< Reference positions by tag (NULL if not set)
+    const Scalar4* d_lattice_orientations;  //!< Reference orientations by tag (NULL if not set)
+    const Scalar4* d_symmetry;              //!< Symmetry rotations of the shape
+    const unsigned int n_symmetry;          //!< Number of symmetry rotations
+    const Scalar k;                         //!< Translational spring constant
+    const Scalar q;                         //!< Rotational spring constant
+    const BoxDim& box;                      //!< Global simulation box
+    const Scalar3 origin;                   //!< Origin shift of the particle data
+    const uint16_t seed;                    //!< RNG seed
+    const unsigned int rank;                //!< MPI Rank
+    const uint64_t timestep;                //!< Current timestep
+    const unsigned int select;              //!< Current selection
+    const unsigned int block_size;          //!< Block size to execute
+    const GPUPartition& gpu_partition;      //!< split particles among GPUs
+    };
+
+//! Kernel driver for kernel::hpmc_lattice_field()
+void hpmc_lattice_field(const lattice_field_args_t& args, hipStream_t hStream);
+
+    } // end namespace gpu
+    } // end namespace hpmc
@@ -0,0 +1,153 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#pragma once
+
+#ifdef ENABLE_HIP
+
+#include "ExternalFieldLattice.h"
+#include "ExternalFieldLatticeGPU.cuh"
+
+#include "hoomd/Autotuner.h"
+#include "hoomd/GPUArray.h"
+
+#include <hip/hip_runtime.h>
+
+/*! \file ExternalFieldLatticeGPU.h
+    \brief Declaration of ExternalFieldLatticeGPU
+    \note This header cannot be compiled by nvcc
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include <pybind11/pybind11.h>
+
+namespace hpmc
+    {
+//! Harmonic lattice field applied to the trial moves of the GPU integrators
+/*! The energy of a particle in the field only depends on its own position and orientation, so
+    computeExternalFieldGPU() accepts or rejects every trial move with a Metropolis test on the
+    change in the field energy. The whole system energies for box moves and logging are still
+    computed on the host by ExternalFieldLattice.
+*/
+template<class Shape> class ExternalFieldLatticeGPU : public ExternalFieldLattice<Shape>
+    {
+    public:
+    //! Constructor
+    ExternalFieldLatticeGPU(std::shared_ptr<SystemDefinition> sysdef,
+                            pybind11::list r0,
+                            Scalar k,
+                            pybind11::list q0,
+                            Scalar q,
+                            pybind11::list symRotations)
+        : ExternalFieldLattice<Shape>(sysdef, r0, k, q0, q, symRotations)
+        {
+        hipDeviceProp_t dev_prop = this->m_exec_conf->dev_prop;
+        m_tuner.reset(new Autotuner(dev_prop.warpSize,
+                                    dev_prop.maxThreadsPerBlock,
+                                    dev_prop.warpSize,
+                                    5,
+                                    100000,
+                                    "hpmc_lattice_field",
+                                    this->m_exec_conf));
+
+        // the symmetry rotations are fixed at construction
+        GPUArray<Scalar4> symmetry(this->m_symmetry.size(), this->m_exec_conf);
+            {
+            ArrayHandle<Scalar4> h_symmetry(symmetry,
+                                            access_location::host,
+                                            access_mode::overwrite);
+            for (size_t i = 0; i < this->m_symmetry.size(); i++)
+                h_symmetry.data[i] = quat_to_scalar4(this->m_symmetry[i]);
+            }
+        m_symmetry_gpu.swap(symmetry);
+        }
+
+    //! Apply the lattice field to the trial moves
+    /*! \param args Kernel arguments
+        \param hStream stream to execute on
+    */
+    virtual void computeExternalFieldGPU(const ExternalField::gpu_args_t& args,
+                                         hipStream_t hStream)
+        {
+        ArrayHandle<unsigned int> d_tag(this->m_pdata->getTags(),
+                                        access_location::device,
+                                        access_mode::read);
+
+        // the reference lists are null when they are not set, the kernel skips their terms
+        ArrayHandle<Scalar3> d_lattice_positions(this->m_latticePositions.getReferenceArray(),
+                                                 access_location::device,
+                                                 access_mode::read);
+        ArrayHandle<Scalar4> d_lattice_orientations(
+            this->m_latticeOrientations.getReferenceArray(),
+            access_location::device,
+            access_mode::read);
+        ArrayHandle<Scalar4> d_symmetry(m_symmetry_gpu, access_location::device, access_mode::read);
+
+        this->m_exec_conf->beginMultiGPU();
+        m_tuner->begin();
+        gpu::lattice_field_args_t lattice_args(args.d_postype,
+                                               args.d_orientation,
+                                               args.d_trial_postype,
+                                               args.d_trial_orientation,
+                                               args.d_trial_move_type,
+                                               d_tag.data,
+                                               args.d_reject_out_of_cell,
+                                               d_lattice_positions.data,
+                                               d_lattice_orientations.data,
+                                               d_symmetry.data,
+                                               (unsigned int)this->m_symmetry.size(),
+                                               this->m_k,
+                                               this->m_q,
+                                               args.box,
+                                               this->m_pdata->getOrigin(),
+                                               args.seed,
+                                               args.rank,
+                                               args.timestep,
+                                               args.select,
+                                               m_tuner->getParam(),
+                                               args.gpu_partition);
+        gpu::hpmc_lattice_field(lattice_args, hStream);
+        if (this->m_exec_conf->isCUDAErrorCheckingEnabled())
+            CHECK_CUDA_ERROR();
+        m_tuner->end();
+        this->m_exec_conf->endMultiGPU();
+        }
+
+    //! Set autotuner parameters
+    /*! \param enable Enable/disable autotuning
+        \param period period (approximate) in time steps when returning occurs
+    */
+    virtual void setAutotunerParams(bool enable, unsigned int period)
+        {
+        m_tuner->setPeriod(period);
+        m_tuner->setEnabled(enable);
+        }
+
+    protected:
+    std::unique_ptr<Autotuner> m_tuner; //!< Autotuner for the block size
+    GPUArray<Scalar4> m_symmetry_gpu;   //!< Symmetry rotations of the shape
+    };
+
+//! Export ExternalFieldLatticeGPU to python
+/*! \param m Python module to export to
+    \param name Name of the class in python
+*/
+template<class Shape> void export_LatticeFieldGPU(pybind11::module& m, std::string name)
+    {
+    pybind11::class_<ExternalFieldLatticeGPU<Shape>,
+                     ExternalFieldLattice<Shape>,
+                     std::shared_ptr<ExternalFieldLatticeGPU<Shape>>>(m, name.c_str())
+        .def(pybind11::init<std::shared_ptr<SystemDefinition>,
+                            pybind11::list,
+                            Scalar,
+                            pybind11::list,
+                            Scalar,
+                            pybind11::list>());
+    }
+
+    } // end namespace hpmc
+
+#endif // ENABLE_HIP
@@ -953,10 +953,10 @@ template<class Shape> class ExternalFieldWall : public ExternalFieldMono<Shape>
     std::vector<CylinderWall> m_Cylinders;
     std::vector<PlaneWall> m_Planes;
     Scalar m_Volume;
+    std::shared_ptr<IntegratorHPMCMono<Shape>> m_mc; //!< integrator
 
     private:
-    std::shared_ptr<IntegratorHPMCMono<Shape>> m_mc; //!< integrator
-    BoxDim m_box;                                    //!< the current box
+    BoxDim m_box; //!< the current box
     };
 
 template<class Shape> void export_ExternalFieldWall(pybind11::module& m, const std::string& name)
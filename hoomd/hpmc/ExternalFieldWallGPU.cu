@@ -0,0 +1,26 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "ExternalFieldWallGPU.cuh"
+
+/*! \file ExternalFieldWallGPU.cu
+    \brief Instantiates the hard wall kernel for the shapes that implement confinement tests
+*/
+
+namespace hpmc
+    {
+namespace gpu
+    {
+template void hpmc_wall_field<ShapeSphere>(const wall_field_args_t& args,
+                                           const ShapeSphere::param_type* d_params,
+                                           hipStream_t hStream);
+template void
+hpmc_wall_field<ShapeConvexPolyhedron>(const wall_field_args_t& args,
+                                       const ShapeConvexPolyhedron::param_type* d_params,
+                                       hipStream_t hStream);
+template void
+hpmc_wall_field<ShapeSpheropolyhedron>(const wall_field_args_t& args,
+                                       const ShapeSpheropolyhedron::param_type* d_params,
+                                       hipStream_t hStream);
+    } // end namespace gpu
+    } // end namespace hpmc
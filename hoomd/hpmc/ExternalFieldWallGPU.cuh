@@ -0,0 +1,593 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file ExternalFieldWallGPU.cuh
+    \brief Confinement tests and kernel for hard walls on the GPU
+*/
+
+#pragma once
+
+#include <hip/hip_runtime.h>
+
+#include "hoomd/BoxDim.h"
+#include "hoomd/GPUPartition.cuh"
+#include "hoomd/HOOMDMath.h"
+#include "hoomd/Index1D.h"
+#include "hoomd/VectorMath.h"
+
+#include "ShapeConvexPolyhedron.h"
+#include "ShapeSphere.h"
+#include "ShapeSpheropolyhedron.h"
+#include "XenoCollide3D.h"
+
+#include <cassert>
+
+// need to declare these class methods with __device__ qualifiers when building in nvcc
+// DEVICE is __device__ when included in nvcc and blank when included into the host compiler
+#undef DEVICE
+#ifdef __HIPCC__
+#define DEVICE __device__
+#else
+#define DEVICE
+#endif
+
+namespace hpmc
+    {
+namespace gpu
+    {
+//! Maximum number of cells per dimension of the wall grid
+const unsigned int MAX_WALL_GRID_DIM = 16;
+
+//! Spherical wall, the device side copy of SphereWall
+struct sphere_wall_t
+    {
+    Scalar rsq;          //!< Squared radius
+    vec3<Scalar> origin; //!< Center of the sphere
+    unsigned int inside; //!< Particles are confined to the inside of the sphere
+    };
+
+//! Cylindrical wall, the device side copy of CylinderWall
+struct cylinder_wall_t
+    {
+    Scalar rsq;               //!< Squared radius
+    vec3<Scalar> origin;      //!< A point on the axis
+    vec3<Scalar> orientation; //!< Unit vector along the axis
+    unsigned int inside;      //!< Particles are confined to the inside of the cylinder
+    };
+
+//! Plane wall, the device side copy of PlaneWall
+struct plane_wall_t
+    {
+    vec3<Scalar> normal; //!< Unit normal pointing to the allowed side
+    Scalar d;            //!< Offset of the plane, dot(normal, r) + d = 0 on the plane
+    };
+
+//! Support function of a sphere of radius r around the origin
+class SupportFuncWallSphere
+    {
+    public:
+    DEVICE SupportFuncWallSphere(OverlapReal _r) : r(_r) { }
+
+    DEVICE vec3<OverlapReal> operator()(const vec3<OverlapReal>& n) const
+        {
+        OverlapReal nsq = dot(n, n);
+        if (nsq == OverlapReal(0.0))
+            return vec3<OverlapReal>(0, 0, 0);
+        return n * (r * fast::rsqrt(nsq));
+        }
+
+    private:
+    OverlapReal r; //!< Radius
+    };
+
+//! Support function of the segment from -a to a swept by a sphere of radius r
+/*! This is the cylinder wall section that ExternalFieldWall builds as a spheropolyhedron with two
+    vertices.
+*/
+class SupportFuncWallCylinder
+    {
+    public:
+    DEVICE SupportFuncWallCylinder(const vec3<OverlapReal>& _a, OverlapReal _r) : a(_a), r(_r) { }
+
+    DEVICE vec3<OverlapReal> operator()(const vec3<OverlapReal>& n) const
+        {
+        vec3<OverlapReal> p = (dot(n, a) >= OverlapReal(0.0)) ? a : -a;
+        OverlapReal nsq = dot(n, n);
+        if (nsq == OverlapReal(0.0))
+            return p;
+        return p + n * (r * fast::rsqrt(nsq));
+        }
+
+    private:
+    vec3<OverlapReal> a; //!< End point of the segment
+    OverlapReal r;       //!< Sweep radius
+    };
+
+//! Test whether a shape is confined by a wall
+/*! The generic version rejects all configurations, as the host version in ExternalFieldWall.h.
+
+    The overloads below implement the same tests as the host versions of test_confined().
+*/
+template<class WallShape, class Shape>
+DEVICE inline bool test_confined(const WallShape& wall,
+                                 const Shape& shape,
+                                 const vec3<Scalar>& position,
+                                 const vec3<Scalar>& box_origin,
+                                 const BoxDim& box)
+    {
+    return false;
+    }
+
+//! Flags combinations of walls and shapes that the generic test_confined() handles
+/*! Walls are never culled from the wall grid for these combinations.
+ */
+template<class WallShape, class Shape> struct confinement_test
+    {
+    static const bool implemented = true;
+    };
+
+template<> struct confinement_test<cylinder_wall_t, ShapeSpheropolyhedron>
+    {
+    static const bool implemented = false;
+    };
+
+//! Position of a particle relative to the wall origin, in the minimum image
+DEVICE inline vec3<Scalar> wall_shifted_position(const vec3<Scalar>& position,
+                                                 const vec3<Scalar>& box_origin,
+                                                 const vec3<Scalar>& wall_origin,
+                                                 const BoxDim& box)
+    {
+    return vec3<Scalar>(box.minImage(vec_to_scalar3(position - box_origin - wall_origin)));
+    }
+
+//! Test whether a particle overlaps the outside of a sphere wall with xenocollide
+template<class Shape>
+DEVICE inline bool test_overlap_sphere_wall(const vec3<Scalar>& shifted_pos,
+                                            const sphere_wall_t& wall,
+                                            const Shape& shape)
+    {
+    unsigned int err = 0;
+    OverlapReal r = OverlapReal(sqrt(wall.rsq));
+    detail::SupportFuncConvexPolyhedron support(shape.verts, shape.verts.sweep_radius);
+    return xenocollide_3d(SupportFuncWallSphere(r),
+                          support,
+                          vec3<OverlapReal>(shifted_pos),
+                          quat<OverlapReal>(shape.orientation),
+                          r + shape.getCircumsphereDiameter() / OverlapReal(2.0),
+                          err);
+    }
+
+// Spherical walls and spheres
+DEVICE inline bool test_confined(const sphere_wall_t& wall,
+                                 const ShapeSphere& shape,
+                                 const vec3<Scalar>& position,
+                                 const vec3<Scalar>& box_origin,
+                                 const BoxDim& box)
+    {
+    vec3<Scalar> shifted_pos = wall_shifted_position(position, box_origin, wall.origin, box);
+    Scalar r = sqrt(dot(shifted_pos, shifted_pos));
+    Scalar radius = shape.getCircumsphereDiameter() / Scalar(2.0);
+
+    if (wall.inside)
+        {
+        Scalar max_dist = r + radius;
+        return wall.rsq > max_dist * max_dist;
+        }
+
+    // min_dist is zero when the circumsphere of the particle contains the wall origin
+    Scalar min_dist = (r > radius) ? r - radius : Scalar(0.0);
+    return wall.rsq < min_dist * min_dist;
+    }
+
+// Spherical walls and convex polyhedra
+DEVICE inline bool test_confined(const sphere_wall_t& wall,
+                                 const ShapeConvexPolyhedron& shape,
+                                 const vec3<Scalar>& position,
+                                 const vec3<Scalar>& box_origin,
+                                 const BoxDim& box)
+    {
+    vec3<Scalar> shifted_pos = wall_shifted_position(position, box_origin, wall.origin, box);
+    Scalar r = sqrt(dot(shifted_pos, shifted_pos));
+    Scalar radius = shape.getCircumsphereDiameter() / Scalar(2.0);
+
+    if (wall.inside)
+        {
+        Scalar max_dist = r + radius;
+        if (wall.rsq > max_dist * max_dist)
+            return true;
+
+        for (unsigned int v = 0; v < shape.verts.N; v++)
+            {
+            vec3<Scalar> pos(shape.verts.x[v], shape.verts.y[v], shape.verts.z[v]);
+            vec3<Scalar> rotated_pos = rotate(shape.orientation, pos) + shifted_pos;
+            if (!(wall.rsq > dot(rotated_pos, rotated_pos)))
+                return false;
+            }
+        return true;
+        }
+
+    Scalar min_dist = (r > radius) ? r - radius : Scalar(0.0);
+    if (wall.rsq < min_dist * min_dist)
+        return true;
+    return !test_overlap_sphere_wall(shifted_pos, wall, shape);
+    }
+
+// Spherical walls and convex spheropolyhedra
+DEVICE inline bool test_confined(const sphere_wall_t& wall,
+                                 const ShapeSpheropolyhedron& shape,
+                                 const vec3<Scalar>& position,
+                                 const vec3<Scalar>& box_origin,
+                                 const BoxDim& box)
+    {
+    vec3<Scalar> shifted_pos = wall_shifted_position(position, box_origin, wall.origin, box);
+    Scalar r = sqrt(dot(shifted_pos, shifted_pos));
+    Scalar radius = shape.getCircumsphereDiameter() / Scalar(2.0);
+
+    if (wall.inside)
+        {
+        Scalar max_dist = r + radius;
+        if (wall.rsq > max_dist * max_dist)
+            return true;
+
+        // a pure sphere is outside when its circumsphere is
+        if (shape.verts.N == 0)
+            return false;
+
+        for (unsigned int v = 0; v < shape.verts.N; v++)
+            {
+            vec3<Scalar> pos(shape.verts.x[v], shape.verts.y[v], shape.verts.z[v]);
+            vec3<Scalar> rotated_pos = rotate(shape.orientation, pos) + shifted_pos;
+            Scalar tot_r = sqrt(dot(rotated_pos, rotated_pos)) + shape.verts.sweep_radius;
+            if (!(wall.rsq > tot_r * tot_r))
+                return false;
+            }
+        return true;
+        }
+
+    Scalar min_dist = (r > radius) ? r - radius : Scalar(0.0);
+    if (wall.rsq < min_dist * min_dist)
+        return true;
+    if (shape.verts.N == 0)
+        return false;
+    return !test_overlap_sphere_wall(shifted_pos, wall, shape);
+    }
+
+// Cylindrical walls and spheres
+DEVICE inline bool test_confined(const cylinder_wall_t& wall,
+                                 const ShapeSphere& shape,
+                                 const vec3<Scalar>& position,
+                                 const vec3<Scalar>& box_origin,
+                                 const BoxDim& box)
+    {
+    vec3<Scalar> shifted_pos = wall_shifted_position(position, box_origin, wall.origin, box);
+
+    // component of the position perpendicular to the axis
+    vec3<Scalar> dist_vec = cross(shifted_pos, wall.orientation);
+    Scalar r = sqrt(dot(dist_vec, dist_vec));
+    Scalar radius = shape.getCircumsphereDiameter() / Scalar(2.0);
+
+    if (wall.inside)
+        {
+        Scalar max_dist = r + radius;
+        return wall.rsq > max_dist * max_dist;
+        }
+
+    Scalar min_dist = (r > radius) ? r - radius : Scalar(0.0);
+    return wall.rsq < min_dist * min_dist;
+    }
+
+// Cylindrical walls and convex polyhedra
+DEVICE inline bool test_confined(const cylinder_wall_t& wall,
+                                 const ShapeConvexPolyhedron& shape,
+                                 const vec3<Scalar>& position,
+                                 const vec3<Scalar>& box_origin,
+                                 const BoxDim& box)
+    {
+    vec3<Scalar> shifted_pos = wall_shifted_position(position, box_origin, wall.origin, box);
+
+    // component of the position perpendicular to the axis
+    vec3<Scalar> dist_vec = cross(shifted_pos, wall.orientation);
+    Scalar r = sqrt(dot(dist_vec, dist_vec));
+    OverlapReal diameter = shape.getCircumsphereDiameter();
+    Scalar radius = diameter / Scalar(2.0);
+
+    if (wall.inside)
+        {
+        Scalar max_dist = r + radius;
+        if (wall.rsq > max_dist * max_dist)
+            return true;
+
+        for (unsigned int v = 0; v < shape.verts.N; v++)
+            {
+            vec3<Scalar> pos(shape.verts.x[v], shape.verts.y[v], shape.verts.z[v]);
+            vec3<Scalar> rotated_pos = rotate(shape.orientation, pos) + shifted_pos;
+            dist_vec = cross(rotated_pos, wall.orientation);
+            if (!(wall.rsq > dot(dist_vec, dist_vec)))
+                return false;
+            }
+        return true;
+        }
+
+    Scalar min_dist = (r > radius) ? r - radius : Scalar(0.0);
+    if (wall.rsq < min_dist * min_dist)
+        return true;
+
+    // test against a section of the cylinder one particle diameter long on each side
+    vec3<Scalar> r_ab = shifted_pos - dot(shifted_pos, wall.orientation) * wall.orientation;
+    OverlapReal sweep_radius = OverlapReal(sqrt(wall.rsq));
+    unsigned int err = 0;
+    return !xenocollide_3d(
+        SupportFuncWallCylinder(vec3<OverlapReal>(wall.orientation) * diameter, sweep_radius),
+        detail::SupportFuncConvexPolyhedron(shape.verts, shape.verts.sweep_radius),
+        vec3<OverlapReal>(r_ab),
+        quat<OverlapReal>(shape.orientation),
+        diameter + sweep_radius + diameter / OverlapReal(2.0),
+        err);
+    }
+
+// Plane walls and spheres
+DEVICE inline bool test_confined(const plane_wall_t& wall,
+                                 const ShapeSphere& shape,
+                                 const vec3<Scalar>& position,
+                                 const vec3<Scalar>& box_origin,
+                                 const BoxDim& box)
+    {
+    vec3<Scalar> shifted_pos(box.minImage(vec_to_scalar3(position - box_origin)));
+    Scalar dist = dot(wall.normal, shifted_pos) + wall.d;
+    return (dist < 0) ? false : 0 < (dist - shape.getCircumsphereDiameter() / Scalar(2.0));
+    }
+
+// Plane walls and convex polyhedra
+DEVICE inline bool test_confined(const plane_wall_t& wall,
+                                 const ShapeConvexPolyhedron& shape,
+                                 const vec3<Scalar>& position,
+                                 const vec3<Scalar>& box_origin,
+                                 const BoxDim& box)
+    {
+    vec3<Scalar> shifted_pos(box.minImage(vec_to_scalar3(position - box_origin)));
+    Scalar dist = dot(wall.normal, shifted_pos) + wall.d;
+    if (!(Scalar(0.0) < dist))
+        return false;
+    if (dist > shape.getCircumsphereDiameter() / Scalar(2.0))
+        return true;
+
+    for (unsigned int v = 0; v < shape.verts.N; v++)
+        {
+        vec3<Scalar> pos(shape.verts.x[v], shape.verts.y[v], shape.verts.z[v]);
+        vec3<Scalar> rotated_pos = rotate(shape.orientation, pos) + shifted_pos;
+        if (!(Scalar(0.0) < dot(wall.normal, rotated_pos) + wall.d))
+            return false;
+        }
+    return true;
+    }
+
+// Plane walls and convex spheropolyhedra
+DEVICE inline bool test_confined(const plane_wall_t& wall,
+                                 const ShapeSpheropolyhedron& shape,
+                                 const vec3<Scalar>& position,
+                                 const vec3<Scalar>& box_origin,
+                                 const BoxDim& box)
+    {
+    vec3<Scalar> shifted_pos(box.minImage(vec_to_scalar3(position - box_origin)));
+    Scalar dist = dot(wall.normal, shifted_pos) + wall.d;
+    if (!(Scalar(0.0) < dist))
+        return false;
+    if (dist > shape.getCircumsphereDiameter() / Scalar(2.0))
+        return true;
+
+    // pure sphere
+    if (shape.verts.N == 0)
+        return shape.verts.sweep_radius < dist;
+
+    for (unsigned int v = 0; v < shape.verts.N; v++)
+        {
+        vec3<Scalar> pos(shape.verts.x[v], shape.verts.y[v], shape.verts.z[v]);
+        vec3<Scalar> rotated_pos = rotate(shape.orientation, pos) + shifted_pos;
+        if (!(shape.verts.sweep_radius < dot(wall.normal, rotated_pos) + wall.d))
+            return false;
+        }
+    return true;
+    }
+
+//! Wraps arguments to hpmc_wall_field
+/*! \ingroup hpmc_data_structs */
+struct wall_field_args_t
+    {
+    //! Construct a wall_field_args_t
+    wall_field_args_t(const Scalar4* _d_trial_postype,
+                      const Scalar4* _d_trial_orientation,
+                      const unsigned int* _d_trial_move_type,
+                      unsigned int* _d_reject_out_of_cell,
+                      const sphere_wall_t* _d_spheres,
+                      const unsigned int _n_spheres,
+                      const cylinder_wall_t* _d_cylinders,
+                      const unsigned int _n_cylinders,
+                      const plane_wall_t* _d_planes,
+                      const unsigned int _n_planes,
+                      const unsigned int* _d_grid,
+                      const uint3& _grid_dim,
+                      const unsigned int _grid_words,
+                      const BoxDim& _box,
+                      const Scalar3& _origin,
+                      const unsigned int _block_size,
+                      const GPUPartition& _gpu_partition)
+        : d_trial_postype(_d_trial_postype), d_trial_orientation(_d_trial_orientation),
+          d_trial_move_type(_d_trial_move_type), d_reject_out_of_cell(_d_reject_out_of_cell),
+          d_spheres(_d_spheres), n_spheres(_n_spheres), d_cylinders(_d_cylinders),
+          n_cylinders(_n_cylinders), d_planes(_d_planes), n_planes(_n_planes), d_grid(_d_grid),
+          grid_dim(_grid_dim), grid_words(_grid_words), box(_box), origin(_origin),
+          block_size(_block_size), gpu_partition(_gpu_partition)
+        {
+        }
+
+    const Scalar4* d_trial_postype;        //!< New positions (and type) of particles
+    const Scalar4* d_trial_orientation;    //!< New orientations of particles
+    const unsigned int* d_trial_move_type; //!< 0=no move, 1/2 = translate/rotate
+    unsigned int* d_reject_out_of_cell;    //!< Flag if a particle move has been rejected a priori
+    const sphere_wall_t* d_spheres;        //!< Spherical walls
+    const unsigned int n_spheres;          //!< Number of spherical walls
+    const cylinder_wall_t* d_cylinders;    //!< Cylindrical walls
+    const unsigned int n_cylinders;        //!< Number of cylindrical walls
+    const plane_wall_t* d_planes;          //!< Plane walls
+    const unsigned int n_planes;           //!< Number of plane walls
+    const unsigned int* d_grid;            //!< Per type, per cell bit masks of the walls to test
+    const uint3 grid_dim;                  //!< Dimensions of the wall grid
+    const unsigned int grid_words;         //!< Number of words in a bit mask
+    const BoxDim& box;                     //!< Global simulation box
+    const Scalar3 origin;                  //!< Origin shift of the particle data
+    const unsigned int block_size;         //!< Block size to execute
+    const GPUPartition& gpu_partition;     //!< split particles among GPUs
+    };
+
+template<class Shape>
+void hpmc_wall_field(const wall_field_args_t& args,
+                     const typename Shape::param_type* d_params,
+                     hipStream_t hStream);
+
+#ifdef __HIPCC__
+namespace kernel
+    {
+//! Test whether a wall is in the bit mask of a grid cell
+__device__ inline bool wall_in_mask(const unsigned int* mask, unsigned int bit)
+    {
+    return !mask || (mask[bit >> 5] & (1u << (bit & 31)));
+    }
+
+//! Reject the trial moves that place particles outside of the walls
+/*! One thread processes one particle. The thread only tests the walls in the bit mask of the wall
+    grid cell that contains the trial position, particles outside of the grid test all walls.
+    Rejected moves set the a priori rejection flag, so that the narrow phase and patch kernels skip
+    the particle.
+*/
+template<class Shape>
+__global__ void hpmc_wall_field(const Scalar4* d_trial_postype,
+                                const Scalar4* d_trial_orientation,
+                                const unsigned int* d_trial_move_type,
+                                unsigned int* d_reject_out_of_cell,
+                                const sphere_wall_t* d_spheres,
+                                const unsigned int n_spheres,
+                                const cylinder_wall_t* d_cylinders,
+                                const unsigned int n_cylinders,
+                                const plane_wall_t* d_planes,
+                                const unsigned int n_planes,
+                                const unsigned int* d_grid,
+                                const uint3 grid_dim,
+                                const unsigned int grid_words,
+                                const BoxDim box,
+                                const Scalar3 origin,
+                                const typename Shape::param_type* d_params,
+                                const unsigned int work_offset,
+                                const unsigned int nwork)
+    {
+    unsigned int work_idx = blockIdx.x * blockDim.x + threadIdx.x;
+    if (work_idx >= nwork)
+        return;
+    unsigned int idx = work_idx + work_offset;
+
+    if (!d_trial_move_type[idx] || d_reject_out_of_cell[idx])
+        return;
+
+    Scalar4 postype = d_trial_postype[idx];
+    unsigned int type = __scalar_as_int(postype.w);
+    vec3<Scalar> pos(postype);
+    Shape shape(quat<Scalar>(d_trial_orientation[idx]), d_params[type]);
+    vec3<Scalar> box_origin(origin);
+
+    // find the bit mask of the grid cell
+    const unsigned int* mask = NULL;
+    Scalar3 f = box.makeFraction(vec_to_scalar3(pos));
+    if (f.x >= Scalar(0.0) && f.x < Scalar(1.0) && f.y >= Scalar(0.0) && f.y < Scalar(1.0)
+        && f.z >= Scalar(0.0) && f.z < Scalar(1.0))
+        {
+        unsigned int i = min((unsigned int)(f.x * grid_dim.x), grid_dim.x - 1);
+        unsigned int j = min((unsigned int)(f.y * grid_dim.y), grid_dim.y - 1);
+        unsigned int k = min((unsigned int)(f.z * grid_dim.z), grid_dim.z - 1);
+        Index3D cell_indexer(grid_dim.x, grid_dim.y, grid_dim.z);
+        mask = d_grid + (type * cell_indexer.getNumElements() + cell_indexer(i, j, k)) * grid_words;
+        }
+
+    bool accept = true;
+    unsigned int bit = 0;
+    for (unsigned int w = 0; w < n_spheres && accept; w++, bit++)
+        if (wall_in_mask(mask, bit))
+            accept = test_confined(d_spheres[w], shape, pos, box_origin, box);
+    for (unsigned int w = 0; w < n_cylinders && accept; w++, bit++)
+        if (wall_in_mask(mask, bit))
+            accept = test_confined(d_cylinders[w], shape, pos, box_origin, box);
+    for (unsigned int w = 0; w < n_planes && accept; w++, bit++)
+        if (wall_in_mask(mask, bit))
+            accept = test_confined(d_planes[w], shape, pos, box_origin, box);
+
+    if (!accept)
+        d_reject_out_of_cell[idx] = 1;
+    }
+    } // end namespace kernel
+
+//! Kernel driver for kernel::hpmc_wall_field()
+/*! \param args Bundled arguments
+    \param d_params Per-type shape parameters
+    \param hStream stream to execute on
+
+    \ingroup hpmc_kernels
+*/
+template<class Shape>
+void hpmc_wall_field(const wall_field_args_t& args,
+                     const typename Shape::param_type* d_params,
+                     hipStream_t hStream)
+    {
+    assert(args.d_trial_postype);
+    assert(args.d_grid);
+
+    // determine the maximum block size and clamp the input block size down
+    static int max_block_size = -1;
+    if (max_block_size == -1)
+        {
+        hipFuncAttributes attr;
+        hipFuncGetAttributes(&attr, reinterpret_cast<const void*>(kernel::hpmc_wall_field<Shape>));
+        max_block_size = attr.maxThreadsPerBlock;
+        }
+
+    unsigned int run_block_size = min(args.block_size, (unsigned int)max_block_size);
+    dim3 threads(run_block_size, 1, 1);
+
+    for (int idev = args.gpu_partition.getNumActiveGPUs() - 1; idev >= 0; --idev)
+        {
+        auto range = args.gpu_partition.getRangeAndSetGPU(idev);
+
+        unsigned int nwork = range.second - range.first;
+        if (nwork == 0)
+            continue;
+
+        dim3 grid(nwork / run_block_size + 1, 1, 1);
+
+        hipLaunchKernelGGL((kernel::hpmc_wall_field<Shape>),
+                           grid,
+                           threads,
+                           0,
+                           hStream,
+                           args.d_trial_postype,
+                           args.d_trial_orientation,
+                           args.d_trial_move_type,
+                           args.d_reject_out_of_cell,
+                           args.d_spheres,
+                           args.n_spheres,
+                           args.d_cylinders,
+                           args.n_cylinders,
+                           args.d_planes,
+                           args.n_planes,
+                           args.d_grid,
+                           args.grid_dim,
+                           args.grid_words,
+                           args.box,
+                           args.origin,
+                           d_params,
+                           range.first,
+                           nwork);
+        }
+    }
+#endif
+
+    } // end namespace gpu
+    } // end namespace hpmc
+
+#undef DEVICE
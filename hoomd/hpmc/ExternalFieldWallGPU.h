@@ -0,0 +1,402 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#pragma once
+
+#ifdef ENABLE_HIP
+
+#include "ExternalFieldWall.h"
+#include "ExternalFieldWallGPU.cuh"
+
+#include "hoomd/Autotuner.h"
+#include "hoomd/GPUArray.h"
+
+#include <hip/hip_runtime.h>
+
+#include <algorithm>
+#include <vector>
+
+/*! \file ExternalFieldWallGPU.h
+    \brief Declaration of ExternalFieldWallGPU
+    \note This header cannot be compiled by nvcc
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include <pybind11/pybind11.h>
+
+namespace hpmc
+    {
+//! Hard walls applied to the trial moves of the GPU integrators
+/*! computeExternalFieldGPU() rejects every trial move that places a particle outside of a wall,
+    with the same confinement tests as ExternalFieldWall::energydiff().
+
+    Most particles are far from most walls. A coarse grid over the box (cells about one particle
+    diameter wide, at most gpu::MAX_WALL_GRID_DIM per dimension) stores a bit mask of walls per
+    particle type and cell, as EvaluatorWalls does for the MD wall potentials. A wall is left out of
+    a cell only when every particle of that type centered in the cell provably passes its test:
+    the cell is farther from the wall than the circumsphere radius, on the allowed side. The grid is
+    rebuilt on the host when the walls, the box, or the shape parameters change.
+
+    Whole system overlap counts for box moves and UpdaterExternalFieldWall are still computed on the
+    host by ExternalFieldWall.
+*/
+template<class Shape> class ExternalFieldWallGPU : public ExternalFieldWall<Shape>
+    {
+    public:
+    //! Constructor
+    ExternalFieldWallGPU(std::shared_ptr<SystemDefinition> sysdef,
+                         std::shared_ptr<IntegratorHPMCMono<Shape>> mc)
+        : ExternalFieldWall<Shape>(sysdef, mc), m_grid_dim(make_uint3(1, 1, 1)), m_grid_words(0)
+        {
+        hipDeviceProp_t dev_prop = this->m_exec_conf->dev_prop;
+        m_tuner.reset(new Autotuner(dev_prop.warpSize,
+                                    dev_prop.maxThreadsPerBlock,
+                                    dev_prop.warpSize,
+                                    5,
+                                    100000,
+                                    "hpmc_wall_field",
+                                    this->m_exec_conf));
+        }
+
+    //! Reject the trial moves that place particles outside of the walls
+    /*! \param args Kernel arguments
+        \param hStream stream to execute on
+    */
+    virtual void computeExternalFieldGPU(const ExternalField::gpu_args_t& args,
+                                         hipStream_t hStream)
+        {
+        if (this->m_Spheres.empty() && this->m_Cylinders.empty() && this->m_Planes.empty())
+            return;
+
+        updateWallGrid();
+
+        ArrayHandle<gpu::sphere_wall_t> d_spheres(m_sphere_walls,
+                                                  access_location::device,
+                                                  access_mode::read);
+        ArrayHandle<gpu::cylinder_wall_t> d_cylinders(m_cylinder_walls,
+                                                      access_location::device,
+                                                      access_mode::read);
+        ArrayHandle<gpu::plane_wall_t> d_planes(m_plane_walls,
+                                                access_location::device,
+                                                access_mode::read);
+        ArrayHandle<unsigned int> d_grid(m_grid, access_location::device, access_mode::read);
+
+        this->m_exec_conf->beginMultiGPU();
+        m_tuner->begin();
+        gpu::wall_field_args_t wall_args(args.d_trial_postype,
+                                         args.d_trial_orientation,
+                                         args.d_trial_move_type,
+                                         args.d_reject_out_of_cell,
+                                         d_spheres.data,
+                                         (unsigned int)this->m_Spheres.size(),
+                                         d_cylinders.data,
+                                         (unsigned int)this->m_Cylinders.size(),
+                                         d_planes.data,
+                                         (unsigned int)this->m_Planes.size(),
+                                         d_grid.data,
+                                         m_grid_dim,
+                                         m_grid_words,
+                                         args.box,
+                                         this->m_pdata->getOrigin(),
+                                         m_tuner->getParam(),
+                                         args.gpu_partition);
+        gpu::hpmc_wall_field<Shape>(wall_args, this->m_mc->getParams().data(), hStream);
+        if (this->m_exec_conf->isCUDAErrorCheckingEnabled())
+            CHECK_CUDA_ERROR();
+        m_tuner->end();
+        this->m_exec_conf->endMultiGPU();
+        }
+
+    //! Set autotuner parameters
+    /*! \param enable Enable/disable autotuning
+        \param period period (approximate) in time steps when returning occurs
+    */
+    virtual void setAutotunerParams(bool enable, unsigned int period)
+        {
+        m_tuner->setPeriod(period);
+        m_tuner->setEnabled(enable);
+        }
+
+    protected:
+    std::unique_ptr<Autotuner> m_tuner;            //!< Autotuner for the block size
+    GPUArray<gpu::sphere_wall_t> m_sphere_walls;     //!< Spherical walls on the device
+    GPUArray<gpu::cylinder_wall_t> m_cylinder_walls; //!< Cylindrical walls on the device
+    GPUArray<gpu::plane_wall_t> m_plane_walls;       //!< Plane walls on the device
+    GPUArray<unsigned int> m_grid;                   //!< Per type, per cell bit masks of walls
+    uint3 m_grid_dim;                                //!< Dimensions of the wall grid
+    unsigned int m_grid_words;                       //!< Number of words in a bit mask
+    std::vector<Scalar> m_grid_key; //!< Walls, box and shape radii the grid was built for
+
+    //! Copy the walls to the device and rebuild the wall grid when they changed
+    /*! The walls are scaled with the box and may be modified through the python interface at any
+        time, so the current parameters are compared to the ones the grid was built for.
+    */
+    void updateWallGrid()
+        {
+        const BoxDim box = this->m_pdata->getGlobalBox();
+        const vec3<Scalar> box_origin(this->m_pdata->getOrigin());
+        const auto& params = this->m_mc->getParams();
+
+        std::vector<Scalar> radius(params.size());
+        for (unsigned int type = 0; type < params.size(); type++)
+            radius[type] = Shape(quat<Scalar>(), params[type]).getCircumsphereDiameter() / 2.0;
+
+        std::vector<Scalar> key(radius);
+        auto push_vec = [&key](const vec3<Scalar>& v)
+        {
+            key.push_back(v.x);
+            key.push_back(v.y);
+            key.push_back(v.z);
+        };
+        push_vec(vec3<Scalar>(box.getL()));
+        key.push_back(box.getTiltFactorXY());
+        key.push_back(box.getTiltFactorXZ());
+        key.push_back(box.getTiltFactorYZ());
+        push_vec(box_origin);
+        for (const auto& wall : this->m_Spheres)
+            {
+            key.push_back(wall.rsq);
+            push_vec(wall.origin);
+            key.push_back(wall.inside);
+            }
+        for (const auto& wall : this->m_Cylinders)
+            {
+            key.push_back(wall.rsq);
+            push_vec(wall.origin);
+            push_vec(wall.orientation);
+            key.push_back(wall.inside);
+            }
+        for (const auto& wall : this->m_Planes)
+            {
+            push_vec(wall.normal);
+            key.push_back(wall.d);
+            }
+
+        if (key == m_grid_key)
+            return;
+        m_grid_key.swap(key);
+
+        // copy the walls
+        GPUArray<gpu::sphere_wall_t> sphere_walls(this->m_Spheres.size(), this->m_exec_conf);
+            {
+            ArrayHandle<gpu::sphere_wall_t> h_spheres(sphere_walls,
+                                                      access_location::host,
+                                                      access_mode::overwrite);
+            for (size_t i = 0; i < this->m_Spheres.size(); i++)
+                {
+                h_spheres.data[i].rsq = this->m_Spheres[i].rsq;
+                h_spheres.data[i].origin = this->m_Spheres[i].origin;
+                h_spheres.data[i].inside = this->m_Spheres[i].inside;
+                }
+            }
+        m_sphere_walls.swap(sphere_walls);
+
+        GPUArray<gpu::cylinder_wall_t> cylinder_walls(this->m_Cylinders.size(), this->m_exec_conf);
+            {
+            ArrayHandle<gpu::cylinder_wall_t> h_cylinders(cylinder_walls,
+                                                          access_location::host,
+                                                          access_mode::overwrite);
+            for (size_t i = 0; i < this->m_Cylinders.size(); i++)
+                {
+                h_cylinders.data[i].rsq = this->m_Cylinders[i].rsq;
+                h_cylinders.data[i].origin = this->m_Cylinders[i].origin;
+                h_cylinders.data[i].orientation = this->m_Cylinders[i].orientation;
+                h_cylinders.data[i].inside = this->m_Cylinders[i].inside;
+                }
+            }
+        m_cylinder_walls.swap(cylinder_walls);
+
+        GPUArray<gpu::plane_wall_t> plane_walls(this->m_Planes.size(), this->m_exec_conf);
+            {
+            ArrayHandle<gpu::plane_wall_t> h_planes(plane_walls,
+                                                    access_location::host,
+                                                    access_mode::overwrite);
+            for (size_t i = 0; i < this->m_Planes.size(); i++)
+                {
+                h_planes.data[i].normal = this->m_Planes[i].normal;
+                h_planes.data[i].d = this->m_Planes[i].d;
+                }
+            }
+        m_plane_walls.swap(plane_walls);
+
+        buildWallGrid(box, box_origin, radius);
+        }
+
+    //! Build the per type, per cell bit masks of the walls
+    /*! \param box Global simulation box
+        \param box_origin Origin shift of the particle data
+        \param radius Circumsphere radius of each particle type
+
+        Bits [0, n_spheres) flag the spherical walls, followed by the cylindrical and the plane
+        walls. The distance of any point in a cell from a wall differs from the distance of the
+        cell center by at most the distance h from the center to the cell corners. This only holds
+        when the minimum image of the displacement from the wall is the same periodic image for the
+        whole cell, which is checked at the cell corners. All walls are kept for cells that cross
+        an image boundary of a wall.
+    */
+    void buildWallGrid(const BoxDim& box,
+                       const vec3<Scalar>& box_origin,
+                       const std::vector<Scalar>& radius)
+        {
+        unsigned int n_types = (unsigned int)radius.size();
+        unsigned int n_spheres = (unsigned int)this->m_Spheres.size();
+        unsigned int n_cylinders = (unsigned int)this->m_Cylinders.size();
+        unsigned int n_planes = (unsigned int)this->m_Planes.size();
+        m_grid_words = (n_spheres + n_cylinders + n_planes + 31) / 32;
+        bool is_2d = this->m_sysdef->getNDimensions() == 2;
+
+        // cells about one particle diameter wide
+        Scalar diameter_max = Scalar(0.0);
+        for (unsigned int type = 0; type < n_types; type++)
+            diameter_max = std::max(diameter_max, Scalar(2.0) * radius[type]);
+
+        Scalar3 npd = box.getNearestPlaneDistance();
+        m_grid_dim = make_uint3(1, 1, 1);
+        if (diameter_max > Scalar(0.0))
+            {
+            auto n_cells = [diameter_max](Scalar L)
+            {
+                return (unsigned int)std::max(
+                    Scalar(1.0),
+                    std::min(Scalar(gpu::MAX_WALL_GRID_DIM), floor(L / diameter_max)));
+            };
+            m_grid_dim = make_uint3(n_cells(npd.x), n_cells(npd.y), n_cells(npd.z));
+            }
+        if (is_2d)
+            m_grid_dim.z = 1;
+
+        // cell edges, padded against round off in the cell assignment
+        const Scalar pad = Scalar(1.01);
+        vec3<Scalar> a1 = vec3<Scalar>(box.getLatticeVector(0)) * (pad / Scalar(m_grid_dim.x));
+        vec3<Scalar> a2 = vec3<Scalar>(box.getLatticeVector(1)) * (pad / Scalar(m_grid_dim.y));
+        vec3<Scalar> a3 = vec3<Scalar>(box.getLatticeVector(2)) * (pad / Scalar(m_grid_dim.z));
+        if (is_2d)
+            a3 = vec3<Scalar>(0, 0, 0);
+        Scalar h = Scalar(0.5) * (sqrt(dot(a1, a1)) + sqrt(dot(a2, a2)) + sqrt(dot(a3, a3)));
+
+        std::vector<vec3<Scalar>> corners;
+        for (int sx = -1; sx <= 1; sx += 2)
+            for (int sy = -1; sy <= 1; sy += 2)
+                for (int sz = -1; sz <= 1; sz += 2)
+                    corners.push_back(Scalar(0.5)
+                                      * (Scalar(sx) * a1 + Scalar(sy) * a2 + Scalar(sz) * a3));
+
+        // images differ by at least one lattice vector
+        Scalar min_npd = std::min(npd.x, std::min(npd.y, is_2d ? npd.x : npd.z));
+        Scalar image_tol_sq = Scalar(0.25) * min_npd * min_npd;
+
+        // minimum image of the displacement v, or false when the cell around it crosses an image
+        // boundary
+        auto min_image = [&box, &corners, image_tol_sq](const vec3<Scalar>& v, vec3<Scalar>& s)
+        {
+            s = vec3<Scalar>(box.minImage(vec_to_scalar3(v)));
+            vec3<Scalar> shift = s - v;
+            for (const auto& corner : corners)
+                {
+                vec3<Scalar> u = v + corner;
+                vec3<Scalar> d = vec3<Scalar>(box.minImage(vec_to_scalar3(u))) - u - shift;
+                if (dot(d, d) > image_tol_sq)
+                    return false;
+                }
+            return true;
+        };
+
+        // test whether every point within h of distance r is confined by a round wall
+        auto round_wall_clear = [h](Scalar r, Scalar rsq, bool inside, Scalar radius_type)
+        {
+            if (inside)
+                {
+                Scalar max_dist = r + h + radius_type;
+                return rsq > max_dist * max_dist;
+                }
+            Scalar min_dist = r - h - radius_type;
+            return min_dist > Scalar(0.0) && rsq < min_dist * min_dist;
+        };
+
+        Index3D cell_indexer(m_grid_dim.x, m_grid_dim.y, m_grid_dim.z);
+        unsigned int n_cells = cell_indexer.getNumElements();
+        GPUArray<unsigned int> grid(n_types * n_cells * m_grid_words, this->m_exec_conf);
+        ArrayHandle<unsigned int> h_grid(grid, access_location::host, access_mode::overwrite);
+        std::fill(h_grid.data, h_grid.data + grid.getNumElements(), 0);
+
+        for (unsigned int k = 0; k < m_grid_dim.z; k++)
+            for (unsigned int j = 0; j < m_grid_dim.y; j++)
+                for (unsigned int i = 0; i < m_grid_dim.x; i++)
+                    {
+                    Scalar3 f = make_scalar3((Scalar(i) + Scalar(0.5)) / Scalar(m_grid_dim.x),
+                                             (Scalar(j) + Scalar(0.5)) / Scalar(m_grid_dim.y),
+                                             (Scalar(k) + Scalar(0.5)) / Scalar(m_grid_dim.z));
+                    vec3<Scalar> center = vec3<Scalar>(box.makeCoordinates(f)) - box_origin;
+                    if (is_2d)
+                        center.z = -box_origin.z;
+
+                    for (unsigned int type = 0; type < n_types; type++)
+                        {
+                        unsigned int* mask
+                            = h_grid.data
+                              + (type * n_cells + cell_indexer(i, j, k)) * m_grid_words;
+                        auto keep = [mask](unsigned int bit)
+                        { mask[bit >> 5] |= 1u << (bit & 31); };
+                        unsigned int bit = 0;
+                        vec3<Scalar> s;
+
+                        for (const auto& wall : this->m_Spheres)
+                            {
+                            if (!gpu::confinement_test<gpu::sphere_wall_t, Shape>::implemented
+                                || !min_image(center - wall.origin, s)
+                                || !round_wall_clear(sqrt(dot(s, s)),
+                                                     wall.rsq,
+                                                     wall.inside,
+                                                     radius[type]))
+                                keep(bit);
+                            bit++;
+                            }
+
+                        for (const auto& wall : this->m_Cylinders)
+                            {
+                            vec3<Scalar> perp;
+                            if (!gpu::confinement_test<gpu::cylinder_wall_t, Shape>::implemented
+                                || !min_image(center - wall.origin, s)
+                                || !round_wall_clear(
+                                    sqrt(dot(perp = cross(s, wall.orientation), perp)),
+                                    wall.rsq,
+                                    wall.inside,
+                                    radius[type]))
+                                keep(bit);
+                            bit++;
+                            }
+
+                        for (const auto& wall : this->m_Planes)
+                            {
+                            if (!gpu::confinement_test<gpu::plane_wall_t, Shape>::implemented
+                                || !min_image(center, s)
+                                || !(dot(wall.normal, s) + wall.d - h > radius[type]))
+                                keep(bit);
+                            bit++;
+                            }
+                        }
+                    }
+
+        m_grid.swap(grid);
+        }
+    };
+
+//! Export ExternalFieldWallGPU to python
+/*! \param m Python module to export to
+    \param name Name of the class in python
+*/
+template<class Shape> void export_ExternalFieldWallGPU(pybind11::module& m, const std::string& name)
+    {
+    pybind11::class_<ExternalFieldWallGPU<Shape>,
+                     ExternalFieldWall<Shape>,
+                     std::shared_ptr<ExternalFieldWallGPU<Shape>>>(m, name.c_str())
+        .def(pybind11::init<std::shared_ptr<SystemDefinition>,
+                            std::shared_ptr<IntegratorHPMCMono<Shape>>>());
+    }
+
+    } // end namespace hpmc
+
+#endif // ENABLE_HIP
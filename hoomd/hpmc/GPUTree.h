@@ -5,6 +5,7 @@
 
 #ifndef __HIPCC__
 #include "OBBTree.h"
+#include "WideOBB.h"
 #endif
 
 #include "HPMCPrecisionSetup.h"
@@ -108,6 +109,8 @@ class GPUTree
 
         // recursively initialize ancestor indices
         initializeAncestorCounts(0, tree, 0);
+
+        initializeWideNodes(managed);
         }
 #endif
 
@@ -133,6 +136,83 @@ class GPUTree
 
         m_ancestors[idx] = ancestors;
         }
+
+    //! Collapse two levels of the binary tree into wide nodes for the CPU traversal
+    /*! The wide children of an inner node are the children of its children, or the child itself
+        when that is a leaf. Their OBBs are stored in SoA layout for overlapWideNode().
+    */
+    void initializeWideNodes(bool managed)
+        {
+        m_wide_child = ManagedArray<unsigned int>(m_num_nodes * WIDE_OBB_WIDTH, managed);
+        m_wide_obb = ManagedArray<OverlapReal>(m_num_nodes * WIDE_OBB_WIDTH * WIDE_OBB_COMPONENTS,
+                                               managed);
+
+        for (unsigned int i = 0; i < m_num_nodes; ++i)
+            {
+            unsigned int n_lanes = 0;
+            unsigned int* lanes = m_wide_child.get() + i * WIDE_OBB_WIDTH;
+            if (!isLeaf(i))
+                {
+                unsigned int children[2] = {m_left[i], m_escape[m_left[i]]};
+                for (unsigned int child : children)
+                    {
+                    if (isLeaf(child))
+                        {
+                        lanes[n_lanes++] = child;
+                        }
+                    else
+                        {
+                        lanes[n_lanes++] = m_left[child];
+                        lanes[n_lanes++] = m_escape[m_left[child]];
+                        }
+                    }
+                }
+
+            OverlapReal* obbs = m_wide_obb.get() + i * WIDE_OBB_WIDTH * WIDE_OBB_COMPONENTS;
+            for (unsigned int l = 0; l < WIDE_OBB_WIDTH; ++l)
+                {
+                if (l >= n_lanes)
+                    lanes[l] = OBB_INVALID_NODE;
+                storeWideOBB(obbs, l, l < n_lanes ? getOBB(lanes[l]) : OBB());
+                }
+            }
+        }
+
+    //! Return the wide child of a node in a given lane, or OBB_INVALID_NODE
+    inline unsigned int getWideChild(unsigned int node, unsigned int lane) const
+        {
+        return m_wide_child[node * WIDE_OBB_WIDTH + lane];
+        }
+
+    //! Test an OBB against all wide children of an inner node
+    /*! \param obb Query bounding box
+        \param node Inner node
+        \returns A bit mask with bit l set when \a obb overlaps the wide child in lane l
+    */
+    inline unsigned int overlapWideNode(const OBB& obb, unsigned int node) const
+        {
+        unsigned int hits
+            = overlapWide(obb, m_wide_obb.get() + node * WIDE_OBB_WIDTH * WIDE_OBB_COMPONENTS);
+
+        for (unsigned int l = 0; l < WIDE_OBB_WIDTH; ++l)
+            {
+            unsigned int child = getWideChild(node, l);
+            if (child == OBB_INVALID_NODE)
+                {
+                hits &= ~(1u << l);
+                }
+            else if (obb.isSphere() || m_is_sphere[child] || !(obb.mask & m_mask[child]))
+                {
+                // the box test does not cover spheres and masks
+                if (overlap(obb, getOBB(child)))
+                    hits |= 1u << l;
+                else
+                    hits &= ~(1u << l);
+                }
+            }
+
+        return hits;
+        }
 #endif
 
     //! Fetch the next node in the tree and test against overlap
@@ -357,6 +437,9 @@ class GPUTree
     ManagedArray<unsigned int> m_escape;    //!< Escape indices
     ManagedArray<unsigned int> m_ancestors; //!< Number of right-most ancestors
 
+    ManagedArray<unsigned int> m_wide_child; //!< Children of the wide nodes (CPU only)
+    ManagedArray<OverlapReal> m_wide_obb;    //!< OBBs of the wide node children in SoA layout
+
     unsigned int m_num_nodes;     //!< Number of nodes in the tree
     unsigned int m_num_leaves;    //!< Number of leaf nodes
     unsigned int m_leaf_capacity; //!< Capacity of OBB leaf nodes
@@ -519,6 +602,105 @@ DEVICE inline bool traverseBinaryStack(const GPUTree& a,
     return leaf;
     }
 
+//! Traverse a binary hierarchy of OBBs that share a common orientation
+/*! Returns true if an intersecting pair of leaf OBB's has been found
+
+ * \param a First tree
+ * \param b Second tree
+ * \param cur_node_a Current node in first tree
+ * \param cur_node_b Current node in second tree
+ * \param a binary stack realized as an integer
+ * \param obb_a OBB from first tree corresponding to cur_node_a, in the common frame
+ * \param obb_b OBB from second tree corresponding to cur_node_b, in the common frame
+ * \param obbs_a Node OBBs of the first tree, rotated into the common frame
+ * \param obbs_b Node OBBs of the second tree, rotated into the common frame
+ * \param dr translation that is applied to the OBBs in obbs_a
+ *
+ * This function performs the same traversal as traverseBinaryStack, but loads the OBBs from
+ * arrays that have already been rotated so that only a translation is applied to each node.
+ */
+DEVICE inline bool traverseBinaryStackRotated(const GPUTree& a,
+                                              const GPUTree& b,
+                                              unsigned int& cur_node_a,
+                                              unsigned int& cur_node_b,
+                                              unsigned long int& stack,
+                                              OBB& obb_a,
+                                              OBB& obb_b,
+                                              const OBB* obbs_a,
+                                              const OBB* obbs_b,
+                                              const vec3<OverlapReal>& dr)
+    {
+    bool leaf = false;
+    bool ascend = true;
+
+    unsigned int old_a = cur_node_a;
+    unsigned int old_b = cur_node_b;
+
+    if (overlap(obb_a, obb_b))
+        {
+        if (a.isLeaf(cur_node_a) && b.isLeaf(cur_node_b))
+            {
+            leaf = true;
+            }
+        else
+            {
+            // descend into subtree with larger volume first (unless there are no children)
+            bool descend_A = obb_a.getVolume() > obb_b.getVolume() ? !a.isLeaf(cur_node_a)
+                                                                   : b.isLeaf(cur_node_b);
+
+            if (descend_A)
+                {
+                cur_node_a = a.getLeftChild(cur_node_a);
+                stack <<= 1; // push A
+                }
+            else
+                {
+                cur_node_b = b.getLeftChild(cur_node_b);
+                stack <<= 1;
+                stack |= 1; // push B
+                }
+            ascend = false;
+            }
+        }
+
+    if (ascend)
+        {
+        // ascend in tree
+        unsigned int a_count = a.getNumAncestors(cur_node_a);
+        unsigned int b_count = b.getNumAncestors(cur_node_b);
+
+        unsigned int a_ascent, b_ascent;
+        findAscent(a_count, b_count, stack, a_ascent, b_ascent);
+
+        if ((stack & 1) == 0) // top of stack == A
+            {
+            cur_node_a = a.getEscapeIndex(cur_node_a);
+
+            // ascend in B, using post-order indexing
+            cur_node_b -= b_ascent;
+            }
+        else
+            {
+            // ascend in A, using post-order indexing
+            cur_node_a -= a_ascent;
+            cur_node_b = b.getEscapeIndex(cur_node_b);
+            }
+        }
+    if (cur_node_a < a.getNumNodes() && cur_node_b < b.getNumNodes())
+        {
+        // pre-fetch OBBs
+        if (old_a != cur_node_a)
+            {
+            obb_a = obbs_a[cur_node_a];
+            obb_a.center += dr;
+            }
+        if (old_b != cur_node_b)
+            obb_b = obbs_b[cur_node_b];
+        }
+
+    return leaf;
+    }
+
 //! Traverse a binary hierachy, subject to intersection with a third OBB
 /*! Returns true if an intersecting pair of leaf OBB's has been found, where both
  * OBBs intersect with the third OBB
@@ -98,6 +98,46 @@ DEVICE inline hpmc_counters_t operator+(const hpmc_counters_t& a, const hpmc_cou
     return result;
     }
 
+//! Scale a move size toward a target acceptance ratio
+/*! \param x Current move size
+    \param accept Number of accepted moves since the last update
+    \param reject Number of rejected moves since the last update
+    \param target Target acceptance ratio
+    \param gain Added to both the acceptance ratio and the target, larger values damp the update
+    \param x_max Largest allowed move size
+    \returns The new move size
+
+    The move size is scaled by (acceptance + gain) / (target + gain), limited to a factor of 2 in
+    either direction, as in hoomd.tune.ScaleSolver. Move sizes that are zero or have no moves
+    since the last update do not change.
+*/
+DEVICE inline Scalar scaleMoveSize(Scalar x,
+                                   unsigned long long int accept,
+                                   unsigned long long int reject,
+                                   Scalar target,
+                                   Scalar gain,
+                                   Scalar x_max)
+    {
+    if (accept + reject == 0 || x == Scalar(0.0))
+        return x;
+
+    Scalar acceptance = Scalar(accept) / Scalar(accept + reject);
+    Scalar scale = (acceptance + gain) / (target + gain);
+    if (scale > Scalar(2.0))
+        scale = Scalar(2.0);
+    if (scale < Scalar(0.5))
+        scale = Scalar(0.5);
+
+    // keep the move size positive so that it can grow again
+    const Scalar x_min = Scalar(1e-7);
+    x *= scale;
+    if (x < x_min)
+        x = x_min;
+    if (x > x_max)
+        x = x_max;
+    return x;
+    }
+
 //! Storage for NPT acceptance counters
 /*! \ingroup hpmc_data_structs */
 struct hpmc_boxmc_counters_t
@@ -6,6 +6,7 @@
 namespace py = pybind11;
 
 #include "hoomd/VectorMath.h"
+#include <limits>
 #include <sstream>
 
 using namespace std;
@@ -30,19 +31,37 @@ IntegratorHPMC::IntegratorHPMC(std::shared_ptr<SystemDefinition> sysdef)
     GlobalArray<hpmc_counters_t> counters(1, this->m_exec_conf);
     m_count_total.swap(counters);
 
+    GlobalArray<hpmc_counters_t> count_step_start(1, this->m_exec_conf);
+    m_count_step_start.swap(count_step_start);
+
     GPUVector<Scalar> d(this->m_pdata->getNTypes(), this->m_exec_conf);
     m_d.swap(d);
 
     GPUVector<Scalar> a(this->m_pdata->getNTypes(), this->m_exec_conf);
     m_a.swap(a);
 
-    ArrayHandle<Scalar> h_d(m_d, access_location::host, access_mode::overwrite);
-    ArrayHandle<Scalar> h_a(m_a, access_location::host, access_mode::overwrite);
-    // set default values
-    for (unsigned int typ = 0; typ < this->m_pdata->getNTypes(); typ++)
+    GPUVector<Scalar> d_max(this->m_pdata->getNTypes(), this->m_exec_conf);
+    m_d_max.swap(d_max);
+
+    GPUVector<Scalar> a_max(this->m_pdata->getNTypes(), this->m_exec_conf);
+    m_a_max.swap(a_max);
+
+    GlobalArray<hpmc_counters_t> count_tune_start(1, this->m_exec_conf);
+    m_count_tune_start.swap(count_tune_start);
+
         {
-        h_d.data[typ] = 0.1;
-        h_a.data[typ] = 0.1;
+        ArrayHandle<Scalar> h_d(m_d, access_location::host, access_mode::overwrite);
+        ArrayHandle<Scalar> h_a(m_a, access_location::host, access_mode::overwrite);
+        ArrayHandle<Scalar> h_d_max(m_d_max, access_location::host, access_mode::overwrite);
+        ArrayHandle<Scalar> h_a_max(m_a_max, access_location::host, access_mode::overwrite);
+        // set default values
+        for (unsigned int typ = 0; typ < this->m_pdata->getNTypes(); typ++)
+            {
+            h_d.data[typ] = 0.1;
+            h_a.data[typ] = 0.1;
+            h_d_max.data[typ] = std::numeric_limits<Scalar>::infinity();
+            h_a_max.data[typ] = std::numeric_limits<Scalar>::infinity();
+            }
         }
 
     resetStats();
@@ -148,7 +167,80 @@ bool IntegratorHPMC::attemptBoxResize(uint64_t timestep, const BoxDim& new_box)
     this->communicate(false);
 
     // check overlaps
-    return !this->countOverlaps(true);
+    return this->countOverlapsUpTo(timestep, 0) == 0;
+    }
+
+/*! \param period Number of steps between updates of the move sizes, 0 disables the controller
+
+    The first update after enabling the controller uses only the moves made after this call.
+*/
+void IntegratorHPMC::setMoveSizePeriod(uint64_t period)
+    {
+    m_move_size_period = period;
+
+    ArrayHandle<hpmc_counters_t> h_counters(m_count_total,
+                                            access_location::host,
+                                            access_mode::read);
+    ArrayHandle<hpmc_counters_t> h_count_tune_start(m_count_tune_start,
+                                                    access_location::host,
+                                                    access_mode::overwrite);
+    h_count_tune_start.data[0] = h_counters.data[0];
+    }
+
+/*! All types share the acceptance ratio of their kind of move, reduced over all ranks so that
+    every rank sets the same move sizes.
+*/
+void IntegratorHPMC::updateMoveSizes()
+    {
+    ArrayHandle<hpmc_counters_t> h_counters(m_count_total,
+                                            access_location::host,
+                                            access_mode::read);
+    ArrayHandle<hpmc_counters_t> h_count_tune_start(m_count_tune_start,
+                                                    access_location::host,
+                                                    access_mode::readwrite);
+    hpmc_counters_t delta = h_counters.data[0] - h_count_tune_start.data[0];
+    h_count_tune_start.data[0] = h_counters.data[0];
+
+#ifdef ENABLE_MPI
+    if (m_comm)
+        {
+        unsigned long long int counts[4] = {delta.translate_accept_count,
+                                            delta.translate_reject_count,
+                                            delta.rotate_accept_count,
+                                            delta.rotate_reject_count};
+        MPI_Allreduce(MPI_IN_PLACE,
+                      counts,
+                      4,
+                      MPI_UNSIGNED_LONG_LONG,
+                      MPI_SUM,
+                      m_exec_conf->getMPICommunicator());
+        delta.translate_accept_count = counts[0];
+        delta.translate_reject_count = counts[1];
+        delta.rotate_accept_count = counts[2];
+        delta.rotate_reject_count = counts[3];
+        }
+#endif
+
+    ArrayHandle<Scalar> h_d(m_d, access_location::host, access_mode::readwrite);
+    ArrayHandle<Scalar> h_a(m_a, access_location::host, access_mode::readwrite);
+    ArrayHandle<Scalar> h_d_max(m_d_max, access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_a_max(m_a_max, access_location::host, access_mode::read);
+
+    for (unsigned int typ = 0; typ < m_pdata->getNTypes(); typ++)
+        {
+        h_d.data[typ] = scaleMoveSize(h_d.data[typ],
+                                      delta.translate_accept_count,
+                                      delta.translate_reject_count,
+                                      m_move_size_target,
+                                      m_move_size_gain,
+                                      h_d_max.data[typ]);
+        h_a.data[typ] = scaleMoveSize(h_a.data[typ],
+                                      delta.rotate_accept_count,
+                                      delta.rotate_reject_count,
+                                      m_move_size_target,
+                                      m_move_size_gain,
+                                      h_a_max.data[typ]);
+        }
     }
 
 /*! \param mode 0 -> Absolute count, 1 -> relative to the start of the run, 2 -> relative to the
@@ -171,7 +263,12 @@ hpmc_counters_t IntegratorHPMC::getCounters(unsigned int mode)
     else if (mode == 1)
         result = h_counters.data[0] - m_count_run_start;
     else
-        result = h_counters.data[0] - m_count_step_start;
+        {
+        ArrayHandle<hpmc_counters_t> h_count_step_start(m_count_step_start,
+                                                        access_location::host,
+                                                        access_mode::read);
+        result = h_counters.data[0] - h_count_step_start.data[0];
+        }
 
 #ifdef ENABLE_MPI
     if (m_comm)
@@ -232,6 +329,7 @@ void export_IntegratorHPMC(py::module& m)
         .def("getNSelect", &IntegratorHPMC::getNSelect)
         .def("getMaxCoreDiameter", &IntegratorHPMC::getMaxCoreDiameter)
         .def("countOverlaps", &IntegratorHPMC::countOverlaps)
+        .def("countOverlapsUpTo", &IntegratorHPMC::countOverlapsUpTo)
         .def("checkParticleOrientations", &IntegratorHPMC::checkParticleOrientations)
         .def("getMPS", &IntegratorHPMC::getMPS)
         .def("getCounters", &IntegratorHPMC::getCounters)
@@ -243,7 +341,23 @@ void export_IntegratorHPMC(py::module& m)
         .def_property("nselect", &IntegratorHPMC::getNSelect, &IntegratorHPMC::setNSelect)
         .def_property("translation_move_probability",
                       &IntegratorHPMC::getTranslationMoveProbability,
-                      &IntegratorHPMC::setTranslationMoveProbability);
+                      &IntegratorHPMC::setTranslationMoveProbability)
+        .def_property("checkerboard",
+                      &IntegratorHPMC::getCheckerboard,
+                      &IntegratorHPMC::setCheckerboard)
+        .def("setMaxTranslationMove", &IntegratorHPMC::setMaxTranslationMove)
+        .def("getMaxTranslationMove", &IntegratorHPMC::getMaxTranslationMove)
+        .def("setMaxRotationMove", &IntegratorHPMC::setMaxRotationMove)
+        .def("getMaxRotationMove", &IntegratorHPMC::getMaxRotationMove)
+        .def_property("move_size_period",
+                      &IntegratorHPMC::getMoveSizePeriod,
+                      &IntegratorHPMC::setMoveSizePeriod)
+        .def_property("move_size_target",
+                      &IntegratorHPMC::getMoveSizeTarget,
+                      &IntegratorHPMC::setMoveSizeTarget)
+        .def_property("move_size_gain",
+                      &IntegratorHPMC::getMoveSizeGain,
+                      &IntegratorHPMC::setMoveSizeGain);
 
     py::class_<hpmc_counters_t>(m, "hpmc_counters_t")
         .def_readonly("overlap_checks", &hpmc_counters_t::overlap_checks)
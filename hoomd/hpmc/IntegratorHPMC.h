@@ -16,9 +16,12 @@
 #include "hoomd/CellList.h"
 #include "hoomd/Integrator.h"
 
+#include "ExcellIndexer.h"
 #include "ExternalField.h"
 #include "HPMCCounters.h"
 
+#include <vector>
+
 #ifndef __HIPCC__
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
@@ -54,7 +57,7 @@ struct hpmc_patch_args_t
                       const BoxDim& _box,
                       const unsigned int* _d_excell_idx,
                       const unsigned int* _d_excell_size,
-                      const Index2D& _excli,
+                      const gpu::ExcellIndexer& _excli,
                       const Scalar _r_cut_patch,
                       const Scalar* _d_additive_cutoff,
                       const unsigned int* _d_update_order_by_ptl,
@@ -92,7 +95,7 @@ struct hpmc_patch_args_t
     const BoxDim& box;                         //!< Current simulation box
     const unsigned int* d_excell_idx;          //!< Expanded cell list
     const unsigned int* d_excell_size;         //!< Size of expanded cells
-    const Index2D& excli;                      //!< Excell indexer
+    const gpu::ExcellIndexer& excli;           //!< Excell indexer
     const Scalar r_cut_patch;                  //!< Global cutoff radius
     const Scalar* d_additive_cutoff;           //!< Additive contribution to cutoff per type
     const unsigned int* d_update_order_by_ptl; //!< Order of the update sequence
@@ -168,6 +171,46 @@ class PatchEnergy
         return 0;
         }
 
+    //! evaluate the energies of particle i with a batch of particles j
+    /*! \param n Number of particles j
+        \param r_ij Vectors pointing from particle i to each j
+        \param type_i Integer type index of particle i
+        \param q_i Orientation quaternion of particle i
+        \param d_i Diameter of particle i
+        \param charge_i Charge of particle i
+        \param type_j Integer type indices of the particles j
+        \param q_j Orientation quaternions of the particles j
+        \param d_j Diameters of the particles j
+        \param charge_j Charges of the particles j
+        \param energies Output: energy of each pair
+
+        The default implementation calls energy() once per pair. Evaluators that can process the
+        whole batch in one call override this method.
+    */
+    virtual void energyBatch(unsigned int n,
+                             const vec3<float>* r_ij,
+                             unsigned int type_i,
+                             const quat<float>& q_i,
+                             float d_i,
+                             float charge_i,
+                             const unsigned int* type_j,
+                             const quat<float>* q_j,
+                             const float* d_j,
+                             const float* charge_j,
+                             float* energies)
+        {
+        for (unsigned int k = 0; k < n; k++)
+            energies[k] = energy(r_ij[k],
+                                 type_i,
+                                 q_i,
+                                 d_i,
+                                 charge_i,
+                                 type_j[k],
+                                 q_j[k],
+                                 d_j[k],
+                                 charge_j[k]);
+        }
+
 #ifdef ENABLE_HIP
     //! Set autotuner parameters
     /*! \param enable Enable/disable autotuning
@@ -189,6 +232,74 @@ class PatchEnergy
 #endif
     };
 
+namespace detail
+    {
+//! Collects the neighbors of one particle for a single PatchEnergy::energyBatch() call
+/*! The HPMC CPU loops push each neighbor j within the patch cutoff and evaluate the batch once per
+    particle i, which avoids one virtual call per pair. The arrays are kept between uses so that
+    a buffer reused for many particles allocates only when it grows.
+*/
+struct PatchEnergyBatch
+    {
+    std::vector<vec3<float>> r_ij;    //!< Vectors from particle i to j
+    std::vector<unsigned int> type_j; //!< Types of the particles j
+    std::vector<quat<float>> q_j;     //!< Orientations of the particles j
+    std::vector<float> d_j;           //!< Diameters of the particles j
+    std::vector<float> charge_j;      //!< Charges of the particles j
+    std::vector<float> energies;      //!< Energies of the pairs
+
+    //! Remove all particles j
+    void clear()
+        {
+        r_ij.clear();
+        type_j.clear();
+        q_j.clear();
+        d_j.clear();
+        charge_j.clear();
+        }
+
+    //! Add a particle j
+    void push(const vec3<float>& r, unsigned int type, const quat<float>& q, float d, float charge)
+        {
+        r_ij.push_back(r);
+        type_j.push_back(type);
+        q_j.push_back(q);
+        d_j.push_back(d);
+        charge_j.push_back(charge);
+        }
+
+    //! Sum the energies of particle i with all particles j in double precision and clear the batch
+    double evaluate(PatchEnergy& patch,
+                    unsigned int type_i,
+                    const quat<float>& q_i,
+                    float d_i,
+                    float charge_i)
+        {
+        const unsigned int n = (unsigned int)r_ij.size();
+        double sum = 0.0;
+        if (n > 0)
+            {
+            energies.resize(n);
+            patch.energyBatch(n,
+                              r_ij.data(),
+                              type_i,
+                              q_i,
+                              d_i,
+                              charge_i,
+                              type_j.data(),
+                              q_j.data(),
+                              d_j.data(),
+                              charge_j.data(),
+                              energies.data());
+            for (unsigned int k = 0; k < n; k++)
+                sum += energies[k];
+            }
+        clear();
+        return sum;
+        }
+    };
+    } // end namespace detail
+
 class PYBIND11_EXPORT IntegratorHPMC : public Integrator
     {
     public:
@@ -200,10 +311,10 @@ class PYBIND11_EXPORT IntegratorHPMC : public Integrator
     //! Take one timestep forward
     virtual void update(uint64_t timestep)
         {
-        ArrayHandle<hpmc_counters_t> h_counters(m_count_total,
-                                                access_location::host,
-                                                access_mode::read);
-        m_count_step_start = h_counters.data[0];
+        if (m_move_size_period != 0 && timestep % m_move_size_period == 0)
+            updateMoveSizes();
+
+        saveStepStartCounters();
         }
 
     //! Change maximum displacement
@@ -324,10 +435,98 @@ class PYBIND11_EXPORT IntegratorHPMC : public Integrator
         return m_nselect;
         }
 
+    /// Set whether to perform the CPU trial moves in a checkerboard of cells
+    void setCheckerboard(bool checkerboard)
+        {
+        m_checkerboard = checkerboard;
+        }
+
+    /// Get whether to perform the CPU trial moves in a checkerboard of cells
+    bool getCheckerboard()
+        {
+        return m_checkerboard;
+        }
+
+    /// Set the number of steps between updates of the move sizes, 0 disables the controller
+    void setMoveSizePeriod(uint64_t period);
+
+    /// Get the number of steps between updates of the move sizes
+    uint64_t getMoveSizePeriod()
+        {
+        return m_move_size_period;
+        }
+
+    /// Set the acceptance ratio that the move size controller aims for
+    void setMoveSizeTarget(Scalar target)
+        {
+        if (target <= 0 || target >= 1)
+            throw std::domain_error("move_size_target must be between 0 and 1");
+        m_move_size_target = target;
+        }
+
+    /// Get the acceptance ratio that the move size controller aims for
+    Scalar getMoveSizeTarget()
+        {
+        return m_move_size_target;
+        }
+
+    /// Set the damping of the move size controller
+    void setMoveSizeGain(Scalar gain)
+        {
+        if (gain < 0)
+            throw std::domain_error("move_size_gain must not be negative");
+        m_move_size_gain = gain;
+        }
+
+    /// Get the damping of the move size controller
+    Scalar getMoveSizeGain()
+        {
+        return m_move_size_gain;
+        }
+
+    /// Set the largest translation move size the controller sets for a type
+    void setMaxTranslationMove(std::string name, Scalar d_max)
+        {
+        unsigned int id = this->m_pdata->getTypeByName(name);
+        ArrayHandle<Scalar> h_d_max(m_d_max, access_location::host, access_mode::readwrite);
+        h_d_max.data[id] = d_max;
+        }
+
+    /// Get the largest translation move size the controller sets for a type
+    Scalar getMaxTranslationMove(std::string name)
+        {
+        unsigned int id = this->m_pdata->getTypeByName(name);
+        ArrayHandle<Scalar> h_d_max(m_d_max, access_location::host, access_mode::read);
+        return h_d_max.data[id];
+        }
+
+    /// Set the largest rotation move size the controller sets for a type
+    void setMaxRotationMove(std::string name, Scalar a_max)
+        {
+        unsigned int id = this->m_pdata->getTypeByName(name);
+        ArrayHandle<Scalar> h_a_max(m_a_max, access_location::host, access_mode::readwrite);
+        h_a_max.data[id] = a_max;
+        }
+
+    /// Get the largest rotation move size the controller sets for a type
+    Scalar getMaxRotationMove(std::string name)
+        {
+        unsigned int id = this->m_pdata->getTypeByName(name);
+        ArrayHandle<Scalar> h_a_max(m_a_max, access_location::host, access_mode::read);
+        return h_a_max.data[id];
+        }
+
     //! Get performance in moves per second
+    /*! The counters are only read when the value is requested, so that GPU integrators do not
+        synchronize with the device every step.
+    */
     virtual double getMPS()
         {
-        return m_mps;
+        if (m_mps_time == 0)
+            return 0;
+
+        hpmc_counters_t run_counters = getCounters(1);
+        return double(run_counters.getNMoves()) / (double(m_mps_time) / 1e9);
         }
 
     //! Reset statistics counters
@@ -338,6 +537,7 @@ class PYBIND11_EXPORT IntegratorHPMC : public Integrator
                                                 access_mode::read);
         m_count_run_start = h_counters.data[0];
         m_clock = ClockSource();
+        m_mps_time = 0;
         }
 
     //! Get the diameter of the largest circumscribing sphere for objects handled by this integrator
@@ -356,6 +556,19 @@ class PYBIND11_EXPORT IntegratorHPMC : public Integrator
         return 0;
         }
 
+    //! Count the number of particle overlaps, stopping once there are more than a given number
+    /*! \param timestep current step
+        \param max_overlaps Stop counting when there are more overlaps than this
+        \returns number of overlaps if it does not exceed max_overlaps, otherwise a value larger
+                 than max_overlaps
+
+        The base class counts all overlaps with countOverlaps().
+    */
+    virtual unsigned int countOverlapsUpTo(uint64_t timestep, unsigned int max_overlaps)
+        {
+        return countOverlaps(max_overlaps == 0);
+        }
+
     //! Get the number of degrees of freedom granted to a given group
     /*! \param group Group over which to count degrees of freedom.
         \return a non-zero dummy value to suppress warnings.
@@ -475,17 +688,29 @@ class PYBIND11_EXPORT IntegratorHPMC : public Integrator
     unsigned int m_translation_move_probability; //!< Fraction of moves that are translation moves.
     unsigned int m_nselect;                      //!< Number of particles to select for trial moves
 
+    /// When true, sweep the trial moves over a checkerboard of cells in parallel
+    bool m_checkerboard = false;
+
     GPUVector<Scalar> m_d; //!< Maximum move displacement by type
     GPUVector<Scalar> m_a; //!< Maximum angular displacement by type
 
-    GlobalArray<hpmc_counters_t> m_count_total; //!< Accept/reject total count
+    GlobalArray<hpmc_counters_t> m_count_total;      //!< Accept/reject total count
+    GlobalArray<hpmc_counters_t> m_count_step_start; //!< Count saved at the start of the last step
+
+    /// Steps between updates of the move sizes by the controller, 0 disables the controller
+    uint64_t m_move_size_period = 0;
+    Scalar m_move_size_target = 0.2; //!< Acceptance ratio that the move size controller aims for
+    Scalar m_move_size_gain = 1.0;   //!< Damping of the move size controller
+    GPUVector<Scalar> m_d_max;       //!< Largest translation move size set by the controller
+    GPUVector<Scalar> m_a_max;       //!< Largest rotation move size set by the controller
+    GlobalArray<hpmc_counters_t> m_count_tune_start; //!< Count saved at the last move size update
 
     Scalar m_nominal_width;     //!< nominal cell width
     Scalar m_extra_ghost_width; //!< extra ghost width to add
     ClockSource m_clock;        //!< Timer for self-benchmarking
 
-    /// Moves-per-second value last recorded
-    double m_mps = 0;
+    /// Time (in ns since resetStats()) at the end of the last executed step
+    int64_t m_mps_time = 0;
 
     ExternalField* m_external_base; //! This is a cast of the derived class's m_external that can be
                                     //! used in a more general setting.
@@ -500,6 +725,28 @@ class PYBIND11_EXPORT IntegratorHPMC : public Integrator
     */
     virtual void updateCellWidth() { }
 
+    //! Save the counters at the start of a step
+    /*! Derived classes that accumulate the counters on the device override this method to copy
+        them without synchronizing with the host.
+    */
+    virtual void saveStepStartCounters()
+        {
+        ArrayHandle<hpmc_counters_t> h_counters(m_count_total,
+                                                access_location::host,
+                                                access_mode::read);
+        ArrayHandle<hpmc_counters_t> h_count_step_start(m_count_step_start,
+                                                        access_location::host,
+                                                        access_mode::overwrite);
+        h_count_step_start.data[0] = h_counters.data[0];
+        }
+
+    //! Scale the move sizes toward the target acceptance ratio
+    /*! Uses the acceptance ratio of the moves since the last update. Derived classes that
+        accumulate the counters on the device override this method to update the move sizes
+        without synchronizing with the host.
+    */
+    virtual void updateMoveSizes();
+
     //! Return the requested ghost layer width
     virtual Scalar getGhostLayerWidth(unsigned int type)
         {
@@ -516,8 +763,7 @@ class PYBIND11_EXPORT IntegratorHPMC : public Integrator
 #endif
 
     private:
-    hpmc_counters_t m_count_run_start;  //!< Count saved at run() start
-    hpmc_counters_t m_count_step_start; //!< Count saved at the start of the last step
+    hpmc_counters_t m_count_run_start; //!< Count saved at run() start
 
 #ifdef ENABLE_MPI
     bool m_communicator_ghost_width_connected; //!< True if we have connected to Communicator's
@@ -9,6 +9,7 @@
     \brief Declaration of IntegratorHPMC
 */
 
+#include <algorithm>
 #include <iostream>
 #include <iomanip>
 #include <sstream>
@@ -140,8 +141,11 @@ class IntegratorHPMCMono : public IntegratorHPMC
             {
             if (m_aabbs != NULL)
                 free(m_aabbs);
+            if (m_depletant_aabbs != NULL)
+                free(m_depletant_aabbs);
             m_pdata->getBoxChangeSignal().template disconnect<IntegratorHPMCMono<Shape>, &IntegratorHPMCMono<Shape>::slotBoxChanged>(this);
             m_pdata->getParticleSortSignal().template disconnect<IntegratorHPMCMono<Shape>, &IntegratorHPMCMono<Shape>::slotSorted>(this);
+            m_pdata->getParticlesMovedSignal().template disconnect<IntegratorHPMCMono<Shape>, &IntegratorHPMCMono<Shape>::slotSorted>(this);
             }
 
         virtual void resetStats();
@@ -436,11 +440,49 @@ class IntegratorHPMCMono : public IntegratorHPMC
 
         void invalidateAABBTree(){ m_aabb_tree_invalid = true; }
 
+        //! Set the relative growth in the AABB tree cost that triggers a rebuild
+        /*! \param threshold Rebuild the tree when refitting increases its cost by more than this
+                fraction of the cost after the last build. Set to 0 to always rebuild.
+        */
+        void setAABBRefitThreshold(Scalar threshold)
+            {
+            if (threshold < 0)
+                throw std::domain_error("aabb_refit_threshold must not be negative");
+            m_aabb_refit_threshold = threshold;
+            }
+
+        //! Get the relative growth in the AABB tree cost that triggers a rebuild
+        Scalar getAABBRefitThreshold()
+            {
+            return m_aabb_refit_threshold;
+            }
+
+        //! Set whether to insert the depletants once per step and test trial moves against them
+        void setDepletantCache(bool cache)
+            {
+            m_depletant_cache = cache;
+            }
+
+        //! Get whether to insert the depletants once per step
+        bool getDepletantCache()
+            {
+            return m_depletant_cache;
+            }
+
+        //! State of the integrator in frame 0 of a GSD file, kept by each connected slot
+        struct GSDFrameZero
+            {
+            bool valid = false;             //!< True when the slot wrote frame 0 of the file
+            uint64_t param_version = 0;     //!< Version of the shape parameters in frame 0
+            std::vector<Scalar> d;          //!< Translational move sizes in frame 0
+            std::vector<Scalar> a;          //!< Rotational move sizes in frame 0
+            };
+
         //! Method that is called whenever the GSD file is written if connected to a GSD file.
-        int slotWriteGSDState(gsd_handle&, std::string name) const;
+        int slotWriteGSDState(gsd_handle&, std::string name, std::shared_ptr<GSDFrameZero> frame_zero) const;
 
         //! Method that is called whenever the GSD file is written if connected to a GSD file.
-        int slotWriteGSDShapeSpec(gsd_handle&) const;
+        int slotWriteGSDShapeSpec(gsd_handle&, std::shared_ptr<GSDFrameZero> frame_zero) const;
 
         //! Method that is called to connect to the gsd write state signal
         void connectGSDStateSignal(std::shared_ptr<GSDDumpWriter> writer, std::string name);
@@ -474,6 +516,9 @@ class IntegratorHPMCMono : public IntegratorHPMC
 
     protected:
         std::vector<param_type, managed_allocator<param_type> > m_params;   //!< Parameters for each particle type on GPU
+        uint64_t m_param_version;                   //!< Incremented every time m_params is set
+        unsigned int m_params_modified_begin;       //!< First type with parameters modified since the last device update
+        unsigned int m_params_modified_end;         //!< One past the last type with parameters modified since the last device update
         GlobalArray<unsigned int> m_overlaps;          //!< Interaction matrix (0/1) for overlap checks
         detail::UpdateOrder m_update_order;         //!< Update order
         bool m_image_list_is_initialized;                    //!< true if image list has been used
@@ -490,10 +535,26 @@ class IntegratorHPMCMono : public IntegratorHPMC
         detail::AABB* m_aabbs;                      //!< list of AABBs, one per particle
         unsigned int m_aabbs_capacity;              //!< Capacity of m_aabbs list
         bool m_aabb_tree_invalid;                   //!< Flag if the aabb tree has been invalidated
+        ShapeCache<Shape> m_shape_cache;            //!< Orientation dependent shape data of the local and ghost particles
+        Scalar m_aabb_refit_threshold;              //!< Relative growth in the tree cost that triggers a rebuild
+        Scalar m_aabb_tree_build_cost;              //!< Cost of the AABB tree after the last build
+        std::vector<unsigned int> m_aabb_tree_tags; //!< Tags of the particles in the AABB tree at the last build
+        std::vector<unsigned int> m_aabb_type_masks; //!< Type mask bit of each particle in the AABB tree
 
         Scalar m_extra_image_width;                 //! Extra width to extend the image list
 
+        /* Checkerboard sweep data members */
+
+        Index3D m_checkerboard_indexer;             //!< Indexer for the checkerboard cells
+        Scalar3 m_checkerboard_shift;               //!< Fractional shift of the checkerboard in the current sweep
+        std::vector<unsigned int> m_checkerboard_cell;          //!< Checkerboard cell of each local particle
+        std::vector<unsigned char> m_checkerboard_color;        //!< Color of the cell of each local particle
+        std::vector<unsigned int> m_checkerboard_cell_start;    //!< Offset of the first member of each cell
+        std::vector<unsigned int> m_checkerboard_cell_members;  //!< Local particles sorted by cell, in update order
+        std::vector<unsigned int> m_checkerboard_color_order;   //!< Order in which the colors are swept
+
         Index2D m_overlap_idx;                      //!!< Indexer for interaction matrix
+        std::vector<unsigned int> m_overlap_type_mask; //!< Type mask bits of the types each type overlaps with
 
         /* Depletants related data members */
 
@@ -505,6 +566,21 @@ class IntegratorHPMCMono : public IntegratorHPMC
         std::vector<hpmc_implicit_counters_t> m_implicit_count_run_start;     //!< Counter of depletant insertions at run start
         std::vector<hpmc_implicit_counters_t> m_implicit_count_step_start;    //!< Counter of depletant insertions at step start
 
+        bool m_depletant_cache;                             //!< True to insert the depletants once per step
+        std::vector< vec3<Scalar> > m_depletant_pos;         //!< Positions of the cached depletants
+        std::vector< quat<Scalar> > m_depletant_orientation; //!< Orientations of the cached depletants
+        std::vector<unsigned int> m_depletant_type;         //!< Types of the cached depletants
+        detail::AABB* m_depletant_aabbs;                    //!< AABBs of the cached depletants
+        unsigned int m_depletant_aabbs_capacity;            //!< Capacity of m_depletant_aabbs
+        detail::AABBTree m_depletant_tree;                  //!< Bounding volume hierarchy of the cached depletants
+
+        //! Insert the cached depletant configuration of this step
+        void insertCachedDepletants(uint64_t timestep, hpmc_implicit_counters_t *implicit_counters);
+
+        //! Test whether a trial configuration overlaps one of the cached depletants
+        inline bool checkCachedDepletantOverlap(const vec3<Scalar>& pos_i, const Shape& shape_i,
+            unsigned int typ_i, const unsigned int *h_overlaps);
+
         //! Test whether to reject the current particle move based on depletants
         inline bool checkDepletantOverlap(unsigned int i, vec3<Scalar> pos_i, Shape shape_i, unsigned int typ_i,
             Scalar4 *h_postype, Scalar4 *h_orientation, const unsigned int *h_tag, const Scalar4 *h_vel,
@@ -518,9 +594,42 @@ class IntegratorHPMCMono : public IntegratorHPMC
         //! Grow the m_aabbs list
         virtual void growAABBList(unsigned int N);
 
+        //! Refit or rebuild the AABB tree from the first N entries of m_aabbs
+        void fitAABBTree(unsigned int N, const unsigned int *h_tag);
+
+        //! Update the type masks of the types that overlap with each type
+        void updateOverlapTypeMask(const unsigned int *h_overlaps);
+
         //! Limit the maximum move distances
         virtual void limitMoveDistances();
 
+        //! Recompute the shape cache entries of all local and ghost particles
+        void updateShapeCache();
+
+        //! Bin the local particles into the checkerboard cells for one sweep
+        bool binCheckerboard(uint64_t timestep, unsigned int select, const Scalar4 *h_postype,
+            const Scalar4 *h_orientation, const unsigned int *h_tag, const Scalar *h_d);
+
+        //! Find the checkerboard cell that contains a position
+        /*! \param pos Position in the local box
+            \param box Local box
+            \returns The index of the cell in the current sweep
+        */
+        unsigned int getCheckerboardCell(const vec3<Scalar>& pos, const BoxDim& box) const
+            {
+            Scalar3 f = box.makeFraction(vec_to_scalar3(pos)) + m_checkerboard_shift;
+            f.x -= slow::floor(f.x);
+            f.y -= slow::floor(f.y);
+            f.z -= slow::floor(f.z);
+
+            unsigned int w = m_checkerboard_indexer.getW();
+            unsigned int h = m_checkerboard_indexer.getH();
+            unsigned int d = m_checkerboard_indexer.getD();
+            return m_checkerboard_indexer(std::min((unsigned int)(f.x * w), w - 1),
+                                          std::min((unsigned int)(f.y * h), h - 1),
+                                          std::min((unsigned int)(f.z * d), d - 1));
+            }
+
         //! callback so that the box change signal can invalidate the image list
         virtual void slotBoxChanged()
             {
@@ -541,6 +650,7 @@ class IntegratorHPMCMono : public IntegratorHPMC
 template <class Shape>
 IntegratorHPMCMono<Shape>::IntegratorHPMCMono(std::shared_ptr<SystemDefinition> sysdef)
             : IntegratorHPMC(sysdef),
+              m_param_version(0),
               m_update_order(m_pdata->getN()),
               m_image_list_is_initialized(false),
               m_image_list_valid(false),
@@ -553,6 +663,8 @@ IntegratorHPMCMono<Shape>::IntegratorHPMCMono(std::shared_ptr<SystemDefinition>
     m_params = std::vector<param_type, managed_allocator<param_type> >(m_pdata->getNTypes(),
                                                                        param_type(),
                                                                        managed_allocator<param_type>(m_exec_conf->isCUDAEnabled()));
+    m_params_modified_begin = 0;
+    m_params_modified_end = m_pdata->getNTypes();
 
     m_overlap_idx = Index2D(m_pdata->getNTypes());
     GlobalArray<unsigned int> overlaps(m_overlap_idx.getNumElements(), m_exec_conf);
@@ -563,10 +675,12 @@ IntegratorHPMCMono<Shape>::IntegratorHPMCMono(std::shared_ptr<SystemDefinition>
         {
         h_overlaps.data[i] = 1; // Assume we want to check overlaps.
         }
+    updateOverlapTypeMask(h_overlaps.data);
 
     // Connect to the BoxChange signal
     m_pdata->getBoxChangeSignal().template connect<IntegratorHPMCMono<Shape>, &IntegratorHPMCMono<Shape>::slotBoxChanged>(this);
     m_pdata->getParticleSortSignal().template connect<IntegratorHPMCMono<Shape>, &IntegratorHPMCMono<Shape>::slotSorted>(this);
+    m_pdata->getParticlesMovedSignal().template connect<IntegratorHPMCMono<Shape>, &IntegratorHPMCMono<Shape>::slotSorted>(this);
 
     m_image_list_rebuilds = 0;
     m_image_list_warning_issued = false;
@@ -575,6 +689,14 @@ IntegratorHPMCMono<Shape>::IntegratorHPMCMono(std::shared_ptr<SystemDefinition>
     m_aabbs = NULL;
     m_aabbs_capacity = 0;
     m_aabb_tree_invalid = true;
+    m_aabb_refit_threshold = 0;
+    m_aabb_tree_build_cost = 0;
+
+    m_checkerboard_shift = make_scalar3(0, 0, 0);
+
+    m_depletant_cache = false;
+    m_depletant_aabbs = NULL;
+    m_depletant_aabbs_capacity = 0;
 
     m_depletant_idx = Index2D(this->m_pdata->getNTypes());
     m_fugacity.resize(m_depletant_idx.getNumElements(), 0.0);
@@ -675,6 +797,8 @@ void IntegratorHPMCMono<Shape>::update(uint64_t timestep)
     limitMoveDistances();
     // update the image list
     updateImageList();
+    // update the orientation dependent shape data
+    updateShapeCache();
 
     bool has_depletants = false;
     for (unsigned int i = 0; i < m_depletant_idx.getNumElements(); ++i)
@@ -686,6 +810,11 @@ void IntegratorHPMCMono<Shape>::update(uint64_t timestep)
             }
         }
 
+    // sample the depletants once for all trial moves of this step
+    bool cache_depletants = has_depletants && m_depletant_cache;
+    if (cache_depletants)
+        insertCachedDepletants(timestep, h_implicit_counters.data);
+
     // Combine the three seeds to generate RNG for poisson distribution
     hoomd::RandomGenerator rng_depletants(hoomd::Seed(hoomd::RNGIdentifier::HPMCDepletants,
                                                       timestep,
@@ -704,6 +833,19 @@ void IntegratorHPMCMono<Shape>::update(uint64_t timestep)
     // access interaction matrix
     ArrayHandle<unsigned int> h_overlaps(m_overlaps, access_location::host, access_mode::read);
 
+    // depletants and external fields are evaluated in the serial sweep only, the cached depletants
+    // are fixed obstacles during the sweep and do not couple the trial moves
+    bool checkerboard = m_checkerboard && (!has_depletants || cache_depletants) && !m_external;
+    const unsigned int checkerboard_off = 0xffffffff;
+    unsigned int active_color = 0;
+
+    // neighbors within the patch cutoff, evaluated in one batch per trial move
+    #ifdef ENABLE_TBB
+    tbb::enumerable_thread_specific<detail::PatchEnergyBatch> patch_batches;
+    #else
+    detail::PatchEnergyBatch patch_batch;
+    #endif
+
     // loop over local particles nselect times
     for (unsigned int i_nselect = 0; i_nselect < m_nselect; i_nselect++)
         {
@@ -719,10 +861,9 @@ void IntegratorHPMCMono<Shape>::update(uint64_t timestep)
         ArrayHandle<Scalar> h_d(m_d, access_location::host, access_mode::read);
         ArrayHandle<Scalar> h_a(m_a, access_location::host, access_mode::read);
 
-        // loop through N particles in a shuffled order
-        for (unsigned int cur_particle = 0; cur_particle < m_pdata->getN(); cur_particle++)
-            {
-            unsigned int i = m_update_order[cur_particle];
+        // attempt a trial move of particle i, cell_i is its checkerboard cell or checkerboard_off
+        auto trial_move = [&](unsigned int i, hpmc_counters_t& move_counters, unsigned int cell_i)
+        {
 
             // read in the current position and orientation
             Scalar4 postype_i = h_postype.data[i];
@@ -734,7 +875,7 @@ void IntegratorHPMCMono<Shape>::update(uint64_t timestep)
                 {
                 // only move particle if active
                 if (!isActive(make_scalar3(postype_i.x, postype_i.y, postype_i.z), box, ghost_fraction))
-                    continue;
+                    return;
                 }
             #endif
 
@@ -755,8 +896,8 @@ void IntegratorHPMCMono<Shape>::update(uint64_t timestep)
                 if (h_d.data[typ_i] == 0.0)
                     {
                     if (!shape_i.ignoreStatistics())
-                        counters.translate_accept_count++;
-                    continue;
+                        move_counters.translate_accept_count++;
+                    return;
                     }
 
                 move_translate(pos_i, rng_i, h_d.data[typ_i], ndim);
@@ -766,25 +907,36 @@ void IntegratorHPMCMono<Shape>::update(uint64_t timestep)
                     {
                     // check if particle has moved into the ghost layer, and skip if it is
                     if (!isActive(vec_to_scalar3(pos_i), box, ghost_fraction))
-                        continue;
+                        return;
                     }
                 #endif
+
+                // in a checkerboard sweep, moves may not leave the cell
+                if (cell_i != checkerboard_off && getCheckerboardCell(pos_i, box) != cell_i)
+                    {
+                    if (!shape_i.ignoreStatistics())
+                        move_counters.translate_reject_count++;
+                    return;
+                    }
                 }
             else
                 {
                 if (h_a.data[typ_i] == 0.0)
                     {
                     if (!shape_i.ignoreStatistics())
-                        counters.rotate_accept_count++;
-                    continue;
+                        move_counters.rotate_accept_count++;
+                    return;
                     }
 
                 if (ndim == 2)
                     move_rotate<2>(shape_i.orientation, rng_i, h_a.data[typ_i]);
                 else
                     move_rotate<3>(shape_i.orientation, rng_i, h_a.data[typ_i]);
-                }
 
+                // the cache entry of i follows its trial orientation until the move is rejected
+                m_shape_cache.set(i, shape_i);
+                }
+            m_shape_cache.attach(i, shape_i);
 
             bool overlap=false;
             OverlapReal r_cut_patch = 0;
@@ -799,9 +951,18 @@ void IntegratorHPMCMono<Shape>::update(uint64_t timestep)
                 r_cut_patch-getMinCoreDiameter()/(OverlapReal)2.0);
             detail::AABB aabb_i_local = detail::AABB(vec3<Scalar>(0,0,0),R_query);
 
+            // skip subtrees without particles that overlap with i, unless they contribute patch energy
+            unsigned int query_type_mask = (m_patch && !m_patch_log) ? 0xffffffff : m_overlap_type_mask[typ_i];
+
             // patch + field interaction deltaU
             double patch_field_energy_diff = 0;
 
+            #ifdef ENABLE_TBB
+            detail::PatchEnergyBatch& batch = patch_batches.local();
+            #else
+            detail::PatchEnergyBatch& batch = patch_batch;
+            #endif
+
             // check for overlaps with neighboring particle's positions (also calculate the new energy)
             // All image boxes (including the primary)
             const unsigned int n_images = (unsigned int)m_image_list.size();
@@ -814,7 +975,8 @@ void IntegratorHPMCMono<Shape>::update(uint64_t timestep)
                 // stackless search
                 for (unsigned int cur_node_idx = 0; cur_node_idx < m_aabb_tree.getNumNodes(); cur_node_idx++)
                     {
-                    if (detail::overlap(m_aabb_tree.getNodeAABB(cur_node_idx), aabb))
+                    if (detail::overlap(m_aabb_tree.getNodeAABB(cur_node_idx), aabb)
+                        && (m_aabb_tree.getNodeTypeMask(cur_node_idx) & query_type_mask))
                         {
                         if (m_aabb_tree.isNodeLeaf(cur_node_idx))
                             {
@@ -823,6 +985,11 @@ void IntegratorHPMCMono<Shape>::update(uint64_t timestep)
                                 // read in its position and orientation
                                 unsigned int j = m_aabb_tree.getNodeParticle(cur_node_idx, cur_p);
 
+                                // particles in the other active cells of a checkerboard sweep are out of range
+                                if (cell_i != checkerboard_off && j < m_pdata->getN() && m_checkerboard_cell[j] != cell_i
+                                    && m_checkerboard_color[j] == active_color)
+                                    continue;
+
                                 Scalar4 postype_j;
                                 Scalar4 orientation_j;
 
@@ -853,31 +1020,27 @@ void IntegratorHPMCMono<Shape>::update(uint64_t timestep)
 
                                 unsigned int typ_j = __scalar_as_int(postype_j.w);
                                 Shape shape_j(quat<Scalar>(orientation_j), m_params[typ_j]);
+                                m_shape_cache.attach(j, shape_j);
 
                                 Scalar rcut = 0.0;
                                 if (m_patch)
                                     rcut = r_cut_patch + 0.5 * m_patch->getAdditiveCutoff(typ_j);
 
-                                counters.overlap_checks++;
+                                move_counters.overlap_checks++;
                                 if (h_overlaps.data[m_overlap_idx(typ_i, typ_j)]
                                     && check_circumsphere_overlap(r_ij, shape_i, shape_j)
-                                    && test_overlap(r_ij, shape_i, shape_j, counters.overlap_err_count))
+                                    && test_overlap(r_ij, shape_i, shape_j, move_counters.overlap_err_count))
                                     {
                                     overlap = true;
                                     break;
                                     }
                                 else if (m_patch && !m_patch_log && dot(r_ij,r_ij) <= rcut*rcut) // If there is no overlap and m_patch is not NULL, calculate energy
                                     {
-                                    // deltaU = U_old - U_new: subtract energy of new configuration
-                                    patch_field_energy_diff -= m_patch->energy(r_ij, typ_i,
-                                                               quat<float>(shape_i.orientation),
-                                                               float(h_diameter.data[i]),
-                                                               float(h_charge.data[i]),
-                                                               typ_j,
-                                                               quat<float>(orientation_j),
-                                                               float(h_diameter.data[j]),
-                                                               float(h_charge.data[j])
-                                                               );
+                                    batch.push(vec3<float>(r_ij),
+                                               typ_j,
+                                               quat<float>(orientation_j),
+                                               float(h_diameter.data[j]),
+                                               float(h_charge.data[j]));
                                     }
                                 }
                             }
@@ -899,6 +1062,13 @@ void IntegratorHPMCMono<Shape>::update(uint64_t timestep)
             // calculate old patch energy only if m_patch not NULL and no overlaps
             if (m_patch && !m_patch_log && !overlap)
                 {
+                // deltaU = U_old - U_new: subtract energy of new configuration
+                patch_field_energy_diff -= batch.evaluate(*m_patch,
+                                                          typ_i,
+                                                          quat<float>(shape_i.orientation),
+                                                          float(h_diameter.data[i]),
+                                                          float(h_charge.data[i]));
+
                 for (unsigned int cur_image = 0; cur_image < n_images; cur_image++)
                     {
                     vec3<Scalar> pos_i_image = pos_old + m_image_list[cur_image];
@@ -917,6 +1087,11 @@ void IntegratorHPMCMono<Shape>::update(uint64_t timestep)
                                     // read in its position and orientation
                                     unsigned int j = m_aabb_tree.getNodeParticle(cur_node_idx, cur_p);
 
+                                    // particles in the other active cells of a checkerboard sweep are out of range
+                                    if (cell_i != checkerboard_off && j < m_pdata->getN() && m_checkerboard_cell[j] != cell_i
+                                        && m_checkerboard_color[j] == active_color)
+                                        continue;
+
                                     Scalar4 postype_j;
                                     Scalar4 orientation_j;
 
@@ -949,17 +1124,12 @@ void IntegratorHPMCMono<Shape>::update(uint64_t timestep)
 
                                     Scalar rcut = r_cut_patch + 0.5 * m_patch->getAdditiveCutoff(typ_j);
 
-                                    // deltaU = U_old - U_new: add energy of old configuration
                                     if (dot(r_ij,r_ij) <= rcut*rcut)
-                                        patch_field_energy_diff += m_patch->energy(r_ij,
-                                                                   typ_i,
-                                                                   quat<float>(orientation_i),
-                                                                   float(h_diameter.data[i]),
-                                                                   float(h_charge.data[i]),
-                                                                   typ_j,
-                                                                   quat<float>(orientation_j),
-                                                                   float(h_diameter.data[j]),
-                                                                   float(h_charge.data[j]));
+                                        batch.push(vec3<float>(r_ij),
+                                                   typ_j,
+                                                   quat<float>(orientation_j),
+                                                   float(h_diameter.data[j]),
+                                                   float(h_charge.data[j]));
                                     }
                                 }
                             }
@@ -970,7 +1140,19 @@ void IntegratorHPMCMono<Shape>::update(uint64_t timestep)
                             }
                         }  // end loop over AABB nodes
                     } // end loop over images
+
+                // deltaU = U_old - U_new: add energy of old configuration
+                patch_field_energy_diff += batch.evaluate(*m_patch,
+                                                          typ_i,
+                                                          quat<float>(orientation_i),
+                                                          float(h_diameter.data[i]),
+                                                          float(h_charge.data[i]));
                 } // end if (m_patch)
+            else
+                {
+                // the new configuration overlaps, its energy is not needed
+                batch.clear();
+                }
 
             // Add external energetic contribution
             if (m_external)
@@ -984,10 +1166,14 @@ void IntegratorHPMCMono<Shape>::update(uint64_t timestep)
             unsigned int seed_i_new = hoomd::detail::generate_u32(rng_i);
             unsigned int seed_i_old = __scalar_as_int(h_vel.data[i].x);
 
-            if (has_depletants && accept)
+            if (cache_depletants && accept)
+                {
+                accept = !checkCachedDepletantOverlap(pos_i, shape_i, typ_i, h_overlaps.data);
+                }
+            else if (has_depletants && accept)
                 {
                 accept = checkDepletantOverlap(i, pos_i, shape_i, typ_i, h_postype.data,
-                    h_orientation.data, h_tag.data, h_vel.data, h_overlaps.data, counters, h_implicit_counters.data,
+                    h_orientation.data, h_tag.data, h_vel.data, h_overlaps.data, move_counters, h_implicit_counters.data,
                     timestep^i_nselect, rng_depletants, seed_i_old, seed_i_new);
                 }
 
@@ -999,15 +1185,19 @@ void IntegratorHPMCMono<Shape>::update(uint64_t timestep)
                 if (!shape_i.ignoreStatistics())
                     {
                     if (move_type_translate)
-                        counters.translate_accept_count++;
+                        move_counters.translate_accept_count++;
                     else
-                        counters.rotate_accept_count++;
+                        move_counters.rotate_accept_count++;
                     }
 
-                // update the position of the particle in the tree for future updates
-                detail::AABB aabb = aabb_i_local;
-                aabb.translate(pos_i);
-                m_aabb_tree.update(i, aabb);
+                // update the position of the particle in the tree for future updates, the tree built
+                // for a checkerboard sweep already bounds the moves of all particles
+                if (cell_i == checkerboard_off)
+                    {
+                    detail::AABB aabb = aabb_i_local;
+                    aabb.translate(pos_i);
+                    m_aabb_tree.update(i, aabb);
+                    }
 
                 // update position of particle
                 h_postype.data[i] = make_scalar4(pos_i.x,pos_i.y,pos_i.z,postype_i.w);
@@ -1027,12 +1217,73 @@ void IntegratorHPMCMono<Shape>::update(uint64_t timestep)
                     {
                     // increment reject counter
                     if (move_type_translate)
-                        counters.translate_reject_count++;
+                        move_counters.translate_reject_count++;
                     else
-                        counters.rotate_reject_count++;
+                        move_counters.rotate_reject_count++;
+                    }
+
+                if (!move_type_translate)
+                    m_shape_cache.set(i, shape_old);
+                }
+        };
+
+        if (!checkerboard || !binCheckerboard(timestep, i_nselect, h_postype.data, h_orientation.data, h_tag.data, h_d.data))
+            {
+            // loop through N particles in a shuffled order
+            for (unsigned int cur_particle = 0; cur_particle < m_pdata->getN(); cur_particle++)
+                trial_move(m_update_order[cur_particle], counters, checkerboard_off);
+            }
+        else
+            {
+            // cells of the same color are separated by at least one cell width, so the trial moves
+            // in different cells of the active color are independent
+            const unsigned int n_colors = (unsigned int)m_checkerboard_color_order.size();
+            const uint3 n_color_cells = make_uint3(m_checkerboard_indexer.getW() / 2,
+                                                   m_checkerboard_indexer.getH() / 2,
+                                                   ndim == 2 ? 1 : m_checkerboard_indexer.getD() / 2);
+            const unsigned int n_cells = n_color_cells.x * n_color_cells.y * n_color_cells.z;
+
+            // sweep the cells [begin,end) of the active color
+            auto sweep_cells = [&](unsigned int begin, unsigned int end, hpmc_counters_t& cell_counters)
+            {
+                for (unsigned int k = begin; k < end; k++)
+                    {
+                    unsigned int cell = m_checkerboard_indexer(
+                        2 * (k % n_color_cells.x) + (active_color & 1),
+                        2 * ((k / n_color_cells.x) % n_color_cells.y) + ((active_color >> 1) & 1),
+                        2 * (k / (n_color_cells.x * n_color_cells.y)) + ((active_color >> 2) & 1));
+                    for (unsigned int idx = m_checkerboard_cell_start[cell];
+                         idx < m_checkerboard_cell_start[cell + 1];
+                         idx++)
+                        trial_move(m_checkerboard_cell_members[idx], cell_counters, cell);
                     }
+            };
+
+            #ifdef ENABLE_TBB
+            tbb::enumerable_thread_specific<hpmc_counters_t> thread_counters;
+            #endif
+
+            for (unsigned int cur_color = 0; cur_color < n_colors; cur_color++)
+                {
+                active_color = m_checkerboard_color_order[cur_color];
+
+                #ifdef ENABLE_TBB
+                m_exec_conf->getTaskArena()->execute([&]{
+                tbb::parallel_for(tbb::blocked_range<unsigned int>(0, n_cells),
+                    [&](const tbb::blocked_range<unsigned int>& r) {
+                    sweep_cells(r.begin(), r.end(), thread_counters.local());
+                    });
+                });
+                #else
+                sweep_cells(0, n_cells, counters);
+                #endif
                 }
-            } // end loop over all particles
+
+            #ifdef ENABLE_TBB
+            for (auto& c : thread_counters)
+                counters = counters + c;
+            #endif
+            }
         } // end loop over nselect
 
         {
@@ -1084,10 +1335,8 @@ void IntegratorHPMCMono<Shape>::update(uint64_t timestep)
     // all particle have been moved, the aabb tree is now invalid
     m_aabb_tree_invalid = true;
 
-    // set current MPS value
-    hpmc_counters_t run_counters = getCounters(1);
-    double cur_time = double(m_clock.getTime()) / Scalar(1e9);
-    m_mps = double(run_counters.getNMoves()) / cur_time;
+    // record the elapsed time for the MPS value
+    m_mps_time = m_clock.getTime();
     }
 
 /*! \param timestep current step
@@ -1138,7 +1387,8 @@ unsigned int IntegratorHPMCMono<Shape>::countOverlaps(bool early_exit)
             // stackless search
             for (unsigned int cur_node_idx = 0; cur_node_idx < m_aabb_tree.getNumNodes(); cur_node_idx++)
                 {
-                if (detail::overlap(m_aabb_tree.getNodeAABB(cur_node_idx), aabb))
+                if (detail::overlap(m_aabb_tree.getNodeAABB(cur_node_idx), aabb)
+                    && (m_aabb_tree.getNodeTypeMask(cur_node_idx) & m_overlap_type_mask[typ_i]))
                     {
                     if (m_aabb_tree.isNodeLeaf(cur_node_idx))
                         {
@@ -1248,6 +1498,13 @@ float IntegratorHPMCMono<Shape>::computePatchEnergy(uint64_t timestep)
     // access parameters and interaction matrix
     ArrayHandle<unsigned int> h_overlaps(m_overlaps, access_location::host, access_mode::read);
 
+    // neighbors of each particle, evaluated in one batch
+    #ifdef ENABLE_TBB
+    tbb::enumerable_thread_specific<detail::PatchEnergyBatch> patch_batches;
+    #else
+    detail::PatchEnergyBatch patch_batch;
+    #endif
+
     // Loop over all particles
     #ifdef ENABLE_TBB
     m_exec_conf->getTaskArena()->execute([&]{
@@ -1270,6 +1527,12 @@ float IntegratorHPMCMono<Shape>::computePatchEnergy(uint64_t timestep)
         Scalar d_i = h_diameter.data[i];
         Scalar charge_i = h_charge.data[i];
 
+        #ifdef ENABLE_TBB
+        detail::PatchEnergyBatch& batch = patch_batches.local();
+        #else
+        detail::PatchEnergyBatch& batch = patch_batch;
+        #endif
+
         // the cut-off
         OverlapReal r_cut = OverlapReal(m_patch->getRCut() + 0.5*m_patch->getAdditiveCutoff(typ_i));
 
@@ -1317,15 +1580,11 @@ float IntegratorHPMCMono<Shape>::computePatchEnergy(uint64_t timestep)
 
                             if (h_tag.data[i] <= h_tag.data[j] && dot(r_ij,r_ij) <= rcut_ij*rcut_ij)
                                 {
-                                energy += m_patch->energy(r_ij,
-                                       typ_i,
-                                       quat<float>(orientation_i),
-                                       float(d_i),
-                                       float(charge_i),
-                                       typ_j,
-                                       quat<float>(orientation_j),
-                                       float(d_j),
-                                       float(charge_j));
+                                batch.push(vec3<float>(r_ij),
+                                           typ_j,
+                                           quat<float>(orientation_j),
+                                           float(d_j),
+                                           float(charge_j));
                                 }
                             }
                         }
@@ -1338,6 +1597,8 @@ float IntegratorHPMCMono<Shape>::computePatchEnergy(uint64_t timestep)
 
                 } // end loop over AABB nodes
             } // end loop over images
+
+        energy += batch.evaluate(*m_patch, typ_i, quat<float>(orientation_i), float(d_i), float(charge_i));
         } // end loop over particles
     #ifdef ENABLE_TBB
     return energy;
@@ -1443,6 +1704,19 @@ void IntegratorHPMCMono<Shape>::setParam(unsigned int typ,  const param_type& pa
         // update the parameter for this type
         m_exec_conf->msg->notice(7) << "setParam : " << typ << std::endl;
         m_params[typ] = param;
+        m_param_version++;
+
+        // only the modified type needs its memory hints updated on the device
+        if (m_params_modified_begin == m_params_modified_end)
+            {
+            m_params_modified_begin = typ;
+            m_params_modified_end = typ + 1;
+            }
+        else
+            {
+            m_params_modified_begin = std::min(m_params_modified_begin, typ);
+            m_params_modified_end = std::max(m_params_modified_end, typ + 1);
+            }
         }
 
     updateCellWidth();
@@ -1459,10 +1733,30 @@ void IntegratorHPMCMono<Shape>::setInteractionMatrix(std::pair<std::string, std:
     ArrayHandle<unsigned int> h_overlaps(m_overlaps, access_location::host, access_mode::readwrite);
     h_overlaps.data[m_overlap_idx(typi,typj)] = check_overlaps;
     h_overlaps.data[m_overlap_idx(typj,typi)] = check_overlaps;
+    updateOverlapTypeMask(h_overlaps.data);
 
     m_image_list_valid = false;
     }
 
+/*! \param h_overlaps Interaction matrix
+
+    The broad phase skips the AABB tree nodes without any particle of a type in
+    m_overlap_type_mask[typ_i], so that non-interacting species do not cost tree traversals.
+*/
+template <class Shape>
+void IntegratorHPMCMono<Shape>::updateOverlapTypeMask(const unsigned int *h_overlaps)
+    {
+    m_overlap_type_mask.assign(m_pdata->getNTypes(), 0);
+    for (unsigned int typ_i = 0; typ_i < m_pdata->getNTypes(); typ_i++)
+        {
+        for (unsigned int typ_j = 0; typ_j < m_pdata->getNTypes(); typ_j++)
+            {
+            if (h_overlaps[m_overlap_idx(typ_i, typ_j)])
+                m_overlap_type_mask[typ_i] |= detail::type_mask_bit(typ_j);
+            }
+        }
+    }
+
 template <class Shape>
 bool IntegratorHPMCMono<Shape>::getInteractionMatrixPy(std::pair<std::string, std::string> types)
     {
@@ -1754,6 +2048,9 @@ void IntegratorHPMCMono<Shape>::growAABBList(unsigned int N)
     Subclasses that override update() or other methods must be user to set m_aabb_tree_invalid appropriately, or
     erroneous simulations will result.
 
+    When the aabb_refit_threshold is positive, an invalid tree is refit in place instead of rebuilt as long as it
+    holds the same particles, see fitAABBTree().
+
     \returns A reference to the tree.
 */
 template <class Shape>
@@ -1767,17 +2064,20 @@ const detail::AABBTree& IntegratorHPMCMono<Shape>::buildAABBTree()
             {
             ArrayHandle<Scalar4> h_postype(m_pdata->getPositions(), access_location::host, access_mode::read);
             ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(), access_location::host, access_mode::read);
+            ArrayHandle<unsigned int> h_tag(m_pdata->getTags(), access_location::host, access_mode::read);
 
             // grow the AABB list to the needed size
             unsigned int n_aabb = m_pdata->getN()+m_pdata->getNGhosts();
             if (n_aabb > 0)
                 {
                 growAABBList(n_aabb);
+                m_aabb_type_masks.resize(n_aabb);
                 for (unsigned int cur_particle = 0; cur_particle < n_aabb; cur_particle++)
                     {
                     unsigned int i = cur_particle;
                     unsigned int typ_i = __scalar_as_int(h_postype.data[i].w);
                     Shape shape(quat<Scalar>(h_orientation.data[i]), m_params[typ_i]);
+                    m_aabb_type_masks[i] = detail::type_mask_bit(typ_i);
 
                     if (!this->m_patch)
                         m_aabbs[i] = shape.getAABB(vec3<Scalar>(h_postype.data[i]));
@@ -1788,7 +2088,8 @@ const detail::AABBTree& IntegratorHPMCMono<Shape>::buildAABBTree()
                         m_aabbs[i] = detail::AABB(vec3<Scalar>(h_postype.data[i]), radius);
                         }
                     }
-                m_aabb_tree.buildTree(m_aabbs, n_aabb);
+                fitAABBTree(n_aabb, h_tag.data);
+                m_aabb_tree.setTypeMasks(m_aabb_type_masks.data(), n_aabb);
                 }
             }
 
@@ -1799,6 +2100,35 @@ const detail::AABBTree& IntegratorHPMCMono<Shape>::buildAABBTree()
     return m_aabb_tree;
     }
 
+/*! \param N Number of AABBs in m_aabbs
+    \param h_tag Tags of the particles, following the order of m_aabbs
+
+    Refitting keeps the tree topology and only recomputes the node AABBs, which is much cheaper than a rebuild
+    when the particles have moved a small distance since the last build. The topology remains valid as long as
+    the tree holds the same particles at the same indices, which fitAABBTree() verifies by comparing the tags to
+    those at the last build. Sorting, migration, ghost exchange and insertions or removals all change the tags
+    and force a rebuild.
+
+    Over many refits, the leaves grow as their particles diffuse apart. The tree is rebuilt when its cost (the
+    total surface area of the nodes) exceeds that after the last build by more than m_aabb_refit_threshold.
+*/
+template <class Shape>
+void IntegratorHPMCMono<Shape>::fitAABBTree(unsigned int N, const unsigned int *h_tag)
+    {
+    if (m_aabb_refit_threshold > 0 && m_aabb_tree_tags.size() == N
+        && std::equal(h_tag, h_tag + N, m_aabb_tree_tags.begin()))
+        {
+        m_aabb_tree.refit(m_aabbs, N);
+        if (m_aabb_tree.getCost() <= (Scalar(1.0) + m_aabb_refit_threshold) * m_aabb_tree_build_cost)
+            return;
+        }
+
+    m_exec_conf->msg->notice(8) << "Rebuilding AABB tree" << std::endl;
+    m_aabb_tree.buildTree(m_aabbs, N);
+    m_aabb_tree_build_cost = m_aabb_tree.getCost();
+    m_aabb_tree_tags.assign(h_tag, h_tag + N);
+    }
+
 /*! Call to reduce the m_d values down to safe levels for the bvh tree + small box limitations. That code path
     will not work if particles can wander more than one image in a time step.
 
@@ -1834,6 +2164,176 @@ void IntegratorHPMCMono<Shape>::limitMoveDistances()
         }
     }
 
+/*! Shapes that do not specialize ShapeCache skip this step. The entries of rotated particles are updated
+    during the trial moves, so they remain valid until the particle data changes outside of update().
+*/
+template <class Shape>
+void IntegratorHPMCMono<Shape>::updateShapeCache()
+    {
+    if (!ShapeCache<Shape>::isEnabled())
+        return;
+
+    ArrayHandle<Scalar4> h_postype(m_pdata->getPositions(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(), access_location::host, access_mode::read);
+
+    unsigned int n = m_pdata->getN() + m_pdata->getNGhosts();
+    m_shape_cache.resize(n, m_params.data(), m_pdata->getNTypes());
+
+    auto set_entries = [&](unsigned int begin, unsigned int end)
+    {
+        for (unsigned int i = begin; i < end; i++)
+            {
+            Shape shape(quat<Scalar>(h_orientation.data[i]), m_params[__scalar_as_int(h_postype.data[i].w)]);
+            m_shape_cache.set(i, shape);
+            }
+    };
+
+    #ifdef ENABLE_TBB
+    m_exec_conf->getTaskArena()->execute([&]{
+    tbb::parallel_for(tbb::blocked_range<unsigned int>(0, n),
+        [&](const tbb::blocked_range<unsigned int>& r) {
+        set_entries(r.begin(), r.end());
+        });
+    });
+    #else
+    set_entries(0, n);
+    #endif
+    }
+
+/*! \param timestep Current time step
+    \param select Index of the current sweep (0 <= select < nselect)
+    \param h_postype Particle positions and types
+    \param h_orientation Particle orientations
+    \param h_tag Particle tags
+    \param h_d Maximum move displacement by type
+    \returns false when the local box is too small for a checkerboard
+
+    The local box is divided into an even number of cells in every direction, each at least as wide
+    as the nominal width. The cells have 2^dim colors, so that two cells of the same color are
+    separated by at least one other cell. A random fractional shift of the grid and a random order
+    of the colors are drawn for every sweep so that the sweeps satisfy detailed balance.
+
+    The AABB tree is refit or rebuilt with an AABB for each local particle that bounds all of its
+    positions after one trial move. Each particle is moved at most once per sweep, so the tree remains valid
+    for the whole sweep without updates and can be read concurrently.
+*/
+template <class Shape>
+bool IntegratorHPMCMono<Shape>::binCheckerboard(uint64_t timestep, unsigned int select,
+    const Scalar4 *h_postype, const Scalar4 *h_orientation, const unsigned int *h_tag,
+    const Scalar *h_d)
+    {
+    const BoxDim& box = m_pdata->getBox();
+    unsigned int ndim = m_sysdef->getNDimensions();
+    unsigned int N = m_pdata->getN();
+
+    if (m_nominal_width <= Scalar(0.0))
+        return false;
+
+    // round the number of cells down to an even number in every direction
+    Scalar3 npd = box.getNearestPlaneDistance();
+    Scalar3 n = npd / m_nominal_width;
+
+    // limit the number of cells to a small multiple of the number of particles in dilute systems
+    Scalar n_max = Scalar(8 * N + 8);
+    Scalar n_total = n.x * n.y * (ndim == 2 ? Scalar(1.0) : n.z);
+    if (n_total > n_max)
+        n *= slow::pow(n_max / n_total, Scalar(1.0) / Scalar(ndim));
+
+    uint3 dim = make_uint3((unsigned int)n.x & ~1u,
+                           (unsigned int)n.y & ~1u,
+                           ndim == 2 ? 1 : (unsigned int)n.z & ~1u);
+    if (dim.x < 2 || dim.y < 2 || dim.z < 1 || (ndim == 3 && dim.z < 2))
+        return false;
+
+    m_checkerboard_indexer = Index3D(dim.x, dim.y, dim.z);
+
+    // draw the grid shift and the order of the colors
+    hoomd::RandomGenerator rng(hoomd::Seed(hoomd::RNGIdentifier::HPMCMonoCheckerboard, timestep, m_sysdef->getSeed()),
+                               hoomd::Counter(m_exec_conf->getRank(), select));
+    hoomd::UniformDistribution<Scalar> uniform(Scalar(0.0), Scalar(1.0));
+    m_checkerboard_shift.x = uniform(rng);
+    m_checkerboard_shift.y = uniform(rng);
+    m_checkerboard_shift.z = ndim == 2 ? Scalar(0.0) : uniform(rng);
+
+    unsigned int n_colors = ndim == 2 ? 4 : 8;
+    m_checkerboard_color_order.resize(n_colors);
+    for (unsigned int c = 0; c < n_colors; c++)
+        m_checkerboard_color_order[c] = c;
+    for (unsigned int c = n_colors - 1; c > 0; c--)
+        std::swap(m_checkerboard_color_order[c], m_checkerboard_color_order[hoomd::UniformIntDistribution(c)(rng)]);
+
+    // find the cell of each particle and the AABB that bounds its trial move
+    m_checkerboard_cell.resize(N);
+    m_checkerboard_color.resize(N);
+    unsigned int n_aabb = N + m_pdata->getNGhosts();
+    growAABBList(n_aabb);
+
+    auto bin_particles = [&](unsigned int begin, unsigned int end)
+    {
+        for (unsigned int i = begin; i < end; i++)
+            {
+            vec3<Scalar> pos_i(h_postype[i]);
+            unsigned int typ_i = __scalar_as_int(h_postype[i].w);
+            Shape shape_i(quat<Scalar>(h_orientation[i]), m_params[typ_i]);
+
+            if (i >= N)
+                {
+                // ghost particles are not moved
+                if (!this->m_patch)
+                    m_aabbs[i] = shape_i.getAABB(pos_i);
+                else
+                    {
+                    Scalar radius = std::max(0.5*shape_i.getCircumsphereDiameter(),
+                        0.5*this->m_patch->getAdditiveCutoff(typ_i));
+                    m_aabbs[i] = detail::AABB(pos_i, radius);
+                    }
+                continue;
+                }
+
+            unsigned int cell = getCheckerboardCell(pos_i, box);
+            uint3 cell_ijk = m_checkerboard_indexer.getTriple(cell);
+            m_checkerboard_cell[i] = cell;
+            m_checkerboard_color[i] = (unsigned char)((cell_ijk.x & 1) | ((cell_ijk.y & 1) << 1) | ((cell_ijk.z & 1) << 2));
+
+            Scalar radius = 0.5*shape_i.getCircumsphereDiameter();
+            if (this->m_patch)
+                radius = std::max(radius, Scalar(0.5*this->m_patch->getAdditiveCutoff(typ_i)));
+            m_aabbs[i] = detail::AABB(pos_i, radius + h_d[typ_i]);
+            }
+    };
+
+    #ifdef ENABLE_TBB
+    m_exec_conf->getTaskArena()->execute([&]{
+    tbb::parallel_for(tbb::blocked_range<unsigned int>(0, n_aabb),
+        [&](const tbb::blocked_range<unsigned int>& r) {
+        bin_particles(r.begin(), r.end());
+        });
+    });
+    #else
+    bin_particles(0, n_aabb);
+    #endif
+
+    fitAABBTree(n_aabb, h_tag);
+
+    // sort the particles by cell, keeping the update order within each cell
+    unsigned int n_cells = m_checkerboard_indexer.getNumElements();
+    m_checkerboard_cell_start.assign(n_cells + 1, 0);
+    for (unsigned int i = 0; i < N; i++)
+        m_checkerboard_cell_start[m_checkerboard_cell[i] + 1]++;
+    for (unsigned int cell = 0; cell < n_cells; cell++)
+        m_checkerboard_cell_start[cell + 1] += m_checkerboard_cell_start[cell];
+
+    m_checkerboard_cell_members.resize(N);
+    std::vector<unsigned int> offset(m_checkerboard_cell_start.begin(), m_checkerboard_cell_start.end() - 1);
+    for (unsigned int cur_particle = 0; cur_particle < N; cur_particle++)
+        {
+        unsigned int i = m_update_order[cur_particle];
+        m_checkerboard_cell_members[offset[m_checkerboard_cell[i]]++] = i;
+        }
+
+    return true;
+    }
+
 /*! Function for finding all overlaps in a system by particle tag. returns an unraveled form of an NxN matrix
  * with true/false indicating the overlap status of the ith and jth particle
  */
@@ -2082,7 +2582,8 @@ void IntegratorHPMCMono<Shape>::connectGSDStateSignal(
                                                     std::string name)
     {
     typedef hoomd::detail::SharedSignalSlot<int(gsd_handle&)> SlotType;
-    auto func = std::bind(&IntegratorHPMCMono<Shape>::slotWriteGSDState, this, std::placeholders::_1, name);
+    auto func = std::bind(&IntegratorHPMCMono<Shape>::slotWriteGSDState, this, std::placeholders::_1, name,
+                          std::make_shared<GSDFrameZero>());
     std::shared_ptr<hoomd::detail::SignalSlot> pslot( new SlotType(writer->getWriteSignal(), func));
     addSlot(pslot);
     }
@@ -2091,14 +2592,53 @@ template <class Shape>
 void IntegratorHPMCMono<Shape>::connectGSDShapeSpec(std::shared_ptr<GSDDumpWriter> writer)
     {
     typedef hoomd::detail::SharedSignalSlot<int(gsd_handle&)> SlotType;
-    auto func = std::bind(&IntegratorHPMCMono<Shape>::slotWriteGSDShapeSpec, this, std::placeholders::_1);
+    auto func = std::bind(&IntegratorHPMCMono<Shape>::slotWriteGSDShapeSpec, this, std::placeholders::_1,
+                          std::make_shared<GSDFrameZero>());
     std::shared_ptr<hoomd::detail::SignalSlot> pslot( new SlotType(writer->getWriteSignal(), func));
     addSlot(pslot);
     }
 
+/*! \param handle GSD file handle
+    \param name Prefix of the shape parameter chunks
+    \param frame_zero State of the integrator in frame 0 of the file, kept between calls
+
+    GSD readers fall back to frame 0 for chunks that are missing in a frame. Write the move sizes and
+    shape parameters in frame 0, and in later frames only when they differ from frame 0. The shape
+    parameters are compared by version, the move sizes by value. Frame 0 of a file opened for
+    appending is unknown, so every frame is written in that case.
+*/
 template <class Shape>
-int IntegratorHPMCMono<Shape>::slotWriteGSDState( gsd_handle& handle, std::string name ) const
+int IntegratorHPMCMono<Shape>::slotWriteGSDState( gsd_handle& handle, std::string name,
+                                                  std::shared_ptr<GSDFrameZero> frame_zero) const
     {
+    // only the root rank writes to the file
+    if (!m_exec_conf->isRoot())
+        return 0;
+
+    // access parameters
+    ArrayHandle<Scalar> h_d(m_d, access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_a(m_a, access_location::host, access_mode::read);
+    const unsigned int n_types = m_pdata->getNTypes();
+
+    bool write_d = true;
+    bool write_a = m_hasOrientation;
+    bool write_shape = true;
+    if (gsd_get_nframes(&handle) == 0)
+        {
+        frame_zero->valid = true;
+        frame_zero->param_version = m_param_version;
+        frame_zero->d.assign(h_d.data, h_d.data + n_types);
+        frame_zero->a.assign(h_a.data, h_a.data + n_types);
+        }
+    else if (frame_zero->valid)
+        {
+        write_d = !std::equal(h_d.data, h_d.data + n_types,
+                              frame_zero->d.begin(), frame_zero->d.end());
+        write_a = write_a && !std::equal(h_a.data, h_a.data + n_types,
+                                         frame_zero->a.begin(), frame_zero->a.end());
+        write_shape = frame_zero->param_version != m_param_version;
+        }
+
     m_exec_conf->msg->notice(10) << "IntegratorHPMCMono writing to GSD File to name: "<< name << std::endl;
     int retval = 0;
     // create schema helpers
@@ -2110,22 +2650,46 @@ int IntegratorHPMCMono<Shape>::slotWriteGSDState( gsd_handle& handle, std::strin
     gsd_schema_hpmc schema(m_exec_conf, mpi);
     gsd_shape_schema<typename Shape::param_type> schema_shape(m_exec_conf, mpi);
 
-    // access parameters
-    ArrayHandle<Scalar> h_d(m_d, access_location::host, access_mode::read);
-    ArrayHandle<Scalar> h_a(m_a, access_location::host, access_mode::read);
-    schema.write(handle, "state/hpmc/integrate/d", m_pdata->getNTypes(), h_d.data, GSD_TYPE_DOUBLE);
-    if(m_hasOrientation)
+    if (write_d)
+        {
+        schema.write(handle, "state/hpmc/integrate/d", n_types, h_d.data, GSD_TYPE_DOUBLE);
+        }
+    if (write_a)
+        {
+        schema.write(handle, "state/hpmc/integrate/a", n_types, h_a.data, GSD_TYPE_DOUBLE);
+        }
+    if (write_shape)
         {
-        schema.write(handle, "state/hpmc/integrate/a", m_pdata->getNTypes(), h_a.data, GSD_TYPE_DOUBLE);
+        retval |= schema_shape.write(handle, name, n_types, m_params);
         }
-    retval |= schema_shape.write(handle, name, m_pdata->getNTypes(), m_params);
 
     return retval;
     }
 
+/*! \param handle GSD file handle
+    \param frame_zero State of the integrator in frame 0 of the file, kept between calls
+
+    Like slotWriteGSDState(), write the shape specification only in frame 0 and in frames where the
+    shape parameters differ from frame 0.
+*/
 template <class Shape>
-int IntegratorHPMCMono<Shape>::slotWriteGSDShapeSpec(gsd_handle& handle) const
+int IntegratorHPMCMono<Shape>::slotWriteGSDShapeSpec(gsd_handle& handle,
+                                                     std::shared_ptr<GSDFrameZero> frame_zero) const
     {
+    // only the root rank writes to the file
+    if (!m_exec_conf->isRoot())
+        return 0;
+
+    if (gsd_get_nframes(&handle) == 0)
+        {
+        frame_zero->valid = true;
+        frame_zero->param_version = m_param_version;
+        }
+    else if (frame_zero->valid && frame_zero->param_version == m_param_version)
+        {
+        return 0;
+        }
+
     GSDShapeSpecWriter shapespec(m_exec_conf);
     m_exec_conf->msg->notice(10) << "IntegratorHPMCMono writing to GSD File to name: " << shapespec.getName() << std::endl;
     int retval = shapespec.write(handle, this->getTypeShapeMapping(m_params));
@@ -2155,6 +2719,10 @@ bool IntegratorHPMCMono<Shape>::restoreStateGSD( std::shared_ptr<GSDReader> read
         schema.read(reader, frame, "state/hpmc/integrate/a", m_pdata->getNTypes(), h_a.data, GSD_TYPE_DOUBLE);
         }
     schema_shape.read(reader, frame, name, m_pdata->getNTypes(), m_params);
+    m_param_version++;
+    m_params_modified_begin = 0;
+    m_params_modified_end = m_pdata->getNTypes();
+    updateCellWidth();
     return success;
     }
 
@@ -3204,6 +3772,258 @@ inline bool IntegratorHPMCMono<Shape>::checkDepletantOverlap(unsigned int i, vec
     return accept;
     }
 
+/*! \param timestep Current time step
+    \param implicit_counters Depletant insertion counters
+
+    The depletants are ideal particles at fugacity z. Given the particle configuration, they form a
+    Poisson process of density z in the free volume. insertCachedDepletants() samples one
+    configuration of this process: it draws a Poisson distributed number of depletants of each type
+    uniformly in the local box and discards those that overlap a particle. The trial moves of the
+    step then treat the depletants as fixed obstacles, which samples the particles at fixed
+    depletants. Alternating the two steps is a Gibbs sampler of the joint ensemble, whose marginal
+    distribution of the particles is the same as that of the implicit depletant moves.
+
+    Each move tests overlaps against the depletants near the particle only, instead of inserting
+    ntrial sets of depletants into its excluded volume, and the cached configuration serves all
+    nselect sweeps of the step.
+*/
+template<class Shape>
+void IntegratorHPMCMono<Shape>::insertCachedDepletants(uint64_t timestep,
+    hpmc_implicit_counters_t *implicit_counters)
+    {
+    #ifdef ENABLE_MPI
+    if (m_pdata->getDomainDecomposition())
+        throw std::runtime_error("depletant_cache is not supported with domain decomposition");
+    #endif
+
+    const unsigned int ntypes = m_pdata->getNTypes();
+    for (unsigned int type_a = 0; type_a < ntypes; ++type_a)
+        {
+        for (unsigned int type_b = 0; type_b < ntypes; ++type_b)
+            {
+            Scalar fugacity = m_fugacity[m_depletant_idx(type_a,type_b)];
+            if (fugacity != 0.0 && (type_a != type_b || fugacity < 0.0))
+                throw std::runtime_error("depletant_cache requires positive fugacities of "
+                                         "single depletant types");
+            }
+        }
+
+    if (this->m_prof) this->m_prof->push(this->m_exec_conf, "HPMC depletant cache");
+
+    const BoxDim& box = m_pdata->getBox();
+    unsigned int ndim = m_sysdef->getNDimensions();
+    uint16_t seed = m_sysdef->getSeed();
+
+    // draw the candidate depletants
+    m_depletant_pos.clear();
+    m_depletant_orientation.clear();
+    m_depletant_type.clear();
+    for (unsigned int type_d = 0; type_d < ntypes; ++type_d)
+        {
+        Scalar fugacity = m_fugacity[m_depletant_idx(type_d,type_d)];
+        if (fugacity == 0.0)
+            continue;
+
+        hoomd::RandomGenerator rng_num(hoomd::Seed(hoomd::RNGIdentifier::HPMCDepletantCache,
+                                                   timestep,
+                                                   seed),
+                                       hoomd::Counter(type_d, m_exec_conf->getRank()));
+        hoomd::PoissonDistribution<Scalar> poisson(fugacity * box.getVolume(ndim == 2));
+        unsigned int n = poisson(rng_num);
+
+        Shape shape_d(quat<Scalar>(), m_params[type_d]);
+        for (unsigned int k = 0; k < n; ++k)
+            {
+            hoomd::RandomGenerator rng_k(hoomd::Seed(hoomd::RNGIdentifier::HPMCDepletantCache,
+                                                     timestep,
+                                                     seed),
+                                         hoomd::Counter(type_d, m_exec_conf->getRank(), k + 1));
+            Scalar3 f;
+            f.x = hoomd::detail::generate_canonical<Scalar>(rng_k);
+            f.y = hoomd::detail::generate_canonical<Scalar>(rng_k);
+            f.z = ndim == 3 ? hoomd::detail::generate_canonical<Scalar>(rng_k) : Scalar(0.5);
+
+            m_depletant_pos.push_back(vec3<Scalar>(box.makeCoordinates(f)));
+            m_depletant_orientation.push_back(shape_d.hasOrientation()
+                                              ? generateRandomOrientation(rng_k, ndim)
+                                              : quat<Scalar>());
+            m_depletant_type.push_back(type_d);
+            }
+
+        implicit_counters[m_depletant_idx(type_d,type_d)].insert_count += n;
+        }
+
+    // discard the depletants that overlap particles
+    unsigned int n_candidates = (unsigned int)m_depletant_pos.size();
+    std::vector<char> keep(n_candidates, 0);
+        {
+        ArrayHandle<Scalar4> h_postype(m_pdata->getPositions(), access_location::host, access_mode::read);
+        ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(), access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_overlaps(m_overlaps, access_location::host, access_mode::read);
+        const unsigned int n_images = (unsigned int) m_image_list.size();
+
+        auto test_depletant = [&](unsigned int k)
+            {
+            unsigned int type_d = m_depletant_type[k];
+            Shape shape_d(m_depletant_orientation[k], m_params[type_d]);
+            detail::AABB aabb_d_local = shape_d.getAABB(vec3<Scalar>(0,0,0));
+
+            for (unsigned int cur_image = 0; cur_image < n_images; cur_image++)
+                {
+                vec3<Scalar> pos_d_image = m_depletant_pos[k] + m_image_list[cur_image];
+                detail::AABB aabb = aabb_d_local;
+                aabb.translate(pos_d_image);
+
+                for (unsigned int cur_node_idx = 0; cur_node_idx < m_aabb_tree.getNumNodes(); cur_node_idx++)
+                    {
+                    if (detail::overlap(m_aabb_tree.getNodeAABB(cur_node_idx), aabb))
+                        {
+                        if (m_aabb_tree.isNodeLeaf(cur_node_idx))
+                            {
+                            for (unsigned int cur_p = 0; cur_p < m_aabb_tree.getNodeNumParticles(cur_node_idx); cur_p++)
+                                {
+                                unsigned int j = m_aabb_tree.getNodeParticle(cur_node_idx, cur_p);
+                                unsigned int typ_j = __scalar_as_int(h_postype.data[j].w);
+                                if (!h_overlaps.data[m_overlap_idx(type_d, typ_j)])
+                                    continue;
+
+                                Shape shape_j(quat<Scalar>(h_orientation.data[j]), m_params[typ_j]);
+                                vec3<Scalar> r_dj = vec3<Scalar>(h_postype.data[j]) - pos_d_image;
+                                unsigned int err = 0;
+                                if (check_circumsphere_overlap(r_dj, shape_d, shape_j)
+                                    && test_overlap(r_dj, shape_d, shape_j, err))
+                                    return;
+                                }
+                            }
+                        }
+                    else
+                        {
+                        // skip ahead
+                        cur_node_idx += m_aabb_tree.getNodeSkip(cur_node_idx);
+                        }
+                    }
+                }
+
+            keep[k] = 1;
+            };
+
+        if (m_pdata->getN() + m_pdata->getNGhosts() == 0)
+            std::fill(keep.begin(), keep.end(), 1);
+        else
+            {
+            #ifdef ENABLE_TBB
+            m_exec_conf->getTaskArena()->execute([&]{
+            tbb::parallel_for(tbb::blocked_range<unsigned int>(0, n_candidates),
+                [&](const tbb::blocked_range<unsigned int>& r) {
+                for (unsigned int k = r.begin(); k != r.end(); ++k)
+                    test_depletant(k);
+                });
+            });
+            #else
+            for (unsigned int k = 0; k < n_candidates; ++k)
+                test_depletant(k);
+            #endif
+            }
+        }
+
+    // compact the kept depletants and build their tree
+    unsigned int n_kept = 0;
+    for (unsigned int k = 0; k < n_candidates; ++k)
+        {
+        if (!keep[k])
+            continue;
+
+        m_depletant_pos[n_kept] = m_depletant_pos[k];
+        m_depletant_orientation[n_kept] = m_depletant_orientation[k];
+        m_depletant_type[n_kept] = m_depletant_type[k];
+        implicit_counters[m_depletant_idx(m_depletant_type[k],m_depletant_type[k])].insert_accept_count++;
+        n_kept++;
+        }
+    m_depletant_pos.resize(n_kept);
+    m_depletant_orientation.resize(n_kept);
+    m_depletant_type.resize(n_kept);
+
+    if (n_kept > m_depletant_aabbs_capacity)
+        {
+        m_depletant_aabbs_capacity = n_kept;
+        if (m_depletant_aabbs != NULL)
+            free(m_depletant_aabbs);
+
+        int retval = posix_memalign((void**)&m_depletant_aabbs, 32, n_kept*sizeof(detail::AABB));
+        if (retval != 0)
+            {
+            m_exec_conf->msg->errorAllRanks() << "Error allocating aligned memory" << std::endl;
+            throw std::runtime_error("Error allocating AABB memory");
+            }
+        }
+
+    for (unsigned int k = 0; k < n_kept; ++k)
+        {
+        Shape shape_d(m_depletant_orientation[k], m_params[m_depletant_type[k]]);
+        m_depletant_aabbs[k] = shape_d.getAABB(m_depletant_pos[k]);
+        }
+
+    if (n_kept > 0)
+        m_depletant_tree.buildTree(m_depletant_aabbs, n_kept);
+
+    if (this->m_prof) this->m_prof->pop(this->m_exec_conf);
+    }
+
+/*! \param pos_i Trial position of the particle
+    \param shape_i Trial shape of the particle
+    \param typ_i Type of the particle
+    \param h_overlaps Interaction matrix
+
+    \returns true when the trial configuration overlaps a depletant inserted by insertCachedDepletants()
+*/
+template<class Shape>
+inline bool IntegratorHPMCMono<Shape>::checkCachedDepletantOverlap(const vec3<Scalar>& pos_i,
+    const Shape& shape_i, unsigned int typ_i, const unsigned int *h_overlaps)
+    {
+    if (m_depletant_pos.empty())
+        return false;
+
+    detail::AABB aabb_i_local = shape_i.getAABB(vec3<Scalar>(0,0,0));
+    const unsigned int n_images = (unsigned int) m_image_list.size();
+    for (unsigned int cur_image = 0; cur_image < n_images; cur_image++)
+        {
+        vec3<Scalar> pos_i_image = pos_i + m_image_list[cur_image];
+        detail::AABB aabb = aabb_i_local;
+        aabb.translate(pos_i_image);
+
+        for (unsigned int cur_node_idx = 0; cur_node_idx < m_depletant_tree.getNumNodes(); cur_node_idx++)
+            {
+            if (detail::overlap(m_depletant_tree.getNodeAABB(cur_node_idx), aabb))
+                {
+                if (m_depletant_tree.isNodeLeaf(cur_node_idx))
+                    {
+                    for (unsigned int cur_p = 0; cur_p < m_depletant_tree.getNodeNumParticles(cur_node_idx); cur_p++)
+                        {
+                        unsigned int k = m_depletant_tree.getNodeParticle(cur_node_idx, cur_p);
+                        unsigned int type_d = m_depletant_type[k];
+                        if (!h_overlaps[m_overlap_idx(typ_i, type_d)])
+                            continue;
+
+                        Shape shape_d(m_depletant_orientation[k], m_params[type_d]);
+                        vec3<Scalar> r_id = m_depletant_pos[k] - pos_i_image;
+                        unsigned int err = 0;
+                        if (check_circumsphere_overlap(r_id, shape_i, shape_d)
+                            && test_overlap(r_id, shape_i, shape_d, err))
+                            return true;
+                        }
+                    }
+                }
+            else
+                {
+                // skip ahead
+                cur_node_idx += m_depletant_tree.getNodeSkip(cur_node_idx);
+                }
+            }
+        }
+
+    return false;
+    }
+
 template<class Shape>
 bool IntegratorHPMCMono<Shape>::attemptBoxResize(uint64_t timestep, const BoxDim& new_box)
     {
@@ -3252,6 +4072,10 @@ template < class Shape > void export_IntegratorHPMCMono(pybind11::module& m, con
           .def("getTypeShapesPy", &IntegratorHPMCMono<Shape>::getTypeShapesPy)
           .def("getShape", &IntegratorHPMCMono<Shape>::getShape)
           .def("setShape", &IntegratorHPMCMono<Shape>::setShape)
+          .def_property("aabb_refit_threshold", &IntegratorHPMCMono<Shape>::getAABBRefitThreshold,
+                        &IntegratorHPMCMono<Shape>::setAABBRefitThreshold)
+          .def_property("depletant_cache", &IntegratorHPMCMono<Shape>::getDepletantCache,
+                        &IntegratorHPMCMono<Shape>::setDepletantCache)
           ;
     }
 
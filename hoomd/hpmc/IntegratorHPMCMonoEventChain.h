@@ -0,0 +1,714 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#pragma once
+
+#include "IntegratorHPMCMono.h"
+#include "Moves.h"
+#include "ShapeConvexPolyhedron.h"
+#include "ShapeSphere.h"
+#include "ShapeSpheropolyhedron.h"
+
+#include "hoomd/RNGIdentifiers.h"
+#include "hoomd/RandomNumbers.h"
+
+#include <limits>
+#include <stdexcept>
+
+/*! \file IntegratorHPMCMonoEventChain.h
+    \brief Declaration of IntegratorHPMCMonoEventChain
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include <pybind11/pybind11.h>
+
+namespace hpmc
+    {
+namespace detail
+    {
+//! Distance a sphere moves along dir before it touches another sphere
+/*! \param r_ab Vector from the moving sphere a to the fixed sphere b (r_b - r_a)
+    \param dir Unit vector along which a moves
+    \param R Sum of the radii of a and b
+    \param max_distance Maximum distance to consider
+    \returns The distance to the contact, or \a max_distance when there is no contact within it
+
+    Spheres that already overlap and approach each other collide at distance 0.
+*/
+inline OverlapReal sphere_sweep_distance(const vec3<Scalar>& r_ab,
+                                         const vec3<Scalar>& dir,
+                                         OverlapReal R,
+                                         OverlapReal max_distance)
+    {
+    vec3<OverlapReal> dr(r_ab);
+    vec3<OverlapReal> n(dir);
+
+    // solve |r_ab - l*dir|^2 = R^2 for the smallest l
+    OverlapReal b = dot(dr, n);
+    OverlapReal c = dot(dr, dr) - R * R;
+
+    if (b <= OverlapReal(0.0))
+        return max_distance;
+
+    if (c <= OverlapReal(0.0))
+        return OverlapReal(0.0);
+
+    OverlapReal disc = b * b - c;
+    if (disc < OverlapReal(0.0))
+        return max_distance;
+
+    return detail::min(b - fast::sqrt(disc), max_distance);
+    }
+
+//! Test for overlap between shape a, swept by a sphere of radius extra, and shape b
+/*! \param r_ab Vector defining the position of shape b relative to shape a (r_b - r_a)
+    \param a first shape
+    \param b second shape
+    \param extra Radius of the sphere to sweep shape a by
+    \param err in/out variable incremented when error conditions occur in the overlap test
+    \returns true when the swept shape *a* and *b* overlap
+
+    Only specialized for the shapes supported by IntegratorHPMCMonoEventChain.
+*/
+template<class Shape>
+inline bool test_overlap_inflated(const vec3<Scalar>& r_ab,
+                                  const Shape& a,
+                                  const Shape& b,
+                                  OverlapReal extra,
+                                  unsigned int& err);
+
+template<>
+inline bool test_overlap_inflated(const vec3<Scalar>& r_ab,
+                                  const ShapeConvexPolyhedron& a,
+                                  const ShapeConvexPolyhedron& b,
+                                  OverlapReal extra,
+                                  unsigned int& err)
+    {
+    vec3<OverlapReal> dr(r_ab);
+    OverlapReal DaDb = a.getCircumsphereDiameter() + b.getCircumsphereDiameter();
+
+    return xenocollide_3d(SupportFuncConvexPolyhedron(a.verts, extra),
+                          SupportFuncConvexPolyhedron(b.verts),
+                          rotate(conj(quat<OverlapReal>(a.orientation)), dr),
+                          conj(quat<OverlapReal>(a.orientation)) * quat<OverlapReal>(b.orientation),
+                          DaDb / OverlapReal(2.0) + extra,
+                          err);
+    }
+
+template<>
+inline bool test_overlap_inflated(const vec3<Scalar>& r_ab,
+                                  const ShapeSpheropolyhedron& a,
+                                  const ShapeSpheropolyhedron& b,
+                                  OverlapReal extra,
+                                  unsigned int& err)
+    {
+    vec3<OverlapReal> dr(r_ab);
+    OverlapReal DaDb = a.getCircumsphereDiameter() + b.getCircumsphereDiameter();
+
+    return xenocollide_3d(SupportFuncConvexPolyhedron(a.verts, a.verts.sweep_radius + extra),
+                          SupportFuncConvexPolyhedron(b.verts, b.verts.sweep_radius),
+                          rotate(conj(quat<OverlapReal>(a.orientation)), dr),
+                          conj(quat<OverlapReal>(a.orientation)) * quat<OverlapReal>(b.orientation),
+                          DaDb / OverlapReal(2.0) + extra,
+                          err);
+    }
+
+//! Distance shape a moves along dir before it collides with shape b
+/*! \param r_ab Vector defining the position of shape b relative to shape a (r_b - r_a)
+    \param dir Unit vector along which a moves
+    \param a first shape
+    \param b second shape
+    \param max_distance Maximum distance to consider
+    \param err in/out variable incremented when error conditions occur in the overlap test
+    \returns A lower bound on the distance to the first contact that is within a small tolerance
+             of it, or \a max_distance when there is no contact within it
+
+    The collision of the circumspheres bounds the distance from below. The interval from there to
+    \a max_distance is bisected depth first, lower half first: the interval [l, h] contains no
+    collision when a, swept by a sphere of radius (h-l)/2, does not overlap b after a moves by
+    (l+h)/2. The lower end of the first interval narrower than the tolerance that cannot be ruled
+    out is returned, so that a never overlaps b after it moves by the returned distance.
+*/
+template<class Shape>
+inline OverlapReal sweep_distance(const vec3<Scalar>& r_ab,
+                                  const vec3<Scalar>& dir,
+                                  const Shape& a,
+                                  const Shape& b,
+                                  OverlapReal max_distance,
+                                  unsigned int& err)
+    {
+    OverlapReal R = (a.getCircumsphereDiameter() + b.getCircumsphereDiameter()) / OverlapReal(2.0);
+
+    // shapes with overlapping circumspheres may collide even when they move apart
+    OverlapReal lo = OverlapReal(0.0);
+    if (dot(r_ab, r_ab) > Scalar(R) * Scalar(R))
+        lo = sphere_sweep_distance(r_ab, dir, R, max_distance);
+    if (lo >= max_distance)
+        return max_distance;
+
+    const OverlapReal tol = OverlapReal(1e-5) * R;
+    const unsigned int max_stack = 64;
+    OverlapReal stack_lo[max_stack];
+    OverlapReal stack_hi[max_stack];
+    unsigned int n_stack = 0;
+
+    stack_lo[n_stack] = lo;
+    stack_hi[n_stack] = max_distance;
+    n_stack++;
+
+    while (n_stack > 0)
+        {
+        n_stack--;
+        OverlapReal l = stack_lo[n_stack];
+        OverlapReal h = stack_hi[n_stack];
+        OverlapReal half_width = (h - l) / OverlapReal(2.0);
+        OverlapReal mid = l + half_width;
+
+        if (!test_overlap_inflated(r_ab - Scalar(mid) * dir, a, b, half_width, err))
+            continue;
+
+        if (h - l < tol || n_stack + 2 > max_stack)
+            return l;
+
+        // push the upper half first so that the lower half is processed next
+        stack_lo[n_stack] = mid;
+        stack_hi[n_stack] = h;
+        n_stack++;
+        stack_lo[n_stack] = l;
+        stack_hi[n_stack] = mid;
+        n_stack++;
+        }
+
+    return max_distance;
+    }
+
+//! Spheres collide analytically
+template<>
+inline OverlapReal sweep_distance(const vec3<Scalar>& r_ab,
+                                  const vec3<Scalar>& dir,
+                                  const ShapeSphere& a,
+                                  const ShapeSphere& b,
+                                  OverlapReal max_distance,
+                                  unsigned int& err)
+    {
+    return sphere_sweep_distance(r_ab, dir, a.params.radius + b.params.radius, max_distance);
+    }
+
+    } // end namespace detail
+
+//! Event-chain Monte Carlo of hard shapes
+/*! IntegratorHPMCMonoEventChain replaces the translation trial moves of IntegratorHPMCMono with
+    event chains (Bernard, Krauth, and Wilson 2009). A chain starts at a particle and moves it in a
+    random direction until it collides with another particle. The chain then lifts to the
+    collider, which continues in the same direction, until the total displacement of the chain
+    reaches chain_length. Every displacement is accepted, so the chains move the particles much
+    further than rejection-limited trial moves in dense systems.
+
+    The chains are advanced in steps of at most the move size d of the active particle type, so
+    that the image list built for d remains valid. The first collision in a step is found by
+    querying the AABB tree with the swept bounding box of the active particle and computing the
+    collision distance with detail::sweep_distance for each candidate. The active particle is
+    wrapped back into the box after every step.
+
+    Rotation moves are Metropolis trial moves, selected with translation_move_probability as in
+    IntegratorHPMCMono.
+
+    With domain decomposition, chains start only at active particles and end at the boundary of
+    the active region or when they collide with a ghost particle.
+
+    Patch energies, external fields, and implicit depletants are not supported.
+
+    \ingroup hpmc_integrators
+*/
+template<class Shape> class IntegratorHPMCMonoEventChain : public IntegratorHPMCMono<Shape>
+    {
+    public:
+    //! Construct the integrator
+    IntegratorHPMCMonoEventChain(std::shared_ptr<SystemDefinition> sysdef)
+        : IntegratorHPMCMono<Shape>(sysdef), m_chain_length(1.0)
+        {
+        }
+
+    //! Destructor
+    virtual ~IntegratorHPMCMonoEventChain() { }
+
+    //! Set the total displacement of each event chain
+    void setChainLength(Scalar chain_length)
+        {
+        if (chain_length < Scalar(0.0))
+            throw std::domain_error("chain_length must be non-negative.");
+        m_chain_length = chain_length;
+        }
+
+    //! Get the total displacement of each event chain
+    Scalar getChainLength()
+        {
+        return m_chain_length;
+        }
+
+    //! Take one timestep forward
+    virtual void update(uint64_t timestep);
+
+    protected:
+    Scalar m_chain_length; //!< Total displacement of each event chain
+
+#ifdef ENABLE_MPI
+    //! Distance a particle moves along dir before it leaves the active region
+    Scalar getActiveDistance(const vec3<Scalar>& pos,
+                             const vec3<Scalar>& dir,
+                             const BoxDim& box,
+                             Scalar3 ghost_fraction);
+#endif
+    };
+
+/*! \param timestep Current time step
+ */
+template<class Shape> void IntegratorHPMCMonoEventChain<Shape>::update(uint64_t timestep)
+    {
+    Integrator::update(timestep);
+    this->m_exec_conf->msg->notice(10) << "HPMCMonoEventChain update: " << timestep << std::endl;
+    IntegratorHPMC::update(timestep);
+
+    if (this->m_patch && !this->m_patch_log)
+        throw std::runtime_error("Event chains do not support patch energies.");
+    if (this->m_external)
+        throw std::runtime_error("Event chains do not support external fields.");
+    for (unsigned int i = 0; i < this->m_depletant_idx.getNumElements(); ++i)
+        {
+        if (this->m_fugacity[i] != 0.0)
+            throw std::runtime_error("Event chains do not support implicit depletants.");
+        }
+
+    // get needed vars
+    ArrayHandle<hpmc_counters_t> h_counters(this->m_count_total,
+                                            access_location::host,
+                                            access_mode::readwrite);
+    hpmc_counters_t& counters = h_counters.data[0];
+
+    const BoxDim& box = this->m_pdata->getBox();
+    unsigned int ndim = this->m_sysdef->getNDimensions();
+    const unsigned int N = this->m_pdata->getN();
+
+#ifdef ENABLE_MPI
+    // compute the width of the active region
+    Scalar3 npd = box.getNearestPlaneDistance();
+    Scalar3 ghost_fraction = this->m_nominal_width / npd;
+#endif
+
+    // Shuffle the order of particles for this step
+    this->m_update_order.resize(N);
+    this->m_update_order.shuffle(timestep, this->m_sysdef->getSeed(), this->m_exec_conf->getRank());
+
+    // update the AABB Tree
+    this->buildAABBTree();
+    // limit m_d entries so that particles cannot possibly wander more than one box image in one
+    // step of a chain
+    this->limitMoveDistances();
+    // update the image list
+    this->updateImageList();
+
+    if (this->m_prof)
+        this->m_prof->push(this->m_exec_conf, "HPMC event chain");
+
+    uint16_t seed = this->m_sysdef->getSeed();
+    const unsigned int n_images = (unsigned int)this->m_image_list.size();
+    const unsigned int no_particle = 0xffffffff;
+
+    // access interaction matrix
+    ArrayHandle<unsigned int> h_overlaps(this->m_overlaps,
+                                         access_location::host,
+                                         access_mode::read);
+
+    for (unsigned int i_nselect = 0; i_nselect < this->m_nselect; i_nselect++)
+        {
+        // access particle data and move sizes
+        ArrayHandle<Scalar4> h_postype(this->m_pdata->getPositions(),
+                                       access_location::host,
+                                       access_mode::readwrite);
+        ArrayHandle<Scalar4> h_orientation(this->m_pdata->getOrientationArray(),
+                                           access_location::host,
+                                           access_mode::readwrite);
+        ArrayHandle<int3> h_image(this->m_pdata->getImages(),
+                                  access_location::host,
+                                  access_mode::readwrite);
+        ArrayHandle<Scalar> h_d(this->m_d, access_location::host, access_mode::read);
+        ArrayHandle<Scalar> h_a(this->m_a, access_location::host, access_mode::read);
+
+        // test whether particle i with the given position and shape overlaps any other particle
+        auto overlaps_any = [&](unsigned int i, const vec3<Scalar>& pos_i, const Shape& shape_i)
+        {
+            unsigned int typ_i = __scalar_as_int(h_postype.data[i].w);
+            Scalar R_i = shape_i.getCircumsphereDiameter() / Scalar(2.0);
+            detail::AABB aabb_i_local = detail::AABB(vec3<Scalar>(0, 0, 0), R_i);
+
+            for (unsigned int cur_image = 0; cur_image < n_images; cur_image++)
+                {
+                vec3<Scalar> pos_i_image = pos_i + this->m_image_list[cur_image];
+                detail::AABB aabb = aabb_i_local;
+                aabb.translate(pos_i_image);
+
+                // stackless search
+                for (unsigned int cur_node_idx = 0; cur_node_idx < this->m_aabb_tree.getNumNodes();
+                     cur_node_idx++)
+                    {
+                    if (detail::overlap(this->m_aabb_tree.getNodeAABB(cur_node_idx), aabb))
+                        {
+                        if (this->m_aabb_tree.isNodeLeaf(cur_node_idx))
+                            {
+                            for (unsigned int cur_p = 0;
+                                 cur_p < this->m_aabb_tree.getNodeNumParticles(cur_node_idx);
+                                 cur_p++)
+                                {
+                                unsigned int j
+                                    = this->m_aabb_tree.getNodeParticle(cur_node_idx, cur_p);
+
+                                Scalar4 postype_j;
+                                Scalar4 orientation_j;
+                                if (j != i)
+                                    {
+                                    postype_j = h_postype.data[j];
+                                    orientation_j = h_orientation.data[j];
+                                    }
+                                else if (cur_image == 0)
+                                    {
+                                    continue;
+                                    }
+                                else
+                                    {
+                                    // particle i in an outside image
+                                    postype_j = vec_to_scalar4(pos_i, h_postype.data[i].w);
+                                    orientation_j = quat_to_scalar4(shape_i.orientation);
+                                    }
+
+                                vec3<Scalar> r_ij = vec3<Scalar>(postype_j) - pos_i_image;
+                                unsigned int typ_j = __scalar_as_int(postype_j.w);
+                                Shape shape_j(quat<Scalar>(orientation_j), this->m_params[typ_j]);
+
+                                counters.overlap_checks++;
+                                if (h_overlaps.data[this->m_overlap_idx(typ_i, typ_j)]
+                                    && check_circumsphere_overlap(r_ij, shape_i, shape_j)
+                                    && test_overlap(r_ij,
+                                                    shape_i,
+                                                    shape_j,
+                                                    counters.overlap_err_count))
+                                    return true;
+                                }
+                            }
+                        }
+                    else
+                        {
+                        // skip ahead
+                        cur_node_idx += this->m_aabb_tree.getNodeSkip(cur_node_idx);
+                        }
+                    }
+                }
+            return false;
+        };
+
+        // advance the event chain that starts at particle k
+        auto event_chain = [&](unsigned int k, const vec3<Scalar>& dir)
+        {
+            unsigned int i = k;
+            unsigned int prev = no_particle;
+            Scalar remaining = m_chain_length;
+
+            while (remaining > Scalar(0.0))
+                {
+                Scalar4 postype_i = h_postype.data[i];
+                vec3<Scalar> pos_i(postype_i);
+                unsigned int typ_i = __scalar_as_int(postype_i.w);
+                Shape shape_i(quat<Scalar>(h_orientation.data[i]), this->m_params[typ_i]);
+
+                Scalar step = detail::min(remaining, h_d.data[typ_i]);
+                if (step == Scalar(0.0))
+                    break;
+
+                // the chain ends after this step when it reaches the end of the active region
+                bool last_step = false;
+#ifdef ENABLE_MPI
+                if (this->m_comm)
+                    {
+                    Scalar active_distance = getActiveDistance(pos_i, dir, box, ghost_fraction);
+                    if (active_distance <= step)
+                        {
+                        step = active_distance;
+                        last_step = true;
+                        }
+                    }
+#endif
+
+                // bounding box of the circumsphere swept over the step
+                Scalar R_i = shape_i.getCircumsphereDiameter() / Scalar(2.0);
+                detail::AABB aabb_sweep_local
+                    = detail::merge(detail::AABB(vec3<Scalar>(0, 0, 0), R_i),
+                                    detail::AABB(step * dir, R_i));
+
+                OverlapReal l_min = OverlapReal(step);
+                unsigned int j_min = no_particle;
+
+                for (unsigned int cur_image = 0; cur_image < n_images; cur_image++)
+                    {
+                    vec3<Scalar> pos_i_image = pos_i + this->m_image_list[cur_image];
+                    detail::AABB aabb = aabb_sweep_local;
+                    aabb.translate(pos_i_image);
+
+                    // stackless search
+                    for (unsigned int cur_node_idx = 0;
+                         cur_node_idx < this->m_aabb_tree.getNumNodes();
+                         cur_node_idx++)
+                        {
+                        if (detail::overlap(this->m_aabb_tree.getNodeAABB(cur_node_idx), aabb))
+                            {
+                            if (this->m_aabb_tree.isNodeLeaf(cur_node_idx))
+                                {
+                                for (unsigned int cur_p = 0;
+                                     cur_p < this->m_aabb_tree.getNodeNumParticles(cur_node_idx);
+                                     cur_p++)
+                                    {
+                                    unsigned int j
+                                        = this->m_aabb_tree.getNodeParticle(cur_node_idx, cur_p);
+
+                                    // images of i move with it and never collide. The previous
+                                    // particle in the chain is behind i and cannot collide with
+                                    // convex shapes either (barring images in very small boxes).
+                                    if (j == i || j == prev)
+                                        continue;
+
+                                    Scalar4 postype_j = h_postype.data[j];
+                                    unsigned int typ_j = __scalar_as_int(postype_j.w);
+                                    if (!h_overlaps.data[this->m_overlap_idx(typ_i, typ_j)])
+                                        continue;
+
+                                    vec3<Scalar> r_ij = vec3<Scalar>(postype_j) - pos_i_image;
+                                    Shape shape_j(quat<Scalar>(h_orientation.data[j]),
+                                                  this->m_params[typ_j]);
+
+                                    counters.overlap_checks++;
+                                    OverlapReal l
+                                        = detail::sweep_distance(r_ij,
+                                                                 dir,
+                                                                 shape_i,
+                                                                 shape_j,
+                                                                 l_min,
+                                                                 counters.overlap_err_count);
+                                    if (l < l_min)
+                                        {
+                                        l_min = l;
+                                        j_min = j;
+                                        }
+                                    }
+                                }
+                            }
+                        else
+                            {
+                            // skip ahead
+                            cur_node_idx += this->m_aabb_tree.getNodeSkip(cur_node_idx);
+                            }
+                        }
+                    }
+
+                // move i up to the collision, or by the full step
+                Scalar l = detail::min(Scalar(l_min), step);
+                pos_i += l * dir;
+                remaining -= l;
+
+                h_postype.data[i] = vec_to_scalar4(pos_i, postype_i.w);
+                box.wrap(h_postype.data[i], h_image.data[i]);
+                this->m_aabb_tree.update(i, shape_i.getAABB(vec3<Scalar>(h_postype.data[i])));
+
+                if (!shape_i.ignoreStatistics())
+                    counters.translate_accept_count++;
+
+                if (j_min == no_particle)
+                    {
+                    if (last_step)
+                        break;
+                    continue;
+                    }
+
+                // ghost particles are not moved on this rank
+                if (j_min >= N)
+                    break;
+
+                // lift to the collider
+                prev = i;
+                i = j_min;
+                }
+        };
+
+        // loop through N particles in a shuffled order
+        for (unsigned int cur_particle = 0; cur_particle < N; cur_particle++)
+            {
+            unsigned int i = this->m_update_order[cur_particle];
+            Scalar4 postype_i = h_postype.data[i];
+            vec3<Scalar> pos_i = vec3<Scalar>(postype_i);
+
+#ifdef ENABLE_MPI
+            if (this->m_comm)
+                {
+                // only start chains at active particles
+                if (!isActive(vec_to_scalar3(pos_i), box, ghost_fraction))
+                    continue;
+                }
+#endif
+
+            hoomd::RandomGenerator rng_i(
+                hoomd::Seed(hoomd::RNGIdentifier::HPMCMonoTrialMove, timestep, seed),
+                hoomd::Counter(i, this->m_exec_conf->getRank(), i_nselect));
+            unsigned int typ_i = __scalar_as_int(postype_i.w);
+            Shape shape_i(quat<Scalar>(h_orientation.data[i]), this->m_params[typ_i]);
+            unsigned int move_type_select = hoomd::UniformIntDistribution(0xffff)(rng_i);
+            bool move_type_translate = !shape_i.hasOrientation()
+                                       || (move_type_select < this->m_translation_move_probability);
+
+            if (move_type_translate)
+                {
+                // pick a random direction for the chain
+                vec3<Scalar> dir;
+                if (ndim == 2)
+                    {
+                    Scalar angle = hoomd::UniformDistribution<Scalar>(-M_PI, M_PI)(rng_i);
+                    dir = vec3<Scalar>(fast::cos(angle), fast::sin(angle), Scalar(0.0));
+                    }
+                else
+                    {
+                    hoomd::SpherePointGenerator<Scalar>()(rng_i, dir);
+                    }
+
+                event_chain(i, dir);
+                }
+            else
+                {
+                if (h_a.data[typ_i] == 0.0)
+                    {
+                    if (!shape_i.ignoreStatistics())
+                        counters.rotate_accept_count++;
+                    continue;
+                    }
+
+                if (ndim == 2)
+                    move_rotate<2>(shape_i.orientation, rng_i, h_a.data[typ_i]);
+                else
+                    move_rotate<3>(shape_i.orientation, rng_i, h_a.data[typ_i]);
+
+                if (!overlaps_any(i, pos_i, shape_i))
+                    {
+                    h_orientation.data[i] = quat_to_scalar4(shape_i.orientation);
+                    this->m_aabb_tree.update(i, shape_i.getAABB(pos_i));
+                    if (!shape_i.ignoreStatistics())
+                        counters.rotate_accept_count++;
+                    }
+                else if (!shape_i.ignoreStatistics())
+                    {
+                    counters.rotate_reject_count++;
+                    }
+                }
+            }
+        } // end loop over nselect
+
+    // perform the grid shift
+#ifdef ENABLE_MPI
+    if (this->m_comm)
+        {
+        ArrayHandle<Scalar4> h_postype(this->m_pdata->getPositions(),
+                                       access_location::host,
+                                       access_mode::readwrite);
+        ArrayHandle<int3> h_image(this->m_pdata->getImages(),
+                                  access_location::host,
+                                  access_mode::readwrite);
+
+        // precalculate the grid shift
+        hoomd::RandomGenerator rng(
+            hoomd::Seed(hoomd::RNGIdentifier::HPMCMonoShift, timestep, this->m_sysdef->getSeed()),
+            hoomd::Counter());
+        Scalar3 shift = make_scalar3(0, 0, 0);
+        hoomd::UniformDistribution<Scalar> uniform(-this->m_nominal_width / Scalar(2.0),
+                                                   this->m_nominal_width / Scalar(2.0));
+        shift.x = uniform(rng);
+        shift.y = uniform(rng);
+        if (ndim == 3)
+            {
+            shift.z = uniform(rng);
+            }
+        for (unsigned int i = 0; i < N; i++)
+            {
+            Scalar4 postype_i = h_postype.data[i];
+            vec3<Scalar> r_i = vec3<Scalar>(postype_i);
+            r_i += vec3<Scalar>(shift);
+            h_postype.data[i] = vec_to_scalar4(r_i, postype_i.w);
+            box.wrap(h_postype.data[i], h_image.data[i]);
+            }
+        this->m_pdata->translateOrigin(shift);
+        }
+#endif
+
+    if (this->m_prof)
+        this->m_prof->pop(this->m_exec_conf);
+
+    // migrate and exchange particles
+    this->communicate(true);
+
+    // all particle have been moved, the aabb tree is now invalid
+    this->m_aabb_tree_invalid = true;
+
+    // record the elapsed time for the MPS value
+    this->m_mps_time = this->m_clock.getTime();
+    }
+
+#ifdef ENABLE_MPI
+/*! \param pos Position of the particle
+    \param dir Unit vector along which the particle moves
+    \param box Local simulation box
+    \param ghost_fraction Fraction of the box in the inactive zone
+    \returns The distance to the boundary of the active region along \a dir, slightly reduced so
+             that the particle remains active (see isActive())
+*/
+template<class Shape>
+Scalar IntegratorHPMCMonoEventChain<Shape>::getActiveDistance(const vec3<Scalar>& pos,
+                                                              const vec3<Scalar>& dir,
+                                                              const BoxDim& box,
+                                                              Scalar3 ghost_fraction)
+    {
+    Scalar3 f = box.makeFraction(vec_to_scalar3(pos));
+    Scalar3 df = box.makeFraction(vec_to_scalar3(pos + dir)) - f;
+    uchar3 periodic = box.getPeriodic();
+
+    Scalar distance = std::numeric_limits<Scalar>::max();
+    if (!periodic.x && df.x != Scalar(0.0))
+        distance = detail::min(distance,
+                               ((df.x > 0 ? Scalar(1.0) - ghost_fraction.x : Scalar(0.0)) - f.x)
+                                   / df.x);
+    if (!periodic.y && df.y != Scalar(0.0))
+        distance = detail::min(distance,
+                               ((df.y > 0 ? Scalar(1.0) - ghost_fraction.y : Scalar(0.0)) - f.y)
+                                   / df.y);
+    if (!periodic.z && df.z != Scalar(0.0))
+        distance = detail::min(distance,
+                               ((df.z > 0 ? Scalar(1.0) - ghost_fraction.z : Scalar(0.0)) - f.z)
+                                   / df.z);
+
+    // stop short of the boundary, which is itself outside of the active region
+    return detail::max(Scalar(0.0), distance * Scalar(1.0 - 1e-6));
+    }
+#endif
+
+//! Export the IntegratorHPMCMonoEventChain class to python
+/*! \param name Name of the class in the exported python module
+    \tparam Shape An instantiation of IntegratorHPMCMonoEventChain<Shape> will be exported
+*/
+template<class Shape>
+void export_IntegratorHPMCMonoEventChain(pybind11::module& m, const std::string& name)
+    {
+    pybind11::class_<IntegratorHPMCMonoEventChain<Shape>,
+                     IntegratorHPMCMono<Shape>,
+                     std::shared_ptr<IntegratorHPMCMonoEventChain<Shape>>>(m, name.c_str())
+        .def(pybind11::init<std::shared_ptr<SystemDefinition>>())
+        .def_property("chain_length",
+                      &IntegratorHPMCMonoEventChain<Shape>::getChainLength,
+                      &IntegratorHPMCMonoEventChain<Shape>::setChainLength);
+    }
+
+    } // end namespace hpmc
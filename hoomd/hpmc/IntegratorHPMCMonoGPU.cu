@@ -4,6 +4,8 @@
 #include "IntegratorHPMCMonoGPUTypes.cuh"
 #include "hoomd/GPUPartition.cuh"
 
+#include <hipcub/hipcub.hpp>
+
 namespace hpmc
     {
 namespace gpu
@@ -21,28 +23,37 @@ namespace kernel
     \param cli Cell list indexer
     \param cadji Cell adjacency indexer
     \param ngpu Number of active devices
+    \param nwork Number of cells to process
+    \param work_offset Index of the first cell to process
 
     gpu_hpmc_excell_kernel executes one thread per cell. It gathers the particle indices from all
    neighboring cells into the output expanded cell.
+
+    \tparam Indexer Index2D for a fixed capacity per expanded cell, or ExcellIndexer for the
+   compacted list
 */
+template<class Indexer>
 __global__ void hpmc_excell(unsigned int* d_excell_idx,
                             unsigned int* d_excell_size,
-                            const Index2D excli,
+                            const Indexer excli,
                             const unsigned int* d_cell_idx,
                             const unsigned int* d_cell_size,
                             const unsigned int* d_cell_adj,
                             const Index3D ci,
                             const Index2D cli,
                             const Index2D cadji,
-                            const unsigned int ngpu)
+                            const unsigned int ngpu,
+                            const unsigned int nwork,
+                            const unsigned int work_offset)
     {
     // compute the output cell
-    unsigned int my_cell = 0;
-    my_cell = blockDim.x * blockIdx.x + threadIdx.x;
+    unsigned int work_idx = blockDim.x * blockIdx.x + threadIdx.x;
 
-    if (my_cell >= ci.getNumElements())
+    if (work_idx >= nwork)
         return;
 
+    unsigned int my_cell = work_idx + work_offset;
+
     unsigned int my_cell_size = 0;
 
     // loop over neighboring cells and build up the expanded cell list
@@ -69,6 +80,40 @@ __global__ void hpmc_excell(unsigned int* d_excell_idx,
     d_excell_size[my_cell] = my_cell_size;
     }
 
+//! Kernel to count the particles in the expanded cells
+/*! \param d_excell_size Output array to list the number of particles in each expanded cell
+    \param d_cell_size Number of particles in each cell
+    \param d_cell_adj Cell adjacency list
+    \param ci Cell indexer
+    \param cadji Cell adjacency indexer
+    \param ngpu Number of active devices
+
+    hpmc_excell_size executes one thread per cell and sums the sizes of the neighboring cells.
+*/
+__global__ void hpmc_excell_size(unsigned int* d_excell_size,
+                                 const unsigned int* d_cell_size,
+                                 const unsigned int* d_cell_adj,
+                                 const Index3D ci,
+                                 const Index2D cadji,
+                                 const unsigned int ngpu)
+    {
+    unsigned int my_cell = blockDim.x * blockIdx.x + threadIdx.x;
+
+    if (my_cell >= ci.getNumElements())
+        return;
+
+    unsigned int my_cell_size = 0;
+    for (unsigned int offset = 0; offset < cadji.getW(); offset++)
+        {
+        unsigned int neigh_cell = d_cell_adj[cadji(offset, my_cell)];
+
+        for (unsigned int igpu = 0; igpu < ngpu; ++igpu)
+            my_cell_size += d_cell_size[neigh_cell + igpu * ci.getNumElements()];
+        }
+
+    d_excell_size[my_cell] = my_cell_size;
+    }
+
 //! Kernel for grid shift
 /*! \param d_postype postype of each particle
     \param d_image Image flags for each particle
@@ -144,8 +189,149 @@ __global__ void hpmc_check_convergence(const unsigned int* d_trial_move_type,
     // clear input
     d_reject_in[i] = reject_out_of_cell;
     }
+
+//! Kernel to scale particle positions to a new box
+/*! \param d_postype postype of each particle
+    \param N number of particles
+    \param old_box Box the particles are currently in
+    \param new_box Box to scale the particles into
+
+    Positions are scaled so that their fractional coordinates in \a new_box are the same as in
+    \a old_box.
+
+    \ingroup hpmc_kernels
+*/
+__global__ void hpmc_scale_positions(Scalar4* d_postype,
+                                     const unsigned int N,
+                                     const BoxDim old_box,
+                                     const BoxDim new_box)
+    {
+    unsigned int my_pidx = blockIdx.x * blockDim.x + threadIdx.x;
+
+    if (my_pidx >= N)
+        return;
+
+    Scalar4 postype = d_postype[my_pidx];
+    Scalar3 f = old_box.makeFraction(make_scalar3(postype.x, postype.y, postype.z));
+    Scalar3 pos = new_box.makeCoordinates(f);
+
+    d_postype[my_pidx] = make_scalar4(pos.x, pos.y, pos.z, postype.w);
+    }
+
+//! Kernel to flag particles that overlap in the narrow phase
+__global__ void hpmc_flag_overlaps(const unsigned int* d_reject_out,
+                                   unsigned int* d_condition,
+                                   const unsigned int nwork,
+                                   const unsigned work_offset)
+    {
+    unsigned int work_idx = blockIdx.x * blockDim.x + threadIdx.x;
+    if (work_idx >= nwork)
+        return;
+    unsigned int i = work_idx + work_offset;
+
+    // a trivial race condition upon write
+    if (d_reject_out[i])
+        *d_condition = 1;
+    }
+
+//! Kernel to scale the move sizes toward a target acceptance ratio
+/*! \param d_d Translation move sizes by type
+    \param d_a Rotation move sizes by type
+    \param d_d_max Largest translation move sizes by type
+    \param d_a_max Largest rotation move sizes by type
+    \param d_counters Current acceptance counters
+    \param d_count_tune_start Acceptance counters at the last update
+    \param ntypes Number of particle types
+    \param target Target acceptance ratio
+    \param gain Damping of the update
+
+    One thread per type.
+*/
+__global__ void hpmc_update_move_sizes(Scalar* d_d,
+                                       Scalar* d_a,
+                                       const Scalar* d_d_max,
+                                       const Scalar* d_a_max,
+                                       const hpmc_counters_t* d_counters,
+                                       const hpmc_counters_t* d_count_tune_start,
+                                       const unsigned int ntypes,
+                                       const Scalar target,
+                                       const Scalar gain)
+    {
+    unsigned int type = blockIdx.x * blockDim.x + threadIdx.x;
+    if (type >= ntypes)
+        return;
+
+    hpmc_counters_t delta = d_counters[0] - d_count_tune_start[0];
+    d_d[type] = scaleMoveSize(d_d[type],
+                              delta.translate_accept_count,
+                              delta.translate_reject_count,
+                              target,
+                              gain,
+                              d_d_max[type]);
+    d_a[type] = scaleMoveSize(d_a[type],
+                              delta.rotate_accept_count,
+                              delta.rotate_reject_count,
+                              target,
+                              gain,
+                              d_a_max[type]);
+    }
     } // end namespace kernel
 
+//! Launch kernel::hpmc_excell() with the given expanded cell indexer
+template<class Indexer>
+static void hpmc_excell_launch(unsigned int* d_excell_idx,
+                               unsigned int* d_excell_size,
+                               const Indexer& excli,
+                               const unsigned int* d_cell_idx,
+                               const unsigned int* d_cell_size,
+                               const unsigned int* d_cell_adj,
+                               const Index3D& ci,
+                               const Index2D& cli,
+                               const Index2D& cadji,
+                               const unsigned int ngpu,
+                               const unsigned int nwork,
+                               const unsigned int work_offset,
+                               const unsigned int block_size)
+    {
+    assert(d_excell_idx);
+    assert(d_excell_size);
+    assert(d_cell_idx);
+    assert(d_cell_size);
+    assert(d_cell_adj);
+
+    // determine the maximum block size and clamp the input block size down
+    static int max_block_size = -1;
+    if (max_block_size == -1)
+        {
+        hipFuncAttributes attr;
+        hipFuncGetAttributes(&attr, reinterpret_cast<const void*>(kernel::hpmc_excell<Indexer>));
+        max_block_size = attr.maxThreadsPerBlock;
+        }
+
+    // setup the grid to run the kernel
+    unsigned int run_block_size = min(block_size, (unsigned int)max_block_size);
+    dim3 threads(run_block_size, 1, 1);
+    dim3 grid(nwork / run_block_size + 1, 1, 1);
+
+    hipLaunchKernelGGL(kernel::hpmc_excell<Indexer>,
+                       dim3(grid),
+                       dim3(threads),
+                       0,
+                       0,
+                       d_excell_idx,
+                       d_excell_size,
+                       excli,
+                       d_cell_idx,
+                       d_cell_size,
+                       d_cell_adj,
+                       ci,
+                       cli,
+                       cadji,
+                       ngpu,
+                       nwork,
+                       work_offset);
+    }
+
 //! Driver for kernel::hpmc_excell()
 void hpmc_excell(unsigned int* d_excell_idx,
                  unsigned int* d_excell_size,
@@ -159,9 +345,88 @@ void hpmc_excell(unsigned int* d_excell_idx,
                  const unsigned int ngpu,
                  const unsigned int block_size)
     {
-    assert(d_excell_idx);
+    hpmc_excell_launch(d_excell_idx,
+                       d_excell_size,
+                       excli,
+                       d_cell_idx,
+                       d_cell_size,
+                       d_cell_adj,
+                       ci,
+                       cli,
+                       cadji,
+                       ngpu,
+                       ci.getNumElements(),
+                       0,
+                       block_size);
+    }
+
+//! Driver for kernel::hpmc_excell() with the compacted expanded cell list
+/*! Every active device builds the expanded cells in its range of \a cell_partition.
+ */
+void hpmc_excell(unsigned int* d_excell_idx,
+                 unsigned int* d_excell_size,
+                 const ExcellIndexer& excli,
+                 const unsigned int* d_cell_idx,
+                 const unsigned int* d_cell_size,
+                 const unsigned int* d_cell_adj,
+                 const Index3D& ci,
+                 const Index2D& cli,
+                 const Index2D& cadji,
+                 const unsigned int ngpu,
+                 const GPUPartition& cell_partition,
+                 const unsigned int block_size)
+    {
+    for (int idev = cell_partition.getNumActiveGPUs() - 1; idev >= 0; --idev)
+        {
+        auto range = cell_partition.getRangeAndSetGPU(idev);
+
+        unsigned int nwork = range.second - range.first;
+        if (nwork == 0)
+            continue;
+
+        hpmc_excell_launch(d_excell_idx,
+                           d_excell_size,
+                           excli,
+                           d_cell_idx,
+                           d_cell_size,
+                           d_cell_adj,
+                           ci,
+                           cli,
+                           cadji,
+                           ngpu,
+                           nwork,
+                           range.first,
+                           block_size);
+        }
+    }
+
+/*! \param d_excell_size Output array to list the number of particles in each expanded cell
+    \param d_excell_offset Output offset of each expanded cell in the compacted list (Ncells + 1)
+    \param n_excell Output total number of entries in the compacted list
+    \param d_cell_size Number of particles in each cell
+    \param d_cell_adj Cell adjacency list
+    \param ci Cell indexer
+    \param cadji Cell adjacency indexer
+    \param ngpu Number of active devices
+    \param block_size Block size to execute
+    \param alloc Caching allocator for the temporary storage of the prefix sum
+
+    The offsets are the exclusive prefix sum of the expanded cell sizes. The last element of
+    \a d_excell_offset holds the total, which is copied back to the host to size the list.
+*/
+void hpmc_excell_offsets(unsigned int* d_excell_size,
+                         unsigned int* d_excell_offset,
+                         unsigned int& n_excell,
+                         const unsigned int* d_cell_size,
+                         const unsigned int* d_cell_adj,
+                         const Index3D& ci,
+                         const Index2D& cadji,
+                         const unsigned int ngpu,
+                         const unsigned int block_size,
+                         CachedAllocator& alloc)
+    {
     assert(d_excell_size);
-    assert(d_cell_idx);
+    assert(d_excell_offset);
     assert(d_cell_size);
     assert(d_cell_adj);
 
@@ -170,30 +435,46 @@ void hpmc_excell(unsigned int* d_excell_idx,
     if (max_block_size == -1)
         {
         hipFuncAttributes attr;
-        hipFuncGetAttributes(&attr, reinterpret_cast<const void*>(kernel::hpmc_excell));
+        hipFuncGetAttributes(&attr, reinterpret_cast<const void*>(kernel::hpmc_excell_size));
         max_block_size = attr.maxThreadsPerBlock;
         }
 
-    // setup the grid to run the kernel
+    unsigned int n_cells = ci.getNumElements();
     unsigned int run_block_size = min(block_size, (unsigned int)max_block_size);
     dim3 threads(run_block_size, 1, 1);
-    dim3 grid(ci.getNumElements() / run_block_size + 1, 1, 1);
+    dim3 grid(n_cells / run_block_size + 1, 1, 1);
 
-    hipLaunchKernelGGL(kernel::hpmc_excell,
+    hipLaunchKernelGGL(kernel::hpmc_excell_size,
                        dim3(grid),
                        dim3(threads),
                        0,
                        0,
-                       d_excell_idx,
                        d_excell_size,
-                       excli,
-                       d_cell_idx,
                        d_cell_size,
                        d_cell_adj,
                        ci,
-                       cli,
                        cadji,
                        ngpu);
+
+    // offset[0] = 0, offset[i+1] = sum of the sizes of cells 0..i
+    hipMemsetAsync(d_excell_offset, 0, sizeof(unsigned int));
+
+    void* d_temp_storage = NULL;
+    size_t temp_storage_bytes = 0;
+    hipcub::DeviceScan::InclusiveSum(d_temp_storage,
+                                     temp_storage_bytes,
+                                     d_excell_size,
+                                     d_excell_offset + 1,
+                                     n_cells);
+    d_temp_storage = alloc.getTemporaryBuffer<char>(temp_storage_bytes);
+    hipcub::DeviceScan::InclusiveSum(d_temp_storage,
+                                     temp_storage_bytes,
+                                     d_excell_size,
+                                     d_excell_offset + 1,
+                                     n_cells);
+    alloc.deallocate((char*)d_temp_storage);
+
+    hipMemcpy(&n_excell, d_excell_offset + n_cells, sizeof(unsigned int), hipMemcpyDeviceToHost);
     }
 
 //! Kernel driver for kernel::hpmc_shift()
@@ -271,5 +552,105 @@ void hpmc_check_convergence(const unsigned int* d_trial_move_type,
         }
     }
 
+//! Kernel driver for kernel::hpmc_scale_positions()
+void hpmc_scale_positions(Scalar4* d_postype,
+                          const unsigned int N,
+                          const BoxDim& old_box,
+                          const BoxDim& new_box,
+                          const unsigned int block_size)
+    {
+    assert(d_postype);
+
+    dim3 threads(block_size, 1, 1);
+    dim3 grid(N / block_size + 1, 1, 1);
+
+    hipLaunchKernelGGL(kernel::hpmc_scale_positions,
+                       dim3(grid),
+                       dim3(threads),
+                       0,
+                       0,
+                       d_postype,
+                       N,
+                       old_box,
+                       new_box);
+
+    // after this kernel we return control of cuda managed memory to the host
+    hipDeviceSynchronize();
+    }
+
+//! Kernel driver for kernel::hpmc_flag_overlaps()
+void hpmc_flag_overlaps(const unsigned int* d_reject_out,
+                        unsigned int* d_condition,
+                        const GPUPartition& gpu_partition,
+                        const unsigned int block_size)
+    {
+    // determine the maximum block size and clamp the input block size down
+    static int max_block_size = -1;
+    if (max_block_size == -1)
+        {
+        hipFuncAttributes attr;
+        hipFuncGetAttributes(&attr, reinterpret_cast<const void*>(kernel::hpmc_flag_overlaps));
+        max_block_size = attr.maxThreadsPerBlock;
+        }
+
+    unsigned int run_block_size = min(block_size, (unsigned int)max_block_size);
+
+    dim3 threads(run_block_size, 1, 1);
+
+    for (int idev = gpu_partition.getNumActiveGPUs() - 1; idev >= 0; --idev)
+        {
+        auto range = gpu_partition.getRangeAndSetGPU(idev);
+
+        unsigned int nwork = range.second - range.first;
+        const unsigned int num_blocks = nwork / run_block_size + 1;
+        dim3 grid(num_blocks, 1, 1);
+
+        hipLaunchKernelGGL(kernel::hpmc_flag_overlaps,
+                           grid,
+                           threads,
+                           0,
+                           0,
+                           d_reject_out,
+                           d_condition,
+                           nwork,
+                           range.first);
+        }
+    }
+
+/*! The counters are copied to \a d_count_tune_start after the move sizes are updated, on the
+    same stream and without synchronizing with the host.
+*/
+void hpmc_update_move_sizes(Scalar* d_d,
+                            Scalar* d_a,
+                            const Scalar* d_d_max,
+                            const Scalar* d_a_max,
+                            const hpmc_counters_t* d_counters,
+                            hpmc_counters_t* d_count_tune_start,
+                            const unsigned int ntypes,
+                            const Scalar target,
+                            const Scalar gain)
+    {
+    const unsigned int block_size = 32;
+    hipLaunchKernelGGL(kernel::hpmc_update_move_sizes,
+                       dim3(ntypes / block_size + 1),
+                       dim3(block_size),
+                       0,
+                       0,
+                       d_d,
+                       d_a,
+                       d_d_max,
+                       d_a_max,
+                       d_counters,
+                       d_count_tune_start,
+                       ntypes,
+                       target,
+                       gain);
+
+    hipMemcpyAsync(d_count_tune_start,
+                   d_counters,
+                   sizeof(hpmc_counters_t),
+                   hipMemcpyDeviceToDevice);
+    }
+
     } // end namespace gpu
     } // end namespace hpmc
@@ -51,7 +51,7 @@ __launch_bounds__(max_threads)
                                       const unsigned int* d_trial_move_type,
                                       const unsigned int* d_excell_idx,
                                       const unsigned int* d_excell_size,
-                                      const Index2D excli,
+                                      const ExcellIndexer excli,
                                       hpmc_counters_t* d_counters,
                                       const unsigned int num_types,
                                       const BoxDim box,
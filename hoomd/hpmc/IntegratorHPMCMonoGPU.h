@@ -6,6 +6,7 @@
 #ifdef ENABLE_HIP
 
 #include "hoomd/hpmc/IntegratorHPMCMono.h"
+#include "hoomd/hpmc/IntegratorHPMCMonoGPUCountOverlaps.cuh"
 #include "hoomd/hpmc/IntegratorHPMCMonoGPUDepletantsAuxilliaryTypes.cuh"
 #include "hoomd/hpmc/IntegratorHPMCMonoGPUDepletantsTypes.cuh"
 #include "hoomd/hpmc/IntegratorHPMCMonoGPUTypes.cuh"
@@ -144,7 +145,7 @@ template<class Shape> class IntegratorHPMCMonoGPU : public IntegratorHPMCMono<Sh
     {
     public:
     //! Construct the integrator
-    IntegratorHPMCMonoGPU(std::shared_ptr<SystemDefinition> sysdef, std::shared_ptr<CellList> cl);
+    IntegratorHPMCMonoGPU(std::shared_ptr<SystemDefinition> sysdef);
     //! Destructor
     virtual ~IntegratorHPMCMonoGPU();
 
@@ -174,6 +175,11 @@ template<class Shape> class IntegratorHPMCMonoGPU : public IntegratorHPMCMono<Sh
             this->m_patch->setAutotunerParams(enable, chain_length * period * this->m_nselect);
             }
 
+        if (this->m_external)
+            {
+            this->m_external->setAutotunerParams(enable, period * this->m_nselect);
+            }
+
         m_tuner_depletants->setPeriod(chain_length * period * this->m_nselect);
         m_tuner_depletants->setEnabled(enable);
 
@@ -197,16 +203,33 @@ template<class Shape> class IntegratorHPMCMonoGPU : public IntegratorHPMCMono<Sh
 
         m_tuner_depletants_accept->setPeriod(chain_length * period * this->m_nselect);
         m_tuner_depletants_accept->setEnabled(enable);
+
+        m_tuner_count_overlaps->setPeriod(period);
+        m_tuner_count_overlaps->setEnabled(enable);
         }
 
     //! Take one timestep forward
     virtual void update(uint64_t timestep);
 
+    //! Attempt a box change, scaling the particles and checking overlaps on the GPU
+    virtual bool attemptBoxResize(uint64_t timestep, const BoxDim& new_box);
+
+    //! Count the number of particle overlaps on the GPU, up to a given number
+    virtual unsigned int countOverlapsUpTo(uint64_t timestep, unsigned int max_overlaps);
+
 #ifdef ENABLE_MPI
     void setNtrialCommunicator(std::shared_ptr<MPIConfiguration> mpi_conf)
         {
         m_ntrial_comm = mpi_conf;
         }
+
+    virtual void setCommunicator(std::shared_ptr<Communicator> comm)
+        {
+        IntegratorHPMCMono<Shape>::setCommunicator(comm);
+
+        // set the communicator on the internal cell list
+        m_cl->setCommunicator(comm);
+        }
 #endif
 
 #ifdef ENABLE_MPI
@@ -217,13 +240,15 @@ template<class Shape> class IntegratorHPMCMonoGPU : public IntegratorHPMCMono<Sh
 #endif
 
     protected:
-    std::shared_ptr<CellList> m_cl; //!< Cell list
+    std::shared_ptr<CellList> m_cl; //!< Cell list, shared with compatible computes
+    CellListRequest m_cl_request;   //!< Configuration of the cell list
     uint3 m_last_dim;               //!< Dimensions of the cell list on the last call to update
     unsigned int m_last_nmax;       //!< Last cell list NMax value allocated in excell
 
-    GlobalArray<unsigned int> m_excell_idx;  //!< Particle indices in expanded cells
-    GlobalArray<unsigned int> m_excell_size; //!< Number of particles in each expanded cell
-    Index2D m_excell_list_indexer;           //!< Indexer to access elements of the excell_idx list
+    GlobalArray<unsigned int> m_excell_idx;    //!< Particle indices in expanded cells
+    GlobalArray<unsigned int> m_excell_size;   //!< Number of particles in each expanded cell
+    GlobalArray<unsigned int> m_excell_offset; //!< Offset of each expanded cell in m_excell_idx
+    GPUPartition m_cell_partition;             //!< Slabs of cells assigned to each device
 
     std::unique_ptr<Autotuner> m_tuner_moves;  //!< Autotuner for proposing moves
     std::unique_ptr<Autotuner> m_tuner_narrow; //!< Autotuner for the narrow phase
@@ -242,6 +267,7 @@ template<class Shape> class IntegratorHPMCMonoGPU : public IntegratorHPMCMono<Sh
         m_tuner_depletants_phase2; //!< Tuner for depletants with ntrial, phase 2 kernel
     std::unique_ptr<Autotuner>
         m_tuner_depletants_accept; //!< Tuner for depletants with ntrial, acceptance kernel
+    std::unique_ptr<Autotuner> m_tuner_count_overlaps; //!< Autotuner for counting overlaps
 
     GlobalArray<Scalar4> m_trial_postype;           //!< New positions (and type) of particles
     GlobalArray<Scalar4> m_trial_orientation;       //!< New orientations
@@ -301,25 +327,54 @@ template<class Shape> class IntegratorHPMCMonoGPU : public IntegratorHPMCMono<Sh
 
     //! Update GPU memory hints
     virtual void updateGPUAdvice();
+
+    //! Save the counters at the start of a step on the device
+    virtual void saveStepStartCounters();
+
+    //! Scale the move sizes toward the target acceptance ratio on the device
+    virtual void updateMoveSizes();
+
+    //! Grow the per-particle trial move arrays to the maximum number of particles
+    bool resizeTrialArrays();
+
+    //! Compute the cell list and the expanded cells for the current configuration
+    void buildExcell(uint64_t timestep);
+
+    //! Test if any particles overlap in the current configuration with the GPU narrow phase
+    bool checkOverlapsGPU(uint64_t timestep);
     };
 
 template<class Shape>
-IntegratorHPMCMonoGPU<Shape>::IntegratorHPMCMonoGPU(std::shared_ptr<SystemDefinition> sysdef,
-                                                    std::shared_ptr<CellList> cl)
-    : IntegratorHPMCMono<Shape>(sysdef), m_cl(cl), m_update_order(this->m_exec_conf)
+IntegratorHPMCMonoGPU<Shape>::IntegratorHPMCMonoGPU(std::shared_ptr<SystemDefinition> sysdef)
+    : IntegratorHPMCMono<Shape>(sysdef), m_cell_partition(this->m_exec_conf->getGPUIds()),
+      m_update_order(this->m_exec_conf)
     {
-    this->m_cl->setRadius(1);
-    this->m_cl->setComputeTDB(false);
-    this->m_cl->setFlagType();
-    this->m_cl->setComputeIdx(true);
+    m_cl_request.radius = 1;
+    m_cl_request.compute_tdb = false;
+    m_cl_request.flag = CellListRequest::flag_type;
+    m_cl_request.compute_idx = true;
 
     // with multiple GPUs, request a cell list per device
-    m_cl->setPerDevice(this->m_exec_conf->allConcurrentManagedAccess());
+    m_cl_request.per_device = this->m_exec_conf->allConcurrentManagedAccess();
+
+    // updateCellWidth() requests the cell list again when the width changes
+    m_cl_request.nominal_width = this->m_nominal_width;
+    m_cl_request.max_width = this->m_nominal_width;
+    m_cl = this->m_sysdef->getCellList(m_cl_request);
 
     // set last dim to a bogus value so that it will re-init on the first call
     m_last_dim = make_uint3(0xffffffff, 0xffffffff, 0xffffffff);
     m_last_nmax = 0xffffffff;
 
+#ifdef __HIP_PLATFORM_NVCC__
+    // the advice applies to the whole allocation, including the parameters set later
+    cudaMemAdvise(this->m_params.data(),
+                  this->m_params.size() * sizeof(typename Shape::param_type),
+                  cudaMemAdviseSetReadMostly,
+                  0);
+    CHECK_CUDA_ERROR();
+#endif
+
     hipDeviceProp_t dev_prop = this->m_exec_conf->dev_prop;
     m_tuner_moves.reset(new Autotuner(dev_prop.warpSize,
                                       dev_prop.maxThreadsPerBlock,
@@ -380,6 +435,7 @@ IntegratorHPMCMonoGPU<Shape>::IntegratorHPMCMonoGPU(std::shared_ptr<SystemDefini
         }
 
     m_tuner_narrow.reset(new Autotuner(valid_params, 5, 100000, "hpmc_narrow", this->m_exec_conf));
+    m_tuner_narrow->setDimensions({1000000, 100, 1});
 
     m_tuner_convergence.reset(new Autotuner(dev_prop.warpSize,
                                             dev_prop.maxThreadsPerBlock,
@@ -425,6 +481,25 @@ IntegratorHPMCMonoGPU<Shape>::IntegratorHPMCMonoGPU(std::shared_ptr<SystemDefini
                                                   100000,
                                                   "hpmc_depletants_phase2",
                                                   this->m_exec_conf));
+    m_tuner_depletants->setDimensions({1000000, 10000, 1});
+    m_tuner_depletants_phase1->setDimensions({1000000, 10000, 1});
+    m_tuner_depletants_phase2->setDimensions({1000000, 10000, 1});
+
+    // the overlap count kernel searches the block size and threads per particle,
+    // encoded as block_size*1000000 + group_size
+    std::vector<unsigned int> valid_params_count;
+    for (unsigned int block_size = warp_size;
+         block_size <= (unsigned int)dev_prop.maxThreadsPerBlock;
+         block_size += warp_size)
+        {
+        for (auto t : Autotuner::getTppListPow2(warp_size))
+            {
+            if ((block_size % t) == 0 && block_size / t <= narrow_phase_max_tpp)
+                valid_params_count.push_back(block_size * 1000000 + t);
+            }
+        }
+    m_tuner_count_overlaps.reset(
+        new Autotuner(valid_params_count, 5, 100000, "hpmc_count_overlaps", this->m_exec_conf));
 
     // initialize memory
     GlobalArray<Scalar4>(1, this->m_exec_conf).swap(m_trial_postype);
@@ -494,6 +569,10 @@ IntegratorHPMCMonoGPU<Shape>::IntegratorHPMCMonoGPU(std::shared_ptr<SystemDefini
     m_excell_idx.swap(excell_idx);
     TAG_ALLOCATION(m_excell_idx);
 
+    GlobalArray<unsigned int> excell_offset(0, this->m_exec_conf);
+    m_excell_offset.swap(excell_offset);
+    TAG_ALLOCATION(m_excell_offset);
+
     GlobalArray<unsigned int>(1, this->m_exec_conf).swap(m_n_depletants);
     TAG_ALLOCATION(m_n_depletants);
 
@@ -853,6 +932,12 @@ template<class Shape> void IntegratorHPMCMonoGPU<Shape>::update(uint64_t timeste
         hoomd::Seed(hoomd::RNGIdentifier::HPMCMonoShift, timestep, this->m_sysdef->getSeed()),
         hoomd::Counter());
 
+    // key cached tuning results of the per-particle kernels by the number of particles
+    m_tuner_moves->setProblemSize(this->m_pdata->getN());
+    m_tuner_narrow->setProblemSize(this->m_pdata->getN());
+    m_tuner_update_pdata->setProblemSize(this->m_pdata->getN());
+    m_tuner_convergence->setProblemSize(this->m_pdata->getN());
+
     if (this->m_pdata->getN() > 0)
         {
         // compute the width of the active region
@@ -911,22 +996,7 @@ template<class Shape> void IntegratorHPMCMonoGPU<Shape>::update(uint64_t timeste
 #endif
 
         // resize some arrays
-        bool resized = m_reject.getNumElements() < this->m_pdata->getMaxN();
-
-        bool update_gpu_advice = false;
-
-        if (resized)
-            {
-            m_reject.resize(this->m_pdata->getMaxN());
-            m_reject_out_of_cell.resize(this->m_pdata->getMaxN());
-            m_reject_out.resize(this->m_pdata->getMaxN());
-            m_trial_postype.resize(this->m_pdata->getMaxN());
-            m_trial_orientation.resize(this->m_pdata->getMaxN());
-            m_trial_vel.resize(this->m_pdata->getMaxN());
-            m_trial_move_type.resize(this->m_pdata->getMaxN());
-
-            update_gpu_advice = true;
-            }
+        bool update_gpu_advice = resizeTrialArrays();
 
         if (m_n_depletants.getNumElements()
             < this->m_pdata->getMaxN() * this->m_depletant_idx.getNumElements())
@@ -1079,18 +1149,42 @@ template<class Shape> void IntegratorHPMCMonoGPU<Shape>::update(uint64_t timeste
                                      this->m_exec_conf->getRank());
 
         // expanded cells & neighbor list
-        ArrayHandle<unsigned int> d_excell_idx(m_excell_idx,
-                                               access_location::device,
-                                               access_mode::overwrite);
         ArrayHandle<unsigned int> d_excell_size(m_excell_size,
                                                 access_location::device,
                                                 access_mode::overwrite);
+        ArrayHandle<unsigned int> d_excell_offset(m_excell_offset,
+                                                  access_location::device,
+                                                  access_mode::overwrite);
 
-        // update the expanded cells
+        // count the particles in the expanded cells and lay them out back to back
         this->m_tuner_excell_block_size->begin();
+        unsigned int n_excell = 0;
+        gpu::hpmc_excell_offsets(d_excell_size.data,
+                                 d_excell_offset.data,
+                                 n_excell,
+                                 m_cl->getPerDevice() ? d_cell_size_per_device.data
+                                                      : d_cell_size.data,
+                                 d_cell_adj.data,
+                                 this->m_cl->getCellIndexer(),
+                                 this->m_cl->getCellAdjIndexer(),
+                                 this->m_exec_conf->getNumActiveGPUs(),
+                                 this->m_tuner_excell_block_size->getParam(),
+                                 *this->m_exec_conf->getCachedAllocator());
+        if (this->m_exec_conf->isCUDAErrorCheckingEnabled())
+            CHECK_CUDA_ERROR();
+
+        if (n_excell > m_excell_idx.getNumElements())
+            m_excell_idx.resize(n_excell);
+
+        ArrayHandle<unsigned int> d_excell_idx(m_excell_idx,
+                                               access_location::device,
+                                               access_mode::overwrite);
+        const gpu::ExcellIndexer excli(d_excell_offset.data);
+
+        // update the expanded cells
         gpu::hpmc_excell(d_excell_idx.data,
                          d_excell_size.data,
-                         m_excell_list_indexer,
+                         excli,
                          m_cl->getPerDevice() ? d_cell_idx_per_device.data : d_cell_idx.data,
                          m_cl->getPerDevice() ? d_cell_size_per_device.data : d_cell_size.data,
                          d_cell_adj.data,
@@ -1098,6 +1192,7 @@ template<class Shape> void IntegratorHPMCMonoGPU<Shape>::update(uint64_t timeste
                          this->m_cl->getCellListIndexer(),
                          this->m_cl->getCellAdjIndexer(),
                          this->m_exec_conf->getNumActiveGPUs(),
+                         m_cell_partition,
                          this->m_tuner_excell_block_size->getParam());
         if (this->m_exec_conf->isCUDAErrorCheckingEnabled())
             CHECK_CUDA_ERROR();
@@ -1185,7 +1280,7 @@ template<class Shape> void IntegratorHPMCMonoGPU<Shape>::update(uint64_t timeste
                                       d_update_order_by_ptl.data,
                                       d_excell_idx.data,
                                       d_excell_size.data,
-                                      m_excell_list_indexer,
+                                      excli,
                                       0, // d_reject_in
                                       0, // d_reject_out
                                       this->m_exec_conf->dev_prop,
@@ -1201,6 +1296,34 @@ template<class Shape> void IntegratorHPMCMonoGPU<Shape>::update(uint64_t timeste
                 if (this->m_exec_conf->isCUDAErrorCheckingEnabled())
                     CHECK_CUDA_ERROR();
                 m_tuner_moves->end();
+
+                if (this->m_external)
+                    {
+                    // the field only depends on the moved particle, reject its moves a priori
+                    ArrayHandle<Scalar> d_charge(this->m_pdata->getCharges(),
+                                                 access_location::device,
+                                                 access_mode::read);
+                    ArrayHandle<Scalar> d_diameter(this->m_pdata->getDiameters(),
+                                                   access_location::device,
+                                                   access_mode::read);
+                    const BoxDim global_box = this->m_pdata->getGlobalBox();
+
+                    ExternalField::gpu_args_t external_args(d_postype.data,
+                                                            d_orientation.data,
+                                                            d_trial_postype.data,
+                                                            d_trial_orientation.data,
+                                                            d_trial_move_type.data,
+                                                            d_charge.data,
+                                                            d_diameter.data,
+                                                            d_reject_out_of_cell.data,
+                                                            global_box,
+                                                            this->m_sysdef->getSeed(),
+                                                            this->m_exec_conf->getRank(),
+                                                            timestep,
+                                                            i,
+                                                            this->m_pdata->getGPUPartition());
+                    this->m_external->computeExternalFieldGPU(external_args, 0);
+                    }
                 }
 
             bool converged = false;
@@ -1411,7 +1534,7 @@ template<class Shape> void IntegratorHPMCMonoGPU<Shape>::update(uint64_t timeste
                                           d_update_order_by_ptl.data,
                                           d_excell_idx.data,
                                           d_excell_size.data,
-                                          m_excell_list_indexer,
+                                          excli,
                                           d_reject.data,
                                           d_reject_out.data,
                                           this->m_exec_conf->dev_prop,
@@ -1918,7 +2041,7 @@ template<class Shape> void IntegratorHPMCMonoGPU<Shape>::update(uint64_t timeste
                                                        box,
                                                        d_excell_idx.data,
                                                        d_excell_size.data,
-                                                       m_excell_list_indexer,
+                                                       excli,
                                                        this->m_patch->getRCut(),
                                                        d_additive_cutoff.data,
                                                        d_update_order_by_ptl.data,
@@ -2111,10 +2234,556 @@ template<class Shape> void IntegratorHPMCMonoGPU<Shape>::update(uint64_t timeste
     // all particle have been moved, the aabb tree is now invalid
     this->m_aabb_tree_invalid = true;
 
-    // set current MPS value
-    hpmc_counters_t run_counters = this->getCounters(1);
-    double cur_time = double(this->m_clock.getTime()) / Scalar(1e9);
-    this->m_mps = double(run_counters.getNMoves()) / cur_time;
+    // computes that share the cell list must not reuse it at this time step
+    m_cl->notifyParticlesMoved();
+
+    // record the elapsed time for the MPS value, the counters stay on the device until requested
+    this->m_mps_time = this->m_clock.getTime();
+    }
+
+template<class Shape> void IntegratorHPMCMonoGPU<Shape>::saveStepStartCounters()
+    {
+    ArrayHandle<hpmc_counters_t> d_counters(this->m_count_total,
+                                            access_location::device,
+                                            access_mode::read);
+    ArrayHandle<hpmc_counters_t> d_count_step_start(this->m_count_step_start,
+                                                    access_location::device,
+                                                    access_mode::overwrite);
+    hipMemcpyAsync(d_count_step_start.data,
+                   d_counters.data,
+                   sizeof(hpmc_counters_t),
+                   hipMemcpyDeviceToDevice);
+    if (this->m_exec_conf->isCUDAErrorCheckingEnabled())
+        CHECK_CUDA_ERROR();
+    }
+
+template<class Shape> void IntegratorHPMCMonoGPU<Shape>::updateMoveSizes()
+    {
+#ifdef ENABLE_MPI
+    // the counters of all ranks are needed to set the same move sizes everywhere
+    if (this->m_comm)
+        {
+        IntegratorHPMC::updateMoveSizes();
+        return;
+        }
+#endif
+
+    ArrayHandle<Scalar> d_d(this->m_d, access_location::device, access_mode::readwrite);
+    ArrayHandle<Scalar> d_a(this->m_a, access_location::device, access_mode::readwrite);
+    ArrayHandle<Scalar> d_d_max(this->m_d_max, access_location::device, access_mode::read);
+    ArrayHandle<Scalar> d_a_max(this->m_a_max, access_location::device, access_mode::read);
+    ArrayHandle<hpmc_counters_t> d_counters(this->m_count_total,
+                                            access_location::device,
+                                            access_mode::read);
+    ArrayHandle<hpmc_counters_t> d_count_tune_start(this->m_count_tune_start,
+                                                    access_location::device,
+                                                    access_mode::readwrite);
+    gpu::hpmc_update_move_sizes(d_d.data,
+                                d_a.data,
+                                d_d_max.data,
+                                d_a_max.data,
+                                d_counters.data,
+                                d_count_tune_start.data,
+                                this->m_pdata->getNTypes(),
+                                this->m_move_size_target,
+                                this->m_move_size_gain);
+    if (this->m_exec_conf->isCUDAErrorCheckingEnabled())
+        CHECK_CUDA_ERROR();
+    }
+
+template<class Shape> bool IntegratorHPMCMonoGPU<Shape>::resizeTrialArrays()
+    {
+    if (m_reject.getNumElements() >= this->m_pdata->getMaxN())
+        return false;
+
+    m_reject.resize(this->m_pdata->getMaxN());
+    m_reject_out_of_cell.resize(this->m_pdata->getMaxN());
+    m_reject_out.resize(this->m_pdata->getMaxN());
+    m_trial_postype.resize(this->m_pdata->getMaxN());
+    m_trial_orientation.resize(this->m_pdata->getMaxN());
+    m_trial_vel.resize(this->m_pdata->getMaxN());
+    m_trial_move_type.resize(this->m_pdata->getMaxN());
+    return true;
+    }
+
+/*! The particles are scaled into the new box on the device. Overlaps are checked with the same
+    narrow phase kernel as update(), with the trial configuration set to the current one, so that
+    the box move never copies particle data to the host. Each particle stops searching for
+    neighbors at its first overlap.
+
+    Falls back to the CPU implementation when the new box is too small for the minimum image
+    convention with the current cell width.
+*/
+template<class Shape>
+bool IntegratorHPMCMonoGPU<Shape>::attemptBoxResize(uint64_t timestep, const BoxDim& new_box)
+    {
+    Scalar3 nearest_plane_distance = new_box.getNearestPlaneDistance();
+    if ((new_box.getPeriodic().x && nearest_plane_distance.x <= this->m_nominal_width * 2)
+        || (new_box.getPeriodic().y && nearest_plane_distance.y <= this->m_nominal_width * 2)
+        || (this->m_sysdef->getNDimensions() == 3 && new_box.getPeriodic().z
+            && nearest_plane_distance.z <= this->m_nominal_width * 2))
+        {
+        return IntegratorHPMCMono<Shape>::attemptBoxResize(timestep, new_box);
+        }
+
+    BoxDim cur_box = this->m_pdata->getGlobalBox();
+
+    if (this->m_pdata->getN() > 0)
+        {
+        ArrayHandle<Scalar4> d_postype(this->m_pdata->getPositions(),
+                                       access_location::device,
+                                       access_mode::readwrite);
+        gpu::hpmc_scale_positions(d_postype.data, this->m_pdata->getN(), cur_box, new_box, 128);
+        if (this->m_exec_conf->isCUDAErrorCheckingEnabled())
+            CHECK_CUDA_ERROR();
+        }
+
+    this->m_pdata->setGlobalBox(new_box);
+
+    // we have moved particles, communicate those changes
+    this->communicate(false);
+
+    bool result = !checkOverlapsGPU(timestep);
+
+    if (result)
+        {
+        for (unsigned int type_a = 0; type_a < this->m_pdata->getNTypes(); ++type_a)
+            {
+            for (unsigned int type_b = 0; type_b < this->m_pdata->getNTypes(); ++type_b)
+                {
+                if (this->getDepletantFugacity(type_a, type_b) != 0.0)
+                    throw std::runtime_error(
+                        "Implicit depletants not supported with NPT ensemble\n");
+                }
+            }
+        }
+
+    return result;
+    }
+
+/*! \param timestep current step
+
+    Computes the cell list and the expanded cells of the current configuration.
+*/
+template<class Shape> void IntegratorHPMCMonoGPU<Shape>::buildExcell(uint64_t timestep)
+    {
+    this->m_cl->forceCompute(timestep);
+
+    uint3 cur_dim = this->m_cl->getDim();
+    if (m_last_dim.x != cur_dim.x || m_last_dim.y != cur_dim.y || m_last_dim.z != cur_dim.z
+        || m_last_nmax != this->m_cl->getNmax())
+        {
+        initializeExcellMem();
+
+        m_last_dim = cur_dim;
+        m_last_nmax = this->m_cl->getNmax();
+        }
+
+    // access the cell list data
+    ArrayHandle<unsigned int> d_cell_size(this->m_cl->getCellSizeArray(),
+                                          access_location::device,
+                                          access_mode::read);
+    ArrayHandle<unsigned int> d_cell_idx(this->m_cl->getIndexArray(),
+                                         access_location::device,
+                                         access_mode::read);
+    ArrayHandle<unsigned int> d_cell_adj(this->m_cl->getCellAdjArray(),
+                                         access_location::device,
+                                         access_mode::read);
+
+    // per-device cell list data
+    const ArrayHandle<unsigned int>& d_cell_size_per_device
+        = m_cl->getPerDevice() ? ArrayHandle<unsigned int>(m_cl->getCellSizeArrayPerDevice(),
+                                                           access_location::device,
+                                                           access_mode::read)
+                               : ArrayHandle<unsigned int>(GlobalArray<unsigned int>(),
+                                                           access_location::device,
+                                                           access_mode::read);
+    const ArrayHandle<unsigned int>& d_cell_idx_per_device
+        = m_cl->getPerDevice() ? ArrayHandle<unsigned int>(m_cl->getIndexArrayPerDevice(),
+                                                           access_location::device,
+                                                           access_mode::read)
+                               : ArrayHandle<unsigned int>(GlobalArray<unsigned int>(),
+                                                           access_location::device,
+                                                           access_mode::read);
+
+    // expanded cells
+    ArrayHandle<unsigned int> d_excell_size(m_excell_size,
+                                            access_location::device,
+                                            access_mode::overwrite);
+    ArrayHandle<unsigned int> d_excell_offset(m_excell_offset,
+                                              access_location::device,
+                                              access_mode::overwrite);
+
+    // do not time these launches, the workload differs from that in update()
+    unsigned int n_excell = 0;
+    gpu::hpmc_excell_offsets(d_excell_size.data,
+                             d_excell_offset.data,
+                             n_excell,
+                             m_cl->getPerDevice() ? d_cell_size_per_device.data
+                                                  : d_cell_size.data,
+                             d_cell_adj.data,
+                             this->m_cl->getCellIndexer(),
+                             this->m_cl->getCellAdjIndexer(),
+                             this->m_exec_conf->getNumActiveGPUs(),
+                             this->m_tuner_excell_block_size->getParam(),
+                             *this->m_exec_conf->getCachedAllocator());
+    if (this->m_exec_conf->isCUDAErrorCheckingEnabled())
+        CHECK_CUDA_ERROR();
+
+    if (n_excell > m_excell_idx.getNumElements())
+        m_excell_idx.resize(n_excell);
+
+    ArrayHandle<unsigned int> d_excell_idx(m_excell_idx,
+                                           access_location::device,
+                                           access_mode::overwrite);
+
+    gpu::hpmc_excell(d_excell_idx.data,
+                     d_excell_size.data,
+                     gpu::ExcellIndexer(d_excell_offset.data),
+                     m_cl->getPerDevice() ? d_cell_idx_per_device.data : d_cell_idx.data,
+                     m_cl->getPerDevice() ? d_cell_size_per_device.data : d_cell_size.data,
+                     d_cell_adj.data,
+                     this->m_cl->getCellIndexer(),
+                     this->m_cl->getCellListIndexer(),
+                     this->m_cl->getCellAdjIndexer(),
+                     this->m_exec_conf->getNumActiveGPUs(),
+                     m_cell_partition,
+                     this->m_tuner_excell_block_size->getParam());
+    if (this->m_exec_conf->isCUDAErrorCheckingEnabled())
+        CHECK_CUDA_ERROR();
+    }
+
+template<class Shape> bool IntegratorHPMCMonoGPU<Shape>::checkOverlapsGPU(uint64_t timestep)
+    {
+    unsigned int overlap = 0;
+
+    if (this->m_pdata->getN() > 0)
+        {
+        if (this->m_prof)
+            this->m_prof->push(this->m_exec_conf, "HPMC count overlaps");
+
+        // the particles have moved since the last update
+        buildExcell(timestep);
+
+        if (resizeTrialArrays())
+            updateGPUAdvice();
+
+        m_update_order.resize(this->m_pdata->getN());
+
+        bool domain_decomposition = false;
+#ifdef ENABLE_MPI
+        if (this->m_comm)
+            domain_decomposition = true;
+#endif
+
+        Scalar3 npd = this->m_pdata->getBox().getNearestPlaneDistance();
+        Scalar3 ghost_fraction = this->m_nominal_width / npd;
+
+        // expanded cells
+        ArrayHandle<unsigned int> d_excell_idx(m_excell_idx,
+                                               access_location::device,
+                                               access_mode::read);
+        ArrayHandle<unsigned int> d_excell_size(m_excell_size,
+                                                access_location::device,
+                                                access_mode::read);
+        ArrayHandle<unsigned int> d_excell_offset(m_excell_offset,
+                                                  access_location::device,
+                                                  access_mode::read);
+        const gpu::ExcellIndexer excli(d_excell_offset.data);
+
+        auto& params = this->getParams();
+        ArrayHandle<unsigned int> d_overlaps(this->m_overlaps,
+                                             access_location::device,
+                                             access_mode::read);
+        ArrayHandle<Scalar> d_d(this->m_d, access_location::device, access_mode::read);
+        ArrayHandle<Scalar> d_a(this->m_a, access_location::device, access_mode::read);
+
+        ArrayHandle<unsigned int> d_update_order_by_ptl(m_update_order.get(),
+                                                        access_location::device,
+                                                        access_mode::read);
+        ArrayHandle<unsigned int> d_reject_out_of_cell(m_reject_out_of_cell,
+                                                       access_location::device,
+                                                       access_mode::overwrite);
+        ArrayHandle<unsigned int> d_reject(m_reject,
+                                           access_location::device,
+                                           access_mode::overwrite);
+        ArrayHandle<unsigned int> d_reject_out(m_reject_out,
+                                               access_location::device,
+                                               access_mode::overwrite);
+        ArrayHandle<Scalar4> d_trial_postype(m_trial_postype,
+                                             access_location::device,
+                                             access_mode::overwrite);
+        ArrayHandle<Scalar4> d_trial_orientation(m_trial_orientation,
+                                                 access_location::device,
+                                                 access_mode::overwrite);
+        ArrayHandle<Scalar4> d_trial_vel(m_trial_vel,
+                                         access_location::device,
+                                         access_mode::overwrite);
+        ArrayHandle<unsigned int> d_trial_move_type(m_trial_move_type,
+                                                    access_location::device,
+                                                    access_mode::overwrite);
+
+        ArrayHandle<Scalar4> d_postype(this->m_pdata->getPositions(),
+                                       access_location::device,
+                                       access_mode::read);
+        ArrayHandle<Scalar4> d_orientation(this->m_pdata->getOrientationArray(),
+                                           access_location::device,
+                                           access_mode::read);
+        ArrayHandle<Scalar4> d_vel(this->m_pdata->getVelocities(),
+                                   access_location::device,
+                                   access_mode::read);
+
+        // the per-device counters are reset at the start of every update(), use them to keep
+        // the overlap checks out of the move statistics
+        ArrayHandle<hpmc_counters_t> d_counters_per_device(this->m_counters,
+                                                           access_location::device,
+                                                           access_mode::readwrite);
+
+            {
+            ArrayHandle<unsigned int> d_condition(m_condition,
+                                                  access_location::device,
+                                                  access_mode::overwrite);
+            hipMemsetAsync(d_condition.data, 0, sizeof(unsigned int));
+            if (this->m_exec_conf->isCUDAErrorCheckingEnabled())
+                CHECK_CUDA_ERROR();
+            }
+
+        // the trial configuration is the current configuration and no particle is marked as moved,
+        // so every neighbor is read from the particle data
+        this->m_exec_conf->beginMultiGPU();
+        for (int idev = this->m_exec_conf->getNumActiveGPUs() - 1; idev >= 0; --idev)
+            {
+            hipSetDevice(this->m_exec_conf->getGPUIds()[idev]);
+
+            auto range = this->m_pdata->getGPUPartition().getRange(idev);
+            unsigned int n = range.second - range.first;
+            if (n != 0)
+                {
+                hipMemcpyAsync(d_trial_postype.data + range.first,
+                               d_postype.data + range.first,
+                               sizeof(Scalar4) * n,
+                               hipMemcpyDeviceToDevice);
+                hipMemcpyAsync(d_trial_orientation.data + range.first,
+                               d_orientation.data + range.first,
+                               sizeof(Scalar4) * n,
+                               hipMemcpyDeviceToDevice);
+                hipMemsetAsync(d_trial_move_type.data + range.first, 0, sizeof(unsigned int) * n);
+                hipMemsetAsync(d_reject_out_of_cell.data + range.first,
+                               0,
+                               sizeof(unsigned int) * n);
+                hipMemsetAsync(d_reject.data + range.first, 0, sizeof(unsigned int) * n);
+                hipMemsetAsync(d_reject_out.data + range.first, 0, sizeof(unsigned int) * n);
+                }
+            if (this->m_exec_conf->isCUDAErrorCheckingEnabled())
+                CHECK_CUDA_ERROR();
+            }
+        this->m_exec_conf->endMultiGPU();
+
+        gpu::hpmc_args_t args(d_postype.data,
+                              d_orientation.data,
+                              d_vel.data,
+                              d_counters_per_device.data,
+                              (unsigned int)this->m_counters.getPitch(),
+                              this->m_cl->getCellIndexer(),
+                              this->m_cl->getDim(),
+                              this->m_cl->getGhostWidth(),
+                              this->m_pdata->getN(),
+                              this->m_pdata->getNTypes(),
+                              this->m_sysdef->getSeed(),
+                              this->m_exec_conf->getRank(),
+                              d_d.data,
+                              d_a.data,
+                              d_overlaps.data,
+                              this->m_overlap_idx,
+                              this->m_translation_move_probability,
+                              timestep,
+                              this->m_sysdef->getNDimensions(),
+                              this->m_pdata->getBox(),
+                              0, // select
+                              ghost_fraction,
+                              domain_decomposition,
+                              0, // block size
+                              0, // tpp
+                              0, // overlap threads
+                              false,
+                              d_reject_out_of_cell.data,
+                              d_trial_postype.data,
+                              d_trial_orientation.data,
+                              d_trial_vel.data,
+                              d_trial_move_type.data,
+                              d_update_order_by_ptl.data,
+                              d_excell_idx.data,
+                              d_excell_size.data,
+                              excli,
+                              d_reject.data,
+                              d_reject_out.data,
+                              this->m_exec_conf->dev_prop,
+                              this->m_pdata->getGPUPartition(),
+                              &m_narrow_phase_streams.front());
+
+        this->m_exec_conf->beginMultiGPU();
+        unsigned int param = m_tuner_narrow->getParam();
+        args.block_size = param / 1000000;
+        args.tpp = (param % 1000000) / 100;
+        args.overlap_threads = param % 100;
+        gpu::hpmc_narrow_phase<Shape>(args, params.data());
+        if (this->m_exec_conf->isCUDAErrorCheckingEnabled())
+            CHECK_CUDA_ERROR();
+        this->m_exec_conf->endMultiGPU();
+
+            {
+            ArrayHandle<unsigned int> d_condition(m_condition,
+                                                  access_location::device,
+                                                  access_mode::readwrite);
+            this->m_exec_conf->beginMultiGPU();
+            gpu::hpmc_flag_overlaps(d_reject_out.data,
+                                    d_condition.data,
+                                    this->m_pdata->getGPUPartition(),
+                                    m_tuner_convergence->getParam());
+            if (this->m_exec_conf->isCUDAErrorCheckingEnabled())
+                CHECK_CUDA_ERROR();
+            this->m_exec_conf->endMultiGPU();
+            }
+
+        ArrayHandle<unsigned int> h_condition(m_condition,
+                                              access_location::host,
+                                              access_mode::read);
+        overlap = *h_condition.data;
+
+        if (this->m_prof)
+            this->m_prof->pop(this->m_exec_conf);
+        }
+
+#ifdef ENABLE_MPI
+    if (this->m_pdata->getDomainDecomposition())
+        {
+        MPI_Allreduce(MPI_IN_PLACE,
+                      &overlap,
+                      1,
+                      MPI_UNSIGNED,
+                      MPI_MAX,
+                      this->m_exec_conf->getMPICommunicator());
+        }
+#endif
+
+    return overlap != 0;
+    }
+
+/*! \param timestep current step
+    \param max_overlaps Stop counting when there are more overlaps than this
+
+    Counts the overlapping pairs in the expanded cells on the device, so that only the count is
+    copied to the host. All threads stop searching once the count exceeds \a max_overlaps.
+
+    Falls back to the CPU implementation when the box is too small for the minimum image
+    convention with the current cell width.
+*/
+template<class Shape>
+unsigned int IntegratorHPMCMonoGPU<Shape>::countOverlapsUpTo(uint64_t timestep,
+                                                             unsigned int max_overlaps)
+    {
+    const BoxDim global_box = this->m_pdata->getGlobalBox();
+    Scalar3 nearest_plane_distance = global_box.getNearestPlaneDistance();
+    if ((global_box.getPeriodic().x && nearest_plane_distance.x <= this->m_nominal_width * 2)
+        || (global_box.getPeriodic().y && nearest_plane_distance.y <= this->m_nominal_width * 2)
+        || (this->m_sysdef->getNDimensions() == 3 && global_box.getPeriodic().z
+            && nearest_plane_distance.z <= this->m_nominal_width * 2))
+        {
+        return IntegratorHPMCMono<Shape>::countOverlapsUpTo(timestep, max_overlaps);
+        }
+
+    unsigned int overlap_count = 0;
+
+    if (this->m_pdata->getN() > 0)
+        {
+        if (this->m_prof)
+            this->m_prof->push(this->m_exec_conf, "HPMC count overlaps");
+
+        buildExcell(timestep);
+
+        ArrayHandle<unsigned int> d_excell_idx(m_excell_idx,
+                                               access_location::device,
+                                               access_mode::read);
+        ArrayHandle<unsigned int> d_excell_size(m_excell_size,
+                                                access_location::device,
+                                                access_mode::read);
+        ArrayHandle<unsigned int> d_excell_offset(m_excell_offset,
+                                                  access_location::device,
+                                                  access_mode::read);
+        const gpu::ExcellIndexer excli(d_excell_offset.data);
+        ArrayHandle<Scalar4> d_postype(this->m_pdata->getPositions(),
+                                       access_location::device,
+                                       access_mode::read);
+        ArrayHandle<Scalar4> d_orientation(this->m_pdata->getOrientationArray(),
+                                           access_location::device,
+                                           access_mode::read);
+        ArrayHandle<unsigned int> d_tag(this->m_pdata->getTags(),
+                                        access_location::device,
+                                        access_mode::read);
+        ArrayHandle<unsigned int> d_overlaps(this->m_overlaps,
+                                             access_location::device,
+                                             access_mode::read);
+
+            {
+            ArrayHandle<unsigned int> d_condition(m_condition,
+                                                  access_location::device,
+                                                  access_mode::overwrite);
+            hipMemsetAsync(d_condition.data, 0, sizeof(unsigned int));
+            if (this->m_exec_conf->isCUDAErrorCheckingEnabled())
+                CHECK_CUDA_ERROR();
+
+            auto& params = this->getParams();
+
+            m_tuner_count_overlaps->begin();
+            unsigned int param = m_tuner_count_overlaps->getParam();
+            gpu::hpmc_count_overlaps_args_t args(d_postype.data,
+                                                 d_orientation.data,
+                                                 d_tag.data,
+                                                 d_excell_idx.data,
+                                                 d_excell_size.data,
+                                                 excli,
+                                                 this->m_cl->getCellIndexer(),
+                                                 this->m_cl->getDim(),
+                                                 this->m_cl->getGhostWidth(),
+                                                 this->m_pdata->getN(),
+                                                 this->m_pdata->getNTypes(),
+                                                 this->m_pdata->getBox(),
+                                                 d_overlaps.data,
+                                                 this->m_overlap_idx,
+                                                 max_overlaps,
+                                                 d_condition.data,
+                                                 param / 1000000,
+                                                 param % 1000000,
+                                                 this->m_exec_conf->dev_prop);
+            gpu::hpmc_count_overlaps<Shape>(args, params.data());
+            if (this->m_exec_conf->isCUDAErrorCheckingEnabled())
+                CHECK_CUDA_ERROR();
+            m_tuner_count_overlaps->end();
+            }
+
+        ArrayHandle<unsigned int> h_condition(m_condition,
+                                              access_location::host,
+                                              access_mode::read);
+        overlap_count = *h_condition.data;
+
+        if (this->m_prof)
+            this->m_prof->pop(this->m_exec_conf);
+        }
+
+#ifdef ENABLE_MPI
+    if (this->m_pdata->getDomainDecomposition())
+        {
+        // each rank stops above max_overlaps, so the sum exceeds it when any rank did
+        MPI_Allreduce(MPI_IN_PLACE,
+                      &overlap_count,
+                      1,
+                      MPI_UNSIGNED,
+                      MPI_SUM,
+                      this->m_exec_conf->getMPICommunicator());
+        }
+#endif
+
+    return overlap_count;
     }
 
 template<class Shape> void IntegratorHPMCMonoGPU<Shape>::initializeExcellMem()
@@ -2123,34 +2792,49 @@ template<class Shape> void IntegratorHPMCMonoGPU<Shape>::initializeExcellMem()
 
     // get the current cell dimensions
     unsigned int num_cells = this->m_cl->getCellIndexer().getNumElements();
-    unsigned int num_adj = this->m_cl->getCellAdjIndexer().getW();
-    unsigned int n_cell_list
-        = this->m_cl->getPerDevice() ? this->m_exec_conf->getNumActiveGPUs() : 1;
-    unsigned int num_max = this->m_cl->getNmax() * n_cell_list;
-
-    // make the excell dimensions the same, but with room for Nmax*Nadj in each cell
-    m_excell_list_indexer = Index2D(num_max * num_adj, num_cells);
 
-    // reallocate memory
-    m_excell_idx.resize(m_excell_list_indexer.getNumElements());
+    // reallocate memory, m_excell_idx is sized to the actual number of entries when the
+    // expanded cells are built
     m_excell_size.resize(num_cells);
+    m_excell_offset.resize(num_cells + 1);
 
-#if defined(__HIP_PLATFORM_NVCC__) \
-    && 0 // excell is currently not multi-GPU optimized, let the CUDA driver figure this out
+    // assign each device a slab of whole layers of cells along the slowest varying dimension, so
+    // that the device builds the expanded cells of a compact region of space
+    const Index3D& ci = this->m_cl->getCellIndexer();
+    if (ci.getD() > 1)
+        m_cell_partition.setBlocks(ci.getD(), ci.getW() * ci.getH());
+    else
+        m_cell_partition.setBlocks(ci.getH(), ci.getW());
+
+#if defined(__HIP_PLATFORM_NVCC__)
     if (this->m_exec_conf->allConcurrentManagedAccess())
         {
-        // set memory hints
+        // keep the sizes and offsets of each slab on the device that writes them, neighboring
+        // devices only read the slab boundaries over the peer link
         auto gpu_map = this->m_exec_conf->getGPUIds();
         for (unsigned int idev = 0; idev < this->m_exec_conf->getNumActiveGPUs(); ++idev)
             {
-            cudaMemAdvise(m_excell_idx.get(),
-                          sizeof(unsigned int) * m_excell_idx.getNumElements(),
-                          cudaMemAdviseSetAccessedBy,
+            auto range = m_cell_partition.getRange(idev);
+            unsigned int nelem = range.second - range.first;
+            if (nelem == 0)
+                continue;
+
+            cudaMemAdvise(m_excell_size.get() + range.first,
+                          sizeof(unsigned int) * nelem,
+                          cudaMemAdviseSetPreferredLocation,
+                          gpu_map[idev]);
+            cudaMemAdvise(m_excell_offset.get() + range.first,
+                          sizeof(unsigned int) * nelem,
+                          cudaMemAdviseSetPreferredLocation,
                           gpu_map[idev]);
             cudaMemAdvise(m_excell_size.get(),
                           sizeof(unsigned int) * m_excell_size.getNumElements(),
                           cudaMemAdviseSetAccessedBy,
                           gpu_map[idev]);
+            cudaMemAdvise(m_excell_offset.get(),
+                          sizeof(unsigned int) * m_excell_offset.getNumElements(),
+                          cudaMemAdviseSetAccessedBy,
+                          gpu_map[idev]);
             CHECK_CUDA_ERROR();
             }
         }
@@ -2162,27 +2846,29 @@ template<class Shape> void IntegratorHPMCMonoGPU<Shape>::updateCellWidth()
     // call base class method
     IntegratorHPMCMono<Shape>::updateCellWidth();
 
-    // update the cell list
-    this->m_cl->setNominalWidth(this->m_nominal_width);
-
-#ifdef __HIP_PLATFORM_NVCC__
-    // set memory hints
-    cudaMemAdvise(this->m_params.data(),
-                  this->m_params.size() * sizeof(typename Shape::param_type),
-                  cudaMemAdviseSetReadMostly,
-                  0);
-    CHECK_CUDA_ERROR();
+    // update the cell list, other computes with the same configuration share it
+    if (m_cl_request.nominal_width != this->m_nominal_width)
+        {
+        m_cl_request.nominal_width = this->m_nominal_width;
+        m_cl_request.max_width = this->m_nominal_width;
+        m_cl = this->m_sysdef->getCellList(m_cl_request);
+#ifdef ENABLE_MPI
+        if (this->m_comm)
+            m_cl->setCommunicator(this->m_comm);
 #endif
+        }
 
     // sync up so we can access the parameters
     hipDeviceSynchronize();
 
-    for (unsigned int i = 0; i < this->m_pdata->getNTypes(); ++i)
+    // attach the nested memory regions of the parameters modified since the last call
+    for (unsigned int i = this->m_params_modified_begin; i < this->m_params_modified_end; ++i)
         {
-        // attach nested memory regions
         this->m_params[i].set_memory_hint();
         CHECK_CUDA_ERROR();
         }
+    this->m_params_modified_begin = 0;
+    this->m_params_modified_end = 0;
 
     // reinitialize poisson means array
     ArrayHandle<Scalar> h_lambda(m_lambda, access_location::host, access_mode::overwrite);
@@ -2234,7 +2920,7 @@ void export_IntegratorHPMCMonoGPU(pybind11::module& m, const std::string& name)
     pybind11::class_<IntegratorHPMCMonoGPU<Shape>,
                      IntegratorHPMCMono<Shape>,
                      std::shared_ptr<IntegratorHPMCMonoGPU<Shape>>>(m, name.c_str())
-        .def(pybind11::init<std::shared_ptr<SystemDefinition>, std::shared_ptr<CellList>>())
+        .def(pybind11::init<std::shared_ptr<SystemDefinition>>())
 #ifdef ENABLE_MPI
         .def("setNtrialCommunicator", &IntegratorHPMCMonoGPU<Shape>::setNtrialCommunicator)
         .def("setParticleCommunicator", &IntegratorHPMCMonoGPU<Shape>::setParticleCommunicator)
@@ -0,0 +1,311 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file IntegratorHPMCMonoGPUCountOverlaps.cuh
+    \brief Implements the overlap counting kernel on the GPU
+*/
+
+#pragma once
+
+#include <hip/hip_runtime.h>
+
+#include "HPMCMiscFunctions.h"
+#include "hoomd/BoxDim.h"
+#include "hoomd/HOOMDMath.h"
+#include "hoomd/Index1D.h"
+#include "hoomd/VectorMath.h"
+
+#include "ExcellIndexer.h"
+#include "GPUHelpers.cuh"
+
+#include <cassert>
+#include <stdexcept>
+
+namespace hpmc
+    {
+namespace gpu
+    {
+//! Wraps arguments to hpmc_count_overlaps
+/*! \ingroup hpmc_data_structs */
+struct hpmc_count_overlaps_args_t
+    {
+    //! Construct a hpmc_count_overlaps_args_t
+    hpmc_count_overlaps_args_t(const Scalar4* _d_postype,
+                               const Scalar4* _d_orientation,
+                               const unsigned int* _d_tag,
+                               const unsigned int* _d_excell_idx,
+                               const unsigned int* _d_excell_size,
+                               const ExcellIndexer& _excli,
+                               const Index3D& _ci,
+                               const uint3& _cell_dim,
+                               const Scalar3& _ghost_width,
+                               const unsigned int _N,
+                               const unsigned int _num_types,
+                               const BoxDim& _box,
+                               const unsigned int* _d_check_overlaps,
+                               const Index2D& _overlap_idx,
+                               const unsigned int _max_overlaps,
+                               unsigned int* _d_overlap_count,
+                               const unsigned int _block_size,
+                               const unsigned int _group_size,
+                               const hipDeviceProp_t& _devprop)
+        : d_postype(_d_postype), d_orientation(_d_orientation), d_tag(_d_tag),
+          d_excell_idx(_d_excell_idx), d_excell_size(_d_excell_size), excli(_excli), ci(_ci),
+          cell_dim(_cell_dim), ghost_width(_ghost_width), N(_N), num_types(_num_types), box(_box),
+          d_check_overlaps(_d_check_overlaps), overlap_idx(_overlap_idx),
+          max_overlaps(_max_overlaps), d_overlap_count(_d_overlap_count), block_size(_block_size),
+          group_size(_group_size), devprop(_devprop) {};
+
+    const Scalar4* d_postype;               //!< postype array
+    const Scalar4* d_orientation;           //!< orientation array
+    const unsigned int* d_tag;              //!< Particle tags, including ghosts
+    const unsigned int* d_excell_idx;       //!< Expanded cell neighbors
+    const unsigned int* d_excell_size;      //!< Size of expanded cell list per cell
+    const ExcellIndexer excli;              //!< Expanded cell indexer
+    const Index3D ci;                       //!< Cell indexer
+    const uint3 cell_dim;                   //!< Cell dimensions
+    const Scalar3 ghost_width;              //!< Width of ghost layer
+    const unsigned int N;                   //!< Number of local particles
+    const unsigned int num_types;           //!< Number of particle types
+    const BoxDim box;                       //!< Local simulation box
+    const unsigned int* d_check_overlaps;   //!< Interaction matrix
+    const Index2D overlap_idx;              //!< Indexer into interaction matrix
+    const unsigned int max_overlaps;        //!< Stop counting above this many overlaps
+    unsigned int* d_overlap_count;          //!< Number of overlapping pairs (output value)
+    const unsigned int block_size;          //!< Block size to execute
+    const unsigned int group_size;          //!< Number of threads per particle
+    const hipDeviceProp_t& devprop;         //!< CUDA device properties
+    };
+
+template<class Shape>
+void hpmc_count_overlaps(const hpmc_count_overlaps_args_t& args,
+                         const typename Shape::param_type* d_params);
+
+#ifdef __HIPCC__
+namespace kernel
+    {
+//! Kernel to count the overlapping pairs of particles
+/*! \param d_postype Particle positions and types by index
+    \param d_orientation Particle orientations
+    \param d_tag Particle tags, including ghosts
+    \param d_excell_idx Expanded cell neighbors
+    \param d_excell_size Size of expanded cell list per cell
+    \param excli Expanded cell indexer
+    \param ci Cell indexer
+    \param cell_dim Dimensions of the cell list
+    \param ghost_width Width of the ghost layer
+    \param N Number of local particles
+    \param num_types Number of particle types
+    \param box Local simulation box
+    \param d_check_overlaps Interaction matrix
+    \param overlap_idx Indexer into interaction matrix
+    \param max_overlaps Stop counting above this many overlaps
+    \param d_overlap_count Number of overlapping pairs (output value)
+    \param d_params Per-type shape parameters
+    \param max_extra_bytes Shared memory available for the shape parameters
+
+    Each group of blockDim.y threads processes one particle i and splits the neighbors j in the
+    expanded cell of i among its threads. A pair is counted by the particle with the lower tag, as
+    in IntegratorHPMCMono::countOverlaps(). Threads stop searching once the global count exceeds
+    \a max_overlaps. blockDim.x is 1, so that shapes which split an overlap check over threadIdx.x
+    perform the complete check in every thread.
+*/
+template<class Shape>
+__global__ void hpmc_count_overlaps(const Scalar4* d_postype,
+                                    const Scalar4* d_orientation,
+                                    const unsigned int* d_tag,
+                                    const unsigned int* d_excell_idx,
+                                    const unsigned int* d_excell_size,
+                                    const ExcellIndexer excli,
+                                    const Index3D ci,
+                                    const uint3 cell_dim,
+                                    const Scalar3 ghost_width,
+                                    const unsigned int N,
+                                    const unsigned int num_types,
+                                    const BoxDim box,
+                                    const unsigned int* d_check_overlaps,
+                                    const Index2D overlap_idx,
+                                    const unsigned int max_overlaps,
+                                    unsigned int* d_overlap_count,
+                                    const typename Shape::param_type* d_params,
+                                    const unsigned int max_extra_bytes)
+    {
+    unsigned int offset = threadIdx.y;
+    unsigned int group_size = blockDim.y;
+    unsigned int group = threadIdx.z;
+    unsigned int n_groups = blockDim.z;
+
+    // load the per type parameters into shared memory
+    HIP_DYNAMIC_SHARED(char, s_data)
+    typename Shape::param_type* s_params = (typename Shape::param_type*)(&s_data[0]);
+    unsigned int* s_check_overlaps = (unsigned int*)(s_params + num_types);
+    unsigned int ntyppairs = overlap_idx.getNumElements();
+
+    // copy over parameters one int per thread for fast loads
+        {
+        unsigned int tidx
+            = threadIdx.x + blockDim.x * threadIdx.y + blockDim.x * blockDim.y * threadIdx.z;
+        unsigned int block_size = blockDim.x * blockDim.y * blockDim.z;
+        unsigned int param_size = num_types * sizeof(typename Shape::param_type) / sizeof(int);
+
+        for (unsigned int cur_offset = 0; cur_offset < param_size; cur_offset += block_size)
+            {
+            if (cur_offset + tidx < param_size)
+                {
+                ((int*)s_params)[cur_offset + tidx] = ((int*)d_params)[cur_offset + tidx];
+                }
+            }
+
+        for (unsigned int cur_offset = 0; cur_offset < ntyppairs; cur_offset += block_size)
+            {
+            if (cur_offset + tidx < ntyppairs)
+                {
+                s_check_overlaps[cur_offset + tidx] = d_check_overlaps[cur_offset + tidx];
+                }
+            }
+        }
+
+    __syncthreads();
+
+    // initialize extra shared mem
+    char* s_extra = (char*)(s_check_overlaps + ntyppairs);
+
+    unsigned int available_bytes = max_extra_bytes;
+    for (unsigned int cur_type = 0; cur_type < num_types; ++cur_type)
+        s_params[cur_type].load_shared(s_extra, available_bytes);
+
+    __syncthreads();
+
+    unsigned int i = blockIdx.x * n_groups + group;
+
+    if (i >= N)
+        return;
+
+    Scalar4 postype_i = d_postype[i];
+    unsigned int typ_i = __scalar_as_int(postype_i.w);
+    Shape shape_i(quat<Scalar>(), s_params[typ_i]);
+    if (shape_i.hasOrientation())
+        shape_i.orientation = quat<Scalar>(d_orientation[i]);
+    vec3<Scalar> pos_i(postype_i);
+    unsigned int tag_i = d_tag[i];
+
+    unsigned int my_cell
+        = computeParticleCell(vec_to_scalar3(pos_i), box, ghost_width, cell_dim, ci, false);
+    unsigned int excell_size = d_excell_size[my_cell];
+
+    for (unsigned int k = offset; k < excell_size; k += group_size)
+        {
+        // another thread may have found enough overlaps already
+        if (*((volatile unsigned int*)d_overlap_count) > max_overlaps)
+            return;
+
+        unsigned int j = d_excell_idx[excli(k, my_cell)];
+        if (j == i || d_tag[j] < tag_i)
+            continue;
+
+        Scalar4 postype_j = d_postype[j];
+        unsigned int typ_j = __scalar_as_int(postype_j.w);
+        if (!s_check_overlaps[overlap_idx(typ_i, typ_j)])
+            continue;
+
+        Shape shape_j(quat<Scalar>(), s_params[typ_j]);
+        if (shape_j.hasOrientation())
+            shape_j.orientation = quat<Scalar>(d_orientation[j]);
+
+        // put particle j into the coordinate system of particle i
+        vec3<Scalar> r_ij = vec3<Scalar>(postype_j) - pos_i;
+        r_ij = vec3<Scalar>(box.minImage(vec_to_scalar3(r_ij)));
+
+        unsigned int err_count = 0;
+        if (check_circumsphere_overlap(r_ij, shape_i, shape_j)
+            && test_overlap(r_ij, shape_i, shape_j, err_count)
+            && test_overlap(-r_ij, shape_j, shape_i, err_count))
+            {
+            atomicAdd(d_overlap_count, 1);
+            }
+        }
+    }
+    } // end namespace kernel
+
+//! Kernel driver for kernel::hpmc_count_overlaps()
+/*! \param args Bundled arguments
+    \param d_params Per-type shape parameters
+
+    The caller zeroes args.d_overlap_count before the launch.
+
+    \ingroup hpmc_kernels
+*/
+template<class Shape>
+void hpmc_count_overlaps(const hpmc_count_overlaps_args_t& args,
+                         const typename Shape::param_type* d_params)
+    {
+    assert(args.d_postype);
+    assert(args.d_orientation);
+    assert(args.d_overlap_count);
+    assert(args.block_size % args.group_size == 0);
+
+    // determine the maximum block size and clamp the input block size down
+    static int max_block_size = -1;
+    static hipFuncAttributes attr;
+    if (max_block_size == -1)
+        {
+        hipFuncGetAttributes(&attr,
+                             reinterpret_cast<const void*>(kernel::hpmc_count_overlaps<Shape>));
+        max_block_size = attr.maxThreadsPerBlock;
+        }
+
+    unsigned int run_block_size = min(args.block_size, (unsigned int)max_block_size);
+    unsigned int n_groups = run_block_size / args.group_size;
+
+    dim3 threads(1, args.group_size, n_groups);
+    dim3 grid(args.N / n_groups + 1, 1, 1);
+
+    size_t shared_bytes = args.num_types * sizeof(typename Shape::param_type)
+                          + args.overlap_idx.getNumElements() * sizeof(unsigned int);
+
+    if (shared_bytes + attr.sharedSizeBytes >= args.devprop.sharedMemPerBlock)
+        throw std::runtime_error("Insufficient shared memory for HPMC kernel: reduce number of "
+                                 "particle types or size of shape parameters");
+
+    unsigned int max_extra_bytes = static_cast<unsigned int>(args.devprop.sharedMemPerBlock
+                                                             - attr.sharedSizeBytes - shared_bytes);
+
+    // determine dynamically requested shared memory
+    char* ptr = (char*)nullptr;
+    unsigned int available_bytes = max_extra_bytes;
+    for (unsigned int i = 0; i < args.num_types; ++i)
+        {
+        d_params[i].allocate_shared(ptr, available_bytes);
+        }
+    unsigned int extra_bytes = max_extra_bytes - available_bytes;
+
+    shared_bytes += extra_bytes;
+
+    hipLaunchKernelGGL((kernel::hpmc_count_overlaps<Shape>),
+                       grid,
+                       threads,
+                       shared_bytes,
+                       0,
+                       args.d_postype,
+                       args.d_orientation,
+                       args.d_tag,
+                       args.d_excell_idx,
+                       args.d_excell_size,
+                       args.excli,
+                       args.ci,
+                       args.cell_dim,
+                       args.ghost_width,
+                       args.N,
+                       args.num_types,
+                       args.box,
+                       args.d_check_overlaps,
+                       args.overlap_idx,
+                       args.max_overlaps,
+                       args.d_overlap_count,
+                       d_params,
+                       max_extra_bytes);
+    }
+#endif
+
+    } // end namespace gpu
+    } // end namespace hpmc
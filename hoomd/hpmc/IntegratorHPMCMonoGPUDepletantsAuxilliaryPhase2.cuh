@@ -51,7 +51,7 @@ __launch_bounds__(max_threads)
                                                   hpmc_counters_t* d_counters,
                                                   const unsigned int* d_excell_idx,
                                                   const unsigned int* d_excell_size,
-                                                  const Index2D excli,
+                                                  const ExcellIndexer excli,
                                                   const uint3 cell_dim,
                                                   const Scalar3 ghost_width,
                                                   const Index3D ci,
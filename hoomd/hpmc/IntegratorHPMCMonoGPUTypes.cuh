@@ -4,10 +4,12 @@
 #pragma once
 
 #include "hoomd/BoxDim.h"
+#include "hoomd/CachedAllocator.h"
 #include "hoomd/GPUPartition.cuh"
 #include "hoomd/HOOMDMath.h"
 #include "hoomd/Index1D.h"
 #include "hoomd/VectorMath.h"
+#include "hoomd/hpmc/ExcellIndexer.h"
 #include "hoomd/hpmc/HPMCCounters.h"
 #include <hip/hip_runtime.h>
 
@@ -55,7 +57,7 @@ struct hpmc_args_t
                 const unsigned int* _d_update_order_by_ptl,
                 unsigned int* _d_excell_idx,
                 const unsigned int* _d_excell_size,
-                const Index2D& _excli,
+                const ExcellIndexer& _excli,
                 const unsigned int* _d_reject_in,
                 unsigned int* _d_reject_out,
                 const hipDeviceProp_t& _devprop,
@@ -113,7 +115,7 @@ struct hpmc_args_t
     const unsigned int* d_update_order_by_ptl; //!< Lookup of update order by particle index
     unsigned int* d_excell_idx;                //!< Expanded cell list
     const unsigned int* d_excell_size;         //!< Size of expanded cells
-    const Index2D& excli;                      //!< Excell indexer
+    const ExcellIndexer& excli;                //!< Excell indexer
     const unsigned int* d_reject_in;           //!< Reject flags per particle (in)
     unsigned int* d_reject_out;                //!< Reject flags per particle (out)
     const hipDeviceProp_t& devprop;            //!< CUDA device properties
@@ -187,6 +189,32 @@ void hpmc_excell(unsigned int* d_excell_idx,
                  const unsigned int ngpu,
                  const unsigned int block_size);
 
+//! Driver for kernel::hpmc_excell() with the compacted expanded cell list
+void hpmc_excell(unsigned int* d_excell_idx,
+                 unsigned int* d_excell_size,
+                 const ExcellIndexer& excli,
+                 const unsigned int* d_cell_idx,
+                 const unsigned int* d_cell_size,
+                 const unsigned int* d_cell_adj,
+                 const Index3D& ci,
+                 const Index2D& cli,
+                 const Index2D& cadji,
+                 const unsigned int ngpu,
+                 const GPUPartition& cell_partition,
+                 const unsigned int block_size);
+
+//! Count the particles in the expanded cells and compute their offsets in the compacted list
+void hpmc_excell_offsets(unsigned int* d_excell_size,
+                         unsigned int* d_excell_offset,
+                         unsigned int& n_excell,
+                         const unsigned int* d_cell_size,
+                         const unsigned int* d_cell_adj,
+                         const Index3D& ci,
+                         const Index2D& cadji,
+                         const unsigned int ngpu,
+                         const unsigned int block_size,
+                         CachedAllocator& alloc);
+
 //! Kernel driver for kernel::hpmc_shift()
 void hpmc_shift(Scalar4* d_postype,
                 int3* d_image,
@@ -204,6 +232,30 @@ void hpmc_check_convergence(const unsigned int* d_trial_move_type,
                             const GPUPartition& gpu_partition,
                             unsigned int block_size);
 
+//! Kernel driver for kernel::hpmc_scale_positions()
+void hpmc_scale_positions(Scalar4* d_postype,
+                          const unsigned int N,
+                          const BoxDim& old_box,
+                          const BoxDim& new_box,
+                          const unsigned int block_size);
+
+//! Set *d_condition to 1 if any particle has a nonzero reject flag
+void hpmc_flag_overlaps(const unsigned int* d_reject_out,
+                        unsigned int* d_condition,
+                        const GPUPartition& gpu_partition,
+                        const unsigned int block_size);
+
+//! Scale the move sizes toward a target acceptance ratio on the device
+void hpmc_update_move_sizes(Scalar* d_d,
+                            Scalar* d_a,
+                            const Scalar* d_d_max,
+                            const Scalar* d_a_max,
+                            const hpmc_counters_t* d_counters,
+                            hpmc_counters_t* d_count_tune_start,
+                            const unsigned int ntypes,
+                            const Scalar target,
+                            const Scalar gain);
+
     } // end namespace gpu
 
     } // end namespace hpmc
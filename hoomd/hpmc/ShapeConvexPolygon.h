@@ -444,6 +444,9 @@ namespace detail
 
     `p` and `n` are specified *in the polygon's reference frame!*
 
+    On the CPU, the vertices are projected onto the normal 8 (AVX) or 4 (SSE) at a time. The
+    padding vertices beyond N are masked out of the comparison.
+
     \todo make overlap check namespace
 */
 DEVICE inline bool
@@ -455,6 +458,49 @@ is_outside(const PolygonVertices& verts, const vec2<OverlapReal>& p, const vec2<
     // check if n dot (v[i]-p) < 0
     // distribute: (n dot v[i] - n dot p) < 0
     OverlapReal ndotp = dot(n, p);
+#if !defined(__HIPCC__) && defined(__AVX__) \
+    && (defined(SINGLE_PRECISION) || defined(ENABLE_HPMC_MIXED_PRECISION))
+    __m256 nx_v = _mm256_broadcast_ss(&n.x);
+    __m256 ny_v = _mm256_broadcast_ss(&n.y);
+    __m256 ndotp_v = _mm256_broadcast_ss(&ndotp);
+
+    for (unsigned int i = 0; i < verts.N; i += 8)
+        {
+        __m256 x_v = _mm256_load_ps(verts.x + i);
+        __m256 y_v = _mm256_load_ps(verts.y + i);
+
+        __m256 d_v = _mm256_add_ps(_mm256_mul_ps(nx_v, x_v), _mm256_mul_ps(ny_v, y_v));
+        int inside = _mm256_movemask_ps(_mm256_cmp_ps(d_v, ndotp_v, _CMP_LE_OQ));
+
+        // ignore the padding vertices
+        if (verts.N - i < 8)
+            inside &= (1 << (verts.N - i)) - 1;
+
+        if (inside)
+            return false;
+        }
+#elif !defined(__HIPCC__) && defined(__SSE__) \
+    && (defined(SINGLE_PRECISION) || defined(ENABLE_HPMC_MIXED_PRECISION))
+    __m128 nx_v = _mm_load_ps1(&n.x);
+    __m128 ny_v = _mm_load_ps1(&n.y);
+    __m128 ndotp_v = _mm_load_ps1(&ndotp);
+
+    for (unsigned int i = 0; i < verts.N; i += 4)
+        {
+        __m128 x_v = _mm_load_ps(verts.x + i);
+        __m128 y_v = _mm_load_ps(verts.y + i);
+
+        __m128 d_v = _mm_add_ps(_mm_mul_ps(nx_v, x_v), _mm_mul_ps(ny_v, y_v));
+        int inside = _mm_movemask_ps(_mm_cmple_ps(d_v, ndotp_v));
+
+        // ignore the padding vertices
+        if (verts.N - i < 4)
+            inside &= (1 << (verts.N - i)) - 1;
+
+        if (inside)
+            return false;
+        }
+#else
 #pragma unroll 3
     for (unsigned int i = 0; i < verts.N; i++)
         {
@@ -463,6 +509,7 @@ is_outside(const PolygonVertices& verts, const vec2<OverlapReal>& p, const vec2<
             return false; // runs faster on the cpu with an early return
             }
         }
+#endif
 
     // if we get here, all points are outside
     return outside;
@@ -83,11 +83,11 @@ struct PolyhedronVertices : ShapeParams
         sweep_radius = sweep_radius_;
         bool managed = x.isManaged();
 
-        unsigned int align_size = 8; // for AVX
+        unsigned int align_size = 16; // for AVX-512
         unsigned int N_align = ((N + align_size - 1) / align_size) * align_size;
-        x = ManagedArray<OverlapReal>(N_align, managed, 32); // 32byte alignment for AVX
-        y = ManagedArray<OverlapReal>(N_align, managed, 32);
-        z = ManagedArray<OverlapReal>(N_align, managed, 32);
+        x = ManagedArray<OverlapReal>(N_align, managed, 64); // 64byte alignment for AVX-512
+        y = ManagedArray<OverlapReal>(N_align, managed, 64);
+        z = ManagedArray<OverlapReal>(N_align, managed, 64);
         for (unsigned int i = 0; i < N_align; ++i)
             {
             x[i] = y[i] = z[i] = OverlapReal(0.0);
@@ -285,7 +285,42 @@ class SupportFuncConvexPolyhedron
 
         if (verts.N > 0)
             {
-#if !defined(__HIPCC__) && defined(__AVX__) \
+#if !defined(__HIPCC__) && defined(__AVX512F__) \
+    && (defined(SINGLE_PRECISION) || defined(ENABLE_HPMC_MIXED_PRECISION))
+            // process dot products with AVX-512 16 at a time on the CPU. Track the maximum and the
+            // index of the first vertex that attains it in each channel, so that a single pass
+            // over the vertices suffices
+            __m512 nx_v = _mm512_set1_ps(n.x);
+            __m512 ny_v = _mm512_set1_ps(n.y);
+            __m512 nz_v = _mm512_set1_ps(n.z);
+            __m512 max_dot_v = _mm512_set1_ps(max_dot);
+            __m512i max_idx_v = _mm512_setzero_si512();
+            __m512i idx_v
+                = _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+            const __m512i stride_v = _mm512_set1_epi32(16);
+
+            for (unsigned int i = 0; i < verts.N; i += 16)
+                {
+                __m512 x_v = _mm512_load_ps(verts.x.get() + i);
+                __m512 y_v = _mm512_load_ps(verts.y.get() + i);
+                __m512 z_v = _mm512_load_ps(verts.z.get() + i);
+
+                __m512 d_v = _mm512_fmadd_ps(
+                    nx_v,
+                    x_v,
+                    _mm512_fmadd_ps(ny_v, y_v, _mm512_mul_ps(nz_v, z_v)));
+
+                __mmask16 greater = _mm512_cmp_ps_mask(d_v, max_dot_v, _CMP_GT_OQ);
+                max_dot_v = _mm512_mask_mov_ps(max_dot_v, greater, d_v);
+                max_idx_v = _mm512_mask_mov_epi32(max_idx_v, greater, idx_v);
+                idx_v = _mm512_add_epi32(idx_v, stride_v);
+                }
+
+            // the first vertex with the maximum has the smallest index of the channels that hold it
+            __m512 all_max_v = _mm512_set1_ps(_mm512_reduce_max_ps(max_dot_v));
+            __mmask16 is_max = _mm512_cmp_ps_mask(max_dot_v, all_max_v, _CMP_EQ_OQ);
+            max_idx = (unsigned int)_mm512_mask_reduce_min_epi32(is_max, max_idx_v);
+#elif !defined(__HIPCC__) && defined(__AVX__) \
     && (defined(SINGLE_PRECISION) || defined(ENABLE_HPMC_MIXED_PRECISION))
             // process dot products with AVX 8 at a time on the CPU when working with more than
             // 4 verts
@@ -388,7 +423,8 @@ class SupportFuncConvexPolyhedron
                 }
 #else
 
-            // if no AVX or SSE, or running in double precision, fall back on serial computation
+            // if no AVX-512, AVX or SSE, or running in double precision, fall back on serial
+            // computation
             // this code path also triggers on the GPU
 
             OverlapReal max_dot0 = dot(n, vec3<OverlapReal>(verts.x[0], verts.y[0], verts.z[0]));
@@ -200,18 +200,19 @@ namespace detail
 
     @pre M has 10 elements
 */
-DEVICE inline void compute_ellipsoid_matrix(OverlapReal* M,
-                                            const vec3<OverlapReal>& pos,
-                                            const quat<OverlapReal>& orientation,
+template<class Real>
+DEVICE inline void compute_ellipsoid_matrix(Real* M,
+                                            const vec3<Real>& pos,
+                                            const quat<Real>& orientation,
                                             const EllipsoidParams& axes)
     {
     // calculate rotation matrix
-    rotmat3<OverlapReal> R(orientation);
+    rotmat3<Real> R(orientation);
 
     // calculate ellipsoid matrix
-    OverlapReal a = OverlapReal(1.0) / (axes.x * axes.x);
-    OverlapReal b = OverlapReal(1.0) / (axes.y * axes.y);
-    OverlapReal c = OverlapReal(1.0) / (axes.z * axes.z);
+    Real a = Real(1.0) / (Real(axes.x) * Real(axes.x));
+    Real b = Real(1.0) / (Real(axes.y) * Real(axes.y));
+    Real c = Real(1.0) / (Real(axes.z) * Real(axes.z));
     // ...rotation part
     // M[i][j] = a * R[i][0] * R[j][0] + b * R[i][1] * R[j][1] + c * R[i][2] * R[j][2];
     M[0] = a * R.row0.x * R.row0.x + b * R.row0.y * R.row0.y + c * R.row0.z * R.row0.z;
@@ -223,15 +224,15 @@ DEVICE inline void compute_ellipsoid_matrix(OverlapReal* M,
 
     // calculateTranslationPart(x, M);
     // precalculation
-    OverlapReal M0x0 = M[0] * pos.x;
-    OverlapReal M1x0 = M[1] * pos.x;
-    OverlapReal M1x1 = M[1] * pos.y;
-    OverlapReal M2x1 = M[2] * pos.y;
-    OverlapReal M3x0 = M[3] * pos.x;
-    OverlapReal M3x2 = M[3] * pos.z;
-    OverlapReal M4x1 = M[4] * pos.y;
-    OverlapReal M4x2 = M[4] * pos.z;
-    OverlapReal M5x2 = M[5] * pos.z;
+    Real M0x0 = M[0] * pos.x;
+    Real M1x0 = M[1] * pos.x;
+    Real M1x1 = M[1] * pos.y;
+    Real M2x1 = M[2] * pos.y;
+    Real M3x0 = M[3] * pos.x;
+    Real M3x2 = M[3] * pos.z;
+    Real M4x1 = M[4] * pos.y;
+    Real M4x2 = M[4] * pos.z;
+    Real M5x2 = M[5] * pos.z;
 
     // ...translation part
     // M[i][3] = M[3][i] = -M[i][0] * x[0] - M[i][1] * x[1] - M[i][2] * x[2];
@@ -241,8 +242,8 @@ DEVICE inline void compute_ellipsoid_matrix(OverlapReal* M,
     // ...mixed part
     // M[3][3] = -1.0 + M[0][0] * x[0] * x[0] + M[1][1] * x[1] * x[1] + M[2][2] * x[2] * x[2] +
     //           2.0 * (M[0][1] * x[0] * x[1] + M[1][2] * x[1] * x[2] + M[2][0] * x[2] * x[0]);
-    M[9] = OverlapReal(-1.0) + pos.x * (M0x0 + OverlapReal(2.0) * M1x1)
-           + pos.y * (M2x1 + OverlapReal(2.0) * M4x2) + pos.z * (M5x2 + OverlapReal(2.0) * M3x0);
+    M[9] = Real(-1.0) + pos.x * (M0x0 + Real(2.0) * M1x1) + pos.y * (M2x1 + Real(2.0) * M4x2)
+           + pos.z * (M5x2 + Real(2.0) * M3x0);
     }
 
 /** Checks for overlap between two ellipsoids
@@ -253,7 +254,7 @@ DEVICE inline void compute_ellipsoid_matrix(OverlapReal* M,
 
     @pre Both M1 and M2 are 10 elements
 */
-DEVICE inline int test_overlap_ellipsoids(OverlapReal* M1, OverlapReal* M2)
+DEVICE inline int test_overlap_ellipsoids(const double* M1, const double* M2)
     {
     // FIRST: calculate the coefficients a4, a3, a2, a1, a0 of the
     // characteristic polynomial that interpolates between M1 and M2
@@ -451,7 +452,6 @@ DEVICE inline bool test_overlap<ShapeEllipsoid, ShapeEllipsoid>(const vec3<Scala
                                                                 const ShapeEllipsoid& b,
                                                                 unsigned int& err)
     {
-    // matrix representations of the two ellipsoids
     vec3<OverlapReal> dr(r_ab);
 
     // shortcut if ellipsoids are actually spheres
@@ -462,12 +462,17 @@ DEVICE inline bool test_overlap<ShapeEllipsoid, ShapeEllipsoid>(const vec3<Scala
         return (dot(dr, dr) <= ab * ab);
         }
 
-    OverlapReal Ma[10], Mb[10];
+    // matrix representations of the two ellipsoids
+    // The characteristic polynomial is evaluated in double precision, and so are the matrices, also
+    // with ENABLE_HPMC_MIXED_PRECISION. The constant element M[9] cancels terms of order
+    // (r/axis)^2, which leaves too few significant digits in single precision to decide overlaps
+    // close to contact of flat or elongated ellipsoids.
+    double Ma[10], Mb[10];
     detail::compute_ellipsoid_matrix(Ma,
-                                     vec3<OverlapReal>(0, 0, 0),
-                                     quat<OverlapReal>(a.orientation),
+                                     vec3<double>(0, 0, 0),
+                                     quat<double>(a.orientation),
                                      a.axes);
-    detail::compute_ellipsoid_matrix(Mb, dr, quat<OverlapReal>(b.orientation), b.axes);
+    detail::compute_ellipsoid_matrix(Mb, vec3<double>(r_ab), quat<double>(b.orientation), b.axes);
 
     int ret_val = detail::test_overlap_ellipsoids(Ma, Mb);
     if (ret_val == ELLIPSOID_OVERLAP_ERROR)
@@ -948,6 +948,90 @@ inline bool BVHCollision(const ShapePolyhedron& a,
             }
         }
     }
+
+//! Traverse the bounding volume test tree with a stack, four children at a time
+/*! Each step descends into the node with the larger volume and tests the other node's OBB against
+    the (up to four) wide children of that node, which collapse two levels of the binary tree,
+    with one SIMD separating axis test. The OBBs of a are transformed into the frame of b and those
+    of b into the frame of a, so that the SoA OBBs of the wide nodes never need to be transformed.
+*/
+inline bool BVHCollisionWide(const ShapePolyhedron& a,
+                             const ShapePolyhedron& b,
+                             const quat<OverlapReal>& q,
+                             const vec3<OverlapReal>& dr,
+                             unsigned int& err,
+                             OverlapReal abs_tol)
+    {
+    // transformation from the frame of b into the frame of a
+    quat<OverlapReal> q_inv = conj(q);
+    vec3<OverlapReal> dr_inv = -rotate(q_inv, dr);
+
+    detail::OBB obb_a = a.tree.getOBB(0);
+    obb_a.affineTransform(q, dr);
+    if (!overlap(obb_a, b.tree.getOBB(0)))
+        return false;
+
+    const unsigned int max_stack = 256;
+    unsigned int stack_a[max_stack];
+    unsigned int stack_b[max_stack];
+    unsigned int n_stack = 0;
+    stack_a[n_stack] = 0;
+    stack_b[n_stack] = 0;
+    n_stack++;
+
+    while (n_stack > 0)
+        {
+        // the OBBs of the nodes on the stack are known to overlap
+        n_stack--;
+        unsigned int node_a = stack_a[n_stack];
+        unsigned int node_b = stack_b[n_stack];
+        bool leaf_a = a.tree.isLeaf(node_a);
+        bool leaf_b = b.tree.isLeaf(node_b);
+
+        if (leaf_a && leaf_b)
+            {
+            if (test_narrow_phase_overlap(dr, a, b, node_a, node_b, err, abs_tol))
+                return true;
+            continue;
+            }
+
+        if (n_stack + detail::WIDE_OBB_WIDTH > max_stack)
+            {
+            // very deep trees, finish this pair recursively
+            if (BVHCollision(a, b, node_a, node_b, q, dr, err, abs_tol))
+                return true;
+            continue;
+            }
+
+        detail::OBB node_obb_a = a.tree.getOBB(node_a);
+        detail::OBB node_obb_b = b.tree.getOBB(node_b);
+        bool descend_b = leaf_a || (!leaf_b && node_obb_b.getVolume() >= node_obb_a.getVolume());
+
+        unsigned int hits;
+        if (descend_b)
+            {
+            node_obb_a.affineTransform(q, dr);
+            hits = b.tree.overlapWideNode(node_obb_a, node_b);
+            }
+        else
+            {
+            node_obb_b.affineTransform(q_inv, dr_inv);
+            hits = a.tree.overlapWideNode(node_obb_b, node_a);
+            }
+
+        for (unsigned int l = 0; l < detail::WIDE_OBB_WIDTH; ++l)
+            {
+            if (!(hits & (1u << l)))
+                continue;
+
+            stack_a[n_stack] = descend_b ? node_a : a.tree.getWideChild(node_a, l);
+            stack_b[n_stack] = descend_b ? b.tree.getWideChild(node_b, l) : node_b;
+            n_stack++;
+            }
+        }
+
+    return false;
+    }
 #endif
 
 /** Polyhedron overlap test
@@ -1047,7 +1131,7 @@ DEVICE inline bool test_overlap(const vec3<Scalar>& r_ab,
     quat<OverlapReal> q(conj(b.orientation) * a.orientation);
 
 #ifndef __HIPCC__
-    if (BVHCollision(a, b, 0, 0, q, dr_rot, err, abs_tol))
+    if (BVHCollisionWide(a, b, q, dr_rot, err, abs_tol))
         return true;
 #else
 
@@ -272,6 +272,40 @@ test_overlap(const vec3<Scalar>& r_ab, const ShapeA& a, const ShapeB& b, unsigne
     return true;
     }
 
+//! Per particle cache of orientation dependent shape data
+/*! IntegratorHPMCMono keeps one cache entry for each local and ghost particle and attaches the
+    entries to the shapes it constructs for overlap checks. The entries are relative to the
+    particle position, so they depend only on the orientation and remain valid after translation
+    moves.
+
+    Shapes with expensive orientation dependent data specialize ShapeCache (see ShapeUnion). The
+    default stores nothing and attach() leaves the shape unchanged.
+
+    \ingroup shape
+*/
+template<class Shape> class ShapeCache
+    {
+    public:
+    //! Test if the shape uses the cache
+    static bool isEnabled()
+        {
+        return false;
+        }
+
+    //! Resize the cache to hold N entries
+    /*! \param N Number of entries
+        \param params Shape parameters, per type
+        \param n_types Number of types
+    */
+    void resize(unsigned int N, const typename Shape::param_type* params, unsigned int n_types) { }
+
+    //! Compute the entry of particle i
+    void set(unsigned int i, const Shape& shape) { }
+
+    //! Attach the entry of particle i to a shape
+    void attach(unsigned int i, Shape& shape) const { }
+    };
+
 //! Sphere-Sphere overlap
 /*! \param r_ab Vector defining the position of shape b relative to shape a (r_b - r_a)
     \param a first shape
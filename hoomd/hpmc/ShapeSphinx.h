@@ -9,6 +9,8 @@
 #include "hoomd/HOOMDMath.h"
 #include "hoomd/VectorMath.h"
 
+#include <cfloat>
+
 #ifdef __HIPCC__
 #define DEVICE __device__
 #define HOSTDEVICE __host__ __device__
@@ -205,6 +207,21 @@ struct ShapeSphinx
                             disjoint = false;
                 }
         volume = detail::initVolume(disjoint, r, n, d);
+
+        // find the single positive sphere of dimpled shapes and check if the center is inside
+        n_positive = 0;
+        positive = 0;
+        center_inside = true;
+        for (unsigned int i = 0; i < n; i++)
+            {
+            if (s[i] > 0)
+                {
+                n_positive++;
+                positive = i;
+                }
+            if ((s[i] > 0) != (dot(u[i], u[i]) < R[i]))
+                center_inside = false;
+            }
         }
 
     /// Check if the shape may be rotated
@@ -259,6 +276,95 @@ struct ShapeSphinx
         return false;
         }
 
+    /** Length of the segment from the center along a direction that is inside the shape
+
+        @param v Sphere centers rotated into the space frame
+        @param e Unit vector in the space frame
+        @returns The largest t such that the points t' e, 0 <= t' < t, are all inside the shape, or
+            0 when the center is outside the shape
+    */
+    DEVICE OverlapReal getRadialExtent(const vec3<OverlapReal>* v, const vec3<OverlapReal>& e) const
+        {
+        if (!center_inside || n == 0)
+            return OverlapReal(0.0);
+
+        // |t e - v_i|^2 = R_i is quadratic in t, the center is inside all positive spheres and
+        // outside all negative spheres
+        OverlapReal extent = OverlapReal(FLT_MAX);
+        for (unsigned int i = 0; i < n; i++)
+            {
+            OverlapReal b = dot(e, v[i]);
+            OverlapReal c = dot(v[i], v[i]) - R[i];
+            OverlapReal disc = b * b - c;
+            if (s[i] > 0)
+                {
+                // leave the positive sphere
+                extent = detail::min(extent, b + fast::sqrt(detail::max(disc, OverlapReal(0.0))));
+                }
+            else if (b > OverlapReal(0.0) && disc > OverlapReal(0.0))
+                {
+                // enter the negative sphere
+                extent = detail::min(extent, b - fast::sqrt(disc));
+                }
+            }
+        return extent;
+        }
+
+    /** Upper bound on the support function of the shape
+
+        @param v Sphere centers rotated into the space frame
+        @param e Unit vector in the space frame
+        @returns A value h such that x . e <= h for all points x of the shape
+
+        With one positive sphere, the maximum of x . e is either the pole of the positive sphere or
+        lies on the rim of a negative sphere cut out of it, and the bound is exact. Otherwise, the
+        shape is bounded by each positive sphere.
+    */
+    DEVICE OverlapReal getSupport(const vec3<OverlapReal>* v, const vec3<OverlapReal>& e) const
+        {
+        if (n_positive != 1)
+            {
+            OverlapReal support = OverlapReal(FLT_MAX);
+            for (unsigned int i = 0; i < n; i++)
+                if (s[i] > 0)
+                    support = detail::min(support, dot(v[i], e) + r[i]);
+            return support;
+            }
+
+        OverlapReal r0 = r[positive];
+        vec3<OverlapReal> pole = v[positive] + r0 * e;
+        bool pole_inside = true;
+        OverlapReal support = -OverlapReal(FLT_MAX);
+        for (unsigned int k = 0; k < n; k++)
+            {
+            if (k == positive)
+                continue;
+
+            vec3<OverlapReal> dv = v[k] - v[positive];
+            if (dot(pole - v[k], pole - v[k]) < R[k])
+                pole_inside = false;
+
+            // the rim is the circle where the negative sphere intersects the positive sphere
+            OverlapReal dsq = dot(dv, dv);
+            OverlapReal dist = fast::sqrt(dsq);
+            OverlapReal rk = -r[k];
+            if (dist >= r0 + rk || dist <= detail::max(r0 - rk, rk - r0))
+                continue;
+
+            OverlapReal offset = (dsq + r0 * r0 - R[k]) / (OverlapReal(2.0) * dist);
+            OverlapReal rim_radius_sq = detail::max(r0 * r0 - offset * offset, OverlapReal(0.0));
+            OverlapReal cos_e = dot(dv, e) / dist;
+            OverlapReal sin_e_sq = detail::max(OverlapReal(1.0) - cos_e * cos_e, OverlapReal(0.0));
+            support = detail::max(support,
+                                  dot(v[positive], e) + offset * cos_e
+                                      + fast::sqrt(rim_radius_sq * sin_e_sq));
+            }
+
+        if (pole_inside || support == -OverlapReal(FLT_MAX))
+            support = detail::max(support, dot(pole, e));
+        return support;
+        }
+
     /// Orientation of the sphinx
     quat<Scalar> orientation;
 
@@ -293,6 +399,15 @@ struct ShapeSphinx
 
     OverlapReal volume;
 
+    /// Number of positive spheres
+    unsigned int n_positive;
+
+    /// Index of the last positive sphere
+    unsigned int positive;
+
+    /// True when the center of the shape is inside the shape
+    bool center_inside;
+
     /// shape parameters
     const detail::SphinxParams& spheres;
     };
@@ -333,6 +448,23 @@ DEVICE inline bool test_overlap<ShapeSphinx, ShapeSphinx>(const vec3<Scalar>& r_
     vec3<OverlapReal> x(0.0, 0.0, 0.0);
     vec3<OverlapReal> y(r_ab);
 
+    // bound the contact distance along the line between the centers before the exact test
+    OverlapReal rsq = dot(y, y);
+    if (rsq > OverlapReal(0.0))
+        {
+        const OverlapReal tol(1e-5);
+        OverlapReal dist = fast::sqrt(rsq);
+        vec3<OverlapReal> e = y / dist;
+
+        // the segments inside the shapes cover the line between the centers
+        if (p.getRadialExtent(pv, e) + q.getRadialExtent(qv, -e) > dist * (OverlapReal(1.0) + tol))
+            return true;
+
+        // a plane perpendicular to the line separates the shapes
+        if (p.getSupport(pv, e) + q.getSupport(qv, -e) < dist * (OverlapReal(1.0) - tol))
+            return false;
+        }
+
     if (p.disjoint && q.disjoint)
         {
         if ((p.n == 1) && (q.n == 1))
@@ -19,7 +19,9 @@
 #else
 #define DEVICE
 #define HOSTDEVICE
+#include <algorithm>
 #include <iostream>
+#include <vector>
 #endif
 
 namespace hpmc
@@ -343,6 +345,23 @@ template<class Shape> struct ShapeUnionParams : ShapeParams
     vec3<OverlapReal> upper;
     } __attribute__((aligned(32)));
 
+/** Member data of a ShapeUnion rotated by the orientation of a particle
+
+    ShapeCache<ShapeUnion> computes these once per particle so that overlap checks against several
+    neighbors only translate the member tree instead of rotating every visited node.
+*/
+struct RotatedUnionMembers
+    {
+    /// Node OBBs of the member tree
+    const OBB* obbs = nullptr;
+
+    /// Member positions
+    const vec3<OverlapReal>* mpos = nullptr;
+
+    /// Member orientations
+    const quat<OverlapReal>* morientation = nullptr;
+    };
+
     } // end namespace detail
 
 /** Shape consisting of union of shapes of a single type but individual parameters.
@@ -366,7 +385,7 @@ template<class Shape> struct ShapeUnion
 
     /// Construct a shape at a given orientation
     DEVICE ShapeUnion(const quat<Scalar>& _orientation, const param_type& _params)
-        : orientation(_orientation), members(_params)
+        : orientation(_orientation), members(_params), rotated(nullptr)
         {
         }
 
@@ -445,6 +464,9 @@ template<class Shape> struct ShapeUnion
 
     /// Member data
     const param_type& members;
+
+    /// Member data rotated by the orientation, when attached by ShapeCache
+    const detail::RotatedUnionMembers* rotated;
     };
 
 template<class Shape>
@@ -524,12 +546,131 @@ DEVICE inline bool test_narrow_phase_overlap(vec3<OverlapReal> dr,
     return false;
     }
 
+/** Test for overlaps between the members in two leaf nodes, using the rotated member data
+
+    @param r_ab Vector from the center of a to the center of b
+    @param a First shape, with rotated member data
+    @param b Second shape, with rotated member data
+    @param cur_node_a Leaf node of a
+    @param cur_node_b Leaf node of b
+    @param err Incremented if there is an error condition
+*/
+template<class Shape>
+DEVICE inline bool test_narrow_phase_overlap_rotated(const vec3<OverlapReal>& r_ab,
+                                                     const ShapeUnion<Shape>& a,
+                                                     const ShapeUnion<Shape>& b,
+                                                     unsigned int cur_node_a,
+                                                     unsigned int cur_node_b,
+                                                     unsigned int& err)
+    {
+    unsigned int ptls_i_end = a.members.tree.getLeafNodePtrByNode(cur_node_a + 1);
+    unsigned int ptls_j_begin = b.members.tree.getLeafNodePtrByNode(cur_node_b);
+    unsigned int ptls_j_end = b.members.tree.getLeafNodePtrByNode(cur_node_b + 1);
+
+    for (unsigned int ptl_i = a.members.tree.getLeafNodePtrByNode(cur_node_a);
+         ptl_i < ptls_i_end;
+         ptl_i++)
+        {
+        unsigned int ishape = a.members.tree.getParticleByIndex(ptl_i);
+        unsigned int overlap_i = a.members.moverlap[ishape];
+
+        Shape shape_i(quat<Scalar>(), a.members.mparams[ishape]);
+        if (shape_i.hasOrientation())
+            shape_i.orientation = a.rotated->morientation[ishape];
+
+        // work in a frame centered on b
+        vec3<OverlapReal> pos_i = a.rotated->mpos[ishape] - r_ab;
+
+        for (unsigned int ptl_j = ptls_j_begin; ptl_j < ptls_j_end; ptl_j++)
+            {
+            unsigned int jshape = b.members.tree.getParticleByIndex(ptl_j);
+            if (!(overlap_i & b.members.moverlap[jshape]))
+                continue;
+
+            Shape shape_j(quat<Scalar>(), b.members.mparams[jshape]);
+            if (shape_j.hasOrientation())
+                shape_j.orientation = b.rotated->morientation[jshape];
+
+            // reject distant members by their circumspheres before the full overlap check
+            vec3<OverlapReal> r_ij = b.rotated->mpos[jshape] - pos_i;
+            OverlapReal DaDb
+                = shape_i.getCircumsphereDiameter() + shape_j.getCircumsphereDiameter();
+            if (OverlapReal(4.0) * dot(r_ij, r_ij) > DaDb * DaDb)
+                continue;
+
+            if (test_overlap(r_ij, shape_i, shape_j, err))
+                return true;
+            }
+        }
+
+    return false;
+    }
+
+/** Test for overlaps between two unions, using the rotated member data
+
+    @param r_ab Vector from the center of a to the center of b
+    @param a First shape, with rotated member data
+    @param b Second shape, with rotated member data
+    @param err Incremented if there is an error condition
+
+    The rotated member data of both shapes share the orientation of the simulation box, so the
+    tandem traversal only needs to translate the nodes of a.
+*/
+template<class Shape>
+DEVICE inline bool test_overlap_rotated(const vec3<Scalar>& r_ab,
+                                        const ShapeUnion<Shape>& a,
+                                        const ShapeUnion<Shape>& b,
+                                        unsigned int& err)
+    {
+    const detail::GPUTree& tree_a = a.members.tree;
+    const detail::GPUTree& tree_b = b.members.tree;
+
+    // perform a tandem tree traversal in a frame centered on b
+    unsigned long int stack = 0;
+    unsigned int cur_node_a = 0;
+    unsigned int cur_node_b = 0;
+
+    vec3<OverlapReal> dr(-r_ab);
+
+    detail::OBB obb_a = a.rotated->obbs[cur_node_a];
+    obb_a.center += dr;
+
+    detail::OBB obb_b = b.rotated->obbs[cur_node_b];
+
+    unsigned int query_node_a = UINT_MAX;
+    unsigned int query_node_b = UINT_MAX;
+
+    while (cur_node_a != tree_a.getNumNodes() && cur_node_b != tree_b.getNumNodes())
+        {
+        query_node_a = cur_node_a;
+        query_node_b = cur_node_b;
+
+        if (detail::traverseBinaryStackRotated(tree_a,
+                                               tree_b,
+                                               cur_node_a,
+                                               cur_node_b,
+                                               stack,
+                                               obb_a,
+                                               obb_b,
+                                               a.rotated->obbs,
+                                               b.rotated->obbs,
+                                               dr)
+            && test_narrow_phase_overlap_rotated(-dr, a, b, query_node_a, query_node_b, err))
+            return true;
+        }
+
+    return false;
+    }
+
 template<class Shape>
 DEVICE inline bool test_overlap(const vec3<Scalar>& r_ab,
                                 const ShapeUnion<Shape>& a,
                                 const ShapeUnion<Shape>& b,
                                 unsigned int& err)
     {
+    if (a.rotated && b.rotated)
+        return test_overlap_rotated(r_ab, a, b, err);
+
     const detail::GPUTree& tree_a = a.members.tree;
     const detail::GPUTree& tree_b = b.members.tree;
 
@@ -1499,6 +1640,107 @@ DEVICE inline bool isPointInExcludedVolumeIntersection(const ShapeUnion<Shape>&
     return false;
     }
 
+#ifndef __HIPCC__
+/** Cache the member data of unions rotated by the particle orientations
+
+    Each entry stores the member tree OBBs, member positions, and member orientations of one
+    particle rotated by its orientation. Entries have a fixed stride given by the largest tree and
+    member count over all types, so that set() may be called for different particles in parallel.
+*/
+template<class Shape> class ShapeCache<ShapeUnion<Shape>>
+    {
+    public:
+    /// Test if the shape uses the cache
+    static bool isEnabled()
+        {
+        return true;
+        }
+
+    /** Resize the cache to hold N entries
+
+        @param N Number of entries
+        @param params Shape parameters, per type
+        @param n_types Number of types
+    */
+    void resize(unsigned int N,
+                const typename ShapeUnion<Shape>::param_type* params,
+                unsigned int n_types)
+        {
+        m_max_nodes = 0;
+        m_max_members = 0;
+        for (unsigned int type = 0; type < n_types; type++)
+            {
+            m_max_nodes = std::max(m_max_nodes, params[type].tree.getNumNodes());
+            m_max_members = std::max(m_max_members, params[type].N);
+            }
+
+        m_rotated.resize(N);
+        m_obbs.resize(size_t(N) * m_max_nodes);
+        m_mpos.resize(size_t(N) * m_max_members);
+        m_morientation.resize(size_t(N) * m_max_members);
+        }
+
+    /// Compute the entry of particle i
+    void set(unsigned int i, const ShapeUnion<Shape>& shape)
+        {
+        const auto& members = shape.members;
+        unsigned int n_nodes = members.tree.getNumNodes();
+        detail::RotatedUnionMembers& rotated = m_rotated[i];
+        if (n_nodes == 0)
+            {
+            rotated.obbs = nullptr;
+            return;
+            }
+
+        quat<OverlapReal> q(shape.orientation);
+        detail::OBB* obbs = m_obbs.data() + size_t(i) * m_max_nodes;
+        for (unsigned int node = 0; node < n_nodes; node++)
+            {
+            obbs[node] = members.tree.getOBB(node);
+            obbs[node].affineTransform(q, vec3<OverlapReal>(0, 0, 0));
+            }
+
+        vec3<OverlapReal>* mpos = m_mpos.data() + size_t(i) * m_max_members;
+        quat<OverlapReal>* morientation = m_morientation.data() + size_t(i) * m_max_members;
+        for (unsigned int member = 0; member < members.N; member++)
+            {
+            mpos[member] = rotate(q, members.mpos[member]);
+            morientation[member] = q * members.morientation[member];
+            }
+
+        rotated.obbs = obbs;
+        rotated.mpos = mpos;
+        rotated.morientation = morientation;
+        }
+
+    /// Attach the entry of particle i to a shape
+    void attach(unsigned int i, ShapeUnion<Shape>& shape) const
+        {
+        shape.rotated = m_rotated[i].obbs ? &m_rotated[i] : nullptr;
+        }
+
+    private:
+    /// Largest number of tree nodes over all types
+    unsigned int m_max_nodes = 0;
+
+    /// Largest number of members over all types
+    unsigned int m_max_members = 0;
+
+    /// Rotated member data of each particle
+    std::vector<detail::RotatedUnionMembers> m_rotated;
+
+    /// Storage for the rotated OBBs
+    std::vector<detail::OBB> m_obbs;
+
+    /// Storage for the rotated member positions
+    std::vector<vec3<OverlapReal>> m_mpos;
+
+    /// Storage for the rotated member orientations
+    std::vector<quat<OverlapReal>> m_morientation;
+    };
+
+#endif
+
 #ifndef __HIPCC__
 template<> inline std::string getShapeSpec(const ShapeUnion<ShapeSphere>& sphere_union)
     {
@@ -230,6 +230,25 @@ inline bool UpdaterBoxMC::box_resize_trial(Scalar Lx,
     {
     // Make a backup copy of position data
     unsigned int N_backup = m_pdata->getN();
+#ifdef ENABLE_HIP
+    if (m_exec_conf->isCUDAEnabled())
+        {
+        // keep the positions on the device, the GPU integrators scale and check them there
+        ArrayHandle<Scalar4> d_pos(m_pdata->getPositions(),
+                                   access_location::device,
+                                   access_mode::read);
+        ArrayHandle<Scalar4> d_pos_backup(m_pos_backup,
+                                          access_location::device,
+                                          access_mode::overwrite);
+        hipMemcpy(d_pos_backup.data,
+                  d_pos.data,
+                  sizeof(Scalar4) * N_backup,
+                  hipMemcpyDeviceToDevice);
+        if (m_exec_conf->isCUDAErrorCheckingEnabled())
+            CHECK_CUDA_ERROR();
+        }
+    else
+#endif
         {
         ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(),
                                    access_location::host,
@@ -282,6 +301,32 @@ inline bool UpdaterBoxMC::box_resize_trial(Scalar Lx,
     else
         {
         // Restore original box and particle positions
+        unsigned int N = m_pdata->getN();
+        if (N != N_backup)
+            {
+            this->m_exec_conf->msg->error()
+                << "update.boxmc"
+                << ": Number of particles mismatch when rejecting box resize" << std::endl;
+            throw std::runtime_error("Error resizing box");
+            // note, this error should never appear (because particles are not migrated after a
+            // box resize), but is left here as a sanity check
+            }
+
+#ifdef ENABLE_HIP
+        if (m_exec_conf->isCUDAEnabled())
+            {
+            ArrayHandle<Scalar4> d_pos(m_pdata->getPositions(),
+                                       access_location::device,
+                                       access_mode::readwrite);
+            ArrayHandle<Scalar4> d_pos_backup(m_pos_backup,
+                                              access_location::device,
+                                              access_mode::read);
+            hipMemcpy(d_pos.data, d_pos_backup.data, sizeof(Scalar4) * N, hipMemcpyDeviceToDevice);
+            if (m_exec_conf->isCUDAErrorCheckingEnabled())
+                CHECK_CUDA_ERROR();
+            }
+        else
+#endif
             {
             ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(),
                                        access_location::host,
@@ -289,16 +334,6 @@ inline bool UpdaterBoxMC::box_resize_trial(Scalar Lx,
             ArrayHandle<Scalar4> h_pos_backup(m_pos_backup,
                                               access_location::host,
                                               access_mode::read);
-            unsigned int N = m_pdata->getN();
-            if (N != N_backup)
-                {
-                this->m_exec_conf->msg->error()
-                    << "update.boxmc"
-                    << ": Number of particles mismatch when rejecting box resize" << std::endl;
-                throw std::runtime_error("Error resizing box");
-                // note, this error should never appear (because particles are not migrated after a
-                // box resize), but is left here as a sanity check
-                }
             memcpy(h_pos.data, h_pos_backup.data, sizeof(Scalar4) * N);
             }
 
@@ -10,8 +10,10 @@
 #include "hoomd/RandomNumbers.h"
 #include "hoomd/RNGIdentifiers.h"
 
-#include <set>
+#include <atomic>
 #include <list>
+#include <memory>
+#include <set>
 
 #include "Moves.h"
 #include "HPMCCounters.h"
@@ -20,10 +22,8 @@
 #ifdef ENABLE_TBB
 #include <tbb/concurrent_unordered_map.h>
 #include <tbb/concurrent_unordered_set.h>
-#include <tbb/concurrent_vector.h>
 #include <tbb/parallel_for.h>
-#include <tbb/task.h>
-#include <atomic>
+#include <tbb/task_arena.h>
 
 #if TBB_VERSION_MAJOR < 2021
 #define ENABLE_TBB_TASK
@@ -37,53 +37,19 @@ namespace hpmc
 namespace detail
 {
 
-#ifdef ENABLE_TBB_TASK
-//! Wrapper around std::atomic_flag to allow use in a std::vector
-class my_atomic_flag
-    {
-    public:
-        //! Default constructor
-        my_atomic_flag()
-            {
-            f.clear();
-            }
-
-        //! Copy constructor
-        /*! \note this constructor doesn't really copy the value of its argument,
-            it just reset's the flag to zero
-         */
-        my_atomic_flag(const my_atomic_flag& other)
-            {
-            f.clear();
-            }
-
-        //! Assignment operator (non-atomic)
-        /*! \note this assignment operator doesn't really copy the value of its argument,
-            it just reset's the flag to zero
-         */
-        my_atomic_flag& operator =( const my_atomic_flag& other)
-            {
-            f.clear();
-            return *this;
-            }
-
-        //! Sets flag and returns old value
-        bool test_and_set()
-            {
-            return f.test_and_set();
-            }
-
-    private:
-        std::atomic_flag f;
-    };
-#endif
-
-// Graph class represents a undirected graph
-// using adjacency list representation
+//! Undirected graph of particle bonds with concurrent union-find connected components
+/*! Edges are merged into a disjoint set forest as they are added, so that the connected
+    components are available once all edges have been inserted. addEdge() may be called
+    concurrently from multiple threads. The forest is maintained lock-free, following the
+    hooking and path compression scheme of ECL-CC (Jaiganesh and Burtscher 2018, see
+    extern/ECL.cuh): a vertex always points to a vertex with a lower index, so that the
+    representative of a component is its lowest vertex index.
+*/
 class Graph
     {
     public:
         Graph()
+            : m_V(0), m_capacity(0)
             {
             }
 
@@ -93,13 +59,9 @@ class Graph
 
         inline void addEdge(unsigned int v, unsigned int w);
 
-        #ifdef ENABLE_TBB_TASK
-        inline void connectedComponents(std::vector<tbb::concurrent_vector<unsigned int> >& cc);
-        #else
         inline void connectedComponents(std::vector<std::vector<unsigned int> >& cc);
-        #endif
 
-        #ifdef ENABLE_TBB_TASK
+        #ifdef ENABLE_TBB
         void setTaskArena(std::shared_ptr<tbb::task_arena> task_arena)
             {
             m_task_arena = task_arena;
@@ -107,161 +69,124 @@ class Graph
         #endif
 
     private:
-        #ifndef ENABLE_TBB_TASK
-        std::multimap<unsigned int,unsigned int> adj;
-        #else
-        tbb::concurrent_unordered_multimap<unsigned int, unsigned int> adj;
-        #endif
+        unsigned int m_V;           //!< Number of vertices
+        unsigned int m_capacity;    //!< Number of allocated vertices
 
-        #ifndef ENABLE_TBB_TASK
-        std::vector<unsigned int> visited;
-        #else
-        std::vector<my_atomic_flag> visited;
-        #endif
+        //! Parent of every vertex in the disjoint set forest
+        std::unique_ptr<std::atomic<unsigned int>[]> m_parent;
 
-        #ifdef ENABLE_TBB_TASK
+        std::vector<unsigned int> m_label; //!< Temporary storage for the component index of a root
+
+        #ifdef ENABLE_TBB
         /// The TBB task arena
         std::shared_ptr<tbb::task_arena> m_task_arena;
         #endif
 
-        #ifndef ENABLE_TBB_TASK
-        // A function used by DFS
-        inline void DFSUtil(unsigned int v, std::vector<unsigned int>& visited, std::vector<unsigned int>& cur_cc);
-        #endif
-
-        #ifdef ENABLE_TBB_TASK
-        class DFSTask : public tbb::task
-            {
-            public:
-                DFSTask(unsigned int _root, std::vector<my_atomic_flag>& _visited,
-                    tbb::concurrent_vector<unsigned int>& _cc,
-                    const tbb::concurrent_unordered_multimap<unsigned int, unsigned int>& _adj)
-                    : root(_root), visited(_visited), cc(_cc), adj(_adj)
-                    { }
-
-                tbb::task* execute()
-                    {
-                    cc.push_back(root);
-
-                    unsigned int count = 0;
-                    tbb::task_list list;
-
-                    auto begin = adj.equal_range(root).first;
-                    auto end = adj.equal_range(root).second;
-
-                    for (auto it = begin; it != end; ++it)
-                        {
-                        unsigned int neighbor = it->second;
-                        if (!visited[neighbor].test_and_set())
-                            {
-                            if (count++ == 0)
-                                {
-                                root = neighbor; // for task recycling
-                                continue;
-                                }
-                            list.push_back(*new(allocate_child()) DFSTask(neighbor, visited, cc, adj));
-                            }
-                        }
-
-                    if (count)
-                        {
-                        set_ref_count(count);
-                        spawn(list);
-
-                        recycle_as_safe_continuation();
-                        }
-
-                    return NULL;
-                    }
-
-            private:
-                unsigned int root;
-                std::vector<my_atomic_flag> & visited;
-                tbb::concurrent_vector<unsigned int>& cc;
-                const tbb::concurrent_unordered_multimap<unsigned int, unsigned int>& adj;
-            };
-        #endif // ENABLE_TBB_TASK
-
+        //! Find the representative of vertex v, compressing the path along the way
+        inline unsigned int representative(unsigned int v);
     };
 
-// Gather connected components in an undirected graph
-#ifdef ENABLE_TBB_TASK
-void Graph::connectedComponents(std::vector<tbb::concurrent_vector<unsigned int> >& cc)
-#else
-void Graph::connectedComponents(std::vector<std::vector<unsigned int> >& cc)
-#endif
+Graph::Graph(unsigned int V)
+    : m_V(0), m_capacity(0)
     {
-    #ifdef ENABLE_TBB_TASK
-    this->m_task_arena->execute([&]{
-    for (unsigned int v = 0; v < visited.size(); ++v)
+    resize(V);
+    }
+
+void Graph::resize(unsigned int V)
+    {
+    if (V > m_capacity)
         {
-        if (! visited[v].test_and_set())
-            {
-            tbb::concurrent_vector<unsigned int> component;
-            DFSTask& a = *new(tbb::task::allocate_root()) DFSTask(v, visited, component, adj);
-            tbb::task::spawn_root_and_wait(a);
-            cc.push_back(component);
-            }
+        m_parent.reset(new std::atomic<unsigned int>[V]);
+        m_capacity = V;
         }
-    }); // end task arena execute()
-    #else
-    std::fill(visited.begin(), visited.end(), 0);
+    m_V = V;
+
+    for (unsigned int v = 0; v < m_V; ++v)
+        m_parent[v].store(v, std::memory_order_relaxed);
+    }
 
-    // Depth first search
-    for (unsigned int v=0; v<visited.size(); v++)
+unsigned int Graph::representative(unsigned int v)
+    {
+    unsigned int cur = m_parent[v].load(std::memory_order_relaxed);
+    if (cur != v)
         {
-        if (visited[v] == false)
+        // intermediate pointer jumping, every vertex on the path skips to its grandparent
+        unsigned int next, prev = v;
+        while (cur > (next = m_parent[cur].load(std::memory_order_relaxed)))
             {
-            std::vector<unsigned int> cur_cc;
-            DFSUtil(v, visited, cur_cc);
-            cc.push_back(cur_cc);
+            m_parent[prev].store(next, std::memory_order_relaxed);
+            prev = cur;
+            cur = next;
             }
         }
-    #endif
+    return cur;
     }
 
-#ifndef ENABLE_TBB_TASK
-void Graph::DFSUtil(unsigned int v, std::vector<unsigned int>& visited, std::vector<unsigned int>& cur_cc)
+// method to add an edge, the graph is undirected
+void Graph::addEdge(unsigned int v, unsigned int w)
     {
-    visited[v] = 1;
-    cur_cc.push_back(v);
-
-    // Recur for all the vertices
-    // adjacent to this vertex
-    auto begin = adj.equal_range(v).first;
-    auto end = adj.equal_range(v).second;
-    for(auto i = begin; i != end; ++i)
+    unsigned int rv = representative(v);
+    unsigned int rw = representative(w);
+
+    // hook the root with the larger index onto the one with the smaller index
+    while (rv != rw)
         {
-        if(!visited[i->second])
-            DFSUtil(i->second, visited, cur_cc);
+        if (rv < rw)
+            {
+            unsigned int expected = rw;
+            if (m_parent[rw].compare_exchange_strong(expected, rv))
+                break;
+            // rw has been hooked by another thread in the meantime, continue with its new parent
+            rw = expected;
+            }
+        else
+            {
+            unsigned int expected = rv;
+            if (m_parent[rv].compare_exchange_strong(expected, rw))
+                break;
+            rv = expected;
+            }
         }
     }
-#endif
-Graph::Graph(unsigned int V)
-    {
-    #ifndef ENABLE_TBB_TASK
-    visited.resize(V, 0);
-    #else
-    visited.resize(V);
-    #endif
-    }
 
-void Graph::resize(unsigned int V)
+// Gather connected components in an undirected graph
+/*! The components are ordered by their lowest vertex index, and the vertices of each component
+    are stored in increasing order, starting with the representative.
+*/
+void Graph::connectedComponents(std::vector<std::vector<unsigned int> >& cc)
     {
-    #ifndef ENABLE_TBB_TASK
-    visited.resize(V, 0);
+    // point every vertex directly to its representative
+    #ifdef ENABLE_TBB
+    auto flatten = [&]{
+    tbb::parallel_for(tbb::blocked_range<unsigned int>(0, m_V),
+        [&](const tbb::blocked_range<unsigned int>& r)
+        {
+        for (unsigned int v = r.begin(); v != r.end(); ++v)
+            m_parent[v].store(representative(v), std::memory_order_relaxed);
+        });
+    };
+    if (m_task_arena)
+        m_task_arena->execute(flatten);
+    else
+        flatten();
     #else
-    visited.clear();
-    visited.resize(V);
+    for (unsigned int v = 0; v < m_V; ++v)
+        m_parent[v].store(representative(v), std::memory_order_relaxed);
     #endif
 
-    adj.clear();
-    }
-
-// method to add a directed edge
-void Graph::addEdge(unsigned int v, unsigned int w)
-    {
-    adj.insert(std::make_pair(v,w));
+    // the representative of a vertex never has a higher index, so a single ascending pass
+    // labels every root before any of its members is visited
+    m_label.resize(m_V);
+    for (unsigned int v = 0; v < m_V; ++v)
+        {
+        unsigned int root = m_parent[v].load(std::memory_order_relaxed);
+        if (root == v)
+            {
+            m_label[v] = (unsigned int)cc.size();
+            cc.push_back(std::vector<unsigned int>());
+            }
+        cc[m_label[root]].push_back(v);
+        }
     }
 } // end namespace detail
 
@@ -318,6 +243,20 @@ class UpdaterClusters : public Updater
             return m_flip_probability;
             }
 
+        /// Enable or disable the cache of old configuration patch energies
+        void setPatchEnergyCache(bool patch_energy_cache)
+            {
+            m_patch_energy_cache = patch_energy_cache;
+            m_energy_cache_valid = false;
+            m_energy_cache.clear();
+            }
+
+        /// Get whether the cache of old configuration patch energies is enabled
+        bool getPatchEnergyCache()
+            {
+            return m_patch_energy_cache;
+            }
+
         /// Reset statistics counters
         virtual void resetStats()
             {
@@ -360,11 +299,7 @@ class UpdaterClusters : public Updater
 
         unsigned int m_instance=0;                  //!< Unique ID for RNG seeding
 
-        #ifdef ENABLE_TBB_TASK
-        std::vector<tbb::concurrent_vector<unsigned int> > m_clusters; //!< Cluster components
-        #else
         std::vector<std::vector<unsigned int> > m_clusters; //!< Cluster components
-        #endif
 
         detail::Graph m_G; //!< The graph
 
@@ -384,6 +319,19 @@ class UpdaterClusters : public Updater
         tbb::concurrent_unordered_map<std::pair<unsigned int, unsigned int>,float > m_energy_new_old;
         #endif
 
+        /* Cache of the old-old patch energies of the last cluster move. Pairs of particles that did
+           not change since then reuse their energy instead of calling the patch energy again. */
+        bool m_patch_energy_cache = false;                   //!< True if the energy cache is enabled
+        bool m_energy_cache_valid = false;                   //!< True if the energy cache can be used
+        std::map<std::pair<unsigned int, unsigned int>,float > m_energy_cache; //!< Old-old energies, by tag pair
+        std::vector<Scalar4> m_energy_cache_postype;         //!< Cached positions and types, by tag
+        std::vector<Scalar4> m_energy_cache_orientation;     //!< Cached orientations, by tag
+        std::vector<Scalar> m_energy_cache_diameter;         //!< Cached diameters, by tag
+        std::vector<Scalar> m_energy_cache_charge;           //!< Cached charges, by tag
+        BoxDim m_energy_cache_box;                           //!< Box of the cached configuration
+        std::shared_ptr<PatchEnergy> m_energy_cache_patch;   //!< Patch energy of the cached configuration
+        Scalar m_energy_cache_r_cut = 0.0;                   //!< Patch cutoff of the cached configuration
+
         hpmc_clusters_counters_t m_count_total;                 //!< Total count since initialization
         hpmc_clusters_counters_t m_count_run_start;             //!< Count saved at run() start
         hpmc_clusters_counters_t m_count_step_start;            //!< Count saved at the start of the last step
@@ -420,7 +368,7 @@ UpdaterClusters<Shape>::UpdaterClusters(std::shared_ptr<SystemDefinition> sysdef
     {
     m_exec_conf->msg->notice(5) << "Constructing UpdaterClusters" << std::endl;
 
-    #ifdef ENABLE_TBB_TASK
+    #ifdef ENABLE_TBB
     m_G.setTaskArena(sysdef->getParticleData()->getExecConf()->getTaskArena());
     #endif
 
@@ -1197,6 +1145,36 @@ void UpdaterClusters<Shape>::findInteractions(uint64_t timestep, const quat<Scal
 
     if (patch)
         {
+        ArrayHandle<unsigned int> h_tag(m_pdata->getTags(), access_location::host, access_mode::read);
+
+        // find the particles that did not change since the energy cache was filled
+        std::vector<char> unchanged(nptl, 0);
+        if (m_patch_energy_cache && m_energy_cache_valid
+            && m_energy_cache_box == m_pdata->getGlobalBox()
+            && m_energy_cache_patch == patch
+            && m_energy_cache_r_cut == r_cut_patch)
+            {
+            for (unsigned int i = 0; i < nptl; ++i)
+                {
+                unsigned int tag = h_tag.data[i];
+                if (tag >= m_energy_cache_postype.size())
+                    continue;
+
+                Scalar4 postype = m_energy_cache_postype[tag];
+                Scalar4 orientation = m_energy_cache_orientation[tag];
+                unchanged[i] = postype.x == h_postype_backup.data[i].x
+                    && postype.y == h_postype_backup.data[i].y
+                    && postype.z == h_postype_backup.data[i].z
+                    && postype.w == h_postype_backup.data[i].w
+                    && orientation.x == h_orientation_backup.data[i].x
+                    && orientation.y == h_orientation_backup.data[i].y
+                    && orientation.z == h_orientation_backup.data[i].z
+                    && orientation.w == h_orientation_backup.data[i].w
+                    && m_energy_cache_diameter[tag] == h_diameter.data[i]
+                    && m_energy_cache_charge[tag] == h_charge.data[i];
+                }
+            }
+
         // test old configuration against itself
         #ifdef ENABLE_TBB_TASK
         this->m_exec_conf->getTaskArena()->execute([&]{
@@ -1241,6 +1219,16 @@ void UpdaterClusters<Shape>::findInteractions(uint64_t timestep, const quat<Scal
 
                                 if (i == j && cur_image == 0) continue;
 
+                                if (unchanged[i] && unchanged[j])
+                                    {
+                                    // reuse the energy summed over all images, pairs that are not
+                                    // in the cache did not interact
+                                    auto it_cache = m_energy_cache.find(std::make_pair(h_tag.data[i], h_tag.data[j]));
+                                    if (it_cache != m_energy_cache.end())
+                                        m_energy_old_old[std::make_pair(i,j)] = it_cache->second;
+                                    continue;
+                                    }
+
                                 // load the position and orientation of the j particle
                                 vec3<Scalar> pos_j = vec3<Scalar>(h_postype_backup.data[j]);
                                 unsigned int typ_j = __scalar_as_int(h_postype_backup.data[j].w);
@@ -1295,6 +1283,36 @@ void UpdaterClusters<Shape>::findInteractions(uint64_t timestep, const quat<Scal
             );
         }); // end task arena execute()
         #endif
+
+        if (m_patch_energy_cache)
+            {
+            // store the old configuration energies for the next cluster move
+            m_energy_cache.clear();
+            for (auto it = m_energy_old_old.begin(); it != m_energy_old_old.end(); ++it)
+                {
+                m_energy_cache[std::make_pair(h_tag.data[it->first.first], h_tag.data[it->first.second])]
+                    = it->second;
+                }
+
+            unsigned int n_tags = (unsigned int) m_pdata->getRTags().size();
+            m_energy_cache_postype.resize(n_tags);
+            m_energy_cache_orientation.resize(n_tags);
+            m_energy_cache_diameter.resize(n_tags);
+            m_energy_cache_charge.resize(n_tags);
+            for (unsigned int i = 0; i < nptl; ++i)
+                {
+                unsigned int tag = h_tag.data[i];
+                m_energy_cache_postype[tag] = h_postype_backup.data[i];
+                m_energy_cache_orientation[tag] = h_orientation_backup.data[i];
+                m_energy_cache_diameter[tag] = h_diameter.data[i];
+                m_energy_cache_charge[tag] = h_charge.data[i];
+                }
+
+            m_energy_cache_box = m_pdata->getGlobalBox();
+            m_energy_cache_patch = patch;
+            m_energy_cache_r_cut = r_cut_patch;
+            m_energy_cache_valid = true;
+            }
         }
 
     // loop over new configuration
@@ -1780,6 +1798,7 @@ template < class Shape> void export_UpdaterClusters(pybind11::module& m, const s
         .def("getCounters", &UpdaterClusters<Shape>::getCounters)
         .def_property("pivot_move_ratio", &UpdaterClusters<Shape>::getMoveRatio, &UpdaterClusters<Shape>::setMoveRatio)
         .def_property("flip_probability", &UpdaterClusters<Shape>::getFlipProbability, &UpdaterClusters<Shape>::setFlipProbability)
+        .def_property("patch_energy_cache", &UpdaterClusters<Shape>::getPatchEnergyCache, &UpdaterClusters<Shape>::setPatchEnergyCache)
     ;
     }
 
@@ -30,8 +30,7 @@ template<class Shape> class UpdaterClustersGPU : public UpdaterClusters<Shape>
         \param seed PRNG seed
     */
     UpdaterClustersGPU(std::shared_ptr<SystemDefinition> sysdef,
-                       std::shared_ptr<IntegratorHPMCMono<Shape>> mc,
-                       std::shared_ptr<CellList> cl);
+                       std::shared_ptr<IntegratorHPMCMono<Shape>> mc);
 
     //! Destructor
     virtual ~UpdaterClustersGPU();
@@ -69,13 +68,25 @@ template<class Shape> class UpdaterClustersGPU : public UpdaterClusters<Shape>
      */
     virtual void update(uint64_t timestep);
 
+#ifdef ENABLE_MPI
+    virtual void setCommunicator(std::shared_ptr<Communicator> comm)
+        {
+        UpdaterClusters<Shape>::setCommunicator(comm);
+
+        // set the communicator on the internal cell list
+        if (m_cl)
+            m_cl->setCommunicator(comm);
+        }
+#endif
+
     protected:
     GlobalArray<unsigned int> m_adjacency; //!< List of overlaps between old and new configuration
     GlobalVector<uint2>
         m_adjacency_copy; //!< List of overlaps between old and new configuration, contiguous
     GlobalVector<int> m_components; //!< The connected component labels per particle
 
-    std::shared_ptr<CellList> m_cl; //!< Cell list
+    std::shared_ptr<CellList> m_cl; //!< Cell list, shared with compatible computes
+    CellListRequest m_cl_request;   //!< Configuration of the cell list
     uint3 m_last_dim;               //!< Dimensions of the cell list on the last call to update
     unsigned int m_last_nmax;       //!< Last cell list NMax value allocated in excell
 
@@ -137,19 +148,19 @@ template<class Shape> class UpdaterClustersGPU : public UpdaterClusters<Shape>
 
 template<class Shape>
 UpdaterClustersGPU<Shape>::UpdaterClustersGPU(std::shared_ptr<SystemDefinition> sysdef,
-                                              std::shared_ptr<IntegratorHPMCMono<Shape>> mc,
-                                              std::shared_ptr<CellList> cl)
-    : UpdaterClusters<Shape>(sysdef, mc), m_cl(cl)
+                                              std::shared_ptr<IntegratorHPMCMono<Shape>> mc)
+    : UpdaterClusters<Shape>(sysdef, mc)
     {
     this->m_exec_conf->msg->notice(5) << "Constructing UpdaterClustersGPU" << std::endl;
 
-    this->m_cl->setRadius(1);
-    this->m_cl->setComputeTDB(false);
-    this->m_cl->setFlagType();
-    this->m_cl->setComputeIdx(true);
+    // the cell list is requested on the first update, when the width is known
+    m_cl_request.radius = 1;
+    m_cl_request.compute_tdb = false;
+    m_cl_request.flag = CellListRequest::flag_type;
+    m_cl_request.compute_idx = true;
 
     // with multiple GPUs, request a cell list per device
-    m_cl->setPerDevice(this->m_exec_conf->allConcurrentManagedAccess());
+    m_cl_request.per_device = this->m_exec_conf->allConcurrentManagedAccess();
 
     // set last dim to a bogus value so that it will re-init on the first call
     m_last_dim = make_uint3(0xffffffff, 0xffffffff, 0xffffffff);
@@ -366,8 +377,18 @@ template<class Shape> void UpdaterClustersGPU<Shape>::update(uint64_t timestep)
             }
         }
     nominal_width += max_d;
-    if (this->m_cl->getNominalWidth() != nominal_width)
-        this->m_cl->setNominalWidth(nominal_width);
+
+    // the integrator and other computes with the same cell width share the cell list
+    if (!m_cl || m_cl_request.nominal_width != nominal_width)
+        {
+        m_cl_request.nominal_width = nominal_width;
+        m_cl_request.max_width = nominal_width;
+        m_cl = this->m_sysdef->getCellList(m_cl_request);
+#ifdef ENABLE_MPI
+        if (this->m_comm)
+            m_cl->setCommunicator(this->m_comm);
+#endif
+        }
 
     // update the cell list before re-initializing
     this->m_cl->compute(timestep);
@@ -418,6 +439,9 @@ template<class Shape> void UpdaterClustersGPU<Shape>::update(uint64_t timestep)
 
     // perform the update
     UpdaterClusters<Shape>::update(timestep);
+
+    // computes that share the cell list must not reuse it at this time step
+    m_cl->notifyParticlesMoved();
     }
 
 template<class Shape> void UpdaterClustersGPU<Shape>::connectedComponents()
@@ -1125,8 +1149,7 @@ template<class Shape> void export_UpdaterClustersGPU(pybind11::module& m, const
                      UpdaterClusters<Shape>,
                      std::shared_ptr<UpdaterClustersGPU<Shape>>>(m, name.c_str())
         .def(pybind11::init<std::shared_ptr<SystemDefinition>,
-                            std::shared_ptr<IntegratorHPMCMono<Shape>>,
-                            std::shared_ptr<CellList>>());
+                            std::shared_ptr<IntegratorHPMCMono<Shape>>>());
     }
 
     } // end namespace hpmc
@@ -187,6 +187,20 @@ template<class Shape> class UpdaterMuVT : public Updater
                                    quat<Scalar> orientation,
                                    Scalar& lnboltzmann);
 
+    /*! Check for overlaps of a fictitious particle with the particles on this rank
+     * \param timestep Current time step
+     * \param type Type of particle to test
+     * \param pos Position of fictitious particle
+     * \param orientation Orientation of particle
+     * \param lnboltzmann Log of Boltzmann weight of the patch energy (accumulated)
+     * \returns 1 if the particle overlaps, 0 otherwise
+     */
+    virtual unsigned int checkInsertOverlap(uint64_t timestep,
+                                            unsigned int type,
+                                            vec3<Scalar> pos,
+                                            quat<Scalar> orientation,
+                                            Scalar& lnboltzmann);
+
     /*! Try removing a particle
         \param timestep Current time step
         \param tag Tag of particle being removed
@@ -561,7 +575,7 @@ bool UpdaterMuVT<Shape>::boxResizeAndScale(uint64_t timestep,
     m_mc->communicate(false);
 
     // check for overlaps
-    bool overlap = m_mc->countOverlaps(true);
+    bool overlap = m_mc->countOverlapsUpTo(timestep, 0) > 0;
 
     if (!overlap && patch)
         {
@@ -1921,217 +1935,229 @@ bool UpdaterMuVT<Shape>::tryRemoveParticle(uint64_t timestep, unsigned int tag,
     }
 
 template<class Shape>
-bool UpdaterMuVT<Shape>::tryInsertParticle(uint64_t timestep,
-                                           unsigned int type,
-                                           vec3<Scalar> pos,
-                                           quat<Scalar> orientation,
-                                           Scalar& lnboltzmann)
+unsigned int UpdaterMuVT<Shape>::checkInsertOverlap(uint64_t timestep,
+                                                    unsigned int type,
+                                                    vec3<Scalar> pos,
+                                                    quat<Scalar> orientation,
+                                                    Scalar& lnboltzmann)
     {
     // do we have to compute energetic contribution?
     auto patch = m_mc->getPatchInteraction();
 
-    lnboltzmann = Scalar(0.0);
-
     unsigned int overlap = 0;
 
-    bool is_local = true;
-#ifdef ENABLE_MPI
-    if (this->m_pdata->getDomainDecomposition())
-        {
-        const BoxDim& global_box = this->m_pdata->getGlobalBox();
-        ArrayHandle<unsigned int> h_cart_ranks(
-            this->m_pdata->getDomainDecomposition()->getCartRanks(),
-            access_location::host,
-            access_mode::read);
-        is_local = this->m_exec_conf->getRank()
-                   == this->m_pdata->getDomainDecomposition()->placeParticle(global_box,
-                                                                             vec_to_scalar3(pos),
-                                                                             h_cart_ranks.data);
-        }
-#endif
-
     unsigned int nptl_local = m_pdata->getN() + m_pdata->getNGhosts();
 
-    if (is_local)
-        {
-        // get some data structures from the integrator
-        auto& image_list = m_mc->updateImageList();
-        const unsigned int n_images = (unsigned int)image_list.size();
-        auto& params = m_mc->getParams();
+    // get some data structures from the integrator
+    auto& image_list = m_mc->updateImageList();
+    const unsigned int n_images = (unsigned int)image_list.size();
+    auto& params = m_mc->getParams();
 
-        const Index2D& overlap_idx = m_mc->getOverlapIndexer();
+    const Index2D& overlap_idx = m_mc->getOverlapIndexer();
 
-        OverlapReal r_cut_patch(0.0);
-        Scalar r_cut_self(0.0);
+    OverlapReal r_cut_patch(0.0);
+    Scalar r_cut_self(0.0);
 
-        if (patch)
-            {
-            r_cut_patch = OverlapReal(patch->getRCut() + 0.5 * patch->getAdditiveCutoff(type));
-            r_cut_self = r_cut_patch + 0.5 * patch->getAdditiveCutoff(type);
-            }
+    if (patch)
+        {
+        r_cut_patch = OverlapReal(patch->getRCut() + 0.5 * patch->getAdditiveCutoff(type));
+        r_cut_self = r_cut_patch + 0.5 * patch->getAdditiveCutoff(type);
+        }
 
-        unsigned int err_count = 0;
+    unsigned int err_count = 0;
 
-            {
-            // check for overlaps
-            ArrayHandle<Scalar4> h_postype(m_pdata->getPositions(),
-                                           access_location::host,
-                                           access_mode::read);
-            ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(),
-                                               access_location::host,
-                                               access_mode::read);
-            ArrayHandle<Scalar> h_diameter(m_pdata->getDiameters(),
+        {
+        // check for overlaps
+        ArrayHandle<Scalar4> h_postype(m_pdata->getPositions(),
+                                       access_location::host,
+                                       access_mode::read);
+        ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(),
                                            access_location::host,
                                            access_mode::read);
-            ArrayHandle<Scalar> h_charge(m_pdata->getCharges(),
-                                         access_location::host,
-                                         access_mode::read);
+        ArrayHandle<Scalar> h_diameter(m_pdata->getDiameters(),
+                                       access_location::host,
+                                       access_mode::read);
+        ArrayHandle<Scalar> h_charge(m_pdata->getCharges(),
+                                     access_location::host,
+                                     access_mode::read);
 
-            ArrayHandle<unsigned int> h_overlaps(m_mc->getInteractionMatrix(),
-                                                 access_location::host,
-                                                 access_mode::read);
+        ArrayHandle<unsigned int> h_overlaps(m_mc->getInteractionMatrix(),
+                                             access_location::host,
+                                             access_mode::read);
 
-            // read in the current position and orientation
-            Shape shape(orientation, params[type]);
+        // read in the current position and orientation
+        Shape shape(orientation, params[type]);
 
-            for (unsigned int cur_image = 0; cur_image < n_images; cur_image++)
-                {
-                vec3<Scalar> pos_image = pos + image_list[cur_image];
+        for (unsigned int cur_image = 0; cur_image < n_images; cur_image++)
+            {
+            vec3<Scalar> pos_image = pos + image_list[cur_image];
 
-                if (cur_image != 0)
+            if (cur_image != 0)
+                {
+                // check for self-overlap with all images except the original
+                vec3<Scalar> r_ij = pos - pos_image;
+                if (h_overlaps.data[overlap_idx(type, type)]
+                    && check_circumsphere_overlap(r_ij, shape, shape)
+                    && test_overlap(r_ij, shape, shape, err_count))
                     {
-                    // check for self-overlap with all images except the original
-                    vec3<Scalar> r_ij = pos - pos_image;
-                    if (h_overlaps.data[overlap_idx(type, type)]
-                        && check_circumsphere_overlap(r_ij, shape, shape)
-                        && test_overlap(r_ij, shape, shape, err_count))
-                        {
-                        overlap = 1;
-                        break;
-                        }
+                    overlap = 1;
+                    break;
+                    }
 
-                    // self-energy
-                    if (patch && dot(r_ij, r_ij) <= r_cut_self * r_cut_self)
-                        {
-                        lnboltzmann -= patch->energy(r_ij,
-                                                     type,
-                                                     quat<float>(orientation),
-                                                     1.0, // diameter i
-                                                     0.0, // charge i
-                                                     type,
-                                                     quat<float>(orientation),
-                                                     1.0, // diameter i
-                                                     0.0  // charge i
-                        );
-                        }
+                // self-energy
+                if (patch && dot(r_ij, r_ij) <= r_cut_self * r_cut_self)
+                    {
+                    lnboltzmann -= patch->energy(r_ij,
+                                                 type,
+                                                 quat<float>(orientation),
+                                                 1.0, // diameter i
+                                                 0.0, // charge i
+                                                 type,
+                                                 quat<float>(orientation),
+                                                 1.0, // diameter i
+                                                 0.0  // charge i
+                    );
                     }
                 }
             }
+        }
 
-        // we cannot rely on a valid AABB tree when there are 0 particles
-        if (!overlap && nptl_local > 0)
-            {
-            // Check particle against AABB tree for neighbors
-            const detail::AABBTree& aabb_tree = m_mc->buildAABBTree();
+    // we cannot rely on a valid AABB tree when there are 0 particles
+    if (!overlap && nptl_local > 0)
+        {
+        // Check particle against AABB tree for neighbors
+        const detail::AABBTree& aabb_tree = m_mc->buildAABBTree();
 
-            ArrayHandle<Scalar4> h_postype(m_pdata->getPositions(),
-                                           access_location::host,
-                                           access_mode::read);
-            ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(),
-                                               access_location::host,
-                                               access_mode::read);
-            ArrayHandle<Scalar> h_diameter(m_pdata->getDiameters(),
+        ArrayHandle<Scalar4> h_postype(m_pdata->getPositions(),
+                                       access_location::host,
+                                       access_mode::read);
+        ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(),
                                            access_location::host,
                                            access_mode::read);
-            ArrayHandle<Scalar> h_charge(m_pdata->getCharges(),
-                                         access_location::host,
-                                         access_mode::read);
-            ArrayHandle<unsigned int> h_overlaps(m_mc->getInteractionMatrix(),
-                                                 access_location::host,
-                                                 access_mode::read);
+        ArrayHandle<Scalar> h_diameter(m_pdata->getDiameters(),
+                                       access_location::host,
+                                       access_mode::read);
+        ArrayHandle<Scalar> h_charge(m_pdata->getCharges(),
+                                     access_location::host,
+                                     access_mode::read);
+        ArrayHandle<unsigned int> h_overlaps(m_mc->getInteractionMatrix(),
+                                             access_location::host,
+                                             access_mode::read);
 
-            Shape shape(orientation, params[type]);
-            OverlapReal R_query
-                = std::max(shape.getCircumsphereDiameter() / OverlapReal(2.0),
-                           r_cut_patch - m_mc->getMinCoreDiameter() / (OverlapReal)2.0);
-            detail::AABB aabb_local = detail::AABB(vec3<Scalar>(0, 0, 0), R_query);
+        Shape shape(orientation, params[type]);
+        OverlapReal R_query
+            = std::max(shape.getCircumsphereDiameter() / OverlapReal(2.0),
+                       r_cut_patch - m_mc->getMinCoreDiameter() / (OverlapReal)2.0);
+        detail::AABB aabb_local = detail::AABB(vec3<Scalar>(0, 0, 0), R_query);
 
-            for (unsigned int cur_image = 0; cur_image < n_images; cur_image++)
-                {
-                vec3<Scalar> pos_image = pos + image_list[cur_image];
+        for (unsigned int cur_image = 0; cur_image < n_images; cur_image++)
+            {
+            vec3<Scalar> pos_image = pos + image_list[cur_image];
 
-                detail::AABB aabb = aabb_local;
-                aabb.translate(pos_image);
+            detail::AABB aabb = aabb_local;
+            aabb.translate(pos_image);
 
-                // stackless search
-                for (unsigned int cur_node_idx = 0; cur_node_idx < aabb_tree.getNumNodes();
-                     cur_node_idx++)
+            // stackless search
+            for (unsigned int cur_node_idx = 0; cur_node_idx < aabb_tree.getNumNodes();
+                 cur_node_idx++)
+                {
+                if (detail::overlap(aabb_tree.getNodeAABB(cur_node_idx), aabb))
                     {
-                    if (detail::overlap(aabb_tree.getNodeAABB(cur_node_idx), aabb))
+                    if (aabb_tree.isNodeLeaf(cur_node_idx))
                         {
-                        if (aabb_tree.isNodeLeaf(cur_node_idx))
+                        for (unsigned int cur_p = 0;
+                             cur_p < aabb_tree.getNodeNumParticles(cur_node_idx);
+                             cur_p++)
                             {
-                            for (unsigned int cur_p = 0;
-                                 cur_p < aabb_tree.getNodeNumParticles(cur_node_idx);
-                                 cur_p++)
-                                {
-                                // read in its position and orientation
-                                unsigned int j = aabb_tree.getNodeParticle(cur_node_idx, cur_p);
+                            // read in its position and orientation
+                            unsigned int j = aabb_tree.getNodeParticle(cur_node_idx, cur_p);
 
-                                Scalar4 postype_j = h_postype.data[j];
-                                Scalar4 orientation_j = h_orientation.data[j];
+                            Scalar4 postype_j = h_postype.data[j];
+                            Scalar4 orientation_j = h_orientation.data[j];
 
-                                // put particles in coordinate system of particle i
-                                vec3<Scalar> r_ij = vec3<Scalar>(postype_j) - pos_image;
+                            // put particles in coordinate system of particle i
+                            vec3<Scalar> r_ij = vec3<Scalar>(postype_j) - pos_image;
 
-                                unsigned int typ_j = __scalar_as_int(postype_j.w);
-                                Shape shape_j(quat<Scalar>(orientation_j), params[typ_j]);
+                            unsigned int typ_j = __scalar_as_int(postype_j.w);
+                            Shape shape_j(quat<Scalar>(orientation_j), params[typ_j]);
 
-                                Scalar r_cut_ij(0.0);
-                                if (patch)
-                                    r_cut_ij = r_cut_patch + 0.5 * patch->getAdditiveCutoff(typ_j);
+                            Scalar r_cut_ij(0.0);
+                            if (patch)
+                                r_cut_ij = r_cut_patch + 0.5 * patch->getAdditiveCutoff(typ_j);
 
-                                if (h_overlaps.data[overlap_idx(type, typ_j)]
-                                    && check_circumsphere_overlap(r_ij, shape, shape_j)
-                                    && test_overlap(r_ij, shape, shape_j, err_count))
-                                    {
-                                    overlap = 1;
-                                    break;
-                                    }
-                                else if (patch && dot(r_ij, r_ij) <= r_cut_ij * r_cut_ij)
-                                    {
-                                    lnboltzmann -= patch->energy(r_ij,
-                                                                 type,
-                                                                 quat<float>(orientation),
-                                                                 float(1.0), // diameter i
-                                                                 float(0.0), // charge i
-                                                                 typ_j,
-                                                                 quat<float>(orientation_j),
-                                                                 float(h_diameter.data[j]),
-                                                                 float(h_charge.data[j]));
-                                    }
+                            if (h_overlaps.data[overlap_idx(type, typ_j)]
+                                && check_circumsphere_overlap(r_ij, shape, shape_j)
+                                && test_overlap(r_ij, shape, shape_j, err_count))
+                                {
+                                overlap = 1;
+                                break;
+                                }
+                            else if (patch && dot(r_ij, r_ij) <= r_cut_ij * r_cut_ij)
+                                {
+                                lnboltzmann -= patch->energy(r_ij,
+                                                             type,
+                                                             quat<float>(orientation),
+                                                             float(1.0), // diameter i
+                                                             float(0.0), // charge i
+                                                             typ_j,
+                                                             quat<float>(orientation_j),
+                                                             float(h_diameter.data[j]),
+                                                             float(h_charge.data[j]));
                                 }
                             }
                         }
-                    else
-                        {
-                        // skip ahead
-                        cur_node_idx += aabb_tree.getNodeSkip(cur_node_idx);
-                        }
-
-                    if (overlap)
-                        {
-                        break;
-                        }
-                    } // end loop over AABB nodes
+                    }
+                else
+                    {
+                    // skip ahead
+                    cur_node_idx += aabb_tree.getNodeSkip(cur_node_idx);
+                    }
 
                 if (overlap)
                     {
                     break;
                     }
-                } // end loop over images
-            }     // end if nptl_local > 0
-        }         // end if local
+                } // end loop over AABB nodes
+
+            if (overlap)
+                {
+                break;
+                }
+            } // end loop over images
+        }     // end if nptl_local > 0
+
+    return overlap;
+    }
+
+template<class Shape>
+bool UpdaterMuVT<Shape>::tryInsertParticle(uint64_t timestep,
+                                           unsigned int type,
+                                           vec3<Scalar> pos,
+                                           quat<Scalar> orientation,
+                                           Scalar& lnboltzmann)
+    {
+    lnboltzmann = Scalar(0.0);
+
+    unsigned int overlap = 0;
+
+    bool is_local = true;
+#ifdef ENABLE_MPI
+    if (this->m_pdata->getDomainDecomposition())
+        {
+        const BoxDim& global_box = this->m_pdata->getGlobalBox();
+        ArrayHandle<unsigned int> h_cart_ranks(
+            this->m_pdata->getDomainDecomposition()->getCartRanks(),
+            access_location::host,
+            access_mode::read);
+        is_local = this->m_exec_conf->getRank()
+                   == this->m_pdata->getDomainDecomposition()->placeParticle(global_box,
+                                                                             vec_to_scalar3(pos),
+                                                                             h_cart_ranks.data);
+        }
+#endif
+
+    if (is_local)
+        overlap = checkInsertOverlap(timestep, type, pos, orientation, lnboltzmann);
 
 #ifdef ENABLE_MPI
     if (m_comm)
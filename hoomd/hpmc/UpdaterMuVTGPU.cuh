@@ -0,0 +1,253 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file UpdaterMuVTGPU.cuh
+    \brief Implements the insertion overlap kernel for the grand canonical updater on the GPU
+*/
+
+#pragma once
+
+#include <hip/hip_runtime.h>
+
+#include "HPMCMiscFunctions.h"
+#include "hoomd/BoxDim.h"
+#include "hoomd/HOOMDMath.h"
+#include "hoomd/Index1D.h"
+#include "hoomd/VectorMath.h"
+
+#include "GPUHelpers.cuh"
+
+#include <cassert>
+#include <stdexcept>
+
+namespace hpmc
+    {
+namespace gpu
+    {
+//! Wraps arguments to hpmc_muvt_check_insert
+/*! \ingroup hpmc_data_structs */
+struct muvt_insert_args_t
+    {
+    //! Construct a muvt_insert_args_t
+    muvt_insert_args_t(const Scalar4* _d_postype,
+                       const Scalar4* _d_orientation,
+                       const unsigned int _N,
+                       const unsigned int _num_types,
+                       const unsigned int _type,
+                       const Scalar3 _pos,
+                       const Scalar4 _orientation,
+                       const BoxDim& _box,
+                       const unsigned int* _d_check_overlaps,
+                       const Index2D& _overlap_idx,
+                       unsigned int* _d_overlap,
+                       const unsigned int _block_size,
+                       const unsigned int _overlap_threads,
+                       const hipDeviceProp_t& _devprop)
+        : d_postype(_d_postype), d_orientation(_d_orientation), N(_N), num_types(_num_types),
+          type(_type), pos(_pos), orientation(_orientation), box(_box),
+          d_check_overlaps(_d_check_overlaps), overlap_idx(_overlap_idx), d_overlap(_d_overlap),
+          block_size(_block_size), overlap_threads(_overlap_threads), devprop(_devprop) {};
+
+    const Scalar4* d_postype;             //!< postype array
+    const Scalar4* d_orientation;         //!< orientation array
+    const unsigned int N;                 //!< Number of particles to check (local + ghosts)
+    const unsigned int num_types;         //!< Number of particle types
+    const unsigned int type;              //!< Type of the inserted particle
+    const Scalar3 pos;                    //!< Position of the inserted particle
+    const Scalar4 orientation;            //!< Orientation of the inserted particle
+    const BoxDim box;                     //!< Global simulation box
+    const unsigned int* d_check_overlaps; //!< Interaction matrix
+    const Index2D overlap_idx;            //!< Interaction matrix indexer
+    unsigned int* d_overlap;              //!< Overlap flag (output)
+    const unsigned int block_size;        //!< Block size to execute
+    const unsigned int overlap_threads;   //!< Number of threads per overlap check
+    const hipDeviceProp_t& devprop;       //!< CUDA device properties
+    };
+
+template<class Shape>
+void hpmc_muvt_check_insert(const muvt_insert_args_t& args,
+                            const typename Shape::param_type* d_params);
+
+#ifdef __HIPCC__
+namespace kernel
+    {
+//! Kernel to check a fictitious particle for overlaps with all particles
+/*! \param d_postype Particle positions and types by index
+    \param d_orientation Particle orientations
+    \param N Number of particles to check
+    \param num_types Number of particle types
+    \param type Type of the inserted particle
+    \param pos Position of the inserted particle
+    \param orientation Orientation of the inserted particle
+    \param box Global simulation box
+    \param d_check_overlaps Per-type pair interaction matrix
+    \param overlap_idx Interaction matrix indexer
+    \param d_overlap Set to 1 when the inserted particle overlaps (output value)
+    \param d_params Per-type shape parameters
+    \param max_extra_bytes Shared memory available for the shape parameters
+
+    Each group of blockDim.x threads checks one particle. Groups skip their check once any overlap
+    has been found.
+*/
+template<class Shape>
+__global__ void hpmc_muvt_check_insert(const Scalar4* d_postype,
+                                       const Scalar4* d_orientation,
+                                       const unsigned int N,
+                                       const unsigned int num_types,
+                                       const unsigned int type,
+                                       const Scalar3 pos,
+                                       const Scalar4 orientation,
+                                       const BoxDim box,
+                                       const unsigned int* d_check_overlaps,
+                                       const Index2D overlap_idx,
+                                       unsigned int* d_overlap,
+                                       const typename Shape::param_type* d_params,
+                                       const unsigned int max_extra_bytes)
+    {
+    // load the per type pair parameters into shared memory
+    HIP_DYNAMIC_SHARED(char, s_data)
+    typename Shape::param_type* s_params = (typename Shape::param_type*)(&s_data[0]);
+    unsigned int* s_check_overlaps = (unsigned int*)(s_params + num_types);
+    unsigned int ntyppairs = overlap_idx.getNumElements();
+
+    // copy over parameters one int per thread for fast loads
+        {
+        unsigned int tidx = threadIdx.x + blockDim.x * threadIdx.y;
+        unsigned int block_size = blockDim.x * blockDim.y;
+        unsigned int param_size = num_types * sizeof(typename Shape::param_type) / sizeof(int);
+
+        for (unsigned int cur_offset = 0; cur_offset < param_size; cur_offset += block_size)
+            {
+            if (cur_offset + tidx < param_size)
+                {
+                ((int*)s_params)[cur_offset + tidx] = ((int*)d_params)[cur_offset + tidx];
+                }
+            }
+
+        for (unsigned int cur_offset = 0; cur_offset < ntyppairs; cur_offset += block_size)
+            {
+            if (cur_offset + tidx < ntyppairs)
+                {
+                s_check_overlaps[cur_offset + tidx] = d_check_overlaps[cur_offset + tidx];
+                }
+            }
+        }
+
+    __syncthreads();
+
+    // initialize extra shared mem
+    char* s_extra = (char*)(s_check_overlaps + ntyppairs);
+
+    unsigned int available_bytes = max_extra_bytes;
+    for (unsigned int cur_type = 0; cur_type < num_types; ++cur_type)
+        s_params[cur_type].load_shared(s_extra, available_bytes);
+
+    __syncthreads();
+
+    unsigned int j = blockIdx.x * blockDim.y + threadIdx.y;
+
+    // load from output, this race condition is intentional and implements an early exit
+    if (j >= N || atomicCAS(d_overlap, 0, 0))
+        return;
+
+    Scalar4 postype_j = d_postype[j];
+    unsigned int type_j = __scalar_as_int(postype_j.w);
+
+    if (!s_check_overlaps[overlap_idx(type, type_j)])
+        return;
+
+    Shape shape_i(quat<Scalar>(orientation), s_params[type]);
+    Shape shape_j(quat<Scalar>(), s_params[type_j]);
+    if (shape_j.hasOrientation())
+        shape_j.orientation = quat<Scalar>(d_orientation[j]);
+
+    // put particle j into the coordinate system of the inserted particle
+    vec3<Scalar> r_ij = vec3<Scalar>(postype_j) - vec3<Scalar>(pos);
+    r_ij = vec3<Scalar>(box.minImage(vec_to_scalar3(r_ij)));
+
+    unsigned int err_count = 0;
+    if (check_circumsphere_overlap(r_ij, shape_i, shape_j)
+        && test_overlap(r_ij, shape_i, shape_j, err_count))
+        {
+        atomicExch(d_overlap, 1);
+        }
+    }
+    } // end namespace kernel
+
+//! Kernel driver for kernel::hpmc_muvt_check_insert()
+/*! \param args Bundled arguments
+    \param d_params Per-type shape parameters
+
+    The caller resets *args.d_overlap before the launch.
+
+    \ingroup hpmc_kernels
+*/
+template<class Shape>
+void hpmc_muvt_check_insert(const muvt_insert_args_t& args,
+                            const typename Shape::param_type* d_params)
+    {
+    assert(args.d_postype);
+    assert(args.d_orientation);
+    assert(args.d_overlap);
+    assert(args.block_size % args.overlap_threads == 0);
+
+    // determine the maximum block size and clamp the input block size down
+    static int max_block_size = -1;
+    static hipFuncAttributes attr;
+    if (max_block_size == -1)
+        {
+        hipFuncGetAttributes(&attr,
+                             reinterpret_cast<const void*>(kernel::hpmc_muvt_check_insert<Shape>));
+        max_block_size = attr.maxThreadsPerBlock;
+        }
+
+    unsigned int run_block_size = min(args.block_size, (unsigned int)max_block_size);
+    unsigned int n_groups = run_block_size / args.overlap_threads;
+
+    dim3 threads(args.overlap_threads, n_groups, 1);
+    dim3 grid(args.N / n_groups + 1, 1, 1);
+
+    size_t shared_bytes = args.num_types * sizeof(typename Shape::param_type)
+                          + args.overlap_idx.getNumElements() * sizeof(unsigned int);
+
+    if (shared_bytes + attr.sharedSizeBytes >= args.devprop.sharedMemPerBlock)
+        throw std::runtime_error("Insufficient shared memory for HPMC kernel: reduce number of "
+                                 "particle types or size of shape parameters");
+
+    unsigned int max_extra_bytes = static_cast<unsigned int>(args.devprop.sharedMemPerBlock
+                                                             - attr.sharedSizeBytes - shared_bytes);
+
+    // determine dynamically requested shared memory
+    char* ptr = (char*)nullptr;
+    unsigned int available_bytes = max_extra_bytes;
+    for (unsigned int i = 0; i < args.num_types; ++i)
+        {
+        d_params[i].allocate_shared(ptr, available_bytes);
+        }
+    unsigned int extra_bytes = max_extra_bytes - available_bytes;
+
+    shared_bytes += extra_bytes;
+
+    hipLaunchKernelGGL((kernel::hpmc_muvt_check_insert<Shape>),
+                       grid,
+                       threads,
+                       shared_bytes,
+                       0,
+                       args.d_postype,
+                       args.d_orientation,
+                       args.N,
+                       args.num_types,
+                       args.type,
+                       args.pos,
+                       args.orientation,
+                       args.box,
+                       args.d_check_overlaps,
+                       args.overlap_idx,
+                       args.d_overlap,
+                       d_params,
+                       max_extra_bytes);
+    }
+#endif
+
+    } // end namespace gpu
+    } // end namespace hpmc
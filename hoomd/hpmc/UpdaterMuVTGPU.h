@@ -0,0 +1,207 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#pragma once
+
+#ifdef ENABLE_HIP
+
+#include "UpdaterMuVT.h"
+#include "UpdaterMuVTGPU.cuh"
+
+#include "hoomd/Autotuner.h"
+#include "hoomd/GlobalArray.h"
+
+#include <hip/hip_runtime.h>
+
+/*! \file UpdaterMuVTGPU.h
+    \brief Declaration of UpdaterMuVTGPU
+    \note This header cannot be compiled by nvcc
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include <pybind11/pybind11.h>
+
+namespace hpmc
+    {
+/*!
+   Implementation of UpdaterMuVT on the GPU
+
+   The overlap checks of inserted particles are performed on the GPU, in parallel over all
+   particles on the rank, so that insertions do not copy the particle data to the host. Insertions
+   with a patch energy, and boxes too small for the minimum image convention, fall back to the
+   CPU implementation.
+*/
+template<class Shape> class UpdaterMuVTGPU : public UpdaterMuVT<Shape>
+    {
+    public:
+    //! Constructor
+    UpdaterMuVTGPU(std::shared_ptr<SystemDefinition> sysdef,
+                   std::shared_ptr<IntegratorHPMCMono<Shape>> mc,
+                   unsigned int npartition);
+
+    //! Destructor
+    virtual ~UpdaterMuVTGPU();
+
+    //! Set autotuner parameters
+    /*! \param enable Enable/disable autotuning
+        \param period period (approximate) in time steps when returning occurs
+    */
+    virtual void setAutotunerParams(bool enable, unsigned int period)
+        {
+        m_tuner_insert->setPeriod(period);
+        m_tuner_insert->setEnabled(enable);
+        }
+
+    protected:
+    GlobalArray<unsigned int> m_overlap;      //!< Overlap flag of the inserted particle
+    std::unique_ptr<Autotuner> m_tuner_insert; //!< Autotuner for the insertion overlap check
+
+    //! Check for overlaps of a fictitious particle with the particles on this rank
+    virtual unsigned int checkInsertOverlap(uint64_t timestep,
+                                            unsigned int type,
+                                            vec3<Scalar> pos,
+                                            quat<Scalar> orientation,
+                                            Scalar& lnboltzmann);
+    };
+
+template<class Shape>
+UpdaterMuVTGPU<Shape>::UpdaterMuVTGPU(std::shared_ptr<SystemDefinition> sysdef,
+                                      std::shared_ptr<IntegratorHPMCMono<Shape>> mc,
+                                      unsigned int npartition)
+    : UpdaterMuVT<Shape>(sysdef, mc, npartition)
+    {
+    this->m_exec_conf->msg->notice(5) << "Constructing UpdaterMuVTGPU" << std::endl;
+
+    GlobalArray<unsigned int>(1, this->m_exec_conf).swap(m_overlap);
+    TAG_ALLOCATION(m_overlap);
+
+    // the block size and overlap threads are searched,
+    // encoded as block_size*1000000 + overlap_threads
+    std::vector<unsigned int> valid_params;
+    const hipDeviceProp_t& dev_prop = this->m_exec_conf->dev_prop;
+    unsigned int warp_size = dev_prop.warpSize;
+    unsigned int max_groups = dev_prop.maxThreadsDim[1];
+    for (unsigned int block_size = warp_size;
+         block_size <= (unsigned int)dev_prop.maxThreadsPerBlock;
+         block_size += warp_size)
+        {
+        for (auto t : Autotuner::getTppListPow2(warp_size))
+            {
+            // only widen the parallelism if the shape supports it
+            if (t == 1 || Shape::isParallel())
+                {
+                if ((block_size % t) == 0 && block_size / t <= max_groups)
+                    valid_params.push_back(block_size * 1000000 + t);
+                }
+            }
+        }
+
+    m_tuner_insert.reset(
+        new Autotuner(valid_params, 5, 100000, "muvt_insert", this->m_exec_conf));
+    }
+
+template<class Shape> UpdaterMuVTGPU<Shape>::~UpdaterMuVTGPU()
+    {
+    this->m_exec_conf->msg->notice(5) << "Destroying UpdaterMuVTGPU" << std::endl;
+    }
+
+template<class Shape>
+unsigned int UpdaterMuVTGPU<Shape>::checkInsertOverlap(uint64_t timestep,
+                                                       unsigned int type,
+                                                       vec3<Scalar> pos,
+                                                       quat<Scalar> orientation,
+                                                       Scalar& lnboltzmann)
+    {
+    if (this->m_mc->getPatchInteraction())
+        return UpdaterMuVT<Shape>::checkInsertOverlap(timestep,
+                                                      type,
+                                                      pos,
+                                                      orientation,
+                                                      lnboltzmann);
+
+    auto& params = this->m_mc->getParams();
+
+    // the kernel checks a single image of every particle, it is only valid if no pair can overlap
+    // through more than one image
+    const BoxDim global_box = this->m_pdata->getGlobalBox();
+    Shape shape(orientation, params[type]);
+    Scalar max_range = shape.getCircumsphereDiameter() + this->m_mc->getMaxCoreDiameter();
+    Scalar3 npd = global_box.getNearestPlaneDistance();
+    if ((global_box.getPeriodic().x && npd.x <= max_range)
+        || (global_box.getPeriodic().y && npd.y <= max_range)
+        || (this->m_sysdef->getNDimensions() == 3 && global_box.getPeriodic().z
+            && npd.z <= max_range))
+        {
+        return UpdaterMuVT<Shape>::checkInsertOverlap(timestep,
+                                                      type,
+                                                      pos,
+                                                      orientation,
+                                                      lnboltzmann);
+        }
+
+    unsigned int nptl_local = this->m_pdata->getN() + this->m_pdata->getNGhosts();
+    if (nptl_local == 0)
+        return 0;
+
+        {
+        ArrayHandle<Scalar4> d_postype(this->m_pdata->getPositions(),
+                                       access_location::device,
+                                       access_mode::read);
+        ArrayHandle<Scalar4> d_orientation(this->m_pdata->getOrientationArray(),
+                                           access_location::device,
+                                           access_mode::read);
+        ArrayHandle<unsigned int> d_check_overlaps(this->m_mc->getInteractionMatrix(),
+                                                   access_location::device,
+                                                   access_mode::read);
+        ArrayHandle<unsigned int> d_overlap(m_overlap,
+                                            access_location::device,
+                                            access_mode::overwrite);
+
+        hipMemsetAsync(d_overlap.data, 0, sizeof(unsigned int));
+
+        m_tuner_insert->begin();
+        unsigned int param = m_tuner_insert->getParam();
+        gpu::muvt_insert_args_t args(d_postype.data,
+                                     d_orientation.data,
+                                     nptl_local,
+                                     this->m_pdata->getNTypes(),
+                                     type,
+                                     vec_to_scalar3(pos),
+                                     quat_to_scalar4(orientation),
+                                     global_box,
+                                     d_check_overlaps.data,
+                                     this->m_mc->getOverlapIndexer(),
+                                     d_overlap.data,
+                                     param / 1000000,
+                                     param % 1000000,
+                                     this->m_exec_conf->dev_prop);
+        gpu::hpmc_muvt_check_insert<Shape>(args, params.data());
+        if (this->m_exec_conf->isCUDAErrorCheckingEnabled())
+            CHECK_CUDA_ERROR();
+        m_tuner_insert->end();
+        }
+
+    ArrayHandle<unsigned int> h_overlap(m_overlap, access_location::host, access_mode::read);
+    return *h_overlap.data;
+    }
+
+//! Export the UpdaterMuVTGPU class to python
+/*! \param name Name of the class in the exported python module
+    \tparam Shape An instantiation of UpdaterMuVTGPU<Shape> will be exported
+*/
+template<class Shape> void export_UpdaterMuVTGPU(pybind11::module& m, const std::string& name)
+    {
+    pybind11::class_<UpdaterMuVTGPU<Shape>,
+                     UpdaterMuVT<Shape>,
+                     std::shared_ptr<UpdaterMuVTGPU<Shape>>>(m, name.c_str())
+        .def(pybind11::init<std::shared_ptr<SystemDefinition>,
+                            std::shared_ptr<IntegratorHPMCMono<Shape>>,
+                            unsigned int>());
+    }
+
+    } // end namespace hpmc
+
+#endif // ENABLE_HIP
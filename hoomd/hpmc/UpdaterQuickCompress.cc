@@ -4,6 +4,8 @@
 #include "UpdaterQuickCompress.h"
 #include "hoomd/RNGIdentifiers.h"
 
+#include <climits>
+
 namespace hpmc
     {
 UpdaterQuickCompress::UpdaterQuickCompress(std::shared_ptr<SystemDefinition> sysdef,
@@ -43,7 +45,7 @@ void UpdaterQuickCompress::update(uint64_t timestep)
     m_exec_conf->msg->notice(10) << "UpdaterQuickCompress: " << timestep << std::endl;
 
     // count the number of overlaps in the current configuration
-    auto n_overlaps = m_mc->countOverlaps(false);
+    auto n_overlaps = m_mc->countOverlapsUpTo(timestep, 0);
     BoxDim current_box = m_pdata->getGlobalBox();
 
     // TODO: This slow. We will implement a general reusable fix later in #705
@@ -71,6 +73,25 @@ void UpdaterQuickCompress::performBoxScale(uint64_t timestep)
 
     // Make a backup copy of position data
     unsigned int N_backup = m_pdata->getN();
+#ifdef ENABLE_HIP
+    if (m_exec_conf->isCUDAEnabled())
+        {
+        // keep the positions on the device, the GPU integrators scale and check them there
+        ArrayHandle<Scalar4> d_pos(m_pdata->getPositions(),
+                                   access_location::device,
+                                   access_mode::read);
+        ArrayHandle<Scalar4> d_pos_backup(m_pos_backup,
+                                          access_location::device,
+                                          access_mode::overwrite);
+        hipMemcpy(d_pos_backup.data,
+                  d_pos.data,
+                  sizeof(Scalar4) * N_backup,
+                  hipMemcpyDeviceToDevice);
+        if (m_exec_conf->isCUDAErrorCheckingEnabled())
+            CHECK_CUDA_ERROR();
+        }
+    else
+#endif
         {
         ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(),
                                    access_location::host,
@@ -81,19 +102,46 @@ void UpdaterQuickCompress::performBoxScale(uint64_t timestep)
         memcpy(h_pos_backup.data, h_pos.data, sizeof(Scalar4) * N_backup);
         }
 
-    m_mc->attemptBoxResize(timestep, new_box);
+    // the move is rejected as soon as the count exceeds this, so there is no need to count the
+    // remaining overlaps
+    unsigned int max_overlaps = static_cast<unsigned int>(
+        std::min(std::floor(m_max_overlaps_per_particle * m_pdata->getNGlobal()),
+                 double(UINT_MAX - 1)));
+
+    // attemptBoxResize returns true when there are no overlaps in the new box
+    unsigned int n_overlaps = 0;
+    if (!m_mc->attemptBoxResize(timestep, new_box))
+        n_overlaps = m_mc->countOverlapsUpTo(timestep, max_overlaps);
 
-    auto n_overlaps = m_mc->countOverlaps(false);
-    if (n_overlaps > m_max_overlaps_per_particle * m_pdata->getNGlobal())
+    if (n_overlaps > max_overlaps)
         {
         // the box move generated too many overlaps, undo the move
-        ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(),
-                                   access_location::host,
-                                   access_mode::readwrite);
-        ArrayHandle<Scalar4> h_pos_backup(m_pos_backup, access_location::host, access_mode::read);
         unsigned int N = m_pdata->getN();
         assert(N == N_backup);
-        memcpy(h_pos.data, h_pos_backup.data, sizeof(Scalar4) * N);
+#ifdef ENABLE_HIP
+        if (m_exec_conf->isCUDAEnabled())
+            {
+            ArrayHandle<Scalar4> d_pos(m_pdata->getPositions(),
+                                       access_location::device,
+                                       access_mode::readwrite);
+            ArrayHandle<Scalar4> d_pos_backup(m_pos_backup,
+                                              access_location::device,
+                                              access_mode::read);
+            hipMemcpy(d_pos.data, d_pos_backup.data, sizeof(Scalar4) * N, hipMemcpyDeviceToDevice);
+            if (m_exec_conf->isCUDAErrorCheckingEnabled())
+                CHECK_CUDA_ERROR();
+            }
+        else
+#endif
+            {
+            ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(),
+                                       access_location::host,
+                                       access_mode::readwrite);
+            ArrayHandle<Scalar4> h_pos_backup(m_pos_backup,
+                                              access_location::host,
+                                              access_mode::read);
+            memcpy(h_pos.data, h_pos_backup.data, sizeof(Scalar4) * N);
+            }
         m_pdata->setGlobalBox(old_box);
 
         // we have moved particles, communicate those changes
@@ -0,0 +1,260 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "HPMCPrecisionSetup.h"
+#include "OBB.h"
+
+#ifndef __WIDE_OBB_H__
+#define __WIDE_OBB_H__
+
+/*! \file WideOBB.h
+    \brief Separating axis tests of one OBB against several OBBs at once
+    \note This header cannot be compiled by nvcc
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#if defined(__SSE__) && (defined(SINGLE_PRECISION) || defined(ENABLE_HPMC_MIXED_PRECISION))
+#include <immintrin.h>
+#define HPMC_WIDE_OBB_SSE
+#endif
+
+#include <cmath>
+
+namespace hpmc
+    {
+namespace detail
+    {
+//! Number of OBBs in a wide node
+const unsigned int WIDE_OBB_WIDTH = 4;
+
+//! Number of OverlapReal components stored per OBB in a wide node
+/*! The center (3), the half lengths (3) and the rows of the rotation matrix (9).
+ */
+const unsigned int WIDE_OBB_COMPONENTS = 15;
+
+//! WIDE_OBB_WIDTH lanes of OverlapReal values
+/*! With SSE and single precision overlap checks, the lanes map to one register. Otherwise, the
+    operations loop over the lanes.
+*/
+struct WideReal
+    {
+#ifdef HPMC_WIDE_OBB_SSE
+    __m128 v;
+
+    WideReal() { }
+    explicit WideReal(__m128 _v) : v(_v) { }
+    explicit WideReal(OverlapReal s) : v(_mm_set1_ps(s)) { }
+
+    //! Load WIDE_OBB_WIDTH consecutive values
+    static WideReal load(const OverlapReal* ptr)
+        {
+        return WideReal(_mm_loadu_ps(ptr));
+        }
+
+    WideReal operator+(const WideReal& b) const
+        {
+        return WideReal(_mm_add_ps(v, b.v));
+        }
+
+    WideReal operator-(const WideReal& b) const
+        {
+        return WideReal(_mm_sub_ps(v, b.v));
+        }
+
+    WideReal operator*(const WideReal& b) const
+        {
+        return WideReal(_mm_mul_ps(v, b.v));
+        }
+
+    //! Absolute value of each lane
+    WideReal abs() const
+        {
+        return WideReal(_mm_andnot_ps(_mm_set1_ps(-0.0f), v));
+        }
+
+    //! Bit mask of the lanes in which this value is larger than b
+    unsigned int greaterThan(const WideReal& b) const
+        {
+        return (unsigned int)_mm_movemask_ps(_mm_cmpgt_ps(v, b.v));
+        }
+#else
+    OverlapReal v[WIDE_OBB_WIDTH];
+
+    WideReal() { }
+    explicit WideReal(OverlapReal s)
+        {
+        for (unsigned int l = 0; l < WIDE_OBB_WIDTH; ++l)
+            v[l] = s;
+        }
+
+    //! Load WIDE_OBB_WIDTH consecutive values
+    static WideReal load(const OverlapReal* ptr)
+        {
+        WideReal r;
+        for (unsigned int l = 0; l < WIDE_OBB_WIDTH; ++l)
+            r.v[l] = ptr[l];
+        return r;
+        }
+
+    WideReal operator+(const WideReal& b) const
+        {
+        WideReal r;
+        for (unsigned int l = 0; l < WIDE_OBB_WIDTH; ++l)
+            r.v[l] = v[l] + b.v[l];
+        return r;
+        }
+
+    WideReal operator-(const WideReal& b) const
+        {
+        WideReal r;
+        for (unsigned int l = 0; l < WIDE_OBB_WIDTH; ++l)
+            r.v[l] = v[l] - b.v[l];
+        return r;
+        }
+
+    WideReal operator*(const WideReal& b) const
+        {
+        WideReal r;
+        for (unsigned int l = 0; l < WIDE_OBB_WIDTH; ++l)
+            r.v[l] = v[l] * b.v[l];
+        return r;
+        }
+
+    //! Absolute value of each lane
+    WideReal abs() const
+        {
+        WideReal r;
+        for (unsigned int l = 0; l < WIDE_OBB_WIDTH; ++l)
+            r.v[l] = std::abs(v[l]);
+        return r;
+        }
+
+    //! Bit mask of the lanes in which this value is larger than b
+    unsigned int greaterThan(const WideReal& b) const
+        {
+        unsigned int mask = 0;
+        for (unsigned int l = 0; l < WIDE_OBB_WIDTH; ++l)
+            mask |= (v[l] > b.v[l]) << l;
+        return mask;
+        }
+#endif
+    };
+
+//! Store an OBB in one lane of a wide node
+/*! \param dest Storage of the wide node, WIDE_OBB_COMPONENTS * WIDE_OBB_WIDTH values
+    \param lane Lane to store the OBB in
+    \param obb The OBB
+*/
+inline void storeWideOBB(OverlapReal* dest, unsigned int lane, const OBB& obb)
+    {
+    rotmat3<OverlapReal> r(obb.rotation);
+    const OverlapReal c[WIDE_OBB_COMPONENTS] = {obb.center.x,
+                                                obb.center.y,
+                                                obb.center.z,
+                                                obb.lengths.x,
+                                                obb.lengths.y,
+                                                obb.lengths.z,
+                                                r.row0.x,
+                                                r.row0.y,
+                                                r.row0.z,
+                                                r.row1.x,
+                                                r.row1.y,
+                                                r.row1.z,
+                                                r.row2.x,
+                                                r.row2.y,
+                                                r.row2.z};
+    for (unsigned int i = 0; i < WIDE_OBB_COMPONENTS; ++i)
+        dest[i * WIDE_OBB_WIDTH + lane] = c[i];
+    }
+
+//! Test an OBB against all lanes of a wide node with the separating axis theorem
+/*! \param a The OBB
+    \param b Storage of the wide node, as written by storeWideOBB()
+    \returns A bit mask with bit l set when \a a overlaps the OBB in lane l
+
+    This is the same test as overlap(const OBB&, const OBB&) for two boxes, evaluated for all lanes
+    at once. The caller handles masks and spheres.
+*/
+inline unsigned int overlapWide(const OBB& a, const OverlapReal* b)
+    {
+    const unsigned int all_lanes = (1u << WIDE_OBB_WIDTH) - 1;
+
+    // rows of the rotation matrix of a, the columns of its transpose
+    rotmat3<OverlapReal> ra(a.rotation);
+    const OverlapReal ar[3][3] = {{ra.row0.x, ra.row0.y, ra.row0.z},
+                                  {ra.row1.x, ra.row1.y, ra.row1.z},
+                                  {ra.row2.x, ra.row2.y, ra.row2.z}};
+
+    auto component = [b](unsigned int i) { return WideReal::load(b + i * WIDE_OBB_WIDTH); };
+
+    // translation between the centers in the frame of a
+    WideReal d[3] = {component(0) - WideReal(a.center.x),
+                     component(1) - WideReal(a.center.y),
+                     component(2) - WideReal(a.center.z)};
+    WideReal t[3];
+    for (unsigned int i = 0; i < 3; ++i)
+        t[i] = WideReal(ar[0][i]) * d[0] + WideReal(ar[1][i]) * d[1] + WideReal(ar[2][i]) * d[2];
+
+    // rotation of b in the frame of a, r[i][j] = sum_k ar[k][i] * br[k][j]
+    WideReal r[3][3];
+    WideReal rabs[3][3];
+    const WideReal eps(OverlapReal(1e-6));
+    for (unsigned int i = 0; i < 3; ++i)
+        {
+        for (unsigned int j = 0; j < 3; ++j)
+            {
+            r[i][j] = WideReal(ar[0][i]) * component(6 + j) + WideReal(ar[1][i]) * component(9 + j)
+                      + WideReal(ar[2][i]) * component(12 + j);
+            rabs[i][j] = r[i][j].abs() + eps;
+            }
+        }
+
+    const WideReal ea[3] = {WideReal(a.lengths.x), WideReal(a.lengths.y), WideReal(a.lengths.z)};
+    const WideReal eb[3] = {component(3), component(4), component(5)};
+
+    unsigned int separated = 0;
+
+    // test axes L = a0, a1, a2
+    for (unsigned int i = 0; i < 3; ++i)
+        {
+        WideReal rb = eb[0] * rabs[i][0] + eb[1] * rabs[i][1] + eb[2] * rabs[i][2];
+        separated |= t[i].abs().greaterThan(ea[i] + rb);
+        }
+
+    // test axes L = b0, b1, b2
+    for (unsigned int j = 0; j < 3; ++j)
+        {
+        WideReal ra_j = ea[0] * rabs[0][j] + ea[1] * rabs[1][j] + ea[2] * rabs[2][j];
+        WideReal proj = t[0] * r[0][j] + t[1] * r[1][j] + t[2] * r[2][j];
+        separated |= proj.abs().greaterThan(ra_j + eb[j]);
+        }
+
+    if (separated == all_lanes)
+        return 0;
+
+    // test axes L = ai x bj
+    for (unsigned int i = 0; i < 3; ++i)
+        {
+        unsigned int i1 = (i + 1) % 3;
+        unsigned int i2 = (i + 2) % 3;
+        for (unsigned int j = 0; j < 3; ++j)
+            {
+            unsigned int j1 = (j + 1) % 3;
+            unsigned int j2 = (j + 2) % 3;
+            WideReal ra_ij = ea[i1] * rabs[i2][j] + ea[i2] * rabs[i1][j];
+            WideReal rb_ij = eb[j1] * rabs[i][j2] + eb[j2] * rabs[i][j1];
+            WideReal proj = t[i2] * r[i1][j] - t[i1] * r[i2][j];
+            separated |= proj.abs().greaterThan(ra_ij + rb_ij);
+            }
+        }
+
+    return ~separated & all_lanes;
+    }
+
+    } // end namespace detail
+    } // end namespace hpmc
+
+#endif // __WIDE_OBB_H__
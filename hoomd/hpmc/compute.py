@@ -6,7 +6,6 @@
 
 from __future__ import print_function
 
-from hoomd import _hoomd
 from hoomd.operation import Compute
 from hoomd.hpmc import _hpmc
 from hoomd.hpmc import integrate
@@ -22,6 +21,10 @@ class FreeVolume(Compute):
     Args:
         test_particle_type (str): Test particle type.
         num_samples (int): Number of samples to evaluate.
+        num_strata (int): Number of strata along each box dimension.
+            Defaults to 1.
+        accumulate (bool): When `True`, accumulate the samples of all computes
+            until `reset` is called. Defaults to `False`.
 
     `FreeVolume` computes the free volume in the simulation state available to a
     given test particle using Monte Carlo integration. It must be used in
@@ -42,6 +45,27 @@ class FreeVolume(Compute):
     :math:`n_\mathrm{overlaps}` is the number of overlapping test placements,
     and :math:`V_\mathrm{box}` is the volume of the simulation box.
 
+    When `num_strata` is larger than 1, `FreeVolume` divides the box into
+    ``num_strata**3`` (``num_strata**2`` in 2D) strata of equal volume and
+    estimates the free volume with:
+
+    .. math::
+        V_\mathrm{free} = \sum_s \frac{V_\mathrm{box}}{n_\mathrm{strata}}
+            \left( \frac{n_{\mathrm{samples},s} - n_{\mathrm{overlaps},s}}
+                   {n_{\mathrm{samples},s}} \right)
+
+    Every stratum receives at least one sample. `FreeVolume` distributes the
+    remaining samples in proportion to :math:`\sqrt{p_s (1 - p_s)}`, where
+    :math:`p_s` is the free fraction of the stratum estimated from the previous
+    samples. Strata that are entirely inside particles or entirely free
+    receive fewer samples, which reduces the statistical error of the estimate
+    for a given `num_samples`.
+
+    When `accumulate` is `True`, the sample counts of all computes add up until
+    `reset` is called and `free_volume` averages over the sampled
+    configurations. `free_volume_error` reports the standard error of the
+    estimate.
+
     Note:
 
         The test particle type must exist in the simulation state and its shape
@@ -64,14 +88,28 @@ class FreeVolume(Compute):
 
         num_samples (int): Number of samples to evaluate.
 
+        num_strata (int): Number of strata along each box dimension.
+
+        accumulate (bool): When `True`, accumulate the samples of all computes
+            until `reset` is called.
+
     """
 
-    def __init__(self, test_particle_type, num_samples):
+    def __init__(self,
+                 test_particle_type,
+                 num_samples,
+                 num_strata=1,
+                 accumulate=False):
         # store metadata
-        param_dict = ParameterDict(test_particle_type=str, num_samples=int)
+        param_dict = ParameterDict(test_particle_type=str,
+                                   num_samples=int,
+                                   num_strata=int,
+                                   accumulate=bool)
         param_dict.update(
             dict(test_particle_type=test_particle_type,
-                 num_samples=num_samples))
+                 num_samples=num_samples,
+                 num_strata=num_strata,
+                 accumulate=accumulate))
         self._param_dict.update(param_dict)
 
     def _attach(self):
@@ -90,9 +128,8 @@ class FreeVolume(Compute):
         except AttributeError:
             raise RuntimeError("Unsupported integrator.")
 
-        cl = _hoomd.CellList(self._simulation.state._cpp_sys_def)
         self._cpp_obj = cpp_cls(self._simulation.state._cpp_sys_def,
-                                integrator._cpp_obj, cl)
+                                integrator._cpp_obj)
 
         super()._attach()
 
@@ -104,6 +141,19 @@ class FreeVolume(Compute):
         self._cpp_obj.compute(self._simulation.timestep)
         return self._cpp_obj.free_volume
 
+    @log(requires_run=True)
+    def free_volume_error(self):
+        """Standard error of `free_volume` \
+        :math:`[\\mathrm{length}^{2}]` in 2D and \
+        :math:`[\\mathrm{length}^{3}]` in 3D."""
+        self._cpp_obj.compute(self._simulation.timestep)
+        return self._cpp_obj.free_volume_error
+
+    def reset(self):
+        """Discard the accumulated samples."""
+        if self._attached:
+            self._cpp_obj.reset()
+
 
 class SDF(Compute):
     r"""Compute the scale distribution function.
@@ -144,7 +194,8 @@ class SDF(Compute):
         concave particles or enthalpic interactions.
 
     Note:
-        `SDF` runs on the CPU even in GPU simulations.
+        On the GPU, `SDF` falls back to the CPU implementation when the box is
+        too small for the minimum image convention.
 
     Attributes:
         xmax (float): Maximum *x* value at the right hand side of the rightmost
@@ -166,7 +217,11 @@ class SDF(Compute):
         # Extract 'Shape' from '<hoomd.hpmc.integrate.Shape object>'
         integrator_name = integrator.__class__.__name__
 
-        cpp_cls = getattr(_hpmc, 'ComputeSDF' + integrator_name)
+        cpp_cls_name = 'ComputeSDF' + integrator_name
+        if (isinstance(self._simulation.device, hoomd.device.GPU)
+                and (cpp_cls_name + 'GPU') in _hpmc.__dict__):
+            cpp_cls_name += 'GPU'
+        cpp_cls = getattr(_hpmc, cpp_cls_name)
 
         self._cpp_obj = cpp_cls(self._simulation.state._cpp_sys_def,
                                 integrator._cpp_obj, self.xmax, self.dx)
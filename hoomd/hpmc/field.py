@@ -90,42 +90,39 @@ class lattice_field(_external):
         import numpy
         _external.__init__(self)
         cls = None
-        if not hoomd.context.current.device.cpp_exec_conf.isCUDAEnabled():
-            if isinstance(mc, integrate.sphere):
-                cls = _hpmc.ExternalFieldLatticeSphere
-            elif isinstance(mc, integrate.convex_polygon):
-                cls = _hpmc.ExternalFieldLatticeConvexPolygon
-            elif isinstance(mc, integrate.simple_polygon):
-                cls = _hpmc.ExternalFieldLatticeSimplePolygon
-            elif isinstance(mc, integrate.convex_polyhedron):
-                cls = _hpmc.ExternalFieldLatticeConvexPolyhedron
-            elif isinstance(mc, integrate.convex_spheropolyhedron):
-                cls = _hpmc.ExternalFieldLatticeSpheropolyhedron
-            elif isinstance(mc, integrate.ellipsoid):
-                cls = _hpmc.ExternalFieldLatticeEllipsoid
-            elif isinstance(mc, integrate.convex_spheropolygon):
-                cls = _hpmc.ExternalFieldLatticeSpheropolygon
-            elif isinstance(mc, integrate.faceted_ellipsoid):
-                cls = _hpmc.ExternalFieldLatticeFacetedEllipsoid
-            elif isinstance(mc, integrate.polyhedron):
-                cls = _hpmc.ExternalFieldLatticePolyhedron
-            elif isinstance(mc, integrate.sphinx):
-                cls = _hpmc.ExternalFieldLatticeSphinx
-            elif isinstance(mc, integrate.sphere_union):
-                cls = _hpmc.ExternalFieldLatticeSphereUnion
-            elif isinstance(mc, integrate.faceted_ellipsoid_union):
-                cls = _hpmc.ExternalFieldlatticeFacetedEllipsoidUnion
-            elif isinstance(mc, integrate.convex_spheropolyhedron_union):
-                cls = _hpmc.ExternalFieldLatticeConvexPolyhedronUnion
-            else:
-                hoomd.context.current.device.cpp_msg.error(
-                    "compute.position_lattice_field: Unsupported integrator.\n")
-                raise RuntimeError(
-                    "Error initializing compute.position_lattice_field")
+        if isinstance(mc, integrate.sphere):
+            cls = _hpmc.ExternalFieldLatticeSphere
+        elif isinstance(mc, integrate.convex_polygon):
+            cls = _hpmc.ExternalFieldLatticeConvexPolygon
+        elif isinstance(mc, integrate.simple_polygon):
+            cls = _hpmc.ExternalFieldLatticeSimplePolygon
+        elif isinstance(mc, integrate.convex_polyhedron):
+            cls = _hpmc.ExternalFieldLatticeConvexPolyhedron
+        elif isinstance(mc, integrate.convex_spheropolyhedron):
+            cls = _hpmc.ExternalFieldLatticeSpheropolyhedron
+        elif isinstance(mc, integrate.ellipsoid):
+            cls = _hpmc.ExternalFieldLatticeEllipsoid
+        elif isinstance(mc, integrate.convex_spheropolygon):
+            cls = _hpmc.ExternalFieldLatticeSpheropolygon
+        elif isinstance(mc, integrate.faceted_ellipsoid):
+            cls = _hpmc.ExternalFieldLatticeFacetedEllipsoid
+        elif isinstance(mc, integrate.polyhedron):
+            cls = _hpmc.ExternalFieldLatticePolyhedron
+        elif isinstance(mc, integrate.sphinx):
+            cls = _hpmc.ExternalFieldLatticeSphinx
+        elif isinstance(mc, integrate.sphere_union):
+            cls = _hpmc.ExternalFieldLatticeSphereUnion
+        elif isinstance(mc, integrate.faceted_ellipsoid_union):
+            cls = _hpmc.ExternalFieldLatticeFacetedEllipsoidUnion
+        elif isinstance(mc, integrate.convex_spheropolyhedron_union):
+            cls = _hpmc.ExternalFieldLatticeConvexPolyhedronUnion
         else:
-            hoomd.context.current.device.cpp_msg.error("GPU not supported yet")
+            hoomd.context.current.device.cpp_msg.error(
+                "compute.position_lattice_field: Unsupported integrator.\n")
             raise RuntimeError(
                 "Error initializing compute.position_lattice_field")
+        if hoomd.context.current.device.cpp_exec_conf.isCUDAEnabled():
+            cls = getattr(_hpmc, cls.__name__ + "GPU")
 
         self.compute_name = "lattice_field"
         enlist = hoomd.hpmc.data._param.ensure_list
@@ -377,20 +374,18 @@ class wall(_external):
         cls = None
         self.compute_name = "wall-" + str(wall.index)
         wall.index += 1
-        if not hoomd.context.current.device.cpp_exec_conf.isCUDAEnabled():
-            if isinstance(mc, integrate.sphere):
-                cls = _hpmc.WallSphere
-            elif isinstance(mc, integrate.convex_polyhedron):
-                cls = _hpmc.WallConvexPolyhedron
-            elif isinstance(mc, integrate.convex_spheropolyhedron):
-                cls = _hpmc.WallSpheropolyhedron
-            else:
-                hoomd.context.current.device.cpp_msg.error(
-                    "compute.wall: Unsupported integrator.\n")
-                raise RuntimeError("Error initializing compute.wall")
+        if isinstance(mc, integrate.sphere):
+            cls = _hpmc.WallSphere
+        elif isinstance(mc, integrate.convex_polyhedron):
+            cls = _hpmc.WallConvexPolyhedron
+        elif isinstance(mc, integrate.convex_spheropolyhedron):
+            cls = _hpmc.WallSpheropolyhedron
         else:
-            hoomd.context.current.device.cpp_msg.error("GPU not supported yet")
+            hoomd.context.current.device.cpp_msg.error(
+                "compute.wall: Unsupported integrator.\n")
             raise RuntimeError("Error initializing compute.wall")
+        if hoomd.context.current.device.cpp_exec_conf.isCUDAEnabled():
+            cls = getattr(_hpmc, cls.__name__ + "GPU")
 
         self.cpp_compute = cls(hoomd.context.current.system_definition,
                                mc.cpp_integrator)
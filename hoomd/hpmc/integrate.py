@@ -4,7 +4,6 @@
 
 """Hard particle Monte Carlo integrators."""
 
-from hoomd import _hoomd
 from hoomd.data.parameterdicts import TypeParameterDict, ParameterDict
 from hoomd.data.typeconverter import OnlyIf, to_type_converter
 from hoomd.data.typeparam import TypeParameter
@@ -109,16 +108,69 @@ class HPMCIntegrator(BaseIntegrator):
             overlap checks between particles of those types (**default:**
             `True`).
 
+        max_translation_move (`TypeParameter` [``particle type``, `float`]):
+            Largest value of `d` that the move size controller sets
+            :math:`[\\mathrm{length}]` (**default:** ``inf``).
+
+        max_rotation_move (`TypeParameter` [``particle type``, `float`]):
+            Largest value of `a` that the move size controller sets
+            :math:`[\\mathrm{dimensionless}]` (**default:** ``inf``).
+
         translation_move_probability (float): Fraction of moves to be selected
             as translation moves.
 
         nselect (int): Number of trial moves to perform per particle per
             timestep.
 
+        checkerboard (bool): When `True`, split the box into a checkerboard of
+            cells at least as wide as the largest interaction range and perform
+            the trial moves in the cells of each color in parallel on the CPU
+            (**default:** `False`). Moves that leave a cell are rejected, and
+            the checkerboard is randomly shifted on every sweep to maintain
+            detailed balance. The trajectory does not depend on the number of
+            threads. Falls back to the serial sweep when there are implicit
+            depletants without `depletant_cache`, an external field, or too
+            few cells. Has no effect on the GPU.
+
+        aabb_refit_threshold (float): When positive, refit the AABB tree used
+            to find neighboring particles in place after particles move instead
+            of rebuilding it, as long as the local particles and their order are
+            unchanged (**default:** 0). The tree is rebuilt when refitting
+            grows the total surface area of its nodes by more than this fraction
+            of the value after the last rebuild. Set to 0 to rebuild the tree
+            after every move.
+
+        depletant_cache (bool): When `True`, insert the depletants once per
+            timestep into the free volume and reject the trial moves that
+            overlap them, instead of inserting depletants into the excluded
+            volume of every trial move (**default:** `False`). Both methods
+            sample the same distribution of the particles. The cached
+            depletants cost far fewer overlap checks at high fugacities,
+            ignore `depletant_ntrial`, and allow the `checkerboard` sweep.
+            Requires positive fugacities set for single depletant types
+            (``('A', 'A')``) and does not support domain decomposition. Has no
+            effect on the GPU.
+
+        move_size_period (int): When positive, scale `d` and `a` every
+            `move_size_period` time steps toward `move_size_target` from the
+            acceptance ratio of the moves since the last update (**default:**
+            0). The controller runs inside the integrator, on the device with
+            GPUs, and does not trigger Python code. All types share the
+            acceptance ratio of their kind of move. Each update changes the
+            move sizes by at most a factor of 2. Changing `d` and `a` during a
+            simulation breaks detailed balance, so disable the controller
+            before sampling. An alternative to `hoomd.hpmc.tune.MoveSize`.
+
+        move_size_target (float): Acceptance ratio that the move size
+            controller aims for (**default:** 0.2).
+
+        move_size_gain (float): Damping of the move size controller
+            (**default:** 1.0). The move sizes are scaled by
+            :math:`(\\alpha + g) / (\\alpha_\\mathrm{target} + g)`, where
+            :math:`\\alpha` is the acceptance ratio and :math:`g` the gain.
+
     .. rubric:: Attributes
     """
-    _remove_for_pickling = BaseIntegrator._remove_for_pickling + ('_cpp_cell',)
-    _skip_for_equality = BaseIntegrator._skip_for_equality | {'_cpp_cell'}
     _cpp_cls = None
 
     def __init__(self, default_d, default_a, translation_move_probability,
@@ -128,7 +180,13 @@ class HPMCIntegrator(BaseIntegrator):
         # Set base parameter dict for hpmc integrators
         param_dict = ParameterDict(
             translation_move_probability=float(translation_move_probability),
-            nselect=int(nselect))
+            nselect=int(nselect),
+            checkerboard=False,
+            aabb_refit_threshold=float(0.0),
+            depletant_cache=False,
+            move_size_period=int(0),
+            move_size_target=float(0.2),
+            move_size_gain=float(1.0))
         self._param_dict.update(param_dict)
 
         # Set standard typeparameters for hpmc integrators
@@ -156,9 +214,19 @@ class HPMCIntegrator(BaseIntegrator):
                                                param_dict=TypeParameterDict(
                                                    True, len_keys=2))
 
+        typeparam_max_d = TypeParameter('max_translation_move',
+                                        type_kind='particle_types',
+                                        param_dict=TypeParameterDict(
+                                            float('inf'), len_keys=1))
+
+        typeparam_max_a = TypeParameter('max_rotation_move',
+                                        type_kind='particle_types',
+                                        param_dict=TypeParameterDict(
+                                            float('inf'), len_keys=1))
+
         self._extend_typeparam([
             typeparam_d, typeparam_a, typeparam_fugacity, typeparam_ntrial,
-            typeparam_inter_matrix
+            typeparam_inter_matrix, typeparam_max_d, typeparam_max_a
         ])
 
     def _add(self, simulation):
@@ -176,19 +244,12 @@ class HPMCIntegrator(BaseIntegrator):
         sys_def = self._simulation.state._cpp_sys_def
         if (isinstance(self._simulation.device, hoomd.device.GPU)
                 and (self._cpp_cls + 'GPU') in _hpmc.__dict__):
-            self._cpp_cell = _hoomd.CellListGPU(sys_def)
-            if self._simulation._system_communicator is not None:
-                self._cpp_cell.setCommunicator(
-                    self._simulation._system_communicator)
-            self._cpp_obj = getattr(_hpmc,
-                                    self._cpp_cls + 'GPU')(sys_def,
-                                                           self._cpp_cell)
+            self._cpp_obj = getattr(_hpmc, self._cpp_cls + 'GPU')(sys_def)
         else:
             if isinstance(self._simulation.device, hoomd.device.GPU):
                 self._simulation.device._cpp_msg.warning(
                     "Falling back on CPU. No GPU implementation for shape.\n")
             self._cpp_obj = getattr(_hpmc, self._cpp_cls)(sys_def)
-            self._cpp_cell = None
 
         super()._attach()
 
@@ -262,9 +323,13 @@ class HPMCIntegrator(BaseIntegrator):
 
     @log(requires_run=True)
     def overlaps(self):
-        """int: Number of overlapping particle pairs."""
+        """int: Number of overlapping particle pairs.
+
+        GPU integrators count the overlaps on the device.
+        """
         self._cpp_obj.communicate(True)
-        return self._cpp_obj.countOverlaps(False)
+        return self._cpp_obj.countOverlapsUpTo(self._simulation.timestep,
+                                               2**32 - 1)
 
     def test_overlap(self,
                      type_i,
@@ -458,6 +523,68 @@ class Sphere(HPMCIntegrator):
         return super()._return_type_shapes()
 
 
+class SphereEventChain(Sphere):
+    """Hard sphere event-chain Monte Carlo.
+
+    Args:
+        default_d (float): Default maximum length of each step of an event
+            chain :math:`[\\mathrm{length}]`.
+        default_a (float): Default maximum size of rotation trial moves
+            :math:`[\\mathrm{dimensionless}]`.
+        translation_move_probability (float): Fraction of moves that are
+            event chains.
+        nselect (int): Number of event chains to start per particle per
+            timestep.
+        chain_length (float): Total displacement of each event chain
+            :math:`[\\mathrm{length}]`.
+
+    `SphereEventChain` replaces the translation trial moves of `Sphere` with
+    event chains (`Bernard et al. 2009
+    <https://doi.org/10.1103/PhysRevE.80.056704>`_). An event chain starts at
+    a particle and moves it in a random direction until it touches another
+    particle. The chain then continues with the particle it collided with,
+    moving it in the same direction, until the total displacement of all
+    particles in the chain reaches `chain_length`. The displacements are never
+    rejected, which decorrelates dense systems much faster than the trial moves
+    of `Sphere`.
+
+    Chains advance in steps of at most `d` of the moving particle, which bounds
+    the cost of finding the next collision. Rotation moves of orientable
+    spheres are trial moves selected with `translation_move_probability`, as
+    in `Sphere`.
+
+    With domain decomposition, event chains start only at particles in the
+    active region of each rank and stop at its boundary. Event chains run on
+    the CPU and do not support implicit depletants, external fields, or patch
+    energies.
+
+    Examples::
+
+        mc = hoomd.hpmc.integrate.SphereEventChain(default_d=0.5,
+                                                   chain_length=2.0)
+        mc.shape["A"] = dict(diameter=1.0)
+
+    Attributes:
+        chain_length (float): Total displacement of each event chain
+            :math:`[\\mathrm{length}]`.
+    """
+    _cpp_cls = 'IntegratorHPMCMonoEventChainSphere'
+
+    def __init__(self,
+                 default_d=0.1,
+                 default_a=0.1,
+                 translation_move_probability=0.5,
+                 nselect=4,
+                 chain_length=1.0):
+
+        # initialize base class
+        super().__init__(default_d, default_a, translation_move_probability,
+                         nselect)
+
+        self._param_dict.update(
+            ParameterDict(chain_length=float(chain_length)))
+
+
 class ConvexPolygon(HPMCIntegrator):
     """Hard convex polygon Monte Carlo.
 
@@ -1034,6 +1161,55 @@ class ConvexPolyhedron(HPMCIntegrator):
         return super(ConvexPolyhedron, self)._return_type_shapes()
 
 
+class ConvexPolyhedronEventChain(ConvexPolyhedron):
+    """Hard convex polyhedron event-chain Monte Carlo.
+
+    Args:
+        default_d (float): Default maximum length of each step of an event
+            chain :math:`[\\mathrm{length}]`.
+        default_a (float): Default maximum size of rotation trial moves
+            :math:`[\\mathrm{dimensionless}]`.
+        translation_move_probability (float): Fraction of moves that are
+            event chains.
+        nselect (int): Number of event chains to start per particle per
+            timestep.
+        chain_length (float): Total displacement of each event chain
+            :math:`[\\mathrm{length}]`.
+
+    `ConvexPolyhedronEventChain` replaces the translation trial moves of
+    `ConvexPolyhedron` with event chains. See `SphereEventChain` for a
+    description of the algorithm. The distance to the next collision is
+    found by bisection and stops short of the contact by at most
+    :math:`10^{-5}` times the sum of the circumsphere radii.
+
+    Examples::
+
+        mc = hoomd.hpmc.integrate.ConvexPolyhedronEventChain(
+            default_d=0.5, chain_length=2.0)
+        mc.shape["A"] = dict(vertices=[(0.5, 0.5, 0.5), (0.5, -0.5, -0.5),
+                                       (-0.5, 0.5, -0.5), (-0.5, -0.5, 0.5)])
+
+    Attributes:
+        chain_length (float): Total displacement of each event chain
+            :math:`[\\mathrm{length}]`.
+    """
+    _cpp_cls = 'IntegratorHPMCMonoEventChainConvexPolyhedron'
+
+    def __init__(self,
+                 default_d=0.1,
+                 default_a=0.1,
+                 translation_move_probability=0.5,
+                 nselect=4,
+                 chain_length=1.0):
+
+        # initialize base class
+        super().__init__(default_d, default_a, translation_move_probability,
+                         nselect)
+
+        self._param_dict.update(
+            ParameterDict(chain_length=float(chain_length)))
+
+
 class FacetedEllipsoid(HPMCIntegrator):
     r"""Hard faceted ellipsoid Monte Carlo.
 
@@ -1349,6 +1525,55 @@ class ConvexSpheropolyhedron(HPMCIntegrator):
         return super(ConvexSpheropolyhedron, self)._return_type_shapes()
 
 
+class ConvexSpheropolyhedronEventChain(ConvexSpheropolyhedron):
+    """Hard convex spheropolyhedron event-chain Monte Carlo.
+
+    Args:
+        default_d (float): Default maximum length of each step of an event
+            chain :math:`[\\mathrm{length}]`.
+        default_a (float): Default maximum size of rotation trial moves
+            :math:`[\\mathrm{dimensionless}]`.
+        translation_move_probability (float): Fraction of moves that are
+            event chains.
+        nselect (int): Number of event chains to start per particle per
+            timestep.
+        chain_length (float): Total displacement of each event chain
+            :math:`[\\mathrm{length}]`.
+
+    `ConvexSpheropolyhedronEventChain` replaces the translation trial moves
+    of `ConvexSpheropolyhedron` with event chains. See `SphereEventChain`
+    for a description of the algorithm. The distance to the next collision
+    is found by bisection and stops short of the contact by at most
+    :math:`10^{-5}` times the sum of the circumsphere radii.
+
+    Examples::
+
+        mc = hoomd.hpmc.integrate.ConvexSpheropolyhedronEventChain(
+            default_d=0.5, chain_length=2.0)
+        mc.shape["A"] = dict(vertices=[(0.5, 0.5, 0.5), (0.5, -0.5, -0.5),
+                                       (-0.5, 0.5, -0.5), (-0.5, -0.5, 0.5)])
+
+    Attributes:
+        chain_length (float): Total displacement of each event chain
+            :math:`[\\mathrm{length}]`.
+    """
+    _cpp_cls = 'IntegratorHPMCMonoEventChainSpheropolyhedron'
+
+    def __init__(self,
+                 default_d=0.1,
+                 default_a=0.1,
+                 translation_move_probability=0.5,
+                 nselect=4,
+                 chain_length=1.0):
+
+        # initialize base class
+        super().__init__(default_d, default_a, translation_move_probability,
+                         nselect)
+
+        self._param_dict.update(
+            ParameterDict(chain_length=float(chain_length)))
+
+
 class Ellipsoid(HPMCIntegrator):
     """Hard ellipsoid Monte Carlo.
 
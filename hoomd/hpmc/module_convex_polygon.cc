@@ -22,8 +22,11 @@
 
 #ifdef ENABLE_HIP
 #include "ComputeFreeVolumeGPU.h"
+#include "ComputeSDFGPU.h"
+#include "ExternalFieldLatticeGPU.h"
 #include "IntegratorHPMCMonoGPU.h"
 #include "UpdaterClustersGPU.h"
+#include "UpdaterMuVTGPU.h"
 #endif
 
 namespace py = pybind11;
@@ -54,6 +57,9 @@ void export_convex_polygon(py::module& m)
     export_IntegratorHPMCMonoGPU<ShapeConvexPolygon>(m, "IntegratorHPMCMonoConvexPolygonGPU");
     export_ComputeFreeVolumeGPU<ShapeConvexPolygon>(m, "ComputeFreeVolumeConvexPolygonGPU");
     export_UpdaterClustersGPU<ShapeConvexPolygon>(m, "UpdaterClustersConvexPolygonGPU");
+    export_UpdaterMuVTGPU<ShapeConvexPolygon>(m, "UpdaterMuVTConvexPolygonGPU");
+    export_ComputeSDFGPU<ShapeConvexPolygon>(m, "ComputeSDFConvexPolygonGPU");
+    export_LatticeFieldGPU<ShapeConvexPolygon>(m, "ExternalFieldLatticeConvexPolygonGPU");
 #endif
     }
 
@@ -5,6 +5,7 @@
 #include "ComputeFreeVolume.h"
 #include "IntegratorHPMC.h"
 #include "IntegratorHPMCMono.h"
+#include "IntegratorHPMCMonoEventChain.h"
 
 #include "ComputeSDF.h"
 #include "ShapeConvexPolyhedron.h"
@@ -22,8 +23,12 @@
 
 #ifdef ENABLE_HIP
 #include "ComputeFreeVolumeGPU.h"
+#include "ComputeSDFGPU.h"
+#include "ExternalFieldLatticeGPU.h"
+#include "ExternalFieldWallGPU.h"
 #include "IntegratorHPMCMonoGPU.h"
 #include "UpdaterClustersGPU.h"
+#include "UpdaterMuVTGPU.h"
 #endif
 
 namespace py = pybind11;
@@ -37,6 +42,9 @@ namespace hpmc
 void export_convex_polyhedron(py::module& m)
     {
     export_IntegratorHPMCMono<ShapeConvexPolyhedron>(m, "IntegratorHPMCMonoConvexPolyhedron");
+    export_IntegratorHPMCMonoEventChain<ShapeConvexPolyhedron>(
+        m,
+        "IntegratorHPMCMonoEventChainConvexPolyhedron");
     export_ComputeFreeVolume<ShapeConvexPolyhedron>(m, "ComputeFreeVolumeConvexPolyhedron");
     export_ComputeSDF<ShapeConvexPolyhedron>(m, "ComputeSDFConvexPolyhedron");
     export_UpdaterMuVT<ShapeConvexPolyhedron>(m, "UpdaterMuVTConvexPolyhedron");
@@ -57,6 +65,10 @@ void export_convex_polyhedron(py::module& m)
     export_IntegratorHPMCMonoGPU<ShapeConvexPolyhedron>(m, "IntegratorHPMCMonoConvexPolyhedronGPU");
     export_ComputeFreeVolumeGPU<ShapeConvexPolyhedron>(m, "ComputeFreeVolumeConvexPolyhedronGPU");
     export_UpdaterClustersGPU<ShapeConvexPolyhedron>(m, "UpdaterClustersConvexPolyhedronGPU");
+    export_UpdaterMuVTGPU<ShapeConvexPolyhedron>(m, "UpdaterMuVTConvexPolyhedronGPU");
+    export_ComputeSDFGPU<ShapeConvexPolyhedron>(m, "ComputeSDFConvexPolyhedronGPU");
+    export_LatticeFieldGPU<ShapeConvexPolyhedron>(m, "ExternalFieldLatticeConvexPolyhedronGPU");
+    export_ExternalFieldWallGPU<ShapeConvexPolyhedron>(m, "WallConvexPolyhedronGPU");
 
 #endif
     }
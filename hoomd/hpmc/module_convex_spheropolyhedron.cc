@@ -5,6 +5,7 @@
 #include "ComputeFreeVolume.h"
 #include "IntegratorHPMC.h"
 #include "IntegratorHPMCMono.h"
+#include "IntegratorHPMCMonoEventChain.h"
 
 #include "ComputeSDF.h"
 #include "ShapeSpheropolyhedron.h"
@@ -22,8 +23,12 @@
 
 #ifdef ENABLE_HIP
 #include "ComputeFreeVolumeGPU.h"
+#include "ComputeSDFGPU.h"
+#include "ExternalFieldLatticeGPU.h"
+#include "ExternalFieldWallGPU.h"
 #include "IntegratorHPMCMonoGPU.h"
 #include "UpdaterClustersGPU.h"
+#include "UpdaterMuVTGPU.h"
 #endif
 
 namespace py = pybind11;
@@ -37,6 +42,9 @@ namespace hpmc
 void export_convex_spheropolyhedron(py::module& m)
     {
     export_IntegratorHPMCMono<ShapeSpheropolyhedron>(m, "IntegratorHPMCMonoSpheropolyhedron");
+    export_IntegratorHPMCMonoEventChain<ShapeSpheropolyhedron>(
+        m,
+        "IntegratorHPMCMonoEventChainSpheropolyhedron");
     export_ComputeFreeVolume<ShapeSpheropolyhedron>(m, "ComputeFreeVolumeSpheropolyhedron");
     export_ComputeSDF<ShapeSpheropolyhedron>(m, "ComputeSDFConvexSpheropolyhedron");
     export_UpdaterMuVT<ShapeSpheropolyhedron>(m, "UpdaterMuVTConvexSpheropolyhedron");
@@ -57,6 +65,10 @@ void export_convex_spheropolyhedron(py::module& m)
     export_IntegratorHPMCMonoGPU<ShapeSpheropolyhedron>(m, "IntegratorHPMCMonoSpheropolyhedronGPU");
     export_ComputeFreeVolumeGPU<ShapeSpheropolyhedron>(m, "ComputeFreeVolumeSpheropolyhedronGPU");
     export_UpdaterClustersGPU<ShapeSpheropolyhedron>(m, "UpdaterClustersConvexSpheropolyhedronGPU");
+    export_UpdaterMuVTGPU<ShapeSpheropolyhedron>(m, "UpdaterMuVTConvexSpheropolyhedronGPU");
+    export_ComputeSDFGPU<ShapeSpheropolyhedron>(m, "ComputeSDFConvexSpheropolyhedronGPU");
+    export_LatticeFieldGPU<ShapeSpheropolyhedron>(m, "ExternalFieldLatticeSpheropolyhedronGPU");
+    export_ExternalFieldWallGPU<ShapeSpheropolyhedron>(m, "WallSpheropolyhedronGPU");
 
 #endif
     }
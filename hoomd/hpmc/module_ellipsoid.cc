@@ -22,8 +22,11 @@
 
 #ifdef ENABLE_HIP
 #include "ComputeFreeVolumeGPU.h"
+#include "ComputeSDFGPU.h"
+#include "ExternalFieldLatticeGPU.h"
 #include "IntegratorHPMCMonoGPU.h"
 #include "UpdaterClustersGPU.h"
+#include "UpdaterMuVTGPU.h"
 #endif
 
 namespace py = pybind11;
@@ -53,6 +56,9 @@ void export_ellipsoid(py::module& m)
     export_IntegratorHPMCMonoGPU<ShapeEllipsoid>(m, "IntegratorHPMCMonoEllipsoidGPU");
     export_ComputeFreeVolumeGPU<ShapeEllipsoid>(m, "ComputeFreeVolumeEllipsoidGPU");
     export_UpdaterClustersGPU<ShapeEllipsoid>(m, "UpdaterClustersEllipsoidGPU");
+    export_UpdaterMuVTGPU<ShapeEllipsoid>(m, "UpdaterMuVTEllipsoidGPU");
+    export_ComputeSDFGPU<ShapeEllipsoid>(m, "ComputeSDFEllipsoidGPU");
+    export_LatticeFieldGPU<ShapeEllipsoid>(m, "ExternalFieldLatticeEllipsoidGPU");
 #endif
     }
 
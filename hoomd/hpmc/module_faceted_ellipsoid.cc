@@ -21,8 +21,11 @@
 
 #ifdef ENABLE_HIP
 #include "ComputeFreeVolumeGPU.h"
+#include "ComputeSDFGPU.h"
+#include "ExternalFieldLatticeGPU.h"
 #include "IntegratorHPMCMonoGPU.h"
 #include "UpdaterClustersGPU.h"
+#include "UpdaterMuVTGPU.h"
 #endif
 
 namespace py = pybind11;
@@ -55,6 +58,9 @@ void export_faceted_ellipsoid(py::module& m)
     export_IntegratorHPMCMonoGPU<ShapeFacetedEllipsoid>(m, "IntegratorHPMCMonoFacetedEllipsoidGPU");
     export_ComputeFreeVolumeGPU<ShapeFacetedEllipsoid>(m, "ComputeFreeVolumeFacetedEllipsoidGPU");
     export_UpdaterClustersGPU<ShapeFacetedEllipsoid>(m, "UpdaterClustersFacetedEllipsoidGPU");
+    export_UpdaterMuVTGPU<ShapeFacetedEllipsoid>(m, "UpdaterMuVTFacetedEllipsoidGPU");
+    export_ComputeSDFGPU<ShapeFacetedEllipsoid>(m, "ComputeSDFFacetedEllipsoidGPU");
+    export_LatticeFieldGPU<ShapeFacetedEllipsoid>(m, "ExternalFieldLatticeFacetedEllipsoidGPU");
 #endif
     }
 
@@ -22,8 +22,11 @@
 
 #ifdef ENABLE_HIP
 #include "ComputeFreeVolumeGPU.h"
+#include "ComputeSDFGPU.h"
+#include "ExternalFieldLatticeGPU.h"
 #include "IntegratorHPMCMonoGPU.h"
 #include "UpdaterClustersGPU.h"
+#include "UpdaterMuVTGPU.h"
 #endif
 
 namespace py = pybind11;
@@ -53,6 +56,9 @@ void export_polyhedron(py::module& m)
     export_IntegratorHPMCMonoGPU<ShapePolyhedron>(m, "IntegratorHPMCMonoPolyhedronGPU");
     export_ComputeFreeVolumeGPU<ShapePolyhedron>(m, "ComputeFreeVolumePolyhedronGPU");
     export_UpdaterClustersGPU<ShapePolyhedron>(m, "UpdaterClustersPolyhedronGPU");
+    export_UpdaterMuVTGPU<ShapePolyhedron>(m, "UpdaterMuVTPolyhedronGPU");
+    export_ComputeSDFGPU<ShapePolyhedron>(m, "ComputeSDFPolyhedronGPU");
+    export_LatticeFieldGPU<ShapePolyhedron>(m, "ExternalFieldLatticePolyhedronGPU");
 #endif
     }
 
@@ -22,8 +22,11 @@
 
 #ifdef ENABLE_HIP
 #include "ComputeFreeVolumeGPU.h"
+#include "ComputeSDFGPU.h"
+#include "ExternalFieldLatticeGPU.h"
 #include "IntegratorHPMCMonoGPU.h"
 #include "UpdaterClustersGPU.h"
+#include "UpdaterMuVTGPU.h"
 #endif
 
 namespace py = pybind11;
@@ -54,6 +57,9 @@ void export_simple_polygon(py::module& m)
     export_IntegratorHPMCMonoGPU<ShapeSimplePolygon>(m, "IntegratorHPMCMonoSimplePolygonGPU");
     export_ComputeFreeVolumeGPU<ShapeSimplePolygon>(m, "ComputeFreeVolumeSimplePolygonGPU");
     export_UpdaterClustersGPU<ShapeSimplePolygon>(m, "UpdaterClustersSimplePolygonGPU");
+    export_UpdaterMuVTGPU<ShapeSimplePolygon>(m, "UpdaterMuVTSimplePolygonGPU");
+    export_ComputeSDFGPU<ShapeSimplePolygon>(m, "ComputeSDFSimplePolygonGPU");
+    export_LatticeFieldGPU<ShapeSimplePolygon>(m, "ExternalFieldLatticeSimplePolygonGPU");
 #endif
     }
 
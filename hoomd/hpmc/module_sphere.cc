@@ -5,6 +5,7 @@
 #include "ComputeFreeVolume.h"
 #include "IntegratorHPMC.h"
 #include "IntegratorHPMCMono.h"
+#include "IntegratorHPMCMonoEventChain.h"
 
 #include "ComputeSDF.h"
 #include "ShapeSphere.h"
@@ -21,8 +22,12 @@
 #include "UpdaterMuVT.h"
 #ifdef ENABLE_HIP
 #include "ComputeFreeVolumeGPU.h"
+#include "ComputeSDFGPU.h"
+#include "ExternalFieldLatticeGPU.h"
+#include "ExternalFieldWallGPU.h"
 #include "IntegratorHPMCMonoGPU.h"
 #include "UpdaterClustersGPU.h"
+#include "UpdaterMuVTGPU.h"
 #endif
 
 namespace py = pybind11;
@@ -36,6 +41,7 @@ namespace hpmc
 void export_sphere(py::module& m)
     {
     export_IntegratorHPMCMono<ShapeSphere>(m, "IntegratorHPMCMonoSphere");
+    export_IntegratorHPMCMonoEventChain<ShapeSphere>(m, "IntegratorHPMCMonoEventChainSphere");
     export_ComputeFreeVolume<ShapeSphere>(m, "ComputeFreeVolumeSphere");
     export_ComputeSDF<ShapeSphere>(m, "ComputeSDFSphere");
     export_UpdaterMuVT<ShapeSphere>(m, "UpdaterMuVTSphere");
@@ -52,6 +58,10 @@ void export_sphere(py::module& m)
     export_IntegratorHPMCMonoGPU<ShapeSphere>(m, "IntegratorHPMCMonoSphereGPU");
     export_ComputeFreeVolumeGPU<ShapeSphere>(m, "ComputeFreeVolumeSphereGPU");
     export_UpdaterClustersGPU<ShapeSphere>(m, "UpdaterClustersSphereGPU");
+    export_UpdaterMuVTGPU<ShapeSphere>(m, "UpdaterMuVTSphereGPU");
+    export_ComputeSDFGPU<ShapeSphere>(m, "ComputeSDFSphereGPU");
+    export_LatticeFieldGPU<ShapeSphere>(m, "ExternalFieldLatticeSphereGPU");
+    export_ExternalFieldWallGPU<ShapeSphere>(m, "WallSphereGPU");
 #endif
     }
 
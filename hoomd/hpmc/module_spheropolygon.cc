@@ -22,8 +22,11 @@
 
 #ifdef ENABLE_HIP
 #include "ComputeFreeVolumeGPU.h"
+#include "ComputeSDFGPU.h"
+#include "ExternalFieldLatticeGPU.h"
 #include "IntegratorHPMCMonoGPU.h"
 #include "UpdaterClustersGPU.h"
+#include "UpdaterMuVTGPU.h"
 #endif
 
 namespace py = pybind11;
@@ -54,6 +57,9 @@ void export_spheropolygon(py::module& m)
     export_IntegratorHPMCMonoGPU<ShapeSpheropolygon>(m, "IntegratorHPMCMonoSpheropolygonGPU");
     export_ComputeFreeVolumeGPU<ShapeSpheropolygon>(m, "ComputeFreeVolumeSpheropolygonGPU");
     export_UpdaterClustersGPU<ShapeSpheropolygon>(m, "UpdaterClustersConvexSpheropolygonGPU");
+    export_UpdaterMuVTGPU<ShapeSpheropolygon>(m, "UpdaterMuVTConvexSpheropolygonGPU");
+    export_ComputeSDFGPU<ShapeSpheropolygon>(m, "ComputeSDFConvexSpheropolygonGPU");
+    export_LatticeFieldGPU<ShapeSpheropolygon>(m, "ExternalFieldLatticeSpheropolygonGPU");
 #endif
     }
 
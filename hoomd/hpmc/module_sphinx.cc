@@ -22,8 +22,11 @@
 
 #ifdef ENABLE_HIP
 #include "ComputeFreeVolumeGPU.h"
+#include "ComputeSDFGPU.h"
+#include "ExternalFieldLatticeGPU.h"
 #include "IntegratorHPMCMonoGPU.h"
 #include "UpdaterClustersGPU.h"
+#include "UpdaterMuVTGPU.h"
 #endif
 
 namespace py = pybind11;
@@ -55,6 +58,9 @@ void export_sphinx(py::module& m)
     export_IntegratorHPMCMonoGPU<ShapeSphinx>(m, "IntegratorHPMCMonoSphinxGPU");
     export_ComputeFreeVolumeGPU<ShapeSphinx>(m, "ComputeFreeVolumeSphinxGPU");
     export_UpdaterClustersGPU<ShapeSphinx>(m, "UpdaterClustersSphinxGPU");
+    export_UpdaterMuVTGPU<ShapeSphinx>(m, "UpdaterMuVTSphinxGPU");
+    export_ComputeSDFGPU<ShapeSphinx>(m, "ComputeSDFSphinxGPU");
+    export_LatticeFieldGPU<ShapeSphinx>(m, "ExternalFieldLatticeSphinxGPU");
 
 #endif
 #endif
@@ -21,8 +21,11 @@
 
 #ifdef ENABLE_HIP
 #include "ComputeFreeVolumeGPU.h"
+#include "ComputeSDFGPU.h"
+#include "ExternalFieldLatticeGPU.h"
 #include "IntegratorHPMCMonoGPU.h"
 #include "UpdaterClustersGPU.h"
+#include "UpdaterMuVTGPU.h"
 #endif
 
 namespace py = pybind11;
@@ -75,6 +78,15 @@ void export_union_convex_polyhedron(py::module& m)
     export_UpdaterClustersGPU<ShapeUnion<ShapeSpheropolyhedron>>(
         m,
         "UpdaterClustersConvexSpheropolyhedronUnionGPU");
+    export_UpdaterMuVTGPU<ShapeUnion<ShapeSpheropolyhedron>>(
+        m,
+        "UpdaterMuVTConvexSpheropolyhedronUnionGPU");
+    export_ComputeSDFGPU<ShapeUnion<ShapeSpheropolyhedron>>(
+        m,
+        "ComputeSDFConvexSpheropolyhedronUnionGPU");
+    export_LatticeFieldGPU<ShapeUnion<ShapeSpheropolyhedron>>(
+        m,
+        "ExternalFieldLatticeConvexPolyhedronUnionGPU");
 
 #endif
     }
@@ -21,8 +21,11 @@
 
 #ifdef ENABLE_HIP
 #include "ComputeFreeVolumeGPU.h"
+#include "ComputeSDFGPU.h"
+#include "ExternalFieldLatticeGPU.h"
 #include "IntegratorHPMCMonoGPU.h"
 #include "UpdaterClustersGPU.h"
+#include "UpdaterMuVTGPU.h"
 #endif
 
 namespace py = pybind11;
@@ -73,6 +76,15 @@ void export_union_faceted_ellipsoid(py::module& m)
     export_UpdaterClustersGPU<ShapeUnion<ShapeFacetedEllipsoid>>(
         m,
         "UpdaterClustersFacetedEllipsoidUnionGPU");
+    export_UpdaterMuVTGPU<ShapeUnion<ShapeFacetedEllipsoid>>(
+        m,
+        "UpdaterMuVTFacetedEllipsoidUnionGPU");
+    export_ComputeSDFGPU<ShapeUnion<ShapeFacetedEllipsoid>>(
+        m,
+        "ComputeSDFFacetedEllipsoidUnionGPU");
+    export_LatticeFieldGPU<ShapeUnion<ShapeFacetedEllipsoid>>(
+        m,
+        "ExternalFieldLatticeFacetedEllipsoidUnionGPU");
 
 #endif
     }
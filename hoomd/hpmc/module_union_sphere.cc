@@ -21,8 +21,11 @@
 
 #ifdef ENABLE_HIP
 #include "ComputeFreeVolumeGPU.h"
+#include "ComputeSDFGPU.h"
+#include "ExternalFieldLatticeGPU.h"
 #include "IntegratorHPMCMonoGPU.h"
 #include "UpdaterClustersGPU.h"
+#include "UpdaterMuVTGPU.h"
 #endif
 
 namespace py = pybind11;
@@ -55,6 +58,9 @@ void export_union_sphere(py::module& m)
     export_IntegratorHPMCMonoGPU<ShapeUnion<ShapeSphere>>(m, "IntegratorHPMCMonoSphereUnionGPU");
     export_ComputeFreeVolumeGPU<ShapeUnion<ShapeSphere>>(m, "ComputeFreeVolumeSphereUnionGPU");
     export_UpdaterClustersGPU<ShapeUnion<ShapeSphere>>(m, "UpdaterClustersSphereUnionGPU");
+    export_UpdaterMuVTGPU<ShapeUnion<ShapeSphere>>(m, "UpdaterMuVTSphereUnionGPU");
+    export_ComputeSDFGPU<ShapeUnion<ShapeSphere>>(m, "ComputeSDFSphereUnionGPU");
+    export_LatticeFieldGPU<ShapeUnion<ShapeSphere>>(m, "ExternalFieldLatticeSphereUnionGPU");
 
 #endif
     }
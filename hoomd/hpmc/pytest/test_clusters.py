@@ -23,7 +23,8 @@ valid_constructor_args = [
          flip_probability=1),
     dict(trigger=hoomd.trigger.Periodic(1000),
          pivot_move_ratio=0.7,
-         flip_probability=1),
+         flip_probability=1,
+         patch_energy_cache=True),
 ]
 
 valid_attrs = [('trigger', hoomd.trigger.Periodic(10000)),
@@ -31,7 +32,8 @@ valid_attrs = [('trigger', hoomd.trigger.Periodic(10000)),
                ('trigger', hoomd.trigger.Before(12345)),
                ('flip_probability', 0.2), ('flip_probability', 0.5),
                ('flip_probability', 0.8), ('pivot_move_ratio', 0.2),
-               ('pivot_move_ratio', 0.5), ('pivot_move_ratio', 0.8)]
+               ('pivot_move_ratio', 0.5), ('pivot_move_ratio', 0.8),
+               ('patch_energy_cache', True), ('patch_energy_cache', False)]
 
 
 @pytest.mark.serial
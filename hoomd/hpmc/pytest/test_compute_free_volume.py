@@ -70,3 +70,41 @@ def test_validation_systems(simulation_factory, two_particle_snapshot_factory,
     np.testing.assert_allclose(free_volume,
                                free_volume_compute.free_volume,
                                rtol=2e-2)
+
+
+def test_stratified_sampling(simulation_factory, lattice_snapshot_factory):
+    n = 7
+    radius1, radius2 = 0.4, 0.05
+    expected = (n**3) * (1 - (4 / 3) * np.pi * (radius1 + radius2)**3)
+    sim = simulation_factory(
+        lattice_snapshot_factory(particle_types=['A', 'B'],
+                                 n=n,
+                                 a=1,
+                                 dimensions=3,
+                                 r=0))
+
+    mc = hoomd.hpmc.integrate.Sphere()
+    mc.shape["A"] = {'diameter': radius1 * 2}
+    mc.shape["B"] = {'diameter': radius2 * 2}
+    sim.operations.add(mc)
+
+    free_volume_compute = hoomd.hpmc.compute.FreeVolume(test_particle_type='B',
+                                                        num_samples=2000,
+                                                        num_strata=4,
+                                                        accumulate=True)
+    sim.operations.add(free_volume_compute)
+    assert free_volume_compute.num_strata == 4
+    assert free_volume_compute.accumulate
+
+    # the samples of five steps accumulate into one estimate
+    for _ in range(5):
+        sim.run(1)
+        free_volume = free_volume_compute.free_volume
+
+    error = free_volume_compute.free_volume_error
+    assert error > 0
+    np.testing.assert_allclose(expected, free_volume, atol=5 * error)
+
+    free_volume_compute.reset()
+    sim.run(1)
+    assert free_volume_compute.free_volume_error > error
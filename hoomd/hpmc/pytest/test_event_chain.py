@@ -0,0 +1,69 @@
+# Copyright (c) 2009-2021 The Regents of the University of Michigan
+# This file is part of the HOOMD-blue project, released under the BSD 3-Clause
+# License.
+
+"""Test hoomd.hpmc event chain integrators."""
+
+import hoomd
+import numpy
+import pytest
+
+cube_vertices = [
+    (-0.5, -0.5, -0.5),
+    (-0.5, -0.5, 0.5),
+    (-0.5, 0.5, -0.5),
+    (-0.5, 0.5, 0.5),
+    (0.5, -0.5, -0.5),
+    (0.5, -0.5, 0.5),
+    (0.5, 0.5, -0.5),
+    (0.5, 0.5, 0.5),
+]
+
+# (integrator class, shape parameters, dimensions, lattice constant)
+event_chain_test_parameters = [
+    (hoomd.hpmc.integrate.SphereEventChain, dict(diameter=1.0), 3, 1.1),
+    (hoomd.hpmc.integrate.SphereEventChain, dict(diameter=1.0), 2, 1.1),
+    (hoomd.hpmc.integrate.ConvexPolyhedronEventChain,
+     dict(vertices=cube_vertices), 3, 1.2),
+    (hoomd.hpmc.integrate.ConvexSpheropolyhedronEventChain,
+     dict(vertices=cube_vertices, sweep_radius=0.1), 3, 1.4),
+]
+
+
+def test_chain_length():
+    """Test that chain_length is set."""
+    mc = hoomd.hpmc.integrate.SphereEventChain(chain_length=2.5)
+    assert mc.chain_length == 2.5
+
+    mc.chain_length = 0.5
+    assert mc.chain_length == 0.5
+
+
+@pytest.mark.parametrize("cls, shape, dimensions, a",
+                         event_chain_test_parameters)
+def test_event_chain(simulation_factory, lattice_snapshot_factory, cls, shape,
+                     dimensions, a):
+    """Test that event chains move particles without creating overlaps."""
+    snap = lattice_snapshot_factory(dimensions=dimensions, a=a, n=6)
+    sim = simulation_factory(snap)
+
+    mc = cls(default_d=0.3, default_a=0.1, chain_length=1.5, nselect=1)
+    mc.shape['A'] = shape
+    sim.operations.integrator = mc
+
+    sim.run(0)
+    assert mc.overlaps == 0
+
+    sim.run(10)
+    assert mc.overlaps == 0
+    assert mc.translate_moves[0] > 0
+    assert mc.translate_moves[1] == 0
+
+    snap_after = sim.state.snapshot
+    if snap_after.communicator.rank == 0:
+        displacement = (snap_after.particles.position
+                        - snap.particles.position)
+        assert numpy.any(numpy.abs(displacement) > 1e-3)
+        if dimensions == 2:
+            numpy.testing.assert_allclose(snap_after.particles.position[:, 2],
+                                          0)
@@ -125,6 +125,131 @@ def test_moves(device, simulation_factory, lattice_snapshot_factory,
         assert accepted_rejected_rot > 0
 
 
+@pytest.mark.cpu
+@pytest.mark.parametrize("n_dimensions", [2, 3])
+def test_checkerboard(device, simulation_factory, lattice_snapshot_factory,
+                      n_dimensions):
+    mc = hoomd.hpmc.integrate.ConvexPolyhedron(default_d=0.1, default_a=0.1)
+    mc.shape['A'] = dict(vertices=[(-0.5, -0.5, -0.5), (-0.5, -0.5, 0.5),
+                                   (-0.5, 0.5, -0.5), (-0.5, 0.5, 0.5),
+                                   (0.5, -0.5, -0.5), (0.5, -0.5, 0.5),
+                                   (0.5, 0.5, -0.5), (0.5, 0.5, 0.5)])
+    if n_dimensions == 2:
+        mc = hoomd.hpmc.integrate.ConvexPolygon(default_d=0.1, default_a=0.1)
+        mc.shape['A'] = dict(vertices=[(-0.5, -0.5), (0.5, -0.5), (0.5, 0.5),
+                                       (-0.5, 0.5)])
+    mc.checkerboard = True
+    assert mc.checkerboard
+
+    sim = simulation_factory(
+        lattice_snapshot_factory(dimensions=n_dimensions, a=2.0, n=8))
+    sim.operations.add(mc)
+    sim.run(20)
+
+    assert mc.checkerboard
+    assert mc.overlaps == 0
+    assert mc.translate_moves[0] > 0
+    assert mc.rotate_moves[0] > 0
+
+
+@pytest.mark.cpu
+@pytest.mark.parametrize("checkerboard", [False, True])
+def test_aabb_refit(device, simulation_factory, lattice_snapshot_factory,
+                    checkerboard):
+    mc = hoomd.hpmc.integrate.Sphere(default_d=0.2)
+    mc.shape['A'] = dict(diameter=1)
+    mc.checkerboard = checkerboard
+    mc.aabb_refit_threshold = 0.5
+    assert mc.aabb_refit_threshold == 0.5
+
+    sim = simulation_factory(lattice_snapshot_factory(a=1.1, n=8))
+    sim.operations.add(mc)
+    sim.run(50)
+
+    assert mc.aabb_refit_threshold == 0.5
+    assert mc.overlaps == 0
+    assert mc.translate_moves[0] > 0
+
+    with pytest.raises(ValueError):
+        mc.aabb_refit_threshold = -1
+
+
+@pytest.mark.cpu
+@pytest.mark.parametrize("checkerboard", [False, True])
+def test_depletant_cache(device, simulation_factory, lattice_snapshot_factory,
+                         checkerboard):
+    mc = hoomd.hpmc.integrate.Sphere(default_d=0.1)
+    mc.shape['A'] = dict(diameter=1)
+    mc.shape['B'] = dict(diameter=0.2)
+    mc.depletant_fugacity[('B', 'B')] = 10.0
+    mc.checkerboard = checkerboard
+    mc.depletant_cache = True
+    assert mc.depletant_cache
+
+    sim = simulation_factory(
+        lattice_snapshot_factory(particle_types=['A', 'B'], a=1.5, n=6))
+    sim.operations.add(mc)
+    sim.run(20)
+
+    assert mc.depletant_cache
+    assert mc.overlaps == 0
+    assert mc.translate_moves[0] > 0
+
+
+@pytest.mark.parametrize("a, expected_overlaps", [(1.1, 0), (0.9, 192)])
+def test_overlaps(device, simulation_factory, lattice_snapshot_factory, a,
+                  expected_overlaps):
+    mc = hoomd.hpmc.integrate.Sphere(default_d=0.1)
+    mc.shape['A'] = dict(diameter=1)
+
+    # each particle overlaps its 6 nearest neighbors when a < 1
+    sim = simulation_factory(lattice_snapshot_factory(a=a, n=4))
+    sim.operations.add(mc)
+    sim.run(0)
+    assert mc.overlaps == expected_overlaps
+
+
+def test_move_size_controller(device, simulation_factory,
+                              lattice_snapshot_factory):
+    mc = hoomd.hpmc.integrate.ConvexPolyhedron(default_d=0.01,
+                                               default_a=0.01)
+    mc.shape['A'] = dict(vertices=[(-0.5, -0.5, -0.5), (-0.5, -0.5, 0.5),
+                                   (-0.5, 0.5, -0.5), (-0.5, 0.5, 0.5),
+                                   (0.5, -0.5, -0.5), (0.5, -0.5, 0.5),
+                                   (0.5, 0.5, -0.5), (0.5, 0.5, 0.5)])
+    mc.move_size_period = 10
+    mc.move_size_target = 0.3
+    mc.move_size_gain = 0.5
+    mc.max_translation_move['A'] = 0.2
+    mc.max_rotation_move['A'] = 0.5
+
+    sim = simulation_factory(lattice_snapshot_factory(a=1.2, n=6))
+    sim.operations.add(mc)
+    sim.run(0)
+    assert mc.move_size_period == 10
+    assert mc.move_size_target == 0.3
+    assert mc.move_size_gain == 0.5
+    assert mc.max_translation_move['A'] == 0.2
+
+    # the small initial moves are almost always accepted, the controller grows
+    # them up to the limits
+    sim.run(200)
+    assert mc.overlaps == 0
+    assert 0.01 < mc.d['A'] <= 0.2
+    assert 0.01 < mc.a['A'] <= 0.5
+
+    # the move sizes stay fixed when the controller is disabled
+    mc.move_size_period = 0
+    d = mc.d['A']
+    sim.run(20)
+    assert mc.d['A'] == d
+
+    with pytest.raises(ValueError):
+        mc.move_size_target = 1.5
+    with pytest.raises(ValueError):
+        mc.move_size_gain = -1
+
+
 # An ellipsoid with a = b = c should be a sphere
 # A spheropolyhedron with a single vertex should be a sphere
 # A sphinx where the indenting sphere is negligible should also be a sphere
@@ -102,3 +102,142 @@ UP_TEST(bigger)
         UP_ASSERT(in(i, hits));
         }
     }
+
+UP_TEST(refit)
+    {
+    const unsigned int N = 1000;
+    hoomd::RandomGenerator rng(hoomd::Seed(0, 1, 2), hoomd::Counter(7, 8, 9));
+
+    std::vector<vec3<Scalar>> points(N);
+    AABB aabbs[N];
+    for (unsigned int i = 0; i < N; i++)
+        {
+        points[i] = vec3<Scalar>(hoomd::detail::generate_canonical<float>(rng),
+                                 hoomd::detail::generate_canonical<float>(rng),
+                                 hoomd::detail::generate_canonical<float>(rng))
+                    * Scalar(100);
+        aabbs[i] = AABB(points[i], Scalar(1.0));
+        }
+
+    AABBTree tree;
+    tree.buildTree(aabbs, N);
+    Scalar build_cost = tree.getCost();
+
+    // refitting to the same AABBs reproduces the built tree
+    for (unsigned int i = 0; i < N; i++)
+        aabbs[i] = AABB(points[i], Scalar(1.0));
+    tree.refit(aabbs, N);
+    MY_CHECK_CLOSE(tree.getCost(), build_cost, tol);
+
+    // move the points by more than their size, which forces the leaves to grow and shrink
+    for (unsigned int i = 0; i < N; i++)
+        {
+        points[i] += vec3<Scalar>(hoomd::detail::generate_canonical<float>(rng) - Scalar(0.5),
+                                  hoomd::detail::generate_canonical<float>(rng) - Scalar(0.5),
+                                  hoomd::detail::generate_canonical<float>(rng) - Scalar(0.5))
+                     * Scalar(10);
+        aabbs[i] = AABB(points[i], Scalar(0.5));
+        }
+    tree.refit(aabbs, N);
+
+    // every point is found at its new position and no point is found at a distant query
+    std::vector<unsigned int> hits;
+    for (unsigned int i = 0; i < N; i++)
+        {
+        hits.clear();
+        tree.query(hits, AABB(points[i], Scalar(0.01)));
+        UP_ASSERT(in(i, hits));
+        }
+
+    hits.clear();
+    tree.query(hits, AABB(vec3<Scalar>(500, 500, 500), Scalar(1.0)));
+    UP_ASSERT_EQUAL(hits.size(), 0);
+
+    // the moves degrade the refit tree compared to a fresh build
+    Scalar refit_cost = tree.getCost();
+    tree.buildTree(aabbs, N);
+    UP_ASSERT(refit_cost >= tree.getCost());
+    }
+
+UP_TEST(type_masks)
+    {
+    const unsigned int N = 1000;
+    hoomd::RandomGenerator rng(hoomd::Seed(0, 1, 2), hoomd::Counter(10, 11, 12));
+
+    std::vector<vec3<Scalar>> points(N);
+    std::vector<unsigned int> types(N);
+    std::vector<unsigned int> masks(N);
+    AABB aabbs[N];
+    for (unsigned int i = 0; i < N; i++)
+        {
+        points[i] = vec3<Scalar>(hoomd::detail::generate_canonical<float>(rng),
+                                 hoomd::detail::generate_canonical<float>(rng),
+                                 hoomd::detail::generate_canonical<float>(rng))
+                    * Scalar(100);
+        aabbs[i] = AABB(points[i], Scalar(1.0));
+
+        // half of the particles are type 0, the others are spread over types 1, 2, and 40
+        types[i] = (i % 2 == 0) ? 0 : (i % 3 == 0 ? 40 : 1 + (i / 2) % 2);
+        masks[i] = type_mask_bit(types[i]);
+        }
+
+    AABBTree tree;
+    tree.buildTree(aabbs, N);
+
+    // without type masks, no node is skipped
+    UP_ASSERT_EQUAL(tree.getNodeTypeMask(0), 0xffffffff);
+
+    tree.setTypeMasks(masks.data(), N);
+    UP_ASSERT_EQUAL(tree.getNodeTypeMask(0),
+                    type_mask_bit(0) | type_mask_bit(1) | type_mask_bit(2) | type_mask_bit(40));
+
+    // types beyond 31 share the highest bit
+    UP_ASSERT_EQUAL(type_mask_bit(40), type_mask_bit(31));
+
+    // a masked traversal finds exactly the particles of the selected types
+    unsigned int query_mask = type_mask_bit(1) | type_mask_bit(40);
+    AABB query(vec3<Scalar>(20, 20, 20), vec3<Scalar>(60, 60, 60));
+    std::vector<unsigned int> hits;
+    unsigned int n_visited = 0;
+    for (unsigned int cur_node_idx = 0; cur_node_idx < tree.getNumNodes(); cur_node_idx++)
+        {
+        if (overlap(tree.getNodeAABB(cur_node_idx), query)
+            && (tree.getNodeTypeMask(cur_node_idx) & query_mask))
+            {
+            n_visited++;
+            if (tree.isNodeLeaf(cur_node_idx))
+                {
+                for (unsigned int cur_p = 0; cur_p < tree.getNodeNumParticles(cur_node_idx);
+                     cur_p++)
+                    {
+                    unsigned int j = tree.getNodeParticle(cur_node_idx, cur_p);
+                    if ((masks[j] & query_mask) && overlap(aabbs[j], query))
+                        hits.push_back(j);
+                    }
+                }
+            }
+        else
+            {
+            cur_node_idx += tree.getNodeSkip(cur_node_idx);
+            }
+        }
+
+    std::vector<unsigned int> all_hits;
+    tree.query(all_hits, query);
+    unsigned int n_expected = 0;
+    for (unsigned int j : all_hits)
+        {
+        if (types[j] == 1 || types[j] == 40)
+            {
+            n_expected++;
+            UP_ASSERT(in(j, hits));
+            }
+        }
+    UP_ASSERT_EQUAL(hits.size(), n_expected);
+    UP_ASSERT(n_expected > 0);
+
+    // the masks survive a refit
+    tree.refit(aabbs, N);
+    UP_ASSERT_EQUAL(tree.getNodeTypeMask(0),
+                    type_mask_bit(0) | type_mask_bit(1) | type_mask_bit(2) | type_mask_bit(40));
+    }
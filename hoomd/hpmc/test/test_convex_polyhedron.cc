@@ -10,6 +10,7 @@
 
 HOOMD_UP_MAIN();
 
+#include <algorithm>
 #include <iostream>
 #include <string>
 
@@ -82,6 +83,39 @@ UP_TEST(support)
     UP_ASSERT(v1 == v2);
     }
 
+UP_TEST(support_many_verts)
+    {
+    // Find the support of a polyhedron with enough vertices to fill several SIMD registers,
+    // including a partially filled one
+    const unsigned int N = 40;
+    const OverlapReal golden_angle = OverlapReal(M_PI * (3.0 - sqrt(5.0)));
+
+    vector<vec3<OverlapReal>> vlist;
+    for (unsigned int i = 0; i < N; i++)
+        {
+        OverlapReal z = OverlapReal(1.0) - OverlapReal(2 * i + 1) / OverlapReal(N);
+        OverlapReal r = sqrt(OverlapReal(1.0) - z * z);
+        vlist.push_back(vec3<OverlapReal>(r * cos(golden_angle * OverlapReal(i)),
+                                          r * sin(golden_angle * OverlapReal(i)),
+                                          z));
+        }
+    PolyhedronVertices verts(vlist, 0, 0);
+    SupportFuncConvexPolyhedron sa = SupportFuncConvexPolyhedron(verts);
+
+    // the support point maximizes the projection onto n over all vertices
+    for (unsigned int i = 0; i < 100; i++)
+        {
+        vec3<OverlapReal> n(cos(OverlapReal(0.3 * i)),
+                            sin(OverlapReal(0.7 * i)),
+                            OverlapReal(0.02 * i) - OverlapReal(1.0));
+        OverlapReal max_dot = dot(n, vlist[0]);
+        for (unsigned int j = 1; j < N; j++)
+            max_dot = std::max(max_dot, dot(n, vlist[j]));
+
+        MY_CHECK_CLOSE(dot(n, sa(n)), max_dot, tol_small);
+        }
+    }
+
 /*! Not sure how best to test this because not sure what a valid support has to be...
 UP_TEST( composite_support )
     {
@@ -888,3 +888,31 @@ UP_TEST(overlap_ellipsoid_rot2)
     UP_ASSERT(test_overlap(r_ij, a, b, err_count));
     UP_ASSERT(test_overlap(-r_ij, b, a, err_count));
     }
+
+UP_TEST(overlap_ellipsoid_flat_contact)
+    {
+    // flat ellipsoids close to contact, where matrices in single precision decide the overlap
+    // wrongly
+    EllipsoidParams axes;
+    axes.x = 2;
+    axes.y = 0.5;
+    axes.z = 0.02;
+    axes.ignore = 0;
+
+    quat<Scalar> o_a(-0.429132, vec3<Scalar>(0.301504, 0.830582, 0.187282));
+    quat<Scalar> o_b(-0.712484, vec3<Scalar>(0.504266, 0.0484154, 0.485528));
+    ShapeEllipsoid a(o_a * fast::rsqrt(norm2(o_a)), axes);
+    ShapeEllipsoid b(o_b * fast::rsqrt(norm2(o_b)), axes);
+
+    // the ellipsoids touch at a distance of 1.477922 along this direction
+    vec3<Scalar> n(0.751143, -0.240533, 0.614758);
+    n = n * fast::rsqrt(dot(n, n));
+
+    vec3<Scalar> r_ij = n * Scalar(1.475);
+    UP_ASSERT(test_overlap(r_ij, a, b, err_count));
+    UP_ASSERT(test_overlap(-r_ij, b, a, err_count));
+
+    r_ij = n * Scalar(1.48);
+    UP_ASSERT(!test_overlap(r_ij, a, b, err_count));
+    UP_ASSERT(!test_overlap(-r_ij, b, a, err_count));
+    }
@@ -0,0 +1,109 @@
+
+#include "hoomd/HOOMDMath.h"
+#include "hoomd/VectorMath.h"
+
+#include "hoomd/test/upp11_config.h"
+
+HOOMD_UP_MAIN();
+
+#include "hoomd/hpmc/IntegratorHPMCMonoEventChain.h"
+
+#include <iostream>
+#include <vector>
+
+#include <pybind11/pybind11.h>
+
+using namespace hpmc;
+using namespace hpmc::detail;
+
+unsigned int err_count = 0;
+
+//! Build the vertices of a unit cube
+std::vector<vec3<OverlapReal>> cube_vertices()
+    {
+    std::vector<vec3<OverlapReal>> vlist;
+    for (int i = 0; i < 8; i++)
+        {
+        vlist.push_back(vec3<OverlapReal>(OverlapReal((i & 1) - 0.5),
+                                          OverlapReal(((i >> 1) & 1) - 0.5),
+                                          OverlapReal(((i >> 2) & 1) - 0.5)));
+        }
+    return vlist;
+    }
+
+UP_TEST(sweep_sphere)
+    {
+    SphereParams par;
+    par.radius = 0.5;
+    par.ignore = 0;
+    par.isOriented = false;
+
+    ShapeSphere a(quat<Scalar>(), par);
+    ShapeSphere b(quat<Scalar>(), par);
+    vec3<Scalar> dir(1, 0, 0);
+
+    // head on collision
+    MY_CHECK_CLOSE(sweep_distance(vec3<Scalar>(2, 0, 0), dir, a, b, 10, err_count), 1.0, tol_small);
+
+    // glancing collision
+    MY_CHECK_CLOSE(sweep_distance(vec3<Scalar>(2, 0.6, 0), dir, a, b, 10, err_count),
+                   1.2,
+                   tol_small);
+
+    // out of range
+    MY_CHECK_CLOSE(sweep_distance(vec3<Scalar>(2, 0, 0), dir, a, b, 0.5, err_count),
+                   0.5,
+                   tol_small);
+
+    // no collision
+    MY_CHECK_CLOSE(sweep_distance(vec3<Scalar>(2, 1.5, 0), dir, a, b, 10, err_count),
+                   10.0,
+                   tol_small);
+    MY_CHECK_CLOSE(sweep_distance(vec3<Scalar>(-2, 0, 0), dir, a, b, 10, err_count),
+                   10.0,
+                   tol_small);
+
+    // touching spheres collide immediately when they approach each other, but not when they
+    // move apart
+    MY_CHECK_SMALL(sweep_distance(vec3<Scalar>(0.99, 0, 0), dir, a, b, 10, err_count), tol_small);
+    MY_CHECK_CLOSE(sweep_distance(vec3<Scalar>(-0.99, 0, 0), dir, a, b, 10, err_count),
+                   10.0,
+                   tol_small);
+    }
+
+UP_TEST(sweep_convex_polyhedron)
+    {
+    PolyhedronVertices verts(cube_vertices(), 0, 0);
+    ShapeConvexPolyhedron a(quat<Scalar>(), verts);
+    ShapeConvexPolyhedron b(quat<Scalar>(), verts);
+    vec3<Scalar> dir(1, 0, 0);
+    OverlapReal l;
+
+    // face to face collision, the distance stops short of the contact by at most the tolerance
+    l = sweep_distance(vec3<Scalar>(3, 0, 0), dir, a, b, 10, err_count);
+    UP_ASSERT(l <= 2.0);
+    MY_CHECK_CLOSE(l, 2.0, tol_small);
+    UP_ASSERT(!test_overlap(vec3<Scalar>(3, 0, 0) - Scalar(l) * dir, a, b, err_count));
+
+    // corner first collision of a rotated cube
+    ShapeConvexPolyhedron c(quat<Scalar>::fromAxisAngle(vec3<Scalar>(0, 0, 1), M_PI / 4), verts);
+    l = sweep_distance(vec3<Scalar>(3, 0, 0), dir, c, b, 10, err_count);
+    MY_CHECK_CLOSE(l, 2.5 - sqrt(2.0) / 2.0, tol_small);
+
+    // cubes that pass each other, although their circumspheres collide
+    MY_CHECK_CLOSE(sweep_distance(vec3<Scalar>(3, 1.2, 0), dir, a, b, 10, err_count),
+                   10.0,
+                   tol_small);
+    }
+
+UP_TEST(sweep_spheropolyhedron)
+    {
+    PolyhedronVertices verts(cube_vertices(), 0.1, 0);
+    ShapeSpheropolyhedron a(quat<Scalar>(), verts);
+    ShapeSpheropolyhedron b(quat<Scalar>(), verts);
+    vec3<Scalar> dir(0, 0, -1);
+
+    OverlapReal l = sweep_distance(vec3<Scalar>(0, 0, -3), dir, a, b, 10, err_count);
+    UP_ASSERT(l <= 1.8);
+    MY_CHECK_CLOSE(l, 1.8, tol_small);
+    }
@@ -2,6 +2,9 @@
 #include "hoomd/hpmc/IntegratorHPMC.h"
 #include "hoomd/hpmc/Moves.h"
 #include "hoomd/hpmc/ShapePolyhedron.h"
+#include "hoomd/hpmc/WideOBB.h"
+
+#include "hoomd/RandomNumbers.h"
 
 #include "hoomd/test/upp11_config.h"
 
@@ -494,3 +497,55 @@ UP_TEST(overlap_octahedron_sphere)
     UP_ASSERT(test_overlap(r_ij, a, b, err_count));
     UP_ASSERT(test_overlap(-r_ij, b, a, err_count));
     }
+
+UP_TEST(overlap_wide_obb)
+    {
+    hoomd::RandomGenerator rng(hoomd::Seed(0, 1, 2), hoomd::Counter(4, 5, 6));
+
+    // draw a random OBB near the origin
+    auto random_obb = [&rng]()
+    {
+        OBB obb;
+        obb.center = vec3<OverlapReal>(hoomd::detail::generate_canonical<float>(rng),
+                                       hoomd::detail::generate_canonical<float>(rng),
+                                       hoomd::detail::generate_canonical<float>(rng))
+                     * OverlapReal(2.0);
+        obb.lengths = vec3<OverlapReal>(hoomd::detail::generate_canonical<float>(rng),
+                                        hoomd::detail::generate_canonical<float>(rng),
+                                        hoomd::detail::generate_canonical<float>(rng))
+                      * OverlapReal(0.5);
+        quat<OverlapReal> q(hoomd::detail::generate_canonical<float>(rng) - OverlapReal(0.5),
+                            vec3<OverlapReal>(
+                                hoomd::detail::generate_canonical<float>(rng) - OverlapReal(0.5),
+                                hoomd::detail::generate_canonical<float>(rng) - OverlapReal(0.5),
+                                hoomd::detail::generate_canonical<float>(rng) - OverlapReal(0.5)));
+        obb.rotation = q * (OverlapReal(1.0) / fast::sqrt(norm2(q)));
+        return obb;
+    };
+
+    // the wide test must agree with the scalar test in every lane
+    unsigned int n_overlap = 0;
+    for (unsigned int trial = 0; trial < 1000; ++trial)
+        {
+        OBB a = random_obb();
+        OBB b[WIDE_OBB_WIDTH];
+        OverlapReal wide[WIDE_OBB_COMPONENTS * WIDE_OBB_WIDTH];
+        for (unsigned int l = 0; l < WIDE_OBB_WIDTH; ++l)
+            {
+            b[l] = random_obb();
+            storeWideOBB(wide, l, b[l]);
+            }
+
+        unsigned int mask = overlapWide(a, wide);
+        for (unsigned int l = 0; l < WIDE_OBB_WIDTH; ++l)
+            {
+            bool result = overlap(a, b[l]);
+            UP_ASSERT_EQUAL(bool(mask & (1u << l)), result);
+            n_overlap += result;
+            }
+        }
+
+    // make sure that both outcomes were tested
+    UP_ASSERT(n_overlap > 0);
+    UP_ASSERT(n_overlap < 1000 * WIDE_OBB_WIDTH);
+    }
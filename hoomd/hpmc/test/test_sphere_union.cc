@@ -237,3 +237,67 @@ UP_TEST(overlapping_dumbbells)
     UP_ASSERT(test_overlap(r_b - r_a, a, b, err_count));
     UP_ASSERT(test_overlap(r_a - r_b, b, a, err_count));
     }
+
+UP_TEST(shape_cache)
+    {
+    // a union of 8 spheres on the corners of a box, enough to build a tree with several levels
+    const unsigned int N = 8;
+    ShapeUnion<ShapeSphere>::param_type params(N);
+    for (unsigned int i = 0; i < N; i++)
+        {
+        params.mpos[i] = vec3<Scalar>((i & 1) ? 0.5 : -0.5,
+                                      (i & 2) ? 0.25 : -0.25,
+                                      (i & 4) ? 0.1 : -0.1);
+        params.morientation[i] = quat<Scalar>();
+        params.mparams[i].radius = OverlapReal(0.1 + 0.02 * i);
+        params.mparams[i].ignore = 0;
+        params.moverlap[i] = 1;
+        }
+    params.diameter = OverlapReal(2 * (sqrt(0.5 * 0.5 + 0.25 * 0.25 + 0.1 * 0.1) + 0.24));
+    params.ignore = 0;
+    build_tree<ShapeSphere>(params);
+
+    // place particles with a range of orientations on a line
+    const unsigned int n_particles = 16;
+    std::vector<quat<Scalar>> orientation(n_particles);
+    std::vector<vec3<Scalar>> position(n_particles);
+    for (unsigned int i = 0; i < n_particles; i++)
+        {
+        Scalar alpha = Scalar(0.7) * i;
+        vec3<Scalar> axis(cos(Scalar(1.3) * i), sin(Scalar(1.3) * i), Scalar(0.5));
+        axis = axis / sqrt(dot(axis, axis));
+        orientation[i] = quat<Scalar>::fromAxisAngle(axis, alpha);
+        position[i] = vec3<Scalar>(Scalar(0.45) * i, Scalar(0.05) * (i % 3), 0);
+        }
+
+    ShapeCache<ShapeUnion<ShapeSphere>> cache;
+    UP_ASSERT(ShapeCache<ShapeUnion<ShapeSphere>>::isEnabled());
+    cache.resize(n_particles, &params, 1);
+    for (unsigned int i = 0; i < n_particles; i++)
+        cache.set(i, ShapeUnion<ShapeSphere>(orientation[i], params));
+
+    // the rotated member data gives the same result as the full overlap check
+    unsigned int n_overlaps = 0;
+    for (unsigned int i = 0; i < n_particles; i++)
+        {
+        for (unsigned int j = 0; j < n_particles; j++)
+            {
+            if (i == j)
+                continue;
+
+            ShapeUnion<ShapeSphere> a(orientation[i], params);
+            ShapeUnion<ShapeSphere> b(orientation[j], params);
+            bool overlap = test_overlap(position[j] - position[i], a, b, err_count);
+
+            cache.attach(i, a);
+            cache.attach(j, b);
+            UP_ASSERT(a.rotated != nullptr);
+            UP_ASSERT_EQUAL(test_overlap(position[j] - position[i], a, b, err_count), overlap);
+            n_overlaps += overlap;
+            }
+        }
+
+    // the configuration includes both overlapping and disjoint pairs
+    UP_ASSERT(n_overlaps > 0);
+    UP_ASSERT(n_overlaps < n_particles * (n_particles - 1));
+    }
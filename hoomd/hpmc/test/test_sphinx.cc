@@ -419,3 +419,49 @@ UP_TEST(overlap_P4Nth_P2N)
     UP_ASSERT(test_overlap(r_ij, a, b, err_count));
     UP_ASSERT(test_overlap(-r_ij, b, a, err_count));
     }
+
+UP_TEST(contact_bounds_P2N)
+    {
+    // the bounds on the contact distance of a double dimpled sphinx along and normal to its axis
+    quat<Scalar> o(1.0, vec3<Scalar>(0.0, 0.0, 0.0));
+
+    SphinxParams data;
+    data.N = 3;
+    data.diameter[0] = 2.0;
+    data.diameter[1] = -OverlapReal(2.2);
+    data.diameter[2] = -OverlapReal(2.2);
+    data.center[0] = vec3<Scalar>(0.0, 0.0, 0.0);
+    data.center[1] = vec3<Scalar>(0.0, 0.0, 1.15);
+    data.center[2] = vec3<Scalar>(0.0, 0.0, -1.15);
+    data.circumsphereDiameter = 2.0;
+    data.ignore = 0;
+
+    ShapeSphinx a(o, data);
+    UP_ASSERT(a.center_inside);
+    UP_ASSERT_EQUAL(a.n_positive, 1u);
+
+    vec3<OverlapReal> ex(1, 0, 0);
+    vec3<OverlapReal> ez(0, 0, 1);
+
+    // the radial extent ends at the sphere surface or where the ray enters a dimple
+    MY_CHECK_CLOSE(a.getRadialExtent(a.u, ex), 1.0, tol);
+    MY_CHECK_CLOSE(a.getRadialExtent(a.u, ez), 0.05, tol);
+    MY_CHECK_CLOSE(a.getRadialExtent(a.u, -ez), 0.05, tol);
+
+    // the support along the axis is the height of the dimple rim
+    OverlapReal rim = OverlapReal((1.15 * 1.15 + 1.0 - 1.1 * 1.1) / (2.0 * 1.15));
+    MY_CHECK_CLOSE(a.getSupport(a.u, ex), 1.0, tol);
+    MY_CHECK_CLOSE(a.getSupport(a.u, ez), rim, tol);
+    MY_CHECK_CLOSE(a.getSupport(a.u, -ez), rim, tol);
+
+    // stacked along the axis, the dimple rims are separated by a plane
+    ShapeSphinx b(o, data);
+    vec3<Scalar> r_ij(0.0, 0.0, 2.0 * rim * 1.01);
+    UP_ASSERT(!test_overlap(r_ij, a, b, err_count));
+    UP_ASSERT(!test_overlap(-r_ij, b, a, err_count));
+
+    // side by side, the segments from the centers overlap
+    r_ij = vec3<Scalar>(1.9, 0.0, 0.0);
+    UP_ASSERT(test_overlap(r_ij, a, b, err_count));
+    UP_ASSERT(test_overlap(-r_ij, b, a, err_count));
+    }
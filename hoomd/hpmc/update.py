@@ -6,7 +6,6 @@
 
 from . import _hpmc
 from . import integrate
-from hoomd import _hoomd
 from hoomd.logging import log
 from hoomd.data.parameterdicts import TypeParameterDict, ParameterDict
 from hoomd.data.typeparam import TypeParameter
@@ -409,6 +408,10 @@ class MuVT(Updater):
 
         cpp_cls_name = "UpdaterMuVT"
         cpp_cls_name += integrator.__class__.__name__
+        use_gpu = (isinstance(self._simulation.device, hoomd.device.GPU)
+                   and (cpp_cls_name + 'GPU') in _hpmc.__dict__)
+        if use_gpu:
+            cpp_cls_name += "GPU"
         cpp_cls = getattr(_hpmc, cpp_cls_name)
 
         self._cpp_obj = cpp_cls(self._simulation.state._cpp_sys_def,
@@ -478,6 +481,8 @@ class Clusters(Updater):
                                  individual cluster.
         trigger (Trigger): Select the timesteps on which to perform cluster
             moves.
+        patch_energy_cache (bool): When True, reuse the patch energies of
+            particle pairs that did not change since the last cluster move.
 
     The GCA as described in Liu and Lujten (2004),
     http://doi.org/10.1103/PhysRevLett.92.035504 is used for hard shape, patch
@@ -502,6 +507,22 @@ class Clusters(Updater):
 
     The `Clusters` updater support threaded execution on multiple CPU cores.
 
+    .. rubric:: Patch energy cache
+
+    With a patch energy, every cluster move evaluates the energy between all
+    pairs of interacting particles in the configuration before the move. When
+    the integrator rejects most trial moves, many of these pairs are unchanged
+    since the last cluster move. Set ``patch_energy_cache`` to True to keep the
+    pair energies of the last cluster move and reuse them for pairs where
+    neither particle changed its position, orientation, type, diameter, or
+    charge in a box of the same size. The cache costs memory proportional to
+    the number of interacting pairs.
+
+    Note:
+        The cache does not detect changes to the parameters of the patch
+        energy, such as ``alpha_iso``. Disable and re-enable the cache after
+        changing them.
+
     Attributes:
         pivot_move_ratio (float): Set the ratio between pivot and reflection
           moves.
@@ -509,15 +530,19 @@ class Clusters(Updater):
                                  individual cluster.
         trigger (Trigger): Select the timesteps on which to perform cluster
             moves.
+        patch_energy_cache (bool): When True, reuse the patch energies of
+            particle pairs that did not change since the last cluster move.
     """
-    _remove_for_pickling = Updater._remove_for_pickling + ('_cpp_cell',)
-    _skip_for_equality = Updater._skip_for_equality | {'_cpp_cell'}
-
-    def __init__(self, pivot_move_ratio=0.5, flip_probability=0.5, trigger=1):
+    def __init__(self,
+                 pivot_move_ratio=0.5,
+                 flip_probability=0.5,
+                 trigger=1,
+                 patch_energy_cache=False):
         super().__init__(trigger)
 
         param_dict = ParameterDict(pivot_move_ratio=float(pivot_move_ratio),
-                                   flip_probability=float(flip_probability))
+                                   flip_probability=float(flip_probability),
+                                   patch_energy_cache=bool(patch_energy_cache))
 
         self._param_dict.update(param_dict)
         self.instance = 0
@@ -549,14 +574,8 @@ class Clusters(Updater):
         if not integrator._attached:
             raise RuntimeError("Integrator is not attached yet.")
 
-        if use_gpu:
-            sys_def = self._simulation.state._cpp_sys_def
-            self._cpp_cell = _hoomd.CellListGPU(sys_def)
-            self._cpp_obj = cpp_cls(self._simulation.state._cpp_sys_def,
-                                    integrator._cpp_obj, self._cpp_cell)
-        else:
-            self._cpp_obj = cpp_cls(self._simulation.state._cpp_sys_def,
-                                    integrator._cpp_obj)
+        self._cpp_obj = cpp_cls(self._simulation.state._cpp_sys_def,
+                                integrator._cpp_obj)
         super()._attach()
 
     @log(requires_run=True)
@@ -28,6 +28,7 @@ EvalFactory::EvalFactory(const std::string& llvm_ir)
     {
     // set to null pointer
     m_eval = NULL;
+    m_eval_batch = NULL;
 
     // initialize LLVM
     std::ostringstream sstream;
@@ -79,6 +80,9 @@ EvalFactory::EvalFactory(const std::string& llvm_ir)
         return;
         }
 
+    // the batched evaluator is optional, IR compiled outside of HOOMD may only define eval
+    auto eval_batch = m_jit->findSymbol("eval_batch");
+
     auto alpha = m_jit->findSymbol("alpha_iso");
 
     if (!alpha)
@@ -99,10 +103,14 @@ EvalFactory::EvalFactory(const std::string& llvm_ir)
     m_eval = (EvalFnPtr)(long unsigned int)(cantFail(eval.getAddress()));
     m_alpha = (float**)(cantFail(alpha.getAddress()));
     m_alpha_union = (float**)(cantFail(alpha_union.getAddress()));
+    if (eval_batch)
+        m_eval_batch = (EvalBatchFnPtr)(long unsigned int)(cantFail(eval_batch.getAddress()));
 #else
     m_eval = (EvalFnPtr)eval.getAddress();
     m_alpha = (float**)alpha.getAddress();
     m_alpha_union = (float**)alpha_union.getAddress();
+    if (eval_batch)
+        m_eval_batch = (EvalBatchFnPtr)eval_batch.getAddress();
 #endif
 
     llvm_err.flush();
@@ -0,0 +1,187 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#ifndef __PAIR_EVALUATOR_JIT_H__
+#define __PAIR_EVALUATOR_JIT_H__
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include "hoomd/HOOMDMath.h"
+
+#include <pybind11/numpy.h>
+#include <pybind11/pybind11.h>
+
+#include <stdexcept>
+#include <string>
+
+/*! \file EvaluatorPairJIT.h
+    \brief Defines the pair evaluator class for JIT compiled pair potentials
+*/
+
+//! Evaluates a pair potential compiled at run time
+/*! EvaluatorPairJIT calls a function compiled from user code by PairEvalFactory through the
+    pointer stored in param_type::eval. PotentialPairJIT sets the pointer in the parameters of
+    every type pair, so that PotentialPair<EvaluatorPairJIT> needs no knowledge of the JIT.
+
+    The function receives r^2, the per type pair parameter array, and the diameters and charges of
+    both particles. It returns V(r) and writes -(1/r) dV/dr to force_divr. The energy shift is
+    applied by evaluating the function a second time at r_cut.
+*/
+class EvaluatorPairJIT
+    {
+    public:
+    //! Signature of the compiled function
+    typedef double (*eval_fn)(double r_sq,
+                              const double* param,
+                              double d_i,
+                              double d_j,
+                              double q_i,
+                              double q_j,
+                              double& force_divr);
+
+    //! Maximum number of parameters per type pair
+    static const unsigned int max_params = 16;
+
+    //! Define the parameter type used by this pair potential evaluator
+    struct param_type
+        {
+        double param[max_params]; //!< User parameters
+        unsigned int n_param;     //!< Number of user parameters set
+        eval_fn eval;             //!< The compiled function, set by PotentialPairJIT
+
+        void load_shared(char*& ptr, unsigned int& available_bytes) { }
+
+        void allocate_shared(char*& ptr, unsigned int& available_bytes) const { }
+
+#ifdef ENABLE_HIP
+        //! Set CUDA memory hints
+        void set_memory_hint() const
+            {
+            // default implementation does nothing
+            }
+#endif
+
+        param_type() : n_param(0), eval(NULL)
+            {
+            for (unsigned int k = 0; k < max_params; k++)
+                param[k] = 0.0;
+            }
+
+        param_type(pybind11::dict v, bool managed = false) : param_type()
+            {
+            const auto param_py = v["param"].cast<pybind11::array_t<double>>().unchecked<1>();
+            if (param_py.size() > max_params)
+                {
+                throw std::runtime_error("At most " + std::to_string(max_params)
+                                         + " parameters are supported per type pair");
+                }
+
+            n_param = static_cast<unsigned int>(param_py.size());
+            for (unsigned int k = 0; k < n_param; k++)
+                param[k] = param_py(k);
+            }
+
+        pybind11::dict asDict() const
+            {
+            pybind11::dict v;
+            v["param"] = pybind11::array_t<double>(n_param, param);
+            return v;
+            }
+        };
+
+    //! Constructs the pair potential evaluator
+    /*! \param _rsq Squared distance between the particles
+        \param _rcutsq Squared distance at which the potential goes to 0
+        \param _params Per type pair parameters of this potential
+    */
+    EvaluatorPairJIT(Scalar _rsq, Scalar _rcutsq, const param_type& _params)
+        : rsq(_rsq), rcutsq(_rcutsq), params(_params), di(0), dj(0), qi(0), qj(0)
+        {
+        }
+
+    //! The user code may use the diameters
+    static bool needsDiameter()
+        {
+        return true;
+        }
+    //! Accept the optional diameter values
+    /*! \param _di Diameter of particle i
+        \param _dj Diameter of particle j
+    */
+    void setDiameter(Scalar _di, Scalar _dj)
+        {
+        di = _di;
+        dj = _dj;
+        }
+
+    //! The user code may use the charges
+    static bool needsCharge()
+        {
+        return true;
+        }
+    //! Accept the optional charge values
+    /*! \param _qi Charge of particle i
+        \param _qj Charge of particle j
+    */
+    void setCharge(Scalar _qi, Scalar _qj)
+        {
+        qi = _qi;
+        qj = _qj;
+        }
+
+    //! Evaluate the force and energy
+    /*! \param force_divr Output parameter to write the computed force divided by r.
+        \param pair_eng Output parameter to write the computed pair energy
+        \param energy_shift If true, the potential must be shifted so that
+        V(r) is continuous at the cutoff
+
+        \return True if they are evaluated or false if they are not because
+        we are beyond the cutoff
+    */
+    bool evalForceAndEnergy(Scalar& force_divr, Scalar& pair_eng, bool energy_shift)
+        {
+        if (rsq < rcutsq && params.eval)
+            {
+            double f = 0.0;
+            double eng = params.eval(rsq, params.param, di, dj, qi, qj, f);
+
+            if (energy_shift)
+                {
+                double f_cut = 0.0;
+                eng -= params.eval(rcutsq, params.param, di, dj, qi, qj, f_cut);
+                }
+
+            force_divr = Scalar(f);
+            pair_eng = Scalar(eng);
+            return true;
+            }
+        else
+            return false;
+        }
+
+    //! Get the name of this potential
+    /*! \returns The potential name.
+     */
+    static std::string getName()
+        {
+        return std::string("cpp");
+        }
+
+    std::string getShapeSpec() const
+        {
+        throw std::runtime_error("Shape definition not supported for this pair potential.");
+        }
+
+    protected:
+    Scalar rsq;                //!< Stored rsq from the constructor
+    Scalar rcutsq;             //!< Stored rcutsq from the constructor
+    const param_type& params;  //!< Parameters of the type pair
+    Scalar di;                 //!< Diameter of particle i
+    Scalar dj;                 //!< Diameter of particle j
+    Scalar qi;                 //!< Charge of particle i
+    Scalar qj;                 //!< Charge of particle j
+    };
+
+#endif // __PAIR_EVALUATOR_JIT_H__
@@ -0,0 +1,148 @@
+#ifndef _EXTERNAL_FIELD_ENERGY_JIT_GPU_H_
+#define _EXTERNAL_FIELD_ENERGY_JIT_GPU_H_
+
+#ifdef ENABLE_HIP
+
+#include "ExternalFieldJIT.h"
+#include "GPUEvalFactory.h"
+#include <pybind11/stl.h>
+
+#include <vector>
+
+#include "hoomd/Autotuner.h"
+
+//! Evaluate external field energies via runtime generated code, GPU version
+/*! The LLVM compiled evaluator of the base class is still used for the whole system energy
+    differences (calculateDeltaE) and for logging. Trial moves on the GPU are accepted or rejected
+    by the kernel hpmc_external_field, compiled with NVRTC from the same user code.
+ */
+template<class Shape> class ExternalFieldJITGPU : public ExternalFieldJIT<Shape>
+    {
+    public:
+    //! Constructor
+    ExternalFieldJITGPU(std::shared_ptr<SystemDefinition> sysdef,
+                        std::shared_ptr<ExecutionConfiguration> exec_conf,
+                        const std::string& llvm_ir,
+                        const std::string& code,
+                        const std::string& kernel_name,
+                        const std::vector<std::string>& options,
+                        const std::string& cuda_devrt_library_path,
+                        unsigned int compute_arch)
+        : ExternalFieldJIT<Shape>(sysdef, exec_conf, llvm_ir),
+          m_gpu_factory(exec_conf,
+                        code,
+                        kernel_name,
+                        options,
+                        cuda_devrt_library_path,
+                        compute_arch)
+        {
+        // one thread per particle, tune the launch bounds (= block size)
+        m_tuner.reset(new Autotuner(m_gpu_factory.getLaunchBounds(),
+                                    5,
+                                    100000,
+                                    "hpmc_external_field",
+                                    this->m_exec_conf));
+        }
+
+    //! Asynchronously launch the JIT kernel
+    /*! \param args Kernel arguments
+        \param hStream stream to execute on
+        */
+    virtual void computeExternalFieldGPU(const hpmc::ExternalField::gpu_args_t& args,
+                                         hipStream_t hStream)
+        {
+#ifdef __HIP_PLATFORM_NVCC__
+        assert(args.d_postype);
+        assert(args.d_trial_postype);
+
+        this->m_exec_conf->beginMultiGPU();
+        m_tuner->begin();
+
+        auto& gpu_partition = args.gpu_partition;
+
+        // each GPU has its own instance of the kernel, use a block size that fits all of them
+        unsigned int launch_bounds = m_tuner->getParam();
+        unsigned int block_size = launch_bounds;
+        for (unsigned int idev = 0; idev < gpu_partition.getNumActiveGPUs(); ++idev)
+            block_size
+                = std::min(block_size, m_gpu_factory.getKernelMaxThreads(idev, 1, launch_bounds));
+
+        for (int idev = gpu_partition.getNumActiveGPUs() - 1; idev >= 0; --idev)
+            {
+            auto range = gpu_partition.getRangeAndSetGPU(idev);
+
+            unsigned int nwork = range.second - range.first;
+            if (nwork == 0)
+                continue;
+
+            dim3 grid((nwork + block_size - 1) / block_size, 1, 1);
+            dim3 threads(block_size, 1, 1);
+
+            auto launcher
+                = m_gpu_factory.configureKernel(idev, grid, threads, 0, hStream, 1, launch_bounds);
+
+            CUresult res = launcher(args.d_postype,
+                                    args.d_orientation,
+                                    args.d_trial_postype,
+                                    args.d_trial_orientation,
+                                    args.d_trial_move_type,
+                                    args.d_charge,
+                                    args.d_diameter,
+                                    args.d_reject_out_of_cell,
+                                    args.box,
+                                    args.seed,
+                                    args.rank,
+                                    args.timestep,
+                                    args.select,
+                                    range.first,
+                                    nwork);
+
+            if (res != CUDA_SUCCESS)
+                {
+                char* error;
+                cuGetErrorString(res, const_cast<const char**>(&error));
+                throw std::runtime_error("Error launching NVRTC kernel: " + std::string(error));
+                }
+            }
+
+        if (this->m_exec_conf->isCUDAErrorCheckingEnabled())
+            CHECK_CUDA_ERROR();
+        m_tuner->end();
+        this->m_exec_conf->endMultiGPU();
+#endif
+        }
+
+    //! Set autotuner parameters
+    /*! \param enable Enable/disable autotuning
+        \param period period (approximate) in time steps when returning occurs
+    */
+    virtual void setAutotunerParams(bool enable, unsigned int period)
+        {
+        m_tuner->setPeriod(period);
+        m_tuner->setEnabled(enable);
+        }
+
+    protected:
+    std::unique_ptr<Autotuner> m_tuner; //!< Autotuner for the launch bounds
+
+    private:
+    GPUEvalFactory m_gpu_factory; //!< JIT implementation
+    };
+
+//! Exports the ExternalFieldJITGPU class to python
+template<class Shape> void export_ExternalFieldJITGPU(pybind11::module& m, std::string name)
+    {
+    pybind11::class_<ExternalFieldJITGPU<Shape>,
+                     ExternalFieldJIT<Shape>,
+                     std::shared_ptr<ExternalFieldJITGPU<Shape>>>(m, name.c_str())
+        .def(pybind11::init<std::shared_ptr<SystemDefinition>,
+                            std::shared_ptr<ExecutionConfiguration>,
+                            const std::string&,
+                            const std::string&,
+                            const std::string&,
+                            const std::vector<std::string>&,
+                            const std::string&,
+                            unsigned int>());
+    }
+#endif
+#endif // _EXTERNAL_FIELD_ENERGY_JIT_GPU_H_
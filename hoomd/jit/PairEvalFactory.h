@@ -0,0 +1,44 @@
+#pragma once
+
+// do not include python headers
+#define HOOMD_LLVMJIT_BUILD
+#include "hoomd/HOOMDMath.h"
+
+#include "KaleidoscopeJIT.h"
+
+//! Compiles the LLVM IR of a user defined MD pair potential
+/*! The module must define an extern "C" function eval with the PairEvalFnPtr signature. It
+    returns the pair energy and writes -(1/r) dV/dr to force_divr.
+*/
+class PairEvalFactory
+    {
+    public:
+    typedef double (*PairEvalFnPtr)(double r_sq,
+                                    const double* param,
+                                    double d_i,
+                                    double d_j,
+                                    double q_i,
+                                    double q_j,
+                                    double& force_divr);
+
+    //! Constructor
+    PairEvalFactory(const std::string& llvm_ir);
+
+    //! Return the evaluator
+    PairEvalFnPtr getEval()
+        {
+        return m_eval;
+        }
+
+    //! Get the error message from initialization
+    const std::string& getError()
+        {
+        return m_error_msg;
+        }
+
+    private:
+    std::unique_ptr<llvm::orc::KaleidoscopeJIT> m_jit; //!< The persistent JIT engine
+    PairEvalFnPtr m_eval;                              //!< Function pointer to evaluator
+
+    std::string m_error_msg; //!< The error message if initialization fails
+    };
@@ -81,6 +81,42 @@ class PYBIND11_EXPORT PatchEnergyJIT : public hpmc::PatchEnergy
         return m_eval(r_ij, type_i, q_i, d_i, charge_i, type_j, q_j, d_j, charge_j);
         }
 
+    //! evaluate the energies of particle i with a batch of particles j
+    /*! Calls the eval_batch function of the JIT module when it defines one, so that the whole
+        batch is evaluated in a single call that LLVM may vectorize. Otherwise, calls eval once per
+        pair.
+    */
+    virtual void energyBatch(unsigned int n,
+                             const vec3<float>* r_ij,
+                             unsigned int type_i,
+                             const quat<float>& q_i,
+                             float d_i,
+                             float charge_i,
+                             const unsigned int* type_j,
+                             const quat<float>* q_j,
+                             const float* d_j,
+                             const float* charge_j,
+                             float* energies)
+        {
+        if (m_eval_batch)
+            {
+            m_eval_batch(n, r_ij, type_i, q_i, d_i, charge_i, type_j, q_j, d_j, charge_j, energies);
+            }
+        else
+            {
+            for (unsigned int k = 0; k < n; k++)
+                energies[k] = m_eval(r_ij[k],
+                                     type_i,
+                                     q_i,
+                                     d_i,
+                                     charge_i,
+                                     type_j[k],
+                                     q_j[k],
+                                     d_j[k],
+                                     charge_j[k]);
+            }
+        }
+
     static pybind11::object getAlphaNP(pybind11::object self)
         {
         auto self_cpp = self.cast<PatchEnergyJIT*>();
@@ -99,10 +135,11 @@ class PYBIND11_EXPORT PatchEnergyJIT : public hpmc::PatchEnergy
                                const quat<float>& q_j,
                                float,
                                float);
-    Scalar m_r_cut;                         //!< Cutoff radius
-    std::shared_ptr<EvalFactory> m_factory; //!< The factory for the evaluator function
-    EvalFactory::EvalFnPtr m_eval;          //!< Pointer to evaluator function inside the JIT module
-    unsigned int m_alpha_size;              //!< Size of array
+    Scalar m_r_cut;                           //!< Cutoff radius
+    std::shared_ptr<EvalFactory> m_factory;   //!< The factory for the evaluator function
+    EvalFactory::EvalFnPtr m_eval;            //!< Pointer to evaluator function in the JIT module
+    EvalFactory::EvalBatchFnPtr m_eval_batch; //!< Pointer to batched evaluator, may be NULL
+    unsigned int m_alpha_size;                //!< Size of array
     std::vector<float, managed_allocator<float>>
         m_alpha; //!< Array containing adjustable parameters
     };
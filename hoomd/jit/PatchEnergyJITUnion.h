@@ -114,6 +114,35 @@ class PatchEnergyJITUnion : public PatchEnergyJIT
                          float d_j,
                          float charge_j);
 
+    //! evaluate the energies of particle i with a batch of particles j
+    /*! The eval_batch function of the isotropic module does not include the constituent
+        interactions, evaluate each pair with energy().
+    */
+    virtual void energyBatch(unsigned int n,
+                             const vec3<float>* r_ij,
+                             unsigned int type_i,
+                             const quat<float>& q_i,
+                             float d_i,
+                             float charge_i,
+                             const unsigned int* type_j,
+                             const quat<float>* q_j,
+                             const float* d_j,
+                             const float* charge_j,
+                             float* energies)
+        {
+        hpmc::PatchEnergy::energyBatch(n,
+                                       r_ij,
+                                       type_i,
+                                       q_i,
+                                       d_i,
+                                       charge_i,
+                                       type_j,
+                                       q_j,
+                                       d_j,
+                                       charge_j,
+                                       energies);
+        }
+
     static pybind11::object getAlphaUnionNP(pybind11::object self)
         {
         auto self_cpp = self.cast<PatchEnergyJITUnion*>();
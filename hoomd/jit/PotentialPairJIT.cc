@@ -0,0 +1,61 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "PotentialPairJIT.h"
+#include "PairEvalFactory.h"
+
+/*! \param sysdef System to compute forces on
+    \param nlist Neighborlist to use for computing the forces
+    \param llvm_ir Contents of the LLVM IR to load
+*/
+PotentialPairJIT::PotentialPairJIT(std::shared_ptr<SystemDefinition> sysdef,
+                                   std::shared_ptr<NeighborList> nlist,
+                                   const std::string& llvm_ir)
+    : PotentialPair<EvaluatorPairJIT>(sysdef, nlist)
+    {
+    // build the JIT.
+    m_factory = std::shared_ptr<PairEvalFactory>(new PairEvalFactory(llvm_ir));
+
+    // get the evaluator
+    m_eval = m_factory->getEval();
+
+    if (!m_eval)
+        {
+        m_exec_conf->msg->error() << m_factory->getError() << std::endl;
+        throw std::runtime_error("Error compiling JIT code.");
+        }
+
+    for (auto& param : m_params)
+        param.eval = m_eval;
+    }
+
+/*! \param typ1 First type index in the pair
+    \param typ2 Second type index in the pair
+    \param param Parameter to set
+*/
+void PotentialPairJIT::setParams(unsigned int typ1, unsigned int typ2, const param_type& param)
+    {
+    param_type jit_param = param;
+    jit_param.eval = m_eval;
+    PotentialPair<EvaluatorPairJIT>::setParams(typ1, typ2, jit_param);
+    }
+
+void export_PotentialPairJIT(pybind11::module& m)
+    {
+    pybind11::class_<PotentialPairJIT, ForceCompute, std::shared_ptr<PotentialPairJIT>>(
+        m,
+        "PotentialPairJIT")
+        .def(pybind11::init<std::shared_ptr<SystemDefinition>,
+                            std::shared_ptr<NeighborList>,
+                            const std::string&>())
+        .def("setParams", &PotentialPairJIT::setParamsPython)
+        .def("getParams", &PotentialPairJIT::getParams)
+        .def("setRCut", &PotentialPairJIT::setRCutPython)
+        .def("getRCut", &PotentialPairJIT::getRCut)
+        .def("setROn", &PotentialPairJIT::setROnPython)
+        .def("getROn", &PotentialPairJIT::getROn)
+        .def_property("mode",
+                      &PotentialPairJIT::getShiftMode,
+                      &PotentialPairJIT::setShiftModePython)
+        .def("computeEnergyBetweenSets", &PotentialPairJIT::computeEnergyBetweenSetsPythonList);
+    }
@@ -0,0 +1,44 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#ifndef _POTENTIAL_PAIR_JIT_H_
+#define _POTENTIAL_PAIR_JIT_H_
+
+#include "EvaluatorPairJIT.h"
+#include "hoomd/md/PotentialPair.h"
+
+#include <memory>
+#include <string>
+
+/*! \file PotentialPairJIT.h
+    \brief Declares the MD pair potential with a JIT compiled evaluator
+*/
+
+class PairEvalFactory;
+
+//! MD pair potential that evaluates user code compiled at run time
+/*! PotentialPairJIT is PotentialPair<EvaluatorPairJIT>. It owns the PairEvalFactory that compiles
+    the LLVM IR given on construction and stores the pointer to the compiled function in the
+    parameters of every type pair. The CPU force loop then calls the function directly for each
+    pair within the cutoff.
+*/
+class PYBIND11_EXPORT PotentialPairJIT : public PotentialPair<EvaluatorPairJIT>
+    {
+    public:
+    //! Constructor
+    PotentialPairJIT(std::shared_ptr<SystemDefinition> sysdef,
+                     std::shared_ptr<NeighborList> nlist,
+                     const std::string& llvm_ir);
+
+    //! Set the parameters of a type pair
+    virtual void setParams(unsigned int typ1, unsigned int typ2, const param_type& param);
+
+    protected:
+    std::shared_ptr<PairEvalFactory> m_factory; //!< The factory for the evaluator function
+    EvaluatorPairJIT::eval_fn m_eval;           //!< Pointer to evaluator function in the module
+    };
+
+//! Exports the PotentialPairJIT class to python
+void export_PotentialPairJIT(pybind11::module& m);
+
+#endif // _POTENTIAL_PAIR_JIT_H_
@@ -0,0 +1,117 @@
+# Copyright (c) 2009-2021 The Regents of the University of Michigan
+# This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+"""Compile user C++ code to LLVM IR with clang.
+
+The functions in this module are used by :py:mod:`hoomd.jit` and
+:py:class:`hoomd.md.pair.CPPPotential`. They are not part of the public API.
+"""
+
+from hoomd import _hoomd
+import hoomd
+
+import subprocess
+import os
+import hashlib
+import tempfile
+
+
+def _jit_cache_dir():
+    R'''Get the directory that caches compiled LLVM IR.
+
+    The directory is set by the ``HOOMD_JIT_CACHE_DIR`` environment variable
+    and defaults to ``$XDG_CACHE_HOME/hoomd/jit`` (``~/.cache/hoomd/jit``). Set
+    ``HOOMD_JIT_CACHE_DIR`` to an empty string to disable the cache.
+    '''
+    cache_dir = os.environ.get('HOOMD_JIT_CACHE_DIR')
+    if cache_dir is None:
+        cache_root = os.environ.get('XDG_CACHE_HOME',
+                                    os.path.expanduser('~/.cache'))
+        cache_dir = os.path.join(cache_root, 'hoomd', 'jit')
+    return cache_dir
+
+
+def compile_ir(cmd, source, msg):
+    R'''Run clang on the given source and return the LLVM IR it writes.
+
+    Args:
+        cmd (list[str]): clang command line, reading the source from stdin.
+        source (str): C++ source code.
+        msg: C++ messenger that reports compilation errors.
+    '''
+    p = subprocess.Popen(cmd,
+                         stdin=subprocess.PIPE,
+                         stdout=subprocess.PIPE,
+                         stderr=subprocess.PIPE)
+
+    # pass C++ function to stdin
+    output = p.communicate(source.encode('utf-8'))
+    llvm_ir = output[0].decode()
+
+    if p.returncode != 0:
+        msg.error("Error compiling provided code\n")
+        msg.error("Command " + ' '.join(cmd) + "\n")
+        msg.error(output[1].decode() + "\n")
+        raise RuntimeError("Error compiling provided code")
+
+    return llvm_ir
+
+
+def cached_compile_ir(cmd, source, exec_conf, msg):
+    R'''Compile the source to LLVM IR, reusing a previous result from disk.
+
+    Args:
+        cmd (list[str]): clang command line, reading the source from stdin.
+        source (str): C++ source code.
+        exec_conf: C++ execution configuration.
+        msg: C++ messenger that reports compilation errors.
+
+    The cache key hashes the HOOMD version, the compiler command (executable,
+    flags, and include paths), and the source. Only the root rank reads the
+    cache or invokes clang, the IR is broadcast to all other ranks.
+    '''
+    cache_dir = _jit_cache_dir()
+
+    llvm_ir = ''
+    if exec_conf.getRank() == 0:
+        key = hashlib.sha256()
+        for part in [hoomd.version.version, hoomd.version.git_sha1] + cmd:
+            key.update(part.encode('utf-8'))
+            key.update(b'\0')
+        key.update(source.encode('utf-8'))
+        cache_file = None
+        if cache_dir:
+            cache_file = os.path.join(cache_dir, key.hexdigest() + '.ll')
+
+        if cache_file is not None and os.path.isfile(cache_file):
+            with open(cache_file, 'r') as f:
+                llvm_ir = f.read()
+
+        if not llvm_ir:
+            try:
+                llvm_ir = compile_ir(cmd, source, msg)
+            except RuntimeError:
+                # let the other ranks raise too instead of waiting forever
+                _hoomd.mpi_bcast_str('', exec_conf)
+                raise
+
+            if cache_file is not None:
+                # write to a temporary file first so that concurrent jobs
+                # never read a partially written file
+                try:
+                    os.makedirs(cache_dir, exist_ok=True)
+                    fd, tmp_name = tempfile.mkstemp(dir=cache_dir,
+                                                    suffix='.tmp')
+                    with os.fdopen(fd, 'w') as f:
+                        f.write(llvm_ir)
+                    os.replace(tmp_name, cache_file)
+                except OSError:
+                    msg.notice(
+                        2, "Unable to write JIT cache file in " + cache_dir
+                        + "\n")
+
+    llvm_ir = _hoomd.mpi_bcast_str(llvm_ir, exec_conf)
+    if not llvm_ir:
+        raise RuntimeError("Error compiling provided code")
+
+    return llvm_ir
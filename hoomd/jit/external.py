@@ -71,6 +71,15 @@ class user(field._external):
         gravity = """return r_i.z + box.getL().z/2;"""
         external = hoomd.jit.external.user(mc=mc, code=gravity)
 
+    .. rubric:: GPU execution
+
+    On the GPU, *code* is also compiled with NVRTC into a kernel that accepts or
+    rejects each trial move with a Metropolis criterion on the change in the
+    field energy. This happens before the overlap and patch checks. The field
+    only depends on the moved particle, so the separate acceptance test samples
+    the same distribution as the combined one on the CPU. *code* is required on
+    the GPU, *llvm_ir_file* alone is not sufficient.
+
     .. rubric:: LLVM IR code
 
     You can compile outside of HOOMD and provide a direct link
@@ -91,42 +100,42 @@ class user(field._external):
     def __init__(self, mc, code=None, llvm_ir_file=None, clang_exec=None):
         super(user, self).__init__()
 
-        # raise an error if this run is on the GPU
-        cls = None
-        if hoomd.context.current.device.cpp_exec_conf.isCUDAEnabled():
+        suffix = None
+        if isinstance(mc, integrate.sphere):
+            suffix = 'Sphere'
+        elif isinstance(mc, integrate.convex_polygon):
+            suffix = 'ConvexPolygon'
+        elif isinstance(mc, integrate.simple_polygon):
+            suffix = 'SimplePolygon'
+        elif isinstance(mc, integrate.convex_polyhedron):
+            suffix = 'ConvexPolyhedron'
+        elif isinstance(mc, integrate.convex_spheropolyhedron):
+            suffix = 'Spheropolyhedron'
+        elif isinstance(mc, integrate.ellipsoid):
+            suffix = 'Ellipsoid'
+        elif isinstance(mc, integrate.convex_spheropolygon):
+            suffix = 'Spheropolygon'
+        elif isinstance(mc, integrate.faceted_ellipsoid):
+            suffix = 'FacetedEllipsoid'
+        elif isinstance(mc, integrate.polyhedron):
+            suffix = 'Polyhedron'
+        elif isinstance(mc, integrate.sphinx):
+            suffix = 'Sphinx'
+        elif isinstance(mc, integrate.sphere_union):
+            suffix = 'SphereUnion'
+        elif isinstance(mc, integrate.convex_spheropolyhedron_union):
+            suffix = 'ConvexPolyhedronUnion'
+        else:
+            hoomd.context.current.device.cpp_msg.error(
+                "jit.field.user: Unsupported integrator.\n")
+            raise RuntimeError(
+                "Error initializing compute.position_lattice_field")
+
+        gpu = hoomd.context.current.device.cpp_exec_conf.isCUDAEnabled()
+        if gpu and code is None:
             hoomd.context.current.device.cpp_msg.error(
-                "JIT forces are not supported on the GPU\n")
+                "jit.external.user requires code on the GPU\n")
             raise RuntimeError("Error initializing force energy")
-        else:
-            if isinstance(mc, integrate.sphere):
-                cls = _jit.ExternalFieldJITSphere
-            elif isinstance(mc, integrate.convex_polygon):
-                cls = _jit.ExternalFieldJITConvexPolygon
-            elif isinstance(mc, integrate.simple_polygon):
-                cls = _jit.ExternalFieldJITSimplePolygon
-            elif isinstance(mc, integrate.convex_polyhedron):
-                cls = _jit.ExternalFieldJITConvexPolyhedron
-            elif isinstance(mc, integrate.convex_spheropolyhedron):
-                cls = _jit.ExternalFieldJITSpheropolyhedron
-            elif isinstance(mc, integrate.ellipsoid):
-                cls = _jit.ExternalFieldJITEllipsoid
-            elif isinstance(mc, integrate.convex_spheropolygon):
-                cls = _jit.ExternalFieldJITSpheropolygon
-            elif isinstance(mc, integrate.faceted_ellipsoid):
-                cls = _jit.ExternalFieldJITFacetedEllipsoid
-            elif isinstance(mc, integrate.polyhedron):
-                cls = _jit.ExternalFieldJITPolyhedron
-            elif isinstance(mc, integrate.sphinx):
-                cls = _jit.ExternalFieldJITSphinx
-            elif isinstance(mc, integrate.sphere_union):
-                cls = _jit.ExternalFieldJITSphereUnion
-            elif isinstance(mc, integrate.convex_spheropolyhedron_union):
-                cls = _jit.ExternalFieldJITConvexPolyhedronUnion
-            else:
-                hoomd.context.current.device.cpp_msg.error(
-                    "jit.field.user: Unsupported integrator.\n")
-                raise RuntimeError(
-                    "Error initializing compute.position_lattice_field")
 
         # Find a clang executable if none is provided
         if clang_exec is not None:
@@ -142,9 +151,37 @@ class user(field._external):
                 llvm_ir = f.read()
 
         self.compute_name = "external_field_jit"
-        self.cpp_compute = cls(hoomd.context.current.system_definition,
-                               hoomd.context.current.device.cpp_exec_conf,
-                               llvm_ir)
+        if gpu:
+            include_path_hoomd = os.path.dirname(hoomd.__file__) + '/include'
+            include_path_source = hoomd._hoomd.__hoomd_source_dir__
+            include_path_cuda = _jit.__cuda_include_path__
+            options = [
+                "-I" + include_path_hoomd, "-I" + include_path_source,
+                "-I" + include_path_cuda
+            ]
+            cuda_devrt_library_path = _jit.__cuda_devrt_library_path__
+
+            # select maximum supported compute capability out of those we compile for
+            compute_archs = _jit.__cuda_compute_archs__
+            compute_capability = hoomd.context.current.device.cpp_exec_conf.getComputeCapability(
+                0)  # GPU 0
+            compute_major, compute_minor = compute_capability.split('.')
+            max_arch = 0
+            for a in compute_archs.split('_'):
+                if int(a) < int(compute_major) * 10 + int(compute_major):
+                    max_arch = int(a)
+
+            cls = getattr(_jit, 'ExternalFieldJITGPU' + suffix)
+            self.cpp_compute = cls(hoomd.context.current.system_definition,
+                                   hoomd.context.current.device.cpp_exec_conf,
+                                   llvm_ir, self.wrap_gpu_code(code),
+                                   "hpmc::gpu::kernel::hpmc_external_field",
+                                   options, cuda_devrt_library_path, max_arch)
+        else:
+            cls = getattr(_jit, 'ExternalFieldJIT' + suffix)
+            self.cpp_compute = cls(hoomd.context.current.system_definition,
+                                   hoomd.context.current.device.cpp_exec_conf,
+                                   llvm_ir)
         hoomd.context.current.system.addCompute(self.cpp_compute,
                                                 self.compute_name)
 
@@ -225,3 +262,31 @@ Scalar charge
             raise RuntimeError("Error initializing force.")
 
         return llvm_ir
+
+    def wrap_gpu_code(self, code):
+        R'''Helper function to compile the provided code into a device function
+
+        Args:
+            code (str): C++ code to compile
+
+        .. versionadded:: 3.0
+        '''
+        cpp_function = """
+#include "hoomd/HOOMDMath.h"
+#include "hoomd/VectorMath.h"
+#include "hoomd/BoxDim.h"
+#include "hoomd/hpmc/IntegratorHPMCMonoGPUJITExternal.inc"
+
+__device__ inline float eval(const BoxDim& box,
+    unsigned int type_i,
+    const vec3<Scalar>& r_i,
+    const quat<Scalar>& q_i,
+    Scalar diameter,
+    Scalar charge)
+    {
+"""
+        cpp_function += code
+        cpp_function += """
+    }
+"""
+        return cpp_function
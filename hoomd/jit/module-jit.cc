@@ -23,7 +23,12 @@
 
 #include <string>
 
+#ifdef BUILD_MD
+#include "PotentialPairJIT.h"
+#endif
+
 #ifdef ENABLE_HIP
+#include "ExternalFieldJITGPU.h"
 #include "PatchEnergyJITGPU.h"
 #include "PatchEnergyJITUnionGPU.h"
 #endif
@@ -54,6 +59,10 @@ PYBIND11_MODULE(_jit, m)
     export_ExternalFieldJIT<ShapeFacetedEllipsoid>(m, "ExternalFieldJITFacetedEllipsoid");
     export_ExternalFieldJIT<ShapeSphinx>(m, "ExternalFieldJITSphinx");
 
+#ifdef BUILD_MD
+    export_PotentialPairJIT(m);
+#endif
+
 #if defined(ENABLE_HIP) && defined(__HIP_PLATFORM_NVCC__)
     m.attr("__cuda_devrt_library_path__") = std::string(CUDA_DEVRT_LIBRARY_PATH);
     m.attr("__cuda_include_path__") = std::string(CUDA_INCLUDE_PATH);
@@ -61,5 +70,16 @@ PYBIND11_MODULE(_jit, m)
 
     export_PatchEnergyJITGPU(m);
     export_PatchEnergyJITUnionGPU(m);
+
+    export_ExternalFieldJITGPU<ShapeSphere>(m, "ExternalFieldJITGPUSphere");
+    export_ExternalFieldJITGPU<ShapeConvexPolygon>(m, "ExternalFieldJITGPUConvexPolygon");
+    export_ExternalFieldJITGPU<ShapePolyhedron>(m, "ExternalFieldJITGPUPolyhedron");
+    export_ExternalFieldJITGPU<ShapeConvexPolyhedron>(m, "ExternalFieldJITGPUConvexPolyhedron");
+    export_ExternalFieldJITGPU<ShapeSpheropolyhedron>(m, "ExternalFieldJITGPUSpheropolyhedron");
+    export_ExternalFieldJITGPU<ShapeSpheropolygon>(m, "ExternalFieldJITGPUSpheropolygon");
+    export_ExternalFieldJITGPU<ShapeSimplePolygon>(m, "ExternalFieldJITGPUSimplePolygon");
+    export_ExternalFieldJITGPU<ShapeEllipsoid>(m, "ExternalFieldJITGPUEllipsoid");
+    export_ExternalFieldJITGPU<ShapeFacetedEllipsoid>(m, "ExternalFieldJITGPUFacetedEllipsoid");
+    export_ExternalFieldJITGPU<ShapeSphinx>(m, "ExternalFieldJITGPUSphinx");
 #endif
     }
@@ -5,7 +5,7 @@ from hoomd import _hoomd
 from hoomd.jit import _jit
 import hoomd
 
-import subprocess
+from hoomd.jit import compiler
 import os
 
 import numpy as np
@@ -123,6 +123,24 @@ class user(object):
 
     ``vec3`` and ``quat`` are defined in HOOMDMath.h.
 
+    The file may also define an extern "C" ``eval_batch`` function that
+    evaluates particle *i* against *n* particles *j* at once. HOOMD calls it
+    instead of ``eval`` for each pair when present:
+
+    .. code::
+
+        void eval_batch(unsigned int n,
+                        const vec3<float>* r_ij,
+                        unsigned int type_i,
+                        const quat<float>& q_i,
+                        float d_i,
+                        float charge_i,
+                        const unsigned int* type_j,
+                        const quat<float>* q_j,
+                        const float* d_j,
+                        const float* charge_j,
+                        float* energies)
+
     Compile the file with clang: ``clang -O3 --std=c++14 -DHOOMD_LLVMJIT_BUILD -I /path/to/hoomd/include -S -emit-llvm code.cc`` to produce
     the LLVM IR in ``code.ll``.
 
@@ -239,6 +257,25 @@ float eval(const vec3<float>& r_ij,
         cpp_function += code
         cpp_function += """
     }
+
+// evaluate one particle against a batch of neighbors, eval is inlined and the
+// loop may be vectorized
+void eval_batch(unsigned int n,
+    const vec3<float>* r_ij,
+    unsigned int type_i,
+    const quat<float>& q_i,
+    float d_i,
+    float charge_i,
+    const unsigned int* type_j,
+    const quat<float>* q_j,
+    const float* d_j,
+    const float* charge_j,
+    float* energies)
+    {
+    for (unsigned int k = 0; k < n; k++)
+        energies[k] = eval(r_ij[k], type_i, q_i, d_i, charge_i, type_j[k],
+                           q_j[k], d_j[k], charge_j[k]);
+    }
 }
 """
 
@@ -262,23 +299,13 @@ float eval(const vec3<float>& r_ij,
                 include_path, '-I', include_path_source, '-S', '-emit-llvm',
                 '-x', 'c++', '-o', '-', '-'
             ]
-        p = subprocess.Popen(cmd,
-                             stdin=subprocess.PIPE,
-                             stdout=subprocess.PIPE,
-                             stderr=subprocess.PIPE)
-
-        # pass C++ function to stdin
-        output = p.communicate(cpp_function.encode('utf-8'))
-        llvm_ir = output[0].decode()
-
-        if p.returncode != 0:
-            hoomd.context.current.device.cpp_msg.error(
-                "Error compiling provided code\n")
-            hoomd.context.current.device.cpp_msg.error("Command "
-                                                       + ' '.join(cmd) + "\n")
-            hoomd.context.current.device.cpp_msg.error(output[1].decode()
-                                                       + "\n")
-            raise RuntimeError("Error initializing patch energy")
+        if fn is not None:
+            llvm_ir = compiler.compile_ir(
+                cmd, cpp_function, hoomd.context.current.device.cpp_msg)
+        else:
+            llvm_ir = compiler.cached_compile_ir(
+                cmd, cpp_function, hoomd.context.current.device.cpp_exec_conf,
+                hoomd.context.current.device.cpp_msg)
 
         return llvm_ir
 
@@ -552,3 +579,4 @@ class user_union(user):
 
         self.cpp_evaluator.setParam(typeid, typeids, positions, orientations,
                                     diameters, charges, leaf_capacity)
+
@@ -20,7 +20,8 @@ using namespace hoomd;
 ActiveForceCompute::ActiveForceCompute(std::shared_ptr<SystemDefinition> sysdef,
                                        std::shared_ptr<ParticleGroup> group)
 
-    : ForceCompute(sysdef), m_group(group)
+    : ForceCompute(sysdef), m_group(group), m_diffusion_scheduled(false),
+      m_scheduled_diffusion(0.0), m_scheduled_diffusion_timestep(0)
     {
     // allocate memory for the per-type active_force storage and initialize them to (1.0,0,0)
     GlobalVector<Scalar4> tmp_f_activeVec(m_pdata->getNTypes(), m_exec_conf);
@@ -299,6 +300,33 @@ void ActiveForceCompute::rotationalDiffusion(Scalar rotational_diffusion, uint64
         }
     }
 
+/*! ActiveRotationalDiffusionUpdater runs before the integrator in each step. Instead of rotating
+    the orientations in a separate pass over the group, it schedules the rotation and the next
+    force evaluation in the same step applies it together with setting the forces (in one kernel on
+    the GPU). The random numbers depend only on the scheduled timestep and the particle tag.
+
+    \param rotational_diffusion Rotational diffusion constant
+    \param timestep Timestep of the updater
+*/
+void ActiveForceCompute::scheduleRotationalDiffusion(Scalar rotational_diffusion, uint64_t timestep)
+    {
+    // apply a rotation that has not been consumed by a force evaluation yet
+    applyScheduledRotationalDiffusion();
+
+    m_diffusion_scheduled = true;
+    m_scheduled_diffusion = rotational_diffusion;
+    m_scheduled_diffusion_timestep = timestep;
+    }
+
+void ActiveForceCompute::applyScheduledRotationalDiffusion()
+    {
+    if (m_diffusion_scheduled)
+        {
+        rotationalDiffusion(m_scheduled_diffusion, m_scheduled_diffusion_timestep);
+        m_diffusion_scheduled = false;
+        }
+    }
+
 /*! This function applies rotational diffusion and sets forces for all active particles
     \param timestep Current timestep
 */
@@ -307,6 +335,8 @@ void ActiveForceCompute::computeForces(uint64_t timestep)
     if (m_prof)
         m_prof->push(m_exec_conf, "ActiveForceCompute");
 
+    applyScheduledRotationalDiffusion();
+
     setForces(); // set forces for particles
 
 #ifdef ENABLE_HIP
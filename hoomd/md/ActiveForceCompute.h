@@ -73,6 +73,12 @@ class PYBIND11_EXPORT ActiveForceCompute : public ForceCompute
     //! Orientational diffusion for spherical particles
     virtual void rotationalDiffusion(Scalar rotational_diffusion, uint64_t timestep);
 
+    //! Defer rotational diffusion to the next force evaluation
+    void scheduleRotationalDiffusion(Scalar rotational_diffusion, uint64_t timestep);
+
+    //! Apply the scheduled rotational diffusion, if any
+    void applyScheduledRotationalDiffusion();
+
     std::shared_ptr<ParticleGroup> m_group; //!< Group of particles on which this force is applied
     GlobalVector<Scalar4>
         m_f_activeVec; //! active force unit vectors and magnitudes for each particle type
@@ -80,10 +86,14 @@ class PYBIND11_EXPORT ActiveForceCompute : public ForceCompute
     GlobalVector<Scalar4>
         m_t_activeVec; //! active torque unit vectors and magnitudes for each particle type
 
+    bool m_diffusion_scheduled;              //!< True when rotational diffusion is scheduled
+    Scalar m_scheduled_diffusion;            //!< Scheduled rotational diffusion constant
+    uint64_t m_scheduled_diffusion_timestep; //!< Timestep of the scheduled rotational diffusion
+
     private:
     // Allow ActiveRotationalDiffusionUpdater to access internal methods and members of
     // ActiveForceCompute classes/subclasses. This is necessary to allow
-    // ActiveRotationalDiffusionUpdater to call rotationalDiffusion.
+    // ActiveRotationalDiffusionUpdater to call scheduleRotationalDiffusion.
     friend class ActiveRotationalDiffusionUpdater;
     };
 
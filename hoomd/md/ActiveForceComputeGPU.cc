@@ -70,10 +70,15 @@ ActiveForceComputeGPU::ActiveForceComputeGPU(std::shared_ptr<SystemDefinition> s
     m_t_activeVec.swap(tmp_t_activeVec);
     }
 
-/*! This function sets appropriate active forces and torques on all active particles.
- */
-void ActiveForceComputeGPU::setForces()
+/*! This function applies the scheduled rotational diffusion and sets appropriate active forces and
+    torques on all active particles.
+    \param timestep Current timestep
+*/
+void ActiveForceComputeGPU::computeForces(uint64_t timestep)
     {
+    if (m_prof)
+        m_prof->push(m_exec_conf, "ActiveForceCompute");
+
     //  array handles
     ArrayHandle<Scalar4> d_f_actVec(m_f_activeVec, access_location::device, access_mode::read);
     ArrayHandle<Scalar4> d_force(m_force, access_location::device, access_mode::overwrite);
@@ -84,10 +89,11 @@ void ActiveForceComputeGPU::setForces()
     ArrayHandle<Scalar4> d_pos(m_pdata->getPositions(), access_location::device, access_mode::read);
     ArrayHandle<Scalar4> d_orientation(m_pdata->getOrientationArray(),
                                        access_location::device,
-                                       access_mode::read);
+                                       access_mode::readwrite);
     ArrayHandle<unsigned int> d_index_array(m_group->getIndexArray(),
                                             access_location::device,
                                             access_mode::read);
+    ArrayHandle<unsigned int> d_tag(m_pdata->getTags(), access_location::device, access_mode::read);
 
     // sanity check
     assert(d_force.data != NULL);
@@ -99,6 +105,9 @@ void ActiveForceComputeGPU::setForces()
     unsigned int group_size = m_group->getNumMembers();
     unsigned int N = m_pdata->getN();
 
+    bool is2D = (m_sysdef->getNDimensions() == 2);
+    const Scalar rotation_constant = slow::sqrt(2.0 * m_scheduled_diffusion * m_deltaT);
+
     // compute the forces on the GPU
     m_tuner_force->begin();
 
@@ -111,12 +120,22 @@ void ActiveForceComputeGPU::setForces()
                                         d_f_actVec.data,
                                         d_t_actVec.data,
                                         N,
+                                        d_tag.data,
+                                        m_diffusion_scheduled,
+                                        is2D,
+                                        rotation_constant,
+                                        m_scheduled_diffusion_timestep,
+                                        m_sysdef->getSeed(),
                                         m_tuner_force->getParam());
 
     if (m_exec_conf->isCUDAErrorCheckingEnabled())
         CHECK_CUDA_ERROR();
 
     m_tuner_force->end();
+    m_diffusion_scheduled = false;
+
+    if (m_prof)
+        m_prof->pop(m_exec_conf);
     }
 
 /*! This function applies rotational diffusion to all active particles. The angle between the torque
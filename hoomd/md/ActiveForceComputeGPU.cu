@@ -16,6 +16,57 @@ using namespace hoomd;
    ActiveForceComputeGPU.
 */
 
+//! Apply rotational diffusion to the orientation of one particle
+/*! \param quati particle orientation (updated)
+    \param fact active force unit vector and magnitude of the particle type
+    \param ptag particle tag
+    \param is2D check if simulation is 2D or 3D
+    \param rotationConst particle rotational diffusion constant
+    \param timestep timestep of the rotational diffusion
+    \param seed seed for random number generator
+*/
+__device__ inline void gpu_active_force_rotate_particle(quat<Scalar>& quati,
+                                                        const Scalar4& fact,
+                                                        unsigned int ptag,
+                                                        bool is2D,
+                                                        const Scalar rotationConst,
+                                                        const uint64_t timestep,
+                                                        const uint16_t seed)
+    {
+    hoomd::RandomGenerator rng(
+        hoomd::Seed(hoomd::RNGIdentifier::ActiveForceCompute, timestep, seed),
+        hoomd::Counter(ptag));
+
+    if (is2D) // 2D
+        {
+        Scalar delta_theta = hoomd::NormalDistribution<Scalar>(rotationConst)(rng);
+
+        vec3<Scalar> b(0, 0, 1.0);
+        quat<Scalar> rot_quat = quat<Scalar>::fromAxisAngle(b, delta_theta);
+
+        quati = rot_quat * quati;
+        // in 2D there is only one meaningful direction for torque
+        }
+    else // 3D: Following Stenhammar, Soft Matter, 2014
+        {
+        hoomd::SpherePointGenerator<Scalar> unit_vec;
+        vec3<Scalar> rand_vec;
+        unit_vec(rng, rand_vec);
+
+        vec3<Scalar> f(fact.x, fact.y, fact.z);
+        vec3<Scalar> fi = rotate(quati, f);
+
+        vec3<Scalar> aux_vec = cross(fi, rand_vec); // rotation axis
+        Scalar aux_vec_mag = slow::rsqrt(dot(aux_vec, aux_vec));
+        aux_vec *= aux_vec_mag;
+
+        Scalar delta_theta = hoomd::NormalDistribution<Scalar>(rotationConst)(rng);
+        quat<Scalar> rot_quat = quat<Scalar>::fromAxisAngle(aux_vec, delta_theta);
+
+        quati = rot_quat * quati;
+        }
+    }
+
 //! Kernel for setting active force vectors on the GPU
 /*! \param group_size number of particles
     \param d_index_array stores list to convert group index to global tag
@@ -24,17 +75,29 @@ using namespace hoomd;
     \param d_orientation particle orientation on device
     \param d_f_act particle active force unit vector
     \param d_t_act particle active torque unit vector
-    \param orientationLink check if particle orientation is linked to active force vector
+    \param d_tag particle tags on device
+    \param rotational_diffusion apply rotational diffusion before setting the forces
+    \param is2D check if simulation is 2D or 3D
+    \param rotationConst particle rotational diffusion constant
+    \param timestep timestep of the rotational diffusion
+    \param seed seed for random number generator
+
+    Applying the scheduled rotational diffusion in the same kernel saves a pass over the group.
 */
 __global__ void gpu_compute_active_force_set_forces_kernel(const unsigned int group_size,
                                                            unsigned int* d_index_array,
                                                            Scalar4* d_force,
                                                            Scalar4* d_torque,
                                                            const Scalar4* d_pos,
-                                                           const Scalar4* d_orientation,
+                                                           Scalar4* d_orientation,
                                                            const Scalar4* d_f_act,
                                                            const Scalar4* d_t_act,
-                                                           const unsigned int N)
+                                                           unsigned int* d_tag,
+                                                           bool rotational_diffusion,
+                                                           bool is2D,
+                                                           const Scalar rotationConst,
+                                                           const uint64_t timestep,
+                                                           const uint16_t seed)
     {
     unsigned int group_idx = blockIdx.x * blockDim.x + threadIdx.x;
     if (group_idx >= group_size)
@@ -45,17 +108,22 @@ __global__ void gpu_compute_active_force_set_forces_kernel(const unsigned int gr
     unsigned int type = __scalar_as_int(posidx.w);
 
     Scalar4 fact = __ldg(d_f_act + type);
-
-    vec3<Scalar> f(fact.w * fact.x, fact.w * fact.y, fact.w * fact.z);
-    quat<Scalar> quati(__ldg(d_orientation + idx));
-    vec3<Scalar> fi = rotate(quati, f);
-    d_force[idx] = vec_to_scalar4(fi, 0);
-
     Scalar4 tact = __ldg(d_t_act + type);
+    quat<Scalar> quati(d_orientation[idx]);
+
+    if (rotational_diffusion && fact.w != 0)
+        {
+        gpu_active_force_rotate_particle(quati,
+                                         fact,
+                                         d_tag[idx],
+                                         is2D,
+                                         rotationConst,
+                                         timestep,
+                                         seed);
+        d_orientation[idx] = quat_to_scalar4(quati);
+        }
 
-    vec3<Scalar> t(tact.w * tact.x, tact.w * tact.y, tact.w * tact.z);
-    vec3<Scalar> ti = rotate(quati, t);
-    d_torque[idx] = vec_to_scalar4(ti, 0);
+    gpu_active_force_set_particle(idx, quati, fact, tact, d_force, d_torque);
     }
 
 //! Kernel for applying rotational diffusion to active force vectors on the GPU
@@ -90,44 +158,15 @@ __global__ void gpu_compute_active_force_rotational_diffusion_kernel(const unsig
 
     if (fact.w != 0)
         {
-        unsigned int ptag = d_tag[group_idx];
-
         quat<Scalar> quati(__ldg(d_orientation + idx));
-
-        hoomd::RandomGenerator rng(
-            hoomd::Seed(hoomd::RNGIdentifier::ActiveForceCompute, timestep, seed),
-            hoomd::Counter(ptag));
-
-        if (is2D) // 2D
-            {
-            Scalar delta_theta = hoomd::NormalDistribution<Scalar>(rotationConst)(rng);
-
-            vec3<Scalar> b(0, 0, 1.0);
-            quat<Scalar> rot_quat = quat<Scalar>::fromAxisAngle(b, delta_theta);
-
-            quati = rot_quat * quati;
-            d_orientation[idx] = quat_to_scalar4(quati);
-            // in 2D there is only one meaningful direction for torque
-            }
-        else // 3D: Following Stenhammar, Soft Matter, 2014
-            {
-            hoomd::SpherePointGenerator<Scalar> unit_vec;
-            vec3<Scalar> rand_vec;
-            unit_vec(rng, rand_vec);
-
-            vec3<Scalar> f(fact.x, fact.y, fact.z);
-            vec3<Scalar> fi = rotate(quati, f);
-
-            vec3<Scalar> aux_vec = cross(fi, rand_vec); // rotation axis
-            Scalar aux_vec_mag = slow::rsqrt(dot(aux_vec, aux_vec));
-            aux_vec *= aux_vec_mag;
-
-            Scalar delta_theta = hoomd::NormalDistribution<Scalar>(rotationConst)(rng);
-            quat<Scalar> rot_quat = quat<Scalar>::fromAxisAngle(aux_vec, delta_theta);
-
-            quati = rot_quat * quati;
-            d_orientation[idx] = quat_to_scalar4(quati);
-            }
+        gpu_active_force_rotate_particle(quati,
+                                         fact,
+                                         d_tag[idx],
+                                         is2D,
+                                         rotationConst,
+                                         timestep,
+                                         seed);
+        d_orientation[idx] = quat_to_scalar4(quati);
         }
     }
 
@@ -136,18 +175,27 @@ hipError_t gpu_compute_active_force_set_forces(const unsigned int group_size,
                                                Scalar4* d_force,
                                                Scalar4* d_torque,
                                                const Scalar4* d_pos,
-                                               const Scalar4* d_orientation,
+                                               Scalar4* d_orientation,
                                                const Scalar4* d_f_act,
                                                const Scalar4* d_t_act,
                                                const unsigned int N,
+                                               unsigned int* d_tag,
+                                               bool rotational_diffusion,
+                                               bool is2D,
+                                               const Scalar rotationConst,
+                                               const uint64_t timestep,
+                                               const uint16_t seed,
                                                unsigned int block_size)
     {
     // setup the grid to run the kernel
     dim3 grid(group_size / block_size + 1, 1, 1);
     dim3 threads(block_size, 1, 1);
 
-    // run the kernel
+    // zero forces and torques so we don't leave any set for indices that are not in the group
     hipMemset(d_force, 0, sizeof(Scalar4) * N);
+    hipMemset(d_torque, 0, sizeof(Scalar4) * N);
+
+    // run the kernel
     hipLaunchKernelGGL((gpu_compute_active_force_set_forces_kernel),
                        dim3(grid),
                        dim3(threads),
@@ -161,7 +209,12 @@ hipError_t gpu_compute_active_force_set_forces(const unsigned int group_size,
                        d_orientation,
                        d_f_act,
                        d_t_act,
-                       N);
+                       d_tag,
+                       rotational_diffusion,
+                       is2D,
+                       rotationConst,
+                       timestep,
+                       seed);
     return hipSuccess;
     }
 
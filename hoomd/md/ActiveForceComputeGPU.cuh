@@ -6,6 +6,7 @@
 #include "hip/hip_runtime.h"
 #include "hoomd/HOOMDMath.h"
 #include "hoomd/ParticleData.cuh"
+#include "hoomd/VectorMath.h"
 
 /*! \file ActiveForceComputeGPU.cuh
     \brief Declares GPU kernel code for calculating active forces forces on the GPU. Used by
@@ -20,10 +21,16 @@ hipError_t gpu_compute_active_force_set_forces(const unsigned int group_size,
                                                Scalar4* d_force,
                                                Scalar4* d_torque,
                                                const Scalar4* d_pos,
-                                               const Scalar4* d_orientation,
+                                               Scalar4* d_orientation,
                                                const Scalar4* d_f_act,
                                                const Scalar4* d_t_act,
                                                const unsigned int N,
+                                               unsigned int* d_tag,
+                                               bool rotational_diffusion,
+                                               bool is2D,
+                                               const Scalar rotationConst,
+                                               const uint64_t timestep,
+                                               const uint16_t seed,
                                                unsigned int block_size);
 
 hipError_t gpu_compute_active_force_rotational_diffusion(const unsigned int group_size,
@@ -38,4 +45,30 @@ hipError_t gpu_compute_active_force_rotational_diffusion(const unsigned int grou
                                                          const uint16_t seed,
                                                          unsigned int block_size);
 
+#ifdef __HIPCC__
+//! Set the active force and torque of one particle
+/*! \param idx particle index
+    \param quati particle orientation
+    \param fact active force unit vector and magnitude of the particle type
+    \param tact active torque unit vector and magnitude of the particle type
+    \param d_force particle force on device
+    \param d_torque particle torque on device
+*/
+__device__ inline void gpu_active_force_set_particle(unsigned int idx,
+                                                     const quat<Scalar>& quati,
+                                                     const Scalar4& fact,
+                                                     const Scalar4& tact,
+                                                     Scalar4* d_force,
+                                                     Scalar4* d_torque)
+    {
+    vec3<Scalar> f(fact.w * fact.x, fact.w * fact.y, fact.w * fact.z);
+    vec3<Scalar> fi = rotate(quati, f);
+    d_force[idx] = vec_to_scalar4(fi, 0);
+
+    vec3<Scalar> t(tact.w * tact.x, tact.w * tact.y, tact.w * tact.z);
+    vec3<Scalar> ti = rotate(quati, t);
+    d_torque[idx] = vec_to_scalar4(ti, 0);
+    }
+#endif
+
 #endif
@@ -46,8 +46,8 @@ class PYBIND11_EXPORT ActiveForceComputeGPU : public ActiveForceCompute
     std::unique_ptr<Autotuner> m_tuner_force;     //!< Autotuner for block size (force kernel)
     std::unique_ptr<Autotuner> m_tuner_diffusion; //!< Autotuner for block size (diff kernel)
 
-    //! Set forces for particles
-    virtual void setForces();
+    //! Apply the scheduled rotational diffusion and set the forces in one kernel
+    virtual void computeForces(uint64_t timestep);
 
     //! Orientational diffusion for spherical particles
     virtual void rotationalDiffusion(Scalar rotational_diffusion, uint64_t timestep);
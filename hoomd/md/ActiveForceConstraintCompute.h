@@ -199,6 +199,8 @@ void ActiveForceConstraintCompute<Manifold>::computeForces(uint64_t timestep)
         m_box_changed = false;
         }
 
+    applyScheduledRotationalDiffusion();
+
     setConstraint(); // apply manifold constraints to active particles active force vectors
 
     setForces(); // set forces for particles
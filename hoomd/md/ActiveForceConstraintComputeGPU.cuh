@@ -3,6 +3,7 @@
 
 // Maintainer: joaander
 
+#include "ActiveForceComputeGPU.cuh"
 #include "hip/hip_runtime.h"
 #include "hoomd/HOOMDMath.h"
 #include "hoomd/ParticleData.cuh"
@@ -19,13 +20,22 @@
 #define __ACTIVE_FORCE_CONSTRAINT_COMPUTE_GPU_CUH__
 
 template<class Manifold>
-hipError_t gpu_compute_active_force_set_constraints(const unsigned int group_size,
-                                                    unsigned int* d_index_array,
-                                                    const Scalar4* d_pos,
-                                                    Scalar4* d_orientation,
-                                                    const Scalar4* d_f_act,
-                                                    Manifold manifold,
-                                                    unsigned int block_size);
+hipError_t gpu_compute_active_force_constraint_set_forces(const unsigned int group_size,
+                                                         unsigned int* d_index_array,
+                                                         Scalar4* d_force,
+                                                         Scalar4* d_torque,
+                                                         const Scalar4* d_pos,
+                                                         Scalar4* d_orientation,
+                                                         const Scalar4* d_f_act,
+                                                         const Scalar4* d_t_act,
+                                                         const unsigned int N,
+                                                         Manifold manifold,
+                                                         unsigned int* d_tag,
+                                                         bool rotational_diffusion,
+                                                         const Scalar rotationConst,
+                                                         const uint64_t timestep,
+                                                         const uint16_t seed,
+                                                         unsigned int block_size);
 
 template<class Manifold>
 hipError_t gpu_compute_active_force_constraint_rotational_diffusion(const unsigned int group_size,
@@ -42,21 +52,40 @@ hipError_t gpu_compute_active_force_constraint_rotational_diffusion(const unsign
 
 #ifdef __HIPCC__
 
-//! Kernel for adjusting active force vectors to align parallel to an
-//  manifold surface constraint on the GPU
+//! Kernel for setting active force vectors of particles confined to a manifold on the GPU
 /*! \param group_size number of particles
     \param d_index_array stores list to convert group index to global tag
+    \param d_force particle force on device
+    \param d_torque particle torque on device
     \param d_pos particle positions on device
+    \param d_orientation particle orientation on device
     \param d_f_act particle active force unit vector
+    \param d_t_act particle active torque unit vector
     \param manifold constraint
+    \param d_tag particle tags on device
+    \param rotational_diffusion apply rotational diffusion before setting the forces
+    \param rotationConst particle rotational diffusion constant
+    \param timestep timestep of the rotational diffusion
+    \param seed seed for random number generator
+
+    Each thread applies the scheduled rotational diffusion in the tangent plane, aligns the active
+    force vector parallel to the manifold surface, and sets the force and torque of one particle.
 */
 template<class Manifold>
-__global__ void gpu_compute_active_force_set_constraints_kernel(const unsigned int group_size,
-                                                                unsigned int* d_index_array,
-                                                                const Scalar4* d_pos,
-                                                                Scalar4* d_orientation,
-                                                                const Scalar4* d_f_act,
-                                                                Manifold manifold)
+__global__ void gpu_compute_active_force_constraint_set_forces_kernel(const unsigned int group_size,
+                                                                     unsigned int* d_index_array,
+                                                                     Scalar4* d_force,
+                                                                     Scalar4* d_torque,
+                                                                     const Scalar4* d_pos,
+                                                                     Scalar4* d_orientation,
+                                                                     const Scalar4* d_f_act,
+                                                                     const Scalar4* d_t_act,
+                                                                     Manifold manifold,
+                                                                     unsigned int* d_tag,
+                                                                     bool rotational_diffusion,
+                                                                     const Scalar rotationConst,
+                                                                     const uint64_t timestep,
+                                                                     const uint16_t seed)
     {
     unsigned int group_idx = blockIdx.x * blockDim.x + threadIdx.x;
     if (group_idx >= group_size)
@@ -67,15 +96,28 @@ __global__ void gpu_compute_active_force_set_constraints_kernel(const unsigned i
     unsigned int type = __scalar_as_int(posidx.w);
 
     Scalar4 fact = __ldg(d_f_act + type);
+    Scalar4 tact = __ldg(d_t_act + type);
+    quat<Scalar> quati(d_orientation[idx]);
 
-    if (fact.w != 0)
+    Scalar3 current_pos = make_scalar3(posidx.x, posidx.y, posidx.z);
+    vec3<Scalar> norm = normalize(vec3<Scalar>(manifold.derivative(current_pos)));
+
+    if (rotational_diffusion)
         {
-        Scalar3 current_pos = make_scalar3(posidx.x, posidx.y, posidx.z);
+        hoomd::RandomGenerator rng(
+            hoomd::Seed(hoomd::RNGIdentifier::ActiveForceCompute, timestep, seed),
+            hoomd::Counter(d_tag[idx]));
 
-        vec3<Scalar> norm = normalize(vec3<Scalar>(manifold.derivative(current_pos)));
+        Scalar delta_theta = hoomd::NormalDistribution<Scalar>(rotationConst)(rng);
+
+        quat<Scalar> rot_quat = quat<Scalar>::fromAxisAngle(norm, delta_theta);
+
+        quati = rot_quat * quati;
+        }
 
+    if (fact.w != 0)
+        {
         vec3<Scalar> f(fact.x, fact.y, fact.z);
-        quat<Scalar> quati(__ldg(d_orientation + idx));
         vec3<Scalar> fi = rotate(quati, f);
 
         Scalar dot_prod = fi.x * norm.x + fi.y * norm.y + fi.z * norm.z;
@@ -97,9 +139,12 @@ __global__ void gpu_compute_active_force_set_constraints_kernel(const unsigned i
         quat<Scalar> rot_quat = quat<Scalar>::fromAxisAngle(rot_vec, phi);
 
         quati = rot_quat * quati;
+        }
 
+    if (rotational_diffusion || fact.w != 0)
         d_orientation[idx] = quat_to_scalar4(quati);
-        }
+
+    gpu_active_force_set_particle(idx, quati, fact, tact, d_force, d_torque);
     }
 
 //! Kernel for applying rotational diffusion to active force vectors on the GPU
@@ -130,8 +175,7 @@ gpu_compute_active_force_constraint_rotational_diffusion_kernel(const unsigned i
 
     unsigned int idx = d_index_array[group_idx];
     Scalar4 posidx = __ldg(d_pos + idx);
-    unsigned int type = __scalar_as_int(posidx.w);
-    unsigned int ptag = d_tag[group_idx];
+    unsigned int ptag = d_tag[idx];
 
     quat<Scalar> quati(__ldg(d_orientation + idx));
 
@@ -151,30 +195,51 @@ gpu_compute_active_force_constraint_rotational_diffusion_kernel(const unsigned i
     }
 
 template<class Manifold>
-hipError_t gpu_compute_active_force_set_constraints(const unsigned int group_size,
-                                                    unsigned int* d_index_array,
-                                                    const Scalar4* d_pos,
-                                                    Scalar4* d_orientation,
-                                                    const Scalar4* d_f_act,
-                                                    Manifold manifold,
-                                                    unsigned int block_size)
+hipError_t gpu_compute_active_force_constraint_set_forces(const unsigned int group_size,
+                                                         unsigned int* d_index_array,
+                                                         Scalar4* d_force,
+                                                         Scalar4* d_torque,
+                                                         const Scalar4* d_pos,
+                                                         Scalar4* d_orientation,
+                                                         const Scalar4* d_f_act,
+                                                         const Scalar4* d_t_act,
+                                                         const unsigned int N,
+                                                         Manifold manifold,
+                                                         unsigned int* d_tag,
+                                                         bool rotational_diffusion,
+                                                         const Scalar rotationConst,
+                                                         const uint64_t timestep,
+                                                         const uint16_t seed,
+                                                         unsigned int block_size)
     {
     // setup the grid to run the kernel
     dim3 grid(group_size / block_size + 1, 1, 1);
     dim3 threads(block_size, 1, 1);
 
+    // zero forces and torques so we don't leave any set for indices that are not in the group
+    hipMemset(d_force, 0, sizeof(Scalar4) * N);
+    hipMemset(d_torque, 0, sizeof(Scalar4) * N);
+
     // run the kernel
-    hipLaunchKernelGGL((gpu_compute_active_force_set_constraints_kernel<Manifold>),
+    hipLaunchKernelGGL((gpu_compute_active_force_constraint_set_forces_kernel<Manifold>),
                        dim3(grid),
                        dim3(threads),
                        0,
                        0,
                        group_size,
                        d_index_array,
+                       d_force,
+                       d_torque,
                        d_pos,
                        d_orientation,
                        d_f_act,
-                       manifold);
+                       d_t_act,
+                       manifold,
+                       d_tag,
+                       rotational_diffusion,
+                       rotationConst,
+                       timestep,
+                       seed);
     return hipSuccess;
     }
 
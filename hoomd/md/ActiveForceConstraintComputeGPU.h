@@ -49,23 +49,17 @@ class PYBIND11_EXPORT ActiveForceConstraintComputeGPU
         m_tuner_force->setEnabled(enable);
         m_tuner_diffusion->setPeriod(period);
         m_tuner_diffusion->setEnabled(enable);
-        m_tuner_constraint->setPeriod(period);
-        m_tuner_constraint->setEnabled(enable);
         }
 
     protected:
-    std::unique_ptr<Autotuner> m_tuner_force;      //!< Autotuner for block size (force kernel)
-    std::unique_ptr<Autotuner> m_tuner_diffusion;  //!< Autotuner for block size (diff kernel)
-    std::unique_ptr<Autotuner> m_tuner_constraint; //!< Autotuner for block size (constr kernel)
+    std::unique_ptr<Autotuner> m_tuner_force;     //!< Autotuner for block size (force kernel)
+    std::unique_ptr<Autotuner> m_tuner_diffusion; //!< Autotuner for block size (diff kernel)
 
-    //! Set forces for particles
-    virtual void setForces();
+    //! Apply the scheduled rotational diffusion, the constraint, and set the forces in one kernel
+    virtual void computeForces(uint64_t timestep);
 
     //! Orientational diffusion for spherical particles
     virtual void rotationalDiffusion(Scalar rotational_diffusion, uint64_t timestep);
-
-    //! Set constraints if particles confined to a surface
-    virtual void setConstraint();
     };
 
 /*! \file ActiveForceConstraintComputeGPU.cc
@@ -109,8 +103,6 @@ ActiveForceConstraintComputeGPU<Manifold>::ActiveForceConstraintComputeGPU(
         new Autotuner(valid_params, 5, 100000, "active_constraint_force", this->m_exec_conf));
     m_tuner_diffusion.reset(
         new Autotuner(valid_params, 5, 100000, "active_constraint_diffusion", this->m_exec_conf));
-    m_tuner_constraint.reset(
-        new Autotuner(valid_params, 5, 100000, "active_constraint_constraint", this->m_exec_conf));
 
     unsigned int type = this->m_pdata->getNTypes();
     GlobalVector<Scalar4> tmp_f_activeVec(type, this->m_exec_conf);
@@ -136,10 +128,25 @@ ActiveForceConstraintComputeGPU<Manifold>::ActiveForceConstraintComputeGPU(
     this->m_t_activeVec.swap(tmp_t_activeVec);
     }
 
-/*! This function sets appropriate active forces and torques on all active particles.
- */
-template<class Manifold> void ActiveForceConstraintComputeGPU<Manifold>::setForces()
+/*! This function applies the scheduled rotational diffusion and the manifold constraint, and sets
+    appropriate active forces and torques on all active particles.
+    \param timestep Current timestep
+*/
+template<class Manifold>
+void ActiveForceConstraintComputeGPU<Manifold>::computeForces(uint64_t timestep)
     {
+    if (this->m_prof)
+        this->m_prof->push(this->m_exec_conf, "ActiveForceConstraintCompute");
+
+    if (this->m_box_changed)
+        {
+        if (!this->m_manifold.fitsInsideBox(this->m_pdata->getGlobalBox()))
+            {
+            throw std::runtime_error("Parts of the manifold are outside the box");
+            }
+        this->m_box_changed = false;
+        }
+
     //  array handles
     ArrayHandle<Scalar4> d_f_actVec(this->m_f_activeVec,
                                     access_location::device,
@@ -156,10 +163,13 @@ template<class Manifold> void ActiveForceConstraintComputeGPU<Manifold>::setForc
                                access_mode::read);
     ArrayHandle<Scalar4> d_orientation(this->m_pdata->getOrientationArray(),
                                        access_location::device,
-                                       access_mode::read);
+                                       access_mode::readwrite);
     ArrayHandle<unsigned int> d_index_array(this->m_group->getIndexArray(),
                                             access_location::device,
                                             access_mode::read);
+    ArrayHandle<unsigned int> d_tag(this->m_pdata->getTags(),
+                                    access_location::device,
+                                    access_mode::read);
 
     // sanity check
     assert(d_force.data != NULL);
@@ -171,23 +181,37 @@ template<class Manifold> void ActiveForceConstraintComputeGPU<Manifold>::setForc
     unsigned int group_size = this->m_group->getNumMembers();
     unsigned int N = this->m_pdata->getN();
 
+    const Scalar rotation_constant
+        = slow::sqrt(2.0 * this->m_scheduled_diffusion * this->m_deltaT);
+
     // compute the forces on the GPU
     this->m_tuner_force->begin();
-    gpu_compute_active_force_set_forces(group_size,
-                                        d_index_array.data,
-                                        d_force.data,
-                                        d_torque.data,
-                                        d_pos.data,
-                                        d_orientation.data,
-                                        d_f_actVec.data,
-                                        d_t_actVec.data,
-                                        N,
-                                        this->m_tuner_force->getParam());
+    gpu_compute_active_force_constraint_set_forces<Manifold>(
+        group_size,
+        d_index_array.data,
+        d_force.data,
+        d_torque.data,
+        d_pos.data,
+        d_orientation.data,
+        d_f_actVec.data,
+        d_t_actVec.data,
+        N,
+        this->m_manifold,
+        d_tag.data,
+        this->m_diffusion_scheduled,
+        rotation_constant,
+        this->m_scheduled_diffusion_timestep,
+        this->m_sysdef->getSeed(),
+        this->m_tuner_force->getParam());
 
     if (this->m_exec_conf->isCUDAErrorCheckingEnabled())
         CHECK_CUDA_ERROR();
 
     this->m_tuner_force->end();
+    this->m_diffusion_scheduled = false;
+
+    if (this->m_prof)
+        this->m_prof->pop(this->m_exec_conf);
     }
 
 /*! This function applies rotational diffusion to all active particles. The angle between the torque
@@ -241,45 +265,6 @@ void ActiveForceConstraintComputeGPU<Manifold>::rotationalDiffusion(Scalar rotat
     this->m_tuner_diffusion->end();
     }
 
-/*! This function sets an ellipsoid surface constraint for all active particles
- */
-template<class Manifold> void ActiveForceConstraintComputeGPU<Manifold>::setConstraint()
-    {
-    //  array handles
-    ArrayHandle<Scalar4> d_f_actVec(this->m_f_activeVec,
-                                    access_location::device,
-                                    access_mode::readwrite);
-    ArrayHandle<Scalar4> d_pos(this->m_pdata->getPositions(),
-                               access_location::device,
-                               access_mode::read);
-    ArrayHandle<Scalar4> d_orientation(this->m_pdata->getOrientationArray(),
-                                       access_location::device,
-                                       access_mode::readwrite);
-    ArrayHandle<unsigned int> d_index_array(this->m_group->getIndexArray(),
-                                            access_location::device,
-                                            access_mode::read);
-
-    assert(d_pos.data != NULL);
-
-    unsigned int group_size = this->m_group->getNumMembers();
-
-    // perform the update on the GPU
-    this->m_tuner_constraint->begin();
-
-    gpu_compute_active_force_set_constraints<Manifold>(group_size,
-                                                       d_index_array.data,
-                                                       d_pos.data,
-                                                       d_orientation.data,
-                                                       d_f_actVec.data,
-                                                       this->m_manifold,
-                                                       this->m_tuner_constraint->getParam());
-
-    if (this->m_exec_conf->isCUDAErrorCheckingEnabled())
-        CHECK_CUDA_ERROR();
-
-    this->m_tuner_constraint->end();
-    }
-
 template<class Manifold>
 void export_ActiveForceConstraintComputeGPU(py::module& m, const std::string& name)
     {
@@ -39,7 +39,8 @@ ActiveRotationalDiffusionUpdater::~ActiveRotationalDiffusionUpdater()
 */
 void ActiveRotationalDiffusionUpdater::update(uint64_t timestep)
     {
-    m_active_force->rotationalDiffusion(m_rotational_diffusion->operator()(timestep), timestep);
+    m_active_force->scheduleRotationalDiffusion(m_rotational_diffusion->operator()(timestep),
+                                                timestep);
     }
 
 void export_ActiveRotationalDiffusionUpdater(py::module& m)
@@ -20,7 +20,8 @@
 
 /// Updates particle's orientations based on a given diffusion constant.
 /** The updater accepts a variant rotational diffusion and updates the particle orientations of the
- * associated ActiveForceCompute's group (by calling m_active_force.rotationalDiffusion).
+ * associated ActiveForceCompute's group (by calling m_active_force.scheduleRotationalDiffusion).
+ * The active force applies the rotation when it next computes the forces in the same step.
  *
  * Note: This was originally part of the ActiveForceCompute, and is separated to obey the idea that
  * force computes do not update the system directly, but updaters do. See GitHub issue (898). The
@@ -7,6 +7,7 @@
 #define __ALL_EXTERNAL_POTENTIALS__H__
 
 #include "AllPairPotentials.h"
+#include "EvaluatorExternalComposite.h"
 #include "EvaluatorExternalElectricField.h"
 #include "EvaluatorExternalPeriodic.h"
 #include "EvaluatorWalls.h"
@@ -29,6 +30,12 @@ typedef PotentialExternal<EvaluatorExternalPeriodic> PotentialExternalPeriodic;
 
 //! Electric field
 typedef PotentialExternal<EvaluatorExternalElectricField> PotentialExternalElectricField;
+
+//! Periodic and electric fields evaluated together
+typedef PotentialExternal<
+    EvaluatorExternalComposite<EvaluatorExternalPeriodic, EvaluatorExternalElectricField>>
+    PotentialExternalPeriodicElectric;
+
 typedef PotentialExternal<EvaluatorWalls<EvaluatorPairLJ>> WallsPotentialLJ;
 typedef PotentialExternal<EvaluatorWalls<EvaluatorPairSLJ>> WallsPotentialSLJ;
 typedef PotentialExternal<EvaluatorWalls<EvaluatorPairExpandedMie>> WallsPotentialExpandedMie;
@@ -42,6 +49,9 @@ typedef PotentialExternal<EvaluatorWalls<EvaluatorPairMorse>> WallsPotentialMors
 //! External potential to impose periodic structure on the GPU
 typedef PotentialExternalGPU<EvaluatorExternalPeriodic> PotentialExternalPeriodicGPU;
 typedef PotentialExternalGPU<EvaluatorExternalElectricField> PotentialExternalElectricFieldGPU;
+typedef PotentialExternalGPU<
+    EvaluatorExternalComposite<EvaluatorExternalPeriodic, EvaluatorExternalElectricField>>
+    PotentialExternalPeriodicElectricGPU;
 typedef PotentialExternalGPU<EvaluatorWalls<EvaluatorPairLJ>> WallsPotentialLJGPU;
 typedef PotentialExternalGPU<EvaluatorWalls<EvaluatorPairSLJ>> WallsPotentialSLJGPU;
 typedef PotentialExternalGPU<EvaluatorWalls<EvaluatorPairExpandedMie>> WallsPotentialExpandedMieGPU;
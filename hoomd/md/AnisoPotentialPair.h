@@ -22,6 +22,11 @@
 #include "hoomd/ManagedArray.h"
 #include "hoomd/VectorMath.h"
 
+#ifdef ENABLE_TBB
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#endif
+
 /*! \file AnisoPotentialPair.h
     \brief Defines the template class for anisotropic pair potentials
     \details The heart of the code that computes anisotropic pair potentials is in this file.
@@ -225,8 +230,43 @@ template<class aniso_evaluator> class AnisoPotentialPair : public ForceCompute
     /// r_cut (not squared) given to the neighbor list
     std::shared_ptr<GlobalArray<Scalar>> m_r_cut_nlist;
 
+    /// Space frame vector of each local and ghost particle (aniso_evaluator::cacheOrientation)
+    GlobalArray<Scalar4> m_orientation_cache;
+
+    //! Host pointers and flags shared by all ranges of the CPU force loop
+    struct ForceLoopArgs
+        {
+        const unsigned int* n_neigh;      //!< Number of neighbors of each particle
+        const unsigned int* nlist;        //!< Neighbor list
+        const unsigned int* head_list;    //!< Index of the first neighbor of each particle
+        const Scalar4* pos;               //!< Particle positions and types
+        const Scalar* diameter;           //!< Particle diameters
+        const Scalar* charge;             //!< Particle charges
+        const Scalar4* orientation;       //!< Particle orientations
+        const Scalar4* orientation_cache; //!< Cached space frame vectors (may be NULL)
+        const unsigned int* tag;          //!< Particle tags
+        const Scalar* rcutsq;             //!< Cutoff radius squared per type pair
+        const param_type* params;         //!< Parameters per type pair
+        const shape_type* shape_params;   //!< Shape parameters per type
+        BoxDim box;                       //!< Local simulation box
+        bool third_law;                   //!< True when the neighbor list stores each pair once
+        bool compute_virial;              //!< True when the virial is needed
+        };
+
     //! Actually compute the forces
     virtual void computeForces(uint64_t timestep);
+
+    //! Grow the orientation cache to hold all local and ghost particles
+    void allocateOrientationCache();
+
+    //! Compute the forces and torques on a range of local particles
+    void computeForcesRange(unsigned int begin,
+                            unsigned int end,
+                            const ForceLoopArgs& args,
+                            Scalar4* force,
+                            Scalar4* torque,
+                            Scalar* virial,
+                            size_t virial_pitch);
     };
 
 template<class aniso_evaluator>
@@ -476,6 +516,14 @@ Scalar AnisoPotentialPair<aniso_evaluator>::getRCut(pybind11::tuple types)
    called to ensure that it is up to date before proceeding.
 
     \param timestep specifies the current time step of the simulation
+
+    When HOOMD is built with TBB, the loop over particles is split among the threads of the
+   execution configuration's task arena. With a full neighbor list, each thread writes only the
+   forces and torques of the particles it owns. With a half neighbor list, the reactions on the
+   neighbors are accumulated in per-thread arrays and summed after the loop.
+
+    Evaluators that return true from needsOrientationCache() get the space frame vector of each
+   particle from m_orientation_cache, which is filled once before the loop.
 */
 template<class aniso_evaluator>
 void AnisoPotentialPair<aniso_evaluator>::computeForces(uint64_t timestep)
@@ -487,10 +535,6 @@ void AnisoPotentialPair<aniso_evaluator>::computeForces(uint64_t timestep)
     if (m_prof)
         m_prof->push(m_prof_name);
 
-    // depending on the neighborlist settings, we can take advantage of newton's third law
-    // to reduce computations at the cost of memory access complexity: set that flag now
-    bool third_law = m_nlist->getStorageMode() == NeighborList::half;
-
     // access the neighbor list, particle data, and system box
     ArrayHandle<unsigned int> h_n_neigh(m_nlist->getNNeighArray(),
                                         access_location::host,
@@ -517,186 +561,310 @@ void AnisoPotentialPair<aniso_evaluator>::computeForces(uint64_t timestep)
     ArrayHandle<Scalar4> h_torque(m_torque, access_location::host, access_mode::overwrite);
     ArrayHandle<Scalar> h_virial(m_virial, access_location::host, access_mode::overwrite);
 
-    const BoxDim& box = m_pdata->getBox();
     ArrayHandle<Scalar> h_rcutsq(m_rcutsq, access_location::host, access_mode::read);
     ArrayHandle<param_type> h_params(m_params, access_location::host, access_mode::read);
     ArrayHandle<shape_type> h_shape_params(m_shape_params,
                                            access_location::host,
                                            access_mode::read);
 
+    PDataFlags flags = this->m_pdata->getFlags();
+
+    // convert each orientation once per step instead of once per pair
+    std::unique_ptr<ArrayHandle<Scalar4>> h_orientation_cache;
+    if (aniso_evaluator::needsOrientationCache())
         {
-        // need to start from a zero force, energy and virial
-        memset(&h_force.data[0], 0, sizeof(Scalar4) * m_pdata->getN());
-        memset(&h_torque.data[0], 0, sizeof(Scalar4) * m_pdata->getN());
-        memset(&h_virial.data[0], 0, sizeof(Scalar) * m_virial.getNumElements());
+        allocateOrientationCache();
+        h_orientation_cache.reset(new ArrayHandle<Scalar4>(m_orientation_cache,
+                                                           access_location::host,
+                                                           access_mode::overwrite));
+        for (unsigned int i = 0; i < m_pdata->getN() + m_pdata->getNGhosts(); i++)
+            {
+            unsigned int typei = __scalar_as_int(h_pos.data[i].w);
+            Scalar3 c = aniso_evaluator::cacheOrientation(h_orientation.data[i],
+                                                          h_shape_params.data[typei]);
+            h_orientation_cache->data[i] = make_scalar4(c.x, c.y, c.z, Scalar(0.0));
+            }
+        }
 
-        PDataFlags flags = this->m_pdata->getFlags();
-        bool compute_virial = flags[pdata_flag::pressure_tensor];
+    ForceLoopArgs args;
+    args.n_neigh = h_n_neigh.data;
+    args.nlist = h_nlist.data;
+    args.head_list = h_head_list.data;
+    args.pos = h_pos.data;
+    args.diameter = h_diameter.data;
+    args.charge = h_charge.data;
+    args.orientation = h_orientation.data;
+    args.orientation_cache = h_orientation_cache ? h_orientation_cache->data : NULL;
+    args.tag = h_tag.data;
+    args.rcutsq = h_rcutsq.data;
+    args.params = h_params.data;
+    args.shape_params = h_shape_params.data;
+    args.box = m_pdata->getBox();
+    // depending on the neighborlist settings, we can take advantage of newton's third law
+    // to reduce computations at the cost of memory access complexity: set that flag now
+    args.third_law = m_nlist->getStorageMode() == NeighborList::half;
+    args.compute_virial = flags[pdata_flag::pressure_tensor];
+
+    // need to start from a zero force, torque, energy and virial, including the reactions on ghosts
+    memset((void*)h_force.data, 0, sizeof(Scalar4) * m_force.getNumElements());
+    memset((void*)h_torque.data, 0, sizeof(Scalar4) * m_torque.getNumElements());
+    memset((void*)h_virial.data, 0, sizeof(Scalar) * m_virial.getNumElements());
 
-        // for each particle
-        for (int i = 0; i < (int)m_pdata->getN(); i++)
+    bool computed = false;
+#ifdef ENABLE_TBB
+    if (!args.third_law)
+        {
+        // each particle only writes its own force and torque: no synchronization is needed
+        m_exec_conf->getTaskArena()->execute(
+            [&]
             {
-            // access the particle's position and type (MEM TRANSFER: 4 scalars)
-            Scalar3 pi = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
-            unsigned int typei = __scalar_as_int(h_pos.data[i].w);
-            Scalar4 quat_i = h_orientation.data[i];
+                tbb::parallel_for(tbb::blocked_range<unsigned int>(0, m_pdata->getN()),
+                                  [&](const tbb::blocked_range<unsigned int>& r)
+                                  {
+                                      computeForcesRange(r.begin(),
+                                                         r.end(),
+                                                         args,
+                                                         h_force.data,
+                                                         h_torque.data,
+                                                         h_virial.data,
+                                                         m_virial_pitch);
+                                  });
+            });
+        computed = true;
+        }
+#endif
+
+    if (!computed)
+        {
+        // reactions on the neighbors are accumulated per thread
+        scatterForcesAndTorques(0,
+                                m_pdata->getN(),
+                                args.compute_virial,
+                                h_force.data,
+                                h_torque.data,
+                                h_virial.data,
+                                [&](unsigned int r_begin,
+                                    unsigned int r_end,
+                                    Scalar4* force,
+                                    Scalar4* torque,
+                                    Scalar* virial,
+                                    size_t virial_pitch) {
+                                    computeForcesRange(r_begin,
+                                                       r_end,
+                                                       args,
+                                                       force,
+                                                       torque,
+                                                       virial,
+                                                       virial_pitch);
+                                });
+        }
+
+    if (m_prof)
+        m_prof->pop();
+    }
+
+/*! The cache is sized to the particle data arrays so that it covers the ghost particles.
+ */
+template<class aniso_evaluator>
+void AnisoPotentialPair<aniso_evaluator>::allocateOrientationCache()
+    {
+    if (m_orientation_cache.getNumElements() < m_pdata->getMaxN())
+        {
+        GlobalArray<Scalar4> orientation_cache(m_pdata->getMaxN(), m_exec_conf);
+        m_orientation_cache.swap(orientation_cache);
+        }
+    }
 
-            // sanity check
-            assert(typei < m_pdata->getNTypes());
+/*! \param begin First local particle to compute
+    \param end One past the last local particle to compute
+    \param args Host pointers and flags for the force loop
+    \param force Force array to accumulate into
+    \param torque Torque array to accumulate into
+    \param virial Virial array to accumulate into
+    \param virial_pitch Pitch of \a virial
+
+    Forces and torques on the particles [begin, end) are added to \a force, \a torque and \a virial.
+   When the neighbor list uses half storage, the reactions on the neighbors j are also added, so
+   concurrent callers must pass separate arrays.
+*/
+template<class aniso_evaluator>
+void AnisoPotentialPair<aniso_evaluator>::computeForcesRange(unsigned int begin,
+                                                             unsigned int end,
+                                                             const ForceLoopArgs& args,
+                                                             Scalar4* force,
+                                                             Scalar4* torque,
+                                                             Scalar* virial,
+                                                             size_t virial_pitch)
+    {
+    const BoxDim& box = args.box;
+    const bool third_law = args.third_law;
+    const bool compute_virial = args.compute_virial;
+
+    // design specifies that energies are shifted if
+    // shift mode is set to shift
+    const bool energy_shift = m_shift_mode == shift;
+
+    // for each particle
+    for (unsigned int i = begin; i < end; i++)
+        {
+        // access the particle's position and type (MEM TRANSFER: 4 scalars)
+        Scalar3 pi = make_scalar3(args.pos[i].x, args.pos[i].y, args.pos[i].z);
+        unsigned int typei = __scalar_as_int(args.pos[i].w);
+        Scalar4 quat_i = args.orientation[i];
+
+        // sanity check
+        assert(typei < m_pdata->getNTypes());
+
+        // access diameter and charge (if needed)
+        Scalar di = Scalar(0.0);
+        Scalar qi = Scalar(0.0);
+        if (aniso_evaluator::needsDiameter())
+            di = args.diameter[i];
+        if (aniso_evaluator::needsCharge())
+            qi = args.charge[i];
+
+        // initialize current particle force, torque, potential energy, and virial to 0
+        Scalar fxi = Scalar(0.0);
+        Scalar fyi = Scalar(0.0);
+        Scalar fzi = Scalar(0.0);
+        Scalar txi = Scalar(0.0);
+        Scalar tyi = Scalar(0.0);
+        Scalar tzi = Scalar(0.0);
+        Scalar pei = Scalar(0.0);
+        Scalar virialxxi = 0.0;
+        Scalar virialxyi = 0.0;
+        Scalar virialxzi = 0.0;
+        Scalar virialyyi = 0.0;
+        Scalar virialyzi = 0.0;
+        Scalar virialzzi = 0.0;
+
+        // loop over all of the neighbors of this particle
+        const unsigned int myHead = args.head_list[i];
+        const unsigned int size = (unsigned int)args.n_neigh[i];
+        for (unsigned int k = 0; k < size; k++)
+            {
+            // access the index of this neighbor (MEM TRANSFER: 1 scalar)
+            unsigned int j = args.nlist[myHead + k];
+            assert(j < m_pdata->getN() + m_pdata->getNGhosts());
+
+            // calculate dr_ji (MEM TRANSFER: 3 scalars / FLOPS: 3)
+            Scalar3 pj = make_scalar3(args.pos[j].x, args.pos[j].y, args.pos[j].z);
+            Scalar3 dx = pi - pj;
+            Scalar4 quat_j = args.orientation[j];
+
+            // access the type of the neighbor particle (MEM TRANSFER: 1 scalar)
+            unsigned int typej = __scalar_as_int(args.pos[j].w);
+            assert(typej < m_pdata->getNTypes());
 
             // access diameter and charge (if needed)
-            Scalar di = Scalar(0.0);
-            Scalar qi = Scalar(0.0);
+            Scalar dj = Scalar(0.0);
+            Scalar qj = Scalar(0.0);
+            if (aniso_evaluator::needsDiameter())
+                dj = args.diameter[j];
+            if (aniso_evaluator::needsCharge())
+                qj = args.charge[j];
+
+            // apply periodic boundary conditions
+            dx = box.minImage(dx);
+
+            // get parameters for this type pair
+            unsigned int typpair_idx = m_typpair_idx(typei, typej);
+            const param_type& param = args.params[typpair_idx];
+            Scalar rcutsq = args.rcutsq[typpair_idx];
+
+            // compute the force and potential energy
+            Scalar3 f = make_scalar3(0.0, 0.0, 0.0);
+            Scalar3 torque_i = make_scalar3(0.0, 0.0, 0.0);
+            Scalar3 torque_j = make_scalar3(0.0, 0.0, 0.0);
+
+            Scalar pair_eng = Scalar(0.0);
+
+            aniso_evaluator eval(dx, quat_i, quat_j, rcutsq, param);
+
             if (aniso_evaluator::needsDiameter())
-                di = h_diameter.data[i];
+                eval.setDiameter(di, dj);
             if (aniso_evaluator::needsCharge())
-                qi = h_charge.data[i];
-
-            // initialize current particle force, torque, potential energy, and virial to 0
-            Scalar fxi = Scalar(0.0);
-            Scalar fyi = Scalar(0.0);
-            Scalar fzi = Scalar(0.0);
-            Scalar txi = Scalar(0.0);
-            Scalar tyi = Scalar(0.0);
-            Scalar tzi = Scalar(0.0);
-            Scalar pei = Scalar(0.0);
-            Scalar virialxxi = 0.0;
-            Scalar virialxyi = 0.0;
-            Scalar virialxzi = 0.0;
-            Scalar virialyyi = 0.0;
-            Scalar virialyzi = 0.0;
-            Scalar virialzzi = 0.0;
-
-            // loop over all of the neighbors of this particle
-            const unsigned int myHead = h_head_list.data[i];
-            const unsigned int size = (unsigned int)h_n_neigh.data[i];
-            for (unsigned int k = 0; k < size; k++)
+                eval.setCharge(qi, qj);
+            if (aniso_evaluator::needsShape())
+                eval.setShape(&args.shape_params[typei], &args.shape_params[typej]);
+            if (aniso_evaluator::needsTags())
+                eval.setTags(args.tag[i], args.tag[j]);
+            if (args.orientation_cache)
+                eval.setOrientationCache(make_scalar3(args.orientation_cache[i].x,
+                                                      args.orientation_cache[i].y,
+                                                      args.orientation_cache[i].z),
+                                         make_scalar3(args.orientation_cache[j].x,
+                                                      args.orientation_cache[j].y,
+                                                      args.orientation_cache[j].z));
+
+            bool evaluated = eval.evaluate(f, pair_eng, energy_shift, torque_i, torque_j);
+
+            if (evaluated)
                 {
-                // access the index of this neighbor (MEM TRANSFER: 1 scalar)
-                unsigned int j = h_nlist.data[myHead + k];
-                assert(j < m_pdata->getN() + m_pdata->getNGhosts());
-
-                // calculate dr_ji (MEM TRANSFER: 3 scalars / FLOPS: 3)
-                Scalar3 pj = make_scalar3(h_pos.data[j].x, h_pos.data[j].y, h_pos.data[j].z);
-                Scalar3 dx = pi - pj;
-                Scalar4 quat_j = h_orientation.data[j];
-
-                // access the type of the neighbor particle (MEM TRANSFER: 1 scalar)
-                unsigned int typej = __scalar_as_int(h_pos.data[j].w);
-                assert(typej < m_pdata->getNTypes());
-
-                // access diameter and charge (if needed)
-                Scalar dj = Scalar(0.0);
-                Scalar qj = Scalar(0.0);
-                if (aniso_evaluator::needsDiameter())
-                    dj = h_diameter.data[j];
-                if (aniso_evaluator::needsCharge())
-                    qj = h_charge.data[j];
-
-                // apply periodic boundary conditions
-                dx = box.minImage(dx);
-
-                // get parameters for this type pair
-                unsigned int typpair_idx = m_typpair_idx(typei, typej);
-                param_type param = h_params.data[typpair_idx];
-                Scalar rcutsq = h_rcutsq.data[typpair_idx];
-
-                // design specifies that energies are shifted if
-                // shift mode is set to shift
-                bool energy_shift = false;
-                if (m_shift_mode == shift)
-                    energy_shift = true;
-
-                // compute the force and potential energy
-                Scalar3 force = make_scalar3(0.0, 0.0, 0.0);
-                Scalar3 torque_i = make_scalar3(0.0, 0.0, 0.0);
-                Scalar3 torque_j = make_scalar3(0.0, 0.0, 0.0);
-
-                Scalar pair_eng = Scalar(0.0);
-
-                aniso_evaluator eval(dx, quat_i, quat_j, rcutsq, param);
-
-                if (aniso_evaluator::needsDiameter())
-                    eval.setDiameter(di, dj);
-                if (aniso_evaluator::needsCharge())
-                    eval.setCharge(qi, qj);
-                if (aniso_evaluator::needsShape())
-                    eval.setShape(&h_shape_params.data[typei], &h_shape_params.data[typej]);
-                if (aniso_evaluator::needsTags())
-                    eval.setTags(h_tag.data[i], h_tag.data[j]);
-
-                bool evaluated = eval.evaluate(force, pair_eng, energy_shift, torque_i, torque_j);
-
-                if (evaluated)
+                Scalar3 force2 = Scalar(0.5) * f;
+
+                // add the force, potential energy and virial to the particle i
+                // (FLOPS: 8)
+                fxi += f.x;
+                fyi += f.y;
+                fzi += f.z;
+                txi += torque_i.x;
+                tyi += torque_i.y;
+                tzi += torque_i.z;
+                pei += pair_eng * Scalar(0.5);
+
+                if (compute_virial)
                     {
-                    Scalar3 force2 = Scalar(0.5) * force;
-
-                    // add the force, potential energy and virial to the particle i
-                    // (FLOPS: 8)
-                    fxi += force.x;
-                    fyi += force.y;
-                    fzi += force.z;
-                    txi += torque_i.x;
-                    tyi += torque_i.y;
-                    tzi += torque_i.z;
-                    pei += pair_eng * Scalar(0.5);
+                    virialxxi += dx.x * force2.x;
+                    virialxyi += dx.y * force2.x;
+                    virialxzi += dx.z * force2.x;
+                    virialyyi += dx.y * force2.y;
+                    virialyzi += dx.z * force2.y;
+                    virialzzi += dx.z * force2.z;
+                    }
 
+                // add the force to particle j if we are using the third law (MEM TRANSFER: 10
+                // scalars / FLOPS: 8)
+                if (third_law)
+                    {
+                    force[j].x -= f.x;
+                    force[j].y -= f.y;
+                    force[j].z -= f.z;
+                    torque[j].x += torque_j.x;
+                    torque[j].y += torque_j.y;
+                    torque[j].z += torque_j.z;
+                    force[j].w += pair_eng * Scalar(0.5);
                     if (compute_virial)
                         {
-                        virialxxi += dx.x * force2.x;
-                        virialxyi += dx.y * force2.x;
-                        virialxzi += dx.z * force2.x;
-                        virialyyi += dx.y * force2.y;
-                        virialyzi += dx.z * force2.y;
-                        virialzzi += dx.z * force2.z;
-                        }
-
-                    // add the force to particle j if we are using the third law (MEM TRANSFER: 10
-                    // scalars / FLOPS: 8)
-                    if (third_law)
-                        {
-                        h_force.data[j].x -= force.x;
-                        h_force.data[j].y -= force.y;
-                        h_force.data[j].z -= force.z;
-                        h_torque.data[j].x += torque_j.x;
-                        h_torque.data[j].y += torque_j.y;
-                        h_torque.data[j].z += torque_j.z;
-                        h_force.data[j].w += pair_eng * Scalar(0.5);
-                        if (compute_virial)
-                            {
-                            h_virial.data[0 * m_virial_pitch + j] += dx.x * force2.x;
-                            h_virial.data[1 * m_virial_pitch + j] += dx.y * force2.x;
-                            h_virial.data[2 * m_virial_pitch + j] += dx.z * force2.x;
-                            h_virial.data[3 * m_virial_pitch + j] += dx.y * force2.y;
-                            h_virial.data[4 * m_virial_pitch + j] += dx.z * force2.y;
-                            h_virial.data[5 * m_virial_pitch + j] += dx.z * force2.z;
-                            }
+                        virial[0 * virial_pitch + j] += dx.x * force2.x;
+                        virial[1 * virial_pitch + j] += dx.y * force2.x;
+                        virial[2 * virial_pitch + j] += dx.z * force2.x;
+                        virial[3 * virial_pitch + j] += dx.y * force2.y;
+                        virial[4 * virial_pitch + j] += dx.z * force2.y;
+                        virial[5 * virial_pitch + j] += dx.z * force2.z;
                         }
                     }
                 }
+            }
 
-            // finally, increment the force, potential energy and virial for particle i
-            h_force.data[i].x += fxi;
-            h_force.data[i].y += fyi;
-            h_force.data[i].z += fzi;
-            h_torque.data[i].x += txi;
-            h_torque.data[i].y += tyi;
-            h_torque.data[i].z += tzi;
-            h_force.data[i].w += pei;
-            if (compute_virial)
-                {
-                h_virial.data[0 * m_virial_pitch + i] += virialxxi;
-                h_virial.data[1 * m_virial_pitch + i] += virialxyi;
-                h_virial.data[2 * m_virial_pitch + i] += virialxzi;
-                h_virial.data[3 * m_virial_pitch + i] += virialyyi;
-                h_virial.data[4 * m_virial_pitch + i] += virialyzi;
-                h_virial.data[5 * m_virial_pitch + i] += virialzzi;
-                }
+        // finally, increment the force, potential energy and virial for particle i
+        force[i].x += fxi;
+        force[i].y += fyi;
+        force[i].z += fzi;
+        torque[i].x += txi;
+        torque[i].y += tyi;
+        torque[i].z += tzi;
+        force[i].w += pei;
+        if (compute_virial)
+            {
+            virial[0 * virial_pitch + i] += virialxxi;
+            virial[1 * virial_pitch + i] += virialxyi;
+            virial[2 * virial_pitch + i] += virialxzi;
+            virial[3 * virial_pitch + i] += virialyyi;
+            virial[4 * virial_pitch + i] += virialyzi;
+            virial[5 * virial_pitch + i] += virialzzi;
             }
         }
-
-    if (m_prof)
-        m_prof->pop();
     }
 
 #ifdef ENABLE_MPI
@@ -64,7 +64,8 @@ struct a_pair_args_t
           d_nlist(_d_nlist), d_head_list(_d_head_list), d_rcutsq(_d_rcutsq), ntypes(_ntypes),
           block_size(_block_size), shift_mode(_shift_mode), compute_virial(_compute_virial),
           threads_per_particle(_threads_per_particle), gpu_partition(_gpu_partition),
-          devprop(_devprop), update_shape_param(_update_shape_param) {};
+          devprop(_devprop), update_shape_param(_update_shape_param), d_orientation_cache(NULL),
+          n_cache(0) {};
 
     Scalar4* d_force;             //!< Force to write out
     Scalar4* d_torque;            //!< Torque to write out
@@ -93,10 +94,40 @@ struct a_pair_args_t
     const hipDeviceProp_t& devprop;    //!< CUDA device properties
     bool update_shape_param; //!< If true, update size of shape param and synchronize GPU execution
                              //!< stream
+    Scalar4* d_orientation_cache; //!< Space frame vector of each particle (evaluator opt-in)
+    unsigned int n_cache;         //!< Number of local and ghost particles to cache
     };
 
 #ifdef __HIPCC__
 
+//! Kernel for caching the space frame vector of each particle
+/*! \param d_orientation_cache Device memory to write the cached vectors
+    \param N Number of local and ghost particles
+    \param d_pos particle positions
+    \param d_orientation particle orientations
+    \param d_shape_params Shape parameters per type
+
+    Each thread converts the orientation of one particle with evaluator::cacheOrientation(), so the
+   pair kernel reads one vector per neighbor instead of rotating by its quaternion.
+*/
+template<class evaluator>
+__global__ void
+gpu_compute_aniso_orientation_cache_kernel(Scalar4* d_orientation_cache,
+                                           const unsigned int N,
+                                           const Scalar4* d_pos,
+                                           const Scalar4* d_orientation,
+                                           const typename evaluator::shape_type* d_shape_params)
+    {
+    unsigned int idx = blockIdx.x * blockDim.x + threadIdx.x;
+    if (idx >= N)
+        return;
+
+    Scalar4 postype = __ldg(d_pos + idx);
+    Scalar3 c = evaluator::cacheOrientation(__ldg(d_orientation + idx),
+                                            d_shape_params[__scalar_as_int(postype.w)]);
+    d_orientation_cache[idx] = make_scalar4(c.x, c.y, c.z, Scalar(0.0));
+    }
+
 //! Kernel for calculating pair forces
 /*! This kernel is called to calculate the pair forces on all N particles. Actual evaluation of the
    potentials and forces for each pair is handled via the template class \a evaluator.
@@ -110,6 +141,8 @@ struct a_pair_args_t
     \param d_diameter particle diameters
     \param d_charge particle charges
     \param d_orientation Quaternion data on the GPU to calculate forces on
+    \param d_orientation_cache Space frame vector of each particle, read instead of \a
+   d_orientation when evaluator::needsOrientationCache() is true
     \param d_tag Tag data on the GPU to calculate forces on
     \param box Box dimensions used to implement periodic boundary conditions
     \param d_n_neigh Device memory array listing the number of neighbors for each particle
@@ -148,6 +181,7 @@ gpu_compute_pair_aniso_forces_kernel(Scalar4* d_force,
                                      const Scalar* d_diameter,
                                      const Scalar* d_charge,
                                      const Scalar4* d_orientation,
+                                     const Scalar4* d_orientation_cache,
                                      const unsigned int* d_tag,
                                      const BoxDim box,
                                      const unsigned int* d_n_neigh,
@@ -242,7 +276,12 @@ gpu_compute_pair_aniso_forces_kernel(Scalar4* d_force,
         // read in the position of our particle
         Scalar4 postypei = __ldg(d_pos + idx);
         Scalar3 posi = make_scalar3(postypei.x, postypei.y, postypei.z);
-        Scalar4 quati = __ldg(d_orientation + idx);
+        Scalar4 quati = make_scalar4(Scalar(1.0), Scalar(0.0), Scalar(0.0), Scalar(0.0));
+        Scalar4 cachei = make_scalar4(Scalar(0.0), Scalar(0.0), Scalar(0.0), Scalar(0.0));
+        if (evaluator::needsOrientationCache())
+            cachei = __ldg(d_orientation_cache + idx);
+        else
+            quati = __ldg(d_orientation + idx);
 
         Scalar di = Scalar(0);
         if (evaluator::needsDiameter())
@@ -273,7 +312,12 @@ gpu_compute_pair_aniso_forces_kernel(Scalar4* d_force,
                 // get the neighbor's position
                 Scalar4 postypej = __ldg(d_pos + cur_j);
                 Scalar3 posj = make_scalar3(postypej.x, postypej.y, postypej.z);
-                Scalar4 quatj = __ldg(d_orientation + cur_j);
+                Scalar4 quatj = make_scalar4(Scalar(1.0), Scalar(0.0), Scalar(0.0), Scalar(0.0));
+                Scalar4 cachej = make_scalar4(Scalar(0.0), Scalar(0.0), Scalar(0.0), Scalar(0.0));
+                if (evaluator::needsOrientationCache())
+                    cachej = __ldg(d_orientation_cache + cur_j);
+                else
+                    quatj = __ldg(d_orientation + cur_j);
 
                 Scalar dj = Scalar(0);
                 if (evaluator::needsDiameter())
@@ -321,6 +365,9 @@ gpu_compute_pair_aniso_forces_kernel(Scalar4* d_force,
                                   &(s_shape_params[__scalar_as_int(postypej.w)]));
                 if (evaluator::needsTags())
                     eval.setTags(__ldg(d_tag + idx), __ldg(d_tag + cur_j));
+                if (evaluator::needsOrientationCache())
+                    eval.setOrientationCache(make_scalar3(cachei.x, cachei.y, cachei.z),
+                                             make_scalar3(cachej.x, cachej.y, cachej.z));
 
                 // call evaluator
                 eval.evaluate(jforce, pair_eng, energy_shift, torquei, torquej);
@@ -493,6 +540,7 @@ struct AnisoPairForceComputeKernel
                 pair_args.d_diameter,
                 pair_args.d_charge,
                 pair_args.d_orientation,
+                pair_args.d_orientation_cache,
                 pair_args.d_tag,
                 pair_args.box,
                 pair_args.d_n_neigh,
@@ -544,6 +592,27 @@ hipError_t gpu_compute_pair_aniso_forces(const a_pair_args_t& pair_args,
     assert(pair_args.d_rcutsq);
     assert(pair_args.ntypes > 0);
 
+    if (evaluator::needsOrientationCache())
+        {
+        // the cache covers the neighbors of all GPUs, fill it on the current device first
+        assert(pair_args.d_orientation_cache);
+        unsigned int block_size = 256;
+        unsigned int n_blocks = pair_args.n_cache / block_size + 1;
+        hipLaunchKernelGGL((gpu_compute_aniso_orientation_cache_kernel<evaluator>),
+                           dim3(n_blocks),
+                           dim3(block_size),
+                           0,
+                           0,
+                           pair_args.d_orientation_cache,
+                           pair_args.n_cache,
+                           pair_args.d_pos,
+                           pair_args.d_orientation,
+                           d_shape_params);
+
+        if (pair_args.gpu_partition.getNumActiveGPUs() > 1)
+            hipDeviceSynchronize();
+        }
+
     // iterate over active GPUs in reverse, to end up on first GPU when returning from this function
     for (int idev = pair_args.gpu_partition.getNumActiveGPUs() - 1; idev >= 0; --idev)
         {
@@ -97,7 +97,7 @@ AnisoPotentialPairGPU<evaluator, gpu_cgpf>::AnisoPotentialPairGPU(
         }
 
     // initialize autotuner
-    // the full block size and threads_per_particle matrix is searched,
+    // the block size and threads_per_particle matrix is searched with coordinate descent,
     // encoded as block_size*10000 + threads_per_particle
     std::vector<unsigned int> valid_params;
     unsigned int warp_size = this->m_exec_conf->dev_prop.warpSize;
@@ -114,6 +114,7 @@ AnisoPotentialPairGPU<evaluator, gpu_cgpf>::AnisoPotentialPairGPU(
                                 100000,
                                 "aniso_pair_" + evaluator::getName(),
                                 this->m_exec_conf));
+    m_tuner->setDimensions({10000, 1});
 #ifdef ENABLE_MPI
     // synchronize autotuner results across ranks
     m_tuner->setSync(bool(this->m_pdata->getDomainDecomposition()));
@@ -189,6 +190,16 @@ void AnisoPotentialPairGPU<evaluator, gpu_cgpf>::computeForces(uint64_t timestep
     // access flags
     PDataFlags flags = this->m_pdata->getFlags();
 
+    // the cache is filled by the driver before the pair kernel runs
+    std::unique_ptr<ArrayHandle<Scalar4>> d_orientation_cache;
+    if (evaluator::needsOrientationCache())
+        {
+        this->allocateOrientationCache();
+        d_orientation_cache.reset(new ArrayHandle<Scalar4>(this->m_orientation_cache,
+                                                           access_location::device,
+                                                           access_mode::overwrite));
+        }
+
     this->m_exec_conf->beginMultiGPU();
 
     if (!m_param)
@@ -201,32 +212,37 @@ void AnisoPotentialPairGPU<evaluator, gpu_cgpf>::computeForces(uint64_t timestep
     // could track this between calls to avoid extra copying.
     bool first = true;
 
-    gpu_cgpf(a_pair_args_t(d_force.data,
-                           d_torque.data,
-                           d_virial.data,
-                           this->m_virial.getPitch(),
-                           this->m_pdata->getN(),
-                           this->m_pdata->getMaxN(),
-                           d_pos.data,
-                           d_diameter.data,
-                           d_charge.data,
-                           d_orientation.data,
-                           d_tag.data,
-                           box,
-                           d_n_neigh.data,
-                           d_nlist.data,
-                           d_head_list.data,
-                           d_rcutsq.data,
-                           this->m_pdata->getNTypes(),
-                           block_size,
-                           this->m_shift_mode,
-                           flags[pdata_flag::pressure_tensor],
-                           threads_per_particle,
-                           this->m_pdata->getGPUPartition(),
-                           this->m_exec_conf->dev_prop,
-                           first),
-             d_params.data,
-             d_shape_params.data);
+    a_pair_args_t pair_args(d_force.data,
+                            d_torque.data,
+                            d_virial.data,
+                            this->m_virial.getPitch(),
+                            this->m_pdata->getN(),
+                            this->m_pdata->getMaxN(),
+                            d_pos.data,
+                            d_diameter.data,
+                            d_charge.data,
+                            d_orientation.data,
+                            d_tag.data,
+                            box,
+                            d_n_neigh.data,
+                            d_nlist.data,
+                            d_head_list.data,
+                            d_rcutsq.data,
+                            this->m_pdata->getNTypes(),
+                            block_size,
+                            this->m_shift_mode,
+                            flags[pdata_flag::pressure_tensor],
+                            threads_per_particle,
+                            this->m_pdata->getGPUPartition(),
+                            this->m_exec_conf->dev_prop,
+                            first);
+    if (d_orientation_cache)
+        {
+        pair_args.d_orientation_cache = d_orientation_cache->data;
+        pair_args.n_cache = this->m_pdata->getN() + this->m_pdata->getNGhosts();
+        }
+
+    gpu_cgpf(pair_args, d_params.data, d_shape_params.data);
     if (!m_param)
         this->m_tuner->end();
 
@@ -85,6 +85,7 @@ void BondTablePotentialGPU::computeForces(uint64_t timestep)
         gpu_compute_bondtable_forces(d_force.data,
                                      d_virial.data,
                                      m_virial.getPitch(),
+                                     m_pdata->getFlags()[pdata_flag::pressure_tensor],
                                      m_pdata->getN(),
                                      d_pos.data,
                                      box,
@@ -97,7 +98,8 @@ void BondTablePotentialGPU::computeForces(uint64_t timestep)
                                      m_table_width,
                                      m_table_value,
                                      d_flags.data,
-                                     m_tuner->getParam());
+                                     m_tuner->getParam(),
+                                     m_exec_conf->dev_prop);
         }
 
     if (m_exec_conf->isCUDAErrorCheckingEnabled())
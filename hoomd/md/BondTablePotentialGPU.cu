@@ -19,6 +19,7 @@
     \param d_force Device memory to write computed forces
     \param d_virial Device memory to write computed virials
     \param virial_pitch Pitch of 2D virial array
+    \param compute_virial Whether to write the virials
     \param N number of particles in system
     \param d_pos device array of particle positions
     \param box Box dimensions used to implement periodic boundary conditions
@@ -31,11 +32,16 @@
     \param d_flags Flag allocated on the device for use in checking for bonds that cannot be
    evaluated
 
+    \tparam use_shared When true, the block also reads the tables into dynamic shared memory, after
+   the parameters
+
     See BondTablePotential for information on the memory layout.
 */
+template<bool use_shared>
 __global__ void gpu_compute_bondtable_forces_kernel(Scalar4* d_force,
                                                     Scalar* d_virial,
                                                     const size_t virial_pitch,
+                                                    const bool compute_virial,
                                                     const unsigned int N,
                                                     const Scalar4* d_pos,
                                                     const BoxDim box,
@@ -55,6 +61,18 @@ __global__ void gpu_compute_bondtable_forces_kernel(Scalar4* d_force,
         if (cur_offset + threadIdx.x < n_bond_type)
             s_params[cur_offset + threadIdx.x] = d_params[cur_offset + threadIdx.x];
         }
+
+    // stage the tables in shared memory when they fit, see the driver
+    Scalar2* s_tables = (Scalar2*)(s_params + n_bond_type);
+    if (use_shared)
+        {
+        const unsigned int n_values = table_value.getNumElements();
+        for (unsigned int cur_offset = 0; cur_offset < n_values; cur_offset += blockDim.x)
+            {
+            if (cur_offset + threadIdx.x < n_values)
+                s_tables[cur_offset + threadIdx.x] = d_tables[cur_offset + threadIdx.x];
+            }
+        }
     __syncthreads();
 
     // start by identifying which particle we are to handle
@@ -114,8 +132,10 @@ __global__ void gpu_compute_bondtable_forces_kernel(Scalar4* d_force,
             // compute index into the table and read in values
             unsigned int value_i = floor(value_f);
 
-            Scalar2 VF0 = __ldg(d_tables + table_value(value_i, cur_bond_type));
-            Scalar2 VF1 = __ldg(d_tables + table_value(value_i + 1, cur_bond_type));
+            const unsigned int table_idx = table_value(value_i, cur_bond_type);
+            Scalar2 VF0 = use_shared ? s_tables[table_idx] : __ldg(d_tables + table_idx);
+            Scalar2 VF1
+                = use_shared ? s_tables[table_idx + 1] : __ldg(d_tables + table_idx + 1);
             // unpack the data
             Scalar V0 = VF0.x;
             Scalar V1 = VF1.x;
@@ -157,13 +177,17 @@ __global__ void gpu_compute_bondtable_forces_kernel(Scalar4* d_force,
 
     // now that the force calculation is complete, write out the result (MEM TRANSFER: 20 bytes);
     d_force[idx] = force;
-    for (unsigned int i = 0; i < 6; i++)
-        d_virial[i * virial_pitch + idx] = virial[i];
+    if (compute_virial)
+        {
+        for (unsigned int i = 0; i < 6; i++)
+            d_virial[i * virial_pitch + idx] = virial[i];
+        }
     }
 
 /*! \param d_force Device memory to write computed forces
     \param d_virial Device memory to write computed virials
     \param virial_pitch pitch of 2D virial array
+    \param compute_virial Whether to write the virials
     \param N number of particles
     \param d_pos particle positions on the device
     \param box Box dimensions used to implement periodic boundary conditions
@@ -178,13 +202,18 @@ __global__ void gpu_compute_bondtable_forces_kernel(Scalar4* d_force,
     \param d_flags flags on the device - a 1 will be written if evaluation
                    of forces failed for any bond
     \param block_size Block size at which to run the kernel
+    \param dev_prop Properties of the device
+
+    The tables are staged in shared memory when they fit, otherwise the kernel reads them through
+   the read-only data cache.
 
     \note This is just a kernel driver. See gpu_compute_bondtable_forces_kernel for full
    documentation.
 */
 hipError_t gpu_compute_bondtable_forces(Scalar4* d_force,
                                         Scalar* d_virial,
-                                        size_t virial_pitch,
+                                        const size_t virial_pitch,
+                                        const bool compute_virial,
                                         const unsigned int N,
                                         const Scalar4* d_pos,
                                         const BoxDim& box,
@@ -197,35 +226,48 @@ hipError_t gpu_compute_bondtable_forces(Scalar4* d_force,
                                         const unsigned int table_width,
                                         const Index2D& table_value,
                                         unsigned int* d_flags,
-                                        const unsigned int block_size)
+                                        const unsigned int block_size,
+                                        const hipDeviceProp_t& dev_prop)
     {
     assert(d_params);
     assert(d_tables);
     assert(n_bond_type > 0);
     assert(table_width > 1);
 
-    static unsigned int max_block_size = UINT_MAX;
-    if (max_block_size == UINT_MAX)
+    static unsigned int max_block_size[2] = {UINT_MAX, UINT_MAX};
+    static size_t kernel_shared_bytes = 0;
+    if (max_block_size[0] == UINT_MAX)
         {
         hipFuncAttributes attr;
-        hipFuncGetAttributes(&attr, (const void*)gpu_compute_bondtable_forces_kernel);
-        max_block_size = attr.maxThreadsPerBlock;
+        hipFuncGetAttributes(&attr, (const void*)gpu_compute_bondtable_forces_kernel<false>);
+        max_block_size[0] = attr.maxThreadsPerBlock;
+        hipFuncGetAttributes(&attr, (const void*)gpu_compute_bondtable_forces_kernel<true>);
+        max_block_size[1] = attr.maxThreadsPerBlock;
+        kernel_shared_bytes = attr.sharedSizeBytes;
         }
 
-    unsigned int run_block_size = min(block_size, max_block_size);
+    const size_t param_bytes = sizeof(Scalar4) * n_bond_type;
+    const size_t table_bytes = sizeof(Scalar2) * table_value.getNumElements();
+    const bool use_shared
+        = param_bytes + table_bytes + kernel_shared_bytes <= dev_prop.sharedMemPerBlock;
+    auto kernel = use_shared ? gpu_compute_bondtable_forces_kernel<true>
+                             : gpu_compute_bondtable_forces_kernel<false>;
+
+    unsigned int run_block_size = min(block_size, max_block_size[use_shared]);
 
     // setup the grid to run the kernel
     dim3 grid(N / run_block_size + 1, 1, 1);
     dim3 threads(run_block_size, 1, 1);
 
-    hipLaunchKernelGGL((gpu_compute_bondtable_forces_kernel),
+    hipLaunchKernelGGL((kernel),
                        dim3(grid),
                        dim3(threads),
-                       sizeof(Scalar4) * n_bond_type,
+                       use_shared ? param_bytes + table_bytes : param_bytes,
                        0,
                        d_force,
                        d_virial,
                        virial_pitch,
+                       compute_virial,
                        N,
                        d_pos,
                        box,
@@ -20,6 +20,7 @@
 hipError_t gpu_compute_bondtable_forces(Scalar4* d_force,
                                         Scalar* d_virial,
                                         const size_t virial_pitch,
+                                        const bool compute_virial,
                                         const unsigned int N,
                                         const Scalar4* d_pos,
                                         const BoxDim& box,
@@ -32,6 +33,7 @@ hipError_t gpu_compute_bondtable_forces(Scalar4* d_force,
                                         const unsigned int table_width,
                                         const Index2D& table_value,
                                         unsigned int* d_flags,
-                                        const unsigned int block_size);
+                                        const unsigned int block_size,
+                                        const hipDeviceProp_t& dev_prop);
 
 #endif
@@ -0,0 +1,260 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file ComputeRDF.cc
+    \brief Contains code for the ComputeRDF class
+*/
+
+#include "ComputeRDF.h"
+
+#ifdef ENABLE_MPI
+#include "hoomd/HOOMDMPI.h"
+#endif
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace py = pybind11;
+
+using namespace std;
+
+/*! \param sysdef System to compute the radial distribution function of
+    \param nlist Neighbor list to read pairs from
+    \param bins Number of bins between 0 and r_max
+    \param r_max Maximum pair distance
+*/
+ComputeRDF::ComputeRDF(std::shared_ptr<SystemDefinition> sysdef,
+                       std::shared_ptr<NeighborList> nlist,
+                       unsigned int bins,
+                       Scalar r_max)
+    : Compute(sysdef), m_nlist(nlist), m_bins(bins), m_r_max(r_max),
+      m_typpair_idx(m_pdata->getNTypes()), m_num_frames(0)
+    {
+    m_exec_conf->msg->notice(5) << "Constructing ComputeRDF" << endl;
+
+    if (m_bins == 0)
+        {
+        throw std::domain_error("bins must be greater than 0");
+        }
+    if (!(m_r_max > Scalar(0.0)))
+        {
+        throw std::domain_error("r_max must be greater than 0");
+        }
+
+    GlobalArray<unsigned int> counts(m_typpair_idx.getNumElements() * m_bins, m_exec_conf);
+    m_counts.swap(counts);
+    TAG_ALLOCATION(m_counts);
+
+    m_rdf_sum.resize(m_typpair_idx.getNumElements() * m_bins, 0.0);
+
+    // request all pairs within r_max from the neighbor list
+    Index2D typpair_full(m_pdata->getNTypes());
+    m_r_cut_nlist
+        = std::make_shared<GlobalArray<Scalar>>(typpair_full.getNumElements(), m_exec_conf);
+        {
+        ArrayHandle<Scalar> h_r_cut(*m_r_cut_nlist, access_location::host, access_mode::overwrite);
+        std::fill(h_r_cut.data, h_r_cut.data + typpair_full.getNumElements(), m_r_max);
+        }
+    m_nlist->addRCutMatrix(m_r_cut_nlist);
+    }
+
+ComputeRDF::~ComputeRDF()
+    {
+    m_exec_conf->msg->notice(5) << "Destroying ComputeRDF" << endl;
+
+    if (m_attached)
+        {
+        m_nlist->removeRCutMatrix(m_r_cut_nlist);
+        }
+    }
+
+/*! \param timestep Current time step
+
+    Adds one frame to the average for every distinct time step.
+*/
+void ComputeRDF::compute(uint64_t timestep)
+    {
+    Compute::compute(timestep);
+    if (!shouldCompute(timestep))
+        return;
+
+    if (m_prof)
+        m_prof->push(m_exec_conf, "RDF");
+
+    m_nlist->compute(timestep);
+    computeHistogram();
+    accumulateFrame();
+
+    if (m_prof)
+        m_prof->pop(m_exec_conf);
+    }
+
+void ComputeRDF::reset()
+    {
+    std::fill(m_rdf_sum.begin(), m_rdf_sum.end(), 0.0);
+    m_num_frames = 0;
+    }
+
+void ComputeRDF::computeHistogram()
+    {
+    ArrayHandle<unsigned int> h_counts(m_counts, access_location::host, access_mode::overwrite);
+    std::fill(h_counts.data, h_counts.data + m_counts.getNumElements(), 0);
+
+    ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_n_neigh(m_nlist->getNNeighArray(),
+                                        access_location::host,
+                                        access_mode::read);
+    ArrayHandle<unsigned int> h_nlist(m_nlist->getNListArray(),
+                                      access_location::host,
+                                      access_mode::read);
+    ArrayHandle<unsigned int> h_head_list(m_nlist->getHeadList(),
+                                          access_location::host,
+                                          access_mode::read);
+
+    const BoxDim box = m_pdata->getBox();
+    const unsigned int N = m_pdata->getN();
+    const bool half_nlist = m_nlist->getStorageMode() == NeighborList::half;
+    const Scalar r_maxsq = m_r_max * m_r_max;
+    const Scalar bin_scale = Scalar(m_bins) / m_r_max;
+
+    for (unsigned int i = 0; i < N; i++)
+        {
+        const Scalar4 postype_i = h_pos.data[i];
+        const Scalar3 pos_i = make_scalar3(postype_i.x, postype_i.y, postype_i.z);
+        const unsigned int type_i = __scalar_as_int(postype_i.w);
+        const unsigned int head = h_head_list.data[i];
+
+        for (unsigned int k = 0; k < h_n_neigh.data[i]; k++)
+            {
+            const unsigned int j = h_nlist.data[head + k];
+            const Scalar4 postype_j = h_pos.data[j];
+            Scalar3 dx = pos_i - make_scalar3(postype_j.x, postype_j.y, postype_j.z);
+            dx = box.minImage(dx);
+            const Scalar rsq = dot(dx, dx);
+            if (rsq >= r_maxsq)
+                continue;
+
+            const unsigned int bin = (unsigned int)(slow::sqrt(rsq) * bin_scale);
+            if (bin >= m_bins)
+                continue;
+
+            // a half list stores each local pair once, count it in both orders
+            const unsigned int weight = (half_nlist && j < N) ? 2 : 1;
+            const unsigned int type_j = __scalar_as_int(postype_j.w);
+            h_counts.data[m_typpair_idx(type_i, type_j) * m_bins + bin] += weight;
+            }
+        }
+    }
+
+void ComputeRDF::accumulateFrame()
+    {
+    const unsigned int n_types = m_pdata->getNTypes();
+    const unsigned int n_elements = m_typpair_idx.getNumElements() * m_bins;
+
+    // count particles of each type
+    std::vector<double> type_count(n_types, 0.0);
+        {
+        ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(),
+                                   access_location::host,
+                                   access_mode::read);
+        for (unsigned int i = 0; i < m_pdata->getN(); i++)
+            {
+            type_count[__scalar_as_int(h_pos.data[i].w)] += 1.0;
+            }
+        }
+
+    std::vector<double> counts(n_elements);
+        {
+        ArrayHandle<unsigned int> h_counts(m_counts, access_location::host, access_mode::read);
+        std::copy(h_counts.data, h_counts.data + n_elements, counts.begin());
+        }
+
+#ifdef ENABLE_MPI
+    if (m_pdata->getDomainDecomposition())
+        {
+        MPI_Allreduce(MPI_IN_PLACE,
+                      type_count.data(),
+                      n_types,
+                      MPI_DOUBLE,
+                      MPI_SUM,
+                      m_exec_conf->getMPICommunicator());
+        MPI_Allreduce(MPI_IN_PLACE,
+                      counts.data(),
+                      n_elements,
+                      MPI_DOUBLE,
+                      MPI_SUM,
+                      m_exec_conf->getMPICommunicator());
+        }
+#endif
+
+    const bool twod = m_sysdef->getNDimensions() == 2;
+    const double volume = m_pdata->getGlobalBox().getVolume(twod);
+    const double dr = m_r_max / m_bins;
+
+    for (unsigned int type_a = 0; type_a < n_types; type_a++)
+        {
+        for (unsigned int type_b = type_a; type_b < n_types; type_b++)
+            {
+            // number of ordered pairs counted for an ideal gas with unit g(r) is
+            // density_norm * shell volume
+            double density_norm;
+            if (type_a == type_b)
+                density_norm = type_count[type_a] * (type_count[type_a] - 1.0) / volume;
+            else
+                density_norm = 2.0 * type_count[type_a] * type_count[type_b] / volume;
+
+            if (density_norm <= 0.0)
+                continue;
+
+            const unsigned int offset = m_typpair_idx(type_a, type_b) * m_bins;
+            for (unsigned int bin = 0; bin < m_bins; bin++)
+                {
+                const double r_lo = bin * dr;
+                const double r_hi = (bin + 1) * dr;
+                double shell;
+                if (twod)
+                    shell = M_PI * (r_hi * r_hi - r_lo * r_lo);
+                else
+                    shell = 4.0 * M_PI / 3.0 * (r_hi * r_hi * r_hi - r_lo * r_lo * r_lo);
+
+                m_rdf_sum[offset + bin] += counts[offset + bin] / (density_norm * shell);
+                }
+            }
+        }
+
+    m_num_frames++;
+    }
+
+/*! \returns An array with one row per unordered type pair (a, b), a <= b, in row major upper
+    triangular order, and one column per bin.
+*/
+pybind11::array_t<double> ComputeRDF::getRDF() const
+    {
+    std::vector<size_t> dims {m_typpair_idx.getNumElements(), m_bins};
+    pybind11::array_t<double> result(dims);
+    auto r = result.mutable_unchecked<2>();
+
+    for (unsigned int pair = 0; pair < m_typpair_idx.getNumElements(); pair++)
+        {
+        for (unsigned int bin = 0; bin < m_bins; bin++)
+            {
+            r(pair, bin) = m_num_frames > 0 ? m_rdf_sum[pair * m_bins + bin] / m_num_frames : 0.0;
+            }
+        }
+
+    return result;
+    }
+
+void export_ComputeRDF(py::module& m)
+    {
+    py::class_<ComputeRDF, Compute, std::shared_ptr<ComputeRDF>>(m, "ComputeRDF")
+        .def(py::init<std::shared_ptr<SystemDefinition>,
+                      std::shared_ptr<NeighborList>,
+                      unsigned int,
+                      Scalar>())
+        .def_property_readonly("bins", &ComputeRDF::getBins)
+        .def_property_readonly("r_max", &ComputeRDF::getRMax)
+        .def_property_readonly("num_frames", &ComputeRDF::getNumFrames)
+        .def_property_readonly("rdf", &ComputeRDF::getRDF)
+        .def("reset", &ComputeRDF::reset);
+    }
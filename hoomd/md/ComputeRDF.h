@@ -0,0 +1,113 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "NeighborList.h"
+#include "hoomd/Compute.h"
+#include "hoomd/GlobalArray.h"
+#include "hoomd/Index1D.h"
+
+#include <memory>
+#include <vector>
+
+/*! \file ComputeRDF.h
+    \brief Declares a class for computing the radial distribution function
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include <pybind11/numpy.h>
+#include <pybind11/pybind11.h>
+
+#ifndef __COMPUTE_RDF_H__
+#define __COMPUTE_RDF_H__
+
+//! Computes the radial distribution function per type pair
+/*! ComputeRDF histograms the pair distances found in the neighbor list up to r_max and
+    accumulates the normalized g(r) of every unordered type pair over all frames computed since the
+    last reset(). A frame is added each time compute() is called on a new time step, which happens
+    when Python requests the values (e.g. through a logger).
+
+    The compute adds r_max to the neighbor list r_cut matrix so that all pairs within r_max are
+    found. Pairs excluded from the neighbor list are not counted.
+
+    The histogram of the current frame is stored in m_counts, indexed by
+    m_typpair_idx(type_i, type_j) * m_bins + bin. Each ordered pair (i, j) with local particle i
+    contributes one count, so that the counts sum over all MPI ranks to the number of ordered
+    pairs. computeHistogram() is overridden by the GPU implementation.
+
+    \ingroup computes
+*/
+class PYBIND11_EXPORT ComputeRDF : public Compute
+    {
+    public:
+    //! Constructs the compute
+    ComputeRDF(std::shared_ptr<SystemDefinition> sysdef,
+               std::shared_ptr<NeighborList> nlist,
+               unsigned int bins,
+               Scalar r_max);
+
+    //! Destructor
+    virtual ~ComputeRDF();
+
+    //! Add the current configuration to the average
+    virtual void compute(uint64_t timestep);
+
+    //! Clear the accumulated average
+    void reset();
+
+    //! Get the number of bins
+    unsigned int getBins() const
+        {
+        return m_bins;
+        }
+
+    //! Get the maximum pair distance
+    Scalar getRMax() const
+        {
+        return m_r_max;
+        }
+
+    //! Get the number of frames in the average
+    unsigned int getNumFrames() const
+        {
+        return m_num_frames;
+        }
+
+    //! Get the averaged g(r), one row per unordered type pair
+    pybind11::array_t<double> getRDF() const;
+
+    /// Python will notify C++ objects when they are detached from Simulation
+    virtual void notifyDetach()
+        {
+        if (m_attached)
+            {
+            m_nlist->removeRCutMatrix(m_r_cut_nlist);
+            }
+        m_attached = false;
+        }
+
+    protected:
+    std::shared_ptr<NeighborList> m_nlist;                //!< Neighbor list to read pairs from
+    std::shared_ptr<GlobalArray<Scalar>> m_r_cut_nlist;   //!< r_cut matrix given to the nlist
+    unsigned int m_bins;                                  //!< Number of bins
+    Scalar m_r_max;                                       //!< Maximum pair distance
+    Index2DUpperTriangular m_typpair_idx;                 //!< Indexes unordered type pairs
+    GlobalArray<unsigned int> m_counts;                   //!< Pair counts in the current frame
+    std::vector<double> m_rdf_sum;                        //!< Sum of g(r) over all frames
+    unsigned int m_num_frames;                            //!< Number of frames in m_rdf_sum
+    bool m_attached = true;                               //!< True while attached to Simulation
+
+    //! Histogram the pair distances of the current configuration into m_counts
+    virtual void computeHistogram();
+
+    private:
+    //! Normalize m_counts and add the result to m_rdf_sum
+    void accumulateFrame();
+    };
+
+//! Exports the ComputeRDF class to python
+void export_ComputeRDF(pybind11::module& m);
+
+#endif
@@ -0,0 +1,77 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file ComputeRDFGPU.cc
+    \brief Contains code for the ComputeRDFGPU class
+*/
+
+#include "ComputeRDFGPU.h"
+#include "ComputeRDFGPU.cuh"
+
+namespace py = pybind11;
+
+using namespace std;
+
+/*! \param sysdef System to compute the radial distribution function of
+    \param nlist Neighbor list to read pairs from
+    \param bins Number of bins between 0 and r_max
+    \param r_max Maximum pair distance
+*/
+ComputeRDFGPU::ComputeRDFGPU(std::shared_ptr<SystemDefinition> sysdef,
+                             std::shared_ptr<NeighborList> nlist,
+                             unsigned int bins,
+                             Scalar r_max)
+    : ComputeRDF(sysdef, nlist, bins, r_max), m_block_size(256)
+    {
+    if (!m_exec_conf->isCUDAEnabled())
+        {
+        m_exec_conf->msg->error() << "Creating a ComputeRDFGPU with no GPU in the execution "
+                                     "configuration"
+                                  << endl;
+        throw std::runtime_error("Error initializing ComputeRDFGPU");
+        }
+    }
+
+ComputeRDFGPU::~ComputeRDFGPU() { }
+
+void ComputeRDFGPU::computeHistogram()
+    {
+    ArrayHandle<unsigned int> d_counts(m_counts, access_location::device, access_mode::overwrite);
+    hipMemset(d_counts.data, 0, sizeof(unsigned int) * m_counts.getNumElements());
+
+    ArrayHandle<Scalar4> d_pos(m_pdata->getPositions(), access_location::device, access_mode::read);
+    ArrayHandle<unsigned int> d_n_neigh(m_nlist->getNNeighArray(),
+                                        access_location::device,
+                                        access_mode::read);
+    ArrayHandle<unsigned int> d_nlist(m_nlist->getNListArray(),
+                                      access_location::device,
+                                      access_mode::read);
+    ArrayHandle<unsigned int> d_head_list(m_nlist->getHeadList(),
+                                          access_location::device,
+                                          access_mode::read);
+
+    gpu_compute_rdf_histogram(d_counts.data,
+                              d_pos.data,
+                              d_n_neigh.data,
+                              d_nlist.data,
+                              d_head_list.data,
+                              m_pdata->getN(),
+                              m_pdata->getBox(),
+                              m_typpair_idx,
+                              m_bins,
+                              m_r_max,
+                              m_nlist->getStorageMode() == NeighborList::half,
+                              m_block_size);
+
+    if (m_exec_conf->isCUDAErrorCheckingEnabled())
+        CHECK_CUDA_ERROR();
+    }
+
+void export_ComputeRDFGPU(py::module& m)
+    {
+    py::class_<ComputeRDFGPU, ComputeRDF, std::shared_ptr<ComputeRDFGPU>>(m, "ComputeRDFGPU")
+        .def(py::init<std::shared_ptr<SystemDefinition>,
+                      std::shared_ptr<NeighborList>,
+                      unsigned int,
+                      Scalar>());
+    }
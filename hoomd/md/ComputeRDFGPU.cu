@@ -0,0 +1,127 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "ComputeRDFGPU.cuh"
+
+/*! \file ComputeRDFGPU.cu
+    \brief Defines GPU kernel code for histogramming pair distances. Used by ComputeRDFGPU.
+*/
+
+//! Histogram the neighbor list pair distances
+/*! \param d_counts Histogram to add to, indexed by typpair_idx(type_i, type_j) * bins + bin
+    \param d_pos Particle positions and types
+    \param d_n_neigh Number of neighbors of each particle
+    \param d_nlist Neighbor list
+    \param d_head_list Offset of each particle's neighbors in d_nlist
+    \param N Number of local particles
+    \param box Local simulation box
+    \param typpair_idx Indexer for unordered type pairs
+    \param bins Number of bins
+    \param r_max Maximum pair distance
+    \param half_nlist True when the neighbor list stores each pair once
+
+    One thread is executed per particle.
+*/
+__global__ void gpu_compute_rdf_histogram_kernel(unsigned int* d_counts,
+                                                 const Scalar4* d_pos,
+                                                 const unsigned int* d_n_neigh,
+                                                 const unsigned int* d_nlist,
+                                                 const unsigned int* d_head_list,
+                                                 const unsigned int N,
+                                                 const BoxDim box,
+                                                 const Index2DUpperTriangular typpair_idx,
+                                                 const unsigned int bins,
+                                                 const Scalar r_max,
+                                                 const bool half_nlist)
+    {
+    unsigned int idx = blockIdx.x * blockDim.x + threadIdx.x;
+
+    if (idx >= N)
+        return;
+
+    const Scalar4 postype_i = d_pos[idx];
+    const Scalar3 pos_i = make_scalar3(postype_i.x, postype_i.y, postype_i.z);
+    const unsigned int type_i = __scalar_as_int(postype_i.w);
+    const unsigned int head = d_head_list[idx];
+    const unsigned int n_neigh = d_n_neigh[idx];
+    const Scalar r_maxsq = r_max * r_max;
+    const Scalar bin_scale = Scalar(bins) / r_max;
+
+    for (unsigned int k = 0; k < n_neigh; k++)
+        {
+        const unsigned int j = d_nlist[head + k];
+        const Scalar4 postype_j = d_pos[j];
+        Scalar3 dx = pos_i - make_scalar3(postype_j.x, postype_j.y, postype_j.z);
+        dx = box.minImage(dx);
+        const Scalar rsq = dot(dx, dx);
+        if (rsq >= r_maxsq)
+            continue;
+
+        const unsigned int bin = (unsigned int)(fast::sqrt(rsq) * bin_scale);
+        if (bin >= bins)
+            continue;
+
+        // a half list stores each local pair once, count it in both orders
+        const unsigned int weight = (half_nlist && j < N) ? 2 : 1;
+        const unsigned int type_j = __scalar_as_int(postype_j.w);
+        atomicAdd(&d_counts[typpair_idx(type_i, type_j) * bins + bin], weight);
+        }
+    }
+
+/*! \param d_counts Histogram to add to (must be zeroed by the caller)
+    \param d_pos Particle positions and types
+    \param d_n_neigh Number of neighbors of each particle
+    \param d_nlist Neighbor list
+    \param d_head_list Offset of each particle's neighbors in d_nlist
+    \param N Number of local particles
+    \param box Local simulation box
+    \param typpair_idx Indexer for unordered type pairs
+    \param bins Number of bins
+    \param r_max Maximum pair distance
+    \param half_nlist True when the neighbor list stores each pair once
+    \param block_size Number of threads per block
+*/
+hipError_t gpu_compute_rdf_histogram(unsigned int* d_counts,
+                                     const Scalar4* d_pos,
+                                     const unsigned int* d_n_neigh,
+                                     const unsigned int* d_nlist,
+                                     const unsigned int* d_head_list,
+                                     const unsigned int N,
+                                     const BoxDim& box,
+                                     const Index2DUpperTriangular& typpair_idx,
+                                     const unsigned int bins,
+                                     const Scalar r_max,
+                                     const bool half_nlist,
+                                     const unsigned int block_size)
+    {
+    if (N == 0)
+        return hipSuccess;
+
+    unsigned int max_block_size;
+    hipFuncAttributes attr;
+    hipFuncGetAttributes(&attr, (const void*)gpu_compute_rdf_histogram_kernel);
+    max_block_size = attr.maxThreadsPerBlock;
+
+    unsigned int run_block_size = min(block_size, max_block_size);
+    dim3 grid(N / run_block_size + 1, 1, 1);
+    dim3 threads(run_block_size, 1, 1);
+
+    hipLaunchKernelGGL((gpu_compute_rdf_histogram_kernel),
+                       grid,
+                       threads,
+                       0,
+                       0,
+                       d_counts,
+                       d_pos,
+                       d_n_neigh,
+                       d_nlist,
+                       d_head_list,
+                       N,
+                       box,
+                       typpair_idx,
+                       bins,
+                       r_max,
+                       half_nlist);
+
+    return hipSuccess;
+    }
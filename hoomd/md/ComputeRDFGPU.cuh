@@ -0,0 +1,31 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#ifndef _COMPUTE_RDF_GPU_CUH_
+#define _COMPUTE_RDF_GPU_CUH_
+
+#include <hip/hip_runtime.h>
+
+#include "hoomd/BoxDim.h"
+#include "hoomd/HOOMDMath.h"
+#include "hoomd/Index1D.h"
+
+/*! \file ComputeRDFGPU.cuh
+    \brief Kernel driver function declarations for ComputeRDFGPU
+*/
+
+//! Histogram the neighbor list pair distances per type pair
+hipError_t gpu_compute_rdf_histogram(unsigned int* d_counts,
+                                     const Scalar4* d_pos,
+                                     const unsigned int* d_n_neigh,
+                                     const unsigned int* d_nlist,
+                                     const unsigned int* d_head_list,
+                                     const unsigned int N,
+                                     const BoxDim& box,
+                                     const Index2DUpperTriangular& typpair_idx,
+                                     const unsigned int bins,
+                                     const Scalar r_max,
+                                     const bool half_nlist,
+                                     const unsigned int block_size);
+
+#endif
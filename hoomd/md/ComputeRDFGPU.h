@@ -0,0 +1,47 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "ComputeRDF.h"
+
+/*! \file ComputeRDFGPU.h
+    \brief Declares a class for computing the radial distribution function on the GPU
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include <pybind11/pybind11.h>
+
+#ifndef __COMPUTE_RDF_GPU_H__
+#define __COMPUTE_RDF_GPU_H__
+
+//! Computes the radial distribution function on the GPU
+/*! ComputeRDFGPU histograms the neighbor list pairs on the GPU. Only the histogram is transferred
+    to the host for normalization.
+
+    \ingroup computes
+*/
+class PYBIND11_EXPORT ComputeRDFGPU : public ComputeRDF
+    {
+    public:
+    //! Constructs the compute
+    ComputeRDFGPU(std::shared_ptr<SystemDefinition> sysdef,
+                  std::shared_ptr<NeighborList> nlist,
+                  unsigned int bins,
+                  Scalar r_max);
+
+    //! Destructor
+    virtual ~ComputeRDFGPU();
+
+    protected:
+    unsigned int m_block_size; //!< Block size executed
+
+    //! Histogram the pair distances on the GPU
+    virtual void computeHistogram();
+    };
+
+//! Exports the ComputeRDFGPU class to python
+void export_ComputeRDFGPU(pybind11::module& m);
+
+#endif
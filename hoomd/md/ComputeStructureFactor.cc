@@ -0,0 +1,277 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file ComputeStructureFactor.cc
+    \brief Contains code for the ComputeStructureFactor class
+*/
+
+#include "ComputeStructureFactor.h"
+#include "ComputeStructureFactorTypes.h"
+#include "hoomd/VectorMath.h"
+
+#ifdef ENABLE_MPI
+#include "hoomd/HOOMDMPI.h"
+#endif
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace py = pybind11;
+
+using namespace std;
+
+/*! \param sysdef System to compute the structure factor of
+    \param group Particles to include in the density
+    \param nx Number of mesh points along the first lattice vector
+    \param ny Number of mesh points along the second lattice vector
+    \param nz Number of mesh points along the third lattice vector
+    \param bins Number of bins between 0 and q_max
+    \param q_max Maximum wave vector magnitude
+*/
+ComputeStructureFactor::ComputeStructureFactor(std::shared_ptr<SystemDefinition> sysdef,
+                                               std::shared_ptr<ParticleGroup> group,
+                                               unsigned int nx,
+                                               unsigned int ny,
+                                               unsigned int nz,
+                                               unsigned int bins,
+                                               Scalar q_max)
+    : Compute(sysdef), m_group(group), m_mesh_dim(make_uint3(nx, ny, nz)), m_bins(bins),
+      m_q_max(q_max), m_num_frames(0)
+    {
+    m_exec_conf->msg->notice(5) << "Constructing ComputeStructureFactor" << endl;
+
+    if (nx == 0 || ny == 0 || nz == 0)
+        {
+        throw std::domain_error("The mesh must have at least one point along each axis");
+        }
+    if (m_sysdef->getNDimensions() == 2 && nz != 1)
+        {
+        throw std::domain_error("The mesh must have one point along z in 2D");
+        }
+    if (m_bins == 0)
+        {
+        throw std::domain_error("bins must be greater than 0");
+        }
+    if (!(m_q_max > Scalar(0.0)))
+        {
+        throw std::domain_error("q_max must be greater than 0");
+        }
+
+    m_sq_sum.resize(m_bins, 0.0);
+    }
+
+ComputeStructureFactor::~ComputeStructureFactor()
+    {
+    m_exec_conf->msg->notice(5) << "Destroying ComputeStructureFactor" << endl;
+    }
+
+/*! \param timestep Current time step
+
+    Adds one frame to the average for every distinct time step.
+*/
+void ComputeStructureFactor::compute(uint64_t timestep)
+    {
+    Compute::compute(timestep);
+    if (!shouldCompute(timestep))
+        return;
+
+    if (m_prof)
+        m_prof->push(m_exec_conf, "S(q)");
+
+    std::vector<double> shell_sum(m_bins, 0.0);
+    std::vector<unsigned int> shell_count(m_bins, 0);
+    computeShellSums(shell_sum, shell_count);
+
+    const double N = double(m_group->getNumMembersGlobal());
+    if (N > 0)
+        {
+        for (unsigned int bin = 0; bin < m_bins; bin++)
+            {
+            if (shell_count[bin] > 0)
+                m_sq_sum[bin] += shell_sum[bin] / (N * shell_count[bin]);
+            }
+        }
+    m_num_frames++;
+
+    if (m_prof)
+        m_prof->pop(m_exec_conf);
+    }
+
+void ComputeStructureFactor::reset()
+    {
+    std::fill(m_sq_sum.begin(), m_sq_sum.end(), 0.0);
+    m_num_frames = 0;
+    }
+
+pybind11::tuple ComputeStructureFactor::getMesh() const
+    {
+    return pybind11::make_tuple(m_mesh_dim.x, m_mesh_dim.y, m_mesh_dim.z);
+    }
+
+pybind11::array_t<double> ComputeStructureFactor::getStructureFactor() const
+    {
+    std::vector<double> result(m_bins, 0.0);
+    if (m_num_frames > 0)
+        {
+        for (unsigned int bin = 0; bin < m_bins; bin++)
+            result[bin] = m_sq_sum[bin] / m_num_frames;
+        }
+    return pybind11::array_t<double>(result.size(), result.data());
+    }
+
+void ComputeStructureFactor::getReciprocalLattice(Scalar3& b1, Scalar3& b2, Scalar3& b3) const
+    {
+    const BoxDim box = m_pdata->getGlobalBox();
+    const vec3<Scalar> a1(box.getLatticeVector(0));
+    const vec3<Scalar> a2(box.getLatticeVector(1));
+    const vec3<Scalar> a3(box.getLatticeVector(2));
+    const Scalar scale = Scalar(2.0 * M_PI) / dot(a1, cross(a2, a3));
+
+    b1 = vec_to_scalar3(scale * cross(a2, a3));
+    b2 = vec_to_scalar3(scale * cross(a3, a1));
+    b3 = vec_to_scalar3(scale * cross(a1, a2));
+    }
+
+#ifdef ENABLE_MPI
+/*! \param mesh Interleaved real and imaginary parts of the full mesh
+ */
+void ComputeStructureFactor::reduceMesh(float* mesh)
+    {
+    if (!m_pdata->getDomainDecomposition())
+        return;
+
+    const unsigned int n_points = m_mesh_dim.x * m_mesh_dim.y * m_mesh_dim.z;
+    MPI_Allreduce(MPI_IN_PLACE,
+                  mesh,
+                  2 * n_points,
+                  MPI_FLOAT,
+                  MPI_SUM,
+                  m_exec_conf->getMPICommunicator());
+    }
+#endif
+
+/*! \param shell_sum Output: sum of |rho(q)|^2 / W(q)^2 over the wave vectors in each bin
+    \param shell_count Output: number of wave vectors in each bin
+*/
+void ComputeStructureFactor::computeShellSums(std::vector<double>& shell_sum,
+                                              std::vector<unsigned int>& shell_count)
+    {
+    const unsigned int n_points = m_mesh_dim.x * m_mesh_dim.y * m_mesh_dim.z;
+
+    if (!m_local_fft)
+        {
+        int dims[3];
+        dims[0] = m_mesh_dim.z;
+        dims[1] = m_mesh_dim.y;
+        dims[2] = m_mesh_dim.x;
+        m_local_fft.reset(new LocalFFT(dims, m_exec_conf->getNumThreads()));
+
+        GlobalArray<kiss_fft_cpx> mesh(n_points, m_exec_conf);
+        m_mesh.swap(mesh);
+        TAG_ALLOCATION(m_mesh);
+        GlobalArray<kiss_fft_cpx> fourier_mesh(n_points, m_exec_conf);
+        m_fourier_mesh.swap(fourier_mesh);
+        TAG_ALLOCATION(m_fourier_mesh);
+        }
+
+        {
+        ArrayHandle<kiss_fft_cpx> h_mesh(m_mesh, access_location::host, access_mode::overwrite);
+        memset(h_mesh.data, 0, sizeof(kiss_fft_cpx) * n_points);
+
+        ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(),
+                                   access_location::host,
+                                   access_mode::read);
+        ArrayHandle<unsigned int> h_index_array(m_group->getIndexArray(),
+                                                access_location::host,
+                                                access_mode::read);
+        const BoxDim box = m_pdata->getGlobalBox();
+
+        for (unsigned int group_idx = 0; group_idx < m_group->getNumMembers(); group_idx++)
+            {
+            const Scalar4 postype = h_pos.data[h_index_array.data[group_idx]];
+            const Scalar3 f = box.makeFraction(make_scalar3(postype.x, postype.y, postype.z));
+
+            unsigned int ix[2], iy[2], iz[2];
+            Scalar wx[2], wy[2], wz[2];
+            structure_factor_cic_weights(f.x, m_mesh_dim.x, ix[0], ix[1], wx[0], wx[1]);
+            structure_factor_cic_weights(f.y, m_mesh_dim.y, iy[0], iy[1], wy[0], wy[1]);
+            structure_factor_cic_weights(f.z, m_mesh_dim.z, iz[0], iz[1], wz[0], wz[1]);
+
+            for (unsigned int a = 0; a < 2; a++)
+                for (unsigned int b = 0; b < 2; b++)
+                    for (unsigned int c = 0; c < 2; c++)
+                        {
+                        const unsigned int cell
+                            = ix[a] + m_mesh_dim.x * (iy[b] + m_mesh_dim.y * iz[c]);
+                        h_mesh.data[cell].r += float(wx[a] * wy[b] * wz[c]);
+                        }
+            }
+
+#ifdef ENABLE_MPI
+        reduceMesh((float*)h_mesh.data);
+#endif
+        }
+
+    ArrayHandle<kiss_fft_cpx> h_mesh(m_mesh, access_location::host, access_mode::read);
+    ArrayHandle<kiss_fft_cpx> h_fourier_mesh(m_fourier_mesh,
+                                             access_location::host,
+                                             access_mode::overwrite);
+    m_local_fft->forward(h_mesh.data, h_fourier_mesh.data);
+
+    Scalar3 b1, b2, b3;
+    getReciprocalLattice(b1, b2, b3);
+    const Scalar bin_scale = Scalar(m_bins) / m_q_max;
+    const Scalar q_maxsq = m_q_max * m_q_max;
+
+    for (unsigned int z = 0; z < m_mesh_dim.z; z++)
+        {
+        const int mz = structure_factor_wave_index(z, m_mesh_dim.z);
+        for (unsigned int y = 0; y < m_mesh_dim.y; y++)
+            {
+            const int my = structure_factor_wave_index(y, m_mesh_dim.y);
+            for (unsigned int x = 0; x < m_mesh_dim.x; x++)
+                {
+                const int mx = structure_factor_wave_index(x, m_mesh_dim.x);
+                const Scalar3 q = Scalar(mx) * b1 + Scalar(my) * b2 + Scalar(mz) * b3;
+                const Scalar qsq = dot(q, q);
+                if (qsq == Scalar(0.0) || qsq >= q_maxsq)
+                    continue;
+
+                const unsigned int bin = (unsigned int)(slow::sqrt(qsq) * bin_scale);
+                if (bin >= m_bins)
+                    continue;
+
+                const Scalar window = structure_factor_cic_window(mx, m_mesh_dim.x)
+                                      * structure_factor_cic_window(my, m_mesh_dim.y)
+                                      * structure_factor_cic_window(mz, m_mesh_dim.z);
+
+                const kiss_fft_cpx rho
+                    = h_fourier_mesh.data[x + m_mesh_dim.x * (y + m_mesh_dim.y * z)];
+                shell_sum[bin] += (double(rho.r) * rho.r + double(rho.i) * rho.i)
+                                  / (double(window) * window);
+                shell_count[bin]++;
+                }
+            }
+        }
+    }
+
+void export_ComputeStructureFactor(py::module& m)
+    {
+    py::class_<ComputeStructureFactor, Compute, std::shared_ptr<ComputeStructureFactor>>(
+        m,
+        "ComputeStructureFactor")
+        .def(py::init<std::shared_ptr<SystemDefinition>,
+                      std::shared_ptr<ParticleGroup>,
+                      unsigned int,
+                      unsigned int,
+                      unsigned int,
+                      unsigned int,
+                      Scalar>())
+        .def_property_readonly("mesh", &ComputeStructureFactor::getMesh)
+        .def_property_readonly("bins", &ComputeStructureFactor::getBins)
+        .def_property_readonly("q_max", &ComputeStructureFactor::getQMax)
+        .def_property_readonly("num_frames", &ComputeStructureFactor::getNumFrames)
+        .def_property_readonly("structure_factor", &ComputeStructureFactor::getStructureFactor)
+        .def("reset", &ComputeStructureFactor::reset);
+    }
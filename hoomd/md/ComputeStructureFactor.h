@@ -0,0 +1,115 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "LocalFFT.h"
+#include "hoomd/Compute.h"
+#include "hoomd/GlobalArray.h"
+#include "hoomd/ParticleGroup.h"
+
+#include <memory>
+#include <vector>
+
+/*! \file ComputeStructureFactor.h
+    \brief Declares a class for computing the static structure factor
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include <pybind11/numpy.h>
+#include <pybind11/pybind11.h>
+
+#ifndef __COMPUTE_STRUCTURE_FACTOR_H__
+#define __COMPUTE_STRUCTURE_FACTOR_H__
+
+//! Computes the static structure factor on a mesh
+/*! ComputeStructureFactor assigns the particles in a group to a periodic mesh with cloud in cell
+    weights, as PPPMForceCompute does with the charges, and Fourier transforms the density. The
+    structure factor S(q) = |rho(q)|^2 / N is corrected for the assignment function and averaged
+    over spherical (circular in 2D) shells of |q| < q_max. The average over all frames computed
+    since the last reset() is kept. A frame is added each time compute() is called on a new time
+    step, which happens when Python requests the values (e.g. through a logger).
+
+    Every rank assigns its local particles to a copy of the whole mesh. With a domain decomposition,
+    the meshes are summed over all ranks and each rank transforms the full mesh.
+
+    computeShellSums() is overridden by the GPU implementation.
+
+    \ingroup computes
+*/
+class PYBIND11_EXPORT ComputeStructureFactor : public Compute
+    {
+    public:
+    //! Constructs the compute
+    ComputeStructureFactor(std::shared_ptr<SystemDefinition> sysdef,
+                           std::shared_ptr<ParticleGroup> group,
+                           unsigned int nx,
+                           unsigned int ny,
+                           unsigned int nz,
+                           unsigned int bins,
+                           Scalar q_max);
+
+    //! Destructor
+    virtual ~ComputeStructureFactor();
+
+    //! Add the current configuration to the average
+    virtual void compute(uint64_t timestep);
+
+    //! Clear the accumulated average
+    void reset();
+
+    //! Get the mesh dimensions
+    pybind11::tuple getMesh() const;
+
+    //! Get the number of bins
+    unsigned int getBins() const
+        {
+        return m_bins;
+        }
+
+    //! Get the maximum wave vector magnitude
+    Scalar getQMax() const
+        {
+        return m_q_max;
+        }
+
+    //! Get the number of frames in the average
+    unsigned int getNumFrames() const
+        {
+        return m_num_frames;
+        }
+
+    //! Get the averaged S(q), one element per bin
+    pybind11::array_t<double> getStructureFactor() const;
+
+    protected:
+    std::shared_ptr<ParticleGroup> m_group; //!< Group to compute the structure factor of
+    uint3 m_mesh_dim;                       //!< Number of mesh points along each axis
+    unsigned int m_bins;                    //!< Number of bins
+    Scalar m_q_max;                         //!< Maximum wave vector magnitude
+    std::vector<double> m_sq_sum;           //!< Sum of S(q) over all frames
+    unsigned int m_num_frames;              //!< Number of frames in m_sq_sum
+
+    //! Compute the sum of the corrected |rho(q)|^2 and the number of wave vectors in each bin
+    virtual void computeShellSums(std::vector<double>& shell_sum,
+                                  std::vector<unsigned int>& shell_count);
+
+    //! Get the reciprocal lattice vectors of the global box, including the factor 2 pi
+    void getReciprocalLattice(Scalar3& b1, Scalar3& b2, Scalar3& b3) const;
+
+#ifdef ENABLE_MPI
+    //! Sum the mesh over all ranks
+    void reduceMesh(float* mesh);
+#endif
+
+    private:
+    std::unique_ptr<LocalFFT> m_local_fft;    //!< The FFT of the full mesh
+    GlobalArray<kiss_fft_cpx> m_mesh;         //!< The particle density mesh
+    GlobalArray<kiss_fft_cpx> m_fourier_mesh; //!< The Fourier transformed density
+    };
+
+//! Exports the ComputeStructureFactor class to python
+void export_ComputeStructureFactor(pybind11::module& m);
+
+#endif
@@ -0,0 +1,206 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file ComputeStructureFactorGPU.cc
+    \brief Contains code for the ComputeStructureFactorGPU class
+*/
+
+#include "ComputeStructureFactorGPU.h"
+#include "ComputeStructureFactorGPU.cuh"
+
+#include <sstream>
+
+namespace py = pybind11;
+
+using namespace std;
+
+//! Check for HIPFFT errors
+#ifdef __HIP_PLATFORM_HCC__
+static void checkHIPFFTResult(hipfftResult result, const char* file, unsigned int line)
+#else
+static void checkHIPFFTResult(cufftResult result, const char* file, unsigned int line)
+#endif
+    {
+#ifdef __HIP_PLATFORM_HCC__
+    if (result != HIPFFT_SUCCESS)
+#else
+    if (result != CUFFT_SUCCESS)
+#endif
+        {
+        std::ostringstream oss;
+        oss << "HIPFFT returned error " << result << " in file " << file << " line " << line
+            << std::endl;
+        throw std::runtime_error(oss.str());
+        }
+    }
+
+/*! \param sysdef System to compute the structure factor of
+    \param group Particles to include in the density
+    \param nx Number of mesh points along the first lattice vector
+    \param ny Number of mesh points along the second lattice vector
+    \param nz Number of mesh points along the third lattice vector
+    \param bins Number of bins between 0 and q_max
+    \param q_max Maximum wave vector magnitude
+*/
+ComputeStructureFactorGPU::ComputeStructureFactorGPU(std::shared_ptr<SystemDefinition> sysdef,
+                                                     std::shared_ptr<ParticleGroup> group,
+                                                     unsigned int nx,
+                                                     unsigned int ny,
+                                                     unsigned int nz,
+                                                     unsigned int bins,
+                                                     Scalar q_max)
+    : ComputeStructureFactor(sysdef, group, nx, ny, nz, bins, q_max), m_hipfft_initialized(false),
+      m_block_size(256)
+    {
+    if (!m_exec_conf->isCUDAEnabled())
+        {
+        m_exec_conf->msg->error() << "Creating a ComputeStructureFactorGPU with no GPU in the "
+                                     "execution configuration"
+                                  << endl;
+        throw std::runtime_error("Error initializing ComputeStructureFactorGPU");
+        }
+
+    GlobalArray<hipfftComplex> mesh(m_mesh_dim.x * m_mesh_dim.y * m_mesh_dim.z, m_exec_conf);
+    m_mesh.swap(mesh);
+    TAG_ALLOCATION(m_mesh);
+
+    GlobalArray<Scalar> shell_sum(m_bins, m_exec_conf);
+    m_shell_sum.swap(shell_sum);
+    TAG_ALLOCATION(m_shell_sum);
+
+    GlobalArray<unsigned int> shell_count(m_bins, m_exec_conf);
+    m_shell_count.swap(shell_count);
+    TAG_ALLOCATION(m_shell_count);
+    }
+
+ComputeStructureFactorGPU::~ComputeStructureFactorGPU()
+    {
+    if (m_hipfft_initialized)
+        {
+#ifdef __HIP_PLATFORM_HCC__
+        checkHIPFFTResult(hipfftDestroy(m_hipfft_plan), __FILE__, __LINE__);
+#else
+        checkHIPFFTResult(cufftDestroy(m_hipfft_plan), __FILE__, __LINE__);
+#endif
+        }
+    }
+
+/*! \param shell_sum Output: sum of |rho(q)|^2 / W(q)^2 over the wave vectors in each bin
+    \param shell_count Output: number of wave vectors in each bin
+*/
+void ComputeStructureFactorGPU::computeShellSums(std::vector<double>& shell_sum,
+                                                 std::vector<unsigned int>& shell_count)
+    {
+    const unsigned int n_points = m_mesh_dim.x * m_mesh_dim.y * m_mesh_dim.z;
+
+    if (!m_hipfft_initialized)
+        {
+#ifdef __HIP_PLATFORM_HCC__
+        checkHIPFFTResult(
+            hipfftPlan3d(&m_hipfft_plan, m_mesh_dim.z, m_mesh_dim.y, m_mesh_dim.x, HIPFFT_C2C),
+            __FILE__,
+            __LINE__);
+#else
+        checkHIPFFTResult(
+            cufftPlan3d(&m_hipfft_plan, m_mesh_dim.z, m_mesh_dim.y, m_mesh_dim.x, CUFFT_C2C),
+            __FILE__,
+            __LINE__);
+#endif
+        m_hipfft_initialized = true;
+        }
+
+        {
+        ArrayHandle<hipfftComplex> d_mesh(m_mesh, access_location::device, access_mode::overwrite);
+        hipMemset(d_mesh.data, 0, sizeof(hipfftComplex) * n_points);
+
+        ArrayHandle<Scalar4> d_pos(m_pdata->getPositions(),
+                                   access_location::device,
+                                   access_mode::read);
+        ArrayHandle<unsigned int> d_index_array(m_group->getIndexArray(),
+                                                access_location::device,
+                                                access_mode::read);
+
+        gpu_assign_structure_factor_mesh(d_mesh.data,
+                                         d_pos.data,
+                                         d_index_array.data,
+                                         m_group->getNumMembers(),
+                                         m_pdata->getGlobalBox(),
+                                         m_mesh_dim,
+                                         m_block_size);
+
+        if (m_exec_conf->isCUDAErrorCheckingEnabled())
+            CHECK_CUDA_ERROR();
+        }
+
+#ifdef ENABLE_MPI
+    if (m_pdata->getDomainDecomposition())
+        {
+        ArrayHandle<hipfftComplex> h_mesh(m_mesh, access_location::host, access_mode::readwrite);
+        reduceMesh((float*)h_mesh.data);
+        }
+#endif
+
+    Scalar3 b1, b2, b3;
+    getReciprocalLattice(b1, b2, b3);
+
+        {
+        ArrayHandle<hipfftComplex> d_mesh(m_mesh, access_location::device, access_mode::readwrite);
+
+#ifdef __HIP_PLATFORM_HCC__
+        checkHIPFFTResult(hipfftExecC2C(m_hipfft_plan, d_mesh.data, d_mesh.data, HIPFFT_FORWARD),
+                          __FILE__,
+                          __LINE__);
+#else
+        checkHIPFFTResult(cufftExecC2C(m_hipfft_plan, d_mesh.data, d_mesh.data, CUFFT_FORWARD),
+                          __FILE__,
+                          __LINE__);
+#endif
+
+        ArrayHandle<Scalar> d_shell_sum(m_shell_sum,
+                                        access_location::device,
+                                        access_mode::overwrite);
+        ArrayHandle<unsigned int> d_shell_count(m_shell_count,
+                                                access_location::device,
+                                                access_mode::overwrite);
+        hipMemset(d_shell_sum.data, 0, sizeof(Scalar) * m_bins);
+        hipMemset(d_shell_count.data, 0, sizeof(unsigned int) * m_bins);
+
+        gpu_compute_structure_factor_shells(d_shell_sum.data,
+                                            d_shell_count.data,
+                                            d_mesh.data,
+                                            m_mesh_dim,
+                                            b1,
+                                            b2,
+                                            b3,
+                                            m_bins,
+                                            m_q_max,
+                                            m_block_size);
+
+        if (m_exec_conf->isCUDAErrorCheckingEnabled())
+            CHECK_CUDA_ERROR();
+        }
+
+    ArrayHandle<Scalar> h_shell_sum(m_shell_sum, access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_shell_count(m_shell_count,
+                                            access_location::host,
+                                            access_mode::read);
+    for (unsigned int bin = 0; bin < m_bins; bin++)
+        {
+        shell_sum[bin] = h_shell_sum.data[bin];
+        shell_count[bin] = h_shell_count.data[bin];
+        }
+    }
+
+void export_ComputeStructureFactorGPU(py::module& m)
+    {
+    py::class_<ComputeStructureFactorGPU,
+               ComputeStructureFactor,
+               std::shared_ptr<ComputeStructureFactorGPU>>(m, "ComputeStructureFactorGPU")
+        .def(py::init<std::shared_ptr<SystemDefinition>,
+                      std::shared_ptr<ParticleGroup>,
+                      unsigned int,
+                      unsigned int,
+                      unsigned int,
+                      unsigned int,
+                      Scalar>());
+    }
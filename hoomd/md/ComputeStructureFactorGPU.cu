@@ -0,0 +1,196 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "ComputeStructureFactorGPU.cuh"
+#include "ComputeStructureFactorTypes.h"
+
+/*! \file ComputeStructureFactorGPU.cu
+    \brief Defines GPU kernel code for computing the static structure factor. Used by
+    ComputeStructureFactorGPU.
+*/
+
+//! Assign the group members to the density mesh
+/*! \param d_mesh Density mesh to add to, with x varying fastest
+    \param d_pos Particle positions
+    \param d_index_array Indices of the group members
+    \param group_size Number of local group members
+    \param box Global simulation box
+    \param mesh_dim Number of mesh points along each axis
+
+    One thread is executed per group member.
+*/
+__global__ void gpu_assign_structure_factor_mesh_kernel(hipfftComplex* d_mesh,
+                                                        const Scalar4* d_pos,
+                                                        const unsigned int* d_index_array,
+                                                        const unsigned int group_size,
+                                                        const BoxDim box,
+                                                        const uint3 mesh_dim)
+    {
+    unsigned int group_idx = blockIdx.x * blockDim.x + threadIdx.x;
+
+    if (group_idx >= group_size)
+        return;
+
+    const Scalar4 postype = d_pos[d_index_array[group_idx]];
+    const Scalar3 f = box.makeFraction(make_scalar3(postype.x, postype.y, postype.z));
+
+    unsigned int ix[2], iy[2], iz[2];
+    Scalar wx[2], wy[2], wz[2];
+    structure_factor_cic_weights(f.x, mesh_dim.x, ix[0], ix[1], wx[0], wx[1]);
+    structure_factor_cic_weights(f.y, mesh_dim.y, iy[0], iy[1], wy[0], wy[1]);
+    structure_factor_cic_weights(f.z, mesh_dim.z, iz[0], iz[1], wz[0], wz[1]);
+
+    for (unsigned int a = 0; a < 2; a++)
+        for (unsigned int b = 0; b < 2; b++)
+            for (unsigned int c = 0; c < 2; c++)
+                {
+                const unsigned int cell = ix[a] + mesh_dim.x * (iy[b] + mesh_dim.y * iz[c]);
+                atomicAdd(&d_mesh[cell].x, float(wx[a] * wy[b] * wz[c]));
+                }
+    }
+
+//! Sum the corrected |rho(q)|^2 in shells of |q|
+/*! \param d_shell_sum Sum of |rho(q)|^2 / W(q)^2 in each bin
+    \param d_shell_count Number of wave vectors in each bin
+    \param d_mesh Transformed density mesh, with x varying fastest
+    \param mesh_dim Number of mesh points along each axis
+    \param b1 First reciprocal lattice vector
+    \param b2 Second reciprocal lattice vector
+    \param b3 Third reciprocal lattice vector
+    \param bins Number of bins
+    \param q_max Maximum wave vector magnitude
+
+    One thread is executed per mesh point.
+*/
+__global__ void gpu_compute_structure_factor_shells_kernel(Scalar* d_shell_sum,
+                                                           unsigned int* d_shell_count,
+                                                           const hipfftComplex* d_mesh,
+                                                           const uint3 mesh_dim,
+                                                           const Scalar3 b1,
+                                                           const Scalar3 b2,
+                                                           const Scalar3 b3,
+                                                           const unsigned int bins,
+                                                           const Scalar q_max)
+    {
+    unsigned int idx = blockIdx.x * blockDim.x + threadIdx.x;
+
+    if (idx >= mesh_dim.x * mesh_dim.y * mesh_dim.z)
+        return;
+
+    const unsigned int x = idx % mesh_dim.x;
+    const unsigned int y = (idx / mesh_dim.x) % mesh_dim.y;
+    const unsigned int z = idx / (mesh_dim.x * mesh_dim.y);
+    const int mx = structure_factor_wave_index(x, mesh_dim.x);
+    const int my = structure_factor_wave_index(y, mesh_dim.y);
+    const int mz = structure_factor_wave_index(z, mesh_dim.z);
+
+    const Scalar3 q = Scalar(mx) * b1 + Scalar(my) * b2 + Scalar(mz) * b3;
+    const Scalar qsq = dot(q, q);
+    if (qsq == Scalar(0.0) || qsq >= q_max * q_max)
+        return;
+
+    const unsigned int bin = (unsigned int)(fast::sqrt(qsq) * Scalar(bins) / q_max);
+    if (bin >= bins)
+        return;
+
+    const Scalar window = structure_factor_cic_window(mx, mesh_dim.x)
+                          * structure_factor_cic_window(my, mesh_dim.y)
+                          * structure_factor_cic_window(mz, mesh_dim.z);
+
+    const hipfftComplex rho = d_mesh[idx];
+    atomicAdd(&d_shell_sum[bin], Scalar(rho.x * rho.x + rho.y * rho.y) / (window * window));
+    atomicAdd(&d_shell_count[bin], 1u);
+    }
+
+/*! \param d_mesh Density mesh to add to (must be zeroed by the caller)
+    \param d_pos Particle positions
+    \param d_index_array Indices of the group members
+    \param group_size Number of local group members
+    \param box Global simulation box
+    \param mesh_dim Number of mesh points along each axis
+    \param block_size Number of threads per block
+*/
+hipError_t gpu_assign_structure_factor_mesh(hipfftComplex* d_mesh,
+                                            const Scalar4* d_pos,
+                                            const unsigned int* d_index_array,
+                                            const unsigned int group_size,
+                                            const BoxDim& box,
+                                            const uint3 mesh_dim,
+                                            const unsigned int block_size)
+    {
+    if (group_size == 0)
+        return hipSuccess;
+
+    unsigned int max_block_size;
+    hipFuncAttributes attr;
+    hipFuncGetAttributes(&attr, (const void*)gpu_assign_structure_factor_mesh_kernel);
+    max_block_size = attr.maxThreadsPerBlock;
+
+    unsigned int run_block_size = min(block_size, max_block_size);
+    dim3 grid(group_size / run_block_size + 1, 1, 1);
+    dim3 threads(run_block_size, 1, 1);
+
+    hipLaunchKernelGGL((gpu_assign_structure_factor_mesh_kernel),
+                       grid,
+                       threads,
+                       0,
+                       0,
+                       d_mesh,
+                       d_pos,
+                       d_index_array,
+                       group_size,
+                       box,
+                       mesh_dim);
+
+    return hipSuccess;
+    }
+
+/*! \param d_shell_sum Sum of |rho(q)|^2 / W(q)^2 in each bin (must be zeroed by the caller)
+    \param d_shell_count Number of wave vectors in each bin (must be zeroed by the caller)
+    \param d_mesh Transformed density mesh
+    \param mesh_dim Number of mesh points along each axis
+    \param b1 First reciprocal lattice vector
+    \param b2 Second reciprocal lattice vector
+    \param b3 Third reciprocal lattice vector
+    \param bins Number of bins
+    \param q_max Maximum wave vector magnitude
+    \param block_size Number of threads per block
+*/
+hipError_t gpu_compute_structure_factor_shells(Scalar* d_shell_sum,
+                                               unsigned int* d_shell_count,
+                                               const hipfftComplex* d_mesh,
+                                               const uint3 mesh_dim,
+                                               const Scalar3 b1,
+                                               const Scalar3 b2,
+                                               const Scalar3 b3,
+                                               const unsigned int bins,
+                                               const Scalar q_max,
+                                               const unsigned int block_size)
+    {
+    unsigned int max_block_size;
+    hipFuncAttributes attr;
+    hipFuncGetAttributes(&attr, (const void*)gpu_compute_structure_factor_shells_kernel);
+    max_block_size = attr.maxThreadsPerBlock;
+
+    const unsigned int n_points = mesh_dim.x * mesh_dim.y * mesh_dim.z;
+    unsigned int run_block_size = min(block_size, max_block_size);
+    dim3 grid(n_points / run_block_size + 1, 1, 1);
+    dim3 threads(run_block_size, 1, 1);
+
+    hipLaunchKernelGGL((gpu_compute_structure_factor_shells_kernel),
+                       grid,
+                       threads,
+                       0,
+                       0,
+                       d_shell_sum,
+                       d_shell_count,
+                       d_mesh,
+                       mesh_dim,
+                       b1,
+                       b2,
+                       b3,
+                       bins,
+                       q_max);
+
+    return hipSuccess;
+    }
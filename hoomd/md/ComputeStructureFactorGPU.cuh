@@ -0,0 +1,44 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#ifndef _COMPUTE_STRUCTURE_FACTOR_GPU_CUH_
+#define _COMPUTE_STRUCTURE_FACTOR_GPU_CUH_
+
+#include <hip/hip_runtime.h>
+
+#if __HIP_PLATFORM_HCC__
+#include <hipfft.h>
+#elif __HIP_PLATFORM_NVCC__
+#include <cufft.h>
+typedef cufftComplex hipfftComplex;
+#endif
+
+#include "hoomd/BoxDim.h"
+#include "hoomd/HOOMDMath.h"
+
+/*! \file ComputeStructureFactorGPU.cuh
+    \brief Kernel driver function declarations for ComputeStructureFactorGPU
+*/
+
+//! Assign the group members to the density mesh with cloud in cell weights
+hipError_t gpu_assign_structure_factor_mesh(hipfftComplex* d_mesh,
+                                            const Scalar4* d_pos,
+                                            const unsigned int* d_index_array,
+                                            const unsigned int group_size,
+                                            const BoxDim& box,
+                                            const uint3 mesh_dim,
+                                            const unsigned int block_size);
+
+//! Sum the corrected |rho(q)|^2 of the transformed mesh in shells of |q|
+hipError_t gpu_compute_structure_factor_shells(Scalar* d_shell_sum,
+                                               unsigned int* d_shell_count,
+                                               const hipfftComplex* d_mesh,
+                                               const uint3 mesh_dim,
+                                               const Scalar3 b1,
+                                               const Scalar3 b2,
+                                               const Scalar3 b3,
+                                               const unsigned int bins,
+                                               const Scalar q_max,
+                                               const unsigned int block_size);
+
+#endif
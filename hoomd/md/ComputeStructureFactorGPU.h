@@ -0,0 +1,69 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "ComputeStructureFactor.h"
+
+#ifndef __COMPUTE_STRUCTURE_FACTOR_GPU_H__
+#define __COMPUTE_STRUCTURE_FACTOR_GPU_H__
+
+#ifdef ENABLE_HIP
+
+#if __HIP_PLATFORM_HCC__
+#include <hipfft.h>
+#elif __HIP_PLATFORM_NVCC__
+#include <cufft.h>
+typedef cufftComplex hipfftComplex;
+typedef cufftHandle hipfftHandle;
+#endif
+
+/*! \file ComputeStructureFactorGPU.h
+    \brief Declares a class for computing the static structure factor on the GPU
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include <pybind11/pybind11.h>
+
+//! Computes the static structure factor on the GPU
+/*! ComputeStructureFactorGPU assigns the particles to the mesh, transforms it with hipFFT/cuFFT,
+    and sums the shells on the GPU. Only the per bin sums are transferred to the host, except with a
+    domain decomposition, where the mesh is summed over the ranks on the host.
+
+    \ingroup computes
+*/
+class PYBIND11_EXPORT ComputeStructureFactorGPU : public ComputeStructureFactor
+    {
+    public:
+    //! Constructs the compute
+    ComputeStructureFactorGPU(std::shared_ptr<SystemDefinition> sysdef,
+                              std::shared_ptr<ParticleGroup> group,
+                              unsigned int nx,
+                              unsigned int ny,
+                              unsigned int nz,
+                              unsigned int bins,
+                              Scalar q_max);
+
+    //! Destructor
+    virtual ~ComputeStructureFactorGPU();
+
+    protected:
+    //! Compute the shell sums on the GPU
+    virtual void computeShellSums(std::vector<double>& shell_sum,
+                                  std::vector<unsigned int>& shell_count);
+
+    private:
+    hipfftHandle m_hipfft_plan;              //!< The FFT plan
+    bool m_hipfft_initialized;               //!< True if the FFT plan has been created
+    GlobalArray<hipfftComplex> m_mesh;       //!< The particle density mesh, transformed in place
+    GlobalArray<Scalar> m_shell_sum;         //!< Sum of |rho(q)|^2 / W(q)^2 in each bin
+    GlobalArray<unsigned int> m_shell_count; //!< Number of wave vectors in each bin
+    unsigned int m_block_size;               //!< Block size executed
+    };
+
+//! Exports the ComputeStructureFactorGPU class to python
+void export_ComputeStructureFactorGPU(pybind11::module& m);
+
+#endif // ENABLE_HIP
+#endif // __COMPUTE_STRUCTURE_FACTOR_GPU_H__
@@ -0,0 +1,62 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#ifndef _COMPUTE_STRUCTURE_FACTOR_TYPES_H_
+#define _COMPUTE_STRUCTURE_FACTOR_TYPES_H_
+
+#include "hoomd/HOOMDMath.h"
+
+/*! \file ComputeStructureFactorTypes.h
+    \brief Helper functions common to both CPU and GPU implementations of ComputeStructureFactor
+*/
+
+//! Find the cloud in cell weights of a particle along one mesh axis
+/*! \param f Fractional coordinate of the particle along the axis
+    \param n Number of mesh points along the axis
+    \param i0 Output: index of the first mesh point
+    \param i1 Output: index of the second mesh point
+    \param w0 Output: weight of the first mesh point
+    \param w1 Output: weight of the second mesh point
+
+    Mesh point i is located at the fractional coordinate (i + 1/2) / n.
+*/
+HOSTDEVICE inline void structure_factor_cic_weights(Scalar f,
+                                                    unsigned int n,
+                                                    unsigned int& i0,
+                                                    unsigned int& i1,
+                                                    Scalar& w0,
+                                                    Scalar& w1)
+    {
+    Scalar u = f * Scalar(n) - Scalar(0.5);
+    Scalar u_floor = floor(u);
+    w1 = u - u_floor;
+    w0 = Scalar(1.0) - w1;
+
+    int c = int(u_floor) % int(n);
+    if (c < 0)
+        c += n;
+    i0 = c;
+    i1 = (i0 + 1) % n;
+    }
+
+//! Get the signed wave number of mesh point i along an axis with n points
+HOSTDEVICE inline int structure_factor_wave_index(unsigned int i, unsigned int n)
+    {
+    return (i <= n / 2) ? int(i) : int(i) - int(n);
+    }
+
+//! Fourier transform of the cloud in cell assignment function along one axis
+/*! \param m Signed wave number
+    \param n Number of mesh points along the axis
+*/
+HOSTDEVICE inline Scalar structure_factor_cic_window(int m, unsigned int n)
+    {
+    if (m == 0)
+        return Scalar(1.0);
+
+    Scalar x = Scalar(M_PI) * Scalar(m) / Scalar(n);
+    Scalar sinc = fast::sin(x) / x;
+    return sinc * sinc;
+    }
+
+#endif
@@ -15,11 +15,44 @@
 #include "hoomd/HOOMDMPI.h"
 #endif
 
+#ifdef ENABLE_TBB
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_reduce.h>
+#endif
+
 namespace py = pybind11;
 
 #include <iostream>
 using namespace std;
 
+namespace
+    {
+//! Sums over the group members accumulated by ComputeThermo::computeProperties()
+struct ThermoSums
+    {
+    double ke_trans = 0.0;              //!< Twice the translational kinetic energy
+    double pressure_kinetic[6] = {0.0}; //!< Kinetic part of the pressure tensor
+    double ke_rot = 0.0;                //!< Twice the rotational kinetic energy
+    double pe = 0.0;                    //!< Potential energy
+    double virial[6] = {0.0};           //!< Virial tensor
+    double hma_fdr = 0.0;               //!< Sum of F.(r - r_lattice) for HMA
+
+    ThermoSums& operator+=(const ThermoSums& other)
+        {
+        ke_trans += other.ke_trans;
+        ke_rot += other.ke_rot;
+        pe += other.pe;
+        hma_fdr += other.hma_fdr;
+        for (unsigned int k = 0; k < 6; k++)
+            {
+            pressure_kinetic[k] += other.pressure_kinetic[k];
+            virial[k] += other.virial[k];
+            }
+        return *this;
+        }
+    };
+    } // end anonymous namespace
+
 /*! \param sysdef System for which to compute thermodynamic properties
     \param group Subset of the system over which properties are calculated
 */
@@ -46,7 +79,9 @@ ComputeThermo::ComputeThermo(std::shared_ptr<SystemDefinition> sysdef,
         }
 #endif
 
-    m_computed_flags.reset();
+    m_computed_quantities = 0;
+    m_hma_temperature = 0.0;
+    m_harmonic_pressure = 0.0;
 
 #ifdef ENABLE_MPI
     m_properties_reduced = true;
@@ -58,22 +93,56 @@ ComputeThermo::~ComputeThermo()
     m_exec_conf->msg->notice(5) << "Destroying ComputeThermo" << endl;
     }
 
-/*! Calls computeProperties if the properties need updating
+/*! Computes all quantities that the particle data flags make available
     \param timestep Current time step of the simulation
 */
 void ComputeThermo::compute(uint64_t timestep)
+    {
+    computeQuantities(timestep, thermo_quantity::all);
+    }
+
+/*! \param timestep Current time step of the simulation
+    \param quantities Groups of quantities to compute (thermo_quantity flags)
+
+    Evaluates the requested groups that are not yet known on this time step, together with the ones
+    that are, in one pass over the particles and (with MPI) one reduction. The kinetic and potential
+    energy are always included. The pressure and rotational kinetic energy are only available when
+    the corresponding particle data flags are set, the HMA estimators only after setLatticeSites().
+*/
+void ComputeThermo::computeQuantities(uint64_t timestep, unsigned int quantities)
     {
     Compute::compute(timestep);
     if (shouldCompute(timestep))
         {
-        computeProperties();
-        m_computed_flags = m_pdata->getFlags();
+        m_computed_quantities = 0;
         }
+
+    PDataFlags flags = m_pdata->getFlags();
+    quantities |= thermo_quantity::kinetic_energy;
+    if (!flags[pdata_flag::pressure_tensor])
+        {
+        quantities &= ~(thermo_quantity::pressure | thermo_quantity::pressure_tensor);
+        }
+    if (!flags[pdata_flag::rotational_kinetic_energy])
+        {
+        quantities &= ~thermo_quantity::rotational_kinetic_energy;
+        }
+    if (m_lattice_site.isNull())
+        {
+        quantities &= ~thermo_quantity::hma;
+        }
+
+    if ((quantities & ~m_computed_quantities) == 0)
+        return;
+
+    quantities |= m_computed_quantities;
+    computeProperties(quantities);
+    m_computed_quantities = quantities;
     }
 
-/*! Computes all thermodynamic properties of the system in one fell swoop.
+/*! Computes the requested thermodynamic properties of the system in one fell swoop.
  */
-void ComputeThermo::computeProperties()
+void ComputeThermo::computeProperties(unsigned int quantities)
     {
     // just drop out if the group is an empty group
     if (m_group->getNumMembersGlobal() == 0)
@@ -86,6 +155,11 @@ void ComputeThermo::computeProperties()
 
     assert(m_pdata);
 
+    // access the group members before the tag array, which may be used to rebuild them
+    ArrayHandle<unsigned int> h_index(m_group->getIndexArray(),
+                                      access_location::host,
+                                      access_mode::read);
+
     // access the particle data
     ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(), access_location::host, access_mode::read);
     ArrayHandle<unsigned int> h_body(m_pdata->getBodies(),
@@ -99,80 +173,80 @@ void ComputeThermo::computeProperties()
     ArrayHandle<Scalar4> h_net_force(net_force, access_location::host, access_mode::read);
     ArrayHandle<Scalar> h_net_virial(net_virial, access_location::host, access_mode::read);
 
-    // total kinetic energy
-    double ke_trans_total = 0.0;
-
-    PDataFlags flags = m_pdata->getFlags();
-
-    double pressure_kinetic_xx = 0.0;
-    double pressure_kinetic_xy = 0.0;
-    double pressure_kinetic_xz = 0.0;
-    double pressure_kinetic_yy = 0.0;
-    double pressure_kinetic_yz = 0.0;
-    double pressure_kinetic_zz = 0.0;
-
-    if (flags[pdata_flag::pressure_tensor])
+    ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(),
+                                       access_location::host,
+                                       access_mode::read);
+    ArrayHandle<Scalar4> h_angmom(m_pdata->getAngularMomentumArray(),
+                                  access_location::host,
+                                  access_mode::read);
+    ArrayHandle<Scalar3> h_inertia(m_pdata->getMomentsOfInertiaArray(),
+                                   access_location::host,
+                                   access_mode::read);
+
+    const bool compute_pressure_tensor = quantities & thermo_quantity::pressure_tensor;
+    const bool compute_pressure = quantities & thermo_quantity::pressure;
+    const bool compute_ke_rot = quantities & thermo_quantity::rotational_kinetic_energy;
+    const bool compute_hma = quantities & thermo_quantity::hma;
+    const size_t virial_pitch = net_virial.getPitch();
+
+    // the HMA displacements are only needed for the HMA estimators
+    std::unique_ptr<ArrayHandle<Scalar4>> h_pos;
+    std::unique_ptr<ArrayHandle<int3>> h_image;
+    std::unique_ptr<ArrayHandle<Scalar3>> h_lattice_site;
+    if (compute_hma)
         {
-        // Calculate kinetic part of pressure tensor
-        for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
-            {
-            unsigned int j = m_group->getMemberIndex(group_idx);
-            // ignore rigid body constituent particles in the sum
-            if (h_body.data[j] >= MIN_FLOPPY || h_body.data[j] == h_tag.data[j])
-                {
-                double mass = h_vel.data[j].w;
-                pressure_kinetic_xx += mass * ((double)h_vel.data[j].x * (double)h_vel.data[j].x);
-                pressure_kinetic_xy += mass * ((double)h_vel.data[j].x * (double)h_vel.data[j].y);
-                pressure_kinetic_xz += mass * ((double)h_vel.data[j].x * (double)h_vel.data[j].z);
-                pressure_kinetic_yy += mass * ((double)h_vel.data[j].y * (double)h_vel.data[j].y);
-                pressure_kinetic_yz += mass * ((double)h_vel.data[j].y * (double)h_vel.data[j].z);
-                pressure_kinetic_zz += mass * ((double)h_vel.data[j].z * (double)h_vel.data[j].z);
-                }
-            }
-        // kinetic energy = 1/2 trace of kinetic part of pressure tensor
-        ke_trans_total
-            = Scalar(0.5) * (pressure_kinetic_xx + pressure_kinetic_yy + pressure_kinetic_zz);
+        h_pos.reset(new ArrayHandle<Scalar4>(m_pdata->getPositions(),
+                                             access_location::host,
+                                             access_mode::read));
+        h_image.reset(new ArrayHandle<int3>(m_pdata->getImages(),
+                                            access_location::host,
+                                            access_mode::read));
+        h_lattice_site.reset(
+            new ArrayHandle<Scalar3>(m_lattice_site, access_location::host, access_mode::read));
         }
-    else
-        {
-        // total kinetic energy
-        for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
+    const BoxDim& global_box = m_pdata->getGlobalBox();
+
+    // accumulate all sums in a single pass over the group members
+    auto sum_members = [&](unsigned int begin, unsigned int end, ThermoSums& sums)
+    {
+        for (unsigned int group_idx = begin; group_idx < end; group_idx++)
             {
-            unsigned int j = m_group->getMemberIndex(group_idx);
+            unsigned int j = h_index.data[group_idx];
+
             // ignore rigid body constituent particles in the sum
-            if (h_body.data[j] >= MIN_FLOPPY || h_body.data[j] == h_tag.data[j])
+            if (h_body.data[j] < MIN_FLOPPY && h_body.data[j] != h_tag.data[j])
+                continue;
+
+            double mass = h_vel.data[j].w;
+            double vx = h_vel.data[j].x;
+            double vy = h_vel.data[j].y;
+            double vz = h_vel.data[j].z;
+            if (compute_pressure_tensor)
                 {
-                ke_trans_total += (double)h_vel.data[j].w
-                                  * ((double)h_vel.data[j].x * (double)h_vel.data[j].x
-                                     + (double)h_vel.data[j].y * (double)h_vel.data[j].y
-                                     + (double)h_vel.data[j].z * (double)h_vel.data[j].z);
+                sums.pressure_kinetic[0] += mass * (vx * vx);
+                sums.pressure_kinetic[1] += mass * (vx * vy);
+                sums.pressure_kinetic[2] += mass * (vx * vz);
+                sums.pressure_kinetic[3] += mass * (vy * vy);
+                sums.pressure_kinetic[4] += mass * (vy * vz);
+                sums.pressure_kinetic[5] += mass * (vz * vz);
+
+                for (unsigned int k = 0; k < 6; k++)
+                    sums.virial[k] += (double)h_net_virial.data[j + k * virial_pitch];
                 }
-            }
-
-        ke_trans_total *= Scalar(0.5);
-        }
-
-    // total rotational kinetic energy
-    double ke_rot_total = 0.0;
+            else
+                {
+                sums.ke_trans += mass * (vx * vx + vy * vy + vz * vz);
 
-    if (flags[pdata_flag::rotational_kinetic_energy])
-        {
-        // Calculate rotational part of kinetic energy
-        ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(),
-                                           access_location::host,
-                                           access_mode::read);
-        ArrayHandle<Scalar4> h_angmom(m_pdata->getAngularMomentumArray(),
-                                      access_location::host,
-                                      access_mode::read);
-        ArrayHandle<Scalar3> h_inertia(m_pdata->getMomentsOfInertiaArray(),
-                                       access_location::host,
-                                       access_mode::read);
+                // the isotropic pressure only needs the diagonal of the virial
+                if (compute_pressure)
+                    {
+                    sums.virial[0] += (double)h_net_virial.data[j + 0 * virial_pitch];
+                    sums.virial[3] += (double)h_net_virial.data[j + 3 * virial_pitch];
+                    sums.virial[5] += (double)h_net_virial.data[j + 5 * virial_pitch];
+                    }
+                }
 
-        for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
-            {
-            unsigned int j = m_group->getMemberIndex(group_idx);
-            // ignore rigid body constituent particles in the sum
-            if (h_body.data[j] >= MIN_FLOPPY || h_body.data[j] == h_tag.data[j])
+            if (compute_ke_rot)
                 {
                 Scalar3 I = h_inertia.data[j];
                 quat<Scalar> q(h_orientation.data[j]);
@@ -183,72 +257,95 @@ void ComputeThermo::computeProperties()
                 // carries angular momentum
                 if (I.x >= EPSILON)
                     {
-                    ke_rot_total += s.v.x * s.v.x / I.x;
+                    sums.ke_rot += s.v.x * s.v.x / I.x;
                     }
                 if (I.y >= EPSILON)
                     {
-                    ke_rot_total += s.v.y * s.v.y / I.y;
+                    sums.ke_rot += s.v.y * s.v.y / I.y;
                     }
                 if (I.z >= EPSILON)
                     {
-                    ke_rot_total += s.v.z * s.v.z / I.z;
+                    sums.ke_rot += s.v.z * s.v.z / I.z;
                     }
                 }
-            }
 
-        ke_rot_total /= Scalar(2.0);
-        }
+            if (compute_hma)
+                {
+                Scalar4 postype = h_pos->data[j];
+                Scalar3 pos = make_scalar3(postype.x, postype.y, postype.z);
+                Scalar3 dr = global_box.shift(pos, h_image->data[j])
+                             - h_lattice_site->data[h_tag.data[j]];
+                sums.hma_fdr += (double)h_net_force.data[j].x * dr.x
+                                + (double)h_net_force.data[j].y * dr.y
+                                + (double)h_net_force.data[j].z * dr.z;
+                }
 
-    // total potential energy
-    double pe_total = 0.0;
-    for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
+            sums.pe += (double)h_net_force.data[j].w;
+            }
+    };
+
+    ThermoSums sums;
+#ifdef ENABLE_TBB
+    // a fixed partitioning makes the result independent of the number of threads
+    sums = m_exec_conf->getTaskArena()->execute(
+        [&]
         {
-        unsigned int j = m_group->getMemberIndex(group_idx);
+            return tbb::parallel_deterministic_reduce(
+                tbb::blocked_range<unsigned int>(0, group_size, 1024),
+                ThermoSums(),
+                [&](const tbb::blocked_range<unsigned int>& r, ThermoSums partial)
+                {
+                    sum_members(r.begin(), r.end(), partial);
+                    return partial;
+                },
+                [](ThermoSums a, const ThermoSums& b)
+                {
+                    a += b;
+                    return a;
+                });
+        });
+#else
+    sum_members(0, group_size, sums);
+#endif
 
-        // ignore rigid body constituent particles in the sum
-        if (h_body.data[j] >= MIN_FLOPPY || h_body.data[j] == h_tag.data[j])
-            {
-            pe_total += (double)h_net_force.data[j].w;
-            }
+    double pressure_kinetic_xx = sums.pressure_kinetic[0];
+    double pressure_kinetic_xy = sums.pressure_kinetic[1];
+    double pressure_kinetic_xz = sums.pressure_kinetic[2];
+    double pressure_kinetic_yy = sums.pressure_kinetic[3];
+    double pressure_kinetic_yz = sums.pressure_kinetic[4];
+    double pressure_kinetic_zz = sums.pressure_kinetic[5];
+
+    // total kinetic energy
+    double ke_trans_total = Scalar(0.5) * sums.ke_trans;
+    if (compute_pressure_tensor)
+        {
+        // kinetic energy = 1/2 trace of kinetic part of pressure tensor
+        ke_trans_total
+            = Scalar(0.5) * (pressure_kinetic_xx + pressure_kinetic_yy + pressure_kinetic_zz);
         }
 
-    pe_total += m_pdata->getExternalEnergy();
+    // total rotational kinetic energy
+    double ke_rot_total = sums.ke_rot / Scalar(2.0);
+
+    // total potential energy
+    double pe_total = sums.pe + m_pdata->getExternalEnergy();
 
     double W = 0.0;
-    double virial_xx = m_pdata->getExternalVirial(0);
-    double virial_xy = m_pdata->getExternalVirial(1);
-    double virial_xz = m_pdata->getExternalVirial(2);
-    double virial_yy = m_pdata->getExternalVirial(3);
-    double virial_yz = m_pdata->getExternalVirial(4);
-    double virial_zz = m_pdata->getExternalVirial(5);
-
-    if (flags[pdata_flag::pressure_tensor])
+    double virial_xx = m_pdata->getExternalVirial(0) + sums.virial[0];
+    double virial_xy = m_pdata->getExternalVirial(1) + sums.virial[1];
+    double virial_xz = m_pdata->getExternalVirial(2) + sums.virial[2];
+    double virial_yy = m_pdata->getExternalVirial(3) + sums.virial[3];
+    double virial_yz = m_pdata->getExternalVirial(4) + sums.virial[4];
+    double virial_zz = m_pdata->getExternalVirial(5) + sums.virial[5];
+
+    if (compute_pressure_tensor || compute_pressure)
         {
-        // Calculate upper triangular virial tensor
-        size_t virial_pitch = net_virial.getPitch();
-        for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
-            {
-            unsigned int j = m_group->getMemberIndex(group_idx);
-            // ignore rigid body constituent particles in the sum
-            if (h_body.data[j] >= MIN_FLOPPY || h_body.data[j] == h_tag.data[j])
-                {
-                virial_xx += (double)h_net_virial.data[j + 0 * virial_pitch];
-                virial_xy += (double)h_net_virial.data[j + 1 * virial_pitch];
-                virial_xz += (double)h_net_virial.data[j + 2 * virial_pitch];
-                virial_yy += (double)h_net_virial.data[j + 3 * virial_pitch];
-                virial_yz += (double)h_net_virial.data[j + 4 * virial_pitch];
-                virial_zz += (double)h_net_virial.data[j + 5 * virial_pitch];
-                }
-            }
-
         // isotropic virial = 1/3 trace of virial tensor
         W = Scalar(1. / 3.) * (virial_xx + virial_yy + virial_zz);
         }
 
     // compute the pressure
     // volume/area & other 2D stuff needed
-    BoxDim global_box = m_pdata->getGlobalBox();
-
     Scalar3 L = global_box.getL();
     Scalar volume;
     unsigned int D = m_sysdef->getNDimensions();
@@ -287,6 +384,7 @@ void ComputeThermo::computeProperties()
     h_properties.data[thermo_index::pressure_yy] = pressure_yy;
     h_properties.data[thermo_index::pressure_yz] = pressure_yz;
     h_properties.data[thermo_index::pressure_zz] = pressure_zz;
+    h_properties.data[thermo_index::hma_force_displacement] = Scalar(sums.hma_fdr);
 
 #ifdef ENABLE_MPI
     // in MPI, reduce extensive quantities only when they're needed
@@ -297,6 +395,42 @@ void ComputeThermo::computeProperties()
         m_prof->pop();
     }
 
+/*! Saves the unwrapped position of every particle, indexed by tag, as the lattice site from which
+    the HMA estimators measure displacements. Enables the thermo_quantity::hma group.
+*/
+void ComputeThermo::setLatticeSites()
+    {
+    BoxDim box = m_pdata->getGlobalBox();
+
+    SnapshotParticleData<Scalar> snapshot;
+    m_pdata->takeSnapshot(snapshot);
+
+#ifdef ENABLE_MPI
+    // when the simulation is decomposed on multiple ranks
+    if (m_pdata->getDomainDecomposition())
+        {
+        // broadcast the snapshot so the particle positions are available on all ranks
+        snapshot.bcast(0, m_exec_conf->getMPICommunicator());
+        }
+#endif
+
+    GlobalArray<Scalar3> lattice_site(snapshot.size, m_exec_conf);
+    m_lattice_site.swap(lattice_site);
+    TAG_ALLOCATION(m_lattice_site);
+
+    ArrayHandle<Scalar3> h_lattice_site(m_lattice_site,
+                                        access_location::host,
+                                        access_mode::overwrite);
+    for (unsigned int tag = 0; tag < snapshot.size; tag++)
+        {
+        vec3<Scalar> unwrapped = box.shift(snapshot.pos[tag], snapshot.image[tag]);
+        h_lattice_site.data[tag] = make_scalar3(unwrapped.x, unwrapped.y, unwrapped.z);
+        }
+
+    // the lattice sites change the HMA estimators on the current step
+    m_computed_quantities &= ~thermo_quantity::hma;
+    }
+
 #ifdef ENABLE_MPI
 void ComputeThermo::reduceProperties()
     {
@@ -316,10 +450,45 @@ void ComputeThermo::reduceProperties()
     }
 #endif
 
+/*! \param quantity Name of the quantity, as in the Python property
+    \returns A function returning the value, or an empty function for unknown quantities
+*/
+std::function<Scalar()> ComputeThermo::getLogScalar(const std::string& quantity)
+    {
+    if (quantity == "kinetic_temperature")
+        return [this]() { return getTemperature(); };
+    if (quantity == "pressure")
+        return [this]() { return getPressure(); };
+    if (quantity == "kinetic_energy")
+        return [this]() { return getKineticEnergy(); };
+    if (quantity == "translational_kinetic_energy")
+        return [this]() { return getTranslationalKineticEnergy(); };
+    if (quantity == "rotational_kinetic_energy")
+        return [this]() { return getRotationalKineticEnergy(); };
+    if (quantity == "potential_energy")
+        return [this]() { return getPotentialEnergy(); };
+    if (quantity == "volume")
+        return [this]() { return getVolume(); };
+    if (quantity == "degrees_of_freedom")
+        return [this]() { return Scalar(getNDOF()); };
+    if (quantity == "num_particles")
+        return [this]() { return Scalar(getNumParticles()); };
+    return Compute::getLogScalar(quantity);
+    }
+
 void export_ComputeThermo(py::module& m)
     {
+    py::enum_<thermo_quantity::Enum>(m, "ThermoQuantity", py::arithmetic())
+        .value("kinetic_energy", thermo_quantity::kinetic_energy)
+        .value("rotational_kinetic_energy", thermo_quantity::rotational_kinetic_energy)
+        .value("pressure", thermo_quantity::pressure)
+        .value("pressure_tensor", thermo_quantity::pressure_tensor)
+        .value("hma", thermo_quantity::hma)
+        .value("all", thermo_quantity::all);
+
     py::class_<ComputeThermo, Compute, std::shared_ptr<ComputeThermo>>(m, "ComputeThermo")
         .def(py::init<std::shared_ptr<SystemDefinition>, std::shared_ptr<ParticleGroup>>())
+        .def("computeQuantities", &ComputeThermo::computeQuantities)
         .def_property_readonly("kinetic_temperature", &ComputeThermo::getTemperature)
         .def_property_readonly("pressure", &ComputeThermo::getPressure)
         .def_property_readonly("pressure_tensor", &ComputeThermo::getPressureTensorPython)
@@ -334,5 +503,12 @@ void export_ComputeThermo(py::module& m)
         .def_property_readonly("rotational_kinetic_energy",
                                &ComputeThermo::getRotationalKineticEnergy)
         .def_property_readonly("potential_energy", &ComputeThermo::getPotentialEnergy)
-        .def_property_readonly("volume", &ComputeThermo::getVolume);
+        .def_property_readonly("volume", &ComputeThermo::getVolume)
+        .def("setLatticeSites", &ComputeThermo::setLatticeSites)
+        .def_property("kT", &ComputeThermo::getHMATemperature, &ComputeThermo::setHMATemperature)
+        .def_property("harmonic_pressure",
+                      &ComputeThermo::getHarmonicPressure,
+                      &ComputeThermo::setHarmonicPressure)
+        .def_property_readonly("potential_energy_hma", &ComputeThermo::getPotentialEnergyHMA)
+        .def_property_readonly("pressure_hma", &ComputeThermo::getPressureHMA);
     }
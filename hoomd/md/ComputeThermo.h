@@ -49,6 +49,17 @@
    the number of degrees of freedom from the integrators and sets that value for each ComputeThermo
    so that it is always correct.
 
+    The quantities are grouped by the flags in thermo_quantity. compute() evaluates all groups that
+   the particle data flags make available. Callers that need only some of them, such as the
+   thermostats, call computeQuantities() instead, which evaluates only the groups that are not yet
+   known on the current time step. The getters return NaN (or 0 for the rotational kinetic energy)
+   for groups that have not been evaluated.
+
+    After setLatticeSites(), the same pass also accumulates the force-displacement sum of
+   harmonically mapped averaging (HMA), from which getPotentialEnergyHMA() and getPressureHMA()
+   derive the HMA estimators together with the conventional energy and virial. See Moustafa,
+   Schultz, and Kofke, Phys. Rev. E 92, 043303 (2015).
+
     \ingroup computes
 */
 class PYBIND11_EXPORT ComputeThermo : public Compute
@@ -60,9 +71,15 @@ class PYBIND11_EXPORT ComputeThermo : public Compute
     //! Destructor
     virtual ~ComputeThermo();
 
-    //! Compute the temperature
+    //! Compute all available quantities
     virtual void compute(uint64_t timestep);
 
+    //! Compute the given groups of quantities
+    void computeQuantities(uint64_t timestep, unsigned int quantities);
+
+    //! Get a function that evaluates a scalar loggable quantity
+    virtual std::function<Scalar()> getLogScalar(const std::string& quantity);
+
     //! Returns the overall temperature last computed by compute()
     /*! \returns Instantaneous overall temperature of the system
      */
@@ -118,7 +135,7 @@ class PYBIND11_EXPORT ComputeThermo : public Compute
             reduceProperties();
 #endif
         // return 0.0 if the flags are not valid or we have no rotational DOF
-        if (m_computed_flags[pdata_flag::rotational_kinetic_energy]
+        if ((m_computed_quantities & thermo_quantity::rotational_kinetic_energy)
             && m_group->getRotationalDOF() > 0)
             {
             ArrayHandle<Scalar> h_properties(m_properties,
@@ -138,8 +155,8 @@ class PYBIND11_EXPORT ComputeThermo : public Compute
      */
     Scalar getPressure()
         {
-        // return NaN if the flags are not valid
-        if (m_computed_flags[pdata_flag::pressure_tensor])
+        // return NaN if the pressure was not computed
+        if (m_computed_quantities & (thermo_quantity::pressure | thermo_quantity::pressure_tensor))
             {
 // return the pressure
 #ifdef ENABLE_MPI
@@ -182,8 +199,8 @@ class PYBIND11_EXPORT ComputeThermo : public Compute
             reduceProperties();
 #endif
 
-        // return 0.0 if the flags are not valid
-        if (m_computed_flags[pdata_flag::rotational_kinetic_energy])
+        // return 0.0 if the rotational kinetic energy was not computed
+        if (m_computed_quantities & thermo_quantity::rotational_kinetic_energy)
             {
             ArrayHandle<Scalar> h_properties(m_properties,
                                              access_location::host,
@@ -206,9 +223,9 @@ class PYBIND11_EXPORT ComputeThermo : public Compute
             reduceProperties();
 #endif
 
-        // return only translational component if the flags are not valid
+        // return only translational component if the rotational kinetic energy was not computed
         ArrayHandle<Scalar> h_properties(m_properties, access_location::host, access_mode::read);
-        if (m_computed_flags[pdata_flag::rotational_kinetic_energy])
+        if (m_computed_quantities & thermo_quantity::rotational_kinetic_energy)
             {
             return (h_properties.data[thermo_index::translational_kinetic_energy]
                     + h_properties.data[thermo_index::rotational_kinetic_energy]);
@@ -233,15 +250,96 @@ class PYBIND11_EXPORT ComputeThermo : public Compute
         return h_properties.data[thermo_index::potential_energy];
         }
 
+    //! Returns the HMA potential energy last computed by compute()
+    /*! \returns HMA estimator of the potential energy, or NaN if it is not valid
+     */
+    Scalar getPotentialEnergyHMA()
+        {
+        if (!(m_computed_quantities & thermo_quantity::hma))
+            return std::numeric_limits<Scalar>::quiet_NaN();
+
+#ifdef ENABLE_MPI
+        if (!m_properties_reduced)
+            reduceProperties();
+#endif
+
+        ArrayHandle<Scalar> h_properties(m_properties, access_location::host, access_mode::read);
+        Scalar N = m_group->getNumMembersGlobal();
+        Scalar D = m_sysdef->getNDimensions();
+
+        // harmonic energy of the N-1 independent displacements plus the mapped anharmonic part
+        return h_properties.data[thermo_index::potential_energy]
+               + Scalar(0.5) * h_properties.data[thermo_index::hma_force_displacement]
+               + Scalar(0.5) * D * (N - 1) * m_hma_temperature;
+        }
+
+    //! Returns the HMA pressure last computed by compute()
+    /*! \returns HMA estimator of the pressure, or NaN if it is not valid
+     */
+    Scalar getPressureHMA()
+        {
+        // the HMA pressure needs the virial from the conventional pressure
+        if (!(m_computed_quantities & thermo_quantity::hma)
+            || !(m_computed_quantities
+                 & (thermo_quantity::pressure | thermo_quantity::pressure_tensor)))
+            return std::numeric_limits<Scalar>::quiet_NaN();
+
+#ifdef ENABLE_MPI
+        if (!m_properties_reduced)
+            reduceProperties();
+#endif
+
+        ArrayHandle<Scalar> h_properties(m_properties, access_location::host, access_mode::read);
+        Scalar N = m_group->getNumMembersGlobal();
+        Scalar D = m_sysdef->getNDimensions();
+        Scalar V = getVolume();
+
+        // W / V is the conventional pressure without its kinetic part
+        Scalar virial_pressure
+            = h_properties.data[thermo_index::pressure]
+              - Scalar(2.0) * h_properties.data[thermo_index::translational_kinetic_energy]
+                    / (D * V);
+        Scalar fV = (m_harmonic_pressure / m_hma_temperature - N / V) / (D * (N - 1));
+        return m_harmonic_pressure + virial_pressure
+               + fV * h_properties.data[thermo_index::hma_force_displacement];
+        }
+
+    //! Record the current particle positions as the lattice sites for HMA
+    void setLatticeSites();
+
+    //! Get the temperature that governs the sampling, used by the HMA estimators
+    Scalar getHMATemperature()
+        {
+        return m_hma_temperature;
+        }
+
+    //! Set the temperature that governs the sampling, used by the HMA estimators
+    void setHMATemperature(Scalar kT)
+        {
+        m_hma_temperature = kT;
+        }
+
+    //! Get the harmonic contribution to the HMA pressure
+    Scalar getHarmonicPressure()
+        {
+        return m_harmonic_pressure;
+        }
+
+    //! Set the harmonic contribution to the HMA pressure
+    void setHarmonicPressure(Scalar harmonic_pressure)
+        {
+        m_harmonic_pressure = harmonic_pressure;
+        }
+
     //! Returns the upper triangular virial tensor last computed by compute()
     /*! \returns Instantaneous virial tensor, or virial tensor containing NaN entries if it is
         not available
     */
     PressureTensor getPressureTensor()
         {
-        // return tensor of NaN's if flags are not valid
+        // return tensor of NaN's if the pressure tensor was not computed
         PressureTensor p;
-        if (m_computed_flags[pdata_flag::pressure_tensor])
+        if (m_computed_quantities & thermo_quantity::pressure_tensor)
             {
 #ifdef ENABLE_MPI
             if (!m_properties_reduced)
@@ -331,11 +429,17 @@ class PYBIND11_EXPORT ComputeThermo : public Compute
     std::shared_ptr<ParticleGroup> m_group; //!< Group to compute properties for
     GlobalArray<Scalar> m_properties;       //!< Stores the computed properties
 
-    /// Store the particle data flags used during the last computation
-    PDataFlags m_computed_flags;
+    /// Groups of quantities (thermo_quantity flags) known on the current time step
+    unsigned int m_computed_quantities;
+
+    GlobalArray<Scalar3> m_lattice_site; //!< HMA lattice sites, indexed by tag (null if unset)
+    Scalar m_hma_temperature;            //!< Temperature used by the HMA estimators
+    Scalar m_harmonic_pressure;          //!< Harmonic contribution to the HMA pressure
 
     //! Does the actual computation
-    virtual void computeProperties();
+    /*! \param quantities Groups of quantities to compute (thermo_quantity flags)
+     */
+    virtual void computeProperties(unsigned int quantities);
 
 #ifdef ENABLE_MPI
     bool m_properties_reduced; //!< True if properties have been reduced across MPI
@@ -48,9 +48,10 @@ ComputeThermoGPU::~ComputeThermoGPU()
     hipEventDestroy(m_event);
     }
 
-/*! Computes all thermodynamic properties of the system in one fell swoop, on the GPU.
+/*! Computes the requested thermodynamic properties of the system in one fell swoop, on the GPU.
+    \param quantities Groups of quantities to compute (thermo_quantity flags)
  */
-void ComputeThermoGPU::computeProperties()
+void ComputeThermoGPU::computeProperties(unsigned int quantities)
     {
     // just drop out if the group is an empty group
     if (m_group->getNumMembersGlobal() == 0)
@@ -127,7 +128,26 @@ void ComputeThermoGPU::computeProperties()
     ArrayHandle<unsigned int> d_tag(m_pdata->getTags(), access_location::device, access_mode::read);
     BoxDim box = m_pdata->getGlobalBox();
 
-    PDataFlags flags = m_pdata->getFlags();
+    // the isotropic pressure is summed with the energies, only the tensor needs its own kernels
+    const bool compute_pressure_tensor = quantities & thermo_quantity::pressure_tensor;
+    const bool compute_ke_rot = quantities & thermo_quantity::rotational_kinetic_energy;
+    const bool compute_hma = quantities & thermo_quantity::hma;
+
+    // the HMA displacements are only needed for the HMA estimators
+    std::unique_ptr<ArrayHandle<Scalar4>> d_pos;
+    std::unique_ptr<ArrayHandle<int3>> d_image;
+    std::unique_ptr<ArrayHandle<Scalar3>> d_lattice_site;
+    if (compute_hma)
+        {
+        d_pos.reset(new ArrayHandle<Scalar4>(m_pdata->getPositions(),
+                                             access_location::device,
+                                             access_mode::read));
+        d_image.reset(new ArrayHandle<int3>(m_pdata->getImages(),
+                                            access_location::device,
+                                            access_mode::read));
+        d_lattice_site.reset(
+            new ArrayHandle<Scalar3>(m_lattice_site, access_location::device, access_mode::read));
+        }
 
         { // scope these array handles so they are released before the additional terms are added
         // access the net force, pe, and virial
@@ -170,6 +190,9 @@ void ComputeThermoGPU::computeProperties()
         args.d_orientation = d_orientation.data;
         args.d_angmom = d_angmom.data;
         args.d_inertia = d_inertia.data;
+        args.d_pos = compute_hma ? d_pos->data : NULL;
+        args.d_image = compute_hma ? d_image->data : NULL;
+        args.d_lattice_site = compute_hma ? d_lattice_site->data : NULL;
         args.virial_pitch = net_virial.getPitch();
         args.ndof = m_group->getTranslationalDOF();
         args.D = m_sysdef->getNDimensions();
@@ -194,8 +217,8 @@ void ComputeThermoGPU::computeProperties()
                                    group_size,
                                    box,
                                    args,
-                                   flags[pdata_flag::pressure_tensor],
-                                   flags[pdata_flag::rotational_kinetic_energy],
+                                   compute_pressure_tensor,
+                                   compute_ke_rot,
                                    m_group->getGPUPartition());
 
         if (m_exec_conf->isCUDAErrorCheckingEnabled())
@@ -213,8 +236,8 @@ void ComputeThermoGPU::computeProperties()
                                  group_size,
                                  box,
                                  args,
-                                 flags[pdata_flag::pressure_tensor],
-                                 flags[pdata_flag::rotational_kinetic_energy]);
+                                 compute_pressure_tensor,
+                                 compute_ke_rot);
 
         if (m_exec_conf->isCUDAErrorCheckingEnabled())
             CHECK_CUDA_ERROR();
@@ -23,6 +23,10 @@
     \param d_velocity Particle velocity and mass array from ParticleData
     \param d_body Particle body id
     \param d_tag Particle tag
+    \param d_pos Particle positions
+    \param d_image Particle images
+    \param d_lattice_site HMA lattice sites by tag (NULL to skip the HMA sum)
+    \param box Global simulation box
     \param d_group_members List of group members for which to sum properties
     \param work_size Number of particles in the group this GPU processes
     \param offset Offset of this GPU in list of group members
@@ -32,11 +36,12 @@
      - 2*Kinetic energy is summed in .x
      - Potential energy is summed in .y
      - W is summed in .z
+     - F.(r - r_lattice) is summed in .w for harmonically mapped averaging
 
     One thread is executed per group member. That thread reads in the values for its member into
    shared memory and then the block performs a reduction in parallel to produce a partial sum output
    for the block. These partial sums are written to d_scratch[blockIdx.x].
-   sizeof(Scalar3)*block_size of dynamic shared memory are needed for this kernel to run.
+   sizeof(Scalar4)*block_size of dynamic shared memory are needed for this kernel to run.
 */
 
 __global__ void gpu_compute_thermo_partial_sums(Scalar4* d_scratch,
@@ -46,20 +51,24 @@ __global__ void gpu_compute_thermo_partial_sums(Scalar4* d_scratch,
                                                 Scalar4* d_velocity,
                                                 unsigned int* d_body,
                                                 unsigned int* d_tag,
+                                                const Scalar4* d_pos,
+                                                const int3* d_image,
+                                                const Scalar3* d_lattice_site,
+                                                const BoxDim box,
                                                 unsigned int* d_group_members,
                                                 unsigned int work_size,
                                                 unsigned int offset,
                                                 unsigned int block_offset)
     {
-    extern __shared__ Scalar3 compute_thermo_sdata[];
+    extern __shared__ Scalar4 compute_thermo_sdata[];
 
     // determine which particle this thread works on
     int group_idx = blockIdx.x * blockDim.x + threadIdx.x;
 
-    Scalar3 my_element; // element of scratch space read in
+    Scalar4 my_element; // element of scratch space read in
 
     // non-participating thread: contribute 0 to the sum
-    my_element = make_scalar3(0, 0, 0);
+    my_element = make_scalar4(0, 0, 0, 0);
 
     if (group_idx < work_size)
         {
@@ -85,6 +94,14 @@ __global__ void gpu_compute_thermo_partial_sums(Scalar4* d_scratch,
             my_element.x = mass * (vel.x * vel.x + vel.y * vel.y + vel.z * vel.z);
             my_element.y = net_force.w;
             my_element.z = net_isotropic_virial;
+
+            if (d_lattice_site)
+                {
+                Scalar4 postype = d_pos[idx];
+                Scalar3 pos = make_scalar3(postype.x, postype.y, postype.z);
+                Scalar3 dr = box.shift(pos, d_image[idx]) - d_lattice_site[tag];
+                my_element.w = net_force.x * dr.x + net_force.y * dr.y + net_force.z * dr.z;
+                }
             }
         }
 
@@ -100,6 +117,7 @@ __global__ void gpu_compute_thermo_partial_sums(Scalar4* d_scratch,
             compute_thermo_sdata[threadIdx.x].x += compute_thermo_sdata[threadIdx.x + offs].x;
             compute_thermo_sdata[threadIdx.x].y += compute_thermo_sdata[threadIdx.x + offs].y;
             compute_thermo_sdata[threadIdx.x].z += compute_thermo_sdata[threadIdx.x + offs].z;
+            compute_thermo_sdata[threadIdx.x].w += compute_thermo_sdata[threadIdx.x + offs].w;
             }
         offs >>= 1;
         __syncthreads();
@@ -108,8 +126,7 @@ __global__ void gpu_compute_thermo_partial_sums(Scalar4* d_scratch,
     // write out our partial sum
     if (threadIdx.x == 0)
         {
-        Scalar3 res = compute_thermo_sdata[0];
-        d_scratch[block_offset + blockIdx.x] = make_scalar4(res.x, res.y, res.z, 0);
+        d_scratch[block_offset + blockIdx.x] = compute_thermo_sdata[0];
         }
     }
 
@@ -317,7 +334,8 @@ __global__ void gpu_compute_rotational_ke_partial_sums(Scalar* d_scratch,
    values. From the final sums, the thermodynamic properties are computed and written to
    d_properties.
 
-    sizeof(Scalar4)*block_size bytes of shared memory are needed for this kernel to run.
+    (sizeof(Scalar4)+sizeof(Scalar))*block_size bytes of shared memory are needed for this kernel
+   to run.
 */
 __global__ void gpu_compute_thermo_final_sums(Scalar* d_properties,
                                               Scalar4* d_scratch,
@@ -331,8 +349,11 @@ __global__ void gpu_compute_thermo_final_sums(Scalar* d_properties,
                                               Scalar external_energy)
     {
     extern __shared__ Scalar4 compute_thermo_final_sdata[];
+    // the HMA sums follow the other sums in shared memory
+    Scalar* compute_thermo_final_hma_sdata = (Scalar*)&compute_thermo_final_sdata[blockDim.x];
 
     Scalar4 final_sum = make_scalar4(Scalar(0.0), Scalar(0.0), Scalar(0.0), Scalar(0.0));
+    Scalar final_hma_sum = Scalar(0.0);
 
     // sum up the values in the partial sum via a sliding window
     for (int start = 0; start < num_partial_sums; start += blockDim.x)
@@ -345,10 +366,14 @@ __global__ void gpu_compute_thermo_final_sums(Scalar* d_properties,
 
             compute_thermo_final_sdata[threadIdx.x]
                 = make_scalar4(scratch.x, scratch.y, scratch.z, scratch_rot);
+            compute_thermo_final_hma_sdata[threadIdx.x] = scratch.w;
             }
         else
+            {
             compute_thermo_final_sdata[threadIdx.x]
                 = make_scalar4(Scalar(0.0), Scalar(0.0), Scalar(0.0), Scalar(0.0));
+            compute_thermo_final_hma_sdata[threadIdx.x] = Scalar(0.0);
+            }
         __syncthreads();
 
         // reduce the sum in parallel
@@ -365,6 +390,8 @@ __global__ void gpu_compute_thermo_final_sums(Scalar* d_properties,
                     += compute_thermo_final_sdata[threadIdx.x + offs].z;
                 compute_thermo_final_sdata[threadIdx.x].w
                     += compute_thermo_final_sdata[threadIdx.x + offs].w;
+                compute_thermo_final_hma_sdata[threadIdx.x]
+                    += compute_thermo_final_hma_sdata[threadIdx.x + offs];
                 }
             offs >>= 1;
             __syncthreads();
@@ -376,6 +403,7 @@ __global__ void gpu_compute_thermo_final_sums(Scalar* d_properties,
             final_sum.y += compute_thermo_final_sdata[0].y;
             final_sum.z += compute_thermo_final_sdata[0].z;
             final_sum.w += compute_thermo_final_sdata[0].w;
+            final_hma_sum += compute_thermo_final_hma_sdata[0];
             }
         }
 
@@ -413,6 +441,7 @@ __global__ void gpu_compute_thermo_final_sums(Scalar* d_properties,
         d_properties[thermo_index::rotational_kinetic_energy] = Scalar(ke_rot_total);
         d_properties[thermo_index::potential_energy] = Scalar(pe_total);
         d_properties[thermo_index::pressure] = pressure;
+        d_properties[thermo_index::hma_force_displacement] = final_hma_sum;
         }
     }
 
@@ -559,7 +588,7 @@ hipError_t gpu_compute_thermo_partial(Scalar* d_properties,
         dim3 grid(nwork / args.block_size + 1, 1, 1);
         dim3 threads(args.block_size, 1, 1);
 
-        size_t shared_bytes = sizeof(Scalar3) * args.block_size;
+        size_t shared_bytes = sizeof(Scalar4) * args.block_size;
 
         hipLaunchKernelGGL(gpu_compute_thermo_partial_sums,
                            dim3(grid),
@@ -573,6 +602,10 @@ hipError_t gpu_compute_thermo_partial(Scalar* d_properties,
                            d_vel,
                            d_body,
                            d_tag,
+                           args.d_pos,
+                           args.d_image,
+                           args.d_lattice_site,
+                           box,
                            d_group_members,
                            nwork,
                            range.first,
@@ -676,7 +709,7 @@ hipError_t gpu_compute_thermo_final(Scalar* d_properties,
     dim3 grid = dim3(1, 1, 1);
     dim3 threads = dim3(final_block_size, 1, 1);
 
-    size_t shared_bytes = sizeof(Scalar4) * final_block_size;
+    size_t shared_bytes = (sizeof(Scalar4) + sizeof(Scalar)) * final_block_size;
 
     Scalar external_virial
         = Scalar(1.0 / 3.0)
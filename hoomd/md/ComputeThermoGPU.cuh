@@ -23,6 +23,9 @@ struct compute_thermo_args
     Scalar4* d_orientation;            //!< Particle data orientations
     Scalar4* d_angmom;                 //!< Particle data conjugate quaternions
     Scalar3* d_inertia;                //!< Particle data moments of inertia
+    Scalar4* d_pos;                    //!< Particle positions (HMA only)
+    int3* d_image;                     //!< Particle images (HMA only)
+    Scalar3* d_lattice_site;           //!< HMA lattice sites by tag, NULL to skip the HMA sum
     size_t virial_pitch;               //!< Pitch of 2D net_virial array
     Scalar ndof;                       //!< Number of degrees of freedom for T calculation
     unsigned int D;                    //!< Dimensionality of the system
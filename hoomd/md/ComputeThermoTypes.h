@@ -27,7 +27,27 @@ struct thermo_index
         pressure_yy,   //!< Index for the yy component of the pressure tensor in the GPUArray
         pressure_yz,   //!< Index for the yz component of the pressure tensor in the GPUArray
         pressure_zz,   //!< Index for the zz component of the pressure tensor in the GPUArray
-        num_quantities // final element to count number of quantities
+        hma_force_displacement, //!< Sum of F.(r - r_lattice) for harmonically mapped averaging
+        num_quantities          // final element to count number of quantities
+        };
+    };
+
+//! Bit flags for the groups of quantities that ComputeThermo evaluates on request
+/*! ComputeThermo accumulates all requested groups in a single pass over the particles and keeps
+    them until the time step changes. Requesting a group that is not yet known on the current step
+    evaluates it together with the groups already known, so that all values come from the same pass.
+*/
+struct thermo_quantity
+    {
+    //! The enum
+    enum Enum
+        {
+        kinetic_energy = 1 << 0,            //!< Translational kinetic and potential energy
+        rotational_kinetic_energy = 1 << 1, //!< Rotational kinetic energy
+        pressure = 1 << 2,                  //!< Isotropic pressure
+        pressure_tensor = 1 << 3,           //!< All six components of the pressure tensor
+        hma = 1 << 4,                       //!< Harmonically mapped averaging estimators
+        all = (1 << 5) - 1                  //!< All quantities
         };
     };
 
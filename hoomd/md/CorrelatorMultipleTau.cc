@@ -0,0 +1,244 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file CorrelatorMultipleTau.cc
+    \brief Contains code for the CorrelatorMultipleTau class
+*/
+
+#include "CorrelatorMultipleTau.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+namespace py = pybind11;
+
+using namespace std;
+
+/*! \param sysdef System definition
+    \param num_channels Number of values in a sample
+    \param points Number of values kept per level
+    \param averaging Number of values averaged into the next level
+    \param levels Number of levels
+    \param difference Correlate (a - b)^2 instead of a * b
+    \param norm Factor applied to the average
+*/
+CorrelatorMultipleTau::CorrelatorMultipleTau(std::shared_ptr<SystemDefinition> sysdef,
+                                             unsigned int num_channels,
+                                             unsigned int points,
+                                             unsigned int averaging,
+                                             unsigned int levels,
+                                             bool difference,
+                                             Scalar norm)
+    : Analyzer(sysdef), m_num_channels(num_channels), m_points(points), m_averaging(averaging),
+      m_levels(levels), m_difference(difference), m_norm(norm), m_head(levels, 0),
+      m_num_inserted(levels, 0), m_num_accumulated(levels, 0),
+      m_corr_count(size_t(levels) * points, 0), m_num_samples(0)
+    {
+    m_exec_conf->msg->notice(5) << "Constructing CorrelatorMultipleTau" << endl;
+
+    if (m_averaging < 2)
+        {
+        throw std::domain_error("averaging must be at least 2");
+        }
+    if (m_points < m_averaging || m_points % m_averaging != 0)
+        {
+        throw std::domain_error("points must be a multiple of averaging");
+        }
+    if (m_levels == 0)
+        {
+        throw std::domain_error("levels must be greater than 0");
+        }
+
+    GlobalArray<Scalar> sample(m_num_channels, m_exec_conf);
+    m_sample.swap(sample);
+    TAG_ALLOCATION(m_sample);
+
+    GlobalArray<Scalar> shift(size_t(m_levels) * m_points * m_num_channels, m_exec_conf);
+    m_shift.swap(shift);
+    TAG_ALLOCATION(m_shift);
+
+    GlobalArray<Scalar> accum(size_t(m_levels) * m_num_channels, m_exec_conf);
+    m_accum.swap(accum);
+    TAG_ALLOCATION(m_accum);
+
+    GlobalArray<double> corr(size_t(m_levels) * m_points, m_exec_conf);
+    m_corr.swap(corr);
+    TAG_ALLOCATION(m_corr);
+
+    reset();
+    }
+
+CorrelatorMultipleTau::~CorrelatorMultipleTau()
+    {
+    m_exec_conf->msg->notice(5) << "Destroying CorrelatorMultipleTau" << endl;
+    }
+
+/*! \param timestep Current time step of the simulation
+ */
+void CorrelatorMultipleTau::analyze(uint64_t timestep)
+    {
+    Analyzer::analyze(timestep);
+
+    if (m_prof)
+        m_prof->push(m_exec_conf, "Correlator");
+
+    sample(timestep);
+    push(0);
+    m_num_samples++;
+
+    if (m_prof)
+        m_prof->pop(m_exec_conf);
+    }
+
+void CorrelatorMultipleTau::reset()
+    {
+        {
+        ArrayHandle<Scalar> h_shift(m_shift, access_location::host, access_mode::overwrite);
+        memset(h_shift.data, 0, sizeof(Scalar) * m_shift.getNumElements());
+        ArrayHandle<Scalar> h_accum(m_accum, access_location::host, access_mode::overwrite);
+        memset(h_accum.data, 0, sizeof(Scalar) * m_accum.getNumElements());
+        ArrayHandle<double> h_corr(m_corr, access_location::host, access_mode::overwrite);
+        memset(h_corr.data, 0, sizeof(double) * m_corr.getNumElements());
+        }
+
+    std::fill(m_head.begin(), m_head.end(), 0);
+    std::fill(m_num_inserted.begin(), m_num_inserted.end(), 0);
+    std::fill(m_num_accumulated.begin(), m_num_accumulated.end(), 0);
+    std::fill(m_corr_count.begin(), m_corr_count.end(), 0);
+    m_num_samples = 0;
+    }
+
+/*! \param level Level to add to
+ */
+void CorrelatorMultipleTau::push(unsigned int level)
+    {
+    // the lags below points / averaging repeat those of the level below
+    const unsigned int first_lag = level == 0 ? 0 : m_points / m_averaging;
+
+    m_head[level] = (m_head[level] + m_points - 1) % m_points;
+    m_num_inserted[level]++;
+    const unsigned int num_lags
+        = (unsigned int)std::min<uint64_t>(m_num_inserted[level], m_points);
+
+    updateLevel(level, first_lag, num_lags);
+    for (unsigned int lag = first_lag; lag < num_lags; lag++)
+        m_corr_count[level * m_points + lag]++;
+
+    if (level + 1 < m_levels)
+        {
+        m_num_accumulated[level]++;
+        if (m_num_accumulated[level] == m_averaging)
+            {
+            m_num_accumulated[level] = 0;
+            push(level + 1);
+            }
+        }
+    }
+
+void CorrelatorMultipleTau::updateLevel(unsigned int level,
+                                        unsigned int first_lag,
+                                        unsigned int num_lags)
+    {
+    ArrayHandle<Scalar> h_sample(m_sample, access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_shift(m_shift, access_location::host, access_mode::readwrite);
+    ArrayHandle<Scalar> h_accum(m_accum, access_location::host, access_mode::readwrite);
+    ArrayHandle<double> h_corr(m_corr, access_location::host, access_mode::readwrite);
+
+    Scalar* shift = h_shift.data + size_t(level) * m_points * m_num_channels;
+    Scalar* newest = shift + size_t(m_head[level]) * m_num_channels;
+    if (level == 0)
+        {
+        std::copy(h_sample.data, h_sample.data + m_num_channels, newest);
+        }
+    else
+        {
+        Scalar* source = h_accum.data + size_t(level - 1) * m_num_channels;
+        const Scalar scale = Scalar(1.0) / Scalar(m_averaging);
+        for (unsigned int c = 0; c < m_num_channels; c++)
+            {
+            newest[c] = source[c] * scale;
+            source[c] = Scalar(0.0);
+            }
+        }
+
+    if (level + 1 < m_levels)
+        {
+        Scalar* accum = h_accum.data + size_t(level) * m_num_channels;
+        for (unsigned int c = 0; c < m_num_channels; c++)
+            accum[c] += newest[c];
+        }
+
+    for (unsigned int lag = first_lag; lag < num_lags; lag++)
+        {
+        const Scalar* old = shift + size_t((m_head[level] + lag) % m_points) * m_num_channels;
+        double sum = 0.0;
+        if (m_difference)
+            {
+            for (unsigned int c = 0; c < m_num_channels; c++)
+                {
+                const double delta = double(newest[c]) - double(old[c]);
+                sum += delta * delta;
+                }
+            }
+        else
+            {
+            for (unsigned int c = 0; c < m_num_channels; c++)
+                sum += double(newest[c]) * double(old[c]);
+            }
+        h_corr.data[level * m_points + lag] += sum;
+        }
+    }
+
+/*! \returns Lag of each element of getCorrelation() in samples
+ */
+pybind11::array_t<uint64_t> CorrelatorMultipleTau::getLags() const
+    {
+    std::vector<uint64_t> lags;
+    uint64_t block = 1;
+    for (unsigned int level = 0; level < m_levels; level++)
+        {
+        const unsigned int first_lag = level == 0 ? 0 : m_points / m_averaging;
+        for (unsigned int lag = first_lag; lag < m_points; lag++)
+            lags.push_back(lag * block);
+        block *= m_averaging;
+        }
+    return pybind11::array_t<uint64_t>(lags.size(), lags.data());
+    }
+
+/*! \returns Average correlation at each lag of getLags()
+ */
+pybind11::array_t<double> CorrelatorMultipleTau::getCorrelation()
+    {
+    ArrayHandle<double> h_corr(m_corr, access_location::host, access_mode::read);
+
+    std::vector<double> result;
+    for (unsigned int level = 0; level < m_levels; level++)
+        {
+        const unsigned int first_lag = level == 0 ? 0 : m_points / m_averaging;
+        for (unsigned int lag = first_lag; lag < m_points; lag++)
+            {
+            const unsigned int i = level * m_points + lag;
+            if (m_corr_count[i] == 0)
+                result.push_back(std::numeric_limits<double>::quiet_NaN());
+            else
+                result.push_back(h_corr.data[i] / double(m_corr_count[i]) * m_norm);
+            }
+        }
+    return pybind11::array_t<double>(result.size(), result.data());
+    }
+
+void export_CorrelatorMultipleTau(py::module& m)
+    {
+    py::class_<CorrelatorMultipleTau, Analyzer, std::shared_ptr<CorrelatorMultipleTau>>(
+        m,
+        "CorrelatorMultipleTau")
+        .def("reset", &CorrelatorMultipleTau::reset)
+        .def_property_readonly("lags", &CorrelatorMultipleTau::getLags)
+        .def_property_readonly("correlation", &CorrelatorMultipleTau::getCorrelation)
+        .def_property_readonly("num_samples", &CorrelatorMultipleTau::getNumSamples)
+        .def_property_readonly("points", &CorrelatorMultipleTau::getPoints)
+        .def_property_readonly("averaging", &CorrelatorMultipleTau::getAveraging)
+        .def_property_readonly("levels", &CorrelatorMultipleTau::getLevels);
+    }
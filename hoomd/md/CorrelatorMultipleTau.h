@@ -0,0 +1,133 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "hoomd/Analyzer.h"
+#include "hoomd/GlobalArray.h"
+
+#include <memory>
+#include <vector>
+
+/*! \file CorrelatorMultipleTau.h
+    \brief Declares a base class for multiple-tau time correlators
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include <pybind11/numpy.h>
+#include <pybind11/pybind11.h>
+
+#ifndef __CORRELATOR_MULTIPLE_TAU_H__
+#define __CORRELATOR_MULTIPLE_TAU_H__
+
+//! Accumulates time correlation functions on the fly with a multiple-tau correlator
+/*! Each call to analyze() samples a set of channels (e.g. the velocity components of every
+    particle) into m_sample and adds it to a hierarchy of levels. Level k holds the last \a points
+    values of the channels averaged over blocks of averaging^k samples and correlates the newest
+    value with each of them. Level 0 reports lags 0 to points - 1 samples, and level k > 0 reports
+    lags j * averaging^k for j from points / averaging to points - 1, as in Ramirez et al. 2010
+    (https://doi.org/10.1063/1.3491098).
+
+    The correlation of two values a (newest) and b is a * b, or (a - b)^2 when \a difference is set,
+    which gives the mean squared displacement of the channels. The products are summed over all
+    channels and the result is the average over samples times \a norm.
+
+    Subclasses implement sample(). updateLevel() is overridden by the GPU implementation, so the
+    channel values may stay on the device.
+
+    \ingroup analyzers
+*/
+class PYBIND11_EXPORT CorrelatorMultipleTau : public Analyzer
+    {
+    public:
+    //! Constructs the correlator
+    CorrelatorMultipleTau(std::shared_ptr<SystemDefinition> sysdef,
+                          unsigned int num_channels,
+                          unsigned int points,
+                          unsigned int averaging,
+                          unsigned int levels,
+                          bool difference,
+                          Scalar norm);
+
+    //! Destructor
+    virtual ~CorrelatorMultipleTau();
+
+    //! Add a sample
+    virtual void analyze(uint64_t timestep);
+
+    //! Clear the accumulated correlation
+    void reset();
+
+    //! Get the lag of each element of the correlation, in samples
+    pybind11::array_t<uint64_t> getLags() const;
+
+    //! Get the correlation, NaN for lags without data
+    pybind11::array_t<double> getCorrelation();
+
+    //! Get the number of samples since the last reset
+    uint64_t getNumSamples() const
+        {
+        return m_num_samples;
+        }
+
+    //! Get the number of values per level
+    unsigned int getPoints() const
+        {
+        return m_points;
+        }
+
+    //! Get the number of samples averaged from one level to the next
+    unsigned int getAveraging() const
+        {
+        return m_averaging;
+        }
+
+    //! Get the number of levels
+    unsigned int getLevels() const
+        {
+        return m_levels;
+        }
+
+    protected:
+    unsigned int m_num_channels; //!< Number of values in a sample
+    unsigned int m_points;       //!< Number of values kept per level
+    unsigned int m_averaging;    //!< Number of values averaged into the next level
+    unsigned int m_levels;       //!< Number of levels
+    bool m_difference;           //!< Correlate (a - b)^2 instead of a * b
+    Scalar m_norm;               //!< Factor applied to the average
+
+    GlobalArray<Scalar> m_sample; //!< The current sample, filled by sample()
+    GlobalArray<Scalar> m_shift;  //!< Circular buffers of values (level, slot, channel)
+    GlobalArray<Scalar> m_accum;  //!< Sums of values to pass to the next level (level, channel)
+    GlobalArray<double> m_corr;   //!< Sums of the correlations (level, lag)
+
+    std::vector<unsigned int> m_head;            //!< Slot of the newest value in each level
+    std::vector<uint64_t> m_num_inserted;        //!< Number of values inserted in each level
+    std::vector<unsigned int> m_num_accumulated; //!< Number of values in m_accum of each level
+    std::vector<uint64_t> m_corr_count;          //!< Number of terms in m_corr (level, lag)
+    uint64_t m_num_samples;                      //!< Number of samples since the last reset
+
+    //! Fill m_sample with the channels at the given timestep
+    virtual void sample(uint64_t timestep) = 0;
+
+    //! Insert the new value into a level and add its correlations
+    /*! \param level Level to update
+        \param first_lag First lag to correlate
+        \param num_lags One past the last lag to correlate
+
+        The new value is m_sample for level 0, and the average in m_accum of level - 1 otherwise,
+        which is cleared. The value is stored in slot m_head[level] and added to m_accum of the
+        level when a next level exists.
+    */
+    virtual void updateLevel(unsigned int level, unsigned int first_lag, unsigned int num_lags);
+
+    private:
+    //! Add the next value to a level, and pass averages to the higher levels
+    void push(unsigned int level);
+    };
+
+//! Exports the CorrelatorMultipleTau class to python
+void export_CorrelatorMultipleTau(pybind11::module& m);
+
+#endif
@@ -0,0 +1,123 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file CorrelatorParticle.cc
+    \brief Contains code for the CorrelatorParticle class
+*/
+
+#include "CorrelatorParticle.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace py = pybind11;
+
+using namespace std;
+
+/*! \param sysdef System definition
+    \param group Particles to correlate
+    \param position Sample unwrapped positions when true, velocities when false
+    \param points Number of values kept per level
+    \param averaging Number of values averaged into the next level
+    \param levels Number of levels
+*/
+CorrelatorParticle::CorrelatorParticle(std::shared_ptr<SystemDefinition> sysdef,
+                                       std::shared_ptr<ParticleGroup> group,
+                                       bool position,
+                                       unsigned int points,
+                                       unsigned int averaging,
+                                       unsigned int levels)
+    : CorrelatorMultipleTau(sysdef,
+                            3 * group->getNumMembersGlobal(),
+                            points,
+                            averaging,
+                            levels,
+                            position,
+                            Scalar(1.0) / Scalar(std::max(group->getNumMembersGlobal(), 1u))),
+      m_group(group), m_position(position)
+    {
+    m_exec_conf->msg->notice(5) << "Constructing CorrelatorParticle" << endl;
+
+#ifdef ENABLE_MPI
+    if (m_pdata->getDomainDecomposition())
+        {
+        throw std::runtime_error("Particle correlators do not support domain decomposition");
+        }
+#endif
+    }
+
+CorrelatorParticle::~CorrelatorParticle()
+    {
+    m_exec_conf->msg->notice(5) << "Destroying CorrelatorParticle" << endl;
+    }
+
+void CorrelatorParticle::checkGroup()
+    {
+    if (3 * m_group->getNumMembersGlobal() != m_num_channels)
+        {
+        throw std::runtime_error("The group of a particle correlator changed");
+        }
+    }
+
+/*! \param timestep Current time step of the simulation
+ */
+void CorrelatorParticle::sample(uint64_t timestep)
+    {
+    checkGroup();
+
+    ArrayHandle<unsigned int> h_member_tags(m_group->getMemberTagArray(),
+                                            access_location::host,
+                                            access_mode::read);
+    ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(),
+                                     access_location::host,
+                                     access_mode::read);
+    ArrayHandle<Scalar> h_sample(m_sample, access_location::host, access_mode::overwrite);
+
+    const unsigned int num_members = m_num_channels / 3;
+    if (m_position)
+        {
+        ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(),
+                                   access_location::host,
+                                   access_mode::read);
+        ArrayHandle<int3> h_image(m_pdata->getImages(), access_location::host, access_mode::read);
+        const BoxDim box = m_pdata->getGlobalBox();
+
+        for (unsigned int i = 0; i < num_members; i++)
+            {
+            const unsigned int idx = h_rtag.data[h_member_tags.data[i]];
+            const Scalar4 postype = h_pos.data[idx];
+            const Scalar3 r
+                = box.shift(make_scalar3(postype.x, postype.y, postype.z), h_image.data[idx]);
+            h_sample.data[3 * i] = r.x;
+            h_sample.data[3 * i + 1] = r.y;
+            h_sample.data[3 * i + 2] = r.z;
+            }
+        }
+    else
+        {
+        ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(),
+                                   access_location::host,
+                                   access_mode::read);
+
+        for (unsigned int i = 0; i < num_members; i++)
+            {
+            const Scalar4 v = h_vel.data[h_rtag.data[h_member_tags.data[i]]];
+            h_sample.data[3 * i] = v.x;
+            h_sample.data[3 * i + 1] = v.y;
+            h_sample.data[3 * i + 2] = v.z;
+            }
+        }
+    }
+
+void export_CorrelatorParticle(py::module& m)
+    {
+    py::class_<CorrelatorParticle, CorrelatorMultipleTau, std::shared_ptr<CorrelatorParticle>>(
+        m,
+        "CorrelatorParticle")
+        .def(py::init<std::shared_ptr<SystemDefinition>,
+                      std::shared_ptr<ParticleGroup>,
+                      bool,
+                      unsigned int,
+                      unsigned int,
+                      unsigned int>());
+    }
@@ -0,0 +1,59 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "CorrelatorMultipleTau.h"
+#include "hoomd/ParticleGroup.h"
+
+/*! \file CorrelatorParticle.h
+    \brief Declares a multiple-tau correlator of per-particle velocities or positions
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include <pybind11/pybind11.h>
+
+#ifndef __CORRELATOR_PARTICLE_H__
+#define __CORRELATOR_PARTICLE_H__
+
+//! Velocity autocorrelation or mean squared displacement of the particles in a group
+/*! The channels are the three components of the velocity, or of the unwrapped position (with the
+    particle images), of each group member in tag order. Velocities are correlated with products
+    and positions with squared differences. The result is averaged over the group members, so it
+    is <v(0) . v(t)> or <|r(t) - r(0)|^2>.
+
+    The history of every particle is kept in the correlator, so particles may not move between
+    ranks: the correlator does not support domain decomposition, and the group must not change.
+
+    \ingroup analyzers
+*/
+class PYBIND11_EXPORT CorrelatorParticle : public CorrelatorMultipleTau
+    {
+    public:
+    //! Constructs the correlator
+    CorrelatorParticle(std::shared_ptr<SystemDefinition> sysdef,
+                       std::shared_ptr<ParticleGroup> group,
+                       bool position,
+                       unsigned int points,
+                       unsigned int averaging,
+                       unsigned int levels);
+
+    //! Destructor
+    virtual ~CorrelatorParticle();
+
+    protected:
+    std::shared_ptr<ParticleGroup> m_group; //!< Particles to correlate
+    bool m_position;                        //!< Sample unwrapped positions instead of velocities
+
+    //! Sample the velocities or unwrapped positions
+    virtual void sample(uint64_t timestep);
+
+    //! Check that the group has not changed
+    void checkGroup();
+    };
+
+//! Exports the CorrelatorParticle class to python
+void export_CorrelatorParticle(pybind11::module& m);
+
+#endif
@@ -0,0 +1,127 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file CorrelatorParticleGPU.cc
+    \brief Contains code for the CorrelatorParticleGPU class
+*/
+
+#include "CorrelatorParticleGPU.h"
+#include "CorrelatorParticleGPU.cuh"
+
+#include <algorithm>
+
+namespace py = pybind11;
+
+using namespace std;
+
+/*! \param sysdef System definition
+    \param group Particles to correlate
+    \param position Sample unwrapped positions when true, velocities when false
+    \param points Number of values kept per level
+    \param averaging Number of values averaged into the next level
+    \param levels Number of levels
+*/
+CorrelatorParticleGPU::CorrelatorParticleGPU(std::shared_ptr<SystemDefinition> sysdef,
+                                             std::shared_ptr<ParticleGroup> group,
+                                             bool position,
+                                             unsigned int points,
+                                             unsigned int averaging,
+                                             unsigned int levels)
+    : CorrelatorParticle(sysdef, group, position, points, averaging, levels), m_block_size(256)
+    {
+    if (!m_exec_conf->isCUDAEnabled())
+        {
+        m_exec_conf->msg->error() << "Creating a CorrelatorParticleGPU with no GPU in the "
+                                     "execution configuration"
+                                  << endl;
+        throw std::runtime_error("Error initializing CorrelatorParticleGPU");
+        }
+
+    const unsigned int num_blocks = (m_num_channels + m_block_size - 1) / m_block_size;
+    GlobalArray<double> partial(size_t(std::max(num_blocks, 1u)) * m_points, m_exec_conf);
+    m_partial.swap(partial);
+    TAG_ALLOCATION(m_partial);
+    }
+
+CorrelatorParticleGPU::~CorrelatorParticleGPU() { }
+
+/*! \param timestep Current time step of the simulation
+ */
+void CorrelatorParticleGPU::sample(uint64_t timestep)
+    {
+    checkGroup();
+
+    ArrayHandle<unsigned int> d_member_tags(m_group->getMemberTagArray(),
+                                            access_location::device,
+                                            access_mode::read);
+    ArrayHandle<unsigned int> d_rtag(m_pdata->getRTags(),
+                                     access_location::device,
+                                     access_mode::read);
+    ArrayHandle<Scalar4> d_pos(m_pdata->getPositions(), access_location::device, access_mode::read);
+    ArrayHandle<int3> d_image(m_pdata->getImages(), access_location::device, access_mode::read);
+    ArrayHandle<Scalar4> d_vel(m_pdata->getVelocities(),
+                               access_location::device,
+                               access_mode::read);
+    ArrayHandle<Scalar> d_sample(m_sample, access_location::device, access_mode::overwrite);
+
+    gpu_correlator_sample_particles(d_sample.data,
+                                    d_member_tags.data,
+                                    d_rtag.data,
+                                    d_pos.data,
+                                    d_image.data,
+                                    d_vel.data,
+                                    m_pdata->getGlobalBox(),
+                                    m_num_channels / 3,
+                                    m_position,
+                                    m_block_size);
+
+    if (m_exec_conf->isCUDAErrorCheckingEnabled())
+        CHECK_CUDA_ERROR();
+    }
+
+void CorrelatorParticleGPU::updateLevel(unsigned int level,
+                                        unsigned int first_lag,
+                                        unsigned int num_lags)
+    {
+    ArrayHandle<Scalar> d_sample(m_sample, access_location::device, access_mode::readwrite);
+    ArrayHandle<Scalar> d_shift(m_shift, access_location::device, access_mode::readwrite);
+    ArrayHandle<Scalar> d_accum(m_accum, access_location::device, access_mode::readwrite);
+    ArrayHandle<double> d_corr(m_corr, access_location::device, access_mode::readwrite);
+    ArrayHandle<double> d_partial(m_partial, access_location::device, access_mode::overwrite);
+
+    Scalar* d_source = level == 0 ? d_sample.data
+                                  : d_accum.data + size_t(level - 1) * m_num_channels;
+    Scalar* d_level_accum
+        = level + 1 < m_levels ? d_accum.data + size_t(level) * m_num_channels : NULL;
+
+    gpu_correlator_update_level(d_shift.data + size_t(level) * m_points * m_num_channels,
+                                d_level_accum,
+                                d_source,
+                                level == 0 ? Scalar(1.0) : Scalar(1.0) / Scalar(m_averaging),
+                                level > 0,
+                                d_partial.data,
+                                d_corr.data + size_t(level) * m_points,
+                                m_num_channels,
+                                m_points,
+                                m_head[level],
+                                first_lag,
+                                num_lags,
+                                m_difference,
+                                m_block_size);
+
+    if (m_exec_conf->isCUDAErrorCheckingEnabled())
+        CHECK_CUDA_ERROR();
+    }
+
+void export_CorrelatorParticleGPU(py::module& m)
+    {
+    py::class_<CorrelatorParticleGPU, CorrelatorParticle, std::shared_ptr<CorrelatorParticleGPU>>(
+        m,
+        "CorrelatorParticleGPU")
+        .def(py::init<std::shared_ptr<SystemDefinition>,
+                      std::shared_ptr<ParticleGroup>,
+                      bool,
+                      unsigned int,
+                      unsigned int,
+                      unsigned int>());
+    }
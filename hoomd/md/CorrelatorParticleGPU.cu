@@ -0,0 +1,276 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "CorrelatorParticleGPU.cuh"
+
+/*! \file CorrelatorParticleGPU.cu
+    \brief Defines GPU kernel code for the multiple-tau particle correlators. Used by
+    CorrelatorParticleGPU.
+*/
+
+//! Sample the velocities or unwrapped positions
+/*! \param d_sample Sample to fill, three values per group member
+    \param d_member_tags Tags of the group members, in ascending order
+    \param d_rtag Particle indices by tag
+    \param d_pos Particle positions
+    \param d_image Particle images
+    \param d_vel Particle velocities
+    \param box Global simulation box
+    \param num_members Number of group members
+    \param position Sample unwrapped positions when true, velocities when false
+
+    One thread is executed per group member.
+*/
+__global__ void gpu_correlator_sample_particles_kernel(Scalar* d_sample,
+                                                       const unsigned int* d_member_tags,
+                                                       const unsigned int* d_rtag,
+                                                       const Scalar4* d_pos,
+                                                       const int3* d_image,
+                                                       const Scalar4* d_vel,
+                                                       const BoxDim box,
+                                                       const unsigned int num_members,
+                                                       const bool position)
+    {
+    unsigned int i = blockIdx.x * blockDim.x + threadIdx.x;
+
+    if (i >= num_members)
+        return;
+
+    const unsigned int idx = d_rtag[d_member_tags[i]];
+    Scalar3 value;
+    if (position)
+        {
+        const Scalar4 postype = d_pos[idx];
+        value = box.shift(make_scalar3(postype.x, postype.y, postype.z), d_image[idx]);
+        }
+    else
+        {
+        const Scalar4 v = d_vel[idx];
+        value = make_scalar3(v.x, v.y, v.z);
+        }
+
+    d_sample[3 * i] = value.x;
+    d_sample[3 * i + 1] = value.y;
+    d_sample[3 * i + 2] = value.z;
+    }
+
+//! Insert the new value of each channel into a level and sum the correlations in each block
+/*! \param d_shift Circular buffer of the level (slot, channel)
+    \param d_accum Sums to pass to the next level, NULL for the last level
+    \param d_source New value of each channel, before scaling
+    \param scale Factor applied to the new values
+    \param clear_source Set d_source to 0 after reading it
+    \param d_partial Output: sum over the channels of each block (block, lag)
+    \param num_channels Number of channels
+    \param points Number of slots in the level
+    \param head Slot of the new value
+    \param first_lag First lag to correlate
+    \param num_lags One past the last lag to correlate
+    \param difference Correlate (a - b)^2 instead of a * b
+
+    One thread is executed per channel. The block size must be a power of two.
+*/
+__global__ void gpu_correlator_update_level_kernel(Scalar* d_shift,
+                                                   Scalar* d_accum,
+                                                   Scalar* d_source,
+                                                   const Scalar scale,
+                                                   const bool clear_source,
+                                                   double* d_partial,
+                                                   const unsigned int num_channels,
+                                                   const unsigned int points,
+                                                   const unsigned int head,
+                                                   const unsigned int first_lag,
+                                                   const unsigned int num_lags,
+                                                   const bool difference)
+    {
+    extern __shared__ double s_sum[];
+
+    unsigned int c = blockIdx.x * blockDim.x + threadIdx.x;
+
+    Scalar value = Scalar(0.0);
+    if (c < num_channels)
+        {
+        value = d_source[c] * scale;
+        if (clear_source)
+            d_source[c] = Scalar(0.0);
+        d_shift[head * num_channels + c] = value;
+        if (d_accum)
+            d_accum[c] += value;
+        }
+
+    for (unsigned int lag = first_lag; lag < num_lags; lag++)
+        {
+        double term = 0.0;
+        if (c < num_channels)
+            {
+            const Scalar old = d_shift[((head + lag) % points) * num_channels + c];
+            if (difference)
+                term = (double(value) - double(old)) * (double(value) - double(old));
+            else
+                term = double(value) * double(old);
+            }
+
+        s_sum[threadIdx.x] = term;
+        __syncthreads();
+
+        for (unsigned int offset = blockDim.x / 2; offset > 0; offset >>= 1)
+            {
+            if (threadIdx.x < offset)
+                s_sum[threadIdx.x] += s_sum[threadIdx.x + offset];
+            __syncthreads();
+            }
+
+        if (threadIdx.x == 0)
+            d_partial[blockIdx.x * points + lag] = s_sum[0];
+        __syncthreads();
+        }
+    }
+
+//! Add the block sums of each lag to the correlation
+/*! \param d_corr Sums of the correlations of the level, one per lag
+    \param d_partial Sums over the channels of each block (block, lag)
+    \param num_blocks Number of blocks in d_partial
+    \param points Number of lags per block in d_partial
+    \param first_lag First lag to add
+
+    One block is executed per lag. The block size must be a power of two.
+*/
+__global__ void gpu_correlator_reduce_partial_kernel(double* d_corr,
+                                                     const double* d_partial,
+                                                     const unsigned int num_blocks,
+                                                     const unsigned int points,
+                                                     const unsigned int first_lag)
+    {
+    extern __shared__ double s_sum[];
+
+    const unsigned int lag = first_lag + blockIdx.x;
+
+    double sum = 0.0;
+    for (unsigned int block = threadIdx.x; block < num_blocks; block += blockDim.x)
+        sum += d_partial[block * points + lag];
+
+    s_sum[threadIdx.x] = sum;
+    __syncthreads();
+
+    for (unsigned int offset = blockDim.x / 2; offset > 0; offset >>= 1)
+        {
+        if (threadIdx.x < offset)
+            s_sum[threadIdx.x] += s_sum[threadIdx.x + offset];
+        __syncthreads();
+        }
+
+    if (threadIdx.x == 0)
+        d_corr[lag] += s_sum[0];
+    }
+
+/*! \param d_sample Sample to fill, three values per group member
+    \param d_member_tags Tags of the group members, in ascending order
+    \param d_rtag Particle indices by tag
+    \param d_pos Particle positions
+    \param d_image Particle images
+    \param d_vel Particle velocities
+    \param box Global simulation box
+    \param num_members Number of group members
+    \param position Sample unwrapped positions when true, velocities when false
+    \param block_size Number of threads per block
+*/
+hipError_t gpu_correlator_sample_particles(Scalar* d_sample,
+                                           const unsigned int* d_member_tags,
+                                           const unsigned int* d_rtag,
+                                           const Scalar4* d_pos,
+                                           const int3* d_image,
+                                           const Scalar4* d_vel,
+                                           const BoxDim& box,
+                                           const unsigned int num_members,
+                                           const bool position,
+                                           const unsigned int block_size)
+    {
+    if (num_members == 0)
+        return hipSuccess;
+
+    hipLaunchKernelGGL((gpu_correlator_sample_particles_kernel),
+                       dim3((num_members + block_size - 1) / block_size),
+                       dim3(block_size),
+                       0,
+                       0,
+                       d_sample,
+                       d_member_tags,
+                       d_rtag,
+                       d_pos,
+                       d_image,
+                       d_vel,
+                       box,
+                       num_members,
+                       position);
+
+    return hipSuccess;
+    }
+
+/*! \param d_shift Circular buffer of the level (slot, channel)
+    \param d_accum Sums to pass to the next level, NULL for the last level
+    \param d_source New value of each channel, before scaling
+    \param scale Factor applied to the new values
+    \param clear_source Set d_source to 0 after reading it
+    \param d_partial Scratch space for (number of blocks) * points block sums
+    \param d_corr Sums of the correlations of the level, one per lag
+    \param num_channels Number of channels
+    \param points Number of slots in the level
+    \param head Slot of the new value
+    \param first_lag First lag to correlate
+    \param num_lags One past the last lag to correlate
+    \param difference Correlate (a - b)^2 instead of a * b
+    \param block_size Number of threads per block, a power of two
+*/
+hipError_t gpu_correlator_update_level(Scalar* d_shift,
+                                       Scalar* d_accum,
+                                       Scalar* d_source,
+                                       const Scalar scale,
+                                       const bool clear_source,
+                                       double* d_partial,
+                                       double* d_corr,
+                                       const unsigned int num_channels,
+                                       const unsigned int points,
+                                       const unsigned int head,
+                                       const unsigned int first_lag,
+                                       const unsigned int num_lags,
+                                       const bool difference,
+                                       const unsigned int block_size)
+    {
+    if (num_channels == 0)
+        return hipSuccess;
+
+    const unsigned int num_blocks = (num_channels + block_size - 1) / block_size;
+    hipLaunchKernelGGL((gpu_correlator_update_level_kernel),
+                       dim3(num_blocks),
+                       dim3(block_size),
+                       block_size * sizeof(double),
+                       0,
+                       d_shift,
+                       d_accum,
+                       d_source,
+                       scale,
+                       clear_source,
+                       d_partial,
+                       num_channels,
+                       points,
+                       head,
+                       first_lag,
+                       num_lags,
+                       difference);
+
+    if (num_lags > first_lag)
+        {
+        hipLaunchKernelGGL((gpu_correlator_reduce_partial_kernel),
+                           dim3(num_lags - first_lag),
+                           dim3(block_size),
+                           block_size * sizeof(double),
+                           0,
+                           d_corr,
+                           d_partial,
+                           num_blocks,
+                           points,
+                           first_lag);
+        }
+
+    return hipSuccess;
+    }
@@ -0,0 +1,44 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#ifndef _CORRELATOR_PARTICLE_GPU_CUH_
+#define _CORRELATOR_PARTICLE_GPU_CUH_
+
+#include <hip/hip_runtime.h>
+
+#include "hoomd/BoxDim.h"
+#include "hoomd/HOOMDMath.h"
+
+/*! \file CorrelatorParticleGPU.cuh
+    \brief Kernel driver function declarations for CorrelatorParticleGPU
+*/
+
+//! Sample the velocities or unwrapped positions of the group members in tag order
+hipError_t gpu_correlator_sample_particles(Scalar* d_sample,
+                                           const unsigned int* d_member_tags,
+                                           const unsigned int* d_rtag,
+                                           const Scalar4* d_pos,
+                                           const int3* d_image,
+                                           const Scalar4* d_vel,
+                                           const BoxDim& box,
+                                           const unsigned int num_members,
+                                           const bool position,
+                                           const unsigned int block_size);
+
+//! Insert a value into a correlator level and add its correlations
+hipError_t gpu_correlator_update_level(Scalar* d_shift,
+                                       Scalar* d_accum,
+                                       Scalar* d_source,
+                                       const Scalar scale,
+                                       const bool clear_source,
+                                       double* d_partial,
+                                       double* d_corr,
+                                       const unsigned int num_channels,
+                                       const unsigned int points,
+                                       const unsigned int head,
+                                       const unsigned int first_lag,
+                                       const unsigned int num_lags,
+                                       const bool difference,
+                                       const unsigned int block_size);
+
+#endif
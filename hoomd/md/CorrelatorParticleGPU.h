@@ -0,0 +1,58 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "CorrelatorParticle.h"
+
+#ifndef __CORRELATOR_PARTICLE_GPU_H__
+#define __CORRELATOR_PARTICLE_GPU_H__
+
+#ifdef ENABLE_HIP
+
+/*! \file CorrelatorParticleGPU.h
+    \brief Declares the GPU implementation of CorrelatorParticle
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include <pybind11/pybind11.h>
+
+//! Velocity autocorrelation or mean squared displacement on the GPU
+/*! The samples, the level buffers, and the correlation sums stay on the device. Each level update
+    sums the correlations over the channels with a block reduction, so nothing is copied to the
+    host until the correlation is requested.
+
+    \ingroup analyzers
+*/
+class PYBIND11_EXPORT CorrelatorParticleGPU : public CorrelatorParticle
+    {
+    public:
+    //! Constructs the correlator
+    CorrelatorParticleGPU(std::shared_ptr<SystemDefinition> sysdef,
+                          std::shared_ptr<ParticleGroup> group,
+                          bool position,
+                          unsigned int points,
+                          unsigned int averaging,
+                          unsigned int levels);
+
+    //! Destructor
+    virtual ~CorrelatorParticleGPU();
+
+    protected:
+    //! Sample the velocities or unwrapped positions on the GPU
+    virtual void sample(uint64_t timestep);
+
+    //! Update a level on the GPU
+    virtual void updateLevel(unsigned int level, unsigned int first_lag, unsigned int num_lags);
+
+    private:
+    GlobalArray<double> m_partial; //!< Sums of the correlations in each block (block, lag)
+    unsigned int m_block_size;     //!< Block size executed
+    };
+
+//! Exports the CorrelatorParticleGPU class to python
+void export_CorrelatorParticleGPU(pybind11::module& m);
+
+#endif // ENABLE_HIP
+#endif // __CORRELATOR_PARTICLE_GPU_H__
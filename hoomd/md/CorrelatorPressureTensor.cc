@@ -0,0 +1,68 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file CorrelatorPressureTensor.cc
+    \brief Contains code for the CorrelatorPressureTensor class
+*/
+
+#include "CorrelatorPressureTensor.h"
+
+namespace py = pybind11;
+
+using namespace std;
+
+/*! \param sysdef System definition
+    \param thermo Computes the pressure tensor
+    \param points Number of values kept per level
+    \param averaging Number of values averaged into the next level
+    \param levels Number of levels
+*/
+CorrelatorPressureTensor::CorrelatorPressureTensor(std::shared_ptr<SystemDefinition> sysdef,
+                                                   std::shared_ptr<ComputeThermo> thermo,
+                                                   unsigned int points,
+                                                   unsigned int averaging,
+                                                   unsigned int levels)
+    : CorrelatorMultipleTau(sysdef,
+                            sysdef->getNDimensions() == 2 ? 1 : 3,
+                            points,
+                            averaging,
+                            levels,
+                            false,
+                            sysdef->getNDimensions() == 2 ? Scalar(1.0) : Scalar(1.0 / 3.0)),
+      m_thermo(thermo)
+    {
+    m_exec_conf->msg->notice(5) << "Constructing CorrelatorPressureTensor" << endl;
+    }
+
+CorrelatorPressureTensor::~CorrelatorPressureTensor()
+    {
+    m_exec_conf->msg->notice(5) << "Destroying CorrelatorPressureTensor" << endl;
+    }
+
+/*! \param timestep Current time step of the simulation
+ */
+void CorrelatorPressureTensor::sample(uint64_t timestep)
+    {
+    m_thermo->computeQuantities(timestep, thermo_quantity::pressure_tensor);
+    const PressureTensor p = m_thermo->getPressureTensor();
+
+    ArrayHandle<Scalar> h_sample(m_sample, access_location::host, access_mode::overwrite);
+    h_sample.data[0] = p.xy;
+    if (m_num_channels == 3)
+        {
+        h_sample.data[1] = p.xz;
+        h_sample.data[2] = p.yz;
+        }
+    }
+
+void export_CorrelatorPressureTensor(py::module& m)
+    {
+    py::class_<CorrelatorPressureTensor,
+               CorrelatorMultipleTau,
+               std::shared_ptr<CorrelatorPressureTensor>>(m, "CorrelatorPressureTensor")
+        .def(py::init<std::shared_ptr<SystemDefinition>,
+                      std::shared_ptr<ComputeThermo>,
+                      unsigned int,
+                      unsigned int,
+                      unsigned int>());
+    }
@@ -0,0 +1,58 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "ComputeThermo.h"
+#include "CorrelatorMultipleTau.h"
+
+/*! \file CorrelatorPressureTensor.h
+    \brief Declares a multiple-tau correlator of the off-diagonal pressure tensor
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include <pybind11/pybind11.h>
+
+#ifndef __CORRELATOR_PRESSURE_TENSOR_H__
+#define __CORRELATOR_PRESSURE_TENSOR_H__
+
+//! Autocorrelation of the off-diagonal pressure tensor components
+/*! The channels are P_xy, P_xz, and P_yz (only P_xy in 2D) from a ComputeThermo, and the result is
+    averaged over the channels. The pressure tensor is computed by the ComputeThermo on the CPU or
+    GPU, so the few channels are always correlated on the host.
+
+    \ingroup analyzers
+*/
+class PYBIND11_EXPORT CorrelatorPressureTensor : public CorrelatorMultipleTau
+    {
+    public:
+    //! Constructs the correlator
+    CorrelatorPressureTensor(std::shared_ptr<SystemDefinition> sysdef,
+                             std::shared_ptr<ComputeThermo> thermo,
+                             unsigned int points,
+                             unsigned int averaging,
+                             unsigned int levels);
+
+    //! Destructor
+    virtual ~CorrelatorPressureTensor();
+
+    //! The pressure tensor is needed on every sample
+    virtual PDataFlags getRequestedPDataFlags()
+        {
+        PDataFlags flags(0);
+        flags[pdata_flag::pressure_tensor] = 1;
+        return flags;
+        }
+
+    protected:
+    std::shared_ptr<ComputeThermo> m_thermo; //!< Computes the pressure tensor
+
+    //! Sample the off-diagonal pressure tensor components
+    virtual void sample(uint64_t timestep);
+    };
+
+//! Exports the CorrelatorPressureTensor class to python
+void export_CorrelatorPressureTensor(pybind11::module& m);
+
+#endif
@@ -10,6 +10,7 @@
 #include <string>
 #endif
 
+#include "MDPrecisionSetup.h"
 #include "hoomd/HOOMDMath.h"
 
 /*! \file EvaluatorBondHarmonic.h
@@ -114,8 +115,10 @@ class EvaluatorBondHarmonic
     */
     DEVICE bool evalForceAndEnergy(Scalar& force_divr, Scalar& bond_eng)
         {
-        Scalar r = sqrt(rsq);
-        force_divr = K * (r_0 / r - Scalar(1.0));
+        const ShortReal K_s = ShortReal(K);
+        const ShortReal r_0_s = ShortReal(r_0);
+        ShortReal r = fast::sqrt(ShortReal(rsq));
+        force_divr = Scalar(K_s * (r_0_s / r - ShortReal(1.0)));
 
 // if the result is not finite, it is likely because of a division by 0, setting force_divr to 0
 // will correctly result in a 0 force in this case
@@ -127,7 +130,7 @@ class EvaluatorBondHarmonic
             {
             force_divr = Scalar(0);
             }
-        bond_eng = Scalar(0.5) * K * (r_0 - r) * (r_0 - r);
+        bond_eng = Scalar(ShortReal(0.5) * K_s * (r_0_s - r) * (r_0_s - r));
 
         return true;
         }
@@ -0,0 +1,237 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#ifndef __EVALUATOR_EXTERNAL_COMPOSITE_H__
+#define __EVALUATOR_EXTERNAL_COMPOSITE_H__
+
+#ifndef __HIPCC__
+#include <pybind11/pybind11.h>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#endif
+
+#include "hoomd/BoxDim.h"
+#include "hoomd/HOOMDMath.h"
+
+/*! \file EvaluatorExternalComposite.h
+    \brief Defines an external potential evaluator that sums two other external evaluators
+*/
+
+// need to declare these class methods with __device__ qualifiers when building in nvcc
+// DEVICE is __host__ __device__ when included in nvcc and blank when included into the host
+// compiler
+#ifdef __HIPCC__
+#define DEVICE __device__
+#else
+#define DEVICE
+#endif
+
+//! Class for evaluating the sum of two external potentials
+/*! <b>General Overview</b>
+    EvaluatorExternalComposite evaluates the external evaluators \a evaluator_a and \a evaluator_b
+    for the same particle and sums their forces, energies, and virials. PotentialExternal
+    instantiated with it computes both fields in one pass over the particles (one kernel on the
+    GPU) and writes one force array, instead of one pass and one force array per field.
+    Composites nest, so evaluator_b may itself be an EvaluatorExternalComposite.
+
+    The per-type parameters and the field hold those of both evaluators. In python, the parameters
+    are a dict keyed by the names of the two evaluators.
+
+    The composite holds a single field grid, so at most one of the two evaluators may use one.
+*/
+template<class evaluator_a, class evaluator_b> class EvaluatorExternalComposite
+    {
+    public:
+    //! type of parameters this external potential accepts
+    struct param_type
+        {
+        typename evaluator_a::param_type a; //!< Parameters of the first evaluator
+        typename evaluator_b::param_type b; //!< Parameters of the second evaluator
+
+#ifndef __HIPCC__
+        param_type() : a(), b() { }
+
+        param_type(pybind11::dict params)
+            : a(pybind11::object(params[evaluator_a::getName().c_str()])),
+              b(pybind11::object(params[evaluator_b::getName().c_str()]))
+            {
+            }
+
+        pybind11::dict toPython()
+            {
+            pybind11::dict d;
+            d[evaluator_a::getName().c_str()] = a.toPython();
+            d[evaluator_b::getName().c_str()] = b.toPython();
+            return d;
+            }
+#endif
+        } __attribute__((aligned(16)));
+
+    //! type of the field
+    struct field_type
+        {
+        typename evaluator_a::field_type a; //!< Field of the first evaluator
+        typename evaluator_b::field_type b; //!< Field of the second evaluator
+        };
+
+    //! Constructs the evaluator
+    /*! \param X position of particle
+        \param box box dimensions
+        \param params per-type parameters of external potential
+        \param field field of the external potential
+    */
+    DEVICE EvaluatorExternalComposite(Scalar3 X,
+                                      const BoxDim& box,
+                                      const param_type& params,
+                                      const field_type& field)
+        : m_eval_a(X, box, params.a, field.a), m_eval_b(X, box, params.b, field.b)
+        {
+        }
+
+    //! Diameters are needed when either evaluator needs them
+    DEVICE static bool needsDiameter()
+        {
+        return evaluator_a::needsDiameter() || evaluator_b::needsDiameter();
+        }
+
+    //! Accept the optional diameter value
+    /*! \param di Diameter of particle i
+     */
+    DEVICE void setDiameter(Scalar di)
+        {
+        m_eval_a.setDiameter(di);
+        m_eval_b.setDiameter(di);
+        }
+
+    //! Charges are needed when either evaluator needs them
+    DEVICE static bool needsCharge()
+        {
+        return evaluator_a::needsCharge() || evaluator_b::needsCharge();
+        }
+
+    //! Accept the optional charge value
+    /*! \param qi Charge of particle i
+     */
+    DEVICE void setCharge(Scalar qi)
+        {
+        m_eval_a.setCharge(qi);
+        m_eval_b.setCharge(qi);
+        }
+
+    //! The field grid is needed when either evaluator needs it
+    DEVICE static bool needsFieldGrid()
+        {
+        return evaluator_a::needsFieldGrid() || evaluator_b::needsFieldGrid();
+        }
+
+    //! Accept the optional field grid
+    /*! \param box Simulation box
+        \param grid Field grid built by buildFieldGrid()
+        \param grid_dim Dimensions of the field grid
+        \param type Type of particle i
+
+        The grid belongs to the one evaluator that needs it, the other ignores it.
+     */
+    DEVICE void
+    setFieldGrid(const BoxDim& box, const unsigned int* grid, uint3 grid_dim, unsigned int type)
+        {
+        m_eval_a.setFieldGrid(box, grid, grid_dim, type);
+        m_eval_b.setFieldGrid(box, grid, grid_dim, type);
+        }
+
+#ifndef __HIPCC__
+    //! Build the field grid of the evaluator that needs one
+    /*! \param field Field of the potential
+        \param params Per-type parameters
+        \param n_types Number of particle types
+        \param box Global simulation box
+        \param n_dimensions Dimensionality of the system
+        \param grid_dim Dimensions of the grid (output)
+        \param grid Field grid (output)
+    */
+    static void buildFieldGrid(const field_type& field,
+                               const param_type* params,
+                               unsigned int n_types,
+                               const BoxDim& box,
+                               unsigned int n_dimensions,
+                               uint3& grid_dim,
+                               std::vector<unsigned int>& grid)
+        {
+        if (evaluator_a::needsFieldGrid() && evaluator_b::needsFieldGrid())
+            throw std::runtime_error("At most one evaluator in a composite external potential "
+                                     "may use a field grid");
+
+        if (evaluator_a::needsFieldGrid())
+            {
+            std::vector<typename evaluator_a::param_type> params_a(n_types);
+            for (unsigned int i = 0; i < n_types; i++)
+                params_a[i] = params[i].a;
+            evaluator_a::buildFieldGrid(field.a,
+                                        params_a.data(),
+                                        n_types,
+                                        box,
+                                        n_dimensions,
+                                        grid_dim,
+                                        grid);
+            }
+        else if (evaluator_b::needsFieldGrid())
+            {
+            std::vector<typename evaluator_b::param_type> params_b(n_types);
+            for (unsigned int i = 0; i < n_types; i++)
+                params_b[i] = params[i].b;
+            evaluator_b::buildFieldGrid(field.b,
+                                        params_b.data(),
+                                        n_types,
+                                        box,
+                                        n_dimensions,
+                                        grid_dim,
+                                        grid);
+            }
+        }
+#endif
+
+    //! The virial is defined when it is defined for both evaluators
+    DEVICE static bool requestFieldVirialTerm()
+        {
+        return evaluator_a::requestFieldVirialTerm() && evaluator_b::requestFieldVirialTerm();
+        }
+
+    //! Evaluate the force, energy and virial
+    /*! \param F force vector
+        \param energy value of the energy
+        \param virial array of six scalars for the upper triangular virial tensor
+    */
+    DEVICE void evalForceEnergyAndVirial(Scalar3& F, Scalar& energy, Scalar* virial)
+        {
+        m_eval_a.evalForceEnergyAndVirial(F, energy, virial);
+
+        Scalar3 F_b = make_scalar3(Scalar(0.0), Scalar(0.0), Scalar(0.0));
+        Scalar energy_b = Scalar(0.0);
+        Scalar virial_b[6];
+        for (unsigned int i = 0; i < 6; i++)
+            virial_b[i] = Scalar(0.0);
+        m_eval_b.evalForceEnergyAndVirial(F_b, energy_b, virial_b);
+
+        F += F_b;
+        energy += energy_b;
+        for (unsigned int i = 0; i < 6; i++)
+            virial[i] += virial_b[i];
+        }
+
+#ifndef __HIPCC__
+    //! Get the name of this potential
+    /*! \returns The potential name.
+     */
+    static std::string getName()
+        {
+        return evaluator_a::getName() + std::string("_") + evaluator_b::getName();
+        }
+#endif
+
+    protected:
+    evaluator_a m_eval_a; //!< Evaluator of the first potential
+    evaluator_b m_eval_b; //!< Evaluator of the second potential
+    };
+
+#endif // __EVALUATOR_EXTERNAL_COMPOSITE_H__
@@ -8,6 +8,7 @@
 
 #ifndef __HIPCC__
 #include <string>
+#include <vector>
 #endif
 
 #include "hoomd/BoxDim.h"
@@ -115,6 +116,36 @@ class EvaluatorExternalPeriodic
      */
     DEVICE void setCharge(Scalar qi) { }
 
+    //! External Periodic doesn't use a field grid
+    DEVICE static bool needsFieldGrid()
+        {
+        return false;
+        }
+
+    //! Accept the optional field grid
+    /*! \param box Simulation box
+        \param grid Field grid built by buildFieldGrid()
+        \param grid_dim Dimensions of the field grid
+        \param type Type of particle i
+     */
+    DEVICE void
+    setFieldGrid(const BoxDim& box, const unsigned int* grid, uint3 grid_dim, unsigned int type)
+        {
+        }
+
+#ifndef __HIPCC__
+    //! Build the field grid (not used)
+    static void buildFieldGrid(const field_type& field,
+                               const param_type* params,
+                               unsigned int n_types,
+                               const BoxDim& box,
+                               unsigned int n_dimensions,
+                               uint3& grid_dim,
+                               std::vector<unsigned int>& grid)
+        {
+        }
+#endif
+
     //! Declares additional virial contributions are needed for the external field
     /*! No contributions
      */
@@ -0,0 +1,204 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#ifndef __EVALUATOR_FUSED_BONDED_H__
+#define __EVALUATOR_FUSED_BONDED_H__
+
+#include "hoomd/HOOMDMath.h"
+
+/*! \file EvaluatorFusedBonded.h
+    \brief Defines the bond, angle, and dihedral evaluators shared by the CPU and GPU code paths
+   of FusedBondedForceCompute
+*/
+
+// need to declare these functions with __device__ qualifiers when building in nvcc
+// DEVICE is __host__ __device__ when included in nvcc and blank when included into the host
+// compiler
+#ifdef __HIPCC__
+#define DEVICE __device__
+#else
+#define DEVICE
+#endif
+
+//! Evaluate a harmonic bond
+/*! \param rsq Squared distance between the two particles
+    \param params Bond parameters (k, r_0)
+    \param force_divr Output: magnitude of the force divided by r
+    \param bond_eng Output: total energy of the bond
+
+    The force on the second particle of the bond is \a force_divr times the vector pointing from
+    the first particle to the second. Matches EvaluatorBondHarmonic.
+*/
+DEVICE inline void
+evalFusedHarmonicBond(Scalar rsq, const Scalar2& params, Scalar& force_divr, Scalar& bond_eng)
+    {
+    Scalar r = fast::sqrt(rsq);
+    force_divr = params.x * (params.y / r - Scalar(1.0));
+
+    // a zero length bond has no direction, apply no force
+    if (!(r > Scalar(0.0)))
+        force_divr = Scalar(0.0);
+
+    bond_eng = Scalar(0.5) * params.x * (params.y - r) * (params.y - r);
+    }
+
+//! Evaluate a harmonic angle
+/*! \param dab Vector from the central particle b to particle a
+    \param dcb Vector from the central particle b to particle c
+    \param params Angle parameters (k, t_0)
+    \param fab Output: force on particle a
+    \param fcb Output: force on particle c
+    \param angle_eng Output: total energy of the angle
+
+    The force on the central particle is -(fab + fcb). Matches HarmonicAngleForceCompute.
+*/
+DEVICE inline void evalFusedHarmonicAngle(const Scalar3& dab,
+                                          const Scalar3& dcb,
+                                          const Scalar2& params,
+                                          Scalar3& fab,
+                                          Scalar3& fcb,
+                                          Scalar& angle_eng)
+    {
+    Scalar rsqab = dot(dab, dab);
+    Scalar rab = fast::sqrt(rsqab);
+    Scalar rsqcb = dot(dcb, dcb);
+    Scalar rcb = fast::sqrt(rsqcb);
+
+    Scalar c_abbc = dot(dab, dcb) / (rab * rcb);
+    if (c_abbc > Scalar(1.0))
+        c_abbc = Scalar(1.0);
+    if (c_abbc < -Scalar(1.0))
+        c_abbc = -Scalar(1.0);
+
+    Scalar s_abbc = fast::sqrt(Scalar(1.0) - c_abbc * c_abbc);
+    if (s_abbc < Scalar(0.001))
+        s_abbc = Scalar(0.001);
+    s_abbc = Scalar(1.0) / s_abbc;
+
+    Scalar dth = fast::acos(c_abbc) - params.y;
+    Scalar tk = params.x * dth;
+
+    Scalar a = -tk * s_abbc;
+    Scalar a11 = a * c_abbc / rsqab;
+    Scalar a12 = -a / (rab * rcb);
+    Scalar a22 = a * c_abbc / rsqcb;
+
+    fab = a11 * dab + a12 * dcb;
+    fcb = a22 * dcb + a12 * dab;
+
+    angle_eng = Scalar(0.5) * tk * dth;
+    }
+
+//! Evaluate an OPLS dihedral
+/*! \param vb1 Vector from particle b to particle a
+    \param vb2 Vector from particle b to particle c
+    \param vb3 Vector from particle c to particle d
+    \param params Dihedral parameters (k1/2, k2/2, k3/2, k4/2)
+    \param f1 Output: force on particle a
+    \param f2 Output: force on particle b
+    \param f3 Output: force on particle c
+    \param f4 Output: force on particle d
+    \param dihedral_eng Output: total energy of the dihedral
+
+    Matches OPLSDihedralForceCompute, which follows the LAMMPS implementation.
+*/
+DEVICE inline void evalFusedOPLSDihedral(const Scalar3& vb1,
+                                         const Scalar3& vb2,
+                                         const Scalar3& vb3,
+                                         const Scalar4& params,
+                                         Scalar3& f1,
+                                         Scalar3& f2,
+                                         Scalar3& f3,
+                                         Scalar3& f4,
+                                         Scalar& dihedral_eng)
+    {
+    Scalar3 vb2m = -vb2;
+
+    // c,s calculation
+    Scalar3 a = make_scalar3(vb1.y * vb2m.z - vb1.z * vb2m.y,
+                             vb1.z * vb2m.x - vb1.x * vb2m.z,
+                             vb1.x * vb2m.y - vb1.y * vb2m.x);
+    Scalar3 b = make_scalar3(vb3.y * vb2m.z - vb3.z * vb2m.y,
+                             vb3.z * vb2m.x - vb3.x * vb2m.z,
+                             vb3.x * vb2m.y - vb3.y * vb2m.x);
+
+    Scalar rasq = dot(a, a);
+    Scalar rbsq = dot(b, b);
+    Scalar rgsq = dot(vb2m, vb2m);
+    Scalar rg = fast::sqrt(rgsq);
+
+    Scalar rginv, ra2inv, rb2inv;
+    rginv = ra2inv = rb2inv = Scalar(0.0);
+    if (rg > Scalar(0.0))
+        rginv = Scalar(1.0) / rg;
+    if (rasq > Scalar(0.0))
+        ra2inv = Scalar(1.0) / rasq;
+    if (rbsq > Scalar(0.0))
+        rb2inv = Scalar(1.0) / rbsq;
+    Scalar rabinv = fast::sqrt(ra2inv * rb2inv);
+
+    Scalar c = dot(a, b) * rabinv;
+    Scalar s = rg * rabinv * dot(a, vb3);
+
+    if (c > Scalar(1.0))
+        c = Scalar(1.0);
+    if (c < -Scalar(1.0))
+        c = -Scalar(1.0);
+
+    // calculate the potential p = sum (i=1,4) k_i * (1 + (-1)**(i+1)*cos(i*phi) )
+    // and df = dp/dc, the 1/2 factor is already stored in the parameters
+
+    // cos(phi) term
+    Scalar ddf1 = c;
+    Scalar df1 = s;
+    Scalar cos_term = ddf1;
+
+    Scalar p = params.x * (Scalar(1.0) + cos_term);
+    Scalar df = params.x * df1;
+
+    // cos(2*phi) term
+    ddf1 = cos_term * c - df1 * s;
+    df1 = cos_term * s + df1 * c;
+    cos_term = ddf1;
+
+    p += params.y * (Scalar(1.0) - cos_term);
+    df += -Scalar(2.0) * params.y * df1;
+
+    // cos(3*phi) term
+    ddf1 = cos_term * c - df1 * s;
+    df1 = cos_term * s + df1 * c;
+    cos_term = ddf1;
+
+    p += params.z * (Scalar(1.0) + cos_term);
+    df += Scalar(3.0) * params.z * df1;
+
+    // cos(4*phi) term
+    ddf1 = cos_term * c - df1 * s;
+    df1 = cos_term * s + df1 * c;
+    cos_term = ddf1;
+
+    p += params.w * (Scalar(1.0) - cos_term);
+    df += -Scalar(4.0) * params.w * df1;
+
+    Scalar fg = dot(vb1, vb2m);
+    Scalar hg = dot(vb3, vb2m);
+    Scalar fga = fg * ra2inv * rginv;
+    Scalar hgb = hg * rb2inv * rginv;
+    Scalar gaa = -ra2inv * rg;
+    Scalar gbb = rb2inv * rg;
+
+    Scalar3 dtf = gaa * a;
+    Scalar3 dtg = fga * a - hgb * b;
+    Scalar3 dth = gbb * b;
+
+    Scalar3 s2 = df * dtg;
+
+    f1 = df * dtf;
+    f2 = s2 - f1;
+    f4 = df * dth;
+    f3 = -s2 - f4;
+
+    dihedral_eng = p;
+    }
+
+#endif // __EVALUATOR_FUSED_BONDED_H__
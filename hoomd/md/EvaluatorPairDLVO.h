@@ -10,6 +10,7 @@
 #include <string>
 #endif
 
+#include "MDPrecisionSetup.h"
 #include "hoomd/HOOMDMath.h"
 
 /*! \file EvaluatorPairDLVO.h
@@ -149,9 +150,9 @@ class EvaluatorPairDLVO
     DEVICE bool evalForceAndEnergy(Scalar& force_divr, Scalar& pair_eng, bool energy_shift)
         {
         // precompute some quantities
-        Scalar rinv = fast::rsqrt(rsq);
+        Scalar rinv = md_fast::rsqrt(rsq);
         Scalar r = Scalar(1.0) / rinv;
-        Scalar rcutinv = fast::rsqrt(rcutsq);
+        Scalar rcutinv = md_fast::rsqrt(rcutsq);
         Scalar rcut = Scalar(1.0) / rcutinv;
 
         // compute the force divided by r in force_divr
@@ -163,7 +164,7 @@ class EvaluatorPairDLVO
             Scalar radsuminv = Scalar(1.0) / radsum;
             Scalar rmdsqsinv = Scalar(1.0) / rmdsqs;
             Scalar rmdsqminv = Scalar(1.0) / rmdsqm;
-            Scalar exp_val = fast::exp(-kappa * rmds);
+            Scalar exp_val = md_fast::exp(-kappa * rmds);
             Scalar forcerep_divr = kappa * radprod * radsuminv * Z * exp_val / r;
             Scalar fatrterm1 = r * r * r * r + radsubsq * radsubsq - Scalar(2.0) * r * r * radsumsq;
             Scalar fatrterm1inv = Scalar(1.0) / fatrterm1 * Scalar(1.0) / fatrterm1;
@@ -187,7 +188,7 @@ class EvaluatorPairDLVO
                 Scalar engt1cut = radprod * rmdsqsinvcut * A / Scalar(3.0);
                 Scalar engt2cut = radprod * rmdsqminvcut * A / Scalar(3.0);
                 Scalar engt3cut = slow::log(rmdsqscut * rmdsqminvcut) * A / Scalar(6.0);
-                Scalar exp_valcut = fast::exp(-kappa * rmdscut);
+                Scalar exp_valcut = md_fast::exp(-kappa * rmdscut);
                 Scalar forcerepcut_divr = kappa * radprod * radsuminv * Z * exp_valcut / rcutt;
                 pair_eng -= rcutt * forcerepcut_divr / kappa - engt1cut - engt2cut - engt3cut;
                 }
@@ -129,7 +129,8 @@ class EvaluatorPairDipole
                                    Scalar _rcutsq,
                                    const param_type& _params)
         : dr(_dr), rcutsq(_rcutsq), q_i(0), q_j(0), quat_i(_quat_i),
-          quat_j(_quat_j), mu_i {0, 0, 0}, mu_j {0, 0, 0}, A(_params.A), kappa(_params.kappa)
+          quat_j(_quat_j), mu_i {0, 0, 0}, mu_j {0, 0, 0}, A(_params.A), kappa(_params.kappa),
+          cached_moments(false)
         {
         }
 
@@ -194,6 +195,35 @@ class EvaluatorPairDipole
         q_j = qj;
         }
 
+    //! Whether the pair potential uses a per particle vector cached once per step
+    HOSTDEVICE static bool needsOrientationCache()
+        {
+        return true;
+        }
+
+    //! Compute the cached per particle vector
+    /*! \param q Orientation of the particle
+        \param shape Shape parameters of the particle's type
+        \returns The dipole moment of the particle in the space frame
+    */
+    HOSTDEVICE static Scalar3 cacheOrientation(const Scalar4& q, const shape_type& shape)
+        {
+        return vec_to_scalar3(rotate(quat<Scalar>(q), shape.mu));
+        }
+
+    //! Accept the cached per particle vectors
+    /*! \param ci Dipole moment of particle i in the space frame
+        \param cj Dipole moment of particle j in the space frame
+
+        When set, evaluate() uses the cached moments instead of rotating mu_i and mu_j.
+    */
+    HOSTDEVICE void setOrientationCache(const Scalar3& ci, const Scalar3& cj)
+        {
+        p_cached_i = vec3<Scalar>(ci);
+        p_cached_j = vec3<Scalar>(cj);
+        cached_moments = true;
+        }
+
     //! Evaluate the force and energy
     /*! \param force Output parameter to write the computed force.
         \param pair_eng Output parameter to write the computed pair energy.
@@ -223,8 +253,13 @@ class EvaluatorPairDipole
 
         // convert dipole vector in the body frame of each particle to space
         // frame
-        vec3<Scalar> p_i = rotate(quat<Scalar>(quat_i), mu_i);
-        vec3<Scalar> p_j = rotate(quat<Scalar>(quat_j), mu_j);
+        vec3<Scalar> p_i = p_cached_i;
+        vec3<Scalar> p_j = p_cached_j;
+        if (!cached_moments)
+            {
+            p_i = rotate(quat<Scalar>(quat_i), mu_i);
+            p_j = rotate(quat<Scalar>(quat_j), mu_j);
+            }
 
         vec3<Scalar> f;
         vec3<Scalar> t_i;
@@ -332,6 +367,9 @@ class EvaluatorPairDipole
     vec3<Scalar> mu_j;      /// Magnetic moment for jth particle
     Scalar A;
     Scalar kappa;
+    vec3<Scalar> p_cached_i; /// Cached space frame dipole moment of particle i
+    vec3<Scalar> p_cached_j; /// Cached space frame dipole moment of particle j
+    bool cached_moments;     /// True when p_cached_i and p_cached_j are set
     // const param_type &params;   //!< The pair potential parameters
     };
 
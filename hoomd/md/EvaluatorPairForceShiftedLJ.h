@@ -10,6 +10,8 @@
 #include <string>
 #endif
 
+#include "MDPrecisionSetup.h"
+#include "PairEvaluatorBatchTraits.h"
 #include "hoomd/HOOMDMath.h"
 #include "hoomd/md/EvaluatorPairLJ.h"
 
@@ -107,25 +109,32 @@ class EvaluatorPairForceShiftedLJ
         // compute the force divided by r in force_divr
         if (rsq < rcutsq && lj1 != 0)
             {
-            Scalar r2inv = Scalar(1.0) / rsq;
-            Scalar r6inv = r2inv * r2inv * r2inv;
-            force_divr = r2inv * r6inv * (Scalar(12.0) * lj1 * r6inv - Scalar(6.0) * lj2);
+            const ShortReal lj1_s = ShortReal(lj1);
+            const ShortReal lj2_s = ShortReal(lj2);
+            const ShortReal rsq_s = ShortReal(rsq);
+            const ShortReal rcutsq_s = ShortReal(rcutsq);
+            ShortReal r2inv = ShortReal(1.0) / rsq_s;
+            ShortReal r6inv = r2inv * r2inv * r2inv;
+            ShortReal f
+                = r2inv * r6inv * (ShortReal(12.0) * lj1_s * r6inv - ShortReal(6.0) * lj2_s);
 
-            pair_eng = r6inv * (lj1 * r6inv - lj2);
+            ShortReal eng = r6inv * (lj1_s * r6inv - lj2_s);
 
-            Scalar rcut2inv = Scalar(1.0) / rcutsq;
-            Scalar rcut6inv = rcut2inv * rcut2inv * rcut2inv;
+            ShortReal rcut2inv = ShortReal(1.0) / rcutsq_s;
+            ShortReal rcut6inv = rcut2inv * rcut2inv * rcut2inv;
 
             if (energy_shift)
-                pair_eng -= rcut6inv * (lj1 * rcut6inv - lj2);
+                eng -= rcut6inv * (lj1_s * rcut6inv - lj2_s);
 
             // shift force and add linear term to potential
-            Scalar rcut_r_inv = fast::rsqrt(rsq * rcutsq);
-            Scalar force_rcut_at_rcut
-                = rcut6inv * (Scalar(12.0) * lj1 * rcut6inv - Scalar(6.0) * lj2);
-            force_divr -= rcut_r_inv * force_rcut_at_rcut;
-            pair_eng += (rsq * rcut_r_inv - Scalar(1.0)) * force_rcut_at_rcut;
-
+            ShortReal rcut_r_inv = fast::rsqrt(rsq_s * rcutsq_s);
+            ShortReal force_rcut_at_rcut
+                = rcut6inv * (ShortReal(12.0) * lj1_s * rcut6inv - ShortReal(6.0) * lj2_s);
+            f -= rcut_r_inv * force_rcut_at_rcut;
+            eng += (rsq_s * rcut_r_inv - ShortReal(1.0)) * force_rcut_at_rcut;
+
+            force_divr = Scalar(f);
+            pair_eng = Scalar(eng);
             return true;
             }
         else
@@ -154,4 +163,10 @@ class EvaluatorPairForceShiftedLJ
     Scalar lj2;    //!< lj2 parameter extracted from the params passed to the constructor
     };
 
+//! The batched CPU force loop supports EvaluatorPairForceShiftedLJ
+template<> struct PairEvaluatorBatchTraits<EvaluatorPairForceShiftedLJ>
+    {
+    static const bool enabled = true;
+    };
+
 #endif // __PAIR_EVALUATOR_FORCE_SHIFTED_LJ_H__
@@ -134,7 +134,7 @@ class EvaluatorPairGB
                                const Scalar _rcutsq,
                                const param_type& _params)
         : dr(_dr), rcutsq(_rcutsq), qi(_qi), qj(_qj), epsilon(_params.epsilon),
-          lperp(_params.lperp), lpar(_params.lpar)
+          lperp(_params.lperp), lpar(_params.lpar), cached_axes(false)
         {
         }
 
@@ -191,6 +191,35 @@ class EvaluatorPairGB
     */
     HOSTDEVICE void setCharge(Scalar qi, Scalar qj) { }
 
+    //! Whether the pair potential uses a per particle vector cached once per step
+    HOSTDEVICE static bool needsOrientationCache()
+        {
+        return true;
+        }
+
+    //! Compute the cached per particle vector
+    /*! \param q Orientation of the particle
+        \param shape Shape parameters of the particle's type
+        \returns The long axis of the particle in the space frame
+    */
+    HOSTDEVICE static Scalar3 cacheOrientation(const Scalar4& q, const shape_type& shape)
+        {
+        return vec_to_scalar3(rotate(quat<Scalar>(q), vec3<Scalar>(0, 0, 1)));
+        }
+
+    //! Accept the cached per particle vectors
+    /*! \param ci Long axis of particle i in the space frame
+        \param cj Long axis of particle j in the space frame
+
+        When set, evaluate() uses the cached axes instead of the orientation quaternions.
+    */
+    HOSTDEVICE void setOrientationCache(const Scalar3& ci, const Scalar3& cj)
+        {
+        ai = vec3<Scalar>(ci);
+        aj = vec3<Scalar>(cj);
+        cached_axes = true;
+        }
+
     //! Evaluate the force and energy
     /*! \param force Output parameter to write the computed force.
         \param pair_eng Output parameter to write the computed pair energy.
@@ -209,13 +238,18 @@ class EvaluatorPairGB
         Scalar r = fast::sqrt(rsq);
         vec3<Scalar> unitr = fast::rsqrt(dot(dr, dr)) * dr;
 
-        // obtain rotation matrices (space->body)
-        rotmat3<Scalar> rotA(conj(qi));
-        rotmat3<Scalar> rotB(conj(qj));
+        vec3<Scalar> a3 = ai;
+        vec3<Scalar> b3 = aj;
+        if (!cached_axes)
+            {
+            // obtain rotation matrices (space->body)
+            rotmat3<Scalar> rotA(conj(qi));
+            rotmat3<Scalar> rotB(conj(qj));
 
-        // last row of rotation matrix
-        vec3<Scalar> a3 = rotA.row2;
-        vec3<Scalar> b3 = rotB.row2;
+            // last row of rotation matrix
+            a3 = rotA.row2;
+            b3 = rotB.row2;
+            }
 
         Scalar ca = dot(a3, unitr);
         Scalar cb = dot(b3, unitr);
@@ -308,6 +342,9 @@ class EvaluatorPairGB
     Scalar epsilon;
     Scalar lperp;
     Scalar lpar;
+    vec3<Scalar> ai;  //!< Cached long axis of particle i
+    vec3<Scalar> aj;  //!< Cached long axis of particle j
+    bool cached_axes; //!< True when ai and aj are set
     // const param_type &params;  //!< The pair potential parameters
     };
 
@@ -10,6 +10,8 @@
 #include <string>
 #endif
 
+#include "MDPrecisionSetup.h"
+#include "PairEvaluatorBatchTraits.h"
 #include "hoomd/HOOMDMath.h"
 
 /*! \file EvaluatorPairGauss.h
@@ -144,17 +146,21 @@ class EvaluatorPairGauss
         // compute the force divided by r in force_divr
         if (rsq < rcutsq)
             {
-            Scalar sigma_sq = sigma * sigma;
-            Scalar r_over_sigma_sq = rsq / sigma_sq;
-            Scalar exp_val = fast::exp(-Scalar(1.0) / Scalar(2.0) * r_over_sigma_sq);
+            const ShortReal epsilon_s = ShortReal(epsilon);
+            ShortReal sigma_sq = ShortReal(sigma) * ShortReal(sigma);
+            ShortReal r_over_sigma_sq = ShortReal(rsq) / sigma_sq;
+            ShortReal exp_val = md_fast::exp(-ShortReal(1.0) / ShortReal(2.0) * r_over_sigma_sq);
 
-            force_divr = epsilon / sigma_sq * exp_val;
-            pair_eng = epsilon * exp_val;
+            force_divr = Scalar(epsilon_s / sigma_sq * exp_val);
+            ShortReal eng = epsilon_s * exp_val;
 
             if (energy_shift)
                 {
-                pair_eng -= epsilon * fast::exp(-Scalar(1.0) / Scalar(2.0) * rcutsq / sigma_sq);
+                eng -= epsilon_s
+                       * md_fast::exp(-ShortReal(1.0) / ShortReal(2.0) * ShortReal(rcutsq)
+                                      / sigma_sq);
                 }
+            pair_eng = Scalar(eng);
             return true;
             }
         else
@@ -183,4 +189,10 @@ class EvaluatorPairGauss
     Scalar sigma;   //!< sigma parameter extracted from the params passed to the constructor
     };
 
+//! The batched CPU force loop supports EvaluatorPairGauss
+template<> struct PairEvaluatorBatchTraits<EvaluatorPairGauss>
+    {
+    static const bool enabled = true;
+    };
+
 #endif // __PAIR_EVALUATOR_GAUSS_H__
@@ -10,6 +10,8 @@
 #include <string>
 #endif
 
+#include "MDPrecisionSetup.h"
+#include "PairEvaluatorBatchTraits.h"
 #include "hoomd/HOOMDMath.h"
 
 /*! \file EvaluatorPairLJ.h
@@ -204,18 +206,23 @@ class EvaluatorPairLJ
         // compute the force divided by r in force_divr
         if (rsq < rcutsq && lj1 != 0)
             {
-            Scalar r2inv = Scalar(1.0) / rsq;
-            Scalar r6inv = r2inv * r2inv * r2inv;
-            force_divr = r2inv * r6inv * (Scalar(12.0) * lj1 * r6inv - Scalar(6.0) * lj2);
+            const ShortReal lj1_s = ShortReal(lj1);
+            const ShortReal lj2_s = ShortReal(lj2);
+            ShortReal r2inv = ShortReal(1.0) / ShortReal(rsq);
+            ShortReal r6inv = r2inv * r2inv * r2inv;
+            ShortReal f
+                = r2inv * r6inv * (ShortReal(12.0) * lj1_s * r6inv - ShortReal(6.0) * lj2_s);
+            force_divr = Scalar(f);
 
-            pair_eng = r6inv * (lj1 * r6inv - lj2);
+            ShortReal eng = r6inv * (lj1_s * r6inv - lj2_s);
 
             if (energy_shift)
                 {
-                Scalar rcut2inv = Scalar(1.0) / rcutsq;
-                Scalar rcut6inv = rcut2inv * rcut2inv * rcut2inv;
-                pair_eng -= rcut6inv * (lj1 * rcut6inv - lj2);
+                ShortReal rcut2inv = ShortReal(1.0) / ShortReal(rcutsq);
+                ShortReal rcut6inv = rcut2inv * rcut2inv * rcut2inv;
+                eng -= rcut6inv * (lj1_s * rcut6inv - lj2_s);
                 }
+            pair_eng = Scalar(eng);
             return true;
             }
         else
@@ -244,4 +251,10 @@ class EvaluatorPairLJ
     Scalar lj2;    //!< lj2 parameter extracted from the params passed to the constructor
     };
 
+//! The batched CPU force loop supports EvaluatorPairLJ
+template<> struct PairEvaluatorBatchTraits<EvaluatorPairLJ>
+    {
+    static const bool enabled = true;
+    };
+
 #endif // __PAIR_EVALUATOR_LJ_H__
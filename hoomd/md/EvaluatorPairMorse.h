@@ -10,6 +10,7 @@
 #include <string>
 #endif
 
+#include "MDPrecisionSetup.h"
 #include "hoomd/HOOMDMath.h"
 
 /*! \file EvaluatorPairMorse.h
@@ -137,16 +138,16 @@ class EvaluatorPairMorse
         // compute the force divided by r in force_divr
         if (rsq < rcutsq)
             {
-            Scalar r = fast::sqrt(rsq);
-            Scalar Exp_factor = fast::exp(-alpha * (r - r0));
+            Scalar r = md_fast::sqrt(rsq);
+            Scalar Exp_factor = md_fast::exp(-alpha * (r - r0));
 
             pair_eng = D0 * Exp_factor * (Exp_factor - Scalar(2.0));
             force_divr = Scalar(2.0) * D0 * alpha * Exp_factor * (Exp_factor - Scalar(1.0)) / r;
 
             if (energy_shift)
                 {
-                Scalar rcut = fast::sqrt(rcutsq);
-                Scalar Exp_factor_cut = fast::exp(-alpha * (rcut - r0));
+                Scalar rcut = md_fast::sqrt(rcutsq);
+                Scalar Exp_factor_cut = md_fast::exp(-alpha * (rcut - r0));
                 pair_eng -= D0 * Exp_factor_cut * (Exp_factor_cut - Scalar(2.0));
                 }
             return true;
@@ -10,6 +10,8 @@
 #include <string>
 #endif
 
+#include "MDPrecisionSetup.h"
+#include "PairEvaluatorBatchTraits.h"
 #include "hoomd/HOOMDMath.h"
 
 /*! \file EvaluatorPairYukawa.h
@@ -147,21 +149,24 @@ class EvaluatorPairYukawa
         // compute the force divided by r in force_divr
         if (rsq < rcutsq && epsilon != 0)
             {
-            Scalar rinv = fast::rsqrt(rsq);
-            Scalar r = Scalar(1.0) / rinv;
-            Scalar r2inv = Scalar(1.0) / rsq;
+            const ShortReal epsilon_s = ShortReal(epsilon);
+            const ShortReal kappa_s = ShortReal(kappa);
+            ShortReal rinv = md_fast::rsqrt(ShortReal(rsq));
+            ShortReal r = ShortReal(1.0) / rinv;
+            ShortReal r2inv = ShortReal(1.0) / ShortReal(rsq);
 
-            Scalar exp_val = fast::exp(-kappa * r);
+            ShortReal exp_val = md_fast::exp(-kappa_s * r);
 
-            force_divr = epsilon * exp_val * r2inv * (rinv + kappa);
-            pair_eng = epsilon * exp_val * rinv;
+            force_divr = Scalar(epsilon_s * exp_val * r2inv * (rinv + kappa_s));
+            ShortReal eng = epsilon_s * exp_val * rinv;
 
             if (energy_shift)
                 {
-                Scalar rcutinv = fast::rsqrt(rcutsq);
-                Scalar rcut = Scalar(1.0) / rcutinv;
-                pair_eng -= epsilon * fast::exp(-kappa * rcut) * rcutinv;
+                ShortReal rcutinv = md_fast::rsqrt(ShortReal(rcutsq));
+                ShortReal rcut = ShortReal(1.0) / rcutinv;
+                eng -= epsilon_s * md_fast::exp(-kappa_s * rcut) * rcutinv;
                 }
+            pair_eng = Scalar(eng);
             return true;
             }
         else
@@ -190,4 +195,10 @@ class EvaluatorPairYukawa
     Scalar kappa;   //!< kappa parameter extracted from the params passed to the constructor
     };
 
+//! The batched CPU force loop supports EvaluatorPairYukawa
+template<> struct PairEvaluatorBatchTraits<EvaluatorPairYukawa>
+    {
+    static const bool enabled = true;
+    };
+
 #endif // __PAIR_EVALUATOR_YUKAWA_H__
@@ -12,12 +12,15 @@
 #define __EVALUATOR_WALLS_H__
 
 #ifndef __HIPCC__
+#include <algorithm>
 #include <string>
+#include <vector>
 #endif
 
 #include "WallData.h"
 #include "hoomd/BoxDim.h"
 #include "hoomd/HOOMDMath.h"
+#include "hoomd/Index1D.h"
 #include "hoomd/VectorMath.h"
 
 #undef DEVICE
@@ -32,6 +35,10 @@ const unsigned int MAX_N_SWALLS = 20;
 const unsigned int MAX_N_CWALLS = 20;
 const unsigned int MAX_N_PWALLS = 60;
 
+// number of words in the per cell bit mask of walls, and the max number of grid cells per dimension
+const unsigned int WALL_GRID_WORDS = (MAX_N_SWALLS + MAX_N_CWALLS + MAX_N_PWALLS + 31) / 32;
+const unsigned int MAX_WALL_GRID_DIM = 16;
+
 struct wall_type
     {
     unsigned int numSpheres; // these data types come first, since the structs are aligned already
@@ -59,7 +66,7 @@ template<class evaluator> class EvaluatorWalls
 
     //! Constructs the external wall potential evaluator
     DEVICE EvaluatorWalls(Scalar3 pos, const BoxDim& box, const param_type& p, const field_type& f)
-        : m_pos(pos), m_field(f), m_params(p)
+        : m_pos(pos), m_field(f), m_params(p), m_grid_mask(NULL)
         {
         }
 
@@ -99,6 +106,145 @@ template<class evaluator> class EvaluatorWalls
         qi = charge;
         }
 
+    //! Walls cull the evaluated walls with a field grid
+    DEVICE static bool needsFieldGrid()
+        {
+        return true;
+        }
+
+    //! Accept the field grid
+    /*! \param box Simulation box
+        \param grid Field grid built by buildFieldGrid()
+        \param grid_dim Dimensions of the field grid
+        \param type Type of particle i
+
+        Only the walls in the bit mask of the cell that contains the particle are evaluated.
+        Particles outside of the grid evaluate all walls.
+    */
+    DEVICE void
+    setFieldGrid(const BoxDim& box, const unsigned int* grid, uint3 grid_dim, unsigned int type)
+        {
+        Scalar3 f = box.makeFraction(m_pos);
+        if (!(f.x >= Scalar(0.0) && f.x < Scalar(1.0) && f.y >= Scalar(0.0) && f.y < Scalar(1.0)
+              && f.z >= Scalar(0.0) && f.z < Scalar(1.0)))
+            return;
+
+        // guard against round off at the upper box faces
+        unsigned int i = (unsigned int)(f.x * grid_dim.x);
+        unsigned int j = (unsigned int)(f.y * grid_dim.y);
+        unsigned int k = (unsigned int)(f.z * grid_dim.z);
+        i = (i < grid_dim.x) ? i : grid_dim.x - 1;
+        j = (j < grid_dim.y) ? j : grid_dim.y - 1;
+        k = (k < grid_dim.z) ? k : grid_dim.z - 1;
+
+        Index3D cell_indexer(grid_dim.x, grid_dim.y, grid_dim.z);
+        unsigned int cell = cell_indexer(i, j, k);
+        m_grid_mask = grid + (type * cell_indexer.getNumElements() + cell) * WALL_GRID_WORDS;
+        }
+
+#ifndef __HIPCC__
+    //! Build the field grid
+    /*! \param field Walls
+        \param params Per-type parameters
+        \param n_types Number of particle types
+        \param box Simulation box
+        \param n_dimensions Number of dimensions of the system
+        \param grid_dim (output) Dimensions of the field grid
+        \param grid (output) Per-type, per-cell bit masks of the walls
+
+        The grid divides the box into cells about one cutoff wide. A wall is left out of the mask
+        of a cell when it provably contributes nothing to any particle in the cell: the whole cell
+        is on the inside of the wall and beyond the cutoff, or (in normal mode) the whole cell is
+        on the outside. distWall() is the signed distance to the wall, so a cell is entirely on
+        one side when its center is farther from the wall than the cell corners are.
+    */
+    static void buildFieldGrid(const field_type& field,
+                               const param_type* params,
+                               unsigned int n_types,
+                               const BoxDim& box,
+                               unsigned int n_dimensions,
+                               uint3& grid_dim,
+                               std::vector<unsigned int>& grid)
+        {
+        // distance beyond which a wall does not act on particles on its inside
+        std::vector<Scalar> r_cull(n_types);
+        Scalar r_cull_max = Scalar(0.0);
+        for (unsigned int type = 0; type < n_types; type++)
+            {
+            r_cull[type] = sqrt(std::max(params[type].rcutsq, Scalar(0.0)));
+            r_cull[type] = std::max(r_cull[type], params[type].rextrap);
+            r_cull_max = std::max(r_cull_max, r_cull[type]);
+            }
+
+        Scalar3 npd = box.getNearestPlaneDistance();
+        grid_dim = make_uint3(1, 1, 1);
+        if (r_cull_max > Scalar(0.0))
+            {
+            auto n_cells = [r_cull_max](Scalar L)
+            {
+                return (unsigned int)std::max(
+                    Scalar(1.0),
+                    std::min(Scalar(MAX_WALL_GRID_DIM), floor(L / r_cull_max)));
+            };
+            grid_dim = make_uint3(n_cells(npd.x), n_cells(npd.y), n_cells(npd.z));
+            }
+        if (n_dimensions == 2)
+            grid_dim.z = 1;
+
+        // distance from the cell center to its corners, padded against round off in the cell
+        // assignment
+        vec3<Scalar> a1 = vec3<Scalar>(box.getLatticeVector(0)) / Scalar(grid_dim.x);
+        vec3<Scalar> a2 = vec3<Scalar>(box.getLatticeVector(1)) / Scalar(grid_dim.y);
+        vec3<Scalar> a3 = vec3<Scalar>(box.getLatticeVector(2)) / Scalar(grid_dim.z);
+        Scalar h = sqrt(dot(a1, a1)) + sqrt(dot(a2, a2));
+        if (n_dimensions == 3)
+            h += sqrt(dot(a3, a3));
+        h *= Scalar(0.5) * Scalar(1.01);
+
+        Index3D cell_indexer(grid_dim.x, grid_dim.y, grid_dim.z);
+        unsigned int n_cells = cell_indexer.getNumElements();
+        grid.assign(n_types * n_cells * WALL_GRID_WORDS, 0);
+
+        for (unsigned int k = 0; k < grid_dim.z; k++)
+            for (unsigned int j = 0; j < grid_dim.y; j++)
+                for (unsigned int i = 0; i < grid_dim.x; i++)
+                    {
+                    Scalar3 f = make_scalar3((Scalar(i) + Scalar(0.5)) / Scalar(grid_dim.x),
+                                             (Scalar(j) + Scalar(0.5)) / Scalar(grid_dim.y),
+                                             (Scalar(k) + Scalar(0.5)) / Scalar(grid_dim.z));
+                    vec3<Scalar> center(box.makeCoordinates(f));
+
+                    for (unsigned int type = 0; type < n_types; type++)
+                        {
+                        unsigned int* mask
+                            = &grid[(type * n_cells + cell_indexer(i, j, k)) * WALL_GRID_WORDS];
+                        bool extrapolated = params[type].rextrap > Scalar(0.0);
+                        unsigned int bit = 0;
+                        for (unsigned int w = 0; w < field.numSpheres; w++)
+                            if (wallNearCell(distWall(field.Spheres[w], center),
+                                             h,
+                                             r_cull[type],
+                                             extrapolated))
+                                setWallBit(mask, bit + w);
+                        bit += MAX_N_SWALLS;
+                        for (unsigned int w = 0; w < field.numCylinders; w++)
+                            if (wallNearCell(distWall(field.Cylinders[w], center),
+                                             h,
+                                             r_cull[type],
+                                             extrapolated))
+                                setWallBit(mask, bit + w);
+                        bit += MAX_N_CWALLS;
+                        for (unsigned int w = 0; w < field.numPlanes; w++)
+                            if (wallNearCell(distWall(field.Planes[w], center),
+                                             h,
+                                             r_cull[type],
+                                             extrapolated))
+                                setWallBit(mask, bit + w);
+                        }
+                    }
+        }
+#endif
+
     DEVICE inline void callEvaluator(Scalar3& F, Scalar& energy, const vec3<Scalar> drv)
         {
         Scalar3 dr = -vec_to_scalar3(drv);
@@ -199,6 +345,8 @@ template<class evaluator> class EvaluatorWalls
             Scalar rsq;
             for (unsigned int k = 0; k < m_field.numSpheres; k++)
                 {
+                if (!wallInCell(k))
+                    continue;
                 drv = vecPtToWall(m_field.Spheres[k], position, inside);
                 rsq = dot(drv, drv);
                 if (inside && rsq >= rextrapsq)
@@ -224,6 +372,8 @@ template<class evaluator> class EvaluatorWalls
                 }
             for (unsigned int k = 0; k < m_field.numCylinders; k++)
                 {
+                if (!wallInCell(MAX_N_SWALLS + k))
+                    continue;
                 drv = vecPtToWall(m_field.Cylinders[k], position, inside);
                 rsq = dot(drv, drv);
                 if (inside && rsq >= rextrapsq)
@@ -253,6 +403,8 @@ template<class evaluator> class EvaluatorWalls
                 }
             for (unsigned int k = 0; k < m_field.numPlanes; k++)
                 {
+                if (!wallInCell(MAX_N_SWALLS + MAX_N_CWALLS + k))
+                    continue;
                 drv = vecPtToWall(m_field.Planes[k], position, inside);
                 rsq = dot(drv, drv);
                 if (inside && rsq >= rextrapsq)
@@ -281,6 +433,8 @@ template<class evaluator> class EvaluatorWalls
             {
             for (unsigned int k = 0; k < m_field.numSpheres; k++)
                 {
+                if (!wallInCell(k))
+                    continue;
                 drv = vecPtToWall(m_field.Spheres[k], position, inside);
                 if (inside)
                     {
@@ -289,6 +443,8 @@ template<class evaluator> class EvaluatorWalls
                 }
             for (unsigned int k = 0; k < m_field.numCylinders; k++)
                 {
+                if (!wallInCell(MAX_N_SWALLS + k))
+                    continue;
                 drv = vecPtToWall(m_field.Cylinders[k], position, inside);
                 if (inside)
                     {
@@ -297,6 +453,8 @@ template<class evaluator> class EvaluatorWalls
                 }
             for (unsigned int k = 0; k < m_field.numPlanes; k++)
                 {
+                if (!wallInCell(MAX_N_SWALLS + MAX_N_CWALLS + k))
+                    continue;
                 drv = vecPtToWall(m_field.Planes[k], position, inside);
                 if (inside)
                     {
@@ -325,11 +483,43 @@ template<class evaluator> class EvaluatorWalls
 #endif
 
     protected:
+    //! Test if a wall is in the field grid cell of the particle
+    /*! \param bit Index of the wall in the bit mask
+     */
+    DEVICE inline bool wallInCell(unsigned int bit) const
+        {
+        return !m_grid_mask || (m_grid_mask[bit / 32] & (1u << (bit % 32)));
+        }
+
+#ifndef __HIPCC__
+    //! Test if a wall may act on particles in a field grid cell
+    /*! \param d Signed distance from the cell center to the wall, positive on the inside
+        \param h Distance from the cell center to its corners
+        \param r_cull Distance beyond which the wall does not act on particles on its inside
+        \param extrapolated True when the wall acts on particles on its outside
+    */
+    static bool wallNearCell(Scalar d, Scalar h, Scalar r_cull, bool extrapolated)
+        {
+        if (d - h >= r_cull)
+            return false;
+        if (!extrapolated && d + h < Scalar(0.0))
+            return false;
+        return true;
+        }
+
+    //! Add a wall to a field grid cell
+    static void setWallBit(unsigned int* mask, unsigned int bit)
+        {
+        mask[bit / 32] |= 1u << (bit % 32);
+        }
+#endif
+
     Scalar3 m_pos;             //!< particle position
     const field_type& m_field; //!< contains all information about the walls.
     param_type m_params;
     Scalar di;
     Scalar qi;
+    const unsigned int* m_grid_mask; //!< Bit mask of the walls near the particle (NULL for all)
     };
 
 template<class evaluator>
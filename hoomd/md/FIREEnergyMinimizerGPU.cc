@@ -6,6 +6,8 @@
 #include "FIREEnergyMinimizerGPU.h"
 #include "FIREEnergyMinimizerGPU.cuh"
 
+#include <algorithm>
+
 namespace py = pybind11;
 using namespace std;
 
@@ -27,31 +29,13 @@ FIREEnergyMinimizerGPU::FIREEnergyMinimizerGPU(std::shared_ptr<SystemDefinition>
         throw std::runtime_error("Error initializing FIREEnergyMinimizer");
         }
 
-    // allocate the sum arrays
-    GPUArray<Scalar> sum(1, m_exec_conf);
+    // allocate the sum arrays, the partial sums grow with the group sizes in update()
+    GPUArray<Scalar> sum(FIRE_NUM_SUMS, m_exec_conf);
     m_sum.swap(sum);
-    GPUArray<Scalar> sum3(3, m_exec_conf);
-    m_sum3.swap(sum3);
+    GPUArray<Scalar> partial_sum(FIRE_NUM_SUMS, m_exec_conf);
+    m_partial_sum.swap(partial_sum);
 
-    // initialize the partial sum arrays
-    m_block_size = 256; // 128;
-
-    unsigned int num_blocks = 0;
-    for (auto method = m_methods.begin(); method != m_methods.end(); ++method)
-        {
-        std::shared_ptr<ParticleGroup> current_group = (*method)->getGroup();
-
-        unsigned int group_size = current_group->getNumMembers();
-        num_blocks = std::max(num_blocks, group_size);
-        }
-
-    num_blocks = num_blocks / m_block_size + 1;
-    GPUArray<Scalar> partial_sum1(num_blocks, m_exec_conf);
-    m_partial_sum1.swap(partial_sum1);
-    GPUArray<Scalar> partial_sum2(num_blocks, m_exec_conf);
-    m_partial_sum2.swap(partial_sum2);
-    GPUArray<Scalar> partial_sum3(num_blocks, m_exec_conf);
-    m_partial_sum3.swap(partial_sum3);
+    m_block_size = 256;
 
     reset();
     }
@@ -66,65 +50,89 @@ void FIREEnergyMinimizerGPU::update(uint64_t timestep)
 
     IntegratorTwoStep::update(timestep);
 
-    Scalar Pt(0.0); // translational power
-    Scalar Pr(0.0); // rotational power
-    Scalar vnorm(0.0);
-    Scalar fnorm(0.0);
-    Scalar energy(0.0);
-    Scalar tnorm(0.0);
-    Scalar wnorm(0.0);
-
-    // compute the total energy on the GPU
-    // CPU version is Scalar energy = computePotentialEnergy(timesteps)/Scalar(group_size);
+    // compute the total energy, the power, and the norms of all groups on the GPU, accumulating
+    // them in one array that is copied to the host once per iteration
 
     if (m_prof)
-        m_prof->push(m_exec_conf, "FIRE compute total energy");
+        m_prof->push(m_exec_conf, "FIRE sums");
 
     unsigned int total_group_size = 0;
+    Scalar sums[FIRE_NUM_SUMS];
 
-    for (auto method = m_methods.begin(); method != m_methods.end(); ++method)
         {
-        std::shared_ptr<ParticleGroup> current_group = (*method)->getGroup();
+        ArrayHandle<Scalar> d_sum(m_sum, access_location::device, access_mode::overwrite);
+        hipMemset(d_sum.data, 0, sizeof(Scalar) * FIRE_NUM_SUMS);
 
-        unsigned int group_size = current_group->getNumMembers();
-        total_group_size += group_size;
+        for (auto method = m_methods.begin(); method != m_methods.end(); ++method)
+            {
+            std::shared_ptr<ParticleGroup> current_group = (*method)->getGroup();
 
-        ArrayHandle<unsigned int> d_index_array(current_group->getIndexArray(),
-                                                access_location::device,
-                                                access_mode::read);
+            unsigned int group_size = current_group->getNumMembers();
+            total_group_size += group_size;
 
-            {
+            unsigned int num_blocks = group_size / m_block_size + 1;
+            if (m_partial_sum.getNumElements() < num_blocks * FIRE_NUM_SUMS)
+                m_partial_sum.resize(num_blocks * FIRE_NUM_SUMS);
+
+            ArrayHandle<unsigned int> d_index_array(current_group->getIndexArray(),
+                                                    access_location::device,
+                                                    access_mode::read);
+            ArrayHandle<Scalar> d_partial_sum(m_partial_sum,
+                                              access_location::device,
+                                              access_mode::overwrite);
             ArrayHandle<Scalar4> d_net_force(m_pdata->getNetForce(),
                                              access_location::device,
                                              access_mode::read);
-            ArrayHandle<Scalar> d_partial_sumE(m_partial_sum1,
+            ArrayHandle<Scalar4> d_vel(m_pdata->getVelocities(),
+                                       access_location::device,
+                                       access_mode::read);
+            ArrayHandle<Scalar3> d_accel(m_pdata->getAccelerations(),
+                                         access_location::device,
+                                         access_mode::read);
+            ArrayHandle<Scalar4> d_orientation(m_pdata->getOrientationArray(),
                                                access_location::device,
-                                               access_mode::overwrite);
-            ArrayHandle<Scalar> d_sumE(m_sum, access_location::device, access_mode::overwrite);
+                                               access_mode::read);
+            ArrayHandle<Scalar3> d_inertia(m_pdata->getMomentsOfInertiaArray(),
+                                           access_location::device,
+                                           access_mode::read);
+            ArrayHandle<Scalar4> d_angmom(m_pdata->getAngularMomentumArray(),
+                                          access_location::device,
+                                          access_mode::read);
+            ArrayHandle<Scalar4> d_net_torque(m_pdata->getNetTorqueArray(),
+                                              access_location::device,
+                                              access_mode::read);
 
-            unsigned int num_blocks = group_size / m_block_size + 1;
-            gpu_fire_compute_sum_pe(d_index_array.data,
-                                    group_size,
-                                    d_net_force.data,
-                                    d_sumE.data,
-                                    d_partial_sumE.data,
-                                    m_block_size,
-                                    num_blocks);
+            gpu_fire_compute_sums(d_index_array.data,
+                                  group_size,
+                                  d_net_force.data,
+                                  d_vel.data,
+                                  d_accel.data,
+                                  d_orientation.data,
+                                  d_inertia.data,
+                                  d_angmom.data,
+                                  d_net_torque.data,
+                                  (*method)->getAnisotropic(),
+                                  d_sum.data,
+                                  d_partial_sum.data,
+                                  m_block_size,
+                                  num_blocks);
 
             if (m_exec_conf->isCUDAErrorCheckingEnabled())
                 CHECK_CUDA_ERROR();
             }
+        }
 
-        ArrayHandle<Scalar> h_sumE(m_sum, access_location::host, access_mode::read);
-        energy += h_sumE.data[0];
+        {
+        ArrayHandle<Scalar> h_sum(m_sum, access_location::host, access_mode::read);
+        std::copy(h_sum.data, h_sum.data + FIRE_NUM_SUMS, sums);
         }
 
 #ifdef ENABLE_MPI
     if (m_pdata->getDomainDecomposition())
         {
         MPI_Allreduce(MPI_IN_PLACE,
-                      &energy,
-                      1,
+                      sums,
+                      FIRE_NUM_SUMS,
                       MPI_HOOMD_SCALAR,
                       MPI_SUM,
                       m_exec_conf->getMPICommunicator());
@@ -137,187 +145,31 @@ void FIREEnergyMinimizerGPU::update(uint64_t timestep)
         }
 #endif
 
-    m_energy_total = energy;
-    energy /= (Scalar)total_group_size;
-
     if (m_prof)
         m_prof->pop(m_exec_conf);
 
+    Scalar energy = sums[fire_sum_pe];
+    Scalar Pt = sums[fire_sum_P];  // translational power
+    Scalar Pr = sums[fire_sum_Pr]; // rotational power
+    Scalar vnorm = sums[fire_sum_vsq];
+    Scalar fnorm = sums[fire_sum_asq];
+    Scalar wnorm = sums[fire_sum_wsq];
+    Scalar tnorm = sums[fire_sum_tsq];
+
+    m_energy_total = energy;
+    energy /= (Scalar)total_group_size;
+
     if (m_was_reset)
         {
         m_was_reset = false;
         m_old_energy = energy + Scalar(100000) * m_etol;
         }
 
-    // sum P, vnorm, fnorm
-
-    if (m_prof)
-        m_prof->push(m_exec_conf, "FIRE P, vnorm, fnorm");
-
-#ifdef ENABLE_MPI
-    bool aniso = false;
-#endif
-
-    for (auto method = m_methods.begin(); method != m_methods.end(); ++method)
-        {
-        std::shared_ptr<ParticleGroup> current_group = (*method)->getGroup();
-
-        unsigned int group_size = current_group->getNumMembers();
-        ArrayHandle<unsigned int> d_index_array(current_group->getIndexArray(),
-                                                access_location::device,
-                                                access_mode::read);
-
-            {
-            ArrayHandle<Scalar> d_partial_sum_P(m_partial_sum1,
-                                                access_location::device,
-                                                access_mode::overwrite);
-            ArrayHandle<Scalar> d_partial_sum_vsq(m_partial_sum2,
-                                                  access_location::device,
-                                                  access_mode::overwrite);
-            ArrayHandle<Scalar> d_partial_sum_fsq(m_partial_sum3,
-                                                  access_location::device,
-                                                  access_mode::overwrite);
-            ArrayHandle<Scalar> d_sum(m_sum3, access_location::device, access_mode::overwrite);
-            ArrayHandle<Scalar4> d_vel(m_pdata->getVelocities(),
-                                       access_location::device,
-                                       access_mode::read);
-            ArrayHandle<Scalar3> d_accel(m_pdata->getAccelerations(),
-                                         access_location::device,
-                                         access_mode::read);
-
-            unsigned int num_blocks = group_size / m_block_size + 1;
-
-            gpu_fire_compute_sum_all(m_pdata->getN(),
-                                     d_vel.data,
-                                     d_accel.data,
-                                     d_index_array.data,
-                                     group_size,
-                                     d_sum.data,
-                                     d_partial_sum_P.data,
-                                     d_partial_sum_vsq.data,
-                                     d_partial_sum_fsq.data,
-                                     m_block_size,
-                                     num_blocks);
-
-            if (m_exec_conf->isCUDAErrorCheckingEnabled())
-                CHECK_CUDA_ERROR();
-            }
-
-        ArrayHandle<Scalar> h_sum(m_sum3, access_location::host, access_mode::read);
-        Pt += h_sum.data[0];
-        vnorm += h_sum.data[1];
-        fnorm += h_sum.data[2];
-
-        if ((*method)->getAnisotropic())
-            {
-#ifdef ENABLE_MPI
-            aniso = true;
-#endif
-
-                {
-                ArrayHandle<Scalar> d_partial_sum_Pr(m_partial_sum1,
-                                                     access_location::device,
-                                                     access_mode::overwrite);
-                ArrayHandle<Scalar> d_partial_sum_wnorm(m_partial_sum2,
-                                                        access_location::device,
-                                                        access_mode::overwrite);
-                ArrayHandle<Scalar> d_partial_sum_tsq(m_partial_sum3,
-                                                      access_location::device,
-                                                      access_mode::overwrite);
-                ArrayHandle<Scalar> d_sum(m_sum3, access_location::device, access_mode::overwrite);
-                ArrayHandle<Scalar4> d_orientation(m_pdata->getOrientationArray(),
-                                                   access_location::device,
-                                                   access_mode::read);
-                ArrayHandle<Scalar4> d_angmom(m_pdata->getAngularMomentumArray(),
-                                              access_location::device,
-                                              access_mode::read);
-                ArrayHandle<Scalar4> d_net_torque(m_pdata->getNetTorqueArray(),
-                                                  access_location::device,
-                                                  access_mode::read);
-                ArrayHandle<Scalar3> d_inertia(m_pdata->getMomentsOfInertiaArray(),
-                                               access_location::device,
-                                               access_mode::read);
-
-                unsigned int num_blocks = group_size / m_block_size + 1;
-
-                gpu_fire_compute_sum_all_angular(m_pdata->getN(),
-                                                 d_orientation.data,
-                                                 d_inertia.data,
-                                                 d_angmom.data,
-                                                 d_net_torque.data,
-                                                 d_index_array.data,
-                                                 group_size,
-                                                 d_sum.data,
-                                                 d_partial_sum_Pr.data,
-                                                 d_partial_sum_wnorm.data,
-                                                 d_partial_sum_tsq.data,
-                                                 m_block_size,
-                                                 num_blocks);
-
-                if (m_exec_conf->isCUDAErrorCheckingEnabled())
-                    CHECK_CUDA_ERROR();
-                }
-            ArrayHandle<Scalar> h_sum(m_sum3, access_location::host, access_mode::read);
-            Pr += h_sum.data[0];
-            wnorm += h_sum.data[1];
-            tnorm += h_sum.data[2];
-            }
-        }
-
-#ifdef ENABLE_MPI
-    if (m_pdata->getDomainDecomposition())
-        {
-        MPI_Allreduce(MPI_IN_PLACE,
-                      &fnorm,
-                      1,
-                      MPI_HOOMD_SCALAR,
-                      MPI_SUM,
-                      m_exec_conf->getMPICommunicator());
-        MPI_Allreduce(MPI_IN_PLACE,
-                      &vnorm,
-                      1,
-                      MPI_HOOMD_SCALAR,
-                      MPI_SUM,
-                      m_exec_conf->getMPICommunicator());
-        MPI_Allreduce(MPI_IN_PLACE,
-                      &Pt,
-                      1,
-                      MPI_HOOMD_SCALAR,
-                      MPI_SUM,
-                      m_exec_conf->getMPICommunicator());
-
-        if (aniso)
-            {
-            MPI_Allreduce(MPI_IN_PLACE,
-                          &tnorm,
-                          1,
-                          MPI_HOOMD_SCALAR,
-                          MPI_SUM,
-                          m_exec_conf->getMPICommunicator());
-            MPI_Allreduce(MPI_IN_PLACE,
-                          &wnorm,
-                          1,
-                          MPI_HOOMD_SCALAR,
-                          MPI_SUM,
-                          m_exec_conf->getMPICommunicator());
-            MPI_Allreduce(MPI_IN_PLACE,
-                          &Pr,
-                          1,
-                          MPI_HOOMD_SCALAR,
-                          MPI_SUM,
-                          m_exec_conf->getMPICommunicator());
-            }
-        }
-#endif
-
     vnorm = sqrt(vnorm);
     fnorm = sqrt(fnorm);
     wnorm = sqrt(wnorm);
     tnorm = sqrt(tnorm);
 
-    if (m_prof)
-        m_prof->pop(m_exec_conf);
-
     unsigned int ndof = m_sysdef->getNDimensions() * total_group_size;
     m_exec_conf->msg->notice(10) << "FIRE fnorm " << fnorm << " tnorm " << tnorm << " delta_E "
                                  << energy - m_old_energy << std::endl;
@@ -333,7 +185,11 @@ void FIREEnergyMinimizerGPU::update(uint64_t timestep)
         return;
         }
 
-    // update velocities
+    // A simply naive measure is to sum up the power coming from translational and rotational
+    // motions, more sophisticated measure can be devised later
+    Scalar P = Pt + Pr;
+
+    // update velocities, or zero them when the power is not positive
 
     if (m_prof)
         m_prof->push(m_exec_conf, "FIRE update velocities");
@@ -351,6 +207,9 @@ void FIREEnergyMinimizerGPU::update(uint64_t timestep)
     else
         factor_r = 1.0;
 
+    if (P <= Scalar(0.0))
+        m_exec_conf->msg->notice(6) << "FIRE zero velocities" << std::endl;
+
     for (auto method = m_methods.begin(); method != m_methods.end(); ++method)
         {
         std::shared_ptr<ParticleGroup> current_group = (*method)->getGroup();
@@ -363,43 +222,59 @@ void FIREEnergyMinimizerGPU::update(uint64_t timestep)
         ArrayHandle<Scalar4> d_vel(m_pdata->getVelocities(),
                                    access_location::device,
                                    access_mode::readwrite);
-        ArrayHandle<Scalar3> d_accel(m_pdata->getAccelerations(),
-                                     access_location::device,
-                                     access_mode::read);
 
-        gpu_fire_update_v(d_vel.data,
-                          d_accel.data,
-                          d_index_array.data,
-                          group_size,
-                          m_alpha,
-                          factor_t);
+        if (P > Scalar(0.0))
+            {
+            ArrayHandle<Scalar3> d_accel(m_pdata->getAccelerations(),
+                                         access_location::device,
+                                         access_mode::read);
+
+            gpu_fire_update_v(d_vel.data,
+                              d_accel.data,
+                              d_index_array.data,
+                              group_size,
+                              m_alpha,
+                              factor_t);
+            }
+        else
+            {
+            gpu_fire_zero_v(d_vel.data, d_index_array.data, group_size);
+            }
 
         if (m_exec_conf->isCUDAErrorCheckingEnabled())
             CHECK_CUDA_ERROR();
 
         if ((*method)->getAnisotropic())
             {
-            ArrayHandle<Scalar4> d_orientation(m_pdata->getOrientationArray(),
-                                               access_location::device,
-                                               access_mode::read);
-            ArrayHandle<Scalar4> d_net_torque(m_pdata->getNetTorqueArray(),
-                                              access_location::device,
-                                              access_mode::read);
             ArrayHandle<Scalar4> d_angmom(m_pdata->getAngularMomentumArray(),
                                           access_location::device,
                                           access_mode::readwrite);
-            ArrayHandle<Scalar3> d_inertia(m_pdata->getMomentsOfInertiaArray(),
-                                           access_location::device,
-                                           access_mode::read);
 
-            gpu_fire_update_angmom(d_net_torque.data,
-                                   d_orientation.data,
-                                   d_inertia.data,
-                                   d_angmom.data,
-                                   d_index_array.data,
-                                   group_size,
-                                   m_alpha,
-                                   factor_r);
+            if (P > Scalar(0.0))
+                {
+                ArrayHandle<Scalar4> d_orientation(m_pdata->getOrientationArray(),
+                                                   access_location::device,
+                                                   access_mode::read);
+                ArrayHandle<Scalar4> d_net_torque(m_pdata->getNetTorqueArray(),
+                                                  access_location::device,
+                                                  access_mode::read);
+                ArrayHandle<Scalar3> d_inertia(m_pdata->getMomentsOfInertiaArray(),
+                                               access_location::device,
+                                               access_mode::read);
+
+                gpu_fire_update_angmom(d_net_torque.data,
+                                       d_orientation.data,
+                                       d_inertia.data,
+                                       d_angmom.data,
+                                       d_index_array.data,
+                                       group_size,
+                                       m_alpha,
+                                       factor_r);
+                }
+            else
+                {
+                gpu_fire_zero_angmom(d_angmom.data, d_index_array.data, group_size);
+                }
 
             if (m_exec_conf->isCUDAErrorCheckingEnabled())
                 CHECK_CUDA_ERROR();
@@ -409,8 +284,6 @@ void FIREEnergyMinimizerGPU::update(uint64_t timestep)
     if (m_prof)
         m_prof->pop(m_exec_conf);
 
-    Scalar P = Pt + Pr;
-
     if (P > Scalar(0.0))
         {
         m_n_since_negative++;
@@ -420,45 +293,11 @@ void FIREEnergyMinimizerGPU::update(uint64_t timestep)
             m_alpha *= m_falpha;
             }
         }
-    else if (P <= Scalar(0.0))
+    else
         {
         IntegratorTwoStep::setDeltaT(m_deltaT * m_fdec);
         m_alpha = m_alpha_start;
         m_n_since_negative = 0;
-        if (m_prof)
-            m_prof->push(m_exec_conf, "FIRE zero velocities");
-
-        m_exec_conf->msg->notice(6) << "FIRE zero velocities" << std::endl;
-
-        for (auto method = m_methods.begin(); method != m_methods.end(); ++method)
-            {
-            std::shared_ptr<ParticleGroup> current_group = (*method)->getGroup();
-            unsigned int group_size = current_group->getNumMembers();
-            ArrayHandle<unsigned int> d_index_array(current_group->getIndexArray(),
-                                                    access_location::device,
-                                                    access_mode::read);
-
-            ArrayHandle<Scalar4> d_vel(m_pdata->getVelocities(),
-                                       access_location::device,
-                                       access_mode::readwrite);
-
-            gpu_fire_zero_v(d_vel.data, d_index_array.data, group_size);
-            if (m_exec_conf->isCUDAErrorCheckingEnabled())
-                CHECK_CUDA_ERROR();
-
-            if ((*method)->getAnisotropic())
-                {
-                ArrayHandle<Scalar4> d_angmom(m_pdata->getAngularMomentumArray(),
-                                              access_location::device,
-                                              access_mode::readwrite);
-                gpu_fire_zero_angmom(d_angmom.data, d_index_array.data, group_size);
-                if (m_exec_conf->isCUDAErrorCheckingEnabled())
-                    CHECK_CUDA_ERROR();
-                }
-            }
-
-        if (m_prof)
-            m_prof->pop(m_exec_conf);
         }
 
     m_n_since_start++;
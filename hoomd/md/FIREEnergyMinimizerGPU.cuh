@@ -19,41 +19,36 @@ hipError_t gpu_fire_zero_v(Scalar4* d_vel, unsigned int* d_group_members, unsign
 hipError_t
 gpu_fire_zero_angmom(Scalar4* d_angmom, unsigned int* d_group_members, unsigned int group_size);
 
-//! Kernel driver for summing the potential energy called by FIREEnergyMinimizerGPU
-hipError_t gpu_fire_compute_sum_pe(unsigned int* d_group_members,
-                                   unsigned int group_size,
-                                   Scalar4* d_net_force,
-                                   Scalar* d_sum_pe,
-                                   Scalar* d_partial_sum_pe,
-                                   unsigned int block_size,
-                                   unsigned int num_blocks);
+//! Sums reduced over all particles in each FIRE iteration
+enum fire_sum
+    {
+    fire_sum_pe = 0, //!< Potential energy
+    fire_sum_P,      //!< Translational power (a dot v)
+    fire_sum_vsq,    //!< Squared norm of the velocity vector
+    fire_sum_asq,    //!< Squared norm of the acceleration vector
+    fire_sum_Pr,     //!< Rotational power (torque dot angular velocity)
+    fire_sum_wsq,    //!< Squared norm of the angular velocity vector
+    fire_sum_tsq     //!< Squared norm of the torque vector
+    };
 
-//! Kernel driver for summing over P, vsq, and asq called by FIREEnergyMinimizerGPU
-hipError_t gpu_fire_compute_sum_all(const unsigned int N,
-                                    const Scalar4* d_vel,
-                                    const Scalar3* d_accel,
-                                    unsigned int* d_group_members,
-                                    unsigned int group_size,
-                                    Scalar* d_sum_all,
-                                    Scalar* d_partial_sum_P,
-                                    Scalar* d_partial_sum_vsq,
-                                    Scalar* d_partial_sum_asq,
-                                    unsigned int block_size,
-                                    unsigned int num_blocks);
+//! Number of sums in fire_sum
+const unsigned int FIRE_NUM_SUMS = 7;
 
-hipError_t gpu_fire_compute_sum_all_angular(const unsigned int N,
-                                            const Scalar4* d_orientation,
-                                            const Scalar3* d_inertia,
-                                            const Scalar4* d_angmom,
-                                            const Scalar4* d_net_torque,
-                                            unsigned int* d_group_members,
-                                            unsigned int group_size,
-                                            Scalar* d_sum_all,
-                                            Scalar* d_partial_sum_Pr,
-                                            Scalar* d_partial_sum_wnorm,
-                                            Scalar* d_partial_sum_tsq,
-                                            unsigned int block_size,
-                                            unsigned int num_blocks);
+//! Kernel driver for adding the FIRE sums of a group called by FIREEnergyMinimizerGPU
+hipError_t gpu_fire_compute_sums(const unsigned int* d_group_members,
+                                 unsigned int group_size,
+                                 const Scalar4* d_net_force,
+                                 const Scalar4* d_vel,
+                                 const Scalar3* d_accel,
+                                 const Scalar4* d_orientation,
+                                 const Scalar3* d_inertia,
+                                 const Scalar4* d_angmom,
+                                 const Scalar4* d_net_torque,
+                                 bool aniso,
+                                 Scalar* d_sums,
+                                 Scalar* d_partial_sums,
+                                 unsigned int block_size,
+                                 unsigned int num_blocks);
 
 //! Kernel driver for updating the velocities called by FIREEnergyMinimizerGPU
 hipError_t gpu_fire_update_v(Scalar4* d_vel,
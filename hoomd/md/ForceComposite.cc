@@ -495,6 +495,7 @@ void ForceComposite::validateRigidBodies()
 
     // store number of molecules in all ranks
     m_n_molecules_global = nbodies;
+    notifyMoleculeTagsChanged();
 
     // reset flags
     m_bodies_changed = false;
@@ -627,6 +628,7 @@ void ForceComposite::createRigidBodies()
         std::copy(molecule_tag.begin(), molecule_tag.end(), h_molecule_tag.data);
         }
     m_n_molecules_global = n_central_particles;
+    notifyMoleculeTagsChanged();
 
     m_bodies_changed = false;
     m_particles_added_removed = false;
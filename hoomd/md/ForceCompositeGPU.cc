@@ -14,6 +14,12 @@ namespace py = pybind11;
     \brief Contains code for the ForceCompositeGPU class
 */
 
+//! Launch configuration of the reproducible mode, 8 bodies per block of 64 threads
+/*! The sliding window reductions sum in an order set by the launch configuration, so the
+    autotuner is bypassed when the execution configuration is deterministic.
+*/
+static const unsigned int composite_deterministic_param = 64 + 8 * 10000;
+
 /*! \param sysdef SystemDefinition containing the ParticleData to compute forces on
  */
 ForceCompositeGPU::ForceCompositeGPU(std::shared_ptr<SystemDefinition> sysdef)
@@ -171,10 +177,13 @@ void ForceCompositeGPU::computeForces(uint64_t timestep)
         compute_virial = true;
         }
 
+    // the virial is summed in the same pass, tune that variant separately
+    Autotuner* tuner = compute_virial ? m_tuner_virial.get() : m_tuner_force.get();
+
         {
         ArrayHandle<uint2> d_flag(m_flag, access_location::device, access_mode::overwrite);
 
-        // reset force and torque
+        // reset force, torque, and virial
         m_exec_conf->beginMultiGPU();
 
         for (int idev = m_exec_conf->getNumActiveGPUs() - 1; idev >= 0; idev--)
@@ -189,6 +198,16 @@ void ForceCompositeGPU::computeForces(uint64_t timestep)
             hipMemsetAsync(d_force.data + range.first, 0, sizeof(Scalar4) * nelem);
             hipMemsetAsync(d_torque.data + range.first, 0, sizeof(Scalar4) * nelem);
 
+            if (compute_virial)
+                {
+                for (unsigned int i = 0; i < 6; i++)
+                    {
+                    hipMemsetAsync(d_virial.data + i * m_virial_pitch + range.first,
+                                   0,
+                                   sizeof(Scalar) * nelem);
+                    }
+                }
+
             if (m_exec_conf->isCUDAErrorCheckingEnabled())
                 CHECK_CUDA_ERROR();
             }
@@ -196,8 +215,9 @@ void ForceCompositeGPU::computeForces(uint64_t timestep)
 
         m_exec_conf->beginMultiGPU();
 
-        m_tuner_force->begin();
-        unsigned int param = m_tuner_force->getParam();
+        tuner->begin();
+        unsigned int param = m_exec_conf->getDeterministic() ? composite_deterministic_param
+                                                             : tuner->getParam();
         unsigned int block_size = param % 10000;
         unsigned int n_bodies_per_block = param / 10000;
 
@@ -220,17 +240,22 @@ void ForceCompositeGPU::computeForces(uint64_t timestep)
                         d_flag.data,
                         d_net_force.data,
                         d_net_torque.data,
+                        d_virial.data,
+                        d_net_virial.data,
+                        m_pdata->getNetVirial().getPitch(),
+                        m_virial_pitch,
                         nmol,
                         m_pdata->getN(),
                         n_bodies_per_block,
                         block_size,
                         m_exec_conf->dev_prop,
-                        !compute_virial,
+                        compute_virial,
                         m_gpu_partition);
 
         if (m_exec_conf->isCUDAErrorCheckingEnabled())
             CHECK_CUDA_ERROR();
 
+        tuner->end();
         m_exec_conf->endMultiGPU();
         }
 
@@ -248,72 +273,6 @@ void ForceCompositeGPU::computeForces(uint64_t timestep)
         throw std::runtime_error("Error computing composite particle forces.\n");
         }
 
-    m_tuner_force->end();
-
-    if (compute_virial)
-        {
-        // reset virial
-        m_exec_conf->beginMultiGPU();
-
-        for (int idev = m_exec_conf->getNumActiveGPUs() - 1; idev >= 0; idev--)
-            {
-            std::pair<unsigned int, unsigned int> range
-                = m_pdata->getGPUPartition().getRangeAndSetGPU(idev);
-            unsigned int nelem = range.second - range.first;
-
-            if (nelem == 0)
-                continue;
-
-            for (unsigned int i = 0; i < 6; i++)
-                {
-                hipMemsetAsync(d_virial.data + i * m_virial_pitch + range.first,
-                               0,
-                               sizeof(Scalar) * nelem);
-                }
-
-            if (m_exec_conf->isCUDAErrorCheckingEnabled())
-                CHECK_CUDA_ERROR();
-            }
-        m_exec_conf->endMultiGPU();
-
-        m_exec_conf->beginMultiGPU();
-        m_tuner_virial->begin();
-        unsigned int param = m_tuner_virial->getParam();
-        unsigned int block_size = param % 10000;
-        unsigned int n_bodies_per_block = param / 10000;
-
-        // launch GPU kernel
-        gpu_rigid_virial(d_virial.data,
-                         d_molecule_length.data,
-                         d_molecule_list.data,
-                         d_molecule_idx.data,
-                         d_rigid_center.data,
-                         molecule_indexer,
-                         d_postype.data,
-                         d_orientation.data,
-                         m_body_idx,
-                         d_body_pos.data,
-                         d_body_orientation.data,
-                         d_net_force.data,
-                         d_net_virial.data,
-                         d_body.data,
-                         d_tag.data,
-                         nmol,
-                         m_pdata->getN(),
-                         n_bodies_per_block,
-                         m_pdata->getNetVirial().getPitch(),
-                         m_virial_pitch,
-                         block_size,
-                         m_exec_conf->dev_prop,
-                         m_gpu_partition);
-
-        if (m_exec_conf->isCUDAErrorCheckingEnabled())
-            CHECK_CUDA_ERROR();
-
-        m_tuner_virial->end();
-        m_exec_conf->endMultiGPU();
-        }
-
     if (m_prof)
         m_prof->pop(m_exec_conf);
     if (m_prof)
@@ -49,7 +49,12 @@
    n_bodies_per_block=16 slows performance significantly. Based on these performance results, this
    kernel is hardcoded to handle only 1,2,4,8 n_bodies_per_block with a power of 2 block size
    (hardcoded to 64 in the kernel launch).
+
+    With compute_virial, the same pass also sums the constituent virials (minus the intra-body part)
+   onto the central particle and zeroes the constituent virials, so that the constituent forces and
+   positions are read only once.
 */
+template<bool compute_virial>
 __global__ void gpu_rigid_force_sliding_kernel(Scalar4* d_force,
                                                Scalar4* d_torque,
                                                const unsigned int* d_molecule_len,
@@ -68,12 +73,15 @@ __global__ void gpu_rigid_force_sliding_kernel(Scalar4* d_force,
                                                uint2* d_flag,
                                                Scalar4* d_net_force,
                                                Scalar4* d_net_torque,
+                                               Scalar* d_virial,
+                                               Scalar* d_net_virial,
+                                               size_t net_virial_pitch,
+                                               size_t virial_pitch,
                                                unsigned int n_mol,
                                                unsigned int N,
                                                unsigned int window_size,
                                                unsigned int thread_mask,
                                                unsigned int n_bodies_per_block,
-                                               bool zero_force,
                                                unsigned int first_body,
                                                unsigned int nwork)
     {
@@ -87,8 +95,8 @@ __global__ void gpu_rigid_force_sliding_kernel(Scalar4* d_force,
     Scalar4* body_force = (Scalar4*)sum;                 // blockDim.x elements
     Scalar4* body_orientation = body_force + blockDim.x; // n_bodies_per_block elements
     Scalar3* body_torque = (Scalar3*)(body_orientation + n_bodies_per_block); // blockDim.x elements
-    unsigned int* body_type
-        = (unsigned int*)(body_torque + blockDim.x);          // n_bodies_per_block elements
+    Scalar* body_virial = (Scalar*)(body_torque + blockDim.x); // 6*blockDim.x elements, or none
+    unsigned int* body_type = (unsigned int*)(body_virial + (compute_virial ? 6 * blockDim.x : 0));
     unsigned int* mol_idx = body_type + n_bodies_per_block;   // n_bodies_per_block elements
     unsigned int* central_idx = mol_idx + n_bodies_per_block; // n_bodies_per_block elements
 
@@ -96,6 +104,7 @@ __global__ void gpu_rigid_force_sliding_kernel(Scalar4* d_force,
     // loops over
     Scalar4 sum_force = make_scalar4(Scalar(0.0), Scalar(0.0), Scalar(0.0), Scalar(0.0));
     Scalar3 sum_torque = make_scalar3(Scalar(0.0), Scalar(0.0), Scalar(0.0));
+    Scalar sum_virial[6] = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
 
     // thread_mask is a bitmask that masks out the high bits in threadIdx.x.
     // threadIdx.x & thread_mask is an index from 0 to block_size/n_bodies_per_block-1 and
@@ -156,16 +165,22 @@ __global__ void gpu_rigid_force_sliding_kernel(Scalar4* d_force,
                     // will likely need to rotate these components too
                     vec3<Scalar> ti(d_net_torque[pidx]);
 
+                    Scalar virial_i[6];
+                    if (compute_virial)
+                        {
+                        for (unsigned int i = 0; i < 6; i++)
+                            {
+                            virial_i[i] = d_net_virial[i * net_virial_pitch + pidx];
+                            d_net_virial[i * net_virial_pitch + pidx] = Scalar(0.0);
+                            }
+                        }
+
                     // zero net torque on constituent particles
                     d_net_torque[pidx] = make_scalar4(0.0, 0.0, 0.0, 0.0);
 
-                    // zero force only if we don't need it later
-                    if (zero_force)
-                        {
-                        // zero net energy on constituent ptls to avoid double counting
-                        // also zero net force for consistency
-                        d_net_force[pidx] = make_scalar4(0.0, 0.0, 0.0, 0.0);
-                        }
+                    // zero net energy on constituent ptls to avoid double counting
+                    // also zero net force for consistency
+                    d_net_force[pidx] = make_scalar4(0.0, 0.0, 0.0, 0.0);
 
                     if (central_idx[m] < N)
                         {
@@ -196,6 +211,17 @@ __global__ void gpu_rigid_force_sliding_kernel(Scalar4* d_force,
                         sum_torque.x += ti.x + del_torque.x;
                         sum_torque.y += ti.y + del_torque.y;
                         sum_torque.z += ti.z + del_torque.z;
+
+                        if (compute_virial)
+                            {
+                            // subtract intra-body virial prt
+                            sum_virial[0] += virial_i[0] - fi.x * ri.x;
+                            sum_virial[1] += virial_i[1] - fi.x * ri.y;
+                            sum_virial[2] += virial_i[2] - fi.x * ri.z;
+                            sum_virial[3] += virial_i[3] - fi.y * ri.y;
+                            sum_virial[4] += virial_i[4] - fi.y * ri.z;
+                            sum_virial[5] += virial_i[5] - fi.z * ri.z;
+                            }
                         }
                     }
                 }
@@ -207,6 +233,11 @@ __global__ void gpu_rigid_force_sliding_kernel(Scalar4* d_force,
     // put the partial sums into shared memory
     body_force[threadIdx.x] = sum_force;
     body_torque[threadIdx.x] = sum_torque;
+    if (compute_virial)
+        {
+        for (unsigned int i = 0; i < 6; i++)
+            body_virial[i * blockDim.x + threadIdx.x] = sum_virial[i];
+        }
 
     __syncthreads();
 
@@ -225,6 +256,13 @@ __global__ void gpu_rigid_force_sliding_kernel(Scalar4* d_force,
             body_torque[threadIdx.x].x += body_torque[threadIdx.x + offset].x;
             body_torque[threadIdx.x].y += body_torque[threadIdx.x + offset].y;
             body_torque[threadIdx.x].z += body_torque[threadIdx.x + offset].z;
+
+            if (compute_virial)
+                {
+                for (unsigned int i = 0; i < 6; i++)
+                    body_virial[i * blockDim.x + threadIdx.x]
+                        += body_virial[i * blockDim.x + threadIdx.x + offset];
+                }
             }
 
         offset >>= 1;
@@ -240,203 +278,18 @@ __global__ void gpu_rigid_force_sliding_kernel(Scalar4* d_force,
                                                 body_torque[threadIdx.x].y,
                                                 body_torque[threadIdx.x].z,
                                                 0.0f);
-        }
-    }
-
-__global__ void gpu_rigid_virial_sliding_kernel(Scalar* d_virial,
-                                                const unsigned int* d_molecule_len,
-                                                const unsigned int* d_molecule_list,
-                                                const unsigned int* d_molecule_idx,
-                                                const unsigned int* d_rigid_center,
-                                                Index2D molecule_indexer,
-                                                const Scalar4* d_postype,
-                                                const Scalar4* d_orientation,
-                                                Index2D body_indexer,
-                                                Scalar3* d_body_pos,
-                                                Scalar4* d_body_orientation,
-                                                Scalar4* d_net_force,
-                                                Scalar* d_net_virial,
-                                                const unsigned int* d_body,
-                                                const unsigned int* d_tag,
-                                                unsigned int n_mol,
-                                                unsigned int N,
-                                                size_t net_virial_pitch,
-                                                size_t virial_pitch,
-                                                unsigned int window_size,
-                                                unsigned int thread_mask,
-                                                unsigned int n_bodies_per_block,
-                                                unsigned int first_body,
-                                                unsigned int nwork)
-    {
-    extern __shared__ char sum[];
-
-    // determine which body (0 ... n_bodies_per_block-1) this thread is working on
-    // assign threads 0, 1, 2, ... to body 0, n, n+1, n+2, ... to body 1, and so on.
-    unsigned int m = threadIdx.x / (blockDim.x / n_bodies_per_block);
-
-    // arrays in shared memory
-    Scalar4* body_orientation = (Scalar4*)sum; // n_bodies_per_block elements
-    Scalar* sum_virial = (Scalar*)(body_orientation + n_bodies_per_block); // 6*blockDim.x elements
-    unsigned int* body_type
-        = (unsigned int*)(sum_virial + 6 * blockDim.x);       // n_bodies_per_block elements
-    unsigned int* mol_idx = body_type + n_bodies_per_block;   // n_bodies_per_block elements
-    unsigned int* central_idx = mol_idx + n_bodies_per_block; // n_bodies_per_block elements
-
-    // body_force and body_torque are each shared memory arrays with 1 element per threads
-    Scalar* body_virial_xx = sum_virial;
-    Scalar* body_virial_xy = &sum_virial[1 * blockDim.x];
-    Scalar* body_virial_xz = &sum_virial[2 * blockDim.x];
-    Scalar* body_virial_yy = &sum_virial[3 * blockDim.x];
-    Scalar* body_virial_yz = &sum_virial[4 * blockDim.x];
-    Scalar* body_virial_zz = &sum_virial[5 * blockDim.x];
-
-    // each thread makes partial sums of the virial of all the particles that this thread loops over
-    Scalar sum_virial_xx(0.0);
-    Scalar sum_virial_xy(0.0);
-    Scalar sum_virial_xz(0.0);
-    Scalar sum_virial_yy(0.0);
-    Scalar sum_virial_yz(0.0);
-    Scalar sum_virial_zz(0.0);
-
-    // thread_mask is a bitmask that masks out the high bits in threadIdx.x.
-    // threadIdx.x & thread_mask is an index from 0 to block_size/n_bodies_per_block-1 and
-    // determines what offset this thread is to use when accessing the particles in the body
-    if ((threadIdx.x & thread_mask) == 0)
-        {
-        // thread 0 for this body reads in the body id and orientation and stores them in shared
-        // memory
-        int group_idx = blockIdx.x * n_bodies_per_block + m;
-        if (group_idx < nwork)
-            {
-            central_idx[m] = d_rigid_center[group_idx + first_body];
-            mol_idx[m] = d_molecule_idx[central_idx[m]];
-
-            if (d_tag[central_idx[m]] != d_body[central_idx[m]])
-                {
-                // this is not the central ptl, molecule is incomplete - mark as such
-                body_type[m] = NO_BODY;
-                body_orientation[m] = make_scalar4(1, 0, 0, 0);
-                }
-            else
-                {
-                body_type[m] = __scalar_as_int(d_postype[central_idx[m]].w);
-                body_orientation[m] = d_orientation[central_idx[m]];
-                }
-            }
-        else
-            {
-            mol_idx[m] = NO_BODY;
-            }
-        }
-
-    __syncthreads();
-
-    if (mol_idx[m] < MIN_FLOPPY)
-        {
-        // compute the number of windows that we need to loop over
-        unsigned int mol_len = d_molecule_len[mol_idx[m]];
-        unsigned int n_windows = mol_len / window_size + 1;
-
-        // slide the window throughout the block
-        for (unsigned int start = 0; start < n_windows; start++)
-            {
-            // determine the index with this body that this particle should handle
-            unsigned int k = start * window_size + (threadIdx.x & thread_mask);
-
-            // if that index is in the body we are actually handling a real body
-            if (k < mol_len)
-                {
-                // determine the particle idx of the particle
-                unsigned int pidx = d_molecule_list[molecule_indexer(k, mol_idx[m])];
-
-                if (body_type[m] < MIN_FLOPPY && pidx != central_idx[m])
-                    {
-                    // calculate body force and torques
-                    Scalar4 fi = d_net_force[pidx];
-
-                    // sum up virial
-                    Scalar virialxx = d_net_virial[0 * net_virial_pitch + pidx];
-                    Scalar virialxy = d_net_virial[1 * net_virial_pitch + pidx];
-                    Scalar virialxz = d_net_virial[2 * net_virial_pitch + pidx];
-                    Scalar virialyy = d_net_virial[3 * net_virial_pitch + pidx];
-                    Scalar virialyz = d_net_virial[4 * net_virial_pitch + pidx];
-                    Scalar virialzz = d_net_virial[5 * net_virial_pitch + pidx];
-
-                    // zero force and virial on constituent particles
-                    d_net_force[pidx] = make_scalar4(0.0, 0.0, 0.0, 0.0);
-
-                    d_net_virial[0 * net_virial_pitch + pidx] = Scalar(0.0);
-                    d_net_virial[1 * net_virial_pitch + pidx] = Scalar(0.0);
-                    d_net_virial[2 * net_virial_pitch + pidx] = Scalar(0.0);
-                    d_net_virial[3 * net_virial_pitch + pidx] = Scalar(0.0);
-                    d_net_virial[4 * net_virial_pitch + pidx] = Scalar(0.0);
-                    d_net_virial[5 * net_virial_pitch + pidx] = Scalar(0.0);
-
-                    // if this particle is not the central particle (incomplete molecules can't have
-                    // local members)
-                    if (central_idx[m] < N)
-                        {
-                        vec3<Scalar> particle_pos(d_body_pos[body_indexer(body_type[m], k - 1)]);
-                        vec3<Scalar> ri = rotate(quat<Scalar>(body_orientation[m]), particle_pos);
-
-                        // subtract intra-body virial prt
-                        sum_virial_xx += virialxx - fi.x * ri.x;
-                        sum_virial_xy += virialxy - fi.x * ri.y;
-                        sum_virial_xz += virialxz - fi.x * ri.z;
-                        sum_virial_yy += virialyy - fi.y * ri.y;
-                        sum_virial_yz += virialyz - fi.y * ri.z;
-                        sum_virial_zz += virialzz - fi.z * ri.z;
-                        }
-                    }
-                }
-            }
-        }
 
-    __syncthreads();
-
-    // put the partial sums into shared memory
-    body_virial_xx[threadIdx.x] = sum_virial_xx;
-    body_virial_xy[threadIdx.x] = sum_virial_xy;
-    body_virial_xz[threadIdx.x] = sum_virial_xz;
-    body_virial_yy[threadIdx.x] = sum_virial_yy;
-    body_virial_yz[threadIdx.x] = sum_virial_yz;
-    body_virial_zz[threadIdx.x] = sum_virial_zz;
-
-    __syncthreads();
-
-    // perform a set of partial reductions. Each block_size/n_bodies_per_block threads performs a
-    // sum reduction just within its own group
-    unsigned int offset = window_size >> 1;
-    while (offset > 0)
-        {
-        if ((threadIdx.x & thread_mask) < offset)
+        if (compute_virial)
             {
-            body_virial_xx[threadIdx.x] += body_virial_xx[threadIdx.x + offset];
-            body_virial_xy[threadIdx.x] += body_virial_xy[threadIdx.x + offset];
-            body_virial_xz[threadIdx.x] += body_virial_xz[threadIdx.x + offset];
-            body_virial_yy[threadIdx.x] += body_virial_yy[threadIdx.x + offset];
-            body_virial_yz[threadIdx.x] += body_virial_yz[threadIdx.x + offset];
-            body_virial_zz[threadIdx.x] += body_virial_zz[threadIdx.x + offset];
+            for (unsigned int i = 0; i < 6; i++)
+                d_virial[i * virial_pitch + central_idx[m]]
+                    = body_virial[i * blockDim.x + threadIdx.x];
             }
-
-        offset >>= 1;
-
-        __syncthreads();
-        }
-
-    // thread 0 within this body writes out the total virial for the body
-    if ((threadIdx.x & thread_mask) == 0 && mol_idx[m] < MIN_FLOPPY && central_idx[m] < N)
-        {
-        d_virial[0 * virial_pitch + central_idx[m]] = body_virial_xx[threadIdx.x];
-        d_virial[1 * virial_pitch + central_idx[m]] = body_virial_xy[threadIdx.x];
-        d_virial[2 * virial_pitch + central_idx[m]] = body_virial_xz[threadIdx.x];
-        d_virial[3 * virial_pitch + central_idx[m]] = body_virial_yy[threadIdx.x];
-        d_virial[4 * virial_pitch + central_idx[m]] = body_virial_yz[threadIdx.x];
-        d_virial[5 * virial_pitch + central_idx[m]] = body_virial_zz[threadIdx.x];
         }
     }
 
-/*!
+/*! \param compute_virial Also sum the virial into d_virial (and zero d_net_virial on the
+    constituents)
  */
 hipError_t gpu_rigid_force(Scalar4* d_force,
                            Scalar4* d_torque,
@@ -456,12 +309,16 @@ hipError_t gpu_rigid_force(Scalar4* d_force,
                            uint2* d_flag,
                            Scalar4* d_net_force,
                            Scalar4* d_net_torque,
+                           Scalar* d_virial,
+                           Scalar* d_net_virial,
+                           size_t net_virial_pitch,
+                           size_t virial_pitch,
                            unsigned int n_mol,
                            unsigned int N,
                            unsigned int n_bodies_per_block,
                            unsigned int block_size,
                            const hipDeviceProp_t& dev_prop,
-                           bool zero_force,
+                           bool compute_virial,
                            const GPUPartition& gpu_partition)
     {
     for (int idev = gpu_partition.getNumActiveGPUs() - 1; idev >= 0; --idev)
@@ -472,15 +329,22 @@ hipError_t gpu_rigid_force(Scalar4* d_force,
 
         dim3 force_grid(nwork / n_bodies_per_block + 1, 1, 1);
 
-        static unsigned int max_block_size = UINT_MAX;
-        static hipFuncAttributes attr;
-        if (max_block_size == UINT_MAX)
+        static unsigned int max_block_size[2] = {UINT_MAX, UINT_MAX};
+        static hipFuncAttributes attr[2];
+        if (max_block_size[compute_virial] == UINT_MAX)
             {
-            hipFuncGetAttributes(&attr, (const void*)gpu_rigid_force_sliding_kernel);
-            max_block_size = attr.maxThreadsPerBlock;
+            if (compute_virial)
+                hipFuncGetAttributes(&attr[1], (const void*)gpu_rigid_force_sliding_kernel<true>);
+            else
+                hipFuncGetAttributes(&attr[0], (const void*)gpu_rigid_force_sliding_kernel<false>);
+            max_block_size[compute_virial] = attr[compute_virial].maxThreadsPerBlock;
             }
 
-        unsigned int run_block_size = max_block_size < block_size ? max_block_size : block_size;
+        unsigned int virial_bytes_per_thread = compute_virial ? 6 * sizeof(Scalar) : 0;
+
+        unsigned int run_block_size = max_block_size[compute_virial] < block_size
+                                          ? max_block_size[compute_virial]
+                                          : block_size;
 
         // round down to nearest power of two
         unsigned int b = 1;
@@ -493,155 +357,98 @@ hipError_t gpu_rigid_force(Scalar4* d_force,
         unsigned int window_size = run_block_size / n_bodies_per_block;
         unsigned int thread_mask = window_size - 1;
 
-        size_t shared_bytes = run_block_size * (sizeof(Scalar4) + sizeof(Scalar3))
-                              + n_bodies_per_block * (sizeof(Scalar4) + 3 * sizeof(unsigned int));
+        size_t shared_bytes
+            = run_block_size * (sizeof(Scalar4) + sizeof(Scalar3) + virial_bytes_per_thread)
+              + n_bodies_per_block * (sizeof(Scalar4) + 3 * sizeof(unsigned int));
 
-        while (shared_bytes + attr.sharedSizeBytes >= dev_prop.sharedMemPerBlock)
+        while (shared_bytes + attr[compute_virial].sharedSizeBytes >= dev_prop.sharedMemPerBlock)
             {
             // block size is power of two
             run_block_size /= 2;
 
-            shared_bytes = run_block_size * (sizeof(Scalar4) + sizeof(Scalar3))
-                           + n_bodies_per_block * (sizeof(Scalar4) + 3 * sizeof(unsigned int));
+            shared_bytes
+                = run_block_size * (sizeof(Scalar4) + sizeof(Scalar3) + virial_bytes_per_thread)
+                  + n_bodies_per_block * (sizeof(Scalar4) + 3 * sizeof(unsigned int));
 
             window_size = run_block_size / n_bodies_per_block;
             thread_mask = window_size - 1;
             }
 
-        hipLaunchKernelGGL((gpu_rigid_force_sliding_kernel),
-                           dim3(force_grid),
-                           dim3(run_block_size),
-                           shared_bytes,
-                           0,
-                           d_force,
-                           d_torque,
-                           d_molecule_len,
-                           d_molecule_list,
-                           d_molecule_idx,
-                           d_rigid_center,
-                           molecule_indexer,
-                           d_postype,
-                           d_orientation,
-                           body_indexer,
-                           d_body_pos,
-                           d_body_orientation,
-                           d_body_len,
-                           d_body,
-                           d_tag,
-                           d_flag,
-                           d_net_force,
-                           d_net_torque,
-                           n_mol,
-                           N,
-                           window_size,
-                           thread_mask,
-                           n_bodies_per_block,
-                           zero_force,
-                           range.first,
-                           nwork);
-        }
-    return hipSuccess;
-    }
-
-hipError_t gpu_rigid_virial(Scalar* d_virial,
-                            const unsigned int* d_molecule_len,
-                            const unsigned int* d_molecule_list,
-                            const unsigned int* d_molecule_idx,
-                            const unsigned int* d_rigid_center,
-                            Index2D molecule_indexer,
-                            const Scalar4* d_postype,
-                            const Scalar4* d_orientation,
-                            Index2D body_indexer,
-                            Scalar3* d_body_pos,
-                            Scalar4* d_body_orientation,
-                            Scalar4* d_net_force,
-                            Scalar* d_net_virial,
-                            const unsigned int* d_body,
-                            const unsigned int* d_tag,
-                            unsigned int n_mol,
-                            unsigned int N,
-                            unsigned int n_bodies_per_block,
-                            size_t net_virial_pitch,
-                            size_t virial_pitch,
-                            unsigned int block_size,
-                            const hipDeviceProp_t& dev_prop,
-                            const GPUPartition& gpu_partition)
-    {
-    for (int idev = gpu_partition.getNumActiveGPUs() - 1; idev >= 0; --idev)
-        {
-        auto range = gpu_partition.getRangeAndSetGPU(idev);
-
-        unsigned int nwork = range.second - range.first;
-
-        dim3 force_grid(nwork / n_bodies_per_block + 1, 1, 1);
-
-        static unsigned int max_block_size = UINT_MAX;
-        static hipFuncAttributes attr;
-        if (max_block_size == UINT_MAX)
-            {
-            hipFuncGetAttributes(&attr, (const void*)gpu_rigid_virial_sliding_kernel);
-            max_block_size = attr.maxThreadsPerBlock;
-            }
-
-        unsigned int run_block_size = max_block_size < block_size ? max_block_size : block_size;
-
-        // round down to nearest power of two
-        unsigned int b = 1;
-        while (b * 2 <= run_block_size)
+        if (compute_virial)
             {
-            b *= 2;
+            hipLaunchKernelGGL((gpu_rigid_force_sliding_kernel<true>),
+                               dim3(force_grid),
+                               dim3(run_block_size),
+                               shared_bytes,
+                               0,
+                               d_force,
+                               d_torque,
+                               d_molecule_len,
+                               d_molecule_list,
+                               d_molecule_idx,
+                               d_rigid_center,
+                               molecule_indexer,
+                               d_postype,
+                               d_orientation,
+                               body_indexer,
+                               d_body_pos,
+                               d_body_orientation,
+                               d_body_len,
+                               d_body,
+                               d_tag,
+                               d_flag,
+                               d_net_force,
+                               d_net_torque,
+                               d_virial,
+                               d_net_virial,
+                               net_virial_pitch,
+                               virial_pitch,
+                               n_mol,
+                               N,
+                               window_size,
+                               thread_mask,
+                               n_bodies_per_block,
+                               range.first,
+                               nwork);
             }
-        run_block_size = b;
-
-        unsigned int window_size = run_block_size / n_bodies_per_block;
-        unsigned int thread_mask = window_size - 1;
-
-        size_t shared_bytes = 6 * run_block_size * sizeof(Scalar)
-                              + n_bodies_per_block * (sizeof(Scalar4) + 3 * sizeof(unsigned int));
-
-        while (shared_bytes + attr.sharedSizeBytes >= dev_prop.sharedMemPerBlock)
+        else
             {
-            // block size is power of two
-            run_block_size /= 2;
-
-            shared_bytes = 6 * run_block_size * sizeof(Scalar)
-                           + n_bodies_per_block * (sizeof(Scalar4) + 3 * sizeof(unsigned int));
-
-            window_size = run_block_size / n_bodies_per_block;
-            thread_mask = window_size - 1;
+            hipLaunchKernelGGL((gpu_rigid_force_sliding_kernel<false>),
+                               dim3(force_grid),
+                               dim3(run_block_size),
+                               shared_bytes,
+                               0,
+                               d_force,
+                               d_torque,
+                               d_molecule_len,
+                               d_molecule_list,
+                               d_molecule_idx,
+                               d_rigid_center,
+                               molecule_indexer,
+                               d_postype,
+                               d_orientation,
+                               body_indexer,
+                               d_body_pos,
+                               d_body_orientation,
+                               d_body_len,
+                               d_body,
+                               d_tag,
+                               d_flag,
+                               d_net_force,
+                               d_net_torque,
+                               d_virial,
+                               d_net_virial,
+                               net_virial_pitch,
+                               virial_pitch,
+                               n_mol,
+                               N,
+                               window_size,
+                               thread_mask,
+                               n_bodies_per_block,
+                               range.first,
+                               nwork);
             }
-
-        hipLaunchKernelGGL((gpu_rigid_virial_sliding_kernel),
-                           dim3(force_grid),
-                           dim3(run_block_size),
-                           shared_bytes,
-                           0,
-                           d_virial,
-                           d_molecule_len,
-                           d_molecule_list,
-                           d_molecule_idx,
-                           d_rigid_center,
-                           molecule_indexer,
-                           d_postype,
-                           d_orientation,
-                           body_indexer,
-                           d_body_pos,
-                           d_body_orientation,
-                           d_net_force,
-                           d_net_virial,
-                           d_body,
-                           d_tag,
-                           n_mol,
-                           N,
-                           net_virial_pitch,
-                           virial_pitch,
-                           window_size,
-                           thread_mask,
-                           n_bodies_per_block,
-                           range.first,
-                           nwork);
         }
-
     return hipSuccess;
     }
 
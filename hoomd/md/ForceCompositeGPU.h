@@ -77,7 +77,7 @@ class PYBIND11_EXPORT ForceCompositeGPU : public ForceComposite
 
     std::unique_ptr<Autotuner> m_tuner_force; //!< Autotuner for block size and threads per particle
     std::unique_ptr<Autotuner>
-        m_tuner_virial; //!< Autotuner for block size and threads per particle
+        m_tuner_virial; //!< Autotuner for the force kernel that also sums the virial
     std::unique_ptr<Autotuner> m_tuner_update; //!< Autotuner for block size of update kernel
 
     GlobalArray<uint2> m_flag; //!< Flag to read out error condition
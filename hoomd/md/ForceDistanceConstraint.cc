@@ -5,6 +5,7 @@
 
 #include "ForceDistanceConstraint.h"
 
+#include <algorithm>
 #include <string.h>
 using namespace Eigen;
 namespace py = pybind11;
@@ -19,7 +20,8 @@ ForceDistanceConstraint::ForceDistanceConstraint(std::shared_ptr<SystemDefinitio
     : MolecularForceCompute(sysdef), m_cdata(m_sysdef->getConstraintData()), m_cmatrix(m_exec_conf),
       m_cvec(m_exec_conf), m_lagrange(m_exec_conf), m_rel_tol(1e-3),
       m_constraint_violated(m_exec_conf), m_condition(m_exec_conf), m_sparse_idxlookup(m_exec_conf),
-      m_constraint_reorder(true), m_constraints_added_removed(true), m_d_max(0.0)
+      m_constraint_reorder(true), m_constraints_added_removed(true), m_solver(solver_lu),
+      m_solver_tol(1e-10), m_lagrange_valid(false), m_d_max(0.0)
     {
     m_constraint_violated.resetFlags(0);
 
@@ -54,6 +56,34 @@ ForceDistanceConstraint::~ForceDistanceConstraint()
 #endif
     }
 
+/*! \param solver Name of the linear solver, "lu" or "iterative"
+ */
+void ForceDistanceConstraint::setSolver(const std::string& solver)
+    {
+    if (solver == "lu")
+        {
+        m_solver = solver_lu;
+        }
+    else if (solver == "iterative")
+        {
+        m_solver = solver_iterative;
+        }
+    else
+        {
+        throw std::invalid_argument("Invalid solver: " + solver);
+        }
+
+    // rebuild the sparse matrix for the new solver
+    m_condition.resetFlags(1);
+    }
+
+std::string ForceDistanceConstraint::getSolver()
+    {
+    if (m_solver == solver_iterative)
+        return "iterative";
+    return "lu";
+    }
+
 Scalar ForceDistanceConstraint::getNDOFRemoved(std::shared_ptr<ParticleGroup> query)
     {
     // the distance constraint removes half a degree of freedom for each particle that is part
@@ -131,11 +161,8 @@ void ForceDistanceConstraint::fillMatrixVector(uint64_t timestep)
     // fill the matrix in column-major order
     unsigned int n_constraint = m_cdata->getN() + m_cdata->getNGhosts();
 
-    if (m_constraint_reorder)
+    if (m_constraint_reorder && checkConstraintOrder())
         {
-        // reset flag
-        m_constraint_reorder = false;
-
         // resize lookup matrix
         m_sparse_idxlookup.resize(n_constraint * n_constraint);
 
@@ -258,7 +285,9 @@ void ForceDistanceConstraint::fillMatrixVector(uint64_t timestep)
             // update sparse matrix
             int k = m_sparse_idxlookup[m * n_constraint + n];
 
-            if ((k == -1 && delta != double(0.0)) || (k != -1 && delta == double(0.0)))
+            // elements that become zero stay in the pattern, only new non-zeros require a new
+            // symbolic factorization
+            if (k == -1 && delta != double(0.0))
                 {
                 m_condition.resetFlags(1);
                 }
@@ -400,10 +429,37 @@ void ForceDistanceConstraint::solveConstraints(uint64_t timestep)
             }
 
         // Compute the ordering permutation vector from the structural pattern of A
-        m_sparse_solver.analyzePattern(m_sparse);
+        if (m_solver == solver_lu)
+            m_sparse_solver.analyzePattern(m_sparse);
+
+        if (m_prof)
+            m_prof->pop();
+        }
+
+    if (m_solver == solver_iterative)
+        {
+        if (m_prof)
+            m_prof->push("iterate");
+
+        bool converged = solveIterative(n_constraint);
 
         if (m_prof)
             m_prof->pop();
+
+        if (converged)
+            {
+            if (m_prof)
+                m_prof->pop();
+            return;
+            }
+
+        m_exec_conf->msg->notice(6) << "ForceDistanceConstraint: iterative solver did not converge "
+                                    << "after " << m_iterative_solver.iterations()
+                                    << " iterations. Falling back to LU decomposition."
+                                    << std::endl;
+
+        // the pattern of the LU solver is not kept up to date in iterative mode
+        m_sparse_solver.analyzePattern(m_sparse);
         }
 
     if (m_prof)
@@ -425,6 +481,7 @@ void ForceDistanceConstraint::solveConstraints(uint64_t timestep)
 
     // Use the factors to solve the linear system
     map_lagrange = m_sparse_solver.solve(map_vec);
+    m_lagrange_valid = true;
 
     if (m_prof)
         m_prof->pop();
@@ -433,6 +490,62 @@ void ForceDistanceConstraint::solveConstraints(uint64_t timestep)
         m_prof->pop();
     }
 
+/*! \returns true if the order of the constraints differs from the one the sparse matrix was built
+    for
+
+    Resets m_constraint_reorder. The Lagrange multipliers of the previous step are only kept as an
+    initial guess when the order is unchanged.
+*/
+bool ForceDistanceConstraint::checkConstraintOrder()
+    {
+    m_constraint_reorder = false;
+
+    unsigned int n_constraint = m_cdata->getN() + m_cdata->getNGhosts();
+    ArrayHandle<unsigned int> h_group_tag(m_cdata->getTags(),
+                                          access_location::host,
+                                          access_mode::read);
+
+    if (m_pattern_tags.size() == n_constraint
+        && std::equal(m_pattern_tags.begin(), m_pattern_tags.end(), h_group_tag.data))
+        {
+        return false;
+        }
+
+    m_pattern_tags.assign(h_group_tag.data, h_group_tag.data + n_constraint);
+    m_lagrange_valid = false;
+    return true;
+    }
+
+/*! \param n_constraint Number of constraints, including ghosts
+    \returns true if the iteration converged
+
+    Solves the system in m_sparse with BiCGSTAB, starting from the multipliers of the previous step
+    when they are still valid. The sparsity pattern of m_sparse is reused between steps, only the
+    diagonal preconditioner is recomputed.
+*/
+bool ForceDistanceConstraint::solveIterative(unsigned int n_constraint)
+    {
+    typedef Matrix<double, Dynamic, 1> vec_t;
+    typedef Map<vec_t> vec_map_t;
+
+    m_iterative_solver.setTolerance(m_solver_tol);
+    m_iterative_solver.compute(m_sparse);
+
+    ArrayHandle<double> h_cvec(m_cvec, access_location::host, access_mode::read);
+    ArrayHandle<double> h_lagrange(m_lagrange, access_location::host, access_mode::readwrite);
+    vec_map_t map_vec(h_cvec.data, n_constraint, 1);
+    vec_map_t map_lagrange(h_lagrange.data, n_constraint, 1);
+
+    if (!m_lagrange_valid)
+        map_lagrange.setZero();
+
+    vec_t guess = map_lagrange;
+    map_lagrange = m_iterative_solver.solveWithGuess(map_vec, guess);
+
+    m_lagrange_valid = m_iterative_solver.info() == Eigen::Success;
+    return m_lagrange_valid;
+    }
+
 void ForceDistanceConstraint::computeConstraintForces(uint64_t timestep)
     {
     ArrayHandle<double> h_lagrange(m_lagrange, access_location::host, access_mode::read);
@@ -656,6 +769,7 @@ void ForceDistanceConstraint::assignMoleculeTags()
 
     m_exec_conf->msg->notice(6) << "Maximum constraint length: " << m_d_max << std::endl;
     m_n_molecules_global = molecule;
+    notifyMoleculeTagsChanged();
     }
 
 void export_ForceDistanceConstraint(py::module& m)
@@ -666,5 +780,11 @@ void export_ForceDistanceConstraint(py::module& m)
         .def(py::init<std::shared_ptr<SystemDefinition>>())
         .def_property("tolerance",
                       &ForceDistanceConstraint::getRelativeTolerance,
-                      &ForceDistanceConstraint::setRelativeTolerance);
+                      &ForceDistanceConstraint::setRelativeTolerance)
+        .def_property("solver",
+                      &ForceDistanceConstraint::getSolver,
+                      &ForceDistanceConstraint::setSolver)
+        .def_property("solver_tolerance",
+                      &ForceDistanceConstraint::getSolverTolerance,
+                      &ForceDistanceConstraint::setSolverTolerance);
     }
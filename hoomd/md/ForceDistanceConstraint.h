@@ -22,8 +22,11 @@
 #include "hoomd/GPUVector.h"
 
 #include <Eigen/Dense>
+#include <Eigen/IterativeLinearSolvers>
 #include <Eigen/SparseLU>
 
+#include <string>
+
 /*! Implements a pairwise distance constraint using the algorithm of
 
     [1] M. Yoneya, H. J. C. Berendsen, and K. Hirasawa, “A Non-Iterative Matrix Method for
@@ -31,6 +34,15 @@
    M. Yoneya, “A Generalized Non-iterative Matrix Method for Constraint Molecular Dynamics
    Simulations,” J. Comput. Phys., vol. 172, no. 1, pp. 188–197, Sep. 2001.
 
+    The sparsity pattern of the constraint matrix and its symbolic factorization are kept until a
+   new non-zero element appears. When the constraints are reordered (e.g. after a particle sort or
+   a ghost exchange), the pattern is only discarded if the order of the constraint tags changed.
+
+    The sparse linear system for the Lagrange multipliers is either factorized with a sparse LU
+   decomposition on every step, or solved with BiCGSTAB and a diagonal preconditioner. The iterative
+   solver starts from the Lagrange multipliers of the previous step as long as the constraints keep
+   their order in memory, and falls back to the LU decomposition when it does not converge.
+
     See Integrator for detailed documentation on constraint force implementation.
     \ingroup computes
 */
@@ -61,6 +73,31 @@ class PYBIND11_EXPORT ForceDistanceConstraint : public MolecularForceCompute
         return m_rel_tol;
         }
 
+    //! Methods to solve the constraint equations
+    enum solverType
+        {
+        solver_lu,       //!< Sparse LU decomposition on every step
+        solver_iterative //!< Warm started BiCGSTAB
+        };
+
+    /// Set the linear solver ("lu" or "iterative")
+    void setSolver(const std::string& solver);
+
+    /// Get the linear solver
+    std::string getSolver();
+
+    /// Set the relative residual at which the iterative solver stops
+    void setSolverTolerance(Scalar solver_tol)
+        {
+        m_solver_tol = solver_tol;
+        }
+
+    /// Get the relative residual at which the iterative solver stops
+    Scalar getSolverTolerance()
+        {
+        return m_solver_tol;
+        }
+
 #ifdef ENABLE_MPI
     //! Get ghost particle fields requested by this pair potential
     virtual CommFlags getRequestedCommFlags(uint64_t timestep);
@@ -85,12 +122,21 @@ class PYBIND11_EXPORT ForceDistanceConstraint : public MolecularForceCompute
     Eigen::SparseLU<Eigen::SparseMatrix<double, Eigen::ColMajor>, Eigen::COLAMDOrdering<int>>
         m_sparse_solver;
     //!< The persistent state of the sparse matrix solver
+    Eigen::BiCGSTAB<Eigen::SparseMatrix<double, Eigen::ColMajor>,
+                    Eigen::DiagonalPreconditioner<double>>
+        m_iterative_solver; //!< The iterative solver, used when m_solver == solver_iterative
     GPUVector<int>
         m_sparse_idxlookup; //!< Reverse lookup from column-major to sparse matrix element
 
     bool m_constraint_reorder;        //!< True if groups have changed
     bool m_constraints_added_removed; //!< True if global constraint topology has changed
 
+    solverType m_solver;   //!< Method to solve the constraint equations
+    Scalar m_solver_tol;   //!< Relative residual at which the iterative solver stops
+    bool m_lagrange_valid; //!< True if m_lagrange holds the previous solution in the current order
+
+    std::vector<unsigned int> m_pattern_tags; //!< Constraint tags in the order of the sparse matrix
+
     Scalar m_d_max; //!< Maximum constraint extension
 
     //! Compute the forces
@@ -108,6 +154,12 @@ class PYBIND11_EXPORT ForceDistanceConstraint : public MolecularForceCompute
     //! Solve the linear matrix-vector equation
     virtual void computeConstraintForces(uint64_t timestep);
 
+    //! Solve the constraint matrix equation with the iterative solver
+    bool solveIterative(unsigned int n_constraint);
+
+    //! Check if the constraints changed order since the sparsity pattern was built
+    bool checkConstraintOrder();
+
     //! Method called when constraint order changes
     virtual void slotConstraintReorder()
         {
@@ -106,11 +106,8 @@ void ForceDistanceConstraintGPU::fillMatrixVector(uint64_t timestep)
     // fill the matrix in row-major order
     unsigned int n_constraint = m_cdata->getN() + m_cdata->getNGhosts();
 
-    if (m_constraint_reorder)
+    if (m_constraint_reorder && checkConstraintOrder())
         {
-        // reset flag
-        m_constraint_reorder = false;
-
         // resize lookup matrix
         m_sparse_idxlookup.resize(n_constraint * n_constraint);
 
@@ -215,23 +212,32 @@ void ForceDistanceConstraintGPU::solveConstraints(uint64_t timestep)
     // ==1 if the sparsity pattern of the matrix changes (in particular if connectivity changes)
     unsigned int sparsity_pattern_changed = m_condition.readFlags();
 
-#ifndef CUSOLVER_AVAILABLE
-    if (!sparsity_pattern_changed)
+#ifdef CUSOLVER_AVAILABLE
+    // the iterative solver works on the host copy of the sparse matrix
+    if (m_solver == solver_iterative)
+#endif
         {
-        // copy new sparse values to host sparse matrix
-        ArrayHandle<double> h_sparse_val(m_sparse_val, access_location::device, access_mode::read);
-        hipMemcpy(m_sparse.valuePtr(),
-                  h_sparse_val.data,
-                  sizeof(double) * m_sparse.data().size(),
-                  hipMemcpyDeviceToHost);
-        }
+        if (!sparsity_pattern_changed)
+            {
+            // copy new sparse values to host sparse matrix
+            ArrayHandle<double> h_sparse_val(m_sparse_val,
+                                             access_location::device,
+                                             access_mode::read);
+            hipMemcpy(m_sparse.valuePtr(),
+                      h_sparse_val.data,
+                      sizeof(double) * m_sparse.data().size(),
+                      hipMemcpyDeviceToHost);
+            }
+
+        // solve on CPU
+        ForceDistanceConstraint::solveConstraints(timestep);
 
-    // solve on CPU
-    ForceDistanceConstraint::solveConstraints(timestep);
+        // a sparse matrix should have been constructed, resize values array
+        m_sparse_val.resize(m_sparse.data().size());
+        return;
+        }
 
-    // a sparse matrix should have been constructed, resize values array
-    m_sparse_val.resize(m_sparse.data().size());
-#else
+#ifdef CUSOLVER_AVAILABLE
 
     unsigned int n_constraint = m_cdata->getN() + m_cdata->getNGhosts();
 
@@ -676,6 +682,7 @@ void ForceDistanceConstraintGPU::solveConstraints(uint64_t timestep)
                     n_constraint,
                     d_lagrange.data,
                     n_constraint);
+    m_lagrange_valid = true;
 
     if (m_prof)
         m_prof->pop(m_exec_conf);
@@ -728,6 +735,7 @@ void ForceDistanceConstraintGPU::computeConstraintForces(uint64_t timestep)
                                   d_force.data,
                                   d_virial.data,
                                   m_virial_pitch,
+                                  m_pdata->getFlags()[pdata_flag::pressure_tensor],
                                   box,
                                   n_ptl,
                                   m_tuner_force->getParam(),
@@ -140,7 +140,8 @@ __global__ void gpu_fill_matrix_vector_kernel(unsigned int n_constraint,
             // update sparse matrix
             int k = d_csr_idxlookup[m * n_constraint + n];
 
-            if ((k == -1 && mat_element != double(0.0)) || (k != -1 && mat_element == double(0.0)))
+            // elements that become zero stay in the pattern
+            if (k == -1 && mat_element != double(0.0))
                 {
                 *d_sparsity_pattern_changed = 1;
                 }
@@ -240,6 +241,7 @@ __global__ void gpu_fill_constraint_forces_kernel(unsigned int nptl_local,
                                                   Scalar4* d_force,
                                                   Scalar* d_virial,
                                                   size_t virial_pitch,
+                                                  const bool compute_virial,
                                                   const BoxDim box)
     {
     unsigned int idx = blockIdx.x * blockDim.x + threadIdx.x;
@@ -318,12 +320,15 @@ __global__ void gpu_fill_constraint_forces_kernel(unsigned int nptl_local,
 
     d_force[idx] = make_scalar4(f.x, f.y, f.z, Scalar(0.0));
 
-    d_virial[0 * virial_pitch + idx] = virialxx;
-    d_virial[1 * virial_pitch + idx] = virialxy;
-    d_virial[2 * virial_pitch + idx] = virialxz;
-    d_virial[3 * virial_pitch + idx] = virialyy;
-    d_virial[4 * virial_pitch + idx] = virialyz;
-    d_virial[5 * virial_pitch + idx] = virialzz;
+    if (compute_virial)
+        {
+        d_virial[0 * virial_pitch + idx] = virialxx;
+        d_virial[1 * virial_pitch + idx] = virialxy;
+        d_virial[2 * virial_pitch + idx] = virialxz;
+        d_virial[3 * virial_pitch + idx] = virialyy;
+        d_virial[4 * virial_pitch + idx] = virialyz;
+        d_virial[5 * virial_pitch + idx] = virialzz;
+        }
     }
 
 #ifdef CUSOLVER_AVAILABLE
@@ -384,6 +389,7 @@ hipError_t gpu_compute_constraint_forces(const Scalar4* d_pos,
                                          Scalar4* d_force,
                                          Scalar* d_virial,
                                          size_t virial_pitch,
+                                         const bool compute_virial,
                                          const BoxDim box,
                                          unsigned int nptl_local,
                                          unsigned int block_size,
@@ -420,6 +426,7 @@ hipError_t gpu_compute_constraint_forces(const Scalar4* d_pos,
                        d_force,
                        d_virial,
                        virial_pitch,
+                       compute_virial,
                        box);
 
     return hipSuccess;
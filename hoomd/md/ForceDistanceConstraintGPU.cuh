@@ -60,6 +60,7 @@ hipError_t gpu_compute_constraint_forces(const Scalar4* d_pos,
                                          Scalar4* d_force,
                                          Scalar* d_virial,
                                          size_t virial_pitch,
+                                         const bool compute_virial,
                                          const BoxDim box,
                                          unsigned int nptl_local,
                                          unsigned int block_size,
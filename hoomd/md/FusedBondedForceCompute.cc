@@ -0,0 +1,361 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "FusedBondedForceCompute.h"
+#include "EvaluatorFusedBonded.h"
+
+namespace py = pybind11;
+
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+
+using namespace std;
+
+/*! \file FusedBondedForceCompute.cc
+    \brief Contains code for the FusedBondedForceCompute class
+*/
+
+/*! \param sysdef System to compute forces on
+    \post Memory is allocated, and forces are zeroed.
+*/
+FusedBondedForceCompute::FusedBondedForceCompute(std::shared_ptr<SystemDefinition> sysdef)
+    : ForceCompute(sysdef)
+    {
+    m_exec_conf->msg->notice(5) << "Constructing FusedBondedForceCompute" << endl;
+
+    // access the bonded group data for later use
+    m_bond_data = m_sysdef->getBondData();
+    m_angle_data = m_sysdef->getAngleData();
+    m_dihedral_data = m_sysdef->getDihedralData();
+
+    // allocate the parameters
+    GPUArray<Scalar2> bond_params(m_bond_data->getNTypes(), m_exec_conf);
+    m_bond_params.swap(bond_params);
+    GPUArray<Scalar2> angle_params(m_angle_data->getNTypes(), m_exec_conf);
+    m_angle_params.swap(angle_params);
+    GPUArray<Scalar4> dihedral_params(m_dihedral_data->getNTypes(), m_exec_conf);
+    m_dihedral_params.swap(dihedral_params);
+    }
+
+FusedBondedForceCompute::~FusedBondedForceCompute()
+    {
+    m_exec_conf->msg->notice(5) << "Destroying FusedBondedForceCompute" << endl;
+    }
+
+/*! \param type Name of the bond type
+    \param params Dictionary with the keys k and r0
+*/
+void FusedBondedForceCompute::setBondParams(std::string type, pybind11::dict params)
+    {
+    unsigned int typ = m_bond_data->getTypeByName(type);
+    ArrayHandle<Scalar2> h_params(m_bond_params, access_location::host, access_mode::readwrite);
+    h_params.data[typ] = make_scalar2(params["k"].cast<Scalar>(), params["r0"].cast<Scalar>());
+    }
+
+/*! \param type Name of the bond type
+ */
+pybind11::dict FusedBondedForceCompute::getBondParams(std::string type)
+    {
+    unsigned int typ = m_bond_data->getTypeByName(type);
+    ArrayHandle<Scalar2> h_params(m_bond_params, access_location::host, access_mode::read);
+    pybind11::dict params;
+    params["k"] = h_params.data[typ].x;
+    params["r0"] = h_params.data[typ].y;
+    return params;
+    }
+
+/*! \param type Name of the angle type
+    \param params Dictionary with the keys k and t0
+*/
+void FusedBondedForceCompute::setAngleParams(std::string type, pybind11::dict params)
+    {
+    unsigned int typ = m_angle_data->getTypeByName(type);
+    ArrayHandle<Scalar2> h_params(m_angle_params, access_location::host, access_mode::readwrite);
+    h_params.data[typ] = make_scalar2(params["k"].cast<Scalar>(), params["t0"].cast<Scalar>());
+    }
+
+/*! \param type Name of the angle type
+ */
+pybind11::dict FusedBondedForceCompute::getAngleParams(std::string type)
+    {
+    unsigned int typ = m_angle_data->getTypeByName(type);
+    ArrayHandle<Scalar2> h_params(m_angle_params, access_location::host, access_mode::read);
+    pybind11::dict params;
+    params["k"] = h_params.data[typ].x;
+    params["t0"] = h_params.data[typ].y;
+    return params;
+    }
+
+/*! \param type Name of the dihedral type
+    \param params Dictionary with the keys k1, k2, k3, and k4
+
+    The parameters are stored with the 1/2 prefactor, as in OPLSDihedralForceCompute.
+*/
+void FusedBondedForceCompute::setDihedralParams(std::string type, pybind11::dict params)
+    {
+    unsigned int typ = m_dihedral_data->getTypeByName(type);
+    ArrayHandle<Scalar4> h_params(m_dihedral_params,
+                                  access_location::host,
+                                  access_mode::readwrite);
+    h_params.data[typ] = make_scalar4(params["k1"].cast<Scalar>() / Scalar(2.0),
+                                      params["k2"].cast<Scalar>() / Scalar(2.0),
+                                      params["k3"].cast<Scalar>() / Scalar(2.0),
+                                      params["k4"].cast<Scalar>() / Scalar(2.0));
+    }
+
+/*! \param type Name of the dihedral type
+ */
+pybind11::dict FusedBondedForceCompute::getDihedralParams(std::string type)
+    {
+    unsigned int typ = m_dihedral_data->getTypeByName(type);
+    ArrayHandle<Scalar4> h_params(m_dihedral_params, access_location::host, access_mode::read);
+    pybind11::dict params;
+    params["k1"] = h_params.data[typ].x * Scalar(2.0);
+    params["k2"] = h_params.data[typ].y * Scalar(2.0);
+    params["k3"] = h_params.data[typ].z * Scalar(2.0);
+    params["k4"] = h_params.data[typ].w * Scalar(2.0);
+    return params;
+    }
+
+/*! Actually perform the force computation
+    \param timestep Current time step
+
+    The bonds, angles, and dihedrals are evaluated in one threaded loop over the concatenated
+    group index range [0, n_bonds + n_angles + n_dihedrals).
+ */
+void FusedBondedForceCompute::computeForces(uint64_t timestep)
+    {
+    if (m_prof)
+        m_prof->push("Fused bonded");
+
+    assert(m_pdata);
+    // access the particle data arrays
+    ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::read);
+
+    ArrayHandle<Scalar4> h_force(m_force, access_location::host, access_mode::overwrite);
+    ArrayHandle<Scalar> h_virial(m_virial, access_location::host, access_mode::overwrite);
+
+    ArrayHandle<Scalar2> h_bond_params(m_bond_params, access_location::host, access_mode::read);
+    ArrayHandle<Scalar2> h_angle_params(m_angle_params, access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> h_dihedral_params(m_dihedral_params,
+                                           access_location::host,
+                                           access_mode::read);
+
+    // Zero data for force calculation
+    memset((void*)h_force.data, 0, sizeof(Scalar4) * m_force.getNumElements());
+    memset((void*)h_virial.data, 0, sizeof(Scalar) * m_virial.getNumElements());
+
+    const BoxDim& box = m_pdata->getGlobalBox();
+    const unsigned int N = m_pdata->getN();
+
+    const unsigned int n_bonds = (unsigned int)m_bond_data->getN();
+    const unsigned int n_angles = (unsigned int)m_angle_data->getN();
+    const unsigned int n_dihedrals = (unsigned int)m_dihedral_data->getN();
+
+    // add the force, energy, and virial contribution of one group member, skip ghost particles
+    auto accumulate = [N](unsigned int idx,
+                          const Scalar3& f,
+                          Scalar energy,
+                          const Scalar* group_virial,
+                          Scalar4* force,
+                          Scalar* virial,
+                          size_t virial_pitch)
+    {
+        if (idx >= N)
+            return;
+
+        force[idx].x += f.x;
+        force[idx].y += f.y;
+        force[idx].z += f.z;
+        force[idx].w += energy;
+        for (unsigned int j = 0; j < 6; j++)
+            virial[j * virial_pitch + idx] += group_virial[j];
+    };
+
+    // look up the local index of a group member and throw an error if it is not available
+    auto lookup = [&](unsigned int tag, const char* kind)
+    {
+        unsigned int idx = h_rtag.data[tag];
+        if (idx == NOT_LOCAL)
+            {
+            m_exec_conf->msg->error()
+                << "md.force.FusedBonded: " << kind << " with particle " << tag << " incomplete."
+                << endl
+                << endl;
+            throw std::runtime_error("Error in bonded force calculation");
+            }
+        assert(idx < m_pdata->getN() + m_pdata->getNGhosts());
+        return idx;
+    };
+
+    auto compute_groups = [&](unsigned int begin,
+                              unsigned int end,
+                              Scalar4* force,
+                              Scalar* virial,
+                              size_t virial_pitch)
+    {
+        for (unsigned int i = begin; i < end; i++)
+            {
+            if (i < n_bonds)
+                {
+                const BondData::members_t& bond = m_bond_data->getMembersByIndex(i);
+                unsigned int idx_a = lookup(bond.tag[0], "bond");
+                unsigned int idx_b = lookup(bond.tag[1], "bond");
+
+                Scalar3 dx = make_scalar3(h_pos.data[idx_b].x - h_pos.data[idx_a].x,
+                                          h_pos.data[idx_b].y - h_pos.data[idx_a].y,
+                                          h_pos.data[idx_b].z - h_pos.data[idx_a].z);
+                dx = box.minImage(dx);
+
+                Scalar force_divr, bond_eng;
+                evalFusedHarmonicBond(dot(dx, dx),
+                                      h_bond_params.data[m_bond_data->getTypeByIndex(i)],
+                                      force_divr,
+                                      bond_eng);
+
+                // compute 1/2 of the energy and virial for each particle in the bond
+                Scalar bond_virial[6];
+                Scalar force_div2r = Scalar(0.5) * force_divr;
+                bond_virial[0] = dx.x * dx.x * force_div2r;
+                bond_virial[1] = dx.x * dx.y * force_div2r;
+                bond_virial[2] = dx.x * dx.z * force_div2r;
+                bond_virial[3] = dx.y * dx.y * force_div2r;
+                bond_virial[4] = dx.y * dx.z * force_div2r;
+                bond_virial[5] = dx.z * dx.z * force_div2r;
+
+                Scalar3 f = force_divr * dx;
+                Scalar half_eng = Scalar(0.5) * bond_eng;
+                accumulate(idx_a, -f, half_eng, bond_virial, force, virial, virial_pitch);
+                accumulate(idx_b, f, half_eng, bond_virial, force, virial, virial_pitch);
+                }
+            else if (i < n_bonds + n_angles)
+                {
+                unsigned int angle_idx = i - n_bonds;
+                const AngleData::members_t& angle = m_angle_data->getMembersByIndex(angle_idx);
+                unsigned int idx_a = lookup(angle.tag[0], "angle");
+                unsigned int idx_b = lookup(angle.tag[1], "angle");
+                unsigned int idx_c = lookup(angle.tag[2], "angle");
+
+                Scalar3 pos_a = make_scalar3(h_pos.data[idx_a].x,
+                                             h_pos.data[idx_a].y,
+                                             h_pos.data[idx_a].z);
+                Scalar3 pos_b = make_scalar3(h_pos.data[idx_b].x,
+                                             h_pos.data[idx_b].y,
+                                             h_pos.data[idx_b].z);
+                Scalar3 pos_c = make_scalar3(h_pos.data[idx_c].x,
+                                             h_pos.data[idx_c].y,
+                                             h_pos.data[idx_c].z);
+                Scalar3 dab = box.minImage(pos_a - pos_b);
+                Scalar3 dcb = box.minImage(pos_c - pos_b);
+
+                Scalar3 fab, fcb;
+                Scalar angle_eng;
+                evalFusedHarmonicAngle(dab,
+                                       dcb,
+                                       h_angle_params.data[m_angle_data->getTypeByIndex(angle_idx)],
+                                       fab,
+                                       fcb,
+                                       angle_eng);
+
+                // compute 1/3 of the energy and virial for each particle in the angle
+                Scalar angle_virial[6];
+                angle_virial[0] = Scalar(1. / 3.) * (dab.x * fab.x + dcb.x * fcb.x);
+                angle_virial[1] = Scalar(1. / 3.) * (dab.y * fab.x + dcb.y * fcb.x);
+                angle_virial[2] = Scalar(1. / 3.) * (dab.z * fab.x + dcb.z * fcb.x);
+                angle_virial[3] = Scalar(1. / 3.) * (dab.y * fab.y + dcb.y * fcb.y);
+                angle_virial[4] = Scalar(1. / 3.) * (dab.z * fab.y + dcb.z * fcb.y);
+                angle_virial[5] = Scalar(1. / 3.) * (dab.z * fab.z + dcb.z * fcb.z);
+
+                Scalar third_eng = angle_eng * Scalar(1. / 3.);
+                accumulate(idx_a, fab, third_eng, angle_virial, force, virial, virial_pitch);
+                accumulate(idx_b,
+                           -(fab + fcb),
+                           third_eng,
+                           angle_virial,
+                           force,
+                           virial,
+                           virial_pitch);
+                accumulate(idx_c, fcb, third_eng, angle_virial, force, virial, virial_pitch);
+                }
+            else
+                {
+                unsigned int dihedral_idx = i - n_bonds - n_angles;
+                const DihedralData::members_t& dihedral
+                    = m_dihedral_data->getMembersByIndex(dihedral_idx);
+                unsigned int idx_a = lookup(dihedral.tag[0], "dihedral");
+                unsigned int idx_b = lookup(dihedral.tag[1], "dihedral");
+                unsigned int idx_c = lookup(dihedral.tag[2], "dihedral");
+                unsigned int idx_d = lookup(dihedral.tag[3], "dihedral");
+
+                Scalar3 pos_a = make_scalar3(h_pos.data[idx_a].x,
+                                             h_pos.data[idx_a].y,
+                                             h_pos.data[idx_a].z);
+                Scalar3 pos_b = make_scalar3(h_pos.data[idx_b].x,
+                                             h_pos.data[idx_b].y,
+                                             h_pos.data[idx_b].z);
+                Scalar3 pos_c = make_scalar3(h_pos.data[idx_c].x,
+                                             h_pos.data[idx_c].y,
+                                             h_pos.data[idx_c].z);
+                Scalar3 pos_d = make_scalar3(h_pos.data[idx_d].x,
+                                             h_pos.data[idx_d].y,
+                                             h_pos.data[idx_d].z);
+                Scalar3 vb1 = box.minImage(pos_a - pos_b);
+                Scalar3 vb2 = box.minImage(pos_c - pos_b);
+                Scalar3 vb3 = box.minImage(pos_d - pos_c);
+
+                Scalar3 f1, f2, f3, f4;
+                Scalar dihedral_eng;
+                unsigned int dihedral_type = m_dihedral_data->getTypeByIndex(dihedral_idx);
+                evalFusedOPLSDihedral(vb1,
+                                      vb2,
+                                      vb3,
+                                      h_dihedral_params.data[dihedral_type],
+                                      f1,
+                                      f2,
+                                      f3,
+                                      f4,
+                                      dihedral_eng);
+
+                // compute 1/4 of the energy and virial for each particle in the dihedral
+                Scalar dihedral_virial[6];
+                dihedral_virial[0] = 0.25 * (vb1.x * f1.x + vb2.x * f3.x + (vb3.x + vb2.x) * f4.x);
+                dihedral_virial[1] = 0.25 * (vb1.y * f1.x + vb2.y * f3.x + (vb3.y + vb2.y) * f4.x);
+                dihedral_virial[2] = 0.25 * (vb1.z * f1.x + vb2.z * f3.x + (vb3.z + vb2.z) * f4.x);
+                dihedral_virial[3] = 0.25 * (vb1.y * f1.y + vb2.y * f3.y + (vb3.y + vb2.y) * f4.y);
+                dihedral_virial[4] = 0.25 * (vb1.z * f1.y + vb2.z * f3.y + (vb3.z + vb2.z) * f4.y);
+                dihedral_virial[5] = 0.25 * (vb1.z * f1.z + vb2.z * f3.z + (vb3.z + vb2.z) * f4.z);
+
+                Scalar quarter_eng = Scalar(0.25) * dihedral_eng;
+                accumulate(idx_a, f1, quarter_eng, dihedral_virial, force, virial, virial_pitch);
+                accumulate(idx_b, f2, quarter_eng, dihedral_virial, force, virial, virial_pitch);
+                accumulate(idx_c, f3, quarter_eng, dihedral_virial, force, virial, virial_pitch);
+                accumulate(idx_d, f4, quarter_eng, dihedral_virial, force, virial, virial_pitch);
+                }
+            }
+    };
+    scatterForces(0,
+                  n_bonds + n_angles + n_dihedrals,
+                  true,
+                  h_force.data,
+                  h_virial.data,
+                  compute_groups);
+
+    if (m_prof)
+        m_prof->pop();
+    }
+
+void export_FusedBondedForceCompute(py::module& m)
+    {
+    py::class_<FusedBondedForceCompute, ForceCompute, std::shared_ptr<FusedBondedForceCompute>>(
+        m,
+        "FusedBondedForceCompute")
+        .def(py::init<std::shared_ptr<SystemDefinition>>())
+        .def("setBondParams", &FusedBondedForceCompute::setBondParams)
+        .def("getBondParams", &FusedBondedForceCompute::getBondParams)
+        .def("setAngleParams", &FusedBondedForceCompute::setAngleParams)
+        .def("getAngleParams", &FusedBondedForceCompute::getAngleParams)
+        .def("setDihedralParams", &FusedBondedForceCompute::setDihedralParams)
+        .def("getDihedralParams", &FusedBondedForceCompute::getDihedralParams);
+    }
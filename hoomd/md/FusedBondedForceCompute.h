@@ -0,0 +1,92 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "hoomd/BondedGroupData.h"
+#include "hoomd/ForceCompute.h"
+#include "hoomd/GPUArray.h"
+
+#include <memory>
+
+/*! \file FusedBondedForceCompute.h
+    \brief Declares a class for computing harmonic bonds, harmonic angles, and OPLS dihedrals
+   together
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include <pybind11/pybind11.h>
+
+#ifndef __FUSEDBONDEDFORCECOMPUTE_H__
+#define __FUSEDBONDEDFORCECOMPUTE_H__
+
+//! Computes the bonded force field of a polymer in a single pass
+/*! FusedBondedForceCompute evaluates harmonic bonds, harmonic angles, and OPLS dihedrals and sums
+    them into one force array. The result is identical to the sum of PotentialBondHarmonic,
+    HarmonicAngleForceCompute, and OPLSDihedralForceCompute, but the particle positions are read
+    once per particle for all three terms and a single force and virial array is written. This
+    pays off on the GPU, where the three separate computes each launch a kernel that re-reads the
+    positions and each contribute a separate array to the net force.
+
+    Any of the three group types may be empty.
+
+    \ingroup computes
+*/
+class PYBIND11_EXPORT FusedBondedForceCompute : public ForceCompute
+    {
+    public:
+    //! Constructs the compute
+    FusedBondedForceCompute(std::shared_ptr<SystemDefinition> sysdef);
+
+    //! Destructor
+    virtual ~FusedBondedForceCompute();
+
+    //! Set the harmonic bond parameters for a bond type
+    void setBondParams(std::string type, pybind11::dict params);
+
+    //! Get the harmonic bond parameters for a bond type
+    pybind11::dict getBondParams(std::string type);
+
+    //! Set the harmonic angle parameters for an angle type
+    void setAngleParams(std::string type, pybind11::dict params);
+
+    //! Get the harmonic angle parameters for an angle type
+    pybind11::dict getAngleParams(std::string type);
+
+    //! Set the OPLS dihedral parameters for a dihedral type
+    void setDihedralParams(std::string type, pybind11::dict params);
+
+    //! Get the OPLS dihedral parameters for a dihedral type
+    pybind11::dict getDihedralParams(std::string type);
+
+#ifdef ENABLE_MPI
+    //! Get ghost particle fields requested by this compute
+    /*! \param timestep Current time step
+     */
+    virtual CommFlags getRequestedCommFlags(uint64_t timestep)
+        {
+        CommFlags flags = CommFlags(0);
+        flags[comm_flag::tag] = 1;
+        flags |= ForceCompute::getRequestedCommFlags(timestep);
+        return flags;
+        }
+#endif
+
+    protected:
+    std::shared_ptr<BondData> m_bond_data;         //!< Bonds to compute forces on
+    std::shared_ptr<AngleData> m_angle_data;       //!< Angles to compute forces on
+    std::shared_ptr<DihedralData> m_dihedral_data; //!< Dihedrals to compute forces on
+
+    GPUArray<Scalar2> m_bond_params;     //!< Bond parameters (k, r_0) per bond type
+    GPUArray<Scalar2> m_angle_params;    //!< Angle parameters (k, t_0) per angle type
+    GPUArray<Scalar4> m_dihedral_params; //!< Dihedral parameters (k1/2 .. k4/2) per type
+
+    //! Actually compute the forces
+    virtual void computeForces(uint64_t timestep);
+    };
+
+//! Exports the FusedBondedForceCompute class to python
+void export_FusedBondedForceCompute(pybind11::module& m);
+
+#endif
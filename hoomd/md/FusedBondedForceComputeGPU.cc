@@ -0,0 +1,123 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file FusedBondedForceComputeGPU.cc
+    \brief Defines FusedBondedForceComputeGPU
+*/
+
+#include "FusedBondedForceComputeGPU.h"
+
+namespace py = pybind11;
+
+using namespace std;
+
+/*! \param sysdef System to compute bonded forces on
+ */
+FusedBondedForceComputeGPU::FusedBondedForceComputeGPU(std::shared_ptr<SystemDefinition> sysdef)
+    : FusedBondedForceCompute(sysdef)
+    {
+    // can't run on the GPU if there aren't any GPUs in the execution configuration
+    if (!m_exec_conf->isCUDAEnabled())
+        {
+        m_exec_conf->msg->error()
+            << "Creating a FusedBondedForceComputeGPU with no GPU in execution configuration"
+            << endl;
+        throw std::runtime_error("Error initializing FusedBondedForceComputeGPU");
+        }
+
+    unsigned int warp_size = m_exec_conf->dev_prop.warpSize;
+    m_tuner.reset(
+        new Autotuner(warp_size, 1024, warp_size, 5, 100000, "fused_bonded", this->m_exec_conf));
+    }
+
+/*! Internal method for computing the forces on the GPU.
+    \post The force data on the GPU is written with the calculated forces
+
+    \param timestep Current time step of the simulation
+
+    Calls gpu_compute_fused_bonded_forces to do the dirty work.
+*/
+void FusedBondedForceComputeGPU::computeForces(uint64_t timestep)
+    {
+    // start the profile
+    if (m_prof)
+        m_prof->push(m_exec_conf, "Fused bonded");
+
+    ArrayHandle<BondData::members_t> d_gpu_bond_list(m_bond_data->getGPUTable(),
+                                                     access_location::device,
+                                                     access_mode::read);
+    ArrayHandle<unsigned int> d_n_bonds(m_bond_data->getNGroupsArray(),
+                                        access_location::device,
+                                        access_mode::read);
+
+    ArrayHandle<AngleData::members_t> d_gpu_angle_list(m_angle_data->getGPUTable(),
+                                                       access_location::device,
+                                                       access_mode::read);
+    ArrayHandle<unsigned int> d_angles_ABC(m_angle_data->getGPUPosTable(),
+                                           access_location::device,
+                                           access_mode::read);
+    ArrayHandle<unsigned int> d_n_angles(m_angle_data->getNGroupsArray(),
+                                         access_location::device,
+                                         access_mode::read);
+
+    ArrayHandle<DihedralData::members_t> d_gpu_dihedral_list(m_dihedral_data->getGPUTable(),
+                                                             access_location::device,
+                                                             access_mode::read);
+    ArrayHandle<unsigned int> d_dihedrals_ABCD(m_dihedral_data->getGPUPosTable(),
+                                               access_location::device,
+                                               access_mode::read);
+    ArrayHandle<unsigned int> d_n_dihedrals(m_dihedral_data->getNGroupsArray(),
+                                            access_location::device,
+                                            access_mode::read);
+
+    ArrayHandle<Scalar4> d_pos(m_pdata->getPositions(), access_location::device, access_mode::read);
+    BoxDim box = m_pdata->getGlobalBox();
+
+    ArrayHandle<Scalar4> d_force(m_force, access_location::device, access_mode::overwrite);
+    ArrayHandle<Scalar> d_virial(m_virial, access_location::device, access_mode::overwrite);
+
+    ArrayHandle<Scalar2> d_bond_params(m_bond_params, access_location::device, access_mode::read);
+    ArrayHandle<Scalar2> d_angle_params(m_angle_params, access_location::device, access_mode::read);
+    ArrayHandle<Scalar4> d_dihedral_params(m_dihedral_params,
+                                           access_location::device,
+                                           access_mode::read);
+
+    this->m_tuner->begin();
+    gpu_compute_fused_bonded_forces(d_force.data,
+                                    d_virial.data,
+                                    m_virial.getPitch(),
+                                    m_pdata->getFlags()[pdata_flag::pressure_tensor],
+                                    m_pdata->getN(),
+                                    d_pos.data,
+                                    box,
+                                    d_gpu_bond_list.data,
+                                    m_bond_data->getGPUTableIndexer().getW(),
+                                    d_n_bonds.data,
+                                    d_bond_params.data,
+                                    d_gpu_angle_list.data,
+                                    d_angles_ABC.data,
+                                    m_angle_data->getGPUTableIndexer().getW(),
+                                    d_n_angles.data,
+                                    d_angle_params.data,
+                                    d_gpu_dihedral_list.data,
+                                    d_dihedrals_ABCD.data,
+                                    m_dihedral_data->getGPUTableIndexer().getW(),
+                                    d_n_dihedrals.data,
+                                    d_dihedral_params.data,
+                                    this->m_tuner->getParam(),
+                                    m_exec_conf->dev_prop.warpSize);
+    if (m_exec_conf->isCUDAErrorCheckingEnabled())
+        CHECK_CUDA_ERROR();
+    this->m_tuner->end();
+
+    if (m_prof)
+        m_prof->pop(m_exec_conf);
+    }
+
+void export_FusedBondedForceComputeGPU(py::module& m)
+    {
+    py::class_<FusedBondedForceComputeGPU,
+               FusedBondedForceCompute,
+               std::shared_ptr<FusedBondedForceComputeGPU>>(m, "FusedBondedForceComputeGPU")
+        .def(py::init<std::shared_ptr<SystemDefinition>>());
+    }
@@ -0,0 +1,55 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "FusedBondedForceCompute.h"
+#include "FusedBondedForceGPU.cuh"
+#include "hoomd/Autotuner.h"
+
+/*! \file FusedBondedForceComputeGPU.h
+    \brief Declares the FusedBondedForceComputeGPU class
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include <pybind11/pybind11.h>
+
+#ifndef __FUSEDBONDEDFORCECOMPUTEGPU_H__
+#define __FUSEDBONDEDFORCECOMPUTEGPU_H__
+
+//! Computes harmonic bonds, harmonic angles, and OPLS dihedrals on the GPU
+/*! One kernel loops over the bond, angle, and dihedral tables of each particle. The GPU kernel
+    can be found in FusedBondedForceGPU.cu
+    \ingroup computes
+*/
+class PYBIND11_EXPORT FusedBondedForceComputeGPU : public FusedBondedForceCompute
+    {
+    public:
+    //! Constructs the compute
+    FusedBondedForceComputeGPU(std::shared_ptr<SystemDefinition> sysdef);
+
+    //! Destructor
+    virtual ~FusedBondedForceComputeGPU() { }
+
+    //! Set autotuner parameters
+    /*! \param enable Enable/disable autotuning
+        \param period period (approximate) in time steps when returning occurs
+    */
+    virtual void setAutotunerParams(bool enable, unsigned int period)
+        {
+        FusedBondedForceCompute::setAutotunerParams(enable, period);
+        m_tuner->setPeriod(period);
+        m_tuner->setEnabled(enable);
+        }
+
+    private:
+    std::unique_ptr<Autotuner> m_tuner; //!< Autotuner for block size
+
+    virtual void computeForces(uint64_t timestep);
+    };
+
+//! Exports the FusedBondedForceComputeGPU class to python
+void export_FusedBondedForceComputeGPU(pybind11::module& m);
+
+#endif
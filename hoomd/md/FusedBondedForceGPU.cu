@@ -0,0 +1,363 @@
+#include "hip/hip_runtime.h"
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "EvaluatorFusedBonded.h"
+#include "FusedBondedForceGPU.cuh"
+#include "hoomd/TextureTools.h"
+
+#include <assert.h>
+
+/*! \file FusedBondedForceGPU.cu
+    \brief Defines GPU kernel code for calculating harmonic bond, harmonic angle, and OPLS
+   dihedral forces in one kernel. Used by FusedBondedForceComputeGPU.
+*/
+
+//! Load the position of a particle through the read-only data cache
+__device__ inline Scalar3 fused_bonded_load_pos(const Scalar4* d_pos, unsigned int idx)
+    {
+    Scalar4 postype = __ldg(d_pos + idx);
+    return make_scalar3(postype.x, postype.y, postype.z);
+    }
+
+//! Kernel for calculating the bonded forces on the GPU
+/*! \param d_force Device memory to write computed forces
+    \param d_virial Device memory to write computed virials
+    \param virial_pitch pitch of 2D virial array
+    \param compute_virial Whether to write the virials
+    \param N number of particles
+    \param d_pos particle positions on the device
+    \param box Box dimensions for periodic boundary condition handling
+    \param d_bond_table Bond table of the local particles
+    \param bond_pitch Pitch of the 2D bond table
+    \param d_n_bonds Number of bonds per particle
+    \param d_bond_params Bond parameters (k, r_0) per type
+    \param d_angle_table Angle table of the local particles
+    \param d_angle_pos Position of the particle in each angle
+    \param angle_pitch Pitch of the 2D angle tables
+    \param d_n_angles Number of angles per particle
+    \param d_angle_params Angle parameters (k, t_0) per type
+    \param d_dihedral_table Dihedral table of the local particles
+    \param d_dihedral_pos Position of the particle in each dihedral
+    \param dihedral_pitch Pitch of the 2D dihedral tables
+    \param d_n_dihedrals Number of dihedrals per particle
+    \param d_dihedral_params Dihedral parameters (k1/2 .. k4/2) per type
+
+    One thread computes the net bonded force on one particle. The thread keeps the particle
+    position in a register for all three group types and writes the force and virial once.
+*/
+__global__ void gpu_compute_fused_bonded_forces_kernel(Scalar4* d_force,
+                                                       Scalar* d_virial,
+                                                       const size_t virial_pitch,
+                                                       const bool compute_virial,
+                                                       const unsigned int N,
+                                                       const Scalar4* d_pos,
+                                                       BoxDim box,
+                                                       const group_storage<2>* d_bond_table,
+                                                       const unsigned int bond_pitch,
+                                                       const unsigned int* d_n_bonds,
+                                                       const Scalar2* d_bond_params,
+                                                       const group_storage<3>* d_angle_table,
+                                                       const unsigned int* d_angle_pos,
+                                                       const unsigned int angle_pitch,
+                                                       const unsigned int* d_n_angles,
+                                                       const Scalar2* d_angle_params,
+                                                       const group_storage<4>* d_dihedral_table,
+                                                       const unsigned int* d_dihedral_pos,
+                                                       const unsigned int dihedral_pitch,
+                                                       const unsigned int* d_n_dihedrals,
+                                                       const Scalar4* d_dihedral_params)
+    {
+    // start by identifying which particle we are to handle
+    unsigned int idx = blockIdx.x * blockDim.x + threadIdx.x;
+
+    if (idx >= N)
+        return;
+
+    Scalar3 pos_idx = fused_bonded_load_pos(d_pos, idx);
+
+    Scalar4 force_idx = make_scalar4(Scalar(0.0), Scalar(0.0), Scalar(0.0), Scalar(0.0));
+    Scalar virial_idx[6];
+    for (unsigned int i = 0; i < 6; i++)
+        virial_idx[i] = Scalar(0.0);
+
+    // harmonic bonds
+    unsigned int n_bonds = d_n_bonds[idx];
+    for (unsigned int bond_idx = 0; bond_idx < n_bonds; bond_idx++)
+        {
+        group_storage<2> cur_bond = d_bond_table[bond_pitch * bond_idx + idx];
+        Scalar3 pos_other = fused_bonded_load_pos(d_pos, cur_bond.idx[0]);
+
+        // the force on either particle points along the vector from the other particle
+        Scalar3 dx = box.minImage(pos_idx - pos_other);
+
+        Scalar force_divr, bond_eng;
+        evalFusedHarmonicBond(dot(dx, dx),
+                              __ldg(d_bond_params + cur_bond.idx[1]),
+                              force_divr,
+                              bond_eng);
+
+        Scalar force_div2r = Scalar(0.5) * force_divr;
+        virial_idx[0] += dx.x * dx.x * force_div2r;
+        virial_idx[1] += dx.x * dx.y * force_div2r;
+        virial_idx[2] += dx.x * dx.z * force_div2r;
+        virial_idx[3] += dx.y * dx.y * force_div2r;
+        virial_idx[4] += dx.y * dx.z * force_div2r;
+        virial_idx[5] += dx.z * dx.z * force_div2r;
+
+        force_idx.x += force_divr * dx.x;
+        force_idx.y += force_divr * dx.y;
+        force_idx.z += force_divr * dx.z;
+        force_idx.w += Scalar(0.5) * bond_eng;
+        }
+
+    // harmonic angles
+    unsigned int n_angles = d_n_angles[idx];
+    for (unsigned int angle_idx = 0; angle_idx < n_angles; angle_idx++)
+        {
+        group_storage<3> cur_angle = d_angle_table[angle_pitch * angle_idx + idx];
+        unsigned int cur_angle_abc = d_angle_pos[angle_pitch * angle_idx + idx];
+
+        Scalar3 x_pos = fused_bonded_load_pos(d_pos, cur_angle.idx[0]);
+        Scalar3 y_pos = fused_bonded_load_pos(d_pos, cur_angle.idx[1]);
+
+        Scalar3 pos_a, pos_b, pos_c;
+        if (cur_angle_abc == 0)
+            {
+            pos_a = pos_idx;
+            pos_b = x_pos;
+            pos_c = y_pos;
+            }
+        else if (cur_angle_abc == 1)
+            {
+            pos_a = x_pos;
+            pos_b = pos_idx;
+            pos_c = y_pos;
+            }
+        else
+            {
+            pos_a = x_pos;
+            pos_b = y_pos;
+            pos_c = pos_idx;
+            }
+
+        Scalar3 dab = box.minImage(pos_a - pos_b);
+        Scalar3 dcb = box.minImage(pos_c - pos_b);
+
+        Scalar3 fab, fcb;
+        Scalar angle_eng;
+        evalFusedHarmonicAngle(dab,
+                               dcb,
+                               __ldg(d_angle_params + cur_angle.idx[2]),
+                               fab,
+                               fcb,
+                               angle_eng);
+
+        virial_idx[0] += Scalar(1. / 3.) * (dab.x * fab.x + dcb.x * fcb.x);
+        virial_idx[1] += Scalar(1. / 3.) * (dab.y * fab.x + dcb.y * fcb.x);
+        virial_idx[2] += Scalar(1. / 3.) * (dab.z * fab.x + dcb.z * fcb.x);
+        virial_idx[3] += Scalar(1. / 3.) * (dab.y * fab.y + dcb.y * fcb.y);
+        virial_idx[4] += Scalar(1. / 3.) * (dab.z * fab.y + dcb.z * fcb.y);
+        virial_idx[5] += Scalar(1. / 3.) * (dab.z * fab.z + dcb.z * fcb.z);
+
+        Scalar3 f;
+        if (cur_angle_abc == 0)
+            f = fab;
+        else if (cur_angle_abc == 1)
+            f = -(fab + fcb);
+        else
+            f = fcb;
+
+        force_idx.x += f.x;
+        force_idx.y += f.y;
+        force_idx.z += f.z;
+        force_idx.w += angle_eng * Scalar(1. / 3.);
+        }
+
+    // OPLS dihedrals
+    unsigned int n_dihedrals = d_n_dihedrals[idx];
+    for (unsigned int dihedral_idx = 0; dihedral_idx < n_dihedrals; dihedral_idx++)
+        {
+        group_storage<4> cur_dihedral = d_dihedral_table[dihedral_pitch * dihedral_idx + idx];
+        unsigned int cur_dihedral_abcd = d_dihedral_pos[dihedral_pitch * dihedral_idx + idx];
+
+        Scalar3 x_pos = fused_bonded_load_pos(d_pos, cur_dihedral.idx[0]);
+        Scalar3 y_pos = fused_bonded_load_pos(d_pos, cur_dihedral.idx[1]);
+        Scalar3 z_pos = fused_bonded_load_pos(d_pos, cur_dihedral.idx[2]);
+
+        Scalar3 pos_a, pos_b, pos_c, pos_d;
+        if (cur_dihedral_abcd == 0)
+            {
+            pos_a = pos_idx;
+            pos_b = x_pos;
+            pos_c = y_pos;
+            pos_d = z_pos;
+            }
+        else if (cur_dihedral_abcd == 1)
+            {
+            pos_a = x_pos;
+            pos_b = pos_idx;
+            pos_c = y_pos;
+            pos_d = z_pos;
+            }
+        else if (cur_dihedral_abcd == 2)
+            {
+            pos_a = x_pos;
+            pos_b = y_pos;
+            pos_c = pos_idx;
+            pos_d = z_pos;
+            }
+        else
+            {
+            pos_a = x_pos;
+            pos_b = y_pos;
+            pos_c = z_pos;
+            pos_d = pos_idx;
+            }
+
+        Scalar3 vb1 = box.minImage(pos_a - pos_b);
+        Scalar3 vb2 = box.minImage(pos_c - pos_b);
+        Scalar3 vb3 = box.minImage(pos_d - pos_c);
+
+        Scalar3 f1, f2, f3, f4;
+        Scalar dihedral_eng;
+        evalFusedOPLSDihedral(vb1,
+                              vb2,
+                              vb3,
+                              __ldg(d_dihedral_params + cur_dihedral.idx[3]),
+                              f1,
+                              f2,
+                              f3,
+                              f4,
+                              dihedral_eng);
+
+        virial_idx[0] += Scalar(0.25) * (vb1.x * f1.x + vb2.x * f3.x + (vb3.x + vb2.x) * f4.x);
+        virial_idx[1] += Scalar(0.25) * (vb1.y * f1.x + vb2.y * f3.x + (vb3.y + vb2.y) * f4.x);
+        virial_idx[2] += Scalar(0.25) * (vb1.z * f1.x + vb2.z * f3.x + (vb3.z + vb2.z) * f4.x);
+        virial_idx[3] += Scalar(0.25) * (vb1.y * f1.y + vb2.y * f3.y + (vb3.y + vb2.y) * f4.y);
+        virial_idx[4] += Scalar(0.25) * (vb1.z * f1.y + vb2.z * f3.y + (vb3.z + vb2.z) * f4.y);
+        virial_idx[5] += Scalar(0.25) * (vb1.z * f1.z + vb2.z * f3.z + (vb3.z + vb2.z) * f4.z);
+
+        Scalar3 f;
+        if (cur_dihedral_abcd == 0)
+            f = f1;
+        else if (cur_dihedral_abcd == 1)
+            f = f2;
+        else if (cur_dihedral_abcd == 2)
+            f = f3;
+        else
+            f = f4;
+
+        force_idx.x += f.x;
+        force_idx.y += f.y;
+        force_idx.z += f.z;
+        force_idx.w += Scalar(0.25) * dihedral_eng;
+        }
+
+    // write out the result once for all three group types
+    d_force[idx] = force_idx;
+    if (compute_virial)
+        {
+        for (unsigned int k = 0; k < 6; k++)
+            d_virial[k * virial_pitch + idx] = virial_idx[k];
+        }
+    }
+
+/*! \param d_force Device memory to write computed forces
+    \param d_virial Device memory to write computed virials
+    \param virial_pitch pitch of 2D virial array
+    \param compute_virial Whether to write the virials
+    \param N number of particles
+    \param d_pos particle positions on the device
+    \param box Box dimensions for periodic boundary condition handling
+    \param d_bond_table Bond table of the local particles
+    \param bond_pitch Pitch of the 2D bond table
+    \param d_n_bonds Number of bonds per particle
+    \param d_bond_params Bond parameters (k, r_0) per type
+    \param d_angle_table Angle table of the local particles
+    \param d_angle_pos Position of the particle in each angle
+    \param angle_pitch Pitch of the 2D angle tables
+    \param d_n_angles Number of angles per particle
+    \param d_angle_params Angle parameters (k, t_0) per type
+    \param d_dihedral_table Dihedral table of the local particles
+    \param d_dihedral_pos Position of the particle in each dihedral
+    \param dihedral_pitch Pitch of the 2D dihedral tables
+    \param d_n_dihedrals Number of dihedrals per particle
+    \param d_dihedral_params Dihedral parameters (k1/2 .. k4/2) per type
+    \param block_size Block size to use when performing calculations
+    \param warp_size Warp size of the device
+
+    \returns Any error code resulting from the kernel launch
+    \note Always returns hipSuccess in release builds to avoid the hipDeviceSynchronize()
+*/
+hipError_t gpu_compute_fused_bonded_forces(Scalar4* d_force,
+                                           Scalar* d_virial,
+                                           const size_t virial_pitch,
+                                           const bool compute_virial,
+                                           const unsigned int N,
+                                           const Scalar4* d_pos,
+                                           const BoxDim& box,
+                                           const group_storage<2>* d_bond_table,
+                                           const unsigned int bond_pitch,
+                                           const unsigned int* d_n_bonds,
+                                           const Scalar2* d_bond_params,
+                                           const group_storage<3>* d_angle_table,
+                                           const unsigned int* d_angle_pos,
+                                           const unsigned int angle_pitch,
+                                           const unsigned int* d_n_angles,
+                                           const Scalar2* d_angle_params,
+                                           const group_storage<4>* d_dihedral_table,
+                                           const unsigned int* d_dihedral_pos,
+                                           const unsigned int dihedral_pitch,
+                                           const unsigned int* d_n_dihedrals,
+                                           const Scalar4* d_dihedral_params,
+                                           const unsigned int block_size,
+                                           const unsigned int warp_size)
+    {
+    static unsigned int max_block_size = UINT_MAX;
+    if (max_block_size == UINT_MAX)
+        {
+        hipFuncAttributes attr;
+        hipFuncGetAttributes(&attr, (const void*)gpu_compute_fused_bonded_forces_kernel);
+        max_block_size = attr.maxThreadsPerBlock;
+        if (max_block_size % warp_size)
+            // handle non-sensical return values from hipFuncGetAttributes
+            max_block_size = (max_block_size / warp_size - 1) * warp_size;
+        }
+
+    unsigned int run_block_size = min(block_size, max_block_size);
+
+    // setup the grid to run the kernel
+    dim3 grid(N / run_block_size + 1, 1, 1);
+    dim3 threads(run_block_size, 1, 1);
+
+    // run the kernel
+    hipLaunchKernelGGL((gpu_compute_fused_bonded_forces_kernel),
+                       dim3(grid),
+                       dim3(threads),
+                       0,
+                       0,
+                       d_force,
+                       d_virial,
+                       virial_pitch,
+                       compute_virial,
+                       N,
+                       d_pos,
+                       box,
+                       d_bond_table,
+                       bond_pitch,
+                       d_n_bonds,
+                       d_bond_params,
+                       d_angle_table,
+                       d_angle_pos,
+                       angle_pitch,
+                       d_n_angles,
+                       d_angle_params,
+                       d_dihedral_table,
+                       d_dihedral_pos,
+                       dihedral_pitch,
+                       d_n_dihedrals,
+                       d_dihedral_params);
+
+    return hipSuccess;
+    }
@@ -0,0 +1,41 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "hoomd/BondedGroupData.cuh"
+#include "hoomd/HOOMDMath.h"
+#include "hoomd/ParticleData.cuh"
+
+/*! \file FusedBondedForceGPU.cuh
+    \brief Declares GPU kernel code for calculating harmonic bond, harmonic angle, and OPLS
+   dihedral forces in one kernel. Used by FusedBondedForceComputeGPU.
+*/
+
+#ifndef __FUSEDBONDEDFORCEGPU_CUH__
+#define __FUSEDBONDEDFORCEGPU_CUH__
+
+//! Kernel driver that computes the bonded forces for FusedBondedForceComputeGPU
+hipError_t gpu_compute_fused_bonded_forces(Scalar4* d_force,
+                                           Scalar* d_virial,
+                                           const size_t virial_pitch,
+                                           const bool compute_virial,
+                                           const unsigned int N,
+                                           const Scalar4* d_pos,
+                                           const BoxDim& box,
+                                           const group_storage<2>* d_bond_table,
+                                           const unsigned int bond_pitch,
+                                           const unsigned int* d_n_bonds,
+                                           const Scalar2* d_bond_params,
+                                           const group_storage<3>* d_angle_table,
+                                           const unsigned int* d_angle_pos,
+                                           const unsigned int angle_pitch,
+                                           const unsigned int* d_n_angles,
+                                           const Scalar2* d_angle_params,
+                                           const group_storage<4>* d_dihedral_table,
+                                           const unsigned int* d_dihedral_pos,
+                                           const unsigned int dihedral_pitch,
+                                           const unsigned int* d_n_dihedrals,
+                                           const Scalar4* d_dihedral_params,
+                                           const unsigned int block_size,
+                                           const unsigned int warp_size);
+
+#endif
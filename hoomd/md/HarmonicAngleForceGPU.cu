@@ -21,6 +21,7 @@
 /*! \param d_force Device memory to write computed forces
     \param d_virial Device memory to write computed virials
     \param virial_pitch Pitch of 2D virial array
+    \param compute_virial Whether to write the virials
     \param N number of particles
     \param d_pos device array of particle positions
     \param d_params Parameters for the angle force
@@ -33,6 +34,7 @@ extern "C" __global__ void
 gpu_compute_harmonic_angle_forces_kernel(Scalar4* d_force,
                                          Scalar* d_virial,
                                          const size_t virial_pitch,
+                                         const bool compute_virial,
                                          const unsigned int N,
                                          const Scalar4* d_pos,
                                          const Scalar2* d_params,
@@ -192,13 +194,17 @@ gpu_compute_harmonic_angle_forces_kernel(Scalar4* d_force,
 
     // now that the force calculation is complete, write out the result (MEM TRANSFER: 20 bytes)
     d_force[idx] = force_idx;
-    for (int i = 0; i < 6; i++)
-        d_virial[i * virial_pitch + idx] = virial[i];
+    if (compute_virial)
+        {
+        for (int i = 0; i < 6; i++)
+            d_virial[i * virial_pitch + idx] = virial[i];
+        }
     }
 
 /*! \param d_force Device memory to write computed forces
     \param d_virial Device memory to write computed virials
     \param virial_pitch pitch of 2D virial array
+    \param compute_virial Whether to write the virials
     \param N number of particles
     \param d_pos device array of particle positions
     \param box Box dimensions (in GPU format) to use for periodic boundary conditions
@@ -219,6 +225,7 @@ gpu_compute_harmonic_angle_forces_kernel(Scalar4* d_force,
 hipError_t gpu_compute_harmonic_angle_forces(Scalar4* d_force,
                                              Scalar* d_virial,
                                              const size_t virial_pitch,
+                                             const bool compute_virial,
                                              const unsigned int N,
                                              const Scalar4* d_pos,
                                              const BoxDim& box,
@@ -255,6 +262,7 @@ hipError_t gpu_compute_harmonic_angle_forces(Scalar4* d_force,
                        d_force,
                        d_virial,
                        virial_pitch,
+                       compute_virial,
                        N,
                        d_pos,
                        d_params,
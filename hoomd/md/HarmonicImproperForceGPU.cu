@@ -21,6 +21,7 @@
 /*! \param d_force Device memory to write computed forces
     \param d_virial Device memory to write computed virials
     \param virial_pitch pitch of 2D virial
+    \param compute_virial Whether to write the virials
     \param N number of particles
     \param d_pos Device memory of particle positions
     \param d_params Force field parameters
@@ -34,6 +35,7 @@ extern "C" __global__ void
 gpu_compute_harmonic_improper_forces_kernel(Scalar4* d_force,
                                             Scalar* d_virial,
                                             const size_t virial_pitch,
+                                            const bool compute_virial,
                                             unsigned int N,
                                             const Scalar4* d_pos,
                                             const Scalar2* d_params,
@@ -254,13 +256,17 @@ gpu_compute_harmonic_improper_forces_kernel(Scalar4* d_force,
 
     // now that the force calculation is complete, write out the result (MEM TRANSFER: 20 bytes)
     d_force[idx] = force_idx;
-    for (int k = 0; k < 6; k++)
-        d_virial[k * virial_pitch + idx] = virial_idx[k];
+    if (compute_virial)
+        {
+        for (int k = 0; k < 6; k++)
+            d_virial[k * virial_pitch + idx] = virial_idx[k];
+        }
     }
 
 /*! \param d_force Device memory to write computed forces
     \param d_virial Device memory to write computed virials
     \param virial_pitch pitch of 2D virial array
+    \param compute_virial Whether to write the virials
     \param N number of particles
     \param d_pos particle positions on the device
     \param box Box dimensions (in GPU format) to use for periodic boundary conditions
@@ -282,6 +288,7 @@ gpu_compute_harmonic_improper_forces_kernel(Scalar4* d_force,
 hipError_t gpu_compute_harmonic_improper_forces(Scalar4* d_force,
                                                 Scalar* d_virial,
                                                 const size_t virial_pitch,
+                                                const bool compute_virial,
                                                 const unsigned int N,
                                                 const Scalar4* d_pos,
                                                 const BoxDim& box,
@@ -325,6 +332,7 @@ hipError_t gpu_compute_harmonic_improper_forces(Scalar4* d_force,
                        d_force,
                        d_virial,
                        virial_pitch,
+                       compute_virial,
                        N,
                        d_pos,
                        d_params,
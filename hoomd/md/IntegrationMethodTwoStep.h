@@ -9,6 +9,16 @@
 
 #include <memory>
 
+#ifdef ENABLE_HIP
+#include "TwoStepFusedGPU.cuh"
+#endif
+
+#ifdef ENABLE_TBB
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/parallel_reduce.h>
+#endif
+
 #ifndef __INTEGRATION_METHOD_TWO_STEP_H__
 #define __INTEGRATION_METHOD_TWO_STEP_H__
 
@@ -212,6 +222,23 @@ class PYBIND11_EXPORT IntegrationMethodTwoStep
         return true;
         }
 
+#ifdef ENABLE_HIP
+    //! Describe this method to the fused integration kernels
+    /*! \param timestep Current time step
+        \param params Output: parameters of the method
+        \param gamma Output: per-type drag coefficients (one value per particle type)
+        \returns true when IntegratorTwoStep may integrate the group with gpu_fused_step_one() and
+                 gpu_fused_step_two() instead of calling integrateStepOne() and integrateStepTwo()
+
+        Methods that are not implemented by the fused kernels, or whose current settings are not,
+        return false.
+    */
+    virtual bool getFusedParams(uint64_t timestep, fused_method_params& params, Scalar* gamma)
+        {
+        return false;
+        }
+#endif
+
     protected:
     const std::shared_ptr<SystemDefinition>
         m_sysdef; //!< The system definition this method is associated with
@@ -225,6 +252,76 @@ class PYBIND11_EXPORT IntegrationMethodTwoStep
 
     Scalar m_deltaT; //!< The time step
 
+    //! Apply a function to every particle in the group
+    /*! \param body Function called as body(j) with the particle index j of every member
+
+        When HOOMD is built with TBB, the members are split among the threads of the task arena.
+        \a body may only write to the data of particle j.
+    */
+    template<class Body> void forEachMember(const Body& body)
+        {
+        const unsigned int group_size = m_group->getNumMembers();
+        ArrayHandle<unsigned int> h_index(m_group->getIndexArray(),
+                                          access_location::host,
+                                          access_mode::read);
+        const unsigned int* index = h_index.data;
+
+#ifdef ENABLE_TBB
+        m_exec_conf->getTaskArena()->execute(
+            [&]
+            {
+                tbb::parallel_for(tbb::blocked_range<unsigned int>(0, group_size),
+                                  [&](const tbb::blocked_range<unsigned int>& r)
+                                  {
+                                      for (unsigned int group_idx = r.begin(); group_idx != r.end();
+                                           ++group_idx)
+                                          body(index[group_idx]);
+                                  });
+            });
+#else
+        for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
+            body(index[group_idx]);
+#endif
+        }
+
+    //! Sum a function over every particle in the group
+    /*! \param body Function called as body(j) with the particle index j of every member, returns
+        the value to sum
+
+        Like forEachMember(), but sums the values returned by \a body. The members are partitioned
+        the same way for any number of threads, so the sum is reproducible.
+    */
+    template<class Body> Scalar sumOverMembers(const Body& body)
+        {
+        const unsigned int group_size = m_group->getNumMembers();
+        ArrayHandle<unsigned int> h_index(m_group->getIndexArray(),
+                                          access_location::host,
+                                          access_mode::read);
+        const unsigned int* index = h_index.data;
+
+#ifdef ENABLE_TBB
+        return m_exec_conf->getTaskArena()->execute(
+            [&]
+            {
+                return tbb::parallel_deterministic_reduce(
+                    tbb::blocked_range<unsigned int>(0, group_size, 1024),
+                    Scalar(0.0),
+                    [&](const tbb::blocked_range<unsigned int>& r, Scalar sum)
+                    {
+                        for (unsigned int group_idx = r.begin(); group_idx != r.end(); ++group_idx)
+                            sum += body(index[group_idx]);
+                        return sum;
+                    },
+                    [](Scalar a, Scalar b) { return a + b; });
+            });
+#else
+        Scalar sum(0.0);
+        for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
+            sum += body(index[group_idx]);
+        return sum;
+#endif
+        }
+
     //! helper function to get the integrator variables from the particle data
     const IntegratorVariables& getIntegratorVariables()
         {
@@ -3,12 +3,17 @@
 
 #include "IntegratorTwoStep.h"
 
+#ifdef ENABLE_HIP
+#include "TwoStepFusedGPU.cuh"
+#endif
+
 namespace py = pybind11;
 
 #ifdef ENABLE_MPI
 #include "hoomd/Communicator.h"
 #endif
 
+#include <algorithm>
 #include <pybind11/stl_bind.h>
 PYBIND11_MAKE_OPAQUE(std::vector<std::shared_ptr<IntegrationMethodTwoStep>>);
 
@@ -18,6 +23,27 @@ IntegratorTwoStep::IntegratorTwoStep(std::shared_ptr<SystemDefinition> sysdef, S
     : Integrator(sysdef, deltaT), m_prepared(false), m_gave_warning(false), m_aniso_mode(Automatic)
     {
     m_exec_conf->msg->notice(5) << "Constructing IntegratorTwoStep" << endl;
+
+#ifdef ENABLE_HIP
+    if (m_exec_conf->isCUDAEnabled())
+        {
+        hipDeviceProp_t dev_prop = m_exec_conf->dev_prop;
+        m_tuner_fused_one.reset(new Autotuner(dev_prop.warpSize,
+                                              dev_prop.maxThreadsPerBlock,
+                                              dev_prop.warpSize,
+                                              5,
+                                              100000,
+                                              "fused_step_one",
+                                              this->m_exec_conf));
+        m_tuner_fused_two.reset(new Autotuner(dev_prop.warpSize,
+                                              dev_prop.maxThreadsPerBlock,
+                                              dev_prop.warpSize,
+                                              5,
+                                              100000,
+                                              "fused_step_two",
+                                              this->m_exec_conf));
+        }
+#endif
     }
 
 IntegratorTwoStep::~IntegratorTwoStep()
@@ -67,15 +93,28 @@ void IntegratorTwoStep::update(uint64_t timestep)
     if (m_prof)
         m_prof->push("Integrate");
 
+#ifdef ENABLE_HIP
+    prepareFusedMethods(timestep);
+#endif
+
     // perform the first step of the integration on all groups
-    for (auto& method : m_methods)
+    for (unsigned int i = 0; i < m_methods.size(); i++)
         {
         // deltaT should probably be passed as an argument, but that would require modifying many
         // files. Work around this by calling setDeltaT every timestep.
-        method->setDeltaT(m_deltaT);
-        method->integrateStepOne(timestep);
+        m_methods[i]->setDeltaT(m_deltaT);
+#ifdef ENABLE_HIP
+        if (m_fused[i])
+            continue;
+#endif
+        m_methods[i]->integrateStepOne(timestep);
         }
 
+#ifdef ENABLE_HIP
+    if (m_n_fused > 0)
+        fusedStepOne(timestep);
+#endif
+
     if (m_prof)
         m_prof->pop();
 
@@ -114,12 +153,21 @@ void IntegratorTwoStep::update(uint64_t timestep)
         m_prof->push("Integrate");
 
     // perform the second step of the integration on all groups
-    for (auto& method : m_methods)
+    for (unsigned int i = 0; i < m_methods.size(); i++)
         {
-        method->integrateStepTwo(timestep);
-        method->includeRATTLEForce(timestep + 1);
+#ifdef ENABLE_HIP
+        if (m_fused[i])
+            continue;
+#endif
+        m_methods[i]->integrateStepTwo(timestep);
+        m_methods[i]->includeRATTLEForce(timestep + 1);
         }
 
+#ifdef ENABLE_HIP
+    if (m_n_fused > 0)
+        fusedStepTwo(timestep);
+#endif
+
     /* NOTE: For composite particles, it is assumed that positions and orientations are not updated
        in the second step.
 
@@ -420,8 +468,291 @@ void IntegratorTwoStep::setAutotunerParams(bool enable, unsigned int period)
     // set params in all methods
     for (auto& method : m_methods)
         method->setAutotunerParams(enable, period);
+
+#ifdef ENABLE_HIP
+    if (m_tuner_fused_one)
+        {
+        m_tuner_fused_one->setPeriod(period);
+        m_tuner_fused_one->setEnabled(enable);
+        m_tuner_fused_two->setPeriod(period);
+        m_tuner_fused_two->setEnabled(enable);
+        }
+#endif
     }
 
+#ifdef ENABLE_HIP
+/*! \param timestep Current time step
+
+    Asks every method for its fused parameters and sets m_fused and m_n_fused. Fusion requires at
+    least two compatible methods: a single method is integrated faster by its own kernels, which
+    only visit the members of its group. The parameters are copied to the device only when they
+    change.
+*/
+void IntegratorTwoStep::prepareFusedMethods(uint64_t timestep)
+    {
+    m_fused.assign(m_methods.size(), false);
+    m_n_fused = 0;
+
+    if (!m_exec_conf->isCUDAEnabled() || m_methods.size() < 2)
+        return;
+
+    const unsigned int n_types = m_pdata->getNTypes();
+    std::vector<fused_method_params> params(m_methods.size(), fused_method_params());
+    std::vector<Scalar> gamma(m_methods.size() * n_types, Scalar(0.0));
+    std::vector<unsigned int> fused_index(m_methods.size(), FUSED_METHOD_NONE);
+
+    unsigned int n_fused = 0;
+    for (unsigned int i = 0; i < m_methods.size(); i++)
+        {
+        if (m_methods[i]->getFusedParams(timestep, params[n_fused], &gamma[n_fused * n_types]))
+            {
+            fused_index[i] = n_fused;
+            n_fused++;
+            }
+        }
+
+    if (n_fused < 2 || !buildFusedMethodTags(fused_index))
+        return;
+
+    params.resize(n_fused);
+    gamma.resize(n_fused * n_types);
+
+    auto equal = [](const fused_method_params& a, const fused_method_params& b)
+    {
+        return a.kind == b.kind && a.T == b.T && a.alpha == b.alpha && a.limit_val == b.limit_val
+               && a.use_alpha == b.use_alpha && a.noiseless_t == b.noiseless_t
+               && a.limit == b.limit && a.zero_force == b.zero_force;
+    };
+
+    if (params.size() != m_fused_params_host.size()
+        || !std::equal(params.begin(), params.end(), m_fused_params_host.begin(), equal))
+        {
+        if (m_fused_params.getNumElements() < n_fused)
+            {
+            GlobalArray<fused_method_params> fused_params(n_fused, m_exec_conf);
+            m_fused_params.swap(fused_params);
+            TAG_ALLOCATION(m_fused_params);
+            }
+
+        ArrayHandle<fused_method_params> h_params(m_fused_params,
+                                                  access_location::host,
+                                                  access_mode::overwrite);
+        std::copy(params.begin(), params.end(), h_params.data);
+        m_fused_params_host = params;
+        }
+
+    if (gamma != m_fused_gamma_host)
+        {
+        if (m_fused_gamma.getNumElements() < gamma.size())
+            {
+            GlobalArray<Scalar> fused_gamma(gamma.size(), m_exec_conf);
+            m_fused_gamma.swap(fused_gamma);
+            TAG_ALLOCATION(m_fused_gamma);
+            }
+
+        ArrayHandle<Scalar> h_gamma(m_fused_gamma, access_location::host, access_mode::overwrite);
+        std::copy(gamma.begin(), gamma.end(), h_gamma.data);
+        m_fused_gamma_host = gamma;
+        }
+
+    for (unsigned int i = 0; i < m_methods.size(); i++)
+        m_fused[i] = fused_index[i] != FUSED_METHOD_NONE;
+    m_n_fused = n_fused;
+    }
+
+/*! \param fused_index Index of each method in the fused parameters, or FUSED_METHOD_NONE
+    \returns true when the groups of the methods do not overlap
+
+    The table is indexed by tag, so particle sorts and domain decomposition migrations leave it
+    valid. It is rebuilt only when a method, its fused index, or the member tags of its group
+    change. The groups of all methods are checked for overlap, including those that are not fused,
+    because the fused kernels change the order in which the methods are applied.
+*/
+bool IntegratorTwoStep::buildFusedMethodTags(const std::vector<unsigned int>& fused_index)
+    {
+    std::vector<std::tuple<IntegrationMethodTwoStep*, unsigned int, unsigned int>> key;
+    for (unsigned int i = 0; i < m_methods.size(); i++)
+        {
+        key.push_back(std::make_tuple(m_methods[i].get(),
+                                      m_methods[i]->getGroup()->getMemberTagsRevision(),
+                                      fused_index[i]));
+        }
+
+    const unsigned int n_tags = (unsigned int)m_pdata->getRTags().size();
+    if (key == m_fused_key && m_fused_method_by_tag.getNumElements() >= n_tags)
+        return !m_fused_overlap;
+
+    m_exec_conf->msg->notice(7) << "IntegratorTwoStep: rebuilding fused method tags" << endl;
+
+    m_fused_key = key;
+    m_fused_overlap = false;
+
+    if (m_fused_method_by_tag.getNumElements() < n_tags)
+        {
+        GlobalArray<unsigned int> method_by_tag(n_tags, m_exec_conf);
+        m_fused_method_by_tag.swap(method_by_tag);
+        TAG_ALLOCATION(m_fused_method_by_tag);
+        }
+
+    // record the method of each tag, then translate to fused indices
+    std::vector<unsigned int> owner(n_tags, FUSED_METHOD_NONE);
+    for (unsigned int i = 0; i < m_methods.size(); i++)
+        {
+        std::shared_ptr<ParticleGroup> group = m_methods[i]->getGroup();
+        ArrayHandle<unsigned int> h_member_tags(group->getMemberTagArray(),
+                                                access_location::host,
+                                                access_mode::read);
+        for (unsigned int j = 0; j < group->getNumMembersGlobal(); j++)
+            {
+            unsigned int tag = h_member_tags.data[j];
+            assert(tag < n_tags);
+            if (owner[tag] != FUSED_METHOD_NONE)
+                m_fused_overlap = true;
+            owner[tag] = i;
+            }
+        }
+
+    ArrayHandle<unsigned int> h_method_by_tag(m_fused_method_by_tag,
+                                              access_location::host,
+                                              access_mode::overwrite);
+    for (unsigned int tag = 0; tag < n_tags; tag++)
+        {
+        h_method_by_tag.data[tag]
+            = owner[tag] == FUSED_METHOD_NONE ? FUSED_METHOD_NONE : fused_index[owner[tag]];
+        }
+
+    if (m_fused_overlap)
+        {
+        m_exec_conf->msg->notice(4) << "IntegratorTwoStep: integration method groups overlap, "
+                                       "not fusing the integration kernels"
+                                    << endl;
+        }
+
+    return !m_fused_overlap;
+    }
+
+/*! \param timestep Current time step
+ */
+void IntegratorTwoStep::fusedStepOne(uint64_t timestep)
+    {
+    if (m_prof)
+        m_prof->push(m_exec_conf, "Fused step 1");
+
+    ArrayHandle<Scalar4> d_pos(m_pdata->getPositions(),
+                               access_location::device,
+                               access_mode::readwrite);
+    ArrayHandle<Scalar4> d_vel(m_pdata->getVelocities(),
+                               access_location::device,
+                               access_mode::readwrite);
+    ArrayHandle<Scalar3> d_accel(m_pdata->getAccelerations(),
+                                 access_location::device,
+                                 access_mode::read);
+    ArrayHandle<int3> d_image(m_pdata->getImages(),
+                              access_location::device,
+                              access_mode::readwrite);
+    ArrayHandle<Scalar4> d_net_force(m_pdata->getNetForce(),
+                                     access_location::device,
+                                     access_mode::read);
+    ArrayHandle<Scalar> d_diameter(m_pdata->getDiameters(),
+                                   access_location::device,
+                                   access_mode::read);
+    ArrayHandle<unsigned int> d_tag(m_pdata->getTags(), access_location::device, access_mode::read);
+    ArrayHandle<unsigned int> d_method_by_tag(m_fused_method_by_tag,
+                                              access_location::device,
+                                              access_mode::read);
+    ArrayHandle<fused_method_params> d_params(m_fused_params,
+                                              access_location::device,
+                                              access_mode::read);
+    ArrayHandle<Scalar> d_gamma(m_fused_gamma, access_location::device, access_mode::read);
+
+    m_exec_conf->beginMultiGPU();
+    m_tuner_fused_one->begin();
+    gpu_fused_step_one(d_pos.data,
+                       d_vel.data,
+                       d_accel.data,
+                       d_image.data,
+                       d_net_force.data,
+                       d_diameter.data,
+                       d_tag.data,
+                       d_method_by_tag.data,
+                       d_params.data,
+                       d_gamma.data,
+                       m_pdata->getNTypes(),
+                       m_pdata->getGPUPartition(),
+                       m_pdata->getBox(),
+                       m_deltaT,
+                       timestep,
+                       m_sysdef->getSeed(),
+                       m_sysdef->getNDimensions(),
+                       m_tuner_fused_one->getParam());
+
+    if (m_exec_conf->isCUDAErrorCheckingEnabled())
+        CHECK_CUDA_ERROR();
+    m_tuner_fused_one->end();
+    m_exec_conf->endMultiGPU();
+
+    if (m_prof)
+        m_prof->pop(m_exec_conf);
+    }
+
+/*! \param timestep Current time step
+ */
+void IntegratorTwoStep::fusedStepTwo(uint64_t timestep)
+    {
+    if (m_prof)
+        m_prof->push(m_exec_conf, "Fused step 2");
+
+    ArrayHandle<Scalar4> d_pos(m_pdata->getPositions(), access_location::device, access_mode::read);
+    ArrayHandle<Scalar4> d_vel(m_pdata->getVelocities(),
+                               access_location::device,
+                               access_mode::readwrite);
+    ArrayHandle<Scalar3> d_accel(m_pdata->getAccelerations(),
+                                 access_location::device,
+                                 access_mode::readwrite);
+    ArrayHandle<Scalar4> d_net_force(m_pdata->getNetForce(),
+                                     access_location::device,
+                                     access_mode::read);
+    ArrayHandle<Scalar> d_diameter(m_pdata->getDiameters(),
+                                   access_location::device,
+                                   access_mode::read);
+    ArrayHandle<unsigned int> d_tag(m_pdata->getTags(), access_location::device, access_mode::read);
+    ArrayHandle<unsigned int> d_method_by_tag(m_fused_method_by_tag,
+                                              access_location::device,
+                                              access_mode::read);
+    ArrayHandle<fused_method_params> d_params(m_fused_params,
+                                              access_location::device,
+                                              access_mode::read);
+    ArrayHandle<Scalar> d_gamma(m_fused_gamma, access_location::device, access_mode::read);
+
+    m_exec_conf->beginMultiGPU();
+    m_tuner_fused_two->begin();
+    gpu_fused_step_two(d_pos.data,
+                       d_vel.data,
+                       d_accel.data,
+                       d_net_force.data,
+                       d_diameter.data,
+                       d_tag.data,
+                       d_method_by_tag.data,
+                       d_params.data,
+                       d_gamma.data,
+                       m_pdata->getNTypes(),
+                       m_pdata->getGPUPartition(),
+                       m_deltaT,
+                       timestep,
+                       m_sysdef->getSeed(),
+                       m_sysdef->getNDimensions(),
+                       m_tuner_fused_two->getParam());
+
+    if (m_exec_conf->isCUDAErrorCheckingEnabled())
+        CHECK_CUDA_ERROR();
+    m_tuner_fused_two->end();
+    m_exec_conf->endMultiGPU();
+
+    if (m_prof)
+        m_prof->pop(m_exec_conf);
+    }
+#endif
+
 /// helper function to compute net force/virial
 void IntegratorTwoStep::computeNetForce(uint64_t timestep)
     {
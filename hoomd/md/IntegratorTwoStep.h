@@ -6,6 +6,10 @@
 
 #include "ForceComposite.h"
 
+#ifdef ENABLE_HIP
+#include "hoomd/Autotuner.h"
+#endif
+
 #pragma once
 
 #ifdef __HIPCC__
@@ -13,6 +17,7 @@
 #endif
 
 #include <pybind11/pybind11.h>
+#include <tuple>
 
 /// Integrates the system forward one step with possibly multiple methods
 /** See IntegrationMethodTwoStep for most of the design notes regarding group integration.
@@ -29,6 +34,12 @@
    steps one and two, and which can use the updated particle positions and velocities to update any
    slaved degrees of freedom (rigid bodies).
 
+    On the GPU, when two or more methods report parameters through
+   IntegrationMethodTwoStep::getFusedParams() and no two groups share a particle, IntegratorTwoStep
+   integrates all of them in a single kernel launch per half step. The kernels look up the method
+   of each particle by its tag, so the lookup table only changes when the methods or the member
+   tags of their groups change.
+
     \ingroup updaters
 */
 class PYBIND11_EXPORT IntegratorTwoStep : public Integrator
@@ -131,6 +142,53 @@ class PYBIND11_EXPORT IntegratorTwoStep : public Integrator
     /// Helper method to test if all added methods have valid restart information
     bool isValidRestart();
 
+#ifdef ENABLE_HIP
+    /// Select the methods to integrate with the fused kernels
+    void prepareFusedMethods(uint64_t timestep);
+
+    /// Build the per-tag method index used by the fused kernels
+    bool buildFusedMethodTags(const std::vector<unsigned int>& fused_index);
+
+    /// Take the first step of all fused methods
+    void fusedStepOne(uint64_t timestep);
+
+    /// Take the second step of all fused methods
+    void fusedStepTwo(uint64_t timestep);
+
+    /// True for each method in m_methods that is integrated by the fused kernels
+    std::vector<bool> m_fused;
+
+    /// Number of fused methods in the current step
+    unsigned int m_n_fused = 0;
+
+    /// Method, group revision, and fused index for each method when m_fused_method_by_tag was built
+    std::vector<std::tuple<IntegrationMethodTwoStep*, unsigned int, unsigned int>> m_fused_key;
+
+    /// True when the groups of the methods in m_fused_key overlap
+    bool m_fused_overlap = false;
+
+    /// Index of the fused method of each particle tag, or FUSED_METHOD_NONE
+    GlobalArray<unsigned int> m_fused_method_by_tag;
+
+    /// Parameters of the fused methods
+    GlobalArray<fused_method_params> m_fused_params;
+
+    /// Per-type gammas of the fused methods
+    GlobalArray<Scalar> m_fused_gamma;
+
+    /// Host copy of the parameters last written to m_fused_params and m_fused_gamma
+    std::vector<fused_method_params> m_fused_params_host;
+
+    /// Host copy of the gammas last written to m_fused_gamma
+    std::vector<Scalar> m_fused_gamma_host;
+
+    /// Autotuner for the block size of the fused first step
+    std::unique_ptr<Autotuner> m_tuner_fused_one;
+
+    /// Autotuner for the block size of the fused second step
+    std::unique_ptr<Autotuner> m_tuner_fused_two;
+#endif
+
     std::vector<std::shared_ptr<IntegrationMethodTwoStep>>
         m_methods; //!< List of all the integration methods
 
@@ -0,0 +1,107 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "LocalFFT.h"
+
+#include <stdexcept>
+
+/*! \file LocalFFT.cc
+    \brief Defines the LocalFFT class
+*/
+
+#ifdef ENABLE_FFTW
+static_assert(sizeof(kiss_fft_cpx) == sizeof(fftwf_complex),
+              "kiss_fft_cpx must be layout compatible with fftwf_complex");
+
+//! Initialize the FFTW thread support once per process
+static void initFFTWThreads()
+    {
+    static bool initialized = false;
+    if (!initialized)
+        {
+        if (!fftwf_init_threads())
+            throw std::runtime_error("Error initializing FFTW threads");
+        initialized = true;
+        }
+    }
+#endif
+
+LocalFFT::LocalFFT(const int dims[3], unsigned int num_threads)
+    {
+#ifdef ENABLE_FFTW
+    initFFTWThreads();
+    fftwf_plan_with_nthreads(num_threads > 0 ? int(num_threads) : 1);
+
+    // FFTW_ESTIMATE does not access the arrays during planning, and FFTW_UNALIGNED allows the
+    // plans to be executed on any array with the new-array execute interface. Plan with distinct
+    // placeholder arrays so that the plans are out of place.
+    fftwf_complex* in = fftwf_alloc_complex(1);
+    fftwf_complex* out = fftwf_alloc_complex(1);
+    m_plan_forward = fftwf_plan_dft_3d(dims[0],
+                                       dims[1],
+                                       dims[2],
+                                       in,
+                                       out,
+                                       FFTW_FORWARD,
+                                       FFTW_ESTIMATE | FFTW_UNALIGNED);
+    m_plan_inverse = fftwf_plan_dft_3d(dims[0],
+                                       dims[1],
+                                       dims[2],
+                                       in,
+                                       out,
+                                       FFTW_BACKWARD,
+                                       FFTW_ESTIMATE | FFTW_UNALIGNED);
+    fftwf_free(in);
+    fftwf_free(out);
+
+    if (!m_plan_forward || !m_plan_inverse)
+        throw std::runtime_error("Error creating FFTW plans");
+#else
+    m_cfg_forward = kiss_fftnd_alloc(dims, 3, 0, NULL, NULL);
+    m_cfg_inverse = kiss_fftnd_alloc(dims, 3, 1, NULL, NULL);
+#endif
+    }
+
+LocalFFT::~LocalFFT()
+    {
+#ifdef ENABLE_FFTW
+    fftwf_destroy_plan(m_plan_forward);
+    fftwf_destroy_plan(m_plan_inverse);
+#else
+    kiss_fft_free(m_cfg_forward);
+    kiss_fft_free(m_cfg_inverse);
+    kiss_fft_cleanup();
+#endif
+    }
+
+void LocalFFT::forward(const kiss_fft_cpx* in, kiss_fft_cpx* out)
+    {
+#ifdef ENABLE_FFTW
+    // out of place complex transforms preserve their input
+    fftwf_execute_dft(m_plan_forward,
+                      reinterpret_cast<fftwf_complex*>(const_cast<kiss_fft_cpx*>(in)),
+                      reinterpret_cast<fftwf_complex*>(out));
+#else
+    kiss_fftnd(m_cfg_forward, in, out);
+#endif
+    }
+
+void LocalFFT::inverse(const kiss_fft_cpx* in, kiss_fft_cpx* out)
+    {
+#ifdef ENABLE_FFTW
+    fftwf_execute_dft(m_plan_inverse,
+                      reinterpret_cast<fftwf_complex*>(const_cast<kiss_fft_cpx*>(in)),
+                      reinterpret_cast<fftwf_complex*>(out));
+#else
+    kiss_fftnd(m_cfg_inverse, in, out);
+#endif
+    }
+
+std::string LocalFFT::getBackend()
+    {
+#ifdef ENABLE_FFTW
+    return "FFTW";
+#else
+    return "kiss_fft";
+#endif
+    }
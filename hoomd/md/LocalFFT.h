@@ -0,0 +1,62 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#ifndef __LOCAL_FFT_H__
+#define __LOCAL_FFT_H__
+
+#include "hoomd/extern/kiss_fftnd.h"
+
+#ifdef ENABLE_FFTW
+#include <fftw3.h>
+#endif
+
+#include <pybind11/pybind11.h>
+#include <string>
+
+/*! \file LocalFFT.h
+    \brief Declares the LocalFFT class
+*/
+
+//! Complex to complex 3D FFT on a single rank
+/*! The backend is chosen at configure time. With ENABLE_FFTW, the transforms are performed by
+    (threaded) single precision FFTW3, or by any library that provides the FFTW3 interface, such as
+    MKL. Otherwise kiss_fft is used.
+
+    Both directions are unnormalized and operate out of place on row major data, with the first
+    dimension varying slowest. The forward transform uses the exp(-i k x) sign convention.
+*/
+class PYBIND11_EXPORT LocalFFT
+    {
+    public:
+    //! Constructor
+    /*! \param dims Dimensions of the grid, slowest varying first
+        \param num_threads Number of threads to use in the transforms
+    */
+    LocalFFT(const int dims[3], unsigned int num_threads);
+
+    //! Destructor
+    ~LocalFFT();
+
+    LocalFFT(const LocalFFT&) = delete;
+    LocalFFT& operator=(const LocalFFT&) = delete;
+
+    //! Perform a forward transform
+    void forward(const kiss_fft_cpx* in, kiss_fft_cpx* out);
+
+    //! Perform an inverse transform
+    void inverse(const kiss_fft_cpx* in, kiss_fft_cpx* out);
+
+    //! Get the name of the backend
+    static std::string getBackend();
+
+    private:
+#ifdef ENABLE_FFTW
+    fftwf_plan m_plan_forward; //!< FFTW plan for the forward transform
+    fftwf_plan m_plan_inverse; //!< FFTW plan for the inverse transform
+#else
+    kiss_fftnd_cfg m_cfg_forward; //!< kiss_fft configuration for the forward transform
+    kiss_fftnd_cfg m_cfg_inverse; //!< kiss_fft configuration for the inverse transform
+#endif
+    };
+
+#endif // __LOCAL_FFT_H__
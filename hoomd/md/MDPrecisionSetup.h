@@ -0,0 +1,88 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "hoomd/HOOMDMath.h"
+
+/*! \file MDPrecisionSetup.h
+    \brief Setup for md mixed precision
+*/
+
+#ifndef __MD_PRECISION_SETUP_H__
+#define __MD_PRECISION_SETUP_H__
+
+#ifdef SINGLE_PRECISION
+
+// in single precision, ShortReal is always float
+//! Typedef'd real for use in pair and bond evaluators
+typedef float ShortReal;
+
+#else
+
+// in double precision, mixed mode enables floats for ShortReal, otherwise it is double
+#ifdef ENABLE_MD_MIXED_PRECISION
+typedef float ShortReal;
+
+#else
+typedef double ShortReal;
+
+#endif
+
+#endif
+
+//! Transcendental functions for pair evaluators
+/*! When ENABLE_MD_FAST_MATH is set, these evaluate in single precision with the fast:: float
+    overloads, which map to hardware intrinsics on the GPU (see BUILDING.rst for the error bounds).
+    Otherwise they forward to fast:: at the precision of the argument.
+*/
+namespace md_fast
+    {
+//! Compute e^x
+inline HOSTDEVICE float exp(float x)
+    {
+    return fast::exp(x);
+    }
+
+//! Compute e^x
+inline HOSTDEVICE double exp(double x)
+    {
+#ifdef ENABLE_MD_FAST_MATH
+    return double(fast::exp(float(x)));
+#else
+    return fast::exp(x);
+#endif
+    }
+
+//! Compute the square root of x
+inline HOSTDEVICE float sqrt(float x)
+    {
+    return fast::sqrt(x);
+    }
+
+//! Compute the square root of x
+inline HOSTDEVICE double sqrt(double x)
+    {
+#ifdef ENABLE_MD_FAST_MATH
+    return double(fast::sqrt(float(x)));
+#else
+    return fast::sqrt(x);
+#endif
+    }
+
+//! Compute the reciprocal square root of x
+inline HOSTDEVICE float rsqrt(float x)
+    {
+    return fast::rsqrt(x);
+    }
+
+//! Compute the reciprocal square root of x
+inline HOSTDEVICE double rsqrt(double x)
+    {
+#ifdef ENABLE_MD_FAST_MATH
+    return double(fast::rsqrt(float(x)));
+#else
+    return fast::rsqrt(x);
+#endif
+    }
+    } // end namespace md_fast
+
+#endif //__MD_PRECISION_SETUP_H__
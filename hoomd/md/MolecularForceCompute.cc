@@ -12,6 +12,7 @@
 #include "MolecularForceCompute.cuh"
 #endif
 
+#include <algorithm>
 #include <map>
 #include <string.h>
 
@@ -26,7 +27,8 @@ namespace py = pybind11;
 MolecularForceCompute::MolecularForceCompute(std::shared_ptr<SystemDefinition> sysdef)
     : ForceConstraint(sysdef), m_molecule_tag(m_exec_conf), m_n_molecules_global(0),
       m_rebuild_molecules(true), m_molecule_list(m_exec_conf), m_molecule_length(m_exec_conf),
-      m_molecule_order(m_exec_conf), m_molecule_idx(m_exec_conf)
+      m_molecule_order(m_exec_conf), m_molecule_idx(m_exec_conf),
+      m_molecule_table_tags(m_exec_conf)
     {
     // connect to the ParticleData to receive notifications when particles change order in memory
     m_pdata->getParticleSortSignal()
@@ -37,6 +39,7 @@ MolecularForceCompute::MolecularForceCompute(std::shared_ptr<SystemDefinition> s
     TAG_ALLOCATION(m_molecule_length);
     TAG_ALLOCATION(m_molecule_order);
     TAG_ALLOCATION(m_molecule_idx);
+    TAG_ALLOCATION(m_molecule_table_tags);
 
 #ifdef ENABLE_HIP
     if (m_exec_conf->isCUDAEnabled())
@@ -265,12 +268,22 @@ void MolecularForceCompute::initMolecules()
         return;
         }
 
+    // the table only depends on the order of the particles, keep it if that did not change
+    if (isMoleculeTableCurrent())
+        {
+        m_exec_conf->msg->notice(7)
+            << "MolecularForceCompute: particle order unchanged, keeping molecule table"
+            << std::endl;
+        return;
+        }
+
     m_exec_conf->msg->notice(7) << "MolecularForceCompute initializing molecule table" << std::endl;
 
 #ifdef ENABLE_HIP
     if (m_exec_conf->isCUDAEnabled())
         {
         initMoleculesGPU();
+        storeMoleculeTableTags();
         return;
         }
 #endif
@@ -434,6 +447,70 @@ void MolecularForceCompute::initMolecules()
 
     if (m_prof)
         m_prof->pop(m_exec_conf);
+
+    storeMoleculeTableTags();
+    }
+
+bool MolecularForceCompute::isMoleculeTableCurrent()
+    {
+    unsigned int nptl_local = m_pdata->getN() + m_pdata->getNGhosts();
+    if (nptl_local == 0 || m_molecule_table_n != m_pdata->getN()
+        || m_molecule_table_tags.size() != nptl_local)
+        {
+        return false;
+        }
+
+#ifdef ENABLE_HIP
+    if (m_exec_conf->isCUDAEnabled())
+        {
+        ArrayHandle<unsigned int> d_tag(m_pdata->getTags(),
+                                        access_location::device,
+                                        access_mode::read);
+        ArrayHandle<unsigned int> d_table_tags(m_molecule_table_tags,
+                                               access_location::device,
+                                               access_mode::read);
+        return gpu_molecule_table_tags_equal(nptl_local,
+                                             d_tag.data,
+                                             d_table_tags.data,
+                                             m_exec_conf->getCachedAllocator());
+        }
+#endif
+
+    ArrayHandle<unsigned int> h_tag(m_pdata->getTags(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_table_tags(m_molecule_table_tags,
+                                           access_location::host,
+                                           access_mode::read);
+    return std::equal(h_table_tags.data, h_table_tags.data + nptl_local, h_tag.data);
+    }
+
+void MolecularForceCompute::storeMoleculeTableTags()
+    {
+    unsigned int nptl_local = m_pdata->getN() + m_pdata->getNGhosts();
+    m_molecule_table_tags.resize(nptl_local);
+    m_molecule_table_n = m_pdata->getN();
+
+#ifdef ENABLE_HIP
+    if (m_exec_conf->isCUDAEnabled())
+        {
+        ArrayHandle<unsigned int> d_tag(m_pdata->getTags(),
+                                        access_location::device,
+                                        access_mode::read);
+        ArrayHandle<unsigned int> d_table_tags(m_molecule_table_tags,
+                                               access_location::device,
+                                               access_mode::overwrite);
+        hipMemcpy(d_table_tags.data,
+                  d_tag.data,
+                  sizeof(unsigned int) * nptl_local,
+                  hipMemcpyDeviceToDevice);
+        return;
+        }
+#endif
+
+    ArrayHandle<unsigned int> h_tag(m_pdata->getTags(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_table_tags(m_molecule_table_tags,
+                                           access_location::host,
+                                           access_mode::overwrite);
+    std::copy(h_tag.data, h_tag.data + nptl_local, h_table_tags.data);
     }
 
 void export_MolecularForceCompute(py::module& m)
@@ -10,6 +10,7 @@
 #include <thrust/binary_search.h>
 #include <thrust/device_ptr.h>
 #include <thrust/device_vector.h>
+#include <thrust/equal.h>
 #include <thrust/execution_policy.h>
 #include <thrust/extrema.h>
 #include <thrust/gather.h>
@@ -44,7 +45,35 @@
     \brief Contains GPU kernel code used by MolecularForceCompute
 */
 
+//! Compact the per molecule lengths and count the molecules and particles in molecules
+/*! The run of particles without a molecule, if any, is the last one after sorting by molecule tag.
+    Its length is zeroed so that the maximum over all runs is the maximum molecule length.
+*/
+__global__ void gpu_count_molecules_kernel(unsigned int nptl,
+                                           const unsigned int* d_num_runs,
+                                           const unsigned int* d_unique_molecule_tags,
+                                           unsigned int* d_molecule_length,
+                                           unsigned int* d_counts)
+    {
+    unsigned int n_runs = *d_num_runs;
+    unsigned int n_molecules = n_runs;
+    unsigned int n_ptls_in_molecules = nptl;
+
+    if (n_runs > 0 && d_unique_molecule_tags[n_runs - 1] == NO_MOLECULE)
+        {
+        n_molecules--;
+        n_ptls_in_molecules -= d_molecule_length[n_runs - 1];
+        d_molecule_length[n_runs - 1] = 0;
+        }
+
+    d_counts[0] = n_molecules;
+    d_counts[1] = n_ptls_in_molecules;
+    }
+
 //! Sort local molecules and assign local molecule indices to particles
+/*! The numbers of molecules and particles in molecules and the maximum molecule length are
+    reduced on the device and copied to the host in a single transfer.
+*/
 hipError_t gpu_sort_by_molecule(unsigned int nptl,
                                 const unsigned int* d_tag,
                                 const unsigned int* d_molecule_tag,
@@ -75,6 +104,14 @@ hipError_t gpu_sort_by_molecule(unsigned int nptl,
     thrust::device_ptr<unsigned int> idx_sorted_by_tag(d_idx_sorted_by_tag);
     thrust::device_ptr<unsigned int> molecule_length(d_molecule_length);
 
+    if (nptl == 0)
+        {
+        n_local_molecules = 0;
+        max_len = 0;
+        n_local_ptls_in_molecules = 0;
+        return hipSuccess;
+        }
+
     // get temp allocations
     unsigned int* d_molecule_length_tmp = alloc.getTemporaryBuffer<unsigned int>(nptl);
     unsigned int* d_local_unique_molecule_tags_tmp = alloc.getTemporaryBuffer<unsigned int>(nptl);
@@ -157,15 +194,10 @@ hipError_t gpu_sort_by_molecule(unsigned int nptl,
     // release temp buffer
     alloc.deallocate((char*)d_molecule_by_idx);
 
-    // find the end of the molecule list
-    auto end = thrust::lower_bound(local_molecule_tags, local_molecule_tags + nptl, NO_MOLECULE);
-    if (check_cuda)
-        CHECK_CUDA();
-
-    n_local_ptls_in_molecules = (unsigned int)(end - local_molecule_tags);
-
-    // gather unique molecule tags, and reduce their lengths by key
+    // gather unique molecule tags, and reduce their lengths by key. Particles without a molecule
+    // form the last run.
     thrust::constant_iterator<unsigned int> one(1);
+    hipMemsetAsync(d_molecule_length_tmp, 0, sizeof(unsigned int) * nptl);
 
     // determine temporary storage
     d_temp_storage = NULL;
@@ -179,7 +211,7 @@ hipError_t gpu_sort_by_molecule(unsigned int nptl,
                                       d_molecule_length_tmp,
                                       d_num_runs_out,
                                       thrust::plus<unsigned int>(),
-                                      n_local_ptls_in_molecules);
+                                      nptl);
 
     d_temp_storage = alloc.allocate(temp_storage_bytes);
 
@@ -191,14 +223,48 @@ hipError_t gpu_sort_by_molecule(unsigned int nptl,
                                       d_molecule_length_tmp,
                                       d_num_runs_out,
                                       thrust::plus<unsigned int>(),
-                                      n_local_ptls_in_molecules);
+                                      nptl);
+    alloc.deallocate((char*)d_temp_storage);
+
+    // number of molecules, number of particles in molecules, and maximum molecule length
+    unsigned int* d_counts = (unsigned int*)alloc.allocate(3 * sizeof(unsigned int));
+    hipLaunchKernelGGL((gpu_count_molecules_kernel),
+                       dim3(1),
+                       dim3(1),
+                       0,
+                       0,
+                       nptl,
+                       d_num_runs_out,
+                       d_local_unique_molecule_tags_tmp,
+                       d_molecule_length_tmp,
+                       d_counts);
+    alloc.deallocate((char*)d_num_runs_out);
+
+    // the lengths past the last run are zero
+    d_temp_storage = NULL;
+    temp_storage_bytes = 0;
+    hipcub::DeviceReduce::Max(d_temp_storage,
+                              temp_storage_bytes,
+                              d_molecule_length_tmp,
+                              d_counts + 2,
+                              nptl);
+    d_temp_storage = alloc.allocate(temp_storage_bytes);
+    hipcub::DeviceReduce::Max(d_temp_storage,
+                              temp_storage_bytes,
+                              d_molecule_length_tmp,
+                              d_counts + 2,
+                              nptl);
+    alloc.deallocate((char*)d_temp_storage);
 
-    hipMemcpy(&n_local_molecules, d_num_runs_out, sizeof(unsigned int), hipMemcpyDeviceToHost);
+    unsigned int counts[3];
+    hipMemcpy(counts, d_counts, 3 * sizeof(unsigned int), hipMemcpyDeviceToHost);
+    alloc.deallocate((char*)d_counts);
     if (check_cuda)
         CHECK_CUDA();
 
-    alloc.deallocate((char*)d_temp_storage);
-    alloc.deallocate((char*)d_num_runs_out);
+    n_local_molecules = counts[0];
+    n_local_ptls_in_molecules = counts[1];
+    max_len = counts[2];
 
     // find the index of the particle with lowest tag in every molecule
     thrust::device_ptr<unsigned int> lowest_idx_in_molecules(d_lowest_idx_in_molecules);
@@ -223,27 +289,13 @@ hipError_t gpu_sort_by_molecule(unsigned int nptl,
     if (check_cuda)
         CHECK_CUDA();
 
-    // compute maximum molecule length
-    d_temp_storage = NULL;
-    temp_storage_bytes = 0;
-    unsigned int* d_max = (unsigned int*)alloc.allocate(sizeof(unsigned int));
-    hipcub::DeviceReduce::Max(d_temp_storage,
-                              temp_storage_bytes,
-                              d_molecule_length_tmp,
-                              d_max,
-                              n_local_molecules);
-    d_temp_storage = alloc.allocate(temp_storage_bytes);
-    hipcub::DeviceReduce::Max(d_temp_storage,
-                              temp_storage_bytes,
-                              d_molecule_length_tmp,
-                              d_max,
-                              n_local_molecules);
-    alloc.deallocate((char*)d_temp_storage);
-    hipMemcpy(&max_len, d_max, sizeof(unsigned int), hipMemcpyDeviceToHost);
-    alloc.deallocate((char*)d_max);
-
-    if (check_cuda)
-        CHECK_CUDA();
+    // order the molecules by their lowest particle index with a single key-value sort and apply the
+    // permutation to the tags and lengths
+    unsigned int* d_molecule_perm = alloc.getTemporaryBuffer<unsigned int>(n_local_molecules);
+    unsigned int* d_molecule_perm_sort = alloc.getTemporaryBuffer<unsigned int>(n_local_molecules);
+    thrust::device_ptr<unsigned int> molecule_perm(d_molecule_perm);
+    thrust::device_ptr<unsigned int> molecule_perm_sort(d_molecule_perm_sort);
+    thrust::copy(iter, iter + n_local_molecules, molecule_perm);
 
     d_temp_storage = NULL;
     temp_storage_bytes = 0;
@@ -251,8 +303,8 @@ hipError_t gpu_sort_by_molecule(unsigned int nptl,
                                        temp_storage_bytes,
                                        d_lowest_idx,
                                        d_lowest_idx_sort,
-                                       d_local_unique_molecule_tags_tmp,
-                                       d_local_unique_molecule_tags,
+                                       d_molecule_perm,
+                                       d_molecule_perm_sort,
                                        n_local_molecules);
     d_temp_storage = alloc.allocate(temp_storage_bytes);
 
@@ -261,31 +313,25 @@ hipError_t gpu_sort_by_molecule(unsigned int nptl,
                                        temp_storage_bytes,
                                        d_lowest_idx,
                                        d_lowest_idx_sort,
-                                       d_local_unique_molecule_tags_tmp,
-                                       d_local_unique_molecule_tags,
+                                       d_molecule_perm,
+                                       d_molecule_perm_sort,
                                        n_local_molecules);
     alloc.deallocate((char*)d_temp_storage);
 
-    d_temp_storage = NULL;
-    temp_storage_bytes = 0;
-    hipcub::DeviceRadixSort::SortPairs(d_temp_storage,
-                                       temp_storage_bytes,
-                                       d_lowest_idx,
-                                       d_lowest_idx_sort,
-                                       d_molecule_length_tmp,
-                                       d_molecule_length,
-                                       n_local_molecules);
-    d_temp_storage = alloc.allocate(temp_storage_bytes);
+    thrust::device_ptr<unsigned int> molecule_length_tmp(d_molecule_length_tmp);
+    thrust::gather(molecule_perm_sort,
+                   molecule_perm_sort + n_local_molecules,
+                   local_unique_molecule_tags_tmp,
+                   local_unique_molecule_tags);
+    thrust::gather(molecule_perm_sort,
+                   molecule_perm_sort + n_local_molecules,
+                   molecule_length_tmp,
+                   molecule_length);
+    if (check_cuda)
+        CHECK_CUDA();
 
-    // key-value sort
-    hipcub::DeviceRadixSort::SortPairs(d_temp_storage,
-                                       temp_storage_bytes,
-                                       d_lowest_idx,
-                                       d_lowest_idx_sort,
-                                       d_molecule_length_tmp,
-                                       d_molecule_length,
-                                       n_local_molecules);
-    alloc.deallocate((char*)d_temp_storage);
+    alloc.deallocate((char*)d_molecule_perm);
+    alloc.deallocate((char*)d_molecule_perm_sort);
 
     // release temp buffers
     alloc.deallocate((char*)d_molecule_length_tmp);
@@ -365,6 +411,25 @@ hipError_t gpu_sort_by_molecule(unsigned int nptl,
     return hipSuccess;
     }
 
+//! Check whether the particle tags are in the order stored with the molecule table
+bool gpu_molecule_table_tags_equal(unsigned int nptl,
+                                   const unsigned int* d_tag,
+                                   const unsigned int* d_table_tag,
+                                   CachedAllocator& alloc)
+    {
+    thrust::device_ptr<const unsigned int> tag(d_tag);
+    thrust::device_ptr<const unsigned int> table_tag(d_table_tag);
+
+#ifdef __HIP_PLATFORM_HCC__
+    return thrust::equal(thrust::hip::par(alloc),
+#else
+    return thrust::equal(thrust::cuda::par(alloc),
+#endif
+                         tag,
+                         tag + nptl,
+                         table_tag);
+    }
+
 __global__ void gpu_fill_molecule_table_kernel(unsigned int nptl,
                                                Index2D molecule_idx,
                                                const unsigned int* d_molecule_idx,
@@ -38,6 +38,12 @@ gpu_sort_by_molecule(unsigned int nptl,
                      CachedAllocator& alloc,
                      bool check_cuda);
 
+bool __attribute__((visibility("default")))
+gpu_molecule_table_tags_equal(unsigned int nptl,
+                              const unsigned int* d_tag,
+                              const unsigned int* d_table_tag,
+                              CachedAllocator& alloc);
+
 hipError_t __attribute__((visibility("default")))
 gpu_fill_molecule_table(unsigned int nptl,
                         unsigned int n_local_ptls_in_molecules,
@@ -18,7 +18,10 @@
     the particles are sorted according to global particle tag.
 
     The data structures are initialized by calling initMolecules(). This is done in the derived
-   class whenever particles are reordered.
+   class whenever particles are reordered. The table is kept when the local and ghost particles are
+   still in the order it was built for (e.g. after a forced migration at the start of a run that
+   moved no particles). On the GPU, this check and the rebuild run on the device. Derived classes
+   call notifyMoleculeTagsChanged() when they change m_molecule_tag.
 
     Every molecule has a unique contiguous tag, 0 <=tag <m_n_molecules_global.
 
@@ -135,6 +138,13 @@ class PYBIND11_EXPORT MolecularForceCompute : public ForceConstraint
 
     bool m_rebuild_molecules; //!< True if we need to rebuild indices
 
+    //! Rebuild the molecule table on next use, even if the particle order is unchanged
+    void notifyMoleculeTagsChanged()
+        {
+        m_rebuild_molecules = true;
+        m_molecule_table_tags.clear();
+        }
+
     //! Helper function to check if particles have been sorted and rebuild indices if necessary
     virtual void checkParticlesSorted()
         {
@@ -170,6 +180,12 @@ class PYBIND11_EXPORT MolecularForceCompute : public ForceConstraint
         m_tuner_fill; //!< Autotuner for block size for filling the molecule table
 #endif
 
+    /// Tags of the local and ghost particles in index order when the table was last built
+    GlobalVector<unsigned int> m_molecule_table_tags;
+
+    /// Number of local particles when the table was last built
+    unsigned int m_molecule_table_n = 0;
+
     /// Functor for indexing into a 1D array as if it were a 2-D array. Index is
     /// [constituent_number, molecule_number].
     Index2D m_molecule_indexer;
@@ -182,6 +198,12 @@ class PYBIND11_EXPORT MolecularForceCompute : public ForceConstraint
     //! construct a list of local molecules
     virtual void initMolecules();
 
+    //! Check whether the particles are in the order the molecule table was built for
+    bool isMoleculeTableCurrent();
+
+    //! Store the particle order the molecule table was built for
+    void storeMoleculeTableTags();
+
 #ifdef ENABLE_HIP
     //! construct a list of local molecules on the GPU
     virtual void initMoleculesGPU();
@@ -5,6 +5,8 @@
 #include "hoomd/HOOMDMPI.h"
 #include "hoomd/HOOMDMath.h"
 
+#include <algorithm>
+
 namespace py = pybind11;
 using namespace std;
 
@@ -101,12 +103,59 @@ void MuellerPlatheFlow::update(uint64_t timestep)
     // Sign for summed exchanged momentum depends on hierarchy of min and max slab.
     const int sign = this->getMaxSlab() > this->getMinSlab() ? 1 : -1;
 
+    bool domain_decomposition = false;
+#ifdef ENABLE_MPI
+    domain_decomposition = bool(m_pdata->getDomainDecomposition());
+#endif // ENABLE_MPI
+
     unsigned int counter = 0;
     const unsigned int max_iteration = 100;
+    std::vector<Scalar3> max_candidates, min_candidates;
     while (fabs((*m_flow_target)(timestep) - this->getSummedExchangedMomentum() / area)
                > this->getFlowEpsilon()
            && counter < max_iteration)
         {
+        // Find the particles of several iterations in one search and replay the iterations on
+        // them. Each exchange gives the max slab particle the momentum of the min slab particle
+        // and vice versa, so the next iteration would find the next candidate in each slab,
+        // unless an exchanged particle is an extremum again.
+        if (!domain_decomposition
+            && this->searchMinMaxCandidates(max_iteration - counter,
+                                            max_candidates,
+                                            min_candidates))
+            {
+            unsigned int n_pairs = 0;
+            Scalar exchanged_momentum = m_exchanged_momentum;
+            Scalar max_assigned = -INVALID_VEL;
+            Scalar min_assigned = INVALID_VEL;
+            while (n_pairs < max_candidates.size() && n_pairs < min_candidates.size()
+                   && counter + n_pairs < max_iteration
+                   && fabs((*m_flow_target)(timestep) - exchanged_momentum / area)
+                          > this->getFlowEpsilon())
+                {
+                const Scalar3& max_vel = max_candidates[n_pairs];
+                const Scalar3& min_vel = min_candidates[n_pairs];
+                if (!(max_vel.x > max_assigned) || !(min_vel.x < min_assigned))
+                    break;
+
+                exchanged_momentum += sign * (max_vel.x - min_vel.x);
+                max_assigned = std::max(max_assigned, min_vel.x);
+                min_assigned = std::min(min_assigned, max_vel.x);
+                n_pairs++;
+                }
+
+            if (n_pairs > 0)
+                {
+                this->updateMinMaxCandidates(max_candidates, min_candidates, n_pairs);
+                m_last_max_vel = max_candidates[n_pairs - 1];
+                m_last_min_vel = min_candidates[n_pairs - 1];
+                m_exchanged_momentum = exchanged_momentum;
+                counter += n_pairs;
+                continue;
+                }
+            // otherwise, search for the next pair one at a time
+            }
+
         counter++;
 
         m_last_max_vel.x = m_last_max_vel.y = -INVALID_VEL;
@@ -361,6 +410,22 @@ void MuellerPlatheFlow::updateMinMaxVelocity(void)
         m_prof->pop();
     }
 
+/*! \param max_vel Particles in the max slab
+    \param min_vel Particles in the min slab
+    \param n_pairs Number of pairs to exchange
+*/
+void MuellerPlatheFlow::updateMinMaxCandidates(const std::vector<Scalar3>& max_vel,
+                                               const std::vector<Scalar3>& min_vel,
+                                               unsigned int n_pairs)
+    {
+    for (unsigned int i = 0; i < n_pairs; i++)
+        {
+        m_last_max_vel = max_vel[i];
+        m_last_min_vel = min_vel[i];
+        this->updateMinMaxVelocity();
+        }
+    }
+
 void MuellerPlatheFlow::verifyOrthorhombicBox(void)
     {
     bool valid = true;
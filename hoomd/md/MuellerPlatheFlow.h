@@ -12,6 +12,7 @@
 
 #include <cfloat>
 #include <memory>
+#include <vector>
 
 extern const unsigned int INVALID_TAG;
 extern const Scalar INVALID_VEL;
@@ -162,6 +163,27 @@ class PYBIND11_EXPORT MuellerPlatheFlow : public Updater
     virtual void searchMinMaxVelocity(void);
     virtual void updateMinMaxVelocity(void);
 
+    //! Search the particles for several exchanges at once
+    /*! \param max_pairs Maximum number of particles to find in each slab
+        \param max_vel Output: particles in the max slab, in order of decreasing momentum
+        \param min_vel Output: particles in the min slab, in order of increasing momentum
+        \returns false when the implementation only searches for one pair at a time
+
+        The entries have the same layout as m_last_max_vel and m_last_min_vel. Only called
+        without domain decomposition.
+    */
+    virtual bool searchMinMaxCandidates(unsigned int max_pairs,
+                                        std::vector<Scalar3>& max_vel,
+                                        std::vector<Scalar3>& min_vel)
+        {
+        return false;
+        }
+
+    //! Exchange the velocities of the first \a n_pairs particles found by searchMinMaxCandidates()
+    virtual void updateMinMaxCandidates(const std::vector<Scalar3>& max_vel,
+                                        const std::vector<Scalar3>& min_vel,
+                                        unsigned int n_pairs);
+
     //! Temporary variables to store last found min vel info.
     //!
     //! x: velocity y: mass z: tag as scalar.
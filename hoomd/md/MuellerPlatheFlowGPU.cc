@@ -134,6 +134,165 @@ void MuellerPlatheFlowGPU::updateMinMaxVelocity(void)
         m_prof->pop();
     }
 
+/*! \param max_pairs Maximum number of particles to find in each slab
+    \param max_vel Output: particles in the max slab, in order of decreasing momentum
+    \param min_vel Output: particles in the min slab, in order of increasing momentum
+*/
+bool MuellerPlatheFlowGPU::searchMinMaxCandidates(unsigned int max_pairs,
+                                                  std::vector<Scalar3>& max_vel,
+                                                  std::vector<Scalar3>& min_vel)
+    {
+    max_vel.clear();
+    min_vel.clear();
+
+    const unsigned int group_size = m_group->getNumMembers();
+    if (group_size == 0)
+        return true;
+
+    if (m_prof)
+        m_prof->push("MuellerPlatheFlowGPU::search");
+
+    if (m_slab_members.getNumElements() < group_size)
+        {
+        GPUArray<unsigned int> slab_members(group_size, m_exec_conf);
+        m_slab_members.swap(slab_members);
+        GPUArray<Scalar> keys(group_size, m_exec_conf);
+        m_keys.swap(keys);
+        }
+    if (m_max_candidates.getNumElements() < max_pairs)
+        {
+        GPUArray<Scalar3> max_candidates(max_pairs, m_exec_conf);
+        m_max_candidates.swap(max_candidates);
+        GPUArray<Scalar3> min_candidates(max_pairs, m_exec_conf);
+        m_min_candidates.swap(min_candidates);
+        }
+
+    unsigned int n_max = 0, n_min = 0;
+        {
+        const ArrayHandle<Scalar4> d_vel(m_pdata->getVelocities(),
+                                         access_location::device,
+                                         access_mode::read);
+        const ArrayHandle<Scalar4> d_pos(m_pdata->getPositions(),
+                                         access_location::device,
+                                         access_mode::read);
+        const ArrayHandle<unsigned int> d_tag(m_pdata->getTags(),
+                                              access_location::device,
+                                              access_mode::read);
+        const ArrayHandle<unsigned int> d_group_members(m_group->getIndexArray(),
+                                                        access_location::device,
+                                                        access_mode::read);
+        ArrayHandle<unsigned int> d_slab_members(m_slab_members,
+                                                 access_location::device,
+                                                 access_mode::overwrite);
+        ArrayHandle<Scalar> d_keys(m_keys, access_location::device, access_mode::overwrite);
+        ArrayHandle<Scalar3> d_max_candidates(m_max_candidates,
+                                              access_location::device,
+                                              access_mode::overwrite);
+        ArrayHandle<Scalar3> d_min_candidates(m_min_candidates,
+                                              access_location::device,
+                                              access_mode::overwrite);
+
+        const BoxDim& gl_box = m_pdata->getGlobalBox();
+
+        gpu_search_min_max_candidates(group_size,
+                                      d_vel.data,
+                                      d_pos.data,
+                                      d_tag.data,
+                                      d_group_members.data,
+                                      gl_box,
+                                      this->getNSlabs(),
+                                      this->getMaxSlab(),
+                                      true,
+                                      d_slab_members.data,
+                                      d_keys.data,
+                                      d_max_candidates.data,
+                                      max_pairs,
+                                      n_max,
+                                      m_flow_direction,
+                                      m_slab_direction,
+                                      m_exec_conf->getCachedAllocator());
+        if (m_exec_conf->isCUDAErrorCheckingEnabled())
+            CHECK_CUDA_ERROR();
+
+        gpu_search_min_max_candidates(group_size,
+                                      d_vel.data,
+                                      d_pos.data,
+                                      d_tag.data,
+                                      d_group_members.data,
+                                      gl_box,
+                                      this->getNSlabs(),
+                                      this->getMinSlab(),
+                                      false,
+                                      d_slab_members.data,
+                                      d_keys.data,
+                                      d_min_candidates.data,
+                                      max_pairs,
+                                      n_min,
+                                      m_flow_direction,
+                                      m_slab_direction,
+                                      m_exec_conf->getCachedAllocator());
+        if (m_exec_conf->isCUDAErrorCheckingEnabled())
+            CHECK_CUDA_ERROR();
+        }
+
+    // only the candidates come back to the host
+    ArrayHandle<Scalar3> h_max_candidates(m_max_candidates,
+                                          access_location::host,
+                                          access_mode::read);
+    ArrayHandle<Scalar3> h_min_candidates(m_min_candidates,
+                                          access_location::host,
+                                          access_mode::read);
+    max_vel.assign(h_max_candidates.data, h_max_candidates.data + n_max);
+    min_vel.assign(h_min_candidates.data, h_min_candidates.data + n_min);
+
+    if (m_prof)
+        m_prof->pop();
+
+    return true;
+    }
+
+/*! \param max_vel Particles in the max slab
+    \param min_vel Particles in the min slab
+    \param n_pairs Number of pairs to exchange
+
+    Reads the candidates from the device copies left by searchMinMaxCandidates().
+*/
+void MuellerPlatheFlowGPU::updateMinMaxCandidates(const std::vector<Scalar3>& max_vel,
+                                                  const std::vector<Scalar3>& min_vel,
+                                                  unsigned int n_pairs)
+    {
+    if (m_prof)
+        m_prof->push("MuellerPlatheFlowGPU::update");
+
+    const ArrayHandle<unsigned int> d_rtag(m_pdata->getRTags(),
+                                           access_location::device,
+                                           access_mode::read);
+    ArrayHandle<Scalar4> d_vel(m_pdata->getVelocities(),
+                               access_location::device,
+                               access_mode::readwrite);
+    const ArrayHandle<Scalar3> d_max_candidates(m_max_candidates,
+                                                access_location::device,
+                                                access_mode::read);
+    const ArrayHandle<Scalar3> d_min_candidates(m_min_candidates,
+                                                access_location::device,
+                                                access_mode::read);
+    const unsigned int Ntotal = m_pdata->getN() + m_pdata->getNGhosts();
+
+    gpu_update_min_max_candidates(d_rtag.data,
+                                  d_vel.data,
+                                  Ntotal,
+                                  d_max_candidates.data,
+                                  d_min_candidates.data,
+                                  n_pairs,
+                                  m_flow_direction);
+
+    if (m_exec_conf->isCUDAErrorCheckingEnabled())
+        CHECK_CUDA_ERROR();
+
+    if (m_prof)
+        m_prof->pop();
+    }
+
 void export_MuellerPlatheFlowGPU(py::module& m)
     {
     py::class_<MuellerPlatheFlowGPU, MuellerPlatheFlow, std::shared_ptr<MuellerPlatheFlowGPU>>(
@@ -9,8 +9,12 @@
 
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wconversion"
+#include <thrust/copy.h>
 #include <thrust/device_ptr.h>
+#include <thrust/execution_policy.h>
 #include <thrust/functional.h>
+#include <thrust/sort.h>
+#include <thrust/transform.h>
 #include <thrust/transform_reduce.h>
 #pragma GCC diagnostic pop
 
@@ -174,6 +178,243 @@ hipError_t gpu_search_min_max_velocity(const unsigned int group_size,
     return hipPeekAtLastError();
     }
 
+//! Select the particles in one slab
+struct in_slab_pred
+    {
+    in_slab_pred(const Scalar4* const d_pos,
+                 const BoxDim gl_box,
+                 const unsigned int Nslabs,
+                 const unsigned int slab_index,
+                 const flow_enum::Direction slab_direction)
+        : m_pos(d_pos), m_gl_box(gl_box), m_Nslabs(Nslabs), m_slab_index(slab_index),
+          m_slab_direction(slab_direction)
+        {
+        }
+    const Scalar4* const m_pos;
+    const BoxDim m_gl_box;
+    const unsigned int m_Nslabs;
+    const unsigned int m_slab_index;
+    const flow_enum::Direction m_slab_direction;
+
+    __host__ __device__ bool operator()(const unsigned int idx) const
+        {
+        unsigned int index;
+        switch (m_slab_direction)
+            {
+        case flow_enum::X:
+            index = (m_pos[idx].x / m_gl_box.getL().x + .5) * m_Nslabs;
+            break;
+        case flow_enum::Y:
+            index = (m_pos[idx].y / m_gl_box.getL().y + .5) * m_Nslabs;
+            break;
+        case flow_enum::Z:
+            index = (m_pos[idx].z / m_gl_box.getL().z + .5) * m_Nslabs;
+            break;
+            }
+        index %= m_Nslabs;
+        return index == m_slab_index;
+        }
+    };
+
+//! Sort key of a particle: its momentum, negated to sort the largest momenta first
+struct momentum_key_op : public thrust::unary_function<const unsigned int, Scalar>
+    {
+    momentum_key_op(const Scalar4* const d_vel,
+                    const bool largest,
+                    const flow_enum::Direction flow_direction)
+        : m_vel(d_vel), m_largest(largest), m_flow_direction(flow_direction)
+        {
+        }
+    const Scalar4* const m_vel;
+    const bool m_largest;
+    const flow_enum::Direction m_flow_direction;
+
+    __host__ __device__ Scalar operator()(const unsigned int idx) const
+        {
+        Scalar vel;
+        switch (m_flow_direction)
+            {
+        case flow_enum::X:
+            vel = m_vel[idx].x;
+            break;
+        case flow_enum::Y:
+            vel = m_vel[idx].y;
+            break;
+        case flow_enum::Z:
+            vel = m_vel[idx].z;
+            break;
+            }
+        const Scalar momentum = vel * m_vel[idx].w;
+        return m_largest ? -momentum : momentum;
+        }
+    };
+
+/*! \param group_size Number of members in the group
+    \param d_vel Particle velocities
+    \param d_pos Particle positions
+    \param d_tag Particle tags
+    \param d_group_members Indices of the group members
+    \param gl_box Global simulation box
+    \param Nslabs Number of slabs
+    \param slab Slab to search
+    \param largest True to find the largest momenta, false to find the smallest
+    \param d_slab_members Scratch array of \a group_size elements
+    \param d_keys Scratch array of \a group_size elements
+    \param d_candidates Output: momentum, mass, and tag of the candidates, in the same layout as
+           gpu_search_min_max_velocity()
+    \param max_candidates Maximum number of candidates
+    \param n_candidates Output: number of candidates found
+    \param flow_direction Direction of the flow
+    \param slab_direction Direction normal to the slabs
+    \param alloc Caching allocator for thrust
+
+    Sorts only the members of the slab. The number of members in the slab is the only value that
+    is copied to the host.
+*/
+hipError_t gpu_search_min_max_candidates(const unsigned int group_size,
+                                         const Scalar4* const d_vel,
+                                         const Scalar4* const d_pos,
+                                         const unsigned int* const d_tag,
+                                         const unsigned int* const d_group_members,
+                                         const BoxDim gl_box,
+                                         const unsigned int Nslabs,
+                                         const unsigned int slab,
+                                         const bool largest,
+                                         unsigned int* const d_slab_members,
+                                         Scalar* const d_keys,
+                                         Scalar3* const d_candidates,
+                                         const unsigned int max_candidates,
+                                         unsigned int& n_candidates,
+                                         const flow_enum::Direction flow_direction,
+                                         const flow_enum::Direction slab_direction,
+                                         CachedAllocator& alloc)
+    {
+    thrust::device_ptr<const unsigned int> member_ptr(d_group_members);
+    thrust::device_ptr<unsigned int> slab_members(d_slab_members);
+    thrust::device_ptr<Scalar> keys(d_keys);
+    thrust::device_ptr<Scalar3> candidates(d_candidates);
+
+#ifdef __HIP_PLATFORM_HCC__
+    auto policy = thrust::hip::par(alloc);
+#else
+    auto policy = thrust::cuda::par(alloc);
+#endif
+
+    auto end = thrust::copy_if(policy,
+                               member_ptr,
+                               member_ptr + group_size,
+                               slab_members,
+                               in_slab_pred(d_pos, gl_box, Nslabs, slab, slab_direction));
+    const unsigned int n_slab = (unsigned int)(end - slab_members);
+
+    thrust::transform(policy,
+                      slab_members,
+                      slab_members + n_slab,
+                      keys,
+                      momentum_key_op(d_vel, largest, flow_direction));
+    thrust::sort_by_key(policy, keys, keys + n_slab, slab_members);
+
+    n_candidates = n_slab < max_candidates ? n_slab : max_candidates;
+    thrust::transform(policy,
+                      slab_members,
+                      slab_members + n_candidates,
+                      candidates,
+                      vel_search_un_opt(d_vel, d_tag, flow_direction));
+
+    return hipPeekAtLastError();
+    }
+
+//! Exchange the velocities of one pair of candidates per thread
+void __global__ gpu_update_min_max_candidates_kernel(const unsigned int* const d_rtag,
+                                                     Scalar4* const d_vel,
+                                                     const unsigned int Ntotal,
+                                                     const Scalar3* const d_max_candidates,
+                                                     const Scalar3* const d_min_candidates,
+                                                     const unsigned int n_pairs,
+                                                     const flow_enum::Direction flow_direction)
+    {
+    unsigned int pair = blockIdx.x * blockDim.x + threadIdx.x;
+    if (pair >= n_pairs)
+        return;
+
+    const Scalar3 max_vel = d_max_candidates[pair];
+    const Scalar3 min_vel = d_min_candidates[pair];
+    const unsigned int min_idx = d_rtag[__scalar_as_int(min_vel.z)];
+    const unsigned int max_idx = d_rtag[__scalar_as_int(max_vel.z)];
+
+    if (min_idx < Ntotal)
+        {
+        const Scalar new_min_vel = max_vel.x / min_vel.y;
+        switch (flow_direction)
+            {
+        case flow_enum::X:
+            d_vel[min_idx].x = new_min_vel;
+            break;
+        case flow_enum::Y:
+            d_vel[min_idx].y = new_min_vel;
+            break;
+        case flow_enum::Z:
+            d_vel[min_idx].z = new_min_vel;
+            break;
+            }
+        }
+
+    if (max_idx < Ntotal)
+        {
+        const Scalar new_max_vel = min_vel.x / max_vel.y;
+        switch (flow_direction)
+            {
+        case flow_enum::X:
+            d_vel[max_idx].x = new_max_vel;
+            break;
+        case flow_enum::Y:
+            d_vel[max_idx].y = new_max_vel;
+            break;
+        case flow_enum::Z:
+            d_vel[max_idx].z = new_max_vel;
+            break;
+            }
+        }
+    }
+
+/*! \param d_rtag Reverse tag lookup
+    \param d_vel Particle velocities
+    \param Ntotal Number of local and ghost particles
+    \param d_max_candidates Particles in the max slab
+    \param d_min_candidates Particles in the min slab
+    \param n_pairs Number of pairs to exchange
+    \param flow_direction Direction of the flow
+
+    The pairs are disjoint, so all are exchanged in parallel.
+*/
+hipError_t gpu_update_min_max_candidates(const unsigned int* const d_rtag,
+                                         Scalar4* const d_vel,
+                                         const unsigned int Ntotal,
+                                         const Scalar3* const d_max_candidates,
+                                         const Scalar3* const d_min_candidates,
+                                         const unsigned int n_pairs,
+                                         const flow_enum::Direction flow_direction)
+    {
+    const unsigned int block_size = 128;
+    dim3 grid(n_pairs / block_size + 1, 1, 1);
+    dim3 threads(block_size, 1, 1);
+
+    hipLaunchKernelGGL((gpu_update_min_max_candidates_kernel),
+                       dim3(grid),
+                       dim3(threads),
+                       0,
+                       0,
+                       d_rtag,
+                       d_vel,
+                       Ntotal,
+                       d_max_candidates,
+                       d_min_candidates,
+                       n_pairs,
+                       flow_direction);
+
+    return hipPeekAtLastError();
+    }
+
 void __global__ gpu_update_min_max_velocity_kernel(const unsigned int* const d_rtag,
                                                    Scalar4* const d_vel,
                                                    const unsigned int Ntotal,
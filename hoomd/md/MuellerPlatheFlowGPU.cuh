@@ -2,6 +2,7 @@
 // This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
 
 #include "MuellerPlatheFlowEnum.h"
+#include "hoomd/CachedAllocator.h"
 #include "hoomd/HOOMDMath.h"
 #include "hoomd/ParticleData.cuh"
 
@@ -30,6 +31,34 @@ hipError_t gpu_search_min_max_velocity(const unsigned int group_size,
                                        flow_enum::Direction flow_direction,
                                        flow_enum::Direction slab_direction);
 
+//! Find the particles with the largest or smallest momenta in a slab
+hipError_t gpu_search_min_max_candidates(const unsigned int group_size,
+                                         const Scalar4* const d_vel,
+                                         const Scalar4* const d_pos,
+                                         const unsigned int* const d_tag,
+                                         const unsigned int* const d_group_members,
+                                         const BoxDim gl_box,
+                                         const unsigned int Nslabs,
+                                         const unsigned int slab,
+                                         const bool largest,
+                                         unsigned int* const d_slab_members,
+                                         Scalar* const d_keys,
+                                         Scalar3* const d_candidates,
+                                         const unsigned int max_candidates,
+                                         unsigned int& n_candidates,
+                                         flow_enum::Direction flow_direction,
+                                         flow_enum::Direction slab_direction,
+                                         CachedAllocator& alloc);
+
+//! Exchange the velocities of several pairs of particles
+hipError_t gpu_update_min_max_candidates(const unsigned int* const d_rtag,
+                                         Scalar4* const d_vel,
+                                         const unsigned int Ntotal,
+                                         const Scalar3* const d_max_candidates,
+                                         const Scalar3* const d_min_candidates,
+                                         const unsigned int n_pairs,
+                                         const flow_enum::Direction flow_direction);
+
 hipError_t gpu_update_min_max_velocity(const unsigned int* const d_rtag,
                                        Scalar4* const d_vel,
                                        const unsigned int Ntotal,
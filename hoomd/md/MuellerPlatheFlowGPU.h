@@ -67,6 +67,21 @@ class MuellerPlatheFlowGPU : public MuellerPlatheFlow
 
     virtual void searchMinMaxVelocity(void);
     virtual void updateMinMaxVelocity(void);
+
+    //! Sort the members of each slab on the GPU and copy only the candidates to the host
+    virtual bool searchMinMaxCandidates(unsigned int max_pairs,
+                                        std::vector<Scalar3>& max_vel,
+                                        std::vector<Scalar3>& min_vel);
+
+    //! Exchange the velocities of all pairs in one kernel launch
+    virtual void updateMinMaxCandidates(const std::vector<Scalar3>& max_vel,
+                                        const std::vector<Scalar3>& min_vel,
+                                        unsigned int n_pairs);
+
+    GPUArray<unsigned int> m_slab_members; //!< Scratch space for the members of a slab
+    GPUArray<Scalar> m_keys;               //!< Scratch space for the sort keys
+    GPUArray<Scalar3> m_max_candidates;    //!< Candidates in the max slab
+    GPUArray<Scalar3> m_min_candidates;    //!< Candidates in the min slab
     };
 
 //! Exports the MuellerPlatheFlow class to python
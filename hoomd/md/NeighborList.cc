@@ -12,9 +12,15 @@
 
 namespace py = pybind11;
 
+#include <algorithm>
 #include <iostream>
 #include <stdexcept>
 
+#ifdef ENABLE_TBB
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_scan.h>
+#endif
+
 using namespace std;
 
 /*! \file NeighborList.cc
@@ -33,7 +39,7 @@ NeighborList::NeighborList(std::shared_ptr<SystemDefinition> sysdef, Scalar r_bu
     : Compute(sysdef), m_typpair_idx(m_pdata->getNTypes()), m_rcut_max_max(0.0), m_rcut_min(0.0),
       m_r_buff(r_buff), m_d_max(1.0), m_filter_body(false), m_diameter_shift(false),
       m_storage_mode(half), m_rcut_changed(true), m_updates(0), m_forced_updates(0),
-      m_dangerous_updates(0), m_force_update(true), m_dist_check(true),
+      m_dangerous_updates(0), m_force_update(true), m_particles_moved(false), m_dist_check(true),
       m_has_been_updated_once(false)
     {
     m_exec_conf->msg->notice(5) << "Constructing Neighborlist" << endl;
@@ -206,6 +212,10 @@ NeighborList::NeighborList(std::shared_ptr<SystemDefinition> sysdef, Scalar r_bu
     // connect to particle sort to force rebuild
     m_pdata->getParticleSortSignal().connect<NeighborList, &NeighborList::forceUpdate>(this);
 
+    // connect to particle moves to check distances again, without forcing a rebuild
+    m_pdata->getParticlesMovedSignal().connect<NeighborList, &NeighborList::slotParticlesMoved>(
+        this);
+
     // connect to max particle change to resize neighborlist arrays
     m_pdata->getMaxParticleNumberChangeSignal().connect<NeighborList, &NeighborList::reallocate>(
         this);
@@ -284,6 +294,8 @@ NeighborList::~NeighborList()
     m_exec_conf->msg->notice(5) << "Destroying Neighborlist" << endl;
 
     m_pdata->getParticleSortSignal().disconnect<NeighborList, &NeighborList::forceUpdate>(this);
+    m_pdata->getParticlesMovedSignal().disconnect<NeighborList, &NeighborList::slotParticlesMoved>(
+        this);
     m_pdata->getMaxParticleNumberChangeSignal().disconnect<NeighborList, &NeighborList::reallocate>(
         this);
     m_pdata->getGlobalParticleNumberChangeSignal()
@@ -333,6 +345,9 @@ NeighborList::~NeighborList()
 void NeighborList::compute(uint64_t timestep)
     {
     Compute::compute(timestep);
+    ScopedToolRange range(m_profile_name);
+    ScopedOperationTimer timer(m_timer);
+
     // check if the rcut array has changed and update it
     if (m_rcut_changed)
         {
@@ -340,7 +355,7 @@ void NeighborList::compute(uint64_t timestep)
         }
 
     // skip if we shouldn't compute this step
-    if (!shouldCompute(timestep) && !m_force_update)
+    if (!shouldCompute(timestep) && !m_force_update && !m_particles_moved)
         return;
 
     if (m_prof)
@@ -393,11 +408,17 @@ void NeighborList::compute(uint64_t timestep)
                 }
             } while (overflowed);
 
-        if (m_exclusions_set)
+        if (m_exclusions_set && !m_exclusions_in_build)
             filterNlist();
 
+        if (m_sort_by_type)
+            sortNlistByType();
+
+        compressNlist();
+
         setLastUpdatedPos();
         m_has_been_updated_once = true;
+        m_boundary_list_valid = false;
         }
     if (m_prof)
         m_prof->pop();
@@ -1256,6 +1277,21 @@ bool NeighborList::distanceCheck(uint64_t timestep)
     ArrayHandle<Scalar4> h_last_pos(m_last_pos, access_location::host, access_mode::read);
     ArrayHandle<Scalar> h_rcut_max(m_rcut_max, access_location::host, access_mode::read);
 
+    // Incremental updates repair the rows of moved particles at every check, so they need checks
+    // on every step. The reference positions are kept, so a particle that crossed the skin stays
+    // in m_moved until the next full build.
+    bool incremental = m_incremental_fraction > Scalar(0.0) && m_rebuild_check_delay <= 1;
+#ifdef ENABLE_MPI
+    if (m_pdata->getDomainDecomposition())
+        incremental = false;
+#endif
+
+    if (incremental && m_moved_flag.size() != m_pdata->getN())
+        {
+        m_moved.clear();
+        m_moved_flag.assign(m_pdata->getN(), 0);
+        }
+
     for (unsigned int i = 0; i < m_pdata->getN(); i++)
         {
         const unsigned int type_i = __scalar_as_int(h_pos.data[i].w);
@@ -1279,8 +1315,33 @@ bool NeighborList::distanceCheck(uint64_t timestep)
         if (dot(dx, dx) >= maxsq)
             {
             result = true;
-            break;
+            if (!incremental)
+                break;
+
+            if (!m_moved_flag[i])
+                {
+                m_moved_flag[i] = 1;
+                m_moved.push_back(i);
+                }
+            }
+        }
+
+    // repair the list in place when few enough particles have moved
+    if (incremental && result
+        && Scalar(m_moved.size()) <= m_incremental_fraction * Scalar(m_pdata->getN()))
+        {
+        if (m_prof)
+            m_prof->push("Incremental");
+
+        if (updateNlistIncremental(timestep, m_moved))
+            {
+            result = false;
+            m_incremental_updates += 1;
+            m_boundary_list_valid = false;
             }
+
+        if (m_prof)
+            m_prof->pop();
         }
 
 #ifdef ENABLE_MPI
@@ -1335,6 +1396,11 @@ void NeighborList::setLastUpdatedPos()
     m_last_L = m_pdata->getGlobalBox().getNearestPlaneDistance();
     m_last_L_local = m_pdata->getBox().getNearestPlaneDistance();
 
+    // all particles are within the skin of the new reference positions
+    for (unsigned int i : m_moved)
+        m_moved_flag[i] = 0;
+    m_moved.clear();
+
     if (m_prof)
         m_prof->pop();
     }
@@ -1353,7 +1419,7 @@ bool NeighborList::shouldCheckDistance(uint64_t timestep)
 */
 bool NeighborList::needsUpdating(uint64_t timestep)
     {
-    if (m_last_checked_tstep == timestep)
+    if (m_last_checked_tstep == timestep && !m_particles_moved)
         {
         if (m_force_update)
             {
@@ -1366,7 +1432,11 @@ bool NeighborList::needsUpdating(uint64_t timestep)
 
     m_last_checked_tstep = timestep;
 
-    if (!m_force_update && !shouldCheckDistance(timestep))
+    // particles moved in place must be checked, even when this step was already checked
+    bool moved = m_particles_moved;
+    m_particles_moved = false;
+
+    if (!m_force_update && !moved && !shouldCheckDistance(timestep))
         {
         m_last_check_result = false;
         return false;
@@ -1379,7 +1449,7 @@ bool NeighborList::needsUpdating(uint64_t timestep)
     // we are dangerous if m_rebuild_check_delay is greater than 1 and this is the first check after
     // the last build
     bool dangerous = false;
-    if (m_dist_check
+    if (m_dist_check && !moved
         && (m_rebuild_check_delay > 1
             && timestep == (m_last_updated_tstep + m_rebuild_check_delay)))
         dangerous = true;
@@ -1449,6 +1519,8 @@ bool NeighborList::needsUpdating(uint64_t timestep)
 void NeighborList::resetStats()
     {
     m_updates = m_forced_updates = m_dangerous_updates = 0;
+    m_incremental_updates = 0;
+    m_reallocations = 0;
 
     for (unsigned int i = 0; i < m_update_periods.size(); i++)
         m_update_periods[i] = 0;
@@ -1464,6 +1536,45 @@ unsigned int NeighborList::getSmallestRebuild()
     return (unsigned int)m_update_periods.size();
     }
 
+/*! \returns The largest number of neighbors that the storage holds for a particle of any type
+ */
+unsigned int NeighborList::getMaxNeighbors()
+    {
+    ArrayHandle<unsigned int> h_Nmax(m_Nmax, access_location::host, access_mode::read);
+    unsigned int max_neighbors = 0;
+    for (unsigned int i = 0; i < m_pdata->getNTypes(); ++i)
+        max_neighbors = std::max(max_neighbors, h_Nmax.data[i]);
+    return max_neighbors;
+    }
+
+/*! \returns The number of neighbors in the list averaged over all particles in the system
+
+    With half storage, each pair appears in the list once, so the mean is half the mean number of
+    neighbors of a particle.
+*/
+double NeighborList::getMeanNeighbors()
+    {
+    ArrayHandle<unsigned int> h_n_neigh(m_n_neigh, access_location::host, access_mode::read);
+    unsigned long long n_neigh = 0;
+    for (unsigned int i = 0; i < m_pdata->getN(); i++)
+        n_neigh += h_n_neigh.data[i];
+
+#ifdef ENABLE_MPI
+    if (m_pdata->getDomainDecomposition())
+        {
+        MPI_Allreduce(MPI_IN_PLACE,
+                      &n_neigh,
+                      1,
+                      MPI_UNSIGNED_LONG_LONG,
+                      MPI_SUM,
+                      m_exec_conf->getMPICommunicator());
+        }
+#endif
+
+    unsigned int N = m_pdata->getNGlobal();
+    return N > 0 ? double(n_neigh) / double(N) : 0.0;
+    }
+
 /*! This method is now deprecated, and deriving classes must supply it.
  */
 void NeighborList::buildNlist(uint64_t timestep)
@@ -1473,7 +1584,7 @@ void NeighborList::buildNlist(uint64_t timestep)
     }
 
 /*! Translates the exclusions set in \c m_n_ex_tag and \c m_ex_list_tag to indices in \c m_n_ex_idx
- * and \c m_ex_list_idx
+ * and \c m_ex_list_idx, and packs them into \c m_ex_mask
  */
 void NeighborList::updateExListIdx()
     {
@@ -1495,6 +1606,8 @@ void NeighborList::updateExListIdx()
                                             access_location::host,
                                             access_mode::overwrite);
 
+    m_ex_mask.resize(m_pdata->getN());
+
     // translate the number and exclusions from one array to the other
     for (unsigned int idx = 0; idx < m_pdata->getN(); idx++)
         {
@@ -1506,6 +1619,7 @@ void NeighborList::updateExListIdx()
         h_n_ex_idx.data[idx] = n;
 
         // construct the exclusion list
+        uint64_t mask = 0;
         for (unsigned int offset = 0; offset < n; offset++)
             {
             unsigned int ex_tag = h_ex_list_tag.data[m_ex_list_indexer_tag(tag, offset)];
@@ -1513,7 +1627,14 @@ void NeighborList::updateExListIdx()
 
             // store excluded particle idx
             h_ex_list_idx.data[m_ex_list_indexer(idx, offset)] = ex_idx;
+
+            // set the bit of nearby tags, or flag that the exclusion list must be scanned
+            int64_t bit = int64_t(ex_tag) - int64_t(tag) + EX_MASK_CENTER;
+            if (bit < 0 || bit >= 64)
+                bit = EX_MASK_CENTER;
+            mask |= uint64_t(1) << bit;
             }
+        m_ex_mask[idx] = mask;
         }
 
     if (m_prof)
@@ -1598,6 +1719,31 @@ void NeighborList::buildHeadList()
                                    access_mode::read);
         ArrayHandle<unsigned int> h_Nmax(m_Nmax, access_location::host, access_mode::read);
 
+#ifdef ENABLE_TBB
+        // the head list is an exclusive prefix sum of Nmax over the particle types
+        m_exec_conf->getTaskArena()->execute(
+            [&]
+            {
+                headAddress = tbb::parallel_scan(
+                    tbb::blocked_range<unsigned int>(0, m_pdata->getN()),
+                    0u,
+                    [&](const tbb::blocked_range<unsigned int>& r,
+                        unsigned int sum,
+                        bool is_final_scan) -> unsigned int
+                    {
+                        for (unsigned int i = r.begin(); i != r.end(); ++i)
+                            {
+                            if (is_final_scan)
+                                h_head_list.data[i] = sum;
+
+                            unsigned int myType = __scalar_as_int(h_pos.data[i].w);
+                            sum += h_Nmax.data[myType];
+                            }
+                        return sum;
+                    },
+                    [](unsigned int left, unsigned int right) { return left + right; });
+            });
+#else
         for (unsigned int i = 0; i < m_pdata->getN(); ++i)
             {
             h_head_list.data[i] = headAddress;
@@ -1606,6 +1752,7 @@ void NeighborList::buildHeadList()
             unsigned int myType = __scalar_as_int(h_pos.data[i].w);
             headAddress += h_Nmax.data[myType];
             }
+#endif
         }
 
     resizeNlist(headAddress);
@@ -1618,7 +1765,7 @@ void NeighborList::buildHeadList()
  * \param size the requested number of elements in the neighbor list
  *
  * Increases the size of the neighbor list memory using amortized resizing (growth factor: 9/8)
- * only when needed.
+ * only when needed. Shrinks it with the same shrink fraction and delay that GPUVector uses.
  */
 void NeighborList::resizeNlist(size_t size)
     {
@@ -1638,9 +1785,49 @@ void NeighborList::resizeNlist(size_t size)
         alloc_size = (alloc_size > 4) ? (alloc_size + 3) & ~3 : 4;
 
         m_nlist.resize(alloc_size);
+        m_nlist_num_below = 0;
+        }
+    else if (m_exec_conf->getShrinkFraction() > 0.0
+             && (double)size < m_exec_conf->getShrinkFraction() * (double)m_nlist.getNumElements())
+        {
+        if (++m_nlist_num_below >= m_exec_conf->getShrinkDelay())
+            {
+            // keep the head room that the growth factor would add
+            size_t alloc_size = ((size_t)(((float)size) * 1.125f)) + 1;
+            alloc_size = (alloc_size > 4) ? (alloc_size + 3) & ~3 : 4;
+
+            m_exec_conf->msg->notice(6)
+                << "nlist: Shrinking neighbor list, new size " << alloc_size << " uints " << endl;
+
+            m_nlist.resize(alloc_size);
+            m_nlist_num_below = 0;
+            }
+        }
+    else
+        {
+        m_nlist_num_below = 0;
         }
     }
 
+#ifdef ENABLE_TBB
+/*!
+ * \param thread_conditions Overflow conditions written by each thread
+ * \param conditions Host pointer to m_conditions
+ *
+ * Threaded builds record overflows in per-thread arrays so that the inner loop does not contend on
+ * m_conditions. The largest requested size of each type is folded in after the build.
+ */
+void NeighborList::reduceThreadConditions(ThreadConditions& thread_conditions,
+                                          unsigned int* conditions)
+    {
+    for (const auto& local_conditions : thread_conditions)
+        {
+        for (unsigned int i = 0; i < local_conditions.size(); ++i)
+            conditions[i] = max(conditions[i], local_conditions[i]);
+        }
+    }
+#endif
+
 /*!
  * \returns true if an overflow is detected for any particle type
  * \returns false if all particle types have enough memory for their neighbors
@@ -1663,6 +1850,9 @@ bool NeighborList::checkConditions()
             }
         }
 
+    if (result)
+        m_reallocations += 1;
+
     return result;
     }
 
@@ -1689,6 +1879,70 @@ void NeighborList::growExclusionList()
     forceUpdate();
     }
 
+/*! The classification is cached until the next build or incremental update of the list, which
+    happen whenever the local particles or the ghost particles change.
+*/
+void NeighborList::updateBoundaryList()
+    {
+    if (m_boundary_list_valid)
+        return;
+
+    if (m_boundary_list.getNumElements() < m_pdata->getN())
+        {
+        GlobalArray<unsigned int> boundary_list(m_pdata->getMaxN(), m_exec_conf);
+        m_boundary_list.swap(boundary_list);
+        TAG_ALLOCATION(m_boundary_list);
+        }
+
+    buildBoundaryList();
+    m_boundary_list_valid = true;
+    }
+
+void NeighborList::buildBoundaryList()
+    {
+    const unsigned int N = m_pdata->getN();
+
+    ArrayHandle<unsigned int> h_n_neigh(m_n_neigh, access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_nlist(m_nlist, access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_head_list(m_head_list, access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_boundary_list(m_boundary_list,
+                                              access_location::host,
+                                              access_mode::overwrite);
+
+    // interior particles fill the list from the front, boundary particles from the back
+    unsigned int n_interior = 0;
+    unsigned int n_boundary = 0;
+    for (unsigned int i = 0; i < N; i++)
+        {
+        const unsigned int head = h_head_list.data[i];
+        bool boundary = false;
+        for (unsigned int k = 0; k < h_n_neigh.data[i]; k++)
+            {
+            if (h_nlist.data[head + k] >= N)
+                {
+                boundary = true;
+                break;
+                }
+            }
+
+        if (boundary)
+            h_boundary_list.data[N - 1 - n_boundary++] = i;
+        else
+            h_boundary_list.data[n_interior++] = i;
+        }
+
+    // keep the boundary particles in memory order
+    std::reverse(h_boundary_list.data + n_interior, h_boundary_list.data + N);
+    m_n_interior = n_interior;
+    }
+
+bool NeighborList::isUpToDate(uint64_t timestep)
+    {
+    return m_has_been_updated_once && m_last_checked_tstep == timestep && !m_last_check_result
+           && !m_force_update && !m_rcut_changed && !m_n_particles_changed
+           && !m_topology_changed;
+    }
+
 #ifdef ENABLE_MPI
 //! Set the communicator to use
 void NeighborList::setCommunicator(std::shared_ptr<Communicator> comm)
@@ -1812,6 +2066,14 @@ void export_NeighborList(py::module& m)
                       &NeighborList::getRebuildCheckDelay,
                       &NeighborList::setRebuildCheckDelay)
         .def_property("check_dist", &NeighborList::getDistCheck, &NeighborList::setDistCheck)
+        .def_property("compressed", &NeighborList::getCompressed, &NeighborList::setCompressed)
+        .def_property("sort_by_type", &NeighborList::getSortByType, &NeighborList::setSortByType)
+        .def_property("incremental_fraction",
+                      &NeighborList::getIncrementalFraction,
+                      &NeighborList::setIncrementalFraction)
+        .def_property("refit_threshold",
+                      &NeighborList::getRefitThreshold,
+                      &NeighborList::setRefitThreshold)
         .def("setStorageMode", &NeighborList::setStorageMode)
         .def_property("exclusions", &NeighborList::getExclusions, &NeighborList::setExclusions)
         .def_property("diameter_shift",
@@ -1828,6 +2090,11 @@ void export_NeighborList(py::module& m)
         .def("estimateNNeigh", &NeighborList::estimateNNeigh)
         .def("getSmallestRebuild", &NeighborList::getSmallestRebuild)
         .def("getNumUpdates", &NeighborList::getNumUpdates)
+        .def("getNumIncrementalUpdates", &NeighborList::getNumIncrementalUpdates)
+        .def("getNumDangerousUpdates", &NeighborList::getNumDangerousUpdates)
+        .def("getNumReallocations", &NeighborList::getNumReallocations)
+        .def("getMaxNeighbors", &NeighborList::getMaxNeighbors)
+        .def("getMeanNeighbors", &NeighborList::getMeanNeighbors)
         .def("getNumExclusions", &NeighborList::getNumExclusions)
 #ifdef ENABLE_MPI
         .def("setCommunicator", &NeighborList::setCommunicator)
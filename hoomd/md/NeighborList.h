@@ -8,6 +8,7 @@
 #include "hoomd/GPUVector.h"
 #include "hoomd/GlobalArray.h"
 #include "hoomd/Index1D.h"
+#include "hoomd/PythonLocalDataAccess.h"
 
 #include <hoomd/extern/nano-signal-slot/nano_signal_slot.hpp>
 #include <memory>
@@ -31,6 +32,10 @@
 #include "hoomd/Communicator.h"
 #endif
 
+#ifdef ENABLE_TBB
+#include <tbb/enumerable_thread_specific.h>
+#endif
+
 //! Computes a Neighborlist from the particles
 /*! \b Overview:
 
@@ -104,6 +109,11 @@
    removes any particles that are excluded. This allows an arbitrary number of exclusions to be
    processed without slowing the performance of the buildNlist() step itself.
 
+    CPU builders that set \a m_exclusions_in_build instead skip excluded pairs as they find them
+   with isExcludedInBuild(). updateExListIdx() packs the exclusions of each particle with the
+   particles whose tags are close to its own into a 64 bit mask, which covers the bonded
+   exclusions of polymers and molecules with consecutive tags in a single bit test.
+
     <b>Overflow handling:</b>
     For easy support of derived GPU classes to implement overflow detection the overflow condition
    is stored in the GlobalArray \a d_conditions.
@@ -212,6 +222,57 @@ class PYBIND11_EXPORT NeighborList : public Compute
         return m_dist_check;
         }
 
+    //! Set the largest fraction of particles whose rows are updated incrementally
+    /*! \param fraction Fraction of the local particles in [0,1]
+
+        When the distance check finds that only a few particles have moved past the skin, the
+        rows of those particles are updated in place instead of rebuilding the whole list. Once
+        more than \a fraction of the particles have moved, the list is rebuilt in full. Set to 0
+        to always rebuild in full.
+    */
+    void setIncrementalFraction(Scalar fraction)
+        {
+        if (fraction < Scalar(0.0) || fraction > Scalar(1.0))
+            {
+            throw std::invalid_argument("incremental_fraction must be in the range [0,1]");
+            }
+        m_incremental_fraction = fraction;
+        forceUpdate();
+        }
+
+    Scalar getIncrementalFraction()
+        {
+        return m_incremental_fraction;
+        }
+
+    //! Set the growth of the tree cost that triggers a rebuild of a refitted tree
+    /*! \param threshold Ratio of the cost of a refitted tree to its cost after the last build
+
+        Tree based neighbor lists may refit the bounding boxes of their trees to the new positions
+        instead of building new trees. A tree is rebuilt when its cost exceeds \a threshold times
+        the cost after its last build. Set to 0 to always build new trees. Only the GPU tree
+        neighbor list refits its trees.
+    */
+    void setRefitThreshold(Scalar threshold)
+        {
+        if (threshold < Scalar(0.0))
+            {
+            throw std::invalid_argument("refit_threshold must be non-negative");
+            }
+        m_refit_threshold = threshold;
+        }
+
+    Scalar getRefitThreshold()
+        {
+        return m_refit_threshold;
+        }
+
+    //! Get the number of incremental updates performed
+    uint64_t getNumIncrementalUpdates()
+        {
+        return m_incremental_updates;
+        }
+
     //! Set the storage mode
     /*! \param mode Storage mode to set
         - half only stores neighbors where i < j
@@ -236,6 +297,15 @@ class PYBIND11_EXPORT NeighborList : public Compute
         return m_storage_mode;
         }
 
+    //! Get the deterministic flag
+    /*! Neighbor lists that can sort their neighbors override this. GPU pair potentials also sum
+        their forces in a reproducible order when it is true.
+    */
+    virtual bool getDeterministic()
+        {
+        return false;
+        }
+
     //! Get the maximum of all rcut
     Scalar getMaxRCut()
         {
@@ -286,28 +356,116 @@ class PYBIND11_EXPORT NeighborList : public Compute
     //! Gets the shortest rebuild period this nlist has experienced since a call to resetStats
     unsigned int getSmallestRebuild();
 
+    //! Get the number of dangerous builds since the last call to resetStats
+    uint64_t getNumDangerousUpdates()
+        {
+        return m_dangerous_updates;
+        }
+
+    //! Get the number of times the list storage grew since the last call to resetStats
+    uint64_t getNumReallocations()
+        {
+        return m_reallocations;
+        }
+
+    //! Get the number of neighbors per particle that the list storage holds
+    unsigned int getMaxNeighbors();
+
+    //! Get the mean number of neighbors per particle in the current list
+    double getMeanNeighbors();
+
     // @}
     //! \name Get data
     // @{
 
     //! Get the number of neighbors array
-    const GlobalArray<unsigned int>& getNNeighArray()
+    const GlobalArray<unsigned int>& getNNeighArray() const
         {
         return m_n_neigh;
         }
 
     //! Get the neighbor list
-    const GlobalArray<unsigned int>& getNListArray()
+    const GlobalArray<unsigned int>& getNListArray() const
         {
         return m_nlist;
         }
 
     //! Get the head list
-    const GlobalArray<unsigned int>& getHeadList()
+    const GlobalArray<unsigned int>& getHeadList() const
         {
         return m_head_list;
         }
 
+    //! Enable or disable the compressed copy of the neighbor list
+    /*! \param compressed Set to true to store a 16-bit copy of the list
+
+        GPU neighbor lists store each neighbor in the compressed copy as a 16-bit delta from the
+        particle index, so that GPU pair potentials read half as many bytes per neighbor. Entries
+        whose delta does not fit hold NLIST_DELTA_ESCAPE and are read from getNListArray(). The
+        copy is stored in addition to the full list, so it adds memory. CPU neighbor lists ignore
+        this setting.
+    */
+    void setCompressed(bool compressed)
+        {
+        m_compressed = compressed;
+        forceUpdate();
+        }
+
+    bool getCompressed()
+        {
+        return m_compressed;
+        }
+
+    //! Enable or disable ordering each particle's neighbors by type
+    /*! \param sort_by_type Set to true to sort the neighbors of each particle by type
+
+        GPU neighbor lists order the neighbors of each particle by type, then by index, after each
+        build. GPU pair potentials then evaluate runs of neighbors with the same type pair and
+        reuse the type pair parameters across the run. CPU neighbor lists ignore this setting.
+    */
+    void setSortByType(bool sort_by_type)
+        {
+        m_sort_by_type = sort_by_type;
+        forceUpdate();
+        }
+
+    bool getSortByType()
+        {
+        return m_sort_by_type;
+        }
+
+    //! Get the compressed copy of the neighbor list, indexed like getNListArray()
+    /*! The array is null when there is no compressed copy.
+     */
+    const GlobalArray<uint16_t>& getNListDeltaArray()
+        {
+        return m_nlist_delta;
+        }
+
+    //! Order the local particles by whether they have ghost neighbors
+    /*! After the call, getBoundaryList() holds the indices of the getNInterior() local particles
+        whose neighbors are all local, followed by the indices of the remaining local particles.
+        The order is reused until the list is next built or updated.
+    */
+    void updateBoundaryList();
+
+    //! Get the local particle indices ordered by updateBoundaryList()
+    const GlobalArray<unsigned int>& getBoundaryList()
+        {
+        return m_boundary_list;
+        }
+
+    //! Get the number of local particles without ghost neighbors
+    unsigned int getNInterior()
+        {
+        return m_n_interior;
+        }
+
+    //! Test if the list has been checked at \a timestep and needs no update
+    /*! When this returns true, compute() at \a timestep does not access the particle data.
+     */
+    bool isUpToDate(uint64_t timestep);
+
     //! Get the number of exclusions array
     const GlobalArray<unsigned int>& getNExArray()
         {
@@ -454,6 +612,15 @@ class PYBIND11_EXPORT NeighborList : public Compute
         m_force_update = true;
         }
 
+    //! Checks the distances moved again on the next call to compute()
+    /*! Particles moved in place (e.g. by State.set_snapshot) trigger a rebuild only when they moved
+        more than half the buffer distance, just like particles moved by the integrator.
+    */
+    void slotParticlesMoved()
+        {
+        m_particles_moved = true;
+        }
+
     //! Get the number of updates
     virtual uint64_t getNumUpdates()
         {
@@ -511,6 +678,7 @@ class PYBIND11_EXPORT NeighborList : public Compute
     storageMode m_storage_mode; //!< The storage mode
 
     GlobalArray<unsigned int> m_nlist;   //!< Neighbor list data
+    unsigned int m_nlist_num_below = 0;  //!< Consecutive builds below the shrink fraction
     GlobalArray<unsigned int> m_n_neigh; //!< Number of neighbors for each particle
     GlobalArray<Scalar4> m_last_pos;     //!< coordinates of last updated particle positions
     Scalar3 m_last_L;                    //!< Box lengths at last update
@@ -530,12 +698,51 @@ class PYBIND11_EXPORT NeighborList : public Compute
     Index2D m_ex_list_indexer_tag;           //!< Indexer for accessing the by-tag exclusion list
     bool m_exclusions_set;                   //!< True if any exclusions have been set
 
+    /// Exclusion masks by local index, bit k marks an exclusion with tag + k - EX_MASK_CENTER
+    std::vector<uint64_t> m_ex_mask;
+
+    /// True when buildNlist() skips excluded pairs itself and filterNlist() is not needed
+    bool m_exclusions_in_build = false;
+
+    /// Bit of m_ex_mask for a zero tag offset, set when a particle has exclusions outside the mask
+    static const int EX_MASK_CENTER = 32;
+
     /// True if the number of particles has changed.
     bool m_n_particles_changed = false;
 
     /// True if the number of bonds/angles/dihedrals/impropers/pairs has changed.
     bool m_topology_changed = false;
 
+    /// True when a compressed copy of the neighbor list is requested
+    bool m_compressed = false;
+
+    /// True when the neighbors of each particle are ordered by type
+    bool m_sort_by_type = false;
+
+    /// 16-bit deltas from the particle index to each neighbor, indexed like m_nlist
+    GlobalArray<uint16_t> m_nlist_delta;
+
+    /// Largest fraction of moved particles handled by an incremental update
+    Scalar m_incremental_fraction = Scalar(0.0);
+
+    /// Growth of the tree cost that triggers a rebuild of a refitted tree, 0 to always rebuild
+    Scalar m_refit_threshold = Scalar(0.0);
+
+    /// Local indices of particles that moved past the skin since the last full build
+    std::vector<unsigned int> m_moved;
+
+    /// Per-particle flags marking membership in m_moved
+    std::vector<unsigned char> m_moved_flag;
+
+    /// Local particle indices, those without ghost neighbors first
+    GlobalArray<unsigned int> m_boundary_list;
+
+    /// Number of particles without ghost neighbors at the front of m_boundary_list
+    unsigned int m_n_interior = 0;
+
+    /// True when m_boundary_list matches the current neighbor list
+    bool m_boundary_list_valid = false;
+
     //! Return true if we are supposed to do a distance check in this time step
     bool shouldCheckDistance(uint64_t timestep);
 
@@ -548,6 +755,18 @@ class PYBIND11_EXPORT NeighborList : public Compute
     //! Builds the neighbor list
     virtual void buildNlist(uint64_t timestep);
 
+    //! Update only the rows of the given particles in the existing neighbor list
+    /*! \param timestep Current time step
+        \param moved Local indices of particles that have moved past the skin
+        \returns true if the list is valid after the update, false if a full rebuild is needed
+
+        The base implementation does not support incremental updates and always returns false.
+    */
+    virtual bool updateNlistIncremental(uint64_t timestep, const std::vector<unsigned int>& moved)
+        {
+        return false;
+        }
+
     //! Updates the idx exclusion list
     virtual void updateExListIdx();
 
@@ -560,12 +779,64 @@ class PYBIND11_EXPORT NeighborList : public Compute
     //! Filter the neighbor list of excluded particles
     virtual void filterNlist();
 
+    //! Test if a pair is excluded while building the list on the CPU
+    /*! \param i Local index of the particle whose row is built
+        \param j Local or ghost index of the candidate neighbor
+        \param h_tag Particle tags
+        \param h_n_ex_idx Number of exclusions by local index
+        \param h_ex_list_idx Exclusion list by local index
+
+        Pairs with tags closer than EX_MASK_CENTER are resolved with one bit of m_ex_mask. Only
+        particles with an exclusion outside of the mask window scan their exclusion list.
+    */
+    bool isExcludedInBuild(unsigned int i,
+                           unsigned int j,
+                           const unsigned int* h_tag,
+                           const unsigned int* h_n_ex_idx,
+                           const unsigned int* h_ex_list_idx) const
+        {
+        const uint64_t mask = m_ex_mask[i];
+        if (mask == 0)
+            return false;
+
+        const int64_t bit = int64_t(h_tag[j]) - int64_t(h_tag[i]) + EX_MASK_CENTER;
+        if (bit >= 0 && bit < 64 && bit != EX_MASK_CENTER)
+            return (mask >> bit) & 1;
+
+        if (!((mask >> EX_MASK_CENTER) & 1))
+            return false;
+
+        for (unsigned int k = 0; k < h_n_ex_idx[i]; k++)
+            {
+            if (h_ex_list_idx[m_ex_list_indexer(i, k)] == j)
+                return true;
+            }
+        return false;
+        }
+
+    //! Order the neighbors of each particle by type after a build
+    virtual void sortNlistByType() { }
+
+    //! Update the compressed copy of the neighbor list after a build
+    virtual void compressNlist() { }
+
+    //! Fill m_boundary_list and m_n_interior from the current neighbor list
+    virtual void buildBoundaryList();
+
     //! Build the head list to allocated memory
     virtual void buildHeadList();
 
     //! Amortized resizing of the neighborlist
     void resizeNlist(size_t size);
 
+#ifdef ENABLE_TBB
+    /// Per-thread copies of the overflow conditions written by threaded CPU builds
+    typedef tbb::enumerable_thread_specific<std::vector<unsigned int>> ThreadConditions;
+
+    //! Fold per-thread overflow conditions into the conditions array
+    void reduceThreadConditions(ThreadConditions& thread_conditions, unsigned int* conditions);
+#endif
+
 #ifdef ENABLE_MPI
     CommFlags getRequestedCommFlags(uint64_t timestep)
         {
@@ -603,7 +874,15 @@ class PYBIND11_EXPORT NeighborList : public Compute
     uint64_t m_updates;           //!< Number of times the neighbor list has been updated
     uint64_t m_forced_updates;    //!< Number of times the neighbor list has been forcibly updated
     uint64_t m_dangerous_updates; //!< Number of dangerous builds counted
+
+    /// Number of incremental updates performed in place of full builds
+    uint64_t m_incremental_updates = 0;
+
+    /// Number of times m_Nmax grew and the list was reallocated
+    uint64_t m_reallocations = 0;
+
     bool m_force_update;          //!< Flag to handle the forcing of neighborlist updates
+    bool m_particles_moved;       //!< Flag set when particles were moved in place
     bool m_dist_check;            //!< Set to false to disable distance checks (nlist always built
                                   //!< m_rebuild_check_delay steps)
     bool m_has_been_updated_once; //!< True if the neighbor list has been updated at least once
@@ -675,7 +954,89 @@ class PYBIND11_EXPORT NeighborList : public Compute
 #endif
     };
 
+/// Allow the usage of the neighbor list arrays in Python.
+/** Uses the LocalDataAccess templated class to expose the neighbor list
+ *  arrays to Python. For an explanation of the methods and structure see the
+ *  documentation of LocalDataAccess. All arrays are read only.
+ *
+ *  Template Parameters
+ *  Output: The buffer output type (either HOOMDHostBuffer or HOOMDDeviceBuffer)
+ */
+template<class Output>
+class PYBIND11_EXPORT LocalNeighborListData : public LocalDataAccess<Output, NeighborList>
+    {
+    public:
+    LocalNeighborListData(NeighborList& nlist, ParticleData& pdata)
+        : LocalDataAccess<Output, NeighborList>(nlist), m_nlist(nlist), m_pdata(pdata),
+          m_head_list_handle(), m_n_neigh_handle(), m_nlist_handle()
+        {
+        }
+
+    virtual ~LocalNeighborListData() = default;
+
+    /// Index of the first neighbor of each local particle in the flat neighbor list
+    Output getHeadList()
+        {
+        return this->template getBufferOfSize<unsigned int>(m_head_list_handle,
+                                                            &NeighborList::getHeadList,
+                                                            m_pdata.getN());
+        }
+
+    /// Number of neighbors of each local particle
+    Output getNNeigh()
+        {
+        return this->template getBufferOfSize<unsigned int>(m_n_neigh_handle,
+                                                            &NeighborList::getNNeighArray,
+                                                            m_pdata.getN());
+        }
+
+    /// The flat neighbor list, including the unused capacity at the end
+    Output getNList()
+        {
+        return this->template getBufferOfSize<unsigned int>(
+            m_nlist_handle,
+            &NeighborList::getNListArray,
+            m_nlist.getNListArray().getNumElements());
+        }
+
+    /// True when each pair is stored only once
+    bool isHalfNList()
+        {
+        return m_nlist.getStorageMode() == NeighborList::half;
+        }
+
+    protected:
+    void clear()
+        {
+        m_head_list_handle.reset(nullptr);
+        m_n_neigh_handle.reset(nullptr);
+        m_nlist_handle.reset(nullptr);
+        }
+
+    private:
+    NeighborList& m_nlist;
+    ParticleData& m_pdata;
+    std::unique_ptr<ArrayHandle<unsigned int>> m_head_list_handle;
+    std::unique_ptr<ArrayHandle<unsigned int>> m_n_neigh_handle;
+    std::unique_ptr<ArrayHandle<unsigned int>> m_nlist_handle;
+    };
+
 //! Exports NeighborList to python
 void export_NeighborList(pybind11::module& m);
 
+/// Export local access to NeighborList
+template<class Output> void export_LocalNeighborListData(pybind11::module& m, std::string name)
+    {
+    pybind11::class_<LocalNeighborListData<Output>, std::shared_ptr<LocalNeighborListData<Output>>>(
+        m,
+        name.c_str())
+        .def(pybind11::init<NeighborList&, ParticleData&>())
+        .def("getHeadList", &LocalNeighborListData<Output>::getHeadList)
+        .def("getNNeigh", &LocalNeighborListData<Output>::getNNeigh)
+        .def("getNList", &LocalNeighborListData<Output>::getNList)
+        .def("isHalfNList", &LocalNeighborListData<Output>::isHalfNList)
+        .def("enter", &LocalNeighborListData<Output>::enter)
+        .def("exit", &LocalNeighborListData<Output>::exit);
+    }
+
 #endif
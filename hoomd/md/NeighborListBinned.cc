@@ -13,18 +13,27 @@
 #include "hoomd/Communicator.h"
 #endif
 
+#ifdef ENABLE_TBB
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#endif
+
 using namespace std;
 namespace py = pybind11;
 
 NeighborListBinned::NeighborListBinned(std::shared_ptr<SystemDefinition> sysdef, Scalar r_buff)
-    : NeighborList(sysdef, r_buff), m_cl(std::make_shared<CellList>(sysdef))
+    : NeighborList(sysdef, r_buff)
     {
     m_exec_conf->msg->notice(5) << "Constructing NeighborListBinned" << endl;
 
-    m_cl->setRadius(1);
-    m_cl->setComputeXYZF(true);
-    m_cl->setComputeTDB(false);
-    m_cl->setFlagIndex();
+    // the cell list is requested on the first build, when the width is known
+    m_cl_request.radius = 1;
+    m_cl_request.compute_xyzf = true;
+    m_cl_request.compute_tdb = false;
+    m_cl_request.flag = CellListRequest::flag_index;
+
+    // excluded pairs are skipped in buildNlist()
+    m_exclusions_in_build = true;
     }
 
 NeighborListBinned::~NeighborListBinned()
@@ -32,7 +41,7 @@ NeighborListBinned::~NeighborListBinned()
     m_exec_conf->msg->notice(5) << "Destroying NeighborListBinned" << endl;
     }
 
-void NeighborListBinned::buildNlist(uint64_t timestep)
+void NeighborListBinned::updateCellList(uint64_t timestep)
     {
     // update the cell list size if needed
     if (m_update_cell_size)
@@ -41,11 +50,23 @@ void NeighborListBinned::buildNlist(uint64_t timestep)
         if (m_diameter_shift)
             rmax += m_d_max - Scalar(1.0);
 
-        m_cl->setNominalWidth(rmax);
+        // other computes that need the same cell list share it
+        m_cl_request.nominal_width = rmax;
+        m_cl_request.max_width = rmax;
+        m_cl = m_sysdef->getCellList(m_cl_request);
+#ifdef ENABLE_MPI
+        if (m_comm)
+            m_cl->setCommunicator(m_comm);
+#endif
         m_update_cell_size = false;
         }
 
     m_cl->compute(timestep);
+    }
+
+void NeighborListBinned::buildNlist(uint64_t timestep)
+    {
+    updateCellList(timestep);
 
     uint3 dim = m_cl->getDim();
     Scalar3 ghost_width = m_cl->getGhostWidth();
@@ -61,6 +82,7 @@ void NeighborListBinned::buildNlist(uint64_t timestep)
     ArrayHandle<Scalar> h_diameter(m_pdata->getDiameters(),
                                    access_location::host,
                                    access_mode::read);
+    ArrayHandle<unsigned int> h_tag(m_pdata->getTags(), access_location::host, access_mode::read);
 
     const BoxDim& box = m_pdata->getBox();
 
@@ -88,6 +110,12 @@ void NeighborListBinned::buildNlist(uint64_t timestep)
     ArrayHandle<unsigned int> h_nlist(m_nlist, access_location::host, access_mode::overwrite);
     ArrayHandle<unsigned int> h_n_neigh(m_n_neigh, access_location::host, access_mode::overwrite);
 
+    // access the exclusion list
+    ArrayHandle<unsigned int> h_n_ex_idx(m_n_ex_idx, access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_ex_list_idx(m_ex_list_idx,
+                                            access_location::host,
+                                            access_mode::read);
+
     // access indexers
     Index3D ci = m_cl->getCellIndexer();
     Index2D cli = m_cl->getCellListIndexer();
@@ -96,21 +124,259 @@ void NeighborListBinned::buildNlist(uint64_t timestep)
     // get periodic flags
     uchar3 periodic = box.getPeriodic();
 
+    // gather the data read by every particle
+    BuildArgs args;
+    args.pos = h_pos.data;
+    args.body = h_body.data;
+    args.diameter = h_diameter.data;
+    args.tag = h_tag.data;
+    args.r_cut = h_r_cut.data;
+    args.r_listsq = h_r_listsq.data;
+    args.cell_size = h_cell_size.data;
+    args.cell_xyzf = h_cell_xyzf.data;
+    args.cell_adj = h_cell_adj.data;
+    args.head_list = h_head_list.data;
+    args.Nmax = h_Nmax.data;
+    args.nlist = h_nlist.data;
+    args.n_neigh = h_n_neigh.data;
+    args.n_ex_idx = h_n_ex_idx.data;
+    args.ex_list_idx = h_ex_list_idx.data;
+    args.box = box;
+    args.ghost_width = ghost_width;
+    args.dim = dim;
+    args.periodic = periodic;
+    args.ci = ci;
+    args.cli = cli;
+    args.cadji = cadji;
+
     // for each local particle
     unsigned int nparticles = m_pdata->getN();
 
-    for (int i = 0; i < (int)nparticles; i++)
+#ifdef ENABLE_TBB
+    ThreadConditions thread_conditions(std::vector<unsigned int>(m_pdata->getNTypes(), 0));
+
+    m_exec_conf->getTaskArena()->execute(
+        [&]
         {
-        unsigned int cur_n_neigh = 0;
+            tbb::parallel_for(tbb::blocked_range<unsigned int>(0, nparticles),
+                              [&](const tbb::blocked_range<unsigned int>& r)
+                              {
+                                  unsigned int* conditions = thread_conditions.local().data();
+                                  for (unsigned int i = r.begin(); i != r.end(); ++i)
+                                      buildNlistParticle(i, args, conditions);
+                              });
+        });
+
+    reduceThreadConditions(thread_conditions, h_conditions.data);
+#else
+    for (unsigned int i = 0; i < nparticles; i++)
+        buildNlistParticle(i, args, h_conditions.data);
+#endif
+
+    if (m_prof)
+        m_prof->pop(m_exec_conf);
+    }
+
+/*! \param i Index of the particle
+    \param args Host pointers and indexers of this build
+    \param conditions Overflow conditions to update, one array per thread in parallel builds
+
+    Writes the neighbors of particle i to its own row of the list. Rows of different particles do
+    not overlap, so particles can be processed concurrently.
+*/
+void NeighborListBinned::buildNlistParticle(unsigned int i,
+                                            const BuildArgs& args,
+                                            unsigned int* conditions)
+    {
+    unsigned int cur_n_neigh = 0;
+
+    const Scalar3 my_pos = make_scalar3(args.pos[i].x, args.pos[i].y, args.pos[i].z);
+    const unsigned int type_i = __scalar_as_int(args.pos[i].w);
+    const unsigned int body_i = args.body[i];
+    const Scalar diam_i = args.diameter[i];
+
+    const unsigned int Nmax_i = args.Nmax[type_i];
+    const unsigned int head_idx_i = args.head_list[i];
+
+    // find the bin each particle belongs in
+    Scalar3 f = args.box.makeFraction(my_pos, args.ghost_width);
+    int ib = (unsigned int)(f.x * args.dim.x);
+    int jb = (unsigned int)(f.y * args.dim.y);
+    int kb = (unsigned int)(f.z * args.dim.z);
+
+    // need to handle the case where the particle is exactly at the box hi
+    if (ib == (int)args.dim.x && args.periodic.x)
+        ib = 0;
+    if (jb == (int)args.dim.y && args.periodic.y)
+        jb = 0;
+    if (kb == (int)args.dim.z && args.periodic.z)
+        kb = 0;
+
+    // identify the bin
+    unsigned int my_cell = args.ci(ib, jb, kb);
+
+    // loop through all neighboring bins
+    for (unsigned int cur_adj = 0; cur_adj < args.cadji.getW(); cur_adj++)
+        {
+        unsigned int neigh_cell = args.cell_adj[args.cadji(cur_adj, my_cell)];
+
+        // check against all the particles in that neighboring bin to see if it is a neighbor
+        unsigned int size = args.cell_size[neigh_cell];
+        for (unsigned int cur_offset = 0; cur_offset < size; cur_offset++)
+            {
+            const Scalar4& cur_xyzf = args.cell_xyzf[args.cli(cur_offset, neigh_cell)];
+            unsigned int cur_neigh = __scalar_as_int(cur_xyzf.w);
+
+            // get the current neighbor type from the position data (will use tdb on the GPU)
+            unsigned int cur_neigh_type = __scalar_as_int(args.pos[cur_neigh].w);
+            Scalar r_cut = args.r_cut[m_typpair_idx(type_i, cur_neigh_type)];
+
+            // automatically exclude particles without a distance check when:
+            // (1) they are the same particle, or
+            // (2) the r_cut(i,j) indicates to skip, or
+            // (3) they are in the same body
+            bool excluded = ((i == cur_neigh) || (r_cut <= Scalar(0.0)));
+            if (m_filter_body && body_i != NO_BODY)
+                excluded = excluded | (body_i == args.body[cur_neigh]);
+            if (excluded)
+                continue;
+
+            Scalar3 neigh_pos = make_scalar3(cur_xyzf.x, cur_xyzf.y, cur_xyzf.z);
+            Scalar3 dx = my_pos - neigh_pos;
+            dx = args.box.minImage(dx);
+
+            Scalar r_list = r_cut + m_r_buff;
+            Scalar sqshift = Scalar(0.0);
+            if (m_diameter_shift)
+                {
+                const Scalar delta
+                    = (diam_i + args.diameter[cur_neigh]) * Scalar(0.5) - Scalar(1.0);
+                // r^2 < (r_list + delta)^2
+                // r^2 < r_listsq + delta^2 + 2*r_list*delta
+                sqshift = (delta + Scalar(2.0) * r_list) * delta;
+                }
 
+            Scalar dr_sq = dot(dx, dx);
+
+            // move the squared rlist by the diameter shift if necessary
+            Scalar r_listsq = args.r_listsq[m_typpair_idx(type_i, cur_neigh_type)];
+            if (dr_sq <= (r_listsq + sqshift) && !excluded)
+                {
+                // skip excluded pairs here instead of filtering the list after the build
+                if (m_exclusions_set
+                    && isExcludedInBuild(i, cur_neigh, args.tag, args.n_ex_idx, args.ex_list_idx))
+                    continue;
+
+                if (m_storage_mode == full || i < cur_neigh)
+                    {
+                    // local neighbor
+                    if (cur_n_neigh < Nmax_i)
+                        {
+                        args.nlist[head_idx_i + cur_n_neigh] = cur_neigh;
+                        }
+                    else
+                        conditions[type_i] = max(conditions[type_i], cur_n_neigh + 1);
+
+                    cur_n_neigh++;
+                    }
+                }
+            }
+        }
+
+    args.n_neigh[i] = cur_n_neigh;
+    }
+
+/*! Add \a j to the row of \a i unless it is already present
+    \returns false when the row of \a i is full
+*/
+static inline bool insertNeighbor(unsigned int i,
+                                  unsigned int j,
+                                  const Scalar4* pos,
+                                  unsigned int* nlist,
+                                  unsigned int* n_neigh,
+                                  const unsigned int* head_list,
+                                  const unsigned int* Nmax)
+    {
+    const unsigned int head_idx_i = head_list[i];
+    const unsigned int n_neigh_i = n_neigh[i];
+    for (unsigned int k = 0; k < n_neigh_i; k++)
+        {
+        if (nlist[head_idx_i + k] == j)
+            return true;
+        }
+
+    if (n_neigh_i >= Nmax[__scalar_as_int(pos[i].w)])
+        return false;
+
+    nlist[head_idx_i + n_neigh_i] = j;
+    n_neigh[i] = n_neigh_i + 1;
+    return true;
+    }
+
+/*! \param timestep Current time step
+    \param moved Local indices of particles that have moved past the skin since the last full build
+    \returns false when a row is full and the list must be rebuilt
+
+    Adds every pair within r_list of a moved particle that is not already in the list. Pairs
+    between two particles that have both stayed within the skin are still covered by the last full
+    build, and pairs that have left r_list are harmless, so no entries are removed. Excluded pairs
+    are skipped as in buildNlist().
+*/
+bool NeighborListBinned::updateNlistIncremental(uint64_t timestep,
+                                                const std::vector<unsigned int>& moved)
+    {
+    updateCellList(timestep);
+
+    uint3 dim = m_cl->getDim();
+    Scalar3 ghost_width = m_cl->getGhostWidth();
+
+    ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_body(m_pdata->getBodies(),
+                                     access_location::host,
+                                     access_mode::read);
+    ArrayHandle<Scalar> h_diameter(m_pdata->getDiameters(),
+                                   access_location::host,
+                                   access_mode::read);
+    ArrayHandle<unsigned int> h_tag(m_pdata->getTags(), access_location::host, access_mode::read);
+
+    const BoxDim& box = m_pdata->getBox();
+
+    ArrayHandle<Scalar> h_r_cut(m_r_cut, access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_r_listsq(m_r_listsq, access_location::host, access_mode::read);
+
+    ArrayHandle<unsigned int> h_cell_size(m_cl->getCellSizeArray(),
+                                          access_location::host,
+                                          access_mode::read);
+    ArrayHandle<Scalar4> h_cell_xyzf(m_cl->getXYZFArray(),
+                                     access_location::host,
+                                     access_mode::read);
+    ArrayHandle<unsigned int> h_cell_adj(m_cl->getCellAdjArray(),
+                                         access_location::host,
+                                         access_mode::read);
+
+    ArrayHandle<unsigned int> h_head_list(m_head_list, access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_Nmax(m_Nmax, access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_nlist(m_nlist, access_location::host, access_mode::readwrite);
+    ArrayHandle<unsigned int> h_n_neigh(m_n_neigh, access_location::host, access_mode::readwrite);
+
+    ArrayHandle<unsigned int> h_n_ex_idx(m_n_ex_idx, access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_ex_list_idx(m_ex_list_idx,
+                                            access_location::host,
+                                            access_mode::read);
+
+    Index3D ci = m_cl->getCellIndexer();
+    Index2D cli = m_cl->getCellListIndexer();
+    Index2D cadji = m_cl->getCellAdjIndexer();
+
+    uchar3 periodic = box.getPeriodic();
+
+    for (unsigned int i : moved)
+        {
         const Scalar3 my_pos = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
         const unsigned int type_i = __scalar_as_int(h_pos.data[i].w);
         const unsigned int body_i = h_body.data[i];
         const Scalar diam_i = h_diameter.data[i];
 
-        const unsigned int Nmax_i = h_Nmax.data[type_i];
-        const unsigned int head_idx_i = h_head_list.data[i];
-
         // find the bin each particle belongs in
         Scalar3 f = box.makeFraction(my_pos, ghost_width);
         int ib = (unsigned int)(f.x * dim.x);
@@ -125,30 +391,23 @@ void NeighborListBinned::buildNlist(uint64_t timestep)
         if (kb == (int)dim.z && periodic.z)
             kb = 0;
 
-        // identify the bin
         unsigned int my_cell = ci(ib, jb, kb);
 
-        // loop through all neighboring bins
         for (unsigned int cur_adj = 0; cur_adj < cadji.getW(); cur_adj++)
             {
             unsigned int neigh_cell = h_cell_adj.data[cadji(cur_adj, my_cell)];
 
-            // check against all the particles in that neighboring bin to see if it is a neighbor
             unsigned int size = h_cell_size.data[neigh_cell];
             for (unsigned int cur_offset = 0; cur_offset < size; cur_offset++)
                 {
                 Scalar4& cur_xyzf = h_cell_xyzf.data[cli(cur_offset, neigh_cell)];
                 unsigned int cur_neigh = __scalar_as_int(cur_xyzf.w);
 
-                // get the current neighbor type from the position data (will use tdb on the GPU)
                 unsigned int cur_neigh_type = __scalar_as_int(h_pos.data[cur_neigh].w);
                 Scalar r_cut = h_r_cut.data[m_typpair_idx(type_i, cur_neigh_type)];
 
-                // automatically exclude particles without a distance check when:
-                // (1) they are the same particle, or
-                // (2) the r_cut(i,j) indicates to skip, or
-                // (3) they are in the same body
-                bool excluded = ((i == (int)cur_neigh) || (r_cut <= Scalar(0.0)));
+                // same automatic exclusions as buildNlist()
+                bool excluded = ((i == cur_neigh) || (r_cut <= Scalar(0.0)));
                 if (m_filter_body && body_i != NO_BODY)
                     excluded = excluded | (body_i == h_body.data[cur_neigh]);
                 if (excluded)
@@ -164,39 +423,59 @@ void NeighborListBinned::buildNlist(uint64_t timestep)
                     {
                     const Scalar delta
                         = (diam_i + h_diameter.data[cur_neigh]) * Scalar(0.5) - Scalar(1.0);
-                    // r^2 < (r_list + delta)^2
-                    // r^2 < r_listsq + delta^2 + 2*r_list*delta
                     sqshift = (delta + Scalar(2.0) * r_list) * delta;
                     }
 
                 Scalar dr_sq = dot(dx, dx);
-
-                // move the squared rlist by the diameter shift if necessary
                 Scalar r_listsq = h_r_listsq.data[m_typpair_idx(type_i, cur_neigh_type)];
-                if (dr_sq <= (r_listsq + sqshift) && !excluded)
+                if (dr_sq > (r_listsq + sqshift))
+                    continue;
+
+                // exclusions are symmetric, so the list of i covers the pair in either row
+                if (m_exclusions_set
+                    && isExcludedInBuild(i,
+                                         cur_neigh,
+                                         h_tag.data,
+                                         h_n_ex_idx.data,
+                                         h_ex_list_idx.data))
+                    continue;
+
+                bool inserted;
+                if (m_storage_mode == full)
                     {
-                    if (m_storage_mode == full || i < (int)cur_neigh)
-                        {
-                        // local neighbor
-                        if (cur_n_neigh < Nmax_i)
-                            {
-                            h_nlist.data[head_idx_i + cur_n_neigh] = cur_neigh;
-                            }
-                        else
-                            h_conditions.data[type_i]
-                                = max(h_conditions.data[type_i], cur_n_neigh + 1);
-
-                        cur_n_neigh++;
-                        }
+                    inserted = insertNeighbor(i,
+                                              cur_neigh,
+                                              h_pos.data,
+                                              h_nlist.data,
+                                              h_n_neigh.data,
+                                              h_head_list.data,
+                                              h_Nmax.data)
+                               && insertNeighbor(cur_neigh,
+                                                 i,
+                                                 h_pos.data,
+                                                 h_nlist.data,
+                                                 h_n_neigh.data,
+                                                 h_head_list.data,
+                                                 h_Nmax.data);
                     }
+                else
+                    {
+                    inserted = insertNeighbor(std::min(i, cur_neigh),
+                                              std::max(i, cur_neigh),
+                                              h_pos.data,
+                                              h_nlist.data,
+                                              h_n_neigh.data,
+                                              h_head_list.data,
+                                              h_Nmax.data);
+                    }
+
+                if (!inserted)
+                    return false;
                 }
             }
-
-        h_n_neigh.data[i] = cur_n_neigh;
         }
 
-    if (m_prof)
-        m_prof->pop(m_exec_conf);
+    return true;
     }
 
 void export_NeighborListBinned(py::module& m)
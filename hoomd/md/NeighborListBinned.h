@@ -43,13 +43,14 @@ class PYBIND11_EXPORT NeighborListBinned : public NeighborList
     /// Make the neighborlist deterministic
     void setDeterministic(bool deterministic)
         {
-        m_cl->setSortCellList(deterministic);
+        m_cl_request.sort = deterministic;
+        m_update_cell_size = true;
         }
 
     /// Get the deterministic flag
-    bool getDeterministic()
+    virtual bool getDeterministic()
         {
-        return m_cl->getSortCellList();
+        return m_cl_request.sort;
         }
 
 #ifdef ENABLE_MPI
@@ -60,19 +61,58 @@ class PYBIND11_EXPORT NeighborListBinned : public NeighborList
         NeighborList::setCommunicator(comm);
 
         // set the communicator on the internal cell list
-        m_cl->setCommunicator(comm);
+        if (m_cl)
+            m_cl->setCommunicator(comm);
         }
 
 #endif
 
     protected:
-    std::shared_ptr<CellList> m_cl; //!< The cell list
+    std::shared_ptr<CellList> m_cl; //!< The cell list, shared with compatible computes
+    CellListRequest m_cl_request;   //!< Configuration of the cell list
 
-    /// Track when the cell size needs to be updated
+    /// Track when the cell list needs to be requested again
     bool m_update_cell_size = true;
 
     //! Builds the neighbor list
     virtual void buildNlist(uint64_t timestep);
+
+    //! Update the rows of moved particles in place
+    virtual bool updateNlistIncremental(uint64_t timestep, const std::vector<unsigned int>& moved);
+
+    //! Resize and compute the cell list
+    void updateCellList(uint64_t timestep);
+
+    private:
+    //! Host pointers and indexers shared by the particles of one build
+    struct BuildArgs
+        {
+        const Scalar4* pos;              //!< Particle positions and types
+        const unsigned int* body;        //!< Particle bodies
+        const Scalar* diameter;          //!< Particle diameters
+        const unsigned int* tag;         //!< Particle tags
+        const Scalar* r_cut;             //!< Cutoff radius of each type pair
+        const Scalar* r_listsq;          //!< List radius squared of each type pair
+        const unsigned int* cell_size;   //!< Number of members of each cell
+        const Scalar4* cell_xyzf;        //!< Positions and indices of the cell members
+        const unsigned int* cell_adj;    //!< Adjacent cells of each cell
+        const unsigned int* head_list;   //!< Index of the first neighbor of each particle
+        const unsigned int* Nmax;        //!< Maximum number of neighbors of each type
+        unsigned int* nlist;             //!< Neighbor list
+        unsigned int* n_neigh;           //!< Number of neighbors of each particle
+        const unsigned int* n_ex_idx;    //!< Number of exclusions of each particle
+        const unsigned int* ex_list_idx; //!< Excluded particles of each particle
+        BoxDim box;                      //!< Local simulation box
+        Scalar3 ghost_width;             //!< Width of the ghost layer
+        uint3 dim;                       //!< Number of cells in each direction
+        uchar3 periodic;                 //!< Periodic flags of the box
+        Index3D ci;                      //!< Indexes the cells
+        Index2D cli;                     //!< Indexes the cell members
+        Index2D cadji;                   //!< Indexes the adjacent cells
+        };
+
+    //! Find the neighbors of one particle
+    void buildNlistParticle(unsigned int i, const BuildArgs& args, unsigned int* conditions);
     };
 
 //! Exports NeighborListBinned to python
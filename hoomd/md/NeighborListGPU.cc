@@ -182,6 +182,112 @@ void NeighborListGPU::filterNlist()
         m_prof->pop(m_exec_conf);
     }
 
+/*! Calls gpu_nlist_sort_by_type() to order the neighbors of each particle by type on the GPU
+ */
+void NeighborListGPU::sortNlistByType()
+    {
+    if (m_prof)
+        m_prof->push(m_exec_conf, "sort");
+
+    ArrayHandle<unsigned int> d_nlist(m_nlist, access_location::device, access_mode::readwrite);
+    ArrayHandle<unsigned int> d_n_neigh(m_n_neigh, access_location::device, access_mode::read);
+    ArrayHandle<unsigned int> d_head_list(m_head_list, access_location::device, access_mode::read);
+    ArrayHandle<Scalar4> d_pos(m_pdata->getPositions(), access_location::device, access_mode::read);
+
+    m_tuner_sort->begin();
+    gpu_nlist_sort_by_type(d_nlist.data,
+                           d_n_neigh.data,
+                           d_head_list.data,
+                           d_pos.data,
+                           m_pdata->getN(),
+                           m_tuner_sort->getParam());
+    if (m_exec_conf->isCUDAErrorCheckingEnabled())
+        CHECK_CUDA_ERROR();
+    m_tuner_sort->end();
+
+    if (m_prof)
+        m_prof->pop(m_exec_conf);
+    }
+
+void NeighborListGPU::compressNlist()
+    {
+    if (!m_compressed)
+        {
+        // release the compressed copy so consumers fall back to the full list
+        if (!m_nlist_delta.isNull())
+            {
+            GlobalArray<uint16_t> nlist_delta;
+            m_nlist_delta.swap(nlist_delta);
+            }
+        return;
+        }
+
+    if (m_nlist_delta.getNumElements() != m_nlist.getNumElements())
+        {
+        GlobalArray<uint16_t> nlist_delta(m_nlist.getNumElements(), m_exec_conf);
+        m_nlist_delta.swap(nlist_delta);
+        TAG_ALLOCATION(m_nlist_delta);
+        }
+
+    if (m_prof)
+        m_prof->push(m_exec_conf, "compress");
+
+    ArrayHandle<uint16_t> d_nlist_delta(m_nlist_delta,
+                                        access_location::device,
+                                        access_mode::overwrite);
+    ArrayHandle<unsigned int> d_nlist(m_nlist, access_location::device, access_mode::read);
+    ArrayHandle<unsigned int> d_n_neigh(m_n_neigh, access_location::device, access_mode::read);
+    ArrayHandle<unsigned int> d_head_list(m_head_list, access_location::device, access_mode::read);
+
+    m_tuner_compress->begin();
+    gpu_nlist_compress(d_nlist_delta.data,
+                       d_nlist.data,
+                       d_n_neigh.data,
+                       d_head_list.data,
+                       m_pdata->getN(),
+                       m_tuner_compress->getParam());
+    if (m_exec_conf->isCUDAErrorCheckingEnabled())
+        CHECK_CUDA_ERROR();
+    m_tuner_compress->end();
+
+    if (m_prof)
+        m_prof->pop(m_exec_conf);
+    }
+
+void NeighborListGPU::buildBoundaryList()
+    {
+    const unsigned int N = m_pdata->getN();
+
+        {
+        ArrayHandle<unsigned int> d_boundary_list(m_boundary_list,
+                                                  access_location::device,
+                                                  access_mode::overwrite);
+        ArrayHandle<unsigned int> d_counts(m_boundary_counts,
+                                           access_location::device,
+                                           access_mode::overwrite);
+        ArrayHandle<unsigned int> d_nlist(m_nlist, access_location::device, access_mode::read);
+        ArrayHandle<unsigned int> d_n_neigh(m_n_neigh, access_location::device, access_mode::read);
+        ArrayHandle<unsigned int> d_head_list(m_head_list,
+                                              access_location::device,
+                                              access_mode::read);
+
+        m_tuner_boundary->begin();
+        gpu_nlist_build_boundary_list(d_boundary_list.data,
+                                      d_counts.data,
+                                      d_nlist.data,
+                                      d_n_neigh.data,
+                                      d_head_list.data,
+                                      N,
+                                      m_tuner_boundary->getParam());
+        if (m_exec_conf->isCUDAErrorCheckingEnabled())
+            CHECK_CUDA_ERROR();
+        m_tuner_boundary->end();
+        }
+
+    ArrayHandle<unsigned int> h_counts(m_boundary_counts, access_location::host, access_mode::read);
+    m_n_interior = h_counts.data[0];
+    }
+
 //! Update the exclusion list on the GPU
 void NeighborListGPU::updateExListIdx()
     {
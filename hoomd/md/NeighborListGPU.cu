@@ -483,3 +483,217 @@ hipError_t gpu_nlist_build_head_list(unsigned int* d_head_list,
 
     return hipSuccess;
     }
+
+/*! \param d_nlist Neighbor list to reorder
+    \param d_n_neigh Number of neighbors of each particle
+    \param d_head_list Head list indexes for \a d_nlist
+    \param d_pos Particle positions and types
+    \param N Number of particles
+
+    One thread is run for each particle. The thread insertion sorts the neighbors of its particle
+    by (type, index). Each neighbor list is short and the sort runs only after a build, so the
+    quadratic cost is small compared to the build itself.
+*/
+__global__ void gpu_nlist_sort_by_type_kernel(unsigned int* d_nlist,
+                                              const unsigned int* d_n_neigh,
+                                              const unsigned int* d_head_list,
+                                              const Scalar4* d_pos,
+                                              const unsigned int N)
+    {
+    // compute the particle index this thread operates on
+    const unsigned int idx = blockDim.x * blockIdx.x + threadIdx.x;
+
+    // quit now if this thread is processing past the end of the particle list
+    if (idx >= N)
+        return;
+
+    const unsigned int n_neigh = d_n_neigh[idx];
+    unsigned int* nlist = d_nlist + d_head_list[idx];
+    for (unsigned int i = 1; i < n_neigh; i++)
+        {
+        const unsigned int cur_j = nlist[i];
+        const unsigned int cur_type = __scalar_as_int(__ldg(d_pos + cur_j).w);
+
+        unsigned int k = i;
+        while (k > 0)
+            {
+            const unsigned int prev_j = nlist[k - 1];
+            const unsigned int prev_type = __scalar_as_int(__ldg(d_pos + prev_j).w);
+            if (prev_type < cur_type || (prev_type == cur_type && prev_j < cur_j))
+                break;
+            nlist[k] = prev_j;
+            k--;
+            }
+        nlist[k] = cur_j;
+        }
+    }
+
+hipError_t gpu_nlist_sort_by_type(unsigned int* d_nlist,
+                                  const unsigned int* d_n_neigh,
+                                  const unsigned int* d_head_list,
+                                  const Scalar4* d_pos,
+                                  const unsigned int N,
+                                  const unsigned int block_size)
+    {
+    static unsigned int max_block_size = UINT_MAX;
+    if (max_block_size == UINT_MAX)
+        {
+        hipFuncAttributes attr;
+        hipFuncGetAttributes(&attr, (const void*)gpu_nlist_sort_by_type_kernel);
+        max_block_size = attr.maxThreadsPerBlock;
+        }
+
+    unsigned int run_block_size = min(block_size, max_block_size);
+
+    hipLaunchKernelGGL((gpu_nlist_sort_by_type_kernel),
+                       dim3(N / run_block_size + 1),
+                       dim3(run_block_size),
+                       0,
+                       0,
+                       d_nlist,
+                       d_n_neigh,
+                       d_head_list,
+                       d_pos,
+                       N);
+
+    return hipSuccess;
+    }
+
+/*! \param d_nlist_delta Compressed neighbor list to write
+    \param d_nlist Full neighbor list
+    \param d_n_neigh Number of neighbors of each particle
+    \param d_head_list Head list indexes for \a d_nlist and \a d_nlist_delta
+    \param N Number of particles
+
+    One thread is run for each particle. Each neighbor j of particle i is stored as the 16-bit
+    signed delta j - i, or as NLIST_DELTA_ESCAPE when the delta does not fit.
+*/
+__global__ void gpu_nlist_compress_kernel(uint16_t* d_nlist_delta,
+                                          const unsigned int* d_nlist,
+                                          const unsigned int* d_n_neigh,
+                                          const unsigned int* d_head_list,
+                                          const unsigned int N)
+    {
+    // compute the particle index this thread operates on
+    const unsigned int idx = blockDim.x * blockIdx.x + threadIdx.x;
+
+    // quit now if this thread is processing past the end of the particle list
+    if (idx >= N)
+        return;
+
+    const unsigned int n_neigh = d_n_neigh[idx];
+    const unsigned int my_head = d_head_list[idx];
+    for (unsigned int cur_neigh_idx = 0; cur_neigh_idx < n_neigh; cur_neigh_idx++)
+        {
+        const int delta = int(d_nlist[my_head + cur_neigh_idx]) - int(idx);
+        d_nlist_delta[my_head + cur_neigh_idx]
+            = (delta > -32768 && delta < 32768) ? uint16_t(delta) : NLIST_DELTA_ESCAPE;
+        }
+    }
+
+hipError_t gpu_nlist_compress(uint16_t* d_nlist_delta,
+                              const unsigned int* d_nlist,
+                              const unsigned int* d_n_neigh,
+                              const unsigned int* d_head_list,
+                              const unsigned int N,
+                              const unsigned int block_size)
+    {
+    static unsigned int max_block_size = UINT_MAX;
+    if (max_block_size == UINT_MAX)
+        {
+        hipFuncAttributes attr;
+        hipFuncGetAttributes(&attr, (const void*)gpu_nlist_compress_kernel);
+        max_block_size = attr.maxThreadsPerBlock;
+        }
+
+    unsigned int run_block_size = min(block_size, max_block_size);
+
+    hipLaunchKernelGGL((gpu_nlist_compress_kernel),
+                       dim3(N / run_block_size + 1),
+                       dim3(run_block_size),
+                       0,
+                       0,
+                       d_nlist_delta,
+                       d_nlist,
+                       d_n_neigh,
+                       d_head_list,
+                       N);
+
+    return hipSuccess;
+    }
+
+/*! \param d_boundary_list List of local particle indices to write
+    \param d_counts Number of interior (0) and boundary (1) particles written, must be zeroed
+    \param d_nlist Neighbor list
+    \param d_n_neigh Number of neighbors of each particle
+    \param d_head_list Head list indexes for \a d_nlist
+    \param N Number of local particles
+
+    One thread is run for each particle. Particles without ghost neighbors are appended to the
+    front of \a d_boundary_list and all others to the back, in no particular order.
+*/
+__global__ void gpu_nlist_build_boundary_list_kernel(unsigned int* d_boundary_list,
+                                                     unsigned int* d_counts,
+                                                     const unsigned int* d_nlist,
+                                                     const unsigned int* d_n_neigh,
+                                                     const unsigned int* d_head_list,
+                                                     const unsigned int N)
+    {
+    // compute the particle index this thread operates on
+    const unsigned int idx = blockDim.x * blockIdx.x + threadIdx.x;
+
+    // quit now if this thread is processing past the end of the particle list
+    if (idx >= N)
+        return;
+
+    const unsigned int n_neigh = d_n_neigh[idx];
+    const unsigned int my_head = d_head_list[idx];
+    bool boundary = false;
+    for (unsigned int cur_neigh_idx = 0; cur_neigh_idx < n_neigh; cur_neigh_idx++)
+        {
+        if (d_nlist[my_head + cur_neigh_idx] >= N)
+            {
+            boundary = true;
+            break;
+            }
+        }
+
+    if (boundary)
+        d_boundary_list[N - 1 - atomicAdd(&d_counts[1], 1)] = idx;
+    else
+        d_boundary_list[atomicAdd(&d_counts[0], 1)] = idx;
+    }
+
+hipError_t gpu_nlist_build_boundary_list(unsigned int* d_boundary_list,
+                                         unsigned int* d_counts,
+                                         const unsigned int* d_nlist,
+                                         const unsigned int* d_n_neigh,
+                                         const unsigned int* d_head_list,
+                                         const unsigned int N,
+                                         const unsigned int block_size)
+    {
+    static unsigned int max_block_size = UINT_MAX;
+    if (max_block_size == UINT_MAX)
+        {
+        hipFuncAttributes attr;
+        hipFuncGetAttributes(&attr, (const void*)gpu_nlist_build_boundary_list_kernel);
+        max_block_size = attr.maxThreadsPerBlock;
+        }
+
+    unsigned int run_block_size = min(block_size, max_block_size);
+
+    hipMemsetAsync(d_counts, 0, sizeof(unsigned int) * 2);
+    hipLaunchKernelGGL((gpu_nlist_build_boundary_list_kernel),
+                       dim3(N / run_block_size + 1),
+                       dim3(run_block_size),
+                       0,
+                       0,
+                       d_boundary_list,
+                       d_counts,
+                       d_nlist,
+                       d_n_neigh,
+                       d_head_list,
+                       N);
+
+    return hipSuccess;
+    }
@@ -17,6 +17,9 @@
 #include "hoomd/Index1D.h"
 #include "hoomd/ParticleData.cuh"
 
+//! Marks compressed neighbor list entries whose index must be read from the full list
+const uint16_t NLIST_DELTA_ESCAPE = 0x8000;
+
 //! Kernel driver for gpu_nlist_needs_update_check_new_kernel()
 hipError_t gpu_nlist_needs_update_check_new(unsigned int* d_result,
                                             const Scalar4* d_last_pos,
@@ -61,4 +64,51 @@ hipError_t gpu_update_exclusion_list(const unsigned int* d_tag,
                                      const Index2D& ex_list_indexer,
                                      const unsigned int N);
 
+//! Kernel driver for gpu_nlist_sort_by_type_kernel()
+hipError_t gpu_nlist_sort_by_type(unsigned int* d_nlist,
+                                  const unsigned int* d_n_neigh,
+                                  const unsigned int* d_head_list,
+                                  const Scalar4* d_pos,
+                                  const unsigned int N,
+                                  const unsigned int block_size);
+
+//! Kernel driver for gpu_nlist_compress_kernel()
+hipError_t gpu_nlist_compress(uint16_t* d_nlist_delta,
+                              const unsigned int* d_nlist,
+                              const unsigned int* d_n_neigh,
+                              const unsigned int* d_head_list,
+                              const unsigned int N,
+                              const unsigned int block_size);
+
+//! Kernel driver for gpu_nlist_build_boundary_list_kernel()
+hipError_t gpu_nlist_build_boundary_list(unsigned int* d_boundary_list,
+                                         unsigned int* d_counts,
+                                         const unsigned int* d_nlist,
+                                         const unsigned int* d_n_neigh,
+                                         const unsigned int* d_head_list,
+                                         const unsigned int N,
+                                         const unsigned int block_size);
+
+#ifdef __HIPCC__
+//! Read a neighbor index, from the compressed list when one is given
+/*! \param d_nlist Full neighbor list
+    \param d_nlist_delta Compressed neighbor list (may be NULL)
+    \param idx Index of the particle whose neighbors are read
+    \param offset Position of the neighbor in \a d_nlist
+*/
+__device__ inline unsigned int nlist_load_neighbor(const unsigned int* d_nlist,
+                                                   const uint16_t* d_nlist_delta,
+                                                   const unsigned int idx,
+                                                   const unsigned int offset)
+    {
+    if (d_nlist_delta)
+        {
+        const uint16_t delta = __ldg(d_nlist_delta + offset);
+        if (delta != NLIST_DELTA_ESCAPE)
+            return idx + (int)(int16_t)delta;
+        }
+    return __ldg(d_nlist + offset);
+    }
+#endif
+
 #endif
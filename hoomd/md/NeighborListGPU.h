@@ -96,6 +96,31 @@ class PYBIND11_EXPORT NeighborListGPU : public NeighborList
                                               100000,
                                               "nlist_head_list",
                                               this->m_exec_conf));
+        m_tuner_compress.reset(new Autotuner(warp_size,
+                                             1024,
+                                             warp_size,
+                                             5,
+                                             100000,
+                                             "nlist_compress",
+                                             this->m_exec_conf));
+        m_tuner_boundary.reset(new Autotuner(warp_size,
+                                             1024,
+                                             warp_size,
+                                             5,
+                                             100000,
+                                             "nlist_boundary",
+                                             this->m_exec_conf));
+        m_tuner_sort.reset(new Autotuner(warp_size,
+                                         1024,
+                                         warp_size,
+                                         5,
+                                         100000,
+                                         "nlist_sort_type",
+                                         this->m_exec_conf));
+
+        GlobalArray<unsigned int> boundary_counts(2, m_exec_conf);
+        std::swap(m_boundary_counts, boundary_counts);
+        TAG_ALLOCATION(m_boundary_counts);
         }
 
     //! Destructor
@@ -113,6 +138,15 @@ class PYBIND11_EXPORT NeighborListGPU : public NeighborList
 
         m_tuner_head_list->setPeriod(period / 10);
         m_tuner_head_list->setEnabled(enable);
+
+        m_tuner_compress->setPeriod(period / 10);
+        m_tuner_compress->setEnabled(enable);
+
+        m_tuner_boundary->setPeriod(period / 10);
+        m_tuner_boundary->setEnabled(enable);
+
+        m_tuner_sort->setPeriod(period / 10);
+        m_tuner_sort->setEnabled(enable);
         }
 
     //! Benchmark the filter kernel
@@ -147,6 +181,15 @@ class PYBIND11_EXPORT NeighborListGPU : public NeighborList
     //! Build the head list for neighbor list indexing on the GPU
     virtual void buildHeadList();
 
+    //! Order the neighbors of each particle by type on the GPU
+    virtual void sortNlistByType();
+
+    //! Write the 16-bit delta copy of the neighbor list on the GPU
+    virtual void compressNlist();
+
+    //! Classify the local particles by their neighbors on the GPU
+    virtual void buildBoundaryList();
+
     //! Schedule the distance check kernel
     /*! \param timestep Current time step
      */
@@ -156,6 +199,12 @@ class PYBIND11_EXPORT NeighborListGPU : public NeighborList
     private:
     std::unique_ptr<Autotuner> m_tuner_filter;    //!< Autotuner for filter block size
     std::unique_ptr<Autotuner> m_tuner_head_list; //!< Autotuner for the head list block size
+    std::unique_ptr<Autotuner> m_tuner_compress;  //!< Autotuner for the compression block size
+    std::unique_ptr<Autotuner> m_tuner_boundary;  //!< Autotuner for the boundary list block size
+    std::unique_ptr<Autotuner> m_tuner_sort;      //!< Autotuner for the type sort block size
+
+    /// Number of interior and boundary particles counted by the boundary list kernel
+    GlobalArray<unsigned int> m_boundary_counts;
 
     GlobalArray<unsigned int>
         m_alt_head_list; //!< Alternate array to hold the head list from prefix sum
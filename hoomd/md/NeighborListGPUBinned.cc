@@ -18,25 +18,26 @@ namespace py = pybind11;
 
 NeighborListGPUBinned::NeighborListGPUBinned(std::shared_ptr<SystemDefinition> sysdef,
                                              Scalar r_buff)
-    : NeighborListGPU(sysdef, r_buff), m_cl(std::make_shared<CellListGPU>(sysdef)), m_param(0)
+    : NeighborListGPU(sysdef, r_buff), m_param(0)
     {
     // with multiple GPUs, use indirect access via particle data arrays
     m_use_index = m_exec_conf->allConcurrentManagedAccess();
 
     // with multiple GPUs, request a cell list per device
-    m_cl->setPerDevice(m_exec_conf->allConcurrentManagedAccess());
+    // the cell list is requested on the first build, when the width is known
+    m_cl_request.per_device = m_exec_conf->allConcurrentManagedAccess();
 
-    m_cl->setComputeXYZF(!m_use_index);
-    m_cl->setComputeIdx(m_use_index);
+    m_cl_request.compute_xyzf = !m_use_index;
+    m_cl_request.compute_idx = m_use_index;
 
-    m_cl->setRadius(1);
-    m_cl->setComputeTDB(!m_use_index);
-    m_cl->setFlagIndex();
+    m_cl_request.radius = 1;
+    m_cl_request.compute_tdb = !m_use_index;
+    m_cl_request.flag = CellListRequest::flag_index;
 
     CHECK_CUDA_ERROR();
 
     // initialize autotuner
-    // the full block size and threads_per_particle matrix is searched,
+    // the block size and threads_per_particle matrix is searched with coordinate descent,
     // encoded as block_size*10000 + threads_per_particle
     std::vector<unsigned int> valid_params;
 
@@ -53,6 +54,7 @@ NeighborListGPUBinned::NeighborListGPUBinned(std::shared_ptr<SystemDefinition> s
         }
 
     m_tuner.reset(new Autotuner(valid_params, 5, 100000, "nlist_binned", this->m_exec_conf));
+    m_tuner->setDimensions({10000, 1});
     }
 
 NeighborListGPUBinned::~NeighborListGPUBinned() { }
@@ -73,7 +75,14 @@ void NeighborListGPUBinned::buildNlist(uint64_t timestep)
         if (m_diameter_shift)
             rmax += m_d_max - Scalar(1.0);
 
-        m_cl->setNominalWidth(rmax);
+        // other computes that need the same cell list share it
+        m_cl_request.nominal_width = rmax;
+        m_cl_request.max_width = rmax;
+        m_cl = m_sysdef->getCellList(m_cl_request);
+#ifdef ENABLE_MPI
+        if (m_comm)
+            m_cl->setCommunicator(m_comm);
+#endif
         m_update_cell_size = false;
         }
 
@@ -158,6 +167,7 @@ void NeighborListGPUBinned::buildNlist(uint64_t timestep)
 
     m_exec_conf->beginMultiGPU();
 
+    this->m_tuner->setProblemSize(m_pdata->getN());
     this->m_tuner->begin();
     unsigned int param = !m_param ? this->m_tuner->getParam() : m_param;
     unsigned int block_size = param / 10000;
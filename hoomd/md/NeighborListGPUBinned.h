@@ -64,13 +64,14 @@ class PYBIND11_EXPORT NeighborListGPUBinned : public NeighborListGPU
     /// Make the neighborlist deterministic
     void setDeterministic(bool deterministic)
         {
-        m_cl->setSortCellList(deterministic);
+        m_cl_request.sort = deterministic;
+        m_update_cell_size = true;
         }
 
     /// Get the deterministic flag
-    bool getDeterministic()
+    virtual bool getDeterministic()
         {
-        return m_cl->getSortCellList();
+        return m_cl_request.sort;
         }
 
 #ifdef ENABLE_MPI
@@ -81,18 +82,20 @@ class PYBIND11_EXPORT NeighborListGPUBinned : public NeighborListGPU
         NeighborList::setCommunicator(comm);
 
         // set the communicator on the internal cell lists
-        m_cl->setCommunicator(comm);
+        if (m_cl)
+            m_cl->setCommunicator(comm);
         }
 
 #endif
 
     protected:
-    std::shared_ptr<CellList> m_cl; //!< The cell list
+    std::shared_ptr<CellList> m_cl; //!< The cell list, shared with compatible computes
+    CellListRequest m_cl_request;   //!< Configuration of the cell list
     unsigned int m_block_size;      //!< Block size to execute on the GPU
     unsigned int m_param;           //!< Kernel tuning parameter
     bool m_use_index;               //!< True for indirect lookup of particle data via index
 
-    /// Track when the cell size needs to be updated
+    /// Track when the cell list needs to be requested again
     bool m_update_cell_size = true;
 
     std::unique_ptr<Autotuner> m_tuner; //!< Autotuner for block size and threads per particle
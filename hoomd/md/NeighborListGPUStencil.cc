@@ -41,7 +41,7 @@ NeighborListGPUStencil::NeighborListGPUStencil(std::shared_ptr<SystemDefinition>
     CHECK_CUDA_ERROR();
 
     // initialize autotuner
-    // the full block size and threads_per_particle matrix is searched,
+    // the block size and threads_per_particle matrix is searched with coordinate descent,
     // encoded as block_size*10000 + threads_per_particle
     std::vector<unsigned int> valid_params;
 
@@ -59,6 +59,7 @@ NeighborListGPUStencil::NeighborListGPUStencil(std::shared_ptr<SystemDefinition>
         }
 
     m_tuner.reset(new Autotuner(valid_params, 5, 100000, "nlist_stencil", this->m_exec_conf));
+    m_tuner->setDimensions({10000, 1});
     m_last_tuned_timestep = 0;
 
 #ifdef ENABLE_MPI
@@ -23,13 +23,16 @@ namespace py = pybind11;
  */
 NeighborListGPUTree::NeighborListGPUTree(std::shared_ptr<SystemDefinition> sysdef, Scalar r_buff)
     : NeighborListGPU(sysdef, r_buff), m_type_bits(1), m_lbvh_errors(m_exec_conf), m_n_images(0),
-      m_types_allocated(false), m_box_changed(true), m_max_num_changed(true), m_max_types(0)
+      m_trees_valid(false), m_tree_N(0), m_types_allocated(false), m_box_changed(true),
+      m_max_num_changed(true), m_max_types(0)
     {
     m_exec_conf->msg->notice(5) << "Constructing NeighborListGPUTree" << std::endl;
     m_pdata->getBoxChangeSignal()
         .connect<NeighborListGPUTree, &NeighborListGPUTree::slotBoxChanged>(this);
     m_pdata->getMaxParticleNumberChangeSignal()
         .connect<NeighborListGPUTree, &NeighborListGPUTree::slotMaxNumChanged>(this);
+    m_pdata->getParticleSortSignal()
+        .connect<NeighborListGPUTree, &NeighborListGPUTree::slotParticlesSorted>(this);
 
     hipDeviceProp_t dev_prop = m_exec_conf->dev_prop;
     unsigned int warp_size = dev_prop.warpSize;
@@ -55,6 +58,20 @@ NeighborListGPUTree::NeighborListGPUTree(std::shared_ptr<SystemDefinition> sysde
                                      100000,
                                      "nlist_tree_copy",
                                      m_exec_conf));
+    m_refit_mark_tuner.reset(new Autotuner(warp_size,
+                                           max_threads,
+                                           warp_size,
+                                           5,
+                                           100000,
+                                           "nlist_tree_refit_mark",
+                                           m_exec_conf));
+    m_refit_tuner.reset(new Autotuner(warp_size,
+                                      max_threads,
+                                      warp_size,
+                                      5,
+                                      100000,
+                                      "nlist_tree_refit",
+                                      m_exec_conf));
     }
 
 /*!
@@ -67,6 +84,8 @@ NeighborListGPUTree::~NeighborListGPUTree()
         .disconnect<NeighborListGPUTree, &NeighborListGPUTree::slotBoxChanged>(this);
     m_pdata->getMaxParticleNumberChangeSignal()
         .disconnect<NeighborListGPUTree, &NeighborListGPUTree::slotMaxNumChanged>(this);
+    m_pdata->getParticleSortSignal()
+        .disconnect<NeighborListGPUTree, &NeighborListGPUTree::slotParticlesSorted>(this);
 
     // destroy all of the created streams
     for (auto stream = m_streams.begin(); stream != m_streams.end(); ++stream)
@@ -80,7 +99,8 @@ NeighborListGPUTree::~NeighborListGPUTree()
  *
  * First, memory is reallocated based on the number of particles and types.
  * The traversal images are also updated if the box has changed. One LBVH is then
- * built for each particle type using buildTree(), and these LBVHs are traversed in
+ * built for each particle type using buildTree(), or refitted with refitTree() when the
+ * particles are the same as in the last build, and these LBVHs are traversed in
  * traverseTree().
  */
 void NeighborListGPUTree::buildNlist(uint64_t timestep)
@@ -106,6 +126,12 @@ void NeighborListGPUTree::buildNlist(uint64_t timestep)
         GPUArray<unsigned int> traverse_order(m_pdata->getMaxN(), m_exec_conf);
         m_traverse_order.swap(traverse_order);
 
+        GPUArray<unsigned int> refit_locks(m_pdata->getMaxN(), m_exec_conf);
+        m_refit_locks.swap(refit_locks);
+
+        // the sort is lost
+        m_trees_valid = false;
+
         // all done with the particle data reallocation
         m_max_num_changed = false;
         }
@@ -121,6 +147,9 @@ void NeighborListGPUTree::buildNlist(uint64_t timestep)
             GPUArray<unsigned int> type_last(m_pdata->getNTypes(), m_exec_conf);
             m_type_last.swap(type_last);
 
+            GPUArray<float> tree_cost(m_pdata->getNTypes(), m_exec_conf);
+            m_tree_cost.swap(tree_cost);
+
             m_lbvhs.resize(m_pdata->getNTypes());
             m_traversers.resize(m_pdata->getNTypes());
             m_streams.resize(m_pdata->getNTypes());
@@ -134,6 +163,9 @@ void NeighborListGPUTree::buildNlist(uint64_t timestep)
             m_max_types = m_pdata->getNTypes();
             }
 
+        // the sort is lost
+        m_trees_valid = false;
+
         /*
          * Compute the number of bits to sort, which is the number of bits needed to represent the
          * largest type index, plus 1 to account for the ghost sentinel. So, it is the number of
@@ -185,12 +217,32 @@ void NeighborListGPUTree::buildNlist(uint64_t timestep)
         m_traverse_tuner->setPeriod(m_mark_tuner->getPeriod());
         }
 
+    // refit the trees when the particles are the same as in the last build
+    bool refit = m_refit_threshold > Scalar(0.0) && m_trees_valid
+                 && m_tree_N == m_pdata->getN() && m_pdata->getNGhosts() == 0;
+#ifdef ENABLE_MPI
+    if (m_comm)
+        refit = false;
+#endif
+
+    if (refit)
+        {
+        if (m_prof)
+            m_prof->push(m_exec_conf, "refit");
+        refit = refitTree();
+        if (m_prof)
+            m_prof->pop(m_exec_conf);
+        }
+
     // build the tree
-    if (m_prof)
-        m_prof->push(m_exec_conf, "build");
-    buildTree();
-    if (m_prof)
-        m_prof->pop(m_exec_conf);
+    if (!refit)
+        {
+        if (m_prof)
+            m_prof->push(m_exec_conf, "build");
+        buildTree();
+        if (m_prof)
+            m_prof->pop(m_exec_conf);
+        }
 
     // walk with the tree
     if (m_prof)
@@ -488,6 +540,195 @@ void NeighborListGPUTree::buildTree()
             }
         hipDeviceSynchronize();
         }
+
+    // save the costs that refitted trees are compared to
+    m_trees_valid = m_refit_threshold > Scalar(0.0);
+    if (m_trees_valid)
+        {
+        m_build_cost = computeTreeCosts();
+        m_tree_N = m_pdata->getN();
+        }
+    }
+
+/*!
+ * \returns True when the LBVHs were refitted, false when the particle types changed and the LBVHs
+ *          must be built with buildTree().
+ *
+ * The particles keep their positions in the type sort and the LBVHs keep their hierarchy, only
+ * the bounding boxes are updated from the leaves to the root. Each LBVH whose cost grew beyond
+ * the refit threshold is then built again from the sorted particles of its type, without sorting
+ * the other types. Finally, the traversers are set up with the new bounding boxes.
+ */
+bool NeighborListGPUTree::refitTree()
+    {
+    const unsigned int ntypes = m_pdata->getNTypes();
+
+    // check that the particles still have the types they were sorted by
+        {
+        ArrayHandle<Scalar4> d_last_pos(m_last_pos,
+                                        access_location::device,
+                                        access_mode::overwrite);
+        ArrayHandle<Scalar4> d_pos(m_pdata->getPositions(),
+                                   access_location::device,
+                                   access_mode::read);
+        ArrayHandle<unsigned int> d_sorted_types(m_sorted_types,
+                                                 access_location::device,
+                                                 access_mode::read);
+        ArrayHandle<unsigned int> d_sorted_indexes(m_sorted_indexes,
+                                                   access_location::device,
+                                                   access_mode::read);
+        m_lbvh_errors.resetFlags(0);
+
+        m_refit_mark_tuner->begin();
+        gpu_nlist_refit_mark(m_lbvh_errors.getDeviceFlags(),
+                             d_last_pos.data,
+                             d_pos.data,
+                             d_sorted_types.data,
+                             d_sorted_indexes.data,
+                             m_pdata->getN(),
+                             m_refit_mark_tuner->getParam());
+        if (m_exec_conf->isCUDAErrorCheckingEnabled())
+            CHECK_CUDA_ERROR();
+        m_refit_mark_tuner->end();
+        }
+
+    if (m_lbvh_errors.readFlags())
+        {
+        m_trees_valid = false;
+        return false;
+        }
+
+    ArrayHandle<unsigned int> h_type_first(m_type_first, access_location::host, access_mode::read);
+    ArrayHandle<Scalar4> d_pos(m_pdata->getPositions(), access_location::device, access_mode::read);
+    ArrayHandle<unsigned int> d_sorted_indexes(m_sorted_indexes,
+                                               access_location::device,
+                                               access_mode::read);
+
+    // refit the bounding boxes of all lbvhs in their own streams
+        {
+        ArrayHandle<unsigned int> d_refit_locks(m_refit_locks,
+                                                access_location::device,
+                                                access_mode::overwrite);
+
+        hipDeviceSynchronize();
+        m_refit_tuner->begin();
+        const unsigned int block_size = m_refit_tuner->getParam();
+        for (unsigned int i = 0; i < ntypes; ++i)
+            {
+            if (m_lbvhs[i]->getN() == 0)
+                continue;
+
+            // the internal nodes of each type fit in the range of its particles
+            const unsigned int first = h_type_first.data[i];
+            m_lbvhs[i]->refit(d_pos.data,
+                              d_sorted_indexes.data + first,
+                              d_refit_locks.data + first,
+                              m_streams[i],
+                              block_size);
+            }
+        m_refit_tuner->end();
+        hipDeviceSynchronize();
+        }
+
+    // rebuild the lbvhs that have degraded too far
+    const std::vector<float> cost = computeTreeCosts();
+    std::vector<unsigned int> rebuild;
+    for (unsigned int i = 0; i < ntypes; ++i)
+        {
+        if (m_lbvhs[i]->getN() > 1 && cost[i] > m_refit_threshold * m_build_cost[i])
+            rebuild.push_back(i);
+        }
+
+    if (!rebuild.empty())
+        {
+        ArrayHandle<unsigned int> d_traverse_order(m_traverse_order,
+                                                   access_location::device,
+                                                   access_mode::readwrite);
+        const BoxDim lbvh_box = getLBVHBox();
+
+        for (unsigned int i : rebuild)
+            {
+            m_lbvhs[i]->setup(d_pos.data,
+                              d_sorted_indexes.data + h_type_first.data[i],
+                              m_lbvhs[i]->getN(),
+                              m_streams[i]);
+            }
+
+        hipDeviceSynchronize();
+        m_build_tuner->begin();
+        const unsigned int block_size = m_build_tuner->getParam();
+        for (unsigned int i : rebuild)
+            {
+            m_lbvhs[i]->build(d_pos.data,
+                              d_sorted_indexes.data + h_type_first.data[i],
+                              m_lbvhs[i]->getN(),
+                              lbvh_box.getLo(),
+                              lbvh_box.getHi(),
+                              m_streams[i],
+                              block_size);
+            }
+        m_build_tuner->end();
+        hipDeviceSynchronize();
+
+        // the leaves of the new lbvhs are in a new order
+        for (unsigned int i : rebuild)
+            {
+            const unsigned int first = h_type_first.data[i];
+            m_copy_tuner->begin();
+            gpu_nlist_copy_primitives(d_traverse_order.data + first,
+                                      d_sorted_indexes.data + first,
+                                      m_lbvhs[i]->getPrimitives(),
+                                      m_lbvhs[i]->getN(),
+                                      m_copy_tuner->getParam());
+            if (m_exec_conf->isCUDAErrorCheckingEnabled())
+                CHECK_CUDA_ERROR();
+            m_copy_tuner->end();
+            }
+
+        const std::vector<float> build_cost = computeTreeCosts();
+        for (unsigned int i : rebuild)
+            m_build_cost[i] = build_cost[i];
+        }
+
+    // the traversers compress the bounding boxes, so they are always set up again
+    hipDeviceSynchronize();
+    for (unsigned int i = 0; i < ntypes; ++i)
+        {
+        if (m_lbvhs[i]->getN() == 0)
+            continue;
+        m_traversers[i]->setup(d_sorted_indexes.data + h_type_first.data[i],
+                               *(*m_lbvhs[i]).get(),
+                               m_streams[i]);
+        }
+    hipDeviceSynchronize();
+
+    return true;
+    }
+
+/*!
+ * \returns The sum of the surface areas of the internal nodes of each LBVH.
+ *
+ * The costs of all LBVHs are computed in their own streams and copied to the host together.
+ */
+std::vector<float> NeighborListGPUTree::computeTreeCosts()
+    {
+    const unsigned int ntypes = m_pdata->getNTypes();
+        {
+        ArrayHandle<float> d_tree_cost(m_tree_cost,
+                                       access_location::device,
+                                       access_mode::overwrite);
+        hipMemset(d_tree_cost.data, 0, sizeof(float) * ntypes);
+        for (unsigned int i = 0; i < ntypes; ++i)
+            {
+            m_lbvhs[i]->addCost(d_tree_cost.data + i, m_streams[i]);
+            }
+        if (m_exec_conf->isCUDAErrorCheckingEnabled())
+            CHECK_CUDA_ERROR();
+        hipDeviceSynchronize();
+        }
+
+    ArrayHandle<float> h_tree_cost(m_tree_cost, access_location::host, access_mode::read);
+    return std::vector<float>(h_tree_cost.data, h_tree_cost.data + ntypes);
     }
 
 /*!
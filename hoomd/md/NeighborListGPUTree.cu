@@ -282,6 +282,83 @@ hipError_t gpu_nlist_count_types(unsigned int* d_first,
     return hipSuccess;
     }
 
+//! Kernel to check the particle types and save the last positions before a refit
+/*!
+ * \param d_lbvh_errors Error flag for particles whose type changed.
+ * \param d_last_pos Last position of particles at neighbor list update.
+ * \param d_pos Current position of particles.
+ * \param d_sorted_types Types of the particles at the last sort.
+ * \param d_sorted_indexes Indexes of the particles at the last sort.
+ * \param N Number of locally owned particles.
+ *
+ * One thread per entry of the sorted list loads the particle position and compares its type to the
+ * type it was sorted as. A particle that changed its type is in the wrong LBVH, so the error flag
+ * is set to request a full rebuild. The last position of each particle is saved as in
+ * gpu_nlist_mark_types_kernel().
+ */
+__global__ void gpu_nlist_refit_mark_kernel(unsigned int* d_lbvh_errors,
+                                            Scalar4* d_last_pos,
+                                            const Scalar4* d_pos,
+                                            const unsigned int* d_sorted_types,
+                                            const unsigned int* d_sorted_indexes,
+                                            const unsigned int N)
+    {
+    // one thread per particle
+    const unsigned int i = blockDim.x * blockIdx.x + threadIdx.x;
+    if (i >= N)
+        return;
+
+    const unsigned int idx = d_sorted_indexes[i];
+    const Scalar4 postype = d_pos[idx];
+    const unsigned int type = __scalar_as_int(postype.w);
+    if (type != d_sorted_types[i])
+        atomicMax(d_lbvh_errors, idx + 1);
+
+    d_last_pos[idx] = postype;
+    }
+
+/*!
+ * \param d_lbvh_errors Error flag for particles whose type changed.
+ * \param d_last_pos Last position of particles at neighbor list update.
+ * \param d_pos Current position of particles.
+ * \param d_sorted_types Types of the particles at the last sort.
+ * \param d_sorted_indexes Indexes of the particles at the last sort.
+ * \param N Number of locally owned particles.
+ * \param block_size Number of CUDA threads per block.
+ *
+ * \sa gpu_nlist_refit_mark_kernel
+ */
+hipError_t gpu_nlist_refit_mark(unsigned int* d_lbvh_errors,
+                                Scalar4* d_last_pos,
+                                const Scalar4* d_pos,
+                                const unsigned int* d_sorted_types,
+                                const unsigned int* d_sorted_indexes,
+                                const unsigned int N,
+                                const unsigned int block_size)
+    {
+    static unsigned int max_block_size = UINT_MAX;
+    if (max_block_size == UINT_MAX)
+        {
+        hipFuncAttributes attr;
+        hipFuncGetAttributes(&attr, reinterpret_cast<const void*>(gpu_nlist_refit_mark_kernel));
+        max_block_size = attr.maxThreadsPerBlock;
+        }
+
+    const unsigned int run_block_size = min(block_size, max_block_size);
+    hipLaunchKernelGGL(gpu_nlist_refit_mark_kernel,
+                       dim3(N / run_block_size + 1),
+                       dim3(run_block_size),
+                       0,
+                       0,
+                       d_lbvh_errors,
+                       d_last_pos,
+                       d_pos,
+                       d_sorted_types,
+                       d_sorted_indexes,
+                       N);
+    return hipSuccess;
+    }
+
 //! Kernel to copy the particle indexes into traversal order
 /*!
  * \param d_traverse_order List of particle indexes in traversal order.
@@ -440,6 +517,99 @@ struct PointMapInsertOp
     const unsigned int N;
     };
 
+//! Kernel to refit the bounding boxes of an LBVH to new positions
+/*!
+ * \param lo Lower bounds of the nodes.
+ * \param hi Upper bounds of the nodes.
+ * \param parent Parent of each node.
+ * \param left Left child of each internal node.
+ * \param right Right child of each internal node.
+ * \param primitives Nominal index of the primitive in each leaf.
+ * \param locks Arrival counters of the internal nodes, initially zero.
+ * \param insert Operation that constructs the bounding box of each primitive.
+ * \param root Index of the root node.
+ *
+ * The LBVH stores the N - 1 internal nodes first, followed by one leaf per primitive. One thread
+ * per leaf recomputes the leaf box and then walks towards the root. The first thread to arrive at
+ * an internal node stops, the second thread merges the boxes of both children and continues, so
+ * that every box is computed after the boxes of its children. The hierarchy is unchanged.
+ */
+__global__ void gpu_nlist_lbvh_refit_kernel(float3* lo,
+                                            float3* hi,
+                                            const int* parent,
+                                            const int* left,
+                                            const int* right,
+                                            const unsigned int* primitives,
+                                            unsigned int* locks,
+                                            const PointMapInsertOp insert,
+                                            const int root)
+    {
+    // one thread per leaf
+    const unsigned int i = blockDim.x * blockIdx.x + threadIdx.x;
+    const unsigned int N = insert.size();
+    if (i >= N)
+        return;
+
+    int node = N - 1 + i;
+    const neighbor::BoundingBox b = insert.get(primitives[i]);
+    lo[node] = b.lo;
+    hi[node] = b.hi;
+
+    while (node != root)
+        {
+        node = parent[node];
+
+        // make the box of this child visible before the sibling can read it
+        __threadfence();
+        if (atomicAdd(locks + node, 1) == 0)
+            return;
+
+        const int l = left[node];
+        const int r = right[node];
+        const float3 lo_l = lo[l];
+        const float3 lo_r = lo[r];
+        const float3 hi_l = hi[l];
+        const float3 hi_r = hi[r];
+        lo[node] = make_float3(fminf(lo_l.x, lo_r.x), fminf(lo_l.y, lo_r.y), fminf(lo_l.z, lo_r.z));
+        hi[node] = make_float3(fmaxf(hi_l.x, hi_r.x), fmaxf(hi_l.y, hi_r.y), fmaxf(hi_l.z, hi_r.z));
+        }
+    }
+
+//! Kernel to sum the surface areas of the internal nodes of an LBVH
+/*!
+ * \param d_cost Sum of the surface areas (output).
+ * \param lo Lower bounds of the nodes.
+ * \param hi Upper bounds of the nodes.
+ * \param Ninternal Number of internal nodes.
+ *
+ * The probability that a query enters a node is proportional to its surface area, so the sum is a
+ * measure of the traversal cost of the LBVH. Each block reduces its nodes and adds the block sum
+ * to \a d_cost.
+ */
+template<unsigned int block_size>
+__global__ void gpu_nlist_lbvh_cost_kernel(float* d_cost,
+                                           const float3* lo,
+                                           const float3* hi,
+                                           const unsigned int Ninternal)
+    {
+    const unsigned int idx = blockDim.x * blockIdx.x + threadIdx.x;
+
+    float area = 0.0f;
+    if (idx < Ninternal)
+        {
+        const float3 l = lo[idx];
+        const float3 h = hi[idx];
+        const float3 ext = make_float3(h.x - l.x, h.y - l.y, h.z - l.z);
+        area = ext.x * ext.y + ext.y * ext.z + ext.z * ext.x;
+        }
+
+    typedef hipcub::BlockReduce<float, block_size> BlockReduce;
+    __shared__ typename BlockReduce::TempStorage temp;
+    area = BlockReduce(temp).Sum(area);
+    if (threadIdx.x == 0)
+        atomicAdd(d_cost, area);
+    }
+
 //! Neighbor list particle query operation.
 /*!
  * \tparam use_body If true, use the body fields during query.
@@ -866,6 +1036,80 @@ void LBVHWrapper::build(const Scalar4* points,
     lbvh_->build(neighbor::LBVH::LaunchParameters(block_size, stream), insert, lof, hif);
     }
 
+/*!
+ * \param points Particle positions
+ * \param map Mapping of particles for insertion
+ * \param d_locks Scratch space for one counter per internal node
+ * \param stream CUDA stream for execution
+ * \param block_size CUDA block size for execution
+ *
+ * The map must be the same as in the last build(), with the same number of particles. Only the
+ * bounding boxes are updated, so the quality of the LBVH degrades as the particles move away from
+ * the positions it was built for.
+ */
+void LBVHWrapper::refit(const Scalar4* points,
+                        const unsigned int* map,
+                        unsigned int* d_locks,
+                        hipStream_t stream,
+                        unsigned int block_size)
+    {
+    const unsigned int N = lbvh_->getN();
+    if (N == 0)
+        return;
+
+    if (N > 1)
+        hipMemsetAsync(d_locks, 0, sizeof(unsigned int) * (N - 1), stream);
+
+    static unsigned int max_block_size = UINT_MAX;
+    if (max_block_size == UINT_MAX)
+        {
+        hipFuncAttributes attr;
+        hipFuncGetAttributes(&attr, reinterpret_cast<const void*>(gpu_nlist_lbvh_refit_kernel));
+        max_block_size = attr.maxThreadsPerBlock;
+        }
+
+    const unsigned int run_block_size = min(block_size, max_block_size);
+    PointMapInsertOp insert(points, map, N);
+    hipLaunchKernelGGL(gpu_nlist_lbvh_refit_kernel,
+                       dim3(N / run_block_size + 1),
+                       dim3(run_block_size),
+                       0,
+                       stream,
+                       lbvh_->getLowerBounds().get(),
+                       lbvh_->getUpperBounds().get(),
+                       lbvh_->getParents().get(),
+                       lbvh_->getLeftChildren().get(),
+                       lbvh_->getRightChildren().get(),
+                       lbvh_->getPrimitives().get(),
+                       d_locks,
+                       insert,
+                       lbvh_->getRoot());
+    }
+
+/*!
+ * \param d_cost Device memory to add the cost to
+ * \param stream CUDA stream for execution
+ *
+ * \sa gpu_nlist_lbvh_cost_kernel
+ */
+void LBVHWrapper::addCost(float* d_cost, hipStream_t stream)
+    {
+    const unsigned int N = lbvh_->getN();
+    if (N < 2)
+        return;
+
+    const unsigned int block_size = 256;
+    hipLaunchKernelGGL(gpu_nlist_lbvh_cost_kernel<block_size>,
+                       dim3((N - 1) / block_size + 1),
+                       dim3(block_size),
+                       0,
+                       stream,
+                       d_cost,
+                       lbvh_->getLowerBounds().get(),
+                       lbvh_->getUpperBounds().get(),
+                       N - 1);
+    }
+
 unsigned int LBVHWrapper::getN() const
     {
     return lbvh_->getN();
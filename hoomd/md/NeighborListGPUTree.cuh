@@ -56,6 +56,15 @@ hipError_t gpu_nlist_count_types(unsigned int* d_first,
                                  const unsigned int N,
                                  const unsigned int block_size);
 
+//! Kernel driver to check the particle types and save the last positions before a refit
+hipError_t gpu_nlist_refit_mark(unsigned int* d_lbvh_errors,
+                                Scalar4* d_last_pos,
+                                const Scalar4* d_pos,
+                                const unsigned int* d_sorted_types,
+                                const unsigned int* d_sorted_indexes,
+                                const unsigned int N,
+                                const unsigned int block_size);
+
 //! Kernel driver to rearrange primitives for faster traversal
 hipError_t gpu_nlist_copy_primitives(unsigned int* d_traverse_order,
                                      const unsigned int* d_indexes,
@@ -87,6 +96,16 @@ class LBVHWrapper
                hipStream_t stream,
                unsigned int block_size);
 
+    //! Refit the bounding boxes of the LBVH to new positions
+    void refit(const Scalar4* points,
+               const unsigned int* map,
+               unsigned int* d_locks,
+               hipStream_t stream,
+               unsigned int block_size);
+
+    //! Add the surface area of the internal nodes to a cost
+    void addCost(float* d_cost, hipStream_t stream);
+
     //! Get the underlying LBVH
     std::shared_ptr<neighbor::LBVH> get()
         {
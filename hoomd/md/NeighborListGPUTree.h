@@ -34,6 +34,13 @@
  * simulations, this sorting can also be used to efficiently filter out ghosts that lie outside the
  * neighbor search range (e.g., those participating in bonds).
  *
+ * When the refit threshold is set, later builds keep the sort and the hierarchy of each LBVH and
+ * only refit its bounding boxes to the new positions. The quality of a refitted LBVH degrades as
+ * the particles move, so the sum of the surface areas of its internal nodes is compared to the sum
+ * after its last build, and only the LBVHs that grew past the threshold are rebuilt. The particles
+ * are sorted again when their order, number, or types change. Refits are not performed with MPI
+ * domain decomposition, where the ghost particles change with every build.
+ *
  * \ingroup computes
  */
 class PYBIND11_EXPORT NeighborListGPUTree : public NeighborListGPU
@@ -62,6 +69,12 @@ class PYBIND11_EXPORT NeighborListGPUTree : public NeighborListGPU
         m_copy_tuner->setPeriod(period / 10);
         m_copy_tuner->setEnabled(enable);
 
+        m_refit_mark_tuner->setPeriod(period / 10);
+        m_refit_mark_tuner->setEnabled(enable);
+
+        m_refit_tuner->setPeriod(period / 10);
+        m_refit_tuner->setEnabled(enable);
+
         /* These may be null pointers if the first compute has not occurred, since construction of
            these tuners is deferred until the first neighbor list build (in order to get the tuner
            parameters from the LBVHWrapper and LBVHTraverserWrapper). When initialized, the period
@@ -85,11 +98,13 @@ class PYBIND11_EXPORT NeighborListGPUTree : public NeighborListGPU
     virtual void buildNlist(uint64_t timestep);
 
     private:
-    std::unique_ptr<Autotuner> m_mark_tuner;     //!< Tuner for the type mark kernel
-    std::unique_ptr<Autotuner> m_count_tuner;    //!< Tuner for the type-count kernel
-    std::unique_ptr<Autotuner> m_copy_tuner;     //!< Tuner for the primitive-copy kernel
-    std::unique_ptr<Autotuner> m_build_tuner;    //!< Tuner for LBVH builds
-    std::unique_ptr<Autotuner> m_traverse_tuner; //!< Tuner for LBVH traversers
+    std::unique_ptr<Autotuner> m_mark_tuner;       //!< Tuner for the type mark kernel
+    std::unique_ptr<Autotuner> m_count_tuner;      //!< Tuner for the type-count kernel
+    std::unique_ptr<Autotuner> m_copy_tuner;       //!< Tuner for the primitive-copy kernel
+    std::unique_ptr<Autotuner> m_build_tuner;      //!< Tuner for LBVH builds
+    std::unique_ptr<Autotuner> m_traverse_tuner;   //!< Tuner for LBVH traversers
+    std::unique_ptr<Autotuner> m_refit_mark_tuner; //!< Tuner for the refit type check kernel
+    std::unique_ptr<Autotuner> m_refit_tuner;      //!< Tuner for LBVH refits
 
     GPUArray<unsigned int> m_types;          //!< Particle types (for sorting)
     GPUArray<unsigned int> m_sorted_types;   //!< Sorted particle types
@@ -110,9 +125,21 @@ class PYBIND11_EXPORT NeighborListGPUTree : public NeighborListGPU
     unsigned int m_n_images;                 //!< Number of translation vectors for traversal
     GPUArray<unsigned int> m_traverse_order; //!< Order to traverse primitives
 
+    bool m_trees_valid;                   //!< True when the LBVHs can be refitted
+    unsigned int m_tree_N;                //!< Number of particles in the LBVHs
+    GPUArray<unsigned int> m_refit_locks; //!< Arrival counters of the internal nodes during refits
+    GPUArray<float> m_tree_cost;          //!< Cost of each LBVH
+    std::vector<float> m_build_cost;      //!< Cost of each LBVH after its last build
+
     //! Build the LBVHs using the neighbor library
     void buildTree();
 
+    //! Refit the LBVHs to the current positions
+    bool refitTree();
+
+    //! Compute the cost of each LBVH
+    std::vector<float> computeTreeCosts();
+
     //! Traverse the LBVHs using the neighbor library
     void traverseTree();
 
@@ -157,6 +184,12 @@ class PYBIND11_EXPORT NeighborListGPUTree : public NeighborListGPU
         m_max_num_changed = true;
         }
 
+    //! Notification of a particle sort
+    void slotParticlesSorted()
+        {
+        m_trees_valid = false;
+        }
+
     /// set to true when the type data has been allocated
     bool m_types_allocated;
 
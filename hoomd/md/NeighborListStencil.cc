@@ -13,8 +13,20 @@
 #include "hoomd/Communicator.h"
 #endif
 
+#include <algorithm>
+#include <vector>
+
+#ifdef ENABLE_TBB
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#endif
+
 using namespace std;
 namespace py = pybind11;
+
+//! Number of candidate particles whose distances are computed together
+const unsigned int nlist_stencil_batch_width = 8;
+
 /*!
  * \param sysdef System definition
  * \param r_cut Default cutoff radius
@@ -34,6 +46,12 @@ NeighborListStencil::NeighborListStencil(std::shared_ptr<SystemDefinition> sysde
     m_cl->setComputeTDB(true);
     m_cl->setFlagIndex();
     m_cl->setComputeAdjList(false);
+
+    // sort the cells by type so that inactive or out of range type pairs are skipped as a block
+    m_cl->setSortCellList(true);
+
+    // excluded pairs are skipped in buildNlist()
+    m_exclusions_in_build = true;
     }
 
 NeighborListStencil::~NeighborListStencil()
@@ -140,6 +158,13 @@ void NeighborListStencil::buildNlist(uint64_t timestep)
     // access the rlist data
     ArrayHandle<Scalar> h_r_cut(m_r_cut, access_location::host, access_mode::read);
 
+    // access the exclusion list
+    ArrayHandle<unsigned int> h_tag(m_pdata->getTags(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_n_ex_idx(m_n_ex_idx, access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_ex_list_idx(m_ex_list_idx,
+                                            access_location::host,
+                                            access_mode::read);
+
     // access the cell list data arrays
     ArrayHandle<unsigned int> h_cell_size(m_cl->getCellSizeArray(),
                                           access_location::host,
@@ -167,167 +192,281 @@ void NeighborListStencil::buildNlist(uint64_t timestep)
     Index3D ci = m_cl->getCellIndexer();
     Index2D cli = m_cl->getCellListIndexer();
 
+    // the members of every cell are sorted into blocks by type
+    ArrayHandle<unsigned int> h_type_head(m_cl->getTypeHeadArray(),
+                                          access_location::host,
+                                          access_mode::read);
+    const Index2D& thi = m_cl->getTypeHeadIndexer();
+    const unsigned int ntypes = m_pdata->getNTypes();
+
+    // tabulate the list radius of every type pair, negative for inactive pairs
+    std::vector<Scalar> typpair_r_list(m_typpair_idx.getNumElements());
+    std::vector<Scalar> typpair_r_listsq(m_typpair_idx.getNumElements());
+    std::vector<Scalar> typpair_r_listsq_max(m_typpair_idx.getNumElements());
+    for (unsigned int cur_pair = 0; cur_pair < m_typpair_idx.getNumElements(); ++cur_pair)
+        {
+        Scalar r_cut = h_r_cut.data[cur_pair];
+        Scalar r_list = r_cut + m_r_buff;
+        typpair_r_list[cur_pair] = r_list;
+        typpair_r_listsq[cur_pair] = (r_cut > Scalar(0.0)) ? r_list * r_list : Scalar(-1.0);
+
+        // largest list radius with any diameter shift, to reject whole blocks
+        Scalar r_list_max = r_list;
+        if (m_diameter_shift)
+            r_list_max += m_d_max - Scalar(1.0);
+        typpair_r_listsq_max[cur_pair] = r_list_max * r_list_max;
+        }
+
+    // gather the data read by every particle
+    BuildArgs args;
+    args.pos = h_pos.data;
+    args.body = h_body.data;
+    args.diameter = h_diameter.data;
+    args.tag = h_tag.data;
+    args.n_ex_idx = h_n_ex_idx.data;
+    args.ex_list_idx = h_ex_list_idx.data;
+    args.cell_xyzf = h_cell_xyzf.data;
+    args.cell_tdb = h_cell_tdb.data;
+    args.stencil = h_stencil.data;
+    args.n_stencil = h_n_stencil.data;
+    args.head_list = h_head_list.data;
+    args.Nmax = h_Nmax.data;
+    args.nlist = h_nlist.data;
+    args.n_neigh = h_n_neigh.data;
+    args.type_head = h_type_head.data;
+    args.typpair_r_list = typpair_r_list.data();
+    args.typpair_r_listsq = typpair_r_listsq.data();
+    args.typpair_r_listsq_max = typpair_r_listsq_max.data();
+    args.box = box;
+    args.ghost_width = ghost_width;
+    args.dim = dim;
+    args.periodic = periodic;
+    args.ci = ci;
+    args.cli = cli;
+    args.stencil_idx = stencil_idx;
+    args.thi = thi;
+    args.ntypes = ntypes;
+
     // for each local particle
     unsigned int nparticles = m_pdata->getN();
 
-    for (int i = 0; i < (int)nparticles; i++)
+#ifdef ENABLE_TBB
+    ThreadConditions thread_conditions(std::vector<unsigned int>(m_pdata->getNTypes(), 0));
+
+    m_exec_conf->getTaskArena()->execute(
+        [&]
         {
-        unsigned int cur_n_neigh = 0;
-
-        const Scalar3 my_pos = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
-        const unsigned int type_i = __scalar_as_int(h_pos.data[i].w);
-        const unsigned int body_i = h_body.data[i];
-        const Scalar diam_i = h_diameter.data[i];
-
-        const unsigned int Nmax_i = h_Nmax.data[type_i];
-        const unsigned int head_idx_i = h_head_list.data[i];
-
-        // find the bin each particle belongs in
-        Scalar3 f = box.makeFraction(my_pos, ghost_width);
-        int ib = (unsigned int)(f.x * dim.x);
-        int jb = (unsigned int)(f.y * dim.y);
-        int kb = (unsigned int)(f.z * dim.z);
-
-        // need to handle the case where the particle is exactly at the box hi
-        if (ib == (int)dim.x && periodic.x)
-            ib = 0;
-        if (jb == (int)dim.y && periodic.y)
-            jb = 0;
-        if (kb == (int)dim.z && periodic.z)
-            kb = 0;
-
-        // loop through all neighboring bins
-        unsigned int n_stencil = h_n_stencil.data[type_i];
-        for (unsigned int cur_stencil = 0; cur_stencil < n_stencil; ++cur_stencil)
-            {
-            // compute the stenciled cell cartesian coordinates
-            Scalar4 stencil = h_stencil.data[stencil_idx(cur_stencil, type_i)];
-            int sib = ib + __scalar_as_int(stencil.x);
-            int sjb = jb + __scalar_as_int(stencil.y);
-            int skb = kb + __scalar_as_int(stencil.z);
-            Scalar cell_dist2 = stencil.w;
-            // wrap through the boundary
-            if (periodic.x)
-                {
-                if (sib >= (int)dim.x)
-                    sib -= dim.x;
-                else if (sib < 0)
-                    sib += dim.x;
+            tbb::parallel_for(tbb::blocked_range<unsigned int>(0, nparticles),
+                              [&](const tbb::blocked_range<unsigned int>& r)
+                              {
+                                  unsigned int* conditions = thread_conditions.local().data();
+                                  for (unsigned int i = r.begin(); i != r.end(); ++i)
+                                      buildNlistParticle(i, args, conditions);
+                              });
+        });
+
+    reduceThreadConditions(thread_conditions, h_conditions.data);
+#else
+    for (unsigned int i = 0; i < nparticles; i++)
+        buildNlistParticle(i, args, h_conditions.data);
+#endif
 
-                // wrapping and the stencil construction should ensure this is in bounds
-                assert(sib >= 0 && sib < (int)dim.x);
-                }
-            else if (sib < 0 || sib >= (int)dim.x)
-                {
-                // in aperiodic systems the stencil could maybe extend out of the grid
-                continue;
-                }
+    if (m_prof)
+        m_prof->pop(m_exec_conf);
+    }
 
-            if (periodic.y)
-                {
-                if (sjb >= (int)dim.y)
-                    sjb -= dim.y;
-                else if (sjb < 0)
-                    sjb += dim.y;
+/*! \param i Index of the particle
+    \param args Host pointers and indexers of this build
+    \param conditions Overflow conditions to update, one array per thread in parallel builds
 
-                assert(sjb >= 0 && sjb < (int)dim.y);
-                }
-            else if (sjb < 0 || sjb >= (int)dim.y)
-                {
-                continue;
-                }
+    Writes the neighbors of particle i to its own row of the list. Rows of different particles do
+    not overlap, so particles can be processed concurrently.
+*/
+void NeighborListStencil::buildNlistParticle(unsigned int i,
+                                             const BuildArgs& args,
+                                             unsigned int* conditions)
+    {
+    const unsigned int W = nlist_stencil_batch_width;
+
+    alignas(64) Scalar lane_dx[nlist_stencil_batch_width];
+    alignas(64) Scalar lane_dy[nlist_stencil_batch_width];
+    alignas(64) Scalar lane_dz[nlist_stencil_batch_width];
+    alignas(64) Scalar lane_rsq[nlist_stencil_batch_width];
+
+    unsigned int cur_n_neigh = 0;
+
+    const Scalar3 my_pos = make_scalar3(args.pos[i].x, args.pos[i].y, args.pos[i].z);
+    const unsigned int type_i = __scalar_as_int(args.pos[i].w);
+    const unsigned int body_i = args.body[i];
+    const Scalar diam_i = args.diameter[i];
+
+    const unsigned int Nmax_i = args.Nmax[type_i];
+    const unsigned int head_idx_i = args.head_list[i];
+
+    // find the bin each particle belongs in
+    Scalar3 f = args.box.makeFraction(my_pos, args.ghost_width);
+    int ib = (unsigned int)(f.x * args.dim.x);
+    int jb = (unsigned int)(f.y * args.dim.y);
+    int kb = (unsigned int)(f.z * args.dim.z);
+
+    // need to handle the case where the particle is exactly at the box hi
+    if (ib == (int)args.dim.x && args.periodic.x)
+        ib = 0;
+    if (jb == (int)args.dim.y && args.periodic.y)
+        jb = 0;
+    if (kb == (int)args.dim.z && args.periodic.z)
+        kb = 0;
+
+    // loop through all neighboring bins
+    unsigned int n_stencil = args.n_stencil[type_i];
+    for (unsigned int cur_stencil = 0; cur_stencil < n_stencil; ++cur_stencil)
+        {
+        // compute the stenciled cell cartesian coordinates
+        Scalar4 stencil = args.stencil[args.stencil_idx(cur_stencil, type_i)];
+        int sib = ib + __scalar_as_int(stencil.x);
+        int sjb = jb + __scalar_as_int(stencil.y);
+        int skb = kb + __scalar_as_int(stencil.z);
+        Scalar cell_dist2 = stencil.w;
+        // wrap through the boundary
+        if (args.periodic.x)
+            {
+            if (sib >= (int)args.dim.x)
+                sib -= args.dim.x;
+            else if (sib < 0)
+                sib += args.dim.x;
 
-            if (periodic.z)
-                {
-                if (skb >= (int)dim.z)
-                    skb -= dim.z;
-                else if (skb < 0)
-                    skb += dim.z;
+            // wrapping and the stencil construction should ensure this is in bounds
+            assert(sib >= 0 && sib < (int)args.dim.x);
+            }
+        else if (sib < 0 || sib >= (int)args.dim.x)
+            {
+            // in aperiodic systems the stencil could maybe extend out of the grid
+            continue;
+            }
 
-                assert(skb >= 0 && skb < (int)dim.z);
-                }
-            else if (skb < 0 || skb >= (int)dim.z)
-                {
-                continue;
-                }
+        if (args.periodic.y)
+            {
+            if (sjb >= (int)args.dim.y)
+                sjb -= args.dim.y;
+            else if (sjb < 0)
+                sjb += args.dim.y;
 
-            unsigned int neigh_cell = ci(sib, sjb, skb);
+            assert(sjb >= 0 && sjb < (int)args.dim.y);
+            }
+        else if (sjb < 0 || sjb >= (int)args.dim.y)
+            {
+            continue;
+            }
 
-            // check against all the particles in that neighboring bin to see if it is a neighbor
-            unsigned int size = h_cell_size.data[neigh_cell];
-            for (unsigned int cur_offset = 0; cur_offset < size; cur_offset++)
-                {
-                // read in the particle type (diameter and body as well while we've got the Scalar4
-                // in)
-                const Scalar4& neigh_tdb = h_cell_tdb.data[cli(cur_offset, neigh_cell)];
-                const unsigned int type_j = __scalar_as_int(neigh_tdb.x);
-                const Scalar diam_j = neigh_tdb.y;
-                const unsigned int body_j = __scalar_as_int(neigh_tdb.z);
-
-                // skip any particles belonging to the same body if requested
-                if (m_filter_body && body_i != NO_BODY && body_i == body_j)
-                    continue;
-
-                // read cutoff and skip if pair is inactive
-                Scalar r_cut = h_r_cut.data[m_typpair_idx(type_i, type_j)];
-                if (r_cut <= Scalar(0.0))
-                    continue;
-
-                // compute the rlist based on the particle type we're interacting with
-                Scalar r_list = r_cut + m_r_buff;
-                Scalar sqshift = Scalar(0.0);
-                if (m_diameter_shift)
-                    {
-                    const Scalar delta = (diam_i + diam_j) * Scalar(0.5) - Scalar(1.0);
-                    // r^2 < (r_list + delta)^2
-                    // r^2 < r_listsq + delta^2 + 2*r_list*delta
-                    sqshift = (delta + Scalar(2.0) * r_list) * delta;
-                    }
-                Scalar r_listsq = r_list * r_list + sqshift;
+        if (args.periodic.z)
+            {
+            if (skb >= (int)args.dim.z)
+                skb -= args.dim.z;
+            else if (skb < 0)
+                skb += args.dim.z;
+
+            assert(skb >= 0 && skb < (int)args.dim.z);
+            }
+        else if (skb < 0 || skb >= (int)args.dim.z)
+            {
+            continue;
+            }
 
-                // compare the check distance to the minimum cell distance, and pass without
-                // distance check if unnecessary
-                if (cell_dist2 > r_listsq)
-                    continue;
+        unsigned int neigh_cell = args.ci(sib, sjb, skb);
 
-                // only load in the particle position and id if distance check is satisfied
-                const Scalar4& neigh_xyzf = h_cell_xyzf.data[cli(cur_offset, neigh_cell)];
-                unsigned int cur_neigh = __scalar_as_int(neigh_xyzf.w);
+        // check the particles in that neighboring bin one type block at a time
+        for (unsigned int type_j = 0; type_j < args.ntypes; ++type_j)
+            {
+            // skip the whole block if the pair is inactive or the bin is out of range
+            const unsigned int typpair_idx = m_typpair_idx(type_i, type_j);
+            const Scalar r_listsq = args.typpair_r_listsq[typpair_idx];
+            if (r_listsq < Scalar(0.0) || cell_dist2 > args.typpair_r_listsq_max[typpair_idx])
+                continue;
 
-                // a particle cannot neighbor itself
-                if (i == (int)cur_neigh)
-                    continue;
+            const unsigned int block_end = args.type_head[args.thi(type_j + 1, neigh_cell)];
+            for (unsigned int k0 = args.type_head[args.thi(type_j, neigh_cell)]; k0 < block_end;
+                 k0 += W)
+                {
+                const unsigned int n_lanes = std::min(W, block_end - k0);
 
-                Scalar3 neigh_pos = make_scalar3(neigh_xyzf.x, neigh_xyzf.y, neigh_xyzf.z);
-                Scalar3 dx = my_pos - neigh_pos;
-                dx = box.minImage(dx);
+                // gather the candidate coordinates into the lanes
+                for (unsigned int l = 0; l < n_lanes; l++)
+                    {
+                    const Scalar4& neigh_xyzf = args.cell_xyzf[args.cli(k0 + l, neigh_cell)];
+                    lane_dx[l] = my_pos.x - neigh_xyzf.x;
+                    lane_dy[l] = my_pos.y - neigh_xyzf.y;
+                    lane_dz[l] = my_pos.z - neigh_xyzf.z;
+                    }
+                for (unsigned int l = n_lanes; l < W; l++)
+                    {
+                    lane_dx[l] = Scalar(0.0);
+                    lane_dy[l] = Scalar(0.0);
+                    lane_dz[l] = Scalar(0.0);
+                    }
 
-                Scalar dr_sq = dot(dx, dx);
+                // apply periodic boundary conditions and compute r_ij squared
+#pragma omp simd
+                for (unsigned int l = 0; l < W; l++)
+                    {
+                    Scalar3 dx
+                        = args.box.minImage(make_scalar3(lane_dx[l], lane_dy[l], lane_dz[l]));
+                    lane_rsq[l] = dot(dx, dx);
+                    }
 
-                if (dr_sq <= r_listsq)
+                for (unsigned int l = 0; l < n_lanes; l++)
                     {
-                    if (m_storage_mode == full || i < (int)cur_neigh)
+                    // read in the diameter and body only for candidates within range
+                    const Scalar4& neigh_tdb = args.cell_tdb[args.cli(k0 + l, neigh_cell)];
+                    Scalar sqshift = Scalar(0.0);
+                    if (m_diameter_shift)
+                        {
+                        const Scalar delta = (diam_i + neigh_tdb.y) * Scalar(0.5) - Scalar(1.0);
+                        // r^2 < (r_list + delta)^2
+                        // r^2 < r_listsq + delta^2 + 2*r_list*delta
+                        sqshift = (delta + Scalar(2.0) * args.typpair_r_list[typpair_idx]) * delta;
+                        }
+
+                    if (lane_rsq[l] > r_listsq + sqshift)
+                        continue;
+
+                    // skip any particles belonging to the same body if requested
+                    const unsigned int body_j = __scalar_as_int(neigh_tdb.z);
+                    if (m_filter_body && body_i != NO_BODY && body_i == body_j)
+                        continue;
+
+                    // a particle cannot neighbor itself
+                    const unsigned int cur_neigh
+                        = __scalar_as_int(args.cell_xyzf[args.cli(k0 + l, neigh_cell)].w);
+                    if (i == cur_neigh)
+                        continue;
+
+                    // skip excluded pairs instead of filtering the list after the build
+                    if (m_exclusions_set
+                        && isExcludedInBuild(i,
+                                             cur_neigh,
+                                             args.tag,
+                                             args.n_ex_idx,
+                                             args.ex_list_idx))
+                        continue;
+
+                    if (m_storage_mode == full || i < cur_neigh)
                         {
                         // local neighbor
                         if (cur_n_neigh < Nmax_i)
                             {
-                            h_nlist.data[head_idx_i + cur_n_neigh] = cur_neigh;
+                            args.nlist[head_idx_i + cur_n_neigh] = cur_neigh;
                             }
                         else
-                            h_conditions.data[type_i]
-                                = max(h_conditions.data[type_i], cur_n_neigh + 1);
+                            conditions[type_i] = max(conditions[type_i], cur_n_neigh + 1);
 
                         ++cur_n_neigh;
                         }
                     }
                 }
             }
-
-        h_n_neigh.data[i] = cur_n_neigh;
         }
 
-    if (m_prof)
-        m_prof->pop(m_exec_conf);
+    args.n_neigh[i] = cur_n_neigh;
     }
 
 void export_NeighborListStencil(py::module& m)
@@ -23,6 +23,10 @@
 //! Efficient neighbor list build on the CPU with multiple bin stencils
 /*! Implements the O(N) neighbor list build on the CPU using a cell list with multiple bin stencils.
 
+    The cell list is sorted by type, so that all members of a type that is inactive with, or out of
+    range of, the current particle are skipped together. The distances to the remaining candidates
+    are computed in fixed size batches that the compiler vectorizes.
+
     \sa CellListStencil
     \ingroup computes
 */
@@ -51,14 +55,18 @@ class PYBIND11_EXPORT NeighborListStencil : public NeighborList
         m_cl->setNominalWidth(cell_width);
         }
 
+    //! Set the deterministic flag
+    /*! The cell list of the CPU build is always sorted, so the neighbor list is deterministic
+        regardless of this flag.
+    */
     void setDeterministic(bool deterministic)
         {
-        m_cl->setSortCellList(deterministic);
+        m_deterministic = deterministic;
         }
 
-    bool getDeterministic()
+    virtual bool getDeterministic()
         {
-        return m_cl->getSortCellList();
+        return m_deterministic;
         }
 
     Scalar getCellWidth()
@@ -90,12 +98,48 @@ class PYBIND11_EXPORT NeighborListStencil : public NeighborList
     bool m_override_cell_width = false;     //!< Flag to override the cell width
 
     bool m_needs_restencil = true; //!< Flag for updating the stencil
+    bool m_deterministic = false;  //!< Value of the deterministic flag
 
     /// Track when the cell size needs to be updated
     bool m_update_cell_size = true;
 
     //! Update the stencil radius
     void updateRStencil();
+
+    //! Host pointers and indexers shared by the particles of one build
+    struct BuildArgs
+        {
+        const Scalar4* pos;                 //!< Particle positions and types
+        const unsigned int* body;           //!< Particle bodies
+        const Scalar* diameter;             //!< Particle diameters
+        const unsigned int* tag;            //!< Particle tags
+        const unsigned int* n_ex_idx;       //!< Number of exclusions of each particle
+        const unsigned int* ex_list_idx;    //!< Excluded particles of each particle
+        const Scalar4* cell_xyzf;           //!< Positions and indices of the cell members
+        const Scalar4* cell_tdb;            //!< Types, diameters, and bodies of the cell members
+        const Scalar4* stencil;             //!< Stencil offsets and distances of each type
+        const unsigned int* n_stencil;      //!< Number of stencil cells of each type
+        const unsigned int* head_list;      //!< Index of the first neighbor of each particle
+        const unsigned int* Nmax;           //!< Maximum number of neighbors of each type
+        unsigned int* nlist;                //!< Neighbor list
+        unsigned int* n_neigh;              //!< Number of neighbors of each particle
+        const unsigned int* type_head;      //!< First member of each type block in each cell
+        const Scalar* typpair_r_list;       //!< List radius of each type pair
+        const Scalar* typpair_r_listsq;     //!< List radius squared per type pair, < 0 if inactive
+        const Scalar* typpair_r_listsq_max; //!< Largest shifted list radius squared per type pair
+        BoxDim box;                         //!< Local simulation box
+        Scalar3 ghost_width;                //!< Width of the ghost layer
+        uint3 dim;                          //!< Number of cells in each direction
+        uchar3 periodic;                    //!< Periodic flags of the box
+        Index3D ci;                         //!< Indexes the cells
+        Index2D cli;                        //!< Indexes the cell members
+        Index2D stencil_idx;                //!< Indexes the stencils
+        Index2D thi;                        //!< Indexes the type blocks
+        unsigned int ntypes;                //!< Number of particle types
+        };
+
+    //! Find the neighbors of one particle
+    void buildNlistParticle(unsigned int i, const BuildArgs& args, unsigned int* conditions);
     };
 
 //! Exports NeighborListStencil to python
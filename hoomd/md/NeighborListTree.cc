@@ -16,6 +16,11 @@ namespace py = pybind11;
 #include "hoomd/Communicator.h"
 #endif
 
+#ifdef ENABLE_TBB
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#endif
+
 using namespace std;
 using namespace hpmc::detail;
 
@@ -31,6 +36,9 @@ NeighborListTree::NeighborListTree(std::shared_ptr<SystemDefinition> sysdef, Sca
         .connect<NeighborListTree, &NeighborListTree::slotMaxNumChanged>(this);
     m_pdata->getParticleSortSignal()
         .connect<NeighborListTree, &NeighborListTree::slotRemapParticles>(this);
+
+    // excluded pairs are skipped in buildNlist()
+    m_exclusions_in_build = true;
     }
 
 NeighborListTree::~NeighborListTree()
@@ -296,9 +304,16 @@ void NeighborListTree::traverseTree()
     ArrayHandle<Scalar> h_diameter(m_pdata->getDiameters(),
                                    access_location::host,
                                    access_mode::read);
+    ArrayHandle<unsigned int> h_tag(m_pdata->getTags(), access_location::host, access_mode::read);
 
     ArrayHandle<Scalar> h_r_cut(m_r_cut, access_location::host, access_mode::read);
 
+    // exclusion list
+    ArrayHandle<unsigned int> h_n_ex_idx(m_n_ex_idx, access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_ex_list_idx(m_ex_list_idx,
+                                            access_location::host,
+                                            access_mode::read);
+
     // neighborlist data
     ArrayHandle<unsigned int> h_head_list(m_head_list, access_location::host, access_mode::read);
     ArrayHandle<unsigned int> h_Nmax(m_Nmax, access_location::host, access_mode::read);
@@ -308,128 +323,178 @@ void NeighborListTree::traverseTree()
     ArrayHandle<unsigned int> h_nlist(m_nlist, access_location::host, access_mode::overwrite);
     ArrayHandle<unsigned int> h_n_neigh(m_n_neigh, access_location::host, access_mode::overwrite);
 
+    // gather the data read by every particle
+    BuildArgs args;
+    args.postype = h_postype.data;
+    args.body = h_body.data;
+    args.diameter = h_diameter.data;
+    args.tag = h_tag.data;
+    args.r_cut = h_r_cut.data;
+    args.n_ex_idx = h_n_ex_idx.data;
+    args.ex_list_idx = h_ex_list_idx.data;
+    args.head_list = h_head_list.data;
+    args.Nmax = h_Nmax.data;
+    args.nlist = h_nlist.data;
+    args.n_neigh = h_n_neigh.data;
+
     // Loop over all particles
-    for (unsigned int i = 0; i < m_pdata->getN(); ++i)
+#ifdef ENABLE_TBB
+    ThreadConditions thread_conditions(std::vector<unsigned int>(m_pdata->getNTypes(), 0));
+
+    m_exec_conf->getTaskArena()->execute(
+        [&]
         {
-        // read in the current position and orientation
-        const Scalar4 postype_i = h_postype.data[i];
-        const vec3<Scalar> pos_i = vec3<Scalar>(postype_i);
-        const unsigned int type_i = __scalar_as_int(postype_i.w);
-        const unsigned int body_i = h_body.data[i];
-        const Scalar diam_i = h_diameter.data[i];
-
-        const unsigned int Nmax_i = h_Nmax.data[type_i];
-        const unsigned int nlist_head_i = h_head_list.data[i];
-
-        unsigned int n_neigh_i = 0;
-        for (unsigned int cur_pair_type = 0; cur_pair_type < m_pdata->getNTypes();
-             ++cur_pair_type) // loop on pair types
-            {
-            // pass on empty types
-            if (!m_num_per_type[cur_pair_type])
-                continue;
+            tbb::parallel_for(tbb::blocked_range<unsigned int>(0, m_pdata->getN()),
+                              [&](const tbb::blocked_range<unsigned int>& r)
+                              {
+                                  unsigned int* conditions = thread_conditions.local().data();
+                                  for (unsigned int i = r.begin(); i != r.end(); ++i)
+                                      buildNlistParticle(i, args, conditions);
+                              });
+        });
+
+    reduceThreadConditions(thread_conditions, h_conditions.data);
+#else
+    for (unsigned int i = 0; i < m_pdata->getN(); i++)
+        buildNlistParticle(i, args, h_conditions.data);
+#endif
 
-            // Check if this tree type should be excluded by r_cut(i,j) <= 0.0
-            Scalar r_cut = h_r_cut.data[m_typpair_idx(type_i, cur_pair_type)];
-            if (r_cut <= Scalar(0.0))
-                continue;
+    if (this->m_prof)
+        this->m_prof->pop();
+    }
 
-            // Determine the minimum r_cut_i (no diameter shifting, with buffer) for this particle
-            Scalar r_cut_i = r_cut + m_r_buff;
+/*! \param i Index of the particle
+    \param args Host pointers of this build
+    \param conditions Overflow conditions to update, one array per thread in parallel builds
 
-            // we save the r_cutsq before diameter shifting, as we will shift later, and reuse the
-            // r_cut_i now
-            Scalar r_cutsq_i = r_cut_i * r_cut_i;
+    Writes the neighbors of particle i to its own row of the list. Rows of different particles do
+    not overlap, so particles can be processed concurrently.
+*/
+void NeighborListTree::buildNlistParticle(unsigned int i,
+                                          const BuildArgs& args,
+                                          unsigned int* conditions)
+    {
+    // read in the current position and orientation
+    const Scalar4 postype_i = args.postype[i];
+    const vec3<Scalar> pos_i = vec3<Scalar>(postype_i);
+    const unsigned int type_i = __scalar_as_int(postype_i.w);
+    const unsigned int body_i = args.body[i];
+    const Scalar diam_i = args.diameter[i];
+
+    const unsigned int Nmax_i = args.Nmax[type_i];
+    const unsigned int nlist_head_i = args.head_list[i];
+
+    unsigned int n_neigh_i = 0;
+    for (unsigned int cur_pair_type = 0; cur_pair_type < m_pdata->getNTypes();
+         ++cur_pair_type) // loop on pair types
+        {
+        // pass on empty types
+        if (!m_num_per_type[cur_pair_type])
+            continue;
 
-            // the rlist to use for the AABB search has to be at least as big as the biggest
-            // diameter
-            Scalar r_list_i = r_cut_i;
-            if (m_diameter_shift)
-                r_list_i += m_d_max - Scalar(1.0);
+        // Check if this tree type should be excluded by r_cut(i,j) <= 0.0
+        Scalar r_cut = args.r_cut[m_typpair_idx(type_i, cur_pair_type)];
+        if (r_cut <= Scalar(0.0))
+            continue;
 
-            AABBTree* cur_aabb_tree = &m_aabb_trees[cur_pair_type];
+        // Determine the minimum r_cut_i (no diameter shifting, with buffer) for this particle
+        Scalar r_cut_i = r_cut + m_r_buff;
 
-            for (unsigned int cur_image = 0; cur_image < m_n_images;
-                 ++cur_image) // for each image vector
-                {
-                // make an AABB for the image of this particle
-                vec3<Scalar> pos_i_image = pos_i + m_image_list[cur_image];
-                AABB aabb = AABB(pos_i_image, r_list_i);
+        // we save the r_cutsq before diameter shifting, as we will shift later, and reuse the
+        // r_cut_i now
+        Scalar r_cutsq_i = r_cut_i * r_cut_i;
+
+        // the rlist to use for the AABB search has to be at least as big as the biggest
+        // diameter
+        Scalar r_list_i = r_cut_i;
+        if (m_diameter_shift)
+            r_list_i += m_d_max - Scalar(1.0);
+
+        AABBTree* cur_aabb_tree = &m_aabb_trees[cur_pair_type];
 
-                // stackless traversal of the tree
-                for (unsigned int cur_node_idx = 0; cur_node_idx < cur_aabb_tree->getNumNodes();
-                     ++cur_node_idx)
+        for (unsigned int cur_image = 0; cur_image < m_n_images;
+             ++cur_image) // for each image vector
+            {
+            // make an AABB for the image of this particle
+            vec3<Scalar> pos_i_image = pos_i + m_image_list[cur_image];
+            AABB aabb = AABB(pos_i_image, r_list_i);
+
+            // stackless traversal of the tree
+            for (unsigned int cur_node_idx = 0; cur_node_idx < cur_aabb_tree->getNumNodes();
+                 ++cur_node_idx)
+                {
+                if (overlap(cur_aabb_tree->getNodeAABB(cur_node_idx), aabb))
                     {
-                    if (overlap(cur_aabb_tree->getNodeAABB(cur_node_idx), aabb))
+                    if (cur_aabb_tree->isNodeLeaf(cur_node_idx))
                         {
-                        if (cur_aabb_tree->isNodeLeaf(cur_node_idx))
+                        for (unsigned int cur_p = 0;
+                             cur_p < cur_aabb_tree->getNodeNumParticles(cur_node_idx);
+                             ++cur_p)
                             {
-                            for (unsigned int cur_p = 0;
-                                 cur_p < cur_aabb_tree->getNodeNumParticles(cur_node_idx);
-                                 ++cur_p)
-                                {
-                                // neighbor j
-                                unsigned int j
-                                    = cur_aabb_tree->getNodeParticleTag(cur_node_idx, cur_p);
+                            // neighbor j
+                            unsigned int j
+                                = cur_aabb_tree->getNodeParticleTag(cur_node_idx, cur_p);
 
-                                // skip self-interaction always
-                                bool excluded = (i == j);
+                            // skip self-interaction always
+                            bool excluded = (i == j);
 
-                                if (m_filter_body && body_i != NO_BODY)
-                                    excluded = excluded | (body_i == h_body.data[j]);
+                            if (m_filter_body && body_i != NO_BODY)
+                                excluded = excluded | (body_i == args.body[j]);
 
-                                if (!excluded)
+                            if (!excluded)
+                                {
+                                // now we can trim down the actual particles based on diameter
+                                // compute the shift for the cutoff if not excluded
+                                Scalar sqshift = Scalar(0.0);
+                                if (m_diameter_shift)
                                     {
-                                    // now we can trim down the actual particles based on diameter
-                                    // compute the shift for the cutoff if not excluded
-                                    Scalar sqshift = Scalar(0.0);
-                                    if (m_diameter_shift)
-                                        {
-                                        const Scalar delta
-                                            = (diam_i + h_diameter.data[j]) * Scalar(0.5)
-                                              - Scalar(1.0);
-                                        // r^2 < (r_list + delta)^2
-                                        // r^2 < r_listsq + delta^2 + 2*r_list*delta
-                                        sqshift = (delta + Scalar(2.0) * r_cut_i) * delta;
-                                        }
-
-                                    // compute distance
-                                    Scalar4 postype_j = h_postype.data[j];
-                                    Scalar3 drij
-                                        = make_scalar3(postype_j.x, postype_j.y, postype_j.z)
-                                          - vec_to_scalar3(pos_i_image);
-                                    Scalar dr_sq = dot(drij, drij);
+                                    const Scalar delta
+                                        = (diam_i + args.diameter[j]) * Scalar(0.5) - Scalar(1.0);
+                                    // r^2 < (r_list + delta)^2
+                                    // r^2 < r_listsq + delta^2 + 2*r_list*delta
+                                    sqshift = (delta + Scalar(2.0) * r_cut_i) * delta;
+                                    }
 
-                                    if (dr_sq <= (r_cutsq_i + sqshift))
+                                // compute distance
+                                Scalar4 postype_j = args.postype[j];
+                                Scalar3 drij
+                                    = make_scalar3(postype_j.x, postype_j.y, postype_j.z)
+                                      - vec_to_scalar3(pos_i_image);
+                                Scalar dr_sq = dot(drij, drij);
+
+                                // skip excluded pairs instead of filtering the list later
+                                if (dr_sq <= (r_cutsq_i + sqshift)
+                                    && !(m_exclusions_set
+                                         && isExcludedInBuild(i,
+                                                              j,
+                                                              args.tag,
+                                                              args.n_ex_idx,
+                                                              args.ex_list_idx)))
+                                    {
+                                    if (m_storage_mode == full || i < j)
                                         {
-                                        if (m_storage_mode == full || i < j)
-                                            {
-                                            if (n_neigh_i < Nmax_i)
-                                                h_nlist.data[nlist_head_i + n_neigh_i] = j;
-                                            else
-                                                h_conditions.data[type_i]
-                                                    = max(h_conditions.data[type_i], n_neigh_i + 1);
-
-                                            ++n_neigh_i;
-                                            }
+                                        if (n_neigh_i < Nmax_i)
+                                            args.nlist[nlist_head_i + n_neigh_i] = j;
+                                        else
+                                            conditions[type_i]
+                                                = max(conditions[type_i], n_neigh_i + 1);
+
+                                        ++n_neigh_i;
                                         }
                                     }
                                 }
                             }
                         }
-                    else
-                        {
-                        // skip ahead
-                        cur_node_idx += cur_aabb_tree->getNodeSkip(cur_node_idx);
-                        }
-                    } // end stackless search
-                }     // end loop over images
-            }         // end loop over pair types
-        h_n_neigh.data[i] = n_neigh_i;
-        } // end loop over particles
-
-    if (this->m_prof)
-        this->m_prof->pop();
+                    }
+                else
+                    {
+                    // skip ahead
+                    cur_node_idx += cur_aabb_tree->getNodeSkip(cur_node_idx);
+                    }
+                } // end stackless search
+            }     // end loop over images
+        }         // end loop over pair types
+    args.n_neigh[i] = n_neigh_i;
     }
 
 void export_NeighborListTree(py::module& m)
@@ -103,6 +103,25 @@ class PYBIND11_EXPORT NeighborListTree : public NeighborList
 
     //! Traverses AABB trees to compute neighbors
     void traverseTree();
+
+    //! Host pointers shared by the particles of one build
+    struct BuildArgs
+        {
+        const Scalar4* postype;          //!< Particle positions and types
+        const unsigned int* body;        //!< Particle bodies
+        const Scalar* diameter;          //!< Particle diameters
+        const unsigned int* tag;         //!< Particle tags
+        const Scalar* r_cut;             //!< Cutoff radius of each type pair
+        const unsigned int* n_ex_idx;    //!< Number of exclusions of each particle
+        const unsigned int* ex_list_idx; //!< Excluded particles of each particle
+        const unsigned int* head_list;   //!< Index of the first neighbor of each particle
+        const unsigned int* Nmax;        //!< Maximum number of neighbors of each type
+        unsigned int* nlist;             //!< Neighbor list
+        unsigned int* n_neigh;           //!< Number of neighbors of each particle
+        };
+
+    //! Find the neighbors of one particle
+    void buildNlistParticle(unsigned int i, const BuildArgs& args, unsigned int* conditions);
     };
 
 //! Exports NeighborListTree to python
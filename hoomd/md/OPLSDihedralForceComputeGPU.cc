@@ -68,6 +68,7 @@ void OPLSDihedralForceComputeGPU::computeForces(uint64_t timestep)
     gpu_compute_opls_dihedral_forces(d_force.data,
                                      d_virial.data,
                                      m_virial.getPitch(),
+                                     m_pdata->getFlags()[pdata_flag::pressure_tensor],
                                      m_pdata->getN(),
                                      d_pos.data,
                                      box,
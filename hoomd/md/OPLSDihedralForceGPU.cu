@@ -18,6 +18,7 @@
 /*! \param d_force Device memory to write computed forces
     \param d_virial Device memory to write computed virials
     \param virial_pitch pitch of 2D virial array
+    \param compute_virial Whether to write the virials
     \param N number of particles
     \param d_pos particle positions on the device
     \param d_params Array of OPLS parameters k1/2, k2/2, k3/2, and k4/2
@@ -31,6 +32,7 @@ extern "C" __global__ void
 gpu_compute_opls_dihedral_forces_kernel(Scalar4* d_force,
                                         Scalar* d_virial,
                                         const size_t virial_pitch,
+                                        const bool compute_virial,
                                         const unsigned int N,
                                         const Scalar4* d_pos,
                                         const Scalar4* d_params,
@@ -288,13 +290,17 @@ gpu_compute_opls_dihedral_forces_kernel(Scalar4* d_force,
 
     // now that the force calculation is complete, write out the result (MEM TRANSFER: 20 bytes)
     d_force[idx] = force_idx;
-    for (int k = 0; k < 6; k++)
-        d_virial[k * virial_pitch + idx] = virial_idx[k];
+    if (compute_virial)
+        {
+        for (int k = 0; k < 6; k++)
+            d_virial[k * virial_pitch + idx] = virial_idx[k];
+        }
     }
 
 /*! \param d_force Device memory to write computed forces
     \param d_virial Device memory to write computed virials
     \param virial_pitch pitch of 2D virial array
+    \param compute_virial Whether to write the virials
     \param N number of particles
     \param d_pos particle positions on the GPU
     \param box Box dimensions (in GPU format) to use for periodic boundary conditions
@@ -316,6 +322,7 @@ gpu_compute_opls_dihedral_forces_kernel(Scalar4* d_force,
 hipError_t gpu_compute_opls_dihedral_forces(Scalar4* d_force,
                                             Scalar* d_virial,
                                             const size_t virial_pitch,
+                                            const bool compute_virial,
                                             const unsigned int N,
                                             const Scalar4* d_pos,
                                             const BoxDim& box,
@@ -356,6 +363,7 @@ hipError_t gpu_compute_opls_dihedral_forces(Scalar4* d_force,
                        d_force,
                        d_virial,
                        virial_pitch,
+                       compute_virial,
                        N,
                        d_pos,
                        d_params,
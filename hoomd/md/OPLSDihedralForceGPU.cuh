@@ -19,6 +19,7 @@
 hipError_t gpu_compute_opls_dihedral_forces(Scalar4* d_force,
                                             Scalar* d_virial,
                                             const size_t virial_pitch,
+                                            const bool compute_virial,
                                             const unsigned int N,
                                             const Scalar4* d_pos,
                                             const BoxDim& box,
@@ -37,7 +37,7 @@ PPPMForceCompute::PPPMForceCompute(std::shared_ptr<SystemDefinition> sysdef,
       m_grid_dim(make_uint3(0, 0, 0)), m_ghost_width(make_scalar3(0, 0, 0)), m_ghost_offset(0),
       m_n_cells(0), m_radius(1), m_n_inner_cells(0), m_need_initialize(true), m_params_set(false),
       m_box_changed(false), m_q(0.0), m_q2(0.0), m_body_energy(0.0), m_ptls_added_removed(false),
-      m_kiss_fft_initialized(false), m_dfft_initialized(false)
+      m_local_fft_initialized(false), m_dfft_initialized(false)
     {
     m_pdata->getBoxChangeSignal().connect<PPPMForceCompute, &PPPMForceCompute::setBoxChange>(this);
     // reset virial
@@ -146,12 +146,6 @@ PPPMForceCompute::~PPPMForceCompute()
     m_pdata->getGlobalParticleNumberChangeSignal()
         .disconnect<PPPMForceCompute, &PPPMForceCompute::slotGlobalParticleNumberChange>(this);
 
-    if (m_kiss_fft_initialized)
-        {
-        kiss_fft_free(m_kiss_fft);
-        kiss_fft_free(m_kiss_ifft);
-        kiss_fft_cleanup();
-        }
 #ifdef ENABLE_MPI
     if (m_dfft_initialized)
         {
@@ -540,19 +534,11 @@ void PPPMForceCompute::initializeFFT()
         dims[1] = m_mesh_points.y;
         dims[2] = m_mesh_points.x;
 
-        if (m_kiss_fft)
-            {
-            kiss_fft_free(m_kiss_fft);
-            }
-        if (m_kiss_ifft)
-            {
-            kiss_fft_free(m_kiss_ifft);
-            }
-
-        m_kiss_fft = kiss_fftnd_alloc(dims, 3, 0, NULL, NULL);
-        m_kiss_ifft = kiss_fftnd_alloc(dims, 3, 1, NULL, NULL);
+        m_local_fft.reset(new LocalFFT(dims, m_exec_conf->getNumThreads()));
+        m_exec_conf->msg->notice(6) << "charge.pppm: Using " << LocalFFT::getBackend()
+                                    << " for the local FFT" << std::endl;
 
-        m_kiss_fft_initialized = true;
+        m_local_fft_initialized = true;
         }
 
     // allocate mesh and transformed mesh
@@ -644,7 +630,7 @@ void PPPMForceCompute::computeInfluenceFunction()
                  / V_box;
 
 #ifdef ENABLE_MPI
-    bool local_fft = m_kiss_fft_initialized;
+    bool local_fft = m_local_fft_initialized;
 
     uint3 pdim = make_uint3(0, 0, 0);
     uint3 pidx = make_uint3(0, 0, 0);
@@ -692,7 +678,7 @@ void PPPMForceCompute::computeInfluenceFunction()
         else
 #endif
             {
-            // kiss FFT expects data in row major format
+            // the local FFT expects data in row major format
             wave_idx.z = cell_idx / (m_mesh_points.y * m_mesh_points.x);
             wave_idx.y
                 = (cell_idx - wave_idx.z * m_mesh_points.x * m_mesh_points.y) / m_mesh_points.x;
@@ -948,7 +934,7 @@ void PPPMForceCompute::assignParticles()
 
 void PPPMForceCompute::updateMeshes()
     {
-    if (m_kiss_fft_initialized)
+    if (m_local_fft_initialized)
         {
         if (m_prof)
             m_prof->push("FFT");
@@ -958,7 +944,7 @@ void PPPMForceCompute::updateMeshes()
                                                  access_location::host,
                                                  access_mode::overwrite);
 
-        kiss_fftnd(m_kiss_fft, h_mesh.data, h_fourier_mesh.data);
+        m_local_fft->forward(h_mesh.data, h_fourier_mesh.data);
         if (m_prof)
             m_prof->pop();
         }
@@ -1039,7 +1025,7 @@ void PPPMForceCompute::updateMeshes()
     if (m_prof)
         m_prof->pop();
 
-    if (m_kiss_fft_initialized)
+    if (m_local_fft_initialized)
         {
         if (m_prof)
             m_prof->push("FFT");
@@ -1062,9 +1048,9 @@ void PPPMForceCompute::updateMeshes()
         ArrayHandle<kiss_fft_cpx> h_inv_fourier_mesh_z(m_inv_fourier_mesh_z,
                                                        access_location::host,
                                                        access_mode::overwrite);
-        kiss_fftnd(m_kiss_ifft, h_fourier_mesh_G_x.data, h_inv_fourier_mesh_x.data);
-        kiss_fftnd(m_kiss_ifft, h_fourier_mesh_G_y.data, h_inv_fourier_mesh_y.data);
-        kiss_fftnd(m_kiss_ifft, h_fourier_mesh_G_z.data, h_inv_fourier_mesh_z.data);
+        m_local_fft->inverse(h_fourier_mesh_G_x.data, h_inv_fourier_mesh_x.data);
+        m_local_fft->inverse(h_fourier_mesh_G_y.data, h_inv_fourier_mesh_y.data);
+        m_local_fft->inverse(h_fourier_mesh_G_z.data, h_inv_fourier_mesh_z.data);
         if (m_prof)
             m_prof->pop();
         }
@@ -1538,27 +1524,6 @@ void PPPMForceCompute::computeVirial()
         m_prof->pop();
     }
 
-//! The real space form of the long-range interaction part, for exclusions
-inline void
-eval_pppm_real_space(Scalar alpha, Scalar kappa, Scalar rsq, Scalar& pair_eng, Scalar& force_divr)
-    {
-    const Scalar sqrtpi = sqrt(M_PI);
-
-    Scalar r = slow::sqrt(rsq);
-    Scalar expfac = fast::exp(-alpha * r);
-    Scalar arg1 = kappa * r - alpha / Scalar(2.0) / kappa;
-    Scalar arg2 = kappa * r + alpha / Scalar(2.0) / kappa;
-    Scalar erffac
-        = (::erf(arg1) * expfac + expfac - ::erfc(arg2) * exp(alpha * r)) / (Scalar(2.0) * r);
-
-    pair_eng = erffac;
-    force_divr
-        = -(expfac * Scalar(2.0) * kappa / sqrtpi * fast::exp(-arg1 * arg1)
-            - Scalar(0.5) * alpha * (expfac * ::erfc(arg1) + fast::exp(alpha * r) * ::erfc(arg2))
-            - erffac)
-          / rsq;
-    }
-
 void PPPMForceCompute::computeBodyCorrection()
     {
     if (m_prof)
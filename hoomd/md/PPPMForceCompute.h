@@ -13,7 +13,7 @@
 #include "hoomd/extern/dfftlib/src/dfft_host.h"
 #endif
 
-#include "hoomd/extern/kiss_fftnd.h"
+#include "LocalFFT.h"
 
 #include <hoomd/extern/nano-signal-slot/nano_signal_slot.hpp>
 #include <memory>
@@ -22,6 +22,27 @@ const Scalar EPS_HOC(1.0e-7);
 
 const unsigned int PPPM_MAX_ORDER = 7;
 
+//! The real space form of the long-range interaction part, for exclusions
+inline void
+eval_pppm_real_space(Scalar alpha, Scalar kappa, Scalar rsq, Scalar& pair_eng, Scalar& force_divr)
+    {
+    const Scalar sqrtpi = sqrt(M_PI);
+
+    Scalar r = slow::sqrt(rsq);
+    Scalar expfac = fast::exp(-alpha * r);
+    Scalar arg1 = kappa * r - alpha / Scalar(2.0) / kappa;
+    Scalar arg2 = kappa * r + alpha / Scalar(2.0) / kappa;
+    Scalar erffac
+        = (::erf(arg1) * expfac + expfac - ::erfc(arg2) * exp(alpha * r)) / (Scalar(2.0) * r);
+
+    pair_eng = erffac;
+    force_divr
+        = -(expfac * Scalar(2.0) * kappa / sqrtpi * fast::exp(-arg1 * arg1)
+            - Scalar(0.5) * alpha * (expfac * ::erfc(arg1) + fast::exp(alpha * r) * ::erfc(arg2))
+            - erffac)
+          / rsq;
+    }
+
 /*! Compute the long-ranged part of the particle-particle particle-mesh Ewald sum (PPPM)
  */
 class PYBIND11_EXPORT PPPMForceCompute : public ForceCompute
@@ -195,8 +216,7 @@ class PYBIND11_EXPORT PPPMForceCompute : public ForceCompute
     virtual void computeBodyCorrection();
 
     private:
-    kiss_fftnd_cfg m_kiss_fft = NULL;  //!< The FFT configuration
-    kiss_fftnd_cfg m_kiss_ifft = NULL; //!< Inverse FFT configuration
+    std::unique_ptr<LocalFFT> m_local_fft; //!< The FFT on a single rank
 
 #ifdef ENABLE_MPI
     dfft_plan m_dfft_plan_forward; //!< Distributed FFT for forward transform
@@ -207,7 +227,7 @@ class PYBIND11_EXPORT PPPMForceCompute : public ForceCompute
         m_grid_comm_reverse; //!< Communicator for inv fourier mesh
 #endif
 
-    bool m_kiss_fft_initialized; //!< True if a local KISS FFT has been set up
+    bool m_local_fft_initialized; //!< True if a local FFT has been set up
 
     GlobalArray<kiss_fft_cpx> m_mesh;         //!< The particle density mesh
     GlobalArray<kiss_fft_cpx> m_fourier_mesh; //!< The fourier transformed mesh
@@ -54,7 +54,7 @@ PPPMForceComputeGPU::~PPPMForceComputeGPU()
         CHECK_HIPFFT_ERROR(cufftDestroy(m_hipfft_plan));
 #endif
         }
-#ifdef ENABLE_MPI
+#if defined(ENABLE_MPI) && defined(USE_HOST_DFFT)
     else if (m_cuda_dfft_initialized)
         {
         dfft_destroy_plan(m_dfft_plan_forward);
@@ -77,8 +77,12 @@ void PPPMForceComputeGPU::initializeFFT()
 #ifdef ENABLE_MPI
     else if (m_cuda_dfft_initialized)
         {
+#ifndef USE_HOST_DFFT
+        m_pencil_fft.reset();
+#else
         dfft_destroy_plan(m_dfft_plan_forward);
         dfft_destroy_plan(m_dfft_plan_inverse);
+#endif
         }
 #endif
 
@@ -105,6 +109,17 @@ void PPPMForceComputeGPU::initializeFFT()
                 false));
 
         // set up distributed FFT
+        uint3 embed = make_uint3(m_mesh_points.x + 2 * m_n_ghost_cells.x,
+                                 m_mesh_points.y + 2 * m_n_ghost_cells.y,
+                                 m_mesh_points.z + 2 * m_n_ghost_cells.z);
+        m_ghost_offset
+            = (m_n_ghost_cells.z * embed.y + m_n_ghost_cells.y) * embed.x + m_n_ghost_cells.x;
+#ifndef USE_HOST_DFFT
+        m_pencil_fft.reset(new PencilFFTGPU(m_exec_conf,
+                                            m_pdata->getDomainDecomposition(),
+                                            m_mesh_points,
+                                            embed));
+#else
         int gdim[3];
         int pdim[3];
         Index3D decomp_idx = m_pdata->getDomainDecomposition()->getDomainIndexer();
@@ -114,12 +129,10 @@ void PPPMForceComputeGPU::initializeFFT()
         gdim[0] = m_mesh_points.z * pdim[0];
         gdim[1] = m_mesh_points.y * pdim[1];
         gdim[2] = m_mesh_points.x * pdim[2];
-        int embed[3];
-        embed[0] = m_mesh_points.z + 2 * m_n_ghost_cells.z;
-        embed[1] = m_mesh_points.y + 2 * m_n_ghost_cells.y;
-        embed[2] = m_mesh_points.x + 2 * m_n_ghost_cells.x;
-        m_ghost_offset
-            = (m_n_ghost_cells.z * embed[1] + m_n_ghost_cells.y) * embed[2] + m_n_ghost_cells.x;
+        int dfft_embed[3];
+        dfft_embed[0] = embed.z;
+        dfft_embed[1] = embed.y;
+        dfft_embed[2] = embed.x;
         uint3 pcoord = m_pdata->getDomainDecomposition()->getGridPos();
         int pidx[3];
         pidx[0] = pcoord.z;
@@ -129,36 +142,10 @@ void PPPMForceComputeGPU::initializeFFT()
         ArrayHandle<unsigned int> h_cart_ranks(m_pdata->getDomainDecomposition()->getCartRanks(),
                                                access_location::host,
                                                access_mode::read);
-#ifndef USE_HOST_DFFT
-        dfft_cuda_create_plan(&m_dfft_plan_forward,
-                              3,
-                              gdim,
-                              embed,
-                              NULL,
-                              pdim,
-                              pidx,
-                              row_m,
-                              0,
-                              1,
-                              m_exec_conf->getMPICommunicator(),
-                              (int*)h_cart_ranks.data);
-        dfft_cuda_create_plan(&m_dfft_plan_inverse,
-                              3,
-                              gdim,
-                              NULL,
-                              embed,
-                              pdim,
-                              pidx,
-                              row_m,
-                              0,
-                              1,
-                              m_exec_conf->getMPICommunicator(),
-                              (int*)h_cart_ranks.data);
-#else
         dfft_create_plan(&m_dfft_plan_forward,
                          3,
                          gdim,
-                         embed,
+                         dfft_embed,
                          NULL,
                          pdim,
                          pidx,
@@ -171,7 +158,7 @@ void PPPMForceComputeGPU::initializeFFT()
                          3,
                          gdim,
                          NULL,
-                         embed,
+                         dfft_embed,
                          pdim,
                          pidx,
                          row_m,
@@ -392,17 +379,9 @@ void PPPMForceComputeGPU::updateMeshes()
         if (m_prof)
             m_prof->push(m_exec_conf, "FFT");
 #ifndef USE_HOST_DFFT
-        ArrayHandle<hipfftComplex> d_mesh(m_mesh, access_location::device, access_mode::read);
-
-        if (m_exec_conf->isCUDAErrorCheckingEnabled())
-            dfft_cuda_check_errors(&m_dfft_plan_forward, 1);
-        else
-            dfft_cuda_check_errors(&m_dfft_plan_forward, 0);
+        ArrayHandle<hipfftComplex> d_mesh(m_mesh, access_location::device, access_mode::readwrite);
 
-        dfft_cuda_execute(d_mesh.data + m_ghost_offset,
-                          d_mesh.data + m_ghost_offset,
-                          0,
-                          &m_dfft_plan_forward);
+        m_pencil_fft->forward(d_mesh.data + m_ghost_offset, d_mesh.data + m_ghost_offset);
 #else
         ArrayHandle<hipfftComplex> h_mesh(m_mesh, access_location::host, access_mode::read);
 
@@ -527,23 +506,12 @@ void PPPMForceComputeGPU::updateMeshes()
                                                         access_location::device,
                                                         access_mode::overwrite);
 
-        if (m_exec_conf->isCUDAErrorCheckingEnabled())
-            dfft_cuda_check_errors(&m_dfft_plan_inverse, 1);
-        else
-            dfft_cuda_check_errors(&m_dfft_plan_inverse, 0);
-
-        dfft_cuda_execute(d_inv_fourier_mesh_x.data + m_ghost_offset,
-                          d_inv_fourier_mesh_x.data + m_ghost_offset,
-                          1,
-                          &m_dfft_plan_inverse);
-        dfft_cuda_execute(d_inv_fourier_mesh_y.data + m_ghost_offset,
-                          d_inv_fourier_mesh_y.data + m_ghost_offset,
-                          1,
-                          &m_dfft_plan_inverse);
-        dfft_cuda_execute(d_inv_fourier_mesh_z.data + m_ghost_offset,
-                          d_inv_fourier_mesh_z.data + m_ghost_offset,
-                          1,
-                          &m_dfft_plan_inverse);
+        m_pencil_fft->inverse(d_inv_fourier_mesh_x.data + m_ghost_offset,
+                              d_inv_fourier_mesh_x.data + m_ghost_offset);
+        m_pencil_fft->inverse(d_inv_fourier_mesh_y.data + m_ghost_offset,
+                              d_inv_fourier_mesh_y.data + m_ghost_offset);
+        m_pencil_fft->inverse(d_inv_fourier_mesh_z.data + m_ghost_offset,
+                              d_inv_fourier_mesh_z.data + m_ghost_offset);
 #else
         ArrayHandle<hipfftComplex> h_inv_fourier_mesh_x(m_inv_fourier_mesh_x,
                                                         access_location::host,
@@ -813,6 +781,12 @@ void PPPMForceComputeGPU::computeInfluenceFunction()
         }
 #endif
 
+    // the pencil FFT returns the transform in the block distribution of the real space mesh
+    bool block_layout = m_local_fft;
+#if defined(ENABLE_MPI) && !defined(USE_HOST_DFFT)
+    block_layout = true;
+#endif
+
     ArrayHandle<Scalar> d_gf_b(m_gf_b, access_location::device, access_mode::read);
 
     unsigned int block_size = m_tuner_influence->getParam();
@@ -822,7 +796,7 @@ void PPPMForceComputeGPU::computeInfluenceFunction()
                                    d_inf_f.data,
                                    d_k.data,
                                    m_pdata->getGlobalBox(),
-                                   m_local_fft,
+                                   block_layout,
                                    pidx,
                                    pdim,
                                    EPS_HOC,
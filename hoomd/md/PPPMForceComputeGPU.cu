@@ -1056,7 +1056,7 @@ void gpu_compute_virial(unsigned int n_wave_vectors,
                        d_sum_virial);
     }
 
-template<bool local_fft>
+template<bool block_layout>
 __global__ void gpu_compute_influence_function_kernel(const uint3 mesh_dim,
                                                       const unsigned int n_wave_vectors,
                                                       const uint3 global_dim,
@@ -1083,14 +1083,18 @@ __global__ void gpu_compute_influence_function_kernel(const uint3 mesh_dim,
         return;
 
     int l, m, n;
-    if (local_fft)
+    if (block_layout)
         {
-        // use row-major layout
+        // use row-major layout, offset by the position of the local mesh in the global mesh
         int ny = mesh_dim.y;
         int nx = mesh_dim.x;
         n = kidx / ny / nx;
         m = (kidx - n * ny * nx) / nx;
         l = kidx % nx;
+
+        l += int(pidx.x * mesh_dim.x);
+        m += int(pidx.y * mesh_dim.y);
+        n += int(pidx.z * mesh_dim.z);
         }
 #ifdef ENABLE_MPI
     else
@@ -1216,7 +1220,7 @@ void gpu_compute_influence_function(const uint3 mesh_dim,
                                     Scalar* d_inf_f,
                                     Scalar3* d_k,
                                     const BoxDim& global_box,
-                                    const bool local_fft,
+                                    const bool block_layout,
                                     const uint3 pidx,
                                     const uint3 pdim,
                                     const Scalar EPS_HOC,
@@ -1258,7 +1262,7 @@ void gpu_compute_influence_function(const uint3 mesh_dim,
     temp = floor(((kappa * L.z / (M_PI * global_dim.z)) * pow(-log(EPS_HOC), 0.25)));
     int nbz = (int)temp;
 
-    if (local_fft)
+    if (block_layout)
         {
         static unsigned int max_block_size = UINT_MAX;
         if (max_block_size == UINT_MAX)
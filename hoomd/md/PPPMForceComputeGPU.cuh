@@ -98,7 +98,7 @@ void gpu_compute_influence_function(const uint3 mesh_dim,
                                     Scalar* d_inf_f,
                                     Scalar3* d_k,
                                     const BoxDim& global_box,
-                                    const bool local_fft,
+                                    const bool block_layout,
                                     const uint3 pidx,
                                     const uint3 pdim,
                                     const Scalar EPS_HOC,
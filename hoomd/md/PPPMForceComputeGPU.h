@@ -26,7 +26,7 @@ typedef cufftHandle hipfftHandle;
 #include "CommunicatorGridGPU.h"
 
 #ifndef USE_HOST_DFFT
-#include "hoomd/extern/dfftlib/src/dfft_cuda.h"
+#include "PencilFFTGPU.h"
 #else
 #include "hoomd/extern/dfftlib/src/dfft_host.h"
 #endif
@@ -123,7 +123,7 @@ class PYBIND11_EXPORT PPPMForceComputeGPU : public PPPMForceCompute
     hipfftHandle m_hipfft_plan;   //!< The FFT plan
     bool m_local_fft;             //!< True if we are only doing local FFTs (not distributed)
     bool m_cufft_initialized;     //!< True if CUFFT has been initialized
-    bool m_cuda_dfft_initialized; //!< True if dfft has been initialized
+    bool m_cuda_dfft_initialized; //!< True if the distributed FFT has been initialized
 
 #ifdef ENABLE_MPI
     typedef CommunicatorGridGPU<hipfftComplex> CommunicatorGridGPUComplex;
@@ -131,8 +131,12 @@ class PYBIND11_EXPORT PPPMForceComputeGPU : public PPPMForceCompute
     std::shared_ptr<CommunicatorGridGPUComplex>
         m_gpu_grid_comm_reverse; //!< Communicate fourier mesh
 
+#ifndef USE_HOST_DFFT
+    std::unique_ptr<PencilFFTGPU> m_pencil_fft; //!< Distributed FFT
+#else
     dfft_plan m_dfft_plan_forward; //!< Forward distributed FFT
     dfft_plan m_dfft_plan_inverse; //!< Forward distributed FFT
+#endif
 #endif
 
     GlobalArray<hipfftComplex> m_mesh;         //!< The particle density mesh
@@ -0,0 +1,21 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#pragma once
+
+/*! \file PairEvaluatorBatchTraits.h
+    \brief Defines the traits that select the batched CPU force loop in PotentialPair
+*/
+
+//! Selects the batched CPU force loop for a pair evaluator
+/*! The batched loop gathers the coordinates of pair_batch_width neighbors into aligned
+    structure-of-arrays lanes and evaluates all lanes in loops the compiler can vectorize. It gives
+    the same results as the scalar loop up to round-off. Evaluators opt in by specializing this
+    template with enabled = true next to their definition. Evaluators that branch heavily, need
+    diameter or charge, or read large parameter tables gain nothing from the batched loop and
+    should keep the default.
+*/
+template<class evaluator> struct PairEvaluatorBatchTraits
+    {
+    static const bool enabled = false;
+    };
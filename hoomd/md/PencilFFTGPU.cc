@@ -0,0 +1,342 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "PencilFFTGPU.h"
+
+#ifdef ENABLE_HIP
+#ifdef ENABLE_MPI
+
+#include "PencilFFTGPU.cuh"
+
+#include <algorithm>
+#include <sstream>
+#include <stdexcept>
+
+/*! \file PencilFFTGPU.cc
+    \brief Defines the PencilFFTGPU class
+*/
+
+#ifdef __HIP_PLATFORM_HCC__
+typedef hipfftResult pencil_fft_result_t;
+#define PENCIL_FFT_SUCCESS HIPFFT_SUCCESS
+#else
+typedef cufftResult pencil_fft_result_t;
+#define PENCIL_FFT_SUCCESS CUFFT_SUCCESS
+#endif
+
+//! Throw an exception when a hipFFT call fails
+static void checkPencilFFTResult(pencil_fft_result_t result, const char* action)
+    {
+    if (result != PENCIL_FFT_SUCCESS)
+        {
+        std::ostringstream oss;
+        oss << "HIPFFT returned error " << result << " when trying to " << action;
+        throw std::runtime_error(oss.str());
+        }
+    }
+
+/*! \param exec_conf The execution configuration
+    \param decomposition The domain decomposition the mesh is distributed with
+    \param dim Local (inner) mesh dimensions, identical on all ranks
+    \param embed Dimensions of the array the mesh with ghost cells is embedded in
+*/
+PencilFFTGPU::PencilFFTGPU(std::shared_ptr<const ExecutionConfiguration> exec_conf,
+                           std::shared_ptr<DomainDecomposition> decomposition,
+                           uint3 dim,
+                           uint3 embed)
+    : m_exec_conf(exec_conf), m_dim(dim), m_embed(embed)
+    {
+    m_exec_conf->msg->notice(5) << "Constructing PencilFFTGPU" << std::endl;
+
+    const Index3D& didx = decomposition->getDomainIndexer();
+    uint3 grid_pos = decomposition->getGridPos();
+    unsigned int pdim[3] = {didx.getW(), didx.getH(), didx.getD()};
+    unsigned int pidx[3] = {grid_pos.x, grid_pos.y, grid_pos.z};
+    unsigned int n_local[3] = {dim.x, dim.y, dim.z};
+    unsigned int n_cells = dim.x * dim.y * dim.z;
+
+    size_t pencil_size = n_cells;
+    for (unsigned int axis = 0; axis < 3; ++axis)
+        {
+        // the ranks that share the grid position along the two other axes exchange data
+        unsigned int b = (axis + 1) % 3;
+        unsigned int c = (axis + 2) % 3;
+        MPI_Comm_split(m_exec_conf->getMPICommunicator(),
+                       int(pidx[b] * pdim[c] + pidx[c]),
+                       int(pidx[axis]),
+                       &m_comm[axis]);
+
+        // distribute the lines along this axis evenly over the ranks
+        unsigned int n_ranks = pdim[axis];
+        unsigned int n = n_local[axis];
+        unsigned int n_lines_total = n_cells / n;
+        std::vector<unsigned int> begin(n_ranks + 1);
+        for (unsigned int q = 0; q <= n_ranks; ++q)
+            begin[q] = (unsigned int)((uint64_t)n_lines_total * q / n_ranks);
+
+        m_n_ranks[axis] = n_ranks;
+        m_n_lines[axis] = begin[pidx[axis] + 1] - begin[pidx[axis]];
+
+        m_send_counts[axis].resize(n_ranks);
+        m_send_displs[axis].resize(n_ranks);
+        m_recv_counts[axis].resize(n_ranks);
+        m_recv_displs[axis].resize(n_ranks);
+        for (unsigned int q = 0; q < n_ranks; ++q)
+            {
+            m_send_counts[axis][q] = int((begin[q + 1] - begin[q]) * n * sizeof(hipfftComplex));
+            m_send_displs[axis][q] = int(begin[q] * n * sizeof(hipfftComplex));
+            m_recv_counts[axis][q] = int(m_n_lines[axis] * n * sizeof(hipfftComplex));
+            m_recv_displs[axis][q] = int(q * m_n_lines[axis] * n * sizeof(hipfftComplex));
+            }
+
+        pencil_size = std::max(pencil_size, (size_t)m_n_lines[axis] * n * n_ranks);
+
+        // batched transform of the complete lines
+        m_plan_initialized[axis] = false;
+        if (m_n_lines[axis] > 0)
+            {
+            int length = int(n * n_ranks);
+#ifdef __HIP_PLATFORM_HCC__
+            checkPencilFFTResult(hipfftPlanMany(&m_plan[axis],
+                                                1,
+                                                &length,
+                                                NULL,
+                                                1,
+                                                length,
+                                                NULL,
+                                                1,
+                                                length,
+                                                HIPFFT_C2C,
+                                                int(m_n_lines[axis])),
+                                 "create a plan");
+#else
+            checkPencilFFTResult(cufftPlanMany(&m_plan[axis],
+                                               1,
+                                               &length,
+                                               NULL,
+                                               1,
+                                               length,
+                                               NULL,
+                                               1,
+                                               length,
+                                               CUFFT_C2C,
+                                               int(m_n_lines[axis])),
+                                 "create a plan");
+#endif
+            m_plan_initialized[axis] = true;
+            }
+        }
+
+    GlobalArray<hipfftComplex> lines(n_cells, m_exec_conf);
+    m_lines.swap(lines);
+    TAG_ALLOCATION(m_lines);
+
+    GlobalArray<hipfftComplex> recv(pencil_size, m_exec_conf);
+    m_recv.swap(recv);
+    TAG_ALLOCATION(m_recv);
+
+    GlobalArray<hipfftComplex> pencil(pencil_size, m_exec_conf);
+    m_pencil.swap(pencil);
+    TAG_ALLOCATION(m_pencil);
+
+    GlobalArray<hipfftComplex> work(n_cells, m_exec_conf);
+    m_work.swap(work);
+    TAG_ALLOCATION(m_work);
+    }
+
+PencilFFTGPU::~PencilFFTGPU()
+    {
+    m_exec_conf->msg->notice(5) << "Destroying PencilFFTGPU" << std::endl;
+
+    // the communicators are released by MPI_Finalize when the execution configuration goes first
+    int finalized = 0;
+    MPI_Finalized(&finalized);
+
+    for (unsigned int axis = 0; axis < 3; ++axis)
+        {
+        if (m_plan_initialized[axis])
+            {
+#ifdef __HIP_PLATFORM_HCC__
+            hipfftDestroy(m_plan[axis]);
+#else
+            cufftDestroy(m_plan[axis]);
+#endif
+            }
+        if (!finalized)
+            MPI_Comm_free(&m_comm[axis]);
+        }
+    }
+
+/*! \param d_in Pointer to the first inner point of the input
+    \param in_embed Dimensions of the array the input is embedded in
+    \param d_out Pointer to the first inner point of the output
+    \param out_embed Dimensions of the array the output is embedded in
+    \param inverse True for the inverse transform
+*/
+void PencilFFTGPU::execute(hipfftComplex* d_in,
+                           uint3 in_embed,
+                           hipfftComplex* d_out,
+                           uint3 out_embed,
+                           bool inverse)
+    {
+    ArrayHandle<hipfftComplex> d_work(m_work, access_location::device, access_mode::readwrite);
+
+    // the transforms along the three axes are separable
+    transformAxis(0, d_in, in_embed, d_work.data, m_dim, inverse);
+    transformAxis(1, d_work.data, m_dim, d_work.data, m_dim, inverse);
+    transformAxis(2, d_work.data, m_dim, d_out, out_embed, inverse);
+    }
+
+/*! \param axis Axis to transform
+    \param d_in Pointer to the first inner point of the input
+    \param in_embed Dimensions of the array the input is embedded in
+    \param d_out Pointer to the first inner point of the output, may alias \a d_in
+    \param out_embed Dimensions of the array the output is embedded in
+    \param inverse True for the inverse transform
+*/
+void PencilFFTGPU::transformAxis(unsigned int axis,
+                                 hipfftComplex* d_in,
+                                 uint3 in_embed,
+                                 hipfftComplex* d_out,
+                                 uint3 out_embed,
+                                 bool inverse)
+    {
+    const unsigned int block_size = 256;
+    unsigned int n_local = axis == 0 ? m_dim.x : (axis == 1 ? m_dim.y : m_dim.z);
+
+        {
+        ArrayHandle<hipfftComplex> d_lines(m_lines,
+                                           access_location::device,
+                                           access_mode::overwrite);
+        gpu_pencil_copy_lines(m_dim, in_embed, axis, d_in, d_lines.data, true, block_size);
+        if (m_exec_conf->isCUDAErrorCheckingEnabled())
+            CHECK_CUDA_ERROR();
+        }
+
+    if (m_n_ranks[axis] == 1)
+        {
+        // the local lines are complete
+        ArrayHandle<hipfftComplex> d_lines(m_lines,
+                                           access_location::device,
+                                           access_mode::readwrite);
+        executePlan(axis, d_lines.data, inverse);
+        }
+    else
+        {
+        exchange(axis, true);
+
+            {
+            ArrayHandle<hipfftComplex> d_recv(m_recv,
+                                              access_location::device,
+                                              access_mode::readwrite);
+            ArrayHandle<hipfftComplex> d_pencil(m_pencil,
+                                                access_location::device,
+                                                access_mode::overwrite);
+
+            gpu_pencil_transpose(m_n_lines[axis],
+                                 n_local,
+                                 m_n_ranks[axis],
+                                 d_recv.data,
+                                 d_pencil.data,
+                                 true,
+                                 block_size);
+            if (m_exec_conf->isCUDAErrorCheckingEnabled())
+                CHECK_CUDA_ERROR();
+
+            executePlan(axis, d_pencil.data, inverse);
+
+            gpu_pencil_transpose(m_n_lines[axis],
+                                 n_local,
+                                 m_n_ranks[axis],
+                                 d_pencil.data,
+                                 d_recv.data,
+                                 false,
+                                 block_size);
+            if (m_exec_conf->isCUDAErrorCheckingEnabled())
+                CHECK_CUDA_ERROR();
+            }
+
+        exchange(axis, false);
+        }
+
+    ArrayHandle<hipfftComplex> d_lines(m_lines, access_location::device, access_mode::read);
+    gpu_pencil_copy_lines(m_dim, out_embed, axis, d_out, d_lines.data, false, block_size);
+    if (m_exec_conf->isCUDAErrorCheckingEnabled())
+        CHECK_CUDA_ERROR();
+    }
+
+/*! \param axis Axis to transform
+    \param d_data Complete lines along \a axis, transformed in place
+    \param inverse True for the inverse transform
+*/
+void PencilFFTGPU::executePlan(unsigned int axis, hipfftComplex* d_data, bool inverse)
+    {
+    if (!m_plan_initialized[axis])
+        return;
+
+#ifdef __HIP_PLATFORM_HCC__
+    checkPencilFFTResult(hipfftExecC2C(m_plan[axis],
+                                       d_data,
+                                       d_data,
+                                       inverse ? HIPFFT_BACKWARD : HIPFFT_FORWARD),
+                         "execute a plan");
+#else
+    checkPencilFFTResult(
+        cufftExecC2C(m_plan[axis], d_data, d_data, inverse ? CUFFT_INVERSE : CUFFT_FORWARD),
+        "execute a plan");
+#endif
+    }
+
+/*! \param axis Axis along which the ranks exchange data
+    \param to_pencil True to send the local lines to the ranks holding the complete lines, false
+                     to send the transformed segments back
+*/
+void PencilFFTGPU::exchange(unsigned int axis, bool to_pencil)
+    {
+#ifdef ENABLE_MPI_CUDA
+    ArrayHandle<hipfftComplex> lines_handle(m_lines,
+                                            access_location::device,
+                                            to_pencil ? access_mode::read : access_mode::overwrite);
+    ArrayHandle<hipfftComplex> recv_handle(m_recv,
+                                           access_location::device,
+                                           to_pencil ? access_mode::overwrite : access_mode::read);
+
+    // the buffers are written by kernels on the default stream
+    hipDeviceSynchronize();
+#else
+    ArrayHandle<hipfftComplex> lines_handle(m_lines,
+                                            access_location::host,
+                                            to_pencil ? access_mode::read : access_mode::overwrite);
+    ArrayHandle<hipfftComplex> recv_handle(m_recv,
+                                           access_location::host,
+                                           to_pencil ? access_mode::overwrite : access_mode::read);
+#endif
+
+    if (to_pencil)
+        {
+        MPI_Alltoallv(lines_handle.data,
+                      &m_send_counts[axis].front(),
+                      &m_send_displs[axis].front(),
+                      MPI_BYTE,
+                      recv_handle.data,
+                      &m_recv_counts[axis].front(),
+                      &m_recv_displs[axis].front(),
+                      MPI_BYTE,
+                      m_comm[axis]);
+        }
+    else
+        {
+        MPI_Alltoallv(recv_handle.data,
+                      &m_recv_counts[axis].front(),
+                      &m_recv_displs[axis].front(),
+                      MPI_BYTE,
+                      lines_handle.data,
+                      &m_send_counts[axis].front(),
+                      &m_send_displs[axis].front(),
+                      MPI_BYTE,
+                      m_comm[axis]);
+        }
+    }
+
+#endif // ENABLE_MPI
+#endif // ENABLE_HIP
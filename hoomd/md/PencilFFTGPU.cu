@@ -0,0 +1,141 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "PencilFFTGPU.cuh"
+
+/*! \file PencilFFTGPU.cu
+    \brief Defines the GPU kernels used by PencilFFTGPU
+*/
+
+//! Kernel to copy the inner mesh points into (or out of) the line buffer of an axis
+/*! \param n_cells Number of inner mesh points
+    \param dim Local (inner) mesh dimensions
+    \param embed Dimensions of the array the inner mesh is embedded in
+    \param axis Axis along which the lines run
+    \param d_mesh Pointer to the first inner point of the mesh
+    \param d_lines Line buffer
+    \param to_lines True to copy from the mesh to the line buffer, false for the reverse
+
+    Threads are assigned to mesh points in memory order.
+*/
+__global__ void gpu_pencil_copy_lines_kernel(unsigned int n_cells,
+                                             const uint3 dim,
+                                             const uint3 embed,
+                                             unsigned int axis,
+                                             hipfftComplex* d_mesh,
+                                             hipfftComplex* d_lines,
+                                             bool to_lines)
+    {
+    unsigned int idx = blockIdx.x * blockDim.x + threadIdx.x;
+
+    if (idx >= n_cells)
+        return;
+
+    unsigned int x = idx % dim.x;
+    unsigned int y = (idx / dim.x) % dim.y;
+    unsigned int z = idx / dim.x / dim.y;
+
+    unsigned int mesh_idx = (z * embed.y + y) * embed.x + x;
+    unsigned int line_idx = pencil_line_index(x, y, z, axis, dim);
+
+    if (to_lines)
+        d_lines[line_idx] = d_mesh[mesh_idx];
+    else
+        d_mesh[mesh_idx] = d_lines[line_idx];
+    }
+
+//! Kernel to reorder received line segments into complete pencils (or back)
+/*! \param n_elements Number of elements in the receive buffer
+    \param n_lines Number of complete lines (pencils) held by this rank
+    \param n_local Number of mesh points per line held by every rank along the axis
+    \param n_ranks Number of ranks along the axis
+    \param d_in Input buffer
+    \param d_out Output buffer
+    \param to_pencil True to go from the receive buffer layout to pencils, false for the reverse
+*/
+__global__ void gpu_pencil_transpose_kernel(unsigned int n_elements,
+                                            unsigned int n_lines,
+                                            unsigned int n_local,
+                                            unsigned int n_ranks,
+                                            const hipfftComplex* d_in,
+                                            hipfftComplex* d_out,
+                                            bool to_pencil)
+    {
+    unsigned int idx = blockIdx.x * blockDim.x + threadIdx.x;
+
+    if (idx >= n_elements)
+        return;
+
+    unsigned int pencil_idx = pencil_segment_index(idx, n_lines, n_local, n_ranks);
+
+    if (to_pencil)
+        d_out[pencil_idx] = d_in[idx];
+    else
+        d_out[idx] = d_in[pencil_idx];
+    }
+
+/*! \param dim Local (inner) mesh dimensions
+    \param embed Dimensions of the array the inner mesh is embedded in
+    \param axis Axis along which the lines run
+    \param d_mesh Pointer to the first inner point of the mesh
+    \param d_lines Line buffer
+    \param to_lines True to copy from the mesh to the line buffer, false for the reverse
+    \param block_size Number of threads per block
+*/
+void gpu_pencil_copy_lines(const uint3 dim,
+                           const uint3 embed,
+                           unsigned int axis,
+                           hipfftComplex* d_mesh,
+                           hipfftComplex* d_lines,
+                           bool to_lines,
+                           unsigned int block_size)
+    {
+    unsigned int n_cells = dim.x * dim.y * dim.z;
+    unsigned int n_blocks = n_cells / block_size + 1;
+
+    hipLaunchKernelGGL((gpu_pencil_copy_lines_kernel),
+                       dim3(n_blocks),
+                       dim3(block_size),
+                       0,
+                       0,
+                       n_cells,
+                       dim,
+                       embed,
+                       axis,
+                       d_mesh,
+                       d_lines,
+                       to_lines);
+    }
+
+/*! \param n_lines Number of complete lines (pencils) held by this rank
+    \param n_local Number of mesh points per line held by every rank along the axis
+    \param n_ranks Number of ranks along the axis
+    \param d_in Input buffer
+    \param d_out Output buffer
+    \param to_pencil True to go from the receive buffer layout to pencils, false for the reverse
+    \param block_size Number of threads per block
+*/
+void gpu_pencil_transpose(unsigned int n_lines,
+                          unsigned int n_local,
+                          unsigned int n_ranks,
+                          const hipfftComplex* d_in,
+                          hipfftComplex* d_out,
+                          bool to_pencil,
+                          unsigned int block_size)
+    {
+    unsigned int n_elements = n_lines * n_local * n_ranks;
+    unsigned int n_blocks = n_elements / block_size + 1;
+
+    hipLaunchKernelGGL((gpu_pencil_transpose_kernel),
+                       dim3(n_blocks),
+                       dim3(block_size),
+                       0,
+                       0,
+                       n_elements,
+                       n_lines,
+                       n_local,
+                       n_ranks,
+                       d_in,
+                       d_out,
+                       to_pencil);
+    }
@@ -0,0 +1,83 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file PencilFFTGPU.cuh
+    \brief Declares the GPU kernels used by PencilFFTGPU
+*/
+
+#pragma once
+
+#include "hoomd/HOOMDMath.h"
+
+#include "hip/hip_runtime.h"
+
+#ifdef __HIP_PLATFORM_HCC__
+#include <hipfft.h>
+#else
+#include <cufft.h>
+typedef cufftComplex hipfftComplex;
+#endif
+
+//! Index of a mesh point in the line buffer of one axis
+/*! \param x Local x coordinate of the mesh point
+    \param y Local y coordinate of the mesh point
+    \param z Local z coordinate of the mesh point
+    \param axis Axis along which the lines run (0: x, 1: y, 2: z)
+    \param dim Local (inner) mesh dimensions
+
+    Lines are enumerated over the two remaining local coordinates, the lower axis varying
+    fastest, and the mesh points along \a axis are contiguous within each line.
+*/
+HOSTDEVICE inline unsigned int pencil_line_index(unsigned int x,
+                                                 unsigned int y,
+                                                 unsigned int z,
+                                                 unsigned int axis,
+                                                 const uint3 dim)
+    {
+    if (axis == 0)
+        return (z * dim.y + y) * dim.x + x;
+    else if (axis == 1)
+        return (z * dim.x + x) * dim.y + y;
+    else
+        return (y * dim.x + x) * dim.z + z;
+    }
+
+//! Index of a received segment element in the assembled pencil
+/*! \param idx Index into the receive buffer
+    \param n_lines Number of complete lines (pencils) held by this rank
+    \param n_local Number of mesh points per line held by every rank along the axis
+    \param n_ranks Number of ranks along the axis
+
+    The receive buffer holds one segment per source rank, each segment consisting of
+    \a n_local points of every one of the \a n_lines lines.
+*/
+HOSTDEVICE inline unsigned int pencil_segment_index(unsigned int idx,
+                                                    unsigned int n_lines,
+                                                    unsigned int n_local,
+                                                    unsigned int n_ranks)
+    {
+    unsigned int seg_size = n_lines * n_local;
+    unsigned int rank = idx / seg_size;
+    unsigned int rem = idx - rank * seg_size;
+    unsigned int line = rem / n_local;
+    unsigned int i = rem - line * n_local;
+    return line * n_local * n_ranks + rank * n_local + i;
+    }
+
+//! Copy the inner mesh points into (or out of) the line buffer of an axis
+void gpu_pencil_copy_lines(const uint3 dim,
+                           const uint3 embed,
+                           unsigned int axis,
+                           hipfftComplex* d_mesh,
+                           hipfftComplex* d_lines,
+                           bool to_lines,
+                           unsigned int block_size);
+
+//! Reorder received line segments into complete pencils (or back)
+void gpu_pencil_transpose(unsigned int n_lines,
+                          unsigned int n_local,
+                          unsigned int n_ranks,
+                          const hipfftComplex* d_in,
+                          hipfftComplex* d_out,
+                          bool to_pencil,
+                          unsigned int block_size);
@@ -0,0 +1,122 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#ifndef __PENCIL_FFT_GPU_H__
+#define __PENCIL_FFT_GPU_H__
+
+#ifdef ENABLE_HIP
+#ifdef ENABLE_MPI
+
+#include "hoomd/DomainDecomposition.h"
+#include "hoomd/ExecutionConfiguration.h"
+#include "hoomd/GlobalArray.h"
+#include "hoomd/HOOMDMPI.h"
+
+#if __HIP_PLATFORM_HCC__
+#include <hipfft.h>
+#elif __HIP_PLATFORM_NVCC__
+#include <cufft.h>
+typedef cufftComplex hipfftComplex;
+typedef cufftHandle hipfftHandle;
+#endif
+
+#include <memory>
+#include <vector>
+
+/*! \file PencilFFTGPU.h
+    \brief Declares the PencilFFTGPU class
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+//! Distributed 3D FFT of a domain decomposed mesh on the GPU
+/*! The mesh is block distributed over the ranks of the domain decomposition. The transform is
+    carried out one axis at a time: the ranks along that axis exchange their blocks with an
+    all-to-all in a sub-communicator so that each rank holds complete lines (pencils) along the
+    axis, transform them with a batched 1D FFT, and send them back. The result is in the same
+    block distribution as the input, so that wave vectors map to mesh points with the offset of
+    the rank in the domain decomposition.
+
+    Only the ranks along one axis communicate with each other in every exchange. When HOOMD is
+    built with ENABLE_MPI_CUDA, the exchange operates on device buffers directly, otherwise it
+    is staged through host memory.
+*/
+class PYBIND11_EXPORT PencilFFTGPU
+    {
+    public:
+    //! Constructor
+    PencilFFTGPU(std::shared_ptr<const ExecutionConfiguration> exec_conf,
+                 std::shared_ptr<DomainDecomposition> decomposition,
+                 uint3 dim,
+                 uint3 embed);
+
+    //! Destructor
+    ~PencilFFTGPU();
+
+    //! Forward transform
+    /*! \param d_in Pointer to the first inner point of the input mesh (with ghost cells)
+        \param d_out Output in compact row-major layout, may alias \a d_in
+    */
+    void forward(hipfftComplex* d_in, hipfftComplex* d_out)
+        {
+        execute(d_in, m_embed, d_out, m_dim, false);
+        }
+
+    //! Inverse transform (not normalized)
+    /*! \param d_in Input in compact row-major layout
+        \param d_out Pointer to the first inner point of the output mesh (with ghost cells), may
+                     alias \a d_in
+    */
+    void inverse(hipfftComplex* d_in, hipfftComplex* d_out)
+        {
+        execute(d_in, m_dim, d_out, m_embed, true);
+        }
+
+    private:
+    std::shared_ptr<const ExecutionConfiguration> m_exec_conf; //!< The execution configuration
+    uint3 m_dim;   //!< Local (inner) mesh dimensions
+    uint3 m_embed; //!< Dimensions of the array the mesh with ghost cells is embedded in
+
+    MPI_Comm m_comm[3];          //!< Communicators of the ranks along each axis
+    unsigned int m_n_ranks[3];   //!< Number of ranks along each axis
+    unsigned int m_n_lines[3];   //!< Number of complete lines held by this rank, per axis
+    hipfftHandle m_plan[3];      //!< Batched 1D FFT plans, per axis
+    bool m_plan_initialized[3];  //!< True if the plan for an axis has been created
+
+    std::vector<int> m_send_counts[3]; //!< Bytes sent to each rank along an axis
+    std::vector<int> m_send_displs[3]; //!< Offsets of the data sent to each rank (bytes)
+    std::vector<int> m_recv_counts[3]; //!< Bytes received from each rank along an axis
+    std::vector<int> m_recv_displs[3]; //!< Offsets of the data received from each rank (bytes)
+
+    GlobalArray<hipfftComplex> m_lines;  //!< Local mesh points ordered by lines
+    GlobalArray<hipfftComplex> m_recv;   //!< Received line segments
+    GlobalArray<hipfftComplex> m_pencil; //!< Complete lines along the current axis
+    GlobalArray<hipfftComplex> m_work;   //!< Intermediate result between the axes
+
+    //! Transform all three axes
+    void execute(hipfftComplex* d_in,
+                 uint3 in_embed,
+                 hipfftComplex* d_out,
+                 uint3 out_embed,
+                 bool inverse);
+
+    //! Transform along one axis
+    void transformAxis(unsigned int axis,
+                       hipfftComplex* d_in,
+                       uint3 in_embed,
+                       hipfftComplex* d_out,
+                       uint3 out_embed,
+                       bool inverse);
+
+    //! Run the batched 1D FFT of one axis in place
+    void executePlan(unsigned int axis, hipfftComplex* d_data, bool inverse);
+
+    //! Exchange line segments between the ranks along an axis
+    void exchange(unsigned int axis, bool to_pencil);
+    };
+
+#endif // ENABLE_MPI
+#endif // ENABLE_HIP
+#endif // __PENCIL_FFT_GPU_H__
@@ -4,6 +4,7 @@
 // Maintainer: joaander
 
 #include "hip/hip_runtime.h"
+#include "hoomd/FixedPoint.h"
 #include "hoomd/HOOMDMath.h"
 #include "hoomd/Index1D.h"
 #include "hoomd/ParticleData.cuh"
@@ -57,6 +58,10 @@ struct bond_args_t
     const unsigned int* d_gpu_n_bonds;      //!< List of number of bonds stored on the GPU
     const unsigned int n_bond_types;        //!< Number of bond types in the simulation
     const unsigned int block_size;          //!< Block size to execute
+
+    bool fixed_point = false;   //!< When true, sum the bonds of each particle in fixed point
+    bool compute_virial = true; //!< When false, the virials are not written
+    hipStream_t stream = 0;     //!< Stream to execute on
     };
 
 #ifdef __HIPCC__
@@ -68,6 +73,7 @@ struct bond_args_t
     \param d_force Device memory to write computed forces
     \param d_virial Device memory to write computed virials
     \param virial_pitch pitch of 2D virial array
+    \param compute_virial Whether to write the virials
     \param N Number of particles in the system
     \param d_pos particle positions on the GPU
     \param d_charge particle charges
@@ -80,6 +86,8 @@ struct bond_args_t
     \param d_params Parameters for the potential, stored per bond type
     \param d_flags Flag allocated on the device for use in checking for bonds that cannot be
    evaluated
+    \param fixed_point When true, convert the contribution of every bond to fixed point before
+   summing, so that the result does not depend on the order of the bonds in \a blist
 
 
     Certain options are controlled via template parameters to avoid the performance hit when they
@@ -90,6 +98,7 @@ template<class evaluator>
 __global__ void gpu_compute_bond_forces_kernel(Scalar4* d_force,
                                                Scalar* d_virial,
                                                const size_t virial_pitch,
+                                               const bool compute_virial,
                                                const unsigned int N,
                                                const Scalar4* d_pos,
                                                const Scalar* d_charge,
@@ -100,7 +109,8 @@ __global__ void gpu_compute_bond_forces_kernel(Scalar4* d_force,
                                                const unsigned int* n_bonds_list,
                                                const unsigned int n_bond_type,
                                                const typename evaluator::param_type* d_params,
-                                               unsigned int* d_flags)
+                                               unsigned int* d_flags,
+                                               const bool fixed_point)
     {
     // start by identifying which particle we are to handle
     int idx = blockIdx.x * blockDim.x + threadIdx.x;
@@ -153,6 +163,7 @@ __global__ void gpu_compute_bond_forces_kernel(Scalar4* d_force,
     Scalar virial[6];
     for (unsigned int i = 0; i < 6; i++)
         virial[i] = 0;
+    unsigned long long fixed[10] = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
 
     // loop over neighbors
     for (int bond_idx = 0; bond_idx < n_bonds; bond_idx++)
@@ -197,7 +208,23 @@ __global__ void gpu_compute_bond_forces_kernel(Scalar4* d_force,
 
         bool evaluated = eval.evalForceAndEnergy(force_divr, bond_eng);
 
-        if (evaluated)
+        if (evaluated && fixed_point)
+            {
+            Scalar force_div2r = force_divr / Scalar(2.0);
+            Scalar value[10] = {dx.x * force_divr,
+                                dx.y * force_divr,
+                                dx.z * force_divr,
+                                bond_eng * Scalar(0.5),
+                                dx.x * dx.x * force_div2r,
+                                dx.x * dx.y * force_div2r,
+                                dx.x * dx.z * force_div2r,
+                                dx.y * dx.y * force_div2r,
+                                dx.y * dx.z * force_div2r,
+                                dx.z * dx.z * force_div2r};
+            for (unsigned int i = 0; i < 10; i++)
+                fixed[i] += hoomd::scalar_to_fixed(value[i]);
+            }
+        else if (evaluated)
             {
             // add up the virial (double counting, multiply by 0.5)
             Scalar force_div2r = force_divr / Scalar(2.0);
@@ -222,11 +249,24 @@ __global__ void gpu_compute_bond_forces_kernel(Scalar4* d_force,
             }
         }
 
+    if (fixed_point)
+        {
+        force = make_scalar4(hoomd::fixed_to_scalar(fixed[0]),
+                             hoomd::fixed_to_scalar(fixed[1]),
+                             hoomd::fixed_to_scalar(fixed[2]),
+                             hoomd::fixed_to_scalar(fixed[3]));
+        for (unsigned int i = 0; i < 6; i++)
+            virial[i] = hoomd::fixed_to_scalar(fixed[4 + i]);
+        }
+
     // now that the force calculation is complete, write out the result (MEM TRANSFER: 20 bytes);
     d_force[idx] = force;
 
-    for (unsigned int i = 0; i < 6; i++)
-        d_virial[i * virial_pitch + idx] = virial[i];
+    if (compute_virial)
+        {
+        for (unsigned int i = 0; i < 6; i++)
+            d_virial[i * virial_pitch + idx] = virial[i];
+        }
     }
 
 #include <iostream>
@@ -272,10 +312,11 @@ hipError_t gpu_compute_bond_forces(const bond_args_t& bond_args,
                        grid,
                        threads,
                        shared_bytes,
-                       0,
+                       bond_args.stream,
                        bond_args.d_force,
                        bond_args.d_virial,
                        bond_args.virial_pitch,
+                       bond_args.compute_virial,
                        bond_args.N,
                        bond_args.d_pos,
                        bond_args.d_charge,
@@ -286,7 +327,8 @@ hipError_t gpu_compute_bond_forces(const bond_args_t& bond_args,
                        bond_args.d_gpu_n_bonds,
                        bond_args.n_bond_types,
                        d_params,
-                       d_flags);
+                       d_flags,
+                       bond_args.fixed_point);
 
     return hipSuccess;
     }
@@ -52,6 +52,12 @@ class PotentialBondGPU : public PotentialBond<evaluator>
         m_tuner->setEnabled(enable);
         }
 
+    //! The bond kernel executes on the stream assigned by the integrator
+    virtual bool supportsStreams()
+        {
+        return true;
+        }
+
     protected:
     std::unique_ptr<Autotuner> m_tuner; //!< Autotuner for block size
     GPUArray<unsigned int> m_flags;     //!< Flags set during the kernel execution
@@ -144,23 +150,29 @@ void PotentialBondGPU<evaluator, gpu_cgbf>::computeForces(uint64_t timestep)
         // access the flags array for overwriting
         ArrayHandle<unsigned int> d_flags(m_flags, access_location::device, access_mode::readwrite);
 
+        // the GPU bond table may have been rebuilt on the default stream
+        this->waitForDefaultStream();
+        this->m_tuner->setStream(this->m_stream);
+
         this->m_tuner->begin();
-        gpu_cgbf(bond_args_t(d_force.data,
-                             d_virial.data,
-                             this->m_virial.getPitch(),
-                             this->m_pdata->getN(),
-                             this->m_pdata->getMaxN(),
-                             d_pos.data,
-                             d_charge.data,
-                             d_diameter.data,
-                             box,
-                             d_gpu_bondlist.data,
-                             gpu_table_indexer,
-                             d_gpu_n_bonds.data,
-                             this->m_bond_data->getNTypes(),
-                             this->m_tuner->getParam()),
-                 d_params.data,
-                 d_flags.data);
+        bond_args_t bond_args(d_force.data,
+                              d_virial.data,
+                              this->m_virial.getPitch(),
+                              this->m_pdata->getN(),
+                              this->m_pdata->getMaxN(),
+                              d_pos.data,
+                              d_charge.data,
+                              d_diameter.data,
+                              box,
+                              d_gpu_bondlist.data,
+                              gpu_table_indexer,
+                              d_gpu_n_bonds.data,
+                              this->m_bond_data->getNTypes(),
+                              this->m_tuner->getParam());
+        bond_args.fixed_point = this->m_exec_conf->getDeterministic();
+        bond_args.compute_virial = this->m_pdata->getFlags()[pdata_flag::pressure_tensor];
+        bond_args.stream = this->m_stream;
+        gpu_cgbf(bond_args, d_params.data, d_flags.data);
         }
 
     if (this->m_exec_conf->isCUDAErrorCheckingEnabled())
@@ -6,8 +6,10 @@
 #include "hoomd/ForceCompute.h"
 #include "hoomd/GPUArray.h"
 #include "hoomd/GlobalArray.h"
+#include <algorithm>
 #include <memory>
 #include <stdexcept>
+#include <vector>
 
 /*! \file PotentialExternal.h
     \brief Declares a class for computing an external force field
@@ -51,12 +53,32 @@ template<class evaluator> class PotentialExternal : public ForceCompute
     //! set the field type of the evaluator
     void setField(field_type field);
 
+    //! External forces overwrite the forces of all local particles, they may compute into shared
+    //! arrays
+    virtual bool supportsElidedForceArrays()
+        {
+        return true;
+        }
+
     protected:
     GPUArray<param_type> m_params; //!< Array of per-type parameters
     GPUArray<field_type> m_field;
 
+    GPUArray<unsigned int> m_field_grid; //!< Field grid of evaluators that use one
+    uint3 m_field_grid_dim;              //!< Dimensions of the field grid
+    bool m_field_grid_changed;           //!< True when the field grid needs to be rebuilt
+
     //! Actually compute the forces
     virtual void computeForces(uint64_t timestep);
+
+    //! Rebuild the field grid when the box, field, or parameters change
+    void updateFieldGrid();
+
+    //! Mark the field grid for rebuilding
+    void slotFieldGridChanged()
+        {
+        m_field_grid_changed = true;
+        }
     };
 
 /*! Constructor
@@ -71,11 +93,57 @@ PotentialExternal<evaluator>::PotentialExternal(std::shared_ptr<SystemDefinition
 
     GPUArray<field_type> field(1, m_exec_conf);
     m_field.swap(field);
+
+    m_field_grid_dim = make_uint3(1, 1, 1);
+    m_field_grid_changed = true;
+    if (evaluator::needsFieldGrid())
+        m_pdata->getBoxChangeSignal()
+            .template connect<PotentialExternal<evaluator>,
+                              &PotentialExternal<evaluator>::slotFieldGridChanged>(this);
     }
 
 /*! Destructor
  */
-template<class evaluator> PotentialExternal<evaluator>::~PotentialExternal() { }
+template<class evaluator> PotentialExternal<evaluator>::~PotentialExternal()
+    {
+    if (evaluator::needsFieldGrid())
+        m_pdata->getBoxChangeSignal()
+            .template disconnect<PotentialExternal<evaluator>,
+                                 &PotentialExternal<evaluator>::slotFieldGridChanged>(this);
+    }
+
+/*! Evaluators that use a field grid (walls) build it on the host from the field, the per-type
+    parameters, and the global box. It is rebuilt only when one of these changes.
+*/
+template<class evaluator> void PotentialExternal<evaluator>::updateFieldGrid()
+    {
+    if (!evaluator::needsFieldGrid() || !m_field_grid_changed)
+        return;
+
+    ArrayHandle<param_type> h_params(m_params, access_location::host, access_mode::read);
+    ArrayHandle<field_type> h_field(m_field, access_location::host, access_mode::read);
+
+    std::vector<unsigned int> grid;
+    evaluator::buildFieldGrid(*(h_field.data),
+                              h_params.data,
+                              m_pdata->getNTypes(),
+                              m_pdata->getGlobalBox(),
+                              m_sysdef->getNDimensions(),
+                              m_field_grid_dim,
+                              grid);
+
+    if (m_field_grid.getNumElements() != grid.size())
+        {
+        GPUArray<unsigned int> field_grid(grid.size(), m_exec_conf);
+        m_field_grid.swap(field_grid);
+        }
+
+    ArrayHandle<unsigned int> h_field_grid(m_field_grid,
+                                           access_location::host,
+                                           access_mode::overwrite);
+    std::copy(grid.begin(), grid.end(), h_field_grid.data);
+    m_field_grid_changed = false;
+    }
 
 /*! Computes the specified constraint forces
     \param timestep Current timestep
@@ -86,6 +154,8 @@ template<class evaluator> void PotentialExternal<evaluator>::computeForces(uint6
         m_prof->push("PotentialExternal");
 
     assert(m_pdata);
+    updateFieldGrid();
+
     // access the particle data arrays
     ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
 
@@ -99,6 +169,7 @@ template<class evaluator> void PotentialExternal<evaluator>::computeForces(uint6
     ArrayHandle<param_type> h_params(m_params, access_location::host, access_mode::read);
     ArrayHandle<field_type> h_field(m_field, access_location::host, access_mode::read);
     const field_type& field = *(h_field.data);
+    ArrayHandle<unsigned int> h_field_grid(m_field_grid, access_location::host, access_mode::read);
 
     const BoxDim& box = m_pdata->getGlobalBox();
     PDataFlags flags = this->m_pdata->getFlags();
@@ -147,6 +218,8 @@ template<class evaluator> void PotentialExternal<evaluator>::computeForces(uint6
             Scalar qi = h_charge.data[idx];
             eval.setCharge(qi);
             }
+        if (evaluator::needsFieldGrid())
+            eval.setFieldGrid(box, h_field_grid.data, m_field_grid_dim, type);
         eval.evalForceEnergyAndVirial(F, energy, virial);
 
         // apply the constraint force
@@ -181,6 +254,7 @@ void PotentialExternal<evaluator>::setParams(unsigned int type, const param_type
     validateType(type, std::string("setting parameters in PotentialExternal"));
     ArrayHandle<param_type> h_params(m_params, access_location::host, access_mode::readwrite);
     h_params.data[type] = params;
+    m_field_grid_changed = true;
     }
 
 template<class evaluator> pybind11::object PotentialExternal<evaluator>::getParams(std::string type)
@@ -203,6 +277,7 @@ template<class evaluator> void PotentialExternal<evaluator>::setField(field_type
     {
     ArrayHandle<field_type> h_field(m_field, access_location::host, access_mode::overwrite);
     *(h_field.data) = field;
+    m_field_grid_changed = true;
     }
 
 //! Export this external potential to python
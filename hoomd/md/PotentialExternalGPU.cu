@@ -1,6 +1,7 @@
 // Copyright (c) 2009-2021 The Regents of the University of Michigan
 // This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
 
+#include "EvaluatorExternalComposite.h"
 #include "EvaluatorExternalElectricField.h"
 #include "EvaluatorExternalPeriodic.h"
 #include "EvaluatorPairForceShiftedLJ.h"
@@ -25,6 +26,14 @@ template hipError_t __attribute__((visibility("default"))) gpu_cpef<EvaluatorExt
     const external_potential_args_t& external_potential_args,
     const typename EvaluatorExternalElectricField::param_type* d_params,
     const typename EvaluatorExternalElectricField::field_type* d_field);
+//! Evaluator for periodic and electric fields together
+template hipError_t __attribute__((visibility("default")))
+gpu_cpef<EvaluatorExternalComposite<EvaluatorExternalPeriodic, EvaluatorExternalElectricField>>(
+    const external_potential_args_t& external_potential_args,
+    const typename EvaluatorExternalComposite<EvaluatorExternalPeriodic,
+                                              EvaluatorExternalElectricField>::param_type* d_params,
+    const typename EvaluatorExternalComposite<EvaluatorExternalPeriodic,
+                                              EvaluatorExternalElectricField>::field_type* d_field);
 //! Evaluator for Lennard-Jones pair potential.
 template hipError_t __attribute__((visibility("default")))
 gpu_cpef<EvaluatorWalls<EvaluatorPairLJ>>(
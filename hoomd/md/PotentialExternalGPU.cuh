@@ -23,24 +23,32 @@ struct external_potential_args_t
     external_potential_args_t(Scalar4* _d_force,
                               Scalar* _d_virial,
                               const size_t _virial_pitch,
+                              const bool _compute_virial,
                               const unsigned int _N,
                               const Scalar4* _d_pos,
                               const Scalar* _d_diameter,
                               const Scalar* _d_charge,
                               const BoxDim& _box,
+                              const unsigned int* _d_field_grid,
+                              const uint3 _field_grid_dim,
                               const unsigned int _block_size)
-        : d_force(_d_force), d_virial(_d_virial), virial_pitch(_virial_pitch), box(_box), N(_N),
-          d_pos(_d_pos), d_diameter(_d_diameter), d_charge(_d_charge), block_size(_block_size) {};
-
-    Scalar4* d_force;              //!< Force to write out
-    Scalar* d_virial;              //!< Virial to write out
-    const size_t virial_pitch;     //!< The pitch of the 2D array of virial matrix elements
-    const BoxDim& box;             //!< Simulation box in GPU format
-    const unsigned int N;          //!< Number of particles
-    const Scalar4* d_pos;          //!< Device array of particle positions
-    const Scalar* d_diameter;      //!< particle diameters
-    const Scalar* d_charge;        //!< particle charges
-    const unsigned int block_size; //!< Block size to execute
+        : d_force(_d_force), d_virial(_d_virial), virial_pitch(_virial_pitch),
+          compute_virial(_compute_virial), box(_box), N(_N), d_pos(_d_pos), d_diameter(_d_diameter),
+          d_charge(_d_charge), d_field_grid(_d_field_grid), field_grid_dim(_field_grid_dim),
+          block_size(_block_size) {};
+
+    Scalar4* d_force;                 //!< Force to write out
+    Scalar* d_virial;                 //!< Virial to write out
+    const size_t virial_pitch;        //!< The pitch of the 2D array of virial matrix elements
+    const bool compute_virial;        //!< When false, the virials are not written
+    const BoxDim& box;                //!< Simulation box in GPU format
+    const unsigned int N;             //!< Number of particles
+    const Scalar4* d_pos;             //!< Device array of particle positions
+    const Scalar* d_diameter;         //!< particle diameters
+    const Scalar* d_charge;           //!< particle charges
+    const unsigned int* d_field_grid; //!< Field grid of evaluators that use one
+    const uint3 field_grid_dim;       //!< Dimensions of the field grid
+    const unsigned int block_size;    //!< Block size to execute
     };
 
 //! Driver function for compute external field kernel
@@ -64,23 +72,30 @@ gpu_cpef(const external_potential_args_t& external_potential_args,
     \param d_force Device memory to write computed forces
     \param d_virial Device memory to write computed virials
     \param virial_pitch pitch of 2D virial array
+    \param compute_virial Whether to write the virials
     \param N number of particles
     \param d_pos device array of particle positions
     \param box Box dimensions used to implement periodic boundary conditions
     \param params per-type array of parameters for the potential
+    \param d_field field parameters
+    \param d_field_grid field grid of evaluators that use one
+    \param field_grid_dim dimensions of the field grid
 
 */
 template<class evaluator>
 __global__ void gpu_compute_external_forces_kernel(Scalar4* d_force,
                                                    Scalar* d_virial,
                                                    const size_t virial_pitch,
+                                                   const bool compute_virial,
                                                    const unsigned int N,
                                                    const Scalar4* d_pos,
                                                    const Scalar* d_diameter,
                                                    const Scalar* d_charge,
                                                    const BoxDim box,
                                                    const typename evaluator::param_type* params,
-                                                   const typename evaluator::field_type* d_field)
+                                                   const typename evaluator::field_type* d_field,
+                                                   const unsigned int* d_field_grid,
+                                                   const uint3 field_grid_dim)
     {
     // start by identifying which particle we are to handle
     unsigned int idx = blockIdx.x * blockDim.x + threadIdx.x;
@@ -139,6 +154,8 @@ __global__ void gpu_compute_external_forces_kernel(Scalar4* d_force,
         eval.setDiameter(di);
     if (evaluator::needsCharge())
         eval.setCharge(qi);
+    if (evaluator::needsFieldGrid())
+        eval.setFieldGrid(box, d_field_grid, field_grid_dim, typei);
 
     eval.evalForceEnergyAndVirial(force, energy, virial);
 
@@ -148,8 +165,11 @@ __global__ void gpu_compute_external_forces_kernel(Scalar4* d_force,
     d_force[idx].z = force.z;
     d_force[idx].w = energy;
 
-    for (unsigned int k = 0; k < 6; k++)
-        d_virial[k * virial_pitch + idx] = virial[k];
+    if (compute_virial)
+        {
+        for (unsigned int k = 0; k < 6; k++)
+            d_virial[k * virial_pitch + idx] = virial[k];
+        }
     }
 
 /*!
@@ -187,13 +207,16 @@ hipError_t gpu_cpef(const external_potential_args_t& external_potential_args,
                        external_potential_args.d_force,
                        external_potential_args.d_virial,
                        external_potential_args.virial_pitch,
+                       external_potential_args.compute_virial,
                        external_potential_args.N,
                        external_potential_args.d_pos,
                        external_potential_args.d_diameter,
                        external_potential_args.d_charge,
                        external_potential_args.box,
                        d_params,
-                       d_field);
+                       d_field,
+                       external_potential_args.d_field_grid,
+                       external_potential_args.field_grid_dim);
 
     return hipSuccess;
     };
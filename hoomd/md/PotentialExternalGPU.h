@@ -74,6 +74,8 @@ template<class evaluator> void PotentialExternalGPU<evaluator>::computeForces(ui
     if (this->m_prof)
         this->m_prof->push(this->m_exec_conf, "PotentialExternalGPU");
 
+    this->updateFieldGrid();
+
     // access the particle data
     ArrayHandle<Scalar4> d_pos(this->m_pdata->getPositions(),
                                access_location::device,
@@ -95,6 +97,9 @@ template<class evaluator> void PotentialExternalGPU<evaluator>::computeForces(ui
     ArrayHandle<typename evaluator::field_type> d_field(this->m_field,
                                                         access_location::device,
                                                         access_mode::read);
+    ArrayHandle<unsigned int> d_field_grid(this->m_field_grid,
+                                           access_location::device,
+                                           access_mode::read);
 
     // access flags
     PDataFlags flags = this->m_pdata->getFlags();
@@ -103,11 +108,14 @@ template<class evaluator> void PotentialExternalGPU<evaluator>::computeForces(ui
     gpu_cpef<evaluator>(external_potential_args_t(d_force.data,
                                                   d_virial.data,
                                                   this->m_virial.getPitch(),
+                                                  flags[pdata_flag::pressure_tensor],
                                                   this->m_pdata->getN(),
                                                   d_pos.data,
                                                   d_diameter.data,
                                                   d_charge.data,
                                                   box,
+                                                  d_field_grid.data,
+                                                  this->m_field_grid_dim,
                                                   this->m_tuner->getParam()),
                         d_params.data,
                         d_field.data);
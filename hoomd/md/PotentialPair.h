@@ -6,18 +6,22 @@
 #ifndef __POTENTIAL_PAIR_H__
 #define __POTENTIAL_PAIR_H__
 
+#include <algorithm>
 #include <iostream>
+#include <map>
 #include <memory>
 #include <pybind11/numpy.h>
 #include <pybind11/pybind11.h>
 #include <stdexcept>
 
 #include "NeighborList.h"
+#include "PairEvaluatorBatchTraits.h"
 #include "hoomd/ForceCompute.h"
 #include "hoomd/GSDShapeSpecWriter.h"
 #include "hoomd/GlobalArray.h"
 #include "hoomd/HOOMDMath.h"
 #include "hoomd/Index1D.h"
+#include "hoomd/Variant.h"
 #include "hoomd/managed_allocator.h"
 #include "hoomd/md/EvaluatorPairLJ.h"
 
@@ -29,6 +33,12 @@
 #include "hoomd/Communicator.h"
 #endif
 
+#ifdef ENABLE_TBB
+#include <tbb/blocked_range.h>
+#include <tbb/enumerable_thread_specific.h>
+#include <tbb/parallel_for.h>
+#endif
+
 /*! \file PotentialPair.h
     \brief Defines the template class for standard pair potentials
     \details The heart of the code that computes pair potentials is in this file.
@@ -39,6 +49,9 @@
 #error This header cannot be compiled by nvcc
 #endif
 
+//! Number of neighbors evaluated together in the batched CPU force loop
+const unsigned int pair_batch_width = 8;
+
 //! Template class for computing pair potentials
 /*! <b>Overview:</b>
     PotentialPair computes standard pair potentials (and forces) between all particle pairs in the
@@ -100,6 +113,8 @@ template<class evaluator> class PotentialPair : public ForceCompute
     virtual void setParamsPython(pybind11::tuple typ, pybind11::dict params);
     /// Get params for a single type pair using a tuple of strings
     virtual pybind11::dict getParams(pybind11::tuple typ);
+    /// Set a parameter of a single type pair to follow a variant, or stop with a null variant
+    void setParamVariant(pybind11::tuple typ, std::string name, std::shared_ptr<Variant> variant);
     //! Set the rcut for a single type pair
     virtual void setRcut(unsigned int typ1, unsigned int typ2, Scalar rcut);
     /// Get the r_cut for a single type pair
@@ -169,6 +184,30 @@ template<class evaluator> class PotentialPair : public ForceCompute
             }
         }
 
+    /// Set whether the GPU kernel reads single precision positions relative to the local box
+    void setCompactPositions(bool compact_positions)
+        {
+        m_compact_positions = compact_positions;
+        }
+
+    /// Get whether the GPU kernel reads single precision positions relative to the local box
+    bool getCompactPositions()
+        {
+        return m_compact_positions;
+        }
+
+    /// Set whether the CPU force loop uses the batched loop when the evaluator supports it
+    void setBatched(bool batched)
+        {
+        m_batched = batched;
+        }
+
+    /// Get whether the CPU force loop uses the batched loop when the evaluator supports it
+    bool getBatched()
+        {
+        return m_batched;
+        }
+
     virtual void notifyDetach()
         {
         if (m_attached)
@@ -178,11 +217,35 @@ template<class evaluator> class PotentialPair : public ForceCompute
         m_attached = false;
         }
 
+    //! Pair forces may be computed concurrently with other forces
+    virtual bool supportsConcurrentCompute()
+        {
+        return true;
+        }
+
+    //! Pair forces overwrite the forces of all local particles, they may compute into shared arrays
+    virtual bool supportsElidedForceArrays()
+        {
+        return true;
+        }
+
+    //! Pair forces that share a neighbor list are computed on the same thread
+    virtual std::shared_ptr<Compute> getComputeDependency()
+        {
+        return m_nlist;
+        }
+
 #ifdef ENABLE_MPI
     //! Get ghost particle fields requested by this pair potential
     virtual CommFlags getRequestedCommFlags(uint64_t timestep);
+
+    //! Set the communicator to use
+    virtual void setCommunicator(std::shared_ptr<Communicator> comm);
 #endif
 
+    //! Compute the forces on the particles without ghost neighbors ahead of computeForces()
+    virtual void computeInteriorForces(uint64_t timestep);
+
     //! Calculates the energy between two lists of particles.
     template<class InputIterator>
     void computeEnergyBetweenSets(InputIterator first1,
@@ -220,11 +283,135 @@ template<class evaluator> class PotentialPair : public ForceCompute
     /// Track whether we have attached to the Simulation object
     bool m_attached = true;
 
+    /// When true, the GPU kernel reads single precision positions relative to the local box
+    bool m_compact_positions = false;
+
+    /// When true, the CPU force loop uses the batched loop for evaluators that support it
+    bool m_batched = true;
+
     /// r_cut (not squared) given to the neighbor list
     std::shared_ptr<GlobalArray<Scalar>> m_r_cut_nlist;
 
+    //! Parameters of a type pair that follow variants
+    struct ParamSchedule
+        {
+        pybind11::dict params; //!< Parameters last set from Python
+        std::map<std::string, std::shared_ptr<Variant>> variants; //!< Variant of each parameter
+        std::map<std::string, Scalar> values; //!< Values of the variants last applied
+        };
+
+    /// Parameter schedules by type pair, with the first type index not larger than the second
+    std::map<std::pair<unsigned int, unsigned int>, ParamSchedule> m_param_schedules;
+
+    /// First type pair index of the parameters modified since the last prefetch
+    unsigned int m_params_modified_begin = 0;
+
+    /// One past the last type pair index of the parameters modified since the last prefetch
+    unsigned int m_params_modified_end = 0;
+
+    /// True when m_force holds the interior forces computed by computeInteriorForces()
+    bool m_interior_computed = false;
+
+    /// Time step of the last call to computeInteriorForces()
+    uint64_t m_interior_timestep = 0;
+
+    /// Particle data flags of the last call to computeInteriorForces()
+    PDataFlags m_interior_flags;
+
+    //! Test if computeForces() at \a timestep only needs to compute the boundary particles
+    bool takeInteriorForces(uint64_t timestep)
+        {
+        bool result = m_interior_computed && m_interior_timestep == timestep
+                      && m_interior_flags == m_pdata->getFlags();
+        m_interior_computed = false;
+        return result;
+        }
+
+    //! Host pointers and flags shared by all ranges of the CPU force loop
+    struct ForceLoopArgs
+        {
+        const unsigned int* n_neigh;   //!< Number of neighbors of each particle
+        const unsigned int* nlist;     //!< Neighbor list
+        const unsigned int* head_list; //!< Index of the first neighbor of each particle
+        const unsigned int* index;     //!< Particles in loop order, NULL for the identity
+        const Scalar4* pos;            //!< Particle positions and types
+        const Scalar* diameter;        //!< Particle diameters
+        const Scalar* charge;          //!< Particle charges
+        const Scalar* rcutsq;          //!< Cutoff radius squared per type pair
+        const Scalar* ronsq;           //!< r_on squared per type pair
+        BoxDim box;                    //!< Global simulation box
+        unsigned int N;                //!< Number of local particles
+        bool third_law;                //!< True when the neighbor list stores each pair once
+        bool compute_virial;           //!< True when the virial is needed
+        };
+
+    //! Record that the parameters of the type pair indices [first, last) were modified
+    void markParamsModified(unsigned int first, unsigned int last)
+        {
+        if (m_params_modified_begin == m_params_modified_end)
+            {
+            m_params_modified_begin = first;
+            m_params_modified_end = last;
+            }
+        else
+            {
+            m_params_modified_begin = std::min(m_params_modified_begin, first);
+            m_params_modified_end = std::max(m_params_modified_end, last);
+            }
+        }
+
+    //! Prefetch the parameters modified since the last call to the active GPUs
+    void prefetchModifiedParams();
+
+    //! Set the parameters that follow variants to their values at the given time step
+    void updateParamSchedules(uint64_t timestep);
+
+    //! Update the scheduled parameters and compute the forces
+    virtual void compute(uint64_t timestep)
+        {
+        updateParamSchedules(timestep);
+        ForceCompute::compute(timestep);
+        }
+
     //! Actually compute the forces
     virtual void computeForces(uint64_t timestep);
+
+    //! Compute the forces on a range of particles
+    virtual void
+    computeForcesLoop(unsigned int begin, unsigned int end, bool ordered, bool accumulate);
+
+    //! Signature shared by all variants of the CPU force loop
+    typedef void (PotentialPair<evaluator>::*ForceLoop)(unsigned int begin,
+                                                        unsigned int end,
+                                                        const ForceLoopArgs& args,
+                                                        Scalar4* force,
+                                                        Scalar* virial,
+                                                        size_t virial_pitch);
+
+    //! Select the force loop variant for the current shift mode and flags
+    ForceLoop getForceLoop(bool compute_virial) const;
+
+    //! Select the force loop variant for a given shift mode
+    template<energyShiftMode shift_mode>
+    static ForceLoop selectForceLoop(bool compute_virial, bool batched);
+
+    //! Compute the forces on a range of local particles
+    template<energyShiftMode shift_mode, bool compute_virial>
+    void computeForcesRange(unsigned int begin,
+                            unsigned int end,
+                            const ForceLoopArgs& args,
+                            Scalar4* force,
+                            Scalar* virial,
+                            size_t virial_pitch);
+
+    //! Compute the forces on a range of local particles, evaluating neighbors in batches
+    template<energyShiftMode shift_mode, bool compute_virial>
+    void computeForcesRangeBatched(unsigned int begin,
+                                   unsigned int end,
+                                   const ForceLoopArgs& args,
+                                   Scalar4* force,
+                                   Scalar* virial,
+                                   size_t virial_pitch);
     };
 
 /*! \param sysdef System to compute forces on
@@ -303,6 +490,15 @@ template<class evaluator> PotentialPair<evaluator>::~PotentialPair()
         {
         m_nlist->removeRCutMatrix(m_r_cut_nlist);
         }
+
+#ifdef ENABLE_MPI
+    if (m_comm)
+        {
+        m_comm->getInteriorComputeCallbackSignal()
+            .template disconnect<PotentialPair<evaluator>,
+                                 &PotentialPair<evaluator>::computeInteriorForces>(this);
+        }
+#endif
     }
 
 /*! \param typ1 First type index in the pair
@@ -317,8 +513,36 @@ void PotentialPair<evaluator>::setParams(unsigned int typ1,
                                          const param_type& param)
     {
     validateTypes(typ1, typ2, "setting params");
-    m_params[m_typpair_idx(typ1, typ2)] = param;
-    m_params[m_typpair_idx(typ2, typ1)] = param;
+    unsigned int idx_12 = m_typpair_idx(typ1, typ2);
+    unsigned int idx_21 = m_typpair_idx(typ2, typ1);
+    m_params[idx_12] = param;
+    m_params[idx_21] = param;
+    markParamsModified(std::min(idx_12, idx_21), std::max(idx_12, idx_21) + 1);
+    }
+
+/*! Writing a parameter on the host invalidates the read duplicated copies of its pages on the
+    GPUs. Prefetch only the modified range, so that a parameter changed every few steps does not
+    cost page faults in the kernel nor a transfer of the whole array.
+*/
+template<class evaluator> void PotentialPair<evaluator>::prefetchModifiedParams()
+    {
+#if defined(ENABLE_HIP) && defined(__HIP_PLATFORM_NVCC__)
+    if (m_params_modified_begin != m_params_modified_end && m_exec_conf->isCUDAEnabled()
+        && m_exec_conf->allConcurrentManagedAccess())
+        {
+        auto& gpu_map = m_exec_conf->getGPUIds();
+        for (unsigned int idev = 0; idev < m_exec_conf->getNumActiveGPUs(); ++idev)
+            {
+            cudaMemPrefetchAsync(m_params.data() + m_params_modified_begin,
+                                 sizeof(param_type)
+                                     * (m_params_modified_end - m_params_modified_begin),
+                                 gpu_map[idev]);
+            }
+        }
+#endif
+
+    m_params_modified_begin = 0;
+    m_params_modified_end = 0;
     }
 
 template<class evaluator>
@@ -327,6 +551,103 @@ void PotentialPair<evaluator>::setParamsPython(pybind11::tuple typ, pybind11::di
     auto typ1 = m_pdata->getTypeByName(typ[0].cast<std::string>());
     auto typ2 = m_pdata->getTypeByName(typ[1].cast<std::string>());
     setParams(typ1, typ2, param_type(params, m_exec_conf->isCUDAEnabled()));
+
+    // the scheduled parameters start from the new values and are applied again at the next step
+    auto schedule = m_param_schedules.find(std::make_pair(std::min(typ1, typ2),
+                                                          std::max(typ1, typ2)));
+    if (schedule != m_param_schedules.end())
+        {
+        schedule->second.params = params.attr("copy")();
+        schedule->second.values.clear();
+        }
+    }
+
+/*! \param typ Type pair
+    \param name Name of the parameter, as in the dictionary given to setParamsPython()
+    \param variant Variant that sets the parameter value at each time step, or null to keep the
+           value set from Python
+
+    The other parameters of the type pair keep the values last set with setParamsPython(). The
+    parameters are rebuilt only at the time steps where a variant value changes, without calling
+    back into Python.
+*/
+template<class evaluator>
+void PotentialPair<evaluator>::setParamVariant(pybind11::tuple typ,
+                                               std::string name,
+                                               std::shared_ptr<Variant> variant)
+    {
+    auto typ1 = m_pdata->getTypeByName(typ[0].cast<std::string>());
+    auto typ2 = m_pdata->getTypeByName(typ[1].cast<std::string>());
+    validateTypes(typ1, typ2, "setting param variants");
+    auto key = std::make_pair(std::min(typ1, typ2), std::max(typ1, typ2));
+    auto schedule = m_param_schedules.find(key);
+
+    if (!variant)
+        {
+        if (schedule == m_param_schedules.end())
+            return;
+
+        // restore the value set from Python
+        schedule->second.variants.erase(name);
+        schedule->second.values.clear();
+        setParams(typ1, typ2, param_type(schedule->second.params, m_exec_conf->isCUDAEnabled()));
+        if (schedule->second.variants.empty())
+            m_param_schedules.erase(schedule);
+        return;
+        }
+
+    pybind11::dict params = schedule == m_param_schedules.end()
+                                ? m_params[m_typpair_idx(typ1, typ2)].asDict()
+                                : schedule->second.params;
+    if (!params.contains(name)
+        || !(pybind11::isinstance<pybind11::float_>(params[name.c_str()])
+             || pybind11::isinstance<pybind11::int_>(params[name.c_str()])))
+        {
+        throw std::runtime_error("Pair parameter " + name + " is not a scalar parameter of "
+                                 + evaluator::getName());
+        }
+
+    if (schedule == m_param_schedules.end())
+        {
+        ParamSchedule new_schedule;
+        new_schedule.params = params;
+        schedule = m_param_schedules.emplace(key, new_schedule).first;
+        }
+
+    schedule->second.variants[name] = variant;
+    schedule->second.values.clear();
+    }
+
+/*! \param timestep Current time step
+ */
+template<class evaluator> void PotentialPair<evaluator>::updateParamSchedules(uint64_t timestep)
+    {
+    for (auto& item : m_param_schedules)
+        {
+        ParamSchedule& schedule = item.second;
+
+        bool changed = false;
+        for (const auto& variant : schedule.variants)
+            {
+            Scalar value = (*variant.second)(timestep);
+            auto last = schedule.values.find(variant.first);
+            if (last == schedule.values.end() || last->second != value)
+                {
+                schedule.values[variant.first] = value;
+                changed = true;
+                }
+            }
+
+        if (!changed)
+            continue;
+
+        pybind11::dict params = schedule.params.attr("copy")();
+        for (const auto& value : schedule.values)
+            params[value.first.c_str()] = value.second;
+        setParams(item.first.first,
+                  item.first.second,
+                  param_type(params, m_exec_conf->isCUDAEnabled()));
+        }
     }
 
 template<class evaluator> pybind11::dict PotentialPair<evaluator>::getParams(pybind11::tuple typ)
@@ -451,6 +772,9 @@ int PotentialPair<evaluator>::slotWriteGSDShapeSpec(gsd_handle& handle) const
    called to ensure that it is up to date before proceeding.
 
     \param timestep specifies the current time step of the simulation
+
+    When the interior forces were computed by computeInteriorForces() at this step, only the
+   particles with ghost neighbors are computed.
 */
 template<class evaluator> void PotentialPair<evaluator>::computeForces(uint64_t timestep)
     {
@@ -461,10 +785,70 @@ template<class evaluator> void PotentialPair<evaluator>::computeForces(uint64_t
     if (m_prof)
         m_prof->push(m_prof_name);
 
-    // depending on the neighborlist settings, we can take advantage of newton's third law
-    // to reduce computations at the cost of memory access complexity: set that flag now
-    bool third_law = m_nlist->getStorageMode() == NeighborList::half;
+    if (takeInteriorForces(timestep))
+        {
+        // only the particles with ghost neighbors are left
+        computeForcesLoop(m_nlist->getNInterior(), m_pdata->getN(), true, true);
+        }
+    else
+        {
+        computeForcesLoop(0, m_pdata->getN(), false, false);
+        }
+
+    if (m_prof)
+        m_prof->pop();
+    }
+
+/*! \param timestep specifies the current time step of the simulation
+
+    The communicator calls this method while the ghost particle positions are in flight. When the
+   neighbor list does not change at \a timestep, the forces on the particles whose neighbors are
+   all local are computed now, and computeForces() completes the particles with ghost neighbors.
+*/
+template<class evaluator> void PotentialPair<evaluator>::computeInteriorForces(uint64_t timestep)
+    {
+    m_interior_computed = false;
+
+    // only split a force computation that will happen at this step with an unchanged list
+    if (!m_attached || m_particles_sorted || !peekCompute(timestep)
+        || !m_nlist->isUpToDate(timestep))
+        return;
+
+    // the interior pass must use the parameters of this step
+    updateParamSchedules(timestep);
+
+    m_nlist->compute(timestep);
+    m_nlist->updateBoundaryList();
+
+    if (m_prof)
+        m_prof->push(m_prof_name);
 
+    computeForcesLoop(0, m_nlist->getNInterior(), true, false);
+
+    if (m_prof)
+        m_prof->pop();
+
+    m_interior_computed = true;
+    m_interior_timestep = timestep;
+    m_interior_flags = m_pdata->getFlags();
+    }
+
+/*! \param begin First entry of the particle order to compute
+    \param end One past the last entry of the particle order to compute
+    \param ordered When true, entry k is particle m_nlist->getBoundaryList()[k], otherwise k
+    \param accumulate When true, add to the current forces instead of starting from zero
+
+    When HOOMD is built with TBB, the loop over particles is split among the threads of the
+   execution configuration's task arena. With a full neighbor list, each thread writes only the
+   forces of the particles it owns. With a half neighbor list, the reaction forces on neighbors are
+   accumulated in per-thread arrays and summed after the loop.
+*/
+template<class evaluator>
+void PotentialPair<evaluator>::computeForcesLoop(unsigned int begin,
+                                                 unsigned int end,
+                                                 bool ordered,
+                                                 bool accumulate)
+    {
     // access the neighbor list, particle data, and system box
     ArrayHandle<unsigned int> h_n_neigh(m_nlist->getNNeighArray(),
                                         access_location::host,
@@ -477,6 +861,10 @@ template<class evaluator> void PotentialPair<evaluator>::computeForces(uint64_t
                                           access_location::host,
                                           access_mode::read);
 
+    ArrayHandle<unsigned int> h_boundary_list(m_nlist->getBoundaryList(),
+                                              access_location::host,
+                                              access_mode::read);
+
     ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
     ArrayHandle<Scalar> h_diameter(m_pdata->getDiameters(),
                                    access_location::host,
@@ -484,26 +872,163 @@ template<class evaluator> void PotentialPair<evaluator>::computeForces(uint64_t
     ArrayHandle<Scalar> h_charge(m_pdata->getCharges(), access_location::host, access_mode::read);
 
     // force arrays
-    ArrayHandle<Scalar4> h_force(m_force, access_location::host, access_mode::overwrite);
-    ArrayHandle<Scalar> h_virial(m_virial, access_location::host, access_mode::overwrite);
+    const access_mode::Enum force_mode
+        = accumulate ? access_mode::readwrite : access_mode::overwrite;
+    ArrayHandle<Scalar4> h_force(m_force, access_location::host, force_mode);
+    ArrayHandle<Scalar> h_virial(m_virial, access_location::host, force_mode);
 
-    const BoxDim& box = m_pdata->getGlobalBox();
     ArrayHandle<Scalar> h_ronsq(m_ronsq, access_location::host, access_mode::read);
     ArrayHandle<Scalar> h_rcutsq(m_rcutsq, access_location::host, access_mode::read);
 
     PDataFlags flags = this->m_pdata->getFlags();
-    bool compute_virial = flags[pdata_flag::pressure_tensor];
+
+    ForceLoopArgs args;
+    args.n_neigh = h_n_neigh.data;
+    args.nlist = h_nlist.data;
+    args.head_list = h_head_list.data;
+    args.index = ordered ? h_boundary_list.data : NULL;
+    args.pos = h_pos.data;
+    args.diameter = h_diameter.data;
+    args.charge = h_charge.data;
+    args.rcutsq = h_rcutsq.data;
+    args.ronsq = h_ronsq.data;
+    args.box = m_pdata->getGlobalBox();
+    args.N = m_pdata->getN();
+    // depending on the neighborlist settings, we can take advantage of newton's third law
+    // to reduce computations at the cost of memory access complexity: set that flag now
+    args.third_law = m_nlist->getStorageMode() == NeighborList::half;
+    args.compute_virial = flags[pdata_flag::pressure_tensor];
+
+    // choose the loop instantiation once for this step
+    const ForceLoop force_loop = getForceLoop(args.compute_virial);
 
     // need to start from a zero force, energy and virial
-    memset((void*)h_force.data, 0, sizeof(Scalar4) * m_force.getNumElements());
-    memset((void*)h_virial.data, 0, sizeof(Scalar) * m_virial.getNumElements());
+    if (!accumulate)
+        {
+        memset((void*)h_force.data, 0, sizeof(Scalar4) * m_force.getNumElements());
+        memset((void*)h_virial.data, 0, sizeof(Scalar) * m_virial.getNumElements());
+        }
+
+#ifdef ENABLE_TBB
+    if (!args.third_law)
+        {
+        // each particle only writes its own force: no synchronization is needed
+        m_exec_conf->getTaskArena()->execute(
+            [&]
+            {
+                tbb::parallel_for(tbb::blocked_range<unsigned int>(begin, end),
+                                  [&](const tbb::blocked_range<unsigned int>& r)
+                                  {
+                                      (this->*force_loop)(r.begin(),
+                                                          r.end(),
+                                                          args,
+                                                          h_force.data,
+                                                          h_virial.data,
+                                                          m_virial_pitch);
+                                  });
+            });
+        return;
+        }
+#endif
+
+    // reaction forces on the neighbors are accumulated per thread
+    scatterForces(begin,
+                  end,
+                  args.compute_virial,
+                  h_force.data,
+                  h_virial.data,
+                  [&](unsigned int r_begin,
+                      unsigned int r_end,
+                      Scalar4* force,
+                      Scalar* virial,
+                      size_t virial_pitch)
+                  { (this->*force_loop)(r_begin, r_end, args, force, virial, virial_pitch); });
+    }
+
+
+/*! \param compute_virial True when the virial is needed
+
+    The force loop is instantiated for every combination of energy shift mode and virial flag, so
+   the inner loop does not branch on them. Evaluators that opt in to PairEvaluatorBatchTraits use
+   the batched loop unless it is disabled with setBatched().
+
+    \returns A pointer to the force loop member function to call this step
+*/
+template<class evaluator>
+typename PotentialPair<evaluator>::ForceLoop
+PotentialPair<evaluator>::getForceLoop(bool compute_virial) const
+    {
+    switch (m_shift_mode)
+        {
+    case no_shift:
+        return selectForceLoop<no_shift>(compute_virial, m_batched);
+    case shift:
+        return selectForceLoop<shift>(compute_virial, m_batched);
+    case xplor:
+        return selectForceLoop<xplor>(compute_virial, m_batched);
+    default:
+        throw std::runtime_error("Invalid energy shift mode.");
+        }
+    }
+
+/*! \param compute_virial True when the virial is needed
+    \param batched True to use the batched loop when the evaluator supports it
+    \tparam shift_mode Energy shift mode
+    \returns A pointer to the force loop member function for \a shift_mode
+*/
+template<class evaluator>
+template<typename PotentialPair<evaluator>::energyShiftMode shift_mode>
+typename PotentialPair<evaluator>::ForceLoop
+PotentialPair<evaluator>::selectForceLoop(bool compute_virial, bool batched)
+    {
+    if (PairEvaluatorBatchTraits<evaluator>::enabled && batched)
+        {
+        if (compute_virial)
+            return &PotentialPair<evaluator>::computeForcesRangeBatched<shift_mode, true>;
+        else
+            return &PotentialPair<evaluator>::computeForcesRangeBatched<shift_mode, false>;
+        }
+
+    if (compute_virial)
+        return &PotentialPair<evaluator>::computeForcesRange<shift_mode, true>;
+    else
+        return &PotentialPair<evaluator>::computeForcesRange<shift_mode, false>;
+    }
+
+/*! \param begin First entry of the particle order to compute
+    \param end One past the last entry of the particle order to compute
+    \param args Host pointers and flags for the force loop
+    \param force Force array to accumulate into
+    \param virial Virial array to accumulate into
+    \param virial_pitch Pitch of \a virial
+    \tparam shift_mode Energy shift mode
+    \tparam compute_virial True when the virial is needed
+
+    Entry k of the particle order is particle args.index[k], or particle k when args.index is NULL.
+   Forces on the particles of entries [begin, end) are added to \a force and \a virial. When the
+   neighbor list uses half storage, the reaction on local neighbors j is also added to \a force and
+   \a virial, so concurrent callers must pass separate arrays.
+*/
+template<class evaluator>
+template<typename PotentialPair<evaluator>::energyShiftMode shift_mode, bool compute_virial>
+void PotentialPair<evaluator>::computeForcesRange(unsigned int begin,
+                                                  unsigned int end,
+                                                  const ForceLoopArgs& args,
+                                                  Scalar4* force,
+                                                  Scalar* virial,
+                                                  size_t virial_pitch)
+    {
+    const BoxDim& box = args.box;
+    const bool third_law = args.third_law;
 
     // for each particle
-    for (int i = 0; i < (int)m_pdata->getN(); i++)
+    for (unsigned int loop_idx = begin; loop_idx < end; loop_idx++)
         {
+        const unsigned int i = args.index ? args.index[loop_idx] : loop_idx;
+
         // access the particle's position and type (MEM TRANSFER: 4 scalars)
-        Scalar3 pi = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
-        unsigned int typei = __scalar_as_int(h_pos.data[i].w);
+        Scalar3 pi = make_scalar3(args.pos[i].x, args.pos[i].y, args.pos[i].z);
+        unsigned int typei = __scalar_as_int(args.pos[i].w);
 
         // sanity check
         assert(typei < m_pdata->getNTypes());
@@ -512,9 +1037,9 @@ template<class evaluator> void PotentialPair<evaluator>::computeForces(uint64_t
         Scalar di = Scalar(0.0);
         Scalar qi = Scalar(0.0);
         if (evaluator::needsDiameter())
-            di = h_diameter.data[i];
+            di = args.diameter[i];
         if (evaluator::needsCharge())
-            qi = h_charge.data[i];
+            qi = args.charge[i];
 
         // initialize current particle force, potential energy, and virial to 0
         Scalar3 fi = make_scalar3(0, 0, 0);
@@ -527,29 +1052,29 @@ template<class evaluator> void PotentialPair<evaluator>::computeForces(uint64_t
         Scalar virialzzi = 0.0;
 
         // loop over all of the neighbors of this particle
-        const unsigned int myHead = h_head_list.data[i];
-        const unsigned int size = (unsigned int)h_n_neigh.data[i];
+        const unsigned int myHead = args.head_list[i];
+        const unsigned int size = (unsigned int)args.n_neigh[i];
         for (unsigned int k = 0; k < size; k++)
             {
             // access the index of this neighbor (MEM TRANSFER: 1 scalar)
-            unsigned int j = h_nlist.data[myHead + k];
+            unsigned int j = args.nlist[myHead + k];
             assert(j < m_pdata->getN() + m_pdata->getNGhosts());
 
             // calculate dr_ji (MEM TRANSFER: 3 scalars / FLOPS: 3)
-            Scalar3 pj = make_scalar3(h_pos.data[j].x, h_pos.data[j].y, h_pos.data[j].z);
+            Scalar3 pj = make_scalar3(args.pos[j].x, args.pos[j].y, args.pos[j].z);
             Scalar3 dx = pi - pj;
 
             // access the type of the neighbor particle (MEM TRANSFER: 1 scalar)
-            unsigned int typej = __scalar_as_int(h_pos.data[j].w);
+            unsigned int typej = __scalar_as_int(args.pos[j].w);
             assert(typej < m_pdata->getNTypes());
 
             // access diameter and charge (if needed)
             Scalar dj = Scalar(0.0);
             Scalar qj = Scalar(0.0);
             if (evaluator::needsDiameter())
-                dj = h_diameter.data[j];
+                dj = args.diameter[j];
             if (evaluator::needsCharge())
-                qj = h_charge.data[j];
+                qj = args.charge[j];
 
             // apply periodic boundary conditions
             dx = box.minImage(dx);
@@ -559,19 +1084,19 @@ template<class evaluator> void PotentialPair<evaluator>::computeForces(uint64_t
 
             // get parameters for this type pair
             unsigned int typpair_idx = m_typpair_idx(typei, typej);
-            param_type param = m_params[typpair_idx];
-            Scalar rcutsq = h_rcutsq.data[typpair_idx];
+            const param_type& param = m_params[typpair_idx];
+            Scalar rcutsq = args.rcutsq[typpair_idx];
             Scalar ronsq = Scalar(0.0);
-            if (m_shift_mode == xplor)
-                ronsq = h_ronsq.data[typpair_idx];
+            if (shift_mode == xplor)
+                ronsq = args.ronsq[typpair_idx];
 
             // design specifies that energies are shifted if
             // 1) shift mode is set to shift
             // or 2) shift mode is explor and ron > rcut
             bool energy_shift = false;
-            if (m_shift_mode == shift)
+            if (shift_mode == shift)
                 energy_shift = true;
-            else if (m_shift_mode == xplor)
+            else if (shift_mode == xplor)
                 {
                 if (ronsq > rcutsq)
                     energy_shift = true;
@@ -591,7 +1116,7 @@ template<class evaluator> void PotentialPair<evaluator>::computeForces(uint64_t
             if (evaluated)
                 {
                 // modify the potential for xplor shifting
-                if (m_shift_mode == xplor)
+                if (shift_mode == xplor)
                     {
                     if (rsq >= ronsq && rsq < rcutsq)
                         {
@@ -636,21 +1161,21 @@ template<class evaluator> void PotentialPair<evaluator>::computeForces(uint64_t
 
                 // add the force to particle j if we are using the third law (MEM TRANSFER: 10
                 // scalars / FLOPS: 8) only add force to local particles
-                if (third_law && j < m_pdata->getN())
+                if (third_law && j < args.N)
                     {
                     unsigned int mem_idx = j;
-                    h_force.data[mem_idx].x -= dx.x * force_divr;
-                    h_force.data[mem_idx].y -= dx.y * force_divr;
-                    h_force.data[mem_idx].z -= dx.z * force_divr;
-                    h_force.data[mem_idx].w += pair_eng * Scalar(0.5);
+                    force[mem_idx].x -= dx.x * force_divr;
+                    force[mem_idx].y -= dx.y * force_divr;
+                    force[mem_idx].z -= dx.z * force_divr;
+                    force[mem_idx].w += pair_eng * Scalar(0.5);
                     if (compute_virial)
                         {
-                        h_virial.data[0 * m_virial_pitch + mem_idx] += force_div2r * dx.x * dx.x;
-                        h_virial.data[1 * m_virial_pitch + mem_idx] += force_div2r * dx.x * dx.y;
-                        h_virial.data[2 * m_virial_pitch + mem_idx] += force_div2r * dx.x * dx.z;
-                        h_virial.data[3 * m_virial_pitch + mem_idx] += force_div2r * dx.y * dx.y;
-                        h_virial.data[4 * m_virial_pitch + mem_idx] += force_div2r * dx.y * dx.z;
-                        h_virial.data[5 * m_virial_pitch + mem_idx] += force_div2r * dx.z * dx.z;
+                        virial[0 * virial_pitch + mem_idx] += force_div2r * dx.x * dx.x;
+                        virial[1 * virial_pitch + mem_idx] += force_div2r * dx.x * dx.y;
+                        virial[2 * virial_pitch + mem_idx] += force_div2r * dx.x * dx.z;
+                        virial[3 * virial_pitch + mem_idx] += force_div2r * dx.y * dx.y;
+                        virial[4 * virial_pitch + mem_idx] += force_div2r * dx.y * dx.z;
+                        virial[5 * virial_pitch + mem_idx] += force_div2r * dx.z * dx.z;
                         }
                     }
                 }
@@ -658,23 +1183,218 @@ template<class evaluator> void PotentialPair<evaluator>::computeForces(uint64_t
 
         // finally, increment the force, potential energy and virial for particle i
         unsigned int mem_idx = i;
-        h_force.data[mem_idx].x += fi.x;
-        h_force.data[mem_idx].y += fi.y;
-        h_force.data[mem_idx].z += fi.z;
-        h_force.data[mem_idx].w += pei;
+        force[mem_idx].x += fi.x;
+        force[mem_idx].y += fi.y;
+        force[mem_idx].z += fi.z;
+        force[mem_idx].w += pei;
         if (compute_virial)
             {
-            h_virial.data[0 * m_virial_pitch + mem_idx] += virialxxi;
-            h_virial.data[1 * m_virial_pitch + mem_idx] += virialxyi;
-            h_virial.data[2 * m_virial_pitch + mem_idx] += virialxzi;
-            h_virial.data[3 * m_virial_pitch + mem_idx] += virialyyi;
-            h_virial.data[4 * m_virial_pitch + mem_idx] += virialyzi;
-            h_virial.data[5 * m_virial_pitch + mem_idx] += virialzzi;
+            virial[0 * virial_pitch + mem_idx] += virialxxi;
+            virial[1 * virial_pitch + mem_idx] += virialxyi;
+            virial[2 * virial_pitch + mem_idx] += virialxzi;
+            virial[3 * virial_pitch + mem_idx] += virialyyi;
+            virial[4 * virial_pitch + mem_idx] += virialyzi;
+            virial[5 * virial_pitch + mem_idx] += virialzzi;
             }
         }
+    }
 
-    if (m_prof)
-        m_prof->pop();
+/*! \param begin First entry of the particle order to compute
+    \param end One past the last entry of the particle order to compute
+    \param args Host pointers and flags for the force loop
+    \param force Force array to accumulate into
+    \param virial Virial array to accumulate into
+    \param virial_pitch Pitch of \a virial
+    \tparam shift_mode Energy shift mode
+    \tparam compute_virial True when the virial is needed
+
+    Same as computeForcesRange(), but the neighbors of each particle are processed
+   pair_batch_width at a time. Each batch is gathered into aligned lanes, the minimum image,
+   distance, and evaluator are computed for all lanes, and then the results are accumulated in
+   neighbor list order. Unused lanes are padded with rcutsq = 0 so the evaluator rejects them.
+*/
+template<class evaluator>
+template<typename PotentialPair<evaluator>::energyShiftMode shift_mode, bool compute_virial>
+void PotentialPair<evaluator>::computeForcesRangeBatched(unsigned int begin,
+                                                         unsigned int end,
+                                                         const ForceLoopArgs& args,
+                                                         Scalar4* force,
+                                                         Scalar* virial,
+                                                         size_t virial_pitch)
+    {
+    const BoxDim box = args.box;
+    const bool third_law = args.third_law;
+    const param_type* params = m_params.data();
+    const unsigned int W = pair_batch_width;
+
+    alignas(64) Scalar lane_dx[pair_batch_width];
+    alignas(64) Scalar lane_dy[pair_batch_width];
+    alignas(64) Scalar lane_dz[pair_batch_width];
+    alignas(64) Scalar lane_rsq[pair_batch_width];
+    alignas(64) Scalar lane_rcutsq[pair_batch_width];
+    alignas(64) Scalar lane_ronsq[pair_batch_width];
+    alignas(64) Scalar lane_force_divr[pair_batch_width];
+    alignas(64) Scalar lane_pair_eng[pair_batch_width];
+    alignas(64) unsigned int lane_typpair[pair_batch_width];
+
+    for (unsigned int loop_idx = begin; loop_idx < end; loop_idx++)
+        {
+        const unsigned int i = args.index ? args.index[loop_idx] : loop_idx;
+        const Scalar4 postypei = args.pos[i];
+        const unsigned int typei = __scalar_as_int(postypei.w);
+        assert(typei < m_pdata->getNTypes());
+
+        Scalar3 fi = make_scalar3(0, 0, 0);
+        Scalar pei = 0.0;
+        Scalar virialxxi = 0.0;
+        Scalar virialxyi = 0.0;
+        Scalar virialxzi = 0.0;
+        Scalar virialyyi = 0.0;
+        Scalar virialyzi = 0.0;
+        Scalar virialzzi = 0.0;
+
+        const unsigned int* neighbors = args.nlist + args.head_list[i];
+        const unsigned int size = (unsigned int)args.n_neigh[i];
+        for (unsigned int k0 = 0; k0 < size; k0 += W)
+            {
+            const unsigned int n_lanes = std::min(W, size - k0);
+
+            // gather the neighbor coordinates and type pair parameters into the lanes
+            for (unsigned int l = 0; l < n_lanes; l++)
+                {
+                const unsigned int j = neighbors[k0 + l];
+                assert(j < m_pdata->getN() + m_pdata->getNGhosts());
+                const Scalar4 postypej = args.pos[j];
+                lane_dx[l] = postypei.x - postypej.x;
+                lane_dy[l] = postypei.y - postypej.y;
+                lane_dz[l] = postypei.z - postypej.z;
+                const unsigned int typpair_idx
+                    = m_typpair_idx(typei, __scalar_as_int(postypej.w));
+                lane_typpair[l] = typpair_idx;
+                lane_rcutsq[l] = args.rcutsq[typpair_idx];
+                lane_ronsq[l] = args.ronsq[typpair_idx];
+                }
+            for (unsigned int l = n_lanes; l < W; l++)
+                {
+                lane_dx[l] = Scalar(1.0);
+                lane_dy[l] = Scalar(0.0);
+                lane_dz[l] = Scalar(0.0);
+                lane_typpair[l] = lane_typpair[0];
+                lane_rcutsq[l] = Scalar(0.0);
+                lane_ronsq[l] = Scalar(0.0);
+                }
+
+            // apply periodic boundary conditions and compute r_ij squared
+#pragma omp simd
+            for (unsigned int l = 0; l < W; l++)
+                {
+                Scalar3 dx = box.minImage(make_scalar3(lane_dx[l], lane_dy[l], lane_dz[l]));
+                lane_dx[l] = dx.x;
+                lane_dy[l] = dx.y;
+                lane_dz[l] = dx.z;
+                lane_rsq[l] = dot(dx, dx);
+                }
+
+            // evaluate the force and potential energy in every lane
+#pragma omp simd
+            for (unsigned int l = 0; l < W; l++)
+                {
+                const Scalar rsq = lane_rsq[l];
+                const Scalar rcutsq = lane_rcutsq[l];
+                const Scalar ronsq = lane_ronsq[l];
+
+                // design specifies that energies are shifted if
+                // 1) shift mode is set to shift
+                // or 2) shift mode is explor and ron > rcut
+                const bool energy_shift
+                    = shift_mode == shift || (shift_mode == xplor && ronsq > rcutsq);
+
+                Scalar force_divr = Scalar(0.0);
+                Scalar pair_eng = Scalar(0.0);
+                evaluator eval(rsq, rcutsq, params[lane_typpair[l]]);
+                const bool evaluated = eval.evalForceAndEnergy(force_divr, pair_eng, energy_shift);
+
+                if (evaluated && shift_mode == xplor && rsq >= ronsq && rsq < rcutsq)
+                    {
+                    // Implement XPLOR smoothing (FLOPS: 16)
+                    Scalar old_pair_eng = pair_eng;
+                    Scalar old_force_divr = force_divr;
+
+                    // calculate 1.0 / (xplor denominator)
+                    Scalar xplor_denom_inv
+                        = Scalar(1.0) / ((rcutsq - ronsq) * (rcutsq - ronsq) * (rcutsq - ronsq));
+
+                    Scalar rsq_minus_r_cut_sq = rsq - rcutsq;
+                    Scalar s = rsq_minus_r_cut_sq * rsq_minus_r_cut_sq
+                               * (rcutsq + Scalar(2.0) * rsq - Scalar(3.0) * ronsq)
+                               * xplor_denom_inv;
+                    Scalar ds_dr_divr
+                        = Scalar(12.0) * (rsq - ronsq) * rsq_minus_r_cut_sq * xplor_denom_inv;
+
+                    // make modifications to the old pair energy and force
+                    pair_eng = old_pair_eng * s;
+                    force_divr = s * old_force_divr - ds_dr_divr * old_pair_eng;
+                    }
+
+                lane_force_divr[l] = evaluated ? force_divr : Scalar(0.0);
+                lane_pair_eng[l] = evaluated ? pair_eng : Scalar(0.0);
+                }
+
+            // accumulate in neighbor list order
+            for (unsigned int l = 0; l < n_lanes; l++)
+                {
+                const Scalar force_divr = lane_force_divr[l];
+                const Scalar pair_eng = lane_pair_eng[l];
+                const Scalar3 dx = make_scalar3(lane_dx[l], lane_dy[l], lane_dz[l]);
+                const Scalar force_div2r = force_divr * Scalar(0.5);
+
+                fi += dx * force_divr;
+                pei += pair_eng * Scalar(0.5);
+                if (compute_virial)
+                    {
+                    virialxxi += force_div2r * dx.x * dx.x;
+                    virialxyi += force_div2r * dx.x * dx.y;
+                    virialxzi += force_div2r * dx.x * dx.z;
+                    virialyyi += force_div2r * dx.y * dx.y;
+                    virialyzi += force_div2r * dx.y * dx.z;
+                    virialzzi += force_div2r * dx.z * dx.z;
+                    }
+
+                const unsigned int j = neighbors[k0 + l];
+                if (third_law && j < args.N)
+                    {
+                    force[j].x -= dx.x * force_divr;
+                    force[j].y -= dx.y * force_divr;
+                    force[j].z -= dx.z * force_divr;
+                    force[j].w += pair_eng * Scalar(0.5);
+                    if (compute_virial)
+                        {
+                        virial[0 * virial_pitch + j] += force_div2r * dx.x * dx.x;
+                        virial[1 * virial_pitch + j] += force_div2r * dx.x * dx.y;
+                        virial[2 * virial_pitch + j] += force_div2r * dx.x * dx.z;
+                        virial[3 * virial_pitch + j] += force_div2r * dx.y * dx.y;
+                        virial[4 * virial_pitch + j] += force_div2r * dx.y * dx.z;
+                        virial[5 * virial_pitch + j] += force_div2r * dx.z * dx.z;
+                        }
+                    }
+                }
+            }
+
+        // finally, increment the force, potential energy and virial for particle i
+        force[i].x += fi.x;
+        force[i].y += fi.y;
+        force[i].z += fi.z;
+        force[i].w += pei;
+        if (compute_virial)
+            {
+            virial[0 * virial_pitch + i] += virialxxi;
+            virial[1 * virial_pitch + i] += virialxyi;
+            virial[2 * virial_pitch + i] += virialxzi;
+            virial[3 * virial_pitch + i] += virialyyi;
+            virial[4 * virial_pitch + i] += virialyzi;
+            virial[5 * virial_pitch + i] += virialzzi;
+            }
+        }
     }
 
 #ifdef ENABLE_MPI
@@ -695,6 +1415,25 @@ CommFlags PotentialPair<evaluator>::getRequestedCommFlags(uint64_t timestep)
 
     return flags;
     }
+
+/*! \param comm The communicator
+
+    The interior forces are computed while the communicator updates the ghost particles.
+*/
+template<class evaluator>
+void PotentialPair<evaluator>::setCommunicator(std::shared_ptr<Communicator> comm)
+    {
+    if (!m_comm)
+        {
+        // only connect on the first call
+        assert(comm);
+        comm->getInteriorComputeCallbackSignal()
+            .template connect<PotentialPair<evaluator>,
+                              &PotentialPair<evaluator>::computeInteriorForces>(this);
+        }
+
+    ForceCompute::setCommunicator(comm);
+    }
 #endif
 
 //! function to compute the energy between two lists of particles.
@@ -910,11 +1649,13 @@ template<class T> void export_PotentialPair(pybind11::module& m, const std::stri
         .def(pybind11::init<std::shared_ptr<SystemDefinition>, std::shared_ptr<NeighborList>>())
         .def("setParams", &T::setParamsPython)
         .def("getParams", &T::getParams)
+        .def("setParamVariant", &T::setParamVariant)
         .def("setRCut", &T::setRCutPython)
         .def("getRCut", &T::getRCut)
         .def("setROn", &T::setROnPython)
         .def("getROn", &T::getROn)
         .def_property("mode", &T::getShiftMode, &T::setShiftModePython)
+        .def_property("compact_positions", &T::getCompactPositions, &T::setCompactPositions)
         .def("computeEnergyBetweenSets", &T::computeEnergyBetweenSetsPythonList)
         .def("slotWriteGSDShapeSpec", &T::slotWriteGSDShapeSpec)
         .def("connectGSDShapeSpec", &T::connectGSDShapeSpec);
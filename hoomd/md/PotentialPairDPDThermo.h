@@ -62,6 +62,9 @@ template<class evaluator> class PotentialPairDPDThermo : public PotentialPair<ev
     virtual CommFlags getRequestedCommFlags(uint64_t timestep);
 #endif
 
+    //! The thermostat forces are computed in a single pass by computeForces()
+    virtual void computeInteriorForces(uint64_t timestep) { }
+
     protected:
     std::shared_ptr<Variant> m_T; //!< Temperature for the DPD thermostat
 
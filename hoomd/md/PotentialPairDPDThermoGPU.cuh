@@ -12,6 +12,7 @@
 #define __POTENTIAL_PAIR_DPDTHERMO_CUH__
 
 #include "EvaluatorPairDPDThermo.h"
+#include "hoomd/FixedPoint.h"
 #include "hoomd/Index1D.h"
 #include "hoomd/ParticleData.cuh"
 #include "hoomd/TextureTools.h"
@@ -86,6 +87,10 @@ struct dpd_pair_args_t
     const unsigned int compute_virial; //!< Flag to indicate if virials should be computed
     const unsigned int
         threads_per_particle; //!< Number of threads per particle (maximum: 32==1 warp)
+
+    unsigned int half = 0; //!< When non-zero, evaluate each pair once and also apply it to j
+    unsigned long long* d_fixed = NULL; //!< Fixed point sums for half mode (NULL for atomics)
+    size_t fixed_pitch = 0;             //!< Pitch of the 2D array of fixed point sums
     };
 
 #ifdef __HIPCC__
@@ -112,6 +117,10 @@ struct dpd_pair_args_t
     \param d_deltaT timestep size
     \param d_T temperature
     \param ntypes Number of types in the simulation
+    \param half When non-zero, evaluate each pair only once and apply the reaction to j
+    \param d_fixed Fixed point sums to accumulate into in half mode, floating point atomics on
+           \a d_force and \a d_virial are used when NULL
+    \param fixed_pitch Pitch of the 2D array \a d_fixed
     \param tpp Number of threads per particle
 
     \a d_params, and \a d_rcutsq must be indexed with an Index2DUpperTriangular(typei, typej) to
@@ -129,6 +138,13 @@ struct dpd_pair_args_t
     <b>Implementation details</b>
     Each block will calculate the forces on a block of particles.
     Each thread will calculate the total force on one particle.
+
+    In half mode, the pair i,j is evaluated only by the lower index i, which halves the number of
+   random numbers drawn with a full neighbor list. The evaluator seeds the generator with the
+   ordered pair of tags, so i draws the same random force that j would have. The conservative,
+   dissipative and random forces of every pair are added atomically to i and, when j is a local
+   particle, with the opposite sign to j. See gpu_compute_pair_forces_shared_kernel() for the
+   fixed point sums with \a d_fixed.
 */
 template<class evaluator,
          unsigned int shift_mode,
@@ -152,7 +168,10 @@ __global__ void gpu_compute_dpd_forces_kernel(Scalar4* d_force,
                                               const uint64_t d_timestep,
                                               const Scalar d_deltaT,
                                               const Scalar d_T,
-                                              const int ntypes)
+                                              const int ntypes,
+                                              const unsigned int half,
+                                              unsigned long long* d_fixed,
+                                              const size_t fixed_pitch)
     {
     Index2D typpair_idx(ntypes);
     const unsigned int num_typ_parameters = typpair_idx.getNumElements();
@@ -189,6 +208,7 @@ __global__ void gpu_compute_dpd_forces_kernel(Scalar4* d_force,
     Scalar virial[6];
     for (unsigned int i = 0; i < 6; i++)
         virial[i] = Scalar(0.0);
+    unsigned long long fixedi[10] = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
 
     if (active)
         {
@@ -226,6 +246,10 @@ __global__ void gpu_compute_dpd_forces_kernel(Scalar4* d_force,
                     next_j = __ldg(d_nlist + head_idx + neigh_idx + tpp);
                     }
 
+                // in half mode, the lower index of the pair evaluates it
+                if (half && cur_j < idx)
+                    continue;
+
                 // get the neighbor's position (MEM TRANSFER: 16 bytes)
                 Scalar4 postypej = __ldg(d_pos + cur_j);
                 Scalar3 posj = make_scalar3(postypej.x, postypej.y, postypej.z);
@@ -296,6 +320,55 @@ __global__ void gpu_compute_dpd_forces_kernel(Scalar4* d_force,
                 force.z += dx.z * force_divr;
 
                 force.w += pair_eng;
+
+                if (half && d_fixed)
+                    {
+                    // convert every contribution before summing, so that the sums are exact
+                    Scalar force_div2r_cons = Scalar(0.5) * force_divr_cons;
+                    Scalar value[10] = {dx.x * force_divr,
+                                        dx.y * force_divr,
+                                        dx.z * force_divr,
+                                        Scalar(0.5) * pair_eng,
+                                        dx.x * dx.x * force_div2r_cons,
+                                        dx.x * dx.y * force_div2r_cons,
+                                        dx.x * dx.z * force_div2r_cons,
+                                        dx.y * dx.y * force_div2r_cons,
+                                        dx.y * dx.z * force_div2r_cons,
+                                        dx.z * dx.z * force_div2r_cons};
+                    for (unsigned int k = 0; k < (compute_virial ? 10 : 4); k++)
+                        {
+                        unsigned long long v = hoomd::scalar_to_fixed(value[k]);
+                        fixedi[k] += v;
+
+                        // apply the reaction to local neighbors, the force changes sign
+                        if (cur_j < N)
+                            atomicAdd(d_fixed + k * fixed_pitch + cur_j, k < 3 ? -v : v);
+                        }
+                    }
+                else if (half && cur_j < N)
+                    {
+                    // apply the reaction to local neighbors
+                    atomicAdd(&d_force[cur_j].x, -dx.x * force_divr);
+                    atomicAdd(&d_force[cur_j].y, -dx.y * force_divr);
+                    atomicAdd(&d_force[cur_j].z, -dx.z * force_divr);
+                    atomicAdd(&d_force[cur_j].w, Scalar(0.5) * pair_eng);
+                    if (compute_virial)
+                        {
+                        Scalar force_div2r_cons = Scalar(0.5) * force_divr_cons;
+                        atomicAdd(d_virial + 0 * virial_pitch + cur_j,
+                                  dx.x * dx.x * force_div2r_cons);
+                        atomicAdd(d_virial + 1 * virial_pitch + cur_j,
+                                  dx.x * dx.y * force_div2r_cons);
+                        atomicAdd(d_virial + 2 * virial_pitch + cur_j,
+                                  dx.x * dx.z * force_div2r_cons);
+                        atomicAdd(d_virial + 3 * virial_pitch + cur_j,
+                                  dx.y * dx.y * force_div2r_cons);
+                        atomicAdd(d_virial + 4 * virial_pitch + cur_j,
+                                  dx.y * dx.z * force_div2r_cons);
+                        atomicAdd(d_virial + 5 * virial_pitch + cur_j,
+                                  dx.z * dx.z * force_div2r_cons);
+                        }
+                    }
                 }
             }
 
@@ -303,6 +376,19 @@ __global__ void gpu_compute_dpd_forces_kernel(Scalar4* d_force,
         force.w *= Scalar(0.5);
         }
 
+    // the integer sums of the fixed point mode are exact in any order
+    if (half && d_fixed)
+        {
+        hoomd::detail::WarpReduce<unsigned long long, tpp> fixed_reducer;
+        for (unsigned int k = 0; k < (compute_virial ? 10 : 4); k++)
+            {
+            fixedi[k] = fixed_reducer.Sum(fixedi[k]);
+            if (active && threadIdx.x % tpp == 0)
+                atomicAdd(d_fixed + k * fixed_pitch + idx, fixedi[k]);
+            }
+        return;
+        }
+
     // reduce force over threads in cta
     hoomd::detail::WarpReduce<Scalar, tpp> reducer;
     force.x = reducer.Sum(force.x);
@@ -311,8 +397,21 @@ __global__ void gpu_compute_dpd_forces_kernel(Scalar4* d_force,
     force.w = reducer.Sum(force.w);
 
     // now that the force calculation is complete, write out the result (MEM TRANSFER: 20 bytes)
+    // in half mode, other threads also add reaction forces to this particle
     if (active && threadIdx.x % tpp == 0)
-        d_force[idx] = force;
+        {
+        if (half)
+            {
+            atomicAdd(&d_force[idx].x, force.x);
+            atomicAdd(&d_force[idx].y, force.y);
+            atomicAdd(&d_force[idx].z, force.z);
+            atomicAdd(&d_force[idx].w, force.w);
+            }
+        else
+            {
+            d_force[idx] = force;
+            }
+        }
 
     if (compute_virial)
         {
@@ -322,7 +421,12 @@ __global__ void gpu_compute_dpd_forces_kernel(Scalar4* d_force,
         // if we are the first thread in the cta, write out virial to global mem
         if (active && threadIdx.x % tpp == 0)
             for (unsigned int i = 0; i < 6; i++)
-                d_virial[i * virial_pitch + idx] = virial[i];
+                {
+                if (half)
+                    atomicAdd(d_virial + i * virial_pitch + idx, virial[i]);
+                else
+                    d_virial[i * virial_pitch + idx] = virial[i];
+                }
         }
     }
 
@@ -410,7 +514,10 @@ struct DPDForceComputeKernel
                                args.timestep,
                                args.deltaT,
                                args.T,
-                               args.ntypes);
+                               args.ntypes,
+                               args.half,
+                               args.d_fixed,
+                               args.fixed_pitch);
             }
         else
             {
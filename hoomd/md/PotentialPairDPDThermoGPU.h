@@ -10,6 +10,7 @@
 
 #include "PotentialPairDPDThermo.h"
 #include "PotentialPairDPDThermoGPU.cuh"
+#include "PotentialPairGPU.cuh"
 #include "hoomd/Autotuner.h"
 
 /*! \file PotentialPairDPDThermoGPU.h
@@ -33,6 +34,12 @@
    (See PotentialPairDPDThermoGPU.cuh for an example). That function is then passed into this class
    as another template parameter \a gpu_cpdf
 
+    Like PotentialPairGPU, the autotuner chooses between the full kernel, which evaluates every
+   pair twice, and the half kernel, which evaluates each pair once and adds the reaction to the
+   neighbor with atomic operations. The half kernel draws half of the random numbers, it is always
+   used with a half neighbor list and never with more than one GPU. When the neighbor list or the
+   execution configuration is deterministic, the half kernel sums in 64-bit fixed point.
+
     \tparam evaluator EvaluatorPair class used to evaluate V(r) and F(r)/r
     \tparam gpu_cpdf Driver function that calls gpu_compute_dpd_forces<evaluator>()
 
@@ -73,8 +80,9 @@ class PotentialPairDPDThermoGPU : public PotentialPairDPDThermo<evaluator>
         }
 
     protected:
-    std::unique_ptr<Autotuner> m_tuner; //!< Autotuner for block size and threads per particle
-    unsigned int m_param;               //!< Kernel tuning parameter
+    std::unique_ptr<Autotuner> m_tuner;   //!< Autotuner for the kernel and its launch parameters
+    unsigned int m_param;                 //!< Kernel tuning parameter
+    GPUArray<unsigned long long> m_fixed; //!< Fixed point sums of the deterministic half kernel
 
     //! Actually compute the forces
     virtual void computeForces(uint64_t timestep);
@@ -98,20 +106,26 @@ PotentialPairDPDThermoGPU<evaluator, gpu_cpdf>::PotentialPairDPDThermoGPU(
         }
 
     // initialize autotuner
-    // the full block size and threads_per_particle matrix is searched,
-    // encoded as block_size*10000 + threads_per_particle
+    // the kernel, block size and threads_per_particle matrix is searched with coordinate descent,
+    // encoded as kernel*100000000 + block_size*10000 + threads_per_particle with kernel 0 (full)
+    // or 1 (half). The atomics of the half kernel do not reach across GPUs
     std::vector<unsigned int> valid_params;
-    unsigned int warp_size = this->m_exec_conf->dev_prop.warpSize;
-    for (unsigned int block_size = warp_size; block_size <= 1024; block_size += warp_size)
+    const unsigned int warp_size = this->m_exec_conf->dev_prop.warpSize;
+    const unsigned int n_kernels = this->m_exec_conf->getNumActiveGPUs() > 1 ? 1 : 2;
+    for (unsigned int kernel = 0; kernel < n_kernels; ++kernel)
         {
-        for (auto s : Autotuner::getTppListPow2(this->m_exec_conf->dev_prop.warpSize))
+        for (unsigned int block_size = warp_size; block_size <= 1024; block_size += warp_size)
             {
-            valid_params.push_back(block_size * 10000 + s);
+            for (auto s : Autotuner::getTppListPow2(warp_size))
+                {
+                valid_params.push_back(kernel * 100000000 + block_size * 10000 + s);
+                }
             }
         }
 
     m_tuner.reset(
         new Autotuner(valid_params, 5, 100000, "pair_" + evaluator::getName(), this->m_exec_conf));
+    m_tuner->setDimensions({100000000, 10000, 1});
 #ifdef ENABLE_MPI
     // synchronize autotuner results across ranks
     m_tuner->setSync(bool(this->m_pdata->getDomainDecomposition()));
@@ -129,12 +143,13 @@ void PotentialPairDPDThermoGPU<evaluator, gpu_cpdf>::computeForces(uint64_t time
     if (this->m_prof)
         this->m_prof->push(this->m_exec_conf, this->m_prof_name);
 
-    // The GPU implementation CANNOT handle a half neighborlist, error out now
+    // The half kernel cannot sum forces across GPUs, error out now
     bool third_law = this->m_nlist->getStorageMode() == NeighborList::half;
-    if (third_law)
+    const bool single_gpu = this->m_exec_conf->getNumActiveGPUs() == 1;
+    if (third_law && !single_gpu)
         {
         this->m_exec_conf->msg->error()
-            << "PotentialPairDPDThermoGPU cannot handle a half neighborlist" << std::endl
+            << "PotentialPairDPDThermoGPU cannot handle a half neighborlist on multiple GPUs"
             << std::endl;
         throw std::runtime_error("Error computing forces in PotentialPairDPDThermoGPU");
         }
@@ -174,10 +189,43 @@ void PotentialPairDPDThermoGPU<evaluator, gpu_cpdf>::computeForces(uint64_t time
     if (!m_param)
         this->m_tuner->begin();
     unsigned int param = !m_param ? this->m_tuner->getParam() : m_param;
-    unsigned int block_size = param / 10000;
+    unsigned int block_size = (param % 100000000) / 10000;
     unsigned int threads_per_particle = param % 10000;
 
-    gpu_cpdf(dpd_pair_args_t(d_force.data,
+    // the fixed point sums do not depend on the tuning parameters, choose them for all parameters
+    // to keep the result reproducible while the autotuner scans
+    const bool fixed_point = single_gpu
+                             && (this->m_nlist->getDeterministic()
+                                 || this->m_exec_conf->getDeterministic());
+    const bool half = third_law || fixed_point || (param / 100000000 == 1 && single_gpu);
+    const bool compute_virial = flags[pdata_flag::pressure_tensor];
+
+    // the fixed point sums hold four force and six virial components per particle
+    if (fixed_point && m_fixed.getPitch() < this->m_pdata->getMaxN())
+        {
+        GPUArray<unsigned long long> fixed(this->m_pdata->getMaxN(), 10, this->m_exec_conf);
+        m_fixed.swap(fixed);
+        }
+    ArrayHandle<unsigned long long> d_fixed(m_fixed,
+                                            access_location::device,
+                                            access_mode::readwrite);
+
+    // the half kernel adds to the forces of both particles in every pair
+    if (half)
+        {
+        if (fixed_point)
+            {
+            hipMemset(d_fixed.data, 0, sizeof(unsigned long long) * m_fixed.getNumElements());
+            }
+        else
+            {
+            hipMemset(d_force.data, 0, sizeof(Scalar4) * this->m_force.getNumElements());
+            if (compute_virial)
+                hipMemset(d_virial.data, 0, sizeof(Scalar) * this->m_virial.getNumElements());
+            }
+        }
+
+    dpd_pair_args_t dpd_args(d_force.data,
                              d_virial.data,
                              this->m_virial.getPitch(),
                              this->m_pdata->getN(),
@@ -198,9 +246,30 @@ void PotentialPairDPDThermoGPU<evaluator, gpu_cpdf>::computeForces(uint64_t time
                              this->m_deltaT,
                              (*this->m_T)(timestep),
                              this->m_shift_mode,
-                             flags[pdata_flag::pressure_tensor],
-                             threads_per_particle),
-             this->m_params.data());
+                             compute_virial,
+                             threads_per_particle);
+    if (half)
+        {
+        dpd_args.half = 1;
+        if (fixed_point)
+            {
+            dpd_args.d_fixed = d_fixed.data;
+            dpd_args.fixed_pitch = m_fixed.getPitch();
+            }
+        }
+    gpu_cpdf(dpd_args, this->m_params.data());
+
+    if (fixed_point)
+        {
+        gpu_pair_fixed_point_finalize(d_force.data,
+                                      d_virial.data,
+                                      this->m_virial.getPitch(),
+                                      d_fixed.data,
+                                      m_fixed.getPitch(),
+                                      this->m_pdata->getN(),
+                                      compute_virial,
+                                      256);
+        }
 
     if (this->m_exec_conf->isCUDAErrorCheckingEnabled())
         CHECK_CUDA_ERROR();
@@ -0,0 +1,129 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file PotentialPairGPU.cu
+    \brief Defines GPU kernels shared by all pair potentials
+*/
+
+#include "PotentialPairGPU.cuh"
+
+//! Kernel to store the positions in single precision relative to an origin
+/*! \param d_pos_compact Single precision positions to write, the type is stored in w
+    \param d_pos Particle positions
+    \param N Number of particles, including ghosts
+    \param origin Origin to subtract from the positions
+*/
+__global__ void gpu_pair_compact_positions_kernel(float4* d_pos_compact,
+                                                  const Scalar4* d_pos,
+                                                  const unsigned int N,
+                                                  const Scalar3 origin)
+    {
+    unsigned int idx = blockIdx.x * blockDim.x + threadIdx.x;
+    if (idx >= N)
+        return;
+
+    Scalar4 postype = d_pos[idx];
+    d_pos_compact[idx] = make_float4(float(postype.x - origin.x),
+                                     float(postype.y - origin.y),
+                                     float(postype.z - origin.z),
+                                     __int_as_float(__scalar_as_int(postype.w)));
+    }
+
+/*! \param d_pos_compact Single precision positions to write, the type is stored in w
+    \param d_pos Particle positions
+    \param N Number of particles, including ghosts
+    \param origin Origin to subtract from the positions
+    \param block_size Block size to execute
+*/
+hipError_t gpu_pair_compact_positions(float4* d_pos_compact,
+                                      const Scalar4* d_pos,
+                                      const unsigned int N,
+                                      const Scalar3 origin,
+                                      const unsigned int block_size)
+    {
+    if (N == 0)
+        return hipSuccess;
+
+    hipLaunchKernelGGL((gpu_pair_compact_positions_kernel),
+                       dim3(N / block_size + 1),
+                       dim3(block_size),
+                       0,
+                       0,
+                       d_pos_compact,
+                       d_pos,
+                       N,
+                       origin);
+
+    return hipSuccess;
+    }
+
+//! Kernel to convert the fixed point sums of the half mode pair kernel
+/*! \param d_force Forces to write
+    \param d_virial Virials to write
+    \param virial_pitch Pitch of the 2D virial array
+    \param d_fixed Fixed point sums of the four force and six virial components
+    \param fixed_pitch Pitch of the 2D array \a d_fixed
+    \param N Number of particles
+    \param compute_virial When true, also convert the virials
+*/
+__global__ void gpu_pair_fixed_point_finalize_kernel(Scalar4* d_force,
+                                                     Scalar* d_virial,
+                                                     const size_t virial_pitch,
+                                                     const unsigned long long* d_fixed,
+                                                     const size_t fixed_pitch,
+                                                     const unsigned int N,
+                                                     const bool compute_virial)
+    {
+    unsigned int idx = blockIdx.x * blockDim.x + threadIdx.x;
+    if (idx >= N)
+        return;
+
+    d_force[idx] = make_scalar4(hoomd::fixed_to_scalar(d_fixed[idx]),
+                                hoomd::fixed_to_scalar(d_fixed[fixed_pitch + idx]),
+                                hoomd::fixed_to_scalar(d_fixed[2 * fixed_pitch + idx]),
+                                hoomd::fixed_to_scalar(d_fixed[3 * fixed_pitch + idx]));
+
+    if (compute_virial)
+        {
+        for (unsigned int k = 0; k < 6; k++)
+            d_virial[k * virial_pitch + idx]
+                = hoomd::fixed_to_scalar(d_fixed[(4 + k) * fixed_pitch + idx]);
+        }
+    }
+
+/*! \param d_force Forces to write
+    \param d_virial Virials to write
+    \param virial_pitch Pitch of the 2D virial array
+    \param d_fixed Fixed point sums of the four force and six virial components
+    \param fixed_pitch Pitch of the 2D array \a d_fixed
+    \param N Number of particles
+    \param compute_virial When true, also convert the virials
+    \param block_size Block size to execute
+*/
+hipError_t gpu_pair_fixed_point_finalize(Scalar4* d_force,
+                                         Scalar* d_virial,
+                                         const size_t virial_pitch,
+                                         const unsigned long long* d_fixed,
+                                         const size_t fixed_pitch,
+                                         const unsigned int N,
+                                         const bool compute_virial,
+                                         const unsigned int block_size)
+    {
+    if (N == 0)
+        return hipSuccess;
+
+    hipLaunchKernelGGL((gpu_pair_fixed_point_finalize_kernel),
+                       dim3(N / block_size + 1),
+                       dim3(block_size),
+                       0,
+                       0,
+                       d_force,
+                       d_virial,
+                       virial_pitch,
+                       d_fixed,
+                       fixed_pitch,
+                       N,
+                       compute_virial);
+
+    return hipSuccess;
+    }
@@ -4,6 +4,7 @@
 
 // Maintainer: joaander
 
+#include "hoomd/FixedPoint.h"
 #include "hoomd/HOOMDMath.h"
 #include "hoomd/Index1D.h"
 #include "hoomd/ParticleData.cuh"
@@ -11,6 +12,8 @@
 
 #include "hoomd/GPUPartition.cuh"
 
+#include "NeighborListGPU.cuh"
+
 #ifdef __HIPCC__
 #include "hoomd/WarpTools.cuh"
 #endif // __HIPCC__
@@ -49,6 +52,7 @@ struct pair_args_t
                 const unsigned int* _d_n_neigh,
                 const unsigned int* _d_nlist,
                 const unsigned int* _d_head_list,
+                const uint16_t* _d_nlist_delta,
                 const Scalar* _d_rcutsq,
                 const Scalar* _d_ronsq,
                 const size_t _size_neigh_list,
@@ -61,8 +65,9 @@ struct pair_args_t
                 const hipDeviceProp_t& _devprop)
         : d_force(_d_force), d_virial(_d_virial), virial_pitch(_virial_pitch), N(_N), n_max(_n_max),
           d_pos(_d_pos), d_diameter(_d_diameter), d_charge(_d_charge), box(_box),
-          d_n_neigh(_d_n_neigh), d_nlist(_d_nlist), d_head_list(_d_head_list), d_rcutsq(_d_rcutsq),
-          d_ronsq(_d_ronsq), size_neigh_list(_size_neigh_list), ntypes(_ntypes),
+          d_n_neigh(_d_n_neigh), d_nlist(_d_nlist), d_head_list(_d_head_list),
+          d_nlist_delta(_d_nlist_delta), d_rcutsq(_d_rcutsq), d_ronsq(_d_ronsq),
+          size_neigh_list(_size_neigh_list), ntypes(_ntypes),
           block_size(_block_size), shift_mode(_shift_mode), compute_virial(_compute_virial),
           threads_per_particle(_threads_per_particle), gpu_partition(_gpu_partition),
           devprop(_devprop) {};
@@ -80,6 +85,7 @@ struct pair_args_t
         d_n_neigh;               //!< Device array listing the number of neighbors on each particle
     const unsigned int* d_nlist; //!< Device array listing the neighbors of each particle
     const unsigned int* d_head_list; //!< Head list indexes for accessing d_nlist
+    const uint16_t* d_nlist_delta;   //!< Compressed copy of d_nlist (may be NULL)
     const Scalar* d_rcutsq;          //!< Device array listing r_cut squared per particle type pair
     const Scalar* d_ronsq;           //!< Device array listing r_on squared per particle type pair
     const size_t size_neigh_list;    //!< Size of the neighbor list for texture binding
@@ -90,10 +96,151 @@ struct pair_args_t
     const unsigned int threads_per_particle; //!< Number of threads per particle (maximum: 1 warp)
     const GPUPartition& gpu_partition; //!< The load balancing partition of particles between GPUs
     const hipDeviceProp_t& devprop;    //!< CUDA device properties
+
+    const unsigned int* d_index = NULL; //!< Particles in kernel order (NULL for gpu_partition)
+    unsigned int index_begin = 0;       //!< First entry of d_index to compute
+    unsigned int index_end = 0;         //!< One past the last entry of d_index to compute
+
+    const float4* d_pos_compact = NULL; //!< Single precision positions to read in place of d_pos
+
+    unsigned int half = 0; //!< When non-zero, evaluate each pair once and also apply it to j
+    unsigned long long* d_fixed = NULL; //!< Fixed point sums for half mode (NULL for atomics)
+    size_t fixed_pitch = 0;             //!< Pitch of the 2D array of fixed point sums
+
+    const unsigned int* d_cell_size = NULL; //!< Cell sizes, find pairs in the cell list when set
+    const Scalar4* d_cell_xyzf = NULL;      //!< Cell list positions, flagged with the index
+    const Scalar4* d_cell_tdb = NULL;       //!< Cell list types, diameters and bodies
+    const unsigned int* d_cell_adj = NULL;  //!< Cell adjacency list
+    Index3D ci;                             //!< Cell indexer
+    Index2D cli;                            //!< Cell list indexer
+    Index2D cadji;                          //!< Cell adjacency list indexer
     };
 
+//! Store the positions in single precision relative to an origin
+hipError_t gpu_pair_compact_positions(float4* d_pos_compact,
+                                      const Scalar4* d_pos,
+                                      const unsigned int N,
+                                      const Scalar3 origin,
+                                      const unsigned int block_size);
+
+//! Convert the fixed point sums of the half mode pair kernel to forces and virials
+hipError_t gpu_pair_fixed_point_finalize(Scalar4* d_force,
+                                         Scalar* d_virial,
+                                         const size_t virial_pitch,
+                                         const unsigned long long* d_fixed,
+                                         const size_t fixed_pitch,
+                                         const unsigned int N,
+                                         const bool compute_virial,
+                                         const unsigned int block_size);
+
 #ifdef __HIPCC__
 
+//! Load the position and type of a particle
+/*! \param pos Output: position of the particle
+    \param type Output: type of the particle
+    \param d_pos Particle positions
+    \param d_pos_compact Single precision positions relative to an origin, read in place of \a
+           d_pos when not NULL
+    \param idx Index of the particle
+
+    Only differences between positions are meaningful when \a d_pos_compact is set.
+*/
+__device__ inline void gpu_pair_load_postype(Scalar3& pos,
+                                             unsigned int& type,
+                                             const Scalar4* d_pos,
+                                             const float4* d_pos_compact,
+                                             const unsigned int idx)
+    {
+    if (d_pos_compact)
+        {
+        float4 postype = __ldg(d_pos_compact + idx);
+        pos = make_scalar3(postype.x, postype.y, postype.z);
+        type = __float_as_int(postype.w);
+        }
+    else
+        {
+        Scalar4 postype = __ldg(d_pos + idx);
+        pos = make_scalar3(postype.x, postype.y, postype.z);
+        type = __scalar_as_int(postype.w);
+        }
+    }
+
+//! Evaluate the force and energy of one pair, including the energy shift and XPLOR smoothing
+/*! \param force_divr Output: F(r)/r
+    \param pair_eng Output: V(r)
+    \param rsq Squared distance between the particles
+    \param rcutsq Squared cutoff of the type pair
+    \param ronsq Squared XPLOR smoothing onset of the type pair (shift_mode == 2 only)
+    \param param Parameters of the type pair
+    \param di Diameter of particle i
+    \param dj Diameter of particle j
+    \param qi Charge of particle i
+    \param qj Charge of particle j
+
+    \tparam evaluator EvaluatorPair class to evaluate V(r) and -delta V(r)/r
+    \tparam shift_mode 0: No energy shifting is done. 1: V(r) is shifted to be 0 at rcut. 2: XPLOR
+   switching is enabled
+*/
+template<class evaluator, unsigned int shift_mode>
+__device__ inline void gpu_pair_evaluate(Scalar& force_divr,
+                                         Scalar& pair_eng,
+                                         const Scalar rsq,
+                                         const Scalar rcutsq,
+                                         const Scalar ronsq,
+                                         const typename evaluator::param_type& param,
+                                         const Scalar di,
+                                         const Scalar dj,
+                                         const Scalar qi,
+                                         const Scalar qj)
+    {
+    // design specifies that energies are shifted if
+    // 1) shift mode is set to shift
+    // or 2) shift mode is explor and ron > rcut
+    bool energy_shift = false;
+    if (shift_mode == 1)
+        energy_shift = true;
+    else if (shift_mode == 2)
+        {
+        if (ronsq > rcutsq)
+            energy_shift = true;
+        }
+
+    // evaluate the potential
+    force_divr = Scalar(0.0);
+    pair_eng = Scalar(0.0);
+
+    evaluator eval(rsq, rcutsq, param);
+    if (evaluator::needsDiameter())
+        eval.setDiameter(di, dj);
+    if (evaluator::needsCharge())
+        eval.setCharge(qi, qj);
+
+    eval.evalForceAndEnergy(force_divr, pair_eng, energy_shift);
+
+    if (shift_mode == 2)
+        {
+        if (rsq >= ronsq && rsq < rcutsq)
+            {
+            // Implement XPLOR smoothing
+            Scalar old_pair_eng = pair_eng;
+            Scalar old_force_divr = force_divr;
+
+            // calculate 1.0 / (xplor denominator)
+            Scalar xplor_denom_inv
+                = Scalar(1.0) / ((rcutsq - ronsq) * (rcutsq - ronsq) * (rcutsq - ronsq));
+
+            Scalar rsq_minus_r_cut_sq = rsq - rcutsq;
+            Scalar s = rsq_minus_r_cut_sq * rsq_minus_r_cut_sq
+                       * (rcutsq + Scalar(2.0) * rsq - Scalar(3.0) * ronsq) * xplor_denom_inv;
+            Scalar ds_dr_divr = Scalar(12.0) * (rsq - ronsq) * rsq_minus_r_cut_sq * xplor_denom_inv;
+
+            // make modifications to the old pair energy and force
+            pair_eng = old_pair_eng * s;
+            force_divr = s * old_force_divr - ds_dr_divr * old_pair_eng;
+            }
+        }
+    }
+
 //! Kernel for calculating pair forces
 /*! This kernel is called to calculate the pair forces on all N particles. Actual evaluation of the
    potentials and forces for each pair is handled via the template class \a evaluator.
@@ -103,17 +250,26 @@ struct pair_args_t
     \param virial_pitch pitch of 2D virial array
     \param N number of particles in system
     \param d_pos particle positions
+    \param d_pos_compact Single precision positions relative to the local box center, read in place
+           of \a d_pos when not NULL
     \param d_diameter particle diameters
     \param d_charge particle charges
     \param box Box dimensions used to implement periodic boundary conditions
     \param d_n_neigh Device memory array listing the number of neighbors for each particle
     \param d_nlist Device memory array containing the neighbor list contents
     \param d_head_list Indexes for reading \a d_nlist
+    \param d_nlist_delta Compressed copy of \a d_nlist, read in its place when not NULL
     \param d_params Parameters for the potential, stored per type pair
     \param d_rcutsq rcut squared, stored per type pair
     \param d_ronsq ron squared, stored per type pair
     \param ntypes Number of types in the simulation
     \param offset Offset of first particle
+    \param d_index Particle indices in kernel order, the identity when NULL
+    \param n_local Number of local particles
+    \param half When non-zero, evaluate each pair only once and apply the reaction to j
+    \param d_fixed Fixed point sums to accumulate into in half mode, floating point atomics on
+           \a d_force and \a d_virial are used when NULL
+    \param fixed_pitch Pitch of the 2D array \a d_fixed
 
     \a d_params, \a d_rcutsq, and \a d_ronsq must be indexed with an Index2DUpperTriangular(typei,
    typej) to access the unique value for that type pair. These values are all cached into shared
@@ -132,6 +288,14 @@ struct pair_args_t
     Each block will calculate the forces on a block of particles.
     Each group of \a tpp threads will calculate the total force on one particle.
     The neighborlist is arranged in columns so that reads are fully coalesced when doing this.
+
+    In half mode, the pair i,j is evaluated only by the lower index i: neighbors j < i are skipped,
+   so a full neighbor list evaluates half of its pairs and a half neighbor list all of them. Ghost
+   neighbors always have j > i. The force, energy and virial of every pair are added atomically to
+   i and, when j is a local particle, to j. Forces must be zeroed before the launch. With \a
+   d_fixed, every contribution is converted to fixed point before it is summed. The integer sums
+   are exact, so the result depends neither on the order of the atomics nor on \a tpp.
+   gpu_pair_fixed_point_finalize() converts the sums to the forces and virials afterwards.
 */
 template<class evaluator, unsigned int shift_mode, unsigned int compute_virial, int tpp>
 __global__ void
@@ -140,17 +304,24 @@ gpu_compute_pair_forces_shared_kernel(Scalar4* d_force,
                                       const size_t virial_pitch,
                                       const unsigned int N,
                                       const Scalar4* d_pos,
+                                      const float4* d_pos_compact,
                                       const Scalar* d_diameter,
                                       const Scalar* d_charge,
                                       const BoxDim box,
                                       const unsigned int* d_n_neigh,
                                       const unsigned int* d_nlist,
                                       const unsigned int* d_head_list,
+                                      const uint16_t* d_nlist_delta,
                                       const typename evaluator::param_type* d_params,
                                       const Scalar* d_rcutsq,
                                       const Scalar* d_ronsq,
                                       const unsigned int ntypes,
                                       const unsigned int offset,
+                                      const unsigned int* d_index,
+                                      const unsigned int n_local,
+                                      const unsigned int half,
+                                      unsigned long long* d_fixed,
+                                      const size_t fixed_pitch,
                                       unsigned int max_extra_bytes)
     {
     Index2D typpair_idx(ntypes);
@@ -206,6 +377,8 @@ gpu_compute_pair_forces_shared_kernel(Scalar4* d_force,
 
     // add offset to get actual particle index
     idx += offset;
+    if (d_index != NULL && active)
+        idx = d_index[idx];
 
     // initialize the force to 0
     Scalar4 force = make_scalar4(Scalar(0.0), Scalar(0.0), Scalar(0.0), Scalar(0.0));
@@ -215,6 +388,7 @@ gpu_compute_pair_forces_shared_kernel(Scalar4* d_force,
     Scalar virialyy = Scalar(0.0);
     Scalar virialyz = Scalar(0.0);
     Scalar virialzz = Scalar(0.0);
+    unsigned long long fixedi[10] = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
 
     if (active)
         {
@@ -222,8 +396,9 @@ gpu_compute_pair_forces_shared_kernel(Scalar4* d_force,
         unsigned int n_neigh = d_n_neigh[idx];
 
         // read in the position of our particle.
-        Scalar4 postypei = __ldg(d_pos + idx);
-        Scalar3 posi = make_scalar3(postypei.x, postypei.y, postypei.z);
+        Scalar3 posi;
+        unsigned int typei;
+        gpu_pair_load_postype(posi, typei, d_pos, d_pos_compact, idx);
 
         Scalar di = Scalar(0);
         if (evaluator::needsDiameter())
@@ -236,8 +411,19 @@ gpu_compute_pair_forces_shared_kernel(Scalar4* d_force,
         unsigned int my_head = d_head_list[idx];
         unsigned int cur_j = 0;
 
+        // per type pair parameters of the previous neighbor, reused while the type pair repeats
+        // (every neighbor of a run when the neighbor list is sorted by type)
+        unsigned int cur_typpair = num_typ_parameters;
+        const typename evaluator::param_type* param = s_params;
+        Scalar rcutsq = Scalar(0.0);
+        Scalar ronsq = Scalar(0.0);
+
         unsigned int next_j(0);
-        next_j = threadIdx.x % tpp < n_neigh ? __ldg(d_nlist + my_head + threadIdx.x % tpp) : 0;
+        next_j = threadIdx.x % tpp < n_neigh ? nlist_load_neighbor(d_nlist,
+                                                                   d_nlist_delta,
+                                                                   idx,
+                                                                   my_head + threadIdx.x % tpp)
+                                             : 0;
 
         // loop over neighbors
         for (int neigh_idx = threadIdx.x % tpp; neigh_idx < n_neigh; neigh_idx += tpp)
@@ -247,11 +433,20 @@ gpu_compute_pair_forces_shared_kernel(Scalar4* d_force,
                 cur_j = next_j;
                 if (neigh_idx + tpp < n_neigh)
                     {
-                    next_j = __ldg(d_nlist + my_head + neigh_idx + tpp);
+                    next_j = nlist_load_neighbor(d_nlist,
+                                                 d_nlist_delta,
+                                                 idx,
+                                                 my_head + neigh_idx + tpp);
                     }
+
+                // in half mode, the lower index of the pair evaluates it
+                if (half && cur_j < idx)
+                    continue;
+
                 // get the neighbor's position
-                Scalar4 postypej = __ldg(d_pos + cur_j);
-                Scalar3 posj = make_scalar3(postypej.x, postypej.y, postypej.z);
+                Scalar3 posj;
+                unsigned int typej;
+                gpu_pair_load_postype(posj, typej, d_pos, d_pos_compact, cur_j);
 
                 Scalar dj = Scalar(0.0);
                 if (evaluator::needsDiameter())
@@ -271,63 +466,30 @@ gpu_compute_pair_forces_shared_kernel(Scalar4* d_force,
                 Scalar rsq = dot(dx, dx);
 
                 // access the per type pair parameters
-                unsigned int typpair
-                    = typpair_idx(__scalar_as_int(postypei.w), __scalar_as_int(postypej.w));
-                Scalar rcutsq = s_rcutsq[typpair];
-                typename evaluator::param_type param = s_params[typpair];
-                Scalar ronsq = Scalar(0.0);
-                if (shift_mode == 2)
-                    ronsq = s_ronsq[typpair];
-
-                // design specifies that energies are shifted if
-                // 1) shift mode is set to shift
-                // or 2) shift mode is explor and ron > rcut
-                bool energy_shift = false;
-                if (shift_mode == 1)
-                    energy_shift = true;
-                else if (shift_mode == 2)
+                unsigned int typpair = typpair_idx(typei, typej);
+                if (typpair != cur_typpair)
                     {
-                    if (ronsq > rcutsq)
-                        energy_shift = true;
+                    cur_typpair = typpair;
+                    rcutsq = s_rcutsq[typpair];
+                    param = s_params + typpair;
+                    if (shift_mode == 2)
+                        ronsq = s_ronsq[typpair];
                     }
 
                 // evaluate the potential
-                Scalar force_divr = Scalar(0.0);
-                Scalar pair_eng = Scalar(0.0);
-
-                evaluator eval(rsq, rcutsq, param);
-                if (evaluator::needsDiameter())
-                    eval.setDiameter(di, dj);
-                if (evaluator::needsCharge())
-                    eval.setCharge(qi, qj);
-
-                eval.evalForceAndEnergy(force_divr, pair_eng, energy_shift);
+                Scalar force_divr;
+                Scalar pair_eng;
+                gpu_pair_evaluate<evaluator, shift_mode>(force_divr,
+                                                         pair_eng,
+                                                         rsq,
+                                                         rcutsq,
+                                                         ronsq,
+                                                         *param,
+                                                         di,
+                                                         dj,
+                                                         qi,
+                                                         qj);
 
-                if (shift_mode == 2)
-                    {
-                    if (rsq >= ronsq && rsq < rcutsq)
-                        {
-                        // Implement XPLOR smoothing
-                        Scalar old_pair_eng = pair_eng;
-                        Scalar old_force_divr = force_divr;
-
-                        // calculate 1.0 / (xplor denominator)
-                        Scalar xplor_denom_inv
-                            = Scalar(1.0)
-                              / ((rcutsq - ronsq) * (rcutsq - ronsq) * (rcutsq - ronsq));
-
-                        Scalar rsq_minus_r_cut_sq = rsq - rcutsq;
-                        Scalar s = rsq_minus_r_cut_sq * rsq_minus_r_cut_sq
-                                   * (rcutsq + Scalar(2.0) * rsq - Scalar(3.0) * ronsq)
-                                   * xplor_denom_inv;
-                        Scalar ds_dr_divr
-                            = Scalar(12.0) * (rsq - ronsq) * rsq_minus_r_cut_sq * xplor_denom_inv;
-
-                        // make modifications to the old pair energy and force
-                        pair_eng = old_pair_eng * s;
-                        force_divr = s * old_force_divr - ds_dr_divr * old_pair_eng;
-                        }
-                    }
                 // calculate the virial
                 if (compute_virial)
                     {
@@ -346,6 +508,49 @@ gpu_compute_pair_forces_shared_kernel(Scalar4* d_force,
                 force.z += dx.z * force_divr;
 
                 force.w += pair_eng;
+
+                if (half && d_fixed)
+                    {
+                    // convert every contribution before summing, so that the sums are exact
+                    Scalar force_div2r = Scalar(0.5) * force_divr;
+                    Scalar value[10] = {dx.x * force_divr,
+                                        dx.y * force_divr,
+                                        dx.z * force_divr,
+                                        Scalar(0.5) * pair_eng,
+                                        dx.x * dx.x * force_div2r,
+                                        dx.x * dx.y * force_div2r,
+                                        dx.x * dx.z * force_div2r,
+                                        dx.y * dx.y * force_div2r,
+                                        dx.y * dx.z * force_div2r,
+                                        dx.z * dx.z * force_div2r};
+                    for (unsigned int k = 0; k < (compute_virial ? 10 : 4); k++)
+                        {
+                        unsigned long long v = hoomd::scalar_to_fixed(value[k]);
+                        fixedi[k] += v;
+
+                        // apply the reaction to local neighbors, the force changes sign
+                        if (cur_j < n_local)
+                            atomicAdd(d_fixed + k * fixed_pitch + cur_j, k < 3 ? -v : v);
+                        }
+                    }
+                else if (half && cur_j < n_local)
+                    {
+                    // apply the reaction to local neighbors
+                    atomicAdd(&d_force[cur_j].x, -dx.x * force_divr);
+                    atomicAdd(&d_force[cur_j].y, -dx.y * force_divr);
+                    atomicAdd(&d_force[cur_j].z, -dx.z * force_divr);
+                    atomicAdd(&d_force[cur_j].w, Scalar(0.5) * pair_eng);
+                    if (compute_virial)
+                        {
+                        Scalar force_div2r = Scalar(0.5) * force_divr;
+                        atomicAdd(d_virial + 0 * virial_pitch + cur_j, dx.x * dx.x * force_div2r);
+                        atomicAdd(d_virial + 1 * virial_pitch + cur_j, dx.x * dx.y * force_div2r);
+                        atomicAdd(d_virial + 2 * virial_pitch + cur_j, dx.x * dx.z * force_div2r);
+                        atomicAdd(d_virial + 3 * virial_pitch + cur_j, dx.y * dx.y * force_div2r);
+                        atomicAdd(d_virial + 4 * virial_pitch + cur_j, dx.y * dx.z * force_div2r);
+                        atomicAdd(d_virial + 5 * virial_pitch + cur_j, dx.z * dx.z * force_div2r);
+                        }
+                    }
                 }
             }
 
@@ -353,6 +558,19 @@ gpu_compute_pair_forces_shared_kernel(Scalar4* d_force,
         force.w *= Scalar(0.5);
         }
 
+    // the integer sums of the fixed point mode are exact in any order
+    if (half && d_fixed)
+        {
+        hoomd::detail::WarpReduce<unsigned long long, tpp> fixed_reducer;
+        for (unsigned int k = 0; k < (compute_virial ? 10 : 4); k++)
+            {
+            fixedi[k] = fixed_reducer.Sum(fixedi[k]);
+            if (active && threadIdx.x % tpp == 0)
+                atomicAdd(d_fixed + k * fixed_pitch + idx, fixedi[k]);
+            }
+        return;
+        }
+
     // reduce force over threads in cta
     hoomd::detail::WarpReduce<Scalar, tpp> reducer;
     force.x = reducer.Sum(force.x);
@@ -361,8 +579,21 @@ gpu_compute_pair_forces_shared_kernel(Scalar4* d_force,
     force.w = reducer.Sum(force.w);
 
     // now that the force calculation is complete, write out the result
+    // in half mode, other threads also add reaction forces to this particle
     if (active && threadIdx.x % tpp == 0)
-        d_force[idx] = force;
+        {
+        if (half)
+            {
+            atomicAdd(&d_force[idx].x, force.x);
+            atomicAdd(&d_force[idx].y, force.y);
+            atomicAdd(&d_force[idx].z, force.z);
+            atomicAdd(&d_force[idx].w, force.w);
+            }
+        else
+            {
+            d_force[idx] = force;
+            }
+        }
 
     if (compute_virial)
         {
@@ -374,7 +605,16 @@ gpu_compute_pair_forces_shared_kernel(Scalar4* d_force,
         virialzz = reducer.Sum(virialzz);
 
         // if we are the first thread in the cta, write out virial to global mem
-        if (active && threadIdx.x % tpp == 0)
+        if (active && threadIdx.x % tpp == 0 && half)
+            {
+            atomicAdd(d_virial + 0 * virial_pitch + idx, virialxx);
+            atomicAdd(d_virial + 1 * virial_pitch + idx, virialxy);
+            atomicAdd(d_virial + 2 * virial_pitch + idx, virialxz);
+            atomicAdd(d_virial + 3 * virial_pitch + idx, virialyy);
+            atomicAdd(d_virial + 4 * virial_pitch + idx, virialyz);
+            atomicAdd(d_virial + 5 * virial_pitch + idx, virialzz);
+            }
+        else if (active && threadIdx.x % tpp == 0)
             {
             d_virial[0 * virial_pitch + idx] = virialxx;
             d_virial[1 * virial_pitch + idx] = virialxy;
@@ -386,6 +626,263 @@ gpu_compute_pair_forces_shared_kernel(Scalar4* d_force,
         }
     }
 
+//! Kernel for calculating pair forces directly from the cell list
+/*! This kernel finds the pairs in the cell list instead of a neighbor list. It evaluates the full
+   force on every local particle, like gpu_compute_pair_forces_shared_kernel() in full mode.
+
+    \param d_force Device memory to write computed forces
+    \param d_virial Device memory to write computed virials
+    \param virial_pitch pitch of 2D virial array
+    \param N number of local particles
+    \param d_charge particle charges
+    \param box Box dimensions used to implement periodic boundary conditions
+    \param d_cell_size Number of particles in each cell
+    \param d_cell_xyzf Positions in the cell list, flagged with the particle index
+    \param d_cell_tdb Types, diameters and bodies in the cell list
+    \param d_cell_adj Cell adjacency list
+    \param ci Cell indexer
+    \param cli Cell list indexer
+    \param cadji Cell adjacency list indexer
+    \param d_params Parameters for the potential, stored per type pair
+    \param d_rcutsq rcut squared, stored per type pair
+    \param d_ronsq ron squared, stored per type pair
+    \param ntypes Number of types in the simulation
+    \param max_extra_bytes Shared memory available to the parameters of the evaluator
+
+    <b>Implementation details</b>
+    Each block computes the forces on the particles of one home cell, \a tpp threads per particle.
+   The block loads the particles of each adjacent cell into shared memory, one tile of blockDim.x
+   particles at a time, and every particle of the home cell evaluates its pairs with the tile. Each
+   neighbor position is read from global memory once per home cell instead of once per pair. Ghost
+   particles in the home cell receive no force. The tile follows the per type pair parameters in
+   the dynamic shared memory and needs blockDim.x * (sizeof(Scalar4) + 2 * sizeof(Scalar) +
+   sizeof(unsigned int)) bytes.
+*/
+template<class evaluator, unsigned int shift_mode, unsigned int compute_virial, int tpp>
+__global__ void gpu_compute_pair_forces_cell_kernel(Scalar4* d_force,
+                                                    Scalar* d_virial,
+                                                    const size_t virial_pitch,
+                                                    const unsigned int N,
+                                                    const Scalar* d_charge,
+                                                    const BoxDim box,
+                                                    const unsigned int* d_cell_size,
+                                                    const Scalar4* d_cell_xyzf,
+                                                    const Scalar4* d_cell_tdb,
+                                                    const unsigned int* d_cell_adj,
+                                                    const Index3D ci,
+                                                    const Index2D cli,
+                                                    const Index2D cadji,
+                                                    const typename evaluator::param_type* d_params,
+                                                    const Scalar* d_rcutsq,
+                                                    const Scalar* d_ronsq,
+                                                    const unsigned int ntypes,
+                                                    unsigned int max_extra_bytes)
+    {
+    Index2D typpair_idx(ntypes);
+    const unsigned int num_typ_parameters = typpair_idx.getNumElements();
+
+    // shared arrays for per type pair parameters
+    HIP_DYNAMIC_SHARED(char, s_data)
+    typename evaluator::param_type* s_params = (typename evaluator::param_type*)(&s_data[0]);
+    Scalar* s_rcutsq
+        = (Scalar*)(&s_data[num_typ_parameters * sizeof(typename evaluator::param_type)]);
+    Scalar* s_ronsq
+        = (Scalar*)(&s_data[num_typ_parameters
+                            * (sizeof(typename evaluator::param_type) + sizeof(Scalar))]);
+
+    // load in the per type pair parameters
+    for (unsigned int cur_offset = 0; cur_offset < num_typ_parameters; cur_offset += blockDim.x)
+        {
+        if (cur_offset + threadIdx.x < num_typ_parameters)
+            {
+            s_rcutsq[cur_offset + threadIdx.x] = d_rcutsq[cur_offset + threadIdx.x];
+            if (shift_mode == 2)
+                s_ronsq[cur_offset + threadIdx.x] = d_ronsq[cur_offset + threadIdx.x];
+            }
+        }
+
+    unsigned int param_size
+        = num_typ_parameters * sizeof(typename evaluator::param_type) / sizeof(int);
+    for (unsigned int cur_offset = 0; cur_offset < param_size; cur_offset += blockDim.x)
+        {
+        if (cur_offset + threadIdx.x < param_size)
+            {
+            ((int*)s_params)[cur_offset + threadIdx.x] = ((int*)d_params)[cur_offset + threadIdx.x];
+            }
+        }
+
+    // initialize extra shared mem
+    auto s_extra = reinterpret_cast<char*>(s_ronsq + num_typ_parameters);
+
+    unsigned int available_bytes = max_extra_bytes;
+    for (unsigned int cur_pair = 0; cur_pair < num_typ_parameters; ++cur_pair)
+        s_params[cur_pair].load_shared(s_extra, available_bytes);
+
+    // the tile of neighbor particles follows the parameters, aligned for Scalar4
+    size_t tile_offset = (s_extra - s_data) + (max_extra_bytes - available_bytes);
+    tile_offset = (tile_offset + sizeof(Scalar4) - 1) / sizeof(Scalar4) * sizeof(Scalar4);
+    Scalar4* s_postype = (Scalar4*)(&s_data[tile_offset]);
+    Scalar* s_diameter = (Scalar*)(s_postype + blockDim.x);
+    Scalar* s_charge = s_diameter + blockDim.x;
+    unsigned int* s_idx = (unsigned int*)(s_charge + blockDim.x);
+
+    __syncthreads();
+
+    const unsigned int home_cell = blockIdx.x;
+    const unsigned int home_size = d_cell_size[home_cell];
+    const unsigned int n_adj = cadji.getW();
+
+    // all threads execute the same number of iterations, so that they can synchronize
+    for (unsigned int home_offset = 0; home_offset < home_size; home_offset += blockDim.x / tpp)
+        {
+        unsigned int home_i = home_offset + threadIdx.x / tpp;
+
+        unsigned int idx = 0;
+        bool active = false;
+        Scalar3 posi = make_scalar3(0, 0, 0);
+        unsigned int typei = 0;
+        Scalar di = Scalar(0);
+        Scalar qi = Scalar(0);
+        if (home_i < home_size)
+            {
+            Scalar4 xyzf = __ldg(d_cell_xyzf + cli(home_i, home_cell));
+            Scalar4 tdb = __ldg(d_cell_tdb + cli(home_i, home_cell));
+            idx = __scalar_as_int(xyzf.w);
+            posi = make_scalar3(xyzf.x, xyzf.y, xyzf.z);
+            typei = __scalar_as_int(tdb.x);
+            di = tdb.y;
+            if (evaluator::needsCharge())
+                qi = __ldg(d_charge + idx);
+
+            // ghost particles receive no force
+            active = idx < N;
+            }
+
+        Scalar4 force = make_scalar4(Scalar(0.0), Scalar(0.0), Scalar(0.0), Scalar(0.0));
+        Scalar virialxx = Scalar(0.0);
+        Scalar virialxy = Scalar(0.0);
+        Scalar virialxz = Scalar(0.0);
+        Scalar virialyy = Scalar(0.0);
+        Scalar virialyz = Scalar(0.0);
+        Scalar virialzz = Scalar(0.0);
+
+        for (unsigned int cur_adj = 0; cur_adj < n_adj; ++cur_adj)
+            {
+            unsigned int neigh_cell = d_cell_adj[cadji(cur_adj, home_cell)];
+            unsigned int neigh_size = d_cell_size[neigh_cell];
+
+            for (unsigned int tile_start = 0; tile_start < neigh_size; tile_start += blockDim.x)
+                {
+                // load the next tile of neighbors
+                __syncthreads();
+                if (tile_start + threadIdx.x < neigh_size)
+                    {
+                    unsigned int k = cli(tile_start + threadIdx.x, neigh_cell);
+                    Scalar4 xyzf = __ldg(d_cell_xyzf + k);
+                    Scalar4 tdb = __ldg(d_cell_tdb + k);
+                    unsigned int j = __scalar_as_int(xyzf.w);
+                    s_postype[threadIdx.x] = make_scalar4(xyzf.x, xyzf.y, xyzf.z, tdb.x);
+                    s_diameter[threadIdx.x] = tdb.y;
+                    s_charge[threadIdx.x]
+                        = evaluator::needsCharge() ? __ldg(d_charge + j) : Scalar(0.0);
+                    s_idx[threadIdx.x] = j;
+                    }
+                __syncthreads();
+
+                if (!active)
+                    continue;
+
+                unsigned int tile_size = neigh_size - tile_start;
+                if (tile_size > blockDim.x)
+                    tile_size = blockDim.x;
+
+                for (unsigned int t = threadIdx.x % tpp; t < tile_size; t += tpp)
+                    {
+                    if (s_idx[t] == idx)
+                        continue;
+
+                    Scalar4 postypej = s_postype[t];
+                    Scalar3 dx = posi - make_scalar3(postypej.x, postypej.y, postypej.z);
+                    dx = box.minImage(dx);
+                    Scalar rsq = dot(dx, dx);
+
+                    // the cells also hold particles beyond the cutoff
+                    unsigned int typpair = typpair_idx(typei, __scalar_as_int(postypej.w));
+                    Scalar rcutsq = s_rcutsq[typpair];
+                    if (rsq >= rcutsq)
+                        continue;
+
+                    Scalar ronsq = Scalar(0.0);
+                    if (shift_mode == 2)
+                        ronsq = s_ronsq[typpair];
+
+                    Scalar force_divr;
+                    Scalar pair_eng;
+                    gpu_pair_evaluate<evaluator, shift_mode>(force_divr,
+                                                             pair_eng,
+                                                             rsq,
+                                                             rcutsq,
+                                                             ronsq,
+                                                             s_params[typpair],
+                                                             di,
+                                                             s_diameter[t],
+                                                             qi,
+                                                             s_charge[t]);
+
+                    if (compute_virial)
+                        {
+                        Scalar force_div2r = Scalar(0.5) * force_divr;
+                        virialxx += dx.x * dx.x * force_div2r;
+                        virialxy += dx.x * dx.y * force_div2r;
+                        virialxz += dx.x * dx.z * force_div2r;
+                        virialyy += dx.y * dx.y * force_div2r;
+                        virialyz += dx.y * dx.z * force_div2r;
+                        virialzz += dx.z * dx.z * force_div2r;
+                        }
+
+                    force.x += dx.x * force_divr;
+                    force.y += dx.y * force_divr;
+                    force.z += dx.z * force_divr;
+                    force.w += pair_eng;
+                    }
+                }
+            }
+
+        // potential energy per particle must be halved
+        force.w *= Scalar(0.5);
+
+        // reduce force over threads in cta
+        hoomd::detail::WarpReduce<Scalar, tpp> reducer;
+        force.x = reducer.Sum(force.x);
+        force.y = reducer.Sum(force.y);
+        force.z = reducer.Sum(force.z);
+        force.w = reducer.Sum(force.w);
+
+        if (active && threadIdx.x % tpp == 0)
+            d_force[idx] = force;
+
+        if (compute_virial)
+            {
+            virialxx = reducer.Sum(virialxx);
+            virialxy = reducer.Sum(virialxy);
+            virialxz = reducer.Sum(virialxz);
+            virialyy = reducer.Sum(virialyy);
+            virialyz = reducer.Sum(virialyz);
+            virialzz = reducer.Sum(virialzz);
+
+            if (active && threadIdx.x % tpp == 0)
+                {
+                d_virial[0 * virial_pitch + idx] = virialxx;
+                d_virial[1 * virial_pitch + idx] = virialxy;
+                d_virial[2 * virial_pitch + idx] = virialxz;
+                d_virial[3 * virial_pitch + idx] = virialyy;
+                d_virial[4 * virial_pitch + idx] = virialyz;
+                d_virial[5 * virial_pitch + idx] = virialzz;
+                }
+            }
+        }
+    }
+
 template<typename T> int get_max_block_size(T func)
     {
     hipFuncAttributes attr;
@@ -434,6 +931,12 @@ struct PairForceComputeKernel
                 = (2 * sizeof(Scalar) + sizeof(typename evaluator::param_type))
                   * typpair_idx.getNumElements();
 
+            if (pair_args.d_cell_size)
+                {
+                launchCell(pair_args, d_params, param_shared_bytes);
+                return;
+                }
+
             static unsigned int max_block_size = UINT_MAX;
             if (max_block_size == UINT_MAX)
                 max_block_size
@@ -477,17 +980,24 @@ struct PairForceComputeKernel
                 pair_args.virial_pitch,
                 N,
                 pair_args.d_pos,
+                pair_args.d_pos_compact,
                 pair_args.d_diameter,
                 pair_args.d_charge,
                 pair_args.box,
                 pair_args.d_n_neigh,
                 pair_args.d_nlist,
                 pair_args.d_head_list,
+                pair_args.d_nlist_delta,
                 d_params,
                 pair_args.d_rcutsq,
                 pair_args.d_ronsq,
                 pair_args.ntypes,
                 offset,
+                pair_args.d_index,
+                pair_args.N,
+                pair_args.half,
+                pair_args.d_fixed,
+                pair_args.fixed_pitch,
                 max_extra_bytes);
             }
         else
@@ -498,6 +1008,77 @@ struct PairForceComputeKernel
                 d_params);
             }
         }
+
+    //! Launcher for the cell list kernel
+    /*!
+     * \param pair_args Other arguments to pass onto the kernel
+     * \param d_params Parameters for the potential, stored per type pair
+     * \param param_shared_bytes Shared memory needed by the per type pair parameters
+     */
+    static void launchCell(const pair_args_t& pair_args,
+                           const typename evaluator::param_type* d_params,
+                           size_t param_shared_bytes)
+        {
+        unsigned int block_size = pair_args.block_size;
+
+        static unsigned int max_block_size = UINT_MAX;
+        if (max_block_size == UINT_MAX)
+            max_block_size = get_max_block_size(
+                gpu_compute_pair_forces_cell_kernel<evaluator, shift_mode, compute_virial, tpp>);
+
+        hipFuncAttributes attr;
+        hipFuncGetAttributes(
+            &attr,
+            reinterpret_cast<const void*>(
+                &gpu_compute_pair_forces_cell_kernel<evaluator, shift_mode, compute_virial, tpp>));
+
+        block_size = block_size < max_block_size ? block_size : max_block_size;
+
+        // the tile of neighbors and padding to align it
+        size_t tile_shared_bytes
+            = block_size * (sizeof(Scalar4) + 2 * sizeof(Scalar) + sizeof(unsigned int))
+              + sizeof(Scalar4);
+
+        unsigned int max_extra_bytes
+            = static_cast<unsigned int>(pair_args.devprop.sharedMemPerBlock - param_shared_bytes
+                                        - tile_shared_bytes - attr.sharedSizeBytes);
+
+        // determine dynamically requested shared memory in nested managed arrays
+        char* ptr = nullptr;
+        unsigned int available_bytes = max_extra_bytes;
+        Index2D typpair_idx(pair_args.ntypes);
+        for (unsigned int i = 0; i < typpair_idx.getNumElements(); ++i)
+            {
+            d_params[i].allocate_shared(ptr, available_bytes);
+            }
+
+        unsigned int extra_shared_bytes = max_extra_bytes - available_bytes;
+
+        hipLaunchKernelGGL(
+            (gpu_compute_pair_forces_cell_kernel<evaluator, shift_mode, compute_virial, tpp>),
+            dim3(pair_args.ci.getNumElements()),
+            dim3(block_size),
+            param_shared_bytes + extra_shared_bytes + tile_shared_bytes,
+            0,
+            pair_args.d_force,
+            pair_args.d_virial,
+            pair_args.virial_pitch,
+            pair_args.N,
+            pair_args.d_charge,
+            pair_args.box,
+            pair_args.d_cell_size,
+            pair_args.d_cell_xyzf,
+            pair_args.d_cell_tdb,
+            pair_args.d_cell_adj,
+            pair_args.ci,
+            pair_args.cli,
+            pair_args.cadji,
+            d_params,
+            pair_args.d_rcutsq,
+            pair_args.d_ronsq,
+            pair_args.ntypes,
+            max_extra_bytes);
+        }
     };
 
 //! Template specialization to do nothing for the tpp = 0 case
@@ -531,6 +1112,8 @@ hipError_t gpu_compute_pair_forces(const pair_args_t& pair_args,
     for (int idev = pair_args.gpu_partition.getNumActiveGPUs() - 1; idev >= 0; --idev)
         {
         auto range = pair_args.gpu_partition.getRangeAndSetGPU(idev);
+        if (pair_args.d_index)
+            range = std::make_pair(pair_args.index_begin, pair_args.index_end);
 
         // Launch kernel
         if (pair_args.compute_virial)
@@ -14,6 +14,7 @@
 #include "PotentialPairGPU.cuh"
 
 #include "hoomd/Autotuner.h"
+#include "hoomd/CellList.h"
 
 /*! \file PotentialPairGPU.h
     \brief Defines the template class for standard pair potentials on the GPU
@@ -38,6 +39,21 @@
    PotentialPairLJGPU.cu and PotentialPairLJGPU.cuh for an example). That function is then passed
    into this class as another template parameter \a gpu_cgpf
 
+    The autotuner chooses between three kernels: the full kernel evaluates every pair twice and
+   writes the force on each particle once. The half kernel evaluates each pair once and adds the
+   reaction to the neighbor with atomic operations, which is faster for expensive evaluators. The
+   half kernel is always used with a half neighbor list and never with more than one GPU. When the
+   neighbor list or the execution configuration is deterministic, the half kernel is always used on
+   a single GPU and sums in 64-bit fixed point, so that the result depends neither on the order of
+   the atomic operations nor on the tuning parameters.
+
+    The cell kernel finds the pairs in a cell list and does not build the neighbor list at all,
+   which saves its memory traffic for short cutoffs and dense systems. It shares the cell list of
+   the neighbor list when their configurations are compatible. It evaluates pairs like the full
+   kernel. The neighbor list filters exclusions, bodies and diameter shifts, so the cell kernel is
+   only used without them, on a single GPU, and when nothing is deterministic. Otherwise, its tuning
+   parameters run the full kernel.
+
     \tparam evaluator EvaluatorPair class used to evaluate V(r) and F(r)/r
     \tparam gpu_cgpf Driver function that calls gpu_compute_pair_forces<evaluator>()
 
@@ -76,12 +92,38 @@ class PotentialPairGPU : public PotentialPair<evaluator>
         m_tuner->setEnabled(enable);
         }
 
+    //! Compute the forces on the particles without ghost neighbors ahead of computeForces()
+    virtual void computeInteriorForces(uint64_t timestep);
+
     protected:
-    std::unique_ptr<Autotuner> m_tuner; //!< Autotuner for block size and threads per particle
-    unsigned int m_param;               //!< Kernel tuning parameter
+    std::unique_ptr<Autotuner> m_tuner;   //!< Autotuner for the kernel and its launch parameters
+    unsigned int m_param;                 //!< Kernel tuning parameter
+    unsigned int m_pass_param;            //!< Parameter of the last pass that started the sums
+    GPUArray<unsigned long long> m_fixed; //!< Fixed point sums of the deterministic half kernel
+    std::shared_ptr<CellList> m_cl;       //!< Cell list of the cell kernel
+    CellListRequest m_cl_request;         //!< Configuration of m_cl
+    GPUArray<float4> m_pos_compact;       //!< Single precision positions relative to the local box
 
     //! Actually compute the forces
     virtual void computeForces(uint64_t timestep);
+
+    //! Test if the tuning parameter selects the cell kernel and the cell kernel is allowed
+    bool useCellKernel(unsigned int param)
+        {
+        return param / 100000000 == 2 && this->m_exec_conf->getNumActiveGPUs() == 1
+               && !this->m_exec_conf->getDeterministic() && !this->m_nlist->getDeterministic()
+               && !this->m_nlist->getExclusionsSet() && !this->m_nlist->getFilterBody()
+               && !this->m_nlist->getDiameterShift();
+        }
+
+    //! Build the cell list of the cell kernel
+    void computeCellList(uint64_t timestep);
+
+    //! Compute the forces on a range of particles on the GPU
+    virtual void computeForcesLoop(unsigned int begin,
+                                   unsigned int end,
+                                   bool ordered,
+                                   bool accumulate);
     };
 
 template<class evaluator,
@@ -89,7 +131,7 @@ template<class evaluator,
                              const typename evaluator::param_type* d_params)>
 PotentialPairGPU<evaluator, gpu_cgpf>::PotentialPairGPU(std::shared_ptr<SystemDefinition> sysdef,
                                                         std::shared_ptr<NeighborList> nlist)
-    : PotentialPair<evaluator>(sysdef, nlist), m_param(0)
+    : PotentialPair<evaluator>(sysdef, nlist), m_param(0), m_pass_param(0)
     {
     // can't run on the GPU if there aren't any GPUs in the execution configuration
     if (!this->m_exec_conf->isCUDAEnabled())
@@ -101,20 +143,27 @@ PotentialPairGPU<evaluator, gpu_cgpf>::PotentialPairGPU(std::shared_ptr<SystemDe
         }
 
     // initialize autotuner
-    // the full block size and threads_per_particle matrix is searched,
-    // encoded as block_size*10000 + threads_per_particle
+    // the kernel, block size and threads_per_particle matrix is searched with coordinate descent,
+    // encoded as kernel*100000000 + block_size*10000 + threads_per_particle with kernel 0 (full),
+    // 1 (half) or 2 (cell). The atomics of the half kernel and the cell list do not reach across
+    // GPUs
     std::vector<unsigned int> valid_params;
     const unsigned int warp_size = this->m_exec_conf->dev_prop.warpSize;
-    for (unsigned int block_size = warp_size; block_size <= 1024; block_size += warp_size)
+    const unsigned int n_kernels = this->m_exec_conf->getNumActiveGPUs() > 1 ? 1 : 3;
+    for (unsigned int kernel = 0; kernel < n_kernels; ++kernel)
         {
-        for (auto s : Autotuner::getTppListPow2(warp_size))
+        for (unsigned int block_size = warp_size; block_size <= 1024; block_size += warp_size)
             {
-            valid_params.push_back(block_size * 10000 + s);
+            for (auto s : Autotuner::getTppListPow2(warp_size))
+                {
+                valid_params.push_back(kernel * 100000000 + block_size * 10000 + s);
+                }
             }
         }
 
     m_tuner.reset(
         new Autotuner(valid_params, 5, 100000, "pair_" + evaluator::getName(), this->m_exec_conf));
+    m_tuner->setDimensions({100000000, 10000, 1});
 #ifdef ENABLE_MPI
     // synchronize autotuner results across ranks
     m_tuner->setSync(bool(this->m_pdata->getDomainDecomposition()));
@@ -126,21 +175,119 @@ template<class evaluator,
                              const typename evaluator::param_type* d_params)>
 void PotentialPairGPU<evaluator, gpu_cgpf>::computeForces(uint64_t timestep)
     {
-    this->m_nlist->compute(timestep);
+    // the cell kernel does not need the neighbor list
+    const bool cell = useCellKernel(!m_param ? m_tuner->getParam() : m_param);
+    if (cell)
+        computeCellList(timestep);
+    else
+        this->m_nlist->compute(timestep);
 
     // start the profile
     if (this->m_prof)
         this->m_prof->push(this->m_exec_conf, this->m_prof_name);
 
-    // The GPU implementation CANNOT handle a half neighborlist, error out now
+    // The half kernel cannot sum forces across GPUs, error out now
     bool third_law = this->m_nlist->getStorageMode() == NeighborList::half;
-    if (third_law)
+    if (third_law && this->m_exec_conf->getNumActiveGPUs() > 1)
         {
         this->m_exec_conf->msg->error()
-            << "PotentialPairGPU cannot handle a half neighborlist" << std::endl;
+            << "PotentialPairGPU cannot handle a half neighborlist on multiple GPUs" << std::endl;
         throw std::runtime_error("Error computing forces in PotentialPairGPU");
         }
 
+    if (this->takeInteriorForces(timestep))
+        {
+        // only the particles with ghost neighbors are left
+        computeForcesLoop(this->m_nlist->getNInterior(), this->m_pdata->getN(), true, true);
+        }
+    else
+        {
+        computeForcesLoop(0, this->m_pdata->getN(), false, false);
+        }
+
+    if (this->m_prof)
+        this->m_prof->pop(this->m_exec_conf);
+    }
+
+/*! \param timestep Current time step
+
+    The particle order of the interior pass is not partitioned between GPUs, so the forces are
+   computed in a single pass on multiple GPUs.
+*/
+template<class evaluator,
+         hipError_t gpu_cgpf(const pair_args_t& pair_args,
+                             const typename evaluator::param_type* d_params)>
+void PotentialPairGPU<evaluator, gpu_cgpf>::computeInteriorForces(uint64_t timestep)
+    {
+    this->m_interior_computed = false;
+    if (this->m_exec_conf->getNumActiveGPUs() > 1
+        || this->m_nlist->getStorageMode() == NeighborList::half
+        || useCellKernel(!m_param ? m_tuner->getParam() : m_param))
+        return;
+
+    PotentialPair<evaluator>::computeInteriorForces(timestep);
+    }
+
+/*! \param timestep Current time step
+
+    The cells are at least as wide as the largest cutoff, so that all pairs are found in the
+   adjacent cells.
+*/
+template<class evaluator,
+         hipError_t gpu_cgpf(const pair_args_t& pair_args,
+                             const typename evaluator::param_type* d_params)>
+void PotentialPairGPU<evaluator, gpu_cgpf>::computeCellList(uint64_t timestep)
+    {
+    Scalar rcutsq_max(0.0);
+        {
+        ArrayHandle<Scalar> h_rcutsq(this->m_rcutsq, access_location::host, access_mode::read);
+        for (unsigned int i = 0; i < this->m_rcutsq.getNumElements(); ++i)
+            rcutsq_max = std::max(rcutsq_max, h_rcutsq.data[i]);
+        }
+
+    // cells as wide as the neighbor list cells are also correct, so the cell kernel shares the
+    // cell list of the neighbor list when it has the same configuration
+    Scalar width = std::max(fast::sqrt(rcutsq_max), Scalar(1e-3));
+    Scalar max_width = this->m_nlist->getMaxRCut() + this->m_nlist->getRBuff();
+
+    // only request a cell list when the widths change
+    if (!m_cl || width != m_cl_request.nominal_width || max_width != m_cl_request.max_width)
+        {
+        m_cl_request.nominal_width = width;
+        m_cl_request.max_width = max_width;
+        m_cl_request.radius = 1;
+        m_cl_request.compute_xyzf = true;
+        m_cl_request.compute_tdb = true;
+        m_cl_request.flag = CellListRequest::flag_index;
+        m_cl = this->m_sysdef->getCellList(m_cl_request);
+#ifdef ENABLE_MPI
+        if (this->m_comm)
+            m_cl->setCommunicator(this->m_comm);
+#endif
+        }
+
+    m_cl->compute(timestep);
+    }
+
+/*! \param begin First entry of the particle order to compute
+    \param end One past the last entry of the particle order to compute
+    \param ordered When true, entry k is particle m_nlist->getBoundaryList()[k], otherwise k
+    \param accumulate When false, start new sums. The full kernel ignores it and writes the complete
+   force on each computed particle, the half kernel adds to the sums of the previous pass
+
+    The boundary pass completes the sums of the interior pass with the same kernel.
+*/
+template<class evaluator,
+         hipError_t gpu_cgpf(const pair_args_t& pair_args,
+                             const typename evaluator::param_type* d_params)>
+void PotentialPairGPU<evaluator, gpu_cgpf>::computeForcesLoop(unsigned int begin,
+                                                              unsigned int end,
+                                                              bool ordered,
+                                                              bool accumulate)
+    {
+    // synchronize the parameters set since the last pass with the GPUs
+    this->prefetchModifiedParams();
+
     // access the neighbor list
     ArrayHandle<unsigned int> d_n_neigh(this->m_nlist->getNNeighArray(),
                                         access_location::device,
@@ -151,6 +298,12 @@ void PotentialPairGPU<evaluator, gpu_cgpf>::computeForces(uint64_t timestep)
     ArrayHandle<unsigned int> d_head_list(this->m_nlist->getHeadList(),
                                           access_location::device,
                                           access_mode::read);
+    ArrayHandle<uint16_t> d_nlist_delta(this->m_nlist->getNListDeltaArray(),
+                                        access_location::device,
+                                        access_mode::read);
+    ArrayHandle<unsigned int> d_boundary_list(this->m_nlist->getBoundaryList(),
+                                              access_location::device,
+                                              access_mode::read);
 
     // access the particle data
     ArrayHandle<Scalar4> d_pos(this->m_pdata->getPositions(),
@@ -176,45 +329,167 @@ void PotentialPairGPU<evaluator, gpu_cgpf>::computeForces(uint64_t timestep)
 
     this->m_exec_conf->beginMultiGPU();
 
-    if (!m_param)
+    // the short boundary pass does not contribute autotuner samples
+    const bool tune = !m_param && !(ordered && accumulate);
+    if (tune)
         this->m_tuner->begin();
-    unsigned int param = !m_param ? this->m_tuner->getParam() : m_param;
-    unsigned int block_size = param / 10000;
+    unsigned int param = m_pass_param;
+    if (!(ordered && accumulate))
+        {
+        param = !m_param ? this->m_tuner->getParam() : m_param;
+        m_pass_param = param;
+        }
+    unsigned int block_size = (param % 100000000) / 10000;
     unsigned int threads_per_particle = param % 10000;
 
-    gpu_cgpf(pair_args_t(d_force.data,
-                         d_virial.data,
-                         this->m_virial.getPitch(),
-                         this->m_pdata->getN(),
-                         this->m_pdata->getMaxN(),
-                         d_pos.data,
-                         d_diameter.data,
-                         d_charge.data,
-                         box,
-                         d_n_neigh.data,
-                         d_nlist.data,
-                         d_head_list.data,
-                         d_rcutsq.data,
-                         d_ronsq.data,
-                         this->m_nlist->getNListArray().getPitch(),
-                         this->m_pdata->getNTypes(),
-                         block_size,
-                         this->m_shift_mode,
-                         flags[pdata_flag::pressure_tensor],
-                         threads_per_particle,
-                         this->m_pdata->getGPUPartition(),
-                         this->m_exec_conf->dev_prop),
-             this->m_params.data());
+    // the fixed point sums do not depend on the tuning parameters, choose them for all parameters
+    // to keep the result reproducible while the autotuner scans
+    const bool single_gpu = this->m_exec_conf->getNumActiveGPUs() == 1;
+    const bool fixed_point = single_gpu
+                             && (this->m_nlist->getDeterministic()
+                                 || this->m_exec_conf->getDeterministic());
+    const bool cell = useCellKernel(param);
+    const bool half = !cell
+                      && (this->m_nlist->getStorageMode() == NeighborList::half || fixed_point
+                          || (param / 100000000 == 1 && single_gpu));
+    const bool compute_virial = flags[pdata_flag::pressure_tensor];
+
+    // the fixed point sums hold four force and six virial components per particle
+    if (fixed_point && m_fixed.getPitch() < this->m_pdata->getMaxN())
+        {
+        GPUArray<unsigned long long> fixed(this->m_pdata->getMaxN(), 10, this->m_exec_conf);
+        m_fixed.swap(fixed);
+        }
+    ArrayHandle<unsigned long long> d_fixed(m_fixed,
+                                            access_location::device,
+                                            access_mode::readwrite);
+
+    // the half kernel adds to the forces of both particles in every pair
+    if (half && !accumulate)
+        {
+        if (fixed_point)
+            {
+            hipMemset(d_fixed.data, 0, sizeof(unsigned long long) * m_fixed.getNumElements());
+            }
+        else
+            {
+            hipMemset(d_force.data, 0, sizeof(Scalar4) * this->m_force.getNumElements());
+            if (compute_virial)
+                hipMemset(d_virial.data, 0, sizeof(Scalar) * this->m_virial.getNumElements());
+            }
+        }
+
+    pair_args_t pair_args(d_force.data,
+                          d_virial.data,
+                          this->m_virial.getPitch(),
+                          this->m_pdata->getN(),
+                          this->m_pdata->getMaxN(),
+                          d_pos.data,
+                          d_diameter.data,
+                          d_charge.data,
+                          box,
+                          d_n_neigh.data,
+                          d_nlist.data,
+                          d_head_list.data,
+                          d_nlist_delta.data,
+                          d_rcutsq.data,
+                          d_ronsq.data,
+                          this->m_nlist->getNListArray().getPitch(),
+                          this->m_pdata->getNTypes(),
+                          block_size,
+                          this->m_shift_mode,
+                          compute_virial,
+                          threads_per_particle,
+                          this->m_pdata->getGPUPartition(),
+                          this->m_exec_conf->dev_prop);
+    if (ordered)
+        {
+        pair_args.d_index = d_boundary_list.data;
+        pair_args.index_begin = begin;
+        pair_args.index_end = end;
+        }
+
+    // the cell list arrays are only acquired for the cell kernel
+    std::unique_ptr<ArrayHandle<unsigned int>> d_cell_size;
+    std::unique_ptr<ArrayHandle<Scalar4>> d_cell_xyzf;
+    std::unique_ptr<ArrayHandle<Scalar4>> d_cell_tdb;
+    std::unique_ptr<ArrayHandle<unsigned int>> d_cell_adj;
+    if (cell)
+        {
+        d_cell_size.reset(new ArrayHandle<unsigned int>(m_cl->getCellSizeArray(),
+                                                        access_location::device,
+                                                        access_mode::read));
+        d_cell_xyzf.reset(new ArrayHandle<Scalar4>(m_cl->getXYZFArray(),
+                                                   access_location::device,
+                                                   access_mode::read));
+        d_cell_tdb.reset(new ArrayHandle<Scalar4>(m_cl->getTDBArray(),
+                                                  access_location::device,
+                                                  access_mode::read));
+        d_cell_adj.reset(new ArrayHandle<unsigned int>(m_cl->getCellAdjArray(),
+                                                       access_location::device,
+                                                       access_mode::read));
+        pair_args.d_cell_size = d_cell_size->data;
+        pair_args.d_cell_xyzf = d_cell_xyzf->data;
+        pair_args.d_cell_tdb = d_cell_tdb->data;
+        pair_args.d_cell_adj = d_cell_adj->data;
+        pair_args.ci = m_cl->getCellIndexer();
+        pair_args.cli = m_cl->getCellListIndexer();
+        pair_args.cadji = m_cl->getCellAdjIndexer();
+        }
+
+    // convert the positions of the local and ghost particles in every pass, the ghosts arrive
+    // between the interior and boundary passes
+    const bool compact = this->m_compact_positions && !cell && single_gpu;
+    if (compact && m_pos_compact.getNumElements() < this->m_pdata->getMaxN())
+        {
+        GPUArray<float4> pos_compact(this->m_pdata->getMaxN(), this->m_exec_conf);
+        m_pos_compact.swap(pos_compact);
+        }
+    ArrayHandle<float4> d_pos_compact(m_pos_compact,
+                                      access_location::device,
+                                      access_mode::readwrite);
+    if (compact)
+        {
+        // positions relative to the center of the local box keep the most significant bits
+        Scalar3 origin = (box.getLo() + box.getHi()) / Scalar(2.0);
+        gpu_pair_compact_positions(d_pos_compact.data,
+                                   d_pos.data,
+                                   this->m_pdata->getN() + this->m_pdata->getNGhosts(),
+                                   origin,
+                                   256);
+        pair_args.d_pos_compact = d_pos_compact.data;
+        }
+
+    if (half)
+        {
+        pair_args.half = 1;
+        if (fixed_point)
+            {
+            pair_args.d_fixed = d_fixed.data;
+            pair_args.fixed_pitch = m_fixed.getPitch();
+            }
+        }
+    gpu_cgpf(pair_args, this->m_params.data());
+
+    // convert the sums after every pass, the boundary pass overwrites the partial interior result
+    if (fixed_point)
+        {
+        gpu_pair_fixed_point_finalize(d_force.data,
+                                      d_virial.data,
+                                      this->m_virial.getPitch(),
+                                      d_fixed.data,
+                                      m_fixed.getPitch(),
+                                      this->m_pdata->getN(),
+                                      compute_virial,
+                                      256);
+        }
 
     if (this->m_exec_conf->isCUDAErrorCheckingEnabled())
         CHECK_CUDA_ERROR();
-    if (!m_param)
+    if (tune)
         this->m_tuner->end();
 
     this->m_exec_conf->endMultiGPU();
-
-    if (this->m_prof)
-        this->m_prof->pop(this->m_exec_conf);
     }
 
 //! Export this pair potential to python
@@ -152,22 +152,23 @@ void PotentialSpecialPairGPU<evaluator, gpu_cgbf>::computeForces(uint64_t timest
         ArrayHandle<unsigned int> d_flags(m_flags, access_location::device, access_mode::readwrite);
 
         this->m_tuner->begin();
-        gpu_cgbf(bond_args_t(d_force.data,
-                             d_virial.data,
-                             this->m_virial.getPitch(),
-                             this->m_pdata->getN(),
-                             this->m_pdata->getMaxN(),
-                             d_pos.data,
-                             d_charge.data,
-                             d_diameter.data,
-                             box,
-                             d_gpu_bondlist.data,
-                             gpu_table_indexer,
-                             d_gpu_n_bonds.data,
-                             this->m_pair_data->getNTypes(),
-                             this->m_tuner->getParam()),
-                 d_params.data,
-                 d_flags.data);
+        bond_args_t bond_args(d_force.data,
+                              d_virial.data,
+                              this->m_virial.getPitch(),
+                              this->m_pdata->getN(),
+                              this->m_pdata->getMaxN(),
+                              d_pos.data,
+                              d_charge.data,
+                              d_diameter.data,
+                              box,
+                              d_gpu_bondlist.data,
+                              gpu_table_indexer,
+                              d_gpu_n_bonds.data,
+                              this->m_pair_data->getNTypes(),
+                              this->m_tuner->getParam());
+        bond_args.fixed_point = this->m_exec_conf->getDeterministic();
+        bond_args.compute_virial = this->m_pdata->getFlags()[pdata_flag::pressure_tensor];
+        gpu_cgbf(bond_args, d_params.data, d_flags.data);
         }
 
     if (this->m_exec_conf->isCUDAErrorCheckingEnabled())
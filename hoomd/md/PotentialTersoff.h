@@ -8,6 +8,7 @@
 #include <iostream>
 #include <memory>
 #include <stdexcept>
+#include <vector>
 
 #include "NeighborList.h"
 #include "hoomd/ForceCompute.h"
@@ -15,6 +16,12 @@
 #include "hoomd/HOOMDMath.h"
 #include "hoomd/Index1D.h"
 
+#ifdef ENABLE_TBB
+#include <tbb/blocked_range.h>
+#include <tbb/enumerable_thread_specific.h>
+#include <tbb/parallel_for.h>
+#endif
+
 /*! \file PotentialTersoff.h
     \brief Defines the template class for standard three-body potentials
     \details The heart of the code that computes three-body potentials is in this file.
@@ -119,8 +126,88 @@ template<class evaluator> class PotentialTersoff : public ForceCompute
     // r_cut (not squared) given to the neighborlist
     std::shared_ptr<GlobalArray<Scalar>> m_r_cut_nlist;
 
+    //! Host pointers and flags shared by all ranges of the CPU force loop
+    struct ForceLoopArgs
+        {
+        const unsigned int* n_neigh;   //!< Number of neighbors of each particle
+        const unsigned int* nlist;     //!< Neighbor list
+        const unsigned int* head_list; //!< Index of the first neighbor of each particle
+        const Scalar4* pos;            //!< Particle positions and types
+        const Scalar* rcutsq;          //!< Cutoff radius squared per type pair
+        const param_type* params;      //!< Parameters per type pair
+        BoxDim box;                    //!< Local simulation box
+        unsigned int N;                //!< Number of local particles
+        unsigned int n_types;          //!< Number of particle types
+        bool compute_virial;           //!< True when the virial is needed
+        };
+
+    //! Neighbors of one particle with their minimum image separations, as a structure of arrays
+    struct NeighborScratch
+        {
+        std::vector<unsigned int> idx;  //!< Particle index of each neighbor
+        std::vector<unsigned int> type; //!< Type of each neighbor
+        std::vector<Scalar> dx;         //!< x component of r_i - r_k
+        std::vector<Scalar> dy;         //!< y component of r_i - r_k
+        std::vector<Scalar> dz;         //!< z component of r_i - r_k
+        std::vector<Scalar> rsq;        //!< |r_i - r_k|^2
+        std::vector<Scalar> cos_th;     //!< Cosine of the angle jik for the current j
+        std::vector<Scalar> phi_ab;     //!< Per type sum of phi for the current particle
+
+        //! Resize the per neighbor arrays
+        void resize(unsigned int size)
+            {
+            idx.resize(size);
+            type.resize(size);
+            dx.resize(size);
+            dy.resize(size);
+            dz.resize(size);
+            rsq.resize(size);
+            cos_th.resize(size);
+            }
+        };
+
+#ifdef ENABLE_TBB
+    /// Per-thread force accumulators, including ghost particles
+    tbb::enumerable_thread_specific<std::vector<Scalar4>> m_thread_force;
+
+    /// Per-thread virial accumulators, including ghost particles
+    tbb::enumerable_thread_specific<std::vector<Scalar>> m_thread_virial;
+#endif
+
     //! Actually compute the forces
     virtual void computeForces(uint64_t timestep);
+
+    //! Compute the forces on a range of local particles
+    void computeForcesRange(unsigned int begin,
+                            unsigned int end,
+                            const ForceLoopArgs& args,
+                            Scalar4* force,
+                            Scalar* virial,
+                            size_t virial_pitch);
+
+    //! Compute the RevCross forces on a range of local particles
+    void computeRevCrossRange(unsigned int begin,
+                              unsigned int end,
+                              const ForceLoopArgs& args,
+                              NeighborScratch& neigh,
+                              Scalar4* force,
+                              Scalar* virial,
+                              size_t virial_pitch);
+
+    //! Compute the Tersoff or SquareDensity forces on a range of local particles
+    void computeTersoffRange(unsigned int begin,
+                             unsigned int end,
+                             const ForceLoopArgs& args,
+                             NeighborScratch& neigh,
+                             Scalar4* force,
+                             Scalar* virial,
+                             size_t virial_pitch);
+
+    //! Load the neighbors of a particle and their separations
+    void loadNeighbors(unsigned int i, const ForceLoopArgs& args, NeighborScratch& neigh);
+
+    //! Compute the bond angles jik for all neighbors k
+    void computeAngles(unsigned int j, NeighborScratch& neigh);
     };
 
 /*! \param sysdef System to compute forces on
@@ -256,716 +343,765 @@ template<class evaluator> Scalar PotentialTersoff<evaluator>::getRCut(pybind11::
    called to ensure that it is up to date before proceeding.
 
     \param timestep specifies the current time step of the simulation
+
+    When HOOMD is built with TBB, the loop over particles is split among the threads of the
+   execution configuration's task arena. Each particle adds forces to its neighbors j and k, so the
+   threads accumulate into per-thread force and virial arrays that are summed after the loop.
 */
 template<class evaluator> void PotentialTersoff<evaluator>::computeForces(uint64_t timestep)
     {
-    // *****  check if we need the structure of the Tersoff or the RevCross potential for evaluation
-    if (evaluator::flag_for_RevCross)
-        {
-        // ***** RevCross potential
-        // start by updating the neighborlist
-        m_nlist->compute(timestep);
+    // start by updating the neighborlist
+    m_nlist->compute(timestep);
 
-        // start the profile for this compute
-        if (m_prof)
-            m_prof->push(m_prof_name);
+    // start the profile for this compute
+    if (m_prof)
+        m_prof->push(m_prof_name);
 
-        // The three-body potentials can't handle a half neighbor list, so check now.
-        bool third_law = m_nlist->getStorageMode() == NeighborList::half;
-        if (third_law)
-            {
-            m_exec_conf->msg->error()
-                << std::endl
-                << "PotentialRevCross cannot handle a half neighborlist" << std::endl;
-            throw std::runtime_error("Error computing forces in PotentialRevCross");
-            }
+    // The three-body potentials can't handle a half neighbor list, so check now.
+    bool third_law = m_nlist->getStorageMode() == NeighborList::half;
+    if (third_law)
+        {
+        const std::string name
+            = evaluator::flag_for_RevCross ? "PotentialRevCross" : "PotentialTersoff";
+        m_exec_conf->msg->error()
+            << std::endl
+            << name << " cannot handle a half neighborlist" << std::endl;
+        throw std::runtime_error("Error computing forces in " + name);
+        }
 
-        // access the neighbor list, particle data, and system box
-        ArrayHandle<unsigned int> h_n_neigh(m_nlist->getNNeighArray(),
-                                            access_location::host,
-                                            access_mode::read);
-        ArrayHandle<unsigned int> h_nlist(m_nlist->getNListArray(),
+    // access the neighbor list, particle data, and system box
+    ArrayHandle<unsigned int> h_n_neigh(m_nlist->getNNeighArray(),
+                                        access_location::host,
+                                        access_mode::read);
+    ArrayHandle<unsigned int> h_nlist(m_nlist->getNListArray(),
+                                      access_location::host,
+                                      access_mode::read);
+    ArrayHandle<unsigned int> h_head_list(m_nlist->getHeadList(),
                                           access_location::host,
                                           access_mode::read);
-        ArrayHandle<unsigned int> h_head_list(m_nlist->getHeadList(),
-                                              access_location::host,
-                                              access_mode::read);
 
-        ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(),
-                                   access_location::host,
-                                   access_mode::read);
+    ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
 
-        // force and virial arrays
-        ArrayHandle<Scalar4> h_force(m_force, access_location::host, access_mode::overwrite);
-        ArrayHandle<Scalar> h_virial(m_virial, access_location::host, access_mode::overwrite);
+    // force and virial arrays
+    ArrayHandle<Scalar4> h_force(m_force, access_location::host, access_mode::overwrite);
+    ArrayHandle<Scalar> h_virial(m_virial, access_location::host, access_mode::overwrite);
 
-        PDataFlags flags = this->m_pdata->getFlags();
-        bool compute_virial = flags[pdata_flag::pressure_tensor];
-
-        const BoxDim& box = m_pdata->getBox();
-        ArrayHandle<Scalar> h_rcutsq(m_rcutsq, access_location::host, access_mode::read);
-        ArrayHandle<param_type> h_params(m_params, access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_rcutsq(m_rcutsq, access_location::host, access_mode::read);
+    ArrayHandle<param_type> h_params(m_params, access_location::host, access_mode::read);
 
-        // need to start from a zero force, energy
-        memset(h_force.data, 0, sizeof(Scalar4) * (m_pdata->getN() + m_pdata->getNGhosts()));
-        memset(h_virial.data, 0, sizeof(Scalar) * 6 * m_virial_pitch);
+    PDataFlags flags = this->m_pdata->getFlags();
+
+    ForceLoopArgs args;
+    args.n_neigh = h_n_neigh.data;
+    args.nlist = h_nlist.data;
+    args.head_list = h_head_list.data;
+    args.pos = h_pos.data;
+    args.rcutsq = h_rcutsq.data;
+    args.params = h_params.data;
+    args.box = m_pdata->getBox();
+    args.N = m_pdata->getN();
+    args.n_types = m_pdata->getNTypes();
+    args.compute_virial = flags[pdata_flag::pressure_tensor];
+
+    // need to start from a zero force, energy
+    const unsigned int n_total = m_pdata->getN() + m_pdata->getNGhosts();
+    memset(h_force.data, 0, sizeof(Scalar4) * n_total);
+    memset(h_virial.data, 0, sizeof(Scalar) * 6 * m_virial_pitch);
+
+#ifdef ENABLE_TBB
+    // reset the per-thread accumulators that survive from the previous step
+    for (auto& thread_force : m_thread_force)
+        thread_force.assign(n_total, make_scalar4(0, 0, 0, 0));
+    if (args.compute_virial)
+        {
+        for (auto& thread_virial : m_thread_virial)
+            thread_virial.assign(6 * size_t(n_total), Scalar(0.0));
+        }
 
-        // for each particle
-        for (int i = 0; i < (int)m_pdata->getN(); i++)
-            {
-            // access the particle's position and type (MEM TRANSFER: 4 scalars)
-            Scalar3 posi = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
-            unsigned int typei = __scalar_as_int(h_pos.data[i].w);
-            const unsigned int head_i = h_head_list.data[i];
-            // sanity check
-            assert(typei < m_pdata->getNTypes());
-
-            // initialize current force and potential energy of particle i to 0
-            Scalar3 fi = make_scalar3(0.0, 0.0, 0.0);
-            Scalar pei = 0.0;
-
-            Scalar virialixx(0.0);
-            Scalar virialixy(0.0);
-            Scalar virialixz(0.0);
-            Scalar virialiyy(0.0);
-            Scalar virialiyz(0.0);
-            Scalar virializz(0.0);
-
-            // loop over all of the neighbors of this particle
-            const unsigned int size = (unsigned int)h_n_neigh.data[i];
-            for (unsigned int j = 0; j < size; j++)
+    m_exec_conf->getTaskArena()->execute(
+        [&]
+        {
+            tbb::parallel_for(tbb::blocked_range<unsigned int>(0, args.N),
+                              [&](const tbb::blocked_range<unsigned int>& r)
+                              {
+                                  // threads that join after the reset start with empty arrays
+                                  std::vector<Scalar4>& thread_force = m_thread_force.local();
+                                  std::vector<Scalar>& thread_virial = m_thread_virial.local();
+                                  if (thread_force.size() != n_total)
+                                      thread_force.assign(n_total, make_scalar4(0, 0, 0, 0));
+                                  if (args.compute_virial
+                                      && thread_virial.size() != 6 * size_t(n_total))
+                                      thread_virial.assign(6 * size_t(n_total), Scalar(0.0));
+
+                                  computeForcesRange(r.begin(),
+                                                     r.end(),
+                                                     args,
+                                                     thread_force.data(),
+                                                     thread_virial.data(),
+                                                     n_total);
+                              });
+
+            // sum the per-thread contributions
+            tbb::parallel_for(
+                tbb::blocked_range<unsigned int>(0, n_total),
+                [&](const tbb::blocked_range<unsigned int>& r)
                 {
-                // access the index of neighbor j (MEM TRANSFER: 1 scalar)
-                unsigned int jj = h_nlist.data[head_i + j];
-                assert(jj < m_pdata->getN() + m_pdata->getNGhosts());
+                    for (auto& thread_force : m_thread_force)
+                        {
+                        for (unsigned int i = r.begin(); i != r.end(); ++i)
+                            {
+                            h_force.data[i].x += thread_force[i].x;
+                            h_force.data[i].y += thread_force[i].y;
+                            h_force.data[i].z += thread_force[i].z;
+                            h_force.data[i].w += thread_force[i].w;
+                            }
+                        }
 
-                // access the position and type of particle j
-                Scalar3 posj = make_scalar3(h_pos.data[jj].x, h_pos.data[jj].y, h_pos.data[jj].z);
-                unsigned int typej = __scalar_as_int(h_pos.data[jj].w);
-                assert(typej < m_pdata->getNTypes());
+                    if (args.compute_virial)
+                        {
+                        for (auto& thread_virial : m_thread_virial)
+                            {
+                            for (unsigned int k = 0; k < 6; ++k)
+                                for (unsigned int i = r.begin(); i != r.end(); ++i)
+                                    h_virial.data[k * m_virial_pitch + i]
+                                        += thread_virial[k * size_t(n_total) + i];
+                            }
+                        }
+                });
+        });
+#else
+    computeForcesRange(0, args.N, args, h_force.data, h_virial.data, m_virial_pitch);
+#endif
 
-                // initialize the current force and potential energy of particle j to 0
-                Scalar3 fj = make_scalar3(0.0, 0.0, 0.0);
-                Scalar pej = 0.0;
+    if (m_prof)
+        m_prof->pop();
+    }
 
-                // calculate dr_ij (MEM TRANSFER: 3 scalars / FLOPS: 3)
-                Scalar3 dxij = posi - posj;
+/*! \param i Local particle index
+    \param args Host pointers and flags for the force loop
+    \param neigh Output: the neighbors of particle \a i
 
-                // apply periodic boundary conditions
-                dxij = box.minImage(dxij);
+    The minimum image separations are computed once per neighbor here instead of once per pair of
+   neighbors in the three-body loops.
+*/
+template<class evaluator>
+void PotentialTersoff<evaluator>::loadNeighbors(unsigned int i,
+                                                const ForceLoopArgs& args,
+                                                NeighborScratch& neigh)
+    {
+    const Scalar3 posi = make_scalar3(args.pos[i].x, args.pos[i].y, args.pos[i].z);
+    const unsigned int head_i = args.head_list[i];
+    const unsigned int size = args.n_neigh[i];
+    neigh.resize(size);
 
-                // compute rij_sq (FLOPS: 5)
-                Scalar rij_sq = dot(dxij, dxij);
+    for (unsigned int k = 0; k < size; k++)
+        {
+        // access the index of neighbor k (MEM TRANSFER: 1 scalar)
+        unsigned int kk = args.nlist[head_i + k];
+        assert(kk < m_pdata->getN() + m_pdata->getNGhosts());
+
+        // access the position and type of particle k
+        const Scalar4 postype_k = args.pos[kk];
+        unsigned int typek = __scalar_as_int(postype_k.w);
+        assert(typek < m_pdata->getNTypes());
+
+        // calculate dr_ik and apply periodic boundary conditions
+        Scalar3 dxik = posi - make_scalar3(postype_k.x, postype_k.y, postype_k.z);
+        dxik = args.box.minImage(dxik);
+
+        neigh.idx[k] = kk;
+        neigh.type[k] = typek;
+        neigh.dx[k] = dxik.x;
+        neigh.dy[k] = dxik.y;
+        neigh.dz[k] = dxik.z;
+        neigh.rsq[k] = dot(dxik, dxik);
+        }
+    }
 
-                // get parameters for this type pair
-                unsigned int typpair_idx = m_typpair_idx(typei, typej);
-                param_type param = h_params.data[typpair_idx];
-                Scalar rcutsq = h_rcutsq.data[typpair_idx];
-
-                // evaluate the base repulsive and attractive terms
-                Scalar invratio = 0.0;
-                Scalar invratio2 = 0.0;
-                evaluator eval(rij_sq, rcutsq, param);
-                bool evaluated = eval.evalRepulsiveAndAttractive(invratio, invratio2);
-
-                // Even though the i-j interaction is symmetric so in principle I could consider i>j
-                // only, I have to loop over both i-j-k and j-i-k because I search only in neighbors
-                // of of the first element (since nl are type-wise I can not even merge them because
-                // i, j and k could be different types)
-                if (evaluated)
+/*! \param j Neighbor to compute the angles to
+    \param neigh The neighbors of the current particle
+
+    Fills neigh.cos_th with the cosine of the angle between the ij and ik bonds for every neighbor
+   k. The loop has no branches and vectorizes over k.
+*/
+template<class evaluator>
+void PotentialTersoff<evaluator>::computeAngles(unsigned int j, NeighborScratch& neigh)
+    {
+    const Scalar dx = neigh.dx[j];
+    const Scalar dy = neigh.dy[j];
+    const Scalar dz = neigh.dz[j];
+    const Scalar rij_sq = neigh.rsq[j];
+    const unsigned int size = (unsigned int)neigh.idx.size();
+
+    const Scalar* ndx = neigh.dx.data();
+    const Scalar* ndy = neigh.dy.data();
+    const Scalar* ndz = neigh.dz.data();
+    const Scalar* nrsq = neigh.rsq.data();
+    Scalar* cos_th = neigh.cos_th.data();
+    for (unsigned int k = 0; k < size; k++)
+        {
+        cos_th[k] = (dx * ndx[k] + dy * ndy[k] + dz * ndz[k]) / fast::sqrt(rij_sq * nrsq[k]);
+        }
+    }
+
+/*! \param begin First local particle index to compute
+    \param end One past the last local particle index to compute
+    \param args Host pointers and flags for the force loop
+    \param force Force array to accumulate into
+    \param virial Virial array to accumulate into
+    \param virial_pitch Pitch of \a virial
+
+    Forces on particles in [begin, end) and on their neighbors are added to \a force and \a virial,
+   so concurrent callers must pass separate arrays.
+*/
+template<class evaluator>
+void PotentialTersoff<evaluator>::computeForcesRange(unsigned int begin,
+                                                     unsigned int end,
+                                                     const ForceLoopArgs& args,
+                                                     Scalar4* force,
+                                                     Scalar* virial,
+                                                     size_t virial_pitch)
+    {
+    NeighborScratch neigh;
+    if (evaluator::flag_for_RevCross)
+        computeRevCrossRange(begin, end, args, neigh, force, virial, virial_pitch);
+    else
+        computeTersoffRange(begin, end, args, neigh, force, virial, virial_pitch);
+    }
+
+//! Compute the RevCross forces on a range of local particles
+template<class evaluator>
+void PotentialTersoff<evaluator>::computeRevCrossRange(unsigned int begin,
+                                                       unsigned int end,
+                                                       const ForceLoopArgs& args,
+                                                       NeighborScratch& neigh,
+                                                       Scalar4* force,
+                                                       Scalar* virial,
+                                                       size_t virial_pitch)
+    {
+    const bool compute_virial = args.compute_virial;
+
+    // for each particle
+    for (unsigned int i = begin; i < end; i++)
+        {
+        // access the particle's type (MEM TRANSFER: 1 scalar)
+        unsigned int typei = __scalar_as_int(args.pos[i].w);
+        // sanity check
+        assert(typei < m_pdata->getNTypes());
+
+        loadNeighbors(i, args, neigh);
+
+        // initialize current force and potential energy of particle i to 0
+        Scalar3 fi = make_scalar3(0.0, 0.0, 0.0);
+        Scalar pei = 0.0;
+
+        Scalar virialixx(0.0);
+        Scalar virialixy(0.0);
+        Scalar virialixz(0.0);
+        Scalar virialiyy(0.0);
+        Scalar virialiyz(0.0);
+        Scalar virializz(0.0);
+
+        // loop over all of the neighbors of this particle
+        const unsigned int size = args.n_neigh[i];
+        for (unsigned int j = 0; j < size; j++)
+            {
+            unsigned int jj = neigh.idx[j];
+            unsigned int typej = neigh.type[j];
+
+            // initialize the current force and potential energy of particle j to 0
+            Scalar3 fj = make_scalar3(0.0, 0.0, 0.0);
+            Scalar pej = 0.0;
+
+            Scalar3 dxij = make_scalar3(neigh.dx[j], neigh.dy[j], neigh.dz[j]);
+            Scalar rij_sq = neigh.rsq[j];
+
+            // get parameters for this type pair
+            unsigned int typpair_idx = m_typpair_idx(typei, typej);
+            param_type param = args.params[typpair_idx];
+            Scalar rcutsq = args.rcutsq[typpair_idx];
+
+            // evaluate the base repulsive and attractive terms
+            Scalar invratio = 0.0;
+            Scalar invratio2 = 0.0;
+            evaluator eval(rij_sq, rcutsq, param);
+            bool evaluated = eval.evalRepulsiveAndAttractive(invratio, invratio2);
+
+            // Even though the i-j interaction is symmetric so in principle I could consider i>j
+            // only, I have to loop over both i-j-k and j-i-k because I search only in neighbors
+            // of of the first element (since nl are type-wise I can not even merge them because
+            // i, j and k could be different types)
+            if (evaluated)
+                {
+                // evaluate the force and energy from the ij interaction
+                Scalar force_divr = Scalar(0.0);
+                Scalar potential_eng = Scalar(0.0);
+                Scalar bij = Scalar(0.0); // not used
+                eval.evalForceij(invratio,
+                                 invratio2,
+                                 Scalar(0.0),
+                                 Scalar(0.0),
+                                 bij,
+                                 force_divr,
+                                 potential_eng);
+
+                // add this force to particle i
+                fi += force_divr * dxij;
+                pei += potential_eng;
+
+                // add this force to particle j
+                fj += Scalar(-1.0) * force_divr * dxij;
+                pej += potential_eng;
+
+                // vir contribute for i j direct interaction on particle i and j
+                if (compute_virial)
                     {
-                    // printf("\nEvaluating the pair (i,j)=(%d, %d)  from inside HOOMD CPU",i,jj);
-                    // evaluate the force and energy from the ij interaction
-                    Scalar force_divr = Scalar(0.0);
-                    Scalar potential_eng = Scalar(0.0);
-                    Scalar bij = Scalar(0.0); // not used
-                    eval.evalForceij(invratio,
-                                     invratio2,
-                                     Scalar(0.0),
-                                     Scalar(0.0),
-                                     bij,
-                                     force_divr,
-                                     potential_eng);
-
-                    // add this force to particle i
-                    fi += force_divr * dxij;
-                    pei += potential_eng;
-
-                    // add this force to particle j
-                    fj += Scalar(-1.0) * force_divr * dxij;
-                    pej += potential_eng;
-
-                    // vir contribute for i j direct interaction on particle i and j
-                    if (compute_virial)
-                        {
-                        virialixx += force_divr * dxij.x * dxij.x;
-                        virialixy += force_divr * dxij.x * dxij.y;
-                        virialixz += force_divr * dxij.x * dxij.z;
-                        virialiyy += force_divr * dxij.y * dxij.y;
-                        virialiyz += force_divr * dxij.y * dxij.z;
-                        virializz += force_divr * dxij.z * dxij.z;
-                        }
+                    virialixx += force_divr * dxij.x * dxij.x;
+                    virialixy += force_divr * dxij.x * dxij.y;
+                    virialixz += force_divr * dxij.x * dxij.z;
+                    virialiyy += force_divr * dxij.y * dxij.y;
+                    virialiyz += force_divr * dxij.y * dxij.z;
+                    virializz += force_divr * dxij.z * dxij.z;
+                    }
 
-                    // evaluate the force from the ik interactions
-                    for (unsigned int k = j + 1; k < size;
-                         k++) // I want to account only a single time for each triplets
+                // evaluate the force from the ik interactions
+                for (unsigned int k = j + 1; k < size;
+                     k++) // I want to account only a single time for each triplets
+                    {
+                    unsigned int kk = neigh.idx[k];
+                    unsigned int typek = neigh.type[k];
+
+                    // access the type pair parameters for i and k
+                    typpair_idx = m_typpair_idx(typei, typek);
+                    param_type temp_param
+                        = args.params[typpair_idx]; // use this to control the species wich
+                                                    // have to interact
+
+                    Scalar3 dxik = make_scalar3(neigh.dx[k], neigh.dy[k], neigh.dz[k]);
+                    Scalar rik_sq = neigh.rsq[k];
+
+                    // check if k interacts using a temporary evaluator to analyze i-k
+                    // parameters
+                    evaluator temp_eval(rij_sq, rcutsq, temp_param);
+                    temp_eval.setRik(rik_sq);
+                    bool temp_evaluated = temp_eval.areInteractive();
+
+                    // 3 Body interaction ******
+                    if (temp_evaluated)
                         {
-                        // access the index of neighbor k
-                        unsigned int kk = h_nlist.data[head_i + k];
-                        assert(kk < m_pdata->getN());
+                        eval.setRik(rik_sq);
+                        // compute the total force and energy
+                        Scalar3 fk = make_scalar3(0.0, 0.0, 0.0);
+                        Scalar3 force_divr_ij_vec = make_scalar3(0.0, 0.0, 0.0);
+                        Scalar3 force_divr_ik_vec = make_scalar3(0.0, 0.0, 0.0);
+                        bool evaluatedk = eval.evalForceik(invratio,
+                                                           invratio2,
+                                                           Scalar(0.0),
+                                                           Scalar(0.0),
+                                                           force_divr_ij_vec,
+                                                           force_divr_ik_vec);
+                        // k interacts with the i-j as an additional third body
+                        if (evaluatedk)
+                            {
+                            // I stored the modulus of the force in the first component
+                            Scalar force_divr_ij = force_divr_ij_vec.x;
+                            Scalar force_divr_ik = force_divr_ik_vec.x;
 
-                        // access the position and type of neighbor k
-                        Scalar3 posk
-                            = make_scalar3(h_pos.data[kk].x, h_pos.data[kk].y, h_pos.data[kk].z);
-                        unsigned int typek = __scalar_as_int(h_pos.data[kk].w);
-                        assert(typek < m_pdata->getNTypes());
+                            // add the force to particle i
+                            fi += force_divr_ij * dxij + force_divr_ik * dxik;
 
-                        // access the type pair parameters for i and k
-                        typpair_idx = m_typpair_idx(typei, typek);
-                        param_type temp_param
-                            = h_params.data[typpair_idx]; // use this to control the species wich
-                                                          // have to interact
-
-                        // compute dr_ik
-                        Scalar3 dxik = posi - posk;
-                        // apply periodic boundary conditions
-                        dxik = box.minImage(dxik);
-                        // compute rik_sq
-                        Scalar rik_sq = dot(dxik, dxik);
-
-                        // check if k interacts using a temporary evaluator to analyze i-k
-                        // parameters
-                        evaluator temp_eval(rij_sq, rcutsq, temp_param);
-                        temp_eval.setRik(rik_sq);
-                        bool temp_evaluated = temp_eval.areInteractive();
+                            // add the force to particle j (FLOPS: 17)
+                            fj += force_divr_ij * dxij * Scalar(-1.0);
 
-                        // 3 Body interaction ******
-                        if (temp_evaluated)
-                            {
-                            eval.setRik(rik_sq);
-                            // compute the total force and energy
-                            Scalar3 fk = make_scalar3(0.0, 0.0, 0.0);
-                            Scalar3 force_divr_ij_vec = make_scalar3(0.0, 0.0, 0.0);
-                            Scalar3 force_divr_ik_vec = make_scalar3(0.0, 0.0, 0.0);
-                            bool evaluatedk = eval.evalForceik(invratio,
-                                                               invratio2,
-                                                               Scalar(0.0),
-                                                               Scalar(0.0),
-                                                               force_divr_ij_vec,
-                                                               force_divr_ik_vec);
-                            // k interacts with the i-j as an additional third body
-                            if (evaluatedk)
+                            // add the force to particle k
+                            fk += force_divr_ik * dxik * Scalar(-1.0);
+
+                            if (compute_virial)
                                 {
-                                // I stored the modulus of the force in the first component
-                                Scalar force_divr_ij = force_divr_ij_vec.x;
-                                Scalar force_divr_ik = force_divr_ik_vec.x;
-
-                                // add the force to particle i
-                                fi += force_divr_ij * dxij + force_divr_ik * dxik;
-
-                                // add the force to particle j (FLOPS: 17)
-                                fj += force_divr_ij * dxij * Scalar(-1.0);
-
-                                // add the force to particle k
-                                fk += force_divr_ik * dxik * Scalar(-1.0);
-
-                                if (compute_virial)
-                                    {
-                                    //***look at 3 body pressure notes
-                                    // i just need a single term to account for all of the 3 body
-                                    // virial that i decide to store in the i particle's data and i
-                                    // just defined the diagonal component of pressure tensor, I
-                                    // don't know how the off diagonal terms can be included
-                                    virialixx += (force_divr_ij * dxij.x * dxij.x
-                                                  + force_divr_ik * dxik.x * dxik.x);
-                                    virialiyy += (force_divr_ij * dxij.y * dxij.y
-                                                  + force_divr_ik * dxik.y * dxik.y);
-                                    virializz += (force_divr_ij * dxij.z * dxij.z
-                                                  + force_divr_ik * dxik.z * dxik.z);
-                                    virialixy += (force_divr_ij * dxij.x * dxij.y
-                                                  + force_divr_ik * dxik.x * dxik.y);
-                                    virialixz += (force_divr_ij * dxij.x * dxij.z
-                                                  + force_divr_ik * dxik.x * dxik.z);
-                                    virialiyz += (force_divr_ij * dxij.y * dxij.z
-                                                  + force_divr_ik * dxik.y * dxik.z);
-                                    }
-
-                                // increment the force for particle k
-                                unsigned int mem_idx = kk;
-                                h_force.data[mem_idx].x += fk.x;
-                                h_force.data[mem_idx].y += fk.y;
-                                h_force.data[mem_idx].z += fk.z;
+                                //***look at 3 body pressure notes
+                                // i just need a single term to account for all of the 3 body
+                                // virial that i decide to store in the i particle's data and i
+                                // just defined the diagonal component of pressure tensor, I
+                                // don't know how the off diagonal terms can be included
+                                virialixx += (force_divr_ij * dxij.x * dxij.x
+                                              + force_divr_ik * dxik.x * dxik.x);
+                                virialiyy += (force_divr_ij * dxij.y * dxij.y
+                                              + force_divr_ik * dxik.y * dxik.y);
+                                virializz += (force_divr_ij * dxij.z * dxij.z
+                                              + force_divr_ik * dxik.z * dxik.z);
+                                virialixy += (force_divr_ij * dxij.x * dxij.y
+                                              + force_divr_ik * dxik.x * dxik.y);
+                                virialixz += (force_divr_ij * dxij.x * dxij.z
+                                              + force_divr_ik * dxik.x * dxik.z);
+                                virialiyz += (force_divr_ij * dxij.y * dxij.z
+                                              + force_divr_ik * dxik.y * dxik.z);
                                 }
+
+                            // increment the force for particle k
+                            unsigned int mem_idx = kk;
+                            force[mem_idx].x += fk.x;
+                            force[mem_idx].y += fk.y;
+                            force[mem_idx].z += fk.z;
                             }
                         }
                     }
-
-                // increment the force and potential energy for particle j
-                unsigned int mem_idx = jj;
-                h_force.data[mem_idx].x += fj.x;
-                h_force.data[mem_idx].y += fj.y;
-                h_force.data[mem_idx].z += fj.z;
-                h_force.data[mem_idx].w += pej;
                 }
 
-            // finally, increment the force and potential energy for particle i
-            unsigned int mem_idx = i;
-            h_force.data[mem_idx].x += fi.x;
-            h_force.data[mem_idx].y += fi.y;
-            h_force.data[mem_idx].z += fi.z;
-            h_force.data[mem_idx].w += pei;
-
-            // imcrement vir for i
-            if (compute_virial)
-                {
-                h_virial.data[0 * m_virial_pitch + mem_idx] += virialixx;
-                h_virial.data[1 * m_virial_pitch + mem_idx] += virialixy;
-                h_virial.data[2 * m_virial_pitch + mem_idx] += virialixz;
-                h_virial.data[3 * m_virial_pitch + mem_idx] += virialiyy;
-                h_virial.data[4 * m_virial_pitch + mem_idx] += virialiyz;
-                h_virial.data[5 * m_virial_pitch + mem_idx] += virializz;
-                }
+            // increment the force and potential energy for particle j
+            unsigned int mem_idx = jj;
+            force[mem_idx].x += fj.x;
+            force[mem_idx].y += fj.y;
+            force[mem_idx].z += fj.z;
+            force[mem_idx].w += pej;
             }
-        }
-    else
-        {
-        // ****** Tersoff or SquareDensity potential
-        // start by updating the neighborlist
-        m_nlist->compute(timestep);
 
-        // start the profile for this compute
-        if (m_prof)
-            m_prof->push(m_prof_name);
+        // finally, increment the force and potential energy for particle i
+        unsigned int mem_idx = i;
+        force[mem_idx].x += fi.x;
+        force[mem_idx].y += fi.y;
+        force[mem_idx].z += fi.z;
+        force[mem_idx].w += pei;
 
-        // The three-body potentials can't handle a half neighbor list, so check now.
-        bool third_law = m_nlist->getStorageMode() == NeighborList::half;
-        if (third_law)
+        // imcrement vir for i
+        if (compute_virial)
             {
-            m_exec_conf->msg->error()
-                << std::endl
-                << "PotentialTersoff cannot handle a half neighborlist" << std::endl;
-            throw std::runtime_error("Error computing forces in PotentialTersoff");
+            virial[0 * virial_pitch + mem_idx] += virialixx;
+            virial[1 * virial_pitch + mem_idx] += virialixy;
+            virial[2 * virial_pitch + mem_idx] += virialixz;
+            virial[3 * virial_pitch + mem_idx] += virialiyy;
+            virial[4 * virial_pitch + mem_idx] += virialiyz;
+            virial[5 * virial_pitch + mem_idx] += virializz;
             }
+        }
+    }
 
-        // access the neighbor list, particle data, and system box
-        ArrayHandle<unsigned int> h_n_neigh(m_nlist->getNNeighArray(),
-                                            access_location::host,
-                                            access_mode::read);
-        ArrayHandle<unsigned int> h_nlist(m_nlist->getNListArray(),
-                                          access_location::host,
-                                          access_mode::read);
-        ArrayHandle<unsigned int> h_head_list(m_nlist->getHeadList(),
-                                              access_location::host,
-                                              access_mode::read);
-
-        ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(),
-                                   access_location::host,
-                                   access_mode::read);
-
-        // force and virial arrays
-        ArrayHandle<Scalar4> h_force(m_force, access_location::host, access_mode::overwrite);
-        ArrayHandle<Scalar> h_virial(m_virial, access_location::host, access_mode::overwrite);
+//! Compute the Tersoff or SquareDensity forces on a range of local particles
+template<class evaluator>
+void PotentialTersoff<evaluator>::computeTersoffRange(unsigned int begin,
+                                                      unsigned int end,
+                                                      const ForceLoopArgs& args,
+                                                      NeighborScratch& neigh,
+                                                      Scalar4* force,
+                                                      Scalar* virial,
+                                                      size_t virial_pitch)
+    {
+    const bool compute_virial = args.compute_virial;
+    const unsigned int ntypes = args.n_types;
+    neigh.phi_ab.resize(ntypes);
 
-        PDataFlags flags = this->m_pdata->getFlags();
-        bool compute_virial = flags[pdata_flag::pressure_tensor];
+    // for each particle
+    for (unsigned int i = begin; i < end; i++)
+        {
+        // access the particle's type (MEM TRANSFER: 1 scalar)
+        unsigned int typei = __scalar_as_int(args.pos[i].w);
+        // sanity check
+        assert(typei < m_pdata->getNTypes());
+
+        loadNeighbors(i, args, neigh);
+
+        // initialize current force and potential energy of particle i to 0
+        Scalar3 fi = make_scalar3(0.0, 0.0, 0.0);
+        Scalar pei = 0.0;
+
+        Scalar viriali_xx(0.0);
+        Scalar viriali_xy(0.0);
+        Scalar viriali_xz(0.0);
+        Scalar viriali_yy(0.0);
+        Scalar viriali_yz(0.0);
+        Scalar viriali_zz(0.0);
+
+        // reset phi
+        Scalar* phi_ab = neigh.phi_ab.data();
+        for (unsigned int typ_b = 0; typ_b < ntypes; ++typ_b)
+            {
+            phi_ab[typ_b] = Scalar(0.0);
+            }
 
-        const BoxDim& box = m_pdata->getBox();
-        ArrayHandle<Scalar> h_rcutsq(m_rcutsq, access_location::host, access_mode::read);
-        ArrayHandle<param_type> h_params(m_params, access_location::host, access_mode::read);
+        // all neighbors of this particle
+        const unsigned int size = args.n_neigh[i];
+        if (evaluator::hasPerParticleEnergy())
+            {
+            for (unsigned int j = 0; j < size; j++)
+                {
+                unsigned int typej = neigh.type[j];
 
-        // need to start from a zero force, energy
-        memset(h_force.data, 0, sizeof(Scalar4) * (m_pdata->getN() + m_pdata->getNGhosts()));
-        memset(h_virial.data, 0, sizeof(Scalar) * 6 * m_virial_pitch);
+                // get parameters for this type pair
+                unsigned int typpair_idx = m_typpair_idx(typei, typej);
+                param_type param = args.params[typpair_idx];
+                Scalar rcutsq = args.rcutsq[typpair_idx];
 
-        unsigned int ntypes = m_pdata->getNTypes();
+                // evaluate the scalar per-neighbor contribution
+                evaluator eval(neigh.rsq[j], rcutsq, param);
+                eval.evalPhi(phi_ab[typej]);
+                }
 
-        // for each particle
-        for (int i = 0; i < (int)m_pdata->getN(); i++)
-            {
-            // access the particle's position and type (MEM TRANSFER: 4 scalars)
-            Scalar3 posi = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
-            unsigned int typei = __scalar_as_int(h_pos.data[i].w);
-            const unsigned int head_i = h_head_list.data[i];
-            // sanity check
-            assert(typei < m_pdata->getNTypes());
-
-            // initialize current force and potential energy of particle i to 0
-            Scalar3 fi = make_scalar3(0.0, 0.0, 0.0);
-            Scalar pei = 0.0;
-
-            Scalar viriali_xx(0.0);
-            Scalar viriali_xy(0.0);
-            Scalar viriali_xz(0.0);
-            Scalar viriali_yy(0.0);
-            Scalar viriali_yz(0.0);
-            Scalar viriali_zz(0.0);
-
-            Scalar phi_ab[ntypes];
-
-            // reset phi
+            // self-energy
             for (unsigned int typ_b = 0; typ_b < ntypes; ++typ_b)
                 {
-                phi_ab[typ_b] = Scalar(0.0);
+                unsigned int typpair_idx = m_typpair_idx(typei, typ_b);
+                param_type param = args.params[typpair_idx];
+                Scalar rcutsq = args.rcutsq[typpair_idx];
+                evaluator eval(Scalar(0.0), rcutsq, param);
+                Scalar energy(0.0);
+                eval.evalSelfEnergy(energy, phi_ab[typ_b]);
+                pei += energy;
                 }
+            }
 
-            // all neighbors of this particle
-            const unsigned int size = (unsigned int)h_n_neigh.data[i];
-            if (evaluator::hasPerParticleEnergy())
+        // loop over all of the neighbors of this particle
+        for (unsigned int j = 0; j < size; j++)
+            {
+            unsigned int jj = neigh.idx[j];
+            unsigned int typej = neigh.type[j];
+
+            // initialize the current force and potential energy of particle j to 0
+            Scalar3 fj = make_scalar3(0.0, 0.0, 0.0);
+            Scalar pej = 0.0;
+
+            Scalar3 dxij = make_scalar3(neigh.dx[j], neigh.dy[j], neigh.dz[j]);
+            Scalar rij_sq = neigh.rsq[j];
+
+            // get parameters for this type pair
+            unsigned int typpair_idx = m_typpair_idx(typei, typej);
+            param_type param = args.params[typpair_idx];
+            Scalar rcutsq = args.rcutsq[typpair_idx];
+
+            // evaluate the base repulsive and attractive terms
+            Scalar fR = 0.0;
+            Scalar fA = 0.0;
+            evaluator eval(rij_sq, rcutsq, param);
+            bool evaluated = eval.evalRepulsiveAndAttractive(fR, fA);
+
+            Scalar virialj_xx(0.0);
+            Scalar virialj_xy(0.0);
+            Scalar virialj_xz(0.0);
+            Scalar virialj_yy(0.0);
+            Scalar virialj_yz(0.0);
+            Scalar virialj_zz(0.0);
+
+            if (evaluated)
                 {
-                for (unsigned int j = 0; j < size; j++)
+                // the bond angles are shared by the chi and ik force loops
+                if (evaluator::needsAngle() && (evaluator::needsChi() || evaluator::hasIkForce()))
+                    computeAngles(j, neigh);
+
+                // evaluate chi
+                Scalar chi = 0.0;
+                if (evaluator::needsChi())
                     {
-                    // access the index of neighbor j (MEM TRANSFER: 1 scalar)
-                    unsigned int jj = h_nlist.data[head_i + j];
-                    assert(jj < m_pdata->getN() + m_pdata->getNGhosts());
+                    for (unsigned int k = 0; k < size; k++)
+                        {
+                        unsigned int kk = neigh.idx[k];
 
-                    // access the position and type of particle j
-                    Scalar3 posj
-                        = make_scalar3(h_pos.data[jj].x, h_pos.data[jj].y, h_pos.data[jj].z);
-                    unsigned int typej = __scalar_as_int(h_pos.data[jj].w);
-                    assert(typej < m_pdata->getNTypes());
+                        // access the type pair parameters for i and k
+                        typpair_idx = m_typpair_idx(typei, neigh.type[k]);
+                        param_type temp_param = args.params[typpair_idx];
 
-                    // calculate dr_ij (MEM TRANSFER: 3 scalars / FLOPS: 3)
-                    Scalar3 dxij = posi - posj;
+                        evaluator temp_eval(rij_sq, rcutsq, temp_param);
+                        bool temp_evaluated = temp_eval.areInteractive();
 
-                    // apply periodic boundary conditions
-                    dxij = box.minImage(dxij);
+                        if (kk != jj && temp_evaluated)
+                            {
+                            // evaluate the partial chi term
+                            eval.setRik(neigh.rsq[k]);
+                            if (evaluator::needsAngle())
+                                eval.setAngle(neigh.cos_th[k]);
 
-                    // compute rij_sq (FLOPS: 5)
-                    Scalar rij_sq = dot(dxij, dxij);
+                            eval.evalChi(chi);
+                            }
+                        }
+                    }
 
-                    // get parameters for this type pair
-                    unsigned int typpair_idx = m_typpair_idx(typei, typej);
-                    param_type param = h_params.data[typpair_idx];
-                    Scalar rcutsq = h_rcutsq.data[typpair_idx];
+                // evaluate the force and energy from the ij interaction
+                Scalar force_divr = Scalar(0.0);
+                Scalar potential_eng = Scalar(0.0);
+                Scalar bij = Scalar(0.0);
+                eval.evalForceij(fR, fA, chi, phi_ab[typej], bij, force_divr, potential_eng);
 
-                    // evaluate the scalar per-neighbor contribution
-                    evaluator eval(rij_sq, rcutsq, param);
-                    eval.evalPhi(phi_ab[typej]);
-                    }
+                // add this force to particle i
+                fi += force_divr * dxij;
+                pei += potential_eng * Scalar(0.5);
 
-                // self-energy
-                for (unsigned int typ_b = 0; typ_b < ntypes; ++typ_b)
+                if (compute_virial)
                     {
-                    unsigned int typpair_idx = m_typpair_idx(typei, typ_b);
-                    param_type param = h_params.data[typpair_idx];
-                    Scalar rcutsq = h_rcutsq.data[typpair_idx];
-                    evaluator eval(Scalar(0.0), rcutsq, param);
-                    Scalar energy(0.0);
-                    eval.evalSelfEnergy(energy, phi_ab[typ_b]);
-                    pei += energy;
+                    Scalar force_div2r = Scalar(0.5) * force_divr;
+
+                    viriali_xx += force_div2r * dxij.x * dxij.x;
+                    viriali_xy += force_div2r * dxij.x * dxij.y;
+                    viriali_xz += force_div2r * dxij.x * dxij.z;
+                    viriali_yy += force_div2r * dxij.y * dxij.y;
+                    viriali_yz += force_div2r * dxij.y * dxij.z;
+                    viriali_zz += force_div2r * dxij.z * dxij.z;
                     }
-                }
-
-            // loop over all of the neighbors of this particle
-            for (unsigned int j = 0; j < size; j++)
-                {
-                // access the index of neighbor j (MEM TRANSFER: 1 scalar)
-                unsigned int jj = h_nlist.data[head_i + j];
-                assert(jj < m_pdata->getN() + m_pdata->getNGhosts());
-
-                // access the position and type of particle j
-                Scalar3 posj = make_scalar3(h_pos.data[jj].x, h_pos.data[jj].y, h_pos.data[jj].z);
-                unsigned int typej = __scalar_as_int(h_pos.data[jj].w);
-                assert(typej < m_pdata->getNTypes());
-
-                // initialize the current force and potential energy of particle j to 0
-                Scalar3 fj = make_scalar3(0.0, 0.0, 0.0);
-                Scalar pej = 0.0;
 
-                // calculate dr_ij (MEM TRANSFER: 3 scalars / FLOPS: 3)
-                Scalar3 dxij = posi - posj;
+                // add this force to particle j
+                fj += Scalar(-1.0) * force_divr * dxij;
+                pej += potential_eng * Scalar(0.5);
 
-                // apply periodic boundary conditions
-                dxij = box.minImage(dxij);
-
-                // compute rij_sq (FLOPS: 5)
-                Scalar rij_sq = dot(dxij, dxij);
+                if (compute_virial)
+                    {
+                    Scalar force_div2r = Scalar(0.5) * force_divr;
+
+                    virialj_xx += force_div2r * dxij.x * dxij.x;
+                    virialj_xy += force_div2r * dxij.x * dxij.y;
+                    virialj_xz += force_div2r * dxij.x * dxij.z;
+                    virialj_yy += force_div2r * dxij.y * dxij.y;
+                    virialj_yz += force_div2r * dxij.y * dxij.z;
+                    virialj_zz += force_div2r * dxij.z * dxij.z;
+                    }
 
-                // get parameters for this type pair
-                unsigned int typpair_idx = m_typpair_idx(typei, typej);
-                param_type param = h_params.data[typpair_idx];
-                Scalar rcutsq = h_rcutsq.data[typpair_idx];
-
-                // evaluate the base repulsive and attractive terms
-                Scalar fR = 0.0;
-                Scalar fA = 0.0;
-                evaluator eval(rij_sq, rcutsq, param);
-                bool evaluated = eval.evalRepulsiveAndAttractive(fR, fA);
-
-                Scalar virialj_xx(0.0);
-                Scalar virialj_xy(0.0);
-                Scalar virialj_xz(0.0);
-                Scalar virialj_yy(0.0);
-                Scalar virialj_yz(0.0);
-                Scalar virialj_zz(0.0);
-
-                if (evaluated)
+                if (evaluator::hasIkForce())
                     {
-                    // evaluate chi
-                    Scalar chi = 0.0;
-                    if (evaluator::needsChi())
+                    // evaluate the force from the ik interactions
+                    for (unsigned int k = 0; k < size; k++)
                         {
-                        for (unsigned int k = 0; k < size; k++)
-                            {
-                            // access the index of neighbor k
-                            unsigned int kk = h_nlist.data[head_i + k];
-                            assert(kk < m_pdata->getN());
-
-                            // access the position and type of neighbor k
-                            Scalar3 posk = make_scalar3(h_pos.data[kk].x,
-                                                        h_pos.data[kk].y,
-                                                        h_pos.data[kk].z);
-                            unsigned int typek = __scalar_as_int(h_pos.data[kk].w);
-                            assert(typek < m_pdata->getNTypes());
-
-                            // access the type pair parameters for i and k
-                            typpair_idx = m_typpair_idx(typei, typek);
-                            param_type temp_param = h_params.data[typpair_idx];
-
-                            evaluator temp_eval(rij_sq, rcutsq, temp_param);
-                            bool temp_evaluated = temp_eval.areInteractive();
+                        unsigned int kk = neigh.idx[k];
 
-                            if (kk != jj && temp_evaluated)
-                                {
-                                // compute drik
-                                Scalar3 dxik = posi - posk;
+                        // access the type pair parameters for i and k
+                        typpair_idx = m_typpair_idx(typei, neigh.type[k]);
+                        param_type temp_param = args.params[typpair_idx];
 
-                                // apply periodic boundary conditions
-                                dxik = box.minImage(dxik);
+                        evaluator temp_eval(rij_sq, rcutsq, temp_param);
+                        bool temp_evaluated = temp_eval.areInteractive();
 
-                                // compute rik_sq
-                                Scalar rik_sq = dot(dxik, dxik);
+                        if (kk != jj && temp_evaluated)
+                            {
+                            // create variable for the force on k
+                            Scalar3 fk = make_scalar3(0.0, 0.0, 0.0);
 
-                                // compute the bond angle (if needed)
-                                Scalar cos_th = Scalar(0.0);
-                                if (evaluator::needsAngle())
-                                    cos_th = dot(dxij, dxik) / fast::sqrt(rij_sq * rik_sq);
+                            Scalar3 dxik = make_scalar3(neigh.dx[k], neigh.dy[k], neigh.dz[k]);
 
-                                // evaluate the partial chi term
-                                eval.setRik(rik_sq);
-                                if (evaluator::needsAngle())
-                                    eval.setAngle(cos_th);
+                            // set up the evaluator
+                            eval.setRik(neigh.rsq[k]);
+                            if (evaluator::needsAngle())
+                                eval.setAngle(neigh.cos_th[k]);
 
-                                eval.evalChi(chi);
+                            // compute the total force and energy
+                            Scalar3 force_divr_ij = make_scalar3(0.0, 0.0, 0.0);
+                            Scalar3 force_divr_ik = make_scalar3(0.0, 0.0, 0.0);
+                            eval.evalForceik(fR, fA, chi, bij, force_divr_ij, force_divr_ik);
+
+                            // add the force to particle i
+                            // (FLOPS: 17)
+                            fi.x += force_divr_ij.x * dxij.x + force_divr_ik.x * dxik.x;
+                            fi.y += force_divr_ij.x * dxij.y + force_divr_ik.x * dxik.y;
+                            fi.z += force_divr_ij.x * dxij.z + force_divr_ik.x * dxik.z;
+
+                            // NOTE: virial for ik forces not tested
+                            if (compute_virial)
+                                {
+                                Scalar force_div2r_ij = Scalar(0.5) * force_divr_ij.x;
+                                Scalar force_div2r_ik = Scalar(0.5) * force_divr_ik.x;
+                                viriali_xx += force_div2r_ij * dxij.x * dxij.x
+                                              + force_div2r_ik * dxik.x * dxik.x;
+                                viriali_xy += force_div2r_ij * dxij.x * dxij.y
+                                              + force_div2r_ik * dxik.x * dxik.y;
+                                viriali_xz += force_div2r_ij * dxij.x * dxij.z
+                                              + force_div2r_ik * dxik.x * dxik.z;
+                                viriali_yy += force_div2r_ij * dxij.y * dxij.y
+                                              + force_div2r_ik * dxik.y * dxik.y;
+                                viriali_yz += force_div2r_ij * dxij.y * dxij.z
+                                              + force_div2r_ik * dxik.y * dxik.z;
+                                viriali_zz += force_div2r_ij * dxij.z * dxij.z
+                                              + force_div2r_ik * dxik.z * dxik.z;
                                 }
-                            }
-                        }
-
-                    // evaluate the force and energy from the ij interaction
-                    Scalar force_divr = Scalar(0.0);
-                    Scalar potential_eng = Scalar(0.0);
-                    Scalar bij = Scalar(0.0);
-                    eval.evalForceij(fR, fA, chi, phi_ab[typej], bij, force_divr, potential_eng);
 
-                    // add this force to particle i
-                    fi += force_divr * dxij;
-                    pei += potential_eng * Scalar(0.5);
+                            // add the force to particle j (FLOPS: 17)
+                            fj.x += force_divr_ij.y * dxij.x + force_divr_ik.y * dxik.x;
+                            fj.y += force_divr_ij.y * dxij.y + force_divr_ik.y * dxik.y;
+                            fj.z += force_divr_ij.y * dxij.z + force_divr_ik.y * dxik.z;
 
-                    if (compute_virial)
-                        {
-                        Scalar force_div2r = Scalar(0.5) * force_divr;
-
-                        viriali_xx += force_div2r * dxij.x * dxij.x;
-                        viriali_xy += force_div2r * dxij.x * dxij.y;
-                        viriali_xz += force_div2r * dxij.x * dxij.z;
-                        viriali_yy += force_div2r * dxij.y * dxij.y;
-                        viriali_yz += force_div2r * dxij.y * dxij.z;
-                        viriali_zz += force_div2r * dxij.z * dxij.z;
-                        }
-
-                    // add this force to particle j
-                    fj += Scalar(-1.0) * force_divr * dxij;
-                    pej += potential_eng * Scalar(0.5);
-
-                    if (compute_virial)
-                        {
-                        Scalar force_div2r = Scalar(0.5) * force_divr;
-
-                        virialj_xx += force_div2r * dxij.x * dxij.x;
-                        virialj_xy += force_div2r * dxij.x * dxij.y;
-                        virialj_xz += force_div2r * dxij.x * dxij.z;
-                        virialj_yy += force_div2r * dxij.y * dxij.y;
-                        virialj_yz += force_div2r * dxij.y * dxij.z;
-                        virialj_zz += force_div2r * dxij.z * dxij.z;
-                        }
-
-                    if (evaluator::hasIkForce())
-                        {
-                        // evaluate the force from the ik interactions
-                        for (unsigned int k = 0; k < size; k++)
-                            {
-                            // access the index of neighbor k
-                            unsigned int kk = h_nlist.data[head_i + k];
-                            assert(kk < m_pdata->getN());
-
-                            // access the position and type of neighbor k
-                            Scalar3 posk = make_scalar3(h_pos.data[kk].x,
-                                                        h_pos.data[kk].y,
-                                                        h_pos.data[kk].z);
-                            unsigned int typek = __scalar_as_int(h_pos.data[kk].w);
-                            assert(typek < m_pdata->getNTypes());
+                            // NOTE: virial for ik forces not tested
+                            if (compute_virial)
+                                {
+                                Scalar force_div2r_ij = Scalar(0.5) * force_divr_ij.y;
+                                Scalar force_div2r_ik = Scalar(0.5) * force_divr_ik.y;
+                                virialj_xx += force_div2r_ij * dxij.x * dxij.x
+                                              + force_div2r_ik * dxik.x * dxik.x;
+                                virialj_xy += force_div2r_ij * dxij.x * dxij.y
+                                              + force_div2r_ik * dxik.x * dxik.y;
+                                virialj_xz += force_div2r_ij * dxij.x * dxij.z
+                                              + force_div2r_ik * dxik.x * dxik.z;
+                                virialj_yy += force_div2r_ij * dxij.y * dxij.y
+                                              + force_div2r_ik * dxik.y * dxik.y;
+                                virialj_yz += force_div2r_ij * dxij.y * dxij.z
+                                              + force_div2r_ik * dxik.y * dxik.z;
+                                virialj_zz += force_div2r_ij * dxij.z * dxij.z
+                                              + force_div2r_ik * dxik.z * dxik.z;
+                                }
 
-                            // access the type pair parameters for i and k
-                            typpair_idx = m_typpair_idx(typei, typek);
-                            param_type temp_param = h_params.data[typpair_idx];
+                            // add the force to particle k
+                            fk.x += force_divr_ij.z * dxij.x + force_divr_ik.z * dxik.x;
+                            fk.y += force_divr_ij.z * dxij.y + force_divr_ik.z * dxik.y;
+                            fk.z += force_divr_ij.z * dxij.z + force_divr_ik.z * dxik.z;
 
-                            evaluator temp_eval(rij_sq, rcutsq, temp_param);
-                            bool temp_evaluated = temp_eval.areInteractive();
+                            // increment the force for particle k
+                            unsigned int mem_idx = kk;
+                            force[mem_idx].x += fk.x;
+                            force[mem_idx].y += fk.y;
+                            force[mem_idx].z += fk.z;
 
-                            if (kk != jj && temp_evaluated)
+                            if (compute_virial)
                                 {
-                                // create variable for the force on k
-                                Scalar3 fk = make_scalar3(0.0, 0.0, 0.0);
-
-                                // compute dr_ik
-                                Scalar3 dxik = posi - posk;
-
-                                // apply periodic boundary conditions
-                                dxik = box.minImage(dxik);
-
-                                // compute rik_sq
-                                Scalar rik_sq = dot(dxik, dxik);
-
-                                // compute the bond angle (if needed)
-                                Scalar cos_th = Scalar(0.0);
-                                if (evaluator::needsAngle())
-                                    cos_th = dot(dxij, dxik) / sqrt(rij_sq * rik_sq);
-
-                                // set up the evaluator
-                                eval.setRik(rik_sq);
-                                if (evaluator::needsAngle())
-                                    eval.setAngle(cos_th);
-
-                                // compute the total force and energy
-                                Scalar3 force_divr_ij = make_scalar3(0.0, 0.0, 0.0);
-                                Scalar3 force_divr_ik = make_scalar3(0.0, 0.0, 0.0);
-                                eval.evalForceik(fR, fA, chi, bij, force_divr_ij, force_divr_ik);
-
-                                // add the force to particle i
-                                // (FLOPS: 17)
-                                fi.x += force_divr_ij.x * dxij.x + force_divr_ik.x * dxik.x;
-                                fi.y += force_divr_ij.x * dxij.y + force_divr_ik.x * dxik.y;
-                                fi.z += force_divr_ij.x * dxij.z + force_divr_ik.x * dxik.z;
-
-                                // NOTE: virial for ik forces not tested
-                                if (compute_virial)
-                                    {
-                                    Scalar force_div2r_ij = Scalar(0.5) * force_divr_ij.x;
-                                    Scalar force_div2r_ik = Scalar(0.5) * force_divr_ik.x;
-                                    viriali_xx += force_div2r_ij * dxij.x * dxij.x
-                                                  + force_div2r_ik * dxik.x * dxik.x;
-                                    viriali_xy += force_div2r_ij * dxij.x * dxij.y
-                                                  + force_div2r_ik * dxik.x * dxik.y;
-                                    viriali_xz += force_div2r_ij * dxij.x * dxij.z
-                                                  + force_div2r_ik * dxik.x * dxik.z;
-                                    viriali_yy += force_div2r_ij * dxij.y * dxij.y
-                                                  + force_div2r_ik * dxik.y * dxik.y;
-                                    viriali_yz += force_div2r_ij * dxij.y * dxij.z
-                                                  + force_div2r_ik * dxik.y * dxik.z;
-                                    viriali_zz += force_div2r_ij * dxij.z * dxij.z
-                                                  + force_div2r_ik * dxik.z * dxik.z;
-                                    }
-
-                                // add the force to particle j (FLOPS: 17)
-                                fj.x += force_divr_ij.y * dxij.x + force_divr_ik.y * dxik.x;
-                                fj.y += force_divr_ij.y * dxij.y + force_divr_ik.y * dxik.y;
-                                fj.z += force_divr_ij.y * dxij.z + force_divr_ik.y * dxik.z;
-
-                                // NOTE: virial for ik forces not tested
-                                if (compute_virial)
-                                    {
-                                    Scalar force_div2r_ij = Scalar(0.5) * force_divr_ij.y;
-                                    Scalar force_div2r_ik = Scalar(0.5) * force_divr_ik.y;
-                                    virialj_xx += force_div2r_ij * dxij.x * dxij.x
-                                                  + force_div2r_ik * dxik.x * dxik.x;
-                                    virialj_xy += force_div2r_ij * dxij.x * dxij.y
-                                                  + force_div2r_ik * dxik.x * dxik.y;
-                                    virialj_xz += force_div2r_ij * dxij.x * dxij.z
-                                                  + force_div2r_ik * dxik.x * dxik.z;
-                                    virialj_yy += force_div2r_ij * dxij.y * dxij.y
-                                                  + force_div2r_ik * dxik.y * dxik.y;
-                                    virialj_yz += force_div2r_ij * dxij.y * dxij.z
-                                                  + force_div2r_ik * dxik.y * dxik.z;
-                                    virialj_zz += force_div2r_ij * dxij.z * dxij.z
-                                                  + force_div2r_ik * dxik.z * dxik.z;
-                                    }
-
-                                // add the force to particle k
-                                fk.x += force_divr_ij.z * dxij.x + force_divr_ik.z * dxik.x;
-                                fk.y += force_divr_ij.z * dxij.y + force_divr_ik.z * dxik.y;
-                                fk.z += force_divr_ij.z * dxij.z + force_divr_ik.z * dxik.z;
-
-                                // increment the force for particle k
-                                unsigned int mem_idx = kk;
-                                h_force.data[mem_idx].x += fk.x;
-                                h_force.data[mem_idx].y += fk.y;
-                                h_force.data[mem_idx].z += fk.z;
-
-                                if (compute_virial)
-                                    {
-                                    Scalar force_div2r_ij = Scalar(0.5) * force_divr_ij.z;
-                                    Scalar force_div2r_ik = Scalar(0.5) * force_divr_ik.z;
-                                    h_virial.data[0 * m_virial_pitch + mem_idx]
-                                        += force_div2r_ij * dxij.x * dxij.x
-                                           + force_div2r_ik * dxik.x * dxik.x;
-                                    h_virial.data[1 * m_virial_pitch + mem_idx]
-                                        += force_div2r_ij * dxij.x * dxij.y
-                                           + force_div2r_ik * dxik.x * dxik.y;
-                                    h_virial.data[2 * m_virial_pitch + mem_idx]
-                                        += force_div2r_ij * dxij.x * dxij.z
-                                           + force_div2r_ik * dxik.x * dxik.z;
-                                    h_virial.data[3 * m_virial_pitch + mem_idx]
-                                        += force_div2r_ij * dxij.y * dxij.y
-                                           + force_div2r_ik * dxik.y * dxik.y;
-                                    h_virial.data[4 * m_virial_pitch + mem_idx]
-                                        += force_div2r_ij * dxij.y * dxij.z
-                                           + force_div2r_ik * dxik.y * dxik.z;
-                                    h_virial.data[5 * m_virial_pitch + mem_idx]
-                                        += force_div2r_ij * dxij.z * dxij.z
-                                           + force_div2r_ik * dxik.z * dxik.z;
-                                    }
+                                Scalar force_div2r_ij = Scalar(0.5) * force_divr_ij.z;
+                                Scalar force_div2r_ik = Scalar(0.5) * force_divr_ik.z;
+                                virial[0 * virial_pitch + mem_idx]
+                                    += force_div2r_ij * dxij.x * dxij.x
+                                       + force_div2r_ik * dxik.x * dxik.x;
+                                virial[1 * virial_pitch + mem_idx]
+                                    += force_div2r_ij * dxij.x * dxij.y
+                                       + force_div2r_ik * dxik.x * dxik.y;
+                                virial[2 * virial_pitch + mem_idx]
+                                    += force_div2r_ij * dxij.x * dxij.z
+                                       + force_div2r_ik * dxik.x * dxik.z;
+                                virial[3 * virial_pitch + mem_idx]
+                                    += force_div2r_ij * dxij.y * dxij.y
+                                       + force_div2r_ik * dxik.y * dxik.y;
+                                virial[4 * virial_pitch + mem_idx]
+                                    += force_div2r_ij * dxij.y * dxij.z
+                                       + force_div2r_ik * dxik.y * dxik.z;
+                                virial[5 * virial_pitch + mem_idx]
+                                    += force_div2r_ij * dxij.z * dxij.z
+                                       + force_div2r_ik * dxik.z * dxik.z;
                                 }
                             }
                         }
                     }
-                // increment the force and potential energy for particle j
-                unsigned int mem_idx = jj;
-                h_force.data[mem_idx].x += fj.x;
-                h_force.data[mem_idx].y += fj.y;
-                h_force.data[mem_idx].z += fj.z;
-                h_force.data[mem_idx].w += pej;
-
-                if (compute_virial)
-                    {
-                    h_virial.data[0 * m_virial_pitch + mem_idx] += virialj_xx;
-                    h_virial.data[1 * m_virial_pitch + mem_idx] += virialj_xy;
-                    h_virial.data[2 * m_virial_pitch + mem_idx] += virialj_xz;
-                    h_virial.data[3 * m_virial_pitch + mem_idx] += virialj_yy;
-                    h_virial.data[4 * m_virial_pitch + mem_idx] += virialj_yz;
-                    h_virial.data[5 * m_virial_pitch + mem_idx] += virialj_zz;
-                    }
                 }
-            // finally, increment the force and potential energy for particle i
-            unsigned int mem_idx = i;
-            h_force.data[mem_idx].x += fi.x;
-            h_force.data[mem_idx].y += fi.y;
-            h_force.data[mem_idx].z += fi.z;
-            h_force.data[mem_idx].w += pei;
+            // increment the force and potential energy for particle j
+            unsigned int mem_idx = jj;
+            force[mem_idx].x += fj.x;
+            force[mem_idx].y += fj.y;
+            force[mem_idx].z += fj.z;
+            force[mem_idx].w += pej;
 
             if (compute_virial)
                 {
-                h_virial.data[0 * m_virial_pitch + mem_idx] += viriali_xx;
-                h_virial.data[1 * m_virial_pitch + mem_idx] += viriali_xy;
-                h_virial.data[2 * m_virial_pitch + mem_idx] += viriali_xz;
-                h_virial.data[3 * m_virial_pitch + mem_idx] += viriali_yy;
-                h_virial.data[4 * m_virial_pitch + mem_idx] += viriali_yz;
-                h_virial.data[5 * m_virial_pitch + mem_idx] += viriali_zz;
+                virial[0 * virial_pitch + mem_idx] += virialj_xx;
+                virial[1 * virial_pitch + mem_idx] += virialj_xy;
+                virial[2 * virial_pitch + mem_idx] += virialj_xz;
+                virial[3 * virial_pitch + mem_idx] += virialj_yy;
+                virial[4 * virial_pitch + mem_idx] += virialj_yz;
+                virial[5 * virial_pitch + mem_idx] += virialj_zz;
                 }
             }
+        // finally, increment the force and potential energy for particle i
+        unsigned int mem_idx = i;
+        force[mem_idx].x += fi.x;
+        force[mem_idx].y += fi.y;
+        force[mem_idx].z += fi.z;
+        force[mem_idx].w += pei;
+
+        if (compute_virial)
+            {
+            virial[0 * virial_pitch + mem_idx] += viriali_xx;
+            virial[1 * virial_pitch + mem_idx] += viriali_xy;
+            virial[2 * virial_pitch + mem_idx] += viriali_xz;
+            virial[3 * virial_pitch + mem_idx] += viriali_yy;
+            virial[4 * virial_pitch + mem_idx] += viriali_yz;
+            virial[5 * virial_pitch + mem_idx] += viriali_zz;
+            }
         }
-
-    if (m_prof)
-        m_prof->pop();
     }
 
 #ifdef ENABLE_MPI
@@ -81,7 +81,7 @@ PotentialTersoffGPU<evaluator, gpu_cgpf>::PotentialTersoffGPU(
         }
 
     // initialize autotuner
-    // the full block size and threads_per_particle matrix is searched,
+    // the block size and threads_per_particle matrix is searched with coordinate descent,
     // encoded as block_size*10000 + threads_per_particle
     unsigned int warp_size = this->m_exec_conf->dev_prop.warpSize;
     unsigned int max_tpp = warp_size;
@@ -99,6 +99,7 @@ PotentialTersoffGPU<evaluator, gpu_cgpf>::PotentialTersoffGPU(
         }
 
     m_tuner.reset(new Autotuner(valid_params, 5, 100000, "pair_tersoff", this->m_exec_conf));
+    m_tuner->setDimensions({10000, 1});
     }
 
 template<class evaluator,
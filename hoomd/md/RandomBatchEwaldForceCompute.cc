@@ -0,0 +1,491 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "RandomBatchEwaldForceCompute.h"
+#include "PPPMForceCompute.h"
+#include "hoomd/RNGIdentifiers.h"
+#include "hoomd/RandomNumbers.h"
+
+#ifdef ENABLE_MPI
+#include "hoomd/HOOMDMPI.h"
+#endif
+
+#include <algorithm>
+
+namespace py = pybind11;
+
+/*! \file RandomBatchEwaldForceCompute.cc
+    \brief Contains code for the RandomBatchEwaldForceCompute class
+*/
+
+/*! \param sysdef The system definition
+    \param nlist Neighbor list, used to correct for excluded pairs
+    \param group Group of charged particles
+ */
+RandomBatchEwaldForceCompute::RandomBatchEwaldForceCompute(
+    std::shared_ptr<SystemDefinition> sysdef,
+    std::shared_ptr<NeighborList> nlist,
+    std::shared_ptr<ParticleGroup> group)
+    : ForceCompute(sysdef), m_nlist(nlist), m_group(group), m_kappa(0.0), m_batch_size(0),
+      m_alpha(0.0), m_params_set(false), m_need_initialize(true), m_box_changed(true),
+      m_norm(0.0), m_q2(0.0)
+    {
+    m_exec_conf->msg->notice(5) << "Constructing RandomBatchEwaldForceCompute" << std::endl;
+
+    m_pdata->getBoxChangeSignal()
+        .connect<RandomBatchEwaldForceCompute, &RandomBatchEwaldForceCompute::setBoxChange>(this);
+    m_pdata->getGlobalParticleNumberChangeSignal()
+        .connect<RandomBatchEwaldForceCompute,
+                 &RandomBatchEwaldForceCompute::slotGlobalParticleNumberChange>(this);
+
+    // reset virial
+    ArrayHandle<Scalar> h_virial(m_virial, access_location::host, access_mode::overwrite);
+    memset(h_virial.data, 0, sizeof(Scalar) * m_virial.getNumElements());
+    }
+
+RandomBatchEwaldForceCompute::~RandomBatchEwaldForceCompute()
+    {
+    m_exec_conf->msg->notice(5) << "Destroying RandomBatchEwaldForceCompute" << std::endl;
+
+    m_pdata->getBoxChangeSignal()
+        .disconnect<RandomBatchEwaldForceCompute, &RandomBatchEwaldForceCompute::setBoxChange>(
+            this);
+    m_pdata->getGlobalParticleNumberChangeSignal()
+        .disconnect<RandomBatchEwaldForceCompute,
+                    &RandomBatchEwaldForceCompute::slotGlobalParticleNumberChange>(this);
+    }
+
+/*! \param kappa Splitting parameter between the real space and the reciprocal space terms
+    \param batch_size Number of wave vectors sampled per time step
+    \param alpha Debye screening parameter
+ */
+void RandomBatchEwaldForceCompute::setParams(Scalar kappa, unsigned int batch_size, Scalar alpha)
+    {
+    if (kappa <= Scalar(0.0))
+        {
+        throw std::domain_error("kappa must be positive.");
+        }
+    if (batch_size == 0)
+        {
+        throw std::domain_error("batch_size must be positive.");
+        }
+    if (m_sysdef->getNDimensions() != 3)
+        {
+        throw std::runtime_error("The random batch Ewald method requires a 3D system.");
+        }
+
+    m_kappa = kappa;
+    m_batch_size = batch_size;
+    m_alpha = alpha;
+
+    m_k.resize(m_batch_size);
+    m_coeff.resize(m_batch_size);
+    m_rho.resize(2 * m_batch_size);
+
+    m_params_set = true;
+    m_box_changed = true;
+    }
+
+/*! Tabulate the cumulative distribution of the Miller index along every reciprocal lattice
+    vector b_i, such that P(n_i) is proportional to exp(-(n_i |b_i|)^2 / (4 kappa^2)). Weights
+    smaller than exp(-36) are dropped.
+ */
+void RandomBatchEwaldForceCompute::setupDistribution()
+    {
+    const BoxDim& global_box = m_pdata->getGlobalBox();
+
+    // compute reciprocal lattice vectors
+    Scalar3 a1 = global_box.getLatticeVector(0);
+    Scalar3 a2 = global_box.getLatticeVector(1);
+    Scalar3 a3 = global_box.getLatticeVector(2);
+
+    Scalar V_box = global_box.getVolume();
+    m_b[0] = Scalar(2.0 * M_PI)
+             * make_scalar3(a2.y * a3.z - a2.z * a3.y,
+                            a2.z * a3.x - a2.x * a3.z,
+                            a2.x * a3.y - a2.y * a3.x)
+             / V_box;
+    m_b[1] = Scalar(2.0 * M_PI)
+             * make_scalar3(a3.y * a1.z - a3.z * a1.y,
+                            a3.z * a1.x - a3.x * a1.z,
+                            a3.x * a1.y - a3.y * a1.x)
+             / V_box;
+    m_b[2] = Scalar(2.0 * M_PI)
+             * make_scalar3(a1.y * a2.z - a1.z * a2.y,
+                            a1.z * a2.x - a1.x * a2.z,
+                            a1.x * a2.y - a1.y * a2.x)
+             / V_box;
+
+    m_norm = Scalar(1.0);
+    for (unsigned int i = 0; i < 3; ++i)
+        {
+        Scalar b = slow::sqrt(dot(m_b[i], m_b[i]));
+        m_max_mode[i] = (int)ceil(Scalar(12.0) * m_kappa / b);
+
+        m_cdf[i].resize(2 * m_max_mode[i] + 1);
+        Scalar sum(0.0);
+        for (int n = -m_max_mode[i]; n <= m_max_mode[i]; ++n)
+            {
+            Scalar x = Scalar(n) * b / (Scalar(2.0) * m_kappa);
+            sum += exp(-x * x);
+            m_cdf[i][n + m_max_mode[i]] = sum;
+            }
+
+        for (auto& p : m_cdf[i])
+            p /= sum;
+
+        m_norm *= sum;
+        }
+
+    // remove the k = 0 term, which has unit weight
+    m_norm -= Scalar(1.0);
+    }
+
+/*! \param timestep Current time step
+
+    All ranks use the same random number stream, such that they draw the same wave vectors. Every
+    wave vector is stored together with its coefficient in the estimate of the reciprocal space
+    energy, U = sum_l m_coeff[l] |rho(k_l)|^2.
+ */
+void RandomBatchEwaldForceCompute::sampleWaveVectors(uint64_t timestep)
+    {
+    uint16_t seed = m_sysdef->getSeed();
+    hoomd::RandomGenerator rng(
+        hoomd::Seed(hoomd::RNGIdentifier::RandomBatchEwald, timestep, seed),
+        hoomd::Counter());
+    hoomd::UniformDistribution<Scalar> uniform(Scalar(0.0), Scalar(1.0));
+
+    Scalar V = m_pdata->getGlobalBox().getVolume();
+    Scalar alphasq = m_alpha * m_alpha;
+    Scalar inv_4kappasq = Scalar(0.25) / (m_kappa * m_kappa);
+    Scalar prefactor
+        = Scalar(2.0 * M_PI) / V * m_norm / Scalar(m_batch_size) * exp(-alphasq * inv_4kappasq);
+
+    for (unsigned int l = 0; l < m_batch_size; ++l)
+        {
+        int n[3];
+        do
+            {
+            for (unsigned int i = 0; i < 3; ++i)
+                {
+                Scalar u = uniform(rng);
+                n[i] = int(std::upper_bound(m_cdf[i].begin(), m_cdf[i].end() - 1, u)
+                           - m_cdf[i].begin())
+                       - m_max_mode[i];
+                }
+            } while (n[0] == 0 && n[1] == 0 && n[2] == 0);
+
+        Scalar3 k = Scalar(n[0]) * m_b[0] + Scalar(n[1]) * m_b[1] + Scalar(n[2]) * m_b[2];
+        Scalar ksq = dot(k, k);
+
+        // ratio of the true weight to the sampling weight, unity for orthorhombic boxes
+        Scalar sample_ksq(0.0);
+        for (unsigned int i = 0; i < 3; ++i)
+            sample_ksq += Scalar(n[i] * n[i]) * dot(m_b[i], m_b[i]);
+
+        m_k[l] = k;
+        m_coeff[l] = prefactor * exp(-(ksq - sample_ksq) * inv_4kappasq) / (ksq + alphasq);
+        }
+    }
+
+void RandomBatchEwaldForceCompute::computeStructureFactor()
+    {
+    ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_charge(m_pdata->getCharges(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_group_members(m_group->getIndexArray(),
+                                              access_location::host,
+                                              access_mode::read);
+
+    std::fill(m_rho.begin(), m_rho.end(), Scalar(0.0));
+
+    unsigned int group_size = m_group->getNumMembers();
+    for (unsigned int group_idx = 0; group_idx < group_size; ++group_idx)
+        {
+        unsigned int j = h_group_members.data[group_idx];
+        Scalar qj = h_charge.data[j];
+        if (qj == Scalar(0.0))
+            continue;
+
+        Scalar3 r = make_scalar3(h_pos.data[j].x, h_pos.data[j].y, h_pos.data[j].z);
+        for (unsigned int l = 0; l < m_batch_size; ++l)
+            {
+            Scalar s, c;
+            fast::sincos(dot(m_k[l], r), s, c);
+            m_rho[2 * l] += qj * c;
+            m_rho[2 * l + 1] += qj * s;
+            }
+        }
+
+#ifdef ENABLE_MPI
+    if (m_pdata->getDomainDecomposition())
+        {
+        MPI_Allreduce(MPI_IN_PLACE,
+                      &m_rho[0],
+                      (int)m_rho.size(),
+                      MPI_HOOMD_SCALAR,
+                      MPI_SUM,
+                      m_exec_conf->getMPICommunicator());
+        }
+#endif
+    }
+
+void RandomBatchEwaldForceCompute::computeReciprocalForces()
+    {
+    ArrayHandle<Scalar4> h_force(m_force, access_location::host, access_mode::overwrite);
+    ArrayHandle<Scalar4> h_torque(m_torque, access_location::host, access_mode::overwrite);
+    ArrayHandle<Scalar> h_virial(m_virial, access_location::host, access_mode::overwrite);
+    ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_charge(m_pdata->getCharges(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_group_members(m_group->getIndexArray(),
+                                              access_location::host,
+                                              access_mode::read);
+
+    memset(h_force.data, 0, sizeof(Scalar4) * m_force.getNumElements());
+    memset(h_torque.data, 0, sizeof(Scalar4) * m_torque.getNumElements());
+    memset(h_virial.data, 0, sizeof(Scalar) * m_virial.getNumElements());
+
+    // F_i = sum_l 2 c_l q_i k_l (Re rho(k_l) sin(k_l.r_i) - Im rho(k_l) cos(k_l.r_i))
+    unsigned int group_size = m_group->getNumMembers();
+    for (unsigned int group_idx = 0; group_idx < group_size; ++group_idx)
+        {
+        unsigned int j = h_group_members.data[group_idx];
+        Scalar qj = h_charge.data[j];
+        if (qj == Scalar(0.0))
+            continue;
+
+        Scalar3 r = make_scalar3(h_pos.data[j].x, h_pos.data[j].y, h_pos.data[j].z);
+        Scalar3 f = make_scalar3(0.0, 0.0, 0.0);
+        for (unsigned int l = 0; l < m_batch_size; ++l)
+            {
+            Scalar s, c;
+            fast::sincos(dot(m_k[l], r), s, c);
+            f += m_coeff[l] * (m_rho[2 * l] * s - m_rho[2 * l + 1] * c) * m_k[l];
+            }
+
+        h_force.data[j].x = Scalar(2.0) * qj * f.x;
+        h_force.data[j].y = Scalar(2.0) * qj * f.y;
+        h_force.data[j].z = Scalar(2.0) * qj * f.z;
+        }
+
+    // every rank holds the complete structure factor, store energy and virial on rank 0 only
+    for (unsigned int i = 0; i < 6; ++i)
+        m_external_virial[i] = Scalar(0.0);
+    m_external_energy = Scalar(0.0);
+
+    if (m_exec_conf->getRank() != 0)
+        return;
+
+    Scalar energy(0.0);
+    Scalar virial[6];
+    for (unsigned int i = 0; i < 6; ++i)
+        virial[i] = Scalar(0.0);
+
+    PDataFlags flags = m_pdata->getFlags();
+    Scalar inv_4kappasq = Scalar(0.25) / (m_kappa * m_kappa);
+    for (unsigned int l = 0; l < m_batch_size; ++l)
+        {
+        Scalar rhosq = m_rho[2 * l] * m_rho[2 * l] + m_rho[2 * l + 1] * m_rho[2 * l + 1];
+        Scalar u = m_coeff[l] * rhosq;
+        energy += u;
+
+        if (flags[pdata_flag::pressure_tensor])
+            {
+            Scalar3 k = m_k[l];
+            Scalar vterm
+                = -Scalar(2.0) * (Scalar(1.0) / (dot(k, k) + m_alpha * m_alpha) + inv_4kappasq);
+            virial[0] += u * (Scalar(1.0) + vterm * k.x * k.x); // xx
+            virial[1] += u * (vterm * k.x * k.y);               // xy
+            virial[2] += u * (vterm * k.x * k.z);               // xz
+            virial[3] += u * (Scalar(1.0) + vterm * k.y * k.y); // yy
+            virial[4] += u * (vterm * k.y * k.z);               // yz
+            virial[5] += u * (Scalar(1.0) + vterm * k.z * k.z); // zz
+            }
+        }
+
+    // subtract self-energy (see Frenkel and Smit, and Salin and Caillol)
+    energy -= m_q2
+              * (m_kappa / sqrt(Scalar(M_PI))
+                     * exp(-m_alpha * m_alpha / (Scalar(4.0) * m_kappa * m_kappa))
+                 - Scalar(0.5) * m_alpha * erfc(m_alpha / (Scalar(2.0) * m_kappa)));
+
+    m_external_energy = energy;
+    for (unsigned int i = 0; i < 6; ++i)
+        m_external_virial[i] = virial[i];
+    }
+
+void RandomBatchEwaldForceCompute::fixExclusions()
+    {
+    ArrayHandle<Scalar4> h_force(m_force, access_location::host, access_mode::readwrite);
+    ArrayHandle<Scalar> h_virial(m_virial, access_location::host, access_mode::readwrite);
+    size_t virial_pitch = m_virial.getPitch();
+
+    ArrayHandle<unsigned int> h_group_members(m_group->getIndexArray(),
+                                              access_location::host,
+                                              access_mode::read);
+    const BoxDim& box = m_pdata->getBox();
+    ArrayHandle<unsigned int> h_exlist(m_nlist->getExListArray(),
+                                       access_location::host,
+                                       access_mode::read);
+    ArrayHandle<unsigned int> h_n_ex(m_nlist->getNExArray(),
+                                     access_location::host,
+                                     access_mode::read);
+    Index2D nex = m_nlist->getExListIndexer();
+
+    ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
+    ArrayHandle<Scalar> h_charge(m_pdata->getCharges(), access_location::host, access_mode::read);
+
+    unsigned int group_size = m_group->getNumMembers();
+    for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
+        {
+        unsigned int i = h_group_members.data[group_idx];
+        Scalar3 posi = make_scalar3(h_pos.data[i].x, h_pos.data[i].y, h_pos.data[i].z);
+        Scalar qi = h_charge.data[i];
+
+        Scalar4 force = make_scalar4(0.0, 0.0, 0.0, 0.0);
+        Scalar virial[6];
+        for (unsigned int k = 0; k < 6; k++)
+            virial[k] = Scalar(0.0);
+
+        unsigned int n_neigh = h_n_ex.data[i];
+        for (unsigned int neigh_idx = 0; neigh_idx < n_neigh; neigh_idx++)
+            {
+            unsigned int j = h_exlist.data[nex(i, neigh_idx)];
+            Scalar qiqj = qi * h_charge.data[j];
+            if (qiqj == Scalar(0.0))
+                continue;
+
+            Scalar3 posj = make_scalar3(h_pos.data[j].x, h_pos.data[j].y, h_pos.data[j].z);
+            Scalar3 dx = box.minImage(posi - posj);
+            Scalar rsq = dot(dx, dx);
+
+            // subtract the long-range part of the pair interaction
+            Scalar pair_eng(0.0);
+            Scalar force_divr(0.0);
+            eval_pppm_real_space(m_alpha, m_kappa, rsq, pair_eng, force_divr);
+            force_divr = -qiqj * force_divr;
+            pair_eng = -qiqj * pair_eng;
+
+            virial[0] += Scalar(0.5) * dx.x * dx.x * force_divr;
+            virial[1] += Scalar(0.5) * dx.y * dx.x * force_divr;
+            virial[2] += Scalar(0.5) * dx.z * dx.x * force_divr;
+            virial[3] += Scalar(0.5) * dx.y * dx.y * force_divr;
+            virial[4] += Scalar(0.5) * dx.z * dx.y * force_divr;
+            virial[5] += Scalar(0.5) * dx.z * dx.z * force_divr;
+            force.x += dx.x * force_divr;
+            force.y += dx.y * force_divr;
+            force.z += dx.z * force_divr;
+            force.w += pair_eng;
+            }
+
+        force.w *= Scalar(0.5);
+        h_force.data[i].x += force.x;
+        h_force.data[i].y += force.y;
+        h_force.data[i].z += force.z;
+        h_force.data[i].w += force.w;
+        for (unsigned int k = 0; k < 6; k++)
+            h_virial.data[k * virial_pitch + i] += virial[k];
+        }
+    }
+
+/*! \param timestep Current time step
+ */
+void RandomBatchEwaldForceCompute::computeForces(uint64_t timestep)
+    {
+    if (!m_params_set)
+        {
+        throw std::runtime_error("RandomBatchEwaldForceCompute requires parameters to be set "
+                                 "before run()");
+        }
+
+    if (m_prof)
+        m_prof->push("RBE");
+
+    if (m_need_initialize)
+        {
+        ArrayHandle<Scalar> h_charge(m_pdata->getCharges(),
+                                     access_location::host,
+                                     access_mode::read);
+        ArrayHandle<unsigned int> h_group_members(m_group->getIndexArray(),
+                                                  access_location::host,
+                                                  access_mode::read);
+
+        Scalar q(0.0);
+        m_q2 = Scalar(0.0);
+        unsigned int group_size = m_group->getNumMembers();
+        for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
+            {
+            Scalar qj = h_charge.data[h_group_members.data[group_idx]];
+            q += qj;
+            m_q2 += qj * qj;
+            }
+
+#ifdef ENABLE_MPI
+        if (m_pdata->getDomainDecomposition())
+            {
+            MPI_Allreduce(MPI_IN_PLACE,
+                          &q,
+                          1,
+                          MPI_HOOMD_SCALAR,
+                          MPI_SUM,
+                          m_exec_conf->getMPICommunicator());
+            MPI_Allreduce(MPI_IN_PLACE,
+                          &m_q2,
+                          1,
+                          MPI_HOOMD_SCALAR,
+                          MPI_SUM,
+                          m_exec_conf->getMPICommunicator());
+            }
+#endif
+
+        if (fabs(q) > 1e-5 && m_alpha == Scalar(0.0))
+            {
+            m_exec_conf->msg->warning()
+                << "RandomBatchEwald: system is not neutral and unscreened interactions are "
+                   "calculated, the net charge is "
+                << q << std::endl;
+            }
+
+        if (m_nlist->getFilterBody())
+            {
+            m_exec_conf->msg->warning() << "RandomBatchEwald: the long-range interactions "
+                                           "within rigid bodies are not corrected for"
+                                        << std::endl;
+            }
+
+        m_need_initialize = false;
+        }
+
+    if (m_box_changed)
+        {
+        setupDistribution();
+        m_box_changed = false;
+        }
+
+    sampleWaveVectors(timestep);
+    computeStructureFactor();
+    computeReciprocalForces();
+
+    // If there are exclusions, correct for the long-range part of the potential
+    if (m_nlist->getExclusionsSet())
+        {
+        m_nlist->compute(timestep);
+        fixExclusions();
+        }
+
+    if (m_prof)
+        m_prof->pop();
+    }
+
+void export_RandomBatchEwaldForceCompute(py::module& m)
+    {
+    py::class_<RandomBatchEwaldForceCompute,
+               ForceCompute,
+               std::shared_ptr<RandomBatchEwaldForceCompute>>(m, "RandomBatchEwaldForceCompute")
+        .def(py::init<std::shared_ptr<SystemDefinition>,
+                      std::shared_ptr<NeighborList>,
+                      std::shared_ptr<ParticleGroup>>())
+        .def("setParams", &RandomBatchEwaldForceCompute::setParams)
+        .def_property_readonly("kappa", &RandomBatchEwaldForceCompute::getKappa)
+        .def_property_readonly("batch_size", &RandomBatchEwaldForceCompute::getBatchSize)
+        .def_property_readonly("alpha", &RandomBatchEwaldForceCompute::getAlpha);
+    }
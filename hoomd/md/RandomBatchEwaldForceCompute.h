@@ -0,0 +1,140 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#ifndef __RANDOM_BATCH_EWALD_FORCE_COMPUTE_H__
+#define __RANDOM_BATCH_EWALD_FORCE_COMPUTE_H__
+
+#include "NeighborList.h"
+#include "hoomd/ForceCompute.h"
+#include "hoomd/ParticleGroup.h"
+
+#include <memory>
+#include <vector>
+
+/*! \file RandomBatchEwaldForceCompute.h
+    \brief Declares the RandomBatchEwaldForceCompute class
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include <pybind11/pybind11.h>
+
+//! Compute the long-ranged part of the Ewald sum with the random batch Ewald method
+/*! Instead of summing over all wave vectors, every time step draws a batch of wave vectors
+    from the distribution exp(-k^2/(4 kappa^2)) and evaluates the reciprocal space forces,
+    energy, and virial from the structure factor at these wave vectors only. The estimate
+    is unbiased and its variance decreases with the batch size, see Jin, Li, Xu, and Zhao,
+    SIAM J. Sci. Comput. 43, B937 (2021).
+
+    All ranks draw the same wave vectors, so the only communication is a single reduction of
+    the structure factor, with a size proportional to the batch size and independent of the
+    number of particles or of any mesh.
+
+    The sampling distribution is a product of discrete Gaussians along the reciprocal lattice
+    vectors. For triclinic boxes, every sample is reweighted by the ratio of the true weight
+    to the sampling weight.
+*/
+class PYBIND11_EXPORT RandomBatchEwaldForceCompute : public ForceCompute
+    {
+    public:
+    //! Constructor
+    RandomBatchEwaldForceCompute(std::shared_ptr<SystemDefinition> sysdef,
+                                 std::shared_ptr<NeighborList> nlist,
+                                 std::shared_ptr<ParticleGroup> group);
+    virtual ~RandomBatchEwaldForceCompute();
+
+    //! Set the parameters
+    void setParams(Scalar kappa, unsigned int batch_size, Scalar alpha = 0);
+
+    //! Get the splitting parameter
+    Scalar getKappa()
+        {
+        return m_kappa;
+        }
+
+    //! Get the number of wave vectors sampled per time step
+    unsigned int getBatchSize()
+        {
+        return m_batch_size;
+        }
+
+    //! Get the Debye screening parameter
+    Scalar getAlpha()
+        {
+        return m_alpha;
+        }
+
+#ifdef ENABLE_MPI
+    //! Get ghost particle fields requested by this pair potential
+    virtual CommFlags getRequestedCommFlags(uint64_t timestep)
+        {
+        CommFlags flags = CommFlags(0);
+
+        // the exclusion correction needs ghost particle charges
+        if (m_nlist->getExclusionsSet())
+            flags[comm_flag::charge] = 1;
+
+        flags |= ForceCompute::getRequestedCommFlags(timestep);
+
+        return flags;
+        }
+#endif
+
+    protected:
+    std::shared_ptr<NeighborList> m_nlist;  //!< The neighborlist to use for the exclusions
+    std::shared_ptr<ParticleGroup> m_group; //!< Group to compute properties for
+
+    Scalar m_kappa;            //!< Splitting parameter
+    unsigned int m_batch_size; //!< Number of wave vectors sampled per time step
+    Scalar m_alpha;            //!< Debye screening parameter
+    bool m_params_set;         //!< True if parameters are set
+    bool m_need_initialize;    //!< True if the charges need to be summed up
+    bool m_box_changed;        //!< True if box has changed since last compute
+
+    Scalar3 m_b[3];               //!< Reciprocal lattice vectors
+    int m_max_mode[3];            //!< Largest Miller index sampled along each axis
+    std::vector<Scalar> m_cdf[3]; //!< Cumulative distribution of the Miller index along each axis
+    Scalar m_norm;                //!< Sum of the sampling weights over all non-zero wave vectors
+    Scalar m_q2;                  //!< Sum of charge squared
+
+    std::vector<Scalar3> m_k;    //!< Wave vectors of the current batch
+    std::vector<Scalar> m_coeff; //!< Weight of each wave vector in the energy estimate
+    std::vector<Scalar> m_rho;   //!< Structure factor (real and imaginary part) of the batch
+
+    //! Helper function to be called when box changes
+    void setBoxChange()
+        {
+        m_box_changed = true;
+        }
+
+    //! Helper function to be called when particle number changes
+    void slotGlobalParticleNumberChange()
+        {
+        m_need_initialize = true;
+        }
+
+    //! Actually compute the forces
+    virtual void computeForces(uint64_t timestep);
+
+    //! Set up the sampling distribution of the wave vectors
+    void setupDistribution();
+
+    //! Draw the wave vectors for this time step
+    void sampleWaveVectors(uint64_t timestep);
+
+    //! Compute the structure factor of the batch, summed over all ranks
+    void computeStructureFactor();
+
+    //! Compute the reciprocal space forces, energy and virial
+    void computeReciprocalForces();
+
+    //! Correct forces on excluded particles
+    void fixExclusions();
+    };
+
+//! Exports the RandomBatchEwaldForceCompute class to python
+void export_RandomBatchEwaldForceCompute(pybind11::module& m);
+
+#endif // __RANDOM_BATCH_EWALD_FORCE_COMPUTE_H__
@@ -0,0 +1,186 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file ReplicaExchangeUpdater.cc
+    \brief Defines the ReplicaExchangeUpdater class
+*/
+
+#include "ReplicaExchangeUpdater.h"
+#include "hoomd/RNGIdentifiers.h"
+#include "hoomd/RandomNumbers.h"
+
+#include <pybind11/stl.h>
+
+#include <iostream>
+#include <stdexcept>
+
+using namespace std;
+namespace py = pybind11;
+
+/*! \param sysdef System definition
+    \param thermo Compute that evaluates the potential energy of the replica
+    \param kT Temperature variant that the integration methods of this replica use
+    \param kT_ladder Temperature of each slot, one per partition
+*/
+ReplicaExchangeUpdater::ReplicaExchangeUpdater(std::shared_ptr<SystemDefinition> sysdef,
+                                               std::shared_ptr<ComputeThermo> thermo,
+                                               std::shared_ptr<VariantConstant> kT,
+                                               const std::vector<Scalar>& kT_ladder)
+    : Updater(sysdef), m_thermo(thermo), m_kT(kT), m_ladder(kT_ladder), m_n_updates(0)
+    {
+    m_exec_conf->msg->notice(5) << "Constructing ReplicaExchangeUpdater" << endl;
+    assert(m_thermo);
+    assert(m_kT);
+
+    auto mpi_config = m_exec_conf->getMPIConfig();
+    if (m_ladder.size() != mpi_config->getNPartitions())
+        {
+        throw runtime_error("kT_ladder must have one temperature per partition.");
+        }
+
+    for (auto kT_slot : m_ladder)
+        {
+        if (!(kT_slot > Scalar(0.0)))
+            {
+            throw runtime_error("kT_ladder temperatures must be positive.");
+            }
+        }
+
+    // each replica starts in the slot given by its partition index
+    m_slot = mpi_config->getPartition();
+    m_kT->setValue(m_ladder[m_slot]);
+
+    m_attempted.resize(m_ladder.size() - 1, 0);
+    m_accepted.resize(m_ladder.size() - 1, 0);
+    }
+
+ReplicaExchangeUpdater::~ReplicaExchangeUpdater()
+    {
+    m_exec_conf->msg->notice(5) << "Destroying ReplicaExchangeUpdater" << endl;
+    }
+
+/*! \param timestep Current time step of the simulation
+ */
+void ReplicaExchangeUpdater::update(uint64_t timestep)
+    {
+    Updater::update(timestep);
+    unsigned int n_slots = (unsigned int)m_ladder.size();
+    if (n_slots < 2)
+        return;
+
+    if (m_prof)
+        m_prof->push("ReplicaExchange");
+
+    m_thermo->computeQuantities(timestep, thermo_quantity::kinetic_energy);
+    double energy = m_thermo->getPotentialEnergy();
+
+    // partition, slot, potential energy, and seed of every replica
+    std::vector<double> local(4);
+    local[0] = m_exec_conf->getMPIConfig()->getPartition();
+    local[1] = m_slot;
+    local[2] = energy;
+    local[3] = m_sysdef->getSeed();
+
+    std::vector<double> all(local.size() * m_exec_conf->getMPIConfig()->getNRanksGlobal());
+#ifdef ENABLE_MPI
+    MPI_Allgather(local.data(),
+                  (int)local.size(),
+                  MPI_DOUBLE,
+                  all.data(),
+                  (int)local.size(),
+                  MPI_DOUBLE,
+                  m_exec_conf->getHOOMDWorldMPICommunicator());
+#else
+    all = local;
+#endif
+
+    // all ranks in a partition report the same values
+    std::vector<unsigned int> partition_in_slot(n_slots);
+    std::vector<double> energy_in_slot(n_slots);
+    uint16_t seed = 0;
+    for (size_t i = 0; i < all.size(); i += local.size())
+        {
+        unsigned int partition = (unsigned int)all[i];
+        unsigned int slot = (unsigned int)all[i + 1];
+        partition_in_slot[slot] = partition;
+        energy_in_slot[slot] = all[i + 2];
+
+        // every rank must draw the same random numbers, use the seed of partition 0
+        if (partition == 0)
+            seed = (uint16_t)all[i + 3];
+        }
+
+    // alternate between the even and odd pairs of neighboring slots
+    unsigned int new_slot = m_slot;
+    for (unsigned int i = m_n_updates % 2; i + 1 < n_slots; i += 2)
+        {
+        hoomd::RandomGenerator rng(
+            hoomd::Seed(hoomd::RNGIdentifier::ReplicaExchangeUpdater, timestep, seed),
+            hoomd::Counter(i));
+
+        double delta = (1.0 / m_ladder[i] - 1.0 / m_ladder[i + 1])
+                       * (energy_in_slot[i] - energy_in_slot[i + 1]);
+        double u = hoomd::detail::generate_canonical<double>(rng);
+
+        m_attempted[i]++;
+        if (delta >= 0 || u < exp(delta))
+            {
+            m_accepted[i]++;
+            std::swap(partition_in_slot[i], partition_in_slot[i + 1]);
+            if (m_slot == i)
+                new_slot = i + 1;
+            else if (m_slot == i + 1)
+                new_slot = i;
+            }
+        }
+    m_n_updates++;
+
+    if (new_slot != m_slot)
+        {
+        scaleMomenta(sqrt(m_ladder[new_slot] / m_ladder[m_slot]));
+        m_slot = new_slot;
+        m_kT->setValue(m_ladder[m_slot]);
+        }
+
+    if (m_prof)
+        m_prof->pop();
+    }
+
+/*! \param factor Factor to scale the velocities and angular momenta by
+ */
+void ReplicaExchangeUpdater::scaleMomenta(Scalar factor)
+    {
+    ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(),
+                               access_location::host,
+                               access_mode::readwrite);
+    ArrayHandle<Scalar4> h_angmom(m_pdata->getAngularMomentumArray(),
+                                  access_location::host,
+                                  access_mode::readwrite);
+
+    for (unsigned int i = 0; i < m_pdata->getN(); i++)
+        {
+        h_vel.data[i].x *= factor;
+        h_vel.data[i].y *= factor;
+        h_vel.data[i].z *= factor;
+
+        h_angmom.data[i].x *= factor;
+        h_angmom.data[i].y *= factor;
+        h_angmom.data[i].z *= factor;
+        h_angmom.data[i].w *= factor;
+        }
+    }
+
+void export_ReplicaExchangeUpdater(py::module& m)
+    {
+    py::class_<ReplicaExchangeUpdater, Updater, std::shared_ptr<ReplicaExchangeUpdater>>(
+        m,
+        "ReplicaExchangeUpdater")
+        .def(py::init<std::shared_ptr<SystemDefinition>,
+                      std::shared_ptr<ComputeThermo>,
+                      std::shared_ptr<VariantConstant>,
+                      const std::vector<Scalar>&>())
+        .def_property_readonly("kT_ladder", &ReplicaExchangeUpdater::getLadder)
+        .def_property_readonly("slot", &ReplicaExchangeUpdater::getSlot)
+        .def_property_readonly("attempted", &ReplicaExchangeUpdater::getAttempted)
+        .def_property_readonly("accepted", &ReplicaExchangeUpdater::getAccepted);
+    }
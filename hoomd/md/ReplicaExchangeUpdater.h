@@ -0,0 +1,89 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file ReplicaExchangeUpdater.h
+    \brief Declares an updater that exchanges temperatures between partitions
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include "ComputeThermo.h"
+#include "hoomd/Updater.h"
+#include "hoomd/Variant.h"
+
+#include <memory>
+#include <pybind11/pybind11.h>
+#include <vector>
+
+#pragma once
+
+/// Exchanges temperatures between replicas that run in separate partitions
+/** Each MPI partition simulates one replica. The updater holds a ladder of temperatures with one
+    entry per partition and assigns one slot of the ladder to each replica. The integration methods
+    of the replica read the temperature of the current slot from the VariantConstant kT, which the
+    updater sets.
+
+    On each update, all ranks share the slot, potential energy, and seed of their replica in a
+    single MPI_Allgather on the HOOMD world communicator. Every rank then makes the same swap
+    decisions for neighboring pairs of slots with the Metropolis criterion
+    min(1, exp((1/kT_i - 1/kT_j) (U_i - U_j))). Even and odd pairs alternate between updates.
+    Particle data never leaves a partition: a replica that changes slots rescales its velocities and
+    angular momenta by sqrt(kT_new / kT_old) and sets kT to the temperature of its new slot.
+*/
+class PYBIND11_EXPORT ReplicaExchangeUpdater : public Updater
+    {
+    public:
+    /// Constructor
+    ReplicaExchangeUpdater(std::shared_ptr<SystemDefinition> sysdef,
+                           std::shared_ptr<ComputeThermo> thermo,
+                           std::shared_ptr<VariantConstant> kT,
+                           const std::vector<Scalar>& kT_ladder);
+
+    /// Destructor
+    virtual ~ReplicaExchangeUpdater();
+
+    /// Attempt swaps between neighboring slots of the ladder
+    virtual void update(uint64_t timestep);
+
+    /// Get the temperature ladder
+    const std::vector<Scalar>& getLadder() const
+        {
+        return m_ladder;
+        }
+
+    /// Get the slot of the ladder that this replica occupies
+    unsigned int getSlot() const
+        {
+        return m_slot;
+        }
+
+    /// Get the number of swaps attempted between slots i and i+1
+    std::vector<unsigned int> getAttempted() const
+        {
+        return m_attempted;
+        }
+
+    /// Get the number of swaps accepted between slots i and i+1
+    std::vector<unsigned int> getAccepted() const
+        {
+        return m_accepted;
+        }
+
+    protected:
+    std::shared_ptr<ComputeThermo> m_thermo; //!< Computes the potential energy of the replica
+    std::shared_ptr<VariantConstant> m_kT;   //!< Temperature used by the integration methods
+    std::vector<Scalar> m_ladder;            //!< Temperature of each slot
+    unsigned int m_slot;                     //!< Slot occupied by this replica
+    uint64_t m_n_updates;                    //!< Number of times update() has been called
+
+    std::vector<unsigned int> m_attempted; //!< Number of attempted swaps for each pair of slots
+    std::vector<unsigned int> m_accepted;  //!< Number of accepted swaps for each pair of slots
+
+    /// Scale the velocities and angular momenta of the local particles
+    void scaleMomenta(Scalar factor);
+    };
+
+/// Export the ReplicaExchangeUpdater to python
+void export_ReplicaExchangeUpdater(pybind11::module& m);
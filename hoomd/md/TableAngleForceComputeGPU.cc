@@ -78,6 +78,7 @@ void TableAngleForceComputeGPU::computeForces(uint64_t timestep)
         gpu_compute_table_angle_forces(d_force.data,
                                        d_virial.data,
                                        m_virial.getPitch(),
+                                       m_pdata->getFlags()[pdata_flag::pressure_tensor],
                                        m_pdata->getN(),
                                        d_pos.data,
                                        box,
@@ -88,7 +89,8 @@ void TableAngleForceComputeGPU::computeForces(uint64_t timestep)
                                        d_tables.data,
                                        m_table_width,
                                        m_table_value,
-                                       m_tuner->getParam());
+                                       m_tuner->getParam(),
+                                       m_exec_conf->dev_prop);
         }
 
     if (m_exec_conf->isCUDAErrorCheckingEnabled())
@@ -22,6 +22,7 @@
     \param d_force Device memory to write computed forces
     \param d_virial Device memory to write computed virials
     \param virial_pitch Pitch of 2D virial array
+    \param compute_virial Whether to write the virials
     \param N number of particles in system
     \param d_pos device array of particle positions
     \param box Box dimensions used to implement periodic boundary conditions
@@ -34,11 +35,15 @@
     \param table_value index helper function
     \param delta_th angle delta of the table
 
+    \tparam use_shared When true, the block reads the tables into dynamic shared memory first
+
     See TableAngleForceCompute for information on the memory layout.
 */
+template<bool use_shared>
 __global__ void gpu_compute_table_angle_forces_kernel(Scalar4* d_force,
                                                       Scalar* d_virial,
                                                       const size_t virial_pitch,
+                                                      const bool compute_virial,
                                                       const unsigned int N,
                                                       const Scalar4* d_pos,
                                                       const BoxDim box,
@@ -50,6 +55,19 @@ __global__ void gpu_compute_table_angle_forces_kernel(Scalar4* d_force,
                                                       const Index2D table_value,
                                                       const Scalar delta_th)
     {
+    // stage the tables in shared memory when they fit, see the driver
+    HIP_DYNAMIC_SHARED(Scalar2, s_tables)
+    if (use_shared)
+        {
+        const unsigned int n_values = table_value.getNumElements();
+        for (unsigned int cur_offset = 0; cur_offset < n_values; cur_offset += blockDim.x)
+            {
+            if (cur_offset + threadIdx.x < n_values)
+                s_tables[cur_offset + threadIdx.x] = d_tables[cur_offset + threadIdx.x];
+            }
+        __syncthreads();
+        }
+
     // start by identifying which particle we are to handle
     unsigned int idx = blockIdx.x * blockDim.x + threadIdx.x;
 
@@ -145,8 +163,9 @@ __global__ void gpu_compute_table_angle_forces_kernel(Scalar4* d_force,
 
         // compute index into the table and read in values
         unsigned int value_i = value_f;
-        Scalar2 VT0 = __ldg(d_tables + table_value(value_i, cur_angle_type));
-        Scalar2 VT1 = __ldg(d_tables + table_value(value_i + 1, cur_angle_type));
+        const unsigned int table_idx = table_value(value_i, cur_angle_type);
+        Scalar2 VT0 = use_shared ? s_tables[table_idx] : __ldg(d_tables + table_idx);
+        Scalar2 VT1 = use_shared ? s_tables[table_idx + 1] : __ldg(d_tables + table_idx + 1);
         // unpack the data
         Scalar V0 = VT0.x;
         Scalar V1 = VT1.x;
@@ -212,13 +231,17 @@ __global__ void gpu_compute_table_angle_forces_kernel(Scalar4* d_force,
 
     // now that the force calculation is complete, write out the result (MEM TRANSFER: 20 bytes);
     d_force[idx] = force_idx;
-    for (unsigned int i = 0; i < 6; i++)
-        d_virial[i * virial_pitch + idx] = virial[i];
+    if (compute_virial)
+        {
+        for (unsigned int i = 0; i < 6; i++)
+            d_virial[i * virial_pitch + idx] = virial[i];
+        }
     }
 
 /*! \param d_force Device memory to write computed forces
     \param d_virial Device memory to write computed virials
     \param virial_pitch pitch of 2D virial array
+    \param compute_virial Whether to write the virials
     \param N number of particles
     \param d_pos particle positions on the device
     \param box Box dimensions used to implement periodic boundary conditions
@@ -230,7 +253,10 @@ __global__ void gpu_compute_table_angle_forces_kernel(Scalar4* d_force,
     \param table_width Number of points in each table
     \param table_value indexer helper
     \param block_size Block size at which to run the kernel
-    \param compute_capability Compute capability of the device (200, 300, 350, ...)
+    \param dev_prop Properties of the device
+
+    The tables are staged in shared memory when they fit, otherwise the kernel reads them through
+   the read-only data cache.
 
     \note This is just a kernel driver. See gpu_compute_table_angle_forces_kernel for full
    documentation.
@@ -238,6 +264,7 @@ __global__ void gpu_compute_table_angle_forces_kernel(Scalar4* d_force,
 hipError_t gpu_compute_table_angle_forces(Scalar4* d_force,
                                           Scalar* d_virial,
                                           const size_t virial_pitch,
+                                          const bool compute_virial,
                                           const unsigned int N,
                                           const Scalar4* d_pos,
                                           const BoxDim& box,
@@ -248,7 +275,8 @@ hipError_t gpu_compute_table_angle_forces(Scalar4* d_force,
                                           const Scalar2* d_tables,
                                           const unsigned int table_width,
                                           const Index2D& table_value,
-                                          const unsigned int block_size)
+                                          const unsigned int block_size,
+                                          const hipDeviceProp_t& dev_prop)
     {
     assert(d_tables);
     assert(table_width > 1);
@@ -256,15 +284,24 @@ hipError_t gpu_compute_table_angle_forces(Scalar4* d_force,
     if (N == 0)
         return hipSuccess;
 
-    static unsigned int max_block_size = UINT_MAX;
-    if (max_block_size == UINT_MAX)
+    static unsigned int max_block_size[2] = {UINT_MAX, UINT_MAX};
+    static size_t kernel_shared_bytes = 0;
+    if (max_block_size[0] == UINT_MAX)
         {
         hipFuncAttributes attr;
-        hipFuncGetAttributes(&attr, (const void*)gpu_compute_table_angle_forces_kernel);
-        max_block_size = attr.maxThreadsPerBlock;
+        hipFuncGetAttributes(&attr, (const void*)gpu_compute_table_angle_forces_kernel<false>);
+        max_block_size[0] = attr.maxThreadsPerBlock;
+        hipFuncGetAttributes(&attr, (const void*)gpu_compute_table_angle_forces_kernel<true>);
+        max_block_size[1] = attr.maxThreadsPerBlock;
+        kernel_shared_bytes = attr.sharedSizeBytes;
         }
 
-    unsigned int run_block_size = min(block_size, max_block_size);
+    const size_t table_bytes = sizeof(Scalar2) * table_value.getNumElements();
+    const bool use_shared = table_bytes + kernel_shared_bytes <= dev_prop.sharedMemPerBlock;
+    auto kernel = use_shared ? gpu_compute_table_angle_forces_kernel<true>
+                             : gpu_compute_table_angle_forces_kernel<false>;
+
+    unsigned int run_block_size = min(block_size, max_block_size[use_shared]);
 
     // setup the grid to run the kernel
     dim3 grid(N / run_block_size + 1, 1, 1);
@@ -272,14 +309,15 @@ hipError_t gpu_compute_table_angle_forces(Scalar4* d_force,
 
     Scalar delta_th = Scalar(M_PI) / (Scalar)(table_width - 1);
 
-    hipLaunchKernelGGL((gpu_compute_table_angle_forces_kernel),
+    hipLaunchKernelGGL((kernel),
                        dim3(grid),
                        dim3(threads),
-                       0,
+                       use_shared ? table_bytes : 0,
                        0,
                        d_force,
                        d_virial,
                        virial_pitch,
+                       compute_virial,
                        N,
                        d_pos,
                        box,
@@ -20,6 +20,7 @@
 hipError_t gpu_compute_table_angle_forces(Scalar4* d_force,
                                           Scalar* d_virial,
                                           const size_t virial_pitch,
+                                          const bool compute_virial,
                                           const unsigned int N,
                                           const Scalar4* d_pos,
                                           const BoxDim& box,
@@ -30,6 +31,7 @@ hipError_t gpu_compute_table_angle_forces(Scalar4* d_force,
                                           const Scalar2* d_tables,
                                           const unsigned int table_width,
                                           const Index2D& table_value,
-                                          const unsigned int block_size);
+                                          const unsigned int block_size,
+                                          const hipDeviceProp_t& dev_prop);
 
 #endif
@@ -79,6 +79,7 @@ void TableDihedralForceComputeGPU::computeForces(uint64_t timestep)
         gpu_compute_table_dihedral_forces(d_force.data,
                                           d_virial.data,
                                           m_virial.getPitch(),
+                                          m_pdata->getFlags()[pdata_flag::pressure_tensor],
                                           m_pdata->getN(),
                                           d_pos.data,
                                           box,
@@ -89,7 +90,8 @@ void TableDihedralForceComputeGPU::computeForces(uint64_t timestep)
                                           d_tables.data,
                                           m_table_width,
                                           m_table_value,
-                                          m_tuner->getParam());
+                                          m_tuner->getParam(),
+                                          m_exec_conf->dev_prop);
         }
 
     if (m_exec_conf->isCUDAErrorCheckingEnabled())
@@ -14,6 +14,8 @@ using namespace hoomd;
 #include "hoomd/HOOMDMPI.h"
 #endif
 
+#include <memory>
+
 namespace py = pybind11;
 using namespace std;
 
@@ -26,7 +28,8 @@ TwoStepBD::TwoStepBD(std::shared_ptr<SystemDefinition> sysdef,
                      std::shared_ptr<Variant> T,
                      bool noiseless_t,
                      bool noiseless_r)
-    : TwoStepLangevinBase(sysdef, group, T), m_noiseless_t(noiseless_t), m_noiseless_r(noiseless_r)
+    : TwoStepLangevinBase(sysdef, group, T), m_noiseless_t(noiseless_t), m_noiseless_r(noiseless_r),
+      m_update_velocities(true)
     {
     m_exec_conf->msg->notice(5) << "Constructing TwoStepBD" << endl;
     }
@@ -41,11 +44,12 @@ TwoStepBD::~TwoStepBD()
 
     The integration method here is from the book "The Langevin and Generalised Langevin Approach to
    the Dynamics of Atomic, Polymeric and Colloidal Systems", chapter 6.
+
+    When velocities are not updated and the rotational degrees of freedom are not integrated, only
+    the positions, images and net forces of the members are accessed.
 */
 void TwoStepBD::integrateStepOne(uint64_t timestep)
     {
-    unsigned int group_size = m_group->getNumMembers();
-
     // profile this step
     if (m_prof)
         m_prof->push("BD step 1");
@@ -54,10 +58,9 @@ void TwoStepBD::integrateStepOne(uint64_t timestep)
     const Scalar currentTemp = (*m_T)(timestep);
     const unsigned int D = m_sysdef->getNDimensions();
 
+    drawUniformNoise(RNGIdentifier::TwoStepBD, timestep);
+
     const GlobalArray<Scalar4>& net_force = m_pdata->getNetForce();
-    ArrayHandle<Scalar4> h_vel(m_pdata->getVelocities(),
-                               access_location::host,
-                               access_mode::readwrite);
     ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(),
                                access_location::host,
                                access_mode::readwrite);
@@ -70,20 +73,35 @@ void TwoStepBD::integrateStepOne(uint64_t timestep)
                                    access_location::host,
                                    access_mode::read);
 
-    ArrayHandle<Scalar3> h_gamma_r(m_gamma_r, access_location::host, access_mode::read);
-    ArrayHandle<Scalar4> h_orientation(m_pdata->getOrientationArray(),
-                                       access_location::host,
-                                       access_mode::readwrite);
-    ArrayHandle<Scalar4> h_torque(m_pdata->getNetTorqueArray(),
-                                  access_location::host,
-                                  access_mode::readwrite);
-
-    ArrayHandle<Scalar4> h_angmom(m_pdata->getAngularMomentumArray(),
-                                  access_location::host,
-                                  access_mode::readwrite);
-    ArrayHandle<Scalar3> h_inertia(m_pdata->getMomentsOfInertiaArray(),
-                                   access_location::host,
-                                   access_mode::read);
+    // velocities and the rotational degrees of freedom are only accessed when they are updated
+    std::unique_ptr<ArrayHandle<Scalar4>> h_vel;
+    if (m_update_velocities)
+        h_vel.reset(new ArrayHandle<Scalar4>(m_pdata->getVelocities(),
+                                             access_location::host,
+                                             access_mode::readwrite));
+
+    std::unique_ptr<ArrayHandle<Scalar3>> h_gamma_r;
+    std::unique_ptr<ArrayHandle<Scalar4>> h_orientation;
+    std::unique_ptr<ArrayHandle<Scalar4>> h_torque;
+    std::unique_ptr<ArrayHandle<Scalar4>> h_angmom;
+    std::unique_ptr<ArrayHandle<Scalar3>> h_inertia;
+    if (m_aniso)
+        {
+        h_gamma_r.reset(
+            new ArrayHandle<Scalar3>(m_gamma_r, access_location::host, access_mode::read));
+        h_orientation.reset(new ArrayHandle<Scalar4>(m_pdata->getOrientationArray(),
+                                                     access_location::host,
+                                                     access_mode::readwrite));
+        h_torque.reset(new ArrayHandle<Scalar4>(m_pdata->getNetTorqueArray(),
+                                                access_location::host,
+                                                access_mode::readwrite));
+        h_angmom.reset(new ArrayHandle<Scalar4>(m_pdata->getAngularMomentumArray(),
+                                                access_location::host,
+                                                access_mode::readwrite));
+        h_inertia.reset(new ArrayHandle<Scalar3>(m_pdata->getMomentsOfInertiaArray(),
+                                                 access_location::host,
+                                                 access_mode::read));
+        }
 
     const BoxDim& box = m_pdata->getBox();
 
@@ -92,161 +110,169 @@ void TwoStepBD::integrateStepOne(uint64_t timestep)
     // perform the first half step
     // r(t+deltaT) = r(t) + (Fc(t) + Fr)*deltaT/gamma
     // v(t+deltaT) = random distribution consistent with T
-    for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
+    forEachMember(
+        [&](unsigned int j)
         {
-        unsigned int j = m_group->getMemberIndex(group_idx);
-        unsigned int ptag = h_tag.data[j];
-
-        // Initialize the RNG
-        RandomGenerator rng(hoomd::Seed(RNGIdentifier::TwoStepBD, timestep, seed),
-                            hoomd::Counter(ptag));
-
-        // compute the random force
-        UniformDistribution<Scalar> uniform(Scalar(-1), Scalar(1));
-        Scalar rx = uniform(rng);
-        Scalar ry = uniform(rng);
-        Scalar rz = uniform(rng);
-
-        Scalar gamma;
-        if (m_use_alpha)
-            gamma = m_alpha * h_diameter.data[j];
-        else
-            {
-            unsigned int type = __scalar_as_int(h_pos.data[j].w);
-            gamma = h_gamma.data[type];
-            }
-
-        // compute the bd force (the extra factor of 3 is because <rx^2> is 1/3 in the uniform -1,1
-        // distribution it is not the dimensionality of the system
-        Scalar coeff = fast::sqrt(Scalar(3.0) * Scalar(2.0) * gamma * currentTemp / m_deltaT);
-        if (m_noiseless_t)
-            coeff = Scalar(0.0);
-        Scalar Fr_x = rx * coeff;
-        Scalar Fr_y = ry * coeff;
-        Scalar Fr_z = rz * coeff;
-
-        if (D < 3)
-            Fr_z = Scalar(0.0);
-
-        // update position
-        h_pos.data[j].x += (h_net_force.data[j].x + Fr_x) * m_deltaT / gamma;
-        h_pos.data[j].y += (h_net_force.data[j].y + Fr_y) * m_deltaT / gamma;
-        h_pos.data[j].z += (h_net_force.data[j].z + Fr_z) * m_deltaT / gamma;
-
-        // particles may have been moved slightly outside the box by the above steps, wrap them back
-        // into place
-        box.wrap(h_pos.data[j], h_image.data[j]);
-
-        if (m_noiseless_t)
-            {
-            h_vel.data[j].x = h_net_force.data[j].x / gamma;
-            h_vel.data[j].y = h_net_force.data[j].y / gamma;
-            if (D > 2)
-                h_vel.data[j].z = h_net_force.data[j].z / gamma;
-            else
-                h_vel.data[j].z = 0;
-            }
-        else
-            {
-            // draw a new random velocity for particle j
-            Scalar mass = h_vel.data[j].w;
-            Scalar sigma = fast::sqrt(currentTemp / mass);
-            NormalDistribution<Scalar> normal(sigma);
-            h_vel.data[j].x = normal(rng);
-            h_vel.data[j].y = normal(rng);
-            if (D > 2)
-                h_vel.data[j].z = normal(rng);
+            unsigned int ptag = h_tag.data[j];
+
+            // Initialize the RNG after the translational noise drawn in batches above
+            RandomGenerator rng(hoomd::Seed(RNGIdentifier::TwoStepBD, timestep, seed),
+                                hoomd::Counter(ptag));
+            rng.discard(2);
+
+            // compute the random force
+            Scalar rx = m_uniform_noise[j].x;
+            Scalar ry = m_uniform_noise[j].y;
+            Scalar rz = m_uniform_noise[j].z;
+
+            Scalar gamma;
+            if (m_use_alpha)
+                gamma = m_alpha * h_diameter.data[j];
             else
-                h_vel.data[j].z = 0;
-            }
-
-        // rotational random force and orientation quaternion updates
-        if (m_aniso)
-            {
-            unsigned int type_r = __scalar_as_int(h_pos.data[j].w);
-            Scalar3 gamma_r = h_gamma_r.data[type_r];
-            if (gamma_r.x > 0 || gamma_r.y > 0 || gamma_r.z > 0)
                 {
-                vec3<Scalar> p_vec;
-                quat<Scalar> q(h_orientation.data[j]);
-                vec3<Scalar> t(h_torque.data[j]);
-                vec3<Scalar> I(h_inertia.data[j]);
-
-                bool x_zero, y_zero, z_zero;
-                x_zero = (I.x < EPSILON);
-                y_zero = (I.y < EPSILON);
-                z_zero = (I.z < EPSILON);
-
-                Scalar3 sigma_r
-                    = make_scalar3(fast::sqrt(Scalar(2.0) * gamma_r.x * currentTemp / m_deltaT),
-                                   fast::sqrt(Scalar(2.0) * gamma_r.y * currentTemp / m_deltaT),
-                                   fast::sqrt(Scalar(2.0) * gamma_r.z * currentTemp / m_deltaT));
-                if (m_noiseless_r)
-                    sigma_r = make_scalar3(0, 0, 0);
-
-                // original Gaussian random torque
-                // Gaussian random distribution is preferred in terms of preserving the exact math
-                vec3<Scalar> bf_torque;
-                bf_torque.x = NormalDistribution<Scalar>(sigma_r.x)(rng);
-                bf_torque.y = NormalDistribution<Scalar>(sigma_r.y)(rng);
-                bf_torque.z = NormalDistribution<Scalar>(sigma_r.z)(rng);
-
-                if (x_zero)
-                    bf_torque.x = 0;
-                if (y_zero)
-                    bf_torque.y = 0;
-                if (z_zero)
-                    bf_torque.z = 0;
-
-                // use the damping by gamma_r and rotate back to lab frame
-                // Notes For the Future: take special care when have anisotropic gamma_r
-                // if aniso gamma_r, first rotate the torque into particle frame and divide the
-                // different gamma_r and then rotate the "angular velocity" back to lab frame and
-                // integrate
-                bf_torque = rotate(q, bf_torque);
-                if (D < 3)
-                    {
-                    bf_torque.x = 0;
-                    bf_torque.y = 0;
-                    t.x = 0;
-                    t.y = 0;
-                    }
+                unsigned int type = __scalar_as_int(h_pos.data[j].w);
+                gamma = h_gamma.data[type];
+                }
+
+            // compute the bd force (the extra factor of 3 is because <rx^2> is 1/3 in the uniform
+            // -1,1 distribution it is not the dimensionality of the system
+            Scalar coeff = fast::sqrt(Scalar(3.0) * Scalar(2.0) * gamma * currentTemp / m_deltaT);
+            if (m_noiseless_t)
+                coeff = Scalar(0.0);
+            Scalar Fr_x = rx * coeff;
+            Scalar Fr_y = ry * coeff;
+            Scalar Fr_z = rz * coeff;
 
-                // do the integration for quaternion
-                q += Scalar(0.5) * m_deltaT * ((t + bf_torque) / vec3<Scalar>(gamma_r)) * q;
-                q = q * (Scalar(1.0) / slow::sqrt(norm2(q)));
-                h_orientation.data[j] = quat_to_scalar4(q);
+            if (D < 3)
+                Fr_z = Scalar(0.0);
 
-                if (m_noiseless_r)
+            // update position
+            h_pos.data[j].x += (h_net_force.data[j].x + Fr_x) * m_deltaT / gamma;
+            h_pos.data[j].y += (h_net_force.data[j].y + Fr_y) * m_deltaT / gamma;
+            h_pos.data[j].z += (h_net_force.data[j].z + Fr_z) * m_deltaT / gamma;
+
+            // particles may have been moved slightly outside the box by the above steps, wrap them
+            // back into place
+            box.wrap(h_pos.data[j], h_image.data[j]);
+
+            if (m_update_velocities)
+                {
+                Scalar4& vel = h_vel->data[j];
+                if (m_noiseless_t)
                     {
-                    p_vec.x = t.x / gamma_r.x;
-                    p_vec.y = t.y / gamma_r.y;
-                    p_vec.z = t.z / gamma_r.z;
+                    vel.x = h_net_force.data[j].x / gamma;
+                    vel.y = h_net_force.data[j].y / gamma;
+                    if (D > 2)
+                        vel.z = h_net_force.data[j].z / gamma;
+                    else
+                        vel.z = 0;
                     }
                 else
                     {
-                    // draw a new random ang_mom for particle j in body frame
-                    p_vec.x = NormalDistribution<Scalar>(fast::sqrt(currentTemp * I.x))(rng);
-                    p_vec.y = NormalDistribution<Scalar>(fast::sqrt(currentTemp * I.y))(rng);
-                    p_vec.z = NormalDistribution<Scalar>(fast::sqrt(currentTemp * I.z))(rng);
+                    // draw a new random velocity for particle j
+                    Scalar mass = vel.w;
+                    Scalar sigma = fast::sqrt(currentTemp / mass);
+                    Scalar v[3];
+                    NormalDistribution<Scalar>(sigma)(v, rng);
+                    vel.x = v[0];
+                    vel.y = v[1];
+                    if (D > 2)
+                        vel.z = v[2];
+                    else
+                        vel.z = 0;
                     }
+                }
 
-                if (x_zero)
-                    p_vec.x = 0;
-                if (y_zero)
-                    p_vec.y = 0;
-                if (z_zero)
-                    p_vec.z = 0;
-
-                // !! Note this isn't well-behaving in 2D,
-                // !! because may have effective non-zero ang_mom in x,y
-
-                // store ang_mom quaternion
-                quat<Scalar> p = Scalar(2.0) * q * p_vec;
-                h_angmom.data[j] = quat_to_scalar4(p);
+            // rotational random force and orientation quaternion updates
+            if (m_aniso)
+                {
+                unsigned int type_r = __scalar_as_int(h_pos.data[j].w);
+                Scalar3 gamma_r = h_gamma_r->data[type_r];
+                if (gamma_r.x > 0 || gamma_r.y > 0 || gamma_r.z > 0)
+                    {
+                    vec3<Scalar> p_vec;
+                    quat<Scalar> q(h_orientation->data[j]);
+                    vec3<Scalar> t(h_torque->data[j]);
+                    vec3<Scalar> I(h_inertia->data[j]);
+
+                    bool x_zero, y_zero, z_zero;
+                    x_zero = (I.x < EPSILON);
+                    y_zero = (I.y < EPSILON);
+                    z_zero = (I.z < EPSILON);
+
+                    Scalar3 sigma_r = make_scalar3(
+                        fast::sqrt(Scalar(2.0) * gamma_r.x * currentTemp / m_deltaT),
+                        fast::sqrt(Scalar(2.0) * gamma_r.y * currentTemp / m_deltaT),
+                        fast::sqrt(Scalar(2.0) * gamma_r.z * currentTemp / m_deltaT));
+                    if (m_noiseless_r)
+                        sigma_r = make_scalar3(0, 0, 0);
+
+                    // original Gaussian random torque
+                    // Gaussian random distribution is preferred in terms of preserving the exact
+                    // math
+                    Scalar noise[3];
+                    NormalDistribution<Scalar>()(noise, rng);
+                    vec3<Scalar> bf_torque(noise[0] * sigma_r.x,
+                                           noise[1] * sigma_r.y,
+                                           noise[2] * sigma_r.z);
+
+                    if (x_zero)
+                        bf_torque.x = 0;
+                    if (y_zero)
+                        bf_torque.y = 0;
+                    if (z_zero)
+                        bf_torque.z = 0;
+
+                    // use the damping by gamma_r and rotate back to lab frame
+                    // Notes For the Future: take special care when have anisotropic gamma_r
+                    // if aniso gamma_r, first rotate the torque into particle frame and divide the
+                    // different gamma_r and then rotate the "angular velocity" back to lab frame
+                    // and integrate
+                    bf_torque = rotate(q, bf_torque);
+                    if (D < 3)
+                        {
+                        bf_torque.x = 0;
+                        bf_torque.y = 0;
+                        t.x = 0;
+                        t.y = 0;
+                        }
+
+                    // do the integration for quaternion
+                    q += Scalar(0.5) * m_deltaT * ((t + bf_torque) / vec3<Scalar>(gamma_r)) * q;
+                    q = q * (Scalar(1.0) / slow::sqrt(norm2(q)));
+                    h_orientation->data[j] = quat_to_scalar4(q);
+
+                    if (m_noiseless_r)
+                        {
+                        p_vec.x = t.x / gamma_r.x;
+                        p_vec.y = t.y / gamma_r.y;
+                        p_vec.z = t.z / gamma_r.z;
+                        }
+                    else
+                        {
+                        // draw a new random ang_mom for particle j in body frame
+                        NormalDistribution<Scalar>()(noise, rng);
+                        p_vec.x = noise[0] * fast::sqrt(currentTemp * I.x);
+                        p_vec.y = noise[1] * fast::sqrt(currentTemp * I.y);
+                        p_vec.z = noise[2] * fast::sqrt(currentTemp * I.z);
+                        }
+
+                    if (x_zero)
+                        p_vec.x = 0;
+                    if (y_zero)
+                        p_vec.y = 0;
+                    if (z_zero)
+                        p_vec.z = 0;
+
+                    // !! Note this isn't well-behaving in 2D,
+                    // !! because may have effective non-zero ang_mom in x,y
+
+                    // store ang_mom quaternion
+                    quat<Scalar> p = Scalar(2.0) * q * p_vec;
+                    h_angmom->data[j] = quat_to_scalar4(p);
+                    }
                 }
-            }
-        }
+        });
 
     // done profiling
     if (m_prof)
@@ -267,5 +293,8 @@ void export_TwoStepBD(py::module& m)
                       std::shared_ptr<ParticleGroup>,
                       std::shared_ptr<Variant>,
                       bool,
-                      bool>());
+                      bool>())
+        .def_property("update_velocities",
+                      &TwoStepBD::getUpdateVelocities,
+                      &TwoStepBD::setUpdateVelocities);
     }
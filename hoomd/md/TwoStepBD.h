@@ -34,9 +34,24 @@ class PYBIND11_EXPORT TwoStepBD : public TwoStepLangevinBase
     /// Performs the second step of the integration
     virtual void integrateStepTwo(uint64_t timestep);
 
+    /// Get whether velocities are set each step
+    bool getUpdateVelocities()
+        {
+        return m_update_velocities;
+        }
+
+    /// Set whether velocities are set each step
+    void setUpdateVelocities(bool update_velocities)
+        {
+        m_update_velocities = update_velocities;
+        }
+
     protected:
     bool m_noiseless_t;
     bool m_noiseless_r;
+
+    /// When false, leave the velocities untouched and only move the positions
+    bool m_update_velocities;
     };
 
 //! Exports the TwoStepLangevin class to python
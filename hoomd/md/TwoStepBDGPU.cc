@@ -8,6 +8,8 @@
 #include "hoomd/HOOMDMPI.h"
 #endif
 
+#include <memory>
+
 namespace py = pybind11;
 
 using namespace std;
@@ -56,9 +58,6 @@ void TwoStepBDGPU::integrateStepOne(uint64_t timestep)
     ArrayHandle<Scalar4> d_pos(m_pdata->getPositions(),
                                access_location::device,
                                access_mode::readwrite);
-    ArrayHandle<Scalar4> d_vel(m_pdata->getVelocities(),
-                               access_location::device,
-                               access_mode::readwrite);
     ArrayHandle<int3> d_image(m_pdata->getImages(),
                               access_location::device,
                               access_mode::readwrite);
@@ -70,27 +69,43 @@ void TwoStepBDGPU::integrateStepOne(uint64_t timestep)
                                    access_mode::read);
     ArrayHandle<unsigned int> d_tag(m_pdata->getTags(), access_location::device, access_mode::read);
 
-    // for rotational noise
-    ArrayHandle<Scalar3> d_gamma_r(m_gamma_r, access_location::device, access_mode::read);
-    ArrayHandle<Scalar4> d_orientation(m_pdata->getOrientationArray(),
-                                       access_location::device,
-                                       access_mode::readwrite);
-    ArrayHandle<Scalar4> d_torque(m_pdata->getNetTorqueArray(),
-                                  access_location::device,
-                                  access_mode::readwrite);
-    ArrayHandle<Scalar3> d_inertia(m_pdata->getMomentsOfInertiaArray(),
-                                   access_location::device,
-                                   access_mode::read);
-    ArrayHandle<Scalar4> d_angmom(m_pdata->getAngularMomentumArray(),
-                                  access_location::device,
-                                  access_mode::readwrite);
+    // velocities and the rotational degrees of freedom are only accessed when they are updated,
+    // the kernel receives NULL pointers otherwise
+    std::unique_ptr<ArrayHandle<Scalar4>> d_vel;
+    if (m_update_velocities)
+        d_vel.reset(new ArrayHandle<Scalar4>(m_pdata->getVelocities(),
+                                             access_location::device,
+                                             access_mode::readwrite));
+
+    std::unique_ptr<ArrayHandle<Scalar3>> d_gamma_r;
+    std::unique_ptr<ArrayHandle<Scalar4>> d_orientation;
+    std::unique_ptr<ArrayHandle<Scalar4>> d_torque;
+    std::unique_ptr<ArrayHandle<Scalar3>> d_inertia;
+    std::unique_ptr<ArrayHandle<Scalar4>> d_angmom;
+    if (m_aniso)
+        {
+        d_gamma_r.reset(
+            new ArrayHandle<Scalar3>(m_gamma_r, access_location::device, access_mode::read));
+        d_orientation.reset(new ArrayHandle<Scalar4>(m_pdata->getOrientationArray(),
+                                                     access_location::device,
+                                                     access_mode::readwrite));
+        d_torque.reset(new ArrayHandle<Scalar4>(m_pdata->getNetTorqueArray(),
+                                                access_location::device,
+                                                access_mode::readwrite));
+        d_inertia.reset(new ArrayHandle<Scalar3>(m_pdata->getMomentsOfInertiaArray(),
+                                                 access_location::device,
+                                                 access_mode::read));
+        d_angmom.reset(new ArrayHandle<Scalar4>(m_pdata->getAngularMomentumArray(),
+                                                access_location::device,
+                                                access_mode::readwrite));
+        }
 
     langevin_step_two_args args;
     args.d_gamma = d_gamma.data;
     args.n_types = (unsigned int)m_gamma.getNumElements();
     args.use_alpha = m_use_alpha;
     args.alpha = m_alpha;
-    args.T = (*m_T)(timestep);
+    args.T = m_T->getDeviceParams(timestep);
     args.timestep = timestep;
     args.seed = m_sysdef->getSeed();
     args.d_sum_bdenergy = NULL;
@@ -124,7 +139,7 @@ void TwoStepBDGPU::integrateStepOne(uint64_t timestep)
 
     // perform the update on the GPU
     gpu_brownian_step_one(d_pos.data,
-                          d_vel.data,
+                          d_vel ? d_vel->data : NULL,
                           d_image.data,
                           box,
                           d_diameter.data,
@@ -132,11 +147,11 @@ void TwoStepBDGPU::integrateStepOne(uint64_t timestep)
                           d_index_array.data,
                           group_size,
                           d_net_force.data,
-                          d_gamma_r.data,
-                          d_orientation.data,
-                          d_torque.data,
-                          d_inertia.data,
-                          d_angmom.data,
+                          aniso ? d_gamma_r->data : NULL,
+                          aniso ? d_orientation->data : NULL,
+                          aniso ? d_torque->data : NULL,
+                          aniso ? d_inertia->data : NULL,
+                          aniso ? d_angmom->data : NULL,
                           args,
                           aniso,
                           m_deltaT,
@@ -163,6 +178,33 @@ void TwoStepBDGPU::integrateStepTwo(uint64_t timestep)
     // there is no step 2
     }
 
+/*! \param timestep Current time step
+    \param params Output: parameters of the method
+    \param gamma Output: per-type drag coefficients
+
+    The fused kernels implement the translational update, anisotropic integration is not fused.
+    Methods that do not update velocities are not fused either: the fused kernels read and write
+    the velocities of all particles.
+*/
+bool TwoStepBDGPU::getFusedParams(uint64_t timestep, fused_method_params& params, Scalar* gamma)
+    {
+    if (m_aniso || !m_update_velocities)
+        return false;
+
+    params.kind = fused_method_brownian;
+    params.T = m_T->getDeviceParams(timestep);
+    params.alpha = m_alpha;
+    params.limit_val = Scalar(0.0);
+    params.use_alpha = m_use_alpha;
+    params.noiseless_t = m_noiseless_t;
+    params.limit = false;
+    params.zero_force = false;
+
+    ArrayHandle<Scalar> h_gamma(m_gamma, access_location::host, access_mode::read);
+    std::copy(h_gamma.data, h_gamma.data + m_gamma.getNumElements(), gamma);
+    return true;
+    }
+
 void export_TwoStepBDGPU(py::module& m)
     {
     py::class_<TwoStepBDGPU, TwoStepBD, std::shared_ptr<TwoStepBDGPU>>(m, "TwoStepBDGPU")
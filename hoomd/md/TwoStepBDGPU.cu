@@ -20,7 +20,7 @@ using namespace hoomd;
 
 //! Takes the second half-step forward in the Langevin integration on a group of particles with
 /*! \param d_pos array of particle positions and types
-    \param d_vel array of particle positions and masses
+    \param d_vel array of particle velocities and masses (NULL to leave velocities untouched)
     \param d_image array of particle images
     \param box simulation box
     \param d_diameter array of particle diameters
@@ -36,15 +36,17 @@ using namespace hoomd;
    online documentation) \param d_gamma List of per-type gammas \param n_types Number of particle
    types in the simulation \param use_alpha If true, gamma = alpha * diameter \param alpha Scale
    factor to convert diameter to alpha (when use_alpha is true) \param timestep Current timestep of
-   the simulation \param seed User chosen random number seed \param T Temperature set point \param
-   aniso If set true, the system would go through rigid body updates for its orientation \param
-   deltaT Amount of real time to step forward in one time step \param D Dimensionality of the system
+   the simulation \param seed User chosen random number seed \param T_params Temperature set
+   point \param aniso If set true, the system would go through rigid body updates for its
+   orientation \param deltaT Amount of real time to step forward in one time step \param D
+   Dimensionality of the system
     \param d_noiseless_t If set true, there will be no translational noise (random force)
     \param d_noiseless_r If set true, there will be no rotational noise (random torque)
     \param offset Offset of this GPU into group indices
 
     This kernel is implemented in a very similar manner to gpu_nve_step_one_kernel(), see it for
-   design details.
+   design details. When d_vel is NULL and aniso is false, the kernel only accesses positions,
+   images and net forces (plus tags and drag coefficients).
 
     This kernel must be launched with enough dynamic shared memory per block to read in d_gamma
 */
@@ -68,7 +70,7 @@ extern "C" __global__ void gpu_brownian_step_one_kernel(Scalar4* d_pos,
                                                         const Scalar alpha,
                                                         const uint64_t timestep,
                                                         const uint16_t seed,
-                                                        const Scalar T,
+                                                        const variant_params T_params,
                                                         const bool aniso,
                                                         const Scalar deltaT,
                                                         unsigned int D,
@@ -94,13 +96,15 @@ extern "C" __global__ void gpu_brownian_step_one_kernel(Scalar4* d_pos,
         }
 
     // read in the gamma_r, stored in s_gammas_r[0: n_type], which is s_gamma_r[0:n_type]
-
-    for (int cur_offset = 0; cur_offset < n_types; cur_offset += blockDim.x)
+    if (aniso)
         {
-        if (cur_offset + threadIdx.x < n_types)
-            s_gammas_r[cur_offset + threadIdx.x] = d_gamma_r[cur_offset + threadIdx.x];
+        for (int cur_offset = 0; cur_offset < n_types; cur_offset += blockDim.x)
+            {
+            if (cur_offset + threadIdx.x < n_types)
+                s_gammas_r[cur_offset + threadIdx.x] = d_gamma_r[cur_offset + threadIdx.x];
+            }
+        __syncthreads();
         }
-    __syncthreads();
 
     // determine which particle this thread works on (MEM TRANSFER: 4 bytes)
     int local_idx = blockIdx.x * blockDim.x + threadIdx.x;
@@ -108,11 +112,11 @@ extern "C" __global__ void gpu_brownian_step_one_kernel(Scalar4* d_pos,
     if (local_idx < nwork)
         {
         const unsigned int group_idx = local_idx + offset;
+        const Scalar T = evaluate_variant(T_params, timestep);
 
         // determine the particle to work on
         unsigned int idx = d_group_members[group_idx];
         Scalar4 postype = d_pos[idx];
-        Scalar4 vel = d_vel[idx];
         Scalar4 net_force = d_net_force[idx];
         int3 image = d_image[idx];
 
@@ -122,10 +126,11 @@ extern "C" __global__ void gpu_brownian_step_one_kernel(Scalar4* d_pos,
         // compute the random force
         RandomGenerator rng(hoomd::Seed(RNGIdentifier::TwoStepBD, timestep, seed),
                             hoomd::Counter(ptag));
-        UniformDistribution<Scalar> uniform(Scalar(-1), Scalar(1));
-        Scalar rx = uniform(rng);
-        Scalar ry = uniform(rng);
-        Scalar rz = uniform(rng);
+        Scalar r[3];
+        UniformDistribution<Scalar>(Scalar(-1), Scalar(1))(r, rng);
+        Scalar rx = r[0];
+        Scalar ry = r[1];
+        Scalar rz = r[2];
 
         // calculate the magnitude of the random force
         Scalar gamma;
@@ -162,38 +167,43 @@ extern "C" __global__ void gpu_brownian_step_one_kernel(Scalar4* d_pos,
         // into place
         box.wrap(postype, image);
 
-        if (d_noiseless_t)
-            {
-            vel.x = net_force.x / gamma;
-            vel.y = net_force.y / gamma;
-            if (D > 2)
-                vel.z = net_force.z / gamma;
-            else
-                vel.z = 0;
-            }
-        else
-            {
-            // draw a new random velocity for particle j
-            Scalar mass = vel.w;
-            Scalar sigma = fast::sqrt(T / mass);
-            NormalDistribution<Scalar> normal(sigma);
-            vel.x = normal(rng);
-            vel.y = normal(rng);
-            if (D > 2)
-                vel.z = normal(rng);
-            else
-                vel.z = 0;
-            }
-
         // write out data
         d_pos[idx] = postype;
-        d_vel[idx] = vel;
         d_image[idx] = image;
 
+        if (d_vel)
+            {
+            Scalar4 vel = d_vel[idx];
+            if (d_noiseless_t)
+                {
+                vel.x = net_force.x / gamma;
+                vel.y = net_force.y / gamma;
+                if (D > 2)
+                    vel.z = net_force.z / gamma;
+                else
+                    vel.z = 0;
+                }
+            else
+                {
+                // draw a new random velocity for particle j
+                Scalar mass = vel.w;
+                Scalar sigma = fast::sqrt(T / mass);
+                Scalar v[3];
+                NormalDistribution<Scalar>(sigma)(v, rng);
+                vel.x = v[0];
+                vel.y = v[1];
+                if (D > 2)
+                    vel.z = v[2];
+                else
+                    vel.z = 0;
+                }
+            d_vel[idx] = vel;
+            }
+
         // rotational random force and orientation quaternion updates
         if (aniso)
             {
-            unsigned int type_r = __scalar_as_int(d_pos[idx].w);
+            unsigned int type_r = __scalar_as_int(postype.w);
 
             // gamma_r is stored in the second half of s_gammas a.k.a s_gammas_r
             Scalar3 gamma_r = s_gammas_r[type_r];
@@ -218,10 +228,11 @@ extern "C" __global__ void gpu_brownian_step_one_kernel(Scalar4* d_pos,
 
                 // original Gaussian random torque
                 // Gaussian random distribution is preferred in terms of preserving the exact math
-                vec3<Scalar> bf_torque;
-                bf_torque.x = NormalDistribution<Scalar>(sigma_r.x)(rng);
-                bf_torque.y = NormalDistribution<Scalar>(sigma_r.y)(rng);
-                bf_torque.z = NormalDistribution<Scalar>(sigma_r.z)(rng);
+                Scalar noise[3];
+                NormalDistribution<Scalar>()(noise, rng);
+                vec3<Scalar> bf_torque(noise[0] * sigma_r.x,
+                                       noise[1] * sigma_r.y,
+                                       noise[2] * sigma_r.z);
 
                 if (x_zero)
                     bf_torque.x = 0;
@@ -255,9 +266,10 @@ extern "C" __global__ void gpu_brownian_step_one_kernel(Scalar4* d_pos,
                 else
                     {
                     // draw a new random ang_mom for particle j in body frame
-                    p_vec.x = NormalDistribution<Scalar>(fast::sqrt(T * I.x))(rng);
-                    p_vec.y = NormalDistribution<Scalar>(fast::sqrt(T * I.y))(rng);
-                    p_vec.z = NormalDistribution<Scalar>(fast::sqrt(T * I.z))(rng);
+                    NormalDistribution<Scalar>()(noise, rng);
+                    p_vec.x = noise[0] * fast::sqrt(T * I.x);
+                    p_vec.y = noise[1] * fast::sqrt(T * I.y);
+                    p_vec.z = noise[2] * fast::sqrt(T * I.z);
                     }
 
                 if (x_zero)
@@ -279,7 +291,7 @@ extern "C" __global__ void gpu_brownian_step_one_kernel(Scalar4* d_pos,
     }
 
 /*! \param d_pos array of particle positions and types
-    \param d_vel array of particle positions and masses
+    \param d_vel array of particle velocities and masses (NULL to leave velocities untouched)
     \param d_image array of particle images
     \param box simulation box
     \param d_diameter array of particle diameters
@@ -34,6 +34,9 @@ class PYBIND11_EXPORT TwoStepBDGPU : public TwoStepBD
     //! Performs the second step of the integration
     virtual void integrateStepTwo(uint64_t timestep);
 
+    //! Describe this method to the fused integration kernels
+    virtual bool getFusedParams(uint64_t timestep, fused_method_params& params, Scalar* gamma);
+
     protected:
     unsigned int m_block_size; //!< block size
     };
@@ -63,7 +63,7 @@ void TwoStepBerendsen::integrateStepOne(uint64_t timestep)
         m_prof->push("Berendsen step 1");
 
     // compute the current thermodynamic properties and get the temperature
-    m_thermo->compute(timestep);
+    m_thermo->computeQuantities(timestep, thermo_quantity::kinetic_energy);
     Scalar curr_T = m_thermo->getTranslationalTemperature();
 
     // compute the value of lambda for the current timestep
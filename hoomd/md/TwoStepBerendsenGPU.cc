@@ -48,7 +48,7 @@ void TwoStepBerendsenGPU::integrateStepOne(uint64_t timestep)
         m_prof->push("Berendsen");
 
     // compute the current thermodynamic quantities and get the temperature
-    m_thermo->compute(timestep);
+    m_thermo->computeQuantities(timestep, thermo_quantity::kinetic_energy);
     Scalar curr_T = m_thermo->getTranslationalTemperature();
 
     // compute the value of lambda for the current timestep
@@ -0,0 +1,423 @@
+#include "hip/hip_runtime.h"
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "TwoStepFusedGPU.cuh"
+#include "hoomd/VectorMath.h"
+
+#include "hoomd/RNGIdentifiers.h"
+#include "hoomd/RandomNumbers.h"
+using namespace hoomd;
+
+#include <assert.h>
+
+/*! \file TwoStepFusedGPU.cu
+    \brief Defines GPU kernel code that integrates several methods in one launch. Used by
+   IntegratorTwoStep.
+
+    Each method produces exactly the same result as its own kernel (gpu_nve_step_one_kernel,
+   gpu_langevin_step_two_kernel, gpu_brownian_step_one_kernel), including the random number
+   streams.
+*/
+
+//! Takes the first half-step forward for all particles integrated by fused methods
+/*! \param d_pos array of particle positions
+    \param d_vel array of particle velocities
+    \param d_accel array of particle accelerations
+    \param d_image array of particle images
+    \param d_net_force Net force on each particle
+    \param d_diameter array of particle diameters
+    \param d_tag array of particle tags
+    \param d_method_by_tag Index of the method that integrates each tag, or FUSED_METHOD_NONE
+    \param d_params Parameters of each method
+    \param d_gamma Per-type gammas of each method, indexed by method * n_types + type
+    \param n_types Number of particle types
+    \param nwork Number of particles to process on this GPU
+    \param offset Offset of this GPU into the particle indices
+    \param box Box dimensions for periodic boundary condition handling
+    \param deltaT timestep
+    \param timestep Current timestep of the simulation
+    \param seed User chosen random number seed
+    \param D Dimensionality of the system
+
+    One thread processes one local particle. Threads of particles that belong to no fused method
+   return immediately. NVE and Langevin take the velocity-Verlet first step, Brownian dynamics takes
+   its full step.
+*/
+__global__ void gpu_fused_step_one_kernel(Scalar4* d_pos,
+                                          Scalar4* d_vel,
+                                          const Scalar3* d_accel,
+                                          int3* d_image,
+                                          const Scalar4* d_net_force,
+                                          const Scalar* d_diameter,
+                                          const unsigned int* d_tag,
+                                          const unsigned int* d_method_by_tag,
+                                          const fused_method_params* d_params,
+                                          const Scalar* d_gamma,
+                                          const unsigned int n_types,
+                                          const unsigned int nwork,
+                                          const unsigned int offset,
+                                          BoxDim box,
+                                          Scalar deltaT,
+                                          const uint64_t timestep,
+                                          const uint16_t seed,
+                                          unsigned int D)
+    {
+    int work_idx = blockIdx.x * blockDim.x + threadIdx.x;
+    if (work_idx >= nwork)
+        return;
+
+    const unsigned int idx = work_idx + offset;
+    const unsigned int ptag = d_tag[idx];
+    const unsigned int method = d_method_by_tag[ptag];
+    if (method == FUSED_METHOD_NONE)
+        return;
+
+    const fused_method_params params = d_params[method];
+    Scalar4 postype = d_pos[idx];
+    Scalar4 velmass = d_vel[idx];
+    int3 image = d_image[idx];
+
+    if (params.kind == fused_method_brownian)
+        {
+        Scalar4 net_force = d_net_force[idx];
+        const Scalar T = evaluate_variant(params.T, timestep);
+
+        // compute the random force
+        RandomGenerator rng(hoomd::Seed(RNGIdentifier::TwoStepBD, timestep, seed),
+                            hoomd::Counter(ptag));
+        Scalar r[3];
+        UniformDistribution<Scalar>(Scalar(-1), Scalar(1))(r, rng);
+
+        Scalar gamma;
+        if (params.use_alpha)
+            gamma = params.alpha * d_diameter[idx];
+        else
+            gamma = d_gamma[method * n_types + __scalar_as_int(postype.w)];
+
+        // the extra factor of 3 is because <rx^2> is 1/3 in the uniform -1,1 distribution
+        Scalar coeff = fast::sqrt(Scalar(3.0) * Scalar(2.0) * gamma * T / deltaT);
+        if (params.noiseless_t)
+            coeff = Scalar(0.0);
+        Scalar Fr_x = r[0] * coeff;
+        Scalar Fr_y = r[1] * coeff;
+        Scalar Fr_z = r[2] * coeff;
+
+        if (D < 3)
+            Fr_z = Scalar(0.0);
+
+        postype.x += (net_force.x + Fr_x) * deltaT / gamma;
+        postype.y += (net_force.y + Fr_y) * deltaT / gamma;
+        postype.z += (net_force.z + Fr_z) * deltaT / gamma;
+
+        box.wrap(postype, image);
+
+        if (params.noiseless_t)
+            {
+            velmass.x = net_force.x / gamma;
+            velmass.y = net_force.y / gamma;
+            if (D > 2)
+                velmass.z = net_force.z / gamma;
+            else
+                velmass.z = 0;
+            }
+        else
+            {
+            // draw a new random velocity
+            Scalar sigma = fast::sqrt(T / velmass.w);
+            Scalar v[3];
+            NormalDistribution<Scalar>(sigma)(v, rng);
+            velmass.x = v[0];
+            velmass.y = v[1];
+            if (D > 2)
+                velmass.z = v[2];
+            else
+                velmass.z = 0;
+            }
+
+        d_pos[idx] = postype;
+        d_vel[idx] = velmass;
+        d_image[idx] = image;
+        return;
+        }
+
+    // velocity-Verlet first step, shared by NVE and Langevin
+    Scalar3 pos = make_scalar3(postype.x, postype.y, postype.z);
+    Scalar3 vel = make_scalar3(velmass.x, velmass.y, velmass.z);
+
+    Scalar3 accel = make_scalar3(Scalar(0.0), Scalar(0.0), Scalar(0.0));
+    if (!params.zero_force)
+        accel = d_accel[idx];
+
+    Scalar3 dx = vel * deltaT + (Scalar(1.0) / Scalar(2.0)) * accel * deltaT * deltaT;
+
+    if (params.limit)
+        {
+        Scalar len = sqrtf(dot(dx, dx));
+        if (len > params.limit_val)
+            dx = dx / len * params.limit_val;
+        }
+
+    pos += dx;
+    vel += (Scalar(1.0) / Scalar(2.0)) * accel * deltaT;
+
+    box.wrap(pos, image);
+
+    d_pos[idx] = make_scalar4(pos.x, pos.y, pos.z, postype.w);
+    d_vel[idx] = make_scalar4(vel.x, vel.y, vel.z, velmass.w);
+    d_image[idx] = image;
+    }
+
+//! Takes the second half-step forward for all particles integrated by fused methods
+/*! \param d_pos array of particle positions and types
+    \param d_vel array of particle velocities
+    \param d_accel array of particle accelerations
+    \param d_net_force Net force on each particle
+    \param d_diameter array of particle diameters
+    \param d_tag array of particle tags
+    \param d_method_by_tag Index of the method that integrates each tag, or FUSED_METHOD_NONE
+    \param d_params Parameters of each method
+    \param d_gamma Per-type gammas of each method, indexed by method * n_types + type
+    \param n_types Number of particle types
+    \param nwork Number of particles to process on this GPU
+    \param offset Offset of this GPU into the particle indices
+    \param deltaT timestep
+    \param timestep Current timestep of the simulation
+    \param seed User chosen random number seed
+    \param D Dimensionality of the system
+
+    Brownian dynamics has no second step, its particles are skipped.
+*/
+__global__ void gpu_fused_step_two_kernel(const Scalar4* d_pos,
+                                          Scalar4* d_vel,
+                                          Scalar3* d_accel,
+                                          const Scalar4* d_net_force,
+                                          const Scalar* d_diameter,
+                                          const unsigned int* d_tag,
+                                          const unsigned int* d_method_by_tag,
+                                          const fused_method_params* d_params,
+                                          const Scalar* d_gamma,
+                                          const unsigned int n_types,
+                                          const unsigned int nwork,
+                                          const unsigned int offset,
+                                          Scalar deltaT,
+                                          const uint64_t timestep,
+                                          const uint16_t seed,
+                                          unsigned int D)
+    {
+    int work_idx = blockIdx.x * blockDim.x + threadIdx.x;
+    if (work_idx >= nwork)
+        return;
+
+    const unsigned int idx = work_idx + offset;
+    const unsigned int ptag = d_tag[idx];
+    const unsigned int method = d_method_by_tag[ptag];
+    if (method == FUSED_METHOD_NONE)
+        return;
+
+    const fused_method_params params = d_params[method];
+    if (params.kind == fused_method_brownian)
+        return;
+
+    Scalar4 vel = d_vel[idx];
+    Scalar3 accel = make_scalar3(Scalar(0.0), Scalar(0.0), Scalar(0.0));
+
+    if (params.kind == fused_method_langevin)
+        {
+        Scalar gamma;
+        if (params.use_alpha)
+            gamma = params.alpha * d_diameter[idx];
+        else
+            gamma = d_gamma[method * n_types + __scalar_as_int(d_pos[idx].w)];
+
+        Scalar coeff
+            = sqrtf(Scalar(6.0) * gamma * evaluate_variant(params.T, timestep) / deltaT);
+        Scalar3 bd_force = make_scalar3(Scalar(0.0), Scalar(0.0), Scalar(0.0));
+        if (params.noiseless_t)
+            coeff = Scalar(0.0);
+
+        RandomGenerator rng(hoomd::Seed(RNGIdentifier::TwoStepLangevin, timestep, seed),
+                            hoomd::Counter(ptag));
+        Scalar random[3];
+        UniformDistribution<Scalar>(-1, 1)(random, rng);
+
+        bd_force.x = random[0] * coeff - gamma * vel.x;
+        bd_force.y = random[1] * coeff - gamma * vel.y;
+        if (D > 2)
+            bd_force.z = random[2] * coeff - gamma * vel.z;
+
+        Scalar4 net_force = d_net_force[idx];
+        Scalar minv = Scalar(1.0) / vel.w;
+        accel.x = (net_force.x + bd_force.x) * minv;
+        accel.y = (net_force.y + bd_force.y) * minv;
+        accel.z = (net_force.z + bd_force.z) * minv;
+        }
+    else if (!params.zero_force)
+        {
+        Scalar4 net_force = d_net_force[idx];
+        accel = make_scalar3(net_force.x, net_force.y, net_force.z);
+        Scalar mass = vel.w;
+        accel.x /= mass;
+        accel.y /= mass;
+        accel.z /= mass;
+        }
+
+    // v(t+deltaT) = v(t+deltaT/2) + 1/2 * a(t+deltaT)*deltaT
+    vel.x += (Scalar(1.0) / Scalar(2.0)) * accel.x * deltaT;
+    vel.y += (Scalar(1.0) / Scalar(2.0)) * accel.y * deltaT;
+    vel.z += (Scalar(1.0) / Scalar(2.0)) * accel.z * deltaT;
+
+    if (params.kind == fused_method_nve && params.limit)
+        {
+        Scalar vel_len = sqrtf(vel.x * vel.x + vel.y * vel.y + vel.z * vel.z);
+        if ((vel_len * deltaT) > params.limit_val)
+            {
+            vel.x = vel.x / vel_len * params.limit_val / deltaT;
+            vel.y = vel.y / vel_len * params.limit_val / deltaT;
+            vel.z = vel.z / vel_len * params.limit_val / deltaT;
+            }
+        }
+
+    d_vel[idx] = vel;
+    d_accel[idx] = accel;
+    }
+
+/*! See gpu_fused_step_one_kernel() for full documentation, this function is just a driver.
+
+    \param gpu_partition Load balancing info for the local particles
+    \param block_size Kernel block size
+*/
+hipError_t gpu_fused_step_one(Scalar4* d_pos,
+                              Scalar4* d_vel,
+                              const Scalar3* d_accel,
+                              int3* d_image,
+                              const Scalar4* d_net_force,
+                              const Scalar* d_diameter,
+                              const unsigned int* d_tag,
+                              const unsigned int* d_method_by_tag,
+                              const fused_method_params* d_params,
+                              const Scalar* d_gamma,
+                              unsigned int n_types,
+                              const GPUPartition& gpu_partition,
+                              const BoxDim& box,
+                              Scalar deltaT,
+                              uint64_t timestep,
+                              uint16_t seed,
+                              unsigned int D,
+                              unsigned int block_size)
+    {
+    static unsigned int max_block_size = UINT_MAX;
+    if (max_block_size == UINT_MAX)
+        {
+        hipFuncAttributes attr;
+        hipFuncGetAttributes(&attr, (const void*)gpu_fused_step_one_kernel);
+        max_block_size = attr.maxThreadsPerBlock;
+        }
+
+    unsigned int run_block_size = min(block_size, max_block_size);
+
+    // iterate over active GPUs in reverse, to end up on first GPU when returning from this function
+    for (int idev = gpu_partition.getNumActiveGPUs() - 1; idev >= 0; --idev)
+        {
+        auto range = gpu_partition.getRangeAndSetGPU(idev);
+
+        unsigned int nwork = range.second - range.first;
+
+        dim3 grid((nwork / run_block_size) + 1, 1, 1);
+        dim3 threads(run_block_size, 1, 1);
+
+        hipLaunchKernelGGL((gpu_fused_step_one_kernel),
+                           dim3(grid),
+                           dim3(threads),
+                           0,
+                           0,
+                           d_pos,
+                           d_vel,
+                           d_accel,
+                           d_image,
+                           d_net_force,
+                           d_diameter,
+                           d_tag,
+                           d_method_by_tag,
+                           d_params,
+                           d_gamma,
+                           n_types,
+                           nwork,
+                           range.first,
+                           box,
+                           deltaT,
+                           timestep,
+                           seed,
+                           D);
+        }
+
+    return hipSuccess;
+    }
+
+/*! See gpu_fused_step_two_kernel() for full documentation, this function is just a driver.
+
+    \param gpu_partition Load balancing info for the local particles
+    \param block_size Kernel block size
+*/
+hipError_t gpu_fused_step_two(const Scalar4* d_pos,
+                              Scalar4* d_vel,
+                              Scalar3* d_accel,
+                              const Scalar4* d_net_force,
+                              const Scalar* d_diameter,
+                              const unsigned int* d_tag,
+                              const unsigned int* d_method_by_tag,
+                              const fused_method_params* d_params,
+                              const Scalar* d_gamma,
+                              unsigned int n_types,
+                              const GPUPartition& gpu_partition,
+                              Scalar deltaT,
+                              uint64_t timestep,
+                              uint16_t seed,
+                              unsigned int D,
+                              unsigned int block_size)
+    {
+    static unsigned int max_block_size = UINT_MAX;
+    if (max_block_size == UINT_MAX)
+        {
+        hipFuncAttributes attr;
+        hipFuncGetAttributes(&attr, (const void*)gpu_fused_step_two_kernel);
+        max_block_size = attr.maxThreadsPerBlock;
+        }
+
+    unsigned int run_block_size = min(block_size, max_block_size);
+
+    // iterate over active GPUs in reverse, to end up on first GPU when returning from this function
+    for (int idev = gpu_partition.getNumActiveGPUs() - 1; idev >= 0; --idev)
+        {
+        auto range = gpu_partition.getRangeAndSetGPU(idev);
+
+        unsigned int nwork = range.second - range.first;
+
+        dim3 grid((nwork / run_block_size) + 1, 1, 1);
+        dim3 threads(run_block_size, 1, 1);
+
+        hipLaunchKernelGGL((gpu_fused_step_two_kernel),
+                           dim3(grid),
+                           dim3(threads),
+                           0,
+                           0,
+                           d_pos,
+                           d_vel,
+                           d_accel,
+                           d_net_force,
+                           d_diameter,
+                           d_tag,
+                           d_method_by_tag,
+                           d_params,
+                           d_gamma,
+                           n_types,
+                           nwork,
+                           range.first,
+                           deltaT,
+                           timestep,
+                           seed,
+                           D);
+        }
+
+    return hipSuccess;
+    }
@@ -0,0 +1,81 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file TwoStepFusedGPU.cuh
+    \brief Declares GPU kernel code that integrates several methods in one launch. Used by
+   IntegratorTwoStep.
+*/
+
+#include "hoomd/BoxDim.h"
+#include "hoomd/GPUPartition.cuh"
+#include "hoomd/HOOMDMath.h"
+#include "hoomd/VariantDevice.h"
+
+#ifndef __TWO_STEP_FUSED_GPU_CUH__
+#define __TWO_STEP_FUSED_GPU_CUH__
+
+//! Value of the per-tag method index for particles that are not integrated by the fused kernels
+const unsigned int FUSED_METHOD_NONE = 0xffffffff;
+
+//! Integration methods implemented by the fused kernels
+enum fused_method_kind
+    {
+    fused_method_nve = 0,  //!< Velocity-Verlet (TwoStepNVE)
+    fused_method_langevin, //!< Langevin dynamics (TwoStepLangevin)
+    fused_method_brownian  //!< Brownian dynamics (TwoStepBD)
+    };
+
+//! Parameters of one integration method in the fused kernels
+/*! Per-type drag coefficients are stored separately, see gpu_fused_step_one().
+ */
+struct fused_method_params
+    {
+    unsigned int kind;  //!< One of fused_method_kind
+    variant_params T;   //!< Temperature set point (Langevin and Brownian)
+    Scalar alpha;       //!< Scale factor from diameter to gamma (when use_alpha is set)
+    Scalar limit_val;   //!< Maximum displacement in one step (NVE, when limit is set)
+    bool use_alpha;     //!< Set gamma = alpha * diameter
+    bool noiseless_t;   //!< Disable the random force
+    bool limit;         //!< Limit the displacement in one step (NVE)
+    bool zero_force;    //!< Ignore the net force (NVE)
+    };
+
+//! Kernel driver for the fused first step called by IntegratorTwoStep
+hipError_t gpu_fused_step_one(Scalar4* d_pos,
+                              Scalar4* d_vel,
+                              const Scalar3* d_accel,
+                              int3* d_image,
+                              const Scalar4* d_net_force,
+                              const Scalar* d_diameter,
+                              const unsigned int* d_tag,
+                              const unsigned int* d_method_by_tag,
+                              const fused_method_params* d_params,
+                              const Scalar* d_gamma,
+                              unsigned int n_types,
+                              const GPUPartition& gpu_partition,
+                              const BoxDim& box,
+                              Scalar deltaT,
+                              uint64_t timestep,
+                              uint16_t seed,
+                              unsigned int D,
+                              unsigned int block_size);
+
+//! Kernel driver for the fused second step called by IntegratorTwoStep
+hipError_t gpu_fused_step_two(const Scalar4* d_pos,
+                              Scalar4* d_vel,
+                              Scalar3* d_accel,
+                              const Scalar4* d_net_force,
+                              const Scalar* d_diameter,
+                              const unsigned int* d_tag,
+                              const unsigned int* d_method_by_tag,
+                              const fused_method_params* d_params,
+                              const Scalar* d_gamma,
+                              unsigned int n_types,
+                              const GPUPartition& gpu_partition,
+                              Scalar deltaT,
+                              uint64_t timestep,
+                              uint16_t seed,
+                              unsigned int D,
+                              unsigned int block_size);
+
+#endif //__TWO_STEP_FUSED_GPU_CUH__
@@ -2,11 +2,14 @@
 // This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
 
 #include "TwoStepLangevinBase.h"
+#include "hoomd/RandomNumbers.h"
 
 #ifdef ENABLE_MPI
 #include "hoomd/HOOMDMPI.h"
 #endif
 
+#include <algorithm>
+
 namespace py = pybind11;
 using namespace std;
 
@@ -59,6 +62,59 @@ TwoStepLangevinBase::~TwoStepLangevinBase()
     m_exec_conf->msg->notice(5) << "Destroying TwoStepLangevinBase" << endl;
     }
 
+void TwoStepLangevinBase::drawUniformNoise(uint8_t rng_id, uint64_t timestep)
+    {
+    // lanes per batch, a multiple of the SIMD width
+    const unsigned int batch_size = 8;
+
+    const unsigned int group_size = m_group->getNumMembers();
+    const unsigned int n_batches = (group_size + batch_size - 1) / batch_size;
+    const hoomd::Seed seed(rng_id, timestep, m_sysdef->getSeed());
+
+    if (m_uniform_noise.size() < m_pdata->getN())
+        m_uniform_noise.resize(m_pdata->getN());
+
+    ArrayHandle<unsigned int> h_index(m_group->getIndexArray(),
+                                      access_location::host,
+                                      access_mode::read);
+    ArrayHandle<unsigned int> h_tag(m_pdata->getTags(), access_location::host, access_mode::read);
+
+    auto draw_batch = [&](unsigned int batch)
+    {
+        const unsigned int first = batch * batch_size;
+        const unsigned int n = std::min(batch_size, group_size - first);
+
+        hoomd::RandomGeneratorBatch<batch_size> rng(seed);
+        for (unsigned int i = 0; i < n; i++)
+            rng.setCounter(i, hoomd::Counter(h_tag.data[h_index.data[first + i]]));
+
+        // same order of draws as UniformDistribution<Scalar>()(Scalar (&)[3], rng)
+        Scalar rx[batch_size], ry[batch_size], rz[batch_size];
+        hoomd::UniformDistribution<Scalar> uniform(Scalar(-1), Scalar(1));
+        uniform(rx, ry, rng);
+        uniform(rz, rng);
+
+        for (unsigned int i = 0; i < n; i++)
+            m_uniform_noise[h_index.data[first + i]] = make_scalar3(rx[i], ry[i], rz[i]);
+    };
+
+#ifdef ENABLE_TBB
+    m_exec_conf->getTaskArena()->execute(
+        [&]
+        {
+            tbb::parallel_for(tbb::blocked_range<unsigned int>(0, n_batches),
+                              [&](const tbb::blocked_range<unsigned int>& r)
+                              {
+                                  for (unsigned int batch = r.begin(); batch != r.end(); ++batch)
+                                      draw_batch(batch);
+                              });
+        });
+#else
+    for (unsigned int batch = 0; batch < n_batches; batch++)
+        draw_batch(batch);
+#endif
+    }
+
 void TwoStepLangevinBase::setGamma(const std::string& type_name, Scalar gamma)
     {
     unsigned int typ = this->m_pdata->getTypeByName(type_name);
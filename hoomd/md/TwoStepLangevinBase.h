@@ -4,6 +4,8 @@
 #include "IntegrationMethodTwoStep.h"
 #include "hoomd/Variant.h"
 
+#include <vector>
+
 #pragma once
 
 #ifdef __HIPCC__
@@ -87,6 +89,22 @@ class PYBIND11_EXPORT TwoStepLangevinBase : public IntegrationMethodTwoStep
 
     /// List of per type gamma_r (for 2D-only rotational noise) to use
     GlobalVector<Scalar3> m_gamma_r;
+
+    /// Uniform translational noise of each local particle, filled by drawUniformNoise()
+    std::vector<Scalar3> m_uniform_noise;
+
+    /** Draw the uniform translational noise of every member
+
+        @param rng_id RNG identifier of the integration method
+        @param timestep Current time step
+
+        Sets m_uniform_noise[j] to the three values in [-1, 1] that
+        UniformDistribution<Scalar>(-1, 1) draws for member j from
+        RandomGenerator(Seed(rng_id, timestep, seed), Counter(tag_j)). The members are processed
+        in batches with RandomGeneratorBatch. After the call, a RandomGenerator for member j
+        continues the same stream after discard(2).
+    */
+    void drawUniformNoise(uint8_t rng_id, uint64_t timestep);
     };
 
 //! Exports the TwoStepLangevinBase class to python
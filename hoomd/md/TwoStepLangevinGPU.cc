@@ -200,7 +200,7 @@ void TwoStepLangevinGPU::integrateStepTwo(uint64_t timestep)
         args.n_types = (unsigned int)m_gamma.getNumElements();
         args.use_alpha = m_use_alpha;
         args.alpha = m_alpha;
-        args.T = (*m_T)(timestep);
+        args.T = m_T->getDeviceParams(timestep);
         args.timestep = timestep;
         args.seed = m_sysdef->getSeed();
         args.d_sum_bdenergy = d_sumBD.data;
@@ -284,6 +284,34 @@ void TwoStepLangevinGPU::integrateStepTwo(uint64_t timestep)
         m_prof->pop(m_exec_conf);
     }
 
+/*! \param timestep Current time step
+    \param params Output: parameters of the method
+    \param gamma Output: per-type drag coefficients
+
+    The fused kernels implement the translational update without the reservoir energy tally,
+    anisotropic integration and tallying are not fused.
+*/
+bool TwoStepLangevinGPU::getFusedParams(uint64_t timestep,
+                                        fused_method_params& params,
+                                        Scalar* gamma)
+    {
+    if (m_aniso || m_tally)
+        return false;
+
+    params.kind = fused_method_langevin;
+    params.T = m_T->getDeviceParams(timestep);
+    params.alpha = m_alpha;
+    params.limit_val = Scalar(0.0);
+    params.use_alpha = m_use_alpha;
+    params.noiseless_t = m_noiseless_t;
+    params.limit = false;
+    params.zero_force = false;
+
+    ArrayHandle<Scalar> h_gamma(m_gamma, access_location::host, access_mode::read);
+    std::copy(h_gamma.data, h_gamma.data + m_gamma.getNumElements(), gamma);
+    return true;
+    }
+
 void export_TwoStepLangevinGPU(py::module& m)
     {
     py::class_<TwoStepLangevinGPU, TwoStepLangevin, std::shared_ptr<TwoStepLangevinGPU>>(
@@ -31,7 +31,7 @@ using namespace hoomd;
     \param alpha Scale factor to convert diameter to alpha (when use_alpha is true)
     \param timestep Current timestep of the simulation
     \param seed User chosen random number seed
-    \param T Temperature set point
+    \param T_params Temperature set point, evaluated at \a timestep
     \param deltaT Amount of real time to step forward in one time step
     \param D Dimensionality of the system
     \param tally Boolean indicating whether energy tally is performed or not
@@ -58,7 +58,7 @@ __global__ void gpu_langevin_step_two_kernel(const Scalar4* d_pos,
                                              Scalar alpha,
                                              uint64_t timestep,
                                              uint16_t seed,
-                                             Scalar T,
+                                             const variant_params T_params,
                                              bool noiseless_t,
                                              Scalar deltaT,
                                              unsigned int D,
@@ -111,6 +111,7 @@ __global__ void gpu_langevin_step_two_kernel(const Scalar4* d_pos,
             gamma = s_gammas[typ];
             }
 
+        const Scalar T = evaluate_variant(T_params, timestep);
         Scalar coeff = sqrtf(Scalar(6.0) * gamma * T / deltaT);
         Scalar3 bd_force = make_scalar3(Scalar(0.0), Scalar(0.0), Scalar(0.0));
         if (noiseless_t)
@@ -119,11 +120,12 @@ __global__ void gpu_langevin_step_two_kernel(const Scalar4* d_pos,
         // Initialize the Random Number Generator and generate the 3 random numbers
         RandomGenerator rng(hoomd::Seed(RNGIdentifier::TwoStepLangevin, timestep, seed),
                             hoomd::Counter(ptag));
-        UniformDistribution<Scalar> uniform(-1, 1);
+        Scalar random[3];
+        UniformDistribution<Scalar>(-1, 1)(random, rng);
 
-        Scalar randomx = uniform(rng);
-        Scalar randomy = uniform(rng);
-        Scalar randomz = uniform(rng);
+        Scalar randomx = random[0];
+        Scalar randomy = random[1];
+        Scalar randomz = random[2];
 
         bd_force.x = randomx * coeff - gamma * vel.x;
         bd_force.y = randomy * coeff - gamma * vel.y;
@@ -234,7 +236,7 @@ gpu_bdtally_reduce_partial_sum_kernel(Scalar* d_sum, Scalar* d_partial_sum, unsi
     \param group_size Number of members in the group
     \param timestep Current timestep of the simulation
     \param seed User chosen random number seed
-    \param T Temperature set point
+    \param T_params Temperature set point, evaluated at \a timestep
     \param d_noiseless_r If set true, there will be no rotational noise (random torque)
     \param deltaT integration time step size
     \param D dimensionality of the system
@@ -252,7 +254,7 @@ __global__ void gpu_langevin_angular_step_two_kernel(const Scalar4* d_pos,
                                                      unsigned int group_size,
                                                      uint64_t timestep,
                                                      uint16_t seed,
-                                                     Scalar T,
+                                                     const variant_params T_params,
                                                      bool noiseless_r,
                                                      Scalar deltaT,
                                                      unsigned int D,
@@ -297,6 +299,7 @@ __global__ void gpu_langevin_angular_step_two_kernel(const Scalar4* d_pos,
             // original Gaussian random torque
             // for future reference: if gamma_r is different for xyz, then we need to generate 3
             // sigma_r
+            const Scalar T = evaluate_variant(T_params, timestep);
             Scalar3 sigma_r = make_scalar3(fast::sqrt(Scalar(2.0) * gamma_r.x * T / deltaT),
                                            fast::sqrt(Scalar(2.0) * gamma_r.y * T / deltaT),
                                            fast::sqrt(Scalar(2.0) * gamma_r.z * T / deltaT));
@@ -305,9 +308,11 @@ __global__ void gpu_langevin_angular_step_two_kernel(const Scalar4* d_pos,
 
             RandomGenerator rng(hoomd::Seed(RNGIdentifier::TwoStepLangevinAngular, timestep, seed),
                                 hoomd::Counter(ptag));
-            Scalar rand_x = NormalDistribution<Scalar>(sigma_r.x)(rng);
-            Scalar rand_y = NormalDistribution<Scalar>(sigma_r.y)(rng);
-            Scalar rand_z = NormalDistribution<Scalar>(sigma_r.z)(rng);
+            Scalar noise[3];
+            NormalDistribution<Scalar>()(noise, rng);
+            Scalar rand_x = noise[0] * sigma_r.x;
+            Scalar rand_y = noise[1] * sigma_r.y;
+            Scalar rand_z = noise[2] * sigma_r.z;
 
             // check for zero moment of inertia
             bool x_zero, y_zero, z_zero;
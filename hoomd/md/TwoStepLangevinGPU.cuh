@@ -9,6 +9,7 @@
 
 #include "hoomd/HOOMDMath.h"
 #include "hoomd/ParticleData.cuh"
+#include "hoomd/VariantDevice.h"
 #include <hip/hip_runtime.h>
 
 #ifndef __TWO_STEP_LANGEVIN_GPU_CUH__
@@ -21,7 +22,7 @@ struct langevin_step_two_args
     unsigned int n_types;           //!< Number of types in \a d_gamma
     bool use_alpha;                 //!< Set to true to scale diameters by alpha to get gamma
     Scalar alpha;                   //!< Scale factor to convert diameter to alpha
-    Scalar T;                       //!< Current temperature
+    variant_params T;               //!< Temperature set point
     uint64_t timestep;              //!< Current timestep
     uint16_t seed;                  //!< User chosen random number seed
     Scalar* d_sum_bdenergy;         //!< Energy transfer sum from bd thermal reservoir
@@ -32,6 +32,9 @@ class PYBIND11_EXPORT TwoStepLangevinGPU : public TwoStepLangevin
     //! Performs the second step of the integration
     virtual void integrateStepTwo(uint64_t timestep);
 
+    //! Describe this method to the fused integration kernels
+    virtual bool getFusedParams(uint64_t timestep, fused_method_params& params, Scalar* gamma);
+
     //! Set autotuner parameters
     /*! \param enable Enable/disable autotuning
         \param period period (approximate) in time steps when returning occurs
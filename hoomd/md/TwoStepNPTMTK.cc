@@ -710,11 +710,29 @@ std::vector<bool> TwoStepNPTMTK::getFlags()
 //! Helper function to advance the barostat parameters
 void TwoStepNPTMTK::advanceBarostat(uint64_t timestep)
     {
+    couplingMode couple = getRelevantCouplings();
+    unsigned int d = m_sysdef->getNDimensions();
+
+    // a fully coupled barostat without shear only needs the isotropic pressure
+    const bool isotropic
+        = d == 3 && couple == couple_xyz && !(m_flags & (baro_xy | baro_xz | baro_yz));
+
     // compute thermodynamic properties at full time step
-    m_thermo_full_step->compute(timestep);
+    m_thermo_full_step->computeQuantities(timestep,
+                                          isotropic ? thermo_quantity::pressure
+                                                    : thermo_quantity::pressure_tensor);
 
     // compute pressure for the next half time step
-    PressureTensor P = m_thermo_full_step->getPressureTensor();
+    PressureTensor P;
+    if (isotropic)
+        {
+        P.xx = P.yy = P.zz = m_thermo_full_step->getPressure();
+        P.xy = P.xz = P.yz = Scalar(0.0);
+        }
+    else
+        {
+        P = m_thermo_full_step->getPressureTensor();
+        }
 
     if (std::isnan(P.xx) || std::isnan(P.xy) || std::isnan(P.xz) || std::isnan(P.yy)
         || std::isnan(P.yz) || std::isnan(P.zz))
@@ -729,13 +747,10 @@ void TwoStepNPTMTK::advanceBarostat(uint64_t timestep)
 
     // advance barostat (nuxx, nuyy, nuzz) half a time step
     // Martyna-Tobias-Klein correction
-    unsigned int d = m_sysdef->getNDimensions();
     Scalar W = (Scalar)(m_ndof + d) / (Scalar)d * (*m_T)(timestep)*m_tauS * m_tauS;
     Scalar mtk_term = Scalar(2.0) * m_thermo_full_step->getTranslationalKineticEnergy();
     mtk_term *= Scalar(1.0 / 2.0) * m_deltaT / (Scalar)m_ndof / W;
 
-    couplingMode couple = getRelevantCouplings();
-
     // couple diagonal elements of pressure tensor together
     Scalar3 P_diag = make_scalar3(0.0, 0.0, 0.0);
 
@@ -834,7 +849,10 @@ void TwoStepNPTMTK::advanceThermostat(uint64_t timestep)
     Scalar& xi = v.variable[1];
 
     // compute the current thermodynamic properties
-    m_thermo_half_step->compute(timestep);
+    m_thermo_half_step->computeQuantities(
+        timestep,
+        thermo_quantity::kinetic_energy
+            | (m_aniso ? thermo_quantity::rotational_kinetic_energy : 0));
 
     Scalar curr_T_trans = m_thermo_half_step->getTranslationalTemperature();
     Scalar T = (*m_T)(timestep);
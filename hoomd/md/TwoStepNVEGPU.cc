@@ -218,6 +218,28 @@ void TwoStepNVEGPU::integrateStepTwo(uint64_t timestep)
         m_prof->pop(m_exec_conf);
     }
 
+/*! \param timestep Current time step
+    \param params Output: parameters of the method
+    \param gamma Output: per-type drag coefficients (unused)
+
+    The fused kernels implement the translational update, anisotropic integration is not fused.
+*/
+bool TwoStepNVEGPU::getFusedParams(uint64_t timestep, fused_method_params& params, Scalar* gamma)
+    {
+    if (m_aniso)
+        return false;
+
+    params.kind = fused_method_nve;
+    params.T = variant_params();
+    params.alpha = Scalar(0.0);
+    params.limit_val = m_limit_val;
+    params.use_alpha = false;
+    params.noiseless_t = false;
+    params.limit = m_limit;
+    params.zero_force = m_zero_force;
+    return true;
+    }
+
 void export_TwoStepNVEGPU(py::module& m)
     {
     py::class_<TwoStepNVEGPU, TwoStepNVE, std::shared_ptr<TwoStepNVEGPU>>(m, "TwoStepNVEGPU")
@@ -67,8 +67,6 @@ void TwoStepNVTMTK::integrateStepOne(uint64_t timestep)
         throw std::runtime_error("Error during NVT integration.");
         }
 
-    unsigned int group_size = m_group->getNumMembers();
-
     // profile this step
     if (m_prof)
         {
@@ -87,32 +85,31 @@ void TwoStepNVTMTK::integrateStepOne(uint64_t timestep)
                                    access_location::host,
                                    access_mode::readwrite);
 
-        for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
+        forEachMember(
+            [&](unsigned int j)
             {
-            unsigned int j = m_group->getMemberIndex(group_idx);
+                // load variables
+                Scalar3 v = make_scalar3(h_vel.data[j].x, h_vel.data[j].y, h_vel.data[j].z);
+                Scalar3 pos = make_scalar3(h_pos.data[j].x, h_pos.data[j].y, h_pos.data[j].z);
+                Scalar3 accel = h_accel.data[j];
 
-            // load variables
-            Scalar3 v = make_scalar3(h_vel.data[j].x, h_vel.data[j].y, h_vel.data[j].z);
-            Scalar3 pos = make_scalar3(h_pos.data[j].x, h_pos.data[j].y, h_pos.data[j].z);
-            Scalar3 accel = h_accel.data[j];
+                // update velocity and position
+                v = v + Scalar(1.0 / 2.0) * accel * m_deltaT;
 
-            // update velocity and position
-            v = v + Scalar(1.0 / 2.0) * accel * m_deltaT;
+                // rescale velocity
+                v *= m_exp_thermo_fac;
 
-            // rescale velocity
-            v *= m_exp_thermo_fac;
+                pos += m_deltaT * v;
 
-            pos += m_deltaT * v;
+                // store updated variables
+                h_vel.data[j].x = v.x;
+                h_vel.data[j].y = v.y;
+                h_vel.data[j].z = v.z;
 
-            // store updated variables
-            h_vel.data[j].x = v.x;
-            h_vel.data[j].y = v.y;
-            h_vel.data[j].z = v.z;
-
-            h_pos.data[j].x = pos.x;
-            h_pos.data[j].y = pos.y;
-            h_pos.data[j].z = pos.z;
-            }
+                h_pos.data[j].x = pos.x;
+                h_pos.data[j].y = pos.y;
+                h_pos.data[j].z = pos.z;
+            });
 
         // particles may have been moved slightly outside the box by the above steps, wrap them back
         // into place
@@ -122,12 +119,12 @@ void TwoStepNVTMTK::integrateStepOne(uint64_t timestep)
                                   access_location::host,
                                   access_mode::readwrite);
 
-        for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
+        forEachMember(
+            [&](unsigned int j)
             {
-            unsigned int j = m_group->getMemberIndex(group_idx);
-            // wrap the particles around the box
-            box.wrap(h_pos.data[j], h_image.data[j]);
-            }
+                // wrap the particles around the box
+                box.wrap(h_pos.data[j], h_image.data[j]);
+            });
         }
 
     // Integration of angular degrees of freedom using symplectic and
@@ -152,111 +149,110 @@ void TwoStepNVTMTK::integrateStepOne(uint64_t timestep)
                                        access_location::host,
                                        access_mode::read);
 
-        for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
+        forEachMember(
+            [&](unsigned int j)
             {
-            unsigned int j = m_group->getMemberIndex(group_idx);
-
-            quat<Scalar> q(h_orientation.data[j]);
-            quat<Scalar> p(h_angmom.data[j]);
-            vec3<Scalar> t(h_net_torque.data[j]);
-            vec3<Scalar> I(h_inertia.data[j]);
-
-            // rotate torque into principal frame
-            t = rotate(conj(q), t);
-
-            // check for zero moment of inertia
-            bool x_zero, y_zero, z_zero;
-            x_zero = (I.x < EPSILON);
-            y_zero = (I.y < EPSILON);
-            z_zero = (I.z < EPSILON);
-
-            // ignore torque component along an axis for which the moment of inertia zero
-            if (x_zero)
-                t.x = 0;
-            if (y_zero)
-                t.y = 0;
-            if (z_zero)
-                t.z = 0;
-
-            // advance p(t)->p(t+deltaT/2), q(t)->q(t+deltaT)
-            // using Trotter factorization of rotation Liouvillian
-            p += m_deltaT * q * t;
-
-            // apply thermostat
-            p = p * exp_fac;
-
-            quat<Scalar> p1, p2, p3; // permutated quaternions
-            quat<Scalar> q1, q2, q3;
-            Scalar phi1, cphi1, sphi1;
-            Scalar phi2, cphi2, sphi2;
-            Scalar phi3, cphi3, sphi3;
-
-            if (!z_zero)
-                {
-                p3 = quat<Scalar>(-p.v.z, vec3<Scalar>(p.v.y, -p.v.x, p.s));
-                q3 = quat<Scalar>(-q.v.z, vec3<Scalar>(q.v.y, -q.v.x, q.s));
-                phi3 = Scalar(1. / 4.) / I.z * dot(p, q3);
-                cphi3 = slow::cos(Scalar(1. / 2.) * m_deltaT * phi3);
-                sphi3 = slow::sin(Scalar(1. / 2.) * m_deltaT * phi3);
-
-                p = cphi3 * p + sphi3 * p3;
-                q = cphi3 * q + sphi3 * q3;
-                }
-
-            if (!y_zero)
-                {
-                p2 = quat<Scalar>(-p.v.y, vec3<Scalar>(-p.v.z, p.s, p.v.x));
-                q2 = quat<Scalar>(-q.v.y, vec3<Scalar>(-q.v.z, q.s, q.v.x));
-                phi2 = Scalar(1. / 4.) / I.y * dot(p, q2);
-                cphi2 = slow::cos(Scalar(1. / 2.) * m_deltaT * phi2);
-                sphi2 = slow::sin(Scalar(1. / 2.) * m_deltaT * phi2);
-
-                p = cphi2 * p + sphi2 * p2;
-                q = cphi2 * q + sphi2 * q2;
-                }
-
-            if (!x_zero)
-                {
-                p1 = quat<Scalar>(-p.v.x, vec3<Scalar>(p.s, p.v.z, -p.v.y));
-                q1 = quat<Scalar>(-q.v.x, vec3<Scalar>(q.s, q.v.z, -q.v.y));
-                phi1 = Scalar(1. / 4.) / I.x * dot(p, q1);
-                cphi1 = slow::cos(m_deltaT * phi1);
-                sphi1 = slow::sin(m_deltaT * phi1);
-
-                p = cphi1 * p + sphi1 * p1;
-                q = cphi1 * q + sphi1 * q1;
-                }
-
-            if (!y_zero)
-                {
-                p2 = quat<Scalar>(-p.v.y, vec3<Scalar>(-p.v.z, p.s, p.v.x));
-                q2 = quat<Scalar>(-q.v.y, vec3<Scalar>(-q.v.z, q.s, q.v.x));
-                phi2 = Scalar(1. / 4.) / I.y * dot(p, q2);
-                cphi2 = slow::cos(Scalar(1. / 2.) * m_deltaT * phi2);
-                sphi2 = slow::sin(Scalar(1. / 2.) * m_deltaT * phi2);
-
-                p = cphi2 * p + sphi2 * p2;
-                q = cphi2 * q + sphi2 * q2;
-                }
-
-            if (!z_zero)
-                {
-                p3 = quat<Scalar>(-p.v.z, vec3<Scalar>(p.v.y, -p.v.x, p.s));
-                q3 = quat<Scalar>(-q.v.z, vec3<Scalar>(q.v.y, -q.v.x, q.s));
-                phi3 = Scalar(1. / 4.) / I.z * dot(p, q3);
-                cphi3 = slow::cos(Scalar(1. / 2.) * m_deltaT * phi3);
-                sphi3 = slow::sin(Scalar(1. / 2.) * m_deltaT * phi3);
-
-                p = cphi3 * p + sphi3 * p3;
-                q = cphi3 * q + sphi3 * q3;
-                }
-
-            // renormalize (improves stability)
-            q = q * (Scalar(1.0) / slow::sqrt(norm2(q)));
-
-            h_orientation.data[j] = quat_to_scalar4(q);
-            h_angmom.data[j] = quat_to_scalar4(p);
-            }
+                quat<Scalar> q(h_orientation.data[j]);
+                quat<Scalar> p(h_angmom.data[j]);
+                vec3<Scalar> t(h_net_torque.data[j]);
+                vec3<Scalar> I(h_inertia.data[j]);
+
+                // rotate torque into principal frame
+                t = rotate(conj(q), t);
+
+                // check for zero moment of inertia
+                bool x_zero, y_zero, z_zero;
+                x_zero = (I.x < EPSILON);
+                y_zero = (I.y < EPSILON);
+                z_zero = (I.z < EPSILON);
+
+                // ignore torque component along an axis for which the moment of inertia zero
+                if (x_zero)
+                    t.x = 0;
+                if (y_zero)
+                    t.y = 0;
+                if (z_zero)
+                    t.z = 0;
+
+                // advance p(t)->p(t+deltaT/2), q(t)->q(t+deltaT)
+                // using Trotter factorization of rotation Liouvillian
+                p += m_deltaT * q * t;
+
+                // apply thermostat
+                p = p * exp_fac;
+
+                quat<Scalar> p1, p2, p3; // permutated quaternions
+                quat<Scalar> q1, q2, q3;
+                Scalar phi1, cphi1, sphi1;
+                Scalar phi2, cphi2, sphi2;
+                Scalar phi3, cphi3, sphi3;
+
+                if (!z_zero)
+                    {
+                    p3 = quat<Scalar>(-p.v.z, vec3<Scalar>(p.v.y, -p.v.x, p.s));
+                    q3 = quat<Scalar>(-q.v.z, vec3<Scalar>(q.v.y, -q.v.x, q.s));
+                    phi3 = Scalar(1. / 4.) / I.z * dot(p, q3);
+                    cphi3 = slow::cos(Scalar(1. / 2.) * m_deltaT * phi3);
+                    sphi3 = slow::sin(Scalar(1. / 2.) * m_deltaT * phi3);
+
+                    p = cphi3 * p + sphi3 * p3;
+                    q = cphi3 * q + sphi3 * q3;
+                    }
+
+                if (!y_zero)
+                    {
+                    p2 = quat<Scalar>(-p.v.y, vec3<Scalar>(-p.v.z, p.s, p.v.x));
+                    q2 = quat<Scalar>(-q.v.y, vec3<Scalar>(-q.v.z, q.s, q.v.x));
+                    phi2 = Scalar(1. / 4.) / I.y * dot(p, q2);
+                    cphi2 = slow::cos(Scalar(1. / 2.) * m_deltaT * phi2);
+                    sphi2 = slow::sin(Scalar(1. / 2.) * m_deltaT * phi2);
+
+                    p = cphi2 * p + sphi2 * p2;
+                    q = cphi2 * q + sphi2 * q2;
+                    }
+
+                if (!x_zero)
+                    {
+                    p1 = quat<Scalar>(-p.v.x, vec3<Scalar>(p.s, p.v.z, -p.v.y));
+                    q1 = quat<Scalar>(-q.v.x, vec3<Scalar>(q.s, q.v.z, -q.v.y));
+                    phi1 = Scalar(1. / 4.) / I.x * dot(p, q1);
+                    cphi1 = slow::cos(m_deltaT * phi1);
+                    sphi1 = slow::sin(m_deltaT * phi1);
+
+                    p = cphi1 * p + sphi1 * p1;
+                    q = cphi1 * q + sphi1 * q1;
+                    }
+
+                if (!y_zero)
+                    {
+                    p2 = quat<Scalar>(-p.v.y, vec3<Scalar>(-p.v.z, p.s, p.v.x));
+                    q2 = quat<Scalar>(-q.v.y, vec3<Scalar>(-q.v.z, q.s, q.v.x));
+                    phi2 = Scalar(1. / 4.) / I.y * dot(p, q2);
+                    cphi2 = slow::cos(Scalar(1. / 2.) * m_deltaT * phi2);
+                    sphi2 = slow::sin(Scalar(1. / 2.) * m_deltaT * phi2);
+
+                    p = cphi2 * p + sphi2 * p2;
+                    q = cphi2 * q + sphi2 * q2;
+                    }
+
+                if (!z_zero)
+                    {
+                    p3 = quat<Scalar>(-p.v.z, vec3<Scalar>(p.v.y, -p.v.x, p.s));
+                    q3 = quat<Scalar>(-q.v.z, vec3<Scalar>(q.v.y, -q.v.x, q.s));
+                    phi3 = Scalar(1. / 4.) / I.z * dot(p, q3);
+                    cphi3 = slow::cos(Scalar(1. / 2.) * m_deltaT * phi3);
+                    sphi3 = slow::sin(Scalar(1. / 2.) * m_deltaT * phi3);
+
+                    p = cphi3 * p + sphi3 * p3;
+                    q = cphi3 * q + sphi3 * q3;
+                    }
+
+                // renormalize (improves stability)
+                q = q * (Scalar(1.0) / slow::sqrt(norm2(q)));
+
+                h_orientation.data[j] = quat_to_scalar4(q);
+                h_angmom.data[j] = quat_to_scalar4(p);
+            });
         }
 
     // get temperature and advance thermostat
@@ -272,8 +268,6 @@ void TwoStepNVTMTK::integrateStepOne(uint64_t timestep)
 */
 void TwoStepNVTMTK::integrateStepTwo(uint64_t timestep)
     {
-    unsigned int group_size = m_group->getNumMembers();
-
     const GlobalArray<Scalar4>& net_force = m_pdata->getNetForce();
 
     // profile this step
@@ -291,35 +285,34 @@ void TwoStepNVTMTK::integrateStepTwo(uint64_t timestep)
 
     // perform second half step of Nose-Hoover integration
 
-    for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
+    forEachMember(
+        [&](unsigned int j)
         {
-        unsigned int j = m_group->getMemberIndex(group_idx);
-
-        // load velocity
-        Scalar3 v = make_scalar3(h_vel.data[j].x, h_vel.data[j].y, h_vel.data[j].z);
-        Scalar3 accel = h_accel.data[j];
-        Scalar3 net_force
-            = make_scalar3(h_net_force.data[j].x, h_net_force.data[j].y, h_net_force.data[j].z);
+            // load velocity
+            Scalar3 v = make_scalar3(h_vel.data[j].x, h_vel.data[j].y, h_vel.data[j].z);
+            Scalar3 accel = h_accel.data[j];
+            Scalar3 net_force
+                = make_scalar3(h_net_force.data[j].x, h_net_force.data[j].y, h_net_force.data[j].z);
 
-        // first, calculate acceleration from the net force
-        Scalar m = h_vel.data[j].w;
-        Scalar minv = Scalar(1.0) / m;
-        accel = net_force * minv;
+            // first, calculate acceleration from the net force
+            Scalar m = h_vel.data[j].w;
+            Scalar minv = Scalar(1.0) / m;
+            accel = net_force * minv;
 
-        // rescale velocity
-        v *= m_exp_thermo_fac;
+            // rescale velocity
+            v *= m_exp_thermo_fac;
 
-        // update velocity
-        v += Scalar(1.0 / 2.0) * m_deltaT * accel;
+            // update velocity
+            v += Scalar(1.0 / 2.0) * m_deltaT * accel;
 
-        // store velocity
-        h_vel.data[j].x = v.x;
-        h_vel.data[j].y = v.y;
-        h_vel.data[j].z = v.z;
+            // store velocity
+            h_vel.data[j].x = v.x;
+            h_vel.data[j].y = v.y;
+            h_vel.data[j].z = v.z;
 
-        // store acceleration
-        h_accel.data[j] = accel;
-        }
+            // store acceleration
+            h_accel.data[j] = accel;
+        });
 
     if (m_aniso)
         {
@@ -341,40 +334,39 @@ void TwoStepNVTMTK::integrateStepTwo(uint64_t timestep)
                                        access_location::host,
                                        access_mode::read);
 
-        for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
+        forEachMember(
+            [&](unsigned int j)
             {
-            unsigned int j = m_group->getMemberIndex(group_idx);
-
-            quat<Scalar> q(h_orientation.data[j]);
-            quat<Scalar> p(h_angmom.data[j]);
-            vec3<Scalar> t(h_net_torque.data[j]);
-            vec3<Scalar> I(h_inertia.data[j]);
-
-            // rotate torque into principal frame
-            t = rotate(conj(q), t);
-
-            // check for zero moment of inertia
-            bool x_zero, y_zero, z_zero;
-            x_zero = (I.x < EPSILON);
-            y_zero = (I.y < EPSILON);
-            z_zero = (I.z < EPSILON);
-
-            // ignore torque component along an axis for which the moment of inertia zero
-            if (x_zero)
-                t.x = 0;
-            if (y_zero)
-                t.y = 0;
-            if (z_zero)
-                t.z = 0;
-
-            // apply thermostat
-            p = p * exp_fac;
-
-            // advance p(t+deltaT/2)->p(t+deltaT)
-            p += m_deltaT * q * t;
-
-            h_angmom.data[j] = quat_to_scalar4(p);
-            }
+                quat<Scalar> q(h_orientation.data[j]);
+                quat<Scalar> p(h_angmom.data[j]);
+                vec3<Scalar> t(h_net_torque.data[j]);
+                vec3<Scalar> I(h_inertia.data[j]);
+
+                // rotate torque into principal frame
+                t = rotate(conj(q), t);
+
+                // check for zero moment of inertia
+                bool x_zero, y_zero, z_zero;
+                x_zero = (I.x < EPSILON);
+                y_zero = (I.y < EPSILON);
+                z_zero = (I.z < EPSILON);
+
+                // ignore torque component along an axis for which the moment of inertia zero
+                if (x_zero)
+                    t.x = 0;
+                if (y_zero)
+                    t.y = 0;
+                if (z_zero)
+                    t.z = 0;
+
+                // apply thermostat
+                p = p * exp_fac;
+
+                // advance p(t+deltaT/2)->p(t+deltaT)
+                p += m_deltaT * q * t;
+
+                h_angmom.data[j] = quat_to_scalar4(p);
+            });
         }
 
     // done profiling
@@ -389,7 +381,9 @@ void TwoStepNVTMTK::advanceThermostat(uint64_t timestep, bool broadcast)
     Scalar& eta = v.variable[1];
 
     // compute the current thermodynamic properties
-    m_thermo->compute(timestep + 1);
+    m_thermo->computeQuantities(timestep + 1,
+                                thermo_quantity::kinetic_energy
+                                    | (m_aniso ? thermo_quantity::rotational_kinetic_energy : 0));
 
     Scalar curr_T_trans = m_thermo->getTranslationalTemperature();
 
@@ -450,6 +444,7 @@ void TwoStepNVTMTK::thermalizeThermostatDOF(uint64_t timestep)
     {
     m_exec_conf->msg->notice(6) << "TwoStepNVTMTK randomizing thermostat DOF" << std::endl;
 
+    syncThermostatToHost();
     IntegratorVariables v = getIntegratorVariables();
     Scalar& xi = v.variable[0];
 
@@ -501,11 +496,13 @@ void TwoStepNVTMTK::thermalizeThermostatDOF(uint64_t timestep)
         }
 
     setIntegratorVariables(v);
+    thermostatChangedOnHost();
     }
 
 pybind11::tuple TwoStepNVTMTK::getTranslationalThermostatDOF()
     {
     pybind11::list result;
+    syncThermostatToHost();
     IntegratorVariables v = getIntegratorVariables();
 
     Scalar& xi = v.variable[0];
@@ -524,6 +521,7 @@ void TwoStepNVTMTK::setTranslationalThermostatDOF(pybind11::tuple v)
         throw std::length_error("translational_thermostat_dof must have length 2");
         }
 
+    syncThermostatToHost();
     IntegratorVariables vars = getIntegratorVariables();
 
     Scalar& xi = vars.variable[0];
@@ -533,11 +531,13 @@ void TwoStepNVTMTK::setTranslationalThermostatDOF(pybind11::tuple v)
     eta = pybind11::cast<Scalar>(v[1]);
 
     setIntegratorVariables(vars);
+    thermostatChangedOnHost();
     }
 
 pybind11::tuple TwoStepNVTMTK::getRotationalThermostatDOF()
     {
     pybind11::list result;
+    syncThermostatToHost();
     IntegratorVariables v = getIntegratorVariables();
 
     Scalar& xi_rot = v.variable[2];
@@ -556,6 +556,7 @@ void TwoStepNVTMTK::setRotationalThermostatDOF(pybind11::tuple v)
         throw std::length_error("rotational_thermostat_dof must have length 2");
         }
 
+    syncThermostatToHost();
     IntegratorVariables vars = getIntegratorVariables();
 
     Scalar& xi_rot = vars.variable[2];
@@ -565,11 +566,13 @@ void TwoStepNVTMTK::setRotationalThermostatDOF(pybind11::tuple v)
     eta_rot = pybind11::cast<Scalar>(v[1]);
 
     setIntegratorVariables(vars);
+    thermostatChangedOnHost();
     }
 
 Scalar TwoStepNVTMTK::getThermostatEnergy(uint64_t timestep)
     {
     Scalar translation_dof = m_group->getTranslationalDOF();
+    syncThermostatToHost();
     IntegratorVariables integrator_variables = getIntegratorVariables();
     Scalar& xi = integrator_variables.variable[0];
     Scalar& eta = integrator_variables.variable[1];
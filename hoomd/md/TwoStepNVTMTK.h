@@ -78,10 +78,12 @@ class PYBIND11_EXPORT TwoStepNVTMTK : public IntegrationMethodTwoStep
     //! Set the value of xi (for unit tests)
     void setXi(Scalar new_xi)
         {
+        syncThermostatToHost();
         IntegratorVariables v = getIntegratorVariables();
         Scalar& xi = v.variable[0];
         xi = new_xi;
         setIntegratorVariables(v);
+        thermostatChangedOnHost();
         }
 
     //! Performs the first step of the integration
@@ -113,6 +115,7 @@ class PYBIND11_EXPORT TwoStepNVTMTK : public IntegrationMethodTwoStep
         v.variable[2] = Scalar(0.0);
         v.variable[3] = Scalar(0.0);
         setIntegratorVariables(v);
+        thermostatChangedOnHost();
         }
 
     /// Randomize the thermostat variables
@@ -158,6 +161,15 @@ class PYBIND11_EXPORT TwoStepNVTMTK : public IntegrationMethodTwoStep
      * \param broadcast True if we should broadcast the integrator variables via MPI
      */
     void advanceThermostat(uint64_t timestep, bool broadcast = true);
+
+    //! Make the integrator variables and m_exp_thermo_fac current on the host
+    /*! Derived classes that advance the thermostat elsewhere override this and copy their state
+        into the integrator variables.
+    */
+    virtual void syncThermostatToHost() { }
+
+    //! Notify derived classes that the host changed the integrator variables
+    virtual void thermostatChangedOnHost() { }
     };
 
 //! Exports the TwoStepNVTMTK class to python
@@ -31,7 +31,8 @@ TwoStepNVTMTKGPU::TwoStepNVTMTKGPU(std::shared_ptr<SystemDefinition> sysdef,
                                    std::shared_ptr<ComputeThermo> thermo,
                                    Scalar tau,
                                    std::shared_ptr<Variant> T)
-    : TwoStepNVTMTK(sysdef, group, thermo, tau, T)
+    : TwoStepNVTMTK(sysdef, group, thermo, tau, T), m_device_state_current(false),
+      m_host_state_current(true), m_device_step(false)
     {
     // only one GPU is supported
     if (!m_exec_conf->isCUDAEnabled())
@@ -54,6 +55,56 @@ TwoStepNVTMTKGPU::TwoStepNVTMTKGPU(std::shared_ptr<SystemDefinition> sysdef,
         new Autotuner(valid_params, 5, 100000, "nvt_mtk_angular_one", this->m_exec_conf));
     m_tuner_angular_two.reset(
         new Autotuner(valid_params, 5, 100000, "nvt_mtk_angular_two", this->m_exec_conf));
+
+    // the block reduction in step one requires power of two block sizes
+    std::vector<unsigned int> valid_params_reduce;
+    for (unsigned int block_size = warp_size; block_size <= 1024; block_size *= 2)
+        valid_params_reduce.push_back(block_size);
+
+    m_tuner_one_reduce.reset(new Autotuner(valid_params_reduce,
+                                           5,
+                                           100000,
+                                           "nvt_mtk_step_one_reduce",
+                                           this->m_exec_conf));
+
+    GPUArray<Scalar> thermostat_state(3, m_exec_conf);
+    m_thermostat_state.swap(thermostat_state);
+    }
+
+/*! The device thermostat reduces the kinetic energy in the step one kernel, so it is limited to the
+    translational degrees of freedom of a group on a single GPU and MPI rank.
+*/
+bool TwoStepNVTMTKGPU::useDeviceThermostat()
+    {
+    if (m_aniso || m_exec_conf->getNumActiveGPUs() != 1)
+        return false;
+
+#ifdef ENABLE_MPI
+    if (m_comm)
+        return false;
+#endif
+
+    return true;
+    }
+
+/*! Read xi, eta, and the rescaling factor back from the device after the thermostat has been
+    advanced there.
+*/
+void TwoStepNVTMTKGPU::syncThermostatToHost()
+    {
+    if (m_host_state_current)
+        return;
+
+    ArrayHandle<Scalar> h_thermostat_state(m_thermostat_state,
+                                           access_location::host,
+                                           access_mode::read);
+    IntegratorVariables v = getIntegratorVariables();
+    v.variable[0] = h_thermostat_state.data[0];
+    v.variable[1] = h_thermostat_state.data[1];
+    setIntegratorVariables(v);
+    m_exp_thermo_fac = h_thermostat_state.data[2];
+
+    m_host_state_current = true;
     }
 
 /*! \param timestep Current time step
@@ -76,6 +127,100 @@ void TwoStepNVTMTKGPU::integrateStepOne(uint64_t timestep)
         m_prof->push(m_exec_conf, "NVT MTK step 1");
         }
 
+    m_device_step = useDeviceThermostat();
+    if (m_device_step)
+        {
+        if (!m_device_state_current)
+            {
+            // upload the state after it changed on the host
+            IntegratorVariables v = getIntegratorVariables();
+            ArrayHandle<Scalar> h_thermostat_state(m_thermostat_state,
+                                                   access_location::host,
+                                                   access_mode::overwrite);
+            h_thermostat_state.data[0] = v.variable[0];
+            h_thermostat_state.data[1] = v.variable[1];
+            h_thermostat_state.data[2] = m_exp_thermo_fac;
+            m_device_state_current = true;
+            }
+
+        // one partial sum per block at the smallest block size
+        unsigned int num_blocks = group_size / m_exec_conf->dev_prop.warpSize + 1;
+        if (m_partial_sum2K.getNumElements() < num_blocks)
+            {
+            GPUArray<Scalar> partial_sum2K(num_blocks, m_exec_conf);
+            m_partial_sum2K.swap(partial_sum2K);
+            }
+
+        ArrayHandle<Scalar4> d_pos(m_pdata->getPositions(),
+                                   access_location::device,
+                                   access_mode::readwrite);
+        ArrayHandle<Scalar4> d_vel(m_pdata->getVelocities(),
+                                   access_location::device,
+                                   access_mode::readwrite);
+        ArrayHandle<Scalar3> d_accel(m_pdata->getAccelerations(),
+                                     access_location::device,
+                                     access_mode::read);
+        ArrayHandle<int3> d_image(m_pdata->getImages(),
+                                  access_location::device,
+                                  access_mode::readwrite);
+        ArrayHandle<unsigned int> d_index_array(m_group->getIndexArray(),
+                                                access_location::device,
+                                                access_mode::read);
+        ArrayHandle<Scalar> d_thermostat_state(m_thermostat_state,
+                                               access_location::device,
+                                               access_mode::readwrite);
+        ArrayHandle<Scalar> d_partial_sum2K(m_partial_sum2K,
+                                            access_location::device,
+                                            access_mode::overwrite);
+
+        BoxDim box = m_pdata->getBox();
+
+        // the velocities at timestep+1/2 are final after this kernel, reduce the kinetic energy
+        // and advance the thermostat without leaving the device
+        m_tuner_one_reduce->begin();
+        unsigned int block_size = m_tuner_one_reduce->getParam();
+        gpu_nvt_mtk_step_one(d_pos.data,
+                             d_vel.data,
+                             d_accel.data,
+                             d_image.data,
+                             d_index_array.data,
+                             group_size,
+                             box,
+                             block_size,
+                             m_exp_thermo_fac,
+                             m_deltaT,
+                             m_group->getGPUPartition(),
+                             d_thermostat_state.data,
+                             d_partial_sum2K.data);
+
+        if (m_exec_conf->isCUDAErrorCheckingEnabled())
+            CHECK_CUDA_ERROR();
+        m_tuner_one_reduce->end();
+
+        gpu_nvt_mtk_advance_thermostat(d_thermostat_state.data,
+                                       d_partial_sum2K.data,
+                                       group_size / block_size + 1,
+                                       Scalar(m_group->getTranslationalDOF()),
+                                       m_T->getDeviceParams(timestep),
+                                       timestep,
+                                       m_tau,
+                                       m_deltaT);
+
+        if (m_exec_conf->isCUDAErrorCheckingEnabled())
+            CHECK_CUDA_ERROR();
+
+        m_host_state_current = false;
+
+        // done profiling
+        if (m_prof)
+            m_prof->pop(m_exec_conf);
+
+        return;
+        }
+
+    // the host path needs the current state
+    syncThermostatToHost();
+
         {
         // access all the needed data
         ArrayHandle<Scalar4> d_pos(m_pdata->getPositions(),
@@ -162,6 +307,7 @@ void TwoStepNVTMTKGPU::integrateStepOne(uint64_t timestep)
 
     // advance thermostat
     advanceThermostat(timestep, false);
+    m_device_state_current = false;
 
     // done profiling
     if (m_prof)
@@ -193,6 +339,9 @@ void TwoStepNVTMTKGPU::integrateStepTwo(uint64_t timestep)
                                      access_location::device,
                                      access_mode::readwrite);
         ArrayHandle<Scalar4> d_net_force(net_force, access_location::device, access_mode::read);
+        ArrayHandle<Scalar> d_thermostat_state(m_thermostat_state,
+                                               access_location::device,
+                                               access_mode::read);
 
         m_exec_conf->beginMultiGPU();
 
@@ -206,7 +355,8 @@ void TwoStepNVTMTKGPU::integrateStepTwo(uint64_t timestep)
                              m_tuner_two->getParam(),
                              m_deltaT,
                              m_exp_thermo_fac,
-                             m_group->getGPUPartition());
+                             m_group->getGPUPartition(),
+                             m_device_step ? d_thermostat_state.data : NULL);
 
         if (m_exec_conf->isCUDAErrorCheckingEnabled())
             CHECK_CUDA_ERROR();
@@ -23,11 +23,18 @@
     \param exp_fac Velocity rescaling factor from thermostat
     \param deltaT Amount of real time to step forward in one time step
     \param offset The offset of this GPU into the list of particles
+    \param d_thermostat_state When not NULL, read the rescaling factor from element 2 instead of
+           \a exp_fac
+    \param d_partial_sum2K When not NULL, write the sum of m*v^2 over the updated velocities of
+           each block
 
     Take the first half step forward in the NVT integration.
 
     See gpu_nve_step_one_kernel() for some performance notes on how to handle the group data reads
    efficiently.
+
+    When \a d_partial_sum2K is set, the kernel must be launched with a power of two block size and
+   blockDim.x * sizeof(Scalar) bytes of dynamic shared memory.
 */
 extern "C" __global__ void gpu_nvt_mtk_step_one_kernel(Scalar4* d_pos,
                                                        Scalar4* d_vel,
@@ -38,11 +45,18 @@ extern "C" __global__ void gpu_nvt_mtk_step_one_kernel(Scalar4* d_pos,
                                                        BoxDim box,
                                                        Scalar exp_fac,
                                                        Scalar deltaT,
-                                                       unsigned int offset)
+                                                       unsigned int offset,
+                                                       const Scalar* d_thermostat_state,
+                                                       Scalar* d_partial_sum2K)
     {
     // determine which particle this thread works on
     int group_idx = blockIdx.x * blockDim.x + threadIdx.x;
 
+    if (d_thermostat_state)
+        exp_fac = d_thermostat_state[2];
+
+    Scalar mv2 = Scalar(0.0);
+
     if (group_idx < work_size)
         {
         unsigned int idx = d_group_members[group_idx + offset];
@@ -73,6 +87,26 @@ extern "C" __global__ void gpu_nvt_mtk_step_one_kernel(Scalar4* d_pos,
         d_pos[idx] = make_scalar4(pos.x, pos.y, pos.z, postype.w);
         d_vel[idx] = make_scalar4(vel.x, vel.y, vel.z, velmass.w);
         d_image[idx] = image;
+
+        mv2 = velmass.w * dot(vel, vel);
+        }
+
+    if (d_partial_sum2K)
+        {
+        HIP_DYNAMIC_SHARED(char, s_data)
+        Scalar* s_sum = (Scalar*)s_data;
+        s_sum[threadIdx.x] = mv2;
+        __syncthreads();
+
+        for (int offs = blockDim.x >> 1; offs > 0; offs >>= 1)
+            {
+            if (threadIdx.x < offs)
+                s_sum[threadIdx.x] += s_sum[threadIdx.x + offs];
+            __syncthreads();
+            }
+
+        if (threadIdx.x == 0)
+            d_partial_sum2K[blockIdx.x] = s_sum[0];
         }
     }
 
@@ -86,6 +120,11 @@ extern "C" __global__ void gpu_nvt_mtk_step_one_kernel(Scalar4* d_pos,
     \param block_size Size of the block to run
     \param exp_fac Thermostat rescaling factor
     \param deltaT Amount of real time to step forward in one time step
+    \param gpu_partition Load balancing info for multi-GPU execution
+    \param d_thermostat_state Device thermostat state to read the rescaling factor from, or NULL
+    \param d_partial_sum2K Output: partial sums of m*v^2, one per block, or NULL
+
+    The reduction into \a d_partial_sum2K requires a single GPU and a power of two \a block_size.
 */
 hipError_t gpu_nvt_mtk_step_one(Scalar4* d_pos,
                                 Scalar4* d_vel,
@@ -97,7 +136,9 @@ hipError_t gpu_nvt_mtk_step_one(Scalar4* d_pos,
                                 unsigned int block_size,
                                 Scalar exp_fac,
                                 Scalar deltaT,
-                                const GPUPartition& gpu_partition)
+                                const GPUPartition& gpu_partition,
+                                const Scalar* d_thermostat_state,
+                                Scalar* d_partial_sum2K)
     {
     static unsigned int max_block_size = UINT_MAX;
     if (max_block_size == UINT_MAX)
@@ -108,6 +149,9 @@ hipError_t gpu_nvt_mtk_step_one(Scalar4* d_pos,
         }
 
     unsigned int run_block_size = min(block_size, max_block_size);
+    assert(!d_partial_sum2K || gpu_partition.getNumActiveGPUs() == 1);
+    assert(!d_partial_sum2K || (run_block_size & (run_block_size - 1)) == 0);
+    size_t shared_bytes = d_partial_sum2K ? run_block_size * sizeof(Scalar) : 0;
 
     // iterate over active GPUs in reverse, to end up on first GPU when returning from this function
     for (int idev = gpu_partition.getNumActiveGPUs() - 1; idev >= 0; --idev)
@@ -124,7 +168,7 @@ hipError_t gpu_nvt_mtk_step_one(Scalar4* d_pos,
         hipLaunchKernelGGL((gpu_nvt_mtk_step_one_kernel),
                            dim3(grid),
                            dim3(threads),
-                           0,
+                           shared_bytes,
                            0,
                            d_pos,
                            d_vel,
@@ -135,8 +179,98 @@ hipError_t gpu_nvt_mtk_step_one(Scalar4* d_pos,
                            box,
                            exp_fac,
                            deltaT,
-                           range.first);
+                           range.first,
+                           d_thermostat_state,
+                           d_partial_sum2K);
+        }
+
+    return hipSuccess;
+    }
+
+//! Reduce the partial sums of step one and advance the thermostat variables
+/*! \param d_thermostat_state xi, eta, and the rescaling factor exp(-xi*deltaT/2) (in/out)
+    \param d_partial_sum2K Partial sums of m*v^2
+    \param num_partial_sums Number of partial sums
+    \param ndof Number of translational degrees of freedom of the group
+    \param T_params Temperature set point
+    \param timestep Current time step, at which \a T_params is evaluated
+    \param tau Thermostat time constant
+    \param deltaT Amount of real time to step forward in one time step
+
+    Launched with a single block of a power of two size and blockDim.x * sizeof(Scalar) bytes of
+   dynamic shared memory. Implements the same update as TwoStepNVTMTK::advanceThermostat().
+*/
+__global__ void gpu_nvt_mtk_advance_thermostat_kernel(Scalar* d_thermostat_state,
+                                                      const Scalar* d_partial_sum2K,
+                                                      unsigned int num_partial_sums,
+                                                      Scalar ndof,
+                                                      const variant_params T_params,
+                                                      uint64_t timestep,
+                                                      Scalar tau,
+                                                      Scalar deltaT)
+    {
+    HIP_DYNAMIC_SHARED(char, s_data)
+    Scalar* s_sum = (Scalar*)s_data;
+
+    Scalar sum = Scalar(0.0);
+    for (unsigned int i = threadIdx.x; i < num_partial_sums; i += blockDim.x)
+        sum += d_partial_sum2K[i];
+    s_sum[threadIdx.x] = sum;
+    __syncthreads();
+
+    for (int offs = blockDim.x >> 1; offs > 0; offs >>= 1)
+        {
+        if (threadIdx.x < offs)
+            s_sum[threadIdx.x] += s_sum[threadIdx.x + offs];
+        __syncthreads();
+        }
+
+    if (threadIdx.x == 0)
+        {
+        // T = 2 K / ndof and s_sum[0] = 2 K
+        Scalar curr_T_trans = ndof > Scalar(0.0) ? s_sum[0] / ndof : Scalar(0.0);
+        Scalar T = evaluate_variant(T_params, timestep);
+
+        Scalar xi = d_thermostat_state[0];
+        Scalar eta = d_thermostat_state[1];
+
+        Scalar xi_prime
+            = xi + Scalar(1.0 / 2.0) * deltaT / tau / tau * (curr_T_trans / T - Scalar(1.0));
+        xi = xi_prime + Scalar(1.0 / 2.0) * deltaT / tau / tau * (curr_T_trans / T - Scalar(1.0));
+        eta += xi_prime * deltaT;
+
+        d_thermostat_state[0] = xi;
+        d_thermostat_state[1] = eta;
+        d_thermostat_state[2] = slow::exp(-Scalar(1.0 / 2.0) * xi * deltaT);
         }
+    }
+
+/*! See gpu_nvt_mtk_advance_thermostat_kernel() for full documentation, this function is just a
+    driver.
+*/
+hipError_t gpu_nvt_mtk_advance_thermostat(Scalar* d_thermostat_state,
+                                          const Scalar* d_partial_sum2K,
+                                          unsigned int num_partial_sums,
+                                          Scalar ndof,
+                                          const variant_params& T,
+                                          uint64_t timestep,
+                                          Scalar tau,
+                                          Scalar deltaT)
+    {
+    const unsigned int block_size = 256;
+    hipLaunchKernelGGL((gpu_nvt_mtk_advance_thermostat_kernel),
+                       dim3(1),
+                       dim3(block_size),
+                       block_size * sizeof(Scalar),
+                       0,
+                       d_thermostat_state,
+                       d_partial_sum2K,
+                       num_partial_sums,
+                       ndof,
+                       T,
+                       timestep,
+                       tau,
+                       deltaT);
 
     return hipSuccess;
     }
@@ -149,6 +283,8 @@ hipError_t gpu_nvt_mtk_step_one(Scalar4* d_pos,
     \param d_net_force Net force on each particle
     \param deltaT Amount of real time to step forward in one time step
     \param offset The offset of this GPU into the list of particles
+    \param d_thermostat_state When not NULL, read the rescaling factor from element 2 instead of
+           \a exp_v_fac_thermo
 */
 extern "C" __global__ void gpu_nvt_mtk_step_two_kernel(Scalar4* d_vel,
                                                        Scalar3* d_accel,
@@ -157,11 +293,15 @@ extern "C" __global__ void gpu_nvt_mtk_step_two_kernel(Scalar4* d_vel,
                                                        Scalar4* d_net_force,
                                                        Scalar deltaT,
                                                        Scalar exp_v_fac_thermo,
-                                                       unsigned int offset)
+                                                       unsigned int offset,
+                                                       const Scalar* d_thermostat_state)
     {
     // determine which particle this thread works on
     int group_idx = blockIdx.x * blockDim.x + threadIdx.x;
 
+    if (d_thermostat_state)
+        exp_v_fac_thermo = d_thermostat_state[2];
+
     if (group_idx < work_size)
         {
         unsigned int idx = d_group_members[group_idx + offset];
@@ -198,6 +338,8 @@ extern "C" __global__ void gpu_nvt_mtk_step_two_kernel(Scalar4* d_vel,
     \param block_size Size of the block to execute on the device
     \param deltaT Amount of real time to step forward in one time step
     \param exp_v_fac_thermo Exponential velocity scaling factor
+    \param gpu_partition Load balancing info for multi-GPU execution
+    \param d_thermostat_state Device thermostat state to read the scaling factor from, or NULL
 */
 hipError_t gpu_nvt_mtk_step_two(Scalar4* d_vel,
                                 Scalar3* d_accel,
@@ -207,7 +349,8 @@ hipError_t gpu_nvt_mtk_step_two(Scalar4* d_vel,
                                 unsigned int block_size,
                                 Scalar deltaT,
                                 Scalar exp_v_fac_thermo,
-                                const GPUPartition& gpu_partition)
+                                const GPUPartition& gpu_partition,
+                                const Scalar* d_thermostat_state)
     {
     static unsigned int max_block_size = UINT_MAX;
     if (max_block_size == UINT_MAX)
@@ -243,7 +386,8 @@ hipError_t gpu_nvt_mtk_step_two(Scalar4* d_vel,
                            d_net_force,
                            deltaT,
                            exp_v_fac_thermo,
-                           range.first);
+                           range.first,
+                           d_thermostat_state);
         }
 
     return hipSuccess;
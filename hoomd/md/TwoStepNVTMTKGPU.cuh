@@ -10,6 +10,7 @@
 #include "hoomd/GPUPartition.cuh"
 #include "hoomd/HOOMDMath.h"
 #include "hoomd/ParticleData.cuh"
+#include "hoomd/VariantDevice.h"
 
 #ifndef __TWO_STEP_NVT_MTK_GPU_CUH__
 #define __TWO_STEP_NVT_MTK_GPU_CUH__
@@ -25,7 +26,19 @@ hipError_t gpu_nvt_mtk_step_one(Scalar4* d_pos,
                                 unsigned int block_size,
                                 Scalar exp_fac,
                                 Scalar deltaT,
-                                const GPUPartition& gpu_partition);
+                                const GPUPartition& gpu_partition,
+                                const Scalar* d_thermostat_state = NULL,
+                                Scalar* d_partial_sum2K = NULL);
+
+//! Kernel driver to reduce the partial sums of step one and advance the thermostat on the device
+hipError_t gpu_nvt_mtk_advance_thermostat(Scalar* d_thermostat_state,
+                                          const Scalar* d_partial_sum2K,
+                                          unsigned int num_partial_sums,
+                                          Scalar ndof,
+                                          const variant_params& T,
+                                          uint64_t timestep,
+                                          Scalar tau,
+                                          Scalar deltaT);
 
 //! Kernel driver for the second part of the NVT update called by NVTUpdaterGPU
 hipError_t gpu_nvt_mtk_step_two(Scalar4* d_vel,
@@ -36,6 +49,7 @@ hipError_t gpu_nvt_mtk_step_two(Scalar4* d_vel,
                                 unsigned int block_size,
                                 Scalar deltaT,
                                 Scalar exp_v_fac_thermo,
-                                const GPUPartition& gpu_partition);
+                                const GPUPartition& gpu_partition,
+                                const Scalar* d_thermostat_state = NULL);
 
 #endif //__TWO_STEP_NVT_MTK_GPU_CUH__
@@ -26,8 +26,13 @@
 
     In order to compute efficiently and limit the number of kernel launches integrateStepOne()
    performs a first pass reduction on the sum of m*v^2 and stores the partial reductions. A second
-   kernel is then launched to reduce those to a final \a sum2K, which is a scalar but stored in a
-   GPUArray for convenience.
+   kernel is then launched to reduce those to a final \a sum2K and advance the thermostat
+   variables, which are kept in a GPUArray. The step kernels read the rescaling factor from that
+   array, so the host does not synchronize with the GPU during the step. The integrator variables
+   are copied to the host only when they are accessed (e.g. for logging).
+
+    The device thermostat applies to isotropic integration on a single GPU without MPI. In other
+   cases, integrateStepOne() advances the thermostat on the host from ComputeThermo.
 
     \ingroup updaters
 */
@@ -57,6 +62,8 @@ class PYBIND11_EXPORT TwoStepNVTMTKGPU : public TwoStepNVTMTK
         TwoStepNVTMTK::setAutotunerParams(enable, period);
         m_tuner_one->setPeriod(period);
         m_tuner_one->setEnabled(enable);
+        m_tuner_one_reduce->setPeriod(period);
+        m_tuner_one_reduce->setEnabled(enable);
         m_tuner_two->setPeriod(period);
         m_tuner_two->setEnabled(enable);
         m_tuner_angular_one->setPeriod(period);
@@ -67,11 +74,31 @@ class PYBIND11_EXPORT TwoStepNVTMTKGPU : public TwoStepNVTMTK
 
     protected:
     std::unique_ptr<Autotuner> m_tuner_one; //!< Autotuner for block size (step one kernel)
+    std::unique_ptr<Autotuner>
+        m_tuner_one_reduce; //!< Autotuner for block size (step one kernel with reduction)
     std::unique_ptr<Autotuner> m_tuner_two; //!< Autotuner for block size (step two kernel)
     std::unique_ptr<Autotuner>
         m_tuner_angular_one; //!< Autotuner_angular for block size (angular step one kernel)
     std::unique_ptr<Autotuner>
         m_tuner_angular_two; //!< Autotuner_angular for block size (angular step two kernel)
+
+    GPUArray<Scalar> m_thermostat_state; //!< xi, eta, and exp_thermo_fac on the device
+    GPUArray<Scalar> m_partial_sum2K;    //!< Partial sums of m*v^2 over the blocks of step one
+    bool m_device_state_current;         //!< True when m_thermostat_state holds the current state
+    bool m_host_state_current;           //!< True when the integrator variables hold the state
+    bool m_device_step;                  //!< True when the current step advances on the device
+
+    //! Test whether the thermostat can advance on the device
+    bool useDeviceThermostat();
+
+    //! Copy the device thermostat state to the integrator variables
+    virtual void syncThermostatToHost();
+
+    //! Mark the device thermostat state as out of date
+    virtual void thermostatChangedOnHost()
+        {
+        m_device_state_current = false;
+        }
     };
 
 //! Exports the TwoStepNVTMTKGPU class to python
@@ -148,8 +148,6 @@ template<class Manifold> TwoStepRATTLEBD<Manifold>::~TwoStepRATTLEBD()
 
 template<class Manifold> void TwoStepRATTLEBD<Manifold>::integrateStepOne(uint64_t timestep)
     {
-    unsigned int group_size = m_group->getNumMembers();
-
     const Scalar currentTemp = (*m_T)(timestep);
 
     // profile this step
@@ -164,7 +162,7 @@ template<class Manifold> void TwoStepRATTLEBD<Manifold>::integrateStepOne(uint64
                                access_location::host,
                                access_mode::readwrite);
     ArrayHandle<int3> h_image(m_pdata->getImages(), access_location::host, access_mode::readwrite);
-    ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_tag(m_pdata->getTags(), access_location::host, access_mode::read);
 
     ArrayHandle<Scalar4> h_net_force(net_force, access_location::host, access_mode::read);
     ArrayHandle<Scalar> h_gamma(m_gamma, access_location::host, access_mode::read);
@@ -204,194 +202,194 @@ template<class Manifold> void TwoStepRATTLEBD<Manifold>::integrateStepOne(uint64
     // r(t+deltaT) = r(t) + (Fc(t) + Fr)*deltaT/gamma
     // iterative: r(t+deltaT) = r(t+deltaT) - J^(-1)*residual
     // v(t+deltaT) = random distribution consistent with T
-    for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
+    forEachMember(
+        [&](unsigned int j)
         {
-        unsigned int ptag = m_group->getMemberTag(group_idx);
-        unsigned int j = h_rtag.data[ptag];
-
-        // Initialize the RNG
-        RandomGenerator rng(hoomd::Seed(RNGIdentifier::TwoStepBD, timestep, seed),
-                            hoomd::Counter(ptag, 1));
-
-        // Initialize the RNG
-        RandomGenerator rng_b(
-            hoomd::Seed(RNGIdentifier::TwoStepBD, timestep, seed),
-            hoomd::Counter(ptag, 2)); // This random number generator generates the same numbers as
-                                      // in includeRATTLEForce for each particle such that the
-                                      // Brownian force stays consistent
-
-        Scalar gamma;
-        if (m_use_alpha)
-            gamma = m_alpha * h_diameter.data[j];
-        else
-            {
-            unsigned int type = __scalar_as_int(h_pos.data[j].w);
-            gamma = h_gamma.data[type];
-            }
-        Scalar deltaT_gamma = m_deltaT / gamma;
-
-        Scalar3 vec_rand;
-        if (m_noiseless_t)
-            {
-            vec_rand.x = h_net_force.data[j].x / gamma;
-            vec_rand.y = h_net_force.data[j].x / gamma;
-            vec_rand.z = h_net_force.data[j].x / gamma;
-            }
-        else
-            {
-            // draw a new random velocity for particle j
-            Scalar mass = h_vel.data[j].w;
-            Scalar sigma1 = fast::sqrt(currentTemp / mass);
-            NormalDistribution<Scalar> norm(sigma1);
-
-            vec_rand.x = norm(rng);
-            vec_rand.y = norm(rng);
-            vec_rand.z = norm(rng);
-            }
-
-        Scalar3 next_pos;
-        next_pos.x = h_pos.data[j].x;
-        next_pos.y = h_pos.data[j].y;
-        next_pos.z = h_pos.data[j].z;
-
-        Scalar3 normal = m_manifold.derivative(next_pos);
-        Scalar norm_normal = fast::rsqrt(dot(normal, normal));
+            unsigned int ptag = h_tag.data[j];
+
+            // Initialize the RNG
+            RandomGenerator rng(hoomd::Seed(RNGIdentifier::TwoStepBD, timestep, seed),
+                                hoomd::Counter(ptag, 1));
+
+            // Initialize the RNG
+            // This random number generator generates the same numbers as in includeRATTLEForce for
+            // each particle such that the Brownian force stays consistent
+            RandomGenerator rng_b(hoomd::Seed(RNGIdentifier::TwoStepBD, timestep, seed),
+                                  hoomd::Counter(ptag, 2));
+
+            Scalar gamma;
+            if (m_use_alpha)
+                gamma = m_alpha * h_diameter.data[j];
+            else
+                {
+                unsigned int type = __scalar_as_int(h_pos.data[j].w);
+                gamma = h_gamma.data[type];
+                }
+            Scalar deltaT_gamma = m_deltaT / gamma;
 
-        normal.x *= norm_normal;
-        normal.y *= norm_normal;
-        normal.z *= norm_normal;
+            Scalar3 vec_rand;
+            if (m_noiseless_t)
+                {
+                vec_rand.x = h_net_force.data[j].x / gamma;
+                vec_rand.y = h_net_force.data[j].x / gamma;
+                vec_rand.z = h_net_force.data[j].x / gamma;
+                }
+            else
+                {
+                // draw a new random velocity for particle j
+                Scalar mass = h_vel.data[j].w;
+                Scalar sigma1 = fast::sqrt(currentTemp / mass);
+                NormalDistribution<Scalar> norm(sigma1);
+
+                vec_rand.x = norm(rng);
+                vec_rand.y = norm(rng);
+                vec_rand.z = norm(rng);
+                }
 
-        Scalar rand_norm = dot(vec_rand, normal);
-        vec_rand.x -= rand_norm * normal.x;
-        vec_rand.y -= rand_norm * normal.y;
-        vec_rand.z -= rand_norm * normal.z;
+            Scalar3 next_pos;
+            next_pos.x = h_pos.data[j].x;
+            next_pos.y = h_pos.data[j].y;
+            next_pos.z = h_pos.data[j].z;
 
-        h_vel.data[j].x = vec_rand.x;
-        h_vel.data[j].y = vec_rand.y;
-        h_vel.data[j].z = vec_rand.z;
+            Scalar3 normal = m_manifold.derivative(next_pos);
+            Scalar norm_normal = fast::rsqrt(dot(normal, normal));
 
-        Scalar rx, ry, rz, coeff;
+            normal.x *= norm_normal;
+            normal.y *= norm_normal;
+            normal.z *= norm_normal;
 
-        if (currentTemp > 0)
-            {
-            // compute the random force
-            UniformDistribution<Scalar> uniform(Scalar(-1), Scalar(1));
-            rx = uniform(rng_b);
-            ry = uniform(rng_b);
-            rz = uniform(rng_b);
+            Scalar rand_norm = dot(vec_rand, normal);
+            vec_rand.x -= rand_norm * normal.x;
+            vec_rand.y -= rand_norm * normal.y;
+            vec_rand.z -= rand_norm * normal.z;
 
-            Scalar normal_r = rx * normal.x + ry * normal.y + rz * normal.z;
+            h_vel.data[j].x = vec_rand.x;
+            h_vel.data[j].y = vec_rand.y;
+            h_vel.data[j].z = vec_rand.z;
 
-            rx = rx - normal_r * normal.x;
-            ry = ry - normal_r * normal.y;
-            rz = rz - normal_r * normal.z;
+            Scalar rx, ry, rz, coeff;
 
-            // compute the bd force (the extra factor of 3 is because <rx^2> is 1/3 in the uniform
-            // -1,1 distribution it is not the dimensionality of the system
-            coeff = fast::sqrt(Scalar(6.0) * currentTemp / deltaT_gamma);
-            if (m_noiseless_t)
-                coeff = Scalar(0.0);
-            }
-        else
-            {
-            rx = 0;
-            ry = 0;
-            rz = 0;
-            coeff = 0;
-            }
+            if (currentTemp > 0)
+                {
+                // compute the random force
+                UniformDistribution<Scalar> uniform(Scalar(-1), Scalar(1));
+                rx = uniform(rng_b);
+                ry = uniform(rng_b);
+                rz = uniform(rng_b);
+
+                Scalar normal_r = rx * normal.x + ry * normal.y + rz * normal.z;
+
+                rx = rx - normal_r * normal.x;
+                ry = ry - normal_r * normal.y;
+                rz = rz - normal_r * normal.z;
+
+                // compute the bd force (the extra factor of 3 is because <rx^2> is 1/3 in the
+                // uniform -1,1 distribution it is not the dimensionality of the system
+                coeff = fast::sqrt(Scalar(6.0) * currentTemp / deltaT_gamma);
+                if (m_noiseless_t)
+                    coeff = Scalar(0.0);
+                }
+            else
+                {
+                rx = 0;
+                ry = 0;
+                rz = 0;
+                coeff = 0;
+                }
 
-        Scalar dx = (h_net_force.data[j].x + rx * coeff) * deltaT_gamma;
-        Scalar dy = (h_net_force.data[j].y + ry * coeff) * deltaT_gamma;
-        Scalar dz = (h_net_force.data[j].z + rz * coeff) * deltaT_gamma;
+            Scalar dx = (h_net_force.data[j].x + rx * coeff) * deltaT_gamma;
+            Scalar dy = (h_net_force.data[j].y + ry * coeff) * deltaT_gamma;
+            Scalar dz = (h_net_force.data[j].z + rz * coeff) * deltaT_gamma;
 
-        h_pos.data[j].x += dx;
-        h_pos.data[j].y += dy;
-        h_pos.data[j].z += dz;
+            h_pos.data[j].x += dx;
+            h_pos.data[j].y += dy;
+            h_pos.data[j].z += dz;
 
-        // particles may have been moved slightly outside the box by the above steps, wrap them back
-        // into place
-        box.wrap(h_pos.data[j], h_image.data[j]);
+            // particles may have been moved slightly outside the box by the above steps, wrap them
+            // back into place
+            box.wrap(h_pos.data[j], h_image.data[j]);
 
-        // rotational random force and orientation quaternion updates
-        if (m_aniso)
-            {
-            unsigned int type_r = __scalar_as_int(h_pos.data[j].w);
-            Scalar3 gamma_r = h_gamma_r.data[type_r];
-            if (gamma_r.x > 0 || gamma_r.y > 0 || gamma_r.z > 0)
+            // rotational random force and orientation quaternion updates
+            if (m_aniso)
                 {
-                vec3<Scalar> p_vec;
-                quat<Scalar> q(h_orientation.data[j]);
-                vec3<Scalar> t(h_torque.data[j]);
-                vec3<Scalar> I(h_inertia.data[j]);
-
-                bool x_zero, y_zero, z_zero;
-                x_zero = (I.x < EPSILON);
-                y_zero = (I.y < EPSILON);
-                z_zero = (I.z < EPSILON);
-
-                Scalar3 sigma_r
-                    = make_scalar3(fast::sqrt(Scalar(2.0) * gamma_r.x * currentTemp / m_deltaT),
-                                   fast::sqrt(Scalar(2.0) * gamma_r.y * currentTemp / m_deltaT),
-                                   fast::sqrt(Scalar(2.0) * gamma_r.z * currentTemp / m_deltaT));
-                if (m_noiseless_r)
-                    sigma_r = make_scalar3(0, 0, 0);
-
-                // original Gaussian random torque
-                // Gaussian random distribution is preferred in terms of preserving the exact math
-                vec3<Scalar> bf_torque;
-                bf_torque.x = NormalDistribution<Scalar>(sigma_r.x)(rng);
-                bf_torque.y = NormalDistribution<Scalar>(sigma_r.y)(rng);
-                bf_torque.z = NormalDistribution<Scalar>(sigma_r.z)(rng);
-
-                if (x_zero)
-                    bf_torque.x = 0;
-                if (y_zero)
-                    bf_torque.y = 0;
-                if (z_zero)
-                    bf_torque.z = 0;
-
-                // use the d_invamping by gamma_r and rotate back to lab frame
-                // Notes For the Future: take special care when have anisotropic gamma_r
-                // if aniso gamma_r, first rotate the torque into particle frame and divide the
-                // different gamma_r and then rotate the "angular velocity" back to lab frame and
-                // integrate
-                bf_torque = rotate(q, bf_torque);
-
-                // do the integration for quaternion
-                q += Scalar(0.5) * m_deltaT * ((t + bf_torque) / vec3<Scalar>(gamma_r)) * q;
-                q = q * (Scalar(1.0) / slow::sqrt(norm2(q)));
-                h_orientation.data[j] = quat_to_scalar4(q);
-
-                if (m_noiseless_r)
-                    {
-                    p_vec.x = t.x / gamma_r.x;
-                    p_vec.y = t.y / gamma_r.y;
-                    p_vec.z = t.z / gamma_r.z;
-                    }
-                else
+                unsigned int type_r = __scalar_as_int(h_pos.data[j].w);
+                Scalar3 gamma_r = h_gamma_r.data[type_r];
+                if (gamma_r.x > 0 || gamma_r.y > 0 || gamma_r.z > 0)
                     {
-                    // draw a new random ang_mom for particle j in body frame
-                    p_vec.x = NormalDistribution<Scalar>(fast::sqrt(currentTemp * I.x))(rng);
-                    p_vec.y = NormalDistribution<Scalar>(fast::sqrt(currentTemp * I.y))(rng);
-                    p_vec.z = NormalDistribution<Scalar>(fast::sqrt(currentTemp * I.z))(rng);
+                    vec3<Scalar> p_vec;
+                    quat<Scalar> q(h_orientation.data[j]);
+                    vec3<Scalar> t(h_torque.data[j]);
+                    vec3<Scalar> I(h_inertia.data[j]);
+
+                    bool x_zero, y_zero, z_zero;
+                    x_zero = (I.x < EPSILON);
+                    y_zero = (I.y < EPSILON);
+                    z_zero = (I.z < EPSILON);
+
+                    Scalar3 sigma_r = make_scalar3(
+                        fast::sqrt(Scalar(2.0) * gamma_r.x * currentTemp / m_deltaT),
+                        fast::sqrt(Scalar(2.0) * gamma_r.y * currentTemp / m_deltaT),
+                        fast::sqrt(Scalar(2.0) * gamma_r.z * currentTemp / m_deltaT));
+                    if (m_noiseless_r)
+                        sigma_r = make_scalar3(0, 0, 0);
+
+                    // original Gaussian random torque
+                    // Gaussian random distribution is preferred in terms of preserving the exact
+                    // math
+                    vec3<Scalar> bf_torque;
+                    bf_torque.x = NormalDistribution<Scalar>(sigma_r.x)(rng);
+                    bf_torque.y = NormalDistribution<Scalar>(sigma_r.y)(rng);
+                    bf_torque.z = NormalDistribution<Scalar>(sigma_r.z)(rng);
+
+                    if (x_zero)
+                        bf_torque.x = 0;
+                    if (y_zero)
+                        bf_torque.y = 0;
+                    if (z_zero)
+                        bf_torque.z = 0;
+
+                    // use the d_invamping by gamma_r and rotate back to lab frame
+                    // Notes For the Future: take special care when have anisotropic gamma_r
+                    // if aniso gamma_r, first rotate the torque into particle frame and divide the
+                    // different gamma_r and then rotate the "angular velocity" back to lab frame
+                    // and integrate
+                    bf_torque = rotate(q, bf_torque);
+
+                    // do the integration for quaternion
+                    q += Scalar(0.5) * m_deltaT * ((t + bf_torque) / vec3<Scalar>(gamma_r)) * q;
+                    q = q * (Scalar(1.0) / slow::sqrt(norm2(q)));
+                    h_orientation.data[j] = quat_to_scalar4(q);
+
+                    if (m_noiseless_r)
+                        {
+                        p_vec.x = t.x / gamma_r.x;
+                        p_vec.y = t.y / gamma_r.y;
+                        p_vec.z = t.z / gamma_r.z;
+                        }
+                    else
+                        {
+                        // draw a new random ang_mom for particle j in body frame
+                        p_vec.x = NormalDistribution<Scalar>(fast::sqrt(currentTemp * I.x))(rng);
+                        p_vec.y = NormalDistribution<Scalar>(fast::sqrt(currentTemp * I.y))(rng);
+                        p_vec.z = NormalDistribution<Scalar>(fast::sqrt(currentTemp * I.z))(rng);
+                        }
+
+                    if (x_zero)
+                        p_vec.x = 0;
+                    if (y_zero)
+                        p_vec.y = 0;
+                    if (z_zero)
+                        p_vec.z = 0;
+
+                    // !! Note this isn't well-behaving in 2D,
+                    // !! because may have effective non-zero ang_mom in x,y
+
+                    // store ang_mom quaternion
+                    quat<Scalar> p = Scalar(2.0) * q * p_vec;
+                    h_angmom.data[j] = quat_to_scalar4(p);
                     }
-
-                if (x_zero)
-                    p_vec.x = 0;
-                if (y_zero)
-                    p_vec.y = 0;
-                if (z_zero)
-                    p_vec.z = 0;
-
-                // !! Note this isn't well-behaving in 2D,
-                // !! because may have effective non-zero ang_mom in x,y
-
-                // store ang_mom quaternion
-                quat<Scalar> p = Scalar(2.0) * q * p_vec;
-                h_angmom.data[j] = quat_to_scalar4(p);
                 }
-            }
-        }
+        });
     // done profiling
     if (m_prof)
         m_prof->pop();
@@ -406,14 +404,12 @@ template<class Manifold> void TwoStepRATTLEBD<Manifold>::integrateStepTwo(uint64
 
 template<class Manifold> void TwoStepRATTLEBD<Manifold>::includeRATTLEForce(uint64_t timestep)
     {
-    unsigned int group_size = m_group->getNumMembers();
-
     const Scalar currentTemp = (*m_T)(timestep);
 
     const GlobalArray<Scalar4>& net_force = m_pdata->getNetForce();
     const GlobalArray<Scalar>& net_virial = m_pdata->getNetVirial();
     ArrayHandle<Scalar4> h_pos(m_pdata->getPositions(), access_location::host, access_mode::read);
-    ArrayHandle<unsigned int> h_rtag(m_pdata->getRTags(), access_location::host, access_mode::read);
+    ArrayHandle<unsigned int> h_tag(m_pdata->getTags(), access_location::host, access_mode::read);
 
     ArrayHandle<Scalar4> h_net_force(net_force, access_location::host, access_mode::readwrite);
     ArrayHandle<Scalar> h_net_virial(net_virial, access_location::host, access_mode::readwrite);
@@ -426,130 +422,128 @@ template<class Manifold> void TwoStepRATTLEBD<Manifold>::includeRATTLEForce(uint
 
     uint16_t seed = m_sysdef->getSeed();
 
+    std::atomic<unsigned int> n_unconverged(0);
+
     // perform the first half step
     // r(t+deltaT) = r(t) + (Fc(t) + Fr)*deltaT/gamma
     // iterative: r(t+deltaT) = r(t+deltaT) - J^(-1)*residual
     // v(t+deltaT) = random distribution consistent with T
-    for (unsigned int group_idx = 0; group_idx < group_size; group_idx++)
+    forEachMember(
+        [&](unsigned int j)
         {
-        unsigned int ptag = m_group->getMemberTag(group_idx);
-        unsigned int j = h_rtag.data[ptag];
-
-        // Initialize the RNG
-        RandomGenerator rng_b(hoomd::Seed(RNGIdentifier::TwoStepBD, timestep, seed),
-                              hoomd::Counter(ptag, 2));
-
-        Scalar gamma;
-        if (m_use_alpha)
-            gamma = m_alpha * h_diameter.data[j];
-        else
-            {
-            unsigned int type = __scalar_as_int(h_pos.data[j].w);
-            gamma = h_gamma.data[type];
-            }
-        Scalar deltaT_gamma = m_deltaT / gamma;
+            unsigned int ptag = h_tag.data[j];
 
-        Scalar3 next_pos;
-        next_pos.x = h_pos.data[j].x;
-        next_pos.y = h_pos.data[j].y;
-        next_pos.z = h_pos.data[j].z;
+            // Initialize the RNG
+            RandomGenerator rng_b(hoomd::Seed(RNGIdentifier::TwoStepBD, timestep, seed),
+                                  hoomd::Counter(ptag, 2));
 
-        Scalar3 normal = m_manifold.derivative(next_pos);
-        Scalar norm_normal = fast::rsqrt(dot(normal, normal));
-
-        normal.x *= norm_normal;
-        normal.y *= norm_normal;
-        normal.z *= norm_normal;
-
-        Scalar rx, ry, rz, coeff;
-
-        if (currentTemp > 0)
-            {
-            // compute the random force
-            UniformDistribution<Scalar> uniform(Scalar(-1), Scalar(1));
-            rx = uniform(rng_b);
-            ry = uniform(rng_b);
-            rz = uniform(rng_b);
-
-            Scalar normal_r = rx * normal.x + ry * normal.y + rz * normal.z;
-
-            rx = rx - normal_r * normal.x;
-            ry = ry - normal_r * normal.y;
-            rz = rz - normal_r * normal.z;
-
-            // compute the bd force (the extra factor of 3 is because <rx^2> is 1/3 in the uniform
-            // -1,1 distribution it is not the dimensionality of the system
-            coeff = fast::sqrt(Scalar(6.0) * currentTemp / deltaT_gamma);
-            if (m_noiseless_t)
-                coeff = Scalar(0.0);
-            }
-        else
-            {
-            rx = 0;
-            ry = 0;
-            rz = 0;
-            coeff = 0;
-            }
-
-        Scalar Fr_x = rx * coeff;
-        Scalar Fr_y = ry * coeff;
-        Scalar Fr_z = rz * coeff;
+            Scalar gamma;
+            if (m_use_alpha)
+                gamma = m_alpha * h_diameter.data[j];
+            else
+                {
+                unsigned int type = __scalar_as_int(h_pos.data[j].w);
+                gamma = h_gamma.data[type];
+                }
+            Scalar deltaT_gamma = m_deltaT / gamma;
 
-        // update position
-        Scalar mu = 0.0;
+            Scalar3 next_pos;
+            next_pos.x = h_pos.data[j].x;
+            next_pos.y = h_pos.data[j].y;
+            next_pos.z = h_pos.data[j].z;
 
-        Scalar inv_alpha = -Scalar(1.0) / deltaT_gamma;
+            Scalar3 normal = m_manifold.derivative(next_pos);
+            Scalar norm_normal = fast::rsqrt(dot(normal, normal));
 
-        Scalar3 residual;
-        Scalar resid;
+            normal.x *= norm_normal;
+            normal.y *= norm_normal;
+            normal.z *= norm_normal;
 
-        unsigned int iteration = 0;
-        do
-            {
-            iteration++;
-            residual.x = h_pos.data[j].x - next_pos.x
-                         + (h_net_force.data[j].x + Fr_x - mu * normal.x) * deltaT_gamma;
-            residual.y = h_pos.data[j].y - next_pos.y
-                         + (h_net_force.data[j].y + Fr_y - mu * normal.y) * deltaT_gamma;
-            residual.z = h_pos.data[j].z - next_pos.z
-                         + (h_net_force.data[j].z + Fr_z - mu * normal.z) * deltaT_gamma;
-            resid = m_manifold.implicitFunction(next_pos);
+            Scalar rx, ry, rz, coeff;
 
-            Scalar3 next_normal = m_manifold.derivative(next_pos);
+            if (currentTemp > 0)
+                {
+                // compute the random force
+                UniformDistribution<Scalar> uniform(Scalar(-1), Scalar(1));
+                rx = uniform(rng_b);
+                ry = uniform(rng_b);
+                rz = uniform(rng_b);
+
+                Scalar normal_r = rx * normal.x + ry * normal.y + rz * normal.z;
+
+                rx = rx - normal_r * normal.x;
+                ry = ry - normal_r * normal.y;
+                rz = rz - normal_r * normal.z;
+
+                // compute the bd force (the extra factor of 3 is because <rx^2> is 1/3 in the
+                // uniform -1,1 distribution it is not the dimensionality of the system
+                coeff = fast::sqrt(Scalar(6.0) * currentTemp / deltaT_gamma);
+                if (m_noiseless_t)
+                    coeff = Scalar(0.0);
+                }
+            else
+                {
+                rx = 0;
+                ry = 0;
+                rz = 0;
+                coeff = 0;
+                }
 
-            Scalar nndotr = dot(next_normal, residual);
-            Scalar nndotn = dot(next_normal, normal);
-            Scalar beta = (resid + nndotr) / nndotn;
+            Scalar Fr_x = rx * coeff;
+            Scalar Fr_y = ry * coeff;
+            Scalar Fr_z = rz * coeff;
 
-            next_pos.x = next_pos.x - beta * normal.x + residual.x;
-            next_pos.y = next_pos.y - beta * normal.y + residual.y;
-            next_pos.z = next_pos.z - beta * normal.z + residual.z;
-            mu = mu - beta * inv_alpha;
+            // update position
+            Scalar mu = 0.0;
 
-            } while (maxNorm(residual, resid) > m_tolerance && iteration < maxiteration);
+            Scalar inv_alpha = -Scalar(1.0) / deltaT_gamma;
 
-        if (iteration == maxiteration)
-            {
-            m_exec_conf->msg->warning()
-                << "The RATTLE integrator needed an unusual high number of iterations!" << endl
-                << "It is recomended to change the initial configuration or lower the step size."
-                << endl;
-            }
+            Scalar3 residual;
+            Scalar resid;
 
-        h_net_force.data[j].x -= mu * normal.x;
-        h_net_force.data[j].y -= mu * normal.y;
-        h_net_force.data[j].z -= mu * normal.z;
-
-        h_net_virial.data[0 * net_virial_pitch + j] -= mu * normal.x * h_pos.data[j].x;
-        h_net_virial.data[1 * net_virial_pitch + j]
-            -= 0.5 * mu * (normal.y * h_pos.data[j].x + normal.x * h_pos.data[j].y);
-        h_net_virial.data[2 * net_virial_pitch + j]
-            -= 0.5 * mu * (normal.z * h_pos.data[j].x + normal.x * h_pos.data[j].z);
-        h_net_virial.data[3 * net_virial_pitch + j] -= mu * normal.y * h_pos.data[j].y;
-        h_net_virial.data[4 * net_virial_pitch + j]
-            -= 0.5 * mu * (normal.y * h_pos.data[j].z + normal.z * h_pos.data[j].y);
-        h_net_virial.data[5 * net_virial_pitch + j] -= mu * normal.z * h_pos.data[j].z;
-        }
+            unsigned int iteration = 0;
+            do
+                {
+                iteration++;
+                residual.x = h_pos.data[j].x - next_pos.x
+                             + (h_net_force.data[j].x + Fr_x - mu * normal.x) * deltaT_gamma;
+                residual.y = h_pos.data[j].y - next_pos.y
+                             + (h_net_force.data[j].y + Fr_y - mu * normal.y) * deltaT_gamma;
+                residual.z = h_pos.data[j].z - next_pos.z
+                             + (h_net_force.data[j].z + Fr_z - mu * normal.z) * deltaT_gamma;
+                resid = m_manifold.implicitFunction(next_pos);
+
+                Scalar3 next_normal = m_manifold.derivative(next_pos);
+
+                Scalar nndotr = dot(next_normal, residual);
+                Scalar nndotn = dot(next_normal, normal);
+                Scalar beta = (resid + nndotr) / nndotn;
+
+                next_pos.x = next_pos.x - beta * normal.x + residual.x;
+                next_pos.y = next_pos.y - beta * normal.y + residual.y;
+                next_pos.z = next_pos.z - beta * normal.z + residual.z;
+                mu = mu - beta * inv_alpha;
+
+                } while (maxNorm(residual, resid) > m_tolerance && iteration < maxiteration);
+
+            if (iteration == maxiteration)
+                n_unconverged++;
+
+            h_net_force.data[j].x -= mu * normal.x;
+            h_net_force.data[j].y -= mu * normal.y;
+            h_net_force.data[j].z -= mu * normal.z;
+
+            h_net_virial.data[0 * net_virial_pitch + j] -= mu * normal.x * h_pos.data[j].x;
+            h_net_virial.data[1 * net_virial_pitch + j]
+                -= 0.5 * mu * (normal.y * h_pos.data[j].x + normal.x * h_pos.data[j].y);
+            h_net_virial.data[2 * net_virial_pitch + j]
+                -= 0.5 * mu * (normal.z * h_pos.data[j].x + normal.x * h_pos.data[j].z);
+            h_net_virial.data[3 * net_virial_pitch + j] -= mu * normal.y * h_pos.data[j].y;
+            h_net_virial.data[4 * net_virial_pitch + j]
+                -= 0.5 * mu * (normal.y * h_pos.data[j].z + normal.z * h_pos.data[j].y);
+            h_net_virial.data[5 * net_virial_pitch + j] -= mu * normal.z * h_pos.data[j].z;
+        });
+    checkRATTLEConvergence(*m_exec_conf, n_unconverged);
     }
 
 template<class Manifold> void export_TwoStepRATTLEBD(py::module& m, const std::string& name)
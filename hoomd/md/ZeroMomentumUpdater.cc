@@ -13,6 +13,12 @@
 #include <math.h>
 #include <stdexcept>
 
+#ifdef ENABLE_TBB
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/parallel_reduce.h>
+#endif
+
 using namespace std;
 namespace py = pybind11;
 
@@ -52,25 +58,51 @@ void ZeroMomentumUpdater::update(uint64_t timestep)
                                         access_location::host,
                                         access_mode::read);
 
-        // temp variables for holding the sums
-        Scalar sum_px = 0.0;
-        Scalar sum_py = 0.0;
-        Scalar sum_pz = 0.0;
-        unsigned int n = 0;
+        const unsigned int N = m_pdata->getN();
+        const Scalar4* vel = h_vel.data;
+        const unsigned int* body = h_body.data;
+        const unsigned int* tag = h_tag.data;
 
-        // add up the momentum of every free particle (including floppy body particles) and every
-        // central particle of a rigid body
-        for (unsigned int i = 0; i < m_pdata->getN(); i++)
-            {
-            if (h_body.data[i] >= MIN_FLOPPY || h_body.data[i] == h_tag.data[i])
+        // the momentum of every free particle (including floppy body particles) and every central
+        // particle of a rigid body, with the number of such particles in .w
+        auto momentum = [vel, body, tag](unsigned int i)
+        {
+            if (body[i] >= MIN_FLOPPY || body[i] == tag[i])
                 {
-                Scalar mass = h_vel.data[i].w;
-                sum_px += mass * h_vel.data[i].x;
-                sum_py += mass * h_vel.data[i].y;
-                sum_pz += mass * h_vel.data[i].z;
-                n++;
+                Scalar mass = vel[i].w;
+                return make_scalar4(mass * vel[i].x, mass * vel[i].y, mass * vel[i].z, 1);
                 }
-            }
+            return make_scalar4(0, 0, 0, 0);
+        };
+        auto add = [](const Scalar4& a, const Scalar4& b)
+        { return make_scalar4(a.x + b.x, a.y + b.y, a.z + b.z, a.w + b.w); };
+
+        // add up the momentum, the partition is independent of the thread count so the sum is
+        // reproducible
+#ifdef ENABLE_TBB
+        Scalar4 sum = m_exec_conf->getTaskArena()->execute(
+            [&]
+            {
+                return tbb::parallel_deterministic_reduce(
+                    tbb::blocked_range<unsigned int>(0, N, 1024),
+                    make_scalar4(0, 0, 0, 0),
+                    [&](const tbb::blocked_range<unsigned int>& r, Scalar4 partial)
+                    {
+                        for (unsigned int i = r.begin(); i != r.end(); ++i)
+                            partial = add(partial, momentum(i));
+                        return partial;
+                    },
+                    add);
+            });
+#else
+        Scalar4 sum = make_scalar4(0, 0, 0, 0);
+        for (unsigned int i = 0; i < N; i++)
+            sum = add(sum, momentum(i));
+#endif
+        Scalar sum_px = sum.x;
+        Scalar sum_py = sum.y;
+        Scalar sum_pz = sum.z;
+        unsigned int n = (unsigned int)sum.w;
 
 #ifdef ENABLE_MPI
         if (m_pdata->getDomainDecomposition())
@@ -104,16 +136,33 @@ void ZeroMomentumUpdater::update(uint64_t timestep)
 
         // subtract this momentum from every free particle (including floppy body particles) and
         // every central particle of a rigid body
-        for (unsigned int i = 0; i < m_pdata->getN(); i++)
-            {
-            if (h_body.data[i] >= MIN_FLOPPY || h_body.data[i] == h_tag.data[i])
+        Scalar4* vel_out = h_vel.data;
+        auto subtract = [=](unsigned int i)
+        {
+            if (body[i] >= MIN_FLOPPY || body[i] == tag[i])
                 {
-                Scalar mass = h_vel.data[i].w;
-                h_vel.data[i].x -= avg_px / mass;
-                h_vel.data[i].y -= avg_py / mass;
-                h_vel.data[i].z -= avg_pz / mass;
+                Scalar mass = vel_out[i].w;
+                vel_out[i].x -= avg_px / mass;
+                vel_out[i].y -= avg_py / mass;
+                vel_out[i].z -= avg_pz / mass;
                 }
-            }
+        };
+
+#ifdef ENABLE_TBB
+        m_exec_conf->getTaskArena()->execute(
+            [&]
+            {
+                tbb::parallel_for(tbb::blocked_range<unsigned int>(0, N),
+                                  [&](const tbb::blocked_range<unsigned int>& r)
+                                  {
+                                      for (unsigned int i = r.begin(); i != r.end(); ++i)
+                                          subtract(i);
+                                  });
+            });
+#else
+        for (unsigned int i = 0; i < N; i++)
+            subtract(i);
+#endif
         } // end GPUArray scope
 
     if (m_prof)
@@ -0,0 +1,118 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file ZeroMomentumUpdaterGPU.cc
+    \brief Defines the ZeroMomentumUpdaterGPU class
+*/
+
+#include "ZeroMomentumUpdaterGPU.h"
+#include "ZeroMomentumUpdaterGPU.cuh"
+
+using namespace std;
+namespace py = pybind11;
+
+/*! \param sysdef System to zero the momentum of
+ */
+ZeroMomentumUpdaterGPU::ZeroMomentumUpdaterGPU(std::shared_ptr<SystemDefinition> sysdef)
+    : ZeroMomentumUpdater(sysdef), m_block_size(256)
+    {
+    m_exec_conf->msg->notice(5) << "Constructing ZeroMomentumUpdaterGPU" << endl;
+
+    if (!m_exec_conf->isCUDAEnabled())
+        {
+        m_exec_conf->msg->error()
+            << "Creating a ZeroMomentumUpdaterGPU with no GPU in the execution configuration"
+            << endl;
+        throw std::runtime_error("Error initializing ZeroMomentumUpdaterGPU");
+        }
+
+    GPUArray<Scalar4> scratch(m_pdata->getN() / m_block_size + 1, m_exec_conf);
+    m_scratch.swap(scratch);
+    GPUArray<Scalar4> sum(1, m_exec_conf);
+    m_sum.swap(sum);
+
+    unsigned int warp_size = m_exec_conf->dev_prop.warpSize;
+    m_tuner.reset(
+        new Autotuner(warp_size, 1024, warp_size, 5, 100000, "zero_momentum", m_exec_conf));
+    }
+
+ZeroMomentumUpdaterGPU::~ZeroMomentumUpdaterGPU()
+    {
+    m_exec_conf->msg->notice(5) << "Destroying ZeroMomentumUpdaterGPU" << endl;
+    }
+
+/*! Perform the needed calculations to zero the system's momentum
+    \param timestep Current time step of the simulation
+*/
+void ZeroMomentumUpdaterGPU::update(uint64_t timestep)
+    {
+    Updater::update(timestep);
+    if (m_prof)
+        m_prof->push(m_exec_conf, "ZeroMomentum");
+
+    const unsigned int N = m_pdata->getN();
+    const unsigned int num_blocks = N / m_block_size + 1;
+    if (m_scratch.getNumElements() < num_blocks)
+        m_scratch.resize(num_blocks);
+
+    ArrayHandle<Scalar4> d_vel(m_pdata->getVelocities(),
+                               access_location::device,
+                               access_mode::readwrite);
+    ArrayHandle<unsigned int> d_body(m_pdata->getBodies(),
+                                     access_location::device,
+                                     access_mode::read);
+    ArrayHandle<unsigned int> d_tag(m_pdata->getTags(), access_location::device, access_mode::read);
+
+        {
+        ArrayHandle<Scalar4> d_scratch(m_scratch, access_location::device, access_mode::overwrite);
+        ArrayHandle<Scalar4> d_sum(m_sum, access_location::device, access_mode::overwrite);
+
+        gpu_zero_momentum_sum(d_sum.data,
+                              d_scratch.data,
+                              d_vel.data,
+                              d_body.data,
+                              d_tag.data,
+                              N,
+                              m_block_size,
+                              num_blocks);
+        if (m_exec_conf->isCUDAErrorCheckingEnabled())
+            CHECK_CUDA_ERROR();
+        }
+
+#ifdef ENABLE_MPI
+    if (m_pdata->getDomainDecomposition())
+        {
+        ArrayHandle<Scalar4> h_sum(m_sum, access_location::host, access_mode::readwrite);
+        MPI_Allreduce(MPI_IN_PLACE,
+                      &h_sum.data[0],
+                      4,
+                      MPI_HOOMD_SCALAR,
+                      MPI_SUM,
+                      m_exec_conf->getMPICommunicator());
+        }
+#endif
+
+    ArrayHandle<Scalar4> d_sum(m_sum, access_location::device, access_mode::read);
+
+    m_tuner->begin();
+    gpu_zero_momentum_apply(d_vel.data,
+                            d_body.data,
+                            d_tag.data,
+                            d_sum.data,
+                            N,
+                            m_tuner->getParam());
+    if (m_exec_conf->isCUDAErrorCheckingEnabled())
+        CHECK_CUDA_ERROR();
+    m_tuner->end();
+
+    if (m_prof)
+        m_prof->pop(m_exec_conf);
+    }
+
+void export_ZeroMomentumUpdaterGPU(py::module& m)
+    {
+    py::class_<ZeroMomentumUpdaterGPU,
+               ZeroMomentumUpdater,
+               std::shared_ptr<ZeroMomentumUpdaterGPU>>(m, "ZeroMomentumUpdaterGPU")
+        .def(py::init<std::shared_ptr<SystemDefinition>>());
+    }
@@ -0,0 +1,241 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "ZeroMomentumUpdaterGPU.cuh"
+
+#include <assert.h>
+
+/*! \file ZeroMomentumUpdaterGPU.cu
+    \brief Defines GPU kernel code for zeroing the momentum of the system on the GPU. Used by
+   ZeroMomentumUpdaterGPU.
+*/
+
+//! Perform partial sums of the momentum on the GPU
+/*! \param d_scratch Scratch space to hold partial sums. One element is written per block
+    \param d_vel Particle velocity and mass array from ParticleData
+    \param d_body Particle body id
+    \param d_tag Particle tag
+    \param N Number of local particles
+
+    The momentum of every free particle (including floppy body particles) and every central
+    particle of a rigid body is summed in .x, .y, and .z, and the number of such particles in .w.
+
+    One thread is executed per particle. The block performs a reduction in shared memory and writes
+    its partial sum to d_scratch[blockIdx.x]. sizeof(Scalar4)*block_size of dynamic shared memory
+    are needed for this kernel to run, and block_size must be a power of two.
+*/
+__global__ void gpu_zero_momentum_partial_sums(Scalar4* d_scratch,
+                                               const Scalar4* d_vel,
+                                               const unsigned int* d_body,
+                                               const unsigned int* d_tag,
+                                               const unsigned int N)
+    {
+    HIP_DYNAMIC_SHARED(Scalar4, zero_momentum_sdata)
+
+    unsigned int idx = blockIdx.x * blockDim.x + threadIdx.x;
+
+    // non-participating thread: contribute 0 to the sum
+    Scalar4 my_element = make_scalar4(0, 0, 0, 0);
+
+    if (idx < N)
+        {
+        unsigned int body = d_body[idx];
+        if (body >= MIN_FLOPPY || body == d_tag[idx])
+            {
+            Scalar4 vel = d_vel[idx];
+            Scalar mass = vel.w;
+            my_element = make_scalar4(mass * vel.x, mass * vel.y, mass * vel.z, 1);
+            }
+        }
+
+    zero_momentum_sdata[threadIdx.x] = my_element;
+    __syncthreads();
+
+    // reduce the sum in parallel
+    int offs = blockDim.x >> 1;
+    while (offs > 0)
+        {
+        if (threadIdx.x < offs)
+            {
+            zero_momentum_sdata[threadIdx.x].x += zero_momentum_sdata[threadIdx.x + offs].x;
+            zero_momentum_sdata[threadIdx.x].y += zero_momentum_sdata[threadIdx.x + offs].y;
+            zero_momentum_sdata[threadIdx.x].z += zero_momentum_sdata[threadIdx.x + offs].z;
+            zero_momentum_sdata[threadIdx.x].w += zero_momentum_sdata[threadIdx.x + offs].w;
+            }
+        offs >>= 1;
+        __syncthreads();
+        }
+
+    // write out our partial sum
+    if (threadIdx.x == 0)
+        d_scratch[blockIdx.x] = zero_momentum_sdata[0];
+    }
+
+//! Complete the partial sums of the momentum on the GPU
+/*! \param d_sum Total momentum (one element)
+    \param d_scratch Partial sums from gpu_zero_momentum_partial_sums
+    \param num_partial_sums Number of partial sums in \a d_scratch
+
+    Executed with a single block. sizeof(Scalar4)*block_size of dynamic shared memory are needed
+    for this kernel to run, and block_size must be a power of two.
+*/
+__global__ void gpu_zero_momentum_final_sum(Scalar4* d_sum,
+                                            const Scalar4* d_scratch,
+                                            const unsigned int num_partial_sums)
+    {
+    HIP_DYNAMIC_SHARED(Scalar4, zero_momentum_sdata)
+
+    Scalar4 final_sum = make_scalar4(0, 0, 0, 0);
+
+    // sum up the values in the partial sum via a sliding window
+    for (unsigned int start = 0; start < num_partial_sums; start += blockDim.x)
+        {
+        if (start + threadIdx.x < num_partial_sums)
+            zero_momentum_sdata[threadIdx.x] = d_scratch[start + threadIdx.x];
+        else
+            zero_momentum_sdata[threadIdx.x] = make_scalar4(0, 0, 0, 0);
+        __syncthreads();
+
+        // reduce the sum in parallel
+        int offs = blockDim.x >> 1;
+        while (offs > 0)
+            {
+            if (threadIdx.x < offs)
+                {
+                zero_momentum_sdata[threadIdx.x].x += zero_momentum_sdata[threadIdx.x + offs].x;
+                zero_momentum_sdata[threadIdx.x].y += zero_momentum_sdata[threadIdx.x + offs].y;
+                zero_momentum_sdata[threadIdx.x].z += zero_momentum_sdata[threadIdx.x + offs].z;
+                zero_momentum_sdata[threadIdx.x].w += zero_momentum_sdata[threadIdx.x + offs].w;
+                }
+            offs >>= 1;
+            __syncthreads();
+            }
+
+        // everybody sums up the total
+        final_sum.x += zero_momentum_sdata[0].x;
+        final_sum.y += zero_momentum_sdata[0].y;
+        final_sum.z += zero_momentum_sdata[0].z;
+        final_sum.w += zero_momentum_sdata[0].w;
+        __syncthreads();
+        }
+
+    if (threadIdx.x == 0)
+        *d_sum = final_sum;
+    }
+
+/*! \param d_sum Total momentum (one element)
+    \param d_scratch Scratch space for \a num_blocks partial sums
+    \param d_vel Particle velocity and mass array from ParticleData
+    \param d_body Particle body id
+    \param d_tag Particle tag
+    \param N Number of local particles
+    \param block_size Block size to execute on the GPU (power of two)
+    \param num_blocks Number of blocks, must be at least N / block_size + 1
+
+    The result stays on the device, see gpu_zero_momentum_partial_sums for the layout.
+*/
+hipError_t gpu_zero_momentum_sum(Scalar4* d_sum,
+                                 Scalar4* d_scratch,
+                                 const Scalar4* d_vel,
+                                 const unsigned int* d_body,
+                                 const unsigned int* d_tag,
+                                 const unsigned int N,
+                                 const unsigned int block_size,
+                                 const unsigned int num_blocks)
+    {
+    assert(d_sum);
+    assert(d_scratch);
+    assert(num_blocks >= N / block_size + 1);
+
+    hipLaunchKernelGGL((gpu_zero_momentum_partial_sums),
+                       dim3(num_blocks),
+                       dim3(block_size),
+                       block_size * sizeof(Scalar4),
+                       0,
+                       d_scratch,
+                       d_vel,
+                       d_body,
+                       d_tag,
+                       N);
+
+    hipLaunchKernelGGL((gpu_zero_momentum_final_sum),
+                       dim3(1),
+                       dim3(block_size),
+                       block_size * sizeof(Scalar4),
+                       0,
+                       d_sum,
+                       d_scratch,
+                       num_blocks);
+
+    return hipSuccess;
+    }
+
+//! Subtract the average momentum on the GPU
+/*! \param d_vel Particle velocity and mass array from ParticleData
+    \param d_body Particle body id
+    \param d_tag Particle tag
+    \param d_sum Total momentum and number of particles it was summed over
+    \param N Number of local particles
+*/
+__global__ void gpu_zero_momentum_apply_kernel(Scalar4* d_vel,
+                                               const unsigned int* d_body,
+                                               const unsigned int* d_tag,
+                                               const Scalar4* d_sum,
+                                               const unsigned int N)
+    {
+    unsigned int idx = blockIdx.x * blockDim.x + threadIdx.x;
+
+    if (idx >= N)
+        return;
+
+    unsigned int body = d_body[idx];
+    if (body >= MIN_FLOPPY || body == d_tag[idx])
+        {
+        Scalar4 sum = *d_sum;
+        Scalar4 vel = d_vel[idx];
+        Scalar mass = vel.w;
+
+        vel.x -= sum.x / sum.w / mass;
+        vel.y -= sum.y / sum.w / mass;
+        vel.z -= sum.z / sum.w / mass;
+        d_vel[idx] = vel;
+        }
+    }
+
+/*! \param d_vel Particle velocity and mass array from ParticleData
+    \param d_body Particle body id
+    \param d_tag Particle tag
+    \param d_sum Total momentum and number of particles it was summed over
+    \param N Number of local particles
+    \param block_size Block size to execute on the GPU
+*/
+hipError_t gpu_zero_momentum_apply(Scalar4* d_vel,
+                                   const unsigned int* d_body,
+                                   const unsigned int* d_tag,
+                                   const Scalar4* d_sum,
+                                   const unsigned int N,
+                                   const unsigned int block_size)
+    {
+    static unsigned int max_block_size = UINT_MAX;
+    if (max_block_size == UINT_MAX)
+        {
+        hipFuncAttributes attr;
+        hipFuncGetAttributes(&attr, (const void*)gpu_zero_momentum_apply_kernel);
+        max_block_size = attr.maxThreadsPerBlock;
+        }
+
+    unsigned int run_block_size = min(block_size, max_block_size);
+
+    hipLaunchKernelGGL((gpu_zero_momentum_apply_kernel),
+                       dim3(N / run_block_size + 1),
+                       dim3(run_block_size),
+                       0,
+                       0,
+                       d_vel,
+                       d_body,
+                       d_tag,
+                       d_sum,
+                       N);
+
+    return hipSuccess;
+    }
@@ -0,0 +1,34 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "hoomd/HOOMDMath.h"
+#include "hoomd/ParticleData.cuh"
+#include <hip/hip_runtime.h>
+
+/*! \file ZeroMomentumUpdaterGPU.cuh
+    \brief Declares GPU kernel code for zeroing the momentum of the system on the GPU. Used by
+   ZeroMomentumUpdaterGPU.
+*/
+
+#ifndef __ZERO_MOMENTUM_UPDATER_GPU_CUH__
+#define __ZERO_MOMENTUM_UPDATER_GPU_CUH__
+
+//! Kernel driver to sum the momentum of the free particles and rigid body centers
+hipError_t gpu_zero_momentum_sum(Scalar4* d_sum,
+                                 Scalar4* d_scratch,
+                                 const Scalar4* d_vel,
+                                 const unsigned int* d_body,
+                                 const unsigned int* d_tag,
+                                 const unsigned int N,
+                                 const unsigned int block_size,
+                                 const unsigned int num_blocks);
+
+//! Kernel driver to subtract the average momentum
+hipError_t gpu_zero_momentum_apply(Scalar4* d_vel,
+                                   const unsigned int* d_body,
+                                   const unsigned int* d_tag,
+                                   const Scalar4* d_sum,
+                                   const unsigned int N,
+                                   const unsigned int block_size);
+
+#endif // __ZERO_MOMENTUM_UPDATER_GPU_CUH__
@@ -0,0 +1,62 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*! \file ZeroMomentumUpdaterGPU.h
+    \brief Declares an updater that zeros the momentum of the system on the GPU
+*/
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include "ZeroMomentumUpdater.h"
+#include "hoomd/Autotuner.h"
+#include "hoomd/GPUArray.h"
+
+#include <memory>
+#include <pybind11/pybind11.h>
+
+#ifndef __ZEROMOMENTUMUPDATER_GPU_H__
+#define __ZEROMOMENTUMUPDATER_GPU_H__
+
+//! Updates particle velocities to zero the momentum on the GPU
+/*! The momentum is reduced on the device and the correction is applied in place, so the
+    velocities never leave the device. Only the four summed values are copied to the host when the
+    sum must be reduced over MPI ranks.
+
+    \ingroup updaters
+*/
+class PYBIND11_EXPORT ZeroMomentumUpdaterGPU : public ZeroMomentumUpdater
+    {
+    public:
+    //! Constructor
+    ZeroMomentumUpdaterGPU(std::shared_ptr<SystemDefinition> sysdef);
+
+    //! Destructor
+    virtual ~ZeroMomentumUpdaterGPU();
+
+    //! Set autotuner parameters
+    /*! \param enable Enable/disable autotuning
+        \param period period (approximate) in time steps when returning occurs
+    */
+    virtual void setAutotunerParams(bool enable, unsigned int period)
+        {
+        ZeroMomentumUpdater::setAutotunerParams(enable, period);
+        m_tuner->setPeriod(period);
+        m_tuner->setEnabled(enable);
+        }
+
+    //! Take one timestep forward
+    virtual void update(uint64_t timestep);
+
+    protected:
+    unsigned int m_block_size;          //!< Block size (power of two) of the momentum reduction
+    GPUArray<Scalar4> m_scratch;        //!< Partial sums of the momentum, one per block
+    GPUArray<Scalar4> m_sum;            //!< Total momentum (.x, .y, .z) and particle count (.w)
+    std::unique_ptr<Autotuner> m_tuner; //!< Autotuner for the block size of the correction
+    };
+
+//! Export the ZeroMomentumUpdaterGPU class to python
+void export_ZeroMomentumUpdaterGPU(pybind11::module& m);
+
+#endif
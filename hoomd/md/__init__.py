@@ -11,6 +11,8 @@ from hoomd.md import angle
 from hoomd.md import bond
 from hoomd.md import compute
 from hoomd.md import constrain
+from hoomd.md import correlator
+from hoomd.md import data
 from hoomd.md import dihedral
 from hoomd.md import external
 from hoomd.md import force
@@ -23,5 +25,6 @@ from hoomd.md import pair
 from hoomd.md import update
 from hoomd.md import wall
 from hoomd.md import special_pair
+from hoomd.md import tune
 from hoomd.md import methods
 from hoomd.md import many_body
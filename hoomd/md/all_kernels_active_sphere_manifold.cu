@@ -4,14 +4,23 @@
 #include "ActiveForceConstraintComputeGPU.cuh"
 #include "ManifoldSphere.h"
 
-template hipError_t
-gpu_compute_active_force_set_constraints<ManifoldSphere>(const unsigned int group_size,
-                                                         unsigned int* d_index_array,
-                                                         const Scalar4* d_pos,
-                                                         Scalar4* d_orientation,
-                                                         const Scalar4* d_f_act,
-                                                         ManifoldSphere manifold,
-                                                         unsigned int block_size);
+template hipError_t gpu_compute_active_force_constraint_set_forces<ManifoldSphere>(
+    const unsigned int group_size,
+    unsigned int* d_index_array,
+    Scalar4* d_force,
+    Scalar4* d_torque,
+    const Scalar4* d_pos,
+    Scalar4* d_orientation,
+    const Scalar4* d_f_act,
+    const Scalar4* d_t_act,
+    const unsigned int N,
+    ManifoldSphere manifold,
+    unsigned int* d_tag,
+    bool rotational_diffusion,
+    const Scalar rotationConst,
+    const uint64_t timestep,
+    const uint16_t seed,
+    unsigned int block_size);
 
 template hipError_t gpu_compute_active_force_constraint_rotational_diffusion<ManifoldSphere>(
     const unsigned int group_size,
@@ -4,14 +4,23 @@
 #include "ActiveForceConstraintComputeGPU.cuh"
 #include "ManifoldXYPlane.h"
 
-template hipError_t
-gpu_compute_active_force_set_constraints<ManifoldXYPlane>(const unsigned int group_size,
-                                                          unsigned int* d_index_array,
-                                                          const Scalar4* d_pos,
-                                                          Scalar4* d_orientation,
-                                                          const Scalar4* d_f_act,
-                                                          ManifoldXYPlane manifold,
-                                                          unsigned int block_size);
+template hipError_t gpu_compute_active_force_constraint_set_forces<ManifoldXYPlane>(
+    const unsigned int group_size,
+    unsigned int* d_index_array,
+    Scalar4* d_force,
+    Scalar4* d_torque,
+    const Scalar4* d_pos,
+    Scalar4* d_orientation,
+    const Scalar4* d_f_act,
+    const Scalar4* d_t_act,
+    const unsigned int N,
+    ManifoldXYPlane manifold,
+    unsigned int* d_tag,
+    bool rotational_diffusion,
+    const Scalar rotationConst,
+    const uint64_t timestep,
+    const uint16_t seed,
+    unsigned int block_size);
 
 template hipError_t gpu_compute_active_force_constraint_rotational_diffusion<ManifoldXYPlane>(
     const unsigned int group_size,
@@ -12,6 +12,7 @@ from hoomd.operation import Compute
 from hoomd.data.parameterdicts import ParameterDict
 from hoomd.logging import log
 import hoomd
+import numpy
 
 
 class _Thermo(Compute):
@@ -51,6 +52,11 @@ class ThermodynamicQuantities(_Thermo):
         self._cpp_obj = thermo_cls(self._simulation.state._cpp_sys_def, group)
         super()._attach()
 
+    def _compute(self, quantity):
+        # Evaluate only the requested group of quantities on this step.
+        self._cpp_obj.computeQuantities(self._simulation.timestep,
+                                        int(quantity))
+
     @log(requires_run=True)
     def kinetic_temperature(self):
         """:math:`kT_k`, instantaneous thermal energy of the group \
@@ -62,7 +68,7 @@ class ThermodynamicQuantities(_Thermo):
 
             kT_k = 2 \\cdot \\frac{K}{N_{\\mathrm{dof}}}
         """
-        self._cpp_obj.compute(self._simulation.timestep)
+        self._compute(_md.ThermoQuantity.rotational_kinetic_energy)
         return self._cpp_obj.kinetic_temperature
 
     @log(requires_run=True)
@@ -91,7 +97,7 @@ class ThermodynamicQuantities(_Thermo):
         due to explicit constraints, implicit rigid body constraints, external
         walls, and fields.
         """
-        self._cpp_obj.compute(self._simulation.timestep)
+        self._compute(_md.ThermoQuantity.pressure)
         return self._cpp_obj.pressure
 
     @log(category='sequence', requires_run=True)
@@ -112,7 +118,7 @@ class ThermodynamicQuantities(_Thermo):
 
         where :math:`V` is the total simulation box volume (or area in 2D).
         """
-        self._cpp_obj.compute(self._simulation.timestep)
+        self._compute(_md.ThermoQuantity.pressure_tensor)
         return self._cpp_obj.pressure_tensor
 
     @log(requires_run=True)
@@ -125,7 +131,7 @@ class ThermodynamicQuantities(_Thermo):
             K = K_{\\mathrm{rot}} + K_{\\mathrm{trans}}
 
         """
-        self._cpp_obj.compute(self._simulation.timestep)
+        self._compute(_md.ThermoQuantity.rotational_kinetic_energy)
         return self._cpp_obj.kinetic_energy
 
     @log(requires_run=True)
@@ -141,7 +147,7 @@ class ThermodynamicQuantities(_Thermo):
             m_i|\vec{v}_i|^2
 
         """
-        self._cpp_obj.compute(self._simulation.timestep)
+        self._compute(_md.ThermoQuantity.kinetic_energy)
         return self._cpp_obj.translational_kinetic_energy
 
     @log(requires_run=True)
@@ -162,7 +168,7 @@ class ThermodynamicQuantities(_Thermo):
         where :math:`I` is the moment of inertia and :math:`L` is the angular
         momentum in the (diagonal) reference frame of the particle.
         """
-        self._cpp_obj.compute(self._simulation.timestep)
+        self._compute(_md.ThermoQuantity.rotational_kinetic_energy)
         return self._cpp_obj.rotational_kinetic_energy
 
     @log(requires_run=True)
@@ -212,7 +218,7 @@ class ThermodynamicQuantities(_Thermo):
         potentials are summed similar to the other terms using per-particle
         contributions.
         """
-        self._cpp_obj.compute(self._simulation.timestep)
+        self._compute(_md.ThermoQuantity.kinetic_energy)
         return self._cpp_obj.potential_energy
 
     @log(requires_run=True)
@@ -297,6 +303,12 @@ class HarmonicAveragedThermodynamicQuantities(Compute):
     are saved either during first call to `Simulation.run` or when the compute
     is first added to the simulation, whichever occurs last.
 
+    `HarmonicAveragedThermodynamicQuantities` also provides the conventional
+    potential energy and pressure. It evaluates the conventional and HMA
+    estimators together in one pass over the particles (and one MPI
+    reduction), so log both from this compute instead of adding a separate
+    `ThermodynamicQuantities` for the same particles.
+
     Note:
         `HarmonicAveragedThermodynamicQuantities` is an implementation of the
         methods section of Sabry G. Moustafa, Andrew J. Schultz, and David A.
@@ -335,22 +347,282 @@ class HarmonicAveragedThermodynamicQuantities(Compute):
 
     def _attach(self):
         if isinstance(self._simulation.device, hoomd.device.CPU):
-            thermoHMA_cls = _md.ComputeThermoHMA
+            thermo_cls = _md.ComputeThermo
         else:
-            thermoHMA_cls = _md.ComputeThermoHMAGPU
+            thermo_cls = _md.ComputeThermoGPU
         group = self._simulation.state._get_group(self._filter)
-        self._cpp_obj = thermoHMA_cls(self._simulation.state._cpp_sys_def,
-                                      group, self.kT, self.harmonic_pressure)
+        self._cpp_obj = thermo_cls(self._simulation.state._cpp_sys_def, group)
+        self._cpp_obj.setLatticeSites()
         super()._attach()
 
+    def _compute(self):
+        # Evaluate the HMA and conventional estimators in the same pass.
+        self._cpp_obj.computeQuantities(
+            self._simulation.timestep,
+            int(_md.ThermoQuantity.hma | _md.ThermoQuantity.pressure))
+
     @log(requires_run=True)
     def potential_energy(self):
         """Average potential energy :math:`[\\mathrm{energy}]`."""
-        self._cpp_obj.compute(self._simulation.timestep)
-        return self._cpp_obj.potential_energy
+        self._compute()
+        return self._cpp_obj.potential_energy_hma
 
     @log(requires_run=True)
     def pressure(self):
         """Average pressure :math:`[\\mathrm{pressure}]`."""
-        self._cpp_obj.compute(self._simulation.timestep)
+        self._compute()
+        return self._cpp_obj.pressure_hma
+
+    @log(requires_run=True)
+    def conventional_potential_energy(self):
+        """Conventional potential energy :math:`[\\mathrm{energy}]`.
+
+        The same as `ThermodynamicQuantities.potential_energy`.
+        """
+        self._compute()
+        return self._cpp_obj.potential_energy
+
+    @log(requires_run=True)
+    def conventional_pressure(self):
+        """Conventional pressure :math:`[\\mathrm{pressure}]`.
+
+        The same as `ThermodynamicQuantities.pressure`.
+        """
+        self._compute()
         return self._cpp_obj.pressure
+
+
+class RDF(Compute):
+    r"""Compute the radial distribution function of each pair of types.
+
+    Args:
+        nlist (`hoomd.md.nlist.NList`): Neighbor list used to find the pairs.
+        bins (int): Number of bins between 0 and ``r_max``.
+        r_max (float): Maximum pair distance :math:`[\mathrm{length}]`.
+
+    `RDF` histograms the distances between the pairs of particles in the
+    neighbor list and computes the radial distribution function
+
+    .. math::
+
+        g_{ab}(r) = \frac{V}{N_a N_b} \left\langle \sum_{i \in a}
+        \sum_{j \in b, j \ne i} \frac{\delta(r - r_{ij})}{4 \pi r^2}
+        \right\rangle
+
+    for every unordered pair of types :math:`(a, b)`, where :math:`V` is the
+    volume of the simulation box (use :math:`2 \pi r` in place of
+    :math:`4 \pi r^2` and the area in 2D) and :math:`N_a (N_a - 1)` replaces
+    :math:`N_a N_b` when :math:`a = b`.
+
+    `RDF` adds a frame to the average each time you access `rdf` or
+    `num_frames` on a new time step, such as when a `hoomd.logging.Logger`
+    requests the values. Use `reset` to start a new average.
+
+    `RDF` requests ``r_max`` from the neighbor list, which then also includes
+    all pairs within ``r_max`` in the forces that share it. Pairs excluded
+    from the neighbor list (see `hoomd.md.nlist.NList.exclusions`) are not
+    counted.
+
+    Examples::
+
+        rdf = hoomd.md.compute.RDF(nlist=nlist, bins=100, r_max=3.0)
+        sim.operations.computes.append(rdf)
+        logger.add(rdf, quantities=['rdf'])
+    """
+
+    def __init__(self, nlist, bins, r_max):
+        self._nlist = hoomd.data.typeconverter.OnlyTypes(
+            hoomd.md.nlist.NList)(nlist)
+        self._bins = int(bins)
+        self._r_max = float(r_max)
+
+    def _attach(self):
+        if not self._nlist._added:
+            self._nlist._add(self._simulation)
+        else:
+            if self._simulation != self._nlist._simulation:
+                raise RuntimeError("{} object's neighbor list is used in a "
+                                   "different simulation.".format(type(self)))
+
+        if not self.nlist._attached:
+            self.nlist._attach()
+
+        if isinstance(self._simulation.device, hoomd.device.CPU):
+            rdf_cls = _md.ComputeRDF
+        else:
+            rdf_cls = _md.ComputeRDFGPU
+        self._cpp_obj = rdf_cls(self._simulation.state._cpp_sys_def,
+                                self.nlist._cpp_obj, self._bins, self._r_max)
+        super()._attach()
+
+    @property
+    def nlist(self):
+        """hoomd.md.nlist.NList: Neighbor list used to find the pairs."""
+        return self._nlist
+
+    @nlist.setter
+    def nlist(self, value):
+        if self._attached:
+            raise RuntimeError("nlist cannot be set after scheduling.")
+        self._nlist = hoomd.data.typeconverter.OnlyTypes(
+            hoomd.md.nlist.NList)(value)
+
+    @property
+    def _children(self):
+        return [self.nlist]
+
+    @property
+    def bins(self):
+        """int: Number of bins between 0 and ``r_max``."""
+        return self._bins
+
+    @property
+    def r_max(self):
+        """float: Maximum pair distance :math:`[\\mathrm{length}]`."""
+        return self._r_max
+
+    @log(category='sequence')
+    def bin_centers(self):
+        """(*bins*,) `numpy.ndarray` of ``numpy.float64``: Distance at the \
+        center of each bin :math:`[\\mathrm{length}]`."""
+        return (numpy.arange(self._bins) + 0.5) * self._r_max / self._bins
+
+    @property
+    def type_pairs(self):
+        """list[tuple[str, str]]: Type pair of each row of `rdf`."""
+        types = self._simulation.state.particle_types
+        return [(a, b) for i, a in enumerate(types) for b in types[i:]]
+
+    @log(category='sequence', requires_run=True)
+    def rdf(self):
+        """(*N_type_pairs*, *bins*) `numpy.ndarray` of ``numpy.float64``: \
+        :math:`g(r)` averaged over all frames since the last `reset`.
+
+        Rows are ordered like `type_pairs`.
+        """
+        self._cpp_obj.compute(self._simulation.timestep)
+        return self._cpp_obj.rdf
+
+    @log(requires_run=True)
+    def num_frames(self):
+        """int: Number of frames averaged since the last `reset`."""
+        self._cpp_obj.compute(self._simulation.timestep)
+        return self._cpp_obj.num_frames
+
+    def reset(self):
+        """Clear the accumulated average."""
+        if self._attached:
+            self._cpp_obj.reset()
+
+
+class StructureFactor(Compute):
+    r"""Compute the static structure factor on a mesh.
+
+    Args:
+        filter (``hoomd.filter``): Particles to include in the density.
+        mesh (tuple[int, int, int]): Number of mesh points along each lattice
+            vector of the box. Set the last element to 1 in 2D.
+        bins (int): Number of bins between 0 and ``q_max``.
+        q_max (float): Maximum wave vector magnitude
+            :math:`[\mathrm{length}^{-1}]`.
+
+    `StructureFactor` assigns the selected particles to a periodic mesh with
+    cloud in cell weights, as `hoomd.md.long_range.pppm` does with the charges,
+    Fourier transforms the density, and computes
+
+    .. math::
+
+        S(q) = \frac{1}{N} \left\langle \left| \sum_{j \in \mathrm{filter}}
+        e^{-i \vec{q} \cdot \vec{r}_j} \right|^2 \right\rangle_{|\vec{q}| = q}
+
+    averaged over the wave vectors :math:`\vec{q} \ne 0` of the mesh in each
+    shell of :math:`|\vec{q}|`. `StructureFactor` divides out the Fourier
+    transform of the assignment function. The mesh spacing limits the usable
+    wave vectors: choose ``q_max`` well below :math:`\pi n / L` along every
+    axis, where aliasing grows.
+
+    `StructureFactor` adds a frame to the average each time you access
+    `structure_factor` or `num_frames` on a new time step, such as when a
+    `hoomd.logging.Logger` requests the values. Use `reset` to start a new
+    average.
+
+    Note:
+        With MPI domain decomposition, every rank stores and transforms the
+        whole mesh.
+
+    Examples::
+
+        sq = hoomd.md.compute.StructureFactor(filter=hoomd.filter.All(),
+                                              mesh=(64, 64, 64),
+                                              bins=50,
+                                              q_max=10.0)
+        sim.operations.computes.append(sq)
+        logger.add(sq, quantities=['structure_factor'])
+    """
+
+    def __init__(self, filter, mesh, bins, q_max):
+        self._filter = filter
+        self._mesh = tuple(int(n) for n in mesh)
+        if len(self._mesh) != 3:
+            raise ValueError("mesh must have 3 elements.")
+        self._bins = int(bins)
+        self._q_max = float(q_max)
+
+    def _attach(self):
+        if isinstance(self._simulation.device, hoomd.device.CPU):
+            sq_cls = _md.ComputeStructureFactor
+        else:
+            sq_cls = _md.ComputeStructureFactorGPU
+        group = self._simulation.state._get_group(self._filter)
+        self._cpp_obj = sq_cls(self._simulation.state._cpp_sys_def, group,
+                               *self._mesh, self._bins, self._q_max)
+        super()._attach()
+
+    @property
+    def filter(self):
+        """hoomd.filter.ParticleFilter: Particles to include in the density."""
+        return self._filter
+
+    @property
+    def mesh(self):
+        """tuple[int, int, int]: Number of mesh points along each lattice \
+        vector."""
+        return self._mesh
+
+    @property
+    def bins(self):
+        """int: Number of bins between 0 and ``q_max``."""
+        return self._bins
+
+    @property
+    def q_max(self):
+        """float: Maximum wave vector magnitude \
+        :math:`[\\mathrm{length}^{-1}]`."""
+        return self._q_max
+
+    @log(category='sequence')
+    def bin_centers(self):
+        """(*bins*,) `numpy.ndarray` of ``numpy.float64``: Wave vector \
+        magnitude at the center of each bin :math:`[\\mathrm{length}^{-1}]`."""
+        return (numpy.arange(self._bins) + 0.5) * self._q_max / self._bins
+
+    @log(category='sequence', requires_run=True)
+    def structure_factor(self):
+        """(*bins*,) `numpy.ndarray` of ``numpy.float64``: :math:`S(q)` \
+        averaged over all frames since the last `reset`.
+
+        Bins that contain no wave vectors of the mesh are 0.
+        """
+        self._cpp_obj.compute(self._simulation.timestep)
+        return self._cpp_obj.structure_factor
+
+    @log(requires_run=True)
+    def num_frames(self):
+        """int: Number of frames averaged since the last `reset`."""
+        self._cpp_obj.compute(self._simulation.timestep)
+        return self._cpp_obj.num_frames
+
+    def reset(self):
+        """Clear the accumulated average."""
+        if self._attached:
+            self._cpp_obj.reset()
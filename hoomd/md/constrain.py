@@ -24,7 +24,7 @@ accounted for in `hoomd.md.ThermodynamicQuantities`.
 from hoomd.md import _md
 from hoomd.data.parameterdicts import ParameterDict, TypeParameterDict
 from hoomd.data.typeparam import TypeParameter
-from hoomd.data.typeconverter import OnlyIf, to_type_converter
+from hoomd.data.typeconverter import OnlyFrom, OnlyIf, to_type_converter
 import hoomd
 from hoomd.operation import _HOOMDBaseObject
 
@@ -49,6 +49,10 @@ class Distance(Constraint):
 
     Args:
         tolerance (float): Relative tolerance for constraint violation warnings.
+        solver (str): Method to solve the constraint equations, ``'lu'`` or
+            ``'iterative'``.
+        solver_tolerance (float): Relative residual at which the iterative
+            solver stops.
 
     `Distance` applies forces between particles to constrain the distances
     between particles to specific values. The algorithm implemented is described
@@ -94,14 +98,31 @@ class Distance(Constraint):
         issue a warning message. It does not influence the computation of the
         constraint force.
 
+    With ``solver='lu'``, the sparse linear system is factorized on every
+    step. With ``solver='iterative'``, it is solved with BiCGSTAB and a
+    diagonal preconditioner starting from the Lagrange multipliers of the
+    previous step, which is faster for large numbers of constraints that change
+    little between steps. Steps where the iteration does not converge fall back
+    to the LU factorization. The iterative solver runs on the CPU, also in GPU
+    simulations.
+
     Attributes:
         tolerance (float): Relative tolerance for constraint violation warnings.
+        solver (str): Method to solve the constraint equations, ``'lu'`` or
+            ``'iterative'``.
+        solver_tolerance (float): Relative residual at which the iterative
+            solver stops.
     """
 
     _cpp_class_name = "ForceDistanceConstraint"
 
-    def __init__(self, tolerance=1e-3):
-        self._param_dict.update(ParameterDict(tolerance=float(tolerance)))
+    def __init__(self, tolerance=1e-3, solver='lu', solver_tolerance=1e-10):
+        self._param_dict.update(
+            ParameterDict(tolerance=float(tolerance),
+                          solver=OnlyFrom(['lu', 'iterative']),
+                          solver_tolerance=float(solver_tolerance),
+                          _defaults={"solver": "lu"}))
+        self.solver = solver
 
 
 class Rigid(Constraint):
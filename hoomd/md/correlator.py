@@ -0,0 +1,255 @@
+# Copyright (c) 2009-2021 The Regents of the University of Michigan
+# This file is part of the HOOMD-blue project, released under the BSD 3-Clause
+# License.
+
+r"""Time correlation functions computed during the simulation.
+
+The correlators in this module accumulate time correlation functions with a
+multiple-tau correlator (`Ramirez et al. 2010
+<https://doi.org/10.1063/1.3491098>`_) on each timestep where they trigger, so
+there is no need to log every step and post-process the time series.
+
+Level 0 of the correlator holds the last *points* samples and reports lags of
+0 to *points* - 1 samples. Each level :math:`k > 0` holds averages of
+:math:`m^k` consecutive samples, where :math:`m` is *averaging*, and reports
+lags :math:`j m^k` for :math:`j` from *points* / *averaging* to *points* - 1.
+The lags therefore span :math:`\mathrm{points} \cdot m^{\mathrm{levels} - 1}`
+samples with a fixed relative resolution. Correlations at lags longer than a
+level's block length are computed from block averages, which smooth the
+correlation at long lags.
+
+The lags are given in samples. Multiply them by the trigger period to obtain
+lags in timesteps.
+
+Add the correlators to `Operations.writers` and log `correlation` and
+`lags` with `hoomd.logging.Logger`.
+"""
+
+from hoomd.md import _md
+from hoomd.operation import Writer
+from hoomd.data.parameterdicts import ParameterDict
+from hoomd.filter import ParticleFilter, All
+from hoomd.logging import log
+import hoomd
+
+
+class _MultipleTau(Writer):
+    """Common parameters and loggable quantities of the correlators."""
+
+    def __init__(self, trigger, points, averaging, levels):
+        super().__init__(trigger)
+        self._param_dict.update(
+            ParameterDict(points=int(points),
+                          averaging=int(averaging),
+                          levels=int(levels)))
+
+    @log(category='sequence', requires_run=True)
+    def lags(self):
+        """(*N*,) `numpy.ndarray` of ``numpy.uint64``: Lag of each element of \
+        `correlation` in samples."""
+        return self._cpp_obj.lags
+
+    @log(category='sequence', requires_run=True)
+    def correlation(self):
+        """(*N*,) `numpy.ndarray` of ``numpy.float64``: Correlation at each \
+        lag, averaged over all samples since the last `reset`.
+
+        Lags that have not been reached yet are NaN.
+        """
+        return self._cpp_obj.correlation
+
+    @log(requires_run=True)
+    def num_samples(self):
+        """int: Number of samples since the last `reset`."""
+        return self._cpp_obj.num_samples
+
+    def reset(self):
+        """Clear the accumulated correlation."""
+        if self._attached:
+            self._cpp_obj.reset()
+
+
+class PressureTensor(_MultipleTau):
+    r"""Autocorrelation of the off-diagonal pressure tensor.
+
+    Args:
+        trigger (hoomd.trigger.Trigger): Select the timesteps to sample.
+        filter (hoomd.filter.ParticleFilter): Particles to compute the
+            pressure tensor of. Defaults to `hoomd.filter.All`.
+        points (int): Number of values per level. Defaults to 16.
+        averaging (int): Number of values averaged from one level to the next.
+            Defaults to 2.
+        levels (int): Number of levels. Defaults to 20.
+
+    `PressureTensor` computes
+
+    .. math::
+
+        C(t) = \frac{1}{3} \left\langle P_{xy}(0) P_{xy}(t)
+            + P_{xz}(0) P_{xz}(t) + P_{yz}(0) P_{yz}(t) \right\rangle
+
+    (:math:`\langle P_{xy}(0) P_{xy}(t) \rangle` in 2D), from which the
+    Green-Kubo relation gives the shear viscosity :math:`\eta = \frac{V}{kT}
+    \int_0^\infty C(t) dt`. `PressureTensor` requests the pressure tensor on
+    the timesteps where it triggers.
+
+    Examples::
+
+        pt = hoomd.md.correlator.PressureTensor(
+            trigger=hoomd.trigger.Periodic(1))
+        sim.operations.writers.append(pt)
+        logger.add(pt, quantities=['lags', 'correlation'])
+
+    Attributes:
+        trigger (hoomd.trigger.Trigger): Select the timesteps to sample.
+        filter (hoomd.filter.ParticleFilter): Particles to compute the
+            pressure tensor of (*read only*).
+        points (int): Number of values per level (*read only*).
+        averaging (int): Number of values averaged from one level to the next
+            (*read only*).
+        levels (int): Number of levels (*read only*).
+    """
+
+    def __init__(self, trigger, filter=All(), points=16, averaging=2,
+                 levels=20):
+        super().__init__(trigger, points, averaging, levels)
+        self._param_dict.update(ParameterDict(filter=ParticleFilter))
+        self.filter = filter
+
+    def _attach(self):
+        if isinstance(self._simulation.device, hoomd.device.CPU):
+            thermo_cls = _md.ComputeThermo
+        else:
+            thermo_cls = _md.ComputeThermoGPU
+        sys_def = self._simulation.state._cpp_sys_def
+        group = self._simulation.state._get_group(self.filter)
+        thermo = thermo_cls(sys_def, group)
+        self._cpp_obj = _md.CorrelatorPressureTensor(sys_def, thermo,
+                                                     self.points,
+                                                     self.averaging,
+                                                     self.levels)
+        super()._attach()
+
+
+class _Particle(_MultipleTau):
+    """Correlate the velocities or positions of particles."""
+
+    _position = None
+
+    def __init__(self, trigger, filter, points, averaging, levels):
+        super().__init__(trigger, points, averaging, levels)
+        self._param_dict.update(ParameterDict(filter=ParticleFilter))
+        self.filter = filter
+
+    def _attach(self):
+        if isinstance(self._simulation.device, hoomd.device.CPU):
+            cpp_cls = _md.CorrelatorParticle
+        else:
+            cpp_cls = _md.CorrelatorParticleGPU
+        group = self._simulation.state._get_group(self.filter)
+        self._cpp_obj = cpp_cls(self._simulation.state._cpp_sys_def, group,
+                                self._position, self.points, self.averaging,
+                                self.levels)
+        super()._attach()
+
+
+class Velocity(_Particle):
+    r"""Velocity autocorrelation function.
+
+    Args:
+        trigger (hoomd.trigger.Trigger): Select the timesteps to sample.
+        filter (hoomd.filter.ParticleFilter): Particles to correlate.
+        points (int): Number of values per level. Defaults to 16.
+        averaging (int): Number of values averaged from one level to the next.
+            Defaults to 2.
+        levels (int): Number of levels. Defaults to 12.
+
+    `Velocity` computes
+
+    .. math::
+
+        C(t) = \frac{1}{N} \sum_{i=1}^N \left\langle \vec{v}_i(0) \cdot
+            \vec{v}_i(t) \right\rangle
+
+    over the :math:`N` particles selected by the filter.
+
+    `Velocity` stores *levels* * *points* velocities of every particle. On
+    the GPU, the velocities and the correlation stay in device memory. The
+    filter must select the same particles throughout the simulation.
+
+    Note:
+        `Velocity` does not support MPI domain decomposition.
+
+    Examples::
+
+        vacf = hoomd.md.correlator.Velocity(trigger=hoomd.trigger.Periodic(1),
+                                            filter=hoomd.filter.All())
+        sim.operations.writers.append(vacf)
+
+    Attributes:
+        trigger (hoomd.trigger.Trigger): Select the timesteps to sample.
+        filter (hoomd.filter.ParticleFilter): Particles to correlate
+            (*read only*).
+        points (int): Number of values per level (*read only*).
+        averaging (int): Number of values averaged from one level to the next
+            (*read only*).
+        levels (int): Number of levels (*read only*).
+    """
+
+    _position = False
+
+    def __init__(self, trigger, filter, points=16, averaging=2, levels=12):
+        super().__init__(trigger, filter, points, averaging, levels)
+
+
+class MeanSquaredDisplacement(_Particle):
+    r"""Mean squared displacement.
+
+    Args:
+        trigger (hoomd.trigger.Trigger): Select the timesteps to sample.
+        filter (hoomd.filter.ParticleFilter): Particles to correlate.
+        points (int): Number of values per level. Defaults to 16.
+        averaging (int): Number of values averaged from one level to the next.
+            Defaults to 2.
+        levels (int): Number of levels. Defaults to 12.
+
+    `MeanSquaredDisplacement` computes
+
+    .. math::
+
+        \mathrm{MSD}(t) = \frac{1}{N} \sum_{i=1}^N \left\langle
+            \left| \vec{r}_i(t) - \vec{r}_i(0) \right|^2 \right\rangle
+
+    over the :math:`N` particles selected by the filter, where
+    :math:`\vec{r}_i` is the position unwrapped with the particle's image.
+    At lags above level 0, the positions are averaged over blocks of
+    samples.
+
+    `MeanSquaredDisplacement` stores *levels* * *points* positions of every
+    particle. On the GPU, the positions and the correlation stay in device
+    memory. The filter must select the same particles throughout the
+    simulation.
+
+    Note:
+        `MeanSquaredDisplacement` does not support MPI domain decomposition.
+
+    Examples::
+
+        msd = hoomd.md.correlator.MeanSquaredDisplacement(
+            trigger=hoomd.trigger.Periodic(10), filter=hoomd.filter.All())
+        sim.operations.writers.append(msd)
+
+    Attributes:
+        trigger (hoomd.trigger.Trigger): Select the timesteps to sample.
+        filter (hoomd.filter.ParticleFilter): Particles to correlate
+            (*read only*).
+        points (int): Number of values per level (*read only*).
+        averaging (int): Number of values averaged from one level to the next
+            (*read only*).
+        levels (int): Number of levels (*read only*).
+    """
+
+    _position = True
+
+    def __init__(self, trigger, filter, points=16, averaging=2, levels=12):
+        super().__init__(trigger, filter, points, averaging, levels)
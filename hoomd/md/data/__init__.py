@@ -0,0 +1,8 @@
+# Copyright (c) 2009-2021 The Regents of the University of Michigan
+# This file is part of the HOOMD-blue project, released under the BSD 3-Clause
+# License.
+
+"""Neighbor list local access."""
+
+from .local_access import (NeighborListLocalAccessBase,
+                           NeighborListLocalAccess, NeighborListLocalAccessGPU)
@@ -0,0 +1,109 @@
+# Copyright (c) 2009-2021 The Regents of the University of Michigan
+# This file is part of the HOOMD-blue project, released under the BSD 3-Clause
+# License.
+
+"""Access neighbor list data directly."""
+
+from abc import abstractmethod
+
+import hoomd
+from hoomd.data.local_access import _LocalAccess
+from hoomd.data.array import HOOMDArray, HOOMDGPUArray
+from hoomd.md import _md
+
+
+class NeighborListLocalAccessBase(_LocalAccess):
+    """Class for directly accessing HOOMD-blue neighbor list data.
+
+    The neighbors of the local particle with index ``i`` are
+    ``nlist[head_list[i]:head_list[i] + n_neigh[i]]``. Neighbor indices refer
+    to the local particle data (`hoomd.State.cpu_local_snapshot` and
+    `hoomd.State.gpu_local_snapshot`) and may be larger than the number of local
+    particles, in which case the neighbor is a ghost particle. Each neighbor
+    list includes all particles within the largest
+    :math:`r_{\\mathrm{cut}} + r_{\\mathrm{buffer}}` that applies to the pair of
+    types, so analyses must check the distances themselves.
+
+    All arrays are read only.
+
+    Attributes:
+        head_list ((N_particles,) `hoomd.data.array` object of ``int``):
+            Index of the first neighbor of each particle in `nlist`.
+        n_neigh ((N_particles,) `hoomd.data.array` object of ``int``):
+            Number of neighbors of each particle.
+        nlist ((N_elements,) `hoomd.data.array` object of ``int``):
+            The flat neighbor list. It includes unused capacity after the
+            neighbors of the last particle.
+    """
+
+    @property
+    @abstractmethod
+    def _cpp_cls(self):
+        pass
+
+    _fields = {
+        'head_list': 'getHeadList',
+        'n_neigh': 'getNNeigh',
+        'nlist': 'getNList'
+    }
+    _global_fields = {}
+
+    def __init__(self, nlist, state):
+        super().__init__()
+        self._cpp_obj = self._cpp_cls(nlist._cpp_obj,
+                                      state._cpp_sys_def.getParticleData())
+
+    def __getattr__(self, attr):
+        if attr in self._accessed_fields:
+            return self._accessed_fields[attr]
+        elif attr in self._fields:
+            buff = getattr(self._cpp_obj, self._fields[attr])()
+        else:
+            raise AttributeError("{} object has no attribute {}".format(
+                type(self), attr))
+
+        self._accessed_fields[attr] = arr = self._array_cls(
+            buff, lambda: self._entered)
+        return arr
+
+    @property
+    def half_nlist(self):
+        """bool: `True` when each pair of neighbors is stored only once."""
+        return self._cpp_obj.isHalfNList()
+
+
+class _NeighborListLocalAccessManager:
+    """Context manager that exposes the neighbor list arrays."""
+
+    def __init__(self, nlist, access_cls):
+        if not nlist._attached:
+            raise hoomd.error.DataAccessError("local_nlist_arrays")
+        self._access = access_cls(nlist, nlist._simulation.state)
+
+    def __enter__(self):
+        self._access._enter()
+        return self._access
+
+    def __exit__(self, type, value, traceback):
+        self._access._exit()
+
+
+class NeighborListLocalAccess(NeighborListLocalAccessBase):
+    """Access neighbor list data on the CPU."""
+    _cpp_cls = _md.LocalNeighborListDataHost
+    _array_cls = HOOMDArray
+
+
+if hoomd.version.gpu_enabled:
+
+    class NeighborListLocalAccessGPU(NeighborListLocalAccessBase):
+        """Access neighbor list data on the GPU."""
+        _cpp_cls = _md.LocalNeighborListDataDevice
+        _array_cls = HOOMDGPUArray
+
+else:
+    from hoomd.util import _NoGPU
+
+    class NeighborListLocalAccessGPU(_NoGPU):
+        """GPU data access is not available in CPU builds."""
+        pass
@@ -129,3 +129,49 @@ class Electric(Field):
             'E', 'particle_types',
             TypeParameterDict((float, float, float), len_keys=1))
         self._add_typeparam(params)
+
+
+class PeriodicElectric(Field):
+    """Periodic and electric fields evaluated together.
+
+    `PeriodicElectric` applies the potentials of `Periodic` and `Electric` to
+    every particle:
+
+    .. math::
+
+       V(\\vec{r}) = A \\tanh\\left[\\frac{1}{2 \\pi p w} \\cos\\left(
+       p \\vec{b}_i\\cdot\\vec{r}\\right)\\right] - q_i \\vec{E} \\cdot \\vec{r}
+
+    The forces, energies, and virials are the sum of those computed by
+    separate `Periodic` and `Electric` fields with the same parameters.
+    `PeriodicElectric` evaluates both fields in one pass over the particles
+    (one kernel on the GPU) and writes a single force array.
+
+    .. py:attribute:: params
+
+        The field parameters. The dictionary has the following keys:
+
+        * ``periodic`` (`dict`, **required**) - The parameters of the
+          periodic field with the keys ``A``, ``i``, ``w``, and ``p``
+          documented in `Periodic`.
+        * ``e_field`` (`tuple` [`float`, `float`, `float`], **required**) -
+          The electric field vector :math:`\\vec{E}` documented in
+          `Electric`.
+
+        Type: `TypeParameter` [``particle_type``, `dict`]
+
+    Example::
+
+        field = external.field.PeriodicElectric()
+        field.params['A'] = dict(periodic=dict(A=1.0, i=0, w=0.02, p=3),
+                                 e_field=(1, 0, 0))
+    """
+    _cpp_class_name = "PotentialExternalPeriodicElectric"
+
+    def __init__(self):
+        params = TypeParameter(
+            'params', 'particle_types',
+            TypeParameterDict(periodic=dict(i=int, A=float, w=float, p=int),
+                              e_field=(float, float, float),
+                              len_keys=1))
+        self._add_typeparam(params)
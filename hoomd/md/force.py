@@ -7,7 +7,7 @@
 import hoomd
 from hoomd import _hoomd
 from hoomd.md import _md
-from hoomd.operation import _HOOMDBaseObject
+from hoomd.operation import _HOOMDBaseObject, _TimedOperation
 from hoomd.logging import log
 from hoomd.data.typeparam import TypeParameter
 from hoomd.data.typeconverter import OnlyTypes
@@ -21,7 +21,7 @@ class _force:  # noqa - This will be removed eventually. Needed to build docs.
     pass
 
 
-class Force(_HOOMDBaseObject):
+class Force(_HOOMDBaseObject, _TimedOperation):
     """Defines a force in HOOMD-blue.
 
     Pair, angle, bond, and other forces are subclasses of this class.
@@ -543,3 +543,100 @@ class ActiveOnManifold(Active):
 
         # Attach param_dict and typeparam_dict
         super()._attach()
+
+
+class FusedBonded(Force):
+    r"""Harmonic bonds, harmonic angles, and OPLS dihedrals in one force.
+
+    :py:class:`FusedBonded` computes the same forces, energies, and virials as
+    the sum of `hoomd.md.bond.Harmonic`, `hoomd.md.angle.Harmonic`, and
+    `hoomd.md.dihedral.OPLS`:
+
+    .. math::
+
+        V = \sum_{\mathrm{bonds}} \frac{1}{2} k_b \left( r - r_0 \right)^2
+          + \sum_{\mathrm{angles}} \frac{1}{2} k_a
+            \left( \theta - \theta_0 \right)^2
+          + \sum_{\mathrm{dihedrals}} \frac{1}{2} \left[
+            k_1 \left( 1 + \cos\phi \right)
+          + k_2 \left( 1 - \cos 2\phi \right)
+          + k_3 \left( 1 + \cos 3\phi \right)
+          + k_4 \left( 1 - \cos 4\phi \right) \right]
+
+    On the GPU, a single kernel evaluates all three terms for each particle,
+    reading its position once and writing one force array. Polymer force
+    fields with many bonded terms per particle run faster with
+    :py:class:`FusedBonded` than with the three separate forces. Bond, angle,
+    or dihedral types that are not present in the system need no parameters.
+
+    Attributes:
+        bond_params (TypeParameter[``bond type``, dict]):
+            The harmonic bond parameters for each bond type. The dictionary
+            has the following keys:
+
+            * ``k`` (`float`, **required**) - potential constant
+              :math:`[\mathrm{energy} \cdot \mathrm{length}^{-2}]`
+
+            * ``r0`` (`float`, **required**) - rest length
+              :math:`[\mathrm{length}]`
+
+        angle_params (TypeParameter[``angle type``, dict]):
+            The harmonic angle parameters for each angle type. The dictionary
+            has the following keys:
+
+            * ``k`` (`float`, **required**) - potential constant
+              :math:`[\mathrm{energy} \cdot \mathrm{radians}^{-2}]`
+
+            * ``t0`` (`float`, **required**) - rest angle
+              :math:`[\mathrm{radians}]`
+
+        dihedral_params (TypeParameter[``dihedral type``, dict]):
+            The OPLS dihedral parameters for each dihedral type. The
+            dictionary has the following keys:
+
+            * ``k1`` (`float`, **required**) - force constant of the first
+              term :math:`[\mathrm{energy}]`
+
+            * ``k2`` (`float`, **required**) - force constant of the second
+              term :math:`[\mathrm{energy}]`
+
+            * ``k3`` (`float`, **required**) - force constant of the third
+              term :math:`[\mathrm{energy}]`
+
+            * ``k4`` (`float`, **required**) - force constant of the fourth
+              term :math:`[\mathrm{energy}]`
+
+    Examples::
+
+        bonded = hoomd.md.force.FusedBonded()
+        bonded.bond_params['backbone'] = dict(k=1000.0, r0=1.0)
+        bonded.angle_params['backbone'] = dict(k=100.0, t0=1.9)
+        bonded.dihedral_params['backbone'] = dict(k1=1.0, k2=-0.5, k3=0.2,
+                                                  k4=0.0)
+    """
+
+    def __init__(self):
+        bond_params = TypeParameter(
+            'bond_params', 'bond_types',
+            TypeParameterDict(k=float, r0=float, len_keys=1))
+        angle_params = TypeParameter(
+            'angle_params', 'angle_types',
+            TypeParameterDict(k=float, t0=float, len_keys=1))
+        dihedral_params = TypeParameter(
+            'dihedral_params', 'dihedral_types',
+            TypeParameterDict(k1=float,
+                              k2=float,
+                              k3=float,
+                              k4=float,
+                              len_keys=1))
+        self._extend_typeparam([bond_params, angle_params, dihedral_params])
+
+    def _attach(self):
+        if isinstance(self._simulation.device, hoomd.device.CPU):
+            cpp_cls = _md.FusedBondedForceCompute
+        else:
+            cpp_cls = _md.FusedBondedForceComputeGPU
+
+        self._cpp_obj = cpp_cls(self._simulation.state._cpp_sys_def)
+
+        super()._attach()
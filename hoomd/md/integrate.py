@@ -32,13 +32,24 @@ def _set_synced_list(old_list, new_list):
 
 class _DynamicIntegrator(BaseIntegrator):
 
-    def __init__(self, forces, constraints, methods, rigid):
+    def __init__(self,
+                 forces,
+                 constraints,
+                 methods,
+                 rigid,
+                 outer_forces=None):
         forces = [] if forces is None else forces
         constraints = [] if constraints is None else constraints
         methods = [] if methods is None else methods
+        outer_forces = [] if outer_forces is None else outer_forces
         self._forces = syncedlist.SyncedList(
             Force, syncedlist._PartialGetAttr('_cpp_obj'), iterable=forces)
 
+        self._outer_forces = syncedlist.SyncedList(
+            Force,
+            syncedlist._PartialGetAttr('_cpp_obj'),
+            iterable=outer_forces)
+
         self._constraints = syncedlist.SyncedList(
             OnlyTypes(Constraint, disallow_types=(Rigid,)),
             syncedlist._PartialGetAttr('_cpp_obj'),
@@ -55,6 +66,7 @@ class _DynamicIntegrator(BaseIntegrator):
 
     def _attach(self):
         self.forces._sync(self._simulation, self._cpp_obj.forces)
+        self.outer_forces._sync(self._simulation, self._cpp_obj.outer_forces)
         self.constraints._sync(self._simulation, self._cpp_obj.constraints)
         self.methods._sync(self._simulation, self._cpp_obj.methods)
         super()._attach()
@@ -64,6 +76,7 @@ class _DynamicIntegrator(BaseIntegrator):
 
     def _detach(self):
         self._forces._unsync()
+        self._outer_forces._unsync()
         self._methods._unsync()
         self._constraints._unsync()
         if self.rigid is not None:
@@ -88,6 +101,14 @@ class _DynamicIntegrator(BaseIntegrator):
     def forces(self, value):
         _set_synced_list(self._forces, value)
 
+    @property
+    def outer_forces(self):
+        return self._outer_forces
+
+    @outer_forces.setter
+    def outer_forces(self, value):
+        _set_synced_list(self._outer_forces, value)
+
     @property
     def constraints(self):
         return self._constraints
@@ -107,11 +128,12 @@ class _DynamicIntegrator(BaseIntegrator):
     @property
     def _children(self):
         children = list(self.forces)
+        children.extend(self.outer_forces)
         children.extend(self.constraints)
         children.extend(self.methods)
 
-        for child in itertools.chain(self.forces, self.constraints,
-                                     self.methods):
+        for child in itertools.chain(self.forces, self.outer_forces,
+                                     self.constraints, self.methods):
             children.extend(child._children)
 
         return children
@@ -187,6 +209,16 @@ class Integrator(_DynamicIntegrator):
         rigid (hoomd.md.constrain.Rigid): A rigid bodies object defining the
             rigid bodies in the simulation.
 
+        outer_forces (Sequence[hoomd.md.force.Force]): Sequence of slowly
+            varying forces evaluated only every ``outer_period`` time steps.
+            The default value of ``None`` initializes an empty list.
+
+        outer_period (int): Number of time steps between evaluations of
+            `outer_forces`.
+
+        elide_force_arrays (bool): When `True`, compute the pair and external
+            forces into shared arrays instead of arrays of their own.
+
 
     Classes of the following modules can be used as elements in `methods`:
 
@@ -210,6 +242,40 @@ class Integrator(_DynamicIntegrator):
 
     - `hoomd.md.constrain`
 
+    .. rubric:: Multiple time step integration
+
+    `Integrator` evaluates the forces in `outer_forces` only on time steps that
+    are multiples of `outer_period` and applies them to the particles as an
+    impulse :math:`k \\Delta t \\vec{F}`, where :math:`k` is `outer_period`,
+    split evenly between the velocity updates before and after that step. With
+    the velocity Verlet based integration methods, this is the reversible
+    reference system propagator algorithm (r-RESPA) with `forces` in the inner
+    and `outer_forces` in the outer time step. Use it for forces that vary
+    slowly compared to the time step, such as the long range part of
+    `hoomd.md.long_range.pppm.make_pppm_coulomb_forces`.
+
+    Note:
+        The energies and virials of `outer_forces` contribute to the
+        thermodynamic quantities only on the time steps where they are
+        evaluated. Log them and couple pressure dependent methods at multiples
+        of `outer_period`.
+
+    .. rubric:: Elided force arrays
+
+    Each force stores the force, energy, and virial of every particle. When
+    `elide_force_arrays` is `True`, the pair forces (`hoomd.md.pair`) and
+    external fields (`hoomd.md.external.field`) release these arrays. The
+    integrator computes them one after the other into one set of shared arrays
+    and adds each to the net force, which saves the memory of the per-force
+    arrays in large simulations with many forces. A force allocates its arrays
+    again, and keeps them, the first time its per-force quantities (such as
+    `hoomd.md.force.Force.energy` or `hoomd.md.force.Force.forces`) are
+    accessed or logged.
+
+    Note:
+        The per-force arrays are always kept in MPI simulations with more than
+        one rank and with more than one GPU.
+
 
     Examples::
 
@@ -239,6 +305,15 @@ class Integrator(_DynamicIntegrator):
 
         rigid (hoomd.md.constrain.Rigid): The rigid body definition for the
             simulation associated with the integrator.
+
+        outer_forces (list[hoomd.md.force.Force]): List of forces evaluated
+            every `outer_period` time steps.
+
+        outer_period (int): Number of time steps between evaluations of
+            `outer_forces`.
+
+        elide_force_arrays (bool): When `True`, compute the pair and external
+            forces into shared arrays instead of arrays of their own.
     """
 
     def __init__(self,
@@ -247,14 +322,19 @@ class Integrator(_DynamicIntegrator):
                  forces=None,
                  constraints=None,
                  methods=None,
-                 rigid=None):
+                 rigid=None,
+                 outer_forces=None,
+                 outer_period=1,
+                 elide_force_arrays=False):
 
-        super().__init__(forces, constraints, methods, rigid)
+        super().__init__(forces, constraints, methods, rigid, outer_forces)
 
         self._param_dict.update(
             ParameterDict(dt=float(dt),
                           aniso=OnlyFrom(['true', 'false', 'auto'],
                                          preprocess=_preprocess_aniso),
+                          outer_period=int(outer_period),
+                          elide_force_arrays=bool(elide_force_arrays),
                           _defaults={"aniso": "auto"}))
         if aniso is not None:
             self.aniso = aniso
@@ -5,3 +5,4 @@
 """Long-range potentials for molecular dynamics."""
 
 from . import pppm
+from . import rbe
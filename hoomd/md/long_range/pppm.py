@@ -113,6 +113,117 @@ def make_pppm_coulomb_forces(nlist, resolution, order, r_cut, alpha=0):
     return real_space_force, reciprocal_space_force
 
 
+def tune_coulomb_parameters(simulation,
+                            nlist,
+                            accuracy,
+                            r_cut,
+                            order=(4, 5, 6, 7),
+                            steps=100):
+    """Choose PPPM parameters that reach a given accuracy in the least time.
+
+    Args:
+        simulation (hoomd.Simulation): Simulation to tune the parameters for.
+        nlist (`hoomd.md.nlist.NList`): Neighbor list.
+        accuracy (float): Target RMS error of the Coulomb forces
+          :math:`\\mathrm{[force]}`.
+        r_cut (list[float]): Candidate cutoff distances between the real space
+          and reciprocal space terms :math:`\\mathrm{[length]}`.
+        order (list[int]): Candidate interpolation orders
+          :math:`\\mathrm{[dimensionless]}`.
+        steps (int): Number of time steps to run for each candidate
+          :math:`\\mathrm{[dimensionless]}`.
+
+    For every combination of ``r_cut`` and ``order``,
+    `tune_coulomb_parameters` determines the coarsest grid resolution for which
+    the estimated RMS force error of the real space and the reciprocal space
+    terms is at most ``accuracy``. It then adds the forces for each of these
+    candidates to the integrator of ``simulation`` in turn, runs ``steps`` time
+    steps, and returns the candidate that achieves the highest `Simulation.tps
+    <hoomd.Simulation.tps>`. A larger cutoff shifts work from the fast Fourier
+    transforms to the pair force, so the fastest candidate depends on the
+    system and the hardware.
+
+    Note:
+        `tune_coulomb_parameters` advances the simulation by ``steps`` time
+        steps for each candidate. Use it during equilibration.
+
+    Warning:
+        The error estimate assumes an orthorhombic box.
+
+    Returns:
+        dict: The parameters ``resolution``, ``order``, and ``r_cut`` to pass
+        to `make_pppm_coulomb_forces`.
+    """
+    integrator = simulation.operations.integrator
+    if integrator is None:
+        raise RuntimeError("tune_coulomb_parameters requires an integrator.")
+
+    # attach a coarse candidate to obtain the sum of the squared charges
+    real_space_force, reciprocal_space_force = make_pppm_coulomb_forces(
+        nlist, resolution=(8, 8, 8), order=min(order), r_cut=min(r_cut))
+    integrator.forces.extend([real_space_force, reciprocal_space_force])
+    simulation.run(0)
+    q2 = reciprocal_space_force._cpp_obj.getQ2Sum()
+    integrator.forces.remove(reciprocal_space_force)
+    integrator.forces.remove(real_space_force)
+
+    N = simulation.state.N_particles
+    box = simulation.state.box
+    L = (box.Lx, box.Ly, box.Lz)
+
+    # FFT sizes: powers of two with MPI, otherwise products of small primes
+    if simulation.device.communicator.num_ranks > 1:
+        sizes = [2**i for i in range(1, 12)]
+    else:
+        sizes = sorted({
+            2**i * 3**j * 5**k for i in range(1, 12) for j in range(0, 7)
+            for k in range(0, 5) if 2**i * 3**j * 5**k <= 2048
+        })
+
+    candidates = []
+    for rc in r_cut:
+        # the screening parameter at which the real space error is accuracy
+        x = 2.0 * q2 / (accuracy * math.sqrt(N * rc * L[0] * L[1] * L[2]))
+        kappa = math.sqrt(math.log(max(x, 1.0))) / rc
+
+        for p in order:
+            resolution = []
+            for prd in L:
+                for m in sizes:
+                    if _rms(prd / m, prd, N, p, kappa, q2) <= accuracy:
+                        resolution.append(m)
+                        break
+                else:
+                    raise ValueError("Cannot reach an accuracy of {} with "
+                                     "r_cut={} and order={}.".format(
+                                         accuracy, rc, p))
+
+            candidates.append(
+                dict(resolution=tuple(resolution), order=p, r_cut=rc))
+
+    best_index = 0
+    best_tps = 0
+    for i, candidate in enumerate(candidates):
+        real_space_force, reciprocal_space_force = make_pppm_coulomb_forces(
+            nlist, **candidate)
+        integrator.forces.extend([real_space_force, reciprocal_space_force])
+        simulation.run(0)
+        simulation.run(steps)
+        tps = simulation.tps
+        integrator.forces.remove(reciprocal_space_force)
+        integrator.forces.remove(real_space_force)
+
+        if tps > best_tps:
+            best_index = i
+            best_tps = tps
+
+    # the timings differ between ranks, use the choice of the root rank
+    best_index = int(
+        hoomd._hoomd.mpi_bcast_str(str(best_index),
+                                   simulation.device._cpp_exec_conf))
+    return candidates[best_index]
+
+
 class Coulomb(Force):
     """Reciprocal space part of the PPPM Coulomb forces.
 
@@ -0,0 +1,165 @@
+# Copyright (c) 2009-2021 The Regents of the University of Michigan
+# This file is part of the HOOMD-blue project, released under the BSD 3-Clause
+# License.
+
+"""Long-range potentials evaluated using the random batch Ewald method."""
+
+import hoomd
+from hoomd.md.force import Force
+
+
+def make_rbe_coulomb_forces(nlist, kappa, batch_size, r_cut, alpha=0):
+    """Long range Coulomb interactions evaluated using random batch Ewald.
+
+    Args:
+        nlist (`hoomd.md.nlist.NList`): Neighbor list.
+        kappa (float): Splitting parameter between the real space and
+          reciprocal space terms :math:`\\mathrm{[length^{-1}]}`.
+        batch_size (int): Number of wave vectors sampled per time step
+          :math:`\\mathrm{[dimensionless]}`.
+        r_cut (float): Cutoff distance of the real space term
+          :math:`\\mathrm{[length]}`.
+        alpha (float): Debye screening parameter
+          :math:`\\mathrm{[length^{-1}]}`.
+
+    Evaluate the same potential energy :math:`U_\\mathrm{coulomb}` as
+    `hoomd.md.long_range.pppm.make_pppm_coulomb_forces` and apply the
+    corresponding forces to the particles in the simulation.
+
+    `md.pair.Ewald` computes the real space term directly.
+    `md.long_range.rbe.Coulomb` estimates the reciprocal space term
+
+    .. math::
+
+        U_\\mathrm{reciprocal\\ space} = \\frac{2\\pi}{V}
+          \\sum_{\\vec{k} \\ne 0} \\frac{e^{-(k^2 + \\alpha^2)/(4\\kappa^2)}}
+          {k^2 + \\alpha^2} \\left| \\sum_{j=0}^{N-1} q_j
+          e^{i \\vec{k} \\cdot \\vec{r}_j} \\right|^2
+
+    from ``batch_size`` wave vectors :math:`\\vec{k}`, drawn anew every time
+    step with a probability proportional to :math:`e^{-k^2/(4\\kappa^2)}`. The
+    estimate of the energy and the forces is unbiased, and its variance
+    decreases with ``batch_size``. The noise in the forces acts like a weak
+    random force, which a thermostat removes.
+
+    The random batch Ewald method requires no mesh and no fast Fourier
+    transforms. The only communication between MPI ranks is a reduction of
+    ``2 * batch_size`` values per time step, which makes it suitable for large
+    charged systems on many ranks. The cost per step is proportional to
+    ``N * batch_size``.
+
+    ``kappa`` sets the error of the real space term, which is of order
+    :math:`e^{-\\kappa^2 r_\\mathrm{cut}^2}`. Choose ``kappa`` between
+    :math:`3 / r_\\mathrm{cut}` and :math:`3.5 / r_\\mathrm{cut}`.
+
+    * `S. Jin, L. Li, Z. Xu, and Y. Zhao 2021`_ describes the algorithm.
+
+    Note:
+        `md.long_range.rbe.Coulomb` does not correct for the long range
+        interactions between the particles of a rigid body.
+
+    Returns:
+        ``real_space_force``, ``reciprocal_space_force``
+
+        Add both of these forces to the integrator.
+
+    Warning:
+        `make_rbe_coulomb_forces` sets all parameters for the returned
+        `Force` objects appropriately. Do not change the parameters of
+        ``real_space_force`` directly.
+
+    .. _S. Jin, L. Li, Z. Xu, and Y. Zhao 2021:
+      https://doi.org/10.1137/20M1371385
+    """
+    real_space_force = hoomd.md.pair.Ewald(nlist)
+
+    # the real space force may be attached before the reciprocal space one
+    # set default parameters to avoid errors in this case
+    real_space_force.params.default = dict(kappa=kappa, alpha=alpha)
+    real_space_force.r_cut.default = r_cut
+
+    reciprocal_space_force = Coulomb(nlist=nlist,
+                                     kappa=kappa,
+                                     batch_size=batch_size,
+                                     alpha=alpha,
+                                     pair_force=real_space_force)
+
+    return real_space_force, reciprocal_space_force
+
+
+class Coulomb(Force):
+    """Reciprocal space part of the random batch Ewald Coulomb forces.
+
+    Note:
+        Use `make_rbe_coulomb_forces` to create a connected pair of
+        `md.pair.Ewald` and `md.long_range.rbe.Coulomb` instances that together
+        implement the random batch Ewald method for electrostatics.
+
+    Attributes:
+        kappa (float): Splitting parameter between the real space and
+          reciprocal space terms :math:`\\mathrm{[length^{-1}]}`.
+        batch_size (int): Number of wave vectors sampled per time step
+          :math:`\\mathrm{[dimensionless]}`.
+        alpha (float): Debye screening parameter
+          :math:`\\mathrm{[length^{-1}]}`.
+    """
+
+    def __init__(self, nlist, kappa, batch_size, alpha, pair_force):
+        self._nlist = hoomd.data.typeconverter.OnlyTypes(
+            hoomd.md.nlist.NList)(nlist)
+        self._param_dict.update(
+            hoomd.data.parameterdicts.ParameterDict(kappa=float,
+                                                    batch_size=int,
+                                                    alpha=float))
+
+        self.kappa = kappa
+        self.batch_size = batch_size
+        self.alpha = alpha
+        self._pair_force = pair_force
+
+    def _attach(self):
+        if not self._nlist._added:
+            self._nlist._add(self._simulation)
+        else:
+            if self._simulation != self._nlist._simulation:
+                raise RuntimeError("{} object's neighbor list is used in a "
+                                   "different simulation.".format(type(self)))
+
+        if not self.nlist._attached:
+            self.nlist._attach()
+
+        # there is no GPU implementation, the CPU class operates on the
+        # host copies of the particle data
+        group = self._simulation.state._get_group(hoomd.filter.All())
+        self._cpp_obj = hoomd.md._md.RandomBatchEwaldForceCompute(
+            self._simulation.state._cpp_sys_def, self.nlist._cpp_obj, group)
+
+        # set the pair force parameters to match
+        for a in self._simulation.state.particle_types:
+            for b in self._simulation.state.particle_types:
+                self._pair_force.params[(a, b)] = dict(kappa=self.kappa,
+                                                       alpha=self.alpha)
+
+        self._cpp_obj.setParams(self.kappa, self.batch_size, self.alpha)
+
+        super()._attach()
+
+    @property
+    def nlist(self):
+        """Neighbor list used to compute the real space term."""
+        return self._nlist
+
+    @nlist.setter
+    def nlist(self, value):
+        if self._attached:
+            raise RuntimeError("nlist cannot be set after scheduling.")
+        else:
+            self._nlist = hoomd.data.typeconverter.OnlyTypes(
+                hoomd.md.nlist.NList)(value)
+
+            # ensure that the pair force uses the same neighbor list
+            self._pair_force.nlist = value
+
+    @property
+    def _children(self):
+        return [self.nlist]
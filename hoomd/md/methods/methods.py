@@ -880,6 +880,9 @@ class Brownian(Method):
             :math:`[\mathrm{mass} \cdot \mathrm{length}^{-1}
             \cdot \mathrm{time}^{-1}]`.
 
+        update_velocities (`bool`): When `True`, draw new particle velocities
+            every time step. Defaults to `True`.
+
     `Brownian` integrates particles forward in time according to the overdamped
     Langevin equations of motion, sometimes called Brownian dynamics, or the
     diffusive limit.
@@ -920,6 +923,12 @@ class Brownian(Method):
     `hoomd.compute.thermo` will report appropriate temperatures and
     pressures if logged or needed by other commands.
 
+    Set ``update_velocities`` to `False` when nothing in the simulation uses
+    the velocities. `Brownian` then leaves the particle velocities unchanged
+    and, when it does not integrate rotational degrees of freedom, accesses
+    only the positions, images, and net forces of the particles. This reduces
+    the memory traffic of each time step.
+
     Brownian dynamics neglects the acceleration term in the Langevin equation.
     This assumption is valid when overdamped:
     :math:`\frac{m}{\gamma} \ll \delta t`. Use `Langevin` if your
@@ -961,6 +970,9 @@ class Brownian(Method):
             :math:`[\mathrm{mass} \cdot \mathrm{length}^{-1}
             \cdot \mathrm{time}^{-1}]`. Defaults to None.
 
+        update_velocities (bool): When `True`, draw new particle velocities
+            every time step.
+
         gamma (TypeParameter[ ``particle type``, `float` ]): The drag
             coefficient can be directly set instead of the ratio of particle
             diameter (:math:`\gamma = \alpha d_i`). The type of ``gamma``
@@ -975,13 +987,14 @@ class Brownian(Method):
             \mathrm{radian}^{-1} \cdot \mathrm{time}^{-1}]`.
     """
 
-    def __init__(self, filter, kT, alpha=None):
+    def __init__(self, filter, kT, alpha=None, update_velocities=True):
 
         # store metadata
         param_dict = ParameterDict(
             filter=ParticleFilter,
             kT=Variant,
             alpha=OnlyTypes(float, allow_none=True),
+            update_velocities=bool(update_velocities),
         )
         param_dict.update(dict(kT=kT, alpha=alpha, filter=filter))
 
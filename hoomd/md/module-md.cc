@@ -14,8 +14,12 @@
 #include "AllTripletPotentials.h"
 #include "AnisoPotentialPair.h"
 #include "BondTablePotential.h"
+#include "ComputeRDF.h"
+#include "ComputeStructureFactor.h"
 #include "ComputeThermo.h"
-#include "ComputeThermoHMA.h"
+#include "CorrelatorMultipleTau.h"
+#include "CorrelatorParticle.h"
+#include "CorrelatorPressureTensor.h"
 #include "CosineSqAngleForceCompute.h"
 #include "EvaluatorRevCross.h"
 #include "EvaluatorSquareDensity.h"
@@ -23,6 +27,7 @@
 #include "FIREEnergyMinimizer.h"
 #include "ForceComposite.h"
 #include "ForceDistanceConstraint.h"
+#include "FusedBondedForceCompute.h"
 #include "HarmonicAngleForceCompute.h"
 #include "HarmonicDihedralForceCompute.h"
 #include "HarmonicImproperForceCompute.h"
@@ -48,7 +53,9 @@
 #include "PotentialPair.h"
 #include "PotentialPairDPDThermo.h"
 #include "PotentialTersoff.h"
+#include "RandomBatchEwaldForceCompute.h"
 #include "QuaternionMath.h"
+#include "ReplicaExchangeUpdater.h"
 #include "TableAngleForceCompute.h"
 #include "TableDihedralForceCompute.h"
 #include "TwoStepBD.h"
@@ -70,12 +77,15 @@
 #include "ActiveForceConstraintComputeGPU.h"
 #include "AnisoPotentialPairGPU.h"
 #include "BondTablePotentialGPU.h"
+#include "ComputeRDFGPU.h"
+#include "ComputeStructureFactorGPU.h"
 #include "ComputeThermoGPU.h"
-#include "ComputeThermoHMAGPU.h"
+#include "CorrelatorParticleGPU.h"
 #include "CosineSqAngleForceComputeGPU.h"
 #include "FIREEnergyMinimizerGPU.h"
 #include "ForceCompositeGPU.h"
 #include "ForceDistanceConstraintGPU.h"
+#include "FusedBondedForceComputeGPU.h"
 #include "HarmonicAngleForceComputeGPU.h"
 #include "HarmonicDihedralForceComputeGPU.h"
 #include "HarmonicImproperForceComputeGPU.h"
@@ -102,6 +112,7 @@
 #include "TwoStepRATTLEBDGPU.h"
 #include "TwoStepRATTLELangevinGPU.h"
 #include "TwoStepRATTLENVEGPU.h"
+#include "ZeroMomentumUpdaterGPU.h"
 #endif
 
 #include <pybind11/pybind11.h>
@@ -241,13 +252,18 @@ PYBIND11_MODULE(_md, m)
                                                            "ActiveForceConstraintComputePrimitive");
     export_ActiveForceConstraintCompute<ManifoldSphere>(m, "ActiveForceConstraintComputeSphere");
     export_ActiveRotationalDiffusionUpdater(m);
+    export_ComputeRDF(m);
+    export_ComputeStructureFactor(m);
     export_ComputeThermo(m);
-    export_ComputeThermoHMA(m);
+    export_CorrelatorMultipleTau(m);
+    export_CorrelatorParticle(m);
+    export_CorrelatorPressureTensor(m);
     export_HarmonicAngleForceCompute(m);
     export_CosineSqAngleForceCompute(m);
     export_TableAngleForceCompute(m);
     export_HarmonicDihedralForceCompute(m);
     export_OPLSDihedralForceCompute(m);
+    export_FusedBondedForceCompute(m);
     export_TableDihedralForceCompute(m);
     export_HarmonicImproperForceCompute(m);
     export_BondTablePotential(m);
@@ -290,6 +306,10 @@ PYBIND11_MODULE(_md, m)
     export_PotentialSpecialPair<PotentialSpecialPairLJ>(m, "PotentialSpecialPairLJ");
     export_PotentialSpecialPair<PotentialSpecialPairCoulomb>(m, "PotentialSpecialPairCoulomb");
     export_NeighborList(m);
+    export_LocalNeighborListData<HOOMDHostBuffer>(m, "LocalNeighborListDataHost");
+#ifdef ENABLE_HIP
+    export_LocalNeighborListData<HOOMDDeviceBuffer>(m, "LocalNeighborListDataDevice");
+#endif
     export_NeighborListBinned(m);
     export_NeighborListStencil(m);
     export_NeighborListTree(m);
@@ -297,10 +317,14 @@ PYBIND11_MODULE(_md, m)
     export_ForceDistanceConstraint(m);
     export_ForceComposite(m);
     export_PPPMForceCompute(m);
+    export_RandomBatchEwaldForceCompute(m);
     py::class_<wall_type, std::shared_ptr<wall_type>>(m, "wall_type").def(py::init<>());
     m.def("make_wall_field_params", &make_wall_field_params);
     export_PotentialExternal<PotentialExternalPeriodic>(m, "PotentialExternalPeriodic");
     export_PotentialExternal<PotentialExternalElectricField>(m, "PotentialExternalElectricField");
+    export_PotentialExternal<PotentialExternalPeriodicElectric>(
+        m,
+        "PotentialExternalPeriodicElectric");
     // TODO: Port walls to HOOMD v3
     // export_PotentialExternalWall<EvaluatorPairLJ>(m, "WallsPotentialLJ");
     // export_PotentialExternalWall<EvaluatorPairYukawa>(m, "WallsPotentialYukawa");
@@ -392,11 +416,14 @@ PYBIND11_MODULE(_md, m)
     export_TableAngleForceComputeGPU(m);
     export_HarmonicDihedralForceComputeGPU(m);
     export_OPLSDihedralForceComputeGPU(m);
+    export_FusedBondedForceComputeGPU(m);
     export_TableDihedralForceComputeGPU(m);
     export_HarmonicImproperForceComputeGPU(m);
     export_ForceDistanceConstraintGPU(m);
+    export_ComputeRDFGPU(m);
+    export_ComputeStructureFactorGPU(m);
     export_ComputeThermoGPU(m);
-    export_ComputeThermoHMAGPU(m);
+    export_CorrelatorParticleGPU(m);
     export_PPPMForceComputeGPU(m);
     export_ActiveForceComputeGPU(m);
     export_ActiveForceConstraintComputeGPU<ManifoldZCylinder>(
@@ -423,6 +450,10 @@ PYBIND11_MODULE(_md, m)
     export_PotentialExternalGPU<PotentialExternalElectricFieldGPU, PotentialExternalElectricField>(
         m,
         "PotentialExternalElectricFieldGPU");
+    export_PotentialExternalGPU<PotentialExternalPeriodicElectricGPU,
+                                PotentialExternalPeriodicElectric>(
+        m,
+        "PotentialExternalPeriodicElectricGPU");
     /*
     export_PotentialExternalGPU<WallsPotentialLJGPU, WallsPotentialLJ>(m, "WallsPotentialLJGPU");
     export_PotentialExternalGPU<WallsPotentialYukawaGPU, WallsPotentialYukawa>(
@@ -446,6 +477,7 @@ PYBIND11_MODULE(_md, m)
     export_IntegratorTwoStep(m);
     export_IntegrationMethodTwoStep(m);
     export_ZeroMomentumUpdater(m);
+    export_ReplicaExchangeUpdater(m);
     export_TwoStepNVE(m);
     export_TwoStepNVTMTK(m);
     export_TwoStepLangevinBase(m);
@@ -490,6 +522,7 @@ PYBIND11_MODULE(_md, m)
     export_BerendsenGPU(m);
     export_FIREEnergyMinimizerGPU(m);
     export_MuellerPlatheFlowGPU(m);
+    export_ZeroMomentumUpdaterGPU(m);
 
     export_TwoStepRATTLEBDGPU<ManifoldZCylinder>(m, "TwoStepRATTLEBDCylinderGPU");
     export_TwoStepRATTLEBDGPU<ManifoldDiamond>(m, "TwoStepRATTLEBDDiamondGPU");
@@ -17,10 +17,13 @@ from hoomd.data.parameterdicts import ParameterDict
 from hoomd.data.typeconverter import OnlyFrom
 from hoomd.logging import log
 from hoomd.md import _md
-from hoomd.operation import _HOOMDBaseObject
+from hoomd.md.data.local_access import (_NeighborListLocalAccessManager,
+                                        NeighborListLocalAccess,
+                                        NeighborListLocalAccessGPU)
+from hoomd.operation import _HOOMDBaseObject, _TimedOperation
 
 
-class NList(_HOOMDBaseObject):
+class NList(_HOOMDBaseObject, _TimedOperation):
     r"""Base class neighbor list.
 
     Methods and attributes provided by this base class are available to all
@@ -70,6 +73,26 @@ class NList(_HOOMDBaseObject):
     largest value that any particle's diameter will achieve (where **diameter**
     is the per particle quantity stored in the `hoomd.State`).
 
+    .. rubric:: Compression
+
+    Set `compressed` to `True` to store a copy of the neighbor list on the GPU
+    with each neighbor encoded as a 16-bit offset from the particle index.
+    Pair potentials in `hoomd.md.pair` read this copy, which halves the memory
+    traffic per neighbor when particles are sorted spatially. Neighbors whose
+    offset does not fit in 16 bits are read from the full list.
+
+    `compressed` reduces bandwidth, not memory. The full 32-bit neighbor list
+    is still built and read by other operations, and the compressed copy adds
+    2 bytes per neighbor list entry. `NList` ignores `compressed` on the CPU.
+
+    .. rubric:: Type sorting
+
+    Set `sort_by_type` to `True` to order the neighbors of each particle by
+    type on the GPU after every build. Pair potentials in `hoomd.md.pair` then
+    load the per type pair parameters once for each run of neighbors of the
+    same type, which helps systems with many particle types. `NList` ignores
+    `sort_by_type` on the CPU.
+
     Attributes:
         buffer (float): Buffer width :math:`[\mathrm{length}]`.
         exclusions (tuple[str]): Defines which particles to exlclude from the
@@ -80,6 +103,10 @@ class NList(_HOOMDBaseObject):
         check_dist (bool): Flag to enable / disable distance checking.
         max_diameter (float): The maximum diameter a particle will achieve
             :math:`[\mathrm{length}]`.
+        compressed (bool): Flag to enable / disable the compressed copy of
+            the neighbor list on the GPU.
+        sort_by_type (bool): Flag to enable / disable ordering the neighbors
+            of each particle by type on the GPU.
     """
 
     def __init__(self, buffer, exclusions, rebuild_check_delay, diameter_shift,
@@ -96,6 +123,8 @@ class NList(_HOOMDBaseObject):
                                check_dist=bool(check_dist),
                                diameter_shift=bool(diameter_shift),
                                max_diameter=float(max_diameter),
+                               compressed=False,
+                               sort_by_type=False,
                                _defaults={'exclusions': exclusions})
         self._param_dict.update(params)
 
@@ -108,6 +137,112 @@ class NList(_HOOMDBaseObject):
         """
         return self._cpp_obj.getSmallestRebuild()
 
+    @log(requires_run=True)
+    def num_builds(self):
+        """int: The number of neighbor list builds.
+
+        `num_builds` counts the builds during the current or last
+        `Simulation.run`.
+        """
+        return self._cpp_obj.getNumUpdates()
+
+    @log(requires_run=True)
+    def num_dangerous_builds(self):
+        """int: The number of dangerous neighbor list builds.
+
+        A build is dangerous when a particle may have moved more than
+        ``buffer/2`` since the previous build, so some neighbors may have been
+        missed. `num_dangerous_builds` counts the dangerous builds during the
+        current or last `Simulation.run`. Reduce `rebuild_check_delay` or
+        increase `buffer` when it is nonzero.
+        """
+        return self._cpp_obj.getNumDangerousUpdates()
+
+    @log(requires_run=True)
+    def mean_rebuild_period(self):
+        """float: The mean number of time steps between neighbor list builds.
+
+        `mean_rebuild_period` averages over the current or last
+        `Simulation.run`.
+        """
+        steps = (self._simulation.timestep
+                 - self._simulation._cpp_sys.start_timestep)
+        builds = self._cpp_obj.getNumUpdates()
+        if builds == 0:
+            return float(steps)
+        return steps / builds
+
+    @log(requires_run=True)
+    def num_reallocations(self):
+        """int: The number of times the neighbor list storage grew.
+
+        `num_reallocations` counts the times during the current or last
+        `Simulation.run` that a particle had more neighbors than the storage
+        held, so the neighbor list was reallocated and built again.
+        """
+        return self._cpp_obj.getNumReallocations()
+
+    @log(requires_run=True)
+    def max_neighbors(self):
+        """int: The number of neighbors per particle that the neighbor list \
+        storage holds."""
+        return self._cpp_obj.getMaxNeighbors()
+
+    @log(default=False, requires_run=True)
+    def mean_neighbors(self):
+        """float: The mean number of neighbors per particle in the list.
+
+        The neighbor list stores each pair once for forces that apply Newton's
+        third law, so `mean_neighbors` may be half the mean number of particles
+        within range of a particle.
+
+        Note:
+            `mean_neighbors` is not a default loggable quantity because it
+            copies the neighbor counts from the GPU and communicates between
+            MPI ranks.
+        """
+        return self._cpp_obj.getMeanNeighbors()
+
+    @property
+    def cpu_local_nlist_arrays(self):
+        """hoomd.md.data.NeighborListLocalAccess: Expose the neighbor list \
+        arrays on the CPU.
+
+        Provides zero-copy, read only access to the neighbor list built for the
+        last force evaluation through a context manager::
+
+            with nlist.cpu_local_nlist_arrays as data:
+                head_list = data.head_list
+                n_neigh = data.n_neigh
+                neighbors = data.nlist
+
+        The arrays are MPI rank local and indexed like the particle data in
+        `hoomd.State.cpu_local_snapshot`. Enter this context manager before
+        accessing the local snapshot when using both together. See
+        `hoomd.md.data.NeighborListLocalAccessBase` for the layout.
+
+        Note:
+            The neighbor list is available after the simulation has run for 0
+            or more steps.
+        """
+        return _NeighborListLocalAccessManager(self, NeighborListLocalAccess)
+
+    @property
+    def gpu_local_nlist_arrays(self):
+        """hoomd.md.data.NeighborListLocalAccessGPU: Expose the neighbor list \
+        arrays on the GPU.
+
+        Like `cpu_local_nlist_arrays`, but the arrays are
+        `hoomd.data.array.HOOMDGPUArray` objects that refer to the data on the
+        GPU. Libraries that support DLPack or the ``__cuda_array_interface__``
+        can read them without a copy.
+        """
+        if self._attached and not isinstance(self._simulation.device,
+                                             hoomd.device.GPU):
+            raise RuntimeError(
+                "Cannot access gpu_local_nlist_arrays without a GPU device")
+        return _NeighborListLocalAccessManager(self, NeighborListLocalAccessGPU)
+
     def _remove_dependent(self, obj):
         super()._remove_dependent(obj)
         if len(self._dependents) == 0:
@@ -134,8 +269,11 @@ class Cell(NList):
         check_dist (bool): Flag to enable / disable distance checking.
         max_diameter (float): The maximum diameter a particle will achieve
             :math:`[\mathrm{length}]`.
-        deterministic (bool): When `True`, sort neighbors to help provide
-            deterministic simulation runs.
+        deterministic (bool): When `True`, sort neighbors and sum pair forces
+            on the GPU in fixed point to help provide deterministic simulation
+            runs.
+        incremental_fraction (float): Largest fraction of particles that may
+            move past the buffer before the list is fully rebuilt.
 
     `Cell` finds neighboring particles using a fixed width cell list, allowing
     for *O(kN)* construction of the neighbor list where *k* is the number of
@@ -144,13 +282,25 @@ class Cell(NList):
     but performance degrades for large cutoff radius asymmetries due to the
     significantly increased number of particles per cell.
 
+    When `incremental_fraction` is greater than 0, `Cell` updates the
+    neighbor list in place when only a few particles have moved a distance
+    ``buffer/2``. It adds the new neighbors of those particles and keeps the
+    rest of the list. `Cell` rebuilds the whole list once more than
+    `incremental_fraction` of the particles have moved. This can reduce the
+    cost of neighbor list builds in dense, slowly relaxing systems. Incremental
+    updates require ``rebuild_check_delay <= 1``. They are not performed on the
+    GPU or with MPI domain decomposition.
+
     Examples::
 
         cell = nlist.Cell()
 
     Attributes:
-        deterministic (bool): When `True`, sort neighbors to help provide
-            deterministic simulation runs.
+        deterministic (bool): When `True`, sort neighbors and sum pair forces
+            on the GPU in fixed point to help provide deterministic simulation
+            runs.
+        incremental_fraction (float): Largest fraction of particles that may
+            move past the buffer before the list is fully rebuilt.
     """
 
     def __init__(self,
@@ -160,13 +310,15 @@ class Cell(NList):
                  diameter_shift=False,
                  check_dist=True,
                  max_diameter=1.0,
-                 deterministic=False):
+                 deterministic=False,
+                 incremental_fraction=0.0):
 
         super().__init__(buffer, exclusions, rebuild_check_delay,
                          diameter_shift, check_dist, max_diameter)
 
         self._param_dict.update(
-            ParameterDict(deterministic=bool(deterministic)))
+            ParameterDict(deterministic=bool(deterministic),
+                          incremental_fraction=float(incremental_fraction)))
 
     def _attach(self):
         if isinstance(self._simulation.device, hoomd.device.CPU):
@@ -193,8 +345,9 @@ class Stencil(NList):
         check_dist (bool): Flag to enable / disable distance checking.
         max_diameter (float): The maximum diameter a particle will achieve
             :math:`[\\mathrm{length}]`.
-        deterministic (bool): When `True`, sort neighbors to help provide
-            deterministic simulation runs.
+        deterministic (bool): When `True`, sort neighbors and sum pair forces
+            on the GPU in fixed point to help provide deterministic simulation
+            runs.
 
     `Stencil` creates a cell list based neighbor list object to which pair
     potentials can be attached for computing non-bonded pairwise interactions.
@@ -227,8 +380,9 @@ class Stencil(NList):
     Attributes:
         cell_width (float): The underlying stencil bin width for the cell list
             :math:`[\\mathrm{length}]`.
-        deterministic (bool): When `True`, sort neighbors to help provide
-            deterministic simulation runs.
+        deterministic (bool): When `True`, sort neighbors and sum pair forces
+            on the GPU in fixed point to help provide deterministic simulation
+            runs.
     """
 
     def __init__(self,
@@ -272,6 +426,8 @@ class Tree(NList):
         check_dist (bool): Flag to enable / disable distance checking.
         max_diameter (float): The maximum diameter a particle will achieve
             :math:`[\\mathrm{length}]`.
+        refit_threshold (float): Growth of the tree cost that triggers a
+            rebuild of a refitted tree.
 
     `Tree` creates a neighbor list using a bounding volume hierarchy (BVH) tree
     traversal. A BVH tree of axis-aligned bounding boxes is constructed per
@@ -290,9 +446,22 @@ class Tree(NList):
     describes the improved algorithm that is currently implemented. Cite both
     if you utilize this neighbor list style in your work.
 
+    When `refit_threshold` is greater than 0, `Tree` on the GPU keeps the BVH
+    trees between builds and only refits their bounding boxes to the new
+    particle positions. The cost of a tree is the sum of the surface areas of
+    its internal nodes. A tree is rebuilt once its cost exceeds
+    `refit_threshold` times its cost after the last build. The particles are
+    sorted by type again only when their order, number, or types change. Refits
+    can reduce the build cost for slowly relaxing systems. They are not
+    performed on the CPU or with MPI domain decomposition.
+
     Examples::
 
         nl_t = nlist.Tree(check_dist=False)
+
+    Attributes:
+        refit_threshold (float): Growth of the tree cost that triggers a
+            rebuild of a refitted tree.
     """
 
     def __init__(self,
@@ -301,11 +470,15 @@ class Tree(NList):
                  rebuild_check_delay=1,
                  diameter_shift=False,
                  check_dist=True,
-                 max_diameter=1.0):
+                 max_diameter=1.0,
+                 refit_threshold=0.0):
 
         super().__init__(buffer, exclusions, rebuild_check_delay,
                          diameter_shift, check_dist, max_diameter)
 
+        self._param_dict.update(
+            ParameterDict(refit_threshold=float(refit_threshold)))
+
     def _attach(self):
         if isinstance(self._simulation.device, hoomd.device.CPU):
             nlist_cls = _md.NeighborListTree
@@ -46,6 +46,11 @@ class AnisotropicPair(Pair):
         self._param_dict.update(ParameterDict(mode=OnlyFrom(['none', 'shift'])))
         self.mode = mode
         self._add_typeparam(tp_r_cut)
+        self._param_variants = {}
+
+    def set_param_variant(self, pair, name, variant):
+        """Not available for anisotropic pair potentials."""
+        raise TypeError("Anisotropic pair parameters cannot follow a variant.")
 
     def _return_type_shapes(self):
         type_shapes = self.cpp_force.getTypeShapesPy()
@@ -5,6 +5,7 @@
 """Pair potentials."""
 
 import copy
+import os
 import warnings
 
 import hoomd
@@ -120,12 +121,30 @@ class Pair(force.Force):
         Possible values: ``"none"``, ``"shift"``, ``"xplor"``
 
         Type: `str`
+
+    .. py:attribute:: compact_positions
+
+        *compact_positions*, *optional*: defaults to `False`. When `True`, the
+        GPU kernel reads positions stored in single precision relative to the
+        center of the local box instead of the full precision positions. This
+        halves the memory traffic of the position reads in mixed and double
+        precision builds. Pair separations then carry an absolute error of
+        about :math:`10^{-7} L/2`, where :math:`L` is the local box length,
+        while the forces, energies, and virials still accumulate in full
+        precision. The positions are only converted when the GPU kernel uses
+        the neighbor list on a single GPU. Has no effect on the CPU.
+
+        Type: `bool`
     """
 
     # The accepted modes for the potential. Should be reset by subclasses with
     # restricted modes.
     _accepted_modes = ("none", "shift", "xplor")
 
+    # Whether the GPU implementation reads compact positions. Should be reset
+    # by subclasses with their own GPU kernels.
+    _supports_compact_positions = True
+
     def __init__(self, nlist, default_r_cut=None, default_r_on=0., mode='none'):
         self._nlist = validate_nlist(nlist)
         tp_r_cut = TypeParameter(
@@ -141,6 +160,48 @@ class Pair(force.Force):
         self._param_dict.update(
             ParameterDict(mode=OnlyFrom(self._accepted_modes)))
         self.mode = mode
+        if self._supports_compact_positions:
+            self._param_dict.update(
+                ParameterDict(compact_positions=False))
+        self._param_variants = {}
+
+    def set_param_variant(self, pair, name, variant):
+        """Vary a pair parameter with the time step.
+
+        Args:
+            pair (tuple[str, str]): Particle type pair.
+            name (str): Name of a scalar parameter in ``params`` (for example
+                ``'epsilon'``).
+            variant (hoomd.variant.Variant): Value of the parameter as a
+                function of the time step. Set to `None` to use the value in
+                ``params`` again.
+
+        The pair potential evaluates *variant* in C++ at every time step and
+        rebuilds the parameters of *pair* when its value changes, without the
+        overhead of a Python action. The other parameters of *pair* keep the
+        values set in ``params``.
+
+        Example::
+
+            lj.set_param_variant(('A', 'A'), 'epsilon',
+                                 hoomd.variant.Ramp(0, 1, 0, 10000))
+        """
+        if variant is not None and not isinstance(variant,
+                                                  hoomd.variant.Variant):
+            raise TypeError("variant must be a hoomd.variant.Variant or None.")
+
+        key = (tuple(sorted(pair)), name)
+        if self._attached:
+            self._cpp_obj.setParamVariant(key[0], name, variant)
+
+        if variant is None:
+            self._param_variants.pop(key, None)
+        else:
+            self._param_variants[key] = variant
+
+    def _apply_param_variants(self):
+        for (pair, name), variant in self._param_variants.items():
+            self._cpp_obj.setParamVariant(pair, name, variant)
 
     def compute_energy(self, tags1, tags2):
         r"""Compute the energy between two sets of particles.
@@ -207,8 +268,7 @@ class Pair(force.Force):
         # neighbor list when not attached we handle correctly.
         self._add_dependency(self._nlist)
 
-    def _attach(self):
-        # create the c++ mirror class
+    def _attach_nlist(self):
         if not self._nlist._added:
             self._nlist._add(self._simulation)
         else:
@@ -217,6 +277,10 @@ class Pair(force.Force):
                                    "different simulation.".format(type(self)))
         if not self.nlist._attached:
             self.nlist._attach()
+
+    def _attach(self):
+        # create the c++ mirror class
+        self._attach_nlist()
         if isinstance(self._simulation.device, hoomd.device.CPU):
             cls = getattr(_md, self._cpp_class_name)
             self.nlist._cpp_obj.setStorageMode(
@@ -229,6 +293,7 @@ class Pair(force.Force):
                             self.nlist._cpp_obj)
 
         super()._attach()
+        self._apply_param_variants()
 
     @property
     def nlist(self):
@@ -612,11 +677,19 @@ class Table(Pair):
 
     Provide :math:`F(r)` and :math:`V(r)` on an evenly space set of grid points
     points between :math:`r_{\\mathrm{min}}` and :math:`r_{\\mathrm{cut}}`.
-    `Table` linearly interpolates values when :math:`r` lies between grid points
-    and between the last grid point and :math:`r=r_{\\mathrm{cut}}`.  The force
+    `Table` interpolates values when :math:`r` lies between grid points and
+    between the last grid point and :math:`r=r_{\\mathrm{cut}}`.  The force
     must be specificed commensurate with the potential: :math:`F =
     -\\frac{\\partial V}{\\partial r}`.
 
+    With ``interpolation='linear'``, `Table` interpolates :math:`V` and
+    :math:`F` linearly. With ``interpolation='cubic'``, :math:`V` is the cubic
+    Hermite polynomial that matches :math:`V` and :math:`-F` at both grid
+    points and :math:`F` is its derivative. The cubic error decreases with the
+    fourth power of the grid spacing instead of the second, so a much coarser
+    table reaches the same accuracy. Coarser tables are also more likely to fit
+    in the shared memory on the GPU.
+
     `Table` does not support energy shifting or smoothing modes.
 
     Attributes:
@@ -636,6 +709,9 @@ class Table(Pair):
             the tabulated force values :math:`[\\mathrm{force}]`. Must have the
             same length as ``V``.
 
+          * ``interpolation`` (`str`, **optional**) - ``'linear'`` or
+            ``'cubic'``, defaults to ``'linear'``.
+
     Note:
 
         The implicitly defined :math:`r` values are those that would be returned
@@ -652,6 +728,7 @@ class Table(Pair):
                 r_min=float,
                 V=hoomd.data.typeconverter.NDArrayValidator(np.float64),
                 F=hoomd.data.typeconverter.NDArrayValidator(np.float64),
+                interpolation='linear',
                 len_keys=2))
         self._add_typeparam(params)
 
@@ -796,6 +873,7 @@ class DPD(Pair):
         dpd.params[(['A', 'B'], ['C', 'D'])] = dict(A=40.0, gamma=4.5)
     """
     _cpp_class_name = "PotentialPairDPDThermoDPD"
+    _supports_compact_positions = False
     _accepted_modes = ("none",)
 
     def __init__(self, nlist, kT, default_r_cut=None, default_r_on=0.):
@@ -969,6 +1047,7 @@ class DPDLJ(Pair):
         dpdlj.r_cut[('B', 'B')] = 2.0**(1.0/6.0)
     """
     _cpp_class_name = "PotentialPairDPDLJThermoDPD"
+    _supports_compact_positions = False
     _accepted_modes = ("none", "shifted")
 
     def __init__(self,
@@ -1918,3 +1997,146 @@ class TWF(Pair):
                               alpha=float,
                               len_keys=2))
         self._add_typeparam(params)
+
+
+class CPPPotential(Pair):
+    r"""Pair potential evaluated by C++ code compiled at run time.
+
+    Args:
+        nlist (`hoomd.md.nlist.NList`): Neighbor list.
+        code (str): C++ code that computes the energy and force of a pair.
+        default_r_cut (float): Default cutoff radius :math:`[\mathrm{length}]`.
+        default_r_on (float): Default turn-on radius :math:`[\mathrm{length}]`.
+        mode (str): Energy shifting/smoothing mode.
+        clang_exec (str): The clang executable to use.
+
+    `CPPPotential` compiles *code* with clang to LLVM IR and then to machine
+    code when it is attached to a simulation. The compiled function is called
+    for every pair within the cutoff with the same force loop as the built in
+    pair potentials, without the interpolation error of `Table`.
+
+    *code* is the body of a function with the following signature:
+
+    .. code-block:: c++
+
+        double eval(double r_sq,
+                    const double* param,
+                    double d_i,
+                    double d_j,
+                    double q_i,
+                    double q_j,
+                    double& force_divr)
+
+    * *r_sq* is the squared distance between the particles.
+    * *param* holds the ``param`` array of the type pair.
+    * *d_i*, *d_j* are the particle diameters and *q_i*, *q_j* their charges.
+    * The code must set *force_divr* to :math:`-\frac{1}{r}\frac{\partial
+      V}{\partial r}` and return :math:`V(r)`.
+
+    ``HOOMDMath.h`` is included. See `Pair` for details on how forces are
+    calculated and the available energy shifting and smoothing modes. The
+    compiled LLVM IR is cached on disk, see ``HOOMD_JIT_CACHE_DIR``.
+
+    Note:
+        `CPPPotential` requires a build with ``BUILD_JIT`` and a ``clang``
+        executable. It is only available on the CPU.
+
+    .. py:attribute:: params
+
+        The potential parameters. The dictionary has the following keys:
+
+        * ``param`` (`numpy.ndarray` [`float`], **required**) - parameters
+          passed to the code, at most 16 values.
+
+        Type: `TypeParameter` [`tuple` [``particle_type``, ``particle_type``],
+        `dict`]
+
+    Example::
+
+        nl = nlist.Cell()
+        lj_code = '''
+            double r2inv = 1.0 / r_sq;
+            double r6inv = r2inv * r2inv * r2inv;
+            double sigma6 = param[1] * param[1] * param[1]
+                            * param[1] * param[1] * param[1];
+            force_divr = 24.0 * param[0] * sigma6 * r2inv * r6inv
+                         * (2.0 * sigma6 * r6inv - 1.0);
+            return 4.0 * param[0] * sigma6 * r6inv * (sigma6 * r6inv - 1.0);
+        '''
+        cpp = pair.CPPPotential(nl, code=lj_code, default_r_cut=2.5)
+        cpp.params[('A', 'A')] = dict(param=[1.0, 1.0])
+    """
+    _cpp_class_name = "PotentialPairJIT"
+    _supports_compact_positions = False
+
+    def __init__(self,
+                 nlist,
+                 code,
+                 default_r_cut=None,
+                 default_r_on=0.,
+                 mode='none',
+                 clang_exec='clang'):
+        super().__init__(nlist, default_r_cut, default_r_on, mode)
+        params = TypeParameter(
+            'params', 'particle_types',
+            TypeParameterDict(
+                param=hoomd.data.typeconverter.NDArrayValidator(np.float64),
+                len_keys=2))
+        self._add_typeparam(params)
+        self._code = code
+        self._clang_exec = clang_exec
+
+    @property
+    def code(self):
+        """str: C++ code that computes the energy and force of a pair."""
+        return self._code
+
+    def _wrap_cpu_code(self):
+        return """
+#include "hoomd/HOOMDMath.h"
+
+extern "C"
+{
+double eval(double r_sq,
+    const double* param,
+    double d_i,
+    double d_j,
+    double q_i,
+    double q_j,
+    double& force_divr)
+    {
+""" + self._code + """
+    }
+}
+"""
+
+    def _attach(self):
+        if not isinstance(self._simulation.device, hoomd.device.CPU):
+            raise RuntimeError("CPPPotential is only available on the CPU.")
+
+        # hoomd.jit is only present in builds with BUILD_JIT
+        from hoomd.jit import _jit, compiler
+
+        include_path = os.path.dirname(hoomd.__file__) + '/include'
+        include_path_source = hoomd._hoomd.__hoomd_source_dir__
+        cmd = [
+            self._clang_exec, '-O3', '--std=c++14', '-DHOOMD_LLVMJIT_BUILD',
+            '-I', include_path, '-I', include_path_source, '-S', '-emit-llvm',
+            '-x', 'c++', '-o', '-', '-'
+        ]
+        device = self._simulation.device
+        llvm_ir = compiler.cached_compile_ir(cmd, self._wrap_cpu_code(),
+                                             device._cpp_exec_conf,
+                                             device._cpp_msg)
+
+        self._attach_nlist()
+        self.nlist._cpp_obj.setStorageMode(_md.NeighborList.storageMode.half)
+        self._cpp_obj = _jit.PotentialPairJIT(
+            self._simulation.state._cpp_sys_def, self.nlist._cpp_obj, llvm_ir)
+
+        # skip Pair._attach, which constructs the built in potentials
+        super(Pair, self)._attach()
+
+    def set_param_variant(self, pair, name, variant):
+        """Not available, the parameters of `CPPPotential` are arrays."""
+        raise TypeError("CPPPotential parameters cannot follow a variant.")
@@ -148,6 +148,64 @@ def test_update(active_force, local_simulation_factory):
         assert not np.allclose(old_orientations, new_orientations)
 
 
+def test_rotation_distribution(active_force, simulation_factory, device):
+    """Rotation angles per step follow a normal with width sqrt(2 D_r dt)."""
+    # particles on a grid in the plane z = 0.1 used by the manifold fixture
+    n = 32
+    snapshot = hoomd.Snapshot(device.communicator)
+    if snapshot.communicator.rank == 0:
+        snapshot.configuration.box = [2 * n, 2 * n, 2 * n, 0, 0, 0]
+        snapshot.particles.N = n * n
+        snapshot.particles.types = ['A']
+        x = np.linspace(-n + 1, n - 1, n)
+        grid = np.meshgrid(x, x, indexing='ij')
+        snapshot.particles.position[:, 0] = grid[0].flatten()
+        snapshot.particles.position[:, 1] = grid[1].flatten()
+        snapshot.particles.position[:, 2] = 0.1
+        snapshot.particles.orientation[:] = [1, 0, 0, 0]
+
+    active_force.active_force.default = (1., 0., 0.)
+    active_force.active_torque.default = (0., 0., 0.)
+    rotational_diffusion = 1.0
+    dt = 0.005
+    rd_updater = hoomd.md.update.ActiveRotationalDiffusion(
+        1, active_force, rotational_diffusion)
+
+    sim = simulation_factory(snapshot)
+    if isinstance(active_force, hoomd.md.force.ActiveOnManifold):
+        method = hoomd.md.methods.rattle.NVE(hoomd.filter.All(),
+                                             hoomd.md.manifold.Plane(0.1))
+    else:
+        method = hoomd.md.methods.NVE(hoomd.filter.All())
+    sim.operations.integrator = hoomd.md.Integrator(dt,
+                                                    methods=[method],
+                                                    forces=[active_force])
+    sim.operations.updaters.append(rd_updater)
+    sim.run(0)
+
+    # each step applies one rotation, its angle follows from the overlap of
+    # the orientations before and after the step
+    angles = []
+    old = sim.state.get_snapshot()
+    for _ in range(5):
+        sim.run(1)
+        new = sim.state.get_snapshot()
+        if new.communicator.rank == 0:
+            overlap = np.sum(old.particles.orientation
+                             * new.particles.orientation,
+                             axis=1)
+            angles.append(2 * np.arccos(np.clip(np.abs(overlap), 0, 1)))
+        old = new
+
+    if old.communicator.rank == 0:
+        angles = np.concatenate(angles)
+        sigma = np.sqrt(2 * rotational_diffusion * dt)
+        np.testing.assert_allclose(np.mean(angles**2), sigma**2, rtol=0.1)
+        np.testing.assert_allclose(np.mean(angles),
+                                   sigma * np.sqrt(2 / np.pi),
+                                   rtol=0.1)
+
+
 def test_pickling(active_force, local_simulation_factory):
     # don't add the rd_updater since operation_pickling_check will deal with
     # that.
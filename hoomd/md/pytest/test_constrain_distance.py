@@ -88,6 +88,15 @@ def test_attach_detach(simulation_factory, polymer_snapshot_factory):
     d.tolerance = 1e-5
     assert d.tolerance == 1e-5
 
+    assert d.solver == 'lu'
+    d.solver = 'iterative'
+    assert d.solver == 'iterative'
+    d.solver_tolerance = 1e-8
+    assert d.solver_tolerance == 1e-8
+
+    with pytest.raises(ValueError):
+        d.solver = 'cholesky'
+
 
 def test_pickling(simulation_factory, polymer_snapshot_factory):
     """Test that md.constrain.Distance can be pickled and unpickled."""
@@ -106,9 +115,11 @@ def test_pickling(simulation_factory, polymer_snapshot_factory):
     pickling_check(d)
 
 
-def test_basic_simulation(simulation_factory, polymer_snapshot_factory):
+@pytest.mark.parametrize("solver", ['lu', 'iterative'])
+def test_basic_simulation(simulation_factory, polymer_snapshot_factory,
+                          solver):
     """Ensure that distances are constrained in a basic simulation."""
-    d = hoomd.md.constrain.Distance()
+    d = hoomd.md.constrain.Distance(solver=solver)
 
     sim = simulation_factory(polymer_snapshot_factory())
     integrator = hoomd.md.Integrator(dt=0.005)
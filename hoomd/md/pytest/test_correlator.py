@@ -0,0 +1,81 @@
+import hoomd
+import numpy as np
+import pytest
+
+_lags = [0, 1, 2, 3, 4, 6, 8, 12]
+
+
+def _make_simulation(simulation_factory, two_particle_snapshot_factory):
+    snap = two_particle_snapshot_factory()
+    if snap.communicator.rank == 0:
+        snap.particles.velocity[:] = [[1, 0, 0], [0, 2, 0]]
+    sim = simulation_factory(snap)
+    integrator = hoomd.md.Integrator(dt=0.01)
+    integrator.methods.append(hoomd.md.methods.NVE(hoomd.filter.All()))
+    sim.operations.integrator = integrator
+    return sim
+
+
+@pytest.mark.serial
+def test_velocity(simulation_factory, two_particle_snapshot_factory):
+    sim = _make_simulation(simulation_factory, two_particle_snapshot_factory)
+    vacf = hoomd.md.correlator.Velocity(trigger=hoomd.trigger.Periodic(1),
+                                        filter=hoomd.filter.All(),
+                                        points=4,
+                                        averaging=2,
+                                        levels=3)
+    sim.operations.writers.append(vacf)
+    sim.run(40)
+
+    assert vacf.num_samples == 40
+    np.testing.assert_array_equal(vacf.lags, _lags)
+    # free particles keep their velocities
+    np.testing.assert_allclose(vacf.correlation, 2.5, rtol=1e-5)
+
+    vacf.reset()
+    assert vacf.num_samples == 0
+    assert np.all(np.isnan(vacf.correlation))
+
+
+@pytest.mark.serial
+def test_mean_squared_displacement(simulation_factory,
+                                   two_particle_snapshot_factory):
+    sim = _make_simulation(simulation_factory, two_particle_snapshot_factory)
+    msd = hoomd.md.correlator.MeanSquaredDisplacement(
+        trigger=hoomd.trigger.Periodic(1),
+        filter=hoomd.filter.All(),
+        points=4,
+        averaging=2,
+        levels=3)
+    sim.operations.writers.append(msd)
+    sim.run(40)
+
+    # block averages of linear trajectories differ by the exact displacement
+    expected = 2.5 * (np.array(_lags) * 0.01)**2
+    np.testing.assert_allclose(msd.correlation, expected, rtol=1e-4,
+                               atol=1e-8)
+
+
+def test_pressure_tensor(simulation_factory, two_particle_snapshot_factory):
+    sim = _make_simulation(simulation_factory, two_particle_snapshot_factory)
+    pt = hoomd.md.correlator.PressureTensor(trigger=hoomd.trigger.Periodic(1),
+                                            points=4,
+                                            averaging=2,
+                                            levels=3)
+    sim.operations.writers.append(pt)
+    sim.run(10)
+
+    np.testing.assert_array_equal(pt.lags, _lags)
+    correlation = pt.correlation
+    # the off-diagonal kinetic pressure is 0 for these velocities
+    np.testing.assert_allclose(correlation[:4], 0, atol=1e-10)
+    assert np.all(np.isnan(correlation[-2:]))
+
+
+def test_invalid_points(simulation_factory, two_particle_snapshot_factory):
+    sim = _make_simulation(simulation_factory, two_particle_snapshot_factory)
+    pt = hoomd.md.correlator.PressureTensor(trigger=hoomd.trigger.Periodic(1),
+                                            points=5,
+                                            averaging=2)
+    with pytest.raises(ValueError):
+        sim.operations.writers.append(pt)
@@ -0,0 +1,124 @@
+import hoomd
+import numpy
+import pytest
+import shutil
+
+try:
+    from hoomd.jit import _jit
+except ImportError:
+    pytest.skip("hoomd.jit not available", allow_module_level=True)
+
+if not hasattr(_jit, 'PotentialPairJIT'):
+    pytest.skip("hoomd.jit built without MD", allow_module_level=True)
+
+if shutil.which('clang') is None:
+    pytest.skip("clang not available", allow_module_level=True)
+
+lj_code = """
+double r2inv = 1.0 / r_sq;
+double r6inv = r2inv * r2inv * r2inv;
+double sigma6 = param[1] * param[1] * param[1] * param[1] * param[1] * param[1];
+force_divr = 24.0 * param[0] * sigma6 * r2inv * r6inv
+             * (2.0 * sigma6 * r6inv - 1.0);
+return 4.0 * param[0] * sigma6 * r6inv * (sigma6 * r6inv - 1.0);
+"""
+
+
+@pytest.mark.parametrize("mode", ['none', 'shift'])
+def test_cpp_potential_matches_lj(simulation_factory,
+                                  two_particle_snapshot_factory, device,
+                                  tmp_path, monkeypatch, mode):
+    """Test that the compiled potential reproduces LJ."""
+    if isinstance(device, hoomd.device.GPU):
+        pytest.skip("CPPPotential is only available on the CPU")
+
+    monkeypatch.setenv('HOOMD_JIT_CACHE_DIR', str(tmp_path))
+
+    forces = []
+    energies = []
+    for make_potential in [
+            lambda nl: hoomd.md.pair.CPPPotential(
+                nl, code=lj_code, default_r_cut=2.5, mode=mode),
+            lambda nl: hoomd.md.pair.LJ(nl, default_r_cut=2.5, mode=mode)
+    ]:
+        sim = simulation_factory(two_particle_snapshot_factory(d=1.1))
+        potential = make_potential(hoomd.md.nlist.Cell())
+        if isinstance(potential, hoomd.md.pair.CPPPotential):
+            potential.params[('A', 'A')] = dict(param=[1.5, 0.9])
+        else:
+            potential.params[('A', 'A')] = dict(epsilon=1.5, sigma=0.9)
+
+        integrator = hoomd.md.Integrator(dt=0.005, forces=[potential])
+        sim.operations.integrator = integrator
+        sim.run(0)
+
+        forces.append(potential.forces)
+        energies.append(potential.energies)
+
+    if device.communicator.rank == 0:
+        numpy.testing.assert_allclose(forces[0], forces[1], rtol=1e-6)
+        numpy.testing.assert_allclose(energies[0], energies[1], rtol=1e-6)
+
+
+def test_cpp_potential_ir_cache(simulation_factory,
+                                two_particle_snapshot_factory, device,
+                                tmp_path, monkeypatch):
+    """Test that compiled IR is reused from the cache directory."""
+    if isinstance(device, hoomd.device.GPU):
+        pytest.skip("CPPPotential is only available on the CPU")
+
+    from hoomd.jit import compiler
+
+    # count the clang invocations
+    compiles = []
+    compile_ir = compiler.compile_ir
+
+    def counting_compile_ir(cmd, source, msg):
+        compiles.append(source)
+        return compile_ir(cmd, source, msg)
+
+    monkeypatch.setattr(compiler, 'compile_ir', counting_compile_ir)
+
+    def attach(code):
+        sim = simulation_factory(two_particle_snapshot_factory(d=1.1))
+        potential = hoomd.md.pair.CPPPotential(hoomd.md.nlist.Cell(),
+                                               code=code,
+                                               default_r_cut=2.5)
+        potential.params[('A', 'A')] = dict(param=[1.5, 0.9])
+        sim.operations.integrator = hoomd.md.Integrator(dt=0.005,
+                                                        forces=[potential])
+        sim.run(0)
+        return potential.energy
+
+    def cache_files():
+        return sorted(p.name for p in tmp_path.iterdir())
+
+    monkeypatch.setenv('HOOMD_JIT_CACHE_DIR', str(tmp_path))
+
+    # the first construction misses and writes the IR to the cache
+    energy = attach(lj_code)
+    n_compiles = len(compiles)
+    if device.communicator.rank == 0:
+        assert n_compiles == 1
+        assert len(cache_files()) == 1
+        assert cache_files()[0].endswith('.ll')
+
+    # the same code hits the cache and gives the same energy
+    assert attach(lj_code) == energy
+    assert len(compiles) == n_compiles
+    if device.communicator.rank == 0:
+        assert len(cache_files()) == 1
+
+    # different code misses and adds a second entry
+    attach(lj_code + "\n")
+    if device.communicator.rank == 0:
+        assert len(compiles) == n_compiles + 1
+        assert len(cache_files()) == 2
+
+    # an empty cache directory disables the cache
+    monkeypatch.setenv('HOOMD_JIT_CACHE_DIR', '')
+    n_compiles = len(compiles)
+    assert attach(lj_code) == energy
+    if device.communicator.rank == 0:
+        assert len(compiles) == n_compiles + 1
+        assert len(cache_files()) == 2
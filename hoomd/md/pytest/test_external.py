@@ -128,3 +128,40 @@ def test_forces_and_energies(simulation_factory, lattice_snapshot_factory,
             np.testing.assert_allclose(expected_forces, forces)
             # set atol as the energies are very close to 0
             np.testing.assert_allclose(expected_energies, energies, atol=1e-5)
+
+
+def test_periodic_electric(simulation_factory, lattice_snapshot_factory):
+    """Test that PeriodicElectric matches the sum of the separate fields."""
+    periodic_params = dict(A=1.5, i=1, w=3.5, p=5)
+    E = (1, 2, 0)
+
+    snap = lattice_snapshot_factory(n=2)
+    if snap.communicator.rank == 0:
+        snap.particles.charge[:] = np.random.random(snap.particles.N) * 2 - 1
+    sim = simulation_factory(snap)
+
+    combined = hoomd.md.external.field.PeriodicElectric()
+    combined.params['A'] = dict(periodic=periodic_params, e_field=E)
+    periodic = hoomd.md.external.field.Periodic()
+    periodic.params['A'] = periodic_params
+    electric = hoomd.md.external.field.Electric()
+    electric.E['A'] = E
+
+    sim.operations.integrator = hoomd.md.Integrator(dt=0.001)
+    sim.operations.integrator.forces.extend([combined, periodic, electric])
+    sim.run(0)
+
+    assert combined.params['A']['periodic'] == periodic_params
+    npt.assert_allclose(combined.params['A']['e_field'], E)
+
+    forces = combined.forces
+    energies = combined.energies
+    expected_forces = periodic.forces
+    expected_energies = periodic.energies
+    electric_forces = electric.forces
+    electric_energies = electric.energies
+    if snap.communicator.rank == 0:
+        npt.assert_allclose(forces, expected_forces + electric_forces,
+                            atol=1e-5)
+        npt.assert_allclose(energies, expected_energies + electric_energies,
+                            atol=1e-5)
@@ -0,0 +1,116 @@
+# Copyright (c) 2009-2021 The Regents of the University of Michigan
+# This file is part of the HOOMD-blue project, released under the BSD 3-Clause
+# License.
+
+import hoomd
+import numpy as np
+import pytest
+
+_bond_params = dict(k=400.0, r0=1.0)
+_angle_params = dict(k=50.0, t0=1.9)
+_dihedral_params = dict(k1=1.0, k2=-0.5, k3=0.75, k4=0.25)
+
+
+@pytest.fixture(scope='session')
+def chain_snapshot_factory(device):
+
+    def make_snapshot(N=8, L=6):
+        s = hoomd.Snapshot(device.communicator)
+        if s.communicator.rank == 0:
+            s.configuration.box = [L, L, L, 0, 0, 0]
+            s.particles.N = N
+            s.particles.types = ['A']
+
+            # a kinked chain that crosses the periodic boundary
+            rng = np.random.default_rng(seed=10)
+            position = np.zeros((N, 3))
+            for i in range(1, N):
+                step = rng.normal(size=3)
+                position[i] = position[i - 1] + 1.1 * step / np.linalg.norm(
+                    step)
+            position -= np.mean(position, axis=0)
+            position[:, 0] += L / 2 - 0.5
+            s.particles.position[:] = (position + L / 2) % L - L / 2
+
+            s.bonds.N = N - 1
+            s.bonds.types = ['backbone']
+            s.bonds.group[:] = [(i, i + 1) for i in range(N - 1)]
+            s.angles.N = N - 2
+            s.angles.types = ['backbone']
+            s.angles.group[:] = [(i, i + 1, i + 2) for i in range(N - 2)]
+            s.dihedrals.N = N - 3
+            s.dihedrals.types = ['backbone']
+            s.dihedrals.group[:] = [
+                (i, i + 1, i + 2, i + 3) for i in range(N - 3)
+            ]
+
+        return s
+
+    return make_snapshot
+
+
+def _run_forces(simulation_factory, snap, forces):
+    sim = simulation_factory(snap)
+    integrator = hoomd.md.Integrator(dt=0.005)
+    integrator.forces.extend(forces)
+    sim.operations.integrator = integrator
+    sim.always_compute_pressure = True
+    sim.run(0)
+    return sim
+
+
+def test_params(chain_snapshot_factory, simulation_factory):
+    bonded = hoomd.md.force.FusedBonded()
+    bonded.bond_params['backbone'] = _bond_params
+    bonded.angle_params['backbone'] = _angle_params
+    bonded.dihedral_params['backbone'] = _dihedral_params
+
+    _run_forces(simulation_factory, chain_snapshot_factory(), [bonded])
+
+    for param_dict, expected in ((bonded.bond_params, _bond_params),
+                                 (bonded.angle_params, _angle_params),
+                                 (bonded.dihedral_params, _dihedral_params)):
+        for key in expected:
+            np.testing.assert_allclose(param_dict['backbone'][key],
+                                       expected[key],
+                                       rtol=1e-6)
+
+
+def test_matches_separate_forces(chain_snapshot_factory, simulation_factory):
+    snap = chain_snapshot_factory()
+
+    bonded = hoomd.md.force.FusedBonded()
+    bonded.bond_params['backbone'] = _bond_params
+    bonded.angle_params['backbone'] = _angle_params
+    bonded.dihedral_params['backbone'] = _dihedral_params
+    _run_forces(simulation_factory, snap, [bonded])
+
+    bond = hoomd.md.bond.Harmonic()
+    bond.params['backbone'] = _bond_params
+    angle = hoomd.md.angle.Harmonic()
+    angle.params['backbone'] = _angle_params
+    dihedral = hoomd.md.dihedral.OPLS()
+    dihedral.params['backbone'] = _dihedral_params
+    separate = [bond, angle, dihedral]
+    _run_forces(simulation_factory, snap, separate)
+
+    forces = bonded.forces
+    energies = bonded.energies
+    virials = bonded.virials
+    reference_forces = [f.forces for f in separate]
+    reference_energies = [f.energies for f in separate]
+    reference_virials = [f.virials for f in separate]
+
+    if snap.communicator.rank == 0:
+        np.testing.assert_allclose(forces,
+                                   sum(reference_forces),
+                                   rtol=1e-5,
+                                   atol=1e-5)
+        np.testing.assert_allclose(energies,
+                                   sum(reference_energies),
+                                   rtol=1e-5,
+                                   atol=1e-5)
+        np.testing.assert_allclose(virials,
+                                   sum(reference_virials),
+                                   rtol=1e-5,
+                                   atol=1e-5)
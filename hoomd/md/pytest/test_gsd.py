@@ -207,6 +207,67 @@ def test_write_gsd_filter(create_md_sim, tmp_path):
                 assert frame.particles.N == 0
 
 
+def test_write_gsd_filter_subset(create_md_sim, tmp_path):
+
+    filename = tmp_path / "temporary_test_file.gsd"
+
+    sim = create_md_sim
+    tags = [3, 17, 42, 99, 500]
+    gsd_writer = hoomd.write.GSD(filename=filename,
+                                 trigger=hoomd.trigger.Periodic(1),
+                                 filter=hoomd.filter.Tags(tags),
+                                 mode='wb',
+                                 dynamic=['property', 'momentum', 'attribute'])
+    sim.operations.writers.append(gsd_writer)
+
+    sim.run(3)
+    snapshot = sim.state.get_snapshot()
+
+    if snapshot.communicator.rank == 0:
+        with gsd.hoomd.open(name=filename, mode='rb') as traj:
+            assert len(traj) == 3
+            frame = traj[-1]
+            assert frame.particles.N == len(tags)
+            for prop in [
+                    'position', 'velocity', 'image', 'typeid', 'mass',
+                    'charge', 'diameter', 'angmom'
+            ]:
+                np.testing.assert_allclose(
+                    getattr(frame.particles, prop),
+                    getattr(snapshot.particles, prop)[tags],
+                    rtol=1e-6,
+                    atol=1e-6)
+
+
+def test_write_gsd_repeated(create_md_sim, tmp_path):
+
+    sim = create_md_sim
+    tags = [3, 17, 42, 99, 500]
+    snapshot = sim.state.get_snapshot()
+
+    # temporaries of writes outside of a run do not accumulate
+    arena_bytes = []
+    for i in range(10):
+        filename = tmp_path / f"temporary_test_file_{i}.gsd"
+        hoomd.write.GSD.write(state=sim.state,
+                              mode='wb',
+                              filename=str(filename),
+                              filter=hoomd.filter.Tags(tags))
+        report = sim.device.memory_report
+        arena_bytes.append(
+            (report['StepArena::host'], report.get('StepArena::device', 0)))
+
+        if snapshot.communicator.rank == 0:
+            with gsd.hoomd.open(name=filename, mode='rb') as traj:
+                assert len(traj) == 1
+                np.testing.assert_allclose(traj[0].particles.position,
+                                           snapshot.particles.position[tags],
+                                           rtol=1e-6,
+                                           atol=1e-6)
+
+    assert all(b == arena_bytes[1] for b in arena_bytes[1:])
+
+
 def test_write_gsd_truncate(create_md_sim, tmp_path):
 
     filename = tmp_path / "temporary_test_file.gsd"
@@ -228,6 +289,121 @@ def test_write_gsd_truncate(create_md_sim, tmp_path):
                 assert_equivalent_snapshots(gsd_snap, snapshot)
 
 
+@pytest.mark.parametrize('truncate', [False, True])
+def test_write_gsd_asynchronous(create_md_sim, tmp_path, truncate):
+
+    filename = tmp_path / "temporary_test_file.gsd"
+
+    sim = create_md_sim
+
+    gsd_writer = hoomd.write.GSD(filename=filename,
+                                 trigger=hoomd.trigger.Periodic(1),
+                                 truncate=truncate,
+                                 mode='wb',
+                                 asynchronous=True)
+    sim.operations.writers.append(gsd_writer)
+    assert gsd_writer.asynchronous
+
+    sim.run(5)
+    snapshot = sim.state.get_snapshot()
+
+    # run() returns after the buffered frames are written
+    if snapshot.communicator.rank == 0:
+        with gsd.hoomd.open(name=filename, mode='rb') as traj:
+            if truncate:
+                assert len(traj) == 1
+            else:
+                assert [frame.configuration.step for frame in traj
+                       ] == [1, 2, 3, 4, 5]
+            assert_equivalent_snapshots(traj[-1], snapshot)
+
+    gsd_writer.asynchronous = False
+    sim.run(1)
+    gsd_writer.flush()
+
+    if snapshot.communicator.rank == 0:
+        with gsd.hoomd.open(name=filename, mode='rb') as traj:
+            assert len(traj) == (1 if truncate else 6)
+
+
+def test_write_gsd_parallel(create_md_sim, tmp_path):
+
+    filename = tmp_path / "temporary_test_file.gsd"
+    filename_parallel = tmp_path / "temporary_test_file_parallel.gsd"
+
+    sim = create_md_sim
+
+    gsd_writer = hoomd.write.GSD(filename=filename,
+                                 trigger=hoomd.trigger.Periodic(1),
+                                 mode='wb',
+                                 dynamic=['property', 'momentum', 'attribute'])
+    gsd_writer_parallel = hoomd.write.GSD(
+        filename=filename_parallel,
+        trigger=hoomd.trigger.Periodic(1),
+        mode='wb',
+        dynamic=['property', 'momentum', 'attribute'],
+        parallel=True)
+    sim.operations.writers.append(gsd_writer)
+    sim.operations.writers.append(gsd_writer_parallel)
+    assert gsd_writer_parallel.parallel
+
+    sim.run(3)
+    snapshot = sim.state.get_snapshot()
+
+    if snapshot.communicator.rank == 0:
+        with gsd.hoomd.open(name=filename, mode='rb') as traj, \
+                gsd.hoomd.open(name=filename_parallel,
+                               mode='rb') as traj_parallel:
+            assert len(traj) == len(traj_parallel)
+            for frame, frame_parallel in zip(traj, traj_parallel):
+                for prop in ['position', 'velocity', 'image', 'typeid', 'mass']:
+                    np.testing.assert_array_equal(
+                        getattr(frame.particles, prop),
+                        getattr(frame_parallel.particles, prop))
+            assert_equivalent_snapshots(traj_parallel[-1], snapshot)
+
+
+@pytest.mark.skipif(not hoomd.version.zlib_enabled,
+                    reason="HOOMD-blue was built without zlib")
+@pytest.mark.parametrize('position_precision', [0.0, 1e-3])
+def test_write_gsd_compress(create_md_sim, simulation_factory, tmp_path,
+                            position_precision):
+
+    filename = tmp_path / "temporary_test_file.gsd"
+
+    sim = create_md_sim
+    gsd_writer = hoomd.write.GSD(
+        filename=filename,
+        trigger=hoomd.trigger.Periodic(1),
+        mode='wb',
+        dynamic=['momentum'],
+        compress=['particles/position', 'particles/velocity'],
+        position_precision=position_precision)
+    sim.operations.writers.append(gsd_writer)
+
+    sim.run(2)
+    snapshot = sim.state.get_snapshot()
+
+    sim_read = simulation_factory()
+    sim_read.create_state_from_gsd(filename, frame=1)
+    snapshot_read = sim_read.state.get_snapshot()
+
+    if snapshot.communicator.rank == 0:
+        np.testing.assert_allclose(snapshot_read.particles.velocity,
+                                   snapshot.particles.velocity,
+                                   rtol=1e-6,
+                                   atol=1e-6)
+        if position_precision == 0:
+            np.testing.assert_allclose(snapshot_read.particles.position,
+                                       snapshot.particles.position,
+                                       rtol=1e-6,
+                                       atol=1e-6)
+        else:
+            np.testing.assert_allclose(snapshot_read.particles.position,
+                                       snapshot.particles.position,
+                                       atol=position_precision)
+
+
 def test_write_gsd_dynamic(simulation_factory, create_md_sim, tmp_path):
 
     filename = tmp_path / "temporary_test_file.gsd"
@@ -389,3 +565,71 @@ def test_write_gsd_log(create_md_sim, tmp_path):
                 e = traj[s].log[
                     'md/compute/ThermodynamicQuantities/kinetic_energy']
                 assert e == kinetic_energy_list[s]
+
+
+def test_write_checkpoint(create_md_sim, tmp_path):
+    filename = str(tmp_path / "checkpoint.gsd")
+
+    sim = create_md_sim
+    checkpoint = hoomd.write.Checkpoint(trigger=hoomd.trigger.Periodic(10),
+                                        filename=filename)
+    sim.operations.writers.append(checkpoint)
+    assert checkpoint.num_files == 2
+    assert checkpoint.asynchronous
+
+    sim.run(21)
+
+    # steps 0 and 20 write file 0, step 10 writes file 1
+    assert hoomd.write.Checkpoint.latest(filename) == str(tmp_path
+                                                          / "checkpoint.0.gsd")
+    if sim.device.communicator.rank == 0:
+        for name, step in [("checkpoint.0.gsd", 20), ("checkpoint.1.gsd", 10)]:
+            with gsd.hoomd.open(name=tmp_path / name, mode='rb') as traj:
+                assert len(traj) == 1
+                assert traj[0].configuration.step == step
+                assert traj[0].bonds.N == 2
+
+    # a new writer continues the rotation after the most recent checkpoint
+    sim.operations.writers.remove(checkpoint)
+    checkpoint = hoomd.write.Checkpoint(trigger=hoomd.trigger.Periodic(10),
+                                        filename=filename)
+    sim.operations.writers.append(checkpoint)
+    sim.run(10)
+    assert hoomd.write.Checkpoint.latest(filename) == str(tmp_path
+                                                          / "checkpoint.1.gsd")
+
+
+def test_checkpoint_restore_state(simulation_factory, hoomd_snapshot,
+                                  tmp_path):
+    filename = str(tmp_path / "checkpoint.gsd")
+    assert hoomd.write.Checkpoint.latest(filename) is None
+
+    sim = simulation_factory(hoomd_snapshot)
+    sim.seed = 12
+    nvt = hoomd.md.methods.NVT(filter=hoomd.filter.All(), kT=1.0, tau=0.5)
+    sim.operations.integrator = hoomd.md.Integrator(dt=0.005, methods=[nvt])
+    checkpoint = hoomd.write.Checkpoint(trigger=hoomd.trigger.Periodic(5),
+                                        filename=filename,
+                                        num_files=3,
+                                        asynchronous=False)
+    sim.operations.writers.append(checkpoint)
+    sim.run(6)
+    assert nvt.translational_thermostat_dof != (0.0, 0.0)
+
+    latest = hoomd.write.Checkpoint.latest(filename, num_files=3)
+    assert latest == str(tmp_path / "checkpoint.1.gsd")
+
+    new_sim = hoomd.Simulation(device=sim.device)
+    new_sim.create_state_from_gsd(latest)
+    new_nvt = hoomd.md.methods.NVT(filter=hoomd.filter.All(), kT=1.0, tau=0.5)
+    new_sim.operations.integrator = hoomd.md.Integrator(dt=0.005,
+                                                        methods=[new_nvt])
+    hoomd.write.Checkpoint.restore_state(new_sim, latest)
+
+    assert new_sim.timestep == 5
+    assert new_sim.seed == 12
+    assert new_nvt.translational_thermostat_dof != (0.0, 0.0)
+
+    new_sim.operations.integrator = hoomd.md.Integrator(dt=0.005)
+    with pytest.raises(RuntimeError):
+        hoomd.write.Checkpoint.restore_state(new_sim, latest)
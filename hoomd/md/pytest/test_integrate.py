@@ -1,3 +1,4 @@
+import numpy
 import pytest
 
 import hoomd
@@ -48,3 +49,124 @@ def test_detaching(make_simulation, methods, forces):
     assert not integrator._forces._synced
     assert not integrator._methods._synced
     assert not integrator._contraints._synced
+
+
+def test_outer_forces(simulation_factory, two_particle_snapshot_factory):
+    """Test that outer forces are applied as an impulse every outer_period."""
+    dt = 0.005
+    sim = simulation_factory(two_particle_snapshot_factory(d=1.1))
+    lj = md.pair.LJ(nlist=md.nlist.Cell(), default_r_cut=2.5)
+    lj.params[("A", "A")] = {"epsilon": 1.0, "sigma": 1.0}
+    integrator = md.Integrator(dt,
+                               methods=[md.methods.NVE(hoomd.filter.All())],
+                               outer_forces=[lj],
+                               outer_period=2)
+    sim.operations.integrator = integrator
+    sim.run(0)
+
+    assert integrator.outer_period == 2
+    assert integrator.outer_forces._synced
+
+    snapshot = sim.state.get_snapshot()
+    force = lj.forces
+    sim.run(2)
+
+    # the particles start at rest and only feel the impulse applied at step 0
+    new_snapshot = sim.state.get_snapshot()
+    if new_snapshot.communicator.rank == 0:
+        numpy.testing.assert_allclose(new_snapshot.particles.position
+                                      - snapshot.particles.position,
+                                      2 * dt**2 * force,
+                                      rtol=1e-2,
+                                      atol=1e-6)
+
+    with pytest.raises(ValueError):
+        integrator.outer_period = 0
+
+
+@pytest.mark.cpu
+@pytest.mark.skipif(not hoomd.version.tbb_enabled,
+                    reason="TBB is required for concurrent force computes")
+def test_concurrent_forces(device, simulation_factory,
+                           lattice_snapshot_factory):
+    """Test that forces computed on several threads match a serial run."""
+    snapshot = lattice_snapshot_factory(n=6, a=1.2, r=0.05)
+    if snapshot.communicator.rank == 0:
+        snapshot.bonds.types = ['bond']
+        snapshot.bonds.N = snapshot.particles.N - 1
+        snapshot.bonds.group[:] = [[i, i + 1] for i in range(snapshot.bonds.N)]
+
+    def run(num_cpu_threads):
+        device.num_cpu_threads = num_cpu_threads
+        sim = simulation_factory(snapshot)
+        nlist = md.nlist.Cell()
+        lj = md.pair.LJ(nlist=nlist, default_r_cut=2.5)
+        lj.params[("A", "A")] = {"epsilon": 1.0, "sigma": 1.0}
+        gauss = md.pair.Gauss(nlist=nlist, default_r_cut=2.0)
+        gauss.params[("A", "A")] = {"epsilon": 0.5, "sigma": 0.5}
+        yukawa = md.pair.Yukawa(nlist=md.nlist.Tree(), default_r_cut=2.0)
+        yukawa.params[("A", "A")] = {"epsilon": 0.5, "kappa": 1.0}
+        harmonic = md.bond.Harmonic()
+        harmonic.params['bond'] = dict(k=10.0, r0=1.2)
+        sim.operations.integrator = md.Integrator(
+            0.005,
+            methods=[md.methods.NVE(hoomd.filter.All())],
+            forces=[lj, gauss, yukawa, harmonic])
+        sim.run(10)
+        return sim.state.get_snapshot()
+
+    num_cpu_threads = device.num_cpu_threads
+    serial = run(1)
+    concurrent = run(4)
+    device.num_cpu_threads = num_cpu_threads
+    if serial.communicator.rank == 0:
+        numpy.testing.assert_allclose(concurrent.particles.position,
+                                      serial.particles.position,
+                                      rtol=1e-6,
+                                      atol=1e-8)
+
+
+def test_elide_force_arrays(simulation_factory, lattice_snapshot_factory):
+    """Test that forces computed into shared arrays match separate arrays."""
+    snapshot = lattice_snapshot_factory(n=6, a=1.2, r=0.05)
+    if snapshot.communicator.rank == 0:
+        snapshot.particles.charge[:] = 0.5
+        snapshot.bonds.types = ['bond']
+        snapshot.bonds.N = snapshot.particles.N - 1
+        snapshot.bonds.group[:] = [[i, i + 1] for i in range(snapshot.bonds.N)]
+
+    def run(elide_force_arrays):
+        sim = simulation_factory(snapshot)
+        nlist = md.nlist.Cell()
+        lj = md.pair.LJ(nlist=nlist, default_r_cut=2.5)
+        lj.params[("A", "A")] = {"epsilon": 1.0, "sigma": 1.0}
+        gauss = md.pair.Gauss(nlist=nlist, default_r_cut=2.0)
+        gauss.params[("A", "A")] = {"epsilon": 0.5, "sigma": 0.5}
+        electric = md.external.field.Electric()
+        electric.E['A'] = (0.1, 0.2, 0)
+        harmonic = md.bond.Harmonic()
+        harmonic.params['bond'] = dict(k=10.0, r0=1.2)
+        integrator = md.Integrator(
+            0.005,
+            methods=[md.methods.NVE(hoomd.filter.All())],
+            forces=[lj, gauss, electric, harmonic],
+            elide_force_arrays=elide_force_arrays)
+        sim.operations.integrator = integrator
+        sim.run(10)
+        assert integrator.elide_force_arrays == elide_force_arrays
+
+        # accessing the forces allocates the arrays of the force again
+        return sim.state.get_snapshot(), lj.forces, lj.energy
+
+    separate, separate_forces, separate_energy = run(False)
+    shared, shared_forces, shared_energy = run(True)
+    if separate.communicator.rank == 0:
+        numpy.testing.assert_allclose(shared.particles.position,
+                                      separate.particles.position,
+                                      rtol=1e-6,
+                                      atol=1e-8)
+        numpy.testing.assert_allclose(shared_forces,
+                                      separate_forces,
+                                      rtol=1e-6,
+                                      atol=1e-8)
+    numpy.testing.assert_allclose(shared_energy, separate_energy, rtol=1e-6)
@@ -613,3 +613,97 @@ def test_pickling(method_base_params, simulation_factory,
     sim.operations.integrator = integrator
     sim.run(0)
     pickling_check(method)
+
+
+def test_split_methods_match_single_method(simulation_factory,
+                                           lattice_snapshot_factory):
+    """Methods on disjoint groups match one method on all particles.
+
+    On the GPU, the integrator fuses the split methods into single kernels.
+    """
+    snap = lattice_snapshot_factory(particle_types=['A', 'B'],
+                                    n=6,
+                                    a=1.5,
+                                    r=0.1)
+    if snap.communicator.rank == 0:
+        snap.particles.typeid[:] = [i % 2 for i in range(snap.particles.N)]
+
+    def run(methods):
+        sim = simulation_factory(snap)
+        nlist = hoomd.md.nlist.Cell(buffer=0.4)
+        lj = hoomd.md.pair.LJ(nlist, default_r_cut=2.5)
+        lj.params[(['A', 'B'], ['A', 'B'])] = dict(epsilon=1.0, sigma=1.0)
+        sim.operations.integrator = hoomd.md.Integrator(0.005,
+                                                        methods=methods,
+                                                        forces=[lj])
+        sim.run(20)
+        return sim.state.get_snapshot()
+
+    langevin = hoomd.md.methods.Langevin(filter=hoomd.filter.All(), kT=1.5)
+    langevin.gamma['A'] = 1.0
+    langevin.gamma['B'] = 2.0
+    single = run([langevin])
+
+    langevin_a = hoomd.md.methods.Langevin(filter=hoomd.filter.Type(['A']),
+                                           kT=1.5)
+    langevin_a.gamma['A'] = 1.0
+    langevin_a.gamma['B'] = 2.0
+    langevin_b = hoomd.md.methods.Langevin(filter=hoomd.filter.Type(['B']),
+                                           kT=1.5)
+    langevin_b.gamma['A'] = 1.0
+    langevin_b.gamma['B'] = 2.0
+    split = run([langevin_a, langevin_b])
+
+    if snap.communicator.rank == 0:
+        assert (single.particles.position == split.particles.position).all()
+        assert (single.particles.velocity == split.particles.velocity).all()
+
+
+def test_nvt_thermostat_dof_during_run(simulation_factory,
+                                       two_particle_snapshot_factory):
+    """NVT reports and accepts the thermostat state between runs.
+
+    On the GPU, the thermostat advances on the device during the run.
+    """
+    nvt = hoomd.md.methods.NVT(filter=hoomd.filter.All(), kT=2.0, tau=2.0)
+
+    sim = simulation_factory(two_particle_snapshot_factory())
+    sim.operations.integrator = hoomd.md.Integrator(0.005, methods=[nvt])
+    sim.run(10)
+
+    xi, eta = nvt.translational_thermostat_dof
+    assert xi != 0.0
+    assert eta != 0.0
+
+    nvt.translational_thermostat_dof = (0.25, 0.5)
+    assert nvt.translational_thermostat_dof == (0.25, 0.5)
+
+    sim.run(1)
+    xi, eta = nvt.translational_thermostat_dof
+    assert xi != 0.25
+    assert eta == pytest.approx(0.5 + 0.25 * 0.005, rel=1e-4)
+
+
+def test_brownian_update_velocities(simulation_factory,
+                                    two_particle_snapshot_factory):
+    """Brownian without velocity updates moves the same positions."""
+    snap = two_particle_snapshot_factory()
+
+    def run(update_velocities):
+        sim = simulation_factory(snap)
+        brownian = hoomd.md.methods.Brownian(
+            filter=hoomd.filter.All(),
+            kT=1.5,
+            update_velocities=update_velocities)
+        sim.operations.integrator = hoomd.md.Integrator(0.005,
+                                                        methods=[brownian])
+        sim.run(10)
+        assert brownian.update_velocities == update_velocities
+        return sim.state.get_snapshot()
+
+    updated = run(True)
+    lean = run(False)
+
+    if snap.communicator.rank == 0:
+        assert (updated.particles.position == lean.particles.position).all()
+        assert (lean.particles.velocity == snap.particles.velocity).all()
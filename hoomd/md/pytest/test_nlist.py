@@ -37,7 +37,9 @@ def test_common_params(nlist_params):
         "rebuild_check_delay": 1,
         "diameter_shift": False,
         "check_dist": True,
-        "max_diameter": 1.0
+        "max_diameter": 1.0,
+        "compressed": False,
+        "sort_by_type": False
     }
     _assert_nlist_params(nlist, default_params_dict)
     new_params_dict = {
@@ -55,7 +57,11 @@ def test_common_params(nlist_params):
         "check_dist":
             False,
         "max_diameter":
-            np.random.uniform(10.3)
+            np.random.uniform(10.3),
+        "compressed":
+            True,
+        "sort_by_type":
+            True
     }
     for param in new_params_dict.keys():
         setattr(nlist, param, new_params_dict[param])
@@ -64,9 +70,12 @@ def test_common_params(nlist_params):
 
 def test_cell_specific_params():
     nlist = Cell()
-    _assert_nlist_params(nlist, dict(deterministic=False))
+    _assert_nlist_params(nlist,
+                         dict(deterministic=False, incremental_fraction=0.0))
     nlist.deterministic = True
-    _assert_nlist_params(nlist, dict(deterministic=True))
+    nlist.incremental_fraction = 0.1
+    _assert_nlist_params(nlist,
+                         dict(deterministic=True, incremental_fraction=0.1))
 
 
 def test_stencil_specific_params():
@@ -80,6 +89,13 @@ def test_stencil_specific_params():
     _assert_nlist_params(nlist, dict(deterministic=True, cell_width=x))
 
 
+def test_tree_specific_params():
+    nlist = Tree()
+    _assert_nlist_params(nlist, dict(refit_threshold=0.0))
+    nlist.refit_threshold = 1.5
+    _assert_nlist_params(nlist, dict(refit_threshold=1.5))
+
+
 def test_simple_simulation(nlist_params, simulation_factory,
                            lattice_snapshot_factory):
     nlist_cls, required_args = nlist_params
@@ -98,6 +114,223 @@ def test_simple_simulation(nlist_params, simulation_factory,
     sim.run(2)
 
 
+def test_build_statistics(simulation_factory, lattice_snapshot_factory):
+    nlist = Cell(buffer=0.4)
+    lj = hoomd.md.pair.LJ(nlist, default_r_cut=1.1)
+    lj.params[('A', 'A')] = dict(epsilon=1, sigma=1)
+    integrator = hoomd.md.Integrator(0.005)
+    integrator.forces.append(lj)
+    integrator.methods.append(
+        hoomd.md.methods.Langevin(hoomd.filter.All(), kT=1))
+
+    sim = simulation_factory(lattice_snapshot_factory(n=10, a=1.2))
+    sim.operations.integrator = integrator
+    sim.run(20)
+
+    assert nlist.num_builds >= 1
+    assert nlist.num_dangerous_builds == 0
+    assert nlist.mean_rebuild_period == 20 / nlist.num_builds
+    assert nlist.max_neighbors >= 4
+    assert nlist.num_reallocations >= 0
+    assert nlist.mean_neighbors > 0
+
+    # statistics describe the current or last run
+    sim.run(1)
+    assert nlist.num_builds <= 1
+
+
+def test_stencil_mixture(simulation_factory, lattice_snapshot_factory):
+    """Compare Stencil to Cell for a mixture with very different cutoffs."""
+    snap = lattice_snapshot_factory(particle_types=['A', 'B', 'C'],
+                                    a=1.1,
+                                    n=10,
+                                    r=0.05)
+    if snap.communicator.rank == 0:
+        snap.particles.typeid[:] = np.arange(snap.particles.N) % 3
+
+    energies = []
+    for nlist in [Cell(), Stencil(cell_width=0.6)]:
+        lj = hoomd.md.pair.LJ(nlist, default_r_cut=1.2)
+        for pair in [('A', 'A'), ('A', 'B'), ('A', 'C'), ('B', 'B'),
+                     ('B', 'C'), ('C', 'C')]:
+            lj.params[pair] = dict(epsilon=1, sigma=1)
+        lj.r_cut[('A', 'A')] = 3.0
+        lj.r_cut[('A', 'C')] = 0.0
+        lj.r_cut[('C', 'C')] = 1.5
+        integrator = hoomd.md.Integrator(0.005)
+        integrator.forces.append(lj)
+
+        sim = simulation_factory(snap)
+        sim.operations.integrator = integrator
+        sim.run(0)
+        energies.append(lj.energy)
+
+    np.testing.assert_allclose(energies[0], energies[1], rtol=1e-6)
+
+
+def test_sort_by_type(simulation_factory, lattice_snapshot_factory):
+    """Sorting the neighbors by type does not change the forces."""
+    snap = lattice_snapshot_factory(particle_types=['A', 'B', 'C'],
+                                    a=1.1,
+                                    n=10,
+                                    r=0.05)
+    if snap.communicator.rank == 0:
+        snap.particles.typeid[:] = np.arange(snap.particles.N) % 3
+
+    energies = []
+    forces = []
+    for sort_by_type in [False, True]:
+        nlist = Cell()
+        nlist.sort_by_type = sort_by_type
+        lj = hoomd.md.pair.LJ(nlist, default_r_cut=1.2)
+        for pair, epsilon in [(('A', 'A'), 1.0), (('A', 'B'), 0.5),
+                              (('A', 'C'), 1.5), (('B', 'B'), 2.0),
+                              (('B', 'C'), 0.8), (('C', 'C'), 1.2)]:
+            lj.params[pair] = dict(epsilon=epsilon, sigma=1)
+        lj.r_cut[('A', 'A')] = 3.0
+        lj.r_cut[('C', 'C')] = 1.5
+        integrator = hoomd.md.Integrator(0.005)
+        integrator.forces.append(lj)
+
+        sim = simulation_factory(snap)
+        sim.operations.integrator = integrator
+        sim.run(0)
+        energies.append(lj.energy)
+        forces.append(lj.forces)
+
+    np.testing.assert_allclose(energies[0], energies[1], rtol=1e-6)
+    if snap.communicator.rank == 0:
+        np.testing.assert_allclose(forces[0], forces[1], rtol=1e-6, atol=1e-8)
+
+
+@pytest.mark.gpu
+@pytest.mark.serial
+def test_compressed(simulation_factory, lattice_snapshot_factory, device):
+    """The compressed neighbor list gives the same forces as the full list."""
+    n = 33
+    snap = lattice_snapshot_factory(n=n, a=1.1, r=0.05)
+
+    # shuffle the particles and disable sorting so that many neighbor index
+    # deltas do not fit in 16 bits
+    rng = np.random.default_rng(12)
+    perm = rng.permutation(n**3)
+    if snap.communicator.rank == 0:
+        assert snap.particles.N > 32768
+        snap.particles.position[:] = snap.particles.position[perm]
+
+        site = np.array(np.unravel_index(perm, (n, n, n))).T
+        neighbor_site = np.ravel_multi_index(((site + [1, 0, 0]) % n).T,
+                                             (n, n, n))
+        inverse = np.argsort(perm)
+        delta = inverse[neighbor_site] - np.arange(n**3)
+        assert np.any(np.abs(delta) >= 32768)
+
+    energies = []
+    forces = []
+    virials = []
+    for compressed in [False, True]:
+        nlist = Cell()
+        nlist.compressed = compressed
+        lj = hoomd.md.pair.LJ(nlist, default_r_cut=1.2)
+        lj.params[('A', 'A')] = dict(epsilon=1, sigma=1)
+        integrator = hoomd.md.Integrator(0.005)
+        integrator.forces.append(lj)
+
+        sim = simulation_factory(snap)
+        sim.operations.tuners.clear()
+        sim.operations.integrator = integrator
+        sim.always_compute_pressure = True
+        sim.run(0)
+        energies.append(lj.energies)
+        forces.append(lj.forces)
+        virials.append(lj.virials)
+
+    # the autotuned threads per particle may change the summation order
+    np.testing.assert_allclose(forces[0], forces[1], rtol=1e-5, atol=1e-6)
+    np.testing.assert_allclose(energies[0], energies[1], rtol=1e-5, atol=1e-6)
+    np.testing.assert_allclose(virials[0], virials[1], rtol=1e-5, atol=1e-6)
+
+
+def test_deterministic_run(simulation_factory, lattice_snapshot_factory):
+    """Repeated runs with a deterministic neighbor list agree bitwise."""
+    snap = lattice_snapshot_factory(n=10, a=1.1, r=0.05)
+
+    positions = []
+    for i in range(2):
+        nlist = Cell(deterministic=True)
+        lj = hoomd.md.pair.LJ(nlist, default_r_cut=2.5)
+        lj.params[('A', 'A')] = dict(epsilon=1, sigma=1)
+        integrator = hoomd.md.Integrator(0.005)
+        integrator.forces.append(lj)
+        integrator.methods.append(
+            hoomd.md.methods.Langevin(hoomd.filter.All(), kT=1))
+
+        sim = simulation_factory(snap)
+        sim.operations.integrator = integrator
+        sim.run(50)
+        s = sim.state.get_snapshot()
+        if s.communicator.rank == 0:
+            positions.append(s.particles.position)
+
+    if snap.communicator.rank == 0:
+        np.testing.assert_array_equal(positions[0], positions[1])
+
+
+def test_incremental_simulation(simulation_factory, lattice_snapshot_factory):
+    nlist = Cell(incremental_fraction=0.5)
+    lj = hoomd.md.pair.LJ(nlist, default_r_cut=1.1)
+    lj.params[('A', 'A')] = dict(epsilon=1, sigma=1)
+    lj.params[('A', 'B')] = dict(epsilon=1, sigma=1)
+    lj.params[('B', 'B')] = dict(epsilon=1, sigma=1)
+    integrator = hoomd.md.Integrator(0.005)
+    integrator.forces.append(lj)
+    integrator.methods.append(
+        hoomd.md.methods.Langevin(hoomd.filter.All(), kT=1))
+
+    sim = simulation_factory(lattice_snapshot_factory(n=10))
+    sim.operations.integrator = integrator
+    sim.run(20)
+    assert nlist.incremental_fraction == 0.5
+
+
+def test_tree_refit(simulation_factory, lattice_snapshot_factory):
+    """Compare a refitted Tree to Cell after the particles have moved."""
+    snap = lattice_snapshot_factory(particle_types=['A', 'B'],
+                                    a=1.1,
+                                    n=10,
+                                    r=0.05)
+    if snap.communicator.rank == 0:
+        snap.particles.typeid[:] = np.arange(snap.particles.N) % 2
+
+    nlist = Tree(refit_threshold=1.5)
+    lj = hoomd.md.pair.LJ(nlist, default_r_cut=1.2)
+    lj.params[('A', 'A')] = dict(epsilon=1, sigma=1)
+    lj.params[('A', 'B')] = dict(epsilon=1, sigma=1)
+    lj.params[('B', 'B')] = dict(epsilon=1, sigma=1)
+    integrator = hoomd.md.Integrator(0.005)
+    integrator.forces.append(lj)
+    integrator.methods.append(
+        hoomd.md.methods.Langevin(hoomd.filter.All(), kT=1))
+
+    sim = simulation_factory(snap)
+    sim.operations.integrator = integrator
+    sim.run(50)
+    energy = lj.energy
+
+    lj_cell = hoomd.md.pair.LJ(Cell(), default_r_cut=1.2)
+    lj_cell.params[('A', 'A')] = dict(epsilon=1, sigma=1)
+    lj_cell.params[('A', 'B')] = dict(epsilon=1, sigma=1)
+    lj_cell.params[('B', 'B')] = dict(epsilon=1, sigma=1)
+    integrator_cell = hoomd.md.Integrator(0.005)
+    integrator_cell.forces.append(lj_cell)
+
+    sim_cell = simulation_factory(sim.state.get_snapshot())
+    sim_cell.operations.integrator = integrator_cell
+    sim_cell.run(0)
+
+    np.testing.assert_allclose(energy, lj_cell.energy, rtol=1e-5)
+
+
 def test_auto_detach_simulation(simulation_factory,
                                 two_particle_snapshot_factory):
     nlist = Cell()
@@ -120,3 +353,105 @@ def test_auto_detach_simulation(simulation_factory,
     del integrator.forces[0]
     assert not nlist._attached
     assert nlist._cpp_obj is None
+
+
+def test_local_nlist_arrays(simulation_factory, two_particle_snapshot_factory):
+    nlist = Cell()
+    lj = hoomd.md.pair.LJ(nlist, default_r_cut=1.1)
+    lj.params[('A', 'A')] = dict(epsilon=1, sigma=1)
+    lj.params[('A', 'B')] = dict(epsilon=1, sigma=1)
+    lj.params[('B', 'B')] = dict(epsilon=1, sigma=1)
+    integrator = hoomd.md.Integrator(0.005, forces=[lj])
+
+    sim = simulation_factory(two_particle_snapshot_factory(d=1.0))
+    sim.operations.integrator = integrator
+    with pytest.raises(hoomd.error.DataAccessError):
+        nlist.cpu_local_nlist_arrays
+
+    sim.run(0)
+    with nlist.cpu_local_nlist_arrays as data:
+        head_list = np.array(data.head_list, copy=True)
+        n_neigh = np.array(data.n_neigh, copy=True)
+        neighbors = [
+            np.array(data.nlist[head:head + n], copy=True)
+            for head, n in zip(head_list, n_neigh)
+        ]
+        half_nlist = data.half_nlist
+        n_neigh_array = data.n_neigh
+        assert data.nlist.read_only
+        with pytest.raises(ValueError):
+            data.n_neigh[:] = 0
+
+    with pytest.raises(hoomd.data.array.HOOMDArrayError):
+        n_neigh_array[0]
+
+    if sim.device.communicator.num_ranks == 1:
+        assert len(n_neigh) == 2
+        assert n_neigh.sum() == (1 if half_nlist else 2)
+        for i, neighbors_i in enumerate(neighbors):
+            assert all(j == 1 - i for j in neighbors_i)
+
+
+def test_set_snapshot_in_place(simulation_factory, lattice_snapshot_factory):
+    """Check forces after State.set_snapshot updates the particles in place."""
+
+    def make_integrator():
+        lj = hoomd.md.pair.LJ(Cell(), default_r_cut=1.2)
+        lj.params[('A', 'A')] = dict(epsilon=1, sigma=1)
+        return hoomd.md.Integrator(0.005, forces=[lj]), lj
+
+    sim = simulation_factory(lattice_snapshot_factory(a=1.1, n=6))
+    sim.operations.integrator, lj = make_integrator()
+    sim.run(0)
+    energy = lj.energy
+
+    # new velocities do not change the forces
+    snap = sim.state.get_snapshot()
+    if snap.communicator.rank == 0:
+        snap.particles.velocity[:] = [1, 2, 3]
+    sim.state.set_snapshot(snap)
+    np.testing.assert_allclose(lj.energy, energy, rtol=1e-5)
+
+    # particles moved further than the buffer are found at the same step
+    snap = sim.state.get_snapshot()
+    if snap.communicator.rank == 0:
+        snap.particles.position[:] *= 0.9
+    sim.state.set_snapshot(snap)
+    energy = lj.energy
+
+    sim_new = simulation_factory(snap)
+    sim_new.operations.integrator, lj_new = make_integrator()
+    sim_new.run(0)
+    np.testing.assert_allclose(energy, lj_new.energy, rtol=1e-5)
+
+
+def test_read_only_local_snapshot(simulation_factory,
+                                  lattice_snapshot_factory):
+    """Reading a local snapshot does not force a migration or a build.
+
+    The particles do not move, so the neighbor list is only built at the start
+    of the run. In MPI simulations, every migration sorts the particles, which
+    also forces a build.
+    """
+
+    class Reader(hoomd.custom.Action):
+
+        def act(self, timestep):
+            with self._state.cpu_local_snapshot as data:
+                self.position = np.array(data.particles.position)
+                self.velocity = np.array(data.particles.velocity)
+
+    def num_builds(read):
+        nlist = Cell(buffer=0.4)
+        lj = hoomd.md.pair.LJ(nlist, default_r_cut=1.2)
+        lj.params[('A', 'A')] = dict(epsilon=1, sigma=1)
+        sim = simulation_factory(lattice_snapshot_factory(a=1.1, n=6))
+        sim.operations.integrator = hoomd.md.Integrator(0.005, forces=[lj])
+        if read:
+            sim.operations.writers.append(
+                hoomd.write.CustomWriter(action=Reader(),
+                                         trigger=hoomd.trigger.Periodic(1)))
+        sim.run(10)
+        return nlist.num_builds
+
+    assert num_builds(read=True) == num_builds(read=False)
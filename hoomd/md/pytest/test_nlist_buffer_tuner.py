@@ -0,0 +1,66 @@
+import hoomd
+import pytest
+from hoomd.md.tune import NeighborListBuffer
+
+
+@pytest.fixture
+def simulation(simulation_factory, lattice_snapshot_factory):
+    sim = simulation_factory(lattice_snapshot_factory(n=10, a=1.2))
+    nlist = hoomd.md.nlist.Cell(buffer=0.4)
+    lj = hoomd.md.pair.LJ(nlist, default_r_cut=2.5)
+    lj.params[('A', 'A')] = dict(epsilon=1, sigma=1)
+    integrator = hoomd.md.Integrator(0.005)
+    integrator.forces.append(lj)
+    integrator.methods.append(
+        hoomd.md.methods.Langevin(hoomd.filter.All(), kT=1))
+    sim.operations.integrator = integrator
+    return sim
+
+
+def test_attributes(simulation):
+    nlist = simulation.operations.integrator.forces[0].nlist
+    tuner = NeighborListBuffer(trigger=hoomd.trigger.Periodic(10),
+                               nlist=nlist,
+                               maximum_buffer=1.0)
+    assert tuner.nlist is nlist
+    assert tuner.maximum_buffer == 1.0
+    assert tuner.step == 0.1
+    assert tuner.tol == 0.01
+    assert not tuner.tuned
+
+    tuner.step = 0.2
+    assert tuner.step == 0.2
+
+
+def test_requires_md_integrator(simulation_factory, lattice_snapshot_factory):
+    sim = simulation_factory(lattice_snapshot_factory())
+    sim.operations.integrator = hoomd.hpmc.integrate.Sphere()
+    sim.operations.integrator.shape['A'] = dict(diameter=0.5)
+    tuner = NeighborListBuffer(trigger=hoomd.trigger.Periodic(10),
+                               nlist=hoomd.md.nlist.Cell(buffer=0.4),
+                               maximum_buffer=1.0)
+    sim.operations.tuners.append(tuner)
+    with pytest.raises(RuntimeError):
+        sim.run(0)
+
+
+def test_tuning(simulation):
+    nlist = simulation.operations.integrator.forces[0].nlist
+    tuner = NeighborListBuffer(trigger=hoomd.trigger.Periodic(10),
+                               nlist=nlist,
+                               maximum_buffer=0.8,
+                               step=0.2,
+                               tol=0.05)
+    simulation.operations.tuners.append(tuner)
+
+    # the step halves after every trial that does not improve, so the search
+    # ends within a bounded number of triggers
+    simulation.run(500)
+    assert tuner.tuned
+    assert 0 <= nlist.buffer <= 0.8
+    assert tuner.best_cost > 0
+
+    # a tuned tuner no longer changes the buffer
+    buffer = nlist.buffer
+    simulation.run(50)
+    assert nlist.buffer == buffer
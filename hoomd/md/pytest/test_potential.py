@@ -122,6 +122,277 @@ def test_ron(simulation_factory, two_particle_snapshot_factory):
     assert _equivalent_data_structures({('A', 'A'): 1.0}, lj.r_on.to_dict())
 
 
+def test_param_variant(simulation_factory, two_particle_snapshot_factory):
+    lj = md.pair.LJ(nlist=md.nlist.Cell(), default_r_cut=2.5)
+    lj.params[('A', 'A')] = {'sigma': 1, 'epsilon': 1}
+    lj.set_param_variant(('A', 'A'), 'epsilon',
+                         hoomd.variant.Ramp(A=1, B=2, t_start=0, t_ramp=10))
+    with pytest.raises(TypeError):
+        lj.set_param_variant(('A', 'A'), 'sigma', 1.5)
+
+    sim = simulation_factory(two_particle_snapshot_factory(dimensions=3, d=1.5))
+    sim.operations.integrator = md.Integrator(dt=0.005, forces=[lj])
+    sim.run(0)
+    energy = lj.energy
+
+    # the particles do not move, the energy is proportional to epsilon
+    sim.run(5)
+    assert lj.params[('A', 'A')]['epsilon'] == pytest.approx(1.5)
+    assert lj.params[('A', 'A')]['sigma'] == pytest.approx(1)
+    np.testing.assert_allclose(lj.energy, 1.5 * energy, rtol=1e-5)
+
+    # parameters set from Python apply to the parameters not in the variant
+    lj.params[('A', 'A')] = {'sigma': 1.1, 'epsilon': 1}
+    sim.run(1)
+    assert lj.params[('A', 'A')]['epsilon'] == pytest.approx(1.6)
+    assert lj.params[('A', 'A')]['sigma'] == pytest.approx(1.1)
+
+    lj.set_param_variant(('A', 'A'), 'epsilon', None)
+    assert lj.params[('A', 'A')]['epsilon'] == pytest.approx(1)
+
+    with pytest.raises(RuntimeError):
+        lj.set_param_variant(('A', 'A'), 'r_cut', hoomd.variant.Constant(1))
+
+
+def test_dpd_half_kernel(simulation_factory, lattice_snapshot_factory):
+    """DPD forces agree with and without a deterministic neighbor list.
+
+    On the GPU, the deterministic neighbor list selects the kernel that
+    evaluates each pair once.
+    """
+    snap = lattice_snapshot_factory(n=6, a=0.9, r=0.1)
+    if snap.communicator.rank == 0:
+        rng = np.random.default_rng(7)
+        snap.particles.velocity[:] = rng.normal(size=(snap.particles.N, 3))
+
+    forces = []
+    energies = []
+    for deterministic in (False, True):
+        dpd = md.pair.DPD(nlist=md.nlist.Cell(deterministic=deterministic),
+                          kT=1.0,
+                          default_r_cut=1.0)
+        dpd.params[('A', 'A')] = dict(A=25.0, gamma=4.5)
+        sim = simulation_factory(snap)
+        sim.operations.integrator = md.Integrator(dt=0.005, forces=[dpd])
+        sim.run(0)
+        forces.append(dpd.forces)
+        energies.append(dpd.energy)
+
+    np.testing.assert_allclose(energies[0], energies[1], rtol=1e-5)
+    if snap.communicator.rank == 0:
+        np.testing.assert_allclose(forces[0], forces[1], rtol=1e-4, atol=1e-5)
+
+
+@pytest.mark.gpu
+@pytest.mark.parametrize("mode", ['none', 'shift', 'xplor'])
+@pytest.mark.parametrize("threads_per_particle", [1, 4])
+def test_cell_kernel(simulation_factory, lattice_snapshot_factory, mode,
+                     threads_per_particle):
+    """The cell list kernel matches the neighbor list kernel.
+
+    The tuning parameter encodes kernel * 100000000 + block_size * 10000 +
+    threads_per_particle with kernel 0 (full) or 2 (cell).
+    """
+    snap = lattice_snapshot_factory(n=8, a=1.1, r=0.2)
+
+    def compute(kernel):
+        lj = md.pair.LJ(nlist=md.nlist.Cell(), default_r_cut=2.5, mode=mode)
+        lj.params[('A', 'A')] = dict(sigma=1.0, epsilon=1.0)
+        lj.r_on[('A', 'A')] = 2.0
+        sim = simulation_factory(snap)
+        sim.always_compute_pressure = True
+        sim.operations.integrator = md.Integrator(dt=0.005, forces=[lj])
+        sim.run(0)
+        lj._cpp_obj.setTuningParam(kernel * 100000000 + 128 * 10000
+                                   + threads_per_particle)
+        sim.run(1)
+        return lj.forces, lj.energies, lj.virials
+
+    full = compute(0)
+    cell = compute(2)
+
+    if snap.communicator.rank == 0:
+        for f, c in zip(full, cell):
+            np.testing.assert_allclose(c, f, rtol=1e-5, atol=1e-6)
+
+
+def test_compact_positions(simulation_factory, lattice_snapshot_factory):
+    """LJ forces agree with and without compact positions."""
+    snap = lattice_snapshot_factory(n=6, a=1.1, r=0.1)
+
+    forces = []
+    energies = []
+    for compact_positions in (False, True):
+        lj = md.pair.LJ(nlist=md.nlist.Cell(), default_r_cut=2.5)
+        lj.params[('A', 'A')] = dict(sigma=1.0, epsilon=1.0)
+        assert not lj.compact_positions
+        lj.compact_positions = compact_positions
+        sim = simulation_factory(snap)
+        sim.operations.integrator = md.Integrator(dt=0.005, forces=[lj])
+        sim.run(0)
+        assert lj.compact_positions == compact_positions
+        forces.append(lj.forces)
+        energies.append(lj.energy)
+
+    np.testing.assert_allclose(energies[0], energies[1], rtol=1e-5)
+    if snap.communicator.rank == 0:
+        np.testing.assert_allclose(forces[0], forces[1], rtol=1e-4, atol=1e-4)
+
+
+def _evaluator_rtol():
+    """Relative tolerance of forces evaluated at the build's precision.
+
+    Builds with ENABLE_MD_MIXED_PRECISION evaluate the common pair and bond
+    potentials in single precision, and ENABLE_MD_FAST_MATH evaluates their
+    transcendental functions in single precision.
+    """
+    flags = hoomd.version.compile_flags.split()
+    if {'SINGLE', 'MD_MIXED', 'MD_FAST_MATH'}.intersection(flags):
+        return 1e-5
+    return 1e-10
+
+
+def _lj_force(r, epsilon, sigma):
+    return 24 * epsilon / r * (2 * (sigma / r)**12 - (sigma / r)**6)
+
+
+def _lj_energy(r, epsilon, sigma):
+    return 4 * epsilon * ((sigma / r)**12 - (sigma / r)**6)
+
+
+def _gauss_force(r, epsilon, sigma):
+    return epsilon * r / sigma**2 * math.exp(-r**2 / (2 * sigma**2))
+
+
+def _gauss_energy(r, epsilon, sigma):
+    return epsilon * math.exp(-r**2 / (2 * sigma**2))
+
+
+def _yukawa_force(r, epsilon, kappa):
+    return epsilon * math.exp(-kappa * r) * (1 + kappa * r) / r**2
+
+
+def _yukawa_energy(r, epsilon, kappa):
+    return epsilon * math.exp(-kappa * r) / r
+
+
+def _force_shifted_lj_force(r, epsilon, sigma, r_cut=2.5):
+    return _lj_force(r, epsilon, sigma) - _lj_force(r_cut, epsilon, sigma)
+
+
+def _force_shifted_lj_energy(r, epsilon, sigma, r_cut=2.5):
+    return _lj_energy(r, epsilon, sigma) + (r - r_cut) * _lj_force(
+        r_cut, epsilon, sigma)
+
+
+@pytest.mark.parametrize(
+    "pair_cls, params, force, energy",
+    [(md.pair.LJ, dict(epsilon=1.5, sigma=0.9), _lj_force, _lj_energy),
+     (md.pair.Gauss, dict(epsilon=1.5, sigma=0.9), _gauss_force,
+      _gauss_energy),
+     (md.pair.Yukawa, dict(epsilon=1.5, kappa=0.8), _yukawa_force,
+      _yukawa_energy),
+     (md.pair.ForceShiftedLJ, dict(epsilon=1.5, sigma=0.9),
+      _force_shifted_lj_force, _force_shifted_lj_energy)],
+    ids=['LJ', 'Gauss', 'Yukawa', 'ForceShiftedLJ'])
+@pytest.mark.parametrize("r", [0.85, 1.3, 2.2])
+def test_evaluator_precision(simulation_factory, two_particle_snapshot_factory,
+                             pair_cls, params, force, energy, r):
+    """Pair forces match the double precision result within the precision."""
+    rtol = _evaluator_rtol()
+    pair = pair_cls(nlist=md.nlist.Cell(), default_r_cut=2.5)
+    pair.params[('A', 'A')] = params
+    sim = simulation_factory(two_particle_snapshot_factory(d=r))
+    sim.operations.integrator = md.Integrator(dt=0.005, forces=[pair])
+    sim.run(0)
+
+    np.testing.assert_allclose(pair.energy, energy(r, **params), rtol=rtol)
+    forces = pair.forces
+    if sim.device.communicator.rank == 0:
+        np.testing.assert_allclose(forces[1], [force(r, **params), 0, 0],
+                                   rtol=rtol,
+                                   atol=1e-12)
+        np.testing.assert_allclose(forces[0], -forces[1], rtol=rtol)
+
+
+@pytest.mark.parametrize("r", [0.8, 1.2])
+def test_evaluator_precision_bond(simulation_factory,
+                                  two_particle_snapshot_factory, r):
+    """Harmonic bond forces match the double precision result."""
+    rtol = _evaluator_rtol()
+    snap = two_particle_snapshot_factory(d=r)
+    if snap.communicator.rank == 0:
+        snap.bonds.types = ['bond']
+        snap.bonds.N = 1
+        snap.bonds.group[0] = [0, 1]
+    harmonic = md.bond.Harmonic()
+    harmonic.params['bond'] = dict(k=30.0, r0=1.0)
+    sim = simulation_factory(snap)
+    sim.operations.integrator = md.Integrator(dt=0.005, forces=[harmonic])
+    sim.run(0)
+
+    np.testing.assert_allclose(harmonic.energy,
+                               15.0 * (r - 1.0)**2,
+                               rtol=rtol)
+    forces = harmonic.forces
+    if sim.device.communicator.rank == 0:
+        np.testing.assert_allclose(forces[1], [-30.0 * (r - 1.0), 0, 0],
+                                   rtol=rtol,
+                                   atol=1e-12)
+
+
+@pytest.mark.cpu
+@pytest.mark.skipif(not hoomd.version.tbb_enabled,
+                    reason="TBB is required for concurrent force computes")
+@pytest.mark.parametrize("storage_mode", ['half', 'full'])
+@pytest.mark.parametrize("compute_pressure", [False, True])
+def test_concurrent_pair_forces(device, simulation_factory,
+                                lattice_snapshot_factory, storage_mode,
+                                compute_pressure):
+    """Pair and bond forces on several threads match a serial compute."""
+    snap = lattice_snapshot_factory(n=6, a=1.1, r=0.1)
+    if snap.communicator.rank == 0:
+        snap.bonds.types = ['bond']
+        snap.bonds.N = snap.particles.N - 1
+        snap.bonds.group[:] = [[i, i + 1] for i in range(snap.bonds.N)]
+
+    def compute(num_cpu_threads):
+        device.num_cpu_threads = num_cpu_threads
+        lj = md.pair.LJ(nlist=md.nlist.Cell(), default_r_cut=2.5)
+        lj.params[('A', 'A')] = dict(sigma=1.0, epsilon=1.0)
+        harmonic = md.bond.Harmonic()
+        harmonic.params['bond'] = dict(k=10.0, r0=1.1)
+        sim = simulation_factory(snap)
+        sim.always_compute_pressure = compute_pressure
+        sim.operations.integrator = md.Integrator(dt=0.005,
+                                                  forces=[lj, harmonic])
+        sim.run(0)
+        # pair potentials attach with a half neighbor list on the CPU
+        if storage_mode == 'full':
+            lj.nlist._cpp_obj.setStorageMode(
+                hoomd.md._md.NeighborList.storageMode.full)
+        sim.run(1)
+        return [(f.forces, f.energy, f.virials) for f in (lj, harmonic)]
+
+    num_cpu_threads = device.num_cpu_threads
+    serial = compute(1)
+    concurrent = compute(4)
+    device.num_cpu_threads = num_cpu_threads
+
+    for (s_forces, s_energy, s_virials), (c_forces, c_energy,
+                                          c_virials) in zip(serial, concurrent):
+        np.testing.assert_allclose(c_energy, s_energy, rtol=1e-6)
+        if snap.communicator.rank == 0:
+            np.testing.assert_allclose(c_forces, s_forces, rtol=1e-6, atol=1e-8)
+            if compute_pressure:
+                np.testing.assert_allclose(c_virials,
+                                           s_virials,
+                                           rtol=1e-6,
+                                           atol=1e-8)
+            else:
+                assert c_virials is None and s_virials is None
+
+
 def _make_invalid_param_dict(valid_dict):
     """This could is fragile if multiple types are allowed for a key."""
     invalid_dicts = [valid_dict] * len(valid_dict.keys()) * 2
@@ -1100,3 +1371,40 @@ def test_pickling(simulation_factory, two_particle_snapshot_factory,
     sim.operations.integrator = integrator
     sim.run(0)
     pickling_check(pot)
+
+
+@pytest.mark.parametrize("interpolation", ['linear', 'cubic'])
+def test_table_interpolation(simulation_factory, two_particle_snapshot_factory,
+                             interpolation):
+    """Test that Table interpolates a coarse Lennard-Jones table."""
+
+    def lj_energy(r):
+        return 4 * (r**-12 - r**-6)
+
+    def lj_force(r):
+        return 4 * (12 * r**-13 - 6 * r**-7)
+
+    r_min = 0.9
+    r_cut = 2.5
+    r = np.linspace(r_min, r_cut, 16, endpoint=False)
+
+    table = md.pair.Table(nlist=md.nlist.Cell(), default_r_cut=r_cut)
+    table.params[('A', 'A')] = dict(r_min=r_min,
+                                    V=lj_energy(r),
+                                    F=lj_force(r),
+                                    interpolation=interpolation)
+    assert table.params[('A', 'A')]['interpolation'] == interpolation
+
+    d = 1.47
+    sim = simulation_factory(two_particle_snapshot_factory(d=d))
+    sim.operations.integrator = md.Integrator(dt=0.005, forces=[table])
+    sim.run(0)
+
+    energy = table.energy
+    forces = table.forces
+    if sim.device.communicator.rank == 0:
+        # the cubic error is two orders of magnitude smaller at this spacing
+        rtol = 1e-4 if interpolation == 'cubic' else 2e-2
+        np.testing.assert_allclose(energy, lj_energy(d), rtol=rtol)
+        np.testing.assert_allclose(abs(forces[0][0]), abs(lj_force(d)),
+                                   rtol=10 * rtol)
@@ -140,3 +140,35 @@ def test_pppm_energy(simulation_factory, two_charged_particle_snapshot_factory):
     # The reference energy is from a LAMMPS simulation. The tolerance is large
     # as the PPPM parameters do not directly map between the two codes
     numpy.testing.assert_allclose(energy, -1.0021254, rtol=1e-2)
+
+
+def test_tune_coulomb_parameters(simulation_factory,
+                                 two_charged_particle_snapshot_factory):
+    """Test that md.long_range.pppm.tune_coulomb_parameters selects one of the
+    candidates and that the selected parameters reach the accuracy."""
+    nlist = hoomd.md.nlist.Cell()
+    sim = simulation_factory(two_charged_particle_snapshot_factory())
+    integrator = hoomd.md.Integrator(dt=0.005)
+    nve = hoomd.md.methods.NVE(filter=hoomd.filter.All())
+    integrator.methods.append(nve)
+    sim.operations.integrator = integrator
+
+    params = hoomd.md.long_range.pppm.tune_coulomb_parameters(sim,
+                                                              nlist,
+                                                              accuracy=1e-3,
+                                                              r_cut=[2.0, 3.0],
+                                                              order=[5, 6],
+                                                              steps=2)
+
+    assert params['r_cut'] in [2.0, 3.0]
+    assert params['order'] in [5, 6]
+    assert len(params['resolution']) == 3
+    assert len(integrator.forces) == 0
+
+    ewald, coulomb = hoomd.md.long_range.pppm.make_pppm_coulomb_forces(
+        nlist=nlist, **params)
+    integrator.forces.extend([ewald, coulomb])
+    sim.run(0)
+
+    energy = ewald.energy + coulomb.energy
+    numpy.testing.assert_allclose(energy, -1.0021254, rtol=1e-2)
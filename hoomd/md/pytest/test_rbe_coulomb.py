@@ -0,0 +1,131 @@
+import hoomd
+from hoomd.conftest import pickling_check
+import pytest
+import numpy
+
+
+@pytest.fixture(scope='session')
+def two_charged_particle_snapshot_factory(two_particle_snapshot_factory):
+    """Make a snapshot with two charged particles."""
+
+    def make_snapshot(particle_types=['A'], dimensions=3, d=1, L=20, q=1):
+        """Make the snapshot.
+
+        Args:
+            particle_types: List of particle type names
+            dimensions: Number of dimensions (2 or 3)
+            d: Distance apart to place particles
+            L: Box length
+            q: Particle charge
+        """
+        s = two_particle_snapshot_factory(particle_types=particle_types,
+                                          dimensions=dimensions,
+                                          d=d,
+                                          L=L)
+
+        if s.communicator.rank == 0:
+            s.particles.charge[0] = -q
+            s.particles.charge[1] = q
+        return s
+
+    return make_snapshot
+
+
+def test_attach_detach(simulation_factory,
+                       two_charged_particle_snapshot_factory):
+    """Ensure that md.long_range.rbe.Coulomb can be attached.
+
+    Also test that parameters can be set.
+    """
+    # detached
+    nlist = hoomd.md.nlist.Cell()
+    ewald, coulomb = hoomd.md.long_range.rbe.make_rbe_coulomb_forces(
+        nlist=nlist, kappa=1.0, batch_size=100, r_cut=3.0, alpha=0)
+
+    assert ewald.nlist is nlist
+    assert coulomb.nlist is nlist
+    assert coulomb.kappa == 1.0
+    assert coulomb.batch_size == 100
+    assert coulomb.alpha == 0
+
+    coulomb.kappa = 1.2
+    assert coulomb.kappa == 1.2
+
+    coulomb.batch_size = 200
+    assert coulomb.batch_size == 200
+
+    coulomb.alpha = 1.5
+    assert coulomb.alpha == 1.5
+
+    # attached
+    sim = simulation_factory(two_charged_particle_snapshot_factory())
+    integrator = hoomd.md.Integrator(dt=0.005)
+    nve = hoomd.md.methods.NVE(filter=hoomd.filter.All())
+    integrator.methods.append(nve)
+    integrator.forces.extend([ewald, coulomb])
+    sim.operations.integrator = integrator
+
+    sim.run(0)
+
+    assert ewald._attached
+    assert coulomb._attached
+
+    assert coulomb.kappa == 1.2
+    assert coulomb.batch_size == 200
+    assert coulomb.alpha == 1.5
+
+    assert ewald.params[('A', 'A')]['kappa'] == 1.2
+    assert ewald.params[('A', 'A')]['alpha'] == 1.5
+
+    with pytest.raises(AttributeError):
+        coulomb.kappa = 1.0
+    with pytest.raises(AttributeError):
+        coulomb.batch_size = 100
+    with pytest.raises(AttributeError):
+        coulomb.alpha = 3.0
+
+
+def test_pickling(simulation_factory, two_charged_particle_snapshot_factory):
+    """Test that md.long_range.rbe.Coulomb can be pickled and unpickled."""
+    # detached
+    nlist = hoomd.md.nlist.Cell()
+    ewald, coulomb = hoomd.md.long_range.rbe.make_rbe_coulomb_forces(
+        nlist=nlist, kappa=1.0, batch_size=100, r_cut=3.0)
+    pickling_check(coulomb)
+
+    # attached
+    sim = simulation_factory(two_charged_particle_snapshot_factory())
+    integrator = hoomd.md.Integrator(dt=0.005)
+    nve = hoomd.md.methods.NVE(filter=hoomd.filter.All())
+    integrator.methods.append(nve)
+    integrator.forces.extend([ewald, coulomb])
+    sim.operations.integrator = integrator
+
+    sim.run(0)
+
+    assert ewald._attached
+    assert coulomb._attached
+
+    pickling_check(coulomb)
+
+
+def test_rbe_energy(simulation_factory, two_charged_particle_snapshot_factory):
+    """Test that md.long_range.rbe.Coulomb estimates the correct energy."""
+    nlist = hoomd.md.nlist.Cell()
+    ewald, coulomb = hoomd.md.long_range.rbe.make_rbe_coulomb_forces(
+        nlist=nlist, kappa=1.0, batch_size=4000, r_cut=3.0)
+
+    sim = simulation_factory(two_charged_particle_snapshot_factory())
+    integrator = hoomd.md.Integrator(dt=0.005)
+    nve = hoomd.md.methods.NVE(filter=hoomd.filter.All())
+    integrator.methods.append(nve)
+    integrator.forces.extend([ewald, coulomb])
+    sim.operations.integrator = integrator
+
+    sim.run(0)
+
+    energy = ewald.energy + coulomb.energy
+
+    # The reference energy is the same LAMMPS result as in the PPPM test. The
+    # standard deviation of the estimate is about 0.4% with this batch size.
+    numpy.testing.assert_allclose(energy, -1.0021254, rtol=2e-2)
@@ -0,0 +1,45 @@
+import hoomd
+import pytest
+
+
+def test_before_attaching():
+    kT = hoomd.variant.Constant(1.0)
+    trigger = hoomd.trigger.Periodic(100)
+    replica_exchange = hoomd.md.update.ReplicaExchange(trigger=trigger,
+                                                       kT=kT,
+                                                       kT_ladder=[1.5])
+    assert replica_exchange.trigger is trigger
+    assert replica_exchange.kT is kT
+    assert list(replica_exchange.kT_ladder) == [1.5]
+
+
+def test_single_partition(simulation_factory, two_particle_snapshot_factory):
+    sim = simulation_factory(two_particle_snapshot_factory())
+    kT = hoomd.variant.Constant(1.0)
+    langevin = hoomd.md.methods.Langevin(filter=hoomd.filter.All(), kT=kT)
+    sim.operations.integrator = hoomd.md.Integrator(0.005, methods=[langevin])
+
+    replica_exchange = hoomd.md.update.ReplicaExchange(
+        trigger=hoomd.trigger.Periodic(10), kT=kT, kT_ladder=[1.5])
+    sim.operations.updaters.append(replica_exchange)
+    sim.run(20)
+
+    # with one partition, the replica takes the only slot of the ladder
+    assert replica_exchange.slot == 0
+    assert replica_exchange.acceptance == []
+    assert kT.value == 1.5
+    assert langevin.kT(sim.timestep) == 1.5
+
+
+def test_ladder_size(simulation_factory, two_particle_snapshot_factory):
+    sim = simulation_factory(two_particle_snapshot_factory())
+    kT = hoomd.variant.Constant(1.0)
+    langevin = hoomd.md.methods.Langevin(filter=hoomd.filter.All(), kT=kT)
+    sim.operations.integrator = hoomd.md.Integrator(0.005, methods=[langevin])
+
+    replica_exchange = hoomd.md.update.ReplicaExchange(
+        trigger=hoomd.trigger.Periodic(10), kT=kT, kT_ladder=[1.0, 2.0])
+    sim.operations.updaters.append(replica_exchange)
+
+    with pytest.raises(RuntimeError):
+        sim.run(0)
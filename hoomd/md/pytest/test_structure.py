@@ -0,0 +1,140 @@
+import hoomd
+from hoomd.conftest import logging_check
+from hoomd.error import DataAccessError
+from hoomd.logging import LoggerCategories
+import math
+import numpy
+import pytest
+
+
+def test_rdf_before_attaching():
+    nlist = hoomd.md.nlist.Cell(buffer=0.4)
+    rdf = hoomd.md.compute.RDF(nlist=nlist, bins=10, r_max=2.5)
+    assert rdf.nlist is nlist
+    assert rdf.bins == 10
+    assert rdf.r_max == 2.5
+    numpy.testing.assert_allclose(rdf.bin_centers,
+                                  (numpy.arange(10) + 0.5) * 0.25)
+    with pytest.raises(DataAccessError):
+        rdf.rdf
+    with pytest.raises(DataAccessError):
+        rdf.num_frames
+
+
+def test_rdf_pair(simulation_factory, two_particle_snapshot_factory):
+    sim = simulation_factory(
+        two_particle_snapshot_factory(particle_types=['A', 'B'], d=1.1, L=20))
+    rdf = hoomd.md.compute.RDF(nlist=hoomd.md.nlist.Cell(buffer=0.4),
+                               bins=10,
+                               r_max=2.5)
+    sim.operations.computes.append(rdf)
+    sim.run(0)
+
+    assert rdf.type_pairs == [('A', 'A'), ('A', 'B'), ('B', 'B')]
+    g = rdf.rdf
+    assert g.shape == (3, 10)
+
+    # both particles are type A
+    volume = 20**3
+    shell = 4 / 3 * math.pi * (1.25**3 - 1.0**3)
+    expected = numpy.zeros(10)
+    expected[4] = volume / shell
+    numpy.testing.assert_allclose(g[0], expected, rtol=1e-5)
+    numpy.testing.assert_allclose(g[1], 0)
+    numpy.testing.assert_allclose(g[2], 0)
+
+    # repeated access on the same step adds no frames
+    assert rdf.num_frames == 1
+    sim.run(1)
+    assert rdf.num_frames == 2
+    numpy.testing.assert_allclose(rdf.rdf[0], expected, rtol=1e-5)
+
+    rdf.reset()
+    assert rdf.num_frames == 0
+    numpy.testing.assert_allclose(rdf.rdf, 0)
+
+
+def test_structure_factor_before_attaching():
+    sq = hoomd.md.compute.StructureFactor(filter=hoomd.filter.All(),
+                                          mesh=(16, 16, 16),
+                                          bins=8,
+                                          q_max=2.0)
+    assert sq.mesh == (16, 16, 16)
+    assert sq.bins == 8
+    assert sq.q_max == 2.0
+    numpy.testing.assert_allclose(sq.bin_centers,
+                                  (numpy.arange(8) + 0.5) * 0.25)
+    with pytest.raises(DataAccessError):
+        sq.structure_factor
+
+    with pytest.raises(ValueError):
+        hoomd.md.compute.StructureFactor(filter=hoomd.filter.All(),
+                                         mesh=(16, 16),
+                                         bins=8,
+                                         q_max=2.0)
+
+
+def test_structure_factor_ideal_gas(simulation_factory, device):
+    L = 20
+    N = 4000
+    snap = hoomd.Snapshot(device.communicator)
+    if snap.communicator.rank == 0:
+        rng = numpy.random.default_rng(12)
+        snap.configuration.box = [L, L, L, 0, 0, 0]
+        snap.particles.N = N
+        snap.particles.types = ['A']
+        snap.particles.position[:] = rng.uniform(-L / 2, L / 2, size=(N, 3))
+    sim = simulation_factory(snap)
+
+    # q_max is well below the Nyquist wave vector pi * 32 / L
+    sq = hoomd.md.compute.StructureFactor(filter=hoomd.filter.All(),
+                                          mesh=(32, 32, 32),
+                                          bins=6,
+                                          q_max=1.8)
+    sim.operations.computes.append(sq)
+    sim.run(0)
+
+    s = sq.structure_factor
+    assert s.shape == (6,)
+    assert sq.num_frames == 1
+
+    # uncorrelated particles have S(q) = 1, the outer shells hold the most
+    # wave vectors and the least noise
+    assert numpy.all(s[0:2] > 0)
+    numpy.testing.assert_allclose(numpy.mean(s[3:]), 1.0, atol=0.2)
+
+    sq.reset()
+    assert sq.num_frames == 0
+
+
+def test_logging():
+    logging_check(
+        hoomd.md.compute.RDF, ('md', 'compute'), {
+            'rdf': {
+                'category': LoggerCategories.sequence,
+                'default': True
+            },
+            'bin_centers': {
+                'category': LoggerCategories.sequence,
+                'default': True
+            },
+            'num_frames': {
+                'category': LoggerCategories.scalar,
+                'default': True
+            },
+        })
+    logging_check(
+        hoomd.md.compute.StructureFactor, ('md', 'compute'), {
+            'structure_factor': {
+                'category': LoggerCategories.sequence,
+                'default': True
+            },
+            'bin_centers': {
+                'category': LoggerCategories.sequence,
+                'default': True
+            },
+            'num_frames': {
+                'category': LoggerCategories.scalar,
+                'default': True
+            },
+        })
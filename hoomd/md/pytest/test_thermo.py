@@ -94,6 +94,34 @@ def test_basic_system_3d(simulation_factory, two_particle_snapshot_factory):
                               [8.0 / 20.0**3, 0., 0., 0., 0., 0.], volume)
 
 
+def test_lazy_pressure(simulation_factory, two_particle_snapshot_factory):
+    filt = hoomd.filter.All()
+    thermo = hoomd.md.compute.ThermodynamicQuantities(filt)
+    snap = two_particle_snapshot_factory(d=0.5)
+    if snap.communicator.rank == 0:
+        snap.particles.velocity[:] = [[-2, 1, 0], [2, 0, -1]]
+    sim = simulation_factory(snap)
+    sim.always_compute_pressure = True
+    sim.operations.add(thermo)
+
+    nlist = hoomd.md.nlist.Cell()
+    lj = hoomd.md.pair.LJ(nlist, r_cut=2.5)
+    lj.params[('A', 'A')] = dict(epsilon=1, sigma=1)
+    integrator = hoomd.md.Integrator(dt=0.0001, forces=[lj])
+    sim.operations.integrator = integrator
+    sim.run(1)
+
+    # the isotropic pressure evaluated on its own agrees with the tensor
+    # evaluated later on the same step
+    pressure = thermo.pressure
+    pressure_tensor = thermo.pressure_tensor
+    np.testing.assert_allclose(
+        pressure, (pressure_tensor[0] + pressure_tensor[3] + pressure_tensor[5])
+        / 3,
+        rtol=1e-4)
+    np.testing.assert_allclose(thermo.pressure, pressure, rtol=1e-6)
+
+
 def test_basic_system_2d(simulation_factory, lattice_snapshot_factory):
     filterA = hoomd.filter.Type(['A'])
     filterB = hoomd.filter.Type(['B'])
@@ -175,3 +203,97 @@ def test_pickling(simulation_factory, two_particle_snapshot_factory):
     thermo = hoomd.md.compute.ThermodynamicQuantities(filter_)
     sim = simulation_factory(two_particle_snapshot_factory())
     operation_pickling_check(thermo, sim)
+
+
+def test_log_buffer(simulation_factory, two_particle_snapshot_factory):
+    thermo = hoomd.md.compute.ThermodynamicQuantities(hoomd.filter.All())
+    sim = simulation_factory(two_particle_snapshot_factory())
+    sim.operations.add(thermo)
+    integrator = hoomd.md.Integrator(dt=0.005)
+    integrator.methods.append(hoomd.md.methods.NVE(hoomd.filter.All()))
+    sim.operations.integrator = integrator
+
+    buffer = hoomd.write.LogBuffer(trigger=hoomd.trigger.Periodic(2),
+                                   quantities=[(thermo, 'kinetic_energy'),
+                                               (thermo, 'num_particles')],
+                                   capacity=3)
+    sim.operations.writers.append(buffer)
+    assert buffer.labels == [
+        'timestep',
+        'md.compute.ThermodynamicQuantities.kinetic_energy',
+        'md.compute.ThermodynamicQuantities.num_particles'
+    ]
+
+    sim.run(4)
+    data = buffer.fetch()
+    np.testing.assert_array_equal(data[:, 0], [0, 2])
+    np.testing.assert_allclose(data[-1, 1], thermo.kinetic_energy)
+    np.testing.assert_array_equal(data[:, 2], [2, 2])
+    assert buffer.fetch().shape == (0, 3)
+
+    # the ring keeps the newest rows
+    sim.run(10)
+    np.testing.assert_array_equal(buffer.fetch()[:, 0], [8, 10, 12])
+    assert buffer.num_dropped == 2
+
+
+@pytest.mark.serial
+def test_log_buffer_file(simulation_factory, two_particle_snapshot_factory,
+                         tmp_path):
+    thermo = hoomd.md.compute.ThermodynamicQuantities(hoomd.filter.All())
+    sim = simulation_factory(two_particle_snapshot_factory())
+    sim.operations.add(thermo)
+    sim.operations.integrator = hoomd.md.Integrator(dt=0.005)
+    filename = tmp_path / 'log.txt'
+    buffer = hoomd.write.LogBuffer(trigger=hoomd.trigger.Periodic(1),
+                                   quantities=[(thermo, 'num_particles')],
+                                   capacity=2,
+                                   filename=str(filename))
+    sim.operations.writers.append(buffer)
+    sim.run(5)
+
+    lines = filename.read_text().splitlines()
+    assert lines[0].split() == buffer.labels
+    np.testing.assert_array_equal(np.loadtxt(lines[1:]),
+                                  [[i, 2] for i in range(5)])
+
+
+@pytest.mark.serial
+def test_log_buffer_gsd(simulation_factory, two_particle_snapshot_factory,
+                        tmp_path):
+    gsd_fl = pytest.importorskip('gsd.fl')
+    thermo = hoomd.md.compute.ThermodynamicQuantities(hoomd.filter.All())
+    sim = simulation_factory(two_particle_snapshot_factory())
+    sim.operations.add(thermo)
+    sim.operations.integrator = hoomd.md.Integrator(dt=0.005)
+    filename = tmp_path / 'log.gsd'
+    buffer = hoomd.write.LogBuffer(trigger=hoomd.trigger.Periodic(1),
+                                   quantities=[(thermo, 'num_particles')],
+                                   capacity=2,
+                                   filename=str(filename),
+                                   format='gsd')
+    sim.operations.writers.append(buffer)
+    sim.run(5)
+
+    name = 'log/md/compute/ThermodynamicQuantities/num_particles'
+    with gsd_fl.open(name=str(filename), mode='rb') as f:
+        assert f.nframes == 3
+        timestep = np.concatenate([
+            f.read_chunk(frame=i, name='log/timestep') for i in range(3)
+        ])
+        num_particles = np.concatenate(
+            [f.read_chunk(frame=i, name=name) for i in range(3)])
+    np.testing.assert_array_equal(timestep, range(5))
+    np.testing.assert_array_equal(num_particles, [2] * 5)
+
+
+def test_log_buffer_python_quantity(simulation_factory,
+                                    two_particle_snapshot_factory):
+    thermo = hoomd.md.compute.ThermodynamicQuantities(hoomd.filter.All())
+    sim = simulation_factory(two_particle_snapshot_factory())
+    sim.operations.add(thermo)
+    buffer = hoomd.write.LogBuffer(trigger=hoomd.trigger.Periodic(1),
+                                   quantities=[(thermo, 'pressure_tensor')])
+    sim.operations.writers.append(buffer)
+    with pytest.raises(RuntimeError):
+        sim.run(1)
@@ -76,5 +76,41 @@ def test_logging(simulation_factory, two_particle_snapshot_factory):
             'pressure': {
                 'category': LoggerCategories.scalar,
                 'default': True
+            },
+            'conventional_potential_energy': {
+                'category': LoggerCategories.scalar,
+                'default': True
+            },
+            'conventional_pressure': {
+                'category': LoggerCategories.scalar,
+                'default': True
             }
         })
+
+
+def test_conventional(simulation_factory, two_particle_snapshot_factory):
+    filt = hoomd.filter.All()
+    thermoHMA = hoomd.md.compute.HarmonicAveragedThermodynamicQuantities(
+        filt, 1.0)
+    thermo = hoomd.md.compute.ThermodynamicQuantities(filt)
+    snap = two_particle_snapshot_factory()
+    if snap.communicator.rank == 0:
+        snap.particles.velocity[:] = [[-2, 0, 0], [2, 0, 0]]
+    sim = simulation_factory(snap)
+    sim.always_compute_pressure = True
+    sim.operations.add(thermoHMA)
+    sim.operations.add(thermo)
+
+    integrator = hoomd.md.Integrator(dt=0.0001)
+    integrator.methods.append(hoomd.md.methods.NVE(filt))
+    sim.operations.integrator = integrator
+    sim.run(1)
+
+    assert thermoHMA.conventional_pressure == pytest.approx(thermo.pressure)
+    assert thermoHMA.conventional_potential_energy == pytest.approx(
+        thermo.potential_energy)
+
+    # without forces, the HMA energy only adds the harmonic energy
+    N = thermo.num_particles
+    assert thermoHMA.potential_energy == pytest.approx(
+        thermo.potential_energy + 1.5 * (N - 1) * 1.0)
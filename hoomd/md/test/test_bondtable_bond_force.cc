@@ -4,6 +4,7 @@
 // this include is necessary to get MPI included before anything else to support intel MPI
 #include "hoomd/ExecutionConfiguration.h"
 
+#include <cmath>
 #include <fstream>
 
 #include <functional>
@@ -250,6 +251,50 @@ void bond_force_type_test(bondforce_creator bf_creator,
         }
     }
 
+#ifdef ENABLE_HIP
+//! Compute table bond forces on the GPU for a chain of bonds of type 0
+/*! \param exec_conf Execution configuration
+    \param n_bond_types Number of bond types, the types other than 0 only add to the table size
+    \param width Number of points in each table
+*/
+std::shared_ptr<BondTablePotential>
+bond_table_chain(std::shared_ptr<ExecutionConfiguration> exec_conf,
+                 unsigned int n_bond_types,
+                 unsigned int width)
+    {
+    const unsigned int N = 100;
+    std::shared_ptr<SystemDefinition> sysdef(
+        new SystemDefinition(N, BoxDim(1000.0), 1, n_bond_types, 0, 0, 0, exec_conf));
+    std::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+    pdata->setFlags(~PDataFlags(0));
+
+    // bond lengths between 0.8 and 1.6
+    Scalar x(-450.0);
+    for (unsigned int i = 0; i < N; i++)
+        {
+        pdata->setPosition(i, make_scalar3(x, Scalar(0.1) * (i % 3), Scalar(0.1) * (i % 5)));
+        x += Scalar(0.8) + Scalar(0.1) * (i % 9);
+        }
+
+    std::shared_ptr<BondTablePotential> fc(new BondTablePotentialGPU(sysdef, width));
+    const Scalar rmin(0.5), rmax(2.0);
+    vector<Scalar> V, F;
+    for (unsigned int k = 0; k < width; k++)
+        {
+        Scalar r = rmin + (rmax - rmin) * Scalar(k) / Scalar(width - 1);
+        V.push_back(Scalar(50.0) * (r - Scalar(1.2)) * (r - Scalar(1.2)));
+        F.push_back(Scalar(-100.0) * (r - Scalar(1.2)));
+        }
+    fc->setTable(0, V, F, rmin, rmax);
+
+    for (unsigned int i = 0; i < N - 1; i++)
+        sysdef->getBondData()->addBondedGroup(Bond(0, i, i + 1));
+
+    fc->compute(0);
+    return fc;
+    }
+#endif
+
 //! BondTablePotential creator for bond_force_basic_tests()
 std::shared_ptr<BondTablePotential> base_class_bf_creator(std::shared_ptr<SystemDefinition> sysdef,
                                                           unsigned int width)
@@ -303,4 +348,51 @@ UP_TEST(BondTablePotentialGPU_type)
                              new ExecutionConfiguration(ExecutionConfiguration::GPU)));
     }
 
+//! test case for bond forces with the tables in shared memory and in global memory on the GPU
+UP_TEST(BondTablePotentialGPU_shared)
+    {
+    std::shared_ptr<ExecutionConfiguration> exec_conf(
+        new ExecutionConfiguration(ExecutionConfiguration::GPU));
+
+    // one type fits in shared memory, enough types to exceed it force the global memory path
+    const unsigned int width = 1000;
+    const size_t type_bytes = sizeof(Scalar2) * width;
+    const unsigned int n_types = exec_conf->dev_prop.sharedMemPerBlock / type_bytes + 1;
+    UP_ASSERT(type_bytes < exec_conf->dev_prop.sharedMemPerBlock / 2);
+
+    std::shared_ptr<BondTablePotential> fc_shared = bond_table_chain(exec_conf, 1, width);
+    std::shared_ptr<BondTablePotential> fc_global = bond_table_chain(exec_conf, n_types, width);
+
+    ArrayHandle<Scalar4> h_force_shared(fc_shared->getForceArray(),
+                                        access_location::host,
+                                        access_mode::read);
+    ArrayHandle<Scalar> h_virial_shared(fc_shared->getVirialArray(),
+                                        access_location::host,
+                                        access_mode::read);
+    ArrayHandle<Scalar4> h_force_global(fc_global->getForceArray(),
+                                        access_location::host,
+                                        access_mode::read);
+    ArrayHandle<Scalar> h_virial_global(fc_global->getVirialArray(),
+                                        access_location::host,
+                                        access_mode::read);
+    size_t pitch_shared = fc_shared->getVirialArray().getPitch();
+    size_t pitch_global = fc_global->getVirialArray().getPitch();
+
+    // both paths read the same table entries and do the same arithmetic
+    const Scalar tol_same = Scalar(1e-4);
+    for (unsigned int i = 0; i < 100; i++)
+        {
+        MY_CHECK_SMALL(h_force_shared.data[i].x - h_force_global.data[i].x, tol_same);
+        MY_CHECK_SMALL(h_force_shared.data[i].y - h_force_global.data[i].y, tol_same);
+        MY_CHECK_SMALL(h_force_shared.data[i].z - h_force_global.data[i].z, tol_same);
+        MY_CHECK_SMALL(h_force_shared.data[i].w - h_force_global.data[i].w, tol_same);
+        for (unsigned int k = 0; k < 6; k++)
+            MY_CHECK_SMALL(h_virial_shared.data[k * pitch_shared + i]
+                               - h_virial_global.data[k * pitch_global + i],
+                           tol_same);
+        }
+
+    // the chain is not at rest, so the comparison is not between zeros
+    UP_ASSERT(std::abs(h_force_shared.data[0].x) > Scalar(1.0));
+    }
 #endif
@@ -44,6 +44,10 @@ std::shared_ptr<Communicator>
 base_class_communicator_creator(std::shared_ptr<SystemDefinition> sysdef,
                                 std::shared_ptr<DomainDecomposition> decomposition);
 
+std::shared_ptr<Communicator>
+compressed_communicator_creator(std::shared_ptr<SystemDefinition> sysdef,
+                                std::shared_ptr<DomainDecomposition> decomposition);
+
 #ifdef ENABLE_HIP
 std::shared_ptr<Communicator>
 gpu_communicator_creator(std::shared_ptr<SystemDefinition> sysdef,
@@ -3631,6 +3635,16 @@ base_class_communicator_creator(std::shared_ptr<SystemDefinition> sysdef,
     return std::shared_ptr<Communicator>(new Communicator(sysdef, decomposition));
     }
 
+//! Communicator creator for unit tests that compresses ghost position updates
+std::shared_ptr<Communicator>
+compressed_communicator_creator(std::shared_ptr<SystemDefinition> sysdef,
+                                std::shared_ptr<DomainDecomposition> decomposition)
+    {
+    std::shared_ptr<Communicator> comm(new Communicator(sysdef, decomposition));
+    comm->setCompressGhostPositions(true);
+    return comm;
+    }
+
 #ifdef ENABLE_HIP
 std::shared_ptr<Communicator>
 gpu_communicator_creator(std::shared_ptr<SystemDefinition> sysdef,
@@ -3794,6 +3808,37 @@ UP_TEST(communicator_ghosts_test)
         }
     }
 
+UP_TEST(communicator_compressed_ghosts_test)
+    {
+    if (!exec_conf_cpu)
+        exec_conf_cpu = std::shared_ptr<ExecutionConfiguration>(
+            new ExecutionConfiguration(ExecutionConfiguration::CPU));
+
+    communicator_creator communicator_creator_compressed
+        = bind(compressed_communicator_creator, _1, _2);
+
+    // test in a cubic box
+        {
+        BoxDim box(2.0);
+        test_communicator_ghosts(communicator_creator_compressed,
+                                 exec_conf_cpu,
+                                 box,
+                                 std::shared_ptr<DomainDecomposition>(
+                                     new DomainDecomposition(exec_conf_cpu, box.getL())),
+                                 make_scalar3(0.0, 0.0, 0.0));
+        }
+    // triclinic box
+        {
+        BoxDim box(1.0, -.6, .7, .5);
+        test_communicator_ghosts(communicator_creator_compressed,
+                                 exec_conf_cpu,
+                                 box,
+                                 std::shared_ptr<DomainDecomposition>(
+                                     new DomainDecomposition(exec_conf_cpu, box.getL())),
+                                 make_scalar3(0.0, 0.0, 0.0));
+        }
+    }
+
 UP_TEST(communicator_bonded_ghosts_test)
     {
     if (!exec_conf_cpu)
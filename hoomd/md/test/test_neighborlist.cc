@@ -1355,6 +1355,84 @@ void neighborlist_comparison_test(std::shared_ptr<ExecutionConfiguration> exec_c
         }
     }
 
+#ifdef ENABLE_TBB
+//! Build a neighbor list on a random system with the given number of TBB threads
+/*! \param num_threads Number of threads in the task arena
+    \param mode Neighbor list storage mode
+    \param neighbors Set to the sorted neighbor tags of each particle, indexed by tag
+*/
+template<class NL>
+void neighborlist_thread_build(unsigned int num_threads,
+                               NeighborList::storageMode mode,
+                               std::vector<std::vector<unsigned int>>& neighbors)
+    {
+    std::shared_ptr<ExecutionConfiguration> exec_conf(
+        new ExecutionConfiguration(ExecutionConfiguration::CPU));
+    exec_conf->setNumThreads(num_threads);
+
+    RandomInitializer init(1000, Scalar(0.016778), Scalar(0.9), "A");
+    // seed the initializer so that every build sees the same configuration
+    init.setSeed(12345);
+    std::shared_ptr<SnapshotSystemData<Scalar>> snap = init.getSnapshot();
+    std::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(snap, exec_conf));
+    std::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+
+    std::shared_ptr<NeighborList> nlist(new NL(sysdef, Scalar(0.4)));
+    auto r_cut = std::make_shared<GlobalArray<Scalar>>(nlist->getTypePairIndexer().getNumElements(),
+                                                       exec_conf);
+        {
+        ArrayHandle<Scalar> h_r_cut(*r_cut, access_location::host, access_mode::overwrite);
+        h_r_cut.data[0] = 3.0;
+        }
+    nlist->addRCutMatrix(r_cut);
+    nlist->setStorageMode(mode);
+    for (unsigned int i = 0; i < pdata->getN() - 2; i++)
+        {
+        nlist->addExclusion(i, i + 1);
+        nlist->addExclusion(i, i + 2);
+        }
+    nlist->compute(0);
+
+    ArrayHandle<unsigned int> h_n_neigh(nlist->getNNeighArray(),
+                                        access_location::host,
+                                        access_mode::read);
+    ArrayHandle<unsigned int> h_nlist(nlist->getNListArray(),
+                                      access_location::host,
+                                      access_mode::read);
+    ArrayHandle<unsigned int> h_head_list(nlist->getHeadList(),
+                                          access_location::host,
+                                          access_mode::read);
+    ArrayHandle<unsigned int> h_tag(pdata->getTags(), access_location::host, access_mode::read);
+
+    neighbors.assign(pdata->getN(), std::vector<unsigned int>());
+    for (unsigned int i = 0; i < pdata->getN(); i++)
+        {
+        std::vector<unsigned int>& list = neighbors[h_tag.data[i]];
+        for (unsigned int k = 0; k < h_n_neigh.data[i]; k++)
+            list.push_back(h_tag.data[h_nlist.data[h_head_list.data[i] + k]]);
+        std::sort(list.begin(), list.end());
+        }
+    }
+
+//! Test that a multi-threaded build finds the same neighbors as a single-threaded one
+template<class NL> void neighborlist_thread_test()
+    {
+    for (auto mode : {NeighborList::half, NeighborList::full})
+        {
+        std::vector<std::vector<unsigned int>> serial, threaded;
+        neighborlist_thread_build<NL>(1, mode, serial);
+        neighborlist_thread_build<NL>(4, mode, threaded);
+
+        UP_ASSERT_EQUAL(serial.size(), threaded.size());
+        for (unsigned int tag = 0; tag < serial.size(); tag++)
+            {
+            UP_ASSERT_EQUAL(serial[tag].size(), threaded[tag].size());
+            UP_ASSERT(serial[tag] == threaded[tag]);
+            }
+        }
+    }
+#endif
+
 //! Test that a NeighborList can successfully exclude a ridiculously large number of particles
 template<class NL>
 void neighborlist_large_ex_tests(std::shared_ptr<ExecutionConfiguration> exec_conf)
@@ -1414,6 +1492,78 @@ void neighborlist_large_ex_tests(std::shared_ptr<ExecutionConfiguration> exec_co
         }
     }
 
+//! Test exclusions at the edges of the tag window of the exclusion masks
+template<class NL>
+void neighborlist_tag_window_exclusion_tests(std::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    // place 100 particles on a line, all within the cutoff of each other
+    const unsigned int N = 100;
+    std::shared_ptr<SystemDefinition> sysdef(
+        new SystemDefinition(N, BoxDim(40.0), 1, 0, 0, 0, 0, exec_conf));
+    std::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+        {
+        ArrayHandle<Scalar4> h_pos(pdata->getPositions(),
+                                   access_location::host,
+                                   access_mode::readwrite);
+        for (unsigned int i = 0; i < N; i++)
+            h_pos.data[i] = make_scalar4(Scalar(-5.0) + Scalar(0.1) * i, 0, 0, __int_as_scalar(0));
+        pdata->notifyParticleSort();
+        }
+
+    std::shared_ptr<NeighborList> nlist(new NL(sysdef, Scalar(0.4)));
+    auto r_cut = std::make_shared<GlobalArray<Scalar>>(nlist->getTypePairIndexer().getNumElements(),
+                                                       exec_conf);
+        {
+        ArrayHandle<Scalar> h_r_cut(*r_cut, access_location::host, access_mode::overwrite);
+        h_r_cut.data[0] = 12.0;
+        }
+    nlist->addRCutMatrix(r_cut);
+    nlist->setStorageMode(NeighborList::full);
+
+    // tag offsets inside, at the edges of, and outside the mask window
+    const unsigned int offsets[] = {1, 31, 32, 33, 64};
+    for (unsigned int i = 0; i < N; i++)
+        {
+        for (unsigned int offset : offsets)
+            {
+            if (i + offset < N && (i / 7) % 2 == 0)
+                nlist->addExclusion(i, i + offset);
+            }
+        }
+
+    nlist->compute(0);
+
+    ArrayHandle<unsigned int> h_n_neigh(nlist->getNNeighArray(),
+                                        access_location::host,
+                                        access_mode::read);
+    ArrayHandle<unsigned int> h_nlist(nlist->getNListArray(),
+                                      access_location::host,
+                                      access_mode::read);
+    ArrayHandle<unsigned int> h_head_list(nlist->getHeadList(),
+                                          access_location::host,
+                                          access_mode::read);
+    ArrayHandle<unsigned int> h_tag(pdata->getTags(), access_location::host, access_mode::read);
+
+    // every particle neighbors every other particle except for its exclusions
+    for (unsigned int i = 0; i < N; i++)
+        {
+        unsigned int tag_i = h_tag.data[i];
+        unsigned int n_excluded = 0;
+        for (unsigned int j = 0; j < N; j++)
+            {
+            if (j != i && nlist->isExcluded(tag_i, h_tag.data[j]))
+                n_excluded++;
+            }
+        CHECK_EQUAL_UINT(h_n_neigh.data[i], N - 1 - n_excluded);
+
+        for (unsigned int k = 0; k < h_n_neigh.data[i]; k++)
+            {
+            unsigned int j = h_nlist.data[h_head_list.data[i] + k];
+            UP_ASSERT(!nlist->isExcluded(tag_i, h_tag.data[j]));
+            }
+        }
+    }
+
 //! Test that NeighborList can exclude particles correctly when cutoff radius is negative
 template<class NL>
 void neighborlist_cutoff_exclude_tests(std::shared_ptr<ExecutionConfiguration> exec_conf)
@@ -1736,6 +1886,14 @@ UP_TEST(NeighborListBinned_exclusion)
     neighborlist_exclusion_tests<NeighborListBinned>(std::shared_ptr<ExecutionConfiguration>(
         new ExecutionConfiguration(ExecutionConfiguration::CPU)));
     }
+//! tag window exclusion test case for binned class
+UP_TEST(NeighborListBinned_tag_window_exclusion)
+    {
+    neighborlist_tag_window_exclusion_tests<NeighborListBinned>(
+        std::shared_ptr<ExecutionConfiguration>(
+            new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+
 //! large exclusion test case for binned class
 UP_TEST(NeighborListBinned_large_ex)
     {
@@ -1786,6 +1944,14 @@ UP_TEST(NeighborListBinned_2d)
         new ExecutionConfiguration(ExecutionConfiguration::CPU)));
     }
 
+#ifdef ENABLE_TBB
+//! multi-threaded build matches the single-threaded build
+UP_TEST(NeighborListBinned_threads)
+    {
+    neighborlist_thread_test<NeighborListBinned>();
+    }
+#endif
+
 ////////////////////
 // STENCIL CPU
 ////////////////////
@@ -1802,6 +1968,14 @@ UP_TEST(NeighborListStencil_exclusion)
     neighborlist_exclusion_tests<NeighborListStencil>(std::shared_ptr<ExecutionConfiguration>(
         new ExecutionConfiguration(ExecutionConfiguration::CPU)));
     }
+//! tag window exclusion test case for stencil class
+UP_TEST(NeighborListStencil_tag_window_exclusion)
+    {
+    neighborlist_tag_window_exclusion_tests<NeighborListStencil>(
+        std::shared_ptr<ExecutionConfiguration>(
+            new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+
 //! large exclusion test case for stencil class
 UP_TEST(NeighborListStencil_large_ex)
     {
@@ -1859,6 +2033,14 @@ UP_TEST(NeighborListStencil_comparison)
             new ExecutionConfiguration(ExecutionConfiguration::CPU)));
     }
 
+#ifdef ENABLE_TBB
+//! multi-threaded build matches the single-threaded build
+UP_TEST(NeighborListStencil_threads)
+    {
+    neighborlist_thread_test<NeighborListStencil>();
+    }
+#endif
+
 ///////////////
 // TREE CPU
 ///////////////
@@ -1874,6 +2056,14 @@ UP_TEST(NeighborListTree_exclusion)
     neighborlist_exclusion_tests<NeighborListTree>(std::shared_ptr<ExecutionConfiguration>(
         new ExecutionConfiguration(ExecutionConfiguration::CPU)));
     }
+//! tag window exclusion test case for tree class
+UP_TEST(NeighborListTree_tag_window_exclusion)
+    {
+    neighborlist_tag_window_exclusion_tests<NeighborListTree>(
+        std::shared_ptr<ExecutionConfiguration>(
+            new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+
 //! large exclusion test case for tree class
 UP_TEST(NeighborListTree_large_ex)
     {
@@ -1931,6 +2121,14 @@ UP_TEST(NeighborListTree_comparison)
             new ExecutionConfiguration(ExecutionConfiguration::CPU)));
     }
 
+#ifdef ENABLE_TBB
+//! multi-threaded build matches the single-threaded build
+UP_TEST(NeighborListTree_threads)
+    {
+    neighborlist_thread_test<NeighborListTree>();
+    }
+#endif
+
 #ifdef ENABLE_HIP
 ///////////////
 // BINNED GPU
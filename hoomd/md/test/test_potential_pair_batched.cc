@@ -0,0 +1,187 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+// this include is necessary to get MPI included before anything else to support intel MPI
+#include "hoomd/ExecutionConfiguration.h"
+
+#include <algorithm>
+#include <memory>
+#include <random>
+
+#include "hoomd/Initializers.h"
+#include "hoomd/md/AllPairPotentials.h"
+#include "hoomd/md/NeighborListBinned.h"
+
+using namespace std;
+
+/*! \file test_potential_pair_batched.cc
+    \brief Checks that the batched CPU pair loop matches the scalar loop
+    \ingroup unit_tests
+*/
+
+#include "hoomd/test/upp11_config.h"
+HOOMD_UP_MAIN();
+
+//! Parameters for the type pair with index \a k
+template<class evaluator> typename evaluator::param_type make_params(unsigned int k);
+
+template<> EvaluatorPairLJ::param_type make_params<EvaluatorPairLJ>(unsigned int k)
+    {
+    Scalar epsilon = Scalar(1.0) + Scalar(0.5) * Scalar(k);
+    Scalar sigma = Scalar(1.0) - Scalar(0.1) * Scalar(k);
+    EvaluatorPairLJ::param_type params;
+    params.lj1 = Scalar(4.0) * epsilon * pow(sigma, Scalar(12.0));
+    params.lj2 = Scalar(4.0) * epsilon * pow(sigma, Scalar(6.0));
+    return params;
+    }
+
+template<>
+EvaluatorPairForceShiftedLJ::param_type make_params<EvaluatorPairForceShiftedLJ>(unsigned int k)
+    {
+    return make_params<EvaluatorPairLJ>(k);
+    }
+
+template<> EvaluatorPairYukawa::param_type make_params<EvaluatorPairYukawa>(unsigned int k)
+    {
+    EvaluatorPairYukawa::param_type params;
+    params.epsilon = Scalar(1.0) + Scalar(0.5) * Scalar(k);
+    params.kappa = Scalar(1.0) + Scalar(0.25) * Scalar(k);
+    return params;
+    }
+
+template<> EvaluatorPairGauss::param_type make_params<EvaluatorPairGauss>(unsigned int k)
+    {
+    EvaluatorPairGauss::param_type params;
+    params.epsilon = Scalar(1.0) + Scalar(0.5) * Scalar(k);
+    params.sigma = Scalar(0.5) + Scalar(0.1) * Scalar(k);
+    return params;
+    }
+
+//! Check that two values agree up to round-off
+void check_equivalent(Scalar a, Scalar b)
+    {
+#ifdef SINGLE_PRECISION
+    const Scalar rel_tol = Scalar(1e-4);
+#else
+    const Scalar rel_tol = Scalar(1e-10);
+#endif
+    UP_ASSERT(std::abs(a - b) <= rel_tol * (std::abs(a) + std::abs(b)) + rel_tol);
+    }
+
+//! Compare the forces, energies, and virials of the batched and the scalar loops
+template<class evaluator>
+void pair_batched_test(std::shared_ptr<ExecutionConfiguration> exec_conf,
+                       NeighborList::storageMode storage_mode,
+                       typename PotentialPair<evaluator>::energyShiftMode shift_mode)
+    {
+    // a perturbed lattice of two types
+    SimpleCubicInitializer init(8, Scalar(1.1), "A");
+    std::shared_ptr<SnapshotSystemData<Scalar>> snap = init.getSnapshot();
+    snap->particle_data.type_mapping.push_back("B");
+    std::mt19937 rng(17);
+    std::uniform_real_distribution<Scalar> shift(Scalar(-0.15), Scalar(0.15));
+    for (unsigned int i = 0; i < snap->particle_data.size; i++)
+        {
+        snap->particle_data.type[i] = i % 2;
+        snap->particle_data.pos[i] += vec3<Scalar>(shift(rng), shift(rng), shift(rng));
+        }
+
+    std::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(snap, exec_conf));
+    std::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+    PDataFlags flags;
+    flags[pdata_flag::pressure_tensor] = 1;
+    pdata->setFlags(flags);
+
+    std::shared_ptr<NeighborList> nlist(new NeighborListBinned(sysdef, Scalar(0.4)));
+    nlist->setStorageMode(storage_mode);
+
+    std::shared_ptr<PotentialPair<evaluator>> pair[2];
+    for (unsigned int m = 0; m < 2; m++)
+        {
+        pair[m].reset(new PotentialPair<evaluator>(sysdef, nlist));
+        pair[m]->setBatched(m == 1);
+        pair[m]->setShiftMode(shift_mode);
+        pair[m]->setParams(0, 0, make_params<evaluator>(0));
+        pair[m]->setParams(0, 1, make_params<evaluator>(1));
+        pair[m]->setParams(1, 1, make_params<evaluator>(2));
+        pair[m]->setRcut(0, 0, Scalar(2.5));
+        pair[m]->setRcut(0, 1, Scalar(2.0));
+        pair[m]->setRcut(1, 1, Scalar(2.2));
+        pair[m]->setRon(0, 0, Scalar(2.0));
+        pair[m]->setRon(0, 1, Scalar(1.5));
+        pair[m]->setRon(1, 1, Scalar(2.2));
+        std::static_pointer_cast<ForceCompute>(pair[m])->compute(0);
+        }
+
+    ArrayHandle<Scalar4> h_force_scalar(pair[0]->getForceArray(),
+                                        access_location::host,
+                                        access_mode::read);
+    ArrayHandle<Scalar> h_virial_scalar(pair[0]->getVirialArray(),
+                                        access_location::host,
+                                        access_mode::read);
+    ArrayHandle<Scalar4> h_force_batched(pair[1]->getForceArray(),
+                                         access_location::host,
+                                         access_mode::read);
+    ArrayHandle<Scalar> h_virial_batched(pair[1]->getVirialArray(),
+                                         access_location::host,
+                                         access_mode::read);
+    size_t pitch = pair[0]->getVirialArray().getPitch();
+    UP_ASSERT_EQUAL(pitch, pair[1]->getVirialArray().getPitch());
+
+    Scalar max_force = 0;
+    for (unsigned int i = 0; i < pdata->getN(); i++)
+        {
+        check_equivalent(h_force_batched.data[i].x, h_force_scalar.data[i].x);
+        check_equivalent(h_force_batched.data[i].y, h_force_scalar.data[i].y);
+        check_equivalent(h_force_batched.data[i].z, h_force_scalar.data[i].z);
+        check_equivalent(h_force_batched.data[i].w, h_force_scalar.data[i].w);
+        for (unsigned int k = 0; k < 6; k++)
+            check_equivalent(h_virial_batched.data[k * pitch + i],
+                             h_virial_scalar.data[k * pitch + i]);
+        max_force = std::max(max_force, std::abs(h_force_scalar.data[i].x));
+        }
+
+    // the comparison is not vacuous
+    UP_ASSERT(max_force > Scalar(0.01));
+    }
+
+//! Run the comparison for every storage and shift mode
+template<class evaluator> void pair_batched_all_modes(std::shared_ptr<ExecutionConfiguration> exec)
+    {
+    UP_ASSERT(PairEvaluatorBatchTraits<evaluator>::enabled);
+
+    for (auto storage_mode : {NeighborList::half, NeighborList::full})
+        {
+        pair_batched_test<evaluator>(exec, storage_mode, PotentialPair<evaluator>::no_shift);
+        pair_batched_test<evaluator>(exec, storage_mode, PotentialPair<evaluator>::shift);
+        pair_batched_test<evaluator>(exec, storage_mode, PotentialPair<evaluator>::xplor);
+        }
+    }
+
+//! The batched LJ loop matches the scalar loop
+UP_TEST(PotentialPairLJ_batched)
+    {
+    pair_batched_all_modes<EvaluatorPairLJ>(std::shared_ptr<ExecutionConfiguration>(
+        new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+
+//! The batched Yukawa loop matches the scalar loop
+UP_TEST(PotentialPairYukawa_batched)
+    {
+    pair_batched_all_modes<EvaluatorPairYukawa>(std::shared_ptr<ExecutionConfiguration>(
+        new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+
+//! The batched Gauss loop matches the scalar loop
+UP_TEST(PotentialPairGauss_batched)
+    {
+    pair_batched_all_modes<EvaluatorPairGauss>(std::shared_ptr<ExecutionConfiguration>(
+        new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+
+//! The batched force shifted LJ loop matches the scalar loop
+UP_TEST(PotentialPairForceShiftedLJ_batched)
+    {
+    pair_batched_all_modes<EvaluatorPairForceShiftedLJ>(std::shared_ptr<ExecutionConfiguration>(
+        new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
@@ -17,9 +17,12 @@
 
 #include "hoomd/Initializers.h"
 #include "hoomd/filter/ParticleFilterTags.h"
+#include "hoomd/md/LocalFFT.h"
 #include "hoomd/md/NeighborListTree.h"
 
 #include <math.h>
+#include <random>
+#include <vector>
 
 using namespace std;
 using namespace std::placeholders;
@@ -219,6 +222,45 @@ void pppm_force_particle_test_triclinic(pppmforce_creator pppm_creator,
     MY_CHECK_SMALL(h_virial.data[5 * pitch + 1], rough_tol);
     }
 
+//! Compare the transforms of LocalFFT with kiss_fft on the PPPM grid
+void local_fft_test()
+    {
+    const int dims[3] = {10, 15, 24};
+    const unsigned int n = dims[0] * dims[1] * dims[2];
+
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> uniform(-1.0f, 1.0f);
+    std::vector<kiss_fft_cpx> in(n);
+    for (unsigned int i = 0; i < n; i++)
+        {
+        in[i].r = uniform(rng);
+        in[i].i = uniform(rng);
+        }
+
+    kiss_fftnd_cfg cfg_forward = kiss_fftnd_alloc(dims, 3, 0, NULL, NULL);
+    kiss_fftnd_cfg cfg_inverse = kiss_fftnd_alloc(dims, 3, 1, NULL, NULL);
+    std::vector<kiss_fft_cpx> ref_forward(n), ref_inverse(n);
+    kiss_fftnd(cfg_forward, in.data(), ref_forward.data());
+    kiss_fftnd(cfg_inverse, in.data(), ref_inverse.data());
+    kiss_fft_free(cfg_forward);
+    kiss_fft_free(cfg_inverse);
+
+    LocalFFT fft(dims, 1);
+    std::vector<kiss_fft_cpx> forward(n), inverse(n);
+    fft.forward(in.data(), forward.data());
+    fft.inverse(in.data(), inverse.data());
+
+    // the outputs are of order sqrt(n), single precision backends agree well within tol
+    const float tol = 1e-3f;
+    for (unsigned int i = 0; i < n; i++)
+        {
+        CHECK_SMALL(forward[i].r - ref_forward[i].r, tol);
+        CHECK_SMALL(forward[i].i - ref_forward[i].i, tol);
+        CHECK_SMALL(inverse[i].r - ref_inverse[i].r, tol);
+        CHECK_SMALL(inverse[i].i - ref_inverse[i].i, tol);
+        }
+    }
+
 //! PPPMForceCompute creator for unit tests
 std::shared_ptr<PPPMForceCompute> base_class_pppm_creator(std::shared_ptr<SystemDefinition> sysdef,
                                                           std::shared_ptr<NeighborList> nlist,
@@ -257,6 +299,24 @@ UP_TEST(PPPMForceCompute_triclinic)
             new ExecutionConfiguration(ExecutionConfiguration::CPU)));
     }
 
+//! test case for the local FFT backend
+UP_TEST(LocalFFT_kiss_fft)
+    {
+    local_fft_test();
+    }
+
+#ifdef ENABLE_TBB
+//! test case for particle test on CPU with threaded FFTs
+UP_TEST(PPPMForceCompute_threads)
+    {
+    pppmforce_creator pppm_creator = bind(base_class_pppm_creator, _1, _2, _3);
+    std::shared_ptr<ExecutionConfiguration> exec_conf(
+        new ExecutionConfiguration(ExecutionConfiguration::CPU));
+    exec_conf->setNumThreads(4);
+    pppm_force_particle_test(pppm_creator, exec_conf);
+    }
+#endif
+
 #ifdef ENABLE_HIP
 //! test case for bond forces on the GPU
 UP_TEST(PPPMForceComputeGPU_basic)
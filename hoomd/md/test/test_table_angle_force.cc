@@ -4,6 +4,8 @@
 // this include is necessary to get MPI included before anything else to support intel MPI
 #include "hoomd/ExecutionConfiguration.h"
 
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 
 #include <functional>
@@ -277,6 +279,53 @@ void angle_force_comparison_tests(angleforce_creator tf_creator1,
     }
 
 #endif
+
+#ifdef ENABLE_HIP
+//! Compute table angle forces on the GPU for a chain of angles of type 0
+/*! \param exec_conf Execution configuration
+    \param n_angle_types Number of angle types, the types other than 0 only add to the table
+   size
+    \param width Number of points in each table
+*/
+std::shared_ptr<TableAngleForceCompute>
+angle_table_chain(std::shared_ptr<ExecutionConfiguration> exec_conf,
+                  unsigned int n_angle_types,
+                  unsigned int width)
+    {
+    const unsigned int N = 100;
+    std::shared_ptr<SystemDefinition> sysdef(
+        new SystemDefinition(N, BoxDim(1000.0), 1, 0, n_angle_types, 0, 0, exec_conf));
+    std::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+    pdata->setFlags(~PDataFlags(0));
+
+    // unit steps in changing directions
+    Scalar3 pos = make_scalar3(0, 0, 0);
+    for (unsigned int i = 0; i < N; i++)
+        {
+        pos.x += std::cos(Scalar(1.3) * i);
+        pos.y += std::sin(Scalar(1.3) * i);
+        pos.z = Scalar(0.1) * (i % 3);
+        pdata->setPosition(i, pos);
+        }
+
+    std::shared_ptr<TableAngleForceCompute> fc(new TableAngleForceComputeGPU(sysdef, width));
+    std::vector<Scalar> V, T;
+    for (unsigned int k = 0; k < width; k++)
+        {
+        Scalar theta = Scalar(k) / Scalar(width - 1) * Scalar(M_PI);
+        V.push_back(Scalar(10.0) * (theta - Scalar(2.0)) * (theta - Scalar(2.0)));
+        T.push_back(Scalar(-20.0) * (theta - Scalar(2.0)));
+        }
+    fc->setTable(0, V, T);
+
+    for (unsigned int i = 0; i < N - 2; i++)
+        sysdef->getAngleData()->addBondedGroup(Angle(0, i, i + 1, i + 2));
+
+    fc->compute(0);
+    return fc;
+    }
+#endif
+
 //! TableAngleForceCompute creator for angle_force_basic_tests()
 std::shared_ptr<TableAngleForceCompute>
 base_class_tf_creator(std::shared_ptr<SystemDefinition> sysdef, unsigned int width)
@@ -322,4 +371,55 @@ UP_TEST( TableAngleForceComputeGPU_compare )
     angle_force_comparison_tests(tf_creator, tf_creator_gpu, std::shared_ptr<ExecutionConfiguration>(new ExecutionConfiguration(ExecutionConfiguration::GPU)));
     }
 #endif
+
+//! test case for angle forces with the tables in shared memory and in global memory on the GPU
+UP_TEST(TableAngleForceComputeGPU_shared)
+    {
+    std::shared_ptr<ExecutionConfiguration> exec_conf(
+        new ExecutionConfiguration(ExecutionConfiguration::GPU));
+
+    // one type fits in shared memory, enough types to exceed it force the global memory path
+    const unsigned int width = 1000;
+    const size_t type_bytes = sizeof(Scalar2) * width;
+    const unsigned int n_types = exec_conf->dev_prop.sharedMemPerBlock / type_bytes + 1;
+    UP_ASSERT(type_bytes < exec_conf->dev_prop.sharedMemPerBlock / 2);
+
+    std::shared_ptr<TableAngleForceCompute> fc_shared = angle_table_chain(exec_conf, 1, width);
+    std::shared_ptr<TableAngleForceCompute> fc_global
+        = angle_table_chain(exec_conf, n_types, width);
+
+    ArrayHandle<Scalar4> h_force_shared(fc_shared->getForceArray(),
+                                        access_location::host,
+                                        access_mode::read);
+    ArrayHandle<Scalar> h_virial_shared(fc_shared->getVirialArray(),
+                                        access_location::host,
+                                        access_mode::read);
+    ArrayHandle<Scalar4> h_force_global(fc_global->getForceArray(),
+                                        access_location::host,
+                                        access_mode::read);
+    ArrayHandle<Scalar> h_virial_global(fc_global->getVirialArray(),
+                                        access_location::host,
+                                        access_mode::read);
+    size_t pitch_shared = fc_shared->getVirialArray().getPitch();
+    size_t pitch_global = fc_global->getVirialArray().getPitch();
+
+    // both paths read the same table entries and do the same arithmetic
+    const Scalar tol_same = Scalar(1e-4);
+    Scalar max_force(0.0);
+    for (unsigned int i = 0; i < 100; i++)
+        {
+        MY_CHECK_SMALL(h_force_shared.data[i].x - h_force_global.data[i].x, tol_same);
+        MY_CHECK_SMALL(h_force_shared.data[i].y - h_force_global.data[i].y, tol_same);
+        MY_CHECK_SMALL(h_force_shared.data[i].z - h_force_global.data[i].z, tol_same);
+        MY_CHECK_SMALL(h_force_shared.data[i].w - h_force_global.data[i].w, tol_same);
+        for (unsigned int k = 0; k < 6; k++)
+            MY_CHECK_SMALL(h_virial_shared.data[k * pitch_shared + i]
+                               - h_virial_global.data[k * pitch_global + i],
+                           tol_same);
+        max_force = std::max(max_force, std::abs(h_force_shared.data[i].x));
+        }
+
+    // the chain is not at rest, so the comparison is not between zeros
+    UP_ASSERT(max_force > Scalar(0.1));
+    }
 #endif
@@ -8,6 +8,8 @@
 
 HOOMD_UP_MAIN();
 
+#include "hoomd/md/EvaluatorPairLJ.h"
+#include "hoomd/md/EvaluatorWalls.h"
 #include "hoomd/md/WallData.h"
 
 #include <cstdlib>
@@ -273,3 +275,74 @@ UP_TEST(plane_wall_math)
     MY_CHECK_SMALL(vx.z, tol_small);
     MY_CHECK_SMALL(dx, tol_small);
     }
+
+UP_TEST(wall_grid_culling)
+    {
+    // a box shaped pore with a spherical cavity and a cylindrical obstacle
+    wall_type walls;
+    walls.numSpheres = 1;
+    walls.numCylinders = 1;
+    walls.numPlanes = 6;
+    walls.Spheres[0] = SphereWall(4.0, make_scalar3(2.0, 1.0, 0.0), false);
+    walls.Cylinders[0]
+        = CylinderWall(3.0, make_scalar3(-3.0, 0.0, 0.0), make_scalar3(1.0, 1.0, 0.0), false);
+    walls.Planes[0] = PlaneWall(make_scalar3(-9.0, 0.0, 0.0), make_scalar3(1.0, 0.0, 0.0), true);
+    walls.Planes[1] = PlaneWall(make_scalar3(9.0, 0.0, 0.0), make_scalar3(-1.0, 0.0, 0.0), true);
+    walls.Planes[2] = PlaneWall(make_scalar3(0.0, -9.0, 0.0), make_scalar3(0.0, 1.0, 0.0), true);
+    walls.Planes[3] = PlaneWall(make_scalar3(0.0, 9.0, 0.0), make_scalar3(0.0, -1.0, 0.0), true);
+    walls.Planes[4] = PlaneWall(make_scalar3(0.0, 0.0, -9.0), make_scalar3(0.0, 0.0, 1.0), true);
+    walls.Planes[5] = PlaneWall(make_scalar3(0.0, 0.0, 9.0), make_scalar3(0.0, 0.0, -1.0), true);
+
+    // one type in normal mode and one in extrapolated mode
+    typedef EvaluatorWalls<EvaluatorPairLJ> Evaluator;
+    Evaluator::param_type params[2];
+    params[0] = make_wall_params<EvaluatorPairLJ>(EvaluatorPairLJ::param_type(1.0, 1.0),
+                                                  Scalar(2.5 * 2.5),
+                                                  Scalar(0.0));
+    params[1] = make_wall_params<EvaluatorPairLJ>(EvaluatorPairLJ::param_type(1.0, 1.5),
+                                                  Scalar(3.0 * 3.0),
+                                                  Scalar(0.5));
+
+    BoxDim box(20.0, 0.1, 0.2, 0.0);
+    uint3 grid_dim;
+    std::vector<unsigned int> grid;
+    Evaluator::buildFieldGrid(walls, params, 2, box, 3, grid_dim, grid);
+    UP_ASSERT(grid_dim.x > 1 && grid_dim.y > 1 && grid_dim.z > 1);
+
+    // some walls are culled
+    unsigned int n_cells = grid_dim.x * grid_dim.y * grid_dim.z;
+    unsigned int n_bits = 0;
+    for (unsigned int word : grid)
+        for (unsigned int bit = 0; bit < 32; bit++)
+            n_bits += (word >> bit) & 1;
+    UP_ASSERT(n_bits < 2 * n_cells * 8);
+
+    // evaluating the walls in the cell of a particle gives the same result as all walls
+    srand(12345);
+    for (unsigned int n = 0; n < 1000; n++)
+        {
+        Scalar3 f = make_scalar3(Scalar(rand()) / Scalar(RAND_MAX),
+                                 Scalar(rand()) / Scalar(RAND_MAX),
+                                 Scalar(rand()) / Scalar(RAND_MAX));
+        Scalar3 pos = box.makeCoordinates(f);
+
+        for (unsigned int type = 0; type < 2; type++)
+            {
+            Scalar3 F_all, F_grid;
+            Scalar energy_all, energy_grid;
+            Scalar virial_all[6], virial_grid[6];
+
+            Evaluator eval_all(pos, box, params[type], walls);
+            eval_all.evalForceEnergyAndVirial(F_all, energy_all, virial_all);
+
+            Evaluator eval_grid(pos, box, params[type], walls);
+            eval_grid.setFieldGrid(box, grid.data(), grid_dim, type);
+            eval_grid.evalForceEnergyAndVirial(F_grid, energy_grid, virial_grid);
+
+            UP_ASSERT_EQUAL(F_all.x, F_grid.x);
+            UP_ASSERT_EQUAL(F_all.y, F_grid.y);
+            UP_ASSERT_EQUAL(F_all.z, F_grid.z);
+            UP_ASSERT_EQUAL(energy_all, energy_grid);
+            }
+        }
+    }
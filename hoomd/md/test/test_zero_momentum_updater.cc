@@ -9,6 +9,9 @@
 #include <memory>
 
 #include "hoomd/md/ZeroMomentumUpdater.h"
+#ifdef ENABLE_HIP
+#include "hoomd/md/ZeroMomentumUpdaterGPU.h"
+#endif
 
 #include <math.h>
 
@@ -23,10 +26,12 @@ HOOMD_UP_MAIN();
 */
 
 //! test case to verify proper operation of ZeroMomentumUpdater
-UP_TEST(ZeroMomentumUpdater_basic)
+template<class ZM>
+void zero_momentum_updater_basic(std::shared_ptr<ExecutionConfiguration> exec_conf)
     {
     // create a simple particle data to test with
-    std::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(2, BoxDim(1000.0), 4));
+    std::shared_ptr<SystemDefinition> sysdef(
+        new SystemDefinition(2, BoxDim(1000.0), 4, 0, 0, 0, 0, exec_conf));
     std::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
 
         {
@@ -48,7 +53,7 @@ UP_TEST(ZeroMomentumUpdater_basic)
         }
 
     // construct the updater and make sure everything is set properly
-    std::shared_ptr<ZeroMomentumUpdater> zerop(new ZeroMomentumUpdater(sysdef));
+    std::shared_ptr<ZeroMomentumUpdater> zerop(new ZM(sysdef));
 
     // run the updater and check the new temperature
     zerop->update(0);
@@ -83,3 +88,19 @@ UP_TEST(ZeroMomentumUpdater_basic)
     MY_CHECK_SMALL(avg_py, tol_small);
     MY_CHECK_SMALL(avg_pz, tol_small);
     }
+
+//! ZeroMomentumUpdater on the CPU
+UP_TEST(ZeroMomentumUpdater_basic)
+    {
+    zero_momentum_updater_basic<ZeroMomentumUpdater>(std::shared_ptr<ExecutionConfiguration>(
+        new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+
+#ifdef ENABLE_HIP
+//! ZeroMomentumUpdaterGPU on the GPU
+UP_TEST(ZeroMomentumUpdaterGPU_basic)
+    {
+    zero_momentum_updater_basic<ZeroMomentumUpdaterGPU>(std::shared_ptr<ExecutionConfiguration>(
+        new ExecutionConfiguration(ExecutionConfiguration::GPU)));
+    }
+#endif
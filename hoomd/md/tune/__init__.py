@@ -0,0 +1,7 @@
+# Copyright (c) 2009-2021 The Regents of the University of Michigan
+# This file is part of the HOOMD-blue project, released under the BSD 3-Clause
+# License.
+
+"""Tuners for MD."""
+
+from hoomd.md.tune.nlist_buffer import NeighborListBuffer
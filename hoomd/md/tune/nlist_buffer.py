@@ -0,0 +1,194 @@
+# Copyright (c) 2009-2021 The Regents of the University of Michigan
+# This file is part of the HOOMD-blue project, released under the BSD 3-Clause
+# License.
+
+"""Implement NeighborListBuffer."""
+
+from hoomd.custom import _InternalAction
+from hoomd.data.parameterdicts import ParameterDict
+from hoomd.data.typeconverter import OnlyTypes
+from hoomd.logging import log
+from hoomd.tune import _InternalCustomTuner
+from hoomd.md.integrate import Integrator
+from hoomd.md.nlist import NList
+
+
+class _InternalNeighborListBuffer(_InternalAction):
+    """Internal class for the NeighborListBuffer tuner."""
+
+    def __init__(self, nlist, maximum_buffer, step, tol):
+        param_dict = ParameterDict(
+            nlist=OnlyTypes(NList),
+            maximum_buffer=OnlyTypes(float, postprocess=self._reset_search),
+            step=OnlyTypes(float, postprocess=self._reset_search),
+            tol=OnlyTypes(float, postprocess=self._reset_search))
+        self._param_dict.update(param_dict)
+        self.nlist = nlist
+        self.maximum_buffer = maximum_buffer
+        self.step = step
+        self.tol = tol
+
+        self._simulation = None
+        self._reset_search()
+
+    def attach(self, simulation):
+        if not isinstance(simulation.operations.integrator, Integrator):
+            raise RuntimeError(
+                "NeighborListBuffer can only be used in MD simulations.")
+        self._simulation = simulation
+        self._reset_search()
+
+    @property
+    def _attached(self):
+        return self._simulation is not None
+
+    def detach(self):
+        self._simulation = None
+
+    @log
+    def tuned(self):
+        """bool: Whether or not the buffer is considered tuned.
+
+        The buffer is tuned once the search step falls below `tol`. Changing
+        any parameter of the tuner restarts the search.
+        """
+        return self._tuned
+
+    @log
+    def best_cost(self):
+        """float: The lowest time per step measured so far \
+        :math:`[\\mathrm{s}]`."""
+        if self._best_cost is None:
+            return 0.0
+        return self._best_cost
+
+    def act(self, timestep=None):
+        """Measure the time per step and choose the next buffer to try.
+
+        Args:
+            timestep (`int`, optional): Current simulation timestep.
+        """
+        if not self._attached or self._tuned:
+            return
+
+        cost, build_fraction = self._measure(timestep)
+        if cost is None:
+            return
+
+        buffer = self.nlist.buffer
+        if self._best_cost is None:
+            self._best_buffer = buffer
+            self._best_cost = cost
+            # Smaller buffers cost less per pair evaluation and larger buffers
+            # cost less per step in builds. Start in the direction that reduces
+            # the larger of the two.
+            self._direction = 1 if build_fraction > 0.5 else -1
+        elif cost < self._best_cost:
+            self._best_buffer = buffer
+            self._best_cost = cost
+        else:
+            self._direction = -self._direction
+            self._current_step /= 2
+
+        self._propose()
+
+    def _propose(self):
+        """Set the buffer to the next trial value or finish the search."""
+        while self._current_step >= self.tol:
+            buffer = self._best_buffer + self._direction * self._current_step
+            if 0 <= buffer <= self.maximum_buffer:
+                self.nlist.buffer = buffer
+                return
+            # The trial is outside the domain, search the other side.
+            self._direction = -self._direction
+            self._current_step /= 2
+
+        self.nlist.buffer = self._best_buffer
+        self._tuned = True
+
+    def _measure(self, timestep):
+        """Get the time per step and the fraction spent building the list.
+
+        Returns ``(None, None)`` when there is no valid measurement since the
+        last call, which happens on the first call and after a new run resets
+        the operation timers.
+        """
+        simulation = self._simulation
+        start = simulation._cpp_sys.start_timestep
+        mpi_conf = simulation.device.communicator.cpp_mpi_conf
+        integrator_time = mpi_conf.allReduceMax(
+            simulation.operations.integrator._cpp_obj.getRunTime())
+        nlist_time = mpi_conf.allReduceMax(self.nlist._cpp_obj.getRunTime())
+
+        previous = self._previous
+        self._previous = (start, timestep, integrator_time, nlist_time)
+        if (previous is None or previous[0] != start or timestep <= previous[1]
+                or integrator_time <= previous[2]):
+            return None, None
+
+        steps = timestep - previous[1]
+        cost = (integrator_time - previous[2]) / steps
+        build_fraction = (nlist_time - previous[3]) / (integrator_time
+                                                       - previous[2])
+        return cost, build_fraction
+
+    def _reset_search(self, value=None):
+        self._tuned = False
+        self._best_buffer = None
+        self._best_cost = None
+        self._direction = 1
+        self._current_step = getattr(self, 'step', None)
+        self._previous = None
+        return value
+
+
+class NeighborListBuffer(_InternalCustomTuner):
+    """Tunes the neighbor list buffer to minimize the time per step.
+
+    Args:
+        trigger (hoomd.trigger.Trigger): ``Trigger`` to determine when to run
+            the tuner.
+        nlist (hoomd.md.nlist.NList): Neighbor list to tune.
+        maximum_buffer (float): The largest buffer to try
+            :math:`[\\mathrm{length}]`.
+        step (float): The initial change in the buffer between trials
+            :math:`[\\mathrm{length}]`.
+        tol (float): The search stops when the change in the buffer between
+            trials falls below ``tol`` :math:`[\\mathrm{length}]`.
+
+    `NeighborListBuffer` measures the time per step the integrator spends
+    between consecutive triggers, including the force computations and the
+    neighbor list builds, then sets the next buffer to try. Larger buffers
+    rebuild the neighbor list less often but evaluate more pairs per step, and
+    on multiple MPI ranks they communicate more ghost particles. The tuner keeps
+    moving the buffer by ``step`` while the time per step decreases, then
+    reverses direction and halves ``step``. It starts by growing the buffer
+    when building the neighbor list takes more than half of the time per step
+    and by shrinking it otherwise. When the search ends, the tuner sets the
+    buffer with the lowest time per step and stops acting.
+
+    The time between triggers should span many neighbor list builds so that
+    each measurement averages over the rebuild cycle. The
+    `hoomd.md.nlist.NList.mean_rebuild_period` loggable quantity gives the
+    typical time between builds. Each rank measures its own times and the tuner
+    uses the largest, so every rank chooses the same buffer.
+
+    Attributes:
+        trigger (hoomd.trigger.Trigger): ``Trigger`` to determine when to run
+            the tuner.
+        nlist (hoomd.md.nlist.NList): Neighbor list to tune.
+        maximum_buffer (float): The largest buffer to try
+            :math:`[\\mathrm{length}]`.
+        step (float): The initial change in the buffer between trials
+            :math:`[\\mathrm{length}]`.
+        tol (float): The search stops when the change in the buffer between
+            trials falls below ``tol`` :math:`[\\mathrm{length}]`.
+
+    Note:
+        Measured times vary from one trigger to the next. Wait for `tuned` and
+        remove the tuner from the simulation before production runs.
+    """
+    _internal_class = _InternalNeighborListBuffer
+
+    def __init__(self, trigger, nlist, maximum_buffer, step=0.1, tol=0.01):
+        super().__init__(trigger, nlist, maximum_buffer, step, tol)
@@ -41,8 +41,12 @@ class ZeroMomentum(Updater):
 
     def _attach(self):
         # create the c++ mirror class
-        self._cpp_obj = _md.ZeroMomentumUpdater(
-            self._simulation.state._cpp_sys_def)
+        if isinstance(self._simulation.device, hoomd.device.CPU):
+            self._cpp_obj = _md.ZeroMomentumUpdater(
+                self._simulation.state._cpp_sys_def)
+        else:
+            self._cpp_obj = _md.ZeroMomentumUpdaterGPU(
+                self._simulation.state._cpp_sys_def)
         super()._attach()
 
 
@@ -244,6 +248,9 @@ class ActiveRotationalDiffusion(Updater):
     The rotational diffusion is applied to the orientation quaternion
     of each particle. When used with `hoomd.md.force.ActiveOnManifold`,
     rotational diffusion is performed in the tangent plane of the manifold.
+    The updater applies the rotation when the active force is next computed
+    in the same timestep, in the same pass over the particles that sets the
+    active forces.
 
     Tip:
         Use `hoomd.md.force.Active.create_diffusion_updater` to construct
@@ -298,3 +305,98 @@ class ActiveRotationalDiffusion(Updater):
         if attr == "active_force":
             raise ValueError("active_force is not settable after construction.")
         super()._setattr_param(attr, value)
+
+
+class ReplicaExchange(Updater):
+    r"""Exchange temperatures between replicas in separate partitions.
+
+    Args:
+        trigger (hoomd.trigger.Trigger): Select the timesteps to attempt swaps.
+        kT (hoomd.variant.Constant): Temperature of this replica
+            :math:`[\mathrm{energy}]`. Pass the same object as ``kT`` to the
+            integration methods.
+        kT_ladder (list[float]): Temperature of each slot of the ladder, one per
+            partition :math:`[\mathrm{energy}]`.
+
+    `ReplicaExchange` performs temperature replica exchange (parallel
+    tempering) between the partitions of a `hoomd.communicator.Communicator`.
+    Each partition simulates one replica, which starts in slot
+    `hoomd.communicator.Communicator.partition` of *kT_ladder*. On the time
+    steps selected by *trigger*, `ReplicaExchange` attempts to swap the
+    replicas in neighboring slots :math:`i` and :math:`j = i + 1` with the
+    probability:
+
+    .. math::
+
+        p = \min\left(1, \exp\left[\left(\frac{1}{kT_i} - \frac{1}{kT_j}
+            \right) \left(U_i - U_j\right)\right]\right)
+
+    where :math:`U` is the potential energy of the replica. Attempts alternate
+    between the even and odd pairs of slots.
+
+    Swaps exchange only temperatures. All ranks share the slot and potential
+    energy of their replica in one small collective, and particle data never
+    leaves its partition. When a replica changes slots, `ReplicaExchange` sets
+    ``kT.value`` to the temperature of the new slot and scales the particle
+    velocities and angular momenta by :math:`\sqrt{kT_\mathrm{new} /
+    kT_\mathrm{old}}`.
+
+    Examples::
+
+        communicator = hoomd.communicator.Communicator(ranks_per_partition=1)
+        device = hoomd.device.CPU(communicator=communicator)
+        # ...
+        kT = hoomd.variant.Constant(1.0)
+        langevin = hoomd.md.methods.Langevin(filter=hoomd.filter.All(), kT=kT)
+        integrator.methods.append(langevin)
+        replica_exchange = hoomd.md.update.ReplicaExchange(
+            trigger=hoomd.trigger.Periodic(200),
+            kT=kT,
+            kT_ladder=[1.0, 1.2, 1.44, 1.73])
+        sim.operations.updaters.append(replica_exchange)
+
+    Note:
+        Every partition must add a `ReplicaExchange` with the same *trigger*
+        and *kT_ladder* and run the same number of steps.
+
+    Attributes:
+        trigger (hoomd.trigger.Trigger): Select the timesteps to attempt swaps.
+        kT (hoomd.variant.Constant): Temperature of this replica
+            :math:`[\mathrm{energy}]`.
+        kT_ladder (tuple[float]): Temperature of each slot of the ladder
+            :math:`[\mathrm{energy}]`.
+    """
+
+    def __init__(self, trigger, kT, kT_ladder):
+        super().__init__(trigger)
+        param_dict = ParameterDict(kT=hoomd.variant.Constant,
+                                   kT_ladder=[float])
+        param_dict["kT"] = kT
+        param_dict["kT_ladder"] = kT_ladder
+        self._param_dict.update(param_dict)
+
+    def _attach(self):
+        if isinstance(self._simulation.device, hoomd.device.CPU):
+            thermo_cls = _md.ComputeThermo
+        else:
+            thermo_cls = _md.ComputeThermoGPU
+        group = self._simulation.state._get_group(hoomd.filter.All())
+        thermo = thermo_cls(self._simulation.state._cpp_sys_def, group)
+        self._cpp_obj = _md.ReplicaExchangeUpdater(
+            self._simulation.state._cpp_sys_def, thermo, self.kT,
+            list(self.kT_ladder))
+        super()._attach()
+
+    @log(requires_run=True)
+    def slot(self):
+        """int: Slot of *kT_ladder* that this replica occupies."""
+        return self._cpp_obj.slot
+
+    @log(category='sequence', requires_run=True)
+    def acceptance(self):
+        """list[float]: Fraction of accepted swaps between slots ``i`` and \
+        ``i + 1``."""
+        return [
+            accepted / attempted if attempted > 0 else 0.0 for accepted,
+            attempted in zip(self._cpp_obj.accepted, self._cpp_obj.attempted)
+        ]
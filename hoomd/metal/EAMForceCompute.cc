@@ -139,27 +139,27 @@ void EAMForceCompute::loadFile(char* filename, int type_of_file)
         }
 
     // allocate potential data storage
-    GPUArray<Scalar4> t_F(nrho * m_ntypes, m_exec_conf);
+    GlobalArray<Scalar4> t_F(nrho * m_ntypes, m_exec_conf);
     m_F.swap(t_F);
     ArrayHandle<Scalar4> h_F(m_F, access_location::host, access_mode::readwrite);
 
-    GPUArray<Scalar4> t_rho(nr * m_ntypes * m_ntypes, m_exec_conf);
+    GlobalArray<Scalar4> t_rho(nr * m_ntypes * m_ntypes, m_exec_conf);
     m_rho.swap(t_rho);
     ArrayHandle<Scalar4> h_rho(m_rho, access_location::host, access_mode::readwrite);
 
-    GPUArray<Scalar4> t_rphi((int)(0.5 * nr * (m_ntypes + 1) * m_ntypes), m_exec_conf);
+    GlobalArray<Scalar4> t_rphi((int)(0.5 * nr * (m_ntypes + 1) * m_ntypes), m_exec_conf);
     m_rphi.swap(t_rphi);
     ArrayHandle<Scalar4> h_rphi(m_rphi, access_location::host, access_mode::readwrite);
 
-    GPUArray<Scalar4> t_dF(nrho * m_ntypes, m_exec_conf);
+    GlobalArray<Scalar4> t_dF(nrho * m_ntypes, m_exec_conf);
     m_dF.swap(t_dF);
     ArrayHandle<Scalar4> h_dF(m_dF, access_location::host, access_mode::readwrite);
 
-    GPUArray<Scalar4> t_drho(nr * m_ntypes * m_ntypes, m_exec_conf);
+    GlobalArray<Scalar4> t_drho(nr * m_ntypes * m_ntypes, m_exec_conf);
     m_drho.swap(t_drho);
     ArrayHandle<Scalar4> h_drho(m_drho, access_location::host, access_mode::readwrite);
 
-    GPUArray<Scalar4> t_drphi((int)(0.5 * nr * (m_ntypes + 1) * m_ntypes), m_exec_conf);
+    GlobalArray<Scalar4> t_drphi((int)(0.5 * nr * (m_ntypes + 1) * m_ntypes), m_exec_conf);
     m_drphi.swap(t_drphi);
     ArrayHandle<Scalar4> h_drphi(m_drphi, access_location::host, access_mode::readwrite);
 
@@ -350,6 +350,11 @@ void EAMForceCompute::computeForces(uint64_t timestep)
     assert(h_rphi.data);
     assert(h_drphi.data);
 
+    // separations and neighbor types stored by the density pass, if enabled
+    resizePairCache();
+    ArrayHandle<Scalar4> h_pair_cache(m_pair_cache, access_location::host, access_mode::readwrite);
+    Scalar4* pair_cache = m_pair_cache_enabled ? h_pair_cache.data : nullptr;
+
     // Zero data for force calculation.
     memset((void*)h_force.data, 0, sizeof(Scalar4) * m_force.getNumElements());
     memset((void*)h_virial.data, 0, sizeof(Scalar) * m_virial.getNumElements());
@@ -407,6 +412,10 @@ void EAMForceCompute::computeForces(uint64_t timestep)
             // apply periodic boundary conditions
             dx = box.minImage(dx);
 
+            // store the separation for the force pass
+            if (pair_cache)
+                pair_cache[head_i + j] = make_scalar4(dx.x, dx.y, dx.z, __int_as_scalar(typej));
+
             // start computing the force
             // calculate r squared
             Scalar rsq = dot(dx, dx);
@@ -485,18 +494,30 @@ void EAMForceCompute::computeForces(uint64_t timestep)
             // sanity check
             assert(k < m_pdata->getN());
 
-            // calculate \Delta r
-            Scalar3 pk = make_scalar3(h_pos.data[k].x, h_pos.data[k].y, h_pos.data[k].z);
-            Scalar3 dx = pi - pk;
+            Scalar3 dx;
+            unsigned int typej;
+            if (pair_cache)
+                {
+                // reuse the separation from the density pass
+                const Scalar4 cached = pair_cache[head_i + j];
+                dx = make_scalar3(cached.x, cached.y, cached.z);
+                typej = __scalar_as_int(cached.w);
+                }
+            else
+                {
+                // calculate \Delta r
+                Scalar3 pk = make_scalar3(h_pos.data[k].x, h_pos.data[k].y, h_pos.data[k].z);
+                dx = pi - pk;
 
-            // access the type of the neighbor particle
-            unsigned int typej = __scalar_as_int(h_pos.data[k].w);
+                // access the type of the neighbor particle
+                typej = __scalar_as_int(h_pos.data[k].w);
+
+                // apply periodic boundary conditions
+                dx = box.minImage(dx);
+                }
             // sanity check
             assert(typej < m_pdata->getNTypes());
 
-            // apply periodic boundary conditions
-            dx = box.minImage(dx);
-
             // start computing the force
             // calculate r squared
             Scalar rsq = dot(dx, dx);
@@ -577,6 +598,19 @@ void EAMForceCompute::computeForces(uint64_t timestep)
         m_prof->pop(flops, mem_transfer);
     }
 
+void EAMForceCompute::resizePairCache()
+    {
+    if (!m_pair_cache_enabled)
+        return;
+
+    const size_t n_entries = m_nlist->getNListArray().getNumElements();
+    if (m_pair_cache.getNumElements() < n_entries)
+        {
+        GlobalArray<Scalar4> pair_cache(n_entries, m_exec_conf);
+        m_pair_cache.swap(pair_cache);
+        }
+    }
+
 void EAMForceCompute::set_neighbor_list(std::shared_ptr<NeighborList> nlist)
     {
     m_nlist = nlist;
@@ -594,5 +628,6 @@ void export_EAMForceCompute(py::module& m)
                                                                                 "EAMForceCompute")
         .def(py::init<std::shared_ptr<SystemDefinition>, char*, int>())
         .def("set_neighbor_list", &EAMForceCompute::set_neighbor_list)
-        .def("get_r_cut", &EAMForceCompute::get_r_cut);
+        .def("get_r_cut", &EAMForceCompute::get_r_cut)
+        .def_property("pair_cache", &EAMForceCompute::getPairCache, &EAMForceCompute::setPairCache);
     }
@@ -5,6 +5,7 @@
 // Previous Maintainer: Morozov
 
 #include "hoomd/ForceCompute.h"
+#include "hoomd/GlobalArray.h"
 #include "hoomd/md/NeighborList.h"
 
 #include <memory>
@@ -33,7 +34,7 @@
  coefficients.
 
  \b Potential memory layout
- The potential data and the coefficients are stored in six GPUArray<Scalar> arrays: the embedded
+ The potential data and the coefficients are stored in six GlobalArray<Scalar4> arrays: the embedded
  potential function (m_F) and its derivative (m_dF), the electron density function (m_rho) and its
  derivative (m_drho), the pair potential function (m_rphi) and its derivative (m_drphi). The 3
  coefficients for a data point is stored continuously, for example, h_F.data[100].w is the embedded
@@ -42,6 +43,13 @@
  h_dF.data[100].z, h_dF.data[100].y, h_dF.data[100].x, are for interpolating derivative embedded
  function.
 
+ \b Pair cache
+ The electron density pass and the force pass visit the same neighbor pairs. When the pair cache is
+ enabled, the density pass stores the minimum image separation and the neighbor type of every
+ neighbor list entry in m_pair_cache, indexed like the neighbor list, and the force pass reads them
+ back instead of loading the neighbor position and applying the periodic boundary conditions
+ again. This trades one Scalar4 per neighbor list entry for the second gather of positions.
+
  \ingroup computes
  */
 class EAMForceCompute : public ForceCompute
@@ -62,6 +70,24 @@ class EAMForceCompute : public ForceCompute
     //! Load EAM potential file
     virtual void loadFile(char* filename, int type_of_file);
 
+    //! Set whether the force pass reuses the pair separations of the density pass
+    void setPairCache(bool pair_cache)
+        {
+        m_pair_cache_enabled = pair_cache;
+        if (!pair_cache)
+            {
+            // release the memory
+            GlobalArray<Scalar4> pair_cache_array;
+            m_pair_cache.swap(pair_cache_array);
+            }
+        }
+
+    //! Get whether the force pass reuses the pair separations of the density pass
+    bool getPairCache()
+        {
+        return m_pair_cache_enabled;
+        }
+
     protected:
     std::shared_ptr<NeighborList> m_nlist; //!< the neighborlist to use for the computation
     Scalar m_r_cut;                        //!< cut-off radius
@@ -79,13 +105,19 @@ class EAMForceCompute : public ForceCompute
     std::vector<std::string> atomcomment; //!< atom comment
     std::vector<std::string> names;       //!< array names(type)
 
-    GPUArray<Scalar4> m_F;     //!< embedded function and its coefficients
-    GPUArray<Scalar4> m_rho;   //!< electron density and its coefficients
-    GPUArray<Scalar4> m_rphi;  //!< pair wise function and its coefficients
-    GPUArray<Scalar4> m_dF;    //!< derivative embedded function and its coefficients
-    GPUArray<Scalar4> m_drho;  //!< derivative electron density and its coefficients
-    GPUArray<Scalar4> m_drphi; //!< derivative pair wise function and its coefficients
-    GPUArray<Scalar> m_dFdP;   //!< derivative F / derivative P
+    GlobalArray<Scalar4> m_F;     //!< embedded function and its coefficients
+    GlobalArray<Scalar4> m_rho;   //!< electron density and its coefficients
+    GlobalArray<Scalar4> m_rphi;  //!< pair wise function and its coefficients
+    GlobalArray<Scalar4> m_dF;    //!< derivative embedded function and its coefficients
+    GlobalArray<Scalar4> m_drho;  //!< derivative electron density and its coefficients
+    GlobalArray<Scalar4> m_drphi; //!< derivative pair wise function and its coefficients
+    GlobalArray<Scalar> m_dFdP;   //!< derivative F / derivative P
+
+    bool m_pair_cache_enabled = false; //!< True when the pair cache is used
+    GlobalArray<Scalar4> m_pair_cache; //!< Separation and neighbor type per neighbor list entry
+
+    //! Grow the pair cache to the size of the neighbor list
+    void resizePairCache();
 
     //! Actually compute the forces
     virtual void computeForces(uint64_t timestep);
@@ -35,13 +35,33 @@ EAMForceComputeGPU::EAMForceComputeGPU(std::shared_ptr<SystemDefinition> sysdef,
         throw std::runtime_error("Error initializing EAMForceComputeGPU");
         }
 
-    unsigned int warp_size = m_exec_conf->dev_prop.warpSize;
-    unsigned int max_threads = m_exec_conf->dev_prop.maxThreadsPerBlock;
-    m_tuner.reset(
-        new Autotuner(warp_size, max_threads, warp_size, 5, 100000, "pair_eam", this->m_exec_conf));
-
     // allocate the coefficients data on the GPU
     loadFile(filename, type_of_file);
+
+    // the interpolation tables read in the neighbor loops of the two kernels
+    const size_t n_rho = size_t(nr) * m_ntypes * m_ntypes;
+    const size_t n_rphi = size_t(nr) * m_ntypes * (m_ntypes + 1) / 2;
+    m_shared_bytes_density = n_rho * sizeof(Scalar4);
+    m_shared_bytes_forces = (2 * n_rphi + n_rho) * sizeof(Scalar4);
+    const bool tables_fit = m_shared_bytes_forces + sizeof(EAMTexInterData)
+                            <= m_exec_conf->dev_prop.sharedMemPerBlock;
+
+    // initialize autotuner
+    // the table location and block size are searched with coordinate descent, encoded as
+    // shared_tables*10000 + block_size
+    std::vector<unsigned int> valid_params;
+    const unsigned int warp_size = m_exec_conf->dev_prop.warpSize;
+    const unsigned int max_threads = m_exec_conf->dev_prop.maxThreadsPerBlock;
+    for (unsigned int shared_tables = 0; shared_tables < (tables_fit ? 2 : 1); ++shared_tables)
+        {
+        for (unsigned int block_size = warp_size; block_size <= max_threads;
+             block_size += warp_size)
+            {
+            valid_params.push_back(shared_tables * 10000 + block_size);
+            }
+        }
+    m_tuner.reset(new Autotuner(valid_params, 5, 100000, "pair_eam", this->m_exec_conf));
+    m_tuner->setDimensions({10000, 1});
     GlobalArray<EAMTexInterData> eam_data(1, m_exec_conf);
     std::swap(eam_data, m_eam_data);
 
@@ -106,23 +126,64 @@ void EAMForceComputeGPU::computeForces(uint64_t timestep)
     ArrayHandle<Scalar4> d_drphi(m_drphi, access_location::device, access_mode::read);
     ArrayHandle<EAMTexInterData> d_eam_data(m_eam_data, access_location::device, access_mode::read);
 
-    // Derivative Embedding Function for each atom
-    GPUArray<Scalar> t_dFdP(m_pdata->getN(), m_exec_conf);
-    m_dFdP.swap(t_dFdP);
+    // Derivative Embedding Function for each atom, read across GPUs by the force pass
+    if (m_dFdP.getNumElements() < m_pdata->getN())
+        {
+        GlobalArray<Scalar> t_dFdP(m_pdata->getN(), m_exec_conf);
+        m_dFdP.swap(t_dFdP);
+        TAG_ALLOCATION(m_dFdP);
+        }
     ArrayHandle<Scalar> d_dFdP(m_dFdP, access_location::device, access_mode::overwrite);
 
+    // separations and neighbor types stored by the first kernel, if enabled
+    resizePairCache();
+    ArrayHandle<Scalar4> d_pair_cache(m_pair_cache,
+                                      access_location::device,
+                                      access_mode::readwrite);
+    Scalar4* pair_cache = m_pair_cache_enabled ? d_pair_cache.data : NULL;
+
     // Compute energy and forces in GPU
     m_tuner->begin();
+    const unsigned int param = m_tuner->getParam();
+    const unsigned int block_size = param % 10000;
+    const bool shared_tables = param / 10000;
+    m_exec_conf->beginMultiGPU();
+    gpu_compute_eam_tex_inter_density(d_force.data,
+                                      d_virial.data,
+                                      m_virial.getPitch(),
+                                      d_pos.data,
+                                      box,
+                                      d_n_neigh.data,
+                                      d_nlist.data,
+                                      d_head_list.data,
+                                      d_eam_data.data,
+                                      d_dFdP.data,
+                                      d_F.data,
+                                      d_rho.data,
+                                      d_rphi.data,
+                                      d_dF.data,
+                                      d_drho.data,
+                                      d_drphi.data,
+                                      pair_cache,
+                                      block_size,
+                                      shared_tables ? m_shared_bytes_density : 0,
+                                      m_pdata->getGPUPartition());
+
+    if (m_exec_conf->isCUDAErrorCheckingEnabled())
+        CHECK_CUDA_ERROR();
+
+    // the force pass reads dF/dP of neighbors computed on other GPUs
+    m_exec_conf->endMultiGPU();
+    m_exec_conf->beginMultiGPU();
+
     gpu_compute_eam_tex_inter_forces(d_force.data,
                                      d_virial.data,
                                      m_virial.getPitch(),
-                                     m_pdata->getN(),
                                      d_pos.data,
                                      box,
                                      d_n_neigh.data,
                                      d_nlist.data,
                                      d_head_list.data,
-                                     this->m_nlist->getNListArray().getPitch(),
                                      d_eam_data.data,
                                      d_dFdP.data,
                                      d_F.data,
@@ -131,10 +192,14 @@ void EAMForceComputeGPU::computeForces(uint64_t timestep)
                                      d_dF.data,
                                      d_drho.data,
                                      d_drphi.data,
-                                     m_tuner->getParam());
+                                     pair_cache,
+                                     block_size,
+                                     shared_tables ? m_shared_bytes_forces : 0,
+                                     m_pdata->getGPUPartition());
 
     if (m_exec_conf->isCUDAErrorCheckingEnabled())
         CHECK_CUDA_ERROR();
+    m_exec_conf->endMultiGPU();
     m_tuner->end();
 
     if (m_prof)
@@ -25,6 +25,10 @@
 //! Computes EAM forces on each particle using the GPU
 /*! Calculates the same forces as EAMForceCompute, but on the GPU by using texture
  * memory(CUDAArray).
+ *
+ * When the interpolation tables read in the neighbor loops fit in shared memory, the autotuner
+ * also tries kernels that copy them to shared memory once per block, which avoids the latency of
+ * the scattered table reads from global memory.
  */
 class EAMForceComputeGPU : public EAMForceCompute
     {
@@ -48,7 +52,10 @@ class EAMForceComputeGPU : public EAMForceCompute
 
     protected:
     GlobalArray<EAMTexInterData> m_eam_data; //!< EAM parameters to be communicated
-    std::unique_ptr<Autotuner> m_tuner;      //!< autotuner for block size
+    std::unique_ptr<Autotuner> m_tuner;      //!< autotuner for block size and table location
+    size_t m_shared_bytes_density = 0;       //!< Size of the tables read by the density kernel
+    size_t m_shared_bytes_forces = 0;        //!< Size of the tables read by the force kernel
+
     //! Actually compute the forces
     virtual void computeForces(uint64_t timestep);
     };
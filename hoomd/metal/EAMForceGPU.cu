@@ -13,11 +13,37 @@
  \brief Defines GPU kernel code for calculating the EAM forces. Used by EAMForceComputeGPU.
  */
 
+//! Read one entry of an interpolation table from shared or global memory
+template<bool use_shared_tables>
+__device__ inline Scalar4 eam_table_load(const Scalar4* table, unsigned int idx)
+    {
+    if (use_shared_tables)
+        return table[idx];
+    else
+        return __ldg(table + idx);
+    }
+
+//! Copy an interpolation table into shared memory with all threads of the block
+__device__ inline void eam_table_to_shared(Scalar4* s_table, const Scalar4* d_table, unsigned int n)
+    {
+    for (unsigned int i = threadIdx.x; i < n; i += blockDim.x)
+        s_table[i] = d_table[i];
+    }
+
 //! Kernel for computing EAM forces on the GPU
+/*! \tparam use_pair_cache When true, store the separation and neighbor type of every pair in
+    d_pair_cache for gpu_kernel_2
+    \tparam use_shared_tables When true, copy the electron density table into dynamic shared
+    memory before the neighbor loop
+
+    Handles the N particles starting at \a offset.
+*/
+template<bool use_pair_cache, bool use_shared_tables>
 __global__ void gpu_kernel_1(Scalar4* d_force,
                              Scalar* d_virial,
                              const size_t virial_pitch,
                              const unsigned int N,
+                             const unsigned int offset,
                              const Scalar4* d_pos,
                              BoxDim box,
                              const unsigned int* d_n_neigh,
@@ -30,7 +56,8 @@ __global__ void gpu_kernel_1(Scalar4* d_force,
                              const Scalar4* d_drho,
                              const Scalar4* d_drphi,
                              Scalar* d_dFdP,
-                             const EAMTexInterData* d_eam_data)
+                             const EAMTexInterData* d_eam_data,
+                             Scalar4* d_pair_cache)
     {
     __shared__ EAMTexInterData eam_data_ti;
 
@@ -46,6 +73,17 @@ __global__ void gpu_kernel_1(Scalar4* d_force,
             ((int*)&eam_data_ti)[cur_offset + tidx] = ((int*)d_eam_data)[cur_offset + tidx];
             }
         }
+    __syncthreads();
+
+    const Scalar4* rho_table = d_rho;
+    if (use_shared_tables)
+        {
+        HIP_DYNAMIC_SHARED(Scalar4, s_tables)
+        const unsigned int n_rho = eam_data_ti.nr * eam_data_ti.ntypes * eam_data_ti.ntypes;
+        eam_table_to_shared(s_tables, d_rho, n_rho);
+        rho_table = s_tables;
+        __syncthreads();
+        }
 
     // start by identifying which particle we are to handle
     int idx = blockIdx.x * blockDim.x + threadIdx.x;
@@ -53,6 +91,8 @@ __global__ void gpu_kernel_1(Scalar4* d_force,
     if (idx >= N)
         return;
 
+    idx += offset;
+
     // load in the length of the list
     int n_neigh = d_n_neigh[idx];
     const unsigned int head_idx = d_head_list[idx];
@@ -104,6 +144,11 @@ __global__ void gpu_kernel_1(Scalar4* d_force,
         // apply periodic boundary conditions
         dx = box.minImage(dx);
 
+        // store the separation for the force pass
+        if (use_pair_cache)
+            d_pair_cache[head_idx + neigh_idx]
+                = make_scalar4(dx.x, dx.y, dx.z, __int_as_scalar(typej));
+
         // calculate r squared
         Scalar rsq = dot(dx, dx);
         ;
@@ -116,7 +161,7 @@ __global__ void gpu_kernel_1(Scalar4* d_force,
             remainder = position - int_position;
             // calculate P = sum{rho}
             idxs = int_position + nr * (typej * ntypes + typei);
-            v = __ldg(d_rho + idxs);
+            v = eam_table_load<use_shared_tables>(rho_table, idxs);
             atomElectronDensity += v.w + v.z * remainder + v.y * remainder * remainder
                                    + v.x * remainder * remainder * remainder;
             }
@@ -141,10 +186,21 @@ __global__ void gpu_kernel_1(Scalar4* d_force,
     }
 
 //! Second stage kernel for computing EAM forces on the GPU
+/*! \tparam use_pair_cache When true, read the separation and neighbor type of every pair from
+    d_pair_cache instead of the neighbor position
+
+    \tparam use_shared_tables When true, copy the pair potential and electron density derivative
+    tables into dynamic shared memory before the neighbor loop
+
+    Handles the N particles starting at \a offset. d_dFdP must be complete for all particles
+    before this kernel runs.
+*/
+template<bool use_pair_cache, bool use_shared_tables>
 __global__ void gpu_kernel_2(Scalar4* d_force,
                              Scalar* d_virial,
                              const size_t virial_pitch,
                              const unsigned int N,
+                             const unsigned int offset,
                              const Scalar4* d_pos,
                              BoxDim box,
                              const unsigned int* d_n_neigh,
@@ -157,7 +213,8 @@ __global__ void gpu_kernel_2(Scalar4* d_force,
                              const Scalar4* d_drho,
                              const Scalar4* d_drphi,
                              Scalar* d_dFdP,
-                             const EAMTexInterData* d_eam_data)
+                             const EAMTexInterData* d_eam_data,
+                             const Scalar4* d_pair_cache)
     {
     __shared__ EAMTexInterData eam_data_ti;
 
@@ -173,6 +230,27 @@ __global__ void gpu_kernel_2(Scalar4* d_force,
             ((int*)&eam_data_ti)[cur_offset + tidx] = ((int*)d_eam_data)[cur_offset + tidx];
             }
         }
+    __syncthreads();
+
+    const Scalar4* rphi_table = d_rphi;
+    const Scalar4* drphi_table = d_drphi;
+    const Scalar4* drho_table = d_drho;
+    if (use_shared_tables)
+        {
+        // shared memory holds the rphi, drphi, and drho tables in this order
+        HIP_DYNAMIC_SHARED(Scalar4, s_tables)
+        const unsigned int nr = eam_data_ti.nr;
+        const unsigned int ntypes = eam_data_ti.ntypes;
+        const unsigned int n_rphi = nr * ntypes * (ntypes + 1) / 2;
+        const unsigned int n_rho = nr * ntypes * ntypes;
+        eam_table_to_shared(s_tables, d_rphi, n_rphi);
+        eam_table_to_shared(s_tables + n_rphi, d_drphi, n_rphi);
+        eam_table_to_shared(s_tables + 2 * n_rphi, d_drho, n_rho);
+        rphi_table = s_tables;
+        drphi_table = s_tables + n_rphi;
+        drho_table = s_tables + 2 * n_rphi;
+        __syncthreads();
+        }
 
     // start by identifying which particle we are to handle
     int idx = blockIdx.x * blockDim.x + threadIdx.x;
@@ -180,6 +258,8 @@ __global__ void gpu_kernel_2(Scalar4* d_force,
     if (idx >= N)
         return;
 
+    idx += offset;
+
     // load in the length of the list
     int n_neigh = d_n_neigh[idx];
     const unsigned int head_idx = d_head_list[idx];
@@ -224,15 +304,27 @@ __global__ void gpu_kernel_2(Scalar4* d_force,
         cur_neigh = next_neigh;
         next_neigh = __ldg(d_nlist + head_idx + neigh_idx + 1);
 
-        // get the neighbor's position
-        Scalar4 neigh_postype = __ldg(d_pos + cur_neigh);
-        Scalar3 neigh_pos = make_scalar3(neigh_postype.x, neigh_postype.y, neigh_postype.z);
-
-        // calculate dr (with periodic boundary conditions)
-        Scalar3 dx = pos - neigh_pos;
-        int typej = __scalar_as_int(neigh_postype.w);
-        // apply periodic boundary conditions
-        dx = box.minImage(dx);
+        Scalar3 dx;
+        int typej;
+        if (use_pair_cache)
+            {
+            // reuse the separation from the density pass
+            Scalar4 cached = __ldg(d_pair_cache + head_idx + neigh_idx);
+            dx = make_scalar3(cached.x, cached.y, cached.z);
+            typej = __scalar_as_int(cached.w);
+            }
+        else
+            {
+            // get the neighbor's position
+            Scalar4 neigh_postype = __ldg(d_pos + cur_neigh);
+            Scalar3 neigh_pos = make_scalar3(neigh_postype.x, neigh_postype.y, neigh_postype.z);
+
+            // calculate dr (with periodic boundary conditions)
+            dx = pos - neigh_pos;
+            typej = __scalar_as_int(neigh_postype.w);
+            // apply periodic boundary conditions
+            dx = box.minImage(dx);
+            }
 
         // calculate r squared
         Scalar rsq = dot(dx, dx);
@@ -252,8 +344,8 @@ __global__ void gpu_kernel_2(Scalar4* d_force,
                                      : (int)(0.5 * (2 * ntypes - typei - 1) * typei + typej) * nr;
 
         idxs = int_position + shift;
-        v = __ldg(d_rphi + idxs);
-        dv = __ldg(d_drphi + idxs);
+        v = eam_table_load<use_shared_tables>(rphi_table, idxs);
+        dv = eam_table_load<use_shared_tables>(drphi_table, idxs);
         // aspair_potential = r * phi
         Scalar aspair_potential = v.w + v.z * remainder + v.y * remainder * remainder
                                   + v.x * remainder * remainder * remainder;
@@ -265,11 +357,11 @@ __global__ void gpu_kernel_2(Scalar4* d_force,
         Scalar derivativePhi = (derivative_pair_potential - pair_eng) * inverseR;
         // derivativeRhoI = drho / dr of i
         idxs = int_position + typei * ntypes * nr + typej * nr;
-        dv = __ldg(d_drho + idxs);
+        dv = eam_table_load<use_shared_tables>(drho_table, idxs);
         Scalar derivativeRhoI = dv.z + dv.y * remainder + dv.x * remainder * remainder;
         // derivativeRhoJ = drho / dr of j
         idxs = int_position + typej * ntypes * nr + typei * nr;
-        dv = __ldg(d_drho + idxs);
+        dv = eam_table_load<use_shared_tables>(drho_table, idxs);
         Scalar derivativeRhoJ = dv.z + dv.y * remainder + dv.x * remainder * remainder;
         // fullDerivativePhi = dF/dP * drho / dr for j + dF/dP * drho / dr for j + phi
         Scalar d_dFdPcur = __ldg(d_dFdP + cur_neigh);
@@ -303,17 +395,296 @@ __global__ void gpu_kernel_2(Scalar4* d_force,
         d_virial[i * virial_pitch + idx] = virial[i];
     }
 
+//! Launch one of the EAM kernels on every active GPU
+/*! \param shared_bytes Dynamic shared memory per block, used when \a use_shared_tables is true
+ */
+template<bool use_pair_cache, bool use_shared_tables, bool density_pass>
+static void gpu_launch_eam_kernel(Scalar4* d_force,
+                                  Scalar* d_virial,
+                                  const size_t virial_pitch,
+                                  const Scalar4* d_pos,
+                                  const BoxDim& box,
+                                  const unsigned int* d_n_neigh,
+                                  const unsigned int* d_nlist,
+                                  const unsigned int* d_head_list,
+                                  const EAMTexInterData* d_eam_data,
+                                  Scalar* d_dFdP,
+                                  const Scalar4* d_F,
+                                  const Scalar4* d_rho,
+                                  const Scalar4* d_rphi,
+                                  const Scalar4* d_dF,
+                                  const Scalar4* d_drho,
+                                  const Scalar4* d_drphi,
+                                  Scalar4* d_pair_cache,
+                                  const unsigned int block_size,
+                                  const size_t shared_bytes,
+                                  const GPUPartition& gpu_partition)
+    {
+    hipFuncAttributes attr;
+    if (density_pass)
+        hipFuncGetAttributes(
+            &attr,
+            reinterpret_cast<const void*>(gpu_kernel_1<use_pair_cache, use_shared_tables>));
+    else
+        hipFuncGetAttributes(
+            &attr,
+            reinterpret_cast<const void*>(gpu_kernel_2<use_pair_cache, use_shared_tables>));
+
+    unsigned int max_block_size = attr.maxThreadsPerBlock;
+    unsigned int run_block_size = min(block_size, max_block_size);
+
+    for (int idev = gpu_partition.getNumActiveGPUs() - 1; idev >= 0; --idev)
+        {
+        auto range = gpu_partition.getRangeAndSetGPU(idev);
+        unsigned int nwork = range.second - range.first;
+        if (nwork == 0)
+            continue;
+
+        // setup the grid to run the kernel
+        dim3 grid((int)ceil((double)nwork / (double)run_block_size), 1, 1);
+        dim3 threads(run_block_size, 1, 1);
+        const size_t run_shared_bytes = use_shared_tables ? shared_bytes : 0;
+
+        if (density_pass)
+            {
+            hipLaunchKernelGGL((gpu_kernel_1<use_pair_cache, use_shared_tables>),
+                               dim3(grid),
+                               dim3(threads),
+                               run_shared_bytes,
+                               0,
+                               d_force,
+                               d_virial,
+                               virial_pitch,
+                               nwork,
+                               range.first,
+                               d_pos,
+                               box,
+                               d_n_neigh,
+                               d_nlist,
+                               d_head_list,
+                               d_F,
+                               d_rho,
+                               d_rphi,
+                               d_dF,
+                               d_drho,
+                               d_drphi,
+                               d_dFdP,
+                               d_eam_data,
+                               d_pair_cache);
+            }
+        else
+            {
+            hipLaunchKernelGGL((gpu_kernel_2<use_pair_cache, use_shared_tables>),
+                               dim3(grid),
+                               dim3(threads),
+                               run_shared_bytes,
+                               0,
+                               d_force,
+                               d_virial,
+                               virial_pitch,
+                               nwork,
+                               range.first,
+                               d_pos,
+                               box,
+                               d_n_neigh,
+                               d_nlist,
+                               d_head_list,
+                               d_F,
+                               d_rho,
+                               d_rphi,
+                               d_dF,
+                               d_drho,
+                               d_drphi,
+                               d_dFdP,
+                               d_eam_data,
+                               d_pair_cache);
+            }
+        }
+    }
+
+//! Launch an EAM kernel, selecting the pair cache and shared table variants
+template<bool density_pass>
+static void gpu_dispatch_eam_kernel(Scalar4* d_force,
+                                    Scalar* d_virial,
+                                    const size_t virial_pitch,
+                                    const Scalar4* d_pos,
+                                    const BoxDim& box,
+                                    const unsigned int* d_n_neigh,
+                                    const unsigned int* d_nlist,
+                                    const unsigned int* d_head_list,
+                                    const EAMTexInterData* d_eam_data,
+                                    Scalar* d_dFdP,
+                                    const Scalar4* d_F,
+                                    const Scalar4* d_rho,
+                                    const Scalar4* d_rphi,
+                                    const Scalar4* d_dF,
+                                    const Scalar4* d_drho,
+                                    const Scalar4* d_drphi,
+                                    Scalar4* d_pair_cache,
+                                    const unsigned int block_size,
+                                    const size_t shared_bytes,
+                                    const GPUPartition& gpu_partition)
+    {
+    if (d_pair_cache && shared_bytes)
+        {
+        gpu_launch_eam_kernel<true, true, density_pass>(d_force,
+                                                        d_virial,
+                                                        virial_pitch,
+                                                        d_pos,
+                                                        box,
+                                                        d_n_neigh,
+                                                        d_nlist,
+                                                        d_head_list,
+                                                        d_eam_data,
+                                                        d_dFdP,
+                                                        d_F,
+                                                        d_rho,
+                                                        d_rphi,
+                                                        d_dF,
+                                                        d_drho,
+                                                        d_drphi,
+                                                        d_pair_cache,
+                                                        block_size,
+                                                        shared_bytes,
+                                                        gpu_partition);
+        }
+    else if (d_pair_cache)
+        {
+        gpu_launch_eam_kernel<true, false, density_pass>(d_force,
+                                                         d_virial,
+                                                         virial_pitch,
+                                                         d_pos,
+                                                         box,
+                                                         d_n_neigh,
+                                                         d_nlist,
+                                                         d_head_list,
+                                                         d_eam_data,
+                                                         d_dFdP,
+                                                         d_F,
+                                                         d_rho,
+                                                         d_rphi,
+                                                         d_dF,
+                                                         d_drho,
+                                                         d_drphi,
+                                                         d_pair_cache,
+                                                         block_size,
+                                                         shared_bytes,
+                                                         gpu_partition);
+        }
+    else if (shared_bytes)
+        {
+        gpu_launch_eam_kernel<false, true, density_pass>(d_force,
+                                                         d_virial,
+                                                         virial_pitch,
+                                                         d_pos,
+                                                         box,
+                                                         d_n_neigh,
+                                                         d_nlist,
+                                                         d_head_list,
+                                                         d_eam_data,
+                                                         d_dFdP,
+                                                         d_F,
+                                                         d_rho,
+                                                         d_rphi,
+                                                         d_dF,
+                                                         d_drho,
+                                                         d_drphi,
+                                                         d_pair_cache,
+                                                         block_size,
+                                                         shared_bytes,
+                                                         gpu_partition);
+        }
+    else
+        {
+        gpu_launch_eam_kernel<false, false, density_pass>(d_force,
+                                                          d_virial,
+                                                          virial_pitch,
+                                                          d_pos,
+                                                          box,
+                                                          d_n_neigh,
+                                                          d_nlist,
+                                                          d_head_list,
+                                                          d_eam_data,
+                                                          d_dFdP,
+                                                          d_F,
+                                                          d_rho,
+                                                          d_rphi,
+                                                          d_dF,
+                                                          d_drho,
+                                                          d_drphi,
+                                                          d_pair_cache,
+                                                          block_size,
+                                                          shared_bytes,
+                                                          gpu_partition);
+        }
+    }
+
+//! compute the electron density, embedding energy and dF/dP on GPU
+/*! \param d_pair_cache Pair cache indexed like the neighbor list, or NULL to disable it
+    \param shared_bytes Size of the tables read from shared memory, or 0 to read them from global
+    memory
+    \param gpu_partition Range of particles handled by each GPU
+ */
+hipError_t gpu_compute_eam_tex_inter_density(Scalar4* d_force,
+                                             Scalar* d_virial,
+                                             const size_t virial_pitch,
+                                             const Scalar4* d_pos,
+                                             const BoxDim& box,
+                                             const unsigned int* d_n_neigh,
+                                             const unsigned int* d_nlist,
+                                             const unsigned int* d_head_list,
+                                             const EAMTexInterData* d_eam_data,
+                                             Scalar* d_dFdP,
+                                             const Scalar4* d_F,
+                                             const Scalar4* d_rho,
+                                             const Scalar4* d_rphi,
+                                             const Scalar4* d_dF,
+                                             const Scalar4* d_drho,
+                                             const Scalar4* d_drphi,
+                                             Scalar4* d_pair_cache,
+                                             const unsigned int block_size,
+                                             const size_t shared_bytes,
+                                             const GPUPartition& gpu_partition)
+    {
+    gpu_dispatch_eam_kernel<true>(d_force,
+                                  d_virial,
+                                  virial_pitch,
+                                  d_pos,
+                                  box,
+                                  d_n_neigh,
+                                  d_nlist,
+                                  d_head_list,
+                                  d_eam_data,
+                                  d_dFdP,
+                                  d_F,
+                                  d_rho,
+                                  d_rphi,
+                                  d_dF,
+                                  d_drho,
+                                  d_drphi,
+                                  d_pair_cache,
+                                  block_size,
+                                  shared_bytes,
+                                  gpu_partition);
+    return hipSuccess;
+    }
+
 //! compute forces on GPU
+/*! \param d_pair_cache Pair cache indexed like the neighbor list, or NULL to disable it
+    \param shared_bytes Size of the tables read from shared memory, or 0 to read them from global
+    memory
+    \param gpu_partition Range of particles handled by each GPU
+
+    gpu_compute_eam_tex_inter_density must have completed on all GPUs before this is called.
+ */
 hipError_t gpu_compute_eam_tex_inter_forces(Scalar4* d_force,
                                             Scalar* d_virial,
                                             const size_t virial_pitch,
-                                            const unsigned int N,
                                             const Scalar4* d_pos,
                                             const BoxDim& box,
                                             const unsigned int* d_n_neigh,
                                             const unsigned int* d_nlist,
                                             const unsigned int* d_head_list,
-                                            const size_t size_nlist,
                                             const EAMTexInterData* d_eam_data,
                                             Scalar* d_dFdP,
                                             const Scalar4* d_F,
@@ -322,75 +693,30 @@ hipError_t gpu_compute_eam_tex_inter_forces(Scalar4* d_force,
                                             const Scalar4* d_dF,
                                             const Scalar4* d_drho,
                                             const Scalar4* d_drphi,
-                                            const unsigned int block_size)
+                                            Scalar4* d_pair_cache,
+                                            const unsigned int block_size,
+                                            const size_t shared_bytes,
+                                            const GPUPartition& gpu_partition)
     {
-    static unsigned int max_block_size_1 = UINT_MAX;
-    static unsigned int max_block_size_2 = UINT_MAX;
-
-    hipFuncAttributes attr1;
-    hipFuncGetAttributes(&attr1, reinterpret_cast<const void*>(gpu_kernel_1));
-
-    hipFuncAttributes attr2;
-    hipFuncGetAttributes(&attr2, reinterpret_cast<const void*>(gpu_kernel_2));
-
-    max_block_size_1 = attr1.maxThreadsPerBlock;
-    max_block_size_2 = attr2.maxThreadsPerBlock;
-
-    unsigned int run_block_size_1 = min(block_size, max_block_size_1);
-    unsigned int run_block_size_2 = min(block_size, max_block_size_2);
-
-    // setup the grid to run the kernel
-
-    dim3 grid_1((int)ceil((double)N / (double)run_block_size_1), 1, 1);
-    dim3 threads_1(run_block_size_1, 1, 1);
-
-    dim3 grid_2((int)ceil((double)N / (double)run_block_size_2), 1, 1);
-    dim3 threads_2(run_block_size_2, 1, 1);
-
-    hipLaunchKernelGGL(gpu_kernel_1,
-                       dim3(grid_1),
-                       dim3(threads_1),
-                       0,
-                       0,
-                       d_force,
-                       d_virial,
-                       virial_pitch,
-                       N,
-                       d_pos,
-                       box,
-                       d_n_neigh,
-                       d_nlist,
-                       d_head_list,
-                       d_F,
-                       d_rho,
-                       d_rphi,
-                       d_dF,
-                       d_drho,
-                       d_drphi,
-                       d_dFdP,
-                       d_eam_data);
-    hipLaunchKernelGGL(gpu_kernel_2,
-                       dim3(grid_2),
-                       dim3(threads_2),
-                       0,
-                       0,
-                       d_force,
-                       d_virial,
-                       virial_pitch,
-                       N,
-                       d_pos,
-                       box,
-                       d_n_neigh,
-                       d_nlist,
-                       d_head_list,
-                       d_F,
-                       d_rho,
-                       d_rphi,
-                       d_dF,
-                       d_drho,
-                       d_drphi,
-                       d_dFdP,
-                       d_eam_data);
-
+    gpu_dispatch_eam_kernel<false>(d_force,
+                                   d_virial,
+                                   virial_pitch,
+                                   d_pos,
+                                   box,
+                                   d_n_neigh,
+                                   d_nlist,
+                                   d_head_list,
+                                   d_eam_data,
+                                   d_dFdP,
+                                   d_F,
+                                   d_rho,
+                                   d_rphi,
+                                   d_dF,
+                                   d_drho,
+                                   d_drphi,
+                                   d_pair_cache,
+                                   block_size,
+                                   shared_bytes,
+                                   gpu_partition);
     return hipSuccess;
     }
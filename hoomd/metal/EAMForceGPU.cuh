@@ -4,6 +4,7 @@
 // Maintainer: Lin Yang, Alex Travesset
 // Previous Maintainer: Morozov
 
+#include "hoomd/GPUPartition.cuh"
 #include "hoomd/HOOMDMath.h"
 #include "hoomd/Index1D.h"
 #include "hoomd/ParticleData.cuh"
@@ -29,17 +30,37 @@ struct EAMTexInterData
     Scalar r_cutsq; //!< r_cut^2
     };
 
+//! Kernel driver that computes the EAM electron density and dF/dP on the GPU for EAMForceComputeGPU
+hipError_t gpu_compute_eam_tex_inter_density(Scalar4* d_force,
+                                             Scalar* d_virial,
+                                             const size_t virial_pitch,
+                                             const Scalar4* d_pos,
+                                             const BoxDim& box,
+                                             const unsigned int* d_n_neigh,
+                                             const unsigned int* d_nlist,
+                                             const unsigned int* d_head_list,
+                                             const EAMTexInterData* d_eam_data,
+                                             Scalar* d_dFdP,
+                                             const Scalar4* d_F,
+                                             const Scalar4* d_rho,
+                                             const Scalar4* d_rphi,
+                                             const Scalar4* d_dF,
+                                             const Scalar4* d_drho,
+                                             const Scalar4* d_drphi,
+                                             Scalar4* d_pair_cache,
+                                             const unsigned int block_size,
+                                             const size_t shared_bytes,
+                                             const GPUPartition& gpu_partition);
+
 //! Kernel driver that computes EAM forces on the GPU for EAMForceComputeGPU
 hipError_t gpu_compute_eam_tex_inter_forces(Scalar4* d_force,
                                             Scalar* d_virial,
                                             const size_t virial_pitch,
-                                            const unsigned int N,
                                             const Scalar4* d_pos,
                                             const BoxDim& box,
                                             const unsigned int* d_n_neigh,
                                             const unsigned int* d_nlist,
                                             const unsigned int* d_head_list,
-                                            const size_t size_nlist,
                                             const EAMTexInterData* d_eam_data,
                                             Scalar* d_dFdP,
                                             const Scalar4* d_F,
@@ -48,6 +69,9 @@ hipError_t gpu_compute_eam_tex_inter_forces(Scalar4* d_force,
                                             const Scalar4* d_dF,
                                             const Scalar4* d_drho,
                                             const Scalar4* d_drphi,
-                                            const unsigned int block_size);
+                                            Scalar4* d_pair_cache,
+                                            const unsigned int block_size,
+                                            const size_t shared_bytes,
+                                            const GPUPartition& gpu_partition);
 
 #endif
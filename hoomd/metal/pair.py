@@ -22,6 +22,8 @@ class eam(force._force):
         file (str): File name with potential tables in Alloy or FS format
         type (str): Type of file potential ('Alloy', 'FS')
         nlist (:py:mod:`hoomd.md.nlist`): Neighbor list (default of None automatically creates a global cell-list based neighbor list)
+        pair_cache (bool): Store the pair separations computed for the electron density and reuse
+          them for the forces, using one extra 4-vector of memory per neighbor list entry
 
     :py:class:`eam` specifies that a EAM (embedded atom method) pair potential should be applied between every
     non-excluded particle pair in the simulation.
@@ -49,7 +51,7 @@ class eam(force._force):
 
     """
 
-    def __init__(self, file, type, nlist):
+    def __init__(self, file, type, nlist, pair_cache=False):
         # Error out in MPI simulations
         if (hoomd.version.mpi_enabled):
             if hoomd.context.current.system_definition.getParticleData(
@@ -77,6 +79,8 @@ class eam(force._force):
             self.cpp_force = _metal.EAMForceComputeGPU(
                 hoomd.context.current.system_definition, file, type_of_file)
 
+        self.cpp_force.pair_cache = pair_cache
+
         #After load EAMForceCompute we know r_cut from EAM potential`s file. We need update neighbor list.
         self.r_cut_new = self.cpp_force.get_r_cut()
         self.nlist = nlist
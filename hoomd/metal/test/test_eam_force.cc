@@ -0,0 +1,239 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+// this include is necessary to get MPI included before anything else to support intel MPI
+#include "hoomd/ExecutionConfiguration.h"
+
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include "hoomd/Initializers.h"
+#include "hoomd/md/NeighborListTree.h"
+#include "hoomd/metal/EAMForceCompute.h"
+#ifdef ENABLE_HIP
+#include "hoomd/md/NeighborListGPUTree.h"
+#include "hoomd/metal/EAMForceComputeGPU.h"
+#endif
+
+using namespace std;
+using namespace std::placeholders;
+
+/*! \file test_eam_force.cc
+    \brief Implements unit tests for EAMForceCompute and EAMForceComputeGPU
+    \ingroup unit_tests
+*/
+
+#include "hoomd/test/upp11_config.h"
+
+HOOMD_UP_MAIN();
+
+//! Typedef'd EAMForceCompute factory
+typedef std::function<std::shared_ptr<EAMForceCompute>(std::shared_ptr<SystemDefinition> sysdef,
+                                                       char* filename)>
+    eamforce_creator;
+
+//! Typedef'd NeighborList factory
+typedef std::function<std::shared_ptr<NeighborList>(std::shared_ptr<SystemDefinition> sysdef)>
+    nlist_creator;
+
+//! Write a smooth single element EAM/Alloy potential file
+/*! \param filename File to write
+
+    The embedding function is -sqrt(rho), the electron density decays as (r_cut - r)^4 and the
+    pair term is a Morse potential shifted to zero at r_cut. The densities stay within the range of
+    the embedding table.
+*/
+void write_eam_file(const std::string& filename)
+    {
+    const unsigned int nrho = 500;
+    const double drho = 0.01;
+    const unsigned int nr = 500;
+    const double dr = 0.01;
+    const double r_cut = 4.0;
+
+    std::ofstream f(filename.c_str());
+    f << "synthetic potential for unit tests" << std::endl;
+    f << "F(rho) = -sqrt(rho), rho(r) = (r_cut - r)^4, phi(r) = shifted Morse" << std::endl;
+    f << "units metal" << std::endl;
+    f << "1 A" << std::endl;
+    f << nrho << " " << drho << " " << nr << " " << dr << " " << r_cut << std::endl;
+    f << "1 1.0 1.0 fcc" << std::endl;
+    f.precision(17);
+
+    for (unsigned int i = 0; i < nrho; i++)
+        f << -std::sqrt(i * drho) << std::endl;
+
+    for (unsigned int i = 0; i < nr; i++)
+        {
+        const double r = i * dr;
+        f << (r < r_cut ? std::pow(r_cut - r, 4) / 1000.0 : 0.0) << std::endl;
+        }
+
+    auto morse = [](double r)
+    { return std::exp(-4.0 * (r - 1.1)) - 2.0 * std::exp(-2.0 * (r - 1.1)); };
+    for (unsigned int i = 0; i < nr; i++)
+        {
+        const double r = i * dr;
+        f << (r < r_cut ? r * (morse(r) - morse(r_cut)) : 0.0) << std::endl;
+        }
+    }
+
+//! Test that the pair cache does not change the forces, energies, and virials
+void eam_pair_cache_test(eamforce_creator eam_creator,
+                         nlist_creator nlist_creator,
+                         std::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    std::string filename = "test_eam_force.eam.alloy";
+    write_eam_file(filename);
+
+    RandomInitializer init(500, Scalar(0.3), Scalar(0.9), "A");
+    init.setSeed(12345);
+    std::shared_ptr<SnapshotSystemData<Scalar>> snap = init.getSnapshot();
+    std::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(snap, exec_conf));
+    std::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+    pdata->setFlags(~PDataFlags(0));
+
+    std::shared_ptr<EAMForceCompute> fc_ref = eam_creator(sysdef, &filename[0]);
+    std::shared_ptr<EAMForceCompute> fc_cache = eam_creator(sysdef, &filename[0]);
+    fc_cache->setPairCache(true);
+    UP_ASSERT(!fc_ref->getPairCache());
+    UP_ASSERT(fc_cache->getPairCache());
+
+    std::shared_ptr<NeighborList> nlist = nlist_creator(sysdef);
+    auto r_cut = std::make_shared<GlobalArray<Scalar>>(nlist->getTypePairIndexer().getNumElements(),
+                                                       exec_conf);
+        {
+        ArrayHandle<Scalar> h_r_cut(*r_cut, access_location::host, access_mode::overwrite);
+        h_r_cut.data[0] = fc_ref->get_r_cut();
+        }
+    nlist->addRCutMatrix(r_cut);
+    fc_ref->set_neighbor_list(nlist);
+    fc_cache->set_neighbor_list(nlist);
+
+    // the second step moves the particles within the buffer so the neighbor list is reused
+    for (uint64_t timestep = 0; timestep < 2; timestep++)
+        {
+        if (timestep > 0)
+            {
+            ArrayHandle<Scalar4> h_pos(pdata->getPositions(),
+                                       access_location::host,
+                                       access_mode::readwrite);
+            ArrayHandle<int3> h_image(pdata->getImages(),
+                                      access_location::host,
+                                      access_mode::readwrite);
+            const BoxDim& box = pdata->getBox();
+            for (unsigned int i = 0; i < pdata->getN(); i++)
+                {
+                h_pos.data[i].x += Scalar(0.01) * (Scalar(i % 3) - Scalar(1.0));
+                h_pos.data[i].y += Scalar(0.005) * (Scalar(i % 5) - Scalar(2.0));
+                box.wrap(h_pos.data[i], h_image.data[i]);
+                }
+            }
+
+        fc_ref->compute(timestep);
+        fc_cache->compute(timestep);
+
+        ArrayHandle<Scalar4> h_force_ref(fc_ref->getForceArray(),
+                                         access_location::host,
+                                         access_mode::read);
+        ArrayHandle<Scalar> h_virial_ref(fc_ref->getVirialArray(),
+                                         access_location::host,
+                                         access_mode::read);
+        ArrayHandle<Scalar4> h_force_cache(fc_cache->getForceArray(),
+                                           access_location::host,
+                                           access_mode::read);
+        ArrayHandle<Scalar> h_virial_cache(fc_cache->getVirialArray(),
+                                           access_location::host,
+                                           access_mode::read);
+        size_t pitch_ref = fc_ref->getVirialArray().getPitch();
+        size_t pitch_cache = fc_cache->getVirialArray().getPitch();
+
+        // the cached separations are the ones the force pass would compute again
+        const Scalar tol = Scalar(1e-5);
+        for (unsigned int i = 0; i < pdata->getN(); i++)
+            {
+            CHECK_SMALL(h_force_cache.data[i].x - h_force_ref.data[i].x, tol);
+            CHECK_SMALL(h_force_cache.data[i].y - h_force_ref.data[i].y, tol);
+            CHECK_SMALL(h_force_cache.data[i].z - h_force_ref.data[i].z, tol);
+            CHECK_SMALL(h_force_cache.data[i].w - h_force_ref.data[i].w, tol);
+            for (unsigned int k = 0; k < 6; k++)
+                CHECK_SMALL(h_virial_cache.data[k * pitch_cache + i]
+                                - h_virial_ref.data[k * pitch_ref + i],
+                            tol);
+            }
+        }
+
+    std::remove(filename.c_str());
+    }
+
+//! EAMForceCompute creator for unit tests
+std::shared_ptr<EAMForceCompute> base_class_eam_creator(std::shared_ptr<SystemDefinition> sysdef,
+                                                        char* filename)
+    {
+    return std::shared_ptr<EAMForceCompute>(new EAMForceCompute(sysdef, filename, 0));
+    }
+
+//! NeighborListTree creator with a half neighbor list
+std::shared_ptr<NeighborList> half_nlist_creator(std::shared_ptr<SystemDefinition> sysdef)
+    {
+    return std::shared_ptr<NeighborList>(new NeighborListTree(sysdef, Scalar(0.4)));
+    }
+
+//! NeighborListTree creator with a full neighbor list
+std::shared_ptr<NeighborList> full_nlist_creator(std::shared_ptr<SystemDefinition> sysdef)
+    {
+    std::shared_ptr<NeighborList> nlist(new NeighborListTree(sysdef, Scalar(0.4)));
+    nlist->setStorageMode(NeighborList::full);
+    return nlist;
+    }
+
+#ifdef ENABLE_HIP
+//! EAMForceComputeGPU creator for unit tests
+std::shared_ptr<EAMForceCompute> gpu_eam_creator(std::shared_ptr<SystemDefinition> sysdef,
+                                                 char* filename)
+    {
+    return std::shared_ptr<EAMForceCompute>(new EAMForceComputeGPU(sysdef, filename, 0));
+    }
+
+//! NeighborListGPUTree creator for unit tests
+std::shared_ptr<NeighborList> gpu_nlist_creator(std::shared_ptr<SystemDefinition> sysdef)
+    {
+    std::shared_ptr<NeighborList> nlist(new NeighborListGPUTree(sysdef, Scalar(0.4)));
+    nlist->setStorageMode(NeighborList::full);
+    return nlist;
+    }
+#endif
+
+//! test case for the pair cache on the CPU with a half neighbor list
+UP_TEST(EAMForceCompute_pair_cache_half)
+    {
+    eam_pair_cache_test(bind(base_class_eam_creator, _1, _2),
+                        bind(half_nlist_creator, _1),
+                        std::shared_ptr<ExecutionConfiguration>(
+                            new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+
+//! test case for the pair cache on the CPU with a full neighbor list
+UP_TEST(EAMForceCompute_pair_cache_full)
+    {
+    eam_pair_cache_test(bind(base_class_eam_creator, _1, _2),
+                        bind(full_nlist_creator, _1),
+                        std::shared_ptr<ExecutionConfiguration>(
+                            new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+
+#ifdef ENABLE_HIP
+//! test case for the pair cache on the GPU
+UP_TEST(EAMForceComputeGPU_pair_cache)
+    {
+    eam_pair_cache_test(bind(gpu_eam_creator, _1, _2),
+                        bind(gpu_nlist_creator, _1),
+                        std::shared_ptr<ExecutionConfiguration>(
+                            new ExecutionConfiguration(ExecutionConfiguration::GPU)));
+    }
+#endif
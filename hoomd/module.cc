@@ -15,14 +15,17 @@
 #include "ExecutionConfiguration.h"
 #include "ForceCompute.h"
 #include "ForceConstraint.h"
+#include "GSDCheckpointWriter.h"
 #include "GSDDumpWriter.h"
 #include "GSDReader.h"
 #include "GetarDumpWriter.h"
 #include "GetarInitializer.h"
 #include "HOOMDMath.h"
+#include "IMDWriter.h"
 #include "Initializers.h"
 #include "Integrator.h"
 #include "LoadBalancer.h"
+#include "LogBufferWriter.h"
 #include "Messenger.h"
 #include "ParticleData.h"
 #include "ParticleFilterUpdater.h"
@@ -46,9 +49,11 @@
 
 // include GPU classes
 #ifdef ENABLE_HIP
+#include "BoxResizeUpdaterGPU.h"
 #include "CellListGPU.h"
 #include "LoadBalancerGPU.h"
 #include "SFCPackTunerGPU.h"
+#include "UpdaterRemoveDriftGPU.h"
 #include <hip/hip_runtime.h>
 #endif
 
@@ -186,6 +191,7 @@ PYBIND11_MODULE(_hoomd, m)
         .def_static("getCXXCompiler", BuildInfo::getCXXCompiler)
         .def_static("getEnableTBB", BuildInfo::getEnableTBB)
         .def_static("getEnableMPI", BuildInfo::getEnableMPI)
+        .def_static("getEnableZLIB", BuildInfo::getEnableZLIB)
         .def_static("getSourceDir", BuildInfo::getSourceDir)
         .def_static("getInstallDir", BuildInfo::getInstallDir);
 
@@ -270,6 +276,9 @@ PYBIND11_MODULE(_hoomd, m)
     export_DCDDumpWriter(m);
     getardump::export_GetarDumpWriter(m);
     export_GSDDumpWriter(m);
+    export_GSDCheckpointWriter(m);
+    export_IMDWriter(m);
+    export_LogBufferWriter(m);
     export_CallbackAnalyzer(m);
 
     // updaters
@@ -278,6 +287,10 @@ PYBIND11_MODULE(_hoomd, m)
     export_Integrator(m);
     export_BoxResizeUpdater(m);
     export_UpdaterRemoveDrift(m);
+#ifdef ENABLE_HIP
+    export_BoxResizeUpdaterGPU(m);
+    export_UpdaterRemoveDriftGPU(m);
+#endif
 
     // tuners
     export_Tuner(m);
@@ -72,9 +72,9 @@ void mpcd::ATCollisionMethod::drawVelocities(uint64_t timestep)
     ArrayHandle<unsigned int> h_tag(m_mpcd_pdata->getTags(),
                                     access_location::host,
                                     access_mode::read);
-    ArrayHandle<Scalar4> h_alt_vel(m_mpcd_pdata->getAltVelocities(),
-                                   access_location::host,
-                                   access_mode::overwrite);
+    ArrayHandle<mpcd::detail::pdata_real4> h_alt_vel(m_mpcd_pdata->getAltVelocities(),
+                                                     access_location::host,
+                                                     access_mode::overwrite);
     const unsigned int N_mpcd = m_mpcd_pdata->getN() + m_mpcd_pdata->getNVirtual();
     unsigned int N_tot = N_mpcd;
 
@@ -127,9 +127,9 @@ void mpcd::ATCollisionMethod::drawVelocities(uint64_t timestep)
             hoomd::Seed(hoomd::RNGIdentifier::ATCollisionMethod, timestep, seed),
             hoomd::Counter(tag));
         hoomd::NormalDistribution<Scalar> gen(fast::sqrt(T / mass), 0.0);
-        Scalar3 vel;
-        gen(vel.x, vel.y, rng);
-        vel.z = gen(rng);
+        Scalar v[3];
+        gen(v, rng);
+        const Scalar3 vel = make_scalar3(v[0], v[1], v[2]);
 
         // save out velocities
         if (idx < N_mpcd)
@@ -147,12 +147,12 @@ void mpcd::ATCollisionMethod::drawVelocities(uint64_t timestep)
 void mpcd::ATCollisionMethod::applyVelocities()
     {
     // mpcd particle data
-    ArrayHandle<Scalar4> h_vel(m_mpcd_pdata->getVelocities(),
-                               access_location::host,
-                               access_mode::readwrite);
-    ArrayHandle<Scalar4> h_vel_alt(m_mpcd_pdata->getAltVelocities(),
-                                   access_location::host,
-                                   access_mode::read);
+    ArrayHandle<mpcd::detail::pdata_real4> h_vel(m_mpcd_pdata->getVelocities(),
+                                                 access_location::host,
+                                                 access_mode::readwrite);
+    ArrayHandle<mpcd::detail::pdata_real4> h_vel_alt(m_mpcd_pdata->getAltVelocities(),
+                                                     access_location::host,
+                                                     access_mode::read);
     const unsigned int N_mpcd = m_mpcd_pdata->getN() + m_mpcd_pdata->getNVirtual();
     unsigned int N_tot = N_mpcd;
 
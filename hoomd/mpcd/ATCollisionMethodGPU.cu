@@ -19,7 +19,7 @@ namespace gpu
     {
 namespace kernel
     {
-__global__ void at_draw_velocity(Scalar4* d_alt_vel,
+__global__ void at_draw_velocity(mpcd::detail::pdata_real4* d_alt_vel,
                                  Scalar4* d_alt_vel_embed,
                                  const unsigned int* d_tag,
                                  const Scalar mpcd_mass,
@@ -57,9 +57,9 @@ __global__ void at_draw_velocity(Scalar4* d_alt_vel,
     hoomd::RandomGenerator rng(hoomd::Seed(hoomd::RNGIdentifier::ATCollisionMethod, timestep, seed),
                                hoomd::Counter(tag));
     hoomd::NormalDistribution<Scalar> gen(fast::sqrt(T / mass), 0.0);
-    Scalar3 vel;
-    gen(vel.x, vel.y, rng);
-    vel.z = gen(rng);
+    Scalar v[3];
+    gen(v, rng);
+    const Scalar3 vel = make_scalar3(v[0], v[1], v[2]);
 
     // save out velocities
     if (idx < N_mpcd)
@@ -72,9 +72,9 @@ __global__ void at_draw_velocity(Scalar4* d_alt_vel,
         }
     }
 
-__global__ void at_apply_velocity(Scalar4* d_vel,
+__global__ void at_apply_velocity(mpcd::detail::pdata_real4* d_vel,
                                   Scalar4* d_vel_embed,
-                                  const Scalar4* d_vel_alt,
+                                  const mpcd::detail::pdata_real4* d_vel_alt,
                                   const unsigned int* d_embed_idx,
                                   const Scalar4* d_vel_alt_embed,
                                   const unsigned int* d_embed_cell_ids,
@@ -125,7 +125,7 @@ __global__ void at_apply_velocity(Scalar4* d_vel,
 
     } // end namespace kernel
 
-cudaError_t at_draw_velocity(Scalar4* d_alt_vel,
+cudaError_t at_draw_velocity(mpcd::detail::pdata_real4* d_alt_vel,
                              Scalar4* d_alt_vel_embed,
                              const unsigned int* d_tag,
                              const Scalar mpcd_mass,
@@ -166,9 +166,9 @@ cudaError_t at_draw_velocity(Scalar4* d_alt_vel,
     return cudaSuccess;
     }
 
-cudaError_t at_apply_velocity(Scalar4* d_vel,
+cudaError_t at_apply_velocity(mpcd::detail::pdata_real4* d_vel,
                               Scalar4* d_vel_embed,
-                              const Scalar4* d_vel_alt,
+                              const mpcd::detail::pdata_real4* d_vel_alt,
                               const unsigned int* d_embed_idx,
                               const Scalar4* d_vel_alt_embed,
                               const unsigned int* d_embed_cell_ids,
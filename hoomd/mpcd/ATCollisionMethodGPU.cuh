@@ -21,7 +21,7 @@ namespace mpcd
 namespace gpu
     {
 //! Draw particle velocities for the Andersen thermostat from Gaussian distribution
-cudaError_t at_draw_velocity(Scalar4* d_alt_vel,
+cudaError_t at_draw_velocity(mpcd::detail::pdata_real4* d_alt_vel,
                              Scalar4* d_alt_vel_embed,
                              const unsigned int* d_tag,
                              const Scalar mpcd_mass,
@@ -36,9 +36,9 @@ cudaError_t at_draw_velocity(Scalar4* d_alt_vel,
                              const unsigned int block_size);
 
 //! Apply velocities for the Andersen thermostat
-cudaError_t at_apply_velocity(Scalar4* d_vel,
+cudaError_t at_apply_velocity(mpcd::detail::pdata_real4* d_vel,
                               Scalar4* d_vel_embed,
-                              const Scalar4* d_vel_alt,
+                              const mpcd::detail::pdata_real4* d_vel_alt,
                               const unsigned int* d_embed_idx,
                               const Scalar4* d_vel_alt_embed,
                               const unsigned int* d_embed_cell_ids,
@@ -10,6 +10,8 @@
 #include "hoomd/Communicator.h"
 #endif // ENABLE_MPI
 
+#include <vector>
+
 /*!
  * \file mpcd/CellList.cc
  * \brief Definition of mpcd::CellList
@@ -19,8 +21,8 @@ mpcd::CellList::CellList(std::shared_ptr<SystemDefinition> sysdef,
                          std::shared_ptr<mpcd::ParticleData> mpcd_pdata)
     : Compute(sysdef), m_mpcd_pdata(mpcd_pdata), m_cell_size(1.0), m_cell_np_max(4),
       m_cell_np(m_exec_conf), m_cell_list(m_exec_conf), m_embed_cell_ids(m_exec_conf),
-      m_conditions(m_exec_conf), m_needs_compute_dim(true), m_particles_sorted(false),
-      m_virtual_change(false)
+      m_cell_ids(m_exec_conf), m_conditions(m_exec_conf), m_needs_full_build(true),
+      m_needs_compute_dim(true), m_particles_sorted(false), m_virtual_change(false)
     {
     assert(m_mpcd_pdata);
     m_exec_conf->msg->notice(5) << "Constructing MPCD CellList" << std::endl;
@@ -30,6 +32,7 @@ mpcd::CellList::CellList(std::shared_ptr<SystemDefinition> sysdef,
     m_global_cell_dim = make_uint3(0, 0, 0);
 
     m_grid_shift = make_scalar3(0.0, 0.0, 0.0);
+    m_last_grid_shift = m_grid_shift;
     m_max_grid_shift = 0.5 * m_cell_size;
     m_origin_idx = make_int3(0, 0, 0);
 
@@ -68,18 +71,25 @@ void mpcd::CellList::compute(uint64_t timestep)
         {
         m_virtual_change = false;
         m_force_compute = true;
+        m_needs_full_build = true;
         }
 
+    // sorting the MD particles only changes the indexes of the embedded particles
     if (m_particles_sorted)
         {
         m_particles_sorted = false;
-        m_force_compute = true;
+        if (m_embed_group)
+            {
+            m_force_compute = true;
+            m_needs_full_build = true;
+            }
         }
 
     if (m_needs_compute_dim)
         {
         computeDimensions();
         m_force_compute = true;
+        m_needs_full_build = true;
         }
 
     if (peekCompute(timestep))
@@ -99,9 +109,10 @@ void mpcd::CellList::compute(uint64_t timestep)
 #endif // ENABLE_MPI
 
         // resize to be able to hold the number of embedded particles
-        if (m_embed_group)
+        if (m_embed_group && m_embed_cell_ids.size() != m_embed_group->getNumMembers())
             {
             m_embed_cell_ids.resize(m_embed_group->getNumMembers());
+            m_needs_full_build = true;
             }
 
         bool overflowed = false;
@@ -115,6 +126,7 @@ void mpcd::CellList::compute(uint64_t timestep)
                 {
                 reallocate();
                 resetConditions();
+                m_needs_full_build = true;
                 }
             } while (overflowed);
 
@@ -524,10 +536,110 @@ bool mpcd::CellList::isCommunicating(mpcd::detail::face dir)
 #endif // ENABLE_MPI
 
 /*!
- * \param timestep Current simulation timestep
+ * \returns Number of cells in the global box, padded by the extra communication cells along the
+ *          directions that are decomposed in MPI simulations
+ */
+uint3 mpcd::CellList::getPaddedGlobalDim()
+    {
+    uint3 n_global_cells = m_global_cell_dim;
+#ifdef ENABLE_MPI
+    if (isCommunicating(mpcd::detail::face::east))
+        n_global_cells.x += 2 * m_num_extra;
+    if (isCommunicating(mpcd::detail::face::north))
+        n_global_cells.y += 2 * m_num_extra;
+    if (isCommunicating(mpcd::detail::face::up))
+        n_global_cells.z += 2 * m_num_extra;
+#endif // ENABLE_MPI
+    return n_global_cells;
+    }
+
+/*!
+ * \param pos Particle position
+ * \param global_lo Lower corner of the global box
+ * \param n_global_cells Padded number of global cells (see getPaddedGlobalDim())
+ * \param periodic Periodic flags of the local box
+ * \param cur_p Index of the particle in the cell list, used to report errors
+ * \param bin_idx Output: local cell index
+ * \param conditions Error conditions, set if the particle cannot be binned
+ * \returns True if the particle lies in a local cell
  */
+bool mpcd::CellList::binParticle(const Scalar3& pos,
+                                 const Scalar3& global_lo,
+                                 const uint3& n_global_cells,
+                                 const uchar3& periodic,
+                                 unsigned int cur_p,
+                                 unsigned int& bin_idx,
+                                 uint3& conditions) const
+    {
+    if (std::isnan(pos.x) || std::isnan(pos.y) || std::isnan(pos.z))
+        {
+        conditions.y = cur_p + 1;
+        return false;
+        }
+
+    // bin particle assuming orthorhombic box (already validated)
+    const Scalar3 delta = (pos - m_grid_shift) - global_lo;
+    int3 global_bin = make_int3((int)std::floor(delta.x / m_cell_size),
+                                (int)std::floor(delta.y / m_cell_size),
+                                (int)std::floor(delta.z / m_cell_size));
+
+    // wrap cell back through the boundaries (grid shifting may send +/- 1 outside of range)
+    // this is done using periodic from the "local" box, since this will be periodic
+    // only when there is one rank along the dimension
+    if (periodic.x)
+        {
+        if (global_bin.x == (int)n_global_cells.x)
+            global_bin.x = 0;
+        else if (global_bin.x == -1)
+            global_bin.x = n_global_cells.x - 1;
+        }
+    if (periodic.y)
+        {
+        if (global_bin.y == (int)n_global_cells.y)
+            global_bin.y = 0;
+        else if (global_bin.y == -1)
+            global_bin.y = n_global_cells.y - 1;
+        }
+    if (periodic.z)
+        {
+        if (global_bin.z == (int)n_global_cells.z)
+            global_bin.z = 0;
+        else if (global_bin.z == -1)
+            global_bin.z = n_global_cells.z - 1;
+        }
+
+    // compute the local cell
+    int3 bin = make_int3(global_bin.x - m_origin_idx.x,
+                         global_bin.y - m_origin_idx.y,
+                         global_bin.z - m_origin_idx.z);
+
+    // validate and make sure no particles blew out of the box
+    if ((bin.x < 0 || bin.x >= (int)m_cell_dim.x) || (bin.y < 0 || bin.y >= (int)m_cell_dim.y)
+        || (bin.z < 0 || bin.z >= (int)m_cell_dim.z))
+        {
+        conditions.z = cur_p + 1;
+        return false;
+        }
+
+    bin_idx = m_cell_indexer(bin.x, bin.y, bin.z);
+    return true;
+    }
+
 void mpcd::CellList::buildCellList()
     {
+    const unsigned int N_mpcd = m_mpcd_pdata->getN() + m_mpcd_pdata->getNVirtual();
+
+    // try to reuse the last build
+    if (!m_needs_full_build && m_cell_ids.size() == N_mpcd && m_grid_shift.x == m_last_grid_shift.x
+        && m_grid_shift.y == m_last_grid_shift.y && m_grid_shift.z == m_last_grid_shift.z)
+        {
+        if (updateCellList())
+            return;
+        }
+    m_needs_full_build = true;
+    if (m_cell_ids.size() != N_mpcd)
+        m_cell_ids.resize(N_mpcd);
+
     const BoxDim& box = m_pdata->getBox();
     const uchar3 periodic = box.getPeriodic();
 
@@ -540,13 +652,13 @@ void mpcd::CellList::buildCellList()
 
     uint3 conditions = make_uint3(0, 0, 0);
 
-    ArrayHandle<Scalar4> h_pos(m_mpcd_pdata->getPositions(),
-                               access_location::host,
-                               access_mode::read);
-    ArrayHandle<Scalar4> h_vel(m_mpcd_pdata->getVelocities(),
-                               access_location::host,
-                               access_mode::readwrite);
-    unsigned int N_mpcd = m_mpcd_pdata->getN() + m_mpcd_pdata->getNVirtual();
+    ArrayHandle<mpcd::detail::pdata_real4> h_pos(m_mpcd_pdata->getPositions(),
+                                                 access_location::host,
+                                                 access_mode::read);
+    ArrayHandle<mpcd::detail::pdata_real4> h_vel(m_mpcd_pdata->getVelocities(),
+                                                 access_location::host,
+                                                 access_mode::readwrite);
+    ArrayHandle<unsigned int> h_cell_ids(m_cell_ids, access_location::host, access_mode::overwrite);
     unsigned int N_tot = N_mpcd;
 
     // we can't modify the velocity of embedded particles, so we only read their position
@@ -569,15 +681,7 @@ void mpcd::CellList::buildCellList()
 
     // total effective number of cells in the global box, optionally padded by
     // extra cells in MPI simulations
-    uint3 n_global_cells = m_global_cell_dim;
-#ifdef ENABLE_MPI
-    if (isCommunicating(mpcd::detail::face::east))
-        n_global_cells.x += 2 * m_num_extra;
-    if (isCommunicating(mpcd::detail::face::north))
-        n_global_cells.y += 2 * m_num_extra;
-    if (isCommunicating(mpcd::detail::face::up))
-        n_global_cells.z += 2 * m_num_extra;
-#endif // ENABLE_MPI
+    const uint3 n_global_cells = getPaddedGlobalDim();
 
     const Scalar3 global_lo = m_pdata->getGlobalBox().getLo();
 
@@ -594,57 +698,10 @@ void mpcd::CellList::buildCellList()
             }
         Scalar3 pos_i = make_scalar3(postype_i.x, postype_i.y, postype_i.z);
 
-        if (std::isnan(pos_i.x) || std::isnan(pos_i.y) || std::isnan(pos_i.z))
-            {
-            conditions.y = cur_p + 1;
-            continue;
-            }
-
-        // bin particle assuming orthorhombic box (already validated)
-        const Scalar3 delta = (pos_i - m_grid_shift) - global_lo;
-        int3 global_bin = make_int3((int)std::floor(delta.x / m_cell_size),
-                                    (int)std::floor(delta.y / m_cell_size),
-                                    (int)std::floor(delta.z / m_cell_size));
-
-        // wrap cell back through the boundaries (grid shifting may send +/- 1 outside of range)
-        // this is done using periodic from the "local" box, since this will be periodic
-        // only when there is one rank along the dimension
-        if (periodic.x)
-            {
-            if (global_bin.x == (int)n_global_cells.x)
-                global_bin.x = 0;
-            else if (global_bin.x == -1)
-                global_bin.x = n_global_cells.x - 1;
-            }
-        if (periodic.y)
-            {
-            if (global_bin.y == (int)n_global_cells.y)
-                global_bin.y = 0;
-            else if (global_bin.y == -1)
-                global_bin.y = n_global_cells.y - 1;
-            }
-        if (periodic.z)
-            {
-            if (global_bin.z == (int)n_global_cells.z)
-                global_bin.z = 0;
-            else if (global_bin.z == -1)
-                global_bin.z = n_global_cells.z - 1;
-            }
-
-        // compute the local cell
-        int3 bin = make_int3(global_bin.x - m_origin_idx.x,
-                             global_bin.y - m_origin_idx.y,
-                             global_bin.z - m_origin_idx.z);
-
-        // validate and make sure no particles blew out of the box
-        if ((bin.x < 0 || bin.x >= (int)m_cell_dim.x) || (bin.y < 0 || bin.y >= (int)m_cell_dim.y)
-            || (bin.z < 0 || bin.z >= (int)m_cell_dim.z))
-            {
-            conditions.z = cur_p + 1;
+        unsigned int bin_idx;
+        if (!binParticle(pos_i, global_lo, n_global_cells, periodic, cur_p, bin_idx, conditions))
             continue;
-            }
 
-        unsigned int bin_idx = m_cell_indexer(bin.x, bin.y, bin.z);
         unsigned int offset = h_cell_np.data[bin_idx];
         if (offset < m_cell_np_max)
             {
@@ -660,6 +717,7 @@ void mpcd::CellList::buildCellList()
         if (cur_p < N_mpcd)
             {
             h_vel.data[cur_p].w = __int_as_scalar(bin_idx);
+            h_cell_ids.data[cur_p] = bin_idx;
             }
         else
             {
@@ -672,6 +730,118 @@ void mpcd::CellList::buildCellList()
 
     // write out the conditions
     m_conditions.resetFlags(conditions);
+
+    // a complete build can be updated next time
+    if (conditions.x == 0 && conditions.y == 0 && conditions.z == 0)
+        {
+        m_needs_full_build = false;
+        m_last_grid_shift = m_grid_shift;
+        }
+    }
+
+/*!
+ * \returns True if the cell list was updated, false if a full build is required
+ *
+ * Every particle is binned again, but only particles whose cell differs from the one recorded in
+ * the last build are moved: the particle is swapped with the last member of its old cell and
+ * appended to its new cell. If a particle cannot be binned or a cell overflows, the update is
+ * abandoned and the caller rebuilds the full list, which also reports the error.
+ */
+bool mpcd::CellList::updateCellList()
+    {
+    const BoxDim& box = m_pdata->getBox();
+    const uchar3 periodic = box.getPeriodic();
+
+    ArrayHandle<unsigned int> h_cell_list(m_cell_list,
+                                          access_location::host,
+                                          access_mode::readwrite);
+    ArrayHandle<unsigned int> h_cell_np(m_cell_np, access_location::host, access_mode::readwrite);
+
+    ArrayHandle<mpcd::detail::pdata_real4> h_pos(m_mpcd_pdata->getPositions(),
+                                                 access_location::host,
+                                                 access_mode::read);
+    ArrayHandle<mpcd::detail::pdata_real4> h_vel(m_mpcd_pdata->getVelocities(),
+                                                 access_location::host,
+                                                 access_mode::readwrite);
+    ArrayHandle<unsigned int> h_cell_ids(m_cell_ids, access_location::host, access_mode::readwrite);
+    const unsigned int N_mpcd = m_mpcd_pdata->getN() + m_mpcd_pdata->getNVirtual();
+    unsigned int N_tot = N_mpcd;
+
+    std::unique_ptr<ArrayHandle<unsigned int>> h_embed_cell_ids;
+    std::unique_ptr<ArrayHandle<Scalar4>> h_pos_embed;
+    std::unique_ptr<ArrayHandle<unsigned int>> h_embed_member_idx;
+    if (m_embed_group)
+        {
+        h_embed_cell_ids.reset(new ArrayHandle<unsigned int>(m_embed_cell_ids,
+                                                             access_location::host,
+                                                             access_mode::readwrite));
+        h_pos_embed.reset(new ArrayHandle<Scalar4>(m_pdata->getPositions(),
+                                                   access_location::host,
+                                                   access_mode::read));
+        h_embed_member_idx.reset(new ArrayHandle<unsigned int>(m_embed_group->getIndexArray(),
+                                                               access_location::host,
+                                                               access_mode::read));
+        N_tot += m_embed_group->getNumMembers();
+        }
+
+    const uint3 n_global_cells = getPaddedGlobalDim();
+    const Scalar3 global_lo = m_pdata->getGlobalBox().getLo();
+
+    uint3 conditions = make_uint3(0, 0, 0);
+    for (unsigned int cur_p = 0; cur_p < N_tot; ++cur_p)
+        {
+        Scalar4 postype_i;
+        unsigned int* old_bin_idx;
+        if (cur_p < N_mpcd)
+            {
+            postype_i = h_pos.data[cur_p];
+            old_bin_idx = h_cell_ids.data + cur_p;
+            }
+        else
+            {
+            postype_i = h_pos_embed->data[h_embed_member_idx->data[cur_p - N_mpcd]];
+            old_bin_idx = h_embed_cell_ids->data + (cur_p - N_mpcd);
+            }
+        Scalar3 pos_i = make_scalar3(postype_i.x, postype_i.y, postype_i.z);
+
+        unsigned int bin_idx;
+        if (!binParticle(pos_i, global_lo, n_global_cells, periodic, cur_p, bin_idx, conditions))
+            return false;
+
+        if (bin_idx != *old_bin_idx)
+            {
+            // the new cell is full, let the full build grow the cell list
+            const unsigned int offset = h_cell_np.data[bin_idx];
+            if (offset >= m_cell_np_max)
+                return false;
+
+            // remove the particle from its old cell
+            const unsigned int old_np = h_cell_np.data[*old_bin_idx];
+            for (unsigned int old_offset = 0; old_offset < old_np; ++old_offset)
+                {
+                const unsigned int cl_idx = m_cell_list_indexer(old_offset, *old_bin_idx);
+                if (h_cell_list.data[cl_idx] == cur_p)
+                    {
+                    h_cell_list.data[cl_idx]
+                        = h_cell_list.data[m_cell_list_indexer(old_np - 1, *old_bin_idx)];
+                    break;
+                    }
+                }
+            --h_cell_np.data[*old_bin_idx];
+
+            // and append it to the new cell
+            h_cell_list.data[m_cell_list_indexer(offset, bin_idx)] = cur_p;
+            ++h_cell_np.data[bin_idx];
+            *old_bin_idx = bin_idx;
+            }
+
+        // the cell cache in the velocity may have been cleared by streaming, so always set it
+        if (cur_p < N_mpcd)
+            h_vel.data[cur_p].w = __int_as_scalar(bin_idx);
+        }
+
+    m_conditions.resetFlags(conditions);
+    return true;
     }
 
 /*!
@@ -685,7 +855,10 @@ void mpcd::CellList::sort(uint64_t timestep,
     {
     // no need to do any sorting if we can still be called at the current timestep
     if (peekCompute(timestep))
+        {
+        m_needs_full_build = true;
         return;
+        }
 
     // if mapping is not valid, signal that we need to force a recompute next time
     // that the cell list is needed. We don't call forceCompute() directly because this always
@@ -693,6 +866,7 @@ void mpcd::CellList::sort(uint64_t timestep,
     if (rorder.isNull())
         {
         m_force_compute = true;
+        m_needs_full_build = true;
         return;
         }
 
@@ -718,6 +892,24 @@ void mpcd::CellList::sort(uint64_t timestep,
                 }
             }
         }
+
+    // carry the recorded cells of the MPCD particles along for the next incremental update
+    if (m_cell_ids.size() < N_mpcd)
+        {
+        m_needs_full_build = true;
+        }
+    else if (!m_needs_full_build)
+        {
+        ArrayHandle<unsigned int> h_order(order, access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_cell_ids(m_cell_ids,
+                                             access_location::host,
+                                             access_mode::readwrite);
+        std::vector<unsigned int> old_cell_ids(h_cell_ids.data, h_cell_ids.data + N_mpcd);
+        for (unsigned int idx = 0; idx < N_mpcd; ++idx)
+            {
+            h_cell_ids.data[idx] = old_cell_ids[h_order.data[idx]];
+            }
+        }
     }
 
 #ifdef ENABLE_MPI
@@ -804,9 +996,9 @@ bool mpcd::CellList::checkConditions()
         Scalar4 pos_empty_i;
         if (n < m_mpcd_pdata->getN() + m_mpcd_pdata->getNVirtual())
             {
-            ArrayHandle<Scalar4> h_pos(m_mpcd_pdata->getPositions(),
-                                       access_location::host,
-                                       access_mode::read);
+            ArrayHandle<mpcd::detail::pdata_real4> h_pos(m_mpcd_pdata->getPositions(),
+                                                         access_location::host,
+                                                         access_mode::read);
             pos_empty_i = h_pos.data[n];
             if (n < m_mpcd_pdata->getN())
                 m_exec_conf->msg->errorAllRanks()
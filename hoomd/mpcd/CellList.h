@@ -30,6 +30,11 @@
 namespace mpcd
     {
 //! Computes the MPCD cell list on the CPU
+/*!
+ * When the grid shift has not changed since the last build and the particles have not been
+ * reordered, the CPU cell list is updated in place: only particles (including embedded ones) whose
+ * cell changed are moved between cells. Any other change rebuilds the full list.
+ */
 class PYBIND11_EXPORT CellList : public Compute
     {
     public:
@@ -190,6 +195,10 @@ class PYBIND11_EXPORT CellList : public Compute
             throw std::runtime_error("Error setting MPCD grid shift");
             }
 
+        // a cell list that was already built for this timestep is only valid for its grid shift
+        if (shift.x != m_grid_shift.x || shift.y != m_grid_shift.y || shift.z != m_grid_shift.z)
+            m_force_compute = true;
+
         m_grid_shift = shift;
         }
 
@@ -212,12 +221,14 @@ class PYBIND11_EXPORT CellList : public Compute
     void setEmbeddedGroup(std::shared_ptr<ParticleGroup> embed_group)
         {
         m_embed_group = embed_group;
+        m_needs_full_build = true;
         }
 
     //! Removes all embedded particles from collision coupling
     void removeEmbeddedGroup()
         {
         m_embed_group = std::shared_ptr<ParticleGroup>();
+        m_needs_full_build = true;
         }
 
     //! Gets the cell id array for the embedded particles
@@ -256,6 +267,7 @@ class PYBIND11_EXPORT CellList : public Compute
     GPUVector<unsigned int> m_cell_np;        //!< Number of particles per cell
     GPUVector<unsigned int> m_cell_list;      //!< Cell list of particles
     GPUVector<unsigned int> m_embed_cell_ids; //!< Cell ids of the embedded particles
+    GPUVector<unsigned int> m_cell_ids;       //!< Cell ids of the MPCD particles in the last build
     GPUFlags<uint3> m_conditions; //!< Detect conditions that might fail building cell list
 
     int3 m_origin_idx; //!< Origin as a global index
@@ -278,6 +290,21 @@ class PYBIND11_EXPORT CellList : public Compute
     //! Builds the cell list and handles cell list memory
     virtual void buildCellList();
 
+    //! Get the number of global cells, padded by the extra communication cells
+    uint3 getPaddedGlobalDim();
+
+    //! Bin a particle into a local cell
+    bool binParticle(const Scalar3& pos,
+                     const Scalar3& global_lo,
+                     const uint3& n_global_cells,
+                     const uchar3& periodic,
+                     unsigned int cur_p,
+                     unsigned int& bin_idx,
+                     uint3& conditions) const;
+
+    bool m_needs_full_build;   //!< True if the last build cannot be updated incrementally
+    Scalar3 m_last_grid_shift; //!< Grid shift used in the last build
+
     //! Callback to sort cell list when particle data is sorted
     virtual void sort(uint64_t timestep,
                       const GPUArray<unsigned int>& order,
@@ -298,6 +325,9 @@ class PYBIND11_EXPORT CellList : public Compute
         m_dim_signal.emit();
         }
 
+    //! Move only the particles that changed cells since the last build
+    bool updateCellList();
+
     bool m_particles_sorted; //!< True if any embedded particles have been sorted
     //! Slot for particle sorting
     void slotSorted()
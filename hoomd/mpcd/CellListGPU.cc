@@ -35,12 +35,12 @@ void mpcd::CellListGPU::buildCellList()
                                           access_location::device,
                                           access_mode::overwrite);
     ArrayHandle<unsigned int> d_cell_np(m_cell_np, access_location::device, access_mode::overwrite);
-    ArrayHandle<Scalar4> d_pos(m_mpcd_pdata->getPositions(),
-                               access_location::device,
-                               access_mode::read);
-    ArrayHandle<Scalar4> d_vel(m_mpcd_pdata->getVelocities(),
-                               access_location::device,
-                               access_mode::readwrite);
+    ArrayHandle<mpcd::detail::pdata_real4> d_pos(m_mpcd_pdata->getPositions(),
+                                                 access_location::device,
+                                                 access_mode::read);
+    ArrayHandle<mpcd::detail::pdata_real4> d_vel(m_mpcd_pdata->getVelocities(),
+                                                 access_location::device,
+                                                 access_mode::readwrite);
 
     const unsigned int N_mpcd = m_mpcd_pdata->getN() + m_mpcd_pdata->getNVirtual();
     unsigned int N_tot = N_mpcd;
@@ -124,6 +124,81 @@ void mpcd::CellListGPU::buildCellList()
         }
     }
 
+/*!
+ * \returns True if a streaming method may bin the MPCD particles into the cell list
+ *
+ * Binning during streaming is only possible if the streamed particles are all the particles in the
+ * cell list: there can be no embedded particles (which move between streaming and the collision)
+ * and no virtual particles (which are not streamed). The cell list must also cover the whole box,
+ * because particles that leave a domain are migrated only after streaming.
+ *
+ * \post The cell list dimensions are up to date.
+ */
+bool mpcd::CellListGPU::canBinWhileStreaming()
+    {
+    if (m_embed_group || m_mpcd_pdata->getNVirtual() > 0)
+        return false;
+#ifdef ENABLE_MPI
+    if (m_pdata->getDomainDecomposition())
+        return false;
+#endif // ENABLE_MPI
+
+    computeDimensions();
+    return true;
+    }
+
+/*!
+ * \param d_cell_np Number of particles per cell, acquired on the device by the caller
+ * \param d_cell_list Cell list, acquired on the device by the caller
+ * \param grid_shift Grid shift of the collision that will use the cell list
+ *
+ * \returns Arguments for mpcd::gpu::kernel::bin_cell_particle()
+ */
+mpcd::gpu::cell_bin_args_t mpcd::CellListGPU::getStreamBinArgs(unsigned int* d_cell_np,
+                                                               unsigned int* d_cell_list,
+                                                               const Scalar3& grid_shift)
+    {
+    return mpcd::gpu::cell_bin_args_t(d_cell_np,
+                                      d_cell_list,
+                                      m_conditions.getDeviceFlags(),
+                                      m_pdata->getBox().getPeriodic(),
+                                      m_origin_idx,
+                                      grid_shift,
+                                      m_pdata->getGlobalBox().getLo(),
+                                      m_global_cell_dim,
+                                      m_cell_size,
+                                      m_cell_np_max,
+                                      m_cell_indexer,
+                                      m_cell_list_indexer);
+    }
+
+/*!
+ * \param timestep Timestep of the collision that will use the cell list
+ * \param grid_shift Grid shift the particles were binned with
+ *
+ * The cell list is marked as computed at \a timestep, so that the collision does not rebuild it.
+ * Anything that invalidates the list before then (sorting, a change of the number of virtual
+ * particles, box changes, or another grid shift) still forces a rebuild. If a cell overflowed, the
+ * cell list is resized and left to be rebuilt by the collision.
+ */
+void mpcd::CellListGPU::finishStreamBinning(uint64_t timestep, const Scalar3& grid_shift)
+    {
+    m_grid_shift = grid_shift;
+
+    if (checkConditions())
+        {
+        reallocate();
+        resetConditions();
+        m_force_compute = true;
+        return;
+        }
+
+    m_first_compute = false;
+    m_force_compute = false;
+    m_last_computed = timestep;
+    m_mpcd_pdata->validateCellCache();
+    }
+
 /*!
  * \param timestep Timestep that the sorting occurred
  * \param order Mapping of sorted particle indexes onto old particle indexes
@@ -133,9 +208,13 @@ void mpcd::CellListGPU::sort(uint64_t timestep,
                              const GPUArray<unsigned int>& order,
                              const GPUArray<unsigned int>& rorder)
     {
-    // no need to do any sorting if we can still be called at the current timestep
+    // no need to do any sorting if we can still be called at the current timestep, but a cell list
+    // that was binned while streaming for a later timestep must then be rebuilt
     if (peekCompute(timestep))
+        {
+        m_force_compute = true;
         return;
+        }
 
     // force a recompute if mapping is invalid
     if (rorder.isNull())
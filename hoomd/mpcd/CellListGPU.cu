@@ -39,18 +39,15 @@ namespace kernel
  * \param N_tot Total number of particle (MPCD + embedded)
  *
  * \b Implementation
- * One thread is launched per particle. The particle is floored into a bin subject to a random grid
- * shift. The number of particles in that bin is atomically incremented. If the addition of the
- * particle will not overflow the allocated memory, the particle is written into that bin.
- * Otherwise, a flag is set to resize the cell list and recompute. The MPCD particle's cell id is
- * stashed into the velocity array.
+ * One thread is launched per particle, which is binned by bin_cell_particle(). The MPCD particle's
+ * cell id is stashed into the velocity array.
  */
 __global__ void compute_cell_list(unsigned int* d_cell_np,
                                   unsigned int* d_cell_list,
                                   uint3* d_conditions,
-                                  Scalar4* d_vel,
+                                  mpcd::detail::pdata_real4* d_vel,
                                   unsigned int* d_embed_cell_ids,
-                                  const Scalar4* d_pos,
+                                  const mpcd::detail::pdata_real4* d_pos,
                                   const Scalar4* d_pos_embed,
                                   const unsigned int* d_embed_member_idx,
                                   const uchar3 periodic,
@@ -81,68 +78,21 @@ __global__ void compute_cell_list(unsigned int* d_cell_np,
         }
     const Scalar3 pos_i = make_scalar3(postype_i.x, postype_i.y, postype_i.z);
 
-    if (isnan(pos_i.x) || isnan(pos_i.y) || isnan(pos_i.z))
-        {
-        (*d_conditions).y = idx + 1;
+    const cell_bin_args_t args(d_cell_np,
+                               d_cell_list,
+                               d_conditions,
+                               periodic,
+                               origin_idx,
+                               grid_shift,
+                               global_lo,
+                               n_global_cell,
+                               cell_size,
+                               cell_np_max,
+                               cell_indexer,
+                               cell_list_indexer);
+    unsigned int bin_idx;
+    if (!bin_cell_particle(bin_idx, pos_i, idx, args))
         return;
-        }
-
-    // bin particle with grid shift assuming orthorhombic box (already validated)
-    const Scalar3 delta = (pos_i - grid_shift) - global_lo;
-    int3 global_bin = make_int3(std::floor(delta.x / cell_size),
-                                std::floor(delta.y / cell_size),
-                                std::floor(delta.z / cell_size));
-
-    // wrap cell back through the boundaries (grid shifting may send +/- 1 outside of range)
-    // this is done using periodic from the "local" box, since this will be periodic
-    // only when there is one rank along the dimension
-    if (periodic.x)
-        {
-        if (global_bin.x == (int)n_global_cell.x)
-            global_bin.x = 0;
-        else if (global_bin.x == -1)
-            global_bin.x = n_global_cell.x - 1;
-        }
-    if (periodic.y)
-        {
-        if (global_bin.y == (int)n_global_cell.y)
-            global_bin.y = 0;
-        else if (global_bin.y == -1)
-            global_bin.y = n_global_cell.y - 1;
-        }
-    if (periodic.z)
-        {
-        if (global_bin.z == (int)n_global_cell.z)
-            global_bin.z = 0;
-        else if (global_bin.z == -1)
-            global_bin.z = n_global_cell.z - 1;
-        }
-
-    // compute the local cell
-    int3 bin = make_int3(global_bin.x - origin_idx.x,
-                         global_bin.y - origin_idx.y,
-                         global_bin.z - origin_idx.z);
-
-    // validate and make sure no particles blew out of the box
-    if ((bin.x < 0 || bin.x >= (int)cell_indexer.getW())
-        || (bin.y < 0 || bin.y >= (int)cell_indexer.getH())
-        || (bin.z < 0 || bin.z >= (int)cell_indexer.getD()))
-        {
-        (*d_conditions).z = idx + 1;
-        return;
-        }
-
-    const unsigned int bin_idx = cell_indexer(bin.x, bin.y, bin.z);
-    const unsigned int offset = atomicInc(&d_cell_np[bin_idx], 0xffffffff);
-    if (offset < cell_np_max)
-        {
-        d_cell_list[cell_list_indexer(offset, bin_idx)] = idx;
-        }
-    else
-        {
-        // overflow
-        atomicMax(&(*d_conditions).x, offset + 1);
-        }
 
     // stash the current particle bin into the velocity array
     if (idx < N_mpcd)
@@ -170,7 +120,7 @@ __global__ void compute_cell_list(unsigned int* d_cell_np,
  * a communication step to migrate particles to their appropriate ranks.
  */
 __global__ void cell_check_migrate_embed(unsigned int* d_migrate_flag,
-                                         const Scalar4* d_pos,
+                                         const mpcd::detail::pdata_real4* d_pos,
                                          const unsigned int* d_group,
                                          const BoxDim box,
                                          const unsigned int num_dim,
@@ -257,9 +207,9 @@ __global__ void cell_apply_sort(unsigned int* d_cell_list,
 cudaError_t mpcd::gpu::compute_cell_list(unsigned int* d_cell_np,
                                          unsigned int* d_cell_list,
                                          uint3* d_conditions,
-                                         Scalar4* d_vel,
+                                         mpcd::detail::pdata_real4* d_vel,
                                          unsigned int* d_embed_cell_ids,
-                                         const Scalar4* d_pos,
+                                         const mpcd::detail::pdata_real4* d_pos,
                                          const Scalar4* d_pos_embed,
                                          const unsigned int* d_embed_member_idx,
                                          const uchar3& periodic,
@@ -325,7 +275,7 @@ cudaError_t mpcd::gpu::compute_cell_list(unsigned int* d_cell_np,
  * \sa mpcd::gpu::kernel::cell_check_migrate_embed
  */
 cudaError_t mpcd::gpu::cell_check_migrate_embed(unsigned int* d_migrate_flag,
-                                                const Scalar4* d_pos,
+                                                const mpcd::detail::pdata_real4* d_pos,
                                                 const unsigned int* d_group,
                                                 const BoxDim& box,
                                                 const unsigned int num_dim,
@@ -21,13 +21,67 @@ namespace mpcd
     {
 namespace gpu
     {
+#ifdef __HIPCC__
+#define HOSTDEVICE __host__ __device__
+#else
+#define HOSTDEVICE
+#endif
+
+//! Arguments to bin particles into the MPCD cell list
+struct cell_bin_args_t
+    {
+    //! Default constructor (no cell list)
+    HOSTDEVICE cell_bin_args_t()
+        : d_cell_np(nullptr), d_cell_list(nullptr), d_conditions(nullptr),
+          periodic(make_uchar3(0, 0, 0)), origin_idx(make_int3(0, 0, 0)),
+          grid_shift(make_scalar3(0, 0, 0)), global_lo(make_scalar3(0, 0, 0)),
+          n_global_cell(make_uint3(0, 0, 0)), cell_size(0), cell_np_max(0)
+        {
+        }
+
+    //! Constructor
+    HOSTDEVICE cell_bin_args_t(unsigned int* _d_cell_np,
+                               unsigned int* _d_cell_list,
+                               uint3* _d_conditions,
+                               const uchar3& _periodic,
+                               const int3& _origin_idx,
+                               const Scalar3& _grid_shift,
+                               const Scalar3& _global_lo,
+                               const uint3& _n_global_cell,
+                               const Scalar _cell_size,
+                               const unsigned int _cell_np_max,
+                               const Index3D& _cell_indexer,
+                               const Index2D& _cell_list_indexer)
+        : d_cell_np(_d_cell_np), d_cell_list(_d_cell_list), d_conditions(_d_conditions),
+          periodic(_periodic), origin_idx(_origin_idx), grid_shift(_grid_shift),
+          global_lo(_global_lo), n_global_cell(_n_global_cell), cell_size(_cell_size),
+          cell_np_max(_cell_np_max), cell_indexer(_cell_indexer),
+          cell_list_indexer(_cell_list_indexer)
+        {
+        }
+
+    unsigned int* d_cell_np;   //!< Number of particles per cell
+    unsigned int* d_cell_list; //!< 2D array of particles in each cell
+    uint3* d_conditions;       //!< Conditions flags for error reporting
+    uchar3 periodic;           //!< Flags if local simulation is periodic
+    int3 origin_idx;           //!< Global origin index for the local box
+    Scalar3 grid_shift;        //!< Random grid shift vector
+    Scalar3 global_lo;         //!< Lower bound of global orthorhombic simulation box
+    uint3 n_global_cell;       //!< Global dimensions of the cell list, including padding
+    Scalar cell_size;          //!< Cell width
+    unsigned int cell_np_max;  //!< Maximum number of particles per cell
+    Index3D cell_indexer;      //!< 3D indexer for cell id
+    Index2D cell_list_indexer; //!< 2D indexer for particle position in cell
+    };
+#undef HOSTDEVICE
+
 //! Kernel driver to compute mpcd cell list
 cudaError_t compute_cell_list(unsigned int* d_cell_np,
                               unsigned int* d_cell_list,
                               uint3* d_conditions,
-                              Scalar4* d_vel,
+                              mpcd::detail::pdata_real4* d_vel,
                               unsigned int* d_embed_cell_ids,
-                              const Scalar4* d_pos,
+                              const mpcd::detail::pdata_real4* d_pos,
                               const Scalar4* d_pos_embed,
                               const unsigned int* d_embed_member_idx,
                               const uchar3& periodic,
@@ -45,7 +99,7 @@ cudaError_t compute_cell_list(unsigned int* d_cell_np,
 
 //! Kernel driver to check if any embedded particles require migration
 cudaError_t cell_check_migrate_embed(unsigned int* d_migrate_flag,
-                                     const Scalar4* d_pos,
+                                     const mpcd::detail::pdata_real4* d_pos,
                                      const unsigned int* d_group,
                                      const BoxDim& box,
                                      const unsigned int num_dim,
@@ -60,6 +114,97 @@ cudaError_t cell_apply_sort(unsigned int* d_cell_list,
                             const unsigned int N_mpcd,
                             const unsigned int block_size);
 
+#ifdef __HIPCC__
+namespace kernel
+    {
+//! Bin one particle into the MPCD cell list
+/*!
+ * \param bin_idx Local cell index of the particle (output)
+ * \param pos_i Particle position
+ * \param idx Index of the particle written into the cell list
+ * \param args Cell list arguments
+ *
+ * \returns True if the particle was binned, false if it has a NaN position or is outside the
+ *          local cells. In that case, the error is recorded in the conditions flags.
+ *
+ * The particle is floored into a bin subject to the random grid shift. The number of particles in
+ * that bin is atomically incremented. If the addition of the particle will not overflow the
+ * allocated memory, the particle is written into that bin. Otherwise, the overflow is recorded so
+ * that the cell list can be resized and recomputed.
+ */
+__device__ inline bool bin_cell_particle(unsigned int& bin_idx,
+                                         const Scalar3& pos_i,
+                                         unsigned int idx,
+                                         const cell_bin_args_t& args)
+    {
+    if (isnan(pos_i.x) || isnan(pos_i.y) || isnan(pos_i.z))
+        {
+        (*args.d_conditions).y = idx + 1;
+        return false;
+        }
+
+    // bin particle with grid shift assuming orthorhombic box (already validated)
+    const Scalar3 delta = (pos_i - args.grid_shift) - args.global_lo;
+    int3 global_bin = make_int3(std::floor(delta.x / args.cell_size),
+                                std::floor(delta.y / args.cell_size),
+                                std::floor(delta.z / args.cell_size));
+
+    // wrap cell back through the boundaries (grid shifting may send +/- 1 outside of range)
+    // this is done using periodic from the "local" box, since this will be periodic
+    // only when there is one rank along the dimension
+    if (args.periodic.x)
+        {
+        if (global_bin.x == (int)args.n_global_cell.x)
+            global_bin.x = 0;
+        else if (global_bin.x == -1)
+            global_bin.x = args.n_global_cell.x - 1;
+        }
+    if (args.periodic.y)
+        {
+        if (global_bin.y == (int)args.n_global_cell.y)
+            global_bin.y = 0;
+        else if (global_bin.y == -1)
+            global_bin.y = args.n_global_cell.y - 1;
+        }
+    if (args.periodic.z)
+        {
+        if (global_bin.z == (int)args.n_global_cell.z)
+            global_bin.z = 0;
+        else if (global_bin.z == -1)
+            global_bin.z = args.n_global_cell.z - 1;
+        }
+
+    // compute the local cell
+    int3 bin = make_int3(global_bin.x - args.origin_idx.x,
+                         global_bin.y - args.origin_idx.y,
+                         global_bin.z - args.origin_idx.z);
+
+    // validate and make sure no particles blew out of the box
+    if ((bin.x < 0 || bin.x >= (int)args.cell_indexer.getW())
+        || (bin.y < 0 || bin.y >= (int)args.cell_indexer.getH())
+        || (bin.z < 0 || bin.z >= (int)args.cell_indexer.getD()))
+        {
+        (*args.d_conditions).z = idx + 1;
+        return false;
+        }
+
+    bin_idx = args.cell_indexer(bin.x, bin.y, bin.z);
+    const unsigned int offset = atomicInc(&args.d_cell_np[bin_idx], 0xffffffff);
+    if (offset < args.cell_np_max)
+        {
+        args.d_cell_list[args.cell_list_indexer(offset, bin_idx)] = idx;
+        }
+    else
+        {
+        // overflow
+        atomicMax(&(*args.d_conditions).x, offset + 1);
+        }
+
+    return true;
+    }
+    } // end namespace kernel
+#endif // __HIPCC__
+
     } // end namespace gpu
     } // end namespace mpcd
 
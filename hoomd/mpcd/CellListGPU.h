@@ -16,6 +16,7 @@
 #endif
 
 #include "CellList.h"
+#include "CellListGPU.cuh"
 #include "hoomd/Autotuner.h"
 
 namespace mpcd
@@ -49,6 +50,17 @@ class PYBIND11_EXPORT CellListGPU : public mpcd::CellList
 #endif // ENABLE_MPI
         }
 
+    //! Check if the MPCD particles can be binned into the cell list while they are streamed
+    bool canBinWhileStreaming();
+
+    //! Get the arguments to bin the MPCD particles into the cell list while they are streamed
+    mpcd::gpu::cell_bin_args_t getStreamBinArgs(unsigned int* d_cell_np,
+                                                unsigned int* d_cell_list,
+                                                const Scalar3& grid_shift);
+
+    //! Finish a cell list that was binned while streaming the MPCD particles
+    void finishStreamBinning(uint64_t timestep, const Scalar3& grid_shift);
+
     protected:
     //! Compute the cell list of particles on the GPU
     virtual void buildCellList();
@@ -152,7 +152,7 @@ struct CellPropertySum
     CellPropertySum(const unsigned int* cell_list_,
                     const unsigned int* cell_np_,
                     const Index2D& cli_,
-                    const Scalar4* vel_,
+                    const mpcd::detail::pdata_real4* vel_,
                     const Scalar mass_,
                     const Scalar4* embed_vel_,
                     const unsigned int* embed_idx_,
@@ -215,7 +215,7 @@ struct CellPropertySum
     const unsigned int* cell_np;   //!< Number of particles per cell
     const Index2D cli;             //!< Cell list indexer
 
-    const Scalar4* vel;            //!< MPCD particle velocities
+    const mpcd::detail::pdata_real4* vel;            //!< MPCD particle velocities
     const Scalar mass;             //!< MPCD particle mass
     const Scalar4* embed_vel;      //!< Embedded particle velocities
     const unsigned int* embed_idx; //!< Embedded particle indexes
@@ -237,9 +237,9 @@ void mpcd::CellThermoCompute::beginOuterCellProperties()
     const Index2D& cli = m_cl->getCellListIndexer();
 
     // MPCD particle data
-    ArrayHandle<Scalar4> h_vel(m_mpcd_pdata->getVelocities(),
-                               access_location::host,
-                               access_mode::read);
+    ArrayHandle<mpcd::detail::pdata_real4> h_vel(m_mpcd_pdata->getVelocities(),
+                                                 access_location::host,
+                                                 access_mode::read);
     const Scalar mpcd_mass = m_mpcd_pdata->getMass();
     const unsigned int N_mpcd = m_mpcd_pdata->getN() + m_mpcd_pdata->getNVirtual();
 
@@ -357,9 +357,9 @@ void mpcd::CellThermoCompute::calcInnerCellProperties()
     // MPCD particle data
     const unsigned int N_mpcd = m_mpcd_pdata->getN() + m_mpcd_pdata->getNVirtual();
     const Scalar mpcd_mass = m_mpcd_pdata->getMass();
-    ArrayHandle<Scalar4> h_vel(m_mpcd_pdata->getVelocities(),
-                               access_location::host,
-                               access_mode::read);
+    ArrayHandle<mpcd::detail::pdata_real4> h_vel(m_mpcd_pdata->getVelocities(),
+                                                 access_location::host,
+                                                 access_mode::read);
 
     // Embedded particle data
     std::unique_ptr<ArrayHandle<Scalar4>> h_embed_vel;
@@ -58,9 +58,9 @@ void mpcd::CellThermoComputeGPU::beginOuterCellProperties()
                                           access_location::device,
                                           access_mode::read);
 
-    ArrayHandle<Scalar4> d_vel(m_mpcd_pdata->getVelocities(),
-                               access_location::device,
-                               access_mode::read);
+    ArrayHandle<mpcd::detail::pdata_real4> d_vel(m_mpcd_pdata->getVelocities(),
+                                                 access_location::device,
+                                                 access_mode::read);
 
     if (m_cl->getEmbeddedGroup())
         {
@@ -155,9 +155,9 @@ void mpcd::CellThermoComputeGPU::calcInnerCellProperties()
                                           access_location::device,
                                           access_mode::read);
 
-    ArrayHandle<Scalar4> d_vel(m_mpcd_pdata->getVelocities(),
-                               access_location::device,
-                               access_mode::read);
+    ArrayHandle<mpcd::detail::pdata_real4> d_vel(m_mpcd_pdata->getVelocities(),
+                                                 access_location::device,
+                                                 access_mode::read);
 
     /*
      * Determine the inner cell indexer and offset. The inner indexer is the cube containing
@@ -54,7 +54,7 @@ __global__ void begin_cell_thermo(double4* d_cell_vel,
                                   const unsigned int* d_cell_np,
                                   const unsigned int* d_cell_list,
                                   const Index2D cli,
-                                  const Scalar4* d_vel,
+                                  const mpcd::detail::pdata_real4* d_vel,
                                   const unsigned int N_mpcd,
                                   const Scalar mpcd_mass,
                                   const Scalar4* d_embed_vel,
@@ -220,7 +220,7 @@ __global__ void inner_cell_thermo(double4* d_cell_vel,
                                   const unsigned int* d_cell_np,
                                   const unsigned int* d_cell_list,
                                   const Index2D cli,
-                                  const Scalar4* d_vel,
+                                  const mpcd::detail::pdata_real4* d_vel,
                                   const unsigned int N_mpcd,
                                   const Scalar mpcd_mass,
                                   const Scalar4* d_embed_vel,
@@ -58,7 +58,7 @@ struct thermo_args_t
                   const unsigned int* cell_np_,
                   const unsigned int* cell_list_,
                   const Index2D& cli_,
-                  const Scalar4* vel_,
+                  const mpcd::detail::pdata_real4* vel_,
                   const unsigned int N_mpcd_,
                   const Scalar mass_,
                   const Scalar4* embed_vel_,
@@ -76,7 +76,7 @@ struct thermo_args_t
     const unsigned int* cell_np;   //!< Number of particles per cell
     const unsigned int* cell_list; //!< MPCD cell list
     const Index2D cli;             //!< MPCD cell list indexer
-    const Scalar4* vel;            //!< MPCD particle velocities
+    const mpcd::detail::pdata_real4* vel;            //!< MPCD particle velocities
     const unsigned int N_mpcd;     //!< Number of MPCD particles
     const Scalar mass;             //!< MPCD particle mass
     const Scalar4* embed_vel;      //!< Embedded particle velocities
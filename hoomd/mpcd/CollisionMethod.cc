@@ -131,37 +131,45 @@ bool mpcd::CollisionMethod::shouldCollide(uint64_t timestep)
  *
  * \post The MPCD cell list has its grid shift set for \a timestep.
  *
+ * \sa computeGridShift
+ */
+void mpcd::CollisionMethod::drawGridShift(uint64_t timestep)
+    {
+    m_cl->setGridShift(computeGridShift(timestep));
+    }
+
+/*!
+ * \param timestep Timestep to compute shifting for
+ *
+ * \returns The grid shift for \a timestep
+ *
  * If grid shifting is enabled, three uniform random numbers are drawn using
  * the Mersenne twister generator. (In two dimensions, only two numbers are drawn.)
+ * The numbers only depend on \a timestep, so the shift of a future collision can be computed ahead
+ * of time.
  *
- * If grid shifting is disabled, a zero vector is instead set.
+ * If grid shifting is disabled, a zero vector is instead returned.
  */
-void mpcd::CollisionMethod::drawGridShift(uint64_t timestep)
+Scalar3 mpcd::CollisionMethod::computeGridShift(uint64_t timestep) const
     {
-    uint16_t seed = m_sysdef->getSeed();
-
     // return zeros if shifting is off
     if (!m_enable_grid_shift)
-        {
-        m_cl->setGridShift(make_scalar3(0.0, 0.0, 0.0));
-        }
-    else
-        {
-        // PRNG using seed and timestep as seeds
-        hoomd::RandomGenerator rng(
-            hoomd::Seed(hoomd::RNGIdentifier::CollisionMethod, timestep, seed),
-            hoomd::Counter(m_instance));
-        const Scalar max_shift = m_cl->getMaxGridShift();
-
-        // draw shift variables from uniform distribution
-        Scalar3 shift;
-        hoomd::UniformDistribution<Scalar> uniform(-max_shift, max_shift);
-        shift.x = uniform(rng);
-        shift.y = uniform(rng);
-        shift.z = (m_sysdef->getNDimensions() == 3) ? uniform(rng) : Scalar(0.0);
-
-        m_cl->setGridShift(shift);
-        }
+        return make_scalar3(0.0, 0.0, 0.0);
+
+    // PRNG using seed and timestep as seeds
+    uint16_t seed = m_sysdef->getSeed();
+    hoomd::RandomGenerator rng(hoomd::Seed(hoomd::RNGIdentifier::CollisionMethod, timestep, seed),
+                               hoomd::Counter(m_instance));
+    const Scalar max_shift = m_cl->getMaxGridShift();
+
+    // draw shift variables from uniform distribution
+    Scalar3 shift;
+    hoomd::UniformDistribution<Scalar> uniform(-max_shift, max_shift);
+    shift.x = uniform(rng);
+    shift.y = uniform(rng);
+    shift.z = (m_sysdef->getNDimensions() == 3) ? uniform(rng) : Scalar(0.0);
+
+    return shift;
     }
 
 /*!
@@ -70,6 +70,9 @@ class PYBIND11_EXPORT CollisionMethod
     //! Generates the random grid shift vector
     void drawGridShift(uint64_t timestep);
 
+    //! Computes the random grid shift vector without setting it
+    Scalar3 computeGridShift(uint64_t timestep) const;
+
     //! Sets a group of particles that is coupled to the MPCD solvent through the collision step
     /*!
      * \param embed_group Group to embed
@@ -31,8 +31,8 @@ mpcd::Communicator::Communicator(std::shared_ptr<mpcd::SystemData> system_data)
       m_pdata(m_sysdef->getParticleData()), m_exec_conf(m_pdata->getExecConf()),
       m_mpcd_pdata(m_mpcd_sys->getParticleData()), m_mpi_comm(m_exec_conf->getMPICommunicator()),
       m_decomposition(m_pdata->getDomainDecomposition()), m_is_communicating(false),
-      m_check_decomposition(true), m_nneigh(0), m_n_unique_neigh(0), m_sendbuf(m_exec_conf),
-      m_recvbuf(m_exec_conf), m_force_migrate(false)
+      m_check_decomposition(true), m_migrated_early(false), m_migrated_timestep(0), m_nneigh(0),
+      m_n_unique_neigh(0), m_sendbuf(m_exec_conf), m_recvbuf(m_exec_conf), m_force_migrate(false)
     {
     // initialize array of neighbor processor ids
     assert(m_mpi_comm);
@@ -59,7 +59,11 @@ mpcd::Communicator::Communicator(std::shared_ptr<mpcd::SystemData> system_data)
     // create new data type for the pdata_element
     const int nitems = 4;
     int blocklengths[nitems] = {4, 4, 1, 1};
+#if defined(ENABLE_MPCD_MIXED_PRECISION) && !defined(SINGLE_PRECISION)
+    MPI_Datatype types[nitems] = {MPI_FLOAT, MPI_FLOAT, MPI_UNSIGNED, MPI_UNSIGNED};
+#else
     MPI_Datatype types[nitems] = {MPI_HOOMD_SCALAR, MPI_HOOMD_SCALAR, MPI_UNSIGNED, MPI_UNSIGNED};
+#endif
     MPI_Aint offsets[nitems];
     offsets[0] = offsetof(mpcd::detail::pdata_element, pos);
     offsets[1] = offsetof(mpcd::detail::pdata_element, vel);
@@ -207,6 +211,11 @@ void mpcd::Communicator::communicate(uint64_t timestep)
     // which will trigger any size change signals
     m_mpcd_sys->getCellList()->computeDimensions();
 
+    // a migration completed ahead of time by finishMigrate() is only valid if the box is unchanged
+    const bool migrated
+        = m_migrated_early && m_migrated_timestep == timestep && !m_check_decomposition;
+    m_migrated_early = false;
+
     if (m_prof)
         m_prof->push("MPCD comm");
     if (m_check_decomposition)
@@ -217,7 +226,7 @@ void mpcd::Communicator::communicate(uint64_t timestep)
 
     // check for and attempt particle migration
     bool migrate = m_force_migrate;
-    if (!migrate)
+    if (!migrate && !migrated)
         {
         m_migrate_requests.emit_accumulate([&](bool r) { migrate = migrate || r; }, timestep);
         }
@@ -458,10 +467,11 @@ void mpcd::Communicator::migrateParticles(uint64_t timestep)
         for (unsigned int idx = 0; idx < n_recv; ++idx)
             {
             mpcd::detail::pdata_element& p = h_recvbuf.data[idx];
-            Scalar4& postype = p.pos;
+            Scalar4 postype = p.pos;
             int3 image = make_int3(0, 0, 0);
 
             wrap_box.wrap(postype, image);
+            p.pos = postype;
             }
         }
 
@@ -486,9 +496,9 @@ void mpcd::Communicator::setCommFlags(const BoxDim& box)
         m_prof->push("comm flags");
     // mark all particles which have left the box for sending
     unsigned int N = m_mpcd_pdata->getN();
-    ArrayHandle<Scalar4> h_pos(m_mpcd_pdata->getPositions(),
-                               access_location::host,
-                               access_mode::read);
+    ArrayHandle<mpcd::detail::pdata_real4> h_pos(m_mpcd_pdata->getPositions(),
+                                                 access_location::host,
+                                                 access_mode::read);
     ArrayHandle<unsigned int> h_comm_flag(m_mpcd_pdata->getCommFlags(),
                                           access_location::host,
                                           access_mode::overwrite);
@@ -498,7 +508,7 @@ void mpcd::Communicator::setCommFlags(const BoxDim& box)
     const Scalar3 hi = box.getHi();
     for (unsigned int idx = 0; idx < N; ++idx)
         {
-        const Scalar4& postype = h_pos.data[idx];
+        const Scalar4 postype = h_pos.data[idx];
         const Scalar3 pos = make_scalar3(postype.x, postype.y, postype.z);
 
         unsigned int flags = 0;
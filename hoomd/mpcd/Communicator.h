@@ -120,6 +120,25 @@ class PYBIND11_EXPORT Communicator
      */
     virtual void migrateParticles(uint64_t timestep);
 
+    //! Start migrating particles ahead of the call to communicate() at \a timestep
+    /*!
+     * \param timestep Timestep of the next call to communicate()
+     *
+     * A migration started with beginMigrate() must be completed by finishMigrate() before the
+     * MPCD particle data is accessed again. Work that does not touch the MPCD particles can be
+     * done in between while the messages are in flight. If the migration completes and the box
+     * does not change, the next call to communicate() at \a timestep does not migrate again.
+     *
+     * The base class does not overlap communication, and migrates in communicate() as usual.
+     */
+    virtual void beginMigrate(uint64_t timestep) { }
+
+    //! Complete a migration started by beginMigrate()
+    /*!
+     * \param timestep Timestep of the next call to communicate()
+     */
+    virtual void finishMigrate(uint64_t timestep) { }
+
     //! Migration signal type
     typedef Nano::Signal<bool(uint64_t timestep)> MigrateSignal;
 
@@ -178,8 +197,10 @@ class PYBIND11_EXPORT Communicator
     std::shared_ptr<DomainDecomposition> m_decomposition;      //!< Domain decomposition information
     std::shared_ptr<Profiler> m_prof;                          //!< Profiler
 
-    bool m_is_communicating;    //!< Whether we are currently communicating
-    bool m_check_decomposition; //!< Flag to check the simulation box decomposition
+    bool m_is_communicating;      //!< Whether we are currently communicating
+    bool m_check_decomposition;   //!< Flag to check the simulation box decomposition
+    bool m_migrated_early;        //!< True if finishMigrate() completed a migration
+    uint64_t m_migrated_timestep; //!< Timestep the early migration was done for
 
     const static unsigned int neigh_max;       //!< Maximum number of neighbor ranks
     GPUArray<unsigned int> m_neighbors;        //!< Neighbor ranks
@@ -25,8 +25,13 @@ namespace py = pybind11;
  */
 mpcd::CommunicatorGPU::CommunicatorGPU(std::shared_ptr<mpcd::SystemData> system_data)
     : Communicator(system_data), m_max_stages(1), m_num_stages(0), m_comm_mask(0),
-      m_tmp_keys(m_exec_conf)
+      m_tmp_keys(m_exec_conf), m_n_recv_tot(0), m_nreq(0), m_migrate_pending(false),
+      m_pending_timestep(0)
     {
+    // migration uses its own communicator so that messages in flight between beginMigrate() and
+    // finishMigrate() cannot match those of other classes
+    MPI_Comm_dup(m_mpi_comm, &m_migrate_comm);
+
     // initialize communication stages
     initializeCommunicationStages();
 
@@ -40,7 +45,11 @@ mpcd::CommunicatorGPU::CommunicatorGPU(std::shared_ptr<mpcd::SystemData> system_
     m_flags_tuner.reset(new Autotuner(32, 1024, 32, 5, 100000, "mpcd_comm_flags", m_exec_conf));
     }
 
-mpcd::CommunicatorGPU::~CommunicatorGPU() { }
+mpcd::CommunicatorGPU::~CommunicatorGPU()
+    {
+    freeCountRequests();
+    MPI_Comm_free(&m_migrate_comm);
+    }
 
 void mpcd::CommunicatorGPU::initializeCommunicationStages()
     {
@@ -157,6 +166,63 @@ void mpcd::CommunicatorGPU::initializeCommunicationStages()
 
     m_exec_conf->msg->notice(4) << "MPCD CommunicatorGPU: Using " << m_num_stages
                                 << " communication stage(s)." << std::endl;
+
+    initializeCountRequests();
+    }
+
+/*!
+ * The number of particles sent to each neighbor is exchanged with persistent requests, which are
+ * grouped by communication stage so that all requests of a stage can be started at once.
+ */
+void mpcd::CommunicatorGPU::initializeCountRequests()
+    {
+    freeCountRequests();
+
+    // the requests hold pointers into these, so they must not be resized later
+    m_n_send_ptls.assign(m_n_unique_neigh, 0);
+    m_n_recv_ptls.assign(m_n_unique_neigh, 0);
+    m_offsets.assign(m_n_unique_neigh, 0);
+
+    ArrayHandle<unsigned int> h_unique_neighbors(m_unique_neighbors,
+                                                 access_location::host,
+                                                 access_mode::read);
+    m_count_req_offsets.assign(m_num_stages + 1, 0);
+    for (unsigned int stage = 0; stage < m_num_stages; ++stage)
+        {
+        m_count_req_offsets[stage] = (unsigned int)m_count_reqs.size();
+        for (unsigned int ineigh = 0; ineigh < m_n_unique_neigh; ++ineigh)
+            {
+            if (m_stages[ineigh] != (int)stage)
+                continue;
+
+            const unsigned int neighbor = h_unique_neighbors.data[ineigh];
+            MPI_Request req;
+            MPI_Send_init(&m_n_send_ptls[ineigh],
+                          1,
+                          MPI_UNSIGNED,
+                          neighbor,
+                          0,
+                          m_migrate_comm,
+                          &req);
+            m_count_reqs.push_back(req);
+            MPI_Recv_init(&m_n_recv_ptls[ineigh],
+                          1,
+                          MPI_UNSIGNED,
+                          neighbor,
+                          0,
+                          m_migrate_comm,
+                          &req);
+            m_count_reqs.push_back(req);
+            }
+        }
+    m_count_req_offsets[m_num_stages] = (unsigned int)m_count_reqs.size();
+    }
+
+void mpcd::CommunicatorGPU::freeCountRequests()
+    {
+    for (auto& req : m_count_reqs)
+        MPI_Request_free(&req);
+    m_count_reqs.clear();
     }
 
 void mpcd::CommunicatorGPU::migrateParticles(uint64_t timestep)
@@ -172,212 +238,263 @@ void mpcd::CommunicatorGPU::migrateParticles(uint64_t timestep)
         m_mpcd_pdata->removeVirtualParticles();
         }
 
-    // reserve per neighbor memory
-    m_n_send_ptls.resize(m_n_unique_neigh);
-    m_n_recv_ptls.resize(m_n_unique_neigh);
-    m_offsets.resize(m_n_unique_neigh);
-
     // determine local particles that are to be sent to neighboring processors
     const BoxDim& box = m_mpcd_sys->getCellList()->getCoverageBox();
     setCommFlags(box);
 
     for (unsigned int stage = 0; stage < m_num_stages; stage++)
         {
-        const unsigned int comm_mask = m_comm_mask[stage];
-
-        // fill send buffer
-        if (m_prof)
-            m_prof->push(m_exec_conf, "pack");
-        m_mpcd_pdata->removeParticlesGPU(m_sendbuf, comm_mask, timestep);
-        if (m_prof)
-            m_prof->pop(m_exec_conf);
-
-        if (m_prof)
-            m_prof->push("sort");
-        // pack the buffers for each neighbor rank in this stage
-        std::fill(m_n_send_ptls.begin(), m_n_send_ptls.end(), 0);
-        if (m_sendbuf.size() > 0)
-            {
-            m_tmp_keys.resize(m_sendbuf.size());
+        startStage(stage, timestep);
+        finishStage(stage, box, timestep);
+        }
 
-            // sort the send buffer on the gpu
-            unsigned int num_send_neigh(0);
-                {
-                ArrayHandle<mpcd::detail::pdata_element> d_sendbuf(m_sendbuf,
-                                                                   access_location::device,
-                                                                   access_mode::readwrite);
-                ArrayHandle<unsigned int> d_neigh_send(m_neigh_send,
-                                                       access_location::device,
-                                                       access_mode::overwrite);
-                ArrayHandle<unsigned int> d_num_send(m_num_send,
-                                                     access_location::device,
-                                                     access_mode::overwrite);
-                ArrayHandle<unsigned int> d_tmp_keys(m_tmp_keys,
-                                                     access_location::device,
-                                                     access_mode::overwrite);
-                ArrayHandle<unsigned int> d_cart_ranks(m_decomposition->getCartRanks(),
-                                                       access_location::device,
-                                                       access_mode::read);
+    if (m_prof)
+        m_prof->pop();
+    }
 
-                num_send_neigh = (unsigned int)mpcd::gpu::sort_comm_send_buffer(
-                    d_sendbuf.data,
-                    d_neigh_send.data,
-                    d_num_send.data,
-                    d_tmp_keys.data,
-                    m_decomposition->getGridPos(),
-                    m_decomposition->getDomainIndexer(),
-                    m_comm_mask[stage],
-                    d_cart_ranks.data,
-                    (unsigned int)(m_sendbuf.size()));
-                }
+/*!
+ * \param timestep Timestep of the next call to communicate()
+ *
+ * The particles leaving the domain are packed and the messages of the first communication stage
+ * are posted. The particle data is left without the particles being sent until finishMigrate()
+ * adds the received ones. The migration is not started early if there are virtual particles or the
+ * decomposition needs to be checked, and communicate() migrates as usual instead.
+ */
+void mpcd::CommunicatorGPU::beginMigrate(uint64_t timestep)
+    {
+    if (m_is_communicating)
+        return;
 
-            // fill the number of particles to send for each neighbor
-            ArrayHandle<unsigned int> h_neigh_send(m_neigh_send,
-                                                   access_location::host,
-                                                   access_mode::read);
-            ArrayHandle<unsigned int> h_num_send(m_num_send,
-                                                 access_location::host,
-                                                 access_mode::read);
-            ArrayHandle<unsigned int> h_unique_neighbors(m_unique_neighbors,
-                                                         access_location::host,
-                                                         access_mode::read);
-            for (unsigned int i = 0; i < num_send_neigh; ++i)
-                {
-                const unsigned int neigh = m_unique_neigh_map.find(h_neigh_send.data[i])->second;
-                m_n_send_ptls[neigh] = h_num_send.data[i];
-                }
-            }
-        if (m_prof)
-            m_prof->pop();
+    m_mpcd_sys->getCellList()->computeDimensions();
+    if (m_check_decomposition || m_mpcd_pdata->getNVirtual() > 0)
+        return;
+
+    // guard against communicate() being called while the messages are in flight
+    m_is_communicating = true;
+    m_migrate_pending = true;
+    m_pending_timestep = timestep;
+
+    if (m_prof)
+        m_prof->push("MPCD comm");
+    setCommFlags(m_mpcd_sys->getCellList()->getCoverageBox());
+    startStage(0, timestep);
+    if (m_prof)
+        m_prof->pop();
+    }
+
+/*!
+ * \param timestep Timestep of the next call to communicate()
+ *
+ * The received particles of the first stage are added, and any remaining stages are communicated
+ * without overlap because they depend on the particles received in the first one.
+ */
+void mpcd::CommunicatorGPU::finishMigrate(uint64_t timestep)
+    {
+    if (!m_migrate_pending)
+        return;
+    assert(timestep == m_pending_timestep);
+
+    if (m_prof)
+        m_prof->push("MPCD comm");
+    const BoxDim& box = m_mpcd_sys->getCellList()->getCoverageBox();
+    finishStage(0, box, timestep);
+    for (unsigned int stage = 1; stage < m_num_stages; stage++)
+        {
+        startStage(stage, timestep);
+        finishStage(stage, box, timestep);
+        }
+    if (m_prof)
+        m_prof->pop();
+
+    m_migrate_pending = false;
+    m_is_communicating = false;
+    m_migrated_early = true;
+    m_migrated_timestep = m_pending_timestep;
+    }
 
-        // communicate total number of particles being sent and received from neighbor ranks
-        unsigned int n_recv_tot = 0;
+/*!
+ * \param stage Communication stage
+ * \param timestep Current timestep
+ *
+ * The particles flagged for this stage are removed into the send buffer and sorted by destination.
+ * The number of particles is exchanged with the neighbors, and the particle data messages are
+ * posted without waiting for them to complete.
+ */
+void mpcd::CommunicatorGPU::startStage(unsigned int stage, uint64_t timestep)
+    {
+    const unsigned int comm_mask = m_comm_mask[stage];
+
+    // fill send buffer
+    if (m_prof)
+        m_prof->push(m_exec_conf, "pack");
+    m_mpcd_pdata->removeParticlesGPU(m_sendbuf, comm_mask, timestep);
+    if (m_prof)
+        m_prof->pop(m_exec_conf);
+
+    if (m_prof)
+        m_prof->push("sort");
+    // pack the buffers for each neighbor rank in this stage
+    std::fill(m_n_send_ptls.begin(), m_n_send_ptls.end(), 0);
+    if (m_sendbuf.size() > 0)
+        {
+        m_tmp_keys.resize(m_sendbuf.size());
+
+        // sort the send buffer on the gpu
+        unsigned int num_send_neigh(0);
             {
-            // loop over neighbors
-            ArrayHandle<unsigned int> h_unique_neighbors(m_unique_neighbors,
-                                                         access_location::host,
-                                                         access_mode::read);
-            unsigned int nreq = 0;
-            m_reqs.resize(2 * m_n_unique_neigh);
-            for (unsigned int ineigh = 0; ineigh < m_n_unique_neigh; ++ineigh)
-                {
-                if (m_stages[ineigh] != (int)stage)
-                    {
-                    // skip neighbor if not participating in this communication stage
-                    m_n_send_ptls[ineigh] = 0;
-                    m_n_recv_ptls[ineigh] = 0;
-                    continue;
-                    }
-
-                // rank of neighbor processor
-                unsigned int neighbor = h_unique_neighbors.data[ineigh];
-
-                MPI_Isend(&m_n_send_ptls[ineigh],
-                          1,
-                          MPI_UNSIGNED,
-                          neighbor,
-                          0,
-                          m_mpi_comm,
-                          &m_reqs[nreq++]);
-                MPI_Irecv(&m_n_recv_ptls[ineigh],
-                          1,
-                          MPI_UNSIGNED,
-                          neighbor,
-                          0,
-                          m_mpi_comm,
-                          &m_reqs[nreq++]);
-                } // end neighbor loop
-            MPI_Waitall(nreq, m_reqs.data(), MPI_STATUSES_IGNORE);
+            ArrayHandle<mpcd::detail::pdata_element> d_sendbuf(m_sendbuf,
+                                                               access_location::device,
+                                                               access_mode::readwrite);
+            ArrayHandle<unsigned int> d_neigh_send(m_neigh_send,
+                                                   access_location::device,
+                                                   access_mode::overwrite);
+            ArrayHandle<unsigned int> d_num_send(m_num_send,
+                                                 access_location::device,
+                                                 access_mode::overwrite);
+            ArrayHandle<unsigned int> d_tmp_keys(m_tmp_keys,
+                                                 access_location::device,
+                                                 access_mode::overwrite);
+            ArrayHandle<unsigned int> d_cart_ranks(m_decomposition->getCartRanks(),
+                                                   access_location::device,
+                                                   access_mode::read);
 
-            // sum up receive counts
-            for (unsigned int ineigh = 0; ineigh < m_n_unique_neigh; ++ineigh)
-                {
-                m_offsets[ineigh] = n_recv_tot;
-                n_recv_tot += m_n_recv_ptls[ineigh];
-                }
+            num_send_neigh = (unsigned int)mpcd::gpu::sort_comm_send_buffer(
+                d_sendbuf.data,
+                d_neigh_send.data,
+                d_num_send.data,
+                d_tmp_keys.data,
+                m_decomposition->getGridPos(),
+                m_decomposition->getDomainIndexer(),
+                comm_mask,
+                d_cart_ranks.data,
+                (unsigned int)(m_sendbuf.size()));
             }
 
-        // Resize particles from neighbor ranks
-        m_recvbuf.resize(n_recv_tot);
+        // fill the number of particles to send for each neighbor
+        ArrayHandle<unsigned int> h_neigh_send(m_neigh_send,
+                                               access_location::host,
+                                               access_mode::read);
+        ArrayHandle<unsigned int> h_num_send(m_num_send, access_location::host, access_mode::read);
+        for (unsigned int i = 0; i < num_send_neigh; ++i)
             {
-            ArrayHandle<unsigned int> h_unique_neighbors(m_unique_neighbors,
-                                                         access_location::host,
-                                                         access_mode::read);
-            ArrayHandle<mpcd::detail::pdata_element> h_sendbuf(m_sendbuf,
-                                                               access_location::host,
-                                                               access_mode::read);
-            ArrayHandle<mpcd::detail::pdata_element> h_recvbuf(m_recvbuf,
-                                                               access_location::host,
-                                                               access_mode::overwrite);
-
-            // loop over neighbors
-            unsigned int nreq = 0;
-            m_reqs.resize(2 * m_n_unique_neigh);
-            unsigned int sendidx = 0;
-            for (unsigned int ineigh = 0; ineigh < m_n_unique_neigh; ++ineigh)
-                {
-                // rank of neighbor processor
-                unsigned int neighbor = h_unique_neighbors.data[ineigh];
-
-                // exchange particle data
-                if (m_n_send_ptls[ineigh])
-                    {
-                    MPI_Isend(h_sendbuf.data + sendidx,
-                              m_n_send_ptls[ineigh],
-                              m_pdata_element,
-                              neighbor,
-                              1,
-                              m_mpi_comm,
-                              &m_reqs[nreq++]);
-
-                    // increment the send index by the amount just transferred
-                    sendidx += m_n_send_ptls[ineigh];
-                    }
-
-                if (m_n_recv_ptls[ineigh])
-                    {
-                    MPI_Irecv(h_recvbuf.data + m_offsets[ineigh],
-                              m_n_recv_ptls[ineigh],
-                              m_pdata_element,
-                              neighbor,
-                              1,
-                              m_mpi_comm,
-                              &m_reqs[nreq++]);
-                    }
-                }
+            const unsigned int neigh = m_unique_neigh_map.find(h_neigh_send.data[i])->second;
+            m_n_send_ptls[neigh] = h_num_send.data[i];
+            }
+        }
+    if (m_prof)
+        m_prof->pop();
 
-            MPI_Waitall(nreq, m_reqs.data(), MPI_STATUSES_IGNORE);
+    // communicate total number of particles being sent and received from neighbor ranks
+    for (unsigned int ineigh = 0; ineigh < m_n_unique_neigh; ++ineigh)
+        {
+        // skip neighbor if not participating in this communication stage
+        if (m_stages[ineigh] != (int)stage)
+            {
+            m_n_send_ptls[ineigh] = 0;
+            m_n_recv_ptls[ineigh] = 0;
             }
+        }
+    const unsigned int first_req = m_count_req_offsets[stage];
+    const int n_count_reqs = m_count_req_offsets[stage + 1] - first_req;
+    MPI_Startall(n_count_reqs, m_count_reqs.data() + first_req);
+    MPI_Waitall(n_count_reqs, m_count_reqs.data() + first_req, MPI_STATUSES_IGNORE);
+
+    // sum up receive counts
+    m_n_recv_tot = 0;
+    for (unsigned int ineigh = 0; ineigh < m_n_unique_neigh; ++ineigh)
+        {
+        m_offsets[ineigh] = m_n_recv_tot;
+        m_n_recv_tot += m_n_recv_ptls[ineigh];
+        }
 
-        // wrap received particles through the global boundary
-        if (m_prof)
+    // Resize particles from neighbor ranks
+    m_recvbuf.resize(m_n_recv_tot);
+
+    // post the messages, which complete in finishStage
+    ArrayHandle<unsigned int> h_unique_neighbors(m_unique_neighbors,
+                                                 access_location::host,
+                                                 access_mode::read);
+    ArrayHandle<mpcd::detail::pdata_element> h_sendbuf(m_sendbuf,
+                                                       access_location::host,
+                                                       access_mode::read);
+    ArrayHandle<mpcd::detail::pdata_element> h_recvbuf(m_recvbuf,
+                                                       access_location::host,
+                                                       access_mode::overwrite);
+
+    // loop over neighbors
+    m_nreq = 0;
+    m_reqs.resize(2 * m_n_unique_neigh);
+    unsigned int sendidx = 0;
+    for (unsigned int ineigh = 0; ineigh < m_n_unique_neigh; ++ineigh)
+        {
+        // rank of neighbor processor
+        unsigned int neighbor = h_unique_neighbors.data[ineigh];
+
+        // exchange particle data
+        if (m_n_send_ptls[ineigh])
             {
-            m_prof->push(m_exec_conf, "wrap");
+            MPI_Isend(h_sendbuf.data + sendidx,
+                      m_n_send_ptls[ineigh],
+                      m_pdata_element,
+                      neighbor,
+                      1,
+                      m_migrate_comm,
+                      &m_reqs[m_nreq++]);
+
+            // increment the send index by the amount just transferred
+            sendidx += m_n_send_ptls[ineigh];
             }
 
+        if (m_n_recv_ptls[ineigh])
             {
-            ArrayHandle<mpcd::detail::pdata_element> d_recvbuf(m_recvbuf,
-                                                               access_location::device,
-                                                               access_mode::readwrite);
-            const BoxDim wrap_box = getWrapBox(box);
-            mpcd::gpu::wrap_particles(n_recv_tot, d_recvbuf.data, wrap_box);
-            if (m_exec_conf->isCUDAErrorCheckingEnabled())
-                CHECK_CUDA_ERROR();
+            MPI_Irecv(h_recvbuf.data + m_offsets[ineigh],
+                      m_n_recv_ptls[ineigh],
+                      m_pdata_element,
+                      neighbor,
+                      1,
+                      m_migrate_comm,
+                      &m_reqs[m_nreq++]);
             }
-        if (m_prof)
-            m_prof->pop(m_exec_conf);
+        }
+    }
 
-        // fill particle data with received particles
-        if (m_prof)
-            m_prof->push(m_exec_conf, "unpack");
-        m_mpcd_pdata->addParticlesGPU(m_recvbuf, comm_mask, timestep);
-        if (m_prof)
-            m_prof->pop(m_exec_conf);
+/*!
+ * \param stage Communication stage
+ * \param box Coverage box of the cell list
+ * \param timestep Current timestep
+ *
+ * Waits for the particle data messages posted by startStage(), then wraps the received particles
+ * and adds them to the particle data.
+ */
+void mpcd::CommunicatorGPU::finishStage(unsigned int stage, const BoxDim& box, uint64_t timestep)
+    {
+    MPI_Waitall(m_nreq, m_reqs.data(), MPI_STATUSES_IGNORE);
+    m_nreq = 0;
 
-        } // end communication stage
+    // wrap received particles through the global boundary
+    if (m_prof)
+        {
+        m_prof->push(m_exec_conf, "wrap");
+        }
 
+        {
+        ArrayHandle<mpcd::detail::pdata_element> d_recvbuf(m_recvbuf,
+                                                           access_location::device,
+                                                           access_mode::readwrite);
+        const BoxDim wrap_box = getWrapBox(box);
+        mpcd::gpu::wrap_particles(m_n_recv_tot, d_recvbuf.data, wrap_box);
+        if (m_exec_conf->isCUDAErrorCheckingEnabled())
+            CHECK_CUDA_ERROR();
+        }
     if (m_prof)
-        m_prof->pop();
+        m_prof->pop(m_exec_conf);
+
+    // fill particle data with received particles
+    if (m_prof)
+        m_prof->push(m_exec_conf, "unpack");
+    m_mpcd_pdata->addParticlesGPU(m_recvbuf, m_comm_mask[stage], timestep);
+    if (m_prof)
+        m_prof->pop(m_exec_conf);
     }
 
 /*!
@@ -394,9 +511,9 @@ void mpcd::CommunicatorGPU::setCommFlags(const BoxDim& box)
     ArrayHandle<unsigned int> d_comm_flag(m_mpcd_pdata->getCommFlags(),
                                           access_location::device,
                                           access_mode::overwrite);
-    ArrayHandle<Scalar4> d_pos(m_mpcd_pdata->getPositions(),
-                               access_location::device,
-                               access_mode::read);
+    ArrayHandle<mpcd::detail::pdata_real4> d_pos(m_mpcd_pdata->getPositions(),
+                                                 access_location::device,
+                                                 access_mode::read);
 
     m_flags_tuner->begin();
     mpcd::gpu::stage_particles(d_comm_flag.data,
@@ -43,8 +43,10 @@ namespace kernel
  *
  * Checks for particles being out of bounds, and aggregates send flags.
  */
-__global__ void
-stage_particles(unsigned int* d_comm_flag, const Scalar4* d_pos, unsigned int N, const BoxDim box)
+__global__ void stage_particles(unsigned int* d_comm_flag,
+                                const mpcd::detail::pdata_real4* d_pos,
+                                unsigned int N,
+                                const BoxDim box)
     {
     const unsigned int idx = blockIdx.x * blockDim.x + threadIdx.x;
     if (idx >= N)
@@ -165,7 +167,7 @@ struct get_migrate_key : public thrust::unary_function<const unsigned int, unsig
  * \returns Accumulated communication flags of all particles
  */
 cudaError_t mpcd::gpu::stage_particles(unsigned int* d_comm_flag,
-                                       const Scalar4* d_pos,
+                                       const mpcd::detail::pdata_real4* d_pos,
                                        const unsigned int N,
                                        const BoxDim& box,
                                        const unsigned int block_size)
@@ -292,8 +294,10 @@ struct wrap_particle_op
     __device__ mpcd::detail::pdata_element operator()(const mpcd::detail::pdata_element p)
         {
         mpcd::detail::pdata_element ret = p;
+        Scalar4 pos = ret.pos;
         int3 image = make_int3(0, 0, 0);
-        box.wrap(ret.pos, image);
+        box.wrap(pos, image);
+        ret.pos = pos;
         return ret;
         }
     };
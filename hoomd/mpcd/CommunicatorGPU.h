@@ -26,6 +26,7 @@
 #include "hoomd/SystemDefinition.h"
 
 #include <pybind11/pybind11.h>
+#include <stdexcept>
 
 namespace mpcd
     {
@@ -58,6 +59,12 @@ class PYBIND11_EXPORT CommunicatorGPU : public mpcd::Communicator
 
     //! Migrate particle data to local domain
     virtual void migrateParticles(uint64_t timestep);
+
+    //! Start migrating particles ahead of the call to communicate() at \a timestep
+    virtual void beginMigrate(uint64_t timestep);
+
+    //! Complete a migration started by beginMigrate()
+    virtual void finishMigrate(uint64_t timestep);
     //@}
 
     //! Set maximum number of communication stages
@@ -65,6 +72,10 @@ class PYBIND11_EXPORT CommunicatorGPU : public mpcd::Communicator
      */
     void setMaxStages(unsigned int max_stages)
         {
+        if (m_migrate_pending)
+            {
+            throw std::runtime_error("Cannot change MPCD communication stages during migration");
+            }
         m_max_stages = max_stages;
         initializeCommunicationStages();
         }
@@ -97,10 +108,31 @@ class PYBIND11_EXPORT CommunicatorGPU : public mpcd::Communicator
     std::vector<unsigned int> m_n_send_ptls; //!< Number of particles sent per neighbor
     std::vector<unsigned int> m_n_recv_ptls; //!< Number of particles received per neighbor
     std::vector<unsigned int> m_offsets;     //!< Offsets for particle send buffers
+    unsigned int m_n_recv_tot;               //!< Number of particles received in the current stage
+    unsigned int m_nreq;                     //!< Number of particle data requests in flight
+
+    MPI_Comm m_migrate_comm;                       //!< Communicator for migration messages
+    std::vector<MPI_Request> m_count_reqs;         //!< Persistent requests for the particle counts
+    std::vector<unsigned int> m_count_req_offsets; //!< First count request of each stage
+
+    bool m_migrate_pending;      //!< True between beginMigrate() and finishMigrate()
+    uint64_t m_pending_timestep; //!< Timestep passed to beginMigrate()
 
     //! Helper function to set up communication stages
     void initializeCommunicationStages();
 
+    //! Create the persistent requests for the particle counts
+    void initializeCountRequests();
+
+    //! Free the persistent requests for the particle counts
+    void freeCountRequests();
+
+    //! Pack the particles of a stage, exchange the counts, and post the particle data messages
+    void startStage(unsigned int stage, uint64_t timestep);
+
+    //! Wait for the particle data messages of a stage and add the received particles
+    void finishStage(unsigned int stage, const BoxDim& box, uint64_t timestep);
+
     /* Autotuners */
     std::unique_ptr<Autotuner> m_flags_tuner; //!< Tuner for marking communication flags
     };
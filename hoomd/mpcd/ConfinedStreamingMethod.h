@@ -108,12 +108,12 @@ template<class Geometry> void ConfinedStreamingMethod<Geometry>::stream(uint64_t
 
     const BoxDim& box = m_mpcd_sys->getCellList()->getCoverageBox();
 
-    ArrayHandle<Scalar4> h_pos(m_mpcd_pdata->getPositions(),
-                               access_location::host,
-                               access_mode::readwrite);
-    ArrayHandle<Scalar4> h_vel(m_mpcd_pdata->getVelocities(),
-                               access_location::host,
-                               access_mode::readwrite);
+    ArrayHandle<mpcd::detail::pdata_real4> h_pos(m_mpcd_pdata->getPositions(),
+                                                 access_location::host,
+                                                 access_mode::readwrite);
+    ArrayHandle<mpcd::detail::pdata_real4> h_vel(m_mpcd_pdata->getVelocities(),
+                                                 access_location::host,
+                                                 access_mode::readwrite);
     const Scalar mass = m_mpcd_pdata->getMass();
 
     // acquire polymorphic pointer to the external field
@@ -196,9 +196,9 @@ template<class Geometry> void ConfinedStreamingMethod<Geometry>::validate()
  */
 template<class Geometry> bool ConfinedStreamingMethod<Geometry>::validateParticles()
     {
-    ArrayHandle<Scalar4> h_pos(m_mpcd_pdata->getPositions(),
-                               access_location::host,
-                               access_mode::read);
+    ArrayHandle<mpcd::detail::pdata_real4> h_pos(m_mpcd_pdata->getPositions(),
+                                                 access_location::host,
+                                                 access_mode::read);
     ArrayHandle<unsigned int> h_tag(m_mpcd_pdata->getTags(),
                                     access_location::host,
                                     access_mode::read);
@@ -38,5 +38,34 @@ template cudaError_t
 confined_stream<mpcd::detail::SlitPoreGeometry>(const stream_args_t& args,
                                                 const mpcd::detail::SlitPoreGeometry& geom);
 
+//! Template instantiation of signed distance field geometry streaming
+template cudaError_t
+confined_stream<mpcd::detail::SDFGeometry>(const stream_args_t& args,
+                                           const mpcd::detail::SDFGeometry& geom);
+
+//! Template instantiation of bulk geometry streaming with cell binning
+template cudaError_t __attribute__((visibility("default")))
+confined_stream_bin<mpcd::detail::BulkGeometry>(const stream_args_t& args,
+                                                const cell_bin_args_t& bin_args,
+                                                const mpcd::detail::BulkGeometry& geom);
+
+//! Template instantiation of slit geometry streaming with cell binning
+template cudaError_t __attribute__((visibility("default")))
+confined_stream_bin<mpcd::detail::SlitGeometry>(const stream_args_t& args,
+                                                const cell_bin_args_t& bin_args,
+                                                const mpcd::detail::SlitGeometry& geom);
+
+//! Template instantiation of slit pore geometry streaming with cell binning
+template cudaError_t
+confined_stream_bin<mpcd::detail::SlitPoreGeometry>(const stream_args_t& args,
+                                                    const cell_bin_args_t& bin_args,
+                                                    const mpcd::detail::SlitPoreGeometry& geom);
+
+//! Template instantiation of signed distance field geometry streaming with cell binning
+template cudaError_t
+confined_stream_bin<mpcd::detail::SDFGeometry>(const stream_args_t& args,
+                                               const cell_bin_args_t& bin_args,
+                                               const mpcd::detail::SDFGeometry& geom);
+
     } // end namespace gpu
     } // end namespace mpcd
@@ -11,6 +11,7 @@
  * \brief Declaration of CUDA kernels for mpcd::ConfinedStreamingMethodGPU
  */
 
+#include "CellListGPU.cuh"
 #include "ExternalField.h"
 #include "ParticleDataUtilities.h"
 #include "hoomd/BoxDim.h"
@@ -24,8 +25,8 @@ namespace gpu
 struct stream_args_t
     {
     //! Constructor
-    stream_args_t(Scalar4* _d_pos,
-                  Scalar4* _d_vel,
+    stream_args_t(mpcd::detail::pdata_real4* _d_pos,
+                  mpcd::detail::pdata_real4* _d_vel,
                   const Scalar _mass,
                   const mpcd::ExternalField* _field,
                   const BoxDim& _box,
@@ -37,8 +38,8 @@ struct stream_args_t
         {
         }
 
-    Scalar4* d_pos;                   //!< Particle positions
-    Scalar4* d_vel;                   //!< Particle velocities
+    mpcd::detail::pdata_real4* d_pos;                   //!< Particle positions
+    mpcd::detail::pdata_real4* d_vel;                   //!< Particle velocities
     const Scalar mass;                //!< Particle mass
     const mpcd::ExternalField* field; //!< Applied external field on particles
     const BoxDim& box;                //!< Simulation box
@@ -51,6 +52,12 @@ struct stream_args_t
 template<class Geometry>
 cudaError_t confined_stream(const stream_args_t& args, const Geometry& geom);
 
+//! Kernel driver to stream particles ballistically and bin them into the cell list
+template<class Geometry>
+cudaError_t confined_stream_bin(const stream_args_t& args,
+                                const cell_bin_args_t& bin_args,
+                                const Geometry& geom);
+
 #ifdef __HIPCC__
 namespace kernel
     {
@@ -64,8 +71,10 @@ namespace kernel
  * \param field Applied external field
  * \param N Number of particles
  * \param geom Confined geometry
+ * \param bin_args Cell list to bin the particles into
  *
  * \tparam Geometry type of the confined geometry \a geom
+ * \tparam bin_cells If true, the particles are binned into the cell list described by \a bin_args
  *
  * \b Implementation
  * Using one thread per particle, the particle position and velocity is loaded.
@@ -78,16 +87,21 @@ namespace kernel
  * Particles crossing a periodic global boundary are wrapped back into the simulation box.
  * Particles are appropriately reflected from the boundaries defined by \a geom during the
  * position update step. The particle positions and velocities are updated accordingly.
+ *
+ * When \a bin_cells is true, the wrapped particle is also binned into the cell list with
+ * bin_cell_particle(), and its cell is stashed into the velocity array. This saves the separate
+ * pass over the particles that the cell list would otherwise make before the next collision.
  */
-template<class Geometry>
-__global__ void confined_stream(Scalar4* d_pos,
-                                Scalar4* d_vel,
+template<class Geometry, bool bin_cells>
+__global__ void confined_stream(mpcd::detail::pdata_real4* d_pos,
+                                mpcd::detail::pdata_real4* d_vel,
                                 const Scalar mass,
                                 const mpcd::ExternalField* field,
                                 const BoxDim box,
                                 const Scalar dt,
                                 const unsigned int N,
-                                const Geometry geom)
+                                const Geometry geom,
+                                const cell_bin_args_t bin_args)
     {
     // one thread per particle
     unsigned int idx = blockIdx.x * blockDim.x + threadIdx.x;
@@ -124,8 +138,16 @@ __global__ void confined_stream(Scalar4* d_pos,
     int3 image = make_int3(0, 0, 0);
     box.wrap(pos, image);
 
+    unsigned int cell = mpcd::detail::NO_CELL;
+    if (bin_cells)
+        {
+        unsigned int bin_idx;
+        if (bin_cell_particle(bin_idx, pos, idx, bin_args))
+            cell = bin_idx;
+        }
+
     d_pos[idx] = make_scalar4(pos.x, pos.y, pos.z, __int_as_scalar(type));
-    d_vel[idx] = make_scalar4(vel.x, vel.y, vel.z, __int_as_scalar(mpcd::detail::NO_CELL));
+    d_vel[idx] = make_scalar4(vel.x, vel.y, vel.z, __int_as_scalar(cell));
     }
 
     } // end namespace kernel
@@ -145,20 +167,70 @@ cudaError_t confined_stream(const stream_args_t& args, const Geometry& geom)
     if (max_block_size == UINT_MAX)
         {
         cudaFuncAttributes attr;
-        cudaFuncGetAttributes(&attr, (const void*)mpcd::gpu::kernel::confined_stream<Geometry>);
+        cudaFuncGetAttributes(&attr,
+                              (const void*)mpcd::gpu::kernel::confined_stream<Geometry, false>);
+        max_block_size = attr.maxThreadsPerBlock;
+        }
+
+    unsigned int run_block_size = min(args.block_size, max_block_size);
+    dim3 grid(args.N / run_block_size + 1);
+    mpcd::gpu::kernel::confined_stream<Geometry, false>
+        <<<grid, run_block_size>>>(args.d_pos,
+                                   args.d_vel,
+                                   args.mass,
+                                   args.field,
+                                   args.box,
+                                   args.dt,
+                                   args.N,
+                                   geom,
+                                   cell_bin_args_t());
+
+    return cudaSuccess;
+    }
+
+/*!
+ * \param args Common arguments for a streaming kernel
+ * \param bin_args Cell list to bin the particles into
+ * \param geom Confined geometry
+ *
+ * \tparam Geometry type of the confined geometry \a geom
+ *
+ * The number of particles in each cell is reset before the particles are streamed.
+ *
+ * \sa mpcd::gpu::kernel::confined_stream
+ */
+template<class Geometry>
+cudaError_t confined_stream_bin(const stream_args_t& args,
+                                const cell_bin_args_t& bin_args,
+                                const Geometry& geom)
+    {
+    // set the number of particles in each cell to zero
+    cudaError_t error = cudaMemset(bin_args.d_cell_np,
+                                   0,
+                                   sizeof(unsigned int) * bin_args.cell_indexer.getNumElements());
+    if (error != cudaSuccess)
+        return error;
+
+    static unsigned int max_block_size = UINT_MAX;
+    if (max_block_size == UINT_MAX)
+        {
+        cudaFuncAttributes attr;
+        cudaFuncGetAttributes(&attr,
+                              (const void*)mpcd::gpu::kernel::confined_stream<Geometry, true>);
         max_block_size = attr.maxThreadsPerBlock;
         }
 
     unsigned int run_block_size = min(args.block_size, max_block_size);
     dim3 grid(args.N / run_block_size + 1);
-    mpcd::gpu::kernel::confined_stream<Geometry><<<grid, run_block_size>>>(args.d_pos,
-                                                                           args.d_vel,
-                                                                           args.mass,
-                                                                           args.field,
-                                                                           args.box,
-                                                                           args.dt,
-                                                                           args.N,
-                                                                           geom);
+    mpcd::gpu::kernel::confined_stream<Geometry, true><<<grid, run_block_size>>>(args.d_pos,
+                                                                                 args.d_vel,
+                                                                                 args.mass,
+                                                                                 args.field,
+                                                                                 args.box,
+                                                                                 args.dt,
+                                                                                 args.N,
+                                                                                 geom,
+                                                                                 bin_args);
 
     return cudaSuccess;
     }
@@ -15,6 +15,7 @@
 #error This header cannot be compiled by nvcc
 #endif
 
+#include "CellListGPU.h"
 #include "ConfinedStreamingMethod.h"
 #include "ConfinedStreamingMethodGPU.cuh"
 #include "hoomd/Autotuner.h"
@@ -25,6 +26,9 @@ namespace mpcd
 /*!
  * This method implements the GPU version of ballistic propagation of MPCD
  * particles in a confined geometry.
+ *
+ * When requested with requestCellBinning(), the particles are also binned into the cell list of
+ * the next collision in the streaming kernel, provided that mpcd::CellListGPU supports it.
  */
 template<class Geometry>
 class PYBIND11_EXPORT ConfinedStreamingMethodGPU : public mpcd::ConfinedStreamingMethod<Geometry>
@@ -74,6 +78,10 @@ class PYBIND11_EXPORT ConfinedStreamingMethodGPU : public mpcd::ConfinedStreamin
  */
 template<class Geometry> void ConfinedStreamingMethodGPU<Geometry>::stream(uint64_t timestep)
     {
+    // a request to bin the particles only applies to this call
+    const bool bin_cells = this->m_bin_cells;
+    this->m_bin_cells = false;
+
     if (!this->shouldStream(timestep))
         return;
 
@@ -87,30 +95,61 @@ template<class Geometry> void ConfinedStreamingMethodGPU<Geometry>::stream(uint6
 
     if (this->m_prof)
         this->m_prof->push(this->m_exec_conf, "MPCD stream");
-    ArrayHandle<Scalar4> d_pos(this->m_mpcd_pdata->getPositions(),
-                               access_location::device,
-                               access_mode::readwrite);
-    ArrayHandle<Scalar4> d_vel(this->m_mpcd_pdata->getVelocities(),
-                               access_location::device,
-                               access_mode::readwrite);
-    mpcd::gpu::stream_args_t args(d_pos.data,
-                                  d_vel.data,
-                                  this->m_mpcd_pdata->getMass(),
-                                  (this->m_field) ? this->m_field->get(access_location::device)
-                                                  : nullptr,
-                                  this->m_mpcd_sys->getCellList()->getCoverageBox(),
-                                  this->m_mpcd_dt,
-                                  this->m_mpcd_pdata->getN(),
-                                  m_tuner->getParam());
-
-    m_tuner->begin();
-    mpcd::gpu::confined_stream<Geometry>(args, *(this->m_geom));
-    if (this->m_exec_conf->isCUDAErrorCheckingEnabled())
-        CHECK_CUDA_ERROR();
-    m_tuner->end();
-
-    // particles have moved, so the cell cache is no longer valid
+
+    // bin the particles for the next collision while streaming them if the cell list allows it
+    auto cl = std::dynamic_pointer_cast<mpcd::CellListGPU>(this->m_mpcd_sys->getCellList());
+    if (!bin_cells || !cl || !cl->canBinWhileStreaming())
+        cl.reset();
+
+        {
+        ArrayHandle<mpcd::detail::pdata_real4> d_pos(this->m_mpcd_pdata->getPositions(),
+                                                     access_location::device,
+                                                     access_mode::readwrite);
+        ArrayHandle<mpcd::detail::pdata_real4> d_vel(this->m_mpcd_pdata->getVelocities(),
+                                                     access_location::device,
+                                                     access_mode::readwrite);
+        mpcd::gpu::stream_args_t args(d_pos.data,
+                                      d_vel.data,
+                                      this->m_mpcd_pdata->getMass(),
+                                      (this->m_field) ? this->m_field->get(access_location::device)
+                                                      : nullptr,
+                                      this->m_mpcd_sys->getCellList()->getCoverageBox(),
+                                      this->m_mpcd_dt,
+                                      this->m_mpcd_pdata->getN(),
+                                      m_tuner->getParam());
+
+        if (cl)
+            {
+            ArrayHandle<unsigned int> d_cell_np(cl->getCellSizeArray(),
+                                                access_location::device,
+                                                access_mode::overwrite);
+            ArrayHandle<unsigned int> d_cell_list(cl->getCellList(),
+                                                  access_location::device,
+                                                  access_mode::overwrite);
+            mpcd::gpu::cell_bin_args_t bin_args
+                = cl->getStreamBinArgs(d_cell_np.data, d_cell_list.data, this->m_bin_grid_shift);
+
+            m_tuner->begin();
+            mpcd::gpu::confined_stream_bin<Geometry>(args, bin_args, *(this->m_geom));
+            if (this->m_exec_conf->isCUDAErrorCheckingEnabled())
+                CHECK_CUDA_ERROR();
+            m_tuner->end();
+            }
+        else
+            {
+            m_tuner->begin();
+            mpcd::gpu::confined_stream<Geometry>(args, *(this->m_geom));
+            if (this->m_exec_conf->isCUDAErrorCheckingEnabled())
+                CHECK_CUDA_ERROR();
+            m_tuner->end();
+            }
+        }
+
+    // particles have moved, so the cell cache is no longer valid unless they were binned
     this->m_mpcd_pdata->invalidateCellCache();
+    if (cl)
+        cl->finishStreamBinning(this->m_bin_timestep, this->m_bin_grid_shift);
+
     if (this->m_prof)
         this->m_prof->pop(this->m_exec_conf);
     }
@@ -126,7 +126,26 @@ void mpcd::Integrator::update(uint64_t timestep)
     // domains
     if (m_stream)
         {
+        // on the GPU, the particles can be binned into the cell list of the next collision while
+        // they are streamed, as long as no virtual particles are added before that collision
+        if (m_exec_conf->isCUDAEnabled() && m_collide && m_fillers.empty()
+            && m_stream->peekStream(timestep))
+            {
+            const uint64_t next_collide = timestep + m_stream->getPeriod();
+            if (m_collide->peekCollide(next_collide))
+                {
+                m_stream->requestCellBinning(next_collide,
+                                             m_collide->computeGridShift(next_collide));
+                }
+            }
         m_stream->stream(timestep);
+
+#ifdef ENABLE_MPI
+        // the particles are not moved again before the next collision, so they can start migrating
+        // while the MD forces are computed
+        if (m_mpcd_comm && checkCollide(timestep + 1))
+            m_mpcd_comm->beginMigrate(timestep + 1);
+#endif // ENABLE_MPI
         }
 
     // compute the net force on the MD particles
@@ -144,6 +163,11 @@ void mpcd::Integrator::update(uint64_t timestep)
         (*method)->integrateStepTwo(timestep);
     if (m_prof)
         m_prof->pop();
+
+#ifdef ENABLE_MPI
+    if (m_mpcd_comm)
+        m_mpcd_comm->finishMigrate(timestep + 1);
+#endif // ENABLE_MPI
     }
 
 /*!
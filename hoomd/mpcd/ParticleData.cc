@@ -269,8 +269,12 @@ void mpcd::ParticleData::initializeFromSnapshot(
             allocate(m_N);
 
         // Fill-up particle data arrays
-        ArrayHandle<Scalar4> h_pos(m_pos, access_location::host, access_mode::overwrite);
-        ArrayHandle<Scalar4> h_vel(m_vel, access_location::host, access_mode::overwrite);
+        ArrayHandle<mpcd::detail::pdata_real4> h_pos(m_pos,
+                                                     access_location::host,
+                                                     access_mode::overwrite);
+        ArrayHandle<mpcd::detail::pdata_real4> h_vel(m_vel,
+                                                     access_location::host,
+                                                     access_mode::overwrite);
         ArrayHandle<unsigned int> h_tag(m_tag, access_location::host, access_mode::overwrite);
         ArrayHandle<unsigned int> h_comm_flag(m_comm_flags,
                                               access_location::host,
@@ -292,8 +296,12 @@ void mpcd::ParticleData::initializeFromSnapshot(
         {
         allocate(snapshot->size);
 
-        ArrayHandle<Scalar4> h_pos(m_pos, access_location::host, access_mode::overwrite);
-        ArrayHandle<Scalar4> h_vel(m_vel, access_location::host, access_mode::overwrite);
+        ArrayHandle<mpcd::detail::pdata_real4> h_pos(m_pos,
+                                                     access_location::host,
+                                                     access_mode::overwrite);
+        ArrayHandle<mpcd::detail::pdata_real4> h_vel(m_vel,
+                                                     access_location::host,
+                                                     access_mode::overwrite);
         ArrayHandle<unsigned int> h_tag(m_tag, access_location::host, access_mode::overwrite);
 
         for (unsigned int snap_idx = 0; snap_idx < snapshot->size; ++snap_idx)
@@ -390,8 +398,12 @@ void mpcd::ParticleData::initializeRandom(unsigned int N,
 
     // allocate and fill up with random values
     allocate(m_N);
-    ArrayHandle<Scalar4> h_pos(m_pos, access_location::host, access_mode::overwrite);
-    ArrayHandle<Scalar4> h_vel(m_vel, access_location::host, access_mode::overwrite);
+    ArrayHandle<mpcd::detail::pdata_real4> h_pos(m_pos,
+                                                 access_location::host,
+                                                 access_mode::overwrite);
+    ArrayHandle<mpcd::detail::pdata_real4> h_vel(m_vel,
+                                                 access_location::host,
+                                                 access_mode::overwrite);
     ArrayHandle<unsigned int> h_tag(m_tag, access_location::host, access_mode::overwrite);
     double3 vel_cm = make_double3(0, 0, 0);
     for (unsigned int i = 0; i < m_N; ++i)
@@ -450,8 +462,8 @@ void mpcd::ParticleData::takeSnapshot(std::shared_ptr<mpcd::ParticleDataSnapshot
     {
     m_exec_conf->msg->notice(4) << "MPCD ParticleData: taking snapshot" << std::endl;
 
-    ArrayHandle<Scalar4> h_pos(m_pos, access_location::host, access_mode::read);
-    ArrayHandle<Scalar4> h_vel(m_vel, access_location::host, access_mode::read);
+    ArrayHandle<mpcd::detail::pdata_real4> h_pos(m_pos, access_location::host, access_mode::read);
+    ArrayHandle<mpcd::detail::pdata_real4> h_vel(m_vel, access_location::host, access_mode::read);
     ArrayHandle<unsigned int> h_tag(m_tag, access_location::host, access_mode::read);
 
 #ifdef ENABLE_MPI
@@ -644,10 +656,10 @@ void mpcd::ParticleData::allocate(unsigned int N_max)
     m_N_max = N_max;
 
     //! Allocate the particle data
-    GPUArray<Scalar4> pos(N_max, m_exec_conf);
+    GPUArray<mpcd::detail::pdata_real4> pos(N_max, m_exec_conf);
     m_pos.swap(pos);
 
-    GPUArray<Scalar4> vel(N_max, m_exec_conf);
+    GPUArray<mpcd::detail::pdata_real4> vel(N_max, m_exec_conf);
     m_vel.swap(vel);
 
     GPUArray<unsigned int> tag(N_max, m_exec_conf);
@@ -662,10 +674,10 @@ void mpcd::ParticleData::allocate(unsigned int N_max)
 #endif // ENABLE_MPI
 
     // Allocate the alternate data
-    GPUArray<Scalar4> pos_alt(N_max, m_exec_conf);
+    GPUArray<mpcd::detail::pdata_real4> pos_alt(N_max, m_exec_conf);
     m_pos_alt.swap(pos_alt);
 
-    GPUArray<Scalar4> vel_alt(N_max, m_exec_conf);
+    GPUArray<mpcd::detail::pdata_real4> vel_alt(N_max, m_exec_conf);
     m_vel_alt.swap(vel_alt);
 
     GPUArray<unsigned int> tag_alt(N_max, m_exec_conf);
@@ -827,7 +839,7 @@ Scalar3 mpcd::ParticleData::getPosition(unsigned int idx) const
                                   << " is out of range" << endl;
         throw std::runtime_error("Error accessing MPCD particle data.");
         }
-    ArrayHandle<Scalar4> h_pos(m_pos, access_location::host, access_mode::read);
+    ArrayHandle<mpcd::detail::pdata_real4> h_pos(m_pos, access_location::host, access_mode::read);
     const Scalar4 postype = h_pos.data[idx];
     return make_scalar3(postype.x, postype.y, postype.z);
     }
@@ -845,7 +857,7 @@ unsigned int mpcd::ParticleData::getType(unsigned int idx) const
                                   << " is out of range" << endl;
         throw std::runtime_error("Error accessing MPCD particle data.");
         }
-    ArrayHandle<Scalar4> h_pos(m_pos, access_location::host, access_mode::read);
+    ArrayHandle<mpcd::detail::pdata_real4> h_pos(m_pos, access_location::host, access_mode::read);
     const Scalar4 postype = h_pos.data[idx];
     return __scalar_as_int(postype.w);
     }
@@ -863,7 +875,7 @@ Scalar3 mpcd::ParticleData::getVelocity(unsigned int idx) const
                                   << " is out of range" << endl;
         throw std::runtime_error("Error accessing MPCD particle data.");
         }
-    ArrayHandle<Scalar4> h_vel(m_vel, access_location::host, access_mode::read);
+    ArrayHandle<mpcd::detail::pdata_real4> h_vel(m_vel, access_location::host, access_mode::read);
     const Scalar4 velcell = h_vel.data[idx];
     return make_scalar3(velcell.x, velcell.y, velcell.z);
     }
@@ -972,8 +984,12 @@ void mpcd::ParticleData::removeParticles(GPUVector<mpcd::detail::pdata_element>&
                                                access_location::host,
                                                access_mode::read);
 
-        ArrayHandle<Scalar4> h_pos(m_pos, access_location::host, access_mode::readwrite);
-        ArrayHandle<Scalar4> h_vel(m_vel, access_location::host, access_mode::readwrite);
+        ArrayHandle<mpcd::detail::pdata_real4> h_pos(m_pos,
+                                                     access_location::host,
+                                                     access_mode::readwrite);
+        ArrayHandle<mpcd::detail::pdata_real4> h_vel(m_vel,
+                                                     access_location::host,
+                                                     access_mode::readwrite);
         ArrayHandle<unsigned int> h_tag(m_tag, access_location::host, access_mode::readwrite);
         ArrayHandle<unsigned int> h_comm_flags(m_comm_flags,
                                                access_location::host,
@@ -1036,8 +1052,12 @@ void mpcd::ParticleData::addParticles(const GPUVector<mpcd::detail::pdata_elemen
 
         {
         // access particle data arrays
-        ArrayHandle<Scalar4> h_pos(getPositions(), access_location::host, access_mode::readwrite);
-        ArrayHandle<Scalar4> h_vel(getVelocities(), access_location::host, access_mode::readwrite);
+        ArrayHandle<mpcd::detail::pdata_real4> h_pos(getPositions(),
+                                                     access_location::host,
+                                                     access_mode::readwrite);
+        ArrayHandle<mpcd::detail::pdata_real4> h_vel(getVelocities(),
+                                                     access_location::host,
+                                                     access_mode::readwrite);
         ArrayHandle<unsigned int> h_tag(getTags(), access_location::host, access_mode::readwrite);
         ArrayHandle<unsigned int> h_comm_flags(m_comm_flags,
                                                access_location::host,
@@ -1161,8 +1181,12 @@ void mpcd::ParticleData::removeParticlesGPU(GPUVector<mpcd::detail::pdata_elemen
                                                        access_mode::overwrite);
 
         // access particle data arrays to read from
-        ArrayHandle<Scalar4> d_pos(m_pos, access_location::device, access_mode::readwrite);
-        ArrayHandle<Scalar4> d_vel(m_vel, access_location::device, access_mode::readwrite);
+        ArrayHandle<mpcd::detail::pdata_real4> d_pos(m_pos,
+                                                     access_location::device,
+                                                     access_mode::readwrite);
+        ArrayHandle<mpcd::detail::pdata_real4> d_vel(m_vel,
+                                                     access_location::device,
+                                                     access_mode::readwrite);
         ArrayHandle<unsigned int> d_tag(m_tag, access_location::device, access_mode::readwrite);
         ArrayHandle<unsigned int> d_comm_flags(m_comm_flags,
                                                access_location::device,
@@ -1216,8 +1240,12 @@ void mpcd::ParticleData::addParticlesGPU(const GPUVector<mpcd::detail::pdata_ele
 
         {
         // access particle data arrays
-        ArrayHandle<Scalar4> d_pos(m_pos, access_location::device, access_mode::readwrite);
-        ArrayHandle<Scalar4> d_vel(m_vel, access_location::device, access_mode::readwrite);
+        ArrayHandle<mpcd::detail::pdata_real4> d_pos(m_pos,
+                                                     access_location::device,
+                                                     access_mode::readwrite);
+        ArrayHandle<mpcd::detail::pdata_real4> d_vel(m_vel,
+                                                     access_location::device,
+                                                     access_mode::readwrite);
         ArrayHandle<unsigned int> d_tag(m_tag, access_location::device, access_mode::readwrite);
         ArrayHandle<unsigned int> d_comm_flags(m_comm_flags,
                                                access_location::device,
@@ -26,6 +26,81 @@ namespace detail
 //! Sentinel value to signify that this particle is not placed in a cell
 const unsigned int NO_CELL = 0xffffffff;
 
+#if defined(ENABLE_MPCD_MIXED_PRECISION) && !defined(SINGLE_PRECISION)
+#ifdef __HIPCC__
+#define HOSTDEVICE __host__ __device__
+#else
+#define HOSTDEVICE
+#endif
+
+//! Integer stored in the w component of a reduced precision element
+/*!
+ * The particle type and cell index are integers that are stuffed into the w component of the
+ * position and velocity. This wrapper keeps the bits of the integer in a float, and reads and
+ * writes them as a Scalar carrying the same integer, so that __scalar_as_int() and
+ * __int_as_scalar() work unchanged on the w component.
+ */
+struct pdata_int_bits
+    {
+    //! Get the integer as a Scalar
+    HOSTDEVICE operator Scalar() const
+        {
+        union {
+            float f;
+            int i;
+            } u;
+        u.f = bits;
+        return __int_as_scalar(u.i);
+        }
+
+    //! Set the integer from a Scalar
+    HOSTDEVICE pdata_int_bits& operator=(Scalar s)
+        {
+        union {
+            float f;
+            int i;
+            } u;
+        u.i = __scalar_as_int(s);
+        bits = u.f;
+        return *this;
+        }
+
+    float bits; //!< Bits of the integer
+    };
+
+//! Reduced precision storage for MPCD particle positions and velocities
+/*!
+ * The components are stored in float, and all arithmetic is done after conversion to Scalar4.
+ * This halves the memory needed for the MPCD particles in double precision builds.
+ */
+struct __attribute__((aligned(16))) pdata_real4
+    {
+    //! Default constructor
+    pdata_real4() = default;
+
+    //! Convert from Scalar4
+    HOSTDEVICE pdata_real4(const Scalar4& v) : x(float(v.x)), y(float(v.y)), z(float(v.z))
+        {
+        w = v.w;
+        }
+
+    //! Convert to Scalar4
+    HOSTDEVICE operator Scalar4() const
+        {
+        return make_scalar4(x, y, z, w);
+        }
+
+    float x;          //!< x component
+    float y;          //!< y component
+    float z;          //!< z component
+    pdata_int_bits w; //!< Integer stuffed in the w component
+    };
+#undef HOSTDEVICE
+#else
+//! Storage for MPCD particle positions and velocities
+typedef Scalar4 pdata_real4;
+#endif
+
 #ifdef ENABLE_MPI
 //! Structure to store packed MPCD particle data
 /*!
@@ -36,8 +111,8 @@ const unsigned int NO_CELL = 0xffffffff;
  */
 struct pdata_element
     {
-    Scalar4 pos;            //!< Position
-    Scalar4 vel;            //!< Velocity
+    pdata_real4 pos;        //!< Position
+    pdata_real4 vel;        //!< Velocity
     unsigned int tag;       //!< Global tag
     unsigned int comm_flag; //!< Communication flag
     };
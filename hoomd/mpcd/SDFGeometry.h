@@ -0,0 +1,355 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*!
+ * \file mpcd/SDFGeometry.h
+ * \brief Definition of the MPCD signed distance field geometry
+ */
+
+#ifndef MPCD_SDF_GEOMETRY_H_
+#define MPCD_SDF_GEOMETRY_H_
+
+#include "BoundaryCondition.h"
+
+#include "hoomd/BoxDim.h"
+#include "hoomd/HOOMDMath.h"
+#include "hoomd/Index1D.h"
+
+#ifdef __HIPCC__
+#define HOSTDEVICE __host__ __device__ inline
+#else
+#define HOSTDEVICE inline __attribute__((always_inline))
+#include "hoomd/managed_allocator.h"
+
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#endif // __HIPCC__
+
+namespace mpcd
+    {
+namespace detail
+    {
+//! Geometry defined by a signed distance field sampled on a grid
+/*!
+ * The boundary is the zero level set of a signed distance field \f$\phi(\mathbf{r})\f$. The field
+ * is negative inside the fluid and positive inside the solid. It is sampled on a regular, periodic
+ * grid of \f$n_x \times n_y \times n_z\f$ nodes that spans the orthorhombic global simulation box,
+ * with node \f$(i,j,k)\f$ located at \f$\mathbf{r}_{\rm lo} + (i h_x, j h_y, k h_z)\f$ and
+ * \f$h_x = L_x/n_x\f$. Between nodes, \f$\phi\f$ is trilinearly interpolated, and the surface
+ * normal is the normalized gradient of the interpolant.
+ *
+ * A collision is detected when the proposed position has \f$\phi > 0\f$. The point of contact is
+ * found by bisection along the straight line the particle traveled during the step, keeping the
+ * bracket end that lies in the fluid so that the particle is never placed outside. The velocity is
+ * then reversed (no-slip) or its normal component is reflected (slip). Crossings of features
+ * thinner than the distance traveled in one streaming step cannot be resolved, so the grid and
+ * time step should be chosen accordingly.
+ *
+ * The geometry is a lightweight view of the grid so that it can be copied by value into GPU
+ * kernels. The grid itself is held in managed memory that is owned by the shared pointer returned
+ * by create(), and it is freed when the last copy of that pointer is released.
+ */
+class __attribute__((visibility("default"))) SDFGeometry
+    {
+    public:
+    //! Constructor
+    /*!
+     * \param sdf Signed distance field on the grid, indexed by \a indexer
+     * \param indexer Indexer for the grid nodes
+     * \param lo Lower corner of the grid
+     * \param L Edge lengths of the grid
+     * \param bc Boundary condition at the wall (slip or no-slip)
+     *
+     * The geometry does not take ownership of \a sdf, which must remain valid for its lifetime.
+     */
+    HOSTDEVICE SDFGeometry(const Scalar* sdf,
+                           const Index3D& indexer,
+                           const Scalar3& lo,
+                           const Scalar3& L,
+                           boundary bc)
+        : m_sdf(sdf), m_indexer(indexer), m_lo(lo), m_L(L), m_bc(bc)
+        {
+        m_inv_h = make_scalar3(Scalar(indexer.getW()) / L.x,
+                               Scalar(indexer.getH()) / L.y,
+                               Scalar(indexer.getD()) / L.z);
+        }
+
+    //! Detect collision between the particle and the boundary
+    /*!
+     * \param pos Proposed particle position
+     * \param vel Proposed particle velocity
+     * \param dt Integration time remaining
+     *
+     * \returns True if a collision occurred, and false otherwise
+     *
+     * \post The particle position \a pos is moved to the point of reflection, the velocity \a vel
+     * is updated according to the appropriate bounce back rule, and the integration time \a dt is
+     * decreased to the amount of time remaining.
+     */
+    HOSTDEVICE bool detectCollision(Scalar3& pos, Scalar3& vel, Scalar& dt) const
+        {
+        // exit immediately if the particle is inside or not moving (no new collision)
+        const bool moving = (vel.x != Scalar(0) || vel.y != Scalar(0) || vel.z != Scalar(0));
+        if (!moving || !(getDistance(pos) > Scalar(0)))
+            {
+            dt = Scalar(0);
+            return false;
+            }
+
+        // bisect for the time to backtrack, keeping out_dt outside and in_dt inside the fluid
+        Scalar out_dt(0);
+        Scalar in_dt(dt);
+        for (unsigned int i = 0; i < num_bisection; ++i)
+            {
+            const Scalar mid_dt = Scalar(0.5) * (out_dt + in_dt);
+            const Scalar3 mid = make_scalar3(pos.x - vel.x * mid_dt,
+                                             pos.y - vel.y * mid_dt,
+                                             pos.z - vel.z * mid_dt);
+            if (getDistance(mid) > Scalar(0))
+                out_dt = mid_dt;
+            else
+                in_dt = mid_dt;
+            }
+        dt = in_dt;
+
+        // backtrack the particle for dt to get to point of contact
+        pos.x -= vel.x * dt;
+        pos.y -= vel.y * dt;
+        pos.z -= vel.z * dt;
+
+        // no-slip reverses the velocity, slip only reflects the normal component
+        const Scalar3 grad = getGradient(pos);
+        const Scalar gradsq = grad.x * grad.x + grad.y * grad.y + grad.z * grad.z;
+        if (m_bc == boundary::no_slip || gradsq == Scalar(0))
+            {
+            vel.x = -vel.x;
+            vel.y = -vel.y;
+            vel.z = -vel.z;
+            }
+        else
+            {
+            const Scalar factor = Scalar(2) * (vel.x * grad.x + vel.y * grad.y + vel.z * grad.z)
+                                  / gradsq;
+            vel.x -= factor * grad.x;
+            vel.y -= factor * grad.y;
+            vel.z -= factor * grad.z;
+            }
+
+        return true;
+        }
+
+    //! Check if a particle is out of bounds
+    /*!
+     * \param pos Current particle position
+     * \returns True if particle is out of bounds, and false otherwise
+     */
+    HOSTDEVICE bool isOutside(const Scalar3& pos) const
+        {
+        return (getDistance(pos) > Scalar(0));
+        }
+
+    //! Validate that the simulation box matches the grid
+    /*!
+     * \param box Global simulation box
+     * \param cell_size Size of MPCD cell
+     *
+     * The grid is periodic in the box, so the box must be orthorhombic and span the grid. The
+     * padding required between periodic images of the boundary cannot be checked for an arbitrary
+     * field, and must be built into the field by the user.
+     */
+    HOSTDEVICE bool validateBox(const BoxDim& box, Scalar cell_size) const
+        {
+        if (box.getTiltFactorXY() != Scalar(0) || box.getTiltFactorXZ() != Scalar(0)
+            || box.getTiltFactorYZ() != Scalar(0))
+            {
+            return false;
+            }
+
+        // the corners of the box and grid must agree to a relative tolerance
+        const Scalar3 dlo = box.getLo() - m_lo;
+        const Scalar3 dhi = box.getHi() - (m_lo + m_L);
+        const Scalar tol = Scalar(1e-5);
+        return (dlo.x * dlo.x + dhi.x * dhi.x <= tol * tol * m_L.x * m_L.x
+                && dlo.y * dlo.y + dhi.y * dhi.y <= tol * tol * m_L.y * m_L.y
+                && dlo.z * dlo.z + dhi.z * dhi.z <= tol * tol * m_L.z * m_L.z);
+        }
+
+    //! Interpolate the signed distance to the boundary
+    /*!
+     * \param pos Position
+     * \returns Signed distance at \a pos, which is positive outside the fluid
+     */
+    HOSTDEVICE Scalar getDistance(const Scalar3& pos) const
+        {
+        Scalar c[8];
+        Scalar3 w;
+        loadCorners(pos, c, w);
+
+        const Scalar c00 = c[0] + w.x * (c[1] - c[0]);
+        const Scalar c10 = c[2] + w.x * (c[3] - c[2]);
+        const Scalar c01 = c[4] + w.x * (c[5] - c[4]);
+        const Scalar c11 = c[6] + w.x * (c[7] - c[6]);
+        const Scalar c0 = c00 + w.y * (c10 - c00);
+        const Scalar c1 = c01 + w.y * (c11 - c01);
+        return c0 + w.z * (c1 - c0);
+        }
+
+    //! Gradient of the interpolated signed distance
+    /*!
+     * \param pos Position
+     * \returns Gradient at \a pos, which points out of the fluid
+     */
+    HOSTDEVICE Scalar3 getGradient(const Scalar3& pos) const
+        {
+        Scalar c[8];
+        Scalar3 w;
+        loadCorners(pos, c, w);
+
+        const Scalar dx = (1 - w.y) * (1 - w.z) * (c[1] - c[0]) + w.y * (1 - w.z) * (c[3] - c[2])
+                          + (1 - w.y) * w.z * (c[5] - c[4]) + w.y * w.z * (c[7] - c[6]);
+        const Scalar dy = (1 - w.x) * (1 - w.z) * (c[2] - c[0]) + w.x * (1 - w.z) * (c[3] - c[1])
+                          + (1 - w.x) * w.z * (c[6] - c[4]) + w.x * w.z * (c[7] - c[5]);
+        const Scalar dz = (1 - w.x) * (1 - w.y) * (c[4] - c[0]) + w.x * (1 - w.y) * (c[5] - c[1])
+                          + (1 - w.x) * w.y * (c[6] - c[2]) + w.x * w.y * (c[7] - c[3]);
+        return make_scalar3(dx * m_inv_h.x, dy * m_inv_h.y, dz * m_inv_h.z);
+        }
+
+    //! Get the grid indexer
+    HOSTDEVICE const Index3D& getIndexer() const
+        {
+        return m_indexer;
+        }
+
+    //! Get the lower corner of the grid
+    HOSTDEVICE Scalar3 getLo() const
+        {
+        return m_lo;
+        }
+
+    //! Get the edge lengths of the grid
+    HOSTDEVICE Scalar3 getL() const
+        {
+        return m_L;
+        }
+
+    //! Get the wall boundary condition
+    /*!
+     * \returns Boundary condition at wall
+     */
+    HOSTDEVICE boundary getBoundaryCondition() const
+        {
+        return m_bc;
+        }
+
+#ifndef __HIPCC__
+    //! Get the unique name of this geometry
+    static std::string getName()
+        {
+        return std::string("SDF");
+        }
+
+    //! Create a geometry that owns a copy of the grid
+    /*!
+     * \param use_device If true, the grid is allocated in managed memory accessible by the GPU
+     * \param sdf Signed distance field, indexed by \a indexer
+     * \param indexer Indexer for the grid nodes
+     * \param lo Lower corner of the grid
+     * \param L Edge lengths of the grid
+     * \param bc Boundary condition at the wall (slip or no-slip)
+     *
+     * \returns A geometry whose grid is freed with the last copy of the returned pointer
+     */
+    static std::shared_ptr<SDFGeometry> create(bool use_device,
+                                               const Scalar* sdf,
+                                               const Index3D& indexer,
+                                               const Scalar3& lo,
+                                               const Scalar3& L,
+                                               boundary bc)
+        {
+        const unsigned int N = indexer.getNumElements();
+        if (N == 0)
+            {
+            throw std::runtime_error("SDF grid must have at least one node");
+            }
+        if (!(L.x > Scalar(0) && L.y > Scalar(0) && L.z > Scalar(0)))
+            {
+            throw std::runtime_error("SDF grid must have positive edge lengths");
+            }
+
+        Scalar* data = managed_allocator<Scalar>(use_device).allocate(N);
+        std::copy(sdf, sdf + N, data);
+
+        return std::shared_ptr<SDFGeometry>(new SDFGeometry(data, indexer, lo, L, bc),
+                                            [data, N, use_device](SDFGeometry* geom)
+                                            {
+                                                managed_allocator<Scalar>(use_device)
+                                                    .deallocate(data, N);
+                                                delete geom;
+                                            });
+        }
+#endif // __HIPCC__
+
+    private:
+    const Scalar* m_sdf; //!< Signed distance field on the grid
+    Index3D m_indexer;   //!< Indexer for the grid nodes
+    Scalar3 m_lo;        //!< Lower corner of the grid
+    Scalar3 m_L;         //!< Edge lengths of the grid
+    Scalar3 m_inv_h;     //!< Inverse grid spacing
+    boundary m_bc;       //!< Boundary condition
+
+    //! Number of bisections used to locate the point of contact
+    static const unsigned int num_bisection = 16;
+
+    //! Load the field at the corners of the grid cell containing a position
+    /*!
+     * \param pos Position
+     * \param c Field at the 8 corners, with x varying fastest and z slowest
+     * \param w Fractional position of \a pos in the grid cell
+     *
+     * Indexes wrap periodically, so \a pos does not need to be inside the box.
+     */
+    HOSTDEVICE void loadCorners(const Scalar3& pos, Scalar* c, Scalar3& w) const
+        {
+        const Scalar fx = (pos.x - m_lo.x) * m_inv_h.x;
+        const Scalar fy = (pos.y - m_lo.y) * m_inv_h.y;
+        const Scalar fz = (pos.z - m_lo.z) * m_inv_h.z;
+        const Scalar flx = slow::floor(fx);
+        const Scalar fly = slow::floor(fy);
+        const Scalar flz = slow::floor(fz);
+        w = make_scalar3(fx - flx, fy - fly, fz - flz);
+
+        const int nx = m_indexer.getW();
+        const int ny = m_indexer.getH();
+        const int nz = m_indexer.getD();
+        int i0 = int(flx) % nx;
+        int j0 = int(fly) % ny;
+        int k0 = int(flz) % nz;
+        if (i0 < 0)
+            i0 += nx;
+        if (j0 < 0)
+            j0 += ny;
+        if (k0 < 0)
+            k0 += nz;
+        const int i1 = (i0 + 1 == nx) ? 0 : i0 + 1;
+        const int j1 = (j0 + 1 == ny) ? 0 : j0 + 1;
+        const int k1 = (k0 + 1 == nz) ? 0 : k0 + 1;
+
+        c[0] = m_sdf[m_indexer(i0, j0, k0)];
+        c[1] = m_sdf[m_indexer(i1, j0, k0)];
+        c[2] = m_sdf[m_indexer(i0, j1, k0)];
+        c[3] = m_sdf[m_indexer(i1, j1, k0)];
+        c[4] = m_sdf[m_indexer(i0, j0, k1)];
+        c[5] = m_sdf[m_indexer(i1, j0, k1)];
+        c[6] = m_sdf[m_indexer(i0, j1, k1)];
+        c[7] = m_sdf[m_indexer(i1, j1, k1)];
+        }
+    };
+
+    } // end namespace detail
+    } // end namespace mpcd
+
+#undef HOSTDEVICE
+
+#endif // MPCD_SDF_GEOMETRY_H_
@@ -0,0 +1,277 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*!
+ * \file mpcd/SDFGeometryFiller.cc
+ * \brief Definition of mpcd::SDFGeometryFiller
+ */
+
+#include "SDFGeometryFiller.h"
+#include "hoomd/RNGIdentifiers.h"
+#include "hoomd/RandomNumbers.h"
+
+#include <algorithm>
+#include <vector>
+
+mpcd::SDFGeometryFiller::SDFGeometryFiller(std::shared_ptr<mpcd::SystemData> sysdata,
+                                           Scalar density,
+                                           unsigned int type,
+                                           std::shared_ptr<::Variant> T,
+                                           uint16_t seed,
+                                           std::shared_ptr<const mpcd::detail::SDFGeometry> geom)
+    : mpcd::VirtualParticleFiller(sysdata, density, type, T), m_num_boxes(0),
+      m_box_lo(m_exec_conf), m_box_hi(m_exec_conf), m_ranges(m_exec_conf), m_thickness(0)
+    {
+    m_exec_conf->msg->notice(5) << "Constructing MPCD SDFGeometryFiller" << std::endl;
+
+    setGeometry(geom);
+
+    // unphysical values in cache to always force recompute
+    m_needs_recompute = true;
+    m_recompute_cache = make_scalar2(-1, -1);
+    m_pdata->getBoxChangeSignal()
+        .connect<mpcd::SDFGeometryFiller, &mpcd::SDFGeometryFiller::notifyRecompute>(this);
+    }
+
+mpcd::SDFGeometryFiller::~SDFGeometryFiller()
+    {
+    m_exec_conf->msg->notice(5) << "Destroying MPCD SDFGeometryFiller" << std::endl;
+    m_pdata->getBoxChangeSignal()
+        .disconnect<mpcd::SDFGeometryFiller, &mpcd::SDFGeometryFiller::notifyRecompute>(this);
+    }
+
+void mpcd::SDFGeometryFiller::computeNumFill()
+    {
+    const Scalar cell_size = m_cl->getCellSize();
+
+    // check if fill-relevant variables have changed (can't use signal because cell list build may
+    // not have triggered yet)
+    m_needs_recompute |= (m_recompute_cache.x != cell_size || m_recompute_cache.y != m_density);
+
+    // only recompute if needed
+    if (!m_needs_recompute)
+        return;
+
+    // as a precaution, validate the global box with the current cell list
+    const BoxDim& global_box = m_pdata->getGlobalBox();
+    if (!m_geom->validateBox(global_box, cell_size))
+        {
+        m_exec_conf->msg->error()
+            << "Invalid SDF geometry for global box, cannot fill virtual particles." << std::endl;
+        throw std::runtime_error("Invalid SDF geometry for global box");
+        }
+
+    // any point of a cell overlapping the fluid is within one cell diagonal of the fluid
+    m_thickness = fast::sqrt(Scalar(3.0)) * cell_size;
+
+    // range of grid voxels overlapping the local domain
+    const Index3D& indexer = m_geom->getIndexer();
+    const Scalar3 grid_lo = m_geom->getLo();
+    const Scalar3 grid_L = m_geom->getL();
+    const int3 n = make_int3(indexer.getW(), indexer.getH(), indexer.getD());
+    const Scalar3 h = make_scalar3(grid_L.x / n.x, grid_L.y / n.y, grid_L.z / n.z);
+
+    const BoxDim& box = m_pdata->getBox();
+    const Scalar3 lo = box.getLo();
+    const Scalar3 hi = box.getHi();
+    const int3 first = make_int3(std::max(int(std::floor((lo.x - grid_lo.x) / h.x)), 0),
+                                 std::max(int(std::floor((lo.y - grid_lo.y) / h.y)), 0),
+                                 std::max(int(std::floor((lo.z - grid_lo.z) / h.z)), 0));
+    const int3 last = make_int3(std::min(int(std::ceil((hi.x - grid_lo.x) / h.x)), n.x),
+                                std::min(int(std::ceil((hi.y - grid_lo.y) / h.y)), n.y),
+                                std::min(int(std::ceil((hi.z - grid_lo.z) / h.z)), n.z));
+
+    /*
+     * Take every voxel that can have a signed distance in (0, thickness]. The interpolated field
+     * is bounded by the values at the voxel corners, so most voxels are decided by the corners
+     * alone. The fraction of the remaining voxels in the fill region is estimated on a grid of
+     * sample points. The particle ranges are rounded from the cumulative volume so that the total
+     * number of particles does not suffer from rounding many small voxels.
+     */
+    const unsigned int num_sample = 4;
+    std::vector<Scalar3> box_lo, box_hi;
+    std::vector<uint2> ranges;
+    double cum_volume = 0.0;
+    m_N_fill = 0;
+    for (int k = first.z; k < last.z; ++k)
+        {
+        for (int j = first.y; j < last.y; ++j)
+            {
+            for (int i = first.x; i < last.x; ++i)
+                {
+                const Scalar3 vox_lo = make_scalar3(grid_lo.x + i * h.x,
+                                                    grid_lo.y + j * h.y,
+                                                    grid_lo.z + k * h.z);
+                Scalar min_dist = m_geom->getDistance(vox_lo);
+                Scalar max_dist = min_dist;
+                for (unsigned int corner = 1; corner < 8; ++corner)
+                    {
+                    const Scalar3 r = make_scalar3(vox_lo.x + (corner & 1) * h.x,
+                                                   vox_lo.y + ((corner >> 1) & 1) * h.y,
+                                                   vox_lo.z + ((corner >> 2) & 1) * h.z);
+                    const Scalar dist = m_geom->getDistance(r);
+                    min_dist = std::min(min_dist, dist);
+                    max_dist = std::max(max_dist, dist);
+                    }
+                if (max_dist <= Scalar(0) || min_dist > m_thickness)
+                    continue;
+
+                // clamp the voxel to the local domain
+                const Scalar3 clamp_lo = make_scalar3(std::max(vox_lo.x, lo.x),
+                                                      std::max(vox_lo.y, lo.y),
+                                                      std::max(vox_lo.z, lo.z));
+                const Scalar3 clamp_hi = make_scalar3(std::min(vox_lo.x + h.x, hi.x),
+                                                      std::min(vox_lo.y + h.y, hi.y),
+                                                      std::min(vox_lo.z + h.z, hi.z));
+                const Scalar3 clamp_L = clamp_hi - clamp_lo;
+                if (clamp_L.x <= Scalar(0) || clamp_L.y <= Scalar(0) || clamp_L.z <= Scalar(0))
+                    continue;
+
+                double fraction = 1.0;
+                if (min_dist <= Scalar(0) || max_dist > m_thickness)
+                    {
+                    unsigned int num_in = 0;
+                    for (unsigned int sk = 0; sk < num_sample; ++sk)
+                        for (unsigned int sj = 0; sj < num_sample; ++sj)
+                            for (unsigned int si = 0; si < num_sample; ++si)
+                                {
+                                const Scalar3 r = make_scalar3(
+                                    clamp_lo.x + (si + Scalar(0.5)) * clamp_L.x / num_sample,
+                                    clamp_lo.y + (sj + Scalar(0.5)) * clamp_L.y / num_sample,
+                                    clamp_lo.z + (sk + Scalar(0.5)) * clamp_L.z / num_sample);
+                                const Scalar dist = m_geom->getDistance(r);
+                                if (dist > Scalar(0) && dist <= m_thickness)
+                                    ++num_in;
+                                }
+                    fraction = double(num_in) / (num_sample * num_sample * num_sample);
+                    }
+                if (fraction == 0.0)
+                    continue;
+
+                cum_volume += fraction * clamp_L.x * clamp_L.y * clamp_L.z;
+                const unsigned int N_end = (unsigned int)std::round(cum_volume * m_density);
+                if (N_end > m_N_fill)
+                    {
+                    box_lo.push_back(clamp_lo);
+                    box_hi.push_back(clamp_hi);
+                    ranges.push_back(make_uint2(m_N_fill, N_end));
+                    m_N_fill = N_end;
+                    }
+                }
+            }
+        }
+
+    // copy the boxes into the fill arrays
+    m_num_boxes = (unsigned int)ranges.size();
+    if (m_num_boxes > m_ranges.getNumElements())
+        {
+        m_box_lo.resize(m_num_boxes);
+        m_box_hi.resize(m_num_boxes);
+        m_ranges.resize(m_num_boxes);
+        }
+    if (m_num_boxes > 0)
+        {
+        ArrayHandle<Scalar3> h_box_lo(m_box_lo, access_location::host, access_mode::overwrite);
+        ArrayHandle<Scalar3> h_box_hi(m_box_hi, access_location::host, access_mode::overwrite);
+        ArrayHandle<uint2> h_ranges(m_ranges, access_location::host, access_mode::overwrite);
+        std::copy(box_lo.begin(), box_lo.end(), h_box_lo.data);
+        std::copy(box_hi.begin(), box_hi.end(), h_box_hi.data);
+        std::copy(ranges.begin(), ranges.end(), h_ranges.data);
+        }
+
+    // size is now updated, cache the cell dimensions used
+    m_needs_recompute = false;
+    m_recompute_cache = make_scalar2(cell_size, m_density);
+    }
+
+/*!
+ * \param timestep Current timestep to draw particles
+ */
+void mpcd::SDFGeometryFiller::drawParticles(uint64_t timestep)
+    {
+    // quit early if not filling to ensure we don't access any memory that hasn't been set
+    if (m_N_fill == 0)
+        return;
+
+    ArrayHandle<mpcd::detail::pdata_real4> h_pos(m_mpcd_pdata->getPositions(),
+                                                 access_location::host,
+                                                 access_mode::readwrite);
+    ArrayHandle<mpcd::detail::pdata_real4> h_vel(m_mpcd_pdata->getVelocities(),
+                                                 access_location::host,
+                                                 access_mode::readwrite);
+    ArrayHandle<unsigned int> h_tag(m_mpcd_pdata->getTags(),
+                                    access_location::host,
+                                    access_mode::readwrite);
+    const Scalar vel_factor = fast::sqrt((*m_T)(timestep) / m_mpcd_pdata->getMass());
+
+    // boxes for filling
+    ArrayHandle<Scalar3> h_box_lo(m_box_lo, access_location::host, access_mode::read);
+    ArrayHandle<Scalar3> h_box_hi(m_box_hi, access_location::host, access_mode::read);
+    ArrayHandle<uint2> h_ranges(m_ranges, access_location::host, access_mode::read);
+    // set these counters so that they get filled on the first pass
+    int boxid = -1;
+    unsigned int boxlast = 0;
+    Scalar3 lo = make_scalar3(0, 0, 0);
+    Scalar3 hi = make_scalar3(0, 0, 0);
+
+    uint16_t seed = m_sysdef->getSeed();
+
+    // index to start filling from
+    const unsigned int first_idx = m_mpcd_pdata->getN() + m_mpcd_pdata->getNVirtual() - m_N_fill;
+    for (unsigned int i = 0; i < m_N_fill; ++i)
+        {
+        const unsigned int tag = m_first_tag + i;
+        hoomd::RandomGenerator rng(
+            hoomd::Seed(hoomd::RNGIdentifier::SDFGeometryFiller, timestep, seed),
+            hoomd::Counter(tag));
+
+        // advanced past end of this box range, take the next
+        if (i >= boxlast)
+            {
+            ++boxid;
+            boxlast = h_ranges.data[boxid].y;
+            lo = h_box_lo.data[boxid];
+            hi = h_box_hi.data[boxid];
+            }
+
+        // draw by rejection in voxels that are only partially in the fill region
+        Scalar3 pos;
+        for (unsigned int attempt = 0; attempt < MAX_ATTEMPTS; ++attempt)
+            {
+            pos = make_scalar3(hoomd::UniformDistribution<Scalar>(lo.x, hi.x)(rng),
+                               hoomd::UniformDistribution<Scalar>(lo.y, hi.y)(rng),
+                               hoomd::UniformDistribution<Scalar>(lo.z, hi.z)(rng));
+            const Scalar dist = m_geom->getDistance(pos);
+            if (dist > Scalar(0) && dist <= m_thickness)
+                break;
+            }
+
+        const unsigned int pidx = first_idx + i;
+        h_pos.data[pidx] = make_scalar4(pos.x, pos.y, pos.z, __int_as_scalar(m_type));
+
+        hoomd::NormalDistribution<Scalar> gen(vel_factor, 0.0);
+        Scalar vel[3];
+        gen(vel, rng);
+        h_vel.data[pidx]
+            = make_scalar4(vel[0], vel[1], vel[2], __int_as_scalar(mpcd::detail::NO_CELL));
+        h_tag.data[pidx] = tag;
+        }
+    }
+
+/*!
+ * \param m Python module to export to
+ */
+void mpcd::detail::export_SDFGeometryFiller(pybind11::module& m)
+    {
+    namespace py = pybind11;
+    py::class_<mpcd::SDFGeometryFiller,
+               mpcd::VirtualParticleFiller,
+               std::shared_ptr<mpcd::SDFGeometryFiller>>(m, "SDFGeometryFiller")
+        .def(py::init<std::shared_ptr<mpcd::SystemData>,
+                      Scalar,
+                      unsigned int,
+                      std::shared_ptr<::Variant>,
+                      unsigned int,
+                      std::shared_ptr<const mpcd::detail::SDFGeometry>>())
+        .def("setGeometry", &mpcd::SDFGeometryFiller::setGeometry);
+    }
@@ -0,0 +1,82 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*!
+ * \file mpcd/SDFGeometryFiller.h
+ * \brief Definition of virtual particle filler for mpcd::detail::SDFGeometry.
+ */
+
+#ifndef MPCD_SDF_GEOMETRY_FILLER_H_
+#define MPCD_SDF_GEOMETRY_FILLER_H_
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include "SDFGeometry.h"
+#include "VirtualParticleFiller.h"
+
+#include <pybind11/pybind11.h>
+
+namespace mpcd
+    {
+//! Adds virtual particles to the MPCD particle data for SDFGeometry
+/*!
+ * Any point of a cell that is partially inside the fluid is within one cell diagonal of the fluid,
+ * so particles are added to the volume outside the geometry where the signed distance is at most
+ * \f$\sqrt{3}\f$ times the cell size. This region is built from the voxels of the signed distance
+ * grid that overlap the local domain. Voxels that are only partially in the region have their
+ * filled volume estimated by sampling, and particles are drawn in them by rejection.
+ */
+class PYBIND11_EXPORT SDFGeometryFiller : public mpcd::VirtualParticleFiller
+    {
+    public:
+    SDFGeometryFiller(std::shared_ptr<mpcd::SystemData> sysdata,
+                      Scalar density,
+                      unsigned int type,
+                      std::shared_ptr<::Variant> T,
+                      uint16_t seed,
+                      std::shared_ptr<const mpcd::detail::SDFGeometry> geom);
+
+    virtual ~SDFGeometryFiller();
+
+    void setGeometry(std::shared_ptr<const mpcd::detail::SDFGeometry> geom)
+        {
+        m_geom = geom;
+        notifyRecompute();
+        }
+
+    protected:
+    std::shared_ptr<const mpcd::detail::SDFGeometry> m_geom;
+
+    unsigned int m_num_boxes;   //!< Number of boxes to use in filling
+    GPUArray<Scalar3> m_box_lo; //!< Lower corners of boxes to use in filling
+    GPUArray<Scalar3> m_box_hi; //!< Upper corners of boxes to use in filling
+    GPUArray<uint2> m_ranges;   //!< Particle tag ranges for filling
+    Scalar m_thickness;         //!< Largest signed distance to fill
+
+    //! Maximum number of draws of a particle position
+    const static unsigned int MAX_ATTEMPTS = 256;
+
+    //! Compute the total number of particles to fill
+    virtual void computeNumFill();
+
+    //! Draw particles within the fill volume
+    virtual void drawParticles(uint64_t timestep);
+
+    private:
+    bool m_needs_recompute;
+    Scalar2 m_recompute_cache;
+    void notifyRecompute()
+        {
+        m_needs_recompute = true;
+        }
+    };
+
+namespace detail
+    {
+//! Export SDFGeometryFiller to python
+void export_SDFGeometryFiller(pybind11::module& m);
+    }      // end namespace detail
+    }      // end namespace mpcd
+#endif // MPCD_SDF_GEOMETRY_FILLER_H_
@@ -0,0 +1,91 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*!
+ * \file mpcd/SDFGeometryFillerGPU.cc
+ * \brief Definition of mpcd::SDFGeometryFillerGPU
+ */
+
+#include "SDFGeometryFillerGPU.h"
+#include "SDFGeometryFillerGPU.cuh"
+
+mpcd::SDFGeometryFillerGPU::SDFGeometryFillerGPU(
+    std::shared_ptr<mpcd::SystemData> sysdata,
+    Scalar density,
+    unsigned int type,
+    std::shared_ptr<::Variant> T,
+    uint16_t seed,
+    std::shared_ptr<const mpcd::detail::SDFGeometry> geom)
+    : mpcd::SDFGeometryFiller(sysdata, density, type, T, seed, geom)
+    {
+    m_tuner.reset(new Autotuner(32, 1024, 32, 5, 100000, "mpcd_sdf_filler", m_exec_conf));
+    }
+
+/*!
+ * \param timestep Current timestep
+ */
+void mpcd::SDFGeometryFillerGPU::drawParticles(uint64_t timestep)
+    {
+    if (m_N_fill == 0)
+        return;
+
+    ArrayHandle<mpcd::detail::pdata_real4> d_pos(m_mpcd_pdata->getPositions(),
+                                                 access_location::device,
+                                                 access_mode::readwrite);
+    ArrayHandle<mpcd::detail::pdata_real4> d_vel(m_mpcd_pdata->getVelocities(),
+                                                 access_location::device,
+                                                 access_mode::readwrite);
+    ArrayHandle<unsigned int> d_tag(m_mpcd_pdata->getTags(),
+                                    access_location::device,
+                                    access_mode::readwrite);
+
+    // boxes for filling
+    ArrayHandle<Scalar3> d_box_lo(m_box_lo, access_location::device, access_mode::read);
+    ArrayHandle<Scalar3> d_box_hi(m_box_hi, access_location::device, access_mode::read);
+    ArrayHandle<uint2> d_ranges(m_ranges, access_location::device, access_mode::read);
+
+    const unsigned int first_idx = m_mpcd_pdata->getN() + m_mpcd_pdata->getNVirtual() - m_N_fill;
+
+    uint16_t seed = m_sysdef->getSeed();
+
+    m_tuner->begin();
+    mpcd::gpu::sdf_draw_particles(d_pos.data,
+                                  d_vel.data,
+                                  d_tag.data,
+                                  *m_geom,
+                                  d_box_lo.data,
+                                  d_box_hi.data,
+                                  d_ranges.data,
+                                  m_num_boxes,
+                                  m_N_fill,
+                                  m_thickness,
+                                  MAX_ATTEMPTS,
+                                  m_mpcd_pdata->getMass(),
+                                  m_type,
+                                  m_first_tag,
+                                  first_idx,
+                                  (*m_T)(timestep),
+                                  timestep,
+                                  seed,
+                                  m_tuner->getParam());
+    if (m_exec_conf->isCUDAErrorCheckingEnabled())
+        CHECK_CUDA_ERROR();
+    m_tuner->end();
+    }
+
+/*!
+ * \param m Python module to export to
+ */
+void mpcd::detail::export_SDFGeometryFillerGPU(pybind11::module& m)
+    {
+    namespace py = pybind11;
+    py::class_<mpcd::SDFGeometryFillerGPU,
+               mpcd::SDFGeometryFiller,
+               std::shared_ptr<mpcd::SDFGeometryFillerGPU>>(m, "SDFGeometryFillerGPU")
+        .def(py::init<std::shared_ptr<mpcd::SystemData>,
+                      Scalar,
+                      unsigned int,
+                      std::shared_ptr<::Variant>,
+                      unsigned int,
+                      std::shared_ptr<const mpcd::detail::SDFGeometry>>());
+    }
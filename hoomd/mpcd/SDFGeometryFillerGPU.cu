@@ -0,0 +1,194 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*!
+ * \file mpcd/SDFGeometryFillerGPU.cu
+ * \brief Defines GPU functions and kernels used by mpcd::SDFGeometryFillerGPU
+ */
+
+#include "SDFGeometryFillerGPU.cuh"
+#include "hoomd/RNGIdentifiers.h"
+#include "hoomd/RandomNumbers.h"
+
+namespace mpcd
+    {
+namespace gpu
+    {
+namespace kernel
+    {
+/*!
+ * \param d_pos Particle positions
+ * \param d_vel Particle velocities
+ * \param d_tag Particle tags
+ * \param geom Signed distance field geometry
+ * \param d_box_lo Lower corners of boxes for filling
+ * \param d_box_hi Upper corners of boxes for filling
+ * \param d_ranges Particle ranges for each box
+ * \param num_boxes Number of boxes to fill
+ * \param N_tot Total number of particles
+ * \param thickness Largest signed distance to fill
+ * \param max_attempts Maximum number of draws of a particle position
+ * \param type Type of fill particles
+ * \param first_tag First tag of filled particles
+ * \param first_idx First (local) particle index of filled particles
+ * \param vel_factor Scale factor for uniform normal velocities consistent with particle mass /
+ * temperature
+ * \param timestep Current timestep
+ * \param seed User seed to PRNG for drawing velocities
+ *
+ * \b Implementation:
+ *
+ * Using one thread per particle, the thread finds the box whose fill range contains it by binary
+ * search, since there can be many boxes. The thread index is translated into a particle tag and
+ * local particle index. A random position is drawn within the box until it lies in the fill region
+ * of the geometry, and a random velocity is drawn with zero mean.
+ */
+__global__ void sdf_draw_particles(mpcd::detail::pdata_real4* d_pos,
+                                   mpcd::detail::pdata_real4* d_vel,
+                                   unsigned int* d_tag,
+                                   const mpcd::detail::SDFGeometry geom,
+                                   const Scalar3* d_box_lo,
+                                   const Scalar3* d_box_hi,
+                                   const uint2* d_ranges,
+                                   const unsigned int num_boxes,
+                                   const unsigned int N_tot,
+                                   const Scalar thickness,
+                                   const unsigned int max_attempts,
+                                   const unsigned int type,
+                                   const unsigned int first_tag,
+                                   const unsigned int first_idx,
+                                   const Scalar vel_factor,
+                                   const uint64_t timestep,
+                                   const uint16_t seed)
+    {
+    // one thread per particle
+    const unsigned int idx = blockIdx.x * blockDim.x + threadIdx.x;
+    if (idx >= N_tot)
+        return;
+
+    // binary search for the first box whose range ends after idx
+    unsigned int left = 0;
+    unsigned int right = num_boxes - 1;
+    while (left < right)
+        {
+        const unsigned int mid = (left + right) / 2;
+        if (d_ranges[mid].y <= idx)
+            left = mid + 1;
+        else
+            right = mid;
+        }
+    const Scalar3 lo = d_box_lo[left];
+    const Scalar3 hi = d_box_hi[left];
+
+    // particle tag and index
+    const unsigned int tag = first_tag + idx;
+    const unsigned int pidx = first_idx + idx;
+    d_tag[pidx] = tag;
+
+    // initialize random number generator for positions and velocity
+    hoomd::RandomGenerator rng(
+        hoomd::Seed(hoomd::RNGIdentifier::SDFGeometryFiller, timestep, seed),
+        hoomd::Counter(tag));
+
+    // draw by rejection in voxels that are only partially in the fill region
+    Scalar3 pos;
+    for (unsigned int attempt = 0; attempt < max_attempts; ++attempt)
+        {
+        pos = make_scalar3(hoomd::UniformDistribution<Scalar>(lo.x, hi.x)(rng),
+                           hoomd::UniformDistribution<Scalar>(lo.y, hi.y)(rng),
+                           hoomd::UniformDistribution<Scalar>(lo.z, hi.z)(rng));
+        const Scalar dist = geom.getDistance(pos);
+        if (dist > Scalar(0) && dist <= thickness)
+            break;
+        }
+    d_pos[pidx] = make_scalar4(pos.x, pos.y, pos.z, __int_as_scalar(type));
+
+    hoomd::NormalDistribution<Scalar> gen(vel_factor, 0.0);
+    Scalar vel[3];
+    gen(vel, rng);
+    d_vel[pidx] = make_scalar4(vel[0], vel[1], vel[2], __int_as_scalar(mpcd::detail::NO_CELL));
+    }
+    } // end namespace kernel
+
+/*!
+ * \param d_pos Particle positions
+ * \param d_vel Particle velocities
+ * \param d_tag Particle tags
+ * \param geom Signed distance field geometry
+ * \param d_box_lo Lower corners of boxes for filling
+ * \param d_box_hi Upper corners of boxes for filling
+ * \param d_ranges Particle ranges for each box
+ * \param num_boxes Number of boxes to fill
+ * \param N_tot Total number of particles
+ * \param thickness Largest signed distance to fill
+ * \param max_attempts Maximum number of draws of a particle position
+ * \param mass Mass of fill particles
+ * \param type Type of fill particles
+ * \param first_tag First tag of filled particles
+ * \param first_idx First (local) particle index of filled particles
+ * \param kT Temperature for fill particles
+ * \param timestep Current timestep
+ * \param seed User seed to PRNG for drawing velocities
+ * \param block_size Number of threads per block
+ *
+ * \sa kernel::sdf_draw_particles
+ */
+cudaError_t sdf_draw_particles(mpcd::detail::pdata_real4* d_pos,
+                               mpcd::detail::pdata_real4* d_vel,
+                               unsigned int* d_tag,
+                               const mpcd::detail::SDFGeometry& geom,
+                               const Scalar3* d_box_lo,
+                               const Scalar3* d_box_hi,
+                               const uint2* d_ranges,
+                               const unsigned int num_boxes,
+                               const unsigned int N_tot,
+                               const Scalar thickness,
+                               const unsigned int max_attempts,
+                               const Scalar mass,
+                               const unsigned int type,
+                               const unsigned int first_tag,
+                               const unsigned int first_idx,
+                               const Scalar kT,
+                               const uint64_t timestep,
+                               const uint16_t seed,
+                               const unsigned int block_size)
+    {
+    if (N_tot == 0)
+        return cudaSuccess;
+
+    static unsigned int max_block_size = UINT_MAX;
+    if (max_block_size == UINT_MAX)
+        {
+        cudaFuncAttributes attr;
+        cudaFuncGetAttributes(&attr, (const void*)kernel::sdf_draw_particles);
+        max_block_size = attr.maxThreadsPerBlock;
+        }
+
+    // precompute factor for rescaling the velocities since it is the same for all particles
+    const Scalar vel_factor = fast::sqrt(kT / mass);
+
+    unsigned int run_block_size = min(block_size, max_block_size);
+    dim3 grid(N_tot / run_block_size + 1);
+    kernel::sdf_draw_particles<<<grid, run_block_size>>>(d_pos,
+                                                         d_vel,
+                                                         d_tag,
+                                                         geom,
+                                                         d_box_lo,
+                                                         d_box_hi,
+                                                         d_ranges,
+                                                         num_boxes,
+                                                         N_tot,
+                                                         thickness,
+                                                         max_attempts,
+                                                         type,
+                                                         first_tag,
+                                                         first_idx,
+                                                         vel_factor,
+                                                         timestep,
+                                                         seed);
+
+    return cudaSuccess;
+    }
+
+    } // end namespace gpu
+    } // end namespace mpcd
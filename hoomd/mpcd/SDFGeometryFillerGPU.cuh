@@ -0,0 +1,46 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#ifndef MPCD_SDF_GEOMETRY_FILLER_GPU_CUH_
+#define MPCD_SDF_GEOMETRY_FILLER_GPU_CUH_
+
+/*!
+ * \file mpcd/SDFGeometryFillerGPU.cuh
+ * \brief Declaration of CUDA kernels for mpcd::SDFGeometryFillerGPU
+ */
+
+#include <cuda_runtime.h>
+
+#include "ParticleDataUtilities.h"
+#include "SDFGeometry.h"
+#include "hoomd/HOOMDMath.h"
+
+namespace mpcd
+    {
+namespace gpu
+    {
+//! Draw virtual particles in the SDFGeometry
+cudaError_t sdf_draw_particles(mpcd::detail::pdata_real4* d_pos,
+                               mpcd::detail::pdata_real4* d_vel,
+                               unsigned int* d_tag,
+                               const mpcd::detail::SDFGeometry& geom,
+                               const Scalar3* d_box_lo,
+                               const Scalar3* d_box_hi,
+                               const uint2* d_ranges,
+                               const unsigned int num_boxes,
+                               const unsigned int N_tot,
+                               const Scalar thickness,
+                               const unsigned int max_attempts,
+                               const Scalar mass,
+                               const unsigned int type,
+                               const unsigned int first_tag,
+                               const unsigned int first_idx,
+                               const Scalar kT,
+                               const uint64_t timestep,
+                               const uint16_t seed,
+                               const unsigned int block_size);
+
+    } // end namespace gpu
+    } // end namespace mpcd
+
+#endif // MPCD_SDF_GEOMETRY_FILLER_GPU_CUH_
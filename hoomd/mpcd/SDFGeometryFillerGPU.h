@@ -0,0 +1,61 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+/*!
+ * \file mpcd/SDFGeometryFillerGPU.h
+ * \brief Definition of virtual particle filler for mpcd::detail::SDFGeometry on the GPU.
+ */
+
+#ifndef MPCD_SDF_GEOMETRY_FILLER_GPU_H_
+#define MPCD_SDF_GEOMETRY_FILLER_GPU_H_
+
+#ifdef __HIPCC__
+#error This header cannot be compiled by nvcc
+#endif
+
+#include "SDFGeometryFiller.h"
+#include "hoomd/Autotuner.h"
+#include <pybind11/pybind11.h>
+
+namespace mpcd
+    {
+//! Adds virtual particles to the MPCD particle data for SDFGeometry using the GPU
+class PYBIND11_EXPORT SDFGeometryFillerGPU : public mpcd::SDFGeometryFiller
+    {
+    public:
+    //! Constructor
+    SDFGeometryFillerGPU(std::shared_ptr<mpcd::SystemData> sysdata,
+                         Scalar density,
+                         unsigned int type,
+                         std::shared_ptr<::Variant> T,
+                         uint16_t seed,
+                         std::shared_ptr<const mpcd::detail::SDFGeometry> geom);
+
+    //! Set autotuner parameters
+    /*!
+     * \param enable Enable/disable autotuning
+     * \param period period (approximate) in time steps when returning occurs
+     */
+    virtual void setAutotunerParams(bool enable, unsigned int period)
+        {
+        mpcd::SDFGeometryFiller::setAutotunerParams(enable, period);
+
+        m_tuner->setEnabled(enable);
+        m_tuner->setPeriod(period);
+        }
+
+    protected:
+    //! Draw particles within the fill volume on the GPU
+    virtual void drawParticles(uint64_t timestep);
+
+    private:
+    std::unique_ptr<::Autotuner> m_tuner; //!< Autotuner for drawing particles
+    };
+
+namespace detail
+    {
+//! Export SDFGeometryFillerGPU to python
+void export_SDFGeometryFillerGPU(pybind11::module& m);
+    }      // end namespace detail
+    }      // end namespace mpcd
+#endif // MPCD_SDF_GEOMETRY_FILLER_GPU_H_
@@ -77,9 +77,9 @@ void mpcd::SRDCollisionMethodGPU::drawRotationVectors(uint64_t timestep)
 void mpcd::SRDCollisionMethodGPU::rotate(uint64_t timestep)
     {
     // acquire MPCD particle data
-    ArrayHandle<Scalar4> d_vel(m_mpcd_pdata->getVelocities(),
-                               access_location::device,
-                               access_mode::readwrite);
+    ArrayHandle<mpcd::detail::pdata_real4> d_vel(m_mpcd_pdata->getVelocities(),
+                                                 access_location::device,
+                                                 access_mode::readwrite);
     const unsigned int N_mpcd = m_mpcd_pdata->getN() + m_mpcd_pdata->getNVirtual();
     unsigned int N_tot = N_mpcd;
 
@@ -94,7 +94,7 @@ __global__ void srd_draw_vectors(double3* d_rotvec,
         d_factors[idx] = factor;
         }
     }
-__global__ void srd_rotate(Scalar4* d_vel,
+__global__ void srd_rotate(mpcd::detail::pdata_real4* d_vel,
                            Scalar4* d_vel_embed,
                            const unsigned int* d_embed_group,
                            const unsigned int* d_embed_cell_ids,
@@ -253,7 +253,7 @@ cudaError_t srd_draw_vectors(double3* d_rotvec,
     return cudaSuccess;
     }
 
-cudaError_t srd_rotate(Scalar4* d_vel,
+cudaError_t srd_rotate(mpcd::detail::pdata_real4* d_vel,
                        Scalar4* d_vel_embed,
                        const unsigned int* d_embed_group,
                        const unsigned int* d_embed_cell_ids,
@@ -33,7 +33,7 @@ cudaError_t srd_draw_vectors(double3* d_rotvec,
                              const unsigned int n_dimensions,
                              const unsigned int block_size);
 
-cudaError_t srd_rotate(Scalar4* d_vel,
+cudaError_t srd_rotate(mpcd::detail::pdata_real4* d_vel,
                        Scalar4* d_vel_embed,
                        const unsigned int* d_embed_group,
                        const unsigned int* d_embed_cell_ids,
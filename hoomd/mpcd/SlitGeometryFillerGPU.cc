@@ -27,12 +27,12 @@ mpcd::SlitGeometryFillerGPU::SlitGeometryFillerGPU(
  */
 void mpcd::SlitGeometryFillerGPU::drawParticles(uint64_t timestep)
     {
-    ArrayHandle<Scalar4> d_pos(m_mpcd_pdata->getPositions(),
-                               access_location::device,
-                               access_mode::readwrite);
-    ArrayHandle<Scalar4> d_vel(m_mpcd_pdata->getVelocities(),
-                               access_location::device,
-                               access_mode::readwrite);
+    ArrayHandle<mpcd::detail::pdata_real4> d_pos(m_mpcd_pdata->getPositions(),
+                                                 access_location::device,
+                                                 access_mode::readwrite);
+    ArrayHandle<mpcd::detail::pdata_real4> d_vel(m_mpcd_pdata->getVelocities(),
+                                                 access_location::device,
+                                                 access_mode::readwrite);
     ArrayHandle<unsigned int> d_tag(m_mpcd_pdata->getTags(),
                                     access_location::device,
                                     access_mode::readwrite);
@@ -42,8 +42,8 @@ namespace kernel
  * into a particle tag and local particle index. A random position is drawn within the cuboid. A
  * random velocity is drawn consistent with the speed of the moving wall.
  */
-__global__ void slit_draw_particles(Scalar4* d_pos,
-                                    Scalar4* d_vel,
+__global__ void slit_draw_particles(mpcd::detail::pdata_real4* d_pos,
+                                    mpcd::detail::pdata_real4* d_vel,
                                     unsigned int* d_tag,
                                     const mpcd::detail::SlitGeometry geom,
                                     const Scalar z_min,
@@ -126,8 +126,8 @@ __global__ void slit_draw_particles(Scalar4* d_pos,
  *
  * \sa kernel::slit_draw_particles
  */
-cudaError_t slit_draw_particles(Scalar4* d_pos,
-                                Scalar4* d_vel,
+cudaError_t slit_draw_particles(mpcd::detail::pdata_real4* d_pos,
+                                mpcd::detail::pdata_real4* d_vel,
                                 unsigned int* d_tag,
                                 const mpcd::detail::SlitGeometry& geom,
                                 const Scalar z_min,
@@ -22,8 +22,8 @@ namespace mpcd
 namespace gpu
     {
 //! Draw virtual particles in the SlitGeometry
-cudaError_t slit_draw_particles(Scalar4* d_pos,
-                                Scalar4* d_vel,
+cudaError_t slit_draw_particles(mpcd::detail::pdata_real4* d_pos,
+                                mpcd::detail::pdata_real4* d_vel,
                                 unsigned int* d_tag,
                                 const mpcd::detail::SlitGeometry& geom,
                                 const Scalar z_min,
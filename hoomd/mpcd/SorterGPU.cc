@@ -110,22 +110,22 @@ void mpcd::SorterGPU::applyOrder() const
         {
         ArrayHandle<unsigned int> d_order(m_order, access_location::device, access_mode::read);
 
-        ArrayHandle<Scalar4> d_pos(m_mpcd_pdata->getPositions(),
-                                   access_location::device,
-                                   access_mode::read);
-        ArrayHandle<Scalar4> d_vel(m_mpcd_pdata->getVelocities(),
-                                   access_location::device,
-                                   access_mode::read);
+        ArrayHandle<mpcd::detail::pdata_real4> d_pos(m_mpcd_pdata->getPositions(),
+                                                     access_location::device,
+                                                     access_mode::read);
+        ArrayHandle<mpcd::detail::pdata_real4> d_vel(m_mpcd_pdata->getVelocities(),
+                                                     access_location::device,
+                                                     access_mode::read);
         ArrayHandle<unsigned int> d_tag(m_mpcd_pdata->getTags(),
                                         access_location::device,
                                         access_mode::read);
 
-        ArrayHandle<Scalar4> d_pos_alt(m_mpcd_pdata->getAltPositions(),
-                                       access_location::device,
-                                       access_mode::overwrite);
-        ArrayHandle<Scalar4> d_vel_alt(m_mpcd_pdata->getAltVelocities(),
-                                       access_location::device,
-                                       access_mode::overwrite);
+        ArrayHandle<mpcd::detail::pdata_real4> d_pos_alt(m_mpcd_pdata->getAltPositions(),
+                                                         access_location::device,
+                                                         access_mode::overwrite);
+        ArrayHandle<mpcd::detail::pdata_real4> d_vel_alt(m_mpcd_pdata->getAltVelocities(),
+                                                         access_location::device,
+                                                         access_mode::overwrite);
         ArrayHandle<unsigned int> d_tag_alt(m_mpcd_pdata->getAltTags(),
                                             access_location::device,
                                             access_mode::overwrite);
@@ -151,11 +151,11 @@ void mpcd::SorterGPU::applyOrder() const
             const unsigned int Nvirtual = m_mpcd_pdata->getNVirtual();
             cudaMemcpyAsync(d_pos_alt.data + N,
                             d_pos.data + N,
-                            Nvirtual * sizeof(Scalar4),
+                            Nvirtual * sizeof(mpcd::detail::pdata_real4),
                             cudaMemcpyDeviceToDevice);
             cudaMemcpyAsync(d_vel_alt.data + N,
                             d_vel.data + N,
-                            Nvirtual * sizeof(Scalar4),
+                            Nvirtual * sizeof(mpcd::detail::pdata_real4),
                             cudaMemcpyDeviceToDevice);
             cudaMemcpyAsync(d_tag_alt.data + N,
                             d_tag.data + N,
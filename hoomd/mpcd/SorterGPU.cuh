@@ -21,11 +21,11 @@ namespace mpcd
 namespace gpu
     {
 //! Kernel driver to apply sorted particle order
-cudaError_t sort_apply(Scalar4* d_pos_alt,
-                       Scalar4* d_vel_alt,
+cudaError_t sort_apply(mpcd::detail::pdata_real4* d_pos_alt,
+                       mpcd::detail::pdata_real4* d_vel_alt,
                        unsigned int* d_tag_alt,
-                       const Scalar4* d_pos,
-                       const Scalar4* d_vel,
+                       const mpcd::detail::pdata_real4* d_pos,
+                       const mpcd::detail::pdata_real4* d_vel,
                        const unsigned int* d_tag,
                        const unsigned int* d_order,
                        const unsigned int N,
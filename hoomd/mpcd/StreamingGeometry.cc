@@ -9,6 +9,9 @@
  */
 
 #include "StreamingGeometry.h"
+#include "hoomd/ExecutionConfiguration.h"
+
+#include <pybind11/numpy.h>
 
 namespace mpcd
     {
@@ -48,5 +51,43 @@ void export_SlitPoreGeometry(pybind11::module& m)
         .def("getBoundaryCondition", &SlitPoreGeometry::getBoundaryCondition);
     }
 
+/*!
+ * The signed distance field is passed as an array of shape (nx, ny, nz) that spans the global
+ * \a box, and it is copied into the layout of the geometry's Index3D.
+ */
+void export_SDFGeometry(pybind11::module& m)
+    {
+    namespace py = pybind11;
+    py::class_<SDFGeometry, std::shared_ptr<SDFGeometry>>(m, "SDFGeometry")
+        .def(py::init(
+            [](std::shared_ptr<const ExecutionConfiguration> exec_conf,
+               py::array_t<Scalar, py::array::c_style | py::array::forcecast> sdf,
+               const BoxDim& box,
+               boundary bc)
+            {
+                if (sdf.ndim() != 3)
+                    {
+                    throw std::runtime_error("SDF grid must be a 3D array");
+                    }
+                const Index3D indexer((unsigned int)sdf.shape(0),
+                                      (unsigned int)sdf.shape(1),
+                                      (unsigned int)sdf.shape(2));
+                auto a = sdf.unchecked<3>();
+                std::vector<Scalar> values(indexer.getNumElements());
+                for (unsigned int i = 0; i < indexer.getW(); ++i)
+                    for (unsigned int j = 0; j < indexer.getH(); ++j)
+                        for (unsigned int k = 0; k < indexer.getD(); ++k)
+                            values[indexer(i, j, k)] = a(i, j, k);
+
+                return SDFGeometry::create(exec_conf->isCUDAEnabled(),
+                                           values.data(),
+                                           indexer,
+                                           box.getLo(),
+                                           box.getL(),
+                                           bc);
+            }))
+        .def("getBoundaryCondition", &SDFGeometry::getBoundaryCondition);
+    }
+
     } // end namespace detail
     } // end namespace mpcd
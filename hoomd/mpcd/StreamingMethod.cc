@@ -22,7 +22,8 @@ mpcd::StreamingMethod::StreamingMethod(std::shared_ptr<mpcd::SystemData> sysdata
                                        int phase)
     : m_mpcd_sys(sysdata), m_sysdef(m_mpcd_sys->getSystemDefinition()),
       m_pdata(m_sysdef->getParticleData()), m_mpcd_pdata(m_mpcd_sys->getParticleData()),
-      m_exec_conf(m_pdata->getExecConf()), m_mpcd_dt(0.0), m_period(period)
+      m_exec_conf(m_pdata->getExecConf()), m_mpcd_dt(0.0), m_period(period), m_bin_cells(false),
+      m_bin_timestep(0), m_bin_grid_shift(make_scalar3(0, 0, 0))
     {
     m_exec_conf->msg->notice(5) << "Constructing MPCD StreamingMethod" << std::endl;
 
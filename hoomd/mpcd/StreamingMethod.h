@@ -94,6 +94,27 @@ class PYBIND11_EXPORT StreamingMethod
     //! Set the period of the streaming method
     void setPeriod(unsigned int cur_timestep, unsigned int period);
 
+    //! Get the period of the streaming method
+    unsigned int getPeriod() const
+        {
+        return m_period;
+        }
+
+    //! Request that the next streaming step also bins the particles into the cell list
+    /*!
+     * \param timestep Timestep of the collision that follows the next streaming step
+     * \param grid_shift Grid shift of that collision
+     *
+     * The request only applies to the next call to stream(). Streaming methods that cannot bin
+     * the particles ignore it, and the cell list is then built by the collision as usual.
+     */
+    void requestCellBinning(uint64_t timestep, const Scalar3& grid_shift)
+        {
+        m_bin_cells = true;
+        m_bin_timestep = timestep;
+        m_bin_grid_shift = grid_shift;
+        }
+
     protected:
     std::shared_ptr<mpcd::SystemData> m_mpcd_sys;              //!< MPCD system data
     std::shared_ptr<SystemDefinition> m_sysdef;                //!< HOOMD system definition
@@ -108,6 +129,10 @@ class PYBIND11_EXPORT StreamingMethod
 
     std::shared_ptr<hoomd::GPUPolymorph<mpcd::ExternalField>> m_field; //!< External field
 
+    bool m_bin_cells;         //!< True if the next streaming step should bin the particles
+    uint64_t m_bin_timestep;  //!< Timestep of the collision to bin the particles for
+    Scalar3 m_bin_grid_shift; //!< Grid shift of the collision to bin the particles for
+
     //! Check if streaming should occur
     virtual bool shouldStream(uint64_t timestep);
     };
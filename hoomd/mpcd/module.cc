@@ -48,10 +48,12 @@
 #endif
 
 // virtual particle fillers
+#include "SDFGeometryFiller.h"
 #include "SlitGeometryFiller.h"
 #include "SlitPoreGeometryFiller.h"
 #include "VirtualParticleFiller.h"
 #ifdef ENABLE_HIP
+#include "SDFGeometryFillerGPU.h"
 #include "SlitGeometryFillerGPU.h"
 #include "SlitPoreGeometryFillerGPU.h"
 #endif // ENABLE_HIP
@@ -137,31 +139,38 @@ PYBIND11_MODULE(_mpcd, m)
     mpcd::detail::export_BulkGeometry(m);
     mpcd::detail::export_SlitGeometry(m);
     mpcd::detail::export_SlitPoreGeometry(m);
+    mpcd::detail::export_SDFGeometry(m);
 
     mpcd::detail::export_StreamingMethod(m);
     mpcd::detail::export_ExternalFieldPolymorph(m);
     mpcd::detail::export_ConfinedStreamingMethod<mpcd::detail::BulkGeometry>(m);
     mpcd::detail::export_ConfinedStreamingMethod<mpcd::detail::SlitGeometry>(m);
     mpcd::detail::export_ConfinedStreamingMethod<mpcd::detail::SlitPoreGeometry>(m);
+    mpcd::detail::export_ConfinedStreamingMethod<mpcd::detail::SDFGeometry>(m);
 #ifdef ENABLE_HIP
     mpcd::detail::export_ConfinedStreamingMethodGPU<mpcd::detail::BulkGeometry>(m);
     mpcd::detail::export_ConfinedStreamingMethodGPU<mpcd::detail::SlitGeometry>(m);
     mpcd::detail::export_ConfinedStreamingMethodGPU<mpcd::detail::SlitPoreGeometry>(m);
+    mpcd::detail::export_ConfinedStreamingMethodGPU<mpcd::detail::SDFGeometry>(m);
 #endif // ENABLE_HIP
 
     mpcd::detail::export_BounceBackNVE<mpcd::detail::SlitGeometry>(m);
     mpcd::detail::export_BounceBackNVE<mpcd::detail::SlitPoreGeometry>(m);
+    mpcd::detail::export_BounceBackNVE<mpcd::detail::SDFGeometry>(m);
 #ifdef ENABLE_HIP
     mpcd::detail::export_BounceBackNVEGPU<mpcd::detail::SlitGeometry>(m);
     mpcd::detail::export_BounceBackNVEGPU<mpcd::detail::SlitPoreGeometry>(m);
+    mpcd::detail::export_BounceBackNVEGPU<mpcd::detail::SDFGeometry>(m);
 #endif // ENABLE_HIP
 
     mpcd::detail::export_VirtualParticleFiller(m);
     mpcd::detail::export_SlitGeometryFiller(m);
     mpcd::detail::export_SlitPoreGeometryFiller(m);
+    mpcd::detail::export_SDFGeometryFiller(m);
 #ifdef ENABLE_HIP
     mpcd::detail::export_SlitGeometryFillerGPU(m);
     mpcd::detail::export_SlitPoreGeometryFillerGPU(m);
+    mpcd::detail::export_SDFGeometryFillerGPU(m);
 #endif // ENABLE_HIP
 
 #ifdef ENABLE_MPI
@@ -551,3 +551,148 @@ class slit_pore(_streaming_method):
         self._cpp.geometry = _mpcd.SlitPoreGeometry(self.H, self.L, bc)
         if self._filler is not None:
             self._filler.setGeometry(self._cpp.geometry)
+
+
+class sdf(_streaming_method):
+    r""" Signed distance field streaming geometry.
+
+    Args:
+        sdf (numpy.ndarray): signed distance field on a grid of shape *(nx, ny, nz)*
+        boundary (str): boundary condition at wall ("slip" or "no_slip"")
+        period (int): Number of integration steps between collisions
+
+    The signed distance field geometry confines the fluid by an arbitrary
+    surface, given as the zero level set of a signed distance field
+    :math:`\phi(\mathbf{r})`. The field is negative in the fluid and positive
+    in the solid. It is sampled on a periodic grid of *(nx, ny, nz)* nodes that
+    spans the simulation box, with node *(i, j, k)* located at
+    :math:`\mathbf{r}_{\rm lo} + (i L_x/n_x, j L_y/n_y, k L_z/n_z)`, where
+    :math:`\mathbf{r}_{\rm lo}` is the lower corner of the box. Between the
+    nodes, :math:`\phi` is trilinearly interpolated, and the surface normal
+    is its gradient. The simulation box must be orthorhombic and must not be
+    changed after the geometry is created.
+
+    Particles that cross the surface during streaming are placed back at the
+    point of contact, which is found by bisection, and reflected according to
+    the boundary condition. Features of the surface thinner than the distance a
+    particle travels in one streaming step may be missed, so the grid spacing,
+    period, and time step should be chosen accordingly. The box must include
+    the padding needed so that the cells do not interact through the periodic
+    boundaries, as for the other geometries.
+
+    The "inside" of the :py:class:`sdf` is the space where :math:`\phi \le 0`.
+
+    Examples::
+
+        # slit of half width 5 along z in a cubic box of edge 20 on a 40^3 grid
+        z = -10.0 + numpy.arange(40) * 20.0 / 40
+        phi = numpy.broadcast_to(numpy.abs(z) - 5.0, (40, 40, 40))
+        stream.sdf(sdf=phi, period=10)
+
+    """
+
+    def __init__(self, sdf, boundary="no_slip", period=1):
+        _streaming_method.__init__(self, period)
+
+        self.sdf = sdf
+        self.boundary = boundary
+
+        bc = self._process_boundary(boundary)
+
+        # create the base streaming class
+        if not hoomd.context.current.device.mode == 'gpu':
+            stream_class = _mpcd.ConfinedStreamingMethodSDF
+        else:
+            stream_class = _mpcd.ConfinedStreamingMethodGPUSDF
+        self._cpp = stream_class(
+            hoomd.context.current.mpcd.data,
+            hoomd.context.current.system.getCurrentTimeStep(), self.period, 0,
+            self._make_geometry(sdf, bc))
+
+    def _make_geometry(self, sdf, bc):
+        """ Create the geometry for the current global box. """
+        box = hoomd.context.current.system_definition.getParticleData(
+        ).getGlobalBox()
+        return _mpcd.SDFGeometry(hoomd.context.current.device.cpp_exec_conf,
+                                 sdf, box, bc)
+
+    def set_filler(self, density, kT, seed, type='A'):
+        r""" Add virtual particles outside the signed distance field boundary.
+
+        Args:
+            density (float): Density of virtual particles.
+            kT (float): Temperature of virtual particles.
+            seed (int): Seed to pseudo-random number generator for virtual particles.
+            type (str): Type of the MPCD particles to fill with.
+
+        The virtual particle filler draws particles within the volume *outside*
+        the boundary that could be overlapped by any cell that is partially
+        *inside* the fluid, which is the region where
+        :math:`0 < \phi \le \sqrt{3} a` for cell size *a*. The particles are drawn
+        from the velocity distribution consistent with *kT* and with the given
+        *density*. The mean of the distribution is zero in *x*, *y*, and *z*.
+        Typically, the virtual particle density and temperature are set to the
+        same conditions as the solvent.
+
+        The virtual particles will act as a weak thermostat on the fluid, and so energy
+        is no longer conserved. Momentum will also be sunk into the walls.
+
+        Example::
+
+            sdf.set_filler(density=5.0, kT=1.0, seed=42)
+
+        """
+        type_id = hoomd.context.current.mpcd.particles.getTypeByName(type)
+        T = hoomd.variant._setup_variant_input(kT)
+
+        if self._filler is None:
+            if not hoomd.context.current.device.mode == 'gpu':
+                fill_class = _mpcd.SDFGeometryFiller
+            else:
+                fill_class = _mpcd.SDFGeometryFillerGPU
+            self._filler = fill_class(hoomd.context.current.mpcd.data, density,
+                                      type_id, T.cpp_variant, seed,
+                                      self._cpp.geometry)
+        else:
+            self._filler.setDensity(density)
+            self._filler.setType(type_id)
+            self._filler.setTemperature(T.cpp_variant)
+            self._filler.setSeed(seed)
+
+    def remove_filler(self):
+        """ Remove the virtual particle filler.
+
+        Example::
+
+            sdf.remove_filler()
+
+        """
+
+        self._filler = None
+
+    def set_params(self, sdf=None, boundary=None):
+        """ Set parameters for the signed distance field geometry.
+
+        Args:
+            sdf (numpy.ndarray): signed distance field on a grid of shape *(nx, ny, nz)*
+            boundary (str): boundary condition at wall ("slip" or "no_slip"")
+
+        Changing any of these parameters will require the geometry to be
+        constructed and validated, so do not change these too often.
+
+        Examples::
+
+            sdf.set_params(boundary="slip")
+
+        """
+
+        if sdf is not None:
+            self.sdf = sdf
+
+        if boundary is not None:
+            self.boundary = boundary
+
+        bc = self._process_boundary(self.boundary)
+        self._cpp.geometry = self._make_geometry(self.sdf, bc)
+        if self._filler is not None:
+            self._filler.setGeometry(self._cpp.geometry)
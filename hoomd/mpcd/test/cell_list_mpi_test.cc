@@ -777,9 +777,9 @@ template<class CL> void celllist_basic_test(std::shared_ptr<ExecutionConfigurati
                                               access_location::host,
                                               access_mode::read);
         Index3D ci = cl->getCellIndexer();
-        ArrayHandle<Scalar4> h_vel(pdata->getVelocities(),
-                                   access_location::host,
-                                   access_mode::read);
+        ArrayHandle<mpcd::detail::pdata_real4> h_vel(pdata->getVelocities(),
+                                                     access_location::host,
+                                                     access_mode::read);
 
         switch (my_rank)
             {
@@ -837,9 +837,9 @@ template<class CL> void celllist_basic_test(std::shared_ptr<ExecutionConfigurati
                                               access_location::host,
                                               access_mode::read);
         Index3D ci = cl->getCellIndexer();
-        ArrayHandle<Scalar4> h_vel(pdata->getVelocities(),
-                                   access_location::host,
-                                   access_mode::read);
+        ArrayHandle<mpcd::detail::pdata_real4> h_vel(pdata->getVelocities(),
+                                                     access_location::host,
+                                                     access_mode::read);
 
         switch (my_rank)
             {
@@ -897,9 +897,9 @@ template<class CL> void celllist_basic_test(std::shared_ptr<ExecutionConfigurati
                                               access_location::host,
                                               access_mode::read);
         Index3D ci = cl->getCellIndexer();
-        ArrayHandle<Scalar4> h_vel(pdata->getVelocities(),
-                                   access_location::host,
-                                   access_mode::read);
+        ArrayHandle<mpcd::detail::pdata_real4> h_vel(pdata->getVelocities(),
+                                                     access_location::host,
+                                                     access_mode::read);
 
         switch (my_rank)
             {
@@ -1003,9 +1003,9 @@ template<class CL> void celllist_edge_test(std::shared_ptr<ExecutionConfiguratio
     // move particles to edges of domains for testing
     const unsigned int my_rank = exec_conf->getRank();
         {
-        ArrayHandle<Scalar4> h_pos(pdata->getPositions(),
-                                   access_location::host,
-                                   access_mode::overwrite);
+        ArrayHandle<mpcd::detail::pdata_real4> h_pos(pdata->getPositions(),
+                                                     access_location::host,
+                                                     access_mode::overwrite);
         switch (my_rank)
             {
         case 0:
@@ -1045,9 +1045,9 @@ template<class CL> void celllist_edge_test(std::shared_ptr<ExecutionConfiguratio
                                               access_location::host,
                                               access_mode::read);
         Index3D ci = cl->getCellIndexer();
-        ArrayHandle<Scalar4> h_vel(pdata->getVelocities(),
-                                   access_location::host,
-                                   access_mode::read);
+        ArrayHandle<mpcd::detail::pdata_real4> h_vel(pdata->getVelocities(),
+                                                     access_location::host,
+                                                     access_mode::read);
 
         switch (my_rank)
             {
@@ -1106,9 +1106,9 @@ template<class CL> void celllist_edge_test(std::shared_ptr<ExecutionConfiguratio
                                               access_location::host,
                                               access_mode::read);
         Index3D ci = cl->getCellIndexer();
-        ArrayHandle<Scalar4> h_vel(pdata->getVelocities(),
-                                   access_location::host,
-                                   access_mode::read);
+        ArrayHandle<mpcd::detail::pdata_real4> h_vel(pdata->getVelocities(),
+                                                     access_location::host,
+                                                     access_mode::read);
 
         switch (my_rank)
             {
@@ -1167,9 +1167,9 @@ template<class CL> void celllist_edge_test(std::shared_ptr<ExecutionConfiguratio
                                               access_location::host,
                                               access_mode::read);
         Index3D ci = cl->getCellIndexer();
-        ArrayHandle<Scalar4> h_vel(pdata->getVelocities(),
-                                   access_location::host,
-                                   access_mode::read);
+        ArrayHandle<mpcd::detail::pdata_real4> h_vel(pdata->getVelocities(),
+                                                     access_location::host,
+                                                     access_mode::read);
 
         switch (my_rank)
             {
@@ -1219,9 +1219,9 @@ template<class CL> void celllist_edge_test(std::shared_ptr<ExecutionConfiguratio
     // we are going to pad the cell list with an extra cell just to test that binning now
     cl->setNExtraCells(1);
         {
-        ArrayHandle<Scalar4> h_pos(pdata->getPositions(),
-                                   access_location::host,
-                                   access_mode::overwrite);
+        ArrayHandle<mpcd::detail::pdata_real4> h_pos(pdata->getPositions(),
+                                                     access_location::host,
+                                                     access_mode::overwrite);
         switch (my_rank)
             {
         case 0:
@@ -1262,9 +1262,9 @@ template<class CL> void celllist_edge_test(std::shared_ptr<ExecutionConfiguratio
                                               access_location::host,
                                               access_mode::read);
         Index3D ci = cl->getCellIndexer();
-        ArrayHandle<Scalar4> h_vel(pdata->getVelocities(),
-                                   access_location::host,
-                                   access_mode::read);
+        ArrayHandle<mpcd::detail::pdata_real4> h_vel(pdata->getVelocities(),
+                                                     access_location::host,
+                                                     access_mode::read);
 
         switch (my_rank)
             {
@@ -1323,9 +1323,9 @@ template<class CL> void celllist_edge_test(std::shared_ptr<ExecutionConfiguratio
                                               access_location::host,
                                               access_mode::read);
         Index3D ci = cl->getCellIndexer();
-        ArrayHandle<Scalar4> h_vel(pdata->getVelocities(),
-                                   access_location::host,
-                                   access_mode::read);
+        ArrayHandle<mpcd::detail::pdata_real4> h_vel(pdata->getVelocities(),
+                                                     access_location::host,
+                                                     access_mode::read);
 
         switch (my_rank)
             {
@@ -1385,9 +1385,9 @@ template<class CL> void celllist_edge_test(std::shared_ptr<ExecutionConfiguratio
                                               access_location::host,
                                               access_mode::read);
         Index3D ci = cl->getCellIndexer();
-        ArrayHandle<Scalar4> h_vel(pdata->getVelocities(),
-                                   access_location::host,
-                                   access_mode::read);
+        ArrayHandle<mpcd::detail::pdata_real4> h_vel(pdata->getVelocities(),
+                                                     access_location::host,
+                                                     access_mode::read);
 
         switch (my_rank)
             {
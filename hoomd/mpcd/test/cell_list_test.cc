@@ -155,9 +155,9 @@ template<class CL> void celllist_small_test(std::shared_ptr<ExecutionConfigurati
         CHECK_EQUAL_UINT(h_cell_list.data[cli(0, ci(1, 1, 0))], 3);
         CHECK_EQUAL_UINT(h_cell_list.data[cli(0, ci(1, 1, 1))], 7);
 
-        ArrayHandle<Scalar4> h_vel(pdata_9->getVelocities(),
-                                   access_location::host,
-                                   access_mode::read);
+        ArrayHandle<mpcd::detail::pdata_real4> h_vel(pdata_9->getVelocities(),
+                                                     access_location::host,
+                                                     access_mode::read);
         CHECK_EQUAL_UINT(__scalar_as_int(h_vel.data[0].w), ci(0, 0, 0));
         CHECK_EQUAL_UINT(__scalar_as_int(h_vel.data[1].w), ci(1, 0, 0));
         CHECK_EQUAL_UINT(__scalar_as_int(h_vel.data[2].w), ci(0, 1, 0));
@@ -171,9 +171,9 @@ template<class CL> void celllist_small_test(std::shared_ptr<ExecutionConfigurati
 
     // condense particles into two bins
         {
-        ArrayHandle<Scalar4> h_pos(pdata_9->getPositions(),
-                                   access_location::host,
-                                   access_mode::overwrite);
+        ArrayHandle<mpcd::detail::pdata_real4> h_pos(pdata_9->getPositions(),
+                                                     access_location::host,
+                                                     access_mode::overwrite);
         h_pos.data[0] = make_scalar4(-0.3, -0.3, -0.3, 0.0);
         h_pos.data[1] = make_scalar4(0.3, 0.3, 0.3, 0.0);
         h_pos.data[2] = h_pos.data[0];
@@ -234,9 +234,9 @@ template<class CL> void celllist_small_test(std::shared_ptr<ExecutionConfigurati
     // bring all particles into one box, which triggers a resize, and check that all particles are
     // in this bin
         {
-        ArrayHandle<Scalar4> h_pos(pdata_9->getPositions(),
-                                   access_location::host,
-                                   access_mode::overwrite);
+        ArrayHandle<mpcd::detail::pdata_real4> h_pos(pdata_9->getPositions(),
+                                                     access_location::host,
+                                                     access_mode::overwrite);
         h_pos.data[0] = make_scalar4(0.9, -0.4, 0.0, 0.0);
         for (unsigned int i = 1; i < 9; ++i)
             h_pos.data[i] = h_pos.data[0];
@@ -261,17 +261,17 @@ template<class CL> void celllist_small_test(std::shared_ptr<ExecutionConfigurati
 
     // send a particle out of bounds and check that an exception is raised
         {
-        ArrayHandle<Scalar4> h_pos(pdata_9->getPositions(),
-                                   access_location::host,
-                                   access_mode::overwrite);
+        ArrayHandle<mpcd::detail::pdata_real4> h_pos(pdata_9->getPositions(),
+                                                     access_location::host,
+                                                     access_mode::overwrite);
         h_pos.data[0] = make_scalar4(2.1, 2.1, 2.1, __int_as_scalar(0));
         }
     UP_ASSERT_EXCEPTION(std::runtime_error, [&] { cl->compute(3); });
     // check the other side as well
         {
-        ArrayHandle<Scalar4> h_pos(pdata_9->getPositions(),
-                                   access_location::host,
-                                   access_mode::overwrite);
+        ArrayHandle<mpcd::detail::pdata_real4> h_pos(pdata_9->getPositions(),
+                                                     access_location::host,
+                                                     access_mode::overwrite);
         h_pos.data[0] = make_scalar4(-2.1, -2.1, -2.1, __int_as_scalar(0));
         }
     UP_ASSERT_EXCEPTION(std::runtime_error, [&] { cl->compute(4); });
@@ -315,9 +315,9 @@ template<class CL> void celllist_grid_shift_test(std::shared_ptr<ExecutionConfig
 
     // move to the other side and retry
         {
-        ArrayHandle<Scalar4> h_pos(pdata_1->getPositions(),
-                                   access_location::host,
-                                   access_mode::overwrite);
+        ArrayHandle<mpcd::detail::pdata_real4> h_pos(pdata_1->getPositions(),
+                                                     access_location::host,
+                                                     access_mode::overwrite);
         h_pos.data[0] = make_scalar4(-0.1, -0.1, -0.1, 0.0);
         }
     cl->setGridShift(make_scalar3(-0.5, -0.5, -0.5));
@@ -332,9 +332,9 @@ template<class CL> void celllist_grid_shift_test(std::shared_ptr<ExecutionConfig
 
     // check for cell periodic wrapping by putting particles near the box boundary
         {
-        ArrayHandle<Scalar4> h_pos(pdata_1->getPositions(),
-                                   access_location::host,
-                                   access_mode::overwrite);
+        ArrayHandle<mpcd::detail::pdata_real4> h_pos(pdata_1->getPositions(),
+                                                     access_location::host,
+                                                     access_mode::overwrite);
         h_pos.data[0] = make_scalar4(-2.9, -2.9, -2.9, 0.0);
         }
     cl->setGridShift(make_scalar3(0.5, 0.5, 0.5));
@@ -349,9 +349,9 @@ template<class CL> void celllist_grid_shift_test(std::shared_ptr<ExecutionConfig
 
     // and the other way
         {
-        ArrayHandle<Scalar4> h_pos(pdata_1->getPositions(),
-                                   access_location::host,
-                                   access_mode::overwrite);
+        ArrayHandle<mpcd::detail::pdata_real4> h_pos(pdata_1->getPositions(),
+                                                     access_location::host,
+                                                     access_mode::overwrite);
         h_pos.data[0] = make_scalar4(2.9, 2.9, 2.9, 0.0);
         }
     cl->setGridShift(make_scalar3(-0.5, -0.5, -0.5));
@@ -450,9 +450,9 @@ template<class CL> void celllist_embed_test(std::shared_ptr<ExecutionConfigurati
         CHECK_EQUAL_UINT(h_cell_list.data[cli(0, ci(1, 1, 0))], 3);
         CHECK_EQUAL_UINT(h_cell_list.data[cli(0, ci(1, 1, 1))], 7);
 
-        ArrayHandle<Scalar4> h_vel(pdata_8->getVelocities(),
-                                   access_location::host,
-                                   access_mode::read);
+        ArrayHandle<mpcd::detail::pdata_real4> h_vel(pdata_8->getVelocities(),
+                                                     access_location::host,
+                                                     access_mode::read);
         CHECK_EQUAL_UINT(__scalar_as_int(h_vel.data[0].w), ci(0, 0, 0));
         CHECK_EQUAL_UINT(__scalar_as_int(h_vel.data[1].w), ci(1, 0, 0));
         CHECK_EQUAL_UINT(__scalar_as_int(h_vel.data[2].w), ci(0, 1, 0));
@@ -530,9 +530,9 @@ template<class CL> void celllist_embed_test(std::shared_ptr<ExecutionConfigurati
             UP_ASSERT_EQUAL(result, std::vector<unsigned int> {7, 11});
             }
 
-        ArrayHandle<Scalar4> h_vel(pdata_8->getVelocities(),
-                                   access_location::host,
-                                   access_mode::read);
+        ArrayHandle<mpcd::detail::pdata_real4> h_vel(pdata_8->getVelocities(),
+                                                     access_location::host,
+                                                     access_mode::read);
         CHECK_EQUAL_UINT(__scalar_as_int(h_vel.data[0].w), ci(0, 0, 0));
         CHECK_EQUAL_UINT(__scalar_as_int(h_vel.data[1].w), ci(1, 0, 0));
         CHECK_EQUAL_UINT(__scalar_as_int(h_vel.data[2].w), ci(0, 1, 0));
@@ -626,9 +626,9 @@ template<class CL> void celllist_embed_test(std::shared_ptr<ExecutionConfigurati
             UP_ASSERT_EQUAL(result, std::vector<unsigned int> {7, 11});
             }
 
-        ArrayHandle<Scalar4> h_vel(pdata_8->getVelocities(),
-                                   access_location::host,
-                                   access_mode::read);
+        ArrayHandle<mpcd::detail::pdata_real4> h_vel(pdata_8->getVelocities(),
+                                                     access_location::host,
+                                                     access_mode::read);
         CHECK_EQUAL_UINT(__scalar_as_int(h_vel.data[0].w), ci(0, 0, 0));
         CHECK_EQUAL_UINT(__scalar_as_int(h_vel.data[1].w), ci(1, 0, 0));
         CHECK_EQUAL_UINT(__scalar_as_int(h_vel.data[2].w), ci(0, 1, 0));
@@ -661,6 +661,116 @@ template<class CL> void celllist_embed_test(std::shared_ptr<ExecutionConfigurati
         }
     }
 
+//! Test that updating the cell list in place gives the same cells as a full build
+template<class CL> void celllist_update_test(std::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    std::shared_ptr<SnapshotSystemData<Scalar>> snap(new SnapshotSystemData<Scalar>());
+    snap->global_box = BoxDim(2.0);
+        {
+        SnapshotParticleData<Scalar>& pdata_snap = snap->particle_data;
+        pdata_snap.type_mapping.push_back("A");
+        pdata_snap.resize(2);
+        pdata_snap.pos[0] = vec3<Scalar>(-0.5, -0.5, -0.5);
+        pdata_snap.pos[1] = vec3<Scalar>(0.5, 0.5, 0.5);
+        }
+    std::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(snap, exec_conf));
+
+    std::shared_ptr<mpcd::ParticleData> pdata_4;
+        {
+        auto mpcd_snap = std::make_shared<mpcd::ParticleDataSnapshot>(4);
+        mpcd_snap->position[0] = vec3<Scalar>(-0.5, -0.5, -0.5);
+        mpcd_snap->position[1] = vec3<Scalar>(0.5, -0.5, -0.5);
+        mpcd_snap->position[2] = vec3<Scalar>(-0.5, 0.5, -0.5);
+        mpcd_snap->position[3] = vec3<Scalar>(-0.4, -0.4, -0.4);
+        pdata_4 = std::make_shared<mpcd::ParticleData>(mpcd_snap, snap->global_box, exec_conf);
+        }
+
+    std::shared_ptr<ParticleFilter> selector_all(new ParticleFilterAll());
+    std::shared_ptr<ParticleGroup> group_all(new ParticleGroup(sysdef, selector_all));
+
+    std::shared_ptr<mpcd::CellList> cl(new CL(sysdef, pdata_4));
+    cl->setEmbeddedGroup(group_all);
+    cl->compute(0);
+
+    // move one MPCD particle and one embedded particle into new cells, and clear the cell cache
+    // of the MPCD particles like streaming does
+        {
+        ArrayHandle<mpcd::detail::pdata_real4> h_pos(pdata_4->getPositions(),
+                                                     access_location::host,
+                                                     access_mode::readwrite);
+        ArrayHandle<mpcd::detail::pdata_real4> h_vel(pdata_4->getVelocities(),
+                                                     access_location::host,
+                                                     access_mode::readwrite);
+        h_pos.data[0] = make_scalar4(0.5, 0.5, -0.5, __int_as_scalar(0));
+        h_pos.data[3] = make_scalar4(-0.3, -0.3, -0.3, __int_as_scalar(0));
+        for (unsigned int i = 0; i < pdata_4->getN(); ++i)
+            h_vel.data[i].w = __int_as_scalar(mpcd::detail::NO_CELL);
+
+        ArrayHandle<Scalar4> h_embed_pos(sysdef->getParticleData()->getPositions(),
+                                         access_location::host,
+                                         access_mode::readwrite);
+        h_embed_pos.data[1] = make_scalar4(-0.5, 0.5, 0.5, __int_as_scalar(0));
+        }
+    cl->compute(1);
+
+    // build a fresh cell list of the same configuration to compare with
+    std::shared_ptr<mpcd::CellList> cl_ref(new CL(sysdef, pdata_4));
+    cl_ref->setEmbeddedGroup(group_all);
+    cl_ref->compute(1);
+
+        {
+        ArrayHandle<unsigned int> h_cell_np(cl->getCellSizeArray(),
+                                            access_location::host,
+                                            access_mode::read);
+        ArrayHandle<unsigned int> h_cell_list(cl->getCellList(),
+                                              access_location::host,
+                                              access_mode::read);
+        ArrayHandle<unsigned int> h_ref_np(cl_ref->getCellSizeArray(),
+                                           access_location::host,
+                                           access_mode::read);
+        ArrayHandle<unsigned int> h_ref_list(cl_ref->getCellList(),
+                                             access_location::host,
+                                             access_mode::read);
+        Index2D cli = cl->getCellListIndexer();
+        Index2D ref_cli = cl_ref->getCellListIndexer();
+
+        Index3D ci = cl->getCellIndexer();
+        CHECK_EQUAL_UINT(h_cell_np.data[ci(0, 0, 0)], 2);
+        CHECK_EQUAL_UINT(h_cell_np.data[ci(1, 1, 0)], 1);
+        CHECK_EQUAL_UINT(h_cell_np.data[ci(0, 1, 1)], 1);
+        CHECK_EQUAL_UINT(h_cell_np.data[ci(1, 1, 1)], 0);
+
+        for (unsigned int cell = 0; cell < cl->getNCells(); ++cell)
+            {
+            CHECK_EQUAL_UINT(h_cell_np.data[cell], h_ref_np.data[cell]);
+            std::vector<unsigned int> pids, ref_pids;
+            for (unsigned int offset = 0; offset < h_cell_np.data[cell]; ++offset)
+                {
+                pids.push_back(h_cell_list.data[cli(offset, cell)]);
+                ref_pids.push_back(h_ref_list.data[ref_cli(offset, cell)]);
+                }
+            sort(pids.begin(), pids.end());
+            sort(ref_pids.begin(), ref_pids.end());
+            UP_ASSERT_EQUAL(pids, ref_pids);
+            }
+
+        // the cell cache is restored for all MPCD particles
+        ArrayHandle<mpcd::detail::pdata_real4> h_vel(pdata_4->getVelocities(),
+                                                     access_location::host,
+                                                     access_mode::read);
+        CHECK_EQUAL_UINT(__scalar_as_int(h_vel.data[0].w), ci(1, 1, 0));
+        CHECK_EQUAL_UINT(__scalar_as_int(h_vel.data[1].w), ci(1, 0, 0));
+        CHECK_EQUAL_UINT(__scalar_as_int(h_vel.data[2].w), ci(0, 1, 0));
+        CHECK_EQUAL_UINT(__scalar_as_int(h_vel.data[3].w), ci(0, 0, 0));
+
+        ArrayHandle<unsigned int> h_embed_cell_ids(cl->getEmbeddedGroupCellIds(),
+                                                   access_location::host,
+                                                   access_mode::read);
+        CHECK_EQUAL_UINT(h_embed_cell_ids.data[0], ci(0, 0, 0));
+        CHECK_EQUAL_UINT(h_embed_cell_ids.data[1], ci(0, 1, 1));
+        }
+    }
+
 //! dimension test case for MPCD CellList class
 UP_TEST(mpcd_cell_list_dimensions)
     {
@@ -689,6 +799,13 @@ UP_TEST(mpcd_cell_list_embed_test)
         new ExecutionConfiguration(ExecutionConfiguration::CPU)));
     }
 
+//! in place update test case for MPCD CellList class
+UP_TEST(mpcd_cell_list_update_test)
+    {
+    celllist_update_test<mpcd::CellList>(std::shared_ptr<ExecutionConfiguration>(
+        new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+
 #ifdef ENABLE_HIP
 //! dimension test case for MPCD CellListGPU class
 UP_TEST(mpcd_cell_list_gpu_dimensions)
@@ -717,4 +834,11 @@ UP_TEST(mpcd_cell_list_gpu_embed_test)
     celllist_embed_test<mpcd::CellListGPU>(std::shared_ptr<ExecutionConfiguration>(
         new ExecutionConfiguration(ExecutionConfiguration::GPU)));
     }
+
+//! in place update test case for MPCD CellListGPU class
+UP_TEST(mpcd_cell_list_gpu_update_test)
+    {
+    celllist_update_test<mpcd::CellListGPU>(std::shared_ptr<ExecutionConfiguration>(
+        new ExecutionConfiguration(ExecutionConfiguration::GPU)));
+    }
 #endif // ENABLE_HIP
@@ -161,9 +161,9 @@ template<class CT> void cell_thermo_basic_test(std::shared_ptr<ExecutionConfigur
     // switch a particle into a different cell, and make sure the DOF are reduced accordingly
     pdata_5->setMass(1.0);
         {
-        ArrayHandle<Scalar4> h_pos(pdata_5->getPositions(),
-                                   access_location::host,
-                                   access_mode::readwrite);
+        ArrayHandle<mpcd::detail::pdata_real4> h_pos(pdata_5->getPositions(),
+                                                     access_location::host,
+                                                     access_mode::readwrite);
         h_pos.data[2] = make_scalar4(-0.5, -0.5, -0.5, 0.0);
         }
     thermo->compute(2);
@@ -296,9 +296,9 @@ void test_communicator_migrate(communicator_creator comm_creator,
 
     // move particles to new ranks
         {
-        ArrayHandle<Scalar4> h_pos(pdata->getPositions(),
-                                   access_location::host,
-                                   access_mode::readwrite);
+        ArrayHandle<mpcd::detail::pdata_real4> h_pos(pdata->getPositions(),
+                                                     access_location::host,
+                                                     access_mode::readwrite);
 
         Scalar3 new_pos;
         switch (my_rank)
@@ -437,9 +437,9 @@ void test_communicator_migrate(communicator_creator comm_creator,
 
     // move particles through the global boundary
         {
-        ArrayHandle<Scalar4> h_pos(pdata->getPositions(),
-                                   access_location::host,
-                                   access_mode::readwrite);
+        ArrayHandle<mpcd::detail::pdata_real4> h_pos(pdata->getPositions(),
+                                                     access_location::host,
+                                                     access_mode::readwrite);
 
         Scalar3 new_pos;
         switch (my_rank)
@@ -750,9 +750,9 @@ void test_communicator_migrate_ortho(communicator_creator comm_creator,
 
     // move particles to new ranks
         {
-        ArrayHandle<Scalar4> h_pos(pdata->getPositions(),
-                                   access_location::host,
-                                   access_mode::readwrite);
+        ArrayHandle<mpcd::detail::pdata_real4> h_pos(pdata->getPositions(),
+                                                     access_location::host,
+                                                     access_mode::readwrite);
 
         Scalar3 new_pos;
         switch (exec_conf->getRank())
@@ -805,9 +805,9 @@ void test_communicator_migrate_ortho(communicator_creator comm_creator,
     // move all particles onto domains 5 and 6
     const unsigned int rank = exec_conf->getRank();
         {
-        ArrayHandle<Scalar4> h_pos(pdata->getPositions(),
-                                   access_location::host,
-                                   access_mode::readwrite);
+        ArrayHandle<mpcd::detail::pdata_real4> h_pos(pdata->getPositions(),
+                                                     access_location::host,
+                                                     access_mode::readwrite);
 
         // just get them all in the same place
         // this first set will put tags 7, 0, 3, and 4 on rank 5
@@ -841,9 +841,9 @@ void test_communicator_migrate_ortho(communicator_creator comm_creator,
 
     // now send multiple particles out from each rank in different directions
         {
-        ArrayHandle<Scalar4> h_pos(pdata->getPositions(),
-                                   access_location::host,
-                                   access_mode::readwrite);
+        ArrayHandle<mpcd::detail::pdata_real4> h_pos(pdata->getPositions(),
+                                                     access_location::host,
+                                                     access_mode::readwrite);
         if (rank == 5)
             {
             // send one particle to rank 6, rank 4, and rank 0
@@ -905,6 +905,87 @@ void test_communicator_migrate_ortho(communicator_creator comm_creator,
         }
     }
 
+//! Test particle migration started by beginMigrate and completed by finishMigrate
+void test_communicator_migrate_overlap(communicator_creator comm_creator,
+                                       std::shared_ptr<ExecutionConfiguration> exec_conf,
+                                       unsigned int nstages)
+    {
+    // this test needs to be run on eight processors
+    int size;
+    MPI_Comm_size(exec_conf->getHOOMDWorldMPICommunicator(), &size);
+    UP_ASSERT_EQUAL(size, 8);
+
+    std::shared_ptr<SnapshotSystemData<Scalar>> snap(new SnapshotSystemData<Scalar>());
+    snap->global_box = BoxDim(4.0, 2.0, 1.0);
+    snap->particle_data.type_mapping.push_back("A");
+    std::shared_ptr<DomainDecomposition> decomposition(
+        new DomainDecomposition(exec_conf, snap->global_box.getL(), 4, 2, 1));
+    std::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(snap, exec_conf, decomposition));
+
+    // place one mpcd particle in each domain
+    auto mpcd_sys_snap = std::make_shared<mpcd::SystemDataSnapshot>(sysdef);
+        {
+        auto mpcd_snap = mpcd_sys_snap->particles;
+
+        mpcd_snap->resize(8);
+        mpcd_snap->position[0] = vec3<Scalar>(-1.5, -0.5, 0.0);
+        mpcd_snap->position[1] = vec3<Scalar>(-0.5, -0.5, 0.0);
+        mpcd_snap->position[2] = vec3<Scalar>(0.5, -0.5, 0.0);
+        mpcd_snap->position[3] = vec3<Scalar>(1.5, -0.5, 0.0);
+        mpcd_snap->position[4] = vec3<Scalar>(-1.5, 0.5, 0.0);
+        mpcd_snap->position[5] = vec3<Scalar>(-0.5, 0.5, 0.0);
+        mpcd_snap->position[6] = vec3<Scalar>(0.5, 0.5, 0.0);
+        mpcd_snap->position[7] = vec3<Scalar>(1.5, 0.5, 0.0);
+        }
+    auto mpcd_sys = std::make_shared<mpcd::SystemData>(mpcd_sys_snap);
+    mpcd_sys->getCellList()->setCellSize(0.05);
+
+    std::shared_ptr<mpcd::Communicator> comm = comm_creator(mpcd_sys, nstages);
+    MigrateSelectOp migrate_op(comm);
+
+    // the first communication checks the decomposition, which is not done early
+    comm->communicate(1);
+    std::shared_ptr<mpcd::ParticleData> pdata = mpcd_sys->getParticleData();
+    UP_ASSERT_EQUAL(pdata->getN(), 1);
+    UP_ASSERT_EQUAL(pdata->getTag(0), exec_conf->getRank());
+
+    // move every particle into the domain to the right (in x)
+        {
+        ArrayHandle<mpcd::detail::pdata_real4> h_pos(pdata->getPositions(),
+                                                     access_location::host,
+                                                     access_mode::readwrite);
+        Scalar x = h_pos.data[0].x + Scalar(1.0);
+        if (x > Scalar(2.0))
+            x -= Scalar(4.0);
+        h_pos.data[0].x = x;
+        }
+
+    // the particle leaves when the migration begins and a new one arrives when it finishes
+    comm->beginMigrate(2);
+    UP_ASSERT_EQUAL(pdata->getN(), 0);
+    comm->finishMigrate(2);
+    UP_ASSERT_EQUAL(pdata->getN(), 1);
+    const unsigned int rank = exec_conf->getRank();
+    const unsigned int ref_tag = (rank % 4 == 0) ? rank + 3 : rank - 1;
+    UP_ASSERT_EQUAL(pdata->getTag(0), ref_tag);
+
+    // communicate at the same step does not migrate again, so the particle is not moved
+        {
+        ArrayHandle<mpcd::detail::pdata_real4> h_pos(pdata->getPositions(),
+                                                     access_location::host,
+                                                     access_mode::readwrite);
+        h_pos.data[0].y = -h_pos.data[0].y;
+        }
+    comm->communicate(2);
+    UP_ASSERT_EQUAL(pdata->getN(), 1);
+    UP_ASSERT_EQUAL(pdata->getTag(0), ref_tag);
+
+    // but the next one does, which sends every particle to the domain above or below
+    comm->communicate(4);
+    UP_ASSERT_EQUAL(pdata->getN(), 1);
+    UP_ASSERT_EQUAL(pdata->getTag(0), (ref_tag + 4) % 8);
+    }
+
 //! Test particle migration of Communicator
 void test_communicator_overdecompose(std::shared_ptr<ExecutionConfiguration> exec_conf,
                                      unsigned int nx,
@@ -1083,5 +1164,23 @@ UP_TEST(mpcd_communicator_migrate_ortho_test_GPU_two_stage)
     communicator_creator communicator_creator_gpu = bind(gpu_communicator_creator, _1, _2);
     test_communicator_migrate_ortho(communicator_creator_gpu, exec_conf, 2);
     }
+
+UP_TEST(mpcd_communicator_migrate_overlap_test_GPU_one_stage)
+    {
+    auto exec_conf = std::shared_ptr<ExecutionConfiguration>(
+        new ExecutionConfiguration(ExecutionConfiguration::GPU));
+
+    communicator_creator communicator_creator_gpu = bind(gpu_communicator_creator, _1, _2);
+    test_communicator_migrate_overlap(communicator_creator_gpu, exec_conf, 1);
+    }
+
+UP_TEST(mpcd_communicator_migrate_overlap_test_GPU_two_stage)
+    {
+    auto exec_conf = std::shared_ptr<ExecutionConfiguration>(
+        new ExecutionConfiguration(ExecutionConfiguration::GPU));
+
+    communicator_creator communicator_creator_gpu = bind(gpu_communicator_creator, _1, _2);
+    test_communicator_migrate_overlap(communicator_creator_gpu, exec_conf, 2);
+    }
 #endif // ENABLE_HIP
 #endif // ENABLE_MPI
@@ -0,0 +1,215 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+#include "hoomd/mpcd/SDFGeometryFiller.h"
+#ifdef ENABLE_HIP
+#include "hoomd/mpcd/SDFGeometryFillerGPU.h"
+#endif // ENABLE_HIP
+
+#include "hoomd/SnapshotSystemData.h"
+#include "hoomd/test/upp11_config.h"
+
+#include <vector>
+
+HOOMD_UP_MAIN()
+
+//! Make a signed distance field for a slit of half width 5 in a box of edge 20 with unit spacing
+std::shared_ptr<const mpcd::detail::SDFGeometry> make_slit_sdf(bool use_device,
+                                                               mpcd::detail::boundary bc)
+    {
+    const Index3D indexer(20, 20, 20);
+    std::vector<Scalar> sdf(indexer.getNumElements());
+    for (unsigned int k = 0; k < 20; ++k)
+        for (unsigned int j = 0; j < 20; ++j)
+            for (unsigned int i = 0; i < 20; ++i)
+                sdf[indexer(i, j, k)] = std::abs(Scalar(-10.0) + k) - Scalar(5.0);
+
+    return mpcd::detail::SDFGeometry::create(use_device,
+                                             sdf.data(),
+                                             indexer,
+                                             make_scalar3(-10, -10, -10),
+                                             make_scalar3(20, 20, 20),
+                                             bc);
+    }
+
+UP_TEST(sdf_geometry_collision)
+    {
+    auto geom = make_slit_sdf(false, mpcd::detail::boundary::no_slip);
+    UP_ASSERT(geom->validateBox(BoxDim(20.0), 1.0));
+    UP_ASSERT(!geom->validateBox(BoxDim(18.0), 1.0));
+
+    // interpolation and inside / outside
+    CHECK_CLOSE(geom->getDistance(make_scalar3(0.3, -2.1, 6.5)), 1.5, tol_small);
+    CHECK_CLOSE(geom->getDistance(make_scalar3(0.3, -2.1, -6.5)), 1.5, tol_small);
+    UP_ASSERT(geom->isOutside(make_scalar3(0, 0, 5.5)));
+    UP_ASSERT(!geom->isOutside(make_scalar3(0, 0, 4.5)));
+    UP_ASSERT(!geom->isOutside(make_scalar3(0, 0, -4.5)));
+
+    // no collision inside the channel
+        {
+        Scalar3 pos = make_scalar3(0, 0, 4.5);
+        Scalar3 vel = make_scalar3(1, 0, 1);
+        Scalar dt = 1.0;
+        UP_ASSERT(!geom->detectCollision(pos, vel, dt));
+        CHECK_SMALL(dt, tol_small);
+        }
+
+    // no-slip collision through the upper wall reverses the velocity
+        {
+        Scalar3 pos = make_scalar3(0, 0, 5.5);
+        Scalar3 vel = make_scalar3(1, 0, 1);
+        Scalar dt = 1.0;
+        UP_ASSERT(geom->detectCollision(pos, vel, dt));
+        CHECK_CLOSE(dt, 0.5, tol_small);
+        CHECK_CLOSE(pos.x, -0.5, tol_small);
+        CHECK_SMALL(pos.y, tol_small);
+        CHECK_CLOSE(pos.z, 5.0, tol_small);
+        UP_ASSERT(!geom->isOutside(pos));
+        CHECK_CLOSE(vel.x, -1.0, tol_small);
+        CHECK_SMALL(vel.y, tol_small);
+        CHECK_CLOSE(vel.z, -1.0, tol_small);
+        }
+
+    // slip collision through the lower wall only reflects the normal component
+    auto slip = make_slit_sdf(false, mpcd::detail::boundary::slip);
+        {
+        Scalar3 pos = make_scalar3(0, 0, -5.5);
+        Scalar3 vel = make_scalar3(1, 2, -1);
+        Scalar dt = 1.0;
+        UP_ASSERT(slip->detectCollision(pos, vel, dt));
+        CHECK_CLOSE(dt, 0.5, tol_small);
+        CHECK_CLOSE(pos.x, -0.5, tol_small);
+        CHECK_CLOSE(pos.y, -1.0, tol_small);
+        CHECK_CLOSE(pos.z, -5.0, tol_small);
+        CHECK_CLOSE(vel.x, 1.0, tol_small);
+        CHECK_CLOSE(vel.y, 2.0, tol_small);
+        CHECK_CLOSE(vel.z, 1.0, tol_small);
+        }
+    }
+
+template<class F> void sdf_fill_basic_test(std::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    std::shared_ptr<SnapshotSystemData<Scalar>> snap(new SnapshotSystemData<Scalar>());
+    snap->global_box = BoxDim(20.0);
+    snap->particle_data.type_mapping.push_back("A");
+    std::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(snap, exec_conf));
+
+    auto mpcd_sys_snap = std::make_shared<mpcd::SystemDataSnapshot>(sysdef);
+        {
+        std::shared_ptr<mpcd::ParticleDataSnapshot> mpcd_snap = mpcd_sys_snap->particles;
+        mpcd_snap->resize(1);
+
+        mpcd_snap->position[0] = vec3<Scalar>(1, -2, 3);
+        mpcd_snap->velocity[0] = vec3<Scalar>(123, 456, 789);
+        }
+    auto mpcd_sys = std::make_shared<mpcd::SystemData>(mpcd_sys_snap);
+    auto pdata = mpcd_sys->getParticleData();
+    mpcd_sys->getCellList()->setCellSize(2.0);
+    UP_ASSERT_EQUAL(pdata->getNVirtual(), 0);
+
+    auto geom = make_slit_sdf(exec_conf->isCUDAEnabled(), mpcd::detail::boundary::no_slip);
+    std::shared_ptr<::Variant> kT = std::make_shared<::VariantConstant>(1.5);
+    std::shared_ptr<mpcd::SDFGeometryFiller> filler
+        = std::make_shared<F>(mpcd_sys, 2.0, 1, kT, 42, geom);
+
+    /*
+     * The fill region is 5 < |z| <= 2 sqrt(3). The voxels from 5 to 8 lie fully inside it, and
+     * half of the sample points of the voxel from 8 to 9 are inside it, so the volume is 3.5 on
+     * each side with a cross section of 20^2.
+     */
+    filler->fill(0);
+    UP_ASSERT_EQUAL(pdata->getNVirtual(), 2 * 7 * 20 * 20);
+        {
+        ArrayHandle<mpcd::detail::pdata_real4> h_pos(pdata->getPositions(),
+                                                     access_location::host,
+                                                     access_mode::read);
+        ArrayHandle<mpcd::detail::pdata_real4> h_vel(pdata->getVelocities(),
+                                                     access_location::host,
+                                                     access_mode::read);
+        ArrayHandle<unsigned int> h_tag(pdata->getTags(), access_location::host, access_mode::read);
+
+        // ensure first particle did not get overwritten
+        CHECK_CLOSE(h_pos.data[0].x, 1, tol_small);
+        CHECK_CLOSE(h_pos.data[0].y, -2, tol_small);
+        CHECK_CLOSE(h_pos.data[0].z, 3, tol_small);
+        CHECK_CLOSE(h_vel.data[0].x, 123, tol_small);
+        CHECK_CLOSE(h_vel.data[0].y, 456, tol_small);
+        CHECK_CLOSE(h_vel.data[0].z, 789, tol_small);
+        UP_ASSERT_EQUAL(h_tag.data[0], 0);
+
+        const Scalar thickness = std::sqrt(Scalar(3.0)) * Scalar(2.0);
+        unsigned int N_lo(0), N_hi(0);
+        for (unsigned int i = pdata->getN(); i < pdata->getN() + pdata->getNVirtual(); ++i)
+            {
+            // tag should equal index on one rank with one filler
+            UP_ASSERT_EQUAL(h_tag.data[i], i);
+            // type should be set
+            UP_ASSERT_EQUAL(__scalar_as_int(h_pos.data[i].w), 1);
+
+            const Scalar z = h_pos.data[i].z;
+            UP_ASSERT(std::abs(z) > Scalar(5.0));
+            UP_ASSERT(std::abs(z) <= Scalar(5.0) + thickness + tol_small);
+            if (z < Scalar(0))
+                ++N_lo;
+            else
+                ++N_hi;
+            }
+        UP_ASSERT_EQUAL(N_lo, 7 * 20 * 20);
+        UP_ASSERT_EQUAL(N_hi, 7 * 20 * 20);
+        }
+
+    /*
+     * Fill the volume again with double the density, which should triple the number of virtual
+     * particles
+     */
+    filler->setDensity(4.0);
+    filler->fill(1);
+    UP_ASSERT_EQUAL(pdata->getNVirtual(), 6 * 7 * 20 * 20);
+
+    /*
+     * Test the average fill properties of the virtual particles.
+     */
+    filler->setDensity(2.0);
+    unsigned int N_avg(0);
+    Scalar3 v_avg = make_scalar3(0, 0, 0);
+    Scalar T_avg(0);
+    for (unsigned int t = 0; t < 500; ++t)
+        {
+        pdata->removeVirtualParticles();
+        filler->fill(2 + t);
+
+        ArrayHandle<mpcd::detail::pdata_real4> h_vel(pdata->getVelocities(),
+                                                     access_location::host,
+                                                     access_mode::read);
+        for (unsigned int i = pdata->getN(); i < pdata->getN() + pdata->getNVirtual(); ++i)
+            {
+            const Scalar4 vel_cell = h_vel.data[i];
+            const Scalar3 vel = make_scalar3(vel_cell.x, vel_cell.y, vel_cell.z);
+
+            ++N_avg;
+            v_avg += vel;
+            T_avg += dot(vel, vel);
+            }
+        }
+    // make averages
+    v_avg /= N_avg;
+    T_avg /= (3 * (N_avg - 1));
+
+    CHECK_SMALL(v_avg.x, tol);
+    CHECK_SMALL(v_avg.y, tol);
+    CHECK_SMALL(v_avg.z, tol);
+    CHECK_CLOSE(T_avg, 1.5, tol);
+    }
+
+UP_TEST(sdf_fill_basic)
+    {
+    sdf_fill_basic_test<mpcd::SDFGeometryFiller>(
+        std::make_shared<ExecutionConfiguration>(ExecutionConfiguration::CPU));
+    }
+#ifdef ENABLE_HIP
+UP_TEST(sdf_fill_basic_gpu)
+    {
+    sdf_fill_basic_test<mpcd::SDFGeometryFillerGPU>(
+        std::make_shared<ExecutionConfiguration>(ExecutionConfiguration::GPU));
+    }
+#endif // ENABLE_HIP
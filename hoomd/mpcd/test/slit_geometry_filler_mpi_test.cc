@@ -54,7 +54,9 @@ template<class F> void slit_fill_mpi_test(std::shared_ptr<ExecutionConfiguration
     // globally, cross section is 20^2 globally and also mirrored on bottom
     UP_ASSERT_EQUAL(pdata->getNVirtualGlobal(), 2 * (20 * 20 / 2) * 2);
         {
-        ArrayHandle<Scalar4> h_pos(pdata->getPositions(), access_location::host, access_mode::read);
+        ArrayHandle<mpcd::detail::pdata_real4> h_pos(pdata->getPositions(),
+                                                     access_location::host,
+                                                     access_mode::read);
         ArrayHandle<unsigned int> h_tag(pdata->getTags(), access_location::host, access_mode::read);
         const BoxDim& box = sysdef->getParticleData()->getBox();
         for (unsigned int i = 0; i < pdata->getNVirtual(); ++i)
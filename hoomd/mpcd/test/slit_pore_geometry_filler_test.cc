@@ -54,10 +54,12 @@ template<class F> void slit_pore_fill_basic_test(std::shared_ptr<ExecutionConfig
     UP_ASSERT_EQUAL(pdata->getNVirtual(), 2 * 2 * (1 * 3 + 2 * 16 + 1 * 3) * 20);
     // count that particles have been placed on the right sides, and in right spaces
         {
-        ArrayHandle<Scalar4> h_pos(pdata->getPositions(), access_location::host, access_mode::read);
-        ArrayHandle<Scalar4> h_vel(pdata->getVelocities(),
-                                   access_location::host,
-                                   access_mode::read);
+        ArrayHandle<mpcd::detail::pdata_real4> h_pos(pdata->getPositions(),
+                                                     access_location::host,
+                                                     access_mode::read);
+        ArrayHandle<mpcd::detail::pdata_real4> h_vel(pdata->getVelocities(),
+                                                     access_location::host,
+                                                     access_mode::read);
         ArrayHandle<unsigned int> h_tag(pdata->getTags(), access_location::host, access_mode::read);
 
         // ensure first particle did not get overwritten
@@ -99,10 +101,12 @@ template<class F> void slit_pore_fill_basic_test(std::shared_ptr<ExecutionConfig
     UP_ASSERT_EQUAL(pdata->getNVirtual(), 6 * 2 * (1 * 3 + 2 * 16 + 1 * 3) * 20);
     // count that particles have been placed on the right sides
         {
-        ArrayHandle<Scalar4> h_pos(pdata->getPositions(), access_location::host, access_mode::read);
-        ArrayHandle<Scalar4> h_vel(pdata->getVelocities(),
-                                   access_location::host,
-                                   access_mode::read);
+        ArrayHandle<mpcd::detail::pdata_real4> h_pos(pdata->getPositions(),
+                                                     access_location::host,
+                                                     access_mode::read);
+        ArrayHandle<mpcd::detail::pdata_real4> h_vel(pdata->getVelocities(),
+                                                     access_location::host,
+                                                     access_mode::read);
         ArrayHandle<unsigned int> h_tag(pdata->getTags(), access_location::host, access_mode::read);
 
         unsigned int N_lo(0), N_hi(0);
@@ -136,7 +140,9 @@ template<class F> void slit_pore_fill_basic_test(std::shared_ptr<ExecutionConfig
                     (unsigned int)(4 * 2 * (0.5 * 4.5 + 0.5 * 16 + 0.5 * 4.5) * 20));
     // count that particles have been placed on the right sides
         {
-        ArrayHandle<Scalar4> h_pos(pdata->getPositions(), access_location::host, access_mode::read);
+        ArrayHandle<mpcd::detail::pdata_real4> h_pos(pdata->getPositions(),
+                                                     access_location::host,
+                                                     access_mode::read);
         unsigned int N_lo(0), N_hi(0);
         for (unsigned int i = pdata->getN(); i < pdata->getN() + pdata->getNVirtual(); ++i)
             {
@@ -166,9 +172,9 @@ template<class F> void slit_pore_fill_basic_test(std::shared_ptr<ExecutionConfig
         pdata->removeVirtualParticles();
         filler->fill(3 + t);
 
-        ArrayHandle<Scalar4> h_vel(pdata->getVelocities(),
-                                   access_location::host,
-                                   access_mode::read);
+        ArrayHandle<mpcd::detail::pdata_real4> h_vel(pdata->getVelocities(),
+                                                     access_location::host,
+                                                     access_mode::read);
         for (unsigned int i = pdata->getN(); i < pdata->getN() + pdata->getNVirtual(); ++i)
             {
             const Scalar4 vel_cell = h_vel.data[i];
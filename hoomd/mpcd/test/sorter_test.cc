@@ -97,7 +97,9 @@ template<class T> void sorter_test(std::shared_ptr<ExecutionConfiguration> exec_
         UP_ASSERT_EQUAL(h_tag.data[7], 0);
 
         // positions should be in order now
-        ArrayHandle<Scalar4> h_pos(pdata->getPositions(), access_location::host, access_mode::read);
+        ArrayHandle<mpcd::detail::pdata_real4> h_pos(pdata->getPositions(),
+                                                     access_location::host,
+                                                     access_mode::read);
         CHECK_CLOSE(h_pos.data[0].x, -0.5, tol);
         CHECK_CLOSE(h_pos.data[0].y, -0.5, tol);
         CHECK_CLOSE(h_pos.data[0].z, -0.5, tol);
@@ -133,9 +135,9 @@ template<class T> void sorter_test(std::shared_ptr<ExecutionConfiguration> exec_
         UP_ASSERT_EQUAL(__scalar_as_int(h_pos.data[7].w), 7);
 
         // velocities should also be sorted
-        ArrayHandle<Scalar4> h_vel(pdata->getVelocities(),
-                                   access_location::host,
-                                   access_mode::read);
+        ArrayHandle<mpcd::detail::pdata_real4> h_vel(pdata->getVelocities(),
+                                                     access_location::host,
+                                                     access_mode::read);
         CHECK_CLOSE(h_vel.data[0].x, 0., tol);
         CHECK_CLOSE(h_vel.data[0].y, -0.5, tol);
         CHECK_CLOSE(h_vel.data[0].z, 0.5, tol);
@@ -257,12 +259,12 @@ template<class T> void sorter_virtual_test(std::shared_ptr<ExecutionConfiguratio
     auto pdata = mpcd_sys->getParticleData();
     pdata->addVirtualParticles(2);
         {
-        ArrayHandle<Scalar4> h_pos(pdata->getPositions(),
-                                   access_location::host,
-                                   access_mode::readwrite);
-        ArrayHandle<Scalar4> h_vel(pdata->getVelocities(),
-                                   access_location::host,
-                                   access_mode::readwrite);
+        ArrayHandle<mpcd::detail::pdata_real4> h_pos(pdata->getPositions(),
+                                                     access_location::host,
+                                                     access_mode::readwrite);
+        ArrayHandle<mpcd::detail::pdata_real4> h_vel(pdata->getVelocities(),
+                                                     access_location::host,
+                                                     access_mode::readwrite);
         ArrayHandle<unsigned int> h_tag(pdata->getTags(),
                                         access_location::host,
                                         access_mode::readwrite);
@@ -297,7 +299,9 @@ template<class T> void sorter_virtual_test(std::shared_ptr<ExecutionConfiguratio
         UP_ASSERT_EQUAL(h_tag.data[7], 7);
 
         // positions should be in order now, with virtual particles at the end unsorted
-        ArrayHandle<Scalar4> h_pos(pdata->getPositions(), access_location::host, access_mode::read);
+        ArrayHandle<mpcd::detail::pdata_real4> h_pos(pdata->getPositions(),
+                                                     access_location::host,
+                                                     access_mode::read);
         CHECK_CLOSE(h_pos.data[0].x, -0.5, tol);
         CHECK_CLOSE(h_pos.data[0].y, -0.5, tol);
         CHECK_CLOSE(h_pos.data[0].z, -0.5, tol);
@@ -336,9 +340,9 @@ template<class T> void sorter_virtual_test(std::shared_ptr<ExecutionConfiguratio
         UP_ASSERT_EQUAL(__scalar_as_int(h_pos.data[7].w), 3);
 
         // velocities should also be sorted
-        ArrayHandle<Scalar4> h_vel(pdata->getVelocities(),
-                                   access_location::host,
-                                   access_mode::read);
+        ArrayHandle<mpcd::detail::pdata_real4> h_vel(pdata->getVelocities(),
+                                                     access_location::host,
+                                                     access_mode::read);
         CHECK_CLOSE(h_vel.data[0].x, 0., tol);
         CHECK_CLOSE(h_vel.data[0].y, -0.5, tol);
         CHECK_CLOSE(h_vel.data[0].z, 0.5, tol);
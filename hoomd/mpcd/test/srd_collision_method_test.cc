@@ -73,9 +73,9 @@ void srd_collision_method_basic_test(std::shared_ptr<ExecutionConfiguration> exe
     UP_ASSERT(!collide->peekCollide(0));
     collide->collide(0);
         {
-        ArrayHandle<Scalar4> h_vel(pdata_4->getVelocities(),
-                                   access_location::host,
-                                   access_mode::read);
+        ArrayHandle<mpcd::detail::pdata_real4> h_vel(pdata_4->getVelocities(),
+                                                     access_location::host,
+                                                     access_mode::read);
         for (unsigned int i = 0; i < pdata_4->getN(); ++i)
             {
             CHECK_CLOSE(h_vel.data[i].x, orig_vel[i].x, tol_small);
@@ -100,9 +100,9 @@ void srd_collision_method_basic_test(std::shared_ptr<ExecutionConfiguration> exe
     UP_ASSERT(collide->peekCollide(1));
     collide->collide(1);
         {
-        ArrayHandle<Scalar4> h_vel(pdata_4->getVelocities(),
-                                   access_location::host,
-                                   access_mode::read);
+        ArrayHandle<mpcd::detail::pdata_real4> h_vel(pdata_4->getVelocities(),
+                                                     access_location::host,
+                                                     access_mode::read);
         ArrayHandle<double3> h_rotvec(collide->getRotationVectors(),
                                       access_location::host,
                                       access_mode::read);
@@ -6,12 +6,16 @@
 #include "hoomd/mpcd/ConfinedStreamingMethod.h"
 #include "hoomd/mpcd/StreamingGeometry.h"
 #ifdef ENABLE_HIP
+#include "hoomd/mpcd/CellListGPU.h"
 #include "hoomd/mpcd/ConfinedStreamingMethodGPU.h"
 #endif // ENABLE_HIP
 
 #include "hoomd/SnapshotSystemData.h"
 #include "hoomd/test/upp11_config.h"
 
+#include <algorithm>
+#include <vector>
+
 HOOMD_UP_MAIN()
 
 //! Test for basic setup and functionality of the streaming method
@@ -50,9 +54,9 @@ void streaming_method_basic_test(std::shared_ptr<ExecutionConfiguration> exec_co
     stream->stream(2);
     std::shared_ptr<mpcd::ParticleData> pdata_2 = mpcd_sys->getParticleData();
         {
-        ArrayHandle<Scalar4> h_pos(pdata_2->getPositions(),
-                                   access_location::host,
-                                   access_mode::read);
+        ArrayHandle<mpcd::detail::pdata_real4> h_pos(pdata_2->getPositions(),
+                                                     access_location::host,
+                                                     access_mode::read);
         CHECK_CLOSE(h_pos.data[0].x, 1.0, tol);
         CHECK_CLOSE(h_pos.data[0].y, 4.85, tol);
         CHECK_CLOSE(h_pos.data[0].z, 3.0, tol);
@@ -66,9 +70,9 @@ void streaming_method_basic_test(std::shared_ptr<ExecutionConfiguration> exec_co
     UP_ASSERT(stream->peekStream(3));
     stream->stream(3);
         {
-        ArrayHandle<Scalar4> h_pos(pdata_2->getPositions(),
-                                   access_location::host,
-                                   access_mode::read);
+        ArrayHandle<mpcd::detail::pdata_real4> h_pos(pdata_2->getPositions(),
+                                                     access_location::host,
+                                                     access_mode::read);
         CHECK_CLOSE(h_pos.data[0].x, 1.1, tol);
         CHECK_CLOSE(h_pos.data[0].y, 4.95, tol);
         CHECK_CLOSE(h_pos.data[0].z, 3.1, tol);
@@ -84,9 +88,9 @@ void streaming_method_basic_test(std::shared_ptr<ExecutionConfiguration> exec_co
     UP_ASSERT(stream->peekStream(5));
     stream->stream(5);
         {
-        ArrayHandle<Scalar4> h_pos(pdata_2->getPositions(),
-                                   access_location::host,
-                                   access_mode::read);
+        ArrayHandle<mpcd::detail::pdata_real4> h_pos(pdata_2->getPositions(),
+                                                     access_location::host,
+                                                     access_mode::read);
         CHECK_CLOSE(h_pos.data[0].x, 1.2, tol);
         CHECK_CLOSE(h_pos.data[0].y, -4.95, tol);
         CHECK_CLOSE(h_pos.data[0].z, 3.2, tol);
@@ -100,9 +104,9 @@ void streaming_method_basic_test(std::shared_ptr<ExecutionConfiguration> exec_co
     stream->setDeltaT(0.1);
     stream->stream(7);
         {
-        ArrayHandle<Scalar4> h_pos(pdata_2->getPositions(),
-                                   access_location::host,
-                                   access_mode::read);
+        ArrayHandle<mpcd::detail::pdata_real4> h_pos(pdata_2->getPositions(),
+                                                     access_location::host,
+                                                     access_mode::read);
         CHECK_CLOSE(h_pos.data[0].x, 1.4, tol);
         CHECK_CLOSE(h_pos.data[0].y, -4.75, tol);
         CHECK_CLOSE(h_pos.data[0].z, 3.4, tol);
@@ -128,4 +132,96 @@ UP_TEST(mpcd_streaming_method_setup)
     streaming_method_basic_test<method>(
         std::make_shared<ExecutionConfiguration>(ExecutionConfiguration::GPU));
     }
+
+//! Test that the GPU streaming method bins the particles into the cell list when requested
+UP_TEST(mpcd_streaming_method_bin_cells)
+    {
+    auto exec_conf = std::make_shared<ExecutionConfiguration>(ExecutionConfiguration::GPU);
+    std::shared_ptr<SnapshotSystemData<Scalar>> snap(new SnapshotSystemData<Scalar>());
+    snap->global_box = BoxDim(4.0);
+    snap->particle_data.type_mapping.push_back("A");
+    std::shared_ptr<SystemDefinition> sysdef(new SystemDefinition(snap, exec_conf));
+
+    auto mpcd_sys_snap = std::make_shared<mpcd::SystemDataSnapshot>(sysdef);
+        {
+        auto mpcd_snap = mpcd_sys_snap->particles;
+        mpcd_snap->resize(4);
+
+        mpcd_snap->position[0] = vec3<Scalar>(-0.6, -0.6, -0.6);
+        mpcd_snap->position[1] = vec3<Scalar>(0.6, 0.6, 0.6);
+        mpcd_snap->position[2] = vec3<Scalar>(1.9, -1.9, 0.1);
+        mpcd_snap->position[3] = vec3<Scalar>(-1.2, 1.7, -1.9);
+
+        mpcd_snap->velocity[0] = vec3<Scalar>(1.0, 1.0, 1.0);
+        mpcd_snap->velocity[1] = vec3<Scalar>(-1.0, 2.0, 0.5);
+        mpcd_snap->velocity[2] = vec3<Scalar>(2.0, -1.0, 0.0);
+        mpcd_snap->velocity[3] = vec3<Scalar>(0.0, 0.5, -2.0);
+        }
+    auto mpcd_sys = std::make_shared<mpcd::SystemData>(mpcd_sys_snap);
+    auto pdata = mpcd_sys->getParticleData();
+    auto cl = mpcd_sys->getCellList();
+
+    // stream every step, binning for a collision at step 1
+    auto geom = std::make_shared<const mpcd::detail::BulkGeometry>();
+    auto stream = std::make_shared<mpcd::ConfinedStreamingMethodGPU<mpcd::detail::BulkGeometry>>(
+        mpcd_sys,
+        0,
+        1,
+        -1,
+        geom);
+    stream->setDeltaT(0.25);
+    const Scalar3 shift = make_scalar3(0.1, -0.2, 0.3);
+    stream->requestCellBinning(1, shift);
+    stream->stream(0);
+
+    // the cell list is already computed for the collision at step 1 with its grid shift
+    UP_ASSERT(pdata->checkCellCache());
+    CHECK_CLOSE(cl->getGridShift().y, shift.y, tol);
+
+    // compare to a cell list built from scratch
+    auto ref_cl = std::make_shared<mpcd::CellListGPU>(sysdef, pdata);
+    ref_cl->setGridShift(shift);
+    ref_cl->compute(1);
+    UP_ASSERT_EQUAL(cl->getNCells(), ref_cl->getNCells());
+        {
+        ArrayHandle<unsigned int> h_cell_np(cl->getCellSizeArray(),
+                                            access_location::host,
+                                            access_mode::read);
+        ArrayHandle<unsigned int> h_cell_list(cl->getCellList(),
+                                              access_location::host,
+                                              access_mode::read);
+        ArrayHandle<unsigned int> h_ref_np(ref_cl->getCellSizeArray(),
+                                           access_location::host,
+                                           access_mode::read);
+        ArrayHandle<unsigned int> h_ref_list(ref_cl->getCellList(),
+                                             access_location::host,
+                                             access_mode::read);
+        ArrayHandle<mpcd::detail::pdata_real4> h_vel(pdata->getVelocities(),
+                                                     access_location::host,
+                                                     access_mode::read);
+        const Index2D& cli = cl->getCellListIndexer();
+        const Index2D& ref_cli = ref_cl->getCellListIndexer();
+        for (unsigned int cell = 0; cell < cl->getNCells(); ++cell)
+            {
+            UP_ASSERT_EQUAL(h_cell_np.data[cell], h_ref_np.data[cell]);
+
+            // particles can be in any order within the cell
+            std::vector<unsigned int> members, ref_members;
+            for (unsigned int offset = 0; offset < h_cell_np.data[cell]; ++offset)
+                {
+                const unsigned int pid = h_cell_list.data[cli(offset, cell)];
+                members.push_back(pid);
+                ref_members.push_back(h_ref_list.data[ref_cli(offset, cell)]);
+                UP_ASSERT_EQUAL((unsigned int)__scalar_as_int(h_vel.data[pid].w), cell);
+                }
+            std::sort(members.begin(), members.end());
+            std::sort(ref_members.begin(), ref_members.end());
+            UP_ASSERT(members == ref_members);
+            }
+        }
+
+    // without a request, the next streaming step invalidates the cell list as usual
+    stream->stream(1);
+    UP_ASSERT(!pdata->checkCellCache());
+    }
 #endif // ENABLE_HIP
@@ -11,7 +11,7 @@ from copy import copy
 import itertools
 
 from hoomd.trigger import Trigger
-from hoomd.logging import Loggable
+from hoomd.logging import Loggable, log
 from hoomd.data.parameterdicts import ParameterDict
 from hoomd.error import MutabilityError
 
@@ -243,6 +243,14 @@ class _HOOMDBaseObject(_HOOMDGetSetAttrBase,
         if self._simulation._system_communicator is not None:
             self._cpp_obj.setCommunicator(self._simulation._system_communicator)
 
+        # name the ranges of the object in external profiling tools
+        if hasattr(self._cpp_obj, "setProfileName"):
+            self._cpp_obj.setProfileName(self._profile_name)
+
+    @property
+    def _profile_name(self):
+        return type(self).__name__
+
     @property
     def _attached(self):
         return self._cpp_obj is not None
@@ -310,7 +318,44 @@ class _HOOMDBaseObject(_HOOMDGetSetAttrBase,
         return state
 
 
-class Operation(_HOOMDBaseObject):
+class _TimedOperation(metaclass=Loggable):
+    """Logs the time that the C++ object spends executing during a run.
+
+    The times are measured in C++ for each execution, with GPU events on GPU
+    devices, and reset at the start of each `hoomd.Simulation.run`.
+    """
+
+    @log(default=False, requires_run=True)
+    def time_per_step(self):
+        """float: Average time per step spent in this object in the current \
+        or last run :math:`[\\mathrm{s}]`.
+
+        The time of steps in which the object does not execute counts as zero,
+        so `time_per_step` is the cost of the object amortized over every step.
+        The time includes that of nested objects, such as the neighbor list of a
+        pair force or the forces of an integrator.
+        """
+        steps = (self._simulation.timestep
+                 - self._simulation._cpp_sys.start_timestep)
+        if steps == 0:
+            return 0.0
+        return self._cpp_obj.getRunTime() / steps
+
+    @log(default=False, requires_run=True)
+    def fraction_of_step(self):
+        """float: Fraction of the walltime of the current or last run spent \
+        in this object.
+
+        Like `time_per_step`, `fraction_of_step` includes the time of nested
+        objects, so the fractions of all objects may sum to more than 1.
+        """
+        walltime = self._simulation.walltime
+        if walltime == 0:
+            return 0.0
+        return self._cpp_obj.getRunTime() / walltime
+
+
+class Operation(_HOOMDBaseObject, _TimedOperation):
     """Represents operations that are added to an `hoomd.Operations` object.
 
     Operations in the HOOMD-blue data scheme are objects that *operate* on a
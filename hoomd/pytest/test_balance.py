@@ -34,6 +34,10 @@ def test_balance_properties():
     balance.max_iterations = 5
     assert balance.max_iterations == 5
 
+    assert balance.weight == 'particles'
+    balance.weight = 'time'
+    assert balance.weight == 'time'
+
 
 def test_attach_detach(simulation_factory, lattice_snapshot_factory):
     snapshot = lattice_snapshot_factory()
@@ -72,6 +76,10 @@ def test_attach_detach(simulation_factory, lattice_snapshot_factory):
     balance.max_iterations = 5
     assert balance.max_iterations == 5
 
+    assert balance.weight == 'particles'
+    balance.weight = 'time'
+    assert balance.weight == 'time'
+
     sim.operations.tuners.remove(balance)
 
 
@@ -111,3 +119,27 @@ def test_balance_action(device, simulation_factory, lattice_snapshot_factory):
 
     # the load balance should move the split place down toward the particles
     assert sim.state.domain_decomposition_split_fractions[2][0] < 0.5
+
+
+def test_balance_time_weight(device, simulation_factory,
+                             lattice_snapshot_factory):
+    """Test that balancing the measured time moves the domain boundary."""
+    if device.communicator.num_ranks != 2:
+        pytest.skip("Test supports only 2 ranks")
+
+    snapshot = lattice_snapshot_factory()
+
+    # place all particles in the lower MPI domain so that it takes more time
+    box = list(snapshot.configuration.box)
+    if snapshot.communicator.rank == 0:
+        snapshot.particles.position[:, 2] -= box[2] / 2
+    box[2] *= 2
+    snapshot.configuration.box = box
+    sim = simulation_factory(snapshot, domain_decomposition=(1, 1, 2))
+
+    balance = hoomd.tune.LoadBalancer(trigger=hoomd.trigger.Periodic(1),
+                                      weight='time')
+    sim.operations.tuners.append(balance)
+    sim.run(3)
+
+    assert sim.state.domain_decomposition_split_fractions[2][0] < 0.5
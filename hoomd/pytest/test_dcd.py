@@ -64,3 +64,29 @@ def test_mutability_error(simulation_factory, two_particle_snapshot_factory,
 
     with pytest.raises(MutabilityError):
         dcd_dump.overwrite = True
+
+
+def test_asynchronous(simulation_factory, two_particle_snapshot_factory,
+                      tmp_path):
+    sim = simulation_factory(two_particle_snapshot_factory())
+
+    filename_sync = tmp_path / "sync.dcd"
+    filename_async = tmp_path / "async.dcd"
+    trigger = hoomd.trigger.Periodic(1)
+    dcd_sync = hoomd.write.DCD(filename=filename_sync, trigger=trigger)
+    dcd_async = hoomd.write.DCD(filename=filename_async,
+                                trigger=trigger,
+                                asynchronous=True)
+    assert dcd_async.asynchronous
+    sim.operations.writers.extend([dcd_sync, dcd_async])
+    sim.run(10)
+    dcd_async.flush()
+
+    if sim.device.communicator.rank == 0:
+        data_sync = filename_sync.read_bytes()
+        data_async = filename_async.read_bytes()
+
+        # skip the creation time stamp in the header
+        assert len(data_sync) == len(data_async)
+        assert data_sync[:180] == data_async[:180]
+        assert data_sync[260:] == data_async[260:]
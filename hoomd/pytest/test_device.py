@@ -48,21 +48,25 @@ def test_common_properties(device, tmp_path):
                               num_cpu_threads=10)
 
 
-def _assert_gpu_properties(dev, mem_traceback, gpu_error_checking):
+def _assert_gpu_properties(dev, mem_traceback, gpu_error_checking,
+                           deterministic):
     """Assert properties specific to GPU objects are correct."""
     assert dev.memory_traceback == mem_traceback
     assert dev.gpu_error_checking == gpu_error_checking
+    assert dev.deterministic == deterministic
 
 
 @pytest.mark.gpu
 def test_gpu_specific_properties(device):
     # assert the defaults are right
-    _assert_gpu_properties(device, False, True)
+    _assert_gpu_properties(device, False, True, False)
 
     # make sure we can set the properties
     device.memory_traceback = True
     device.gpu_error_checking = False
-    _assert_gpu_properties(device, True, False)
+    device.deterministic = True
+    _assert_gpu_properties(device, True, False, True)
+    device.deterministic = False
 
     # make sure we can give a list of GPU ids to the constructor
     hoomd.device.GPU(gpu_ids=[0])
@@ -105,3 +109,135 @@ def test_cpu_build_specifics():
         pytest.skip("Don't run CPU-build specific tests when GPU is available")
     assert not hoomd.device.GPU.is_available()
     assert type(hoomd.device.auto_select()) == hoomd.device.CPU
+
+
+@pytest.mark.gpu
+@pytest.mark.serial
+def test_tuning_cache(simulation_factory, lattice_snapshot_factory, tmp_path):
+    sim = simulation_factory(lattice_snapshot_factory(n=10))
+    nlist = hoomd.md.nlist.Cell()
+    lj = hoomd.md.pair.LJ(nlist, default_r_cut=2.5)
+    lj.params[('A', 'A')] = dict(epsilon=1, sigma=1)
+    sim.operations.integrator = hoomd.md.Integrator(dt=0.005, forces=[lj])
+    sim.run(200)
+
+    filename = str(tmp_path / 'tuning.txt')
+    sim.device.save_tuning_cache(filename)
+    with open(filename) as f:
+        lines = f.readlines()
+    assert lines[0].startswith('# HOOMD-blue autotuner cache')
+
+    # round trip the cache through a new device
+    device = hoomd.device.GPU()
+    device.load_tuning_cache(filename)
+    filename2 = str(tmp_path / 'tuning2.txt')
+    device.save_tuning_cache(filename2)
+    with open(filename2) as f:
+        assert f.readlines() == lines
+
+    with pytest.raises(RuntimeError):
+        sim.device.load_tuning_cache(str(tmp_path / 'missing.txt'))
+
+
+def test_benchmark(simulation_factory, lattice_snapshot_factory, tmp_path):
+    sim = simulation_factory(lattice_snapshot_factory(n=10))
+    nlist = hoomd.md.nlist.Cell()
+    lj = hoomd.md.pair.LJ(nlist, default_r_cut=2.5)
+    lj.params[('A', 'A')] = dict(epsilon=1, sigma=1)
+    sim.operations.integrator = hoomd.md.Integrator(dt=0.005, forces=[lj])
+
+    filename = str(tmp_path / 'tuning.txt')
+    report = hoomd.tune.benchmark(sim, filename=filename, steps_per_check=50)
+    assert sim.timestep % 50 == 0
+
+    if isinstance(sim.device, hoomd.device.CPU):
+        assert report == []
+        return
+
+    assert len(report) > 0
+    for kernel in report:
+        assert kernel['parameter'] > 0
+        assert kernel['time'] >= 0
+
+    if sim.device.communicator.rank == 0:
+        with open(filename) as f:
+            assert len(f.readlines()) >= len(report) + 1
+
+    # the scans are complete, so a second benchmark stops at the first check
+    step = sim.timestep
+    hoomd.tune.benchmark(sim, steps_per_check=10)
+    assert sim.timestep == step + 10
+
+
+def test_memory_report(simulation_factory, lattice_snapshot_factory):
+    sim = simulation_factory(lattice_snapshot_factory(n=10))
+    lj = hoomd.md.pair.LJ(nlist=hoomd.md.nlist.Cell(), default_r_cut=2.5)
+    lj.params[('A', 'A')] = dict(epsilon=1, sigma=1)
+    sim.operations.integrator = hoomd.md.Integrator(dt=0.005, forces=[lj])
+    sim.run(0)
+
+    report = sim.device.memory_report()
+    assert all(nbytes >= 0 for nbytes in report.values())
+    assert any(tag.endswith('::m_nlist') and nbytes > 0
+               for tag, nbytes in report.items())
+    assert any(tag.endswith('::m_pos') and nbytes > 0
+               for tag, nbytes in report.items())
+
+    logger = hoomd.logging.Logger(categories=['object'])
+    logger.add(sim.device, quantities=['memory_report'])
+    value, category = logger.log()['device'][type(
+        sim.device).__name__]['memory_report']
+    assert category == 'object'
+    assert value.keys() == report.keys()
+
+
+@pytest.mark.gpu
+def test_transfer_report(simulation_factory, lattice_snapshot_factory):
+    sim = simulation_factory(lattice_snapshot_factory(n=10))
+    lj = hoomd.md.pair.LJ(nlist=hoomd.md.nlist.Cell(), default_r_cut=2.5)
+    lj.params[('A', 'A')] = dict(epsilon=1, sigma=1)
+    sim.operations.integrator = hoomd.md.Integrator(dt=0.005, forces=[lj])
+    sim.run(0)
+
+    assert not sim.device.transfer_tracing
+    sim.device.transfer_tracing = True
+    assert sim.device.transfer_tracing
+    assert sim.device.transfer_report() == {}
+
+    # reading the snapshot copies the particle data back to the host
+    sim.run(1)
+    sim.state.get_snapshot()
+    report = sim.device.transfer_report()
+    assert any(
+        'm_pos device->host' in key and count > 0 and nbytes > 0
+        for key, (count, nbytes) in report.items())
+
+    logger = hoomd.logging.Logger(categories=['object'])
+    logger.add(sim.device, quantities=['transfer_report'])
+    value, category = logger.log()['device'][type(
+        sim.device).__name__]['transfer_report']
+    assert category == 'object'
+    assert value.keys() == report.keys()
+
+    sim.device.transfer_tracing = False
+    assert sim.device.transfer_report() == {}
+
+
+def test_shrink_policy(simulation_factory, lattice_snapshot_factory):
+    sim = simulation_factory(lattice_snapshot_factory(n=10))
+    assert sim.device.shrink_fraction == 0
+    assert sim.device.shrink_delay == 100
+
+    with pytest.raises(ValueError):
+        sim.device.shrink_fraction = 1.5
+
+    sim.device.shrink_fraction = 0.25
+    sim.device.shrink_delay = 1
+    assert sim.device.shrink_fraction == 0.25
+    assert sim.device.shrink_delay == 1
+
+    lj = hoomd.md.pair.LJ(nlist=hoomd.md.nlist.Cell(), default_r_cut=2.5)
+    lj.params[('A', 'A')] = dict(epsilon=1, sigma=1)
+    sim.operations.integrator = hoomd.md.Integrator(dt=0.005, forces=[lj])
+    sim.run(2)
+    sim.device.shrink_fraction = 0
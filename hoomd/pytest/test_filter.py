@@ -1,9 +1,10 @@
 import pytest
 from hoomd.filter import (Type, Tags, SetDifference, Union, Intersection, All,
-                          Null, Rigid)
+                          Null, Region, Rigid)
 from hoomd.snapshot import Snapshot
 from copy import deepcopy
 from itertools import combinations
+import math
 import pickle
 import numpy as np
 
@@ -197,10 +198,31 @@ def test_difference(make_filter_snapshot, simulation_factory, set_indices):
         assert difference_filter(sim.state) == combo_filter(sim.state)
 
 
+@pytest.mark.serial
+def test_region_filter(make_filter_snapshot, simulation_factory):
+    N = 100
+    filter_snapshot = make_filter_snapshot(n=N, particle_types=['A'])
+    sim = simulation_factory(filter_snapshot)
+    lower = (-5, -math.inf, 0)
+    upper = (5, math.inf, math.inf)
+    region_filter = Region(lower=lower, upper=upper)
+
+    position = sim.state.get_snapshot().particles.position
+    inside = np.all((position >= lower) & (position < upper), axis=1)
+    expected = set(np.flatnonzero(inside))
+    assert set(region_filter(sim.state)) == expected
+
+    # the group built from the filter (on the GPU when possible) selects the
+    # same particles
+    group = sim.state._get_group(region_filter)
+    assert set(group.member_tags) == expected
+
+
 _filter_classes = [
     All,
     Tags,
     Type,
+    Region,
     Rigid,
     SetDifference,
     Union,
@@ -211,6 +233,7 @@ _constructor_args = [
     (),
     ([1, 2, 3],),
     ({'a', 'b'},),
+    ((-1, -2, -3), (1, 2, 3)),
     (('center', 'free'),),
     (Tags([1, 4, 5]), Type({'a'})),
     (Tags([1, 4, 5]), Type({'a'})),
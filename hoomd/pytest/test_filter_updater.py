@@ -10,7 +10,9 @@ def filter_list():
     return [
         hoomd.filter.All(),
         hoomd.filter.Tags([1, 2, 3]),
-        hoomd.filter.Type(["A"])
+        hoomd.filter.Type(["A"]),
+        hoomd.filter.Intersection(hoomd.filter.Type(["B"]),
+                                  hoomd.filter.Region(lower=(-100, -100, 0)))
     ]
 
 
@@ -19,12 +21,12 @@ def test_initialization_setting(filter_list):
     assert filter_updater.trigger == hoomd.trigger.Periodic(1)
     assert filter_updater.filters == []
     filter_updater.filters.extend(filter_list)
-    assert len(filter_updater.filters) == 3
+    assert len(filter_updater.filters) == len(filter_list)
     assert filter_list == filter_updater.filters
 
     filter_updater = hoomd.update.FilterUpdater(5, filter_list)
     assert filter_updater.trigger == hoomd.trigger.Periodic(5)
-    assert len(filter_updater.filters) == 3
+    assert len(filter_updater.filters) == len(filter_list)
     assert filter_list == filter_updater.filters
     filter_updater.trigger = hoomd.trigger.After(100)
     assert filter_updater.trigger == hoomd.trigger.After(100)
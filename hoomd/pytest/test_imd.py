@@ -0,0 +1,70 @@
+import hoomd
+import pytest
+import numpy as np
+import socket
+import struct
+
+IMD_FCOORDS = 2
+IMD_GO = 3
+IMD_HANDSHAKE = 4
+
+
+def _free_port():
+    with socket.socket(socket.AF_INET, socket.SOCK_STREAM) as s:
+        s.bind(('', 0))
+        return s.getsockname()[1]
+
+
+def _recv_exactly(sock, n):
+    data = b''
+    while len(data) < n:
+        chunk = sock.recv(n - len(data))
+        if not chunk:
+            raise ConnectionError("IMD server closed the connection")
+        data += chunk
+    return data
+
+
+def test_attach(simulation_factory, two_particle_snapshot_factory):
+    sim = simulation_factory(two_particle_snapshot_factory())
+    imd = hoomd.write.IMD(trigger=hoomd.trigger.Periodic(1), port=_free_port())
+    assert not imd.connected
+    sim.operations.add(imd)
+    sim.run(10)
+
+    # nothing is sent without a client
+    assert not imd.connected
+    assert imd.frames_sent == 0
+    assert imd.frames_dropped == 0
+
+
+def test_send(simulation_factory, two_particle_snapshot_factory):
+    sim = simulation_factory(two_particle_snapshot_factory())
+    if sim.device.communicator.num_ranks > 1:
+        pytest.skip("The client test runs on a single rank")
+
+    port = _free_port()
+    imd = hoomd.write.IMD(trigger=hoomd.trigger.Periodic(1), port=port)
+    sim.operations.add(imd)
+    sim.run(0)
+
+    with socket.create_connection(('localhost', port), timeout=10) as client:
+        # the server waits for IMD_GO after the handshake
+        client.sendall(struct.pack('!ii', IMD_GO, 0))
+        sim.run(5)
+        assert imd.connected
+
+        msg_type, _ = struct.unpack('!ii', _recv_exactly(client, 8))
+        assert msg_type == IMD_HANDSHAKE
+
+        msg_type, n = struct.unpack('!ii', _recv_exactly(client, 8))
+        assert msg_type == IMD_FCOORDS
+        assert n == 2
+        coords = np.frombuffer(_recv_exactly(client, 12 * n), dtype=np.float32)
+
+        snap = sim.state.get_snapshot()
+        np.testing.assert_allclose(coords.reshape(n, 3),
+                                   snap.particles.position,
+                                   rtol=1e-6)
+
+    assert imd.frames_sent + imd.frames_dropped >= 1
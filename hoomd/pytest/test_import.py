@@ -0,0 +1,45 @@
+# Copyright (c) 2009-2021 The Regents of the University of Michigan
+# This file is part of the HOOMD-blue project, released under the BSD 3-Clause
+# License.
+
+"""Test that the component packages are imported on first access."""
+import subprocess
+import sys
+
+import pytest
+
+import hoomd
+
+# The test runs in a new interpreter, pytest and conftest.py have already
+# imported the components in this one.
+_script = """
+import sys
+import hoomd
+
+for name in hoomd._components:
+    assert 'hoomd.' + name not in sys.modules, name
+
+for name in hoomd._components:
+    assert name in dir(hoomd), name
+    module = getattr(hoomd, name)
+    assert sys.modules['hoomd.' + name] is module, name
+"""
+
+
+@pytest.mark.serial
+@pytest.mark.skipif(sys.version_info < (3, 7),
+                    reason="Python 3.6 imports the components eagerly")
+def test_lazy_components(device):
+    if len(hoomd._components) == 0:
+        pytest.skip("No component packages are built")
+
+    result = subprocess.run([sys.executable, '-c', _script],
+                            stdout=subprocess.PIPE,
+                            stderr=subprocess.STDOUT,
+                            universal_newlines=True)
+    assert result.returncode == 0, result.stdout
+
+
+def test_missing_attribute():
+    with pytest.raises(AttributeError):
+        hoomd.not_a_component
@@ -6,7 +6,7 @@
 
 from copy import deepcopy
 import hoomd
-from hoomd.data.array import HOOMDGPUArray
+from hoomd.data.array import HOOMDGPUArray, HOOMDArrayError
 import numpy as np
 import pytest
 try:
@@ -504,6 +504,30 @@ class TestLocalSnapshots:
                 with pytest.raises(RuntimeError):
                     sim.state.set_snapshot(base_snapshot)
 
+    @pytest.mark.cupy_optional
+    def test_dlpack(self, base_simulation):
+        sim = base_simulation()
+        for lcl_snapshot_attr in self.get_snapshot_attr(sim):
+            with getattr(sim.state, lcl_snapshot_attr) as data:
+                position = data.particles.position
+                if isinstance(position, HOOMDGPUArray):
+                    if not CUPY_IMPORTED or not hasattr(cupy, 'from_dlpack'):
+                        continue
+                    view = cupy.from_dlpack(position)
+                    expected = cupy.array(position, copy=True)
+                else:
+                    if not hasattr(np, 'from_dlpack'):
+                        continue
+                    view = np.from_dlpack(position)
+                    expected = np.array(position, copy=True)
+                assert view.shape == position.shape
+                assert (view == expected).all()
+
+                with pytest.raises(BufferError):
+                    data.particles.ghost_position.__dlpack__()
+            with pytest.raises(HOOMDArrayError):
+                position.__dlpack__()
+
     @pytest.fixture
     def base_simulation(self, simulation_factory, base_snapshot):
         """Creates the simulation from the base_snapshot."""
@@ -120,6 +120,76 @@ def test_tps(simulation_factory, lattice_snapshot_factory):
     assert sim.tps > 0
 
 
+def test_profiling(simulation_factory, lattice_snapshot_factory, tmp_path):
+    sim = simulation_factory()
+    assert not sim.profiling
+    assert sim.profile is None
+    sim.profiling = True
+
+    sim.create_state_from_snapshot(lattice_snapshot_factory())
+    sim.operations.writers.append(
+        hoomd.write.GSD(filename=str(tmp_path / 'profile.gsd'),
+                        trigger=hoomd.trigger.Periodic(10),
+                        mode='wb'))
+    sim.run(20)
+
+    profile = sim.profile
+    assert profile['total'] > 0
+    assert profile['Dump GSD']['calls'] == 2
+    assert profile['Dump GSD']['time'] <= profile['total']
+
+    filename = str(tmp_path / 'trace.json')
+    sim.write_profile_trace(filename)
+    if sim.device.communicator.rank == 0:
+        import json
+        with open(filename) as f:
+            trace = json.load(f)
+        events = [e for e in trace['traceEvents'] if e['name'] == 'Dump GSD']
+        assert len(events) == 2
+        assert all(e['ph'] == 'X' for e in events)
+
+    sim.profiling = False
+    sim.run(1)
+    assert sim.profile is None
+
+
+def test_profile_names(simulation_factory, lattice_snapshot_factory, tmp_path):
+
+    class DoNothing(hoomd.custom.Action):
+
+        def act(self, timestep):
+            pass
+
+    sim = simulation_factory(lattice_snapshot_factory())
+    gsd = hoomd.write.GSD(filename=str(tmp_path / 'names.gsd'),
+                          trigger=hoomd.trigger.Periodic(10),
+                          mode='wb')
+    custom = hoomd.write.CustomWriter(action=DoNothing(),
+                                      trigger=hoomd.trigger.Periodic(1))
+    sim.operations.writers.extend([gsd, custom])
+    sim.run(0)
+
+    assert gsd._cpp_obj.getProfileName() == 'GSD'
+    assert custom._cpp_obj.getProfileName() == 'DoNothing'
+
+
+def test_operation_timing(simulation_factory, lattice_snapshot_factory,
+                          tmp_path):
+    sim = simulation_factory(lattice_snapshot_factory())
+    gsd = hoomd.write.GSD(filename=str(tmp_path / 'timing.gsd'),
+                          trigger=hoomd.trigger.Periodic(1),
+                          mode='wb')
+    sim.operations.writers.append(gsd)
+
+    assert 'time_per_step' in gsd.loggables
+    assert 'fraction_of_step' in gsd.loggables
+
+    sim.run(10)
+    assert gsd.time_per_step > 0
+    assert 0 < gsd.fraction_of_step <= 1
+    assert gsd.time_per_step * 10 == pytest.approx(gsd._cpp_obj.getRunTime())
+
+
 def test_timestep(simulation_factory, lattice_snapshot_factory):
     sim = simulation_factory()
     assert sim.timestep is None
@@ -198,6 +268,25 @@ def test_state_from_gsd(device, simulation_factory, lattice_snapshot_factory,
         assert_equivalent_snapshots(snap, sim.state.get_snapshot())
 
 
+@skip_gsd
+def test_state_from_gsd_parallel(device, simulation_factory,
+                                 lattice_snapshot_factory, tmp_path):
+    sim = simulation_factory(
+        lattice_snapshot_factory(n=10, particle_types=['A', 'B']))
+    snap = update_positions(sim.state.get_snapshot())
+    set_types(snap, random_inds(10), ['A', 'B'], 'B')
+
+    filename = tmp_path / "temporary_test_file.gsd"
+    if device.communicator.rank == 0:
+        with gsd.hoomd.open(name=filename, mode='wb') as f:
+            f.append(make_gsd_snapshot(snap))
+    device.communicator.barrier()
+
+    sim = simulation_factory()
+    sim.create_state_from_gsd(filename, parallel=True)
+    assert_equivalent_snapshots(snap, sim.state.get_snapshot())
+
+
 @skip_gsd
 def test_state_from_gsd_snapshot(simulation_factory, lattice_snapshot_factory,
                                  device, state_args, tmp_path):
@@ -2,6 +2,8 @@
 
 from hoomd.conftest import operation_pickling_check
 import hoomd
+import numpy
+import pytest
 
 
 def test_attributes():
@@ -11,6 +13,17 @@ def test_attributes():
 
     assert sorter.trigger is trigger
     assert sorter.grid == 32
+    assert sorter.curve == 'hilbert'
+    assert sorter.threshold == 0.0
+    assert not sorter.low_memory
+
+    sorter.curve = 'morton'
+    sorter.threshold = 0.1
+    assert sorter.curve == 'morton'
+    assert sorter.threshold == 0.1
+
+    with pytest.raises(ValueError):
+        sorter.curve = 'peano'
 
 
 def test_attributes_attached(simulation_factory, two_particle_snapshot_factory):
@@ -25,6 +38,38 @@ def test_attributes_attached(simulation_factory, two_particle_snapshot_factory):
     assert sorter.trigger is trigger
     assert sorter.grid == 32
 
+    sorter.curve = 'cell'
+    sorter.threshold = 0.25
+    assert sorter.curve == 'cell'
+    assert sorter.threshold == 0.25
+
+
+@pytest.mark.parametrize("curve", ['hilbert', 'morton', 'cell'])
+@pytest.mark.parametrize("threshold", [0.0, 0.5])
+@pytest.mark.parametrize("low_memory", [False, True])
+def test_sort(simulation_factory, lattice_snapshot_factory, curve, threshold,
+              low_memory):
+    """Test that sorting along each curve preserves the particles."""
+    snap = lattice_snapshot_factory(n=8, a=1.5)
+    if snap.communicator.rank == 0:
+        # reverse the particle order so that there is something to sort
+        snap.particles.position[:] = snap.particles.position[::-1]
+
+    sim = simulation_factory(snap)
+    sim.operations.tuners.clear()
+    sorter = hoomd.tune.ParticleSorter(trigger=hoomd.trigger.Periodic(1),
+                                       grid=16,
+                                       curve=curve,
+                                       threshold=threshold,
+                                       low_memory=low_memory)
+    sim.operations.tuners.append(sorter)
+    sim.run(2)
+
+    s = sim.state.get_snapshot()
+    if s.communicator.rank == 0:
+        numpy.testing.assert_allclose(s.particles.position,
+                                      snap.particles.position)
+
 
 def test_default_sorter(simulation_factory, two_particle_snapshot_factory):
     """Test that the default Simulation includes a ParticleSorter."""
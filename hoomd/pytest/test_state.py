@@ -173,6 +173,32 @@ def test_modify_snapshot(simulation_factory, snap):
     assert_snapshots_equal(snap, snap2)
 
 
+def test_set_modified_snapshot(simulation_factory, snap):
+    sim = simulation_factory(snap)
+
+    # only the accessed arrays of a snapshot from get_snapshot are applied
+    snap2 = sim.state.get_snapshot()
+    if snap2.communicator.rank == 0:
+        snap2.particles.typeid[::2] = 1
+        snap2.particles.velocity[:] = [1, 2, 3]
+        snap2.bonds.typeid[:] = 2
+    sim.state.set_snapshot(snap2)
+    assert_snapshots_equal(snap2, sim.state.get_snapshot())
+
+    snap3 = sim.state.get_snapshot()
+    if snap3.communicator.rank == 0:
+        snap3.particles.position[:] *= 0.9
+    sim.state.set_snapshot(snap3)
+    assert_snapshots_equal(snap3, sim.state.get_snapshot())
+
+    # snapshots taken before the state changed reset every array
+    snap4 = sim.state.get_snapshot()
+    with sim.state.cpu_local_snapshot as data:
+        data.particles.velocity[:] = 0
+    sim.state.set_snapshot(snap4)
+    assert_snapshots_equal(snap4, sim.state.get_snapshot())
+
+
 def test_thermalize_particle_velocity(simulation_factory,
                                       lattice_snapshot_factory):
     snap = lattice_snapshot_factory()
@@ -243,6 +269,26 @@ def test_replicate(simulation_factory, lattice_snapshot_factory):
     assert_snapshots_equal(initial_snapshot, new_snapshot)
 
 
+def test_replicate_bonds(simulation_factory, lattice_snapshot_factory):
+    initial_snapshot = lattice_snapshot_factory(a=2, n=2)
+    if initial_snapshot.communicator.rank == 0:
+        initial_snapshot.bonds.types = ['A-A']
+        initial_snapshot.bonds.N = 2
+        initial_snapshot.bonds.group[:] = [[0, 1], [2, 3]]
+
+    sim = simulation_factory(initial_snapshot)
+
+    initial_snapshot.replicate(3, 2, 1)
+    if initial_snapshot.communicator.rank == 0:
+        assert initial_snapshot.bonds.N == 12
+        numpy.testing.assert_equal(initial_snapshot.bonds.group[2:4],
+                                   [[8, 9], [10, 11]])
+
+    sim.state.replicate(3, 2, 1)
+    new_snapshot = sim.state.get_snapshot()
+    assert_snapshots_equal(initial_snapshot, new_snapshot)
+
+
 def test_domain_decomposition(device, simulation_factory,
                               lattice_snapshot_factory):
     snapshot = lattice_snapshot_factory()
@@ -280,3 +326,46 @@ def test_domain_decomposition(device, simulation_factory,
                                                                   [0.25])
     else:
         raise RuntimeError("Test only supports 1 and 2 ranks")
+
+
+def test_balance_domains(device, lattice_snapshot_factory):
+    if device.communicator.num_ranks != 2:
+        pytest.skip("Test supports only 2 ranks")
+
+    snapshot = lattice_snapshot_factory()
+
+    # place all particles in the lower half of the box
+    box = list(snapshot.configuration.box)
+    if snapshot.communicator.rank == 0:
+        snapshot.particles.position[:, 2] -= box[2] / 2
+    box[2] *= 2
+    snapshot.configuration.box = box
+
+    sim = hoomd.Simulation(device)
+    sim.create_state_from_snapshot(snapshot,
+                                   domain_decomposition=(1, 1, 2),
+                                   balance_domains=True)
+    split = sim.state.domain_decomposition_split_fractions[2][0]
+    assert 0.125 <= split < 0.5
+
+    with pytest.raises(ValueError):
+        sim = hoomd.Simulation(device)
+        sim.create_state_from_snapshot(snapshot,
+                                       domain_decomposition=(None, None,
+                                                             [0.25, 0.75]),
+                                       balance_domains=True)
+
+
+def test_group_domains_by_node(device, lattice_snapshot_factory):
+    snapshot = lattice_snapshot_factory()
+
+    sim = hoomd.Simulation(device)
+    sim.create_state_from_snapshot(snapshot, group_domains_by_node=True)
+    assert numpy.prod(
+        sim.state.domain_decomposition) == device.communicator.num_ranks
+
+    with pytest.raises(ValueError):
+        sim = hoomd.Simulation(device)
+        sim.create_state_from_snapshot(snapshot,
+                                       domain_decomposition=(1, 1, None),
+                                       group_domains_by_node=True)
@@ -137,3 +137,41 @@ def test_custom():
     # test that the custom trigger can be called from c++
     assert hoomd._hoomd._test_trigger_call(c, 0)
     assert not hoomd._hoomd._test_trigger_call(c, 250000000001)
+
+
+@pytest.mark.parametrize('trigger', [
+    hoomd.trigger.Periodic(456, 18),
+    hoomd.trigger.Periodic(7, 3),
+    hoomd.trigger.Periodic(10),
+    hoomd.trigger.Before(100),
+    hoomd.trigger.After(100),
+    hoomd.trigger.On(100),
+    hoomd.trigger.Or([hoomd.trigger.Periodic(10, 1),
+                      hoomd.trigger.On(55)]),
+],
+                         ids=_test_name)
+def test_next_trigger(trigger):
+    never = 2**64 - 1
+    for start in itertools.chain(range(0, 1000, 7),
+                                 range(10000000000, 10000001000, 7)):
+        expected = next((step for step in range(start, start + 1000)
+                         if trigger(step)), None)
+        next_step = hoomd._hoomd._test_next_trigger(trigger, start)
+        if expected is None:
+            assert next_step >= start + 1000
+        else:
+            assert next_step == expected
+        assert next_step == never or trigger(next_step)
+
+
+def test_next_trigger_unscheduled():
+    # these triggers are evaluated on every step
+    assert hoomd._hoomd._test_next_trigger(CustomTrigger(), 0) is None
+    assert hoomd._hoomd._test_next_trigger(
+        hoomd.trigger.Not(hoomd.trigger.Periodic(10)), 0) is None
+    assert hoomd._hoomd._test_next_trigger(
+        hoomd.trigger.And([hoomd.trigger.Periodic(10),
+                           hoomd.trigger.Before(100)]), 0) is None
+    assert hoomd._hoomd._test_next_trigger(
+        hoomd.trigger.Or([hoomd.trigger.Periodic(10),
+                          CustomTrigger()]), 0) is None
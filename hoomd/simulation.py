@@ -39,6 +39,7 @@ class Simulation(metaclass=Loggable):
         self._operations._simulation = self
         self._timestep = None
         self._seed = seed
+        self._profiling = False
 
     @property
     def device(self):
@@ -121,6 +122,8 @@ class Simulation(metaclass=Loggable):
         if self._seed is not None:
             self._state._cpp_sys_def.setSeed(self._seed)
 
+        self._cpp_sys.enableProfiler(self._profiling)
+
         self._init_communicator()
 
     def _init_communicator(self):
@@ -154,7 +157,10 @@ class Simulation(metaclass=Loggable):
     def create_state_from_gsd(self,
                               filename,
                               frame=-1,
-                              domain_decomposition=(None, None, None)):
+                              domain_decomposition=(None, None, None),
+                              parallel=False,
+                              balance_domains=False,
+                              group_domains_by_node=False):
         """Create the simulation state from a GSD file.
 
         Args:
@@ -171,6 +177,22 @@ class Simulation(metaclass=Loggable):
                 to include in each domain. The sum of each list of floats must
                 be 1.0 (e.g. ``([0.25, 0.75], [0.2, 0.8], [1.0])``).
 
+            parallel (bool): When `True` in MPI simulations, every rank reads
+                a slice of the particles from the file and sends them directly
+                to their domains. When `False`, the root rank reads all
+                particles and distributes them.
+
+            balance_domains (bool): When `True` in MPI simulations, place the
+                domain boundaries so that every domain initially holds
+                approximately the same number of particles. Not compatible
+                with explicit rank fractions in ``domain_decomposition``.
+
+            group_domains_by_node (bool): When `True` in MPI simulations, map
+                the domains of ranks that share a node onto a contiguous block
+                of the domain grid so that most ghost exchanges stay within
+                the node. Requires the same number of ranks on every node and
+                an automatically selected ``domain_decomposition``.
+
         Note:
             Set any or all of the ``domain_decomposition`` tuple elements to
             `None` and `create_state_from_gsd` will select a value that
@@ -179,18 +201,24 @@ class Simulation(metaclass=Loggable):
             automatically selected direction. The default value of ``(None,
             None, None)`` will automatically select the number of domains in all
             directions.
+
+        Note:
+            With ``parallel=True``, every MPI rank opens the file. The file must
+            be accessible from all ranks, such as on a shared file system.
+            Bonds and other topology are still read on the root rank.
         """
         if self._state is not None:
             raise RuntimeError("Cannot initialize more than once\n")
         filename = _hoomd.mpi_bcast_str(filename, self.device._cpp_exec_conf)
         # Grab snapshot and timestep
         reader = _hoomd.GSDReader(self.device._cpp_exec_conf, filename,
-                                  abs(frame), frame < 0)
+                                  abs(frame), frame < 0, parallel)
         snapshot = Snapshot._from_cpp_snapshot(reader.getSnapshot(),
                                                self.device.communicator)
 
         step = reader.getTimeStep() if self.timestep is None else self.timestep
-        self._state = State(self, snapshot, domain_decomposition)
+        self._state = State(self, snapshot, domain_decomposition,
+                            balance_domains, group_domains_by_node)
 
         reader.clearSnapshot()
 
@@ -198,7 +226,9 @@ class Simulation(metaclass=Loggable):
 
     def create_state_from_snapshot(self,
                                    snapshot,
-                                   domain_decomposition=(None, None, None)):
+                                   domain_decomposition=(None, None, None),
+                                   balance_domains=False,
+                                   group_domains_by_node=False):
         """Create the simulation state from a `Snapshot`.
 
         Args:
@@ -214,6 +244,17 @@ class Simulation(metaclass=Loggable):
                 to include in each domain. The sum of each list of floats must
                 be 1.0 (e.g. ``([0.25, 0.75], [0.2, 0.8], [1.0])``).
 
+            balance_domains (bool): When `True` in MPI simulations, place the
+                domain boundaries so that every domain initially holds
+                approximately the same number of particles. Not compatible
+                with explicit rank fractions in ``domain_decomposition``.
+
+            group_domains_by_node (bool): When `True` in MPI simulations, map
+                the domains of ranks that share a node onto a contiguous block
+                of the domain grid so that most ghost exchanges stay within
+                the node. Requires the same number of ranks on every node and
+                an automatically selected ``domain_decomposition``.
+
         When `timestep` is `None` before calling, `create_state_from_snapshot`
         sets `timestep` to 0.
 
@@ -236,12 +277,14 @@ class Simulation(metaclass=Loggable):
 
         if isinstance(snapshot, Snapshot):
             # snapshot is hoomd.Snapshot
-            self._state = State(self, snapshot, domain_decomposition)
+            self._state = State(self, snapshot, domain_decomposition,
+                                balance_domains, group_domains_by_node)
         elif _match_class_path(snapshot, 'gsd.hoomd.Snapshot'):
             # snapshot is gsd.hoomd.Snapshot
             snapshot = Snapshot.from_gsd_snapshot(snapshot,
                                                   self._device.communicator)
-            self._state = State(self, snapshot, domain_decomposition)
+            self._state = State(self, snapshot, domain_decomposition,
+                                balance_domains, group_domains_by_node)
         else:
             raise TypeError(
                 "Snapshot must be a hoomd.Snapshot or gsd.hoomd.Snapshot.")
@@ -332,6 +375,70 @@ class Simulation(metaclass=Loggable):
         else:
             return self._cpp_sys.final_timestep
 
+    @property
+    def profiling(self):
+        """bool: Time operations during `run` (defaults to ``False``).
+
+        When `True`, each call to `run` records the time spent in each
+        operation and its sub-steps. Access the accumulated times with
+        `profile` and write a timeline with `write_profile_trace`.
+
+        Note:
+            Profiling synchronizes the GPU at the start and end of every
+            profiled region, which reduces performance on GPU devices.
+        """
+        return self._profiling
+
+    @profiling.setter
+    def profiling(self, value):
+        self._profiling = bool(value)
+        if hasattr(self, '_cpp_sys'):
+            self._cpp_sys.enableProfiler(self._profiling)
+
+    @log(category='object', requires_run=True)
+    def profile(self):
+        """dict: Time spent in each profiled region during the last `run`.
+
+        `profile` maps the ``/`` separated path of each region (for example,
+        ``'Integrate/Neighbor'``) to a `dict` with the total time in seconds
+        (``'time'``), the time not spent in nested regions (``'self_time'``),
+        and the number of times the region executed (``'calls'``). The key
+        ``'total'`` holds the walltime of the whole `run` in seconds.
+
+        `profile` is `None` when `profiling` was `False` during the last
+        `run`. Each MPI rank reports its own times.
+        """
+        if not hasattr(self, '_cpp_sys'):
+            return None
+
+        profiler = self._cpp_sys.getProfiler()
+        if profiler is None:
+            return None
+        return profiler.getStats()
+
+    def write_profile_trace(self, filename):
+        """Write the profile of the last `run` as a Chrome trace.
+
+        Args:
+            filename (str): Name of the file to write.
+
+        The file is in the Chrome trace event JSON format, which
+        ``chrome://tracing`` and https://ui.perfetto.dev display as a timeline
+        of every profiled region. The trace holds at most 1048576 regions, later
+        regions are counted in `profile` but not recorded to the trace.
+
+        Only the root MPI rank writes the trace.
+        """
+        if not hasattr(self, '_cpp_sys'):
+            raise RuntimeError('Cannot write a profile trace without state')
+
+        profiler = self._cpp_sys.getProfiler()
+        if profiler is None:
+            raise RuntimeError('Set profiling to True before calling run')
+
+        if self.device.communicator.rank == 0:
+            profiler.writeChromeTrace(filename, 0)
+
     @property
     def always_compute_pressure(self):
         """bool: Always compute the virial and pressure (defaults to ``False``).
@@ -417,6 +524,11 @@ class Simulation(metaclass=Loggable):
         Warning:
             Using ``write_at_start=True`` in subsequent
             calls to `run` will result in duplicate output frames.
+
+        Tip:
+            Set `hoomd.device.GPU.transfer_tracing` to `True` to print the
+            implicit host/device copies of arrays made during the run when it
+            completes.
         """
         # check if initialization has occurred
         if not hasattr(self, '_cpp_sys'):
@@ -432,8 +544,41 @@ class Simulation(metaclass=Loggable):
             raise ValueError(f"steps must be in the range [0, "
                              f"{TIMESTEP_MAX-1}]")
 
+        trace_transfers = (isinstance(self.device, hoomd.device.GPU)
+                           and self.device.transfer_tracing)
+        if trace_transfers:
+            transfers_before = self.device.transfer_report()
+
         self._cpp_sys.run(steps_int, write_at_start)
 
+        if trace_transfers:
+            self._report_transfers(transfers_before, steps_int)
+
+    def _report_transfers(self, transfers_before, steps):
+        """Print the host/device copies made since ``transfers_before``."""
+        transfers = []
+        for key, (count, nbytes) in self.device.transfer_report().items():
+            count_before, nbytes_before = transfers_before.get(key, (0, 0))
+            if count > count_before:
+                transfers.append(
+                    (nbytes - nbytes_before, count - count_before, key))
+
+        msg = self.device._cpp_msg
+        if len(transfers) == 0:
+            msg.notice(2, "No implicit host/device copies during the run.\n")
+            return
+
+        transfers.sort(reverse=True)
+        total = sum(nbytes for nbytes, _, _ in transfers)
+        msg.notice(
+            2, f"Implicit host/device copies during the run: "
+            f"{total / 2**20:.3f} MiB in {steps} steps\n")
+        for nbytes, count, key in transfers:
+            per_step = f", {count / steps:.2f} per step" if steps > 0 else ""
+            msg.notice(
+                2, f"** {key}: {count} copies{per_step}, "
+                f"{nbytes / 2**20:.3f} MiB\n")
+
 
 def _match_class_path(obj, *matches):
     return any(cls.__module__ + '.' + cls.__name__ in matches
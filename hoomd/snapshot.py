@@ -77,6 +77,9 @@ class Snapshot:
 
         self._cpp_obj = _hoomd.SnapshotSystemData_double()
 
+        # the state and version of the state that the snapshot was taken from
+        self._origin = None
+
     @property
     def configuration(self):
         """Snapshot box configuration.
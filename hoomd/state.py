@@ -15,7 +15,11 @@ import math
 import collections.abc
 
 
-def _create_domain_decomposition(device, box, domain_decomposition):
+def _create_domain_decomposition(device,
+                                 box,
+                                 domain_decomposition,
+                                 balance_domains=False,
+                                 group_domains_by_node=False):
     """Create the domain decomposition.
 
     Args:
@@ -23,6 +27,10 @@ def _create_domain_decomposition(device, box, domain_decomposition):
         box: The C++ global box object for the state being initialized
         domain_decomposition: See Simulation.create_state_from_* for a
           description.
+        balance_domains (bool): See Simulation.create_state_from_* for a
+          description.
+        group_domains_by_node (bool): See Simulation.create_state_from_* for
+          a description.
     """
     if (not isinstance(domain_decomposition, collections.abc.Sequence)
             or len(domain_decomposition) != 3):
@@ -45,6 +53,13 @@ def _create_domain_decomposition(device, box, domain_decomposition):
     if initialize_grid and initialize_fractions:
         raise ValueError("Domain decomposition mixes integers and sequences.")
 
+    if balance_domains and initialize_fractions:
+        raise ValueError("Cannot balance domains with given rank fractions.")
+
+    if group_domains_by_node and (initialize_grid or initialize_fractions):
+        raise ValueError("Cannot group domains by node with a given domain "
+                         "decomposition.")
+
     if not hoomd.version.mpi_enabled:
         return None
 
@@ -62,7 +77,7 @@ def _create_domain_decomposition(device, box, domain_decomposition):
     else:
         grid = [v if v is not None else 0 for v in domain_decomposition]
         result = _hoomd.DomainDecomposition(device._cpp_exec_conf, box.getL(),
-                                            *grid, False)
+                                            *grid, group_domains_by_node)
 
     return result
 
@@ -220,12 +235,20 @@ class State:
     .. _Kamberaj 2005: http://dx.doi.org/10.1063/1.1906216
     """
 
-    def __init__(self, simulation, snapshot, domain_decomposition):
+    def __init__(self,
+                 simulation,
+                 snapshot,
+                 domain_decomposition,
+                 balance_domains=False,
+                 group_domains_by_node=False):
         self._simulation = simulation
         snapshot._broadcast_box()
         decomposition = _create_domain_decomposition(
             simulation.device, snapshot._cpp_obj._global_box,
-            domain_decomposition)
+            domain_decomposition, balance_domains, group_domains_by_node)
+
+        if decomposition is not None and balance_domains:
+            decomposition.balanceFractions(snapshot._cpp_obj)
 
         if decomposition is not None:
             self._cpp_sys_def = _hoomd.SystemDefinition(
@@ -239,6 +262,10 @@ class State:
         # snapshots are not contexted at once.
         self._in_context_manager = False
 
+        # Incremented when a method of State changes the state. set_snapshot
+        # uses it to detect snapshots that still match the state.
+        self._version = 0
+
         # self._groups provides a cache of C++ group objects of the form:
         # {type(filter): {filter: C++ group}}
         # The first layer is to prevent user created filters with poorly
@@ -272,8 +299,14 @@ class State:
             hoomd.Snapshot: The current simulation state
         """
         cpp_snapshot = self._cpp_sys_def.takeSnapshot_double()
-        return Snapshot._from_cpp_snapshot(cpp_snapshot,
-                                           self._simulation.device.communicator)
+        snapshot = Snapshot._from_cpp_snapshot(
+            cpp_snapshot, self._simulation.device.communicator)
+        snapshot._origin = self._snapshot_origin()
+        return snapshot
+
+    def _snapshot_origin(self):
+        """Identify the current state for snapshots taken from it."""
+        return (self, self._simulation.timestep, self._version)
 
     def set_snapshot(self, snapshot):
         """Restore the state of the simulation from a snapshot.
@@ -293,6 +326,14 @@ class State:
             N_{bonds} + \\ldots)` operation and is very expensive when the
             simulation device is a GPU.
 
+        Note:
+            When *snapshot* comes from `get_snapshot` and the state has not
+            changed since, `set_snapshot` applies only the particle arrays and
+            bonded groups accessed in *snapshot* and keeps the particles on
+            their current MPI ranks. Changing the box, the number of particles,
+            or (in MPI simulations) the positions, images, or bodies resets the
+            entire state.
+
         See Also:
             `get_snapshot`
 
@@ -315,7 +356,11 @@ class State:
             if snapshot.pairs.types != self.special_pair_types:
                 raise RuntimeError("Pair types must remain the same")
 
-        self._cpp_sys_def.initializeFromSnapshot(snapshot._cpp_obj)
+        if snapshot._origin == self._snapshot_origin():
+            self._cpp_sys_def.updateFromSnapshot(snapshot._cpp_obj)
+        else:
+            self._cpp_sys_def.initializeFromSnapshot(snapshot._cpp_obj)
+        self._version += 1
 
     @property
     def particle_types(self):
@@ -437,6 +482,7 @@ class State:
                 "".format(self._cpp_sys_def.getNDimensions(), box.dimensions))
             self._cpp_sys_def.setNDimensions(box.dimensions)
         self._cpp_sys_def.getParticleData().setGlobalBox(box._cpp_obj)
+        self._version += 1
 
     def replicate(self, nx, ny, nz=1):
         """Replicate the state of the system along the periodic box directions.
@@ -457,10 +503,17 @@ class State:
         factor of ``nx``, ``ny``, and ``nz`` in the direction of the first,
         second, and third box lattice vectors respectively and adjusts the
         particle positions to center them in the new box.
+
+        Note:
+            In MPI simulations, each rank creates only its share of the
+            replicated particles and bonded groups. Only the initial state is
+            gathered on the root rank.
         """
-        snap = self.get_snapshot()
-        snap.replicate(nx, ny, nz)
-        self.set_snapshot(snap)
+        if self._in_context_manager:
+            raise RuntimeError(
+                "Cannot replicate the state inside local snapshot.")
+        self._cpp_sys_def.replicate(nx, ny, nz)
+        self._version += 1
 
     def _get_group(self, filter_):
         cls = filter_.__class__
@@ -536,11 +589,19 @@ class State:
         Note:
             Getting a local snapshot object is order :math:`O(1)` and setting a
             single value is of order :math:`O(1)`.
+
+        Note:
+            Computes are not notified of changes made through a local
+            snapshot, so reading one has no cost. Forces already computed at
+            the current step are not updated until the next step. Use
+            `State.set_snapshot` to modify particles so that the forces are
+            recomputed at the current step.
         """
         if self._in_context_manager:
             raise RuntimeError(
                 "Cannot enter cpu_local_snapshot context manager inside "
                 "another local_snapshot context manager.")
+        self._version += 1
         return LocalSnapshot(self)
 
     @property
@@ -581,6 +642,13 @@ class State:
         Note:
             Getting a local snapshot object is order :math:`O(1)` and setting a
             single value is of order :math:`O(1)`.
+
+        Note:
+            Computes are not notified of changes made through a local
+            snapshot, so reading one has no cost. Forces already computed at
+            the current step are not updated until the next step. Use
+            `State.set_snapshot` to modify particles so that the forces are
+            recomputed at the current step.
         """
         if not isinstance(self._simulation.device, hoomd.device.GPU):
             raise RuntimeError(
@@ -590,6 +658,7 @@ class State:
                 "Cannot enter gpu_local_snapshot context manager inside "
                 "another local_snapshot context manager.")
         else:
+            self._version += 1
             return LocalSnapshotGPU(self)
 
     def thermalize_particle_momenta(self, filter, kT):
@@ -626,6 +695,7 @@ class State:
         self._simulation._warn_if_seed_unset()
         group = self._get_group(filter)
         group.thermalizeParticleMomenta(kT, self._simulation.timestep)
+        self._version += 1
 
     @property
     def domain_decomposition_split_fractions(self):
@@ -218,6 +218,28 @@ void check_range(GeneratorType& gen, const unsigned int N, const ValueType a, co
         }
     }
 
+//! Draws values from a distribution N at a time through its batched operator()
+template<class Distribution, class Real, unsigned int N> class BatchedDistribution
+    {
+    public:
+    BatchedDistribution(const Distribution& dist) : m_dist(dist), m_next(N) { }
+
+    template<class RNG> Real operator()(RNG& rng)
+        {
+        if (m_next == N)
+            {
+            m_dist(m_values, rng);
+            m_next = 0;
+            }
+        return m_values[m_next++];
+        }
+
+    private:
+    Distribution m_dist;
+    Real m_values[N];
+    unsigned int m_next;
+    };
+
 //! Test case for NormalDistribution
 UP_TEST(normal_double_test)
     {
@@ -318,6 +340,16 @@ UP_TEST(canonical_double_moment)
     check_range(canonical, 5000000, a, b);
     }
 
+//! Test case for NormalDistribution drawn three at a time
+UP_TEST(normal_batched_double_test)
+    {
+    double mu = 1.5, sigma = 2.0;
+    double mean = mu, var = sigma * sigma, skew = 0, exkurtosis = 0.0;
+    BatchedDistribution<hoomd::NormalDistribution<double>, double, 3> gen(
+        hoomd::NormalDistribution<double>(sigma, mu));
+    check_moments(gen, 5000000, mean, var, skew, exkurtosis, 0.01);
+    }
+
 //! Test case for UniformDistribution -- double
 UP_TEST(uniform_double_test)
     {
@@ -341,6 +373,19 @@ UP_TEST(uniform_float_test)
     check_range(gen, 5000000, a, b);
     }
 
+//! Test case for UniformDistribution drawn three at a time
+UP_TEST(uniform_batched_double_test)
+    {
+    double a = -1, b = 1;
+    double mean = (a + b) / 2.0, var = 1.0 / 12.0 * (b - a) * (b - a), skew = 0.0,
+           exkurtosis = -6.0 / 5.0;
+
+    BatchedDistribution<hoomd::UniformDistribution<double>, double, 3> gen(
+        hoomd::UniformDistribution<double>(a, b));
+    check_moments(gen, 5000000, mean, var, skew, exkurtosis, 0.01);
+    check_range(gen, 5000000, a, b);
+    }
+
 //! Test case for UniformIntDistribution
 UP_TEST(uniform_int_test_1000)
     {
@@ -503,6 +548,47 @@ UP_TEST(rng_seeding)
     UP_ASSERT_EQUAL(g.getCounter()[3], 0x9876);
     }
 
+//! Test that each lane of RandomGeneratorBatch reproduces the matching RandomGenerator
+UP_TEST(rng_batch)
+    {
+    const unsigned int N = 8;
+    auto s = hoomd::Seed(hoomd::RNGIdentifier::TwoStepLangevin, 0x123456789a, 0x5eed);
+    hoomd::RandomGeneratorBatch<N> batch(s);
+    for (unsigned int i = 0; i < N; i++)
+        batch.setCounter(i, hoomd::Counter(i * 1000 + 7, i, 3));
+
+    // raw 128-bit values
+    for (unsigned int step = 0; step < 3; step++)
+        {
+        uint32_t u[4][N];
+        batch(u);
+        for (unsigned int i = 0; i < N; i++)
+            {
+            hoomd::RandomGenerator g(s, hoomd::Counter(i * 1000 + 7, i, 3));
+            g.discard(step);
+            auto v = g();
+            for (unsigned int k = 0; k < 4; k++)
+                UP_ASSERT_EQUAL(u[k][i], v.v[k]);
+            }
+        }
+
+    // uniform values drawn like UniformDistribution<double>(-1, 1)(double (&)[3], rng)
+    double rx[N], ry[N], rz[N];
+    hoomd::UniformDistribution<double> uniform(-1, 1);
+    uniform(rx, ry, batch);
+    uniform(rz, batch);
+    for (unsigned int i = 0; i < N; i++)
+        {
+        hoomd::RandomGenerator g(s, hoomd::Counter(i * 1000 + 7, i, 3));
+        g.discard(3);
+        double r[3];
+        uniform(r, g);
+        UP_ASSERT_EQUAL(rx[i], r[0]);
+        UP_ASSERT_EQUAL(ry[i], r[1]);
+        UP_ASSERT_EQUAL(rz[i], r[2]);
+        }
+    }
+
 // //! Find performance crossover
 // /*! Note: this code was written for a one time use to find the empirical crossover. It requires
 // that the private:
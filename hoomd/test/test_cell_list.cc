@@ -587,3 +587,82 @@ UP_TEST(CellListGPU_large)
         new ExecutionConfiguration(ExecutionConfiguration::GPU)));
     }
 #endif
+
+//! Validate that SystemDefinition shares cell lists between compatible requests
+void celllist_share_test(std::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    std::shared_ptr<SystemDefinition> sysdef(
+        new SystemDefinition(3, BoxDim(10.0), 1, 0, 0, 0, 0, exec_conf));
+
+    CellListRequest request;
+    request.nominal_width = Scalar(1.0);
+    request.max_width = Scalar(1.0);
+    std::shared_ptr<CellList> cl_a = sysdef->getCellList(request);
+    UP_ASSERT(cl_a);
+    MY_CHECK_CLOSE(cl_a->getNominalWidth(), 1.0, tol);
+
+    // an identical request shares the cell list and adds its optional data
+    CellListRequest request_sort = request;
+    request_sort.sort = true;
+    std::shared_ptr<CellList> cl_b = sysdef->getCellList(request_sort);
+    UP_ASSERT(cl_a == cl_b);
+    UP_ASSERT(cl_a->getSortCellList());
+
+    // optional data is only ever added to a shared cell list
+    std::shared_ptr<CellList> cl_c = sysdef->getCellList(request);
+    UP_ASSERT(cl_a == cl_c);
+    UP_ASSERT(cl_a->getSortCellList());
+
+    // a request that accepts wider cells shares the cell list
+    CellListRequest request_skin;
+    request_skin.nominal_width = Scalar(0.8);
+    request_skin.max_width = Scalar(1.2);
+    std::shared_ptr<CellList> cl_d = sysdef->getCellList(request_skin);
+    UP_ASSERT(cl_a == cl_d);
+
+    // requests for different widths, flags, or radii get their own cell lists
+    CellListRequest request_wide = request;
+    request_wide.nominal_width = Scalar(2.0);
+    request_wide.max_width = Scalar(2.0);
+    std::shared_ptr<CellList> cl_e = sysdef->getCellList(request_wide);
+    UP_ASSERT(cl_a != cl_e);
+    MY_CHECK_CLOSE(cl_e->getNominalWidth(), 2.0, tol);
+
+    CellListRequest request_type = request;
+    request_type.flag = CellListRequest::flag_type;
+    UP_ASSERT(cl_a != sysdef->getCellList(request_type));
+
+    CellListRequest request_radius = request;
+    request_radius.radius = 2;
+    UP_ASSERT(cl_a != sysdef->getCellList(request_radius));
+
+    // a cell list is released with its last consumer
+    std::weak_ptr<CellList> weak_e = cl_e;
+    cl_e.reset();
+    UP_ASSERT(weak_e.expired());
+    std::shared_ptr<CellList> cl_f = sysdef->getCellList(request_wide);
+    UP_ASSERT(!cl_f->getSortCellList());
+
+    // the shared cell list computes correctly
+    cl_a->compute(0);
+    uint3 dim = cl_a->getDim();
+    CHECK_EQUAL_UINT(dim.x, 10);
+    CHECK_EQUAL_UINT(dim.y, 10);
+    CHECK_EQUAL_UINT(dim.z, 10);
+    }
+
+//! test case for celllist_share_test
+UP_TEST(CellList_share)
+    {
+    celllist_share_test(std::shared_ptr<ExecutionConfiguration>(
+        new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+
+#ifdef ENABLE_HIP
+//! test case for celllist_share_test on the GPU
+UP_TEST(CellListGPU_share)
+    {
+    celllist_share_test(std::shared_ptr<ExecutionConfiguration>(
+        new ExecutionConfiguration(ExecutionConfiguration::GPU)));
+    }
+#endif
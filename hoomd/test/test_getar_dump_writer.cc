@@ -0,0 +1,125 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+// this include is necessary to get MPI included before anything else to support intel MPI
+#include "hoomd/ExecutionConfiguration.h"
+
+#include "upp11_config.h"
+HOOMD_UP_MAIN();
+
+#include "hoomd/GetarDumpWriter.h"
+#include "hoomd/System.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+/*! \file test_getar_dump_writer.cc
+    \brief Unit tests for the batched and asynchronous modes of GetarDumpWriter
+    \ingroup unit_tests
+*/
+
+using namespace std;
+using namespace getardump;
+
+//! Create a system of 8 particles with distinct positions
+std::shared_ptr<SystemDefinition>
+getar_test_system(std::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    std::shared_ptr<SystemDefinition> sysdef(
+        new SystemDefinition(8, BoxDim(10.0), 1, 0, 0, 0, 0, exec_conf));
+    std::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+    ArrayHandle<Scalar4> h_pos(pdata->getPositions(),
+                               access_location::host,
+                               access_mode::readwrite);
+    for (unsigned int i = 0; i < pdata->getN(); i++)
+        h_pos.data[i] = make_scalar4(Scalar(i) - Scalar(4.0), Scalar(0.5) * i, Scalar(-1.0), 0);
+    return sysdef;
+    }
+
+//! Return the sorted frame indices of the position record in the given file
+std::vector<unsigned int> getar_position_frames(const std::string& filename)
+    {
+    gtar::GTAR reader(filename, gtar::Read);
+    std::vector<unsigned int> frames;
+    std::vector<gtar::Record> records(reader.getRecordTypes());
+    for (const gtar::Record& rec : records)
+        {
+        if (rec.getName() != "position" || rec.getBehavior() != gtar::Discrete)
+            continue;
+        for (const std::string& frame : reader.queryFrames(rec))
+            frames.push_back(std::stoul(frame));
+        }
+    std::sort(frames.begin(), frames.end());
+    return frames;
+    }
+
+//! Run a system with a GetarDumpWriter that writes the positions on every step
+/*! \param filename File to write
+    \param mode Operation mode of the writer
+    \param nsteps Number of steps to run
+    \returns The writer, still open
+*/
+std::shared_ptr<GetarDumpWriter> getar_run(const std::string& filename,
+                                           GetarDumpMode mode,
+                                           uint64_t nsteps)
+    {
+    std::shared_ptr<ExecutionConfiguration> exec_conf(
+        new ExecutionConfiguration(ExecutionConfiguration::CPU));
+    std::shared_ptr<SystemDefinition> sysdef = getar_test_system(exec_conf);
+
+    std::shared_ptr<GetarDumpWriter> writer(new GetarDumpWriter(sysdef, filename, mode));
+    writer->setPeriod(Position, gtar::Individual, gtar::Discrete, false, gtar::FastCompress, 1);
+    writer->setAsynchronous(true);
+    writer->setBatchFrames(4);
+    UP_ASSERT(writer->getAsynchronous());
+    UP_ASSERT_EQUAL(writer->getBatchFrames(), (unsigned int)4);
+
+    System sys(sysdef, 0);
+    sys.getAnalyzers().push_back(std::make_pair(writer, std::make_shared<PeriodicTrigger>(1)));
+    sys.run(nsteps);
+    return writer;
+    }
+
+//! Batched frames written on the background thread all end up in the file
+UP_TEST(GetarDumpWriter_batched_frames)
+    {
+    const std::string filename = "test_getar_dump_writer_batched.zip";
+    std::shared_ptr<GetarDumpWriter> writer = getar_run(filename, Overwrite, 6);
+    writer->close();
+
+    // 6 frames do not fill two batches of 4, the last batch is written by the flush at run exit
+    std::vector<unsigned int> frames = getar_position_frames(filename);
+    UP_ASSERT_EQUAL(frames.size(), (size_t)6);
+    for (unsigned int i = 0; i < frames.size(); i++)
+        UP_ASSERT_EQUAL(frames[i], i + 1);
+
+    gtar::GTAR reader(filename, gtar::Read);
+    gtar::SharedArray<float> pos(reader.readIndividual<float>("frames/6/position.f32.ind"));
+    UP_ASSERT_EQUAL(pos.size(), (size_t)(3 * 8));
+    for (unsigned int i = 0; i < 8; i++)
+        {
+        MY_CHECK_SMALL(pos[3 * i] - (float(i) - 4.0f), 1e-6);
+        MY_CHECK_SMALL(pos[3 * i + 1] - 0.5f * i, 1e-6);
+        MY_CHECK_SMALL(pos[3 * i + 2] + 1.0f, 1e-6);
+        }
+
+    std::remove(filename.c_str());
+    }
+
+//! The frames of a run are on disk when the run returns, before the writer is closed
+UP_TEST(GetarDumpWriter_flush_at_run_exit)
+    {
+    // one-shot mode replaces the file with each written frame, so the file is readable while the
+    // writer is open and holds the last frame that was written
+    const std::string filename = "test_getar_dump_writer_oneshot.zip";
+    std::shared_ptr<GetarDumpWriter> writer = getar_run(filename, OneShot, 5);
+
+    std::vector<unsigned int> frames = getar_position_frames(filename);
+    UP_ASSERT_EQUAL(frames.size(), (size_t)1);
+    UP_ASSERT_EQUAL(frames[0], (unsigned int)5);
+
+    writer->close();
+    std::remove(filename.c_str());
+    }
@@ -261,6 +261,59 @@ UP_TEST(ParticleGroup_sort_test)
         }
     }
 
+//! Checks that a group of all particles keeps its identity index list through sorts and additions
+UP_TEST(ParticleGroup_all_sort_test)
+    {
+    std::shared_ptr<SystemDefinition> sysdef = create_sysdef();
+    std::shared_ptr<ParticleData> pdata = sysdef->getParticleData();
+
+    std::shared_ptr<ParticleFilter> selector_all(new ParticleFilterAll());
+    ParticleGroup all(sysdef, selector_all);
+    CHECK_EQUAL_UINT(all.getNumMembers(), pdata->getN());
+
+    // reverse the particle order
+        {
+        ArrayHandle<unsigned int> h_tag(pdata->getTags(),
+                                        access_location::host,
+                                        access_mode::readwrite);
+        ArrayHandle<unsigned int> h_rtag(pdata->getRTags(),
+                                         access_location::host,
+                                         access_mode::readwrite);
+        for (unsigned int i = 0; i < pdata->getN(); i++)
+            {
+            h_tag.data[i] = pdata->getN() - 1 - i;
+            h_rtag.data[pdata->getN() - 1 - i] = i;
+            }
+        }
+    pdata->notifyParticleSort();
+
+    CHECK_EQUAL_UINT(all.getNumMembers(), pdata->getN());
+    for (unsigned int i = 0; i < pdata->getN(); i++)
+        {
+        CHECK_EQUAL_UINT(all.getMemberTag(i), i);
+        CHECK_EQUAL_UINT(all.getMemberIndex(i), i);
+        UP_ASSERT(all.isMember(i));
+        }
+
+    // a new particle joins the group at the end of the index list
+    unsigned int new_tag = pdata->addParticle(0);
+    CHECK_EQUAL_UINT(all.getNumMembers(), pdata->getN());
+    CHECK_EQUAL_UINT(all.getNumMembersGlobal(), pdata->getNGlobal());
+    for (unsigned int i = 0; i < pdata->getN(); i++)
+        {
+        CHECK_EQUAL_UINT(all.getMemberIndex(i), i);
+        UP_ASSERT(all.isMember(i));
+        }
+    UP_ASSERT(all.isMember(pdata->getRTag(new_tag)));
+
+    // removing a particle shrinks the list
+    pdata->removeParticle(0);
+    CHECK_EQUAL_UINT(all.getNumMembers(), pdata->getN());
+    CHECK_EQUAL_UINT(all.getNumMembersGlobal(), pdata->getNGlobal());
+    for (unsigned int i = 0; i < pdata->getN(); i++)
+        CHECK_EQUAL_UINT(all.getMemberIndex(i), i);
+    }
+
 //! Checks that ParticleGroup can initialize by particle type
 UP_TEST(ParticleGroup_type_test)
     {
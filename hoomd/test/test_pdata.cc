@@ -10,6 +10,7 @@
 #include "hoomd/ExecutionConfiguration.h"
 
 #include <iostream>
+#include <set>
 
 #include "hoomd/Initializers.h"
 #include "hoomd/ParticleData.h"
@@ -671,6 +672,135 @@ UP_TEST(Random_test)
         }
     }
 
+//! Checks that addParticle and removeParticle keep the particle arrays and rtags consistent
+void pdata_add_remove_test(std::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    BoxDim box(10.0);
+    ParticleData pdata(3, box, 2, exec_conf);
+    pdata.setPosition(0, make_scalar3(1.0, 0.0, 0.0));
+    pdata.setPosition(1, make_scalar3(2.0, 0.0, 0.0));
+    pdata.setPosition(2, make_scalar3(3.0, 0.0, 0.0));
+    pdata.setAngularMomentum(2, make_scalar4(0.0, 1.0, 2.0, 3.0));
+
+    // remove a particle from the middle, the last one moves into its slot
+    pdata.removeParticle(0);
+    UP_ASSERT_EQUAL(pdata.getN(), (unsigned int)2);
+    UP_ASSERT_EQUAL(pdata.getNGlobal(), (unsigned int)2);
+    MY_CHECK_CLOSE(pdata.getPosition(1).x, 2.0, tol);
+    MY_CHECK_CLOSE(pdata.getPosition(2).x, 3.0, tol);
+    MY_CHECK_CLOSE(pdata.getAngularMomentum(2).w, 3.0, tol);
+
+        {
+        ArrayHandle<unsigned int> h_tag(pdata.getTags(), access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_rtag(pdata.getRTags(),
+                                         access_location::host,
+                                         access_mode::read);
+        UP_ASSERT_EQUAL(h_rtag.data[0], NOT_LOCAL);
+        for (unsigned int i = 0; i < pdata.getN(); i++)
+            UP_ASSERT_EQUAL(h_rtag.data[h_tag.data[i]], i);
+        }
+
+    // the removed tag is recycled and the new particle takes default values
+    unsigned int tag = pdata.addParticle(1);
+    UP_ASSERT_EQUAL(tag, (unsigned int)0);
+    UP_ASSERT_EQUAL(pdata.getN(), (unsigned int)3);
+    UP_ASSERT_EQUAL(pdata.getType(tag), (unsigned int)1);
+    UP_ASSERT_EQUAL(pdata.getBody(tag), NO_BODY);
+    MY_CHECK_CLOSE(pdata.getPosition(tag).x, 0.0, tol);
+    MY_CHECK_CLOSE(pdata.getMass(tag), 1.0, tol);
+
+        {
+        ArrayHandle<unsigned int> h_tag(pdata.getTags(), access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_rtag(pdata.getRTags(),
+                                         access_location::host,
+                                         access_mode::read);
+        UP_ASSERT_EQUAL(h_rtag.data[tag], (unsigned int)2);
+        for (unsigned int i = 0; i < pdata.getN(); i++)
+            UP_ASSERT_EQUAL(h_rtag.data[h_tag.data[i]], i);
+        }
+    }
+
+//! Checks that batches of particles are added and removed consistently
+void pdata_batch_test(std::shared_ptr<ExecutionConfiguration> exec_conf)
+    {
+    BoxDim box(10.0);
+    ParticleData pdata(6, box, 2, exec_conf);
+    for (unsigned int tag = 0; tag < 6; tag++)
+        pdata.setPosition(tag, make_scalar3(Scalar(tag), 0.0, 0.0));
+
+    // remove particles from the middle and from the end of the arrays
+    std::vector<unsigned int> removed = {1, 5, 2};
+    pdata.removeParticleBatch(removed);
+    UP_ASSERT_EQUAL(pdata.getN(), (unsigned int)3);
+    UP_ASSERT_EQUAL(pdata.getNGlobal(), (unsigned int)3);
+    for (unsigned int tag : {0, 3, 4})
+        {
+        UP_ASSERT(pdata.isTagActive(tag));
+        MY_CHECK_CLOSE(pdata.getPosition(tag).x, Scalar(tag), tol);
+        }
+    for (unsigned int tag : removed)
+        UP_ASSERT(!pdata.isTagActive(tag));
+
+    // removing a tag twice in one batch fails and leaves the particles untouched
+    UP_ASSERT_EXCEPTION(std::runtime_error,
+                        [&] { pdata.removeParticleBatch(std::vector<unsigned int>({0, 0})); });
+    UP_ASSERT_EQUAL(pdata.getNGlobal(), (unsigned int)3);
+
+    // the new particles recycle the removed tags before taking new ones
+    std::vector<unsigned int> types = {1, 0, 1, 1};
+    std::vector<unsigned int> tags = pdata.addParticleBatch(types);
+    UP_ASSERT_EQUAL(tags.size(), types.size());
+    UP_ASSERT_EQUAL(pdata.getN(), (unsigned int)7);
+    UP_ASSERT_EQUAL(pdata.getNGlobal(), (unsigned int)7);
+
+    std::set<unsigned int> expected_tags = {1, 2, 5, 6};
+    UP_ASSERT(std::set<unsigned int>(tags.begin(), tags.end()) == expected_tags);
+    for (unsigned int i = 0; i < tags.size(); i++)
+        {
+        UP_ASSERT_EQUAL(pdata.getType(tags[i]), types[i]);
+        MY_CHECK_CLOSE(pdata.getMass(tags[i]), 1.0, tol);
+        }
+
+        {
+        ArrayHandle<unsigned int> h_tag(pdata.getTags(), access_location::host, access_mode::read);
+        ArrayHandle<unsigned int> h_rtag(pdata.getRTags(),
+                                         access_location::host,
+                                         access_mode::read);
+        for (unsigned int i = 0; i < pdata.getN(); i++)
+            UP_ASSERT_EQUAL(h_rtag.data[h_tag.data[i]], i);
+        }
+    }
+
+//! Tests adding and removing particles on the CPU
+UP_TEST(ParticleData_add_remove_test)
+    {
+    pdata_add_remove_test(std::shared_ptr<ExecutionConfiguration>(
+        new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+
+//! Tests adding and removing batches of particles on the CPU
+UP_TEST(ParticleData_batch_test)
+    {
+    pdata_batch_test(std::shared_ptr<ExecutionConfiguration>(
+        new ExecutionConfiguration(ExecutionConfiguration::CPU)));
+    }
+
+#ifdef ENABLE_HIP
+//! Tests adding and removing particles on the GPU
+UP_TEST(ParticleData_add_remove_test_GPU)
+    {
+    pdata_add_remove_test(std::shared_ptr<ExecutionConfiguration>(
+        new ExecutionConfiguration(ExecutionConfiguration::GPU)));
+    }
+
+//! Tests adding and removing batches of particles on the GPU
+UP_TEST(ParticleData_batch_test_GPU)
+    {
+    pdata_batch_test(std::shared_ptr<ExecutionConfiguration>(
+        new ExecutionConfiguration(ExecutionConfiguration::GPU)));
+    }
+#endif
+
 /*#include "RandomGenerator.h"
 #include "MOL2DumpWriter.h"
 UP_TEST( Generator_test )
@@ -0,0 +1,131 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+// this include is necessary to get MPI included before anything else to support intel MPI
+#include "hoomd/ExecutionConfiguration.h"
+
+#include "hoomd/StepArena.h"
+
+#include <stdint.h>
+
+using namespace std;
+
+/*! \file test_step_arena.cc
+    \brief Unit tests for StepArena
+    \ingroup unit_tests
+*/
+
+#include "upp11_config.h"
+HOOMD_UP_MAIN();
+
+//! Allocations are aligned, distinct, and returned in scope order
+UP_TEST(StepArena_scoped)
+    {
+    StepArena arena(false);
+
+    // the first step overflows the empty block
+        {
+        ArenaAllocation<double> a(arena, 100);
+        ArenaAllocation<int> b(arena, 10);
+        UP_ASSERT(a.data != NULL);
+        UP_ASSERT(b.data != NULL);
+        UP_ASSERT(a.data != (double*)b.data);
+        UP_ASSERT_EQUAL((uintptr_t)a.data % 256, (uintptr_t)0);
+        UP_ASSERT_EQUAL((uintptr_t)b.data % 256, (uintptr_t)0);
+        for (unsigned int i = 0; i < 100; i++)
+            a.data[i] = i;
+        for (unsigned int i = 0; i < 10; i++)
+            b.data[i] = -int(i);
+        for (unsigned int i = 0; i < 100; i++)
+            UP_ASSERT_EQUAL(a.data[i], double(i));
+        }
+    // releasing the outermost allocation frees the overflow and grows the block to the peak usage
+    UP_ASSERT_EQUAL(arena.getNumAllocations(), 0u);
+    UP_ASSERT(arena.getCapacity() >= 100 * sizeof(double) + 10 * sizeof(int));
+    UP_ASSERT_EQUAL(arena.getAllocatedBytes(), arena.getCapacity());
+
+    // later allocations bump in the block and reuse released memory
+    char* first;
+        {
+        ArenaAllocation<double> a(arena, 100);
+        first = (char*)a.data;
+        UP_ASSERT(arena.getOffset() > 0);
+        }
+    UP_ASSERT_EQUAL(arena.getOffset(), (size_t)0);
+        {
+        ArenaAllocation<char> c(arena, 64);
+        UP_ASSERT_EQUAL(c.data, first);
+        }
+
+    // empty allocations return null
+        {
+        ArenaAllocation<double> a(arena, 0);
+        UP_ASSERT(a.data == NULL);
+        }
+    UP_ASSERT_EQUAL(arena.getNumAllocations(), 0u);
+    }
+
+//! Overflow blocks are freed when the outermost allocation is released, without reset()
+UP_TEST(StepArena_overflow_released)
+    {
+    StepArena arena(false);
+    for (unsigned int i = 0; i < 10; i++)
+        {
+            {
+            ArenaAllocation<char> a(arena, 4096);
+                {
+                ArenaAllocation<char> b(arena, 4096 * (i + 1));
+                UP_ASSERT(b.data != NULL);
+                UP_ASSERT_EQUAL(arena.getNumAllocations(), 2u);
+                }
+            // the inner release keeps the overflow while a is alive
+            UP_ASSERT(arena.getAllocatedBytes() >= 4096 * (i + 2));
+            }
+        UP_ASSERT_EQUAL(arena.getNumAllocations(), 0u);
+        UP_ASSERT_EQUAL(arena.getAllocatedBytes(), arena.getCapacity());
+        UP_ASSERT_EQUAL(arena.getOffset(), (size_t)0);
+        }
+
+    // the block has grown to the peak and repeated use no longer allocates
+    size_t capacity = arena.getCapacity();
+    UP_ASSERT(capacity >= 4096 * 11);
+    for (unsigned int i = 0; i < 10; i++)
+        {
+        ArenaAllocation<char> a(arena, 4096);
+        ArenaAllocation<char> b(arena, 4096 * 10);
+        UP_ASSERT_EQUAL(arena.getAllocatedBytes(), capacity);
+        }
+    UP_ASSERT_EQUAL(arena.getCapacity(), capacity);
+    }
+
+//! A release out of scope order keeps the later allocation valid
+UP_TEST(StepArena_release_order)
+    {
+    StepArena arena(false);
+        {
+        ArenaAllocation<char> warmup(arena, 4096);
+        }
+
+    ArenaAllocation<char>* a = new ArenaAllocation<char>(arena, 16);
+    ArenaAllocation<char> b(arena, 16);
+    size_t end = arena.getOffset();
+
+    // a is not the last allocation, releasing it does nothing
+    delete a;
+    UP_ASSERT_EQUAL(arena.getOffset(), end);
+    ArenaAllocation<char> c(arena, 16);
+    UP_ASSERT(c.data != b.data);
+    }
+
+//! ExecutionConfiguration provides a host arena
+UP_TEST(StepArena_exec_conf)
+    {
+    std::shared_ptr<ExecutionConfiguration> exec_conf(
+        new ExecutionConfiguration(ExecutionConfiguration::CPU));
+        {
+        ArenaAllocation<float> a(exec_conf->getHostArena(), 10);
+        UP_ASSERT(a.data != NULL);
+        }
+    exec_conf->resetArenas();
+    UP_ASSERT_EQUAL(exec_conf->getHostArena().getOffset(), (size_t)0);
+    }
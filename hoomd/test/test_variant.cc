@@ -0,0 +1,82 @@
+// Copyright (c) 2009-2021 The Regents of the University of Michigan
+// This file is part of the HOOMD-blue project, released under the BSD 3-Clause License.
+
+// this include is necessary to get MPI included before anything else to support intel MPI
+#include "hoomd/ExecutionConfiguration.h"
+
+#include "hoomd/Variant.h"
+
+#include "upp11_config.h"
+
+HOOMD_UP_MAIN();
+
+/*! \file test_variant.cc
+    \brief Implements unit tests for the device parameters of the variants
+    \ingroup unit_tests
+*/
+
+//! Check that evaluate_variant() gives the values of the host variant over a range of time steps
+void check_device_params(Variant& variant, uint64_t last)
+    {
+    variant_params params = variant.getDeviceParams(0);
+    for (uint64_t timestep = 0; timestep < last; timestep++)
+        {
+        MY_CHECK_CLOSE(evaluate_variant(params, timestep), variant(timestep), tol);
+        }
+    }
+
+//! Variant without device parameters, like the variants implemented in Python
+class VariantSquare : public Variant
+    {
+    public:
+    Scalar operator()(uint64_t timestep)
+        {
+        return Scalar(timestep * timestep);
+        }
+
+    Scalar min()
+        {
+        return 0;
+        }
+
+    Scalar max()
+        {
+        return 0;
+        }
+    };
+
+UP_TEST(variant_constant_params)
+    {
+    VariantConstant variant(2.5);
+    check_device_params(variant, 10);
+    }
+
+UP_TEST(variant_ramp_params)
+    {
+    VariantRamp variant(1.0, 3.0, 10, 100);
+    check_device_params(variant, 200);
+    }
+
+UP_TEST(variant_cycle_params)
+    {
+    VariantCycle variant(1.0, -2.0, 10, 20, 30, 15, 25);
+    check_device_params(variant, 300);
+    }
+
+UP_TEST(variant_power_params)
+    {
+    VariantPower positive(1.0, 10.0, 3.0, 10, 100);
+    check_device_params(positive, 200);
+
+    VariantPower negative(-5.0, 2.0, 0.5, 0, 50);
+    check_device_params(negative, 100);
+    }
+
+UP_TEST(variant_host_params)
+    {
+    // variants without device parameters are evaluated on the host
+    VariantSquare variant;
+    variant_params params = variant.getDeviceParams(7);
+    UP_ASSERT_EQUAL(params.kind, (unsigned int)variant_constant);
+    MY_CHECK_CLOSE(evaluate_variant(params, 0), 49.0, tol);
+    }
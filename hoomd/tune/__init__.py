@@ -7,5 +7,6 @@
 from hoomd.tune.sorter import ParticleSorter
 from hoomd.tune.balance import LoadBalancer
 from hoomd.tune.custom_tuner import CustomTuner, _InternalCustomTuner
+from hoomd.tune.kernel_benchmark import benchmark
 from hoomd.tune.attr_tuner import (ManualTuneDefinition, SolverStep,
                                    ScaleSolver, SecantSolver)
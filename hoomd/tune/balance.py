@@ -1,6 +1,7 @@
 """Define LoadBalancer."""
 
 from hoomd.data.parameterdicts import ParameterDict
+from hoomd.data.typeconverter import OnlyFrom
 from hoomd.operation import Tuner
 from hoomd.trigger import Trigger
 from hoomd import _hoomd
@@ -19,6 +20,8 @@ class LoadBalancer(Tuner):
         tolerance (`float`): Load imbalance tolerance.
         max_iterations (`int`): Maximum number of iterations to
             attempt in a single step.
+        weight (`str`): Load metric to balance, either ``'particles'`` or
+            ``'time'``.
 
     `LoadBalancer` adjusts the boundaries of the MPI domains to distribute
     the particle load close to evenly between them. The load imbalance is
@@ -48,6 +51,23 @@ class LoadBalancer(Tuner):
     significantly more pair force neighbors than others, this estimate of the
     load imbalance may not produce the optimal results.
 
+    Set *weight* to ``'time'`` to balance the measured cost of each rank
+    instead. The load :math:`W_i` of rank :math:`i` is then the wall clock time
+    the rank spent outside of MPI communication since the previous balancing
+    step, and the imbalance is
+
+    .. math::
+
+        I = \frac{W_i}{\sum_j W_j / P}.
+
+    Each particle is assumed to carry an equal share of the load of the rank
+    that owns it, so that moving a domain boundary moves load along with the
+    particles. This accounts for variations in the cost per particle, such as
+    dense regions with more pair force neighbors, at the price of noise in the
+    measurement. The measured time includes all other operations that run
+    between the balancing steps. The first balancing step of each
+    `Simulation.run` has no measurement and balances the particle count.
+
     A load balancing adjustment is only performed when the maximum load
     imbalance exceeds a *tolerance*. The ideal load balance is 1.0, so setting
     *tolerance* less than 1.0 will force an adjustment every update. The load
@@ -82,6 +102,8 @@ class LoadBalancer(Tuner):
         tolerance (`float`): Load imbalance tolerance.
         max_iterations (`int`): Maximum number of iterations to
             attempt in a single step.
+        weight (`str`): Load metric to balance, either ``'particles'`` or
+            ``'time'``.
     """
 
     def __init__(self,
@@ -90,18 +112,21 @@ class LoadBalancer(Tuner):
                  y=True,
                  z=True,
                  tolerance=1.02,
-                 max_iterations=1):
+                 max_iterations=1,
+                 weight='particles'):
         defaults = dict(x=x,
                         y=y,
                         z=z,
                         tolerance=tolerance,
                         max_iterations=max_iterations,
+                        weight=weight,
                         trigger=trigger)
         self._param_dict = ParameterDict(x=bool,
                                          y=bool,
                                          z=bool,
                                          max_iterations=int,
                                          tolerance=float,
+                                         weight=OnlyFrom(['particles', 'time']),
                                          trigger=Trigger)
         self._param_dict.update(defaults)
 
@@ -0,0 +1,101 @@
+# Copyright (c) 2009-2021 The Regents of the University of Michigan
+# This file is part of the HOOMD-blue project, released under the BSD 3-Clause
+# License.
+
+"""Implement benchmark."""
+
+
+def benchmark(simulation,
+              filename=None,
+              rescan=True,
+              steps_per_check=100,
+              max_steps=100000):
+    """Tune every GPU kernel that a simulation launches.
+
+    Args:
+        simulation (hoomd.Simulation): Simulation with the state and operations
+            to tune.
+        filename (str): When not `None`, save the tuning cache to this file
+            with `hoomd.device.Device.save_tuning_cache`.
+        rescan (bool): When `True`, autotuners scan all their parameters even
+            when the tuning cache has an entry for their kernel.
+        steps_per_check (int): Number of time steps to run between checks for
+            incomplete scans.
+        max_steps (int): Maximum number of time steps to run.
+
+    Returns:
+        list[dict]: One entry for each kernel tuned, with the keys ``'name'``
+        (the name of the autotuner), ``'device'`` (the GPU model),
+        ``'size'`` (the number of particles rounded down to a power of 2, or
+        `None` when the kernel does not depend on it), ``'parameter'`` (the
+        optimal parameter), and ``'time'`` (the kernel time with the optimal
+        parameter :math:`[\\mathrm{ms}]`).
+
+    Autotuners tune the launch parameters of GPU kernels while a simulation
+    runs, and the simulation runs with slower parameters until each initial
+    scan completes. `benchmark` runs ``simulation`` until every autotuner it
+    started has completed its initial scan. Save the tuning cache (with
+    ``filename``) and load it in production jobs with
+    `hoomd.device.Device.load_tuning_cache` so that they run with tuned kernels
+    from the first step.
+
+    Call `benchmark` before the first `hoomd.Simulation.run` with the same
+    state and operations as the production job. Autotuners that completed their
+    initial scan in an earlier run do not scan again and do not appear in the
+    report. Kernels that execute only on some time steps (for example, those of
+    writers and neighbor list builds) need enough time steps to complete their
+    scans, so `benchmark` checks for incomplete scans every ``steps_per_check``
+    steps.
+
+    Note:
+        `benchmark` advances the simulation by the number of time steps it
+        runs.
+
+    Note:
+        On the CPU, there are no autotuners and `benchmark` runs
+        ``steps_per_check`` time steps and returns an empty list.
+
+    Example::
+
+        report = hoomd.tune.benchmark(sim, filename='tuning.txt')
+        for kernel in report:
+            print(kernel['name'], kernel['parameter'], kernel['time'])
+
+    Raises:
+        RuntimeError: When some scans are incomplete after ``max_steps`` time
+            steps.
+    """
+    exec_conf = simulation.device._cpp_exec_conf
+    mpi_conf = simulation.device.communicator.cpp_mpi_conf
+
+    exec_conf.resetTuningReport()
+    exec_conf.setTuningCacheRead(not rescan)
+    try:
+        steps = 0
+        while True:
+            simulation.run(steps_per_check)
+            steps += steps_per_check
+            scanning = exec_conf.getScanningAutotuners()
+            # every rank must agree to stop
+            if mpi_conf.allReduceMax(len(scanning)) == 0:
+                break
+            if steps >= max_steps:
+                raise RuntimeError("Autotuners did not complete their scans in "
+                                   f"{max_steps} steps: {sorted(scanning)}")
+    finally:
+        exec_conf.setTuningCacheRead(True)
+
+    report = []
+    for key, (parameter, time) in exec_conf.getTuningReport().items():
+        name, device, size, _ = key.rsplit('|', 3)
+        report.append(
+            dict(name=name,
+                 device=device,
+                 size=2**int(size[1:]) if size.startswith('N') else None,
+                 parameter=parameter,
+                 time=time))
+
+    if filename is not None:
+        simulation.device.save_tuning_cache(filename)
+
+    return report
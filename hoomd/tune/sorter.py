@@ -1,7 +1,7 @@
 """Define the ParticleSorter class."""
 
 from hoomd.data.parameterdicts import ParameterDict
-from hoomd.data.typeconverter import OnlyTypes
+from hoomd.data.typeconverter import OnlyFrom, OnlyTypes
 from hoomd.operation import Tuner
 from hoomd.trigger import Trigger
 from hoomd import _hoomd
@@ -20,11 +20,36 @@ class ParticleSorter(Tuner):
             value of `None` sets ``grid=4096`` in 2D simulations and
             ``grid=256`` in 3D simulations.
 
+        curve (str): Curve to sort the particles along.
+
+        threshold (float): Fraction of out of order particles below which
+            `ParticleSorter` skips the sort.
+
+        low_memory (bool): Reorder the particle data in place on the GPU.
+
     `ParticleSorter` improves simulation performance by sorting the particles in
     memory along a space-filling curve. This takes particles that are close in
     space and places them close in memory, leading to a higher rate of
     cache hits when computing pair potentials.
 
+    The ``'hilbert'`` curve gives the best locality in most systems. The
+    ``'morton'`` curve (Z order) is the cheapest to evaluate. The ``'cell'``
+    curve traverses the grid in the same order as the cell list, with the
+    **x** index varying fastest.
+
+    When `threshold` is positive, `ParticleSorter` checks the order of the
+    particles on each triggered step and sorts only when the fraction of
+    particles that come before their predecessor in memory along the curve
+    exceeds `threshold`. Use this with a short trigger period to sort as often
+    as the particles' diffusion requires, without tuning the period by hand.
+
+    On the GPU, `ParticleSorter` writes the sorted particle data to a second set
+    of per-particle arrays by default. Set `low_memory` to `True` to reorder
+    each array in place through a temporary buffer the size of one array
+    instead.
+    This is somewhat slower, but single GPU simulations then avoid allocating
+    the second set of arrays, which roughly halves the particle data memory.
+
     Note:
         New `hoomd.Operations` instances include a `ParticleSorter`
         constructed with default parameters.
@@ -37,17 +62,37 @@ class ParticleSorter(Tuner):
             of `grid` provide more accurate space-filling curves, but consume
             more memory (``grid**D * 4`` bytes, where *D* is the dimensionality
             of the system).
+
+        curve (str): Curve to sort the particles along: ``'hilbert'``,
+            ``'morton'``, or ``'cell'``.
+
+        threshold (float): Fraction of out of order particles below which
+            `ParticleSorter` skips the sort. The default value of 0 sorts on
+            every triggered step.
+
+        low_memory (bool): Reorder the particle data in place on the GPU.
     """
 
-    def __init__(self, trigger=200, grid=None):
+    def __init__(self,
+                 trigger=200,
+                 grid=None,
+                 curve='hilbert',
+                 threshold=0.0,
+                 low_memory=False):
         self._param_dict = ParameterDict(
             trigger=Trigger,
             grid=OnlyTypes(int,
                            postprocess=ParticleSorter._to_power_of_two,
                            preprocess=ParticleSorter._natural_number,
-                           allow_none=True))
+                           allow_none=True),
+            curve=OnlyFrom(['hilbert', 'morton', 'cell']),
+            threshold=float,
+            low_memory=bool)
         self.trigger = trigger
         self.grid = grid
+        self.curve = curve
+        self.threshold = threshold
+        self.low_memory = low_memory
 
     @staticmethod
     def _to_power_of_two(value):
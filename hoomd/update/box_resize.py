@@ -4,6 +4,7 @@
 
 """Implement BoxResize."""
 
+import hoomd
 from hoomd.operation import Updater
 from hoomd.box import Box
 from hoomd.data.parameterdicts import ParameterDict
@@ -71,9 +72,12 @@ class BoxResize(Updater):
 
     def _attach(self):
         group = self._simulation.state._get_group(self.filter)
-        self._cpp_obj = _hoomd.BoxResizeUpdater(
-            self._simulation.state._cpp_sys_def, self.box1, self.box2,
-            self.variant, group)
+        if isinstance(self._simulation.device, hoomd.device.CPU):
+            cpp_class = _hoomd.BoxResizeUpdater
+        else:
+            cpp_class = _hoomd.BoxResizeUpdaterGPU
+        self._cpp_obj = cpp_class(self._simulation.state._cpp_sys_def,
+                                  self.box1, self.box2, self.variant, group)
         super()._attach()
 
     def get_box(self, timestep):
@@ -50,6 +50,12 @@ class FilterUpdater(hoomd.operation.Updater):
         Some actions automatically recompute all filter particles such as adding
         or removing particles.
 
+    Note:
+        In GPU simulations on a single rank, filters that support it (see
+        `hoomd.filter.Region`) are evaluated on the GPU and the groups are
+        rebuilt on the device. Other filters, such as
+        `hoomd.filter.CustomFilter`, are evaluated on the host.
+
     Args:
         trigger (hoomd.trigger.Trigger or int):
             A trigger to use for determining when to update particles associated
@@ -43,10 +43,10 @@ class RemoveDrift(Updater):
         super()._add(simulation)
 
     def _attach(self):
-        if isinstance(self._simulation.device, hoomd.device.GPU):
-            self._simulation.device._cpp_msg.warning(
-                "Falling back on CPU. No GPU implementation available.\n")
-
-        self._cpp_obj = _hoomd.UpdaterRemoveDrift(
-            self._simulation.state._cpp_sys_def, self.reference_positions)
+        if isinstance(self._simulation.device, hoomd.device.CPU):
+            self._cpp_obj = _hoomd.UpdaterRemoveDrift(
+                self._simulation.state._cpp_sys_def, self.reference_positions)
+        else:
+            self._cpp_obj = _hoomd.UpdaterRemoveDriftGPU(
+                self._simulation.state._cpp_sys_def, self.reference_positions)
         super()._attach()
@@ -42,6 +42,9 @@ Attributes:
     tbb_enabled (bool): ``True`` when this build supports TBB threads.
 
     version (str): HOOMD-blue package version, following semantic versioning.
+
+    zlib_enabled (bool): ``True`` when this build supports compressed GSD
+        chunks.
 """
 from hoomd import _hoomd
 
@@ -66,5 +69,6 @@ gpu_platform = _hoomd.BuildInfo.getGPUPlatform()
 cxx_compiler = _hoomd.BuildInfo.getCXXCompiler()
 tbb_enabled = _hoomd.BuildInfo.getEnableTBB()
 mpi_enabled = _hoomd.BuildInfo.getEnableMPI()
+zlib_enabled = _hoomd.BuildInfo.getEnableZLIB()
 source_dir = _hoomd.BuildInfo.getSourceDir()
 install_dir = _hoomd.BuildInfo.getInstallDir()
@@ -4,7 +4,10 @@
 
 """Writers."""
 
+from hoomd.write.checkpoint import Checkpoint
 from hoomd.write.custom_writer import CustomWriter
 from hoomd.write.gsd import GSD
 from hoomd.write.dcd import DCD
+from hoomd.write.imd import IMD
+from hoomd.write.log_buffer import LogBuffer
 from hoomd.write.table import Table
@@ -0,0 +1,262 @@
+# Copyright (c) 2009-2021 The Regents of the University of Michigan
+# This file is part of the HOOMD-blue project, released under the BSD 3-Clause
+# License.
+
+"""Implement Checkpoint."""
+
+import json
+import os
+
+import numpy as np
+
+from hoomd import _hoomd
+from hoomd.data.parameterdicts import ParameterDict
+from hoomd.data.typeconverter import OnlyTypes
+from hoomd.filter import All
+from hoomd.operation import Writer
+
+# Attributes of the integrator and its methods that evolve during a run and
+# are needed to continue it.
+_state_attributes = ('translational_thermostat_dof',
+                     'rotational_thermostat_dof', 'barostat_dof', 'd', 'a')
+
+_state_chunk = 'log/checkpoint/state'
+
+
+def _checkpoint_filename(filename, index):
+    """Insert the file index before the extension of *filename*."""
+    root, ext = os.path.splitext(filename)
+    return f'{root}.{index}{ext}'
+
+
+def _state_operations(simulation):
+    """List the operations whose state a checkpoint stores."""
+    integrator = simulation.operations.integrator
+    if integrator is None:
+        return []
+    return [integrator] + list(getattr(integrator, 'methods', []))
+
+
+def _type_name(operation):
+    return type(operation).__module__ + '.' + type(operation).__name__
+
+
+def _operation_state(operation):
+    state = dict(type=_type_name(operation))
+    for name in _state_attributes:
+        if name in operation._param_dict:
+            state[name] = list(getattr(operation, name))
+        elif name in operation._typeparam_dict:
+            state[name] = getattr(operation, name).to_dict()
+    return state
+
+
+class _CheckpointStateWriter:
+    """Write the operation state to each checkpoint as a JSON string."""
+
+    def __init__(self, simulation):
+        self._simulation = simulation
+
+    def _write_frame(self, _gsd):
+        state = dict(seed=self._simulation.seed,
+                     operations=[
+                         _operation_state(op)
+                         for op in _state_operations(self._simulation)
+                     ])
+        value = bytes(json.dumps(state) + '\0', 'UTF-8')
+        _gsd.writeLogQuantities(
+            {_state_chunk: np.frombuffer(value, dtype=np.int8)})
+
+
+class Checkpoint(Writer):
+    """Write checkpoints to a rotating set of GSD files.
+
+    Args:
+        trigger (hoomd.trigger.Trigger): Select the timesteps to write
+            checkpoints.
+        filename (str): Base file name of the checkpoints.
+        num_files (int): Number of checkpoint files to rotate through.
+            Defaults to 2.
+        asynchronous (bool): When `True`, write checkpoints on background
+            threads. Defaults to `True`.
+        parallel (bool): When `True`, write per-particle data from all MPI
+            ranks. Defaults to `False`.
+
+    `Checkpoint` stores everything needed to continue a simulation: all
+    particle data and topology, the simulation seed, the thermostat and
+    barostat degrees of freedom of the integration methods, and the HPMC move
+    sizes. Each checkpoint is a single frame GSD file. Checkpoints rotate
+    through *num_files* files, named by inserting the file index before the
+    extension of *filename* (``checkpoint.gsd`` writes ``checkpoint.0.gsd``,
+    ``checkpoint.1.gsd``, ...). A checkpoint never overwrites the most recent
+    one, so a complete checkpoint remains when the job is interrupted while
+    writing.
+
+    When *asynchronous* is `True`, `Checkpoint` copies the system state into
+    memory and returns to the simulation while a background thread writes the
+    file, as `hoomd.write.GSD` does. Each file has its own thread, so the
+    writes of successive checkpoints may overlap. `Simulation.run` waits for
+    all checkpoints to be written before it returns. See `hoomd.write.GSD` for
+    the *parallel* option.
+
+    When the checkpoint files exist already, `Checkpoint` continues the
+    rotation after the most recent one. To continue a simulation, create the
+    state from `latest`, add the same operations, and call `restore_state`::
+
+        filename = Checkpoint.latest('checkpoint.gsd')
+        if filename is None:
+            sim.create_state_from_snapshot(snapshot)
+        else:
+            sim.create_state_from_gsd(filename)
+
+        sim.operations.integrator = integrator
+        if filename is not None:
+            Checkpoint.restore_state(sim, filename)
+
+        checkpoint = hoomd.write.Checkpoint(trigger=hoomd.trigger.Periodic(
+            100000), filename='checkpoint.gsd')
+        sim.operations.writers.append(checkpoint)
+
+    Note:
+        GSD files store particle data in single precision, so continued
+        simulations are not bitwise identical to uninterrupted ones.
+
+    Attributes:
+        trigger (hoomd.trigger.Trigger): Select the timesteps to write
+            checkpoints.
+        filename (str): Base file name of the checkpoints.
+        num_files (int): Number of checkpoint files to rotate through.
+        asynchronous (bool): When `True`, write checkpoints on background
+            threads.
+        parallel (bool): When `True`, write per-particle data from all MPI
+            ranks.
+    """
+
+    def __init__(self,
+                 trigger,
+                 filename,
+                 num_files=2,
+                 asynchronous=True,
+                 parallel=False):
+        super().__init__(trigger)
+
+        self._param_dict.update(
+            ParameterDict(filename=str(filename),
+                          num_files=OnlyTypes(int,
+                                              preprocess=self._positive),
+                          asynchronous=bool(asynchronous),
+                          parallel=bool(parallel)))
+        self.num_files = num_files
+
+    @staticmethod
+    def _positive(value):
+        try:
+            if value < 1:
+                raise ValueError("Expected positive integer.")
+            else:
+                return value
+        except TypeError:
+            raise ValueError("Expected positive integer.")
+
+    def _attach(self):
+        sim = self._simulation
+        writers = []
+        for index in range(self.num_files):
+            writer = _hoomd.GSDDumpWriter(
+                sim.state._cpp_sys_def,
+                _checkpoint_filename(self.filename, index),
+                sim.state._get_group(All()), 'wb', True)
+            writer.setWriteAttribute(True)
+            writer.setWriteProperty(True)
+            writer.setWriteMomentum(True)
+            writer.setWriteTopology(True)
+            writer.asynchronous = self.asynchronous
+            writer.parallel = self.parallel
+            writer.log_writer = _CheckpointStateWriter(sim)
+            writers.append(writer)
+
+        self._cpp_obj = _hoomd.GSDCheckpointWriter(sim.state._cpp_sys_def,
+                                                   writers)
+
+        # continue the rotation after the most recent checkpoint
+        latest = self._latest_index(self.filename, self.num_files)
+        if latest is not None:
+            self._cpp_obj.next_index = (latest + 1) % self.num_files
+
+        super()._attach()
+
+    def flush(self):
+        """Wait until all checkpoints are written to the files."""
+        if self._attached:
+            self._cpp_obj.flush()
+
+    @staticmethod
+    def _latest_index(filename, num_files):
+        latest = None
+        latest_step = None
+        for index in range(num_files):
+            try:
+                reader = _hoomd.GSDStateReader(
+                    _checkpoint_filename(filename, index), -1)
+                step = int(reader.readChunk('configuration/step')[0])
+            except RuntimeError:
+                # missing, empty, or incomplete file
+                continue
+
+            if latest_step is None or step > latest_step:
+                latest = index
+                latest_step = step
+        return latest
+
+    @staticmethod
+    def latest(filename, num_files=2):
+        """Find the most recent complete checkpoint.
+
+        Args:
+            filename (str): Base file name of the checkpoints.
+            num_files (int): Number of checkpoint files. Defaults to 2.
+
+        Returns:
+            str: The name of the checkpoint file with the largest timestep,
+            or `None` when there is no complete checkpoint.
+        """
+        index = Checkpoint._latest_index(filename, num_files)
+        if index is None:
+            return None
+        return _checkpoint_filename(filename, index)
+
+    @staticmethod
+    def restore_state(simulation, filename):
+        """Restore the operation state stored in a checkpoint.
+
+        Args:
+            simulation (hoomd.Simulation): Simulation to restore. Add the
+                integrator and its methods before calling `restore_state`.
+            filename (str): Checkpoint file to read.
+
+        `restore_state` sets the simulation seed and the state of the
+        integrator and its methods to the values in the checkpoint. The
+        simulation must have the same types of integrator and methods, in the
+        same order, as when the checkpoint was written.
+        """
+        reader = _hoomd.GSDStateReader(filename, -1)
+        value = reader.readChunk(_state_chunk)
+        state = json.loads(
+            value.view(dtype=np.uint8).tobytes().rstrip(b'\0').decode('UTF-8'))
+
+        operations = _state_operations(simulation)
+        if [_type_name(op) for op in operations
+           ] != [s['type'] for s in state['operations']]:
+            raise RuntimeError(
+                f"The operations in {filename} do not match the simulation.")
+
+        simulation.seed = state['seed']
+        for op, op_state in zip(operations, state['operations']):
+            for name, value in op_state.items():
+                if name == 'type':
+                    continue
+                if name in op._typeparam_dict:
+                    for type_, type_value in value.items():
+                        getattr(op, name)[type_] = type_value
+                else:
+                    setattr(op, name, tuple(value))
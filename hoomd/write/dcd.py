@@ -34,6 +34,8 @@ class DCD(Writer):
             *unwrap_full* is True.
         angle_z (bool): When True, the particle orientation angle is written to
             the z component (only useful for 2D simulations)
+        asynchronous (bool): When `True`, write frames to the file on a
+            background thread. Defaults to `False`.
 
     On each timestep where `DCD` triggers, it writes the simulation snapshot to
     the specified file in the DCD file format. DCD only stores particle
@@ -45,6 +47,12 @@ class DCD(Writer):
         dcd = hoomd.write.DCD(filename="data/dump.dcd",
                               trigger=hoomd.trigger.Periodic(100, 10))
 
+    When `asynchronous` is `True`, `DCD` copies the coordinates of each frame
+    into memory and returns to the simulation while a background thread writes
+    the frame to the file. At most two frames are buffered at a time.
+    `Simulation.run` waits for all buffered frames to be written before it
+    returns. Call `flush` to wait for the writes at other times.
+
     Warning:
         When you use `DCD` to append to an existing DCD file:
 
@@ -71,6 +79,8 @@ class DCD(Writer):
             *unwrap_full* is True.
         angle_z (bool): When True, the particle orientation angle is written to
             the z component
+        asynchronous (bool): When `True`, write frames to the file on a
+            background thread.
     """
 
     def __init__(self,
@@ -80,7 +90,8 @@ class DCD(Writer):
                  overwrite=False,
                  unwrap_full=False,
                  unwrap_rigid=False,
-                 angle_z=False):
+                 angle_z=False,
+                 asynchronous=False):
 
         # initialize base class
         super().__init__(trigger)
@@ -90,7 +101,8 @@ class DCD(Writer):
                           overwrite=bool(overwrite),
                           unwrap_full=bool(unwrap_full),
                           unwrap_rigid=bool(unwrap_rigid),
-                          angle_z=bool(angle_z)))
+                          angle_z=bool(angle_z),
+                          asynchronous=bool(asynchronous)))
         self.filter = filter
 
     def _attach(self):
@@ -99,3 +111,8 @@ class DCD(Writer):
             self._simulation.state._cpp_sys_def, self.filename,
             int(self.trigger.period), group, self.overwrite)
         super()._attach()
+
+    def flush(self):
+        """Wait until all buffered frames are written to the file."""
+        if self._attached:
+            self._cpp_obj.flush()
@@ -27,6 +27,14 @@ def _array_to_strings(value):
         return value
 
 
+_compressible_chunks = [
+    'particles/typeid', 'particles/mass', 'particles/charge',
+    'particles/diameter', 'particles/body', 'particles/moment_inertia',
+    'particles/position', 'particles/orientation', 'particles/velocity',
+    'particles/angmom', 'particles/image'
+]
+
+
 class GSD(Writer):
     r"""Write simulation trajectories in the GSD format.
 
@@ -42,6 +50,15 @@ class GSD(Writer):
             Defaults to ``['property']``.
         log (hoomd.logging.Logger): Provide log quantities to write. Defaults to
             `None`.
+        asynchronous (bool): When `True`, write frames to the file on a
+            background thread. Defaults to `False`.
+        parallel (bool): When `True`, write per-particle data from all MPI
+            ranks. Defaults to `False`.
+        compress (list[str]): Per-particle chunks to compress. Defaults to
+            ``[]``.
+        position_precision (float): When greater than 0, round
+            ``particles/position`` to a multiple of this value
+            :math:`[\mathrm{length}]` before compressing it. Defaults to 0.
 
     `GSD` writes a simulation snapshot to the specified file each time it
     triggers. `GSD` can store all particle, bond, angle, dihedral, improper,
@@ -133,6 +150,36 @@ class GSD(Writer):
         to `None` or remove specific quantities from the logger, but do not
         add additional quantities after the first frame.
 
+    Note:
+        When `asynchronous` is `True`, `GSD` copies each frame into memory and
+        returns to the simulation while a background thread writes the frame to
+        the file. At most two frames are buffered at a time. `Simulation.run`
+        waits for all buffered frames to be written before it returns. Call
+        `flush` to wait for the writes at other times. Frames are written
+        synchronously when other operations write state information to the
+        file.
+
+    Note:
+        When `parallel` is `True` and the simulation uses a domain
+        decomposition, `GSD` does not gather the particle data on the root
+        rank. Instead, each rank writes a contiguous slice of each per-particle
+        data chunk using MPI-IO. The file contents are the same as when
+        `parallel` is `False`. Use `parallel` on file systems that support
+        parallel writes to reduce the memory usage of rank 0 in large
+        simulations. The root rank still gathers **topology** data. `parallel`
+        takes precedence over `asynchronous`.
+
+    Note:
+        Set `compress` to a list of per-particle chunk names (such as
+        ``'particles/position'`` or ``'particles/orientation'``) to store those
+        chunks compressed with a byte shuffle and zlib. Compression is lossless
+        unless `position_precision` is set, in which case `GSD` stores
+        positions rounded to the given precision. Compressed chunks are stored
+        in a HOOMD-blue specific encoding that
+        `hoomd.Simulation.create_state_from_gsd` reads transparently. Other GSD
+        readers, such as ``gsd.hoomd``, cannot decode these chunks. Compression
+        requires HOOMD-blue to be built with ``ENABLE_ZLIB=on``.
+
     Attributes:
         filename (str): File name to write.
         trigger (hoomd.trigger.Trigger): Select the timesteps to write.
@@ -141,6 +188,13 @@ class GSD(Writer):
         truncate (bool): When `True`, truncate the file and write a new frame 0
             each time this operation triggers.
         dynamic (list[str]): Quantity categories to save in every frame.
+        asynchronous (bool): When `True`, write frames to the file on a
+            background thread.
+        parallel (bool): When `True`, write per-particle data from all MPI
+            ranks.
+        compress (list[str]): Per-particle chunks to compress.
+        position_precision (float): Precision of compressed positions
+            :math:`[\mathrm{length}]`, or 0 for lossless compression.
     """
 
     def __init__(self,
@@ -150,7 +204,11 @@ class GSD(Writer):
                  mode='ab',
                  truncate=False,
                  dynamic=None,
-                 log=None):
+                 log=None,
+                 asynchronous=False,
+                 parallel=False,
+                 compress=None,
+                 position_precision=0.0):
 
         super().__init__(trigger)
 
@@ -158,14 +216,24 @@ class GSD(Writer):
             ['attribute', 'property', 'momentum', 'topology'],
             preprocess=_array_to_strings)
 
+        compress_validation = OnlyFrom(_compressible_chunks,
+                                       preprocess=_array_to_strings)
+
         dynamic = ['property'] if dynamic is None else dynamic
+        compress = [] if compress is None else compress
         self._param_dict.update(
             ParameterDict(filename=str(filename),
                           filter=ParticleFilter,
                           mode=str(mode),
                           truncate=bool(truncate),
                           dynamic=[dynamic_validation],
-                          _defaults=dict(filter=filter, dynamic=dynamic)))
+                          asynchronous=bool(asynchronous),
+                          parallel=bool(parallel),
+                          compress=[compress_validation],
+                          position_precision=float(position_precision),
+                          _defaults=dict(filter=filter,
+                                         dynamic=dynamic,
+                                         compress=compress)))
 
         self._log = None if log is None else _GSDLogWriter(log)
 
@@ -192,8 +260,20 @@ class GSD(Writer):
         self._cpp_obj.setWriteMomentum('momentum' in dynamic_quantities)
         self._cpp_obj.setWriteTopology('topology' in dynamic_quantities)
         self._cpp_obj.log_writer = self.log
+
+        for chunk in self.compress:
+            precision = 0.0
+            if chunk == 'particles/position':
+                precision = self.position_precision
+            self._cpp_obj.setCompression(chunk, precision)
+
         super()._attach()
 
+    def flush(self):
+        """Wait until all buffered frames are written to the file."""
+        if self._attached:
+            self._cpp_obj.flush()
+
     @staticmethod
     def write(state, filename, filter=All(), mode='wb', log=None):
         """Write the given simulation state out to a GSD file.
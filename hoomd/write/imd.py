@@ -0,0 +1,79 @@
+# Copyright (c) 2009-2021 The Regents of the University of Michigan
+# This file is part of the HOOMD-blue project, released under the BSD 3-Clause
+# License.
+
+"""Implement IMD."""
+
+from hoomd import _hoomd
+from hoomd.filter import ParticleFilter, All
+from hoomd.data.parameterdicts import ParameterDict
+from hoomd.logging import log
+from hoomd.operation import Writer
+
+
+class IMD(Writer):
+    """Stream particle positions to a live client over the IMD protocol.
+
+    Args:
+        trigger (hoomd.trigger.Trigger): Select the timesteps to send.
+        port (int): TCP port to listen on.
+        filter (hoomd.filter.ParticleFilter): Select the particles to send.
+            Defaults to `hoomd.filter.All`.
+
+    `IMD` listens on *port* for a client that speaks the Interactive Molecular
+    Dynamics protocol, such as VMD (``imd connect <host> <port>``). On each
+    timestep where `IMD` triggers and a client is connected, it sends the
+    positions of the selected particles, in tag order and wrapped into the
+    box. Nothing is gathered or sent while no client is connected.
+
+    The frame is sent on a background thread while the simulation continues.
+    When the previous frame is still being sent, `IMD` drops the new frame
+    instead of waiting for the client, so a slow client or network never
+    stalls the simulation. `frames_dropped` counts these frames.
+
+    `IMD` honors the client's transmission rate and pause requests. It ignores
+    forces sent by the client, and treats a kill request as a disconnect. Only
+    one client is connected at a time; another client may connect after the
+    first disconnects.
+
+    Examples::
+
+        imd = hoomd.write.IMD(trigger=hoomd.trigger.Periodic(100), port=54321)
+        sim.operations.writers.append(imd)
+
+    Attributes:
+        trigger (hoomd.trigger.Trigger): Select the timesteps to send.
+        port (int): TCP port to listen on.
+        filter (hoomd.filter.ParticleFilter): Select the particles to send.
+    """
+
+    def __init__(self, trigger, port, filter=All()):
+
+        # initialize base class
+        super().__init__(trigger)
+        self._param_dict.update(
+            ParameterDict(port=int(port), filter=ParticleFilter))
+        self.filter = filter
+
+    def _attach(self):
+        group = self._simulation.state._get_group(self.filter)
+        self._cpp_obj = _hoomd.IMDWriter(self._simulation.state._cpp_sys_def,
+                                         self.port, group)
+        super()._attach()
+
+    @log(requires_run=True)
+    def frames_sent(self):
+        """int: Number of frames sent to clients."""
+        return self._cpp_obj.frames_sent
+
+    @log(requires_run=True)
+    def frames_dropped(self):
+        """int: Number of frames dropped while a previous frame was sent."""
+        return self._cpp_obj.frames_dropped
+
+    @property
+    def connected(self):
+        """bool: True when a client is connected."""
+        if not self._attached:
+            return False
+        return self._cpp_obj.connected
@@ -0,0 +1,149 @@
+# Copyright (c) 2009-2021 The Regents of the University of Michigan
+# This file is part of the HOOMD-blue project, released under the BSD 3-Clause
+# License.
+
+"""Implement LogBuffer."""
+
+from hoomd import _hoomd
+from hoomd.data.parameterdicts import ParameterDict
+from hoomd.logging import log
+from hoomd.operation import Writer
+from hoomd.data.typeconverter import OnlyTypes, OnlyFrom
+
+
+def _label(operation, name):
+    """Label a quantity by its `hoomd.logging.Logger` namespace."""
+    return '.'.join(operation._export_dict[name].namespace + (name,))
+
+
+class LogBuffer(Writer):
+    """Sample scalar quantities into a buffer without calling Python.
+
+    Args:
+        trigger (hoomd.trigger.Trigger): Select the timesteps to sample.
+        quantities (list[tuple[hoomd.operation.Compute, str]]): Operations
+            and the names of their loggable quantities to sample.
+        capacity (int): Maximum number of rows to buffer. Defaults to 1000.
+        filename (str): File name to write. Defaults to `None`, which keeps
+            the rows in memory for `fetch`.
+        format (str): File format, ``'text'`` or ``'gsd'``. Defaults to
+            ``'text'``.
+        delimiter (str): Column delimiter in the file. Defaults to ``' '``.
+        precision (int): Number of significant digits in the file. Defaults
+            to 10.
+
+    `LogBuffer` samples scalar quantities entirely in C++: on each timestep
+    where it triggers, it computes the given operations and appends one row,
+    the timestep followed by the quantities, to a preallocated buffer. This
+    avoids the per sample cost of `hoomd.logging.Logger` and
+    `hoomd.write.Table`, which call into Python for every quantity.
+
+    When *filename* is `None`, the buffer holds the last *capacity* rows.
+    Call `fetch` to retrieve and clear them. When the buffer is full, new
+    rows overwrite the oldest; `num_dropped` counts the overwritten rows.
+
+    When *filename* is given, `LogBuffer` writes each full buffer to the file
+    as one batch on a background thread while the simulation continues.
+    `Simulation.run` writes the remaining rows before it returns. The file is
+    overwritten when the writer attaches.
+
+    The ``'text'`` format writes a header line of column labels followed by
+    one delimited line per row. The ``'gsd'`` format writes binary columns:
+    each GSD frame holds one batch, with the chunk ``log/timestep`` and one
+    ``log/...`` chunk per quantity, named by its `hoomd.logging.Logger`
+    namespace (the same name `hoomd.write.GSD` uses). Each chunk holds one
+    value per row in the batch. Concatenate the chunks of all frames to read
+    the time series::
+
+        with gsd.fl.open(name='log.gsd', mode='rb') as f:
+            timestep = numpy.concatenate([
+                f.read_chunk(frame=i, name='log/timestep')
+                for i in range(f.nframes)
+            ])
+
+    The quantities must be loggable scalars of operations implemented in
+    C++, such as ``energy`` of a `hoomd.md.force.Force` and
+    ``kinetic_temperature``, ``pressure``, ``kinetic_energy``,
+    ``translational_kinetic_energy``, ``rotational_kinetic_energy``,
+    ``potential_energy``, ``volume``, ``degrees_of_freedom``, and
+    ``num_particles`` of `hoomd.md.compute.ThermodynamicQuantities`. The
+    operations must be added to the simulation. `Simulation.run` raises an
+    error when a quantity cannot be sampled natively.
+
+    Examples::
+
+        thermo = hoomd.md.compute.ThermodynamicQuantities(hoomd.filter.All())
+        sim.operations.computes.append(thermo)
+        buffer = hoomd.write.LogBuffer(
+            trigger=hoomd.trigger.Periodic(10),
+            quantities=[(thermo, 'kinetic_temperature'),
+                        (thermo, 'pressure')])
+        sim.operations.writers.append(buffer)
+        sim.run(1000)
+        data = buffer.fetch()
+
+    Attributes:
+        trigger (hoomd.trigger.Trigger): Select the timesteps to sample.
+        capacity (int): Maximum number of rows to buffer.
+        filename (str): File name to write (*read only*).
+        format (str): File format (*read only*).
+        delimiter (str): Column delimiter in the file (*read only*).
+        precision (int): Number of significant digits in the file
+            (*read only*).
+    """
+
+    def __init__(self,
+                 trigger,
+                 quantities,
+                 capacity=1000,
+                 filename=None,
+                 format='text',
+                 delimiter=' ',
+                 precision=10):
+
+        # initialize base class
+        super().__init__(trigger)
+        self._param_dict.update(
+            ParameterDict(capacity=int(capacity),
+                          filename=OnlyTypes(str, allow_none=True),
+                          format=OnlyFrom(['text', 'gsd']),
+                          delimiter=str(delimiter),
+                          precision=int(precision)))
+        self.filename = filename
+        self.format = format
+        self._quantities = [(operation, str(name))
+                            for operation, name in quantities]
+
+    def _attach(self):
+        filename = self.filename if self.filename is not None else ""
+        self._cpp_obj = _hoomd.LogBufferWriter(
+            self._simulation.state._cpp_sys_def, self.capacity, filename,
+            self.format, self.delimiter, self.precision)
+        for operation, name in self._quantities:
+            self._cpp_obj.addQuantity(_label(operation, name), operation,
+                                      name)
+        super()._attach()
+
+    def fetch(self):
+        """Get the buffered rows and clear the buffer.
+
+        Returns:
+            numpy.ndarray: Array of shape ``(N, len(labels))`` with one row
+            per sample. The first column is the timestep.
+
+        Note:
+            When writing to a file, `fetch` returns the rows not yet written.
+        """
+        return self._cpp_obj.fetch()
+
+    @property
+    def labels(self):
+        """list[str]: Column labels, starting with ``timestep``."""
+        return ['timestep'] + [
+            _label(operation, name) for operation, name in self._quantities
+        ]
+
+    @log(requires_run=True)
+    def num_dropped(self):
+        """int: Number of rows overwritten before they were fetched."""
+        return self._cpp_obj.num_dropped